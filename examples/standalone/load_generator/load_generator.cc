@@ -0,0 +1,408 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/marker_v.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/scene.pb.h>
+
+#include <gz/msgs/PointCloudPackedUtils.hh>
+#include <gz/transport/Node.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <csignal>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Set to true if a signal has been received to stop publishing
+static std::atomic<bool> g_terminate(false);
+
+/// \brief Settings read from a profile, by section and key. Top level keys
+/// are in the "" section.
+using Profile = std::map<std::string, std::map<std::string, std::string>>;
+
+//////////////////////////////////////////////////
+/// \brief Read a profile. Only the subset of YAML used by profile.yaml is
+/// supported: top level scalars, and sections holding scalars.
+/// \param[in] _path Profile path
+/// \param[out] _profile Settings read
+/// \return True if the file could be read
+bool readProfile(const std::string &_path, Profile &_profile)
+{
+  std::ifstream file(_path);
+  if (!file)
+    return false;
+
+  auto trim = [](const std::string &_str)
+  {
+    const auto begin = _str.find_first_not_of(" \t\r");
+    if (begin == std::string::npos)
+      return std::string();
+    const auto end = _str.find_last_not_of(" \t\r");
+    return _str.substr(begin, end - begin + 1);
+  };
+
+  std::string section;
+  std::string line;
+  while (std::getline(file, line))
+  {
+    line = line.substr(0, line.find('#'));
+    const auto colon = line.find(':');
+    if (trim(line).empty() || colon == std::string::npos)
+      continue;
+
+    const bool indented = line[0] == ' ' || line[0] == '\t';
+    const auto key = trim(line.substr(0, colon));
+    const auto value = trim(line.substr(colon + 1));
+    if (!indented && value.empty())
+      section = key;
+    else if (!indented)
+      _profile[""][key] = value;
+    else
+      _profile[section][key] = value;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get a number from a profile
+/// \param[in] _profile Profile
+/// \param[in] _section Section
+/// \param[in] _key Key
+/// \return The number, 0 if missing
+double number(const Profile &_profile, const std::string &_section,
+    const std::string &_key)
+{
+  auto section = _profile.find(_section);
+  if (section == _profile.end())
+    return 0.0;
+  auto value = section->second.find(_key);
+  if (value == section->second.end())
+    return 0.0;
+  return std::atof(value->second.c_str());
+}
+
+//////////////////////////////////////////////////
+/// \brief A message published periodically
+class Stream
+{
+  /// \brief Name shown in the statistics
+  public: std::string name;
+
+  /// \brief Time between two messages
+  public: std::chrono::steady_clock::duration period;
+
+  /// \brief When the next message is due
+  public: std::chrono::steady_clock::time_point next;
+
+  /// \brief Publishes one message
+  public: std::function<void()> publish;
+
+  /// \brief Messages published since the last statistics
+  public: unsigned int count{0};
+};
+
+//////////////////////////////////////////////////
+/// \brief Position of a model of the scene, on a square grid
+/// \param[in] _index Model index
+/// \param[in] _models Model count
+/// \param[out] _x X coordinate
+/// \param[out] _y Y coordinate
+void gridPosition(unsigned int _index, unsigned int _models, double &_x,
+    double &_y)
+{
+  const auto side = static_cast<unsigned int>(
+      std::ceil(std::sqrt(std::max(1u, _models))));
+  _x = 2.0 * (_index % side);
+  _y = 2.0 * (_index / side);
+}
+
+//////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  auto signalHandler = [](int _signal) -> void
+  {
+    if (_signal == SIGINT || _signal == SIGTERM)
+      g_terminate = true;
+  };
+  std::signal(SIGINT, signalHandler);
+  std::signal(SIGTERM, signalHandler);
+
+  const std::string path = _argc > 1 ? _argv[1] : "profile.yaml";
+  Profile profile;
+  if (!readProfile(path, profile))
+  {
+    std::cerr << "Unable to read profile [" << path << "]" << std::endl
+              << "Usage: " << _argv[0] << " [profile.yaml]" << std::endl;
+    return 1;
+  }
+
+  std::string prefix = "/load";
+  if (profile[""].count("prefix"))
+    prefix = profile[""]["prefix"];
+
+  gz::transport::Node node;
+  std::vector<Stream> streams;
+  const auto now = std::chrono::steady_clock::now();
+  auto addStream = [&](const std::string &_name, double _rate,
+      std::function<void()> _publish)
+  {
+    if (_rate <= 0.0)
+      return;
+    Stream stream;
+    stream.name = _name;
+    stream.period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / _rate));
+    stream.next = now;
+    stream.publish = std::move(_publish);
+    streams.push_back(std::move(stream));
+  };
+
+  // Scene of boxes, each model has a link with a box visual
+  const auto models = static_cast<unsigned int>(
+      number(profile, "scene", "models"));
+  std::function<bool(gz::msgs::Scene &)> sceneService =
+      [models](gz::msgs::Scene &_rep)
+  {
+    std::cout << "Returning scene of " << models << " models" << std::endl;
+    auto lightMsg = _rep.add_light();
+    lightMsg->set_type(gz::msgs::Light::DIRECTIONAL);
+    lightMsg->mutable_diffuse()->set_r(1.0);
+    lightMsg->mutable_diffuse()->set_g(1.0);
+    lightMsg->mutable_diffuse()->set_b(1.0);
+    lightMsg->mutable_direction()->set_x(0.5);
+    lightMsg->mutable_direction()->set_y(0.2);
+    lightMsg->mutable_direction()->set_z(-0.9);
+
+    for (unsigned int i = 0; i < models; ++i)
+    {
+      auto modelMsg = _rep.add_model();
+      modelMsg->set_id(1 + i);
+      modelMsg->set_name("model_" + std::to_string(i));
+      double x;
+      double y;
+      gridPosition(i, models, x, y);
+      modelMsg->mutable_pose()->mutable_position()->set_x(x);
+      modelMsg->mutable_pose()->mutable_position()->set_y(y);
+
+      auto linkMsg = modelMsg->add_link();
+      linkMsg->set_id(1 + models + i);
+      linkMsg->set_name("link");
+
+      auto visMsg = linkMsg->add_visual();
+      visMsg->set_id(1 + 2 * models + i);
+      visMsg->set_name("visual");
+      auto boxSize = visMsg->mutable_geometry()->mutable_box()
+          ->mutable_size();
+      boxSize->set_x(1.0);
+      boxSize->set_y(1.0);
+      boxSize->set_z(1.0);
+    }
+    return true;
+  };
+  if (models > 0)
+    node.Advertise(prefix + "/scene", sceneService);
+
+  // Poses
+  const auto entities = std::min(models, static_cast<unsigned int>(
+      number(profile, "pose", "entities")));
+  auto posePub = node.Advertise<gz::msgs::Pose_V>(prefix + "/pose");
+  gz::msgs::Pose_V poseMsg;
+  for (unsigned int i = 0; i < entities; ++i)
+    poseMsg.add_pose()->set_id(1 + i);
+  unsigned int poseTick{0};
+  addStream("pose", entities > 0 ? number(profile, "pose", "rate") : 0.0,
+      [&]()
+  {
+    for (unsigned int i = 0; i < entities; ++i)
+    {
+      double x;
+      double y;
+      gridPosition(i, models, x, y);
+      auto position = poseMsg.mutable_pose(i)->mutable_position();
+      position->set_x(x);
+      position->set_y(y);
+      position->set_z(std::sin(0.1 * poseTick + i));
+    }
+    ++poseTick;
+    posePub.Publish(poseMsg);
+  });
+
+  // Marker bursts, requested without waiting for the replies
+  const auto markerCount = static_cast<unsigned int>(
+      number(profile, "markers", "count"));
+  const double lifetime = number(profile, "markers", "lifetime");
+  unsigned int markerTick{0};
+  std::function<void(const gz::msgs::Boolean &, const bool)> markerCb =
+      [](const gz::msgs::Boolean &, const bool) {};
+  addStream("markers",
+      markerCount > 0 ? number(profile, "markers", "rate") : 0.0, [&]()
+  {
+    gz::msgs::Marker_V markers;
+    for (unsigned int i = 0; i < markerCount; ++i)
+    {
+      auto marker = markers.add_marker();
+      marker->set_ns("load");
+      marker->set_id(markerTick * markerCount + i);
+      marker->set_action(gz::msgs::Marker::ADD_MODIFY);
+      marker->set_type(gz::msgs::Marker::BOX);
+      marker->set_visibility(gz::msgs::Marker::GUI);
+      const auto sec = static_cast<int64_t>(lifetime);
+      marker->mutable_lifetime()->set_sec(sec);
+      marker->mutable_lifetime()->set_nsec(
+          static_cast<int32_t>((lifetime - sec) * 1e9));
+      marker->mutable_scale()->set_x(0.2);
+      marker->mutable_scale()->set_y(0.2);
+      marker->mutable_scale()->set_z(0.2);
+      auto position = marker->mutable_pose()->mutable_position();
+      position->set_x(std::cos(0.01 * (markerTick * markerCount + i)) * 10);
+      position->set_y(std::sin(0.01 * (markerTick * markerCount + i)) * 10);
+      position->set_z(3.0);
+      marker->mutable_material()->mutable_diffuse()->set_r(1.0);
+      marker->mutable_material()->mutable_diffuse()->set_a(1.0);
+    }
+    ++markerTick;
+    node.Request("/marker_array", markers, markerCb);
+  });
+
+  // Point cloud of a sphere, rotated a bit for each message
+  const auto points = static_cast<unsigned int>(
+      number(profile, "point_cloud", "points"));
+  auto cloudPub = node.Advertise<gz::msgs::PointCloudPacked>(
+      prefix + "/point_cloud");
+  gz::msgs::PointCloudPacked cloudMsg;
+  gz::msgs::InitPointCloudPacked(cloudMsg, "load", true,
+      {{"xyz", gz::msgs::PointCloudPacked::Field::FLOAT32}});
+  cloudMsg.mutable_data()->resize(
+      static_cast<std::size_t>(points) * cloudMsg.point_step());
+  cloudMsg.set_height(1);
+  cloudMsg.set_width(points);
+  unsigned int cloudTick{0};
+  addStream("point_cloud",
+      points > 0 ? number(profile, "point_cloud", "rate") : 0.0, [&]()
+  {
+    gz::msgs::PointCloudPackedIterator<float> xIter(cloudMsg, "x");
+    gz::msgs::PointCloudPackedIterator<float> yIter(cloudMsg, "y");
+    gz::msgs::PointCloudPackedIterator<float> zIter(cloudMsg, "z");
+    const double golden = M_PI * (3.0 - std::sqrt(5.0));
+    const double spin = 0.05 * cloudTick++;
+    for (unsigned int i = 0; xIter != xIter.End(); ++i, ++xIter, ++yIter,
+        ++zIter)
+    {
+      const double z = 1.0 - 2.0 * (i + 0.5) / points;
+      const double r = std::sqrt(1.0 - z * z);
+      const double angle = golden * i + spin;
+      *xIter = static_cast<float>(5.0 * r * std::cos(angle));
+      *yIter = static_cast<float>(5.0 * r * std::sin(angle));
+      *zIter = static_cast<float>(5.0 + 5.0 * z);
+    }
+    cloudPub.Publish(cloudMsg);
+  });
+
+  // Scrolling gradient
+  const auto width = static_cast<unsigned int>(
+      number(profile, "image", "width"));
+  const auto height = static_cast<unsigned int>(
+      number(profile, "image", "height"));
+  auto imagePub = node.Advertise<gz::msgs::Image>(prefix + "/image");
+  gz::msgs::Image imageMsg;
+  imageMsg.set_width(width);
+  imageMsg.set_height(height);
+  imageMsg.set_step(width * 3);
+  imageMsg.set_pixel_format_type(gz::msgs::PixelFormatType::RGB_INT8);
+  imageMsg.mutable_data()->resize(static_cast<std::size_t>(width) * height *
+      3);
+  unsigned int imageTick{0};
+  addStream("image",
+      width * height > 0 ? number(profile, "image", "rate") : 0.0, [&]()
+  {
+    auto &data = *imageMsg.mutable_data();
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        const std::size_t i = (static_cast<std::size_t>(y) * width + x) * 3;
+        data[i] = static_cast<char>((x + imageTick) & 0xFF);
+        data[i + 1] = static_cast<char>((y + imageTick) & 0xFF);
+        data[i + 2] = static_cast<char>(imageTick & 0xFF);
+      }
+    }
+    imageTick += 4;
+    imagePub.Publish(imageMsg);
+  });
+
+  if (streams.empty() && models == 0)
+  {
+    std::cerr << "Nothing to publish in [" << path << "]" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Publishing on [" << prefix << "], press Ctrl-C to stop"
+            << std::endl;
+
+  // Publish each stream when it's due, and print the achieved rates every
+  // second. Streams which can't keep up skip the messages they missed.
+  auto lastReport = std::chrono::steady_clock::now();
+  while (!g_terminate)
+  {
+    auto next = lastReport + 1s;
+    for (auto &stream : streams)
+    {
+      const auto time = std::chrono::steady_clock::now();
+      if (time >= stream.next)
+      {
+        stream.publish();
+        ++stream.count;
+        stream.next += stream.period;
+        if (stream.next < time)
+          stream.next = time + stream.period;
+      }
+      next = std::min(next, stream.next);
+    }
+
+    const auto time = std::chrono::steady_clock::now();
+    if (time - lastReport >= 1s)
+    {
+      const std::chrono::duration<double> elapsed = time - lastReport;
+      for (auto &stream : streams)
+      {
+        std::cout << stream.name << ": " << stream.count / elapsed.count()
+                  << " Hz  ";
+        stream.count = 0;
+      }
+      std::cout << std::endl;
+      lastReport = time;
+    }
+
+    std::this_thread::sleep_until(next);
+  }
+}
@@ -24,6 +24,7 @@
 
 #include "gz/gui/qt.h"
 #include "gz/gui/Export.hh"
+#include "gz/gui/StallWatchdog.hh"
 
 #include <gz/utils/ImplPtr.hh>
 
@@ -34,9 +35,17 @@ namespace tinyxml2
 
 namespace gz::gui
 {
+    class AsyncRequests;
     class Dialog;
+    class LatencyTrace;
     class MainWindow;
+    class NodePool;
     class Plugin;
+    class StartupTrace;
+    class SubscriptionHub;
+    class TaskPool;
+    class TopicRegistry;
+    struct ThreadPolicy;
 
     /// \brief Type of window which the application will display
     enum class WindowType : int
@@ -58,7 +67,8 @@ namespace gz::gui
     {
       Q_OBJECT
 
-      /// \brief Constructor.
+      /// \brief Constructor. Renders on the GPU requested with GpuSelection,
+      /// which must be requested before.
       /// \param[in] _argc Argument count.
       /// \param[in] _argv Argument values.
       /// \param[in] _type Window type, by default it's a main window.
@@ -80,9 +90,24 @@ namespace gz::gui
       /// If a window has been initialized, the plugin is added to the window.
       /// Otherwise, the plugin is stored and can be later added to a window or
       /// dialog.
+      ///
+      /// Plugins added to a window with `<lazy>true</lazy>` inside their
+      /// `<gz-gui>` block are only loaded the first time their card is
+      /// visible and expanded. Until then, a placeholder card with the
+      /// plugin's card configuration takes their place, and the
+      /// PluginAdded signal is emitted again once the plugin replaces it.
+      /// Lazy plugins with `<preload>true</preload>` are also loaded while the
+      /// application is idle, one at a time.
+      ///
+      /// When gz-gui is built with GZ_GUI_PLUGIN_BUNDLE, the core plugins
+      /// are all in one library, which is found and loaded once. They're
+      /// then instantiated from it without looking for a library of their
+      /// own, so they take precedence over libraries of the same name in
+      /// the plugin path.
       /// \param[in] _filename Plugin filename.
       /// \param[in] _pluginElem Element containing plugin configuration
-      /// \return True if successful
+      /// \return True if successful. Errors loading lazy plugins are only
+      /// reported when they're loaded.
       /// \sa LoadConfig
       /// \sa AddPluginsToWindow
       public: bool LoadPlugin(const std::string &_filename,
@@ -92,12 +117,40 @@ namespace gz::gui
       /// and plugins. This function doesn't instantiate the plugins, it just
       /// keeps them in memory and they can be applied later by either
       /// instantiating a window or several dialogs.
+      ///
+      /// A top level \<plugin_load_threads\> element sets the number of
+      /// threads loading the plugin libraries. A top level \<threads\>
+      /// element sets the priority and CPUs of the GUI thread, in its
+      /// \<gui\> child, and of the Tasks threads, in its \<tasks\> child.
+      ///
+      /// When there's a main window, the plugins are added to it together
+      /// once they're all loaded and configured, with the window's layout
+      /// suspended until the window configuration is also applied. The
+      /// PluginAdded signal is then emitted for each of them.
+      ///
+      /// When loading progressively, which a top level
+      /// \<progressive_load\> element also enables, the window
+      /// configuration is applied right away and the plugins are loaded
+      /// from the event loop, one at a time, each added to the window as
+      /// soon as it's loaded. This then returns true if the file could be
+      /// read, and ConfigLoaded reports the result.
       /// \param[in] _path Full path to configuration file.
+      /// \sa SetPluginLoadThreads
+      /// \sa SetProgressiveLoad
       /// \return True if successful
       /// \sa InitializeMainWindow
       /// \sa InitializeDialogs
       public: bool LoadConfig(const std::string &_path);
 
+      /// \brief Load a configuration file into one of the main windows,
+      /// replacing its plugins. Configs and plugins loaded afterwards also go
+      /// into that window.
+      /// \param[in] _path Full path to configuration file.
+      /// \param[in] _window Window, one of MainWindows()
+      /// \return True if successful
+      /// \sa AddMainWindow
+      public: bool LoadConfig(const std::string &_path, MainWindow *_window);
+
       /// \brief Load window configuration from XML element.
       /// This is the `<window>` element inside a gui config file.
       /// \param[in] _window XML element that contains the window configuration
@@ -138,6 +191,72 @@ namespace gz::gui
       /// \param[in] _env Name of environment variable.
       public: void SetPluginPathEnv(const std::string &_env);
 
+      /// \brief Set how many threads load the plugin libraries of a config.
+      /// With more than one, the libraries are opened concurrently and their
+      /// QML is compiled in the background, before the plugins are
+      /// instantiated and added to the window one by one in the GUI thread.
+      /// \param[in] _threads Number of threads, 1 by default to load the
+      /// plugins one after another.
+      /// \sa LoadConfig
+      public: void SetPluginLoadThreads(unsigned int _threads);
+
+      /// \brief Set whether the plugins of configs loaded into a main
+      /// window are loaded progressively, so the window is shown and
+      /// responsive while they load. Progress is reported through
+      /// ConfigLoadProgress and MainWindow::LoadProgress.
+      /// \param[in] _progressive True to load progressively, false by
+      /// default
+      /// \sa LoadConfig
+      public: void SetProgressiveLoad(bool _progressive);
+
+      /// \brief Get whether configs are loaded progressively.
+      /// \return True if progressive
+      public: bool ProgressiveLoad() const;
+
+      /// \brief Get how many threads load the plugin libraries of a config.
+      /// \return Number of threads
+      public: unsigned int PluginLoadThreads() const;
+
+      /// \brief Set the most messages per second plugins get from the
+      /// Subscriptions hub while no main window is exposed, to save power
+      /// while the GUI is minimized or hidden. Only subscriptions which
+      /// asked for a rate are slowed down. Also set by a top level
+      /// \<hidden_max_rate\> element.
+      /// \param[in] _rate Messages per second, 0 by default to keep the
+      /// rates while hidden
+      /// \sa MainWindow::Exposed, SubscriptionHub::SetRateCap
+      public: void SetHiddenMaxRate(double _rate);
+
+      /// \brief Get the rate subscriptions are capped at while no main
+      /// window is exposed.
+      /// \return Messages per second, 0 if not capped
+      public: double HiddenMaxRate() const;
+
+      /// \brief Set the priority and CPUs of the GUI thread. Must be
+      /// called from the GUI thread. Also set by the \<gui\> child of a
+      /// top level \<threads\> element, see ThreadPolicy::Load.
+      /// \param[in] _policy Policy
+      /// \return False if part of it couldn't be applied
+      public: bool SetGuiThreadPolicy(const ThreadPolicy &_policy);
+
+      /// \brief Watch the GUI thread and the render threads for stalls,
+      /// which are printed, and published on the options' topic if it's
+      /// given. The GUI thread beats from a timer, so it stalls when an
+      /// event takes longer than the threshold. Must be called from the
+      /// GUI thread. Also set by a top level \<watchdog\> element, see
+      /// StallWatchdog::Options::Load.
+      /// \param[in] _options Options, a zero threshold stops watching
+      /// \return False if not called from the GUI thread
+      /// \sa StallWatchdog
+      public: bool SetStallWatchdog(const StallWatchdog::Options &_options);
+
+      /// \brief Set the priority and CPUs of the Tasks threads, now or
+      /// once they're started. Also set by the \<tasks\> child of a top
+      /// level \<threads\> element, see ThreadPolicy::Load.
+      /// \param[in] _policy Policy
+      /// \sa TaskPool::SetThreadPolicy
+      public: void SetTaskThreadPolicy(const ThreadPolicy &_policy);
+
       /// \brief Add an path to look for plugins.
       /// \param[in] _path Full path.
       public: void AddPluginPath(const std::string &_path);
@@ -164,17 +283,95 @@ namespace gz::gui
       /// \return True if successful
       public: bool RemovePlugin(const std::string &_pluginName);
 
-      /// \brief Get a plugin by its unique name.
+      /// \brief Get a plugin by its unique name. Plugins are indexed by
+      /// name as they're added, so this doesn't depend on their number.
       /// \param[in] _pluginName Plugn instance's unique name. This is the
       /// plugin card's object name.
       /// \return Pointer to plugin object, null if not found.
       public: std::shared_ptr<Plugin> PluginByName(
           const std::string &_pluginName) const;
 
+      /// \brief Get the plugins which were removed but haven't been
+      /// destroyed, because something still holds them. Removed plugins are
+      /// unloaded, see Plugin::Unload, and a warning is printed for those
+      /// which are still alive a few seconds later.
+      /// \return Descriptions of the plugins, with their names and
+      /// filenames.
+      public: std::vector<std::string> LeakedPlugins() const;
+
+      /// \brief Get the instances of a plugin.
+      /// \param[in] _filename Plugin filename, such as "Publisher"
+      /// \return Its instances which have been added, in the order they
+      /// were added. Lazily loaded plugins are included while their
+      /// placeholder stands in for them.
+      public: std::vector<std::shared_ptr<Plugin>> PluginsByFilename(
+          const std::string &_filename) const;
+
+      /// \brief Get the registry of transport topics shared by all plugins.
+      /// It's created and starts scanning on the first call.
+      /// \return Pointer to the topic registry
+      public: TopicRegistry *Topics() const;
+
+      /// \brief Get the transport subscriptions shared by all plugins.
+      /// It's created on the first call.
+      /// \return Pointer to the subscription hub
+      public: SubscriptionHub *Subscriptions() const;
+
+      /// \brief Get the service requests shared by all plugins, which
+      /// don't block any thread. It's created on the first call.
+      /// \return Pointer to the requests
+      public: AsyncRequests *Requests() const;
+
+      /// \brief Get the transport nodes shared by all plugins, one per
+      /// namespace, for advertising. It's created on the first call.
+      /// \return Pointer to the node pool
+      public: NodePool *Nodes() const;
+
+      /// \brief Get the worker threads shared by all plugins. They're
+      /// started on the first call, one less than the number of cores.
+      /// \return Pointer to the task pool
+      /// \sa Plugin::RunInBackground
+      public: TaskPool *Tasks() const;
+
+      /// \brief Get the timeline of the application's startup. It's
+      /// recorded when the GZ_GUI_STARTUP_TRACE environment variable holds
+      /// a file path, such as with `gz gui --startup-trace`, and written to
+      /// it in the Chrome trace event format after the main window's first
+      /// frame and when the application is destroyed.
+      /// \return Pointer to the trace
+      public: StartupTrace *Trace();
+
+      /// \brief Get the latency trace, which follows msgs from their
+      /// reception to the main window frame showing them. It's recorded
+      /// when the GZ_GUI_LATENCY_TRACE environment variable holds a file
+      /// path, and written to it in the Chrome trace event format when the
+      /// application is destroyed, along with the latency histograms.
+      /// \return Pointer to the trace
+      public: LatencyTrace *Latency();
+
       /// \brief Notify that a plugin has been added.
       /// \param[in] _objectName Plugin's object name.
       signals: void PluginAdded(const QString &_objectName);
 
+      /// \brief Notify the progress of a config loaded progressively.
+      /// \param[in] _loaded Number of its plugins loaded so far
+      /// \param[in] _total Number of its plugins
+      signals: void ConfigLoadProgress(int _loaded, int _total);
+
+      /// \brief Notify that all the plugins of a config loaded
+      /// progressively have been loaded.
+      /// \param[in] _success False if any of them failed
+      signals: void ConfigLoaded(bool _success);
+
+      /// \brief Notify that a plugin has been removed.
+      /// \param[in] _objectName Plugin's object name.
+      signals: void PluginRemoved(const QString &_objectName);
+
+      /// \brief Notify that the plugins which can be loaded may have
+      /// changed, because a plugin directory changed or plugin paths were
+      /// added.
+      signals: void PluginListChanged();
+
       /// \brief Callback when user requests to close a plugin
       public slots: void OnPluginClose();
 
@@ -183,6 +380,28 @@ namespace gz::gui
       /// \sa InitializeMainWindow
       public: bool CreateMainWindow();
 
+      /// \brief Create another main window in this process, such as one
+      /// per monitor. Windows share the QML engine, the plugin libraries, the
+      /// render engine and the transport subscriptions, instead of
+      /// initializing them once per process.
+      ///
+      /// Configs and plugins loaded afterwards go into the new window. Closing
+      /// it removes its plugins, and the application quits once all windows
+      /// are closed.
+      ///
+      /// The first main window remains the one events go through, so plugins
+      /// in any window keep using `App()->findChild<MainWindow *>()` to send
+      /// and filter events. Plugin cards take their toolbar colors from it.
+      /// 3D scenes in different windows need different scene names.
+      /// \return The new window, or null if it failed
+      /// \sa MainWindows
+      /// \sa LoadConfig
+      public: MainWindow *AddMainWindow();
+
+      /// \brief Get the main windows, in the order they were created
+      /// \return Main windows, empty for dialogs
+      public: std::vector<MainWindow *> MainWindows() const;
+
       /// \brief Create a main window, populate with previously loaded plugins
       /// and apply previously loaded configuration.
       /// An empty window will be created if no plugins have been loaded.
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_GUI_ASYNCLOG_HH_
+#define GZ_GUI_ASYNCLOG_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+    /// \brief Writes log messages on a thread of its own, so the threads
+    /// logging, such as the GUI thread handling Qt warnings, never wait on
+    /// the console or log file.
+    ///
+    /// A message repeated more than a few times within a period is
+    /// suppressed for the rest of the period, and a single summary line
+    /// saying how many times it was suppressed is written once the period
+    /// ends. This keeps warnings which fire thousands of times a second,
+    /// such as QML binding loops, from flooding the log.
+    ///
+    /// Queued messages are capped. Past the cap, new messages are dropped
+    /// and counted, and a line saying how many were dropped is written once
+    /// the queue drains.
+    class GZ_GUI_VISIBLE AsyncLog
+    {
+      /// \brief Severity of a message
+      public: enum class Level
+      {
+        /// \brief Written with gzdbg by default
+        DEBUG,
+
+        /// \brief Written with gzmsg by default
+        INFO,
+
+        /// \brief Written with gzwarn by default
+        WARNING,
+
+        /// \brief Written with gzerr by default
+        ERROR
+      };
+
+      /// \brief Writes one line, called on the log thread
+      public: using Writer =
+          std::function<void(Level, const std::string &)>;
+
+      /// \brief Constructor, starting the log thread
+      /// \param[in] _maxRepeats Times the same message is written within a
+      /// period before being suppressed
+      /// \param[in] _period Length of the periods repeats are counted over
+      /// \param[in] _writer Writes the lines, defaults to gz-common's
+      /// console
+      /// \param[in] _maxQueued Most messages waiting to be written
+      public: explicit AsyncLog(std::size_t _maxRepeats = 5,
+          std::chrono::steady_clock::duration _period =
+              std::chrono::seconds(1),
+          Writer _writer = {}, std::size_t _maxQueued = 10000);
+
+      /// \brief Destructor, writing the queued messages and summaries, then
+      /// stopping the log thread
+      public: ~AsyncLog();
+
+      /// \brief Queue a message. Thread safe, only takes a lock long enough
+      /// to append it.
+      /// \param[in] _level Severity
+      /// \param[in] _msg Message, without a trailing newline
+      public: void Write(Level _level, std::string _msg);
+
+      /// \brief Block until the queued messages are written, along with the
+      /// summaries of the messages suppressed so far. Thread safe.
+      public: void Flush();
+
+      /// \internal
+      /// \brief Private data pointer
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+}  // namespace gz::gui
+#endif  // GZ_GUI_ASYNCLOG_HH_
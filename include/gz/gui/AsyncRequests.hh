@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_ASYNCREQUESTS_HH_
+#define GZ_GUI_ASYNCREQUESTS_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Thread a request's continuation runs on
+  enum class RequestThread
+  {
+    /// \brief The transport thread receiving the reply, or the one timing
+    /// it out. Continuations must be quick and mustn't block.
+    TRANSPORT,
+
+    /// \brief The GUI thread, after the events already queued
+    GUI,
+
+    /// \brief The render thread, before the next frame, which is requested
+    RENDER,
+
+    /// \brief One of the worker threads of Application::Tasks
+    POOL
+  };
+
+  /// \brief Outcome of a request
+  enum class RequestStatus
+  {
+    /// \brief Waiting for the reply
+    PENDING,
+
+    /// \brief Replied successfully
+    OK,
+
+    /// \brief The service replied that it failed
+    FAILED,
+
+    /// \brief No reply within the timeout, including while the service
+    /// wasn't discovered
+    TIMED_OUT,
+
+    /// \brief Cancelled before the reply
+    CANCELLED
+  };
+
+  /// \brief How a request is made
+  struct RequestOptions
+  {
+    /// \brief Time to wait for the service to be discovered and to reply,
+    /// zero to wait until cancelled
+    std::chrono::steady_clock::duration timeout{std::chrono::seconds(5)};
+
+    /// \brief Thread the continuation runs on
+    RequestThread thread{RequestThread::GUI};
+
+    /// \brief Object the request belongs to, usually a plugin, so all of
+    /// its requests can be cancelled together. May be null.
+    const void *owner{nullptr};
+  };
+
+  /// \brief Reply to a request
+  /// \tparam Rep Reply msg type
+  template<typename Rep>
+  struct RequestResult
+  {
+    /// \brief Outcome
+    RequestStatus status{RequestStatus::PENDING};
+
+    /// \brief Reply, only set if the status is OK
+    Rep reply;
+
+    /// \brief Time from the request to its outcome
+    std::chrono::steady_clock::duration latency{0};
+  };
+
+  /// \brief Handle of a request, to wait for its result or cancel it.
+  /// Dropping the handle doesn't cancel the request.
+  /// \tparam Rep Reply msg type
+  template<typename Rep>
+  class RequestFuture
+  {
+    /// \brief Whether the handle refers to a request
+    /// \return False for a default constructed handle
+    public: bool Valid() const
+    {
+      return this->future.valid();
+    }
+
+    /// \brief Get the outcome so far, without waiting
+    /// \return PENDING until the request completes
+    public: RequestStatus Status() const
+    {
+      if (!this->future.valid() || this->future.wait_for(
+          std::chrono::seconds(0)) != std::future_status::ready)
+      {
+        return RequestStatus::PENDING;
+      }
+      return this->future.get().status;
+    }
+
+    /// \brief Get the future of the result, to wait for it. The result is
+    /// set before the continuation runs, on the thread completing the
+    /// request, so waiting on the thread the continuation runs on can't
+    /// deadlock.
+    /// \return Shared future
+    public: const std::shared_future<RequestResult<Rep>> &Future() const
+    {
+      return this->future;
+    }
+
+    /// \brief Cancel the request, if it hasn't completed yet. Its
+    /// continuation doesn't run.
+    /// \return True if it was cancelled
+    public: bool Cancel()
+    {
+      return this->cancel ? this->cancel() : false;
+    }
+
+    /// \brief Result
+    private: std::shared_future<RequestResult<Rep>> future;
+
+    /// \brief Cancels the request, holding the requests weakly
+    private: std::function<bool()> cancel;
+
+    friend class AsyncRequests;
+  };
+
+  /// \brief Service requests which don't block any thread, shared by all
+  /// plugins through Application::Requests.
+  ///
+  /// Requests wait for the service to be discovered without polling, and
+  /// complete with a status once replied, timed out or cancelled. The
+  /// result is available through a future, and is passed to an optional
+  /// continuation on the thread of choice:
+  ///
+  ///     App()->Requests()->Request<msgs::Empty, msgs::Scene>("/scene",
+  ///         msgs::Empty(), [this](const RequestResult<msgs::Scene> &_res)
+  ///         {
+  ///           if (_res.status == RequestStatus::OK)
+  ///             this->LoadScene(_res.reply);
+  ///         }, {std::chrono::seconds(2), RequestThread::RENDER, this});
+  ///
+  /// Plugins cancel their requests with CancelOwner when they're unloaded.
+  /// Without an application, continuations for the GUI and worker threads
+  /// run on the thread completing the request.
+  ///
+  /// The latency of the requests of each service is reported by
+  /// PerformanceCounters, under "AsyncRequests", along with the number of
+  /// requests pending.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE AsyncRequests
+  {
+    /// \brief Constructor
+    public: AsyncRequests();
+
+    /// \brief Destructor. Pending requests are cancelled, without running
+    /// their continuations.
+    public: ~AsyncRequests();
+
+    /// \brief Request a service
+    /// \tparam Req Request msg type
+    /// \tparam Rep Reply msg type
+    /// \param[in] _service Service name
+    /// \param[in] _req Request
+    /// \param[in] _then Continuation, called once with the result unless
+    /// the request is cancelled. May be empty.
+    /// \param[in] _options Timeout, thread and owner
+    /// \return Handle of the request
+    public: template<typename Req, typename Rep>
+            RequestFuture<Rep> Request(const std::string &_service,
+                const Req &_req,
+                std::function<void(const RequestResult<Rep> &)> _then = {},
+                const RequestOptions &_options = {})
+    {
+      auto promise = std::make_shared<std::promise<RequestResult<Rep>>>();
+      auto result = std::make_shared<RequestResult<Rep>>();
+      RequestFuture<Rep> future;
+      future.future = promise->get_future().share();
+
+      std::function<void()> then;
+      if (_then)
+      {
+        then = [result, cb = std::move(_then)]()
+        {
+          cb(*result);
+        };
+      }
+
+      const std::uint64_t id = this->Begin(_service, _options,
+          [promise, result](RequestStatus _status,
+              std::chrono::steady_clock::duration _latency)
+          {
+            result->status = _status;
+            result->latency = _latency;
+            promise->set_value(*result);
+          }, std::move(then));
+      future.cancel = this->Canceller(id);
+
+      std::function<void(const Rep &, const bool)> cb =
+          [this, id, result](const Rep &_rep, const bool _ok)
+          {
+            // Only the first outcome counts
+            if (!this->Claim(id))
+              return;
+            if (_ok)
+              result->reply = _rep;
+            this->Finish(id, _ok ? RequestStatus::OK : RequestStatus::FAILED);
+          };
+      if (!this->Node().Request(_service, _req, cb) && this->Claim(id))
+        this->Finish(id, RequestStatus::FAILED);
+      return future;
+    }
+
+    /// \brief Cancel all the pending requests of an owner. Continuations
+    /// already dispatched to another thread may still run, unless this is
+    /// called from that thread.
+    /// \param[in] _owner Owner given in the options
+    /// \return Number of requests cancelled
+    public: std::size_t CancelOwner(const void *_owner);
+
+    /// \brief Get the number of requests waiting for their outcome
+    /// \return Pending requests
+    public: std::size_t Pending() const;
+
+    /// \brief Get the node making the requests
+    /// \return Node
+    private: transport::Node &Node();
+
+    /// \brief Register a request
+    /// \param[in] _service Service name, to report latency under
+    /// \param[in] _options Options
+    /// \param[in] _complete Called with the outcome on the thread
+    /// completing the request
+    /// \param[in] _then Continuation, called afterwards on the chosen
+    /// thread, may be empty
+    /// \return Id of the request
+    private: std::uint64_t Begin(const std::string &_service,
+        const RequestOptions &_options,
+        std::function<void(RequestStatus,
+            std::chrono::steady_clock::duration)> _complete,
+        std::function<void()> _then);
+
+    /// \brief Take the right to complete a request, so its result can be
+    /// filled before Finish
+    /// \param[in] _id Id given by Begin
+    /// \return False if it already completed or was claimed
+    private: bool Claim(std::uint64_t _id);
+
+    /// \brief Complete a claimed request
+    /// \param[in] _id Id given by Begin
+    /// \param[in] _status Outcome
+    private: void Finish(std::uint64_t _id, RequestStatus _status);
+
+    /// \brief Get a function cancelling a request, which may outlive this
+    /// object
+    /// \param[in] _id Id given by Begin
+    /// \return Function returning true if it cancelled the request
+    private: std::function<bool()> Canceller(std::uint64_t _id);
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_EVENTBUS_HH_
+#define GZ_GUI_EVENTBUS_HH_
+
+#include <QEvent>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+    /// \brief Keeps a callback subscribed to the EventBus for as long as
+    /// it's alive. Destroying it unsubscribes the callback. If the callback
+    /// is running at that moment, the destructor waits for it to return, so
+    /// it's safe for the callback to capture the object owning the
+    /// connection.
+    class GZ_GUI_VISIBLE EventBusConnection
+    {
+      /// \brief Constructor. Use EventBus::Subscribe to create connections.
+      public: EventBusConnection();
+
+      /// \brief Destructor. Unsubscribes the callback.
+      public: ~EventBusConnection();
+
+      /// \internal
+      /// \brief Private data pointer
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+
+      friend class EventBus;
+    };
+
+    /// \brief Shared pointer to an event bus connection
+    using EventBusConnectionPtr = std::shared_ptr<EventBusConnection>;
+
+    /// \brief Typed publish / subscribe bus for the events in GuiEvents.hh,
+    /// or any other QEvent subclass with a unique static `kType`.
+    ///
+    /// This is an alternative to installing an event filter on the main
+    /// window, which makes every plugin see every event sent to it, such as
+    /// each mouse move over the 3D scene. Subscribers are kept in a separate
+    /// list per event type, and are called directly, in the order they
+    /// subscribed, on the thread which publishes the event.
+    ///
+    /// Events sent to the main window are published on the bus too, so
+    /// senders keep using `App()->sendEvent(mainWindow, &event)` for
+    /// compatibility with event filters. Only publish directly events which
+    /// aren't also sent to the main window, or they're received twice.
+    ///
+    /// Subscribing or unsubscribing from within a callback takes effect on
+    /// the next event of that type. Publishing allocates no memory.
+    class GZ_GUI_VISIBLE EventBus
+    {
+      /// \brief Signature of the callbacks of an event type
+      public: template <typename EventT>
+              using Callback = std::function<void(const EventT &)>;
+
+      /// \brief Subscribe to an event type
+      /// \param[in] _cb Callback
+      /// \tparam EventT Event type, such as events::HoverToScene
+      /// \return Connection that keeps the callback subscribed. The callback
+      /// is unsubscribed when all copies of it are destroyed.
+      public: template <typename EventT>
+              static EventBusConnectionPtr Subscribe(Callback<EventT> _cb)
+      {
+        static_assert(std::is_base_of_v<QEvent, EventT>,
+            "Events must derive from QEvent");
+        return Subscribe(ChannelOf<EventT>(),
+            [cb = std::move(_cb)](const QEvent &_event)
+            {
+              cb(static_cast<const EventT &>(_event));
+            });
+      }
+
+      /// \brief Call the subscribers of an event's type
+      /// \param[in] _event Event
+      /// \tparam EventT Event type, such as events::HoverToScene
+      public: template <typename EventT>
+              static void Publish(const EventT &_event)
+      {
+        static_assert(std::is_base_of_v<QEvent, EventT>,
+            "Events must derive from QEvent");
+        Publish(ChannelOf<EventT>(), _event);
+      }
+
+      /// \brief Call the subscribers of an event's type, looked up from
+      /// QEvent::type(). The event must be of the class subscribers expect
+      /// for that type.
+      /// \param[in] _event Event
+      public: static void Publish(const QEvent &_event);
+
+      /// \brief Number of callbacks currently subscribed to an event type
+      /// \tparam EventT Event type
+      /// \return Subscriber count
+      public: template <typename EventT>
+              static std::size_t SubscriberCount()
+      {
+        return SubscriberCount(ChannelOf<EventT>());
+      }
+
+      /// \internal
+      /// \brief Subscribers of one event type
+      private: class Channel;
+
+      /// \brief Get the channel of an event type, cached in each library
+      /// \tparam EventT Event type
+      /// \return Channel, which is never destroyed
+      private: template <typename EventT>
+               static Channel *ChannelOf()
+      {
+        static Channel *channel = ChannelOf(EventT::kType);
+        return channel;
+      }
+
+      /// \brief Get the channel of an event type, creating it if needed
+      /// \param[in] _type Event type
+      /// \return Channel, which is never destroyed
+      private: static Channel *ChannelOf(QEvent::Type _type);
+
+      /// \brief Subscribe to a channel
+      /// \param[in] _channel Channel
+      /// \param[in] _cb Callback
+      /// \return Connection
+      private: static EventBusConnectionPtr Subscribe(Channel *_channel,
+          std::function<void(const QEvent &)> _cb);
+
+      /// \brief Call a channel's subscribers
+      /// \param[in] _channel Channel
+      /// \param[in] _event Event
+      private: static void Publish(Channel *_channel, const QEvent &_event);
+
+      /// \brief Number of callbacks subscribed to a channel
+      /// \param[in] _channel Channel
+      /// \return Subscriber count
+      private: static std::size_t SubscriberCount(Channel *_channel);
+
+      friend class EventBusConnection;
+    };
+}  // namespace gz::gui
+#endif  // GZ_GUI_EVENTBUS_HH_
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_EVENTQUEUE_HH_
+#define GZ_GUI_EVENTQUEUE_HH_
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gz::gui
+{
+    /// \brief Queue handing items, such as received messages, from any
+    /// number of producer threads to one consumer thread, which processes
+    /// them in batches.
+    ///
+    /// Producers call Push from any thread. Push returns true only for the
+    /// first item of a batch, so the producer only has to wake the consumer
+    /// once per batch, for example:
+    ///
+    ///     if (this->queue.Push(_msg))
+    ///       QMetaObject::invokeMethod(this, "ProcessQueue",
+    ///           Qt::QueuedConnection);
+    ///
+    /// The consumer then calls Drain on the thread it chooses, such as the
+    /// GUI thread from that queued call or a UI timer, or the render thread
+    /// from a RenderHooks callback once per frame. Drain processes every
+    /// item pushed until then, in the order they were pushed. Items pushed
+    /// by the same thread keep their order; items pushed concurrently by
+    /// different threads are ordered by whichever took the lock first.
+    ///
+    /// Items are processed without holding the lock, so producers never
+    /// wait on the consumer's handlers. The two buffers are reused, so once
+    /// they've grown to the largest batch, pushing and draining don't
+    /// allocate beyond what copying the items needs.
+    /// \tparam T Item type, which must be movable
+    template <typename T>
+    class EventQueue
+    {
+      /// \brief Add an item. Thread safe.
+      /// \param[in] _item Item
+      /// \return True if the queue was empty, so the consumer should be
+      /// told to drain it
+      public: bool Push(T _item)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending.push_back(std::move(_item));
+        return this->pending.size() == 1u;
+      }
+
+      /// \brief Process all queued items, in order, on the calling thread.
+      /// Only one thread should drain a queue.
+      /// \param[in] _handler Called with a reference to each item, which may
+      /// be moved from
+      /// \tparam HandlerT Callable taking `T &`
+      /// \return Number of items processed
+      public: template <typename HandlerT>
+              std::size_t Drain(HandlerT &&_handler)
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->draining.swap(this->pending);
+        }
+
+        for (auto &item : this->draining)
+          _handler(item);
+
+        const auto count = this->draining.size();
+        this->draining.clear();
+        return count;
+      }
+
+      /// \brief Number of items waiting to be drained. Thread safe.
+      /// \return Item count
+      public: std::size_t Size() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->pending.size();
+      }
+
+      /// \brief Protects `pending`
+      private: mutable std::mutex mutex;
+
+      /// \brief Items pushed since the last drain
+      private: std::vector<T> pending;
+
+      /// \brief Items being drained, only touched by the consumer
+      private: std::vector<T> draining;
+    };
+}  // namespace gz::gui
+#endif  // GZ_GUI_EVENTQUEUE_HH_
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_FRAMETAPS_HH_
+#define GZ_GUI_FRAMETAPS_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Frame rendered by the user camera, handed to the subscribers
+  /// of FrameTaps.
+  class GZ_GUI_VISIBLE TapFrame
+  {
+    /// \brief Number of the frame, increasing with each frame the scene
+    /// renders, whether it's tapped or not
+    public: std::uint64_t index{0u};
+
+    /// \brief Time the frame was rendered
+    public: std::chrono::steady_clock::time_point time;
+
+    /// \brief Width in pixels
+    public: unsigned int width{0u};
+
+    /// \brief Height in pixels
+    public: unsigned int height{0u};
+
+    /// \brief Pixel format name, such as "RGB_INT8", as understood by
+    /// common::Image::ConvertPixelFormat. Channels are 8 bits.
+    public: std::string format;
+
+    /// \brief Bytes per pixel
+    public: unsigned int bytesPerPixel{0u};
+
+    /// \brief Pixels of CPU frames, row by row from the top, without
+    /// padding. Empty for GPU frames.
+    public: std::vector<unsigned char> data;
+
+    /// \brief Native handle of the camera's texture, for GPU frames: the
+    /// OpenGL texture id cast to a pointer, or the Metal or Vulkan texture.
+    /// Only valid during the callback, and on the render thread. Null for
+    /// CPU frames.
+    public: void *texture{nullptr};
+  };
+
+  /// \brief Shared pointer to a tapped frame. The pixels of a CPU frame
+  /// are shared by all the subscribers which got it, and its buffer is
+  /// reused for a later frame once they have all released it.
+  using TapFramePtr = std::shared_ptr<const TapFrame>;
+
+  /// \brief What a subscriber of FrameTaps wants to receive
+  class GZ_GUI_VISIBLE FrameTapOptions
+  {
+    /// \brief Where the frames are accessed
+    public: enum class Access
+    {
+      /// \brief Pixels read back from the GPU
+      CPU,
+
+      /// \brief Texture on the GPU, see TapFrame::texture
+      GPU
+    };
+
+    /// \brief Where the frames are accessed
+    public: Access access{Access::CPU};
+
+    /// \brief Most frames per second to receive, zero for all of them
+    public: double rate{0.0};
+
+    /// \brief Largest width of CPU frames. Larger frames are downscaled,
+    /// keeping their aspect ratio. Zero keeps the rendered width.
+    public: unsigned int maxWidth{0u};
+
+    /// \brief Largest height of CPU frames, see maxWidth
+    public: unsigned int maxHeight{0u};
+
+    /// \brief Optional check of whether a frame the subscriber is due for
+    /// is wanted, such as to follow a clock other than the wall clock, or
+    /// to only take frames when asked to. A frame which no subscriber
+    /// wants isn't read back. Called on the render thread, possibly more
+    /// than once per frame, with the registry locked.
+    public: std::function<bool()> wanted;
+  };
+
+  /// \brief Keeps a FrameTaps subscription for as long as it's alive.
+  /// Destroying it unsubscribes. If the callback is running at that moment,
+  /// the destructor waits for it to return, unless it's called from the
+  /// callback itself.
+  class GZ_GUI_VISIBLE FrameTapConnection
+  {
+    /// \brief Constructor. Use FrameTaps::Subscribe to create connections.
+    public: FrameTapConnection();
+
+    /// \brief Destructor. Unsubscribes.
+    public: ~FrameTapConnection();
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+
+    friend class FrameTaps;
+  };
+
+  /// \brief Shared pointer to a frame tap connection
+  using FrameTapConnectionPtr = std::shared_ptr<FrameTapConnection>;
+
+  /// \brief Registry of plugins which want the frames rendered by the user
+  /// camera, such as for screenshots, recording or streaming.
+  ///
+  /// The plugin owning the render thread, like MinimalScene, reads each
+  /// frame back from the GPU at most once, only when a subscriber is due
+  /// for it, and all CPU subscribers share that copy. Subscribers asking
+  /// for a smaller size share one downscaled copy per size.
+  ///
+  ///     // Other plugins
+  ///     FrameTapOptions options;
+  ///     options.rate = 10.0;
+  ///     this->tap = FrameTaps::Subscribe([](const TapFramePtr &_frame)
+  ///     {
+  ///       // Keep _frame for as long as needed, such as to encode it on
+  ///       // another thread
+  ///     }, options);
+  ///
+  /// Callbacks are called on the render thread, after the frame is rendered
+  /// and before the RenderHooks::OnRender callbacks. They shouldn't do
+  /// more than hand the frame over. Scenes which render on demand only
+  /// produce frames when rendering is requested.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE FrameTaps
+  {
+    /// \brief Signature of subscriber callbacks
+    /// \param[in] _frame The frame, which may be kept
+    public: using Callback = std::function<void(const TapFramePtr &_frame)>;
+
+    /// \brief Subscribe to frames
+    /// \param[in] _cb Callback
+    /// \param[in] _options Access, rate and size of the frames
+    /// \return Connection that keeps the subscription. It's removed when
+    /// all copies of the connection are destroyed.
+    public: static FrameTapConnectionPtr Subscribe(Callback _cb,
+        const FrameTapOptions &_options = FrameTapOptions());
+
+    /// \brief Check whether a subscriber is due for a frame, so the frame
+    /// should be published. Meant to be called by the plugin owning the
+    /// render thread.
+    /// \param[in] _access Access of the subscribers to check
+    /// \param[in] _time Time the frame was rendered
+    /// \return True if at least one subscriber with that access is due
+    public: static bool Due(FrameTapOptions::Access _access,
+        std::chrono::steady_clock::time_point _time);
+
+    /// \brief Get a frame to fill and publish, reusing the buffer of a
+    /// released frame if there's one. Meant to be called by the plugin
+    /// owning the render thread.
+    /// \return Frame, whose fields must all be set
+    public: static std::shared_ptr<TapFrame> AcquireFrame();
+
+    /// \brief Hand a frame to the subscribers which are due for it, by
+    /// the frame's time. Meant to be called by the plugin owning the render
+    /// thread, right after the frame is rendered.
+    /// \param[in] _access Access of the subscribers to hand it to. CPU
+    /// frames must have their data set, and GPU frames their texture.
+    /// \param[in] _frame The frame
+    public: static void Publish(FrameTapOptions::Access _access,
+        const std::shared_ptr<TapFrame> &_frame);
+
+    /// \brief Number of subscribers
+    /// \param[in] _access Access of the subscribers to count
+    /// \return Subscriber count
+    public: static std::size_t SubscriberCount(
+        FrameTapOptions::Access _access);
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_FRAMETAPS_HH_
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_GPUSELECTION_HH_
+#define GZ_GUI_GPUSELECTION_HH_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Chooses the GPU the GUI renders on, for hybrid graphics laptops
+  /// whose default is the integrated GPU, and for servers running one GUI
+  /// per card.
+  ///
+  /// The GPU is requested with the GZ_GUI_GPU environment variable, set by
+  /// `gz gui --gpu` or by the \<gpu\> element of a config file, either as an
+  /// index, 0 being the first device, or as part of the device's name, such
+  /// as "nvidia", matched without case.
+  ///
+  /// The GPU must be chosen before Qt creates its graphics device, so the
+  /// Application does it as it's constructed:
+  /// * Vulkan: Qt's device is picked by index, names are matched against
+  ///   the devices' names.
+  /// * OpenGL: Through the environment variables of the drivers, on Linux
+  ///   only. Indices other than 0 and PCI devices, such as "1002:687f" or
+  ///   "pci-0000_02_00_0", set Mesa's DRI_PRIME. Names containing "nvidia"
+  ///   set the variables of NVIDIA's PRIME render offload. Variables which
+  ///   are already set are left alone.
+  ///
+  /// The GPU used is printed once rendering starts.
+  class GZ_GUI_VISIBLE GpuSelection
+  {
+    /// \brief Get the requested GPU
+    /// \return Index or name, empty for the platform's default
+    public: static std::string Requested();
+
+    /// \brief Request a GPU, for applications constructed afterwards in
+    /// this process and the processes it starts
+    /// \param[in] _gpu Index or name, empty for the platform's default
+    public: static void SetRequested(const std::string &_gpu);
+
+    /// \brief Read the GPU requested by a config file, from its top-level
+    /// \<gpu\> element
+    /// \param[in] _path Path to the config file
+    /// \return Index or name, empty if the file can't be read or doesn't
+    /// request one
+    public: static std::string FromConfig(const std::string &_path);
+
+    /// \brief Get the index of a requested GPU
+    /// \param[in] _gpu Index or name
+    /// \return Index, nothing if it's a name
+    public: static std::optional<unsigned int> Index(
+        const std::string &_gpu);
+
+    /// \brief Find a requested GPU among devices
+    /// \param[in] _gpu Index or name
+    /// \param[in] _names Names of the devices, in the order of their
+    /// indices
+    /// \return Index of the device, which is the first one whose name
+    /// contains a requested name. Nothing if none matches.
+    public: static std::optional<std::size_t> Match(const std::string &_gpu,
+        const std::vector<std::string> &_names);
+
+    /// \brief Get the environment variables which make OpenGL drivers
+    /// render on a GPU
+    /// \param[in] _gpu Index or name
+    /// \return Names and values, empty if the GPU is the default one or
+    /// can't be chosen this way
+    public: static std::vector<std::pair<std::string, std::string>>
+        OpenGlEnvironment(const std::string &_gpu);
+
+    /// \brief Set the environment variables of OpenGL drivers for the
+    /// requested GPU. Must be called before Qt connects to the display.
+    /// \return False if a GPU was requested which OpenGL can't be made to
+    /// use, which is printed
+    public: static bool ApplyOpenGlEnvironment();
+  };
+}
+
+#endif
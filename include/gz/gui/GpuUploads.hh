@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_GPUUPLOADS_HH_
+#define GZ_GUI_GPUUPLOADS_HH_
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Frustum.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+    /// \brief Data one plugin has staged for the GPU, such as the points of
+    /// a cloud or the pixels of a texture, to be uploaded by the render
+    /// thread within a shared per frame budget, so a burst of large
+    /// messages is spread over several frames instead of stalling one.
+    ///
+    /// Each upload is a function called on the render thread, which owns
+    /// the staged data and makes the rendering calls copying it to the GPU,
+    /// along with its size in bytes and, optionally, the world box it
+    /// covers. Uploads within the camera's view, and those without a box,
+    /// go first. Uploads pushed with the same key replace the pending one,
+    /// so only the latest data of something which changes often is staged.
+    ///
+    /// Plugins which must upload in the order their messages came, such as
+    /// MarkerManager, can upload directly instead, while
+    /// GpuUploads::BudgetLeft is above zero, and record what they uploaded
+    /// with Uploaded.
+    ///
+    /// Destroying the queue drops its pending uploads. If one of them is
+    /// running on the render thread at that moment, the destructor waits
+    /// for it to return, so it's safe for uploads to capture the object
+    /// owning the queue. Make the queue one of the last members of that
+    /// object, so it's destroyed before the data its uploads use.
+    class GZ_GUI_VISIBLE GpuUploadQueue
+    {
+      /// \brief Signature of uploads, which are called on the render thread
+      /// and may make rendering calls
+      public: using Upload = std::function<void()>;
+
+      /// \brief Constructor
+      /// \param[in] _owner Name the uploads' time, size and number pending
+      /// are reported under by PerformanceCounters, usually the plugin's
+      /// class name. Not measured if empty.
+      public: explicit GpuUploadQueue(const std::string &_owner = "");
+
+      /// \brief Destructor. Drops pending uploads.
+      public: ~GpuUploadQueue();
+
+      /// \brief Stage an upload. Thread safe.
+      /// \param[in] _bytes Bytes the upload copies to the GPU
+      /// \param[in] _upload Upload
+      /// \param[in] _bounds World box covered by the uploaded data, used to
+      /// upload what the camera sees first. Unset if unknown.
+      public: void Push(std::size_t _bytes, Upload _upload,
+          const std::optional<math::AxisAlignedBox> &_bounds = std::nullopt);
+
+      /// \brief Stage an upload, replacing the pending one pushed with the
+      /// same key, which keeps its place in the order. Thread safe.
+      /// \param[in] _key Identifies what the upload changes, such as a tile
+      /// of a map
+      /// \param[in] _bytes Bytes the upload copies to the GPU
+      /// \param[in] _upload Upload
+      /// \param[in] _bounds World box covered by the uploaded data, unset if
+      /// unknown
+      public: void PushLatest(const std::string &_key, std::size_t _bytes,
+          Upload _upload,
+          const std::optional<math::AxisAlignedBox> &_bounds = std::nullopt);
+
+      /// \brief Record bytes uploaded directly on the render thread, without
+      /// going through the queue. They're taken from the frame's budget and
+      /// reported along with the queued uploads.
+      /// \param[in] _bytes Bytes uploaded
+      public: void Uploaded(std::size_t _bytes);
+
+      /// \brief Drop all pending uploads. If one of them is running on the
+      /// render thread, waits for it to return, so the data uploads use can
+      /// be released once this returns. Thread safe, but mustn't be called
+      /// while holding a lock uploads take.
+      public: void Clear();
+
+      /// \brief Number of uploads waiting to run. Thread safe.
+      /// \return Upload count
+      public: std::size_t Size() const;
+
+      /// \brief Bytes of the uploads waiting to run. Thread safe.
+      /// \return Staged bytes
+      public: std::size_t PendingBytes() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+
+    /// \brief Runs the uploads staged in all GpuUploadQueue, in one place
+    /// on the render thread, up to a number of bytes per frame.
+    class GZ_GUI_VISIBLE GpuUploads
+    {
+      /// \brief Start a frame and run pending uploads until its budget is
+      /// used up: first those within the view, then the others, each in the
+      /// order they were pushed. Uploads which waited for many frames count
+      /// as within the view, so they aren't put off forever. If some are
+      /// left, another frame is requested. Meant to be called once per
+      /// frame by plugins which own a render thread, like MinimalScene,
+      /// before the render hooks.
+      /// \param[in] _budget Bytes after which no more uploads are started
+      /// this frame. At least one upload runs per call. Zero runs all of
+      /// them.
+      /// \return Number of uploads run
+      public: static std::size_t Run(std::size_t _budget);
+
+      /// \brief Set the view of the camera, whose uploads go first. Called
+      /// from the render thread before Run.
+      /// \param[in] _frustum Camera frustum in the world, unset to treat
+      /// all uploads the same
+      public: static void SetView(
+          const std::optional<math::Frustum> &_frustum);
+
+      /// \brief Bytes left of the current frame's budget, for plugins
+      /// uploading directly. Called from the render thread.
+      /// \return Bytes, the largest size_t if there's no limit
+      public: static std::size_t BudgetLeft();
+
+      /// \brief Number of uploads waiting to run in all queues. Thread
+      /// safe.
+      /// \return Upload count
+      public: static std::size_t PendingCount();
+
+      /// \brief Bytes of the uploads waiting to run in all queues. Thread
+      /// safe.
+      /// \return Staged bytes
+      public: static std::size_t PendingBytes();
+    };
+}  // namespace gz::gui
+#endif  // GZ_GUI_GPUUPLOADS_HH_
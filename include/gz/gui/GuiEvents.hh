@@ -40,6 +40,8 @@ namespace gz::gui::events
       /// \brief Event called in the render thread of a 3D scene after the user
       /// camera has rendered.
       /// It's safe to make rendering calls in this event's callback.
+      /// The scene sends the same instance every frame, so handlers must not
+      /// keep pointers to it or delete it.
       class Render : public QEvent
       {
         public: Render()
@@ -469,6 +471,8 @@ namespace gz::gui::events
       /// \brief Event called in the render thread of a 3D scene, before the
       /// user camera is rendered.
       /// It's safe to make rendering calls in this event's callback.
+      /// The scene sends the same instance every frame, so handlers must not
+      /// keep pointers to it or delete it.
       class GZ_GUI_VISIBLE PreRender : public QEvent
       {
         /// \brief Constructor
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_LATENCYTRACE_HH_
+#define GZ_GUI_LATENCYTRACE_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Traces how long msgs take from their reception, and from their
+  /// header stamp, to the window frame which shows them.
+  ///
+  /// A span begins when a msg is received, and its tag is carried along
+  /// with the msg through the plugin's queues. Once the msg is applied, the
+  /// span is held on a channel, such as "scene" for the 3D scene or
+  /// "window" for what's drawn by QML. When the channel's next frame is
+  /// rendered, and then handed to the window, the span waits for the
+  /// window's next buffer swap, which closes it:
+  ///
+  /// * Hold: the msg is applied, waiting for the channel's next frame
+  /// * Rendered: the channel rendered a frame with the held msgs
+  /// * Ready: the window took the rendered frame
+  /// * FrameSwapped: the window frame is on screen
+  ///
+  /// Latencies are kept in histograms per stream, and spans can be written
+  /// in the Chrome trace event format, to be opened with chrome://tracing
+  /// or Perfetto.
+  ///
+  /// Nothing is recorded until the trace is enabled, and calls with empty
+  /// tags return right away. Safe to call from any thread.
+  class GZ_GUI_VISIBLE LatencyTrace
+  {
+    /// \brief Clock of the span times
+    public: using Clock = std::chrono::steady_clock;
+
+    /// \brief Identifies a span while it's open, carried along with the
+    /// msg
+    public: class Tag
+    {
+      /// \brief Whether the tag belongs to a span
+      /// \return False for tags given while the trace isn't enabled
+      public: bool Valid() const
+      {
+        return this->id != 0;
+      }
+
+      /// \brief Span id, 0 if none
+      public: std::uint64_t id{0};
+    };
+
+    /// \brief Latencies of a stream, in milliseconds
+    public: struct Summary
+    {
+      /// \brief Number of spans closed
+      std::size_t count{0};
+
+      /// \brief Mean latency
+      double mean{0.0};
+
+      /// \brief Median, from the histogram
+      double p50{0.0};
+
+      /// \brief 90th percentile, from the histogram
+      double p90{0.0};
+
+      /// \brief 99th percentile, from the histogram
+      double p99{0.0};
+
+      /// \brief Highest latency
+      double max{0.0};
+    };
+
+    /// \brief Constructor
+    public: LatencyTrace();
+
+    /// \brief Destructor
+    public: ~LatencyTrace();
+
+    /// \brief Set whether spans are recorded
+    /// \param[in] _enabled True to record
+    public: void SetEnabled(bool _enabled);
+
+    /// \brief Get whether spans are recorded
+    /// \return True if recording
+    public: bool Enabled() const;
+
+    /// \brief Begin a span, when a msg is received
+    /// \param[in] _stream Name of the stream, such as "poses /world/pose"
+    /// \param[in] _stamp Header stamp of the msg, in seconds since the
+    /// epoch, 0 or less if it has none. Only wall clock stamps give
+    /// meaningful stamp latencies.
+    /// \return Tag to carry along with the msg, empty if not recording
+    public: Tag Begin(const std::string &_stream, double _stamp);
+
+    /// \brief Record the time a span reached a stage, such as "decoded"
+    /// \param[in] _tag Tag of the span
+    /// \param[in] _stage Stage name, which must outlive the trace, such as
+    /// a string literal
+    public: void Stage(const Tag &_tag, const char *_stage);
+
+    /// \brief Close a span without recording it, such as when its msg is
+    /// dropped or replaced
+    /// \param[in] _tag Tag of the span
+    public: void Drop(const Tag &_tag);
+
+    /// \brief Hold a span until the next frame of a channel is shown,
+    /// once its msg is applied
+    /// \param[in] _tag Tag of the span
+    /// \param[in] _channel Channel, such as "scene" or "window"
+    public: void Hold(const Tag &_tag, const std::string &_channel);
+
+    /// \brief Notify that a channel rendered a frame, which includes the
+    /// spans held until now
+    /// \param[in] _channel Channel
+    public: void Rendered(const std::string &_channel);
+
+    /// \brief Notify that the window took the latest rendered frame of a
+    /// channel, to show it on its next buffer swap
+    /// \param[in] _channel Channel
+    public: void Ready(const std::string &_channel);
+
+    /// \brief Notify that the window swapped its buffers, closing the
+    /// spans whose frames were ready
+    public: void FrameSwapped();
+
+    /// \brief Get the number of open spans
+    /// \return Spans begun and not closed or dropped yet
+    public: std::size_t OpenCount() const;
+
+    /// \brief Get the latencies of a stream
+    /// \param[in] _stream Name of the stream
+    /// \param[in] _fromStamp True for the latencies from the header stamps,
+    /// false for those from the reception
+    /// \return Latencies, with a zero count if there are none
+    public: Summary Latencies(const std::string &_stream,
+        bool _fromStamp = false) const;
+
+    /// \brief Get the latency histograms as CSV, with a
+    /// "stream,from,upper_ms,count" header and a row per non-empty bucket.
+    /// "from" is "receive" or "stamp".
+    /// \return CSV text
+    public: std::string Histograms() const;
+
+    /// \brief Get the closed spans in the Chrome trace event format, one
+    /// track per stream, with the stage times as arguments
+    /// \return JSON text
+    public: std::string ChromeTrace() const;
+
+    /// \brief Write the Chrome trace to a file, and the histograms next to
+    /// it, with ".histograms.csv" appended to the path
+    /// \param[in] _path Path of the trace file
+    /// \return True if both files were written
+    public: bool Write(const std::string &_path) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_LATESTVALUE_HH_
+#define GZ_GUI_LATESTVALUE_HH_
+
+#include <mutex>
+#include <utility>
+
+namespace gz::gui
+{
+    /// \brief Holds the latest value received on one thread, such as a
+    /// transport callback, until another thread, usually the GUI thread,
+    /// takes it. Values set in between replace each other.
+    ///
+    /// Set returns true only if the consumer has taken the previous value,
+    /// so there's at most one wake up waiting for the consumer at a time,
+    /// however fast values arrive. For example, to update properties from a
+    /// 1 kHz stream at the rate the GUI thread gets to it:
+    ///
+    ///     // Transport thread
+    ///     if (this->stats.Set(_msg))
+    ///       QMetaObject::invokeMethod(this, "ProcessMsg",
+    ///           Qt::QueuedConnection);
+    ///
+    ///     // GUI thread
+    ///     if (this->stats.Take(this->msg))
+    ///       this->SetSimTime(...);
+    ///
+    /// The lock is only held to swap the value in and out, so neither
+    /// side waits on the other's conversions, and nothing is copied while
+    /// it's held. Protobuf messages swap their contents without allocating.
+    /// \tparam T Value type, which must be swappable and default
+    /// constructible
+    template <typename T>
+    class LatestValue
+    {
+      /// \brief Replace the value. Thread safe.
+      /// \param[in] _value New value
+      /// \return True if the previous value had been taken, so the consumer
+      /// should be told there's a new one
+      public: bool Set(T _value)
+      {
+        bool wake;
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          using std::swap;
+          swap(this->value, _value);
+          wake = !this->fresh;
+          this->fresh = true;
+        }
+        // The replaced value is destroyed here, outside the lock
+        return wake;
+      }
+
+      /// \brief Take the value, if it's been set since last taken.
+      /// Thread safe.
+      /// \param[out] _value Set to the latest value. Its previous contents
+      /// are swapped into the helper, to be reused by the next Set.
+      /// \return True if there was a new value
+      public: bool Take(T &_value)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->fresh)
+          return false;
+        using std::swap;
+        swap(this->value, _value);
+        this->fresh = false;
+        return true;
+      }
+
+      /// \brief Whether a value has been set since last taken. Thread safe.
+      /// \return True if Take would return a value
+      public: bool HasValue() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->fresh;
+      }
+
+      /// \brief Protects all members
+      private: mutable std::mutex mutex;
+
+      /// \brief Latest value, or a stale buffer once taken
+      private: T value{};
+
+      /// \brief True if `value` hasn't been taken yet
+      private: bool fresh{false};
+    };
+}  // namespace gz::gui
+#endif  // GZ_GUI_LATESTVALUE_HH_
@@ -60,6 +60,20 @@ namespace gz::gui
         NOTIFY PluginCountChanged
       )
 
+      /// \brief Fraction of the config's plugins loaded, 1 when done
+      Q_PROPERTY(
+        double loadProgress
+        READ LoadProgress
+        NOTIFY LoadProgressChanged
+      )
+
+      /// \brief Whether the window can be seen
+      Q_PROPERTY(
+        bool exposed
+        READ Exposed
+        NOTIFY ExposedChanged
+      )
+
       /// \brief Material theme (Light / Dark)
       Q_PROPERTY(
         QString materialTheme
@@ -252,6 +266,14 @@ namespace gz::gui
       /// \param[in] _path The full destination path including filename.
       public: void SaveConfig(const std::string &_path);
 
+      /// \brief Save the current window and plugin configuration to a file
+      /// on disk without waiting for it to be written. The configuration is
+      /// collected right away and written by a background thread, replacing
+      /// the file only once it's fully written. Failures are only logged.
+      /// \param[in] _path The full destination path including filename.
+      /// \sa SaveConfig
+      public: void SaveConfigInBackground(const std::string &_path);
+
       /// \brief Apply a WindowConfig to this window and keep a copy of it.
       /// \param[in] _config The configuration to apply.
       /// \return True if successful.
@@ -269,7 +291,9 @@ namespace gz::gui
       /// \param [in] _plugin Plugin filename
       public slots: void OnAddPlugin(QString _plugin);
 
-      /// \brief Return a list of all plugin names found
+      /// \brief Return a list of all plugin names found. The list is kept
+      /// until plugin directories change, plugin paths are added or a
+      /// config is applied, see PluginListModelChanged.
       /// \return List with plugin names
       public: Q_INVOKABLE QStringList PluginListModel() const;
 
@@ -283,6 +307,25 @@ namespace gz::gui
       /// \param[in] _pluginCount Number of plugins
       public: Q_INVOKABLE void SetPluginCount(const int _pluginCount);
 
+      /// \brief Get the fraction of the config's plugins which have been
+      /// loaded, while a config is loaded progressively.
+      /// \return Fraction, 1 when no config is being loaded
+      /// \sa Application::SetProgressiveLoad
+      public: double LoadProgress() const;
+
+      /// \brief Set the fraction of the config's plugins loaded.
+      /// \param[in] _progress Fraction, 1 when done
+      public: void SetLoadProgress(double _progress);
+
+      /// \brief Whether the window can be seen: it's shown, not minimized,
+      /// and the windowing system reports it as exposed, which it doesn't
+      /// on some platforms while it's on another virtual desktop or fully
+      /// covered. Cards suspend while their window isn't exposed, and
+      /// rendering and subscriptions may slow down.
+      /// \return True if exposed
+      /// \sa Plugin::Suspended, Application::SetHiddenMaxRate
+      public: bool Exposed() const;
+
       /// \brief Returns the material theme.
       /// \return Theme (Light / Dark)
       public: Q_INVOKABLE QString MaterialTheme() const;
@@ -493,6 +536,16 @@ namespace gz::gui
       /// \brief Notifies when the number of plugins has changed.
       signals: void PluginCountChanged();
 
+      /// \brief Notifies when the load progress has changed.
+      signals: void LoadProgressChanged();
+
+      /// \brief Notifies when the window is exposed or hidden.
+      signals: void ExposedChanged();
+
+      /// \brief Notifies when the list returned by PluginListModel has
+      /// changed.
+      signals: void PluginListModelChanged();
+
       /// \brief Notifies when the theme has changed.
       signals: void MaterialThemeChanged();
 
@@ -573,6 +626,24 @@ namespace gz::gui
       /// appear
       signals: void notifyWithDuration(const QString &_message, int _duration);
 
+      /// \brief Install an event filter on the window, like
+      /// QObject::installEventFilter, also measuring the time the filter
+      /// spends on events::Render and events::PreRender when
+      /// PerformanceCounters are enabled. This hides the QObject function,
+      /// so filters installed through a QObject pointer aren't measured.
+      /// \param[in] _filter Filter object
+      public: void installEventFilter(QObject *_filter);
+
+      /// \brief Remove an event filter, like QObject::removeEventFilter
+      /// \param[in] _filter Filter object
+      public: void removeEventFilter(QObject *_filter);
+
+      /// \brief Publishes the events sent to the window on the EventBus,
+      /// after the event filters installed on it have seen them.
+      /// \param[in] _event Event
+      /// \return True if the event was handled
+      protected: bool event(QEvent *_event) override;
+
       /// \internal
       /// \brief Private data pointer
       /// Private is necessary here for the Qt MOC
@@ -609,6 +680,10 @@ namespace gz::gui
       /// \brief Window height in px
       int height{-1};
 
+      /// \brief Seconds between automatic saves of the configuration to the
+      /// default config path, 0 to disable them
+      double autosaveInterval{0.0};
+
       /// \brief Window state (dock configuration)
       QByteArray state;
 
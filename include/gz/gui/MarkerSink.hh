@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_MARKERSINK_HH_
+#define GZ_GUI_MARKERSINK_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/marker.pb.h>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Points of a marker, set without going through one msg per
+  /// point. Same as the MarkerManager plugin's bulk service, without the
+  /// packing.
+  struct MarkerPoints
+  {
+    /// \brief Marker namespace
+    std::string ns;
+
+    /// \brief Marker id, must not be 0
+    uint64_t id{0};
+
+    /// \brief POINTS, LINE_LIST, LINE_STRIP or TRIANGLE_LIST. Unset for
+    /// POINTS on new markers and to keep the current type otherwise.
+    std::optional<msgs::Marker::Type> type;
+
+    /// \brief Point size, unset to keep the current one
+    std::optional<double> size;
+
+    /// \brief Index of the first point overwritten, points past the end are
+    /// appended, at a cost proportional to the points given. Unset to
+    /// replace all of the marker's points.
+    std::optional<std::size_t> offset;
+
+    /// \brief Points, in the marker's frame
+    std::vector<math::Vector3d> points;
+
+    /// \brief Color of each point in `points`. Points without a color are
+    /// white.
+    std::vector<math::Color> colors;
+  };
+
+  /// \brief Draws markers for plugins in the same process, without the
+  /// serialization of the `/marker` services. The MarkerManager plugin
+  /// shares one through SceneServices:
+  ///
+  ///     auto markers = SceneServices::Get<MarkerSink>(
+  ///         SceneServices::kMarkers);
+  ///     if (markers)
+  ///       markers->Submit(std::move(markerMsg));
+  ///     else
+  ///       node.Request("/marker", markerMsg);
+  ///
+  /// Markers are queued and applied on the render thread, in the order they
+  /// were submitted, along with the ones received by the services. All
+  /// functions are thread safe. Once the MarkerManager is unloaded, they
+  /// return false. Arguments are only moved from when accepted, so callers
+  /// can fall back to the services with them.
+  class GZ_GUI_VISIBLE MarkerSink
+  {
+    /// \brief Destructor
+    public: virtual ~MarkerSink() = default;
+
+    /// \brief Queue a marker msg, same as the `/marker` service
+    /// \param[in] _msg Msg, moved into the queue
+    /// \return False if no MarkerManager is loaded anymore
+    public: virtual bool Submit(msgs::Marker &&_msg) = 0;
+
+    /// \brief Queue marker msgs, same as the `/marker_array` service
+    /// \param[in] _msgs Msgs, moved into the queue
+    /// \return False if no MarkerManager is loaded anymore
+    public: virtual bool Submit(std::vector<msgs::Marker> &&_msgs) = 0;
+
+    /// \brief Queue new points for a marker, creating it if needed
+    /// \param[in] _points Points, moved into the queue
+    /// \return False if the points are invalid, or no MarkerManager is
+    /// loaded anymore
+    public: virtual bool SetPoints(MarkerPoints &&_points) = 0;
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_MARKERSINK_HH_
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_MEMORYACCOUNTING_HH_
+#define GZ_GUI_MEMORYACCOUNTING_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Where accounted memory lives
+  enum class MemoryType
+  {
+    /// \brief Host memory, such as msg copies and images
+    CPU,
+
+    /// \brief Graphics memory, such as render textures and meshes created
+    /// through gz-rendering
+    GPU
+  };
+
+  /// \brief Memory held by one part of a plugin, such as the msgs buffered
+  /// by TopicEcho. The account stays registered with MemoryAccounting for
+  /// as long as it's alive, and its bytes stop counting once it's
+  /// destroyed, so it's usually a member of the plugin's private data.
+  ///
+  /// Updating the bytes is lock free, so it's cheap to do from transport
+  /// and render threads for every msg or frame.
+  class GZ_GUI_VISIBLE MemoryAccount
+  {
+    /// \brief Constructor
+    /// \param[in] _owner Name the memory is reported under, usually the
+    /// plugin's class name, such as "TopicEcho". Budgets are set per owner.
+    /// \param[in] _category What the memory holds, such as "msgs"
+    /// \param[in] _type Where the memory lives
+    public: MemoryAccount(const std::string &_owner,
+        const std::string &_category, MemoryType _type = MemoryType::CPU);
+
+    /// \brief Destructor, unregisters the account
+    public: ~MemoryAccount();
+
+    /// \brief Set the number of bytes held
+    /// \param[in] _bytes Bytes
+    public: void Set(std::size_t _bytes);
+
+    /// \brief Add to the number of bytes held
+    /// \param[in] _bytes Bytes allocated
+    public: void Add(std::size_t _bytes);
+
+    /// \brief Subtract from the number of bytes held, stopping at zero
+    /// \param[in] _bytes Bytes released
+    public: void Remove(std::size_t _bytes);
+
+    /// \brief Get the number of bytes held
+    /// \return Bytes
+    public: std::size_t Bytes() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+
+  /// \brief Registry of the memory reported by plugins through
+  /// MemoryAccount, so it's possible to tell which plugin is responsible
+  /// when the GUI grows. The MemoryStats plugin displays it and publishes it
+  /// on a topic.
+  ///
+  /// Budgets can be set per owner. Exceeding one only produces a warning,
+  /// plugins which can shed memory, such as by dropping buffered msgs, may
+  /// check OverBudget and act on it.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE MemoryAccounting
+  {
+    /// \brief Memory held by all accounts sharing an owner, category and
+    /// type
+    public: struct Usage
+    {
+      /// \brief Owner, such as "TopicEcho"
+      std::string owner;
+
+      /// \brief Category, such as "msgs"
+      std::string category;
+
+      /// \brief Where the memory lives
+      MemoryType type{MemoryType::CPU};
+
+      /// \brief Bytes held
+      std::size_t bytes{0};
+
+      /// \brief Number of accounts summed up
+      std::size_t accounts{0};
+    };
+
+    /// \brief Get the memory currently reported, sorted by owner, category
+    /// and type
+    /// \return Usage of each owner, category and type
+    public: static std::vector<Usage> Snapshot();
+
+    /// \brief Get the memory held by all accounts of an owner
+    /// \param[in] _owner Owner
+    /// \return Bytes, both CPU and GPU
+    public: static std::size_t OwnerBytes(const std::string &_owner);
+
+    /// \brief Get the memory held by all accounts
+    /// \param[in] _type Where the memory lives
+    /// \return Bytes
+    public: static std::size_t TotalBytes(MemoryType _type);
+
+    /// \brief Set the most memory an owner is expected to hold, CPU and GPU
+    /// combined.
+    /// \param[in] _owner Owner
+    /// \param[in] _bytes Budget in bytes, 0 to remove it
+    public: static void SetBudget(const std::string &_owner,
+        std::size_t _bytes);
+
+    /// \brief Get the budget of an owner
+    /// \param[in] _owner Owner
+    /// \return Budget in bytes, 0 if it has none
+    public: static std::size_t Budget(const std::string &_owner);
+
+    /// \brief Check whether an owner holds more memory than its budget
+    /// \param[in] _owner Owner
+    /// \return True if it has a budget and exceeds it
+    public: static bool OverBudget(const std::string &_owner);
+
+    /// \brief Get a string such as "1.5 MiB" for a number of bytes
+    /// \param[in] _bytes Bytes
+    /// \return Human readable size
+    public: static std::string FormatBytes(std::size_t _bytes);
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_MEMORYACCOUNTING_HH_
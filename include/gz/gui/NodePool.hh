@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_NODEPOOL_HH_
+#define GZ_GUI_NODEPOOL_HH_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Transport nodes shared by all plugins of an application,
+  /// through Application::Nodes, one per namespace, so plugins don't each
+  /// create nodes of their own.
+  ///
+  /// Each owner, usually a plugin, has a namespace, empty by default, and
+  /// gets the node of its namespace. Plugins take theirs from the
+  /// `<transport_namespace>` element of their `<gz-gui>` block. Relative
+  /// topics and services are resolved in the owner's namespace.
+  ///
+  /// Topics and services are advertised on behalf of their owner, and
+  /// released together when the owner is unloaded, see Release. Owners
+  /// advertising the same topic and type in the same namespace share the
+  /// publisher.
+  ///
+  /// The shared nodes are only for advertising, one-way requests and
+  /// discovery queries. Subscribe through Application::Subscriptions, and
+  /// make requests with replies through Application::Requests, which end
+  /// the subscriptions and requests of each owner separately.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE NodePool
+  {
+    /// \brief Constructor
+    public: NodePool();
+
+    /// \brief Destructor. The nodes are destroyed, ending all their
+    /// advertisements.
+    public: ~NodePool();
+
+    /// \brief Set the namespace of an owner. Only topics and services
+    /// advertised afterwards use it.
+    /// \param[in] _owner Owner, usually a plugin
+    /// \param[in] _namespace Namespace, such as "/robot1", empty for none
+    /// \return False if the namespace isn't valid, the owner keeps its
+    /// namespace then
+    public: bool SetNamespace(const void *_owner,
+        const std::string &_namespace);
+
+    /// \brief Get the namespace of an owner
+    /// \param[in] _owner Owner
+    /// \return Namespace, empty by default
+    public: std::string Namespace(const void *_owner) const;
+
+    /// \brief Get the node of an owner's namespace, created on the first
+    /// call. Don't subscribe or unadvertise through it, the node is shared
+    /// with the other owners of the namespace.
+    /// \param[in] _owner Owner, null for the node without a namespace
+    /// \return Node, valid until the pool is destroyed
+    public: transport::Node &Node(const void *_owner = nullptr);
+
+    /// \brief Advertise a topic on behalf of an owner
+    /// \param[in] _owner Owner
+    /// \param[in] _topic Topic, relative to the owner's namespace
+    /// \param[in] _msgType Msg type, such as "gz.msgs.Pose"
+    /// \param[in] _options Options, only used by the first owner
+    /// advertising the topic
+    /// \return Publisher, invalid if the topic couldn't be advertised. The
+    /// topic stays advertised until all its owners released it.
+    public: transport::Node::Publisher Advertise(const void *_owner,
+        const std::string &_topic, const std::string &_msgType,
+        const transport::AdvertiseMessageOptions &_options =
+            transport::AdvertiseMessageOptions());
+
+    /// \brief Advertise a topic of msgs of type T on behalf of an owner
+    /// \param[in] _owner Owner
+    /// \param[in] _topic Topic, relative to the owner's namespace
+    /// \param[in] _options Options
+    /// \return Publisher, see Advertise
+    public: template<typename T>
+            transport::Node::Publisher Advertise(const void *_owner,
+                const std::string &_topic,
+                const transport::AdvertiseMessageOptions &_options =
+                    transport::AdvertiseMessageOptions())
+    {
+      return this->Advertise(_owner, _topic, std::string(T().GetTypeName()),
+          _options);
+    }
+
+    /// \brief Advertise a service on behalf of an owner. The arguments
+    /// after the service name are those of transport::Node::Advertise,
+    /// such as a callback, or a member function and its object.
+    /// \param[in] _owner Owner
+    /// \param[in] _service Service, relative to the owner's namespace
+    /// \param[in] _args Callback and options
+    /// \return False if the service couldn't be advertised
+    public: template<typename... Args>
+            bool AdvertiseService(const void *_owner,
+                const std::string &_service, Args &&..._args)
+    {
+      return this->AdvertiseServiceWith(_owner, _service,
+          [&](transport::Node &_node)
+          {
+            return _node.Advertise(_service, std::forward<Args>(_args)...);
+          });
+    }
+
+    /// \brief Stop advertising the topics and services of an owner, and
+    /// forget its namespace. Plugins are released when they're unloaded.
+    /// \param[in] _owner Owner
+    public: void Release(const void *_owner);
+
+    /// \brief Get the number of nodes created
+    /// \return One per namespace used
+    public: std::size_t NodeCount() const;
+
+    /// \brief Advertise a service on the node of an owner's namespace
+    /// \param[in] _owner Owner
+    /// \param[in] _service Service, relative to the owner's namespace
+    /// \param[in] _advertise Advertises the service on the node
+    /// \return Result of `_advertise`
+    private: bool AdvertiseServiceWith(const void *_owner,
+        const std::string &_service,
+        const std::function<bool(transport::Node &)> &_advertise);
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_PERFORMANCECOUNTERS_HH_
+#define GZ_GUI_PERFORMANCECOUNTERS_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Time spent by one plugin in one kind of callback, such as
+  /// TapeMeasure handling events::Render. The counter stays registered with
+  /// PerformanceCounters for as long as it's alive.
+  ///
+  /// Adding samples is lock free. Callers should only measure time while
+  /// PerformanceCounters::Enabled is true, so nothing is spent on it
+  /// otherwise; PerformanceTimer does that.
+  class GZ_GUI_VISIBLE PerformanceCounter
+  {
+    /// \brief Constructor
+    /// \param[in] _owner Name the time is reported under, usually the
+    /// plugin's class name, such as "TapeMeasure"
+    /// \param[in] _source Kind of callback, such as "render event"
+    public: PerformanceCounter(const std::string &_owner,
+        const std::string &_source);
+
+    /// \brief Destructor, unregisters the counter
+    public: ~PerformanceCounter();
+
+    /// \brief Add the duration of one call
+    /// \param[in] _time Time spent
+    public: void AddTime(std::chrono::steady_clock::duration _time);
+
+    /// \brief Count a call which took longer than its time budget, such as
+    /// a RenderHooks frame task
+    public: void AddOverrun();
+
+    /// \brief Set the number of items waiting to be processed, for callbacks
+    /// which queue work, such as received msgs waiting for the GUI thread
+    /// \param[in] _depth Queued items
+    public: void SetQueueDepth(std::size_t _depth);
+
+    /// \brief Add bytes transferred, for callbacks which move data, such as
+    /// GpuUploadQueue uploads
+    /// \param[in] _bytes Bytes transferred
+    public: void AddBytes(std::size_t _bytes);
+
+    /// \brief Get the owner and source, such as "TapeMeasure render
+    /// event", as reported by StallWatchdog
+    /// \return Name, valid until the process exits
+    public: const char *Name() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+
+  /// \brief Measures the time from its construction to its destruction into
+  /// a counter, if PerformanceCounters were enabled when it was constructed.
+  /// On threads watched by StallWatchdog, the counter's name is reported
+  /// with the stalls the timer spans.
+  class GZ_GUI_VISIBLE PerformanceTimer
+  {
+    /// \brief Constructor, starting the measurement
+    /// \param[in] _counter Counter receiving the time, which must outlive
+    /// the timer
+    public: explicit PerformanceTimer(PerformanceCounter &_counter);
+
+    /// \brief Destructor, adding the time to the counter
+    public: ~PerformanceTimer();
+
+    /// \brief No copies, each timer measures once
+    public: PerformanceTimer(const PerformanceTimer &) = delete;
+
+    /// \brief No copies, each timer measures once
+    public: PerformanceTimer &operator=(const PerformanceTimer &) = delete;
+
+    /// \brief Counter receiving the time
+    private: PerformanceCounter &counter;
+
+    /// \brief Start time, unset if counters were disabled
+    private: std::optional<std::chrono::steady_clock::time_point> start;
+  };
+
+  /// \brief Registry of the time plugins spend in callbacks called by
+  /// gz-gui: render hooks, events::Render and events::PreRender event
+  /// filters on the main window, and SubscriptionHub callbacks. The
+  /// PerformanceMonitor plugin displays it, to find which plugin eats the
+  /// frame budget.
+  ///
+  /// Nothing is measured until counters are enabled, and once enabled the
+  /// cost is a clock read per callback and a few atomic additions.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE PerformanceCounters
+  {
+    /// \brief Calls counted since the previous sample, summed for all
+    /// counters sharing an owner and source
+    public: struct Sample
+    {
+      /// \brief Owner, such as "TapeMeasure"
+      std::string owner;
+
+      /// \brief Kind of callback, such as "render event"
+      std::string source;
+
+      /// \brief Number of calls
+      std::uint64_t calls{0};
+
+      /// \brief Total time of the calls
+      std::chrono::steady_clock::duration total{0};
+
+      /// \brief Longest call
+      std::chrono::steady_clock::duration max{0};
+
+      /// \brief Last queue depth set, summed over the counters
+      std::size_t queueDepth{0};
+
+      /// \brief Number of calls over their time budget
+      std::uint64_t overruns{0};
+
+      /// \brief Bytes transferred
+      std::uint64_t bytes{0};
+    };
+
+    /// \brief Enable or disable measurements. Each call enabling them must
+    /// be matched by one disabling them, so several monitors can be active.
+    /// \param[in] _enabled True to enable
+    public: static void SetEnabled(bool _enabled);
+
+    /// \brief Check whether measurements are enabled
+    /// \return True if enabled
+    public: static bool Enabled();
+
+    /// \brief Get the calls counted since the previous call to this
+    /// function and reset the counters, sorted by owner and source.
+    /// Counters without calls, queued items nor bytes are left out.
+    /// \return Samples
+    public: static std::vector<Sample> TakeSamples();
+
+    /// \brief Get an owner name from a class name, without its namespaces,
+    /// such as "TapeMeasure" for "gz::gui::plugins::TapeMeasure"
+    /// \param[in] _className Class name
+    /// \return Owner name
+    public: static std::string OwnerName(const std::string &_className);
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_PERFORMANCECOUNTERS_HH_
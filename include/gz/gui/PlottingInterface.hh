@@ -17,10 +17,16 @@
 #ifndef GZ_GUI_PLOTTINGINTERFACE_HH_
 #define GZ_GUI_PLOTTINGINTERFACE_HH_
 
+#include <QColor>
 #include <QObject>
+#include <QPointF>
+#include <QQuickItem>
+#include <QRectF>
 #include <QString>
 #include <QMap>
 #include <QVariant>
+#include <QVariantList>
+#include <QVariantMap>
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4251)
@@ -30,11 +36,14 @@
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
 #include <memory>
 #include <limits>
+#include <vector>
 
 #include "gz/gui/Export.hh"
 
@@ -42,6 +51,69 @@
 
 namespace gz::gui
 {
+class RecordedSeries;
+class TimeSeries;
+
+/// \brief How the values of a plotted field are sampled when its msgs
+/// arrive faster than its sampling period
+enum class SamplingPolicy
+{
+  /// \brief Keep the first value of each period and drop the others
+  DECIMATE,
+
+  /// \brief Plot the average of the values received during each period
+  AVERAGE,
+
+  /// \brief Plot every value
+  KEEP_ALL
+};
+
+/// \brief Clock stamping the values of msgs without a header stamp. Msgs
+/// with a header stamp are always plotted at their stamp.
+enum class PlotClock
+{
+  /// \brief Seconds since the plotting interface was created
+  STEADY,
+
+  /// \brief Sim time published on a world statistics topic
+  SIM_TIME
+};
+
+/// \brief Component attribute plotted on a chart
+struct PlotComponentSubscription
+{
+  /// \brief Entity which has the component
+  uint64_t entity{0};
+
+  /// \brief Component type id
+  uint64_t typeId{0};
+
+  /// \brief Component data type
+  std::string type;
+
+  /// \brief Component specific attribute
+  std::string attribute;
+
+  /// \brief Chart ID
+  int chart{0};
+};
+
+/// \brief Value of a component attribute
+struct PlotComponentValue
+{
+  /// \brief Entity which has the component
+  uint64_t entity{0};
+
+  /// \brief Component type id
+  uint64_t typeId{0};
+
+  /// \brief Component specific attribute
+  std::string attribute;
+
+  /// \brief Value
+  double value{0.0};
+};
+
 /// \brief Plot Data containter to hold value and registered charts
 /// Can be a Field or a PlotComponent
 /// Used by PlottingInterface and Gazebo Plotting
@@ -117,6 +189,13 @@ class GZ_GUI_VISIBLE Topic : public QObject
   /// \return fields size
   public: int FieldCount() const;
 
+  /// \brief Set how a field is sampled, DECIMATE every 1/60 s by default.
+  /// \param[in] _fieldPath model path to the field as an ID
+  /// \param[in] _policy Sampling policy
+  /// \param[in] _period Sampling period in seconds, unused by KEEP_ALL
+  public: void SetSamplingPolicy(const std::string &_fieldPath,
+                                 SamplingPolicy _policy, double _period);
+
   /// \brief Get the registered fields
   /// \return Map of fields to their plots
   public: std::map<std::string, PlotData *> &Fields();
@@ -125,6 +204,15 @@ class GZ_GUI_VISIBLE Topic : public QObject
   /// \param[in] _msg the published msg from the topic
   public: void Callback(const google::protobuf::Message &_msg);
 
+  /// \brief Callback to receive serialized messages. Only the registered
+  /// fields are decoded, skipping over the rest of the message, so a few
+  /// fields of large messages can be plotted cheaply.
+  /// \param[in] _data the serialized msg
+  /// \param[in] _size size of the serialized msg
+  /// \param[in] _msgType msg type, such as "gz.msgs.Pose_V"
+  public: void RawCallback(const char *_data, std::size_t _size,
+                           const std::string &_msgType);
+
   /// \brief Check if msg has header field and get its time
   /// \param[in] _msg msg to check its header
   /// \param[out] _headerTime header sim time
@@ -135,6 +223,11 @@ class GZ_GUI_VISIBLE Topic : public QObject
   /// \param[in] _field field path or ID
   public: void UpdateGui(const std::string &_field);
 
+  /// \brief Send the values received since the last flush to the GUI, in
+  /// one batch per field and chart. Call it from the GUI thread, about once
+  /// per frame.
+  public: void FlushGui();
+
   /// \brief update the GUI and plot the topic's fields values
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
@@ -142,6 +235,12 @@ class GZ_GUI_VISIBLE Topic : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief update the GUI with all values of a field since the last flush
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _points QPointF of each value, in arrival order
+  signals: void plotBatch(int _chart, QString _fieldID, QVariantList _points);
+
   /// \brief update the current time with the default time of the plotting timer
   /// \param[in] _time current time of the plotting timer
   public: void SetPlottingTimeRef(const std::shared_ptr<double> &_time);
@@ -185,6 +284,28 @@ class GZ_GUI_VISIBLE Transport : public QObject
   /// \return Topics list
   public: const std::map<std::string, Topic*> &Topics();
 
+  /// \brief Set how a field is sampled, now or once it's subscribed
+  /// \param[in] _topic topic name
+  /// \param[in] _fieldPath field path ID
+  /// \param[in] _policy Sampling policy
+  /// \param[in] _period Sampling period in seconds
+  /// \sa Topic::SetSamplingPolicy
+  public: void SetSamplingPolicy(const std::string &_topic,
+                                 const std::string &_fieldPath,
+                                 SamplingPolicy _policy, double _period);
+
+  /// \brief Set the most messages per second received on each topic.
+  /// Messages above this rate are dropped by the transport subscription,
+  /// before they're delivered. Topics already subscribed are subscribed
+  /// again with the new rate.
+  /// \param[in] _rate Messages per second, 0 for all of them
+  /// \sa SubscriptionHub::Subscribe
+  public: void SetMaxRate(double _rate);
+
+  /// \brief Get the most messages per second received on each topic
+  /// \return Messages per second, 0 for all of them
+  public: double MaxRate() const;
+
   /// \brief Slot for receiving topics signal at each topic callback to plot
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
@@ -199,6 +320,16 @@ class GZ_GUI_VISIBLE Transport : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief Send the values received on all topics since the last flush
+  /// \sa Topic::FlushGui
+  public slots: void FlushGui();
+
+  /// \brief notify the Plotting Interface to plot several points
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _points QPointF of each value, in arrival order
+  signals: void plotBatch(int _chart, QString _fieldID, QVariantList _points);
+
   private:
   /// \brief Private data member.
   GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
@@ -238,6 +369,151 @@ class GZ_GUI_VISIBLE PlottingInterface : public QObject
   /// \return updating plot timeout
   public: float Timeout() const;
 
+  /// \brief Set the clock stamping msgs without a header stamp. The
+  /// steady clock is used by default.
+  /// \param[in] _clock Clock to use
+  /// \param[in] _statsTopic World statistics topic, such as
+  /// "/world/default/stats", for SIM_TIME
+  /// \return False if the clock couldn't be set
+  public: bool SetClock(PlotClock _clock,
+                        const std::string &_statsTopic = "");
+
+  /// \brief Set how a transport field is sampled
+  /// \param[in] _topic topic name
+  /// \param[in] _fieldPath field path ID
+  /// \param[in] _policy Sampling policy
+  /// \param[in] _period Sampling period in seconds
+  /// \sa Topic::SetSamplingPolicy
+  public: void SetSamplingPolicy(const std::string &_topic,
+                                 const std::string &_fieldPath,
+                                 SamplingPolicy _policy, double _period);
+
+  /// \brief Set the most messages per second received on each transport
+  /// topic
+  /// \param[in] _rate Messages per second, 0 for all of them
+  /// \sa Transport::SetMaxRate
+  public: void SetMaxRate(double _rate);
+
+  /// \brief Set how far back in time the plotted values are kept, for
+  /// current and future series.
+  /// \param[in] _window Time window in seconds, 0 to keep values
+  /// regardless of their time
+  /// \sa TimeSeries::SetRetention
+  public: void SetRetention(double _window);
+
+  /// \brief Set the most values kept per series, for current and future
+  /// series.
+  /// \param[in] _maxPoints Maximum number of values
+  /// \sa TimeSeries::SetMaxPoints
+  public: void SetMaxPoints(std::size_t _maxPoints);
+
+  /// \brief Set the time window of the statistics of each series, for
+  /// current and future series. Current statistics start over.
+  /// \param[in] _window Time window in seconds, 0 to include all values.
+  /// Defaults to 10.
+  /// \sa RollingStatistics
+  public: void SetStatisticsWindow(double _window);
+
+  /// \brief Get the statistics of a series over the statistics window,
+  /// updated as its values arrive
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \return "count", "mean", "variance", "stdDev", "rms", "min" and "max",
+  /// empty if there's no such series
+  public slots: QVariantMap statistics(int _chart, QString _fieldID) const;
+
+  /// \brief Compute the spectrum of a series as its values arrive. A
+  /// spectrum is computed on a worker thread every half window, skipping
+  /// windows while the previous one is computed, and `spectrumChanged` is
+  /// emitted once it's ready.
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \param[in] _size Values per window, rounded up to a power of two, 0 to
+  /// stop computing the spectrum
+  /// \sa Spectrum
+  public slots: void setSpectrum(int _chart, QString _fieldID, int _size);
+
+  /// \brief Get the latest spectrum of a series
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \return "sampleRate", "dominant" frequency and "amplitudes" from 0 to
+  /// half the sample rate, empty until a spectrum is ready
+  public slots: QVariantMap spectrum(int _chart, QString _fieldID) const;
+
+  /// \brief Notify that a new spectrum of a series is ready
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  signals: void spectrumChanged(int _chart, QString _fieldID);
+
+  /// \brief Get the stored values of a series, at full resolution
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \return QPointF of each value in time order, empty if there's no such
+  /// series
+  public: QVariantList Points(int _chart, const QString &_fieldID) const;
+
+  /// \brief Get a decimated view of a series, for a chart to draw
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \param[in] _xMin start of the time range
+  /// \param[in] _xMax end of the time range
+  /// \param[in] _buckets number of slices, such as the plot width in pixels
+  /// \return QPointF of the kept values in time order, empty if there's no
+  /// such series. Recordings are decimated too.
+  /// \sa TimeSeries::Decimated
+  public slots: QVariantList decimated(int _chart, QString _fieldID,
+                                       double _xMin, double _xMax,
+                                       int _buckets);
+
+  /// \brief Get the stored values of a series. They're only changed on
+  /// the GUI thread.
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \return The series, null if there's no such series
+  public: const TimeSeries *Series(int _chart,
+                                   const QString &_fieldID) const;
+
+  /// \brief Overlay a recorded series on a chart, such as a "bin" export
+  /// of a previous run. The file is mapped into memory rather than read, and
+  /// only the visible range is decimated, so recordings larger than the RAM
+  /// can be drawn next to the live series.
+  /// \param[in] _chart chart ID
+  /// \param[in] _path path or "file://" URL of a binary plot export
+  /// \return field ID of the recording, "recording-<path>", empty if the
+  /// file couldn't be mapped
+  /// \sa RecordedSeries
+  public slots: QString loadRecording(int _chart, QString _path);
+
+  /// \brief Stop overlaying a recording, unmapping its file
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field ID returned by loadRecording
+  public slots: void unloadRecording(int _chart, QString _fieldID);
+
+  /// \brief Get the time span of a recording overlaid on a chart
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field ID returned by loadRecording
+  /// \return time of the first point as x and of the last point as y,
+  /// (0, 0) if there's no such recording or it's empty
+  public slots: QPointF recordingSpan(int _chart, QString _fieldID) const;
+
+  /// \brief Get a recording overlaid on a chart
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field ID returned by loadRecording
+  /// \return The recording, null if there's no such recording
+  public: const RecordedSeries *Recording(int _chart,
+                                          const QString &_fieldID) const;
+
+  /// \brief Offer a recording to a chart, which loads it like a dropped
+  /// file. Used by plugins converting other recordings, such as logs.
+  /// \param[in] _chart chart ID
+  /// \param[in] _path path of a binary plot export
+  public: void OfferRecording(int _chart, const QString &_path);
+
+  /// \brief Notify the charts that a recording was offered
+  /// \param[in] _chart chart ID
+  /// \param[in] _path path of a binary plot export
+  signals: void recordingOffered(int _chart, QString _path);
+
   /// \brief slot to get triggered to plot a point and send its data to the UI
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
@@ -252,6 +528,13 @@ class GZ_GUI_VISIBLE PlottingInterface : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief plot several points to a chart at once. Transport fields are
+  /// delivered this way, once per frame.
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _points QPointF of each value, in arrival order
+  signals: void plotBatch(int _chart, QString _fieldID, QVariantList _points);
+
   /// \brief called by Qml to register a chart to a component attribute
   /// \param[in] _entity entity id which has the component
   /// \param[in] _typeId component type id
@@ -296,21 +579,98 @@ class GZ_GUI_VISIBLE PlottingInterface : public QObject
                                      const std::string &_attribute,
                                      int _chart);
 
+  /// \brief Register charts to many component attributes at once
+  /// \param[in] _subscriptions Component attributes and their charts
+  /// \sa ComponentSubscribeBatch
+  public: void SubscribeComponents(
+      const std::vector<PlotComponentSubscription> &_subscriptions);
+
+  /// \brief Remove charts from many component attributes at once, and
+  /// drop their stored values
+  /// \param[in] _subscriptions Component attributes and their charts. The
+  /// data types are ignored.
+  /// \sa ComponentUnSubscribeBatch
+  public: void UnsubscribeComponents(
+      const std::vector<PlotComponentSubscription> &_subscriptions);
+
+  /// \brief called by Qml to register a chart to many component attributes
+  /// \param[in] _components Map of each attribute, with the "entity",
+  /// "typeId", "type" and "attribute" strings
+  /// \param[in] _chart chart id
+  public slots: void onComponentSubscribeBatch(QVariantList _components,
+                                               int _chart);
+
+  /// \brief called by Qml to remove a chart from many component attributes
+  /// \param[in] _components Map of each attribute, with the "entity",
+  /// "typeId" and "attribute" strings
+  /// \param[in] _chart chart id
+  public slots: void onComponentUnSubscribeBatch(QVariantList _components,
+                                                 int _chart);
+
+  /// \brief Notify the gazebo plugin to subscribe to many component
+  /// attributes. Emitted instead of one ComponentSubscribe per attribute
+  /// when connected, so the plugin can update them in a single pass.
+  /// \param[in] _subscriptions Component attributes and their charts
+  signals: void ComponentSubscribeBatch(
+      const std::vector<PlotComponentSubscription> &_subscriptions);
+
+  /// \brief Notify the gazebo plugin to unsubscribe many component
+  /// attributes. Emitted instead of one ComponentUnSubscribe per attribute
+  /// when connected.
+  /// \param[in] _subscriptions Component attributes and their charts
+  signals: void ComponentUnSubscribeBatch(
+      const std::vector<PlotComponentSubscription> &_subscriptions);
+
+  /// \brief Plot a frame of component values, all at the same time. The
+  /// values of each series are sent to the charts in one plotBatch, instead
+  /// of a plot signal per value. Values of attributes which aren't
+  /// subscribed are skipped. Must be called on the GUI thread.
+  /// \param[in] _time Time of the values, such as the sim time in seconds
+  /// \param[in] _values Values of the subscribed attributes
+  public: void PlotComponents(double _time,
+                              const std::vector<PlotComponentValue> &_values);
+
   /// \brief Create suitable file path with unique name and extention
   /// \param[in] _path path selected from the UI
   /// \param[in] _name file name
-  /// \param[in] _extention file extention (csv or pdf)
+  /// \param[in] _extention file extention (csv, bin or pdf)
   public slots: std::string FilePath(QString _path, std::string _name,
                                      std::string _extention);
 
-  /// \brief export plot graphs to csv files
+  /// \brief export plot graphs to csv files. Series stored by the
+  /// interface are written at full resolution, the given points are only
+  /// used for the others.
   /// \param[in] _path path of folder to save the csv files
   /// \param[in] _chart plot id to make its name unique
   /// \param[in] _serieses serieses (graphs) of the plot
-  /// \return True if successfully export, False if any error
+  /// \return True if the export started, False if any error
+  /// \sa exportData
   public slots: bool exportCSV(QString _path, int _chart,
                                QMap< QString, QVariant> _serieses);
 
+  /// \brief export plot graphs to one file per graph, in the background.
+  /// The values are copied right away, and `exportFinished` is emitted
+  /// once all files are written.
+  ///
+  /// Formats:
+  /// * "csv": a "time, <name>" header then one "time, value" line per value
+  /// * "bin": columnar binary with host byte order doubles. The file starts
+  ///   with the 8 bytes "GZPLOT\0\1", then the uint32 length of the graph
+  ///   name, the name, the uint64 number of values N, N times and N values.
+  ///
+  /// \param[in] _path path of folder to save the files
+  /// \param[in] _chart plot id to make its name unique
+  /// \param[in] _serieses serieses (graphs) of the plot
+  /// \param[in] _format "csv" or "bin"
+  /// \return True if the export started, False if any error
+  public slots: bool exportData(QString _path, int _chart,
+                                QMap< QString, QVariant> _serieses,
+                                QString _format);
+
+  /// \brief Notify that a background export is done
+  /// \param[in] _success True if all files were written
+  signals: void exportFinished(bool _success);
+
   /// \brief Get Component Name based on its type Id
   /// \param[in] _typeId type Id of the component
   /// \return Component name
@@ -319,12 +679,119 @@ class GZ_GUI_VISIBLE PlottingInterface : public QObject
   /// \brief configration of the timer
   public: void InitTimer();
 
-  /// \brief update the plotting tool time
+  /// \brief update the plotting tool time from the steady clock
   public slots: void UpdateTime();
 
+  /// \brief send the transport values received since the last frame
+  public slots: void FlushGui();
+
+  /// \brief store transport values and forward them to the GUI
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _points QPointF of each value, in arrival order
+  public slots: void onPlotBatch(int _chart, QString _fieldID,
+                                 QVariantList _points);
+
   /// \brief Private data member.
   /// Private is necessary here for the Qt MOC
   private: GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
 };
+
+/// \brief Draws the series of a chart stored by a PlottingInterface, as
+/// `PlotLines` in the `GzPlotting 1.0` QML module.
+///
+/// Each series is decimated to the extremes of each pixel column with a
+/// DecimatedView, so only the columns which got new values are decimated
+/// again on each frame. Recordings don't change, so they're only decimated
+/// again when the range or the width changes. All series are drawn as 1
+/// pixel wide lines of a single geometry, in one draw call. Scrolling and
+/// zooming only change the transform, until new values arrive or the column
+/// width changes.
+class GZ_GUI_VISIBLE PlotLines : public QQuickItem
+{
+  Q_OBJECT
+
+  /// \brief PlottingInterface storing the series
+  Q_PROPERTY(
+    QObject *source
+    READ Source
+    WRITE SetSource
+    NOTIFY SourceChanged
+  )
+
+  /// \brief Chart ID of the series
+  Q_PROPERTY(
+    int chartID
+    READ ChartID
+    WRITE SetChartID
+    NOTIFY ChartIDChanged
+  )
+
+  /// \brief Range shown, with the lowest time and value at the top left
+  /// corner. Higher values are drawn higher.
+  Q_PROPERTY(
+    QRectF range
+    READ Range
+    WRITE SetRange
+    NOTIFY RangeChanged
+  )
+
+  /// \brief Constructor
+  /// \param[in] _parent Parent item
+  public: explicit PlotLines(QQuickItem *_parent = nullptr);
+
+  /// \brief Destructor
+  public: ~PlotLines() override;
+
+  /// \brief Get the interface storing the series
+  /// \return PlottingInterface, null if not set
+  public: QObject *Source() const;
+
+  /// \brief Set the interface storing the series
+  /// \param[in] _source PlottingInterface
+  public: void SetSource(QObject *_source);
+
+  /// \brief Notify that the source changed
+  signals: void SourceChanged();
+
+  /// \brief Get the chart ID of the series
+  /// \return Chart ID
+  public: int ChartID() const;
+
+  /// \brief Set the chart ID of the series
+  /// \param[in] _chart Chart ID
+  public: void SetChartID(int _chart);
+
+  /// \brief Notify that the chart ID changed
+  signals: void ChartIDChanged();
+
+  /// \brief Get the range shown
+  /// \return Range, from the lowest time and value
+  public: QRectF Range() const;
+
+  /// \brief Set the range shown
+  /// \param[in] _range Range, from the lowest time and value
+  public: void SetRange(const QRectF &_range);
+
+  /// \brief Notify that the range changed
+  signals: void RangeChanged();
+
+  /// \brief Draw a series, or change its color
+  /// \param[in] _fieldID field path ID or component key
+  /// \param[in] _color line color
+  public slots: void setSeries(const QString &_fieldID,
+                               const QColor &_color);
+
+  /// \brief Stop drawing a series
+  /// \param[in] _fieldID field path ID or component key
+  public slots: void removeSeries(const QString &_fieldID);
+
+  // Documentation inherited
+  protected: QSGNode *updatePaintNode(QSGNode *_node,
+                                      UpdatePaintNodeData *) override;
+
+  /// \brief Private data member.
+  private: GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
 }  // namespace gz::gui
 #endif  // GZ_GUI_PLOTTINGINTERFACE_HH_
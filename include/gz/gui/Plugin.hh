@@ -19,11 +19,16 @@
 
 #include <tinyxml2.h>
 #include <gz/utils/ImplPtr.hh>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include "gz/gui/qt.h"
 #include "gz/gui/Export.hh"
+#include "gz/gui/TaskPool.hh"
 
 namespace gz::gui
 {
@@ -48,6 +53,13 @@ namespace gz::gui
     {
       Q_OBJECT
 
+      /// \brief True while the card can't be seen, see Suspended
+      Q_PROPERTY(
+        bool suspended
+        READ Suspended
+        NOTIFY SuspendedChanged
+      )
+
       /// \brief Constructor
       public: Plugin();
 
@@ -65,10 +77,16 @@ namespace gz::gui
       /// \param[in] _pluginElem Element containing configuration
       public: void Load(const tinyxml2::XMLElement *_pluginElem);
 
-      /// \brief Get the configuration XML as a string
+      /// \brief Get the configuration XML as a string. The card's
+      /// properties are only serialized again if they changed since the
+      /// last call, or if `configStr` was changed.
       /// \return Config element
       public: virtual std::string ConfigStr();
 
+      /// \brief Make the next ConfigStr call serialize the card again.
+      /// Changes to the card's properties call it automatically.
+      public slots: void MarkConfigDirty();
+
       /// \brief Get the card item which contains this plugin. The item is
       /// generated the first time this function is run.
       /// \return Pointer to card item.
@@ -110,6 +128,109 @@ namespace gz::gui
       /// parent.
       protected: void DeleteLater();
 
+      /// \brief Release what the plugin holds outside of itself. Called by
+      /// the application when the plugin is removed. Calls OnUnload, then
+      /// removes the plugin as an event filter of the application and its
+      /// main windows, and disconnects their signals from it. Only the first
+      /// call has an effect.
+      /// \sa Application::LeakedPlugins
+      public: void Unload();
+
+      /// \brief Whether the plugin has been unloaded.
+      /// \return True once Unload has been called.
+      public: bool Unloaded() const;
+
+      /// \brief Whether the card can't be seen, because it's hidden or
+      /// collapsed, or its window is minimized, hidden or not exposed, see
+      /// MainWindow::Exposed. Plugins should avoid updating what's shown on
+      /// the card while suspended, for example by binding QML timers and
+      /// animations to `!suspended`. The card of a plugin which wasn't added
+      /// to a main window is never suspended.
+      /// \return True while suspended
+      /// \sa UpdateWhenShown, PauseWhenHidden
+      public: bool Suspended() const;
+
+      /// \brief Notify that the card was suspended or resumed
+      signals: void SuspendedChanged();
+
+      /// \brief Run an update of what's shown on the card now, or, while
+      /// the card is suspended, once it's resumed. Only the latest update of
+      /// each key is kept, so transport callbacks can call this for every
+      /// msg. Safe to call from any thread, the update runs on the calling
+      /// thread if the card isn't suspended and on the GUI thread otherwise.
+      /// \param[in] _key Name of what's updated, such as a property
+      /// \param[in] _update Update, such as emitting a notify signal
+      protected: void UpdateWhenShown(const std::string &_key,
+          std::function<void()> _update);
+
+      /// \brief Stop a timer while the card is suspended, and start it again
+      /// when the card is resumed if it was active. The timer isn't owned.
+      /// \param[in] _timer Timer
+      protected: void PauseWhenHidden(QTimer *_timer);
+
+      /// \brief Run a task on the worker threads shared by all plugins,
+      /// such as decoding or converting msgs. Tasks which haven't started
+      /// are dropped when the plugin is unloaded or destroyed, and running
+      /// ones are waited for, so tasks may use the plugin. Safe to call
+      /// from any thread.
+      /// \param[in] _task Task
+      /// \param[in] _priority Priority
+      /// \return ID of the task, which can be given to TaskPool::Cancel,
+      /// 0 if there's no application
+      /// \sa Application::Tasks
+      protected: std::uint64_t RunInBackground(std::function<void()> _task,
+          TaskPool::Priority _priority = TaskPool::Priority::NORMAL);
+
+      /// \brief Run a task on the worker threads, then pass its result to
+      /// a continuation on the GUI thread.
+      /// \param[in] _work Task, returning the result
+      /// \param[in] _then Continuation, taking the result, or nothing if
+      /// the task returns nothing. It isn't called if the plugin is
+      /// unloaded or destroyed first.
+      /// \param[in] _priority Priority
+      /// \return ID of the task
+      /// \sa RunOnMainThread
+      protected: template<typename Work, typename Then,
+                     typename = std::enable_if_t<
+                         !std::is_same_v<Then, TaskPool::Priority>>>
+                 std::uint64_t RunInBackground(Work _work, Then _then,
+                     TaskPool::Priority _priority =
+                         TaskPool::Priority::NORMAL)
+      {
+        return this->RunInBackground(
+            [this, work = std::move(_work), then = std::move(_then)]()
+            {
+              using Result = std::invoke_result_t<const Work &>;
+              if constexpr (std::is_void_v<Result>)
+              {
+                work();
+                this->RunOnMainThread(then);
+              }
+              else
+              {
+                auto result = std::make_shared<Result>(work());
+                this->RunOnMainThread([then, result]()
+                {
+                  then(std::move(*result));
+                });
+              }
+            }, _priority);
+      }
+
+      /// \brief Run a task on the GUI thread, after the events already
+      /// queued. It isn't run if the plugin is unloaded or destroyed
+      /// first. Safe to call from any thread.
+      /// \param[in] _task Task
+      protected: void RunOnMainThread(std::function<void()> _task);
+
+      /// \brief Called once when the plugin is removed, before the card is
+      /// deleted. Override this to stop work and release resources which
+      /// outlive the card otherwise, such as transport nodes, render
+      /// resources and callbacks registered with other objects, and shared
+      /// pointers which keep the plugin alive. The plugin is destroyed once
+      /// nothing holds it anymore.
+      protected: virtual void OnUnload();
+
       /// \brief Title to be displayed on top of plugin.
       protected: std::string title = "";
 
@@ -129,6 +250,15 @@ namespace gz::gui
       /// through the <anchor> tag and any state properties.
       private: void ApplyAnchors();
 
+      /// \brief Parse `configStr` and write all the card's properties to
+      /// it. ConfigStr then only writes the properties which change.
+      /// \return False if the config has no <plugin> element
+      private: bool ParseConfig();
+
+      /// \brief Suspend or resume the card according to whether it can be
+      /// seen
+      private: void UpdateSuspended();
+
       /// \internal
       /// \brief Pointer to private data
       GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_PLUGININDEX_HH_
+#define GZ_GUI_PLUGININDEX_HH_
+
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Index of the plugin libraries found in each plugin directory,
+  /// so listing plugins doesn't walk every directory each time.
+  ///
+  /// Each directory is listed again only once its modification time
+  /// changes. Once checked, a directory isn't even checked again until
+  /// Invalidate is called, such as by a file watcher. The index can be
+  /// kept in a file, so later sessions start with it.
+  ///
+  /// Only file names are indexed. Getting the plugin classes of a library
+  /// would require loading it.
+  class GZ_GUI_VISIBLE PluginIndex
+  {
+    /// \brief Constructor
+    public: PluginIndex();
+
+    /// \brief Destructor
+    public: ~PluginIndex();
+
+    /// \brief Set the file keeping the index, and read it if it exists.
+    /// Entries already in memory are replaced by those of the file.
+    /// \param[in] _path Path to the file, empty to not keep the index
+    /// \return True if the file was read, or doesn't exist yet
+    public: bool SetFile(const std::string &_path);
+
+    /// \brief Get the file keeping the index
+    /// \return Path to the file, empty if the index isn't kept
+    public: std::string File() const;
+
+    /// \brief Get the plugin libraries of a directory, listing it again
+    /// if it changed since it was indexed. The file is updated when the
+    /// index changes.
+    /// \param[in] _dir Directory
+    /// \return File names of the plugin libraries, in directory order
+    public: std::vector<std::string> Plugins(const std::string &_dir);
+
+    /// \brief Check the directory's modification time on the next call to
+    /// Plugins, because it may have changed.
+    /// \param[in] _dir Directory
+    public: void Invalidate(const std::string &_dir);
+
+    /// \brief Check whether a file name looks like a plugin library, by
+    /// its shared library prefix and suffix. Any further check would
+    /// require loading it.
+    /// \param[in] _filename File name
+    /// \return True if it looks like a plugin library
+    public: static bool IsPluginLibrary(const std::string &_filename);
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
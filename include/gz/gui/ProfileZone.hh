@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_PROFILEZONE_HH_
+#define GZ_GUI_PROFILEZONE_HH_
+
+#include <cstdint>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Set whether profiler zones are sent to the gz-common profiler
+  /// (Remotery). They're disabled by default, unless the GZ_GUI_PROFILER
+  /// environment variable is set to 1, and they only have an effect if
+  /// gz-common was built with its profiler.
+  /// \param[in] _enabled True to send zones to the profiler
+  /// \sa ProfilerEnabled
+  GZ_GUI_VISIBLE
+  void SetProfilerEnabled(bool _enabled);
+
+  /// \brief Get whether profiler zones are sent to the gz-common profiler
+  /// \return True if enabled
+  /// \sa SetProfilerEnabled
+  GZ_GUI_VISIBLE
+  bool ProfilerEnabled();
+
+  /// \brief Profiler sample from its construction to its destruction, only
+  /// recorded if the profiler was enabled when it was constructed. Zones on
+  /// threads watched by StallWatchdog are also reported with their stalls.
+  /// Use it through GZ_GUI_PROFILE.
+  class GZ_GUI_VISIBLE ProfileZone
+  {
+    /// \brief Constructor, beginning the sample
+    /// \param[in] _name Sample name, which must outlive the zone
+    /// \param[in] _hash Cached hash of the name, 0 before the first sample
+    public: ProfileZone(const char *_name, uint32_t *_hash);
+
+    /// \brief Destructor, ending the sample
+    public: ~ProfileZone();
+
+    /// \brief No copies, each zone ends its own sample
+    public: ProfileZone(const ProfileZone &) = delete;
+
+    /// \brief No copies, each zone ends its own sample
+    public: ProfileZone &operator=(const ProfileZone &) = delete;
+
+    /// \brief Whether the sample was begun
+    private: bool active{false};
+  };
+}
+
+/// \brief Profile the rest of the scope, like GZ_PROFILE, if the profiler
+/// is enabled at runtime.
+/// \param[in] _name Sample name, a string literal
+#define GZ_GUI_PROFILE(_name) GZ_GUI_PROFILE_L(_name, __LINE__)
+
+/// \internal
+/// \brief Helper of GZ_GUI_PROFILE, expanding the line number
+#define GZ_GUI_PROFILE_L(_name, _line) GZ_GUI_PROFILE_LL(_name, _line)
+
+/// \internal
+/// \brief Helper of GZ_GUI_PROFILE, giving unique names to the zone and its
+/// hash
+#define GZ_GUI_PROFILE_LL(_name, _line) \
+  static uint32_t gzGuiProfileHash##_line = 0; \
+  ::gz::gui::ProfileZone gzGuiProfile##_line(_name, &gzGuiProfileHash##_line)
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_RECORDEDSERIES_HH_
+#define GZ_GUI_RECORDEDSERIES_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Read-only series of (time, value) points recorded in a binary
+  /// plot export, mapped into memory instead of being read, so recordings
+  /// much larger than the RAM can be overlaid on live plots.
+  ///
+  /// The file is the "bin" format of PlottingInterface::exportData: the 8
+  /// bytes "GZPLOT\0\1", the uint32 length of the name, the name, the
+  /// uint64 number of points N, N times then N values, all in host byte
+  /// order. Times must be in ascending order.
+  ///
+  /// Only the pages of the visible range are touched. Decimating a range
+  /// keeps the lowest and highest point of each slice, like
+  /// TimeSeries::Decimated, and reads the extremes of whole blocks of
+  /// points from summaries computed the first time each block is needed,
+  /// so zooming out over a long recording doesn't read every point again.
+  class GZ_GUI_VISIBLE RecordedSeries
+  {
+    /// \brief Constructor
+    public: RecordedSeries();
+
+    /// \brief Destructor, unmaps the file
+    public: ~RecordedSeries();
+
+    /// \brief Map a binary plot export, closing the file mapped before
+    /// \param[in] _path Path of the file
+    /// \return False if the file couldn't be mapped or isn't a valid export
+    public: bool Open(const std::string &_path);
+
+    /// \brief Unmap the file
+    public: void Close();
+
+    /// \brief Whether a file is mapped
+    /// \return True if open
+    public: bool IsOpen() const;
+
+    /// \brief Get the name of the graph written in the file
+    /// \return Name, empty if not open
+    public: const std::string &Name() const;
+
+    /// \brief Get the number of points
+    /// \return Number of points, 0 if not open
+    public: std::size_t Size() const;
+
+    /// \brief Get the time of the first point
+    /// \return Time, 0 if there are no points
+    public: double Start() const;
+
+    /// \brief Get the time of the last point
+    /// \return Time, 0 if there are no points
+    public: double End() const;
+
+    /// \brief Get a point
+    /// \param[in] _index Index of the point, lower than Size()
+    /// \return Time and value of the point
+    public: math::Vector2d Point(std::size_t _index) const;
+
+    /// \brief Get a decimated view of a time range. Points are split into
+    /// `_buckets` slices of equal duration, and only the lowest and highest
+    /// point of each slice are kept, in time order. Ranges with no more
+    /// than two points per bucket are returned as they are. Safe to call
+    /// from several threads.
+    /// \param[in] _xMin Start of the range
+    /// \param[in] _xMax End of the range
+    /// \param[in] _buckets Number of slices, such as the chart's width in
+    /// pixels
+    /// \return At most 2 * `_buckets` points, in time order
+    /// \sa TimeSeries::Decimated
+    public: std::vector<math::Vector2d> Decimated(double _xMin, double _xMax,
+        unsigned int _buckets) const;
+
+    /// \brief Get the number of blocks whose extremes were computed so far
+    /// \return Number of summarized blocks
+    public: std::size_t SummarizedBlocks() const;
+
+    /// \brief Write points in the format read by Open
+    /// \param[in] _path Path of the file, overwritten if it exists
+    /// \param[in] _name Name of the graph
+    /// \param[in] _points Points in ascending time order
+    /// \return False if the file couldn't be written
+    public: static bool Write(const std::string &_path,
+        const std::string &_name,
+        const std::vector<math::Vector2d> &_points);
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
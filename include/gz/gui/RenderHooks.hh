@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_RENDERHOOKS_HH_
+#define GZ_GUI_RENDERHOOKS_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+    /// \brief Keeps a callback registered with RenderHooks for as long as
+    /// it's alive. Destroying it unregisters the callback. If the callback
+    /// is running on the render thread at that moment, the destructor waits
+    /// for it to return, so it's safe for the callback to capture the object
+    /// owning the connection.
+    class GZ_GUI_VISIBLE RenderHookConnection
+    {
+      /// \brief Constructor. Use RenderHooks to create connections.
+      public: RenderHookConnection();
+
+      /// \brief Destructor. Unregisters the callback.
+      public: ~RenderHookConnection();
+
+      /// \internal
+      /// \brief Private data pointer
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+
+      friend class RenderHooks;
+    };
+
+    /// \brief Shared pointer to a render hook connection
+    using RenderHookConnectionPtr = std::shared_ptr<RenderHookConnection>;
+
+    /// \brief Registry of callbacks which are called directly by the render
+    /// thread of a 3D scene at specific stages of each frame.
+    ///
+    /// This is an alternative to installing an event filter on the main
+    /// window and waiting for events::PreRender and events::Render, which
+    /// makes every plugin see every event sent to the main window. Hooks
+    /// only run for the stage they're registered to, in a deterministic
+    /// order. The events are still sent for backwards compatibility.
+    ///
+    /// Callbacks with lower priority run first, and callbacks with equal
+    /// priority run in the order they were registered. Registering or
+    /// unregistering from within a callback takes effect on the next frame.
+    ///
+    /// As with the events, it's safe to make rendering calls from the
+    /// callbacks, but they must not block waiting on the GUI thread.
+    ///
+    /// Work which can be spread over several frames, such as applying a
+    /// burst of received msgs or loading a scene, should be registered as a
+    /// frame task instead. Tasks get a deadline within the frame's budget
+    /// for tasks and their own, and return once they reach it, leaving the
+    /// rest for the next frames, so the frame time stays stable whatever
+    /// they receive. Tasks left out of a frame because its budget ran out
+    /// go first on the next one, and calls over their own budget are
+    /// reported as overruns by PerformanceCounters.
+    class GZ_GUI_VISIBLE RenderHooks
+    {
+      /// \brief Signature of render hook callbacks
+      public: using Callback = std::function<void()>;
+
+      /// \brief Signature of frame tasks
+      /// \param[in] _deadline Time to return by, which should be checked
+      /// between units of work. At least one unit should be done per call,
+      /// so the task makes progress however little time is left.
+      /// \return True if work is left for the next frames
+      public: using Task = std::function<bool(
+          std::chrono::steady_clock::time_point _deadline)>;
+
+      /// \brief Register a callback to be called every frame before the user
+      /// camera renders, right before events::PreRender is sent.
+      /// \param[in] _cb Callback
+      /// \param[in] _priority Lower values run first
+      /// \param[in] _owner Name the callback's time is reported under by
+      /// PerformanceCounters, usually the plugin's class name. Not measured
+      /// if empty.
+      /// \return Connection that keeps the callback registered. The callback
+      /// is unregistered when all copies of it are destroyed.
+      public: static RenderHookConnectionPtr OnPreRender(Callback _cb,
+          int _priority = 0, const std::string &_owner = "");
+
+      /// \brief Register a callback to be called every frame after the user
+      /// camera has rendered, right before events::Render is sent.
+      /// \param[in] _cb Callback
+      /// \param[in] _priority Lower values run first
+      /// \param[in] _owner Name the callback's time is reported under by
+      /// PerformanceCounters, usually the plugin's class name. Not measured
+      /// if empty.
+      /// \return Connection that keeps the callback registered. The callback
+      /// is unregistered when all copies of it are destroyed.
+      public: static RenderHookConnectionPtr OnRender(Callback _cb,
+          int _priority = 0, const std::string &_owner = "");
+
+      /// \brief Register a task to be called every frame after the user
+      /// camera has rendered, right before the OnRender callbacks, with a
+      /// deadline.
+      /// \param[in] _task Task
+      /// \param[in] _priority Lower values run first
+      /// \param[in] _budget Time the task may take each frame. The
+      /// deadline is earlier if the frame's budget for tasks ends first.
+      /// Zero only limits the task to the frame's budget.
+      /// \param[in] _owner Name the task's time and overruns are reported
+      /// under by PerformanceCounters, usually the plugin's class name. Not
+      /// measured if empty.
+      /// \return Connection that keeps the task registered. The task is
+      /// unregistered when all copies of it are destroyed.
+      public: static RenderHookConnectionPtr OnFrameTask(Task _task,
+          int _priority = 0,
+          std::chrono::steady_clock::duration _budget =
+              std::chrono::milliseconds(2),
+          const std::string &_owner = "");
+
+      /// \brief Register a callback to be called whenever a new frame is
+      /// requested with RequestRender. Scenes which only render on demand
+      /// use this to wake up.
+      /// \param[in] _cb Callback, may be called from any thread
+      /// \return Connection that keeps the callback registered.
+      public: static RenderHookConnectionPtr OnRenderRequest(Callback _cb);
+
+      /// \brief Ask scenes to render a new frame. Scenes which render
+      /// continuously ignore this, but scenes configured to render on demand
+      /// don't draw anything new until something calls it. Call it whenever
+      /// the scene changes, for example when a message updating it is
+      /// received, and every frame while an animation is running.
+      /// This is thread safe.
+      public: static void RequestRender();
+
+      /// \brief Call all callbacks registered with OnPreRender. Meant to be
+      /// called by plugins which own a render thread, like MinimalScene.
+      public: static void RunPreRender();
+
+      /// \brief Call all callbacks registered with OnRender. Meant to be
+      /// called by plugins which own a render thread, like MinimalScene.
+      public: static void RunRender();
+
+      /// \brief Call the tasks registered with OnFrameTask until the budget
+      /// is used up. If some have work left, or were left out, another
+      /// frame is requested. Meant to be called once per frame, right
+      /// before RunRender, by plugins which own a render thread, like
+      /// MinimalScene.
+      /// \param[in] _budget Time after which no more tasks are started. At
+      /// least one task runs per call. Zero runs all of them.
+      public: static void RunFrameTasks(
+          std::chrono::steady_clock::duration _budget);
+
+      /// \brief Number of callbacks currently registered with OnPreRender.
+      /// \return Callback count
+      public: static std::size_t PreRenderCount();
+
+      /// \brief Number of callbacks currently registered with OnRender.
+      /// \return Callback count
+      public: static std::size_t RenderCount();
+
+      /// \brief Number of tasks currently registered with OnFrameTask.
+      /// \return Task count
+      public: static std::size_t FrameTaskCount();
+    };
+}  // namespace gz::gui
+#endif  // GZ_GUI_RENDERHOOKS_HH_
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_GUI_RETAINEDMESSAGE_HH_
+#define GZ_GUI_RETAINEDMESSAGE_HH_
+
+#include <memory>
+#include <string>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Helpers to keep transport messages around without copying them
+  /// field by field.
+  ///
+  /// Messages are retained through ref-counted handles to immutable
+  /// messages, such as the ones SubscriptionHub passes to its consumers.
+  /// Parts of a message, such as a model of a scene, are retained through
+  /// handles sharing ownership of the whole message. Where a message has to
+  /// be created or copied, it's allocated on an arena owned by its handle,
+  /// so its sub-messages, repeated fields and strings take a few large
+  /// blocks instead of an allocation each, and are freed at once.
+
+  /// \brief Create an empty message on an arena owned by the handle
+  /// \tparam T Message type
+  /// \return Handle of the message
+  template<typename T>
+  std::shared_ptr<T> NewArenaMessage()
+  {
+    auto arena = std::make_shared<google::protobuf::Arena>();
+    auto *msg = google::protobuf::Arena::CreateMessage<T>(arena.get());
+    return std::shared_ptr<T>(std::move(arena), msg);
+  }
+
+  /// \brief Create an empty message of a type known at runtime on an arena
+  /// owned by the handle
+  /// \param[in] _type Message type, such as "gz.msgs.Scene"
+  /// \return Handle of the message, null if the type is unknown
+  GZ_GUI_VISIBLE std::shared_ptr<google::protobuf::Message> NewArenaMessage(
+      const std::string &_type);
+
+  /// \brief Copy a message to an arena owned by the handle, for when a
+  /// message which isn't retained already must be kept
+  /// \param[in] _msg Message to copy
+  /// \tparam T Message type
+  /// \return Handle of the copy
+  template<typename T>
+  std::shared_ptr<const T> RetainCopy(const T &_msg)
+  {
+    auto copy = NewArenaMessage<T>();
+    copy->CopyFrom(_msg);
+    return copy;
+  }
+
+  /// \brief Retain part of a retained message, without copying it. The
+  /// whole message is kept as long as the part is.
+  /// \param[in] _owner Handle of the whole message
+  /// \param[in] _part Part of the message, such as `_owner->model(0)`
+  /// \tparam T Type of the part
+  /// \tparam U Type of the whole message
+  /// \return Handle of the part
+  template<typename T, typename U>
+  std::shared_ptr<const T> RetainPart(const std::shared_ptr<U> &_owner,
+      const T &_part)
+  {
+    return std::shared_ptr<const T>(_owner, &_part);
+  }
+}
+
+#endif
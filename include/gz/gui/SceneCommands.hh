@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_GUI_SCENECOMMANDS_HH_
+#define GZ_GUI_SCENECOMMANDS_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+    /// \brief Scene changes recorded by one plugin from any thread, such as
+    /// creating a visual, setting a pose or a material, or destroying a
+    /// node, to be made by the render thread. This replaces a mutex, a
+    /// message queue and a dirty flag in each plugin.
+    ///
+    /// Commands of all queues run in the order they were pushed, when the
+    /// render thread calls SceneCommands::Run. Commands pushed with the same
+    /// key replace the pending one, so only the latest state of something
+    /// which changes often is applied.
+    ///
+    /// Destroying the queue drops its pending commands. If one of them is
+    /// running on the render thread at that moment, the destructor waits
+    /// for it to return, so it's safe for commands to capture the object
+    /// owning the queue. Make the queue one of the last members of that
+    /// object, so it's destroyed before the data its commands use.
+    class GZ_GUI_VISIBLE SceneCommandQueue
+    {
+      /// \brief Signature of commands, which are called on the render
+      /// thread and may make rendering calls
+      public: using Command = std::function<void()>;
+
+      /// \brief Constructor
+      /// \param[in] _owner Name the commands' time and the number pending
+      /// are reported under by PerformanceCounters, usually the plugin's
+      /// class name. Not measured if empty.
+      public: explicit SceneCommandQueue(const std::string &_owner = "");
+
+      /// \brief Destructor. Drops pending commands.
+      public: ~SceneCommandQueue();
+
+      /// \brief Record a command. Thread safe.
+      /// \param[in] _cmd Command
+      public: void Push(Command _cmd);
+
+      /// \brief Record a command, replacing the pending one pushed with the
+      /// same key, which keeps its place in the order. Thread safe.
+      /// \param[in] _key Identifies what the command changes, such as an
+      /// entity's pose
+      /// \param[in] _cmd Command
+      public: void PushLatest(const std::string &_key, Command _cmd);
+
+      /// \brief Drop all pending commands. Thread safe.
+      public: void Clear();
+
+      /// \brief Number of commands waiting to run. Thread safe.
+      /// \return Command count
+      public: std::size_t Size() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+
+    /// \brief Runs the commands recorded in all SceneCommandQueue, in one
+    /// place on the render thread, so the time plugins spend changing the
+    /// scene is bounded and measured.
+    class GZ_GUI_VISIBLE SceneCommands
+    {
+      /// \brief Run pending commands in the order they were pushed, until
+      /// the budget is used up. If some are left, another frame is
+      /// requested. Meant to be called once per frame by plugins which own
+      /// a render thread, like MinimalScene, before the render hooks.
+      /// \param[in] _budget Time after which no more commands are started.
+      /// At least one command runs per call. Zero runs all of them.
+      /// \return Number of commands run
+      public: static std::size_t Run(
+          std::chrono::steady_clock::duration _budget);
+
+      /// \brief Number of commands waiting to run in all queues. Thread
+      /// safe.
+      /// \return Command count
+      public: static std::size_t PendingCount();
+    };
+}  // namespace gz::gui
+#endif  // GZ_GUI_SCENECOMMANDS_HH_
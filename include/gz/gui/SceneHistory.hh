@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SCENEHISTORY_HH_
+#define GZ_GUI_SCENEHISTORY_HH_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Recent history of the scene, kept by the GUI so the 3D view can
+  /// be scrubbed back a few minutes without a log from the server. The
+  /// plugin loading the scene records it and shares it through
+  /// SceneServices as SceneServices::kSceneHistory, and renders the time
+  /// other plugins scrub to.
+  ///
+  /// Poses are quantized, positions to a fixed precision and rotations to
+  /// about a tenth of a degree, and sampled at a fixed rate. Each sample
+  /// only stores the entities which moved, as differences from their
+  /// previous sample. A full sample starts each chunk of a few seconds, so
+  /// finding the poses at a time only decodes one chunk, and the oldest
+  /// chunks are dropped to stay within a duration and a memory budget.
+  /// An entity moving every sample takes about 12 bytes, a still one
+  /// nothing but its share of the full samples.
+  ///
+  /// Entities added to and removed from the scene are recorded with the
+  /// data needed to create them again, which the recorder chooses.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE SceneHistory
+  {
+    /// \brief Pose of an entity
+    public: struct Pose
+    {
+      /// \brief Entity id
+      unsigned int id{0};
+
+      /// \brief Pose
+      math::Pose3d pose;
+    };
+
+    /// \brief Entity added to the scene
+    public: struct Added
+    {
+      /// \brief When it was added, in seconds
+      double stamp{0.0};
+
+      /// \brief Entity id
+      unsigned int id{0};
+
+      /// \brief Data to create it again, as given to RecordAdded
+      std::string data;
+    };
+
+    /// \brief Constructor
+    public: SceneHistory();
+
+    /// \brief Set how far back history is kept
+    /// \param[in] _seconds Duration, defaults to 600
+    public: void SetDuration(double _seconds);
+
+    /// \brief Set the memory budget, older history is dropped to stay
+    /// within it even if it's shorter than the duration
+    /// \param[in] _bytes Budget, defaults to 256 MiB
+    public: void SetMaxBytes(std::size_t _bytes);
+
+    /// \brief Set how often poses are sampled
+    /// \param[in] _hz Samples per second, defaults to 10
+    public: void SetRate(double _hz);
+
+    /// \brief Set the precision of positions
+    /// \param[in] _meters Quantization step, defaults to 0.001
+    public: void SetPrecision(double _meters);
+
+    /// \brief Set how often full samples are stored
+    /// \param[in] _seconds Interval, defaults to 5
+    public: void SetKeyframeInterval(double _seconds);
+
+    /// \brief Record poses. Entities missing keep their previous pose.
+    /// \param[in] _stamp Time in seconds, never decreasing
+    /// \param[in] _poses Poses received at that time, may be empty to only
+    /// let time pass
+    public: void RecordPoses(double _stamp, const std::vector<Pose> &_poses);
+
+    /// \brief Record an entity added to the scene, or replaced
+    /// \param[in] _stamp Time in seconds, never decreasing
+    /// \param[in] _id Entity id
+    /// \param[in] _data Data to create it again
+    public: void RecordAdded(double _stamp, unsigned int _id,
+        const std::string &_data);
+
+    /// \brief Record an entity removed from the scene. Its pose is
+    /// forgotten.
+    /// \param[in] _stamp Time in seconds, never decreasing
+    /// \param[in] _id Entity id
+    public: void RecordRemoved(double _stamp, unsigned int _id);
+
+    /// \brief Get the time span recorded
+    /// \param[out] _start Oldest time which can be scrubbed to
+    /// \param[out] _end Newest time recorded
+    /// \return False if nothing was recorded yet
+    public: bool Range(double &_start, double &_end) const;
+
+    /// \brief Get the memory used
+    /// \return Bytes of encoded poses and recorded data
+    public: std::size_t Bytes() const;
+
+    /// \brief Get the poses of all entities at a time
+    /// \param[in] _time Time, clamped to the range
+    /// \param[out] _poses Latest sampled pose of each entity, sorted by id
+    /// \return False if nothing was recorded yet
+    public: bool PosesAt(double _time, std::vector<Pose> &_poses) const;
+
+    /// \brief Get the entities of the scene at a time, among those added
+    /// while recording
+    /// \param[in] _time Time
+    /// \return The latest addition of each entity not removed since, in no
+    /// particular order
+    public: std::vector<Added> AliveAt(double _time) const;
+
+    /// \brief Check if an entity was added while recording
+    /// \param[in] _id Entity id
+    /// \return True if its additions and removals are known
+    public: bool Tracked(unsigned int _id) const;
+
+    /// \brief Ask for the scene to be shown as it was at a time. Recording
+    /// carries on meanwhile.
+    /// \param[in] _time Time, within the range
+    public: void Scrub(double _time);
+
+    /// \brief Ask for the scene to be shown live again
+    public: void Live();
+
+    /// \brief Get the time being scrubbed to
+    /// \return Time, or nullopt while live
+    public: std::optional<double> ScrubTime() const;
+
+    /// \brief Forget everything recorded, and go live
+    public: void Clear();
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_SCENEHISTORY_HH_
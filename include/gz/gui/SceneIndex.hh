@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SCENEINDEX_HH_
+#define GZ_GUI_SCENEINDEX_HH_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gz/math/Plane.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Entity found by a SceneIndex query
+  class GZ_GUI_VISIBLE SceneIndexHit
+  {
+    /// \brief Id of the entity, usually the id of its visual
+    public: unsigned int id{0};
+
+    /// \brief Distance to its box, in meters. 0 if the query point or ray
+    /// origin is inside the box.
+    public: double distance{0.0};
+  };
+
+  /// \brief Spatial index over the world boxes of the scene's entities, so
+  /// tools such as measuring, selection and hover tooltips can find what's
+  /// near a point or under the cursor without scanning the whole scene.
+  /// The plugin loading the scene shares one through SceneServices as
+  /// SceneServices::kSceneIndex and keeps it up to date as entities move.
+  ///
+  /// The index is a dynamic AABB tree. Each entity's box is stored with a
+  /// margin around it, and the tree only changes when an entity leaves its
+  /// enlarged box, so entities moving a little each frame are cheap to
+  /// update. Insertions pick the sibling which grows the tree's boxes the
+  /// least, and rotations keep it balanced.
+  ///
+  /// Boxes are coarse, queries return the entities whose boxes match, which
+  /// callers may then test exactly against their geometry.
+  ///
+  /// All functions are thread safe. Queries may run on any thread while
+  /// the render thread updates the index, they only wait for the update of
+  /// a single entity.
+  class GZ_GUI_VISIBLE SceneIndex
+  {
+    /// \brief Constructor
+    public: SceneIndex();
+
+    /// \brief Set the box of an entity, adding it if it isn't indexed yet
+    /// \param[in] _id Id of the entity
+    /// \param[in] _min Minimum corner of its box, in the world frame
+    /// \param[in] _max Maximum corner of its box, in the world frame
+    public: void Set(unsigned int _id, const math::Vector3d &_min,
+        const math::Vector3d &_max);
+
+    /// \brief Remove an entity
+    /// \param[in] _id Id of the entity
+    /// \return False if it wasn't indexed
+    public: bool Remove(unsigned int _id);
+
+    /// \brief Remove all entities
+    public: void Clear();
+
+    /// \brief Get the number of entities
+    /// \return Number of entities indexed
+    public: std::size_t Count() const;
+
+    /// \brief Get the box of an entity
+    /// \param[in] _id Id of the entity
+    /// \param[out] _min Minimum corner of its box
+    /// \param[out] _max Maximum corner of its box
+    /// \return False if it isn't indexed
+    public: bool Box(unsigned int _id, math::Vector3d &_min,
+        math::Vector3d &_max) const;
+
+    /// \brief Set how far boxes are enlarged in the tree, see the class
+    /// description. Applies to boxes set from now on.
+    /// \param[in] _margin Margin in meters, on each side. Defaults to 0.1.
+    public: void SetMargin(double _margin);
+
+    /// \brief Find the entities whose boxes overlap a box
+    /// \param[in] _min Minimum corner of the box
+    /// \param[in] _max Maximum corner of the box
+    /// \return Ids of the entities, in no particular order
+    public: std::vector<unsigned int> Overlapping(const math::Vector3d &_min,
+        const math::Vector3d &_max) const;
+
+    /// \brief Find the entities whose boxes are at least partly on the
+    /// positive side of all planes, such as the part of the view frustum
+    /// inside a rectangle drawn on the screen
+    /// \param[in] _planes Planes, whose normals point inside the volume
+    /// \return Ids of the entities, in no particular order
+    public: std::vector<unsigned int> Within(
+        const std::vector<math::Planed> &_planes) const;
+
+    /// \brief Find the entities whose boxes are closest to a point
+    /// \param[in] _point Point, in the world frame
+    /// \param[in] _count Maximum number of entities returned
+    /// \param[in] _maxDistance Entities further than this are ignored
+    /// \return Entities found, closest first
+    public: std::vector<SceneIndexHit> Nearest(const math::Vector3d &_point,
+        std::size_t _count, double _maxDistance =
+        std::numeric_limits<double>::infinity()) const;
+
+    /// \brief Find the entities whose boxes a ray goes through, such as the
+    /// ray under the mouse cursor
+    /// \param[in] _origin Origin of the ray, in the world frame
+    /// \param[in] _direction Direction of the ray, needn't be normalized
+    /// \param[in] _maxDistance Length of the ray
+    /// \return Entities found, with the distance along the ray at which it
+    /// enters their box, closest first. Empty if the direction is zero.
+    public: std::vector<SceneIndexHit> Raycast(const math::Vector3d &_origin,
+        const math::Vector3d &_direction, double _maxDistance =
+        std::numeric_limits<double>::infinity()) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_SCENEINDEX_HH_
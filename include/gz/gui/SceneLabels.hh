@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SCENELABELS_HH_
+#define GZ_GUI_SCENELABELS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Text drawn over the 3D scene, at a point of the world
+  class GZ_GUI_VISIBLE SceneLabel
+  {
+    /// \brief Text
+    public: std::string text;
+
+    /// \brief Text color
+    public: math::Color color{math::Color::White};
+
+    /// \brief Id of the visual the label follows, 0 to stay at `position`
+    public: unsigned int visualId{0};
+
+    /// \brief World position, or offset from the origin of the visual
+    /// followed, in world axes
+    public: math::Vector3d position;
+
+    /// \brief Labels with a higher priority are placed first when crowded,
+    /// then the closest ones
+    public: int priority{0};
+  };
+
+  /// \brief A label placed on the screen by SceneLabels::Layout
+  class GZ_GUI_VISIBLE PlacedLabel
+  {
+    /// \brief Equality, to skip layouts which didn't change
+    /// \param[in] _other Label to compare to
+    /// \return True if both are drawn the same
+    public: bool operator==(const PlacedLabel &_other) const;
+
+    /// \brief Text
+    public: std::string text;
+
+    /// \brief Text color
+    public: math::Color color;
+
+    /// \brief Position of the anchor on the screen, in pixels from the top
+    /// left corner. The text is drawn centered above it.
+    public: math::Vector2d position;
+
+    /// \brief Distance to the camera, in meters
+    public: double depth{0.0};
+  };
+
+  /// \brief Labels drawn over the 3D scene, such as entity names and text
+  /// markers. The plugin providing the scene shares one through
+  /// SceneServices as SceneServices::kLabels, other plugins set their
+  /// labels on it.
+  ///
+  /// Instead of a visual with its own text geometry per label, all labels
+  /// are projected to the screen each frame and drawn by Qt Quick on top
+  /// of the scene, which renders text from a shared distance field glyph
+  /// atlas and batches labels with the same font into one draw call.
+  /// Labels behind the camera, off the screen or too far are culled, and
+  /// when crowded only one label per screen cell is kept, up to a maximum
+  /// number of labels.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE SceneLabels
+  {
+    /// \brief Projects a label, given its world position
+    /// \return Screen position of the anchor, in pixels from the top left
+    /// corner, and its distance in front of the camera as Z. Null if it
+    /// can't be projected, for example because its visual is gone.
+    public: using Projector =
+        std::function<std::optional<math::Vector3d>(const SceneLabel &)>;
+
+    /// \brief Constructor
+    public: SceneLabels();
+
+    /// \brief Set a label, replacing the one with the same owner and id
+    /// \param[in] _owner Owner of the label, usually the plugin setting it
+    /// \param[in] _id Id of the label among the owner's
+    /// \param[in] _label Label
+    public: void Set(const void *_owner, uint64_t _id, SceneLabel _label);
+
+    /// \brief Remove a label
+    /// \param[in] _owner Owner of the label
+    /// \param[in] _id Id of the label among the owner's
+    public: void Remove(const void *_owner, uint64_t _id);
+
+    /// \brief Remove all the labels of an owner
+    /// \param[in] _owner Owner
+    public: void RemoveAll(const void *_owner);
+
+    /// \brief Get the number of labels
+    /// \return Number of labels set, shown or not
+    public: std::size_t Count() const;
+
+    /// \brief Set the size of the screen cells, only one label is kept per
+    /// cell
+    /// \param[in] _pixels Cell width and height in pixels, 0 to keep
+    /// overlapping labels
+    public: void SetCellSize(double _pixels);
+
+    /// \brief Set the maximum number of labels shown
+    /// \param[in] _count Number of labels, 0 for no limit
+    public: void SetMaxLabels(std::size_t _count);
+
+    /// \brief Set the distance from the camera past which labels are
+    /// hidden
+    /// \param[in] _distance Distance in meters, 0 for no limit
+    public: void SetMaxDistance(double _distance);
+
+    /// \brief Place the labels on the screen
+    /// \param[in] _project Projects labels with the current camera
+    /// \param[in] _width Screen width in pixels
+    /// \param[in] _height Screen height in pixels
+    /// \return Labels shown, in placement order
+    public: std::vector<PlacedLabel> Layout(const Projector &_project,
+        unsigned int _width, unsigned int _height) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_SCENELABELS_HH_
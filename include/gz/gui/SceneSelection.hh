@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SCENESELECTION_HH_
+#define GZ_GUI_SCENESELECTION_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Set of entities selected in the 3D scene, by the same ids as
+  /// SceneIndex. The EntitySelection plugin shares one through
+  /// SceneServices as SceneServices::kSelection, and highlights the
+  /// entities in it. Other plugins may read or change it.
+  ///
+  /// Each change increments a version number, so readers polling the
+  /// selection, for example once per frame, only copy it when it changed.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE SceneSelection
+  {
+    /// \brief Constructor
+    public: SceneSelection();
+
+    /// \brief Replace the selection
+    /// \param[in] _ids Ids of the entities selected, duplicates are ignored
+    public: void Set(const std::vector<unsigned int> &_ids);
+
+    /// \brief Add entities to the selection
+    /// \param[in] _ids Ids of the entities
+    public: void Add(const std::vector<unsigned int> &_ids);
+
+    /// \brief Remove entities from the selection
+    /// \param[in] _ids Ids of the entities
+    public: void Remove(const std::vector<unsigned int> &_ids);
+
+    /// \brief Add an entity to the selection if it isn't in it, remove it
+    /// otherwise
+    /// \param[in] _id Id of the entity
+    /// \return True if the entity is now selected
+    public: bool Toggle(unsigned int _id);
+
+    /// \brief Deselect all entities
+    public: void Clear();
+
+    /// \brief Check if an entity is selected
+    /// \param[in] _id Id of the entity
+    /// \return True if selected
+    public: bool Contains(unsigned int _id) const;
+
+    /// \brief Get the selected entities
+    /// \return Their ids, sorted
+    public: std::vector<unsigned int> Ids() const;
+
+    /// \brief Get the selected entities if the selection changed
+    /// \param[in,out] _version Version of the selection the caller has. Set
+    /// to the current version.
+    /// \param[out] _ids Ids of the entities, sorted. Only set if the
+    /// version changed.
+    /// \return True if the version changed
+    public: bool IdsIfChanged(uint64_t &_version,
+        std::vector<unsigned int> &_ids) const;
+
+    /// \brief Get the number of entities selected
+    /// \return Number of entities
+    public: std::size_t Count() const;
+
+    /// \brief Get the version of the selection, incremented on each change
+    /// \return Version, 0 until the first change
+    public: uint64_t Version() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_SCENESELECTION_HH_
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SCENESERVICES_HH_
+#define GZ_GUI_SCENESERVICES_HH_
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Registry of objects the plugin providing the 3D scene shares
+  /// with the other plugins, such as the user camera, so they don't have to
+  /// search the scene for them.
+  ///
+  /// Objects are registered under a name and their type, for example:
+  ///
+  ///     // MinimalScene
+  ///     SceneServices::Set(SceneServices::kUserCamera, camera);
+  ///
+  ///     // Other plugins, on the render thread
+  ///     auto camera = SceneServices::Get<rendering::Camera>(
+  ///         SceneServices::kUserCamera);
+  ///
+  /// The registry only holds objects weakly, they're released by their
+  /// owner as usual, after which Get returns null. Getting an object is a
+  /// hash map lookup, but plugins may still keep what they got.
+  ///
+  /// This class doesn't depend on gz-rendering, only the plugins using it
+  /// do. All functions are thread safe, the objects themselves usually must
+  /// only be used on the render thread.
+  class GZ_GUI_VISIBLE SceneServices
+  {
+    /// \brief Name of the rendering::Camera the user sees the scene through
+    public: static constexpr const char *kUserCamera{"user-camera"};
+
+    /// \brief Name of a rendering::RayQuery of the user camera's scene.
+    /// Plugins using it should set it up with RayQuery::SetFromCamera before
+    /// each query.
+    public: static constexpr const char *kUserCameraRayQuery{
+        "user-camera-ray-query"};
+
+    /// \brief Name of the SceneLabels drawn over the scene
+    public: static constexpr const char *kLabels{"labels"};
+
+    /// \brief Name of the MarkerSink drawing markers in the scene
+    public: static constexpr const char *kMarkers{"markers"};
+
+    /// \brief Name of the SceneIndex over the world boxes of the scene's
+    /// entities. Unlike most objects, it may be queried from any thread.
+    public: static constexpr const char *kSceneIndex{"scene-index"};
+
+    /// \brief Name of the SceneSelection holding the selected entities.
+    /// It may also be used from any thread.
+    public: static constexpr const char *kSelection{"selection"};
+
+    /// \brief Name of the SceneHistory recorded by the plugin loading the
+    /// scene. It may also be used from any thread.
+    public: static constexpr const char *kSceneHistory{"scene-history"};
+
+    /// \brief Share an object, replacing any other object with the same
+    /// name and type
+    /// \param[in] _name Name, such as kUserCamera
+    /// \param[in] _object Object, null to remove it
+    public: template <class T>
+            static void Set(const std::string &_name,
+                const std::shared_ptr<T> &_object)
+    {
+      SetObject(_name, typeid(T), _object);
+    }
+
+    /// \brief Get a shared object
+    /// \param[in] _name Name, such as kUserCamera
+    /// \return The object, or null if there's none with this name and type,
+    /// or it has been destroyed
+    public: template <class T>
+            static std::shared_ptr<T> Get(const std::string &_name)
+    {
+      return std::static_pointer_cast<T>(Object(_name, typeid(T)));
+    }
+
+    /// \brief Remove all objects with a name, whatever their type
+    /// \param[in] _name Name
+    public: static void Remove(const std::string &_name);
+
+    /// \brief Implementation of Set
+    /// \param[in] _name Name
+    /// \param[in] _type Type the object was shared as
+    /// \param[in] _object Object
+    private: static void SetObject(const std::string &_name,
+        const std::type_info &_type, std::weak_ptr<void> _object);
+
+    /// \brief Implementation of Get
+    /// \param[in] _name Name
+    /// \param[in] _type Type requested
+    /// \return The object if it's still alive
+    private: static std::shared_ptr<void> Object(const std::string &_name,
+        const std::type_info &_type);
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_SCENESERVICES_HH_
@@ -17,6 +17,10 @@
 #ifndef GZ_GUI_SEARCHMODEL_HH_
 #define GZ_GUI_SEARCHMODEL_HH_
 
+#include <chrono>
+
+#include <gz/utils/ImplPtr.hh>
+
 #include "gz/gui/Export.hh"
 #include "gz/gui/qt.h"
 
@@ -28,11 +32,42 @@ namespace gz::gui
   ///
   /// * This has been tested with QTreeView and QTableView.
   /// * Manages expansion of nested items through DataRole::TO_EXPAND when
-  ///   applicable
+  ///   applicable. The flag is returned by this model's data(), the source
+  ///   model isn't modified.
   /// * Items with DataRole::TYPE == "title" are ignored
+  /// * The lowercase text of every item is indexed once, and indexed again
+  ///   only after the source model's rows or filtered text change. Each
+  ///   search is then matched against the index in a single pass. When a
+  ///   search only makes the previous one more specific, such as typing
+  ///   more characters, only the items which matched before are checked.
+  /// * In async mode, searches are matched on a worker thread once they
+  ///   stop changing for SearchDelay, and rows are filtered by the previous
+  ///   search until then. Typing again cancels searches still being matched.
+  ///   Indexing the source model still happens on the GUI thread, as do
+  ///   filtering rows added or changed later.
   ///
   class GZ_GUI_VISIBLE SearchModel : public QSortFilterProxyModel
   {
+    /// \brief Constructor
+    public: SearchModel();
+
+    /// \brief Destructor
+    public: ~SearchModel() override;
+
+    /// \brief Overloaded Qt method. Keeps the index up to date with the
+    /// source model.
+    /// \param[in] _model Source model
+    public: void setSourceModel(QAbstractItemModel *_model) override;
+
+    /// \brief Overloaded Qt method. Returns whether an item should be
+    /// expanded for DataRole::TO_EXPAND, other roles come from the source
+    /// model.
+    /// \param[in] _index Index on this model
+    /// \param[in] _role Data role
+    /// \return Data
+    public: QVariant data(const QModelIndex &_index,
+                          int _role = Qt::DisplayRole) const override;
+
     /// \brief Overloaded Qt method. Customize so we accept rows where:
     /// 1. Each of the words can be found in its ancestors or itself, but not
     /// necessarily all words on the same row, or
@@ -55,7 +90,8 @@ namespace gz::gui
     /// \param[in] _srcParent Parent on the source model.
     /// \return True if row is accepted.
     public: bool filterAcceptsRow(const int _srcRow,
-                                  const QModelIndex &_srcParent) const;
+                                  const QModelIndex &_srcParent) const
+                                  override;
 
     /// \brief Check if row contains the word on itself.
     /// \param[in] _srcRow Row on the source model.
@@ -84,8 +120,31 @@ namespace gz::gui
     /// \param[in] _search Full search string.
     public: void SetSearch(const QString &_search);
 
+    /// \brief Set whether searches are matched on a worker thread, so the
+    /// GUI thread doesn't wait for them on large models. Off by default.
+    /// \param[in] _async True for async mode.
+    public: void SetAsync(bool _async);
+
+    /// \brief Get whether searches are matched on a worker thread.
+    /// \return True for async mode.
+    public: bool Async() const;
+
+    /// \brief Set how long the search must stop changing before it's
+    /// matched in async mode, 150 ms by default.
+    /// \param[in] _delay Delay.
+    public: void SetSearchDelay(const std::chrono::milliseconds &_delay);
+
+    /// \brief Get how long the search must stop changing before it's
+    /// matched in async mode.
+    /// \return Delay.
+    public: std::chrono::milliseconds SearchDelay() const;
+
     /// \brief Full search string.
     public: QString search;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
   };
 }  // namespace gz::gui
 #endif  // GZ_GUI_SEARCHMODEL_HH_
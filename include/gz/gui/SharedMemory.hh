@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SHAREDMEMORY_HH_
+#define GZ_GUI_SHAREDMEMORY_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+#include <google/protobuf/message.h>
+#include <gz/msgs/header.pb.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Get the topic the shared memory descriptors of a topic are
+  /// published on
+  /// \param[in] _topic Topic name, such as "/camera"
+  /// \return Descriptor topic, such as "/camera/shm"
+  GZ_GUI_VISIBLE std::string SharedMemoryTopic(const std::string &_topic);
+
+  /// \brief Publishes the messages of a topic through shared memory to
+  /// subscribers on the same host, and through transport to the others,
+  /// so large messages such as images, point clouds and scenes aren't
+  /// copied through sockets on a single workstation.
+  ///
+  /// Each message is serialized into a slot of a ring in a POSIX shared
+  /// memory segment, and a small gz.msgs.Header descriptor is published on
+  /// SharedMemoryTopic(), with these data keys:
+  ///
+  /// * "host": Host name of the publisher
+  /// * "segment": Name of the segment, for shm_open
+  /// * "slot": Index of the slot
+  /// * "sequence": Sequence number the slot holds while it isn't rewritten
+  /// * "size": Size of the serialized message
+  /// * "type": Message type, such as "gz.msgs.Image"
+  ///
+  /// The segment starts with a header of four uint32 (magic "GZSM",
+  /// version 1, slot count and slot capacity) padded to 64 bytes. Each slot
+  /// is a 64 byte header, whose first 8 bytes hold its atomic sequence
+  /// number, followed by its capacity. The sequence number is odd while
+  /// the slot is being written, readers must check that it's unchanged
+  /// once they're done with the data. Other publishers may implement the
+  /// same layout.
+  ///
+  /// Messages are also published on the topic itself, but only while it
+  /// has subscribers, such as GUIs on other hosts. The segment grows when
+  /// a message doesn't fit, under a new name. Shared memory isn't
+  /// available on Windows, where only the topic is published.
+  ///
+  /// Not thread safe.
+  class GZ_GUI_VISIBLE SharedMemoryPublisher
+  {
+    /// \brief Constructor
+    /// \param[in] _topic Topic name
+    /// \param[in] _msgType Message type, such as "gz.msgs.Image"
+    /// \param[in] _slots Number of slots in the ring. A slot is rewritten
+    /// after that many messages, so it's how many messages a subscriber
+    /// may fall behind.
+    public: SharedMemoryPublisher(const std::string &_topic,
+        const std::string &_msgType, std::size_t _slots = 4);
+
+    /// \brief Destructor, removes the segment. Subscribers which mapped it
+    /// keep it until they let go.
+    public: ~SharedMemoryPublisher();
+
+    /// \brief Whether the topics were advertised
+    /// \return True if valid
+    public: bool Valid() const;
+
+    /// \brief Publish a message
+    /// \param[in] _msg Message of the advertised type
+    /// \return False if it couldn't be published
+    public: bool Publish(const google::protobuf::Message &_msg);
+
+    /// \brief Get the name of the current segment
+    /// \return Segment name, empty until a message went through it
+    public: std::string SegmentName() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+
+  /// \brief Message in a shared memory slot, see SharedMemoryReader
+  class GZ_GUI_VISIBLE SharedMemoryView
+  {
+    /// \brief Serialized message, in the shared memory
+    public: const char *data{nullptr};
+
+    /// \brief Size of the serialized message
+    public: std::size_t size{0};
+
+    /// \brief Message type, such as "gz.msgs.Image"
+    public: std::string type;
+
+    /// \internal
+    /// \brief Sequence number of the slot
+    public: const void *slot{nullptr};
+
+    /// \internal
+    /// \brief Sequence number the slot must still hold
+    public: uint64_t sequence{0};
+  };
+
+  /// \brief Reads the messages described by SharedMemoryPublisher's
+  /// descriptors. Segments are mapped the first time they're seen, and
+  /// stay mapped while the reader lives or until more recent segments
+  /// push them out.
+  ///
+  /// Not thread safe.
+  class GZ_GUI_VISIBLE SharedMemoryReader
+  {
+    /// \brief Result of a read
+    public: enum class Result
+    {
+      /// \brief The view holds the message
+      OK,
+
+      /// \brief The slot was already rewritten with a newer message
+      STALE,
+
+      /// \brief The segment can't be read, for example because the
+      /// publisher is on another host. Messages should be received through
+      /// the topic instead.
+      UNAVAILABLE
+    };
+
+    /// \brief Constructor
+    public: SharedMemoryReader();
+
+    /// \brief Destructor, unmaps the segments
+    public: ~SharedMemoryReader();
+
+    /// \brief Find the message described by a descriptor. The message
+    /// isn't copied, it may be rewritten by the publisher at any time, so
+    /// check Unchanged once done with it, and discard what was made out of
+    /// it otherwise.
+    /// \param[in] _descriptor Descriptor received on SharedMemoryTopic()
+    /// \param[out] _view Message, valid until the next call
+    /// \return Whether the message could be found
+    public: Result Read(const msgs::Header &_descriptor,
+        SharedMemoryView &_view);
+
+    /// \brief Check that a message wasn't rewritten since it was read
+    /// \param[in] _view Message returned by Read
+    /// \return True if the message is still the one described
+    public: static bool Unchanged(const SharedMemoryView &_view);
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
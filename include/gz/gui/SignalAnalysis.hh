@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SIGNALANALYSIS_HH_
+#define GZ_GUI_SIGNALANALYSIS_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Statistics of the latest values of a signal, updated with each
+  /// value in constant amortized time.
+  ///
+  /// The mean and variance follow Welford's algorithm, adding new values
+  /// and removing those which leave the time window. The minimum and
+  /// maximum are kept with monotonic queues.
+  class GZ_GUI_VISIBLE RollingStatistics
+  {
+    /// \brief Constructor
+    /// \param[in] _window Time window, 0 to include all values
+    public: explicit RollingStatistics(double _window = 0.0);
+
+    /// \brief Destructor
+    public: ~RollingStatistics();
+
+    /// \brief Set the time window, removing all values
+    /// \param[in] _window Time window, 0 to include all values
+    public: void SetWindow(double _window);
+
+    /// \brief Get the time window
+    /// \return Time window, 0 if all values are included
+    public: double Window() const;
+
+    /// \brief Add a value. Its time should not be lower than the previous
+    /// value's. Values which aren't finite are skipped.
+    /// \param[in] _time Time of the value
+    /// \param[in] _value Value
+    public: void Add(double _time, double _value);
+
+    /// \brief Remove all values
+    public: void Clear();
+
+    /// \brief Get the number of values within the window
+    /// \return Number of values
+    public: std::size_t Count() const;
+
+    /// \brief Get the mean
+    /// \return Mean, 0 without values
+    public: double Mean() const;
+
+    /// \brief Get the population variance
+    /// \return Variance, 0 without values
+    public: double Variance() const;
+
+    /// \brief Get the population standard deviation
+    /// \return Standard deviation, 0 without values
+    public: double StdDev() const;
+
+    /// \brief Get the root mean square
+    /// \return RMS, 0 without values
+    public: double Rms() const;
+
+    /// \brief Get the lowest value
+    /// \return Minimum, 0 without values
+    public: double Min() const;
+
+    /// \brief Get the highest value
+    /// \return Maximum, 0 without values
+    public: double Max() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+
+  /// \brief Amplitude spectrum of the latest values of a signal, for
+  /// sampled signals such as vibrations.
+  ///
+  /// Values are collected in a window of a power of two size, and a new
+  /// window is ready every half window, so windows overlap by half. The
+  /// sample rate is estimated from the times of the window's values.
+  ///
+  /// Transforms are computed by the static functions, so they can run on
+  /// another thread on a copy of the window.
+  class GZ_GUI_VISIBLE Spectrum
+  {
+    /// \brief Constructor
+    /// \param[in] _size Window size, rounded up to a power of two, at
+    /// least 8
+    public: explicit Spectrum(std::size_t _size = 1024);
+
+    /// \brief Destructor
+    public: ~Spectrum();
+
+    /// \brief Get the window size
+    /// \return Number of values in a window
+    public: std::size_t Size() const;
+
+    /// \brief Add a value. Its time should not be lower than the previous
+    /// value's. Values which aren't finite are skipped.
+    /// \param[in] _time Time of the value
+    /// \param[in] _value Value
+    /// \return True if a new window is ready
+    public: bool Add(double _time, double _value);
+
+    /// \brief Remove all values
+    public: void Clear();
+
+    /// \brief Get the latest full window
+    /// \return Values in time order, empty until the window first fills
+    public: std::vector<double> Window() const;
+
+    /// \brief Get the sample rate of the latest full window
+    /// \return Values per time unit, 0 until the window first fills
+    public: double SampleRate() const;
+
+    /// \brief Compute the one-sided amplitude spectrum of a window, with a
+    /// Hann window to limit leakage
+    /// \param[in] _values Values, their count a power of two
+    /// \return Amplitude of each frequency from 0 to half the sample rate,
+    /// `_values.size() / 2 + 1` of them, empty if the count isn't a power
+    /// of two
+    public: static std::vector<double> Amplitudes(
+        const std::vector<double> &_values);
+
+    /// \brief Find the frequency with the highest amplitude, other than 0,
+    /// interpolated between frequencies
+    /// \param[in] _amplitudes Amplitudes returned by Amplitudes
+    /// \param[in] _sampleRate Sample rate of the window
+    /// \return Dominant frequency, 0 if there is none
+    public: static double Dominant(const std::vector<double> &_amplitudes,
+        double _sampleRate);
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
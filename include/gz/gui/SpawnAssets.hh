@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SPAWNASSETS_HH_
+#define GZ_GUI_SPAWNASSETS_HH_
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief A resource about to be spawned, with its assets resolved
+  class GZ_GUI_VISIBLE SpawnResource
+  {
+    /// \brief True if its description could be read and parsed
+    public: bool valid{false};
+
+    /// \brief Why it isn't valid
+    public: std::string error;
+
+    /// \brief SDF description, the file's content for paths
+    public: std::string sdf;
+
+    /// \brief Resolved file the description was read from, empty if the
+    /// source was a description
+    public: std::string file;
+
+    /// \brief Resolved mesh files of the visuals, including those of
+    /// included models. They're loaded into common::MeshManager.
+    public: std::vector<std::string> meshes;
+
+    /// \brief Resolved texture files of the visuals' materials
+    public: std::vector<std::string> textures;
+
+    /// \brief URIs of included models, meshes and textures which couldn't
+    /// be resolved
+    public: std::vector<std::string> missing;
+
+    /// \brief Box around the visuals, in the frame the resource is spawned
+    /// at. Empty if it has no visuals of known size.
+    public: math::AxisAlignedBox box;
+  };
+
+  /// \brief Future of a resource being resolved
+  using SpawnFuture = std::shared_future<std::shared_ptr<const SpawnResource>>;
+
+  /// \brief Resolves resources to be spawned off the GUI thread, so
+  /// handlers of events::SpawnFromDescription, events::SpawnFromPath and
+  /// events::DropOnScene don't freeze the GUI while loading a complex model.
+  ///
+  /// A source is either an SDF description or a path or URI to an SDF file
+  /// or model directory. On one of the Application::Tasks threads, the
+  /// description is read and parsed, the URIs of its included models,
+  /// meshes and textures are resolved with common::findFile, and the meshes
+  /// are loaded, so creating the model afterwards doesn't touch the disk.
+  /// The box around its visuals is computed for a preview.
+  ///
+  /// Sources are resolved once and their results are kept for the most
+  /// recent sources, so a drag, a drop and the spawn events which follow
+  /// share the work:
+  ///
+  ///     // When the drag starts
+  ///     SpawnAssets::Prefetch(source);
+  ///     ...
+  ///     // While previewing, until it's ready
+  ///     if (auto resource = SpawnAssets::Ready(source))
+  ///       this->CreatePreview(resource->sdf);
+  ///     else
+  ///       this->ShowBox(...);
+  ///
+  /// Without an application, sources are resolved on the calling thread.
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE SpawnAssets
+  {
+    /// \brief Start resolving a source, unless it's already resolved or
+    /// being resolved
+    /// \param[in] _source SDF description, or path or URI of a file or
+    /// model directory
+    /// \return Future of the resolved resource
+    public: static SpawnFuture Prefetch(const std::string &_source);
+
+    /// \brief Get a resolved resource without waiting
+    /// \param[in] _source Source given to Prefetch
+    /// \return Null if it isn't prefetched or not resolved yet
+    public: static std::shared_ptr<const SpawnResource> Ready(
+        const std::string &_source);
+
+    /// \brief Resolve a source on the calling thread, which is what
+    /// Prefetch does on a worker
+    /// \param[in] _source SDF description, or path or URI of a file or
+    /// model directory
+    /// \param[in] _loadMeshes Whether to load the meshes to get their size,
+    /// otherwise they're only resolved
+    /// \return Resolved resource
+    public: static SpawnResource Resolve(const std::string &_source,
+        bool _loadMeshes = true);
+
+    /// \brief Forget the results kept. Sources being resolved complete
+    /// their futures but aren't kept.
+    public: static void Clear();
+
+    /// \brief Number of sources whose results are kept
+    public: static constexpr std::size_t kCacheSize{16};
+  };
+}
+
+#endif
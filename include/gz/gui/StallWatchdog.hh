@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_STALLWATCHDOG_HH_
+#define GZ_GUI_STALLWATCHDOG_HH_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace tinyxml2
+{
+  class XMLElement;
+}
+
+namespace gz::gui
+{
+  /// \brief Watches threads which must stay responsive, such as the GUI
+  /// thread and the render threads, and reports when one of them is stuck
+  /// for longer than a threshold, with what it was running.
+  ///
+  /// Watched threads call Beat whenever they make progress, and Idle while
+  /// they wait for work, so waiting isn't taken for a stall. A thread busy
+  /// for longer than the threshold without beating is reported once, with
+  /// the ProfileZone and PerformanceTimer scopes it's in, the last main
+  /// window event filter it ran, and optionally its stack, then again once
+  /// it recovers.
+  ///
+  /// Stalls are checked from a thread of the watchdog. Beats and scopes are
+  /// a few atomic stores, and nothing is recorded on unwatched threads.
+  ///
+  /// All functions are thread safe.
+  class GZ_GUI_VISIBLE StallWatchdog
+  {
+    /// \brief A watched thread stuck for longer than the threshold
+    public: struct Stall
+    {
+      /// \brief Name the thread is watched as, such as "gui"
+      std::string thread;
+
+      /// \brief Time since the thread last beat
+      std::chrono::steady_clock::duration duration{0};
+
+      /// \brief Scopes the thread was in, outermost first. Taken while the
+      /// thread runs, so it may be off by a scope.
+      std::vector<std::string> zones;
+
+      /// \brief Stack of the thread, one frame per line, empty unless
+      /// stack traces are enabled and supported
+      std::vector<std::string> stack;
+    };
+
+    /// \brief Watchdog options
+    public: struct Options
+    {
+      /// \brief Time a thread may be busy without beating, zero to stop
+      /// watching
+      std::chrono::milliseconds threshold{0};
+
+      /// \brief Capture the stack of stalled threads. Only supported on
+      /// Linux with glibc, where the thread is interrupted with a signal.
+      bool stackTraces{false};
+
+      /// \brief Topic stalls are published on, as gz::msgs::Param, empty
+      /// to only print them. Published by Application.
+      std::string topic;
+
+      /// \brief Load options from XML, with optional children:
+      /// * \<threshold\> : Milliseconds, 1000 if not given.
+      /// * \<stack_trace\> : True to capture stacks, false by default.
+      /// * \<topic\> : Topic to publish stalls on.
+      /// \param[in] _elem Element holding the children
+      /// \return False if a child is invalid, in which case it's ignored
+      bool Load(const tinyxml2::XMLElement *_elem);
+    };
+
+    /// \brief Function receiving stalls, on the watchdog's thread
+    public: using Callback = std::function<void(const Stall &)>;
+
+    /// \brief Start watching, or change the options if already started.
+    /// Stalls are printed as warnings.
+    /// \param[in] _options Options, stops watching if the threshold is
+    /// zero
+    public: static void Start(const Options &_options);
+
+    /// \brief Stop watching. Threads stay registered.
+    public: static void Stop();
+
+    /// \brief Check whether the watchdog is running
+    /// \return True if running
+    public: static bool Running();
+
+    /// \brief Set the function called on each stall, besides printing it
+    /// \param[in] _callback Function, null to remove it
+    public: static void SetCallback(Callback _callback);
+
+    /// \brief Watch the calling thread, which starts idle. The thread is
+    /// unwatched when it exits.
+    /// \param[in] _name Name to report the thread as
+    public: static void Watch(const std::string &_name);
+
+    /// \brief Stop watching the calling thread
+    public: static void Unwatch();
+
+    /// \brief Tell the watchdog the calling thread made progress, and is
+    /// busy from now on
+    public: static void Beat();
+
+    /// \brief Tell the watchdog the calling thread is waiting for work
+    public: static void Idle();
+
+    /// \brief Enter a scope on the calling thread, reported if it stalls.
+    /// Called by ProfileZone and PerformanceTimer.
+    /// \param[in] _name Scope name, which must outlive the process, such
+    /// as a string literal or one returned by Intern
+    public: static void PushZone(const char *_name);
+
+    /// \brief Leave the innermost scope of the calling thread
+    public: static void PopZone();
+
+    /// \brief Set the event handler the calling thread runs, for handlers
+    /// without a scope to push, such as event filters. Cleared by Beat.
+    /// \param[in] _name Handler name, which must outlive the process, null
+    /// to clear it
+    public: static void SetHandler(const char *_name);
+
+    /// \brief Keep a copy of a name for the life of the process, to pass
+    /// names built at runtime to PushZone or SetHandler
+    /// \param[in] _name Name
+    /// \return Copy, the same for equal names
+    public: static const char *Intern(const std::string &_name);
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_STALLWATCHDOG_HH_
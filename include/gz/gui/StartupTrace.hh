@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_STARTUPTRACE_HH_
+#define GZ_GUI_STARTUPTRACE_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Timeline of the application's startup, such as how long each
+  /// plugin took to load, which can be written in the Chrome trace event
+  /// format and opened with chrome://tracing or Perfetto.
+  ///
+  /// Nothing is recorded until the trace is enabled. Events can be
+  /// recorded from any thread.
+  class GZ_GUI_VISIBLE StartupTrace
+  {
+    /// \brief Clock of the event times
+    public: using Clock = std::chrono::steady_clock;
+
+    /// \brief Constructor. Event times are relative to the construction.
+    public: StartupTrace();
+
+    /// \brief Destructor
+    public: ~StartupTrace();
+
+    /// \brief Set whether events are recorded
+    /// \param[in] _enabled True to record events
+    public: void SetEnabled(bool _enabled);
+
+    /// \brief Get whether events are recorded
+    /// \return True if recording
+    public: bool Enabled() const;
+
+    /// \brief Record a phase, on the calling thread's track
+    /// \param[in] _name Phase name, such as "LoadPlugin [Publisher]"
+    /// \param[in] _category Phase category, such as "plugin"
+    /// \param[in] _start When the phase started
+    /// \param[in] _end When the phase ended
+    public: void Record(const std::string &_name,
+        const std::string &_category, Clock::time_point _start,
+        Clock::time_point _end);
+
+    /// \brief Record an instant, such as the first frame, on the calling
+    /// thread's track
+    /// \param[in] _name Event name
+    /// \param[in] _category Event category
+    public: void Mark(const std::string &_name,
+        const std::string &_category);
+
+    /// \brief Get the number of recorded events
+    /// \return Number of phases and instants
+    public: std::size_t EventCount() const;
+
+    /// \brief Get the recorded events in the Chrome trace event format
+    /// \return JSON object
+    public: std::string ChromeTrace() const;
+
+    /// \brief Write the recorded events in the Chrome trace event format
+    /// \param[in] _path File path, overwritten if it exists
+    /// \return True if written
+    public: bool Write(const std::string &_path) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+
+  /// \brief Records a phase of a StartupTrace from its construction to its
+  /// destruction.
+  class GZ_GUI_VISIBLE StartupTraceZone
+  {
+    /// \brief Constructor, starting the phase
+    /// \param[in] _trace Trace to record to, may be null
+    /// \param[in] _name Phase name
+    /// \param[in] _category Phase category
+    public: StartupTraceZone(StartupTrace *_trace, const std::string &_name,
+        const std::string &_category);
+
+    /// \brief Destructor, ending the phase
+    public: ~StartupTraceZone();
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_SUBSCRIPTIONHUB_HH_
+#define GZ_GUI_SUBSCRIPTIONHUB_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+#include <google/protobuf/message.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  class SubscriptionHub;
+
+  /// \brief Get the topic the consumption feedback of a topic is published
+  /// on, see SubscriptionHub::SetFeedback
+  /// \param[in] _topic Topic name, such as "/camera"
+  /// \return Feedback topic, such as "/camera/feedback"
+  GZ_GUI_VISIBLE std::string FeedbackTopic(const std::string &_topic);
+
+  /// \brief Handle of a SubscriptionHub subscription. The subscription
+  /// lasts until the handle is reset or destroyed, and handles can be
+  /// moved but not copied.
+  class GZ_GUI_VISIBLE HubSubscription
+  {
+    /// \brief Constructor of an empty handle
+    public: HubSubscription();
+
+    /// \brief Move constructor
+    /// \param[in] _other Handle to take the subscription from
+    public: HubSubscription(HubSubscription &&_other) noexcept;
+
+    /// \brief Move assignment, ending the current subscription first
+    /// \param[in] _other Handle to take the subscription from
+    /// \return Reference to this handle
+    public: HubSubscription &operator=(HubSubscription &&_other) noexcept;
+
+    /// \brief Destructor, ends the subscription
+    public: ~HubSubscription();
+
+    /// \brief End the subscription. The callback won't be called once
+    /// this returns, unless this is called from the callback itself.
+    public: void Reset();
+
+    /// \brief Whether the handle holds a subscription
+    /// \return True if subscribed
+    public: bool Valid() const;
+
+    /// \brief Get the subscribed topic
+    /// \return Topic name, empty if not subscribed
+    public: std::string Topic() const;
+
+    /// \brief Report messages the consumer received but didn't use, such
+    /// as frames replaced by newer ones before they were shown, so the
+    /// feedback of the topic tells its publisher the rate actually used.
+    /// Like the rest of the handle, it mustn't be called while another
+    /// thread resets or moves the handle.
+    /// \param[in] _count Number of messages dropped
+    /// \sa SubscriptionHub::SetFeedback
+    public: void ReportDropped(std::size_t _count = 1) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+
+    friend class SubscriptionHub;
+  };
+
+  /// \brief Transport subscriptions shared by all plugins of an
+  /// application, through Application::Subscriptions.
+  ///
+  /// Each topic is subscribed to once, however many consumers it has. Every
+  /// message is parsed once, and the same immutable message is passed to
+  /// all consumers of the topic. Consumers which only need a few fields can
+  /// read the serialized message instead, and messages are only parsed if
+  /// another consumer needs them. Messages are parsed into an arena, so
+  /// consumers can keep them, or parts of them, without copies, see
+  /// RetainedMessage.hh.
+  ///
+  /// Consumers may ask for at most a number of messages per second. The
+  /// topic is subscribed with the rate of its fastest consumer, so
+  /// transport drops the messages none of them need before they reach the
+  /// hub, and slower consumers skip the messages which arrive faster than
+  /// their own rate. Messages are only parsed if a consumer is due.
+  /// The hub may also cap the rate of all the consumers which asked for a
+  /// rate, for example while the windows are hidden, see SetRateCap.
+  ///
+  /// Topics may also be received through shared memory, from publishers
+  /// on the same host, see SetSharedMemory.
+  ///
+  /// Publishers may be told how fast their topic is consumed, so they can
+  /// lower their rate or resolution for slow or remote viewers, see
+  /// SetFeedback.
+  ///
+  /// Callbacks are called from transport threads. Callbacks of the same
+  /// topic are called one after the other.
+  class GZ_GUI_VISIBLE SubscriptionHub
+  {
+    /// \brief Callback receiving the shared message
+    public: using Callback = std::function<void(
+        const std::shared_ptr<const google::protobuf::Message> &)>;
+
+    /// \brief Callback receiving the serialized message
+    /// \param[in] _data Serialized message
+    /// \param[in] _size Size of the serialized message
+    /// \param[in] _msgType Message type, such as "gz.msgs.Pose"
+    public: using RawCallback = std::function<void(const char *_data,
+        std::size_t _size, const std::string &_msgType)>;
+
+    /// \brief Constructor
+    public: SubscriptionHub();
+
+    /// \brief Destructor. Outstanding handles become empty.
+    public: ~SubscriptionHub();
+
+    /// \brief Subscribe to a topic
+    /// \param[in] _topic Topic name
+    /// \param[in] _cb Callback called with each message
+    /// \param[in] _maxRate Most messages per second to receive, 0 for all
+    /// \return Handle of the subscription, empty if the topic couldn't be
+    /// subscribed to
+    public: HubSubscription Subscribe(const std::string &_topic,
+        const Callback &_cb, double _maxRate = 0.0);
+
+    /// \brief Subscribe to a topic, only receiving messages of type T
+    /// \param[in] _topic Topic name
+    /// \param[in] _cb Callback called with each message of type T
+    /// \param[in] _maxRate Most messages per second to receive, 0 for all
+    /// \return Handle of the subscription, empty if the topic couldn't be
+    /// subscribed to
+    public: template<typename T>
+            HubSubscription Subscribe(const std::string &_topic,
+                const std::function<void(const T &)> &_cb,
+                double _maxRate = 0.0)
+    {
+      return this->Subscribe(_topic,
+          [_cb](const std::shared_ptr<const google::protobuf::Message> &_msg)
+          {
+            const auto *msg = dynamic_cast<const T *>(_msg.get());
+            if (msg)
+              _cb(*msg);
+          }, _maxRate);
+    }
+
+    /// \brief Subscribe to a topic, only receiving messages of type T, as
+    /// handles which may be kept instead of copying the messages
+    /// \param[in] _topic Topic name
+    /// \param[in] _cb Callback called with each message of type T
+    /// \param[in] _maxRate Most messages per second to receive, 0 for all
+    /// \return Handle of the subscription, empty if the topic couldn't be
+    /// subscribed to
+    /// \sa RetainPart
+    public: template<typename T>
+            HubSubscription SubscribeShared(const std::string &_topic,
+                const std::function<void(const std::shared_ptr<const T> &)>
+                &_cb, double _maxRate = 0.0)
+    {
+      return this->Subscribe(_topic,
+          [_cb](const std::shared_ptr<const google::protobuf::Message> &_msg)
+          {
+            auto msg = std::dynamic_pointer_cast<const T>(_msg);
+            if (msg)
+              _cb(msg);
+          }, _maxRate);
+    }
+
+    /// \brief Subscribe to the serialized messages of a topic
+    /// \param[in] _topic Topic name
+    /// \param[in] _cb Callback called with each serialized message
+    /// \param[in] _maxRate Most messages per second to receive, 0 for all
+    /// \return Handle of the subscription, empty if the topic couldn't be
+    /// subscribed to
+    public: HubSubscription SubscribeRaw(const std::string &_topic,
+        const RawCallback &_cb, double _maxRate = 0.0);
+
+    /// \brief Get the rate a topic is subscribed at, which is that of its
+    /// fastest consumer
+    /// \param[in] _topic Topic name
+    /// \return Messages per second, 0 if unlimited or not subscribed
+    public: double SubscribedRate(const std::string &_topic) const;
+
+    /// \brief Cap the rate of the consumers which asked for at most a
+    /// number of messages per second. Consumers which asked for all
+    /// messages still get them all, since they may be counting or
+    /// recording them. Topics are subscribed again at their new rate.
+    /// \param[in] _rate Most messages per second, 0 to remove the cap
+    /// \sa Application::SetHiddenMaxRate
+    public: void SetRateCap(double _rate);
+
+    /// \brief Get the rate cap of consumers which asked for a rate
+    /// \return Messages per second, 0 if there's no cap
+    public: double RateCap() const;
+
+    /// \brief Receive a topic through shared memory when it's published
+    /// by a SharedMemoryPublisher on the same host. Its descriptors are
+    /// subscribed along with the topic, and once one can be read, the topic
+    /// itself is unsubscribed, so its publisher stops sending it through
+    /// transport. If the shared memory can't be read, for example because
+    /// the publisher is on another host, the topic is received through
+    /// transport again. Topics without shared memory descriptors are
+    /// received as usual. A message may be received twice while switching.
+    /// \param[in] _topic Topic name, now or once it's subscribed
+    /// \param[in] _enable True to allow shared memory, false to only use
+    /// transport
+    public: void SetSharedMemory(const std::string &_topic, bool _enable);
+
+    /// \brief Whether a topic is currently received through shared memory
+    /// \param[in] _topic Topic name
+    /// \return True if its messages come through shared memory
+    public: bool SharedMemoryActive(const std::string &_topic) const;
+
+    /// \brief Publish how fast a topic is consumed on FeedbackTopic(),
+    /// about once per second while its messages arrive. Each message is a
+    /// gz.msgs.Param with these params, all doubles except the first:
+    ///
+    /// * "consumer": Id of the hub, to tell apart GUIs of the same topic
+    /// * "period": Seconds the rest were measured over
+    /// * "requested_rate": Messages per second the topic is subscribed at,
+    ///   0 for all
+    /// * "received_rate": Messages per second which arrived
+    /// * "consumed_rate": Messages per second used by the fastest
+    ///   consumer, which are those passed to it minus those it reported
+    ///   dropped
+    /// * "skipped": Messages consumers skipped for arriving faster than
+    ///   the rate they asked for, added over all consumers
+    /// * "dropped": Messages consumers reported dropped, see
+    ///   HubSubscription::ReportDropped, added over all consumers
+    /// * "consumers": Number of consumers
+    ///
+    /// Cooperating publishers may adapt to the highest consumed rate of
+    /// all the GUIs they hear from.
+    /// \param[in] _topic Topic name, now or once it's subscribed
+    /// \param[in] _enable True to publish feedback
+    public: void SetFeedback(const std::string &_topic, bool _enable);
+
+    /// \brief Whether the feedback of a topic is published
+    /// \param[in] _topic Topic name
+    /// \return True if SetFeedback enabled it
+    public: bool Feedback(const std::string &_topic) const;
+
+    /// \brief Get the number of consumers of a topic
+    /// \param[in] _topic Topic name
+    /// \return Number of subscriptions
+    public: std::size_t SubscriberCount(const std::string &_topic) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_TASKPOOL_HH_
+#define GZ_GUI_TASKPOOL_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "gz/gui/Export.hh"
+#include "gz/gui/ThreadPolicy.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Worker threads shared by all plugins of an application, through
+  /// Application::Tasks, so plugins can move decoding and conversion off the
+  /// GUI and transport threads without each starting threads of their own.
+  ///
+  /// The number of threads is bounded, by default to one less than the
+  /// number of cores, leaving one for the GUI thread. Each thread has a
+  /// queue per priority. Tasks submitted from a worker go to its own queue,
+  /// others are spread over the workers, and workers which run out of tasks
+  /// take them from the others. Higher priority tasks are always taken
+  /// first.
+  ///
+  /// Tasks are submitted on behalf of an owner, usually a plugin, so all
+  /// the tasks of an owner can be cancelled together.
+  ///
+  /// Plugins usually go through Plugin::RunInBackground, which uses the
+  /// plugin as owner and cancels its tasks when it's unloaded.
+  class GZ_GUI_VISIBLE TaskPool
+  {
+    /// \brief Task priorities
+    public: enum class Priority
+    {
+      /// \brief Work whose result isn't needed soon, such as prefetching
+      LOW,
+
+      /// \brief Default
+      NORMAL,
+
+      /// \brief Work whose result is waited on, such as what's shown next
+      HIGH
+    };
+
+    /// \brief Constructor, starting the threads
+    /// \param[in] _threads Number of threads, 0 to use one less than the
+    /// number of cores. At least one thread is started.
+    public: explicit TaskPool(unsigned int _threads = 0);
+
+    /// \brief Destructor. Tasks which haven't started are dropped, and the
+    /// running ones are waited for.
+    public: ~TaskPool();
+
+    /// \brief Get the number of threads
+    /// \return Number of threads
+    public: unsigned int ThreadCount() const;
+
+    /// \brief Queue a task. Exceptions thrown by tasks are caught and
+    /// printed.
+    /// \param[in] _task Task, run on one of the threads
+    /// \param[in] _priority Priority
+    /// \param[in] _owner Object the task belongs to, may be null
+    /// \return ID of the task, 0 if the task is empty
+    public: std::uint64_t Submit(std::function<void()> _task,
+        Priority _priority = Priority::NORMAL,
+        const void *_owner = nullptr);
+
+    /// \brief Cancel a task which hasn't started
+    /// \param[in] _id ID returned by Submit
+    /// \return True if the task was removed before it started
+    public: bool Cancel(std::uint64_t _id);
+
+    /// \brief Cancel the tasks of an owner which haven't started, and wait
+    /// for those which are running. Running tasks aren't waited for when
+    /// called from one of the pool's threads, which could be running one of
+    /// them.
+    /// \param[in] _owner Owner given to Submit
+    /// \return Number of tasks removed before they started
+    public: std::size_t CancelOwner(const void *_owner);
+
+    /// \brief Get the number of tasks which haven't started
+    /// \return Number of queued tasks
+    public: std::size_t Pending() const;
+
+    /// \brief Set the priority and CPUs of the threads. Each thread applies
+    /// it before running its next task, or right away if it's idle, so
+    /// tasks submitted after this returns run with it.
+    /// \param[in] _policy Policy
+    public: void SetThreadPolicy(const ThreadPolicy &_policy);
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_THREADPOLICY_HH_
+#define GZ_GUI_THREADPOLICY_HH_
+
+#include <tinyxml2.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz::gui
+{
+  /// \brief Scheduling priority and CPUs of a thread, so the GUI, its
+  /// render thread and its worker threads can keep up when sharing the
+  /// machine with a simulation using all cores.
+  ///
+  /// Policies are applied by the thread itself, with
+  /// ApplyToCurrentThread. On Linux, priorities are nice values: LOW is 10,
+  /// NORMAL 0 and HIGH -10, which needs CAP_SYS_NICE or a high enough
+  /// RLIMIT_NICE. On Windows, they're the below normal, normal and above
+  /// normal thread priorities. Other platforms ignore policies.
+  ///
+  /// The default policy changes nothing.
+  struct GZ_GUI_VISIBLE ThreadPolicy
+  {
+    /// \brief Thread priorities
+    enum class Priority
+    {
+      /// \brief Keep the priority the thread started with
+      DEFAULT,
+
+      /// \brief Yields to other threads
+      LOW,
+
+      /// \brief Normal priority
+      NORMAL,
+
+      /// \brief Preferred over other threads
+      HIGH
+    };
+
+    /// \brief Priority
+    Priority priority{Priority::DEFAULT};
+
+    /// \brief CPUs the thread may run on, empty for any
+    std::vector<unsigned int> cpus;
+
+    /// \brief Whether the policy changes anything
+    /// \return True if neither a priority nor CPUs are set
+    bool Empty() const;
+
+    /// \brief Load a policy from XML, with optional children:
+    /// * \<priority\> : "low", "normal" or "high".
+    /// * \<cpus\> : CPUs the thread may run on, as a list of numbers and
+    ///              ranges such as "0-3,8".
+    /// * \<numa_node\> : NUMA node whose CPUs the thread may run on, so the
+    ///                   memory it touches stays close. Combined with
+    ///                   \<cpus\>, only the CPUs in both are used. Linux
+    ///                   only.
+    /// \param[in] _elem Element holding the children
+    /// \return False if a child is invalid, in which case it's ignored
+    bool Load(const tinyxml2::XMLElement *_elem);
+
+    /// \brief Apply the policy to the calling thread
+    /// \return False if part of it couldn't be applied, which is printed
+    bool ApplyToCurrentThread() const;
+
+    /// \brief Parse a list of CPUs
+    /// \param[in] _list Comma separated numbers and ranges, such as
+    /// "0-3,8"
+    /// \return Sorted CPUs without duplicates, nothing if the list is
+    /// invalid
+    static std::optional<std::vector<unsigned int>> ParseCpuList(
+        const std::string &_list);
+
+    /// \brief Get the CPUs of a NUMA node
+    /// \param[in] _node Node number
+    /// \return CPUs, empty if the node isn't known
+    static std::vector<unsigned int> NumaNodeCpus(unsigned int _node);
+  };
+}
+
+#endif
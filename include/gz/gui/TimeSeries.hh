@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_TIMESERIES_HH_
+#define GZ_GUI_TIMESERIES_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Bounded history of a plotted value, as (time, value) points
+  /// appended in time order.
+  ///
+  /// Points are stored in fixed size chunks, and whole chunks are dropped
+  /// once they're older than the retention window or the point limit is
+  /// exceeded, so appending never moves the stored points.
+  ///
+  /// Charts can draw a decimated view, keeping the minimum and maximum of
+  /// each pixel column, while exports read every stored point.
+  class DecimatedView;
+
+  class GZ_GUI_VISIBLE TimeSeries
+  {
+    /// \brief Constructor
+    public: TimeSeries();
+
+    /// \brief Destructor
+    public: ~TimeSeries();
+
+    /// \brief Set how far back in time points are kept.
+    /// \param[in] _window Time window, 0 to keep points regardless of
+    /// their time.
+    public: void SetRetention(double _window);
+
+    /// \brief Get how far back in time points are kept.
+    /// \return Time window, 0 if points are kept regardless of their time.
+    public: double Retention() const;
+
+    /// \brief Set the most points kept, the oldest ones are dropped first.
+    /// Points are dropped a whole chunk at a time, so up to a chunk of
+    /// points more may be kept.
+    /// \param[in] _maxPoints Maximum number of points
+    public: void SetMaxPoints(std::size_t _maxPoints);
+
+    /// \brief Get the most points kept.
+    /// \return Maximum number of points
+    public: std::size_t MaxPoints() const;
+
+    /// \brief Append a point. Its time should not be lower than the
+    /// previous point's.
+    /// \param[in] _x Time
+    /// \param[in] _y Value
+    public: void Append(double _x, double _y);
+
+    /// \brief Remove all points
+    public: void Clear();
+
+    /// \brief Get the number of points within the retention window
+    /// \return Number of points
+    public: std::size_t Size() const;
+
+    /// \brief Whether there are no points within the retention window
+    /// \return True if empty
+    public: bool Empty() const;
+
+    /// \brief Get the time of the oldest point within the retention window
+    /// \return Time of the oldest point, 0 if there are none
+    public: double Start() const;
+
+    /// \brief Get the time of the newest point
+    /// \return Time of the newest point, 0 if there are none
+    public: double End() const;
+
+    /// \brief Get all points within the retention window, at full
+    /// resolution.
+    /// \return Points in time order
+    public: std::vector<math::Vector2d> Points() const;
+
+    /// \brief Get a decimated view of a time range. Points are split into
+    /// `_buckets` slices of equal duration, and only the lowest and highest
+    /// point of each slice are kept, in time order. Ranges with no more
+    /// than two points per bucket are returned as they are.
+    /// \param[in] _xMin Start of the range
+    /// \param[in] _xMax End of the range
+    /// \param[in] _buckets Number of slices, such as the chart's width in
+    /// pixels
+    /// \return At most 2 * `_buckets` points, in time order
+    public: std::vector<math::Vector2d> Decimated(double _xMin, double _xMax,
+        unsigned int _buckets) const;
+
+    /// \brief Get a decimated view of all points within the retention
+    /// window.
+    /// \param[in] _buckets Number of slices
+    /// \return At most 2 * `_buckets` points, in time order
+    /// \sa Decimated(double, double, unsigned int)
+    public: std::vector<math::Vector2d> Decimated(
+        unsigned int _buckets) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+
+    friend class DecimatedView;
+  };
+
+  /// \brief Decimated view of a TimeSeries, kept up to date as points are
+  /// appended and the range scrolls, for a chart redrawn every frame.
+  ///
+  /// Slices are aligned to multiples of their duration, so they stay the
+  /// same while the range scrolls. Slices older than the newest point are
+  /// decimated once and kept, and only the newer ones are decimated again
+  /// on each update. Changing the slice duration, such as by zooming, or
+  /// scrolling back before the kept slices, decimates the whole range
+  /// again.
+  class GZ_GUI_VISIBLE DecimatedView
+  {
+    /// \brief Constructor
+    public: DecimatedView();
+
+    /// \brief Destructor
+    public: ~DecimatedView();
+
+    /// \brief Update the view
+    /// \param[in] _series Series to view
+    /// \param[in] _xMin Start of the range
+    /// \param[in] _xMax End of the range
+    /// \param[in] _buckets Number of slices, such as the chart's width in
+    /// pixels
+    /// \return True if the points changed
+    /// \sa TimeSeries::Decimated
+    public: bool Update(const TimeSeries &_series, double _xMin,
+        double _xMax, unsigned int _buckets);
+
+    /// \brief Forget the kept slices, so the next update decimates the
+    /// whole range
+    public: void Reset();
+
+    /// \brief Get the decimated points, which may start up to a slice
+    /// before the range and end up to a slice after it
+    /// \return Points in time order
+    public: const std::vector<math::Vector2d> &Points() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_TOPICREGISTRY_HH_
+#define GZ_GUI_TOPICREGISTRY_HH_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+
+#include "gz/gui/Export.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui
+{
+  /// \brief Cache of the Gazebo Transport topics and their message types,
+  /// shared by all plugins of an application through Application::Topics.
+  ///
+  /// A background thread keeps the cache up to date. Each scan lists the
+  /// topics once and only queries the publishers of topics which weren't
+  /// known yet, so looking up topics of a type doesn't cost a discovery
+  /// query per topic.
+  ///
+  /// Signals may be emitted from the scanning thread, connect to them with
+  /// the default connection type to receive them on the receiver's thread.
+  class GZ_GUI_VISIBLE TopicRegistry : public QObject
+  {
+    Q_OBJECT
+
+    /// \brief Constructor. Starts scanning in the background.
+    public: TopicRegistry();
+
+    /// \brief Destructor
+    public: ~TopicRegistry() override;
+
+    /// \brief Get the known topics.
+    /// \param[in] _msgType Only return topics with publishers of this
+    /// message type, such as "gz.msgs.Image". All topics if empty.
+    /// \return Sorted topic names
+    public: std::vector<std::string> Topics(
+        const std::string &_msgType = "") const;
+
+    /// \brief Get the message types published on a topic.
+    /// \param[in] _topic Topic name
+    /// \return Message types, empty if the topic isn't known
+    public: std::vector<std::string> MsgTypes(
+        const std::string &_topic) const;
+
+    /// \brief Update the cache now, blocking until done. Useful before
+    /// listing topics in response to the user.
+    public: void Scan();
+
+    /// \brief Ask the background thread to update the cache as soon as
+    /// possible, without blocking.
+    public: void Refresh();
+
+    /// \brief Set how often the background thread updates the cache.
+    /// \param[in] _period Time between scans
+    public: void SetScanPeriod(const std::chrono::milliseconds &_period);
+
+    /// \brief Notify that a topic was discovered.
+    /// \param[in] _topic Topic name
+    signals: void TopicAdded(const QString &_topic);
+
+    /// \brief Notify that a topic has no publishers anymore.
+    /// \param[in] _topic Topic name
+    signals: void TopicRemoved(const QString &_topic);
+
+    /// \brief Notify once per scan which added or removed topics.
+    signals: void TopicsChanged();
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_TREEMODEL_HH_
+#define GZ_GUI_TREEMODEL_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Export.hh"
+#include "gz/gui/qt.h"
+
+namespace gz::gui
+{
+  /// \brief Base of tree models holding many nodes, such as the entities
+  /// of large worlds, without an item object per node.
+  ///
+  /// The tree is kept as arrays indexed by node ids: each node's parent,
+  /// its row, and its children. Indices are made on demand out of a row
+  /// and the node id, and data is asked of the subclass through NodeData,
+  /// so subclasses keep their own per node data in arrays indexed by the
+  /// same ids. Ids of removed nodes are reused.
+  ///
+  /// Structure changes are batched:
+  ///
+  /// * InsertNodes and RemoveNodes change consecutive rows of a parent
+  ///   with a single insert or remove notification.
+  /// * NodesChanged notifies changes of many nodes with one dataChanged
+  ///   per parent.
+  /// * Between BeginReset and EndReset, changes aren't notified, and views
+  ///   and proxies, such as SearchModel, are reset once at the end. This
+  ///   is the fastest way to fill or rebuild a large tree.
+  ///
+  /// Items carrying a DataRole::URI_QUERY are dragged like DragDropModel's.
+  class GZ_GUI_VISIBLE TreeModel : public QAbstractItemModel
+  {
+    /// \brief Id of the invisible root, parent of the top level nodes
+    public: static constexpr int kRoot = -1;
+
+    /// \brief Constructor
+    public: TreeModel();
+
+    /// \brief Destructor
+    public: ~TreeModel() override;
+
+    /// \brief Insert nodes as consecutive rows of a parent. Views may ask
+    /// for the data of the new nodes as soon as they're notified, so
+    /// subclasses should set it in NodesInserting.
+    /// \param[in] _parent Parent node, kRoot for top level nodes
+    /// \param[in] _row Row of the first node, from 0 to the parent's
+    /// child count
+    /// \param[in] _count Number of nodes
+    /// \return Ids of the new nodes, in row order, empty if the parent or
+    /// row are invalid
+    public: std::vector<int> InsertNodes(int _parent, int _row, int _count);
+
+    /// \brief Append nodes to a parent
+    /// \param[in] _parent Parent node, kRoot for top level nodes
+    /// \param[in] _count Number of nodes
+    /// \return Ids of the new nodes, in row order
+    public: std::vector<int> AppendNodes(int _parent, int _count = 1);
+
+    /// \brief Remove consecutive rows of a parent, along with their
+    /// descendants
+    /// \param[in] _parent Parent node, kRoot for top level nodes
+    /// \param[in] _row Row of the first node
+    /// \param[in] _count Number of nodes
+    /// \return False if the parent or rows are invalid
+    public: bool RemoveNodes(int _parent, int _row, int _count);
+
+    /// \brief Remove a node and its descendants
+    /// \param[in] _node Node
+    /// \return False if the node isn't valid
+    public: bool RemoveNode(int _node);
+
+    /// \brief Remove all nodes
+    public: void Clear();
+
+    /// \brief Start changing many nodes at once. Changes aren't notified
+    /// until EndReset, which resets the model. Calls may be nested.
+    public: void BeginReset();
+
+    /// \brief Finish changing many nodes, resetting the model once the
+    /// outermost call ends
+    public: void EndReset();
+
+    /// \brief Notify that the data of nodes changed, with one dataChanged
+    /// per parent, over the rows from the first to the last changed one
+    /// \param[in] _nodes Changed nodes
+    /// \param[in] _roles Changed roles, empty for all
+    public: void NodesChanged(const std::vector<int> &_nodes,
+        const QVector<int> &_roles = QVector<int>());
+
+    /// \brief Whether a node exists
+    /// \param[in] _node Node
+    /// \return True if it does
+    public: bool Valid(int _node) const;
+
+    /// \brief Get the parent of a node
+    /// \param[in] _node Node
+    /// \return Parent, kRoot for top level nodes and invalid nodes
+    public: int Parent(int _node) const;
+
+    /// \brief Get the row of a node under its parent
+    /// \param[in] _node Node
+    /// \return Row, -1 for invalid nodes
+    public: int Row(int _node) const;
+
+    /// \brief Get the number of children of a node
+    /// \param[in] _node Node, kRoot for the top level
+    /// \return Number of children
+    public: int ChildCount(int _node) const;
+
+    /// \brief Get a child of a node
+    /// \param[in] _node Node, kRoot for the top level
+    /// \param[in] _row Row of the child
+    /// \return Child, kRoot if there's no such row
+    public: int Child(int _node, int _row) const;
+
+    /// \brief Get the number of nodes
+    /// \return Number of nodes, not counting the root
+    public: std::size_t NodeCount() const;
+
+    /// \brief Get the index of a node
+    /// \param[in] _node Node
+    /// \param[in] _column Column
+    /// \return Index, invalid for kRoot and invalid nodes
+    public: QModelIndex IndexOf(int _node, int _column = 0) const;
+
+    /// \brief Get the node of an index of this model
+    /// \param[in] _index Index
+    /// \return Node, kRoot for invalid indices
+    public: int NodeOf(const QModelIndex &_index) const;
+
+    /// \brief Get the data of a node. Called for every index of the node,
+    /// so it shouldn't allocate more than the value returned.
+    /// \param[in] _node Node
+    /// \param[in] _column Column
+    /// \param[in] _role Data role
+    /// \return Data, invalid if the node has none for the role
+    protected: virtual QVariant NodeData(int _node, int _column,
+        int _role) const = 0;
+
+    /// \brief Called with the ids of nodes being inserted, before the
+    /// insertion is notified, so subclasses may size their arrays and set
+    /// the data of the new nodes. Does nothing by default.
+    /// \param[in] _nodes New nodes
+    protected: virtual void NodesInserting(const std::vector<int> &_nodes);
+
+    /// \brief Called with the ids of nodes once they're removed, so
+    /// subclasses may release their data. Their ids may then be reused.
+    /// Does nothing by default.
+    /// \param[in] _nodes Removed nodes, including descendants
+    protected: virtual void NodesRemoved(const std::vector<int> &_nodes);
+
+    /// \brief Overloaded Qt method
+    /// \param[in] _row Row
+    /// \param[in] _column Column
+    /// \param[in] _parent Parent index
+    /// \return Index
+    public: QModelIndex index(int _row, int _column,
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    /// \brief Overloaded Qt method
+    /// \param[in] _index Index
+    /// \return Parent index
+    public: QModelIndex parent(const QModelIndex &_index) const override;
+
+    /// \brief Overloaded Qt method
+    /// \param[in] _parent Parent index
+    /// \return Number of children
+    public: int rowCount(const QModelIndex &_parent = QModelIndex()) const
+        override;
+
+    /// \brief Overloaded Qt method. One column by default.
+    /// \param[in] _parent Parent index
+    /// \return Number of columns
+    public: int columnCount(const QModelIndex &_parent = QModelIndex()) const
+        override;
+
+    /// \brief Overloaded Qt method
+    /// \param[in] _parent Parent index
+    /// \return True if it has children
+    public: bool hasChildren(const QModelIndex &_parent = QModelIndex()) const
+        override;
+
+    /// \brief Overloaded Qt method. Asks NodeData.
+    /// \param[in] _index Index
+    /// \param[in] _role Data role
+    /// \return Data
+    public: QVariant data(const QModelIndex &_index,
+        int _role = Qt::DisplayRole) const override;
+
+    /// \brief Overloaded Qt method. Nodes are enabled, selectable and
+    /// draggable.
+    /// \param[in] _index Index
+    /// \return Flags
+    public: Qt::ItemFlags flags(const QModelIndex &_index) const override;
+
+    /// \brief Overloaded Qt method. Passes the DataRole::URI_QUERY of the
+    /// first valid index, see DragDropModel.
+    /// \param[in] _indexes Dragged indices
+    /// \return Mime data
+    public: QMimeData *mimeData(const QModelIndexList &_indexes) const
+        override;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui
+#endif  // GZ_GUI_TREEMODEL_HH_
@@ -35,6 +35,20 @@ extern "C" GZ_GUI_VISIBLE void cmdStandalone(const char *_filename);
 /// \param[in] _config Path to a config file.
 extern "C" GZ_GUI_VISIBLE void cmdConfig(const char *_config);
 
+/// \brief External hook when executing 'gz gui -v' from the command line.
+/// \param[in] _verbosity Console verbosity, from 0 to 4.
+extern "C" GZ_GUI_VISIBLE void cmdVerbose(const char *_verbosity);
+
+/// \brief External hook when executing 'gz gui --startup-trace' from the
+/// command line.
+/// \param[in] _path Path of the trace file.
+extern "C" GZ_GUI_VISIBLE void cmdStartupTrace(const char *_path);
+
+/// \brief External hook when executing 'gz gui --gpu' from the command
+/// line.
+/// \param[in] _gpu Index or name of the GPU to render on.
+extern "C" GZ_GUI_VISIBLE void cmdGpu(const char *_gpu);
+
 /// \brief External hook to execute 'gz gui' from the command line.
 extern "C" GZ_GUI_VISIBLE void cmdEmptyWindow();
 
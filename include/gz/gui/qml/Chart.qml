@@ -20,6 +20,7 @@ import QtQuick.Controls 2.2
 import QtQuick.Controls.Styles 1.4
 import QtQuick.Controls.Material 2.1
 import QtQuick.Layouts 1.3
+import GzPlotting 1.0
 
 Rectangle {
   id: main
@@ -48,8 +49,8 @@ Rectangle {
   signal clicked(real Id);
 
   /**
-    Points Limitation: max points of each series
-    When points exceed that limit, some points from begining are deleted
+    Points Limitation: unused, the points are kept by the plotting
+    interface, see PlottingInterface::SetMaxPoints
   */
   property int maxPoints: 10000
   /**
@@ -71,6 +72,24 @@ Rectangle {
   {
     chart.appendPoint(_fieldID, _x, _y);
   }
+  /**
+    add several points to a specific field at once
+    _fieldID field ID or Path
+    _points list of points, each with x and y
+  */
+  function appendPoints(_fieldID, _points)
+  {
+    chart.appendPoints(_fieldID, _points);
+  }
+  /**
+    overlay a recording on the chart
+    _path path of a binary plot export
+  */
+  function addRecording(_path)
+  {
+    infoRect.addRecording(_path);
+    guideText.visible = false;
+  }
   /**
     set the chart opacity
     _opacity opacity value
@@ -139,6 +158,14 @@ Rectangle {
     */
     function onDrop(text)
     {
+      // a recording, such as the binary export of a previous run
+      if (text.indexOf("file://") === 0)
+      {
+        infoRect.addRecording(text.trim());
+        guideText.visible = false;
+        return;
+      }
+
       // topic and path is separated with ','
       if (text.search(",") === -1)
         return;
@@ -216,6 +243,47 @@ Rectangle {
       field.path = path;
       field.type = "Field"
     }
+    /**
+      overlay a recording on the chart. It's mapped by the plotting
+      interface, and only the visible range is drawn.
+      url "file://" URL or path of a binary plot export
+    */
+    function addRecording(url)
+    {
+      var ID = PlottingIface.loadRecording(chartID, url);
+      if (ID === "" || ID in chart.serieses)
+        return;
+
+      var name = url.substring(url.lastIndexOf("/") + 1);
+      chart.addSeries(ID, name);
+
+      // fit an empty chart to the start of the recording, without reading
+      // the rest of it
+      if (!chart.hasPoints)
+      {
+        var span = PlottingIface.recordingSpan(chartID, ID);
+        var end = Math.min(span.y, span.x + 10);
+        chart.appendPoints(ID, PlottingIface.decimated(chartID, ID, span.x,
+                           end, Math.max(1, Math.ceil(chart.plotArea.width))));
+      }
+
+      var field = fieldInfo.createObject(row);
+      field.width = 150;
+      field.height = Qt.binding( function() {return infoRect.height * 0.8} );
+      field.y = Qt.binding( function()
+        {
+          if (infoRect.height)
+            return (infoRect.height - field.height)/2;
+          else
+            return 0;
+        }
+      );
+
+      field.topic = name;
+      field.path = ID;
+      field.type = "Recording";
+    }
+
     /**
       add component to the chart
       entity entity ID
@@ -268,7 +336,7 @@ Rectangle {
 
     Text {
       id: guideText
-      text: qsTr("Drag & Drop Plottable Fields | Components")
+      text: qsTr("Drag & Drop Plottable Fields | Components | Recordings")
       anchors.centerIn: parent
       color: (Material.theme == Material.Light) ? "gray" : "white"
       opacity: 0.3
@@ -306,7 +374,7 @@ Rectangle {
       id: component
 
       /**
-        Field or Component
+        Field, Component or Recording
       */
       property string type: ""
 
@@ -361,7 +429,8 @@ Rectangle {
           id: fieldname
           text: (component.type === "Field") ? component.topic + "/"+ component.path :
                 (component.type === "Component") ? component.entity + "," + component.typeName
-                                                   + "," + component.attribute : ""
+                                                   + "," + component.attribute :
+                (component.type === "Recording") ? component.topic : ""
           color: "white"
           elide: Text.ElideRight
           width: parent.width * 0.9
@@ -377,7 +446,8 @@ Rectangle {
                                                     "typeId: " + component.typeId + "\n" +
                                                     "typeName: " + component.typeName + "\n" +
                                                     "dataType: " + component.componentType + "\n" +
-                                                    "attribute: " + component.attribute : ""
+                                                    "attribute: " + component.attribute :
+                (component.type === "Recording") ? component.path : ""
           visible: fieldInfoMouse.containsMouse
           y: fieldInfoMouse.mouseY
           x: fieldInfoMouse.mouseX
@@ -419,6 +489,13 @@ Rectangle {
             else if (component.type === "Component")
               chart.deleteSeries(component.componentId);
 
+            // stop drawing the recording and unmap it
+            else if (component.type === "Recording")
+            {
+              chart.deleteSeries(component.path);
+              PlottingIface.unloadRecording(main.chartID, component.path);
+            }
+
             // delete the field info component
             component.destroy();
           }
@@ -454,6 +531,10 @@ Rectangle {
       current index of colors array
     */
     property int indexColor: 0
+    /**
+      True once the axes were set from the first point
+    */
+    property bool hasPoints: false
 
     /**
       get sereieses
@@ -492,6 +573,7 @@ Rectangle {
       newSeries.width = 2;
       newSeries.color = chart.colors[chart.indexColor % chart.colors.length]
       serieses[ID] = newSeries;
+      plotLines.setSeries(ID, newSeries.color);
 
       chart.indexColor = (chart.indexColor + 1)  % chart.colors.length;
     }
@@ -501,8 +583,9 @@ Rectangle {
       ID field path
     */
     function deleteSeries(ID) {
-      // remove the points of the series from the chart
+      // remove the series from the chart and stop drawing its points
       removeSeries(serieses[ID]);
+      plotLines.removeSeries(ID);
       // remove the series key from the serieses map
       delete serieses[ID];
     }
@@ -520,12 +603,11 @@ Rectangle {
 
       // if this is the first point (if the chart is empty):
       // set the min/max according to that point's coordinates
-      // note: count == 2: because chart has 1 series by default to show plotting grid
-      if (chart.count === 2 && chart.serieses[_fieldID].count === 0)
+      if (!chart.hasPoints)
       {
         xAxis.min = _x;
         xAxis.max = _x + 10;
-        chart.serieses[_fieldID].append(_x, _y);
+        chart.hasPoints = true;
         return;
       }
 
@@ -543,13 +625,62 @@ Rectangle {
       if (xAxis.min > _x)
         xAxis.min = _x ;
 
-      // add the point
-      chart.serieses[_fieldID].append(_x, _y);
+      // the point itself is drawn by plotLines, from the plotting interface
+      chart.updateHoverText();
+    }
+
+    /**
+      add several points to a specific field, updating the axes and the
+      hover text only once
+      _fieldID field ID or Path
+      _points list of points, each with x and y
+    */
+    function appendPoints(_fieldID, _points)
+    {
+      var series = chart.serieses[_fieldID];
+      if (!series || _points.length === 0)
+        return;
+
+      var first = 0;
+
+      // if this is the first point (if the chart is empty):
+      // set the min/max according to that point's coordinates
+      if (!chart.hasPoints)
+      {
+        xAxis.min = _points[0].x;
+        xAxis.max = _points[0].x + 10;
+        chart.hasPoints = true;
+        first = 1;
+      }
 
-      // delete the oldest point to limit the points size
-      if (chart.serieses[_fieldID].count > maxPoints)
-          chart.serieses[_fieldID].removePoints(0,1)
+      var minX = xAxis.min;
+      var maxX = xAxis.max;
+      var minY = yAxis.min;
+      var maxY = yAxis.max;
+      for (var i = first; i < _points.length; ++i)
+      {
+        var point = _points[i];
+        minX = Math.min(minX, point.x);
+        maxX = Math.max(maxX, point.x);
+        minY = Math.min(minY, point.y);
+        maxY = Math.max(maxY, point.y);
+      }
 
+      // expand the chart boundries if needed
+      if (xAxis.max < maxX)
+      {
+        xAxis.max = maxX;
+        chart.scrollRight(chart.width * 0.0012);
+      }
+      if (yAxis.max < maxY)
+        yAxis.max = maxY;
+      if (yAxis.min > minY)
+        yAxis.min = minY;
+      if (xAxis.min > minX)
+        xAxis.min = minX;
+
+      // the points themselves are drawn by plotLines, from the full history
+      // kept by the plotting interface
       chart.updateHoverText();
     }
 
@@ -707,6 +838,21 @@ Rectangle {
       useOpenGL: true
     }
 
+    // draws the points of all serieses, the line serieses only show
+    // in the legend
+    PlotLines {
+      id: plotLines
+      source: PlottingIface
+      chartID: main.chartID
+      x: chart.plotArea.x
+      y: chart.plotArea.y
+      width: chart.plotArea.width
+      height: chart.plotArea.height
+      range: Qt.rect(xAxis.min, yAxis.min, xAxis.max - xAxis.min,
+                     yAxis.max - yAxis.min)
+      clip: true
+    }
+
     Text {
       id: plotName
       text: "Plot " + chartID.toString()
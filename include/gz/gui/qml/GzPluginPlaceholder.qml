@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+
+// Stands in for a lazily loaded plugin until its card is first shown
+Item {
+  Layout.minimumWidth: 200
+  Layout.minimumHeight: 100
+
+  BusyIndicator {
+    id: busy
+    anchors.centerIn: parent
+    running: visible
+  }
+
+  Label {
+    anchors.top: busy.bottom
+    anchors.horizontalCenter: parent.horizontalCenter
+    text: "Loading..."
+  }
+}
@@ -43,6 +43,12 @@ SplitView {
    */
   property variant childSplits: new Object()
 
+  /**
+   * True while many items are being added or resized at once, such as when
+   * loading a config. The splits are laid out once it's reset.
+   */
+  property bool layoutSuspended: false
+
   /**
    * Callback when the height changed.
    */
@@ -51,6 +57,14 @@ SplitView {
     background.recalculateMinimumSizes();
   }
 
+  /**
+   * Callback when the layout is suspended or resumed.
+   */
+  onLayoutSuspendedChanged:
+  {
+    background.recalculateMinimumSizes();
+  }
+
   Rectangle {
     id: startLabel;
     visible: MainWindow.pluginCount === 0
@@ -71,6 +85,9 @@ SplitView {
    */
   function recalculateMinimumSizes()
   {
+    if (layoutSuspended)
+      return;
+
     for (var name in childSplits)
     {
       childSplits[name].split.recalculateMinimumSize()
@@ -339,6 +356,9 @@ SplitView {
            */
           function recalculateMinimumSize()
           {
+            if (background.layoutSuspended)
+              return;
+
             // TODO(louise): generalize to support horizontal splits
             if (orientation === Qt.Horizontal)
             {
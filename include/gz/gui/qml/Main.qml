@@ -234,6 +234,16 @@ ApplicationWindow
         }
       }
     }
+
+    // Plugins of a config loaded progressively
+    ProgressBar {
+      objectName: "loadProgress"
+      anchors.left: parent.left
+      anchors.right: parent.right
+      anchors.bottom: parent.bottom
+      value: MainWindow.loadProgress
+      visible: MainWindow.loadProgress < 1
+    }
   }
 
   /**
@@ -184,9 +184,34 @@ Rectangle
     charts[_chart].appendPoint(_fieldID, _x, _y);
   }
 
+  /**
+  plot several points to a chart at once
+  _chart: chart id
+  _fieldID: field path or id
+  _points: list of points, each with x and y
+  */
+  function handlePlotBatch(_chart, _fieldID, _points)
+  {
+    if (charts[_chart])
+      charts[_chart].appendPoints(_fieldID, _points);
+  }
+
+  /**
+  overlay a recording offered by a plugin on a chart
+  _chart: chart id
+  _path: path of a binary plot export
+  */
+  function handleRecordingOffered(_chart, _path)
+  {
+    if (charts[_chart])
+      charts[_chart].addRecording(_path);
+  }
+
   Connections {
     target: PlottingIface
     onPlot : handlePlot(_chart, _fieldID, _x, _y);
+    onPlotBatch : handlePlotBatch(_chart, _fieldID, _points);
+    onRecordingOffered : handleRecordingOffered(_chart, _path);
   }
 
 
@@ -415,9 +440,11 @@ Rectangle
 
       /**
       export all selected charts in the export window to that path
+      format "csv" or "bin", files are written in the background
       */
-      function exportCSV(path)
+      function exportData(path, format)
       {
+      var success = true;
       for (var i = 0; i < chartImages.length; i++)
       {
         if (!chartImages[i].isSelected())
@@ -449,8 +476,10 @@ Rectangle
           chartSerieses[key] = seriesArray;
         });
 
-        return PlottingIface.exportCSV(path, chart_id, chartSerieses);
+        success = PlottingIface.exportData(path, chart_id, chartSerieses,
+            format) && success;
       }
+      return success;
       }
 
       /**
@@ -500,7 +529,7 @@ Rectangle
           property string color: Material.primaryColor
 
           displayText: "Export to"
-          model: ["CSV"]
+          model: ["CSV", "Binary"]
 
           background: Rectangle {
             implicitWidth: 120
@@ -547,9 +576,11 @@ Rectangle
         options: FolderDialog.ShowDirsOnly
 
         onAccepted: {
-          if (exportBtn.currentText == "CSV")
+          if (exportBtn.currentText == "CSV" ||
+              exportBtn.currentText == "Binary")
           {
-            var success = exportApp.exportCSV(folder);
+            var format = exportBtn.currentText == "CSV" ? "csv" : "bin";
+            var success = exportApp.exportData(folder, format);
             if (success)
               exportApp.close();
           }
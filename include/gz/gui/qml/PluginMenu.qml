@@ -29,6 +29,9 @@ Popup {
     function onConfigChanged() {
       filteredModel.model = MainWindow.PluginListModel()
     }
+    function onPluginListModelChanged() {
+      filteredModel.model = MainWindow.PluginListModel()
+    }
   }
 
   /**
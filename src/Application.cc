@@ -16,8 +16,28 @@
  */
 
 #include <qsgrendererinterface.h>
+#if QT_CONFIG(vulkan)
+#  include <QVulkanFunctions>
+#  include <QVulkanInstance>
+#endif
 #include <tinyxml2.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
@@ -26,28 +46,290 @@
 #include <gz/common/SystemPaths.hh>
 #include <gz/common/Util.hh>
 
+#include <gz/msgs/param.pb.h>
+
 #include <gz/plugin/Loader.hh>
 
 #include "gz/gui/Application.hh"
+#include "gz/gui/AsyncLog.hh"
+#include "gz/gui/AsyncRequests.hh"
 #include "gz/gui/config.hh"
 #include "gz/gui/Dialog.hh"
+#include "gz/gui/GpuSelection.hh"
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/InstallationDirectories.hh"
+#include "gz/gui/LatencyTrace.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/NodePool.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/PluginIndex.hh"
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/StallWatchdog.hh"
+#include "gz/gui/StartupTrace.hh"
+#include "gz/gui/SubscriptionHub.hh"
+#include "gz/gui/TaskPool.hh"
+#include "gz/gui/ThreadPolicy.hh"
+#include "gz/gui/TopicRegistry.hh"
 
 #include "gz/transport/TopicUtils.hh"
 
+namespace
+{
+/// \brief A plugin library loaded ahead of its instantiation
+class PreloadedLibrary
+{
+  /// \brief Path to the library, empty if it wasn't found
+  public: std::string path;
+
+  /// \brief Loader holding the library
+  public: std::unique_ptr<gz::plugin::Loader> loader;
+
+  /// \brief Plugins in the library, empty if it couldn't be loaded
+  public: std::unordered_set<std::string> pluginNames;
+};
+
+/// \brief Filename of the plugin standing in for lazily loaded plugins
+constexpr const char *kPlaceholderFilename{"GzPluginPlaceholder"};
+
+/// \brief Milliseconds after a plugin is removed before warning that it
+/// hasn't been destroyed
+constexpr int kLeakCheckDelay{5000};
+
+/// \brief Card standing in for a lazily loaded plugin, until the card is
+/// first shown
+class LazyPlugin : public gz::gui::Plugin
+{
+  // Documentation inherited
+  public: void LoadConfig(const tinyxml2::XMLElement *) override
+  {
+    if (this->title.empty())
+      this->title = this->filename;
+  }
+
+  /// \brief Whether the card is visible and expanded
+  /// \return True if shown
+  public: bool Shown() const
+  {
+    auto *cardItem = this->CardItem();
+    return nullptr != cardItem && cardItem->isVisible() &&
+        (cardItem->state() == "docked" || cardItem->state() == "floating");
+  }
+
+  /// \brief Keep the config of the plugin, which is also the config saved
+  /// while the plugin isn't loaded
+  /// \param[in] _config Plugin element
+  public: void SetConfig(const std::string &_config)
+  {
+    this->configStr = _config;
+  }
+
+  /// \brief Filename of the plugin to load
+  public: std::string filename;
+
+  /// \brief Whether the plugin is loaded while the application is idle,
+  /// before being shown
+  public: bool preload{false};
+
+  /// \brief Whether loading the plugin failed, so it's not attempted again
+  public: bool failed{false};
+};
+
+/// \brief Get whether a plugin is loaded lazily, from its `<lazy>` and
+/// `<preload>` elements inside `<gz-gui>`
+/// \param[in] _pluginElem Plugin element, may be null
+/// \param[out] _preload Whether the plugin is loaded while idle
+/// \return True if the plugin is loaded lazily
+bool LazyConfig(const tinyxml2::XMLElement *_pluginElem, bool &_preload)
+{
+  _preload = false;
+  if (nullptr == _pluginElem)
+    return false;
+
+  const auto *guiElem = _pluginElem->FirstChildElement("gz-gui");
+  if (nullptr == guiElem)
+    return false;
+
+  bool lazy{false};
+  if (const auto *lazyElem = guiElem->FirstChildElement("lazy"))
+    lazyElem->QueryBoolText(&lazy);
+  if (const auto *preloadElem = guiElem->FirstChildElement("preload"))
+    preloadElem->QueryBoolText(&_preload);
+  return lazy;
+}
+
+/// \brief Choose the GPU requested for OpenGL, whose drivers read it once Qt
+/// connects to the display, so before the QApplication is constructed
+/// \param[in] _argc Argument count, passed through
+/// \param[in] _renderEngineGuiApiBackend Graphics API requested, null for
+/// the default
+/// \return _argc
+int &selectOpenGlGpu(int &_argc, const char *_renderEngineGuiApiBackend)
+{
+#ifndef __APPLE__
+  if (nullptr == _renderEngineGuiApiBackend ||
+      std::string(_renderEngineGuiApiBackend) != "vulkan")
+  {
+    gz::gui::GpuSelection::ApplyOpenGlEnvironment();
+  }
+#else
+  (void)_renderEngineGuiApiBackend;
+#endif
+  return _argc;
+}
+
+#if QT_CONFIG(vulkan)
+/// \brief Find the Vulkan device matching a requested GPU
+/// \param[in] _gpu Index or name
+/// \return Index of the device, nothing if none matches
+std::optional<unsigned int> vulkanGpuIndex(const std::string &_gpu)
+{
+  QVulkanInstance instance;
+  if (!instance.create())
+    return std::nullopt;
+
+  auto *functions = instance.functions();
+  uint32_t count{0};
+  functions->vkEnumeratePhysicalDevices(instance.vkInstance(), &count,
+      nullptr);
+  std::vector<VkPhysicalDevice> devices(count);
+  functions->vkEnumeratePhysicalDevices(instance.vkInstance(), &count,
+      devices.data());
+
+  std::vector<std::string> names;
+  for (const auto &device : devices)
+  {
+    VkPhysicalDeviceProperties properties;
+    functions->vkGetPhysicalDeviceProperties(device, &properties);
+    gzdbg << "Vulkan GPU " << names.size() << ": [" << properties.deviceName
+          << "]" << std::endl;
+    names.emplace_back(properties.deviceName);
+  }
+
+  auto index = gz::gui::GpuSelection::Match(_gpu, names);
+  if (!index.has_value())
+    return std::nullopt;
+  return static_cast<unsigned int>(*index);
+}
+#endif
+}  // namespace
+
 namespace gz::gui
 {
 class Application::Implementation
 {
+  /// \brief Find the shared library of a plugin. Safe to call from any
+  /// thread while plugin paths aren't added.
+  /// \param[in] _filename Plugin filename, such as "Publisher"
+  /// \return Path to the library, empty if not found
+  public: std::string FindLibrary(const std::string &_filename) const;
+
+  /// \brief Find a plugin in the library bundling the core plugins, which
+  /// is loaded the first time. Safe to call from any thread.
+  /// \param[in] _filename Plugin filename, such as "Publisher"
+  /// \param[out] _pluginName Name of the plugin in the bundle
+  /// \return The bundle, null if the plugin isn't bundled, or if the core
+  /// plugins are built as separate libraries
+  public: const PreloadedLibrary *Bundled(const std::string &_filename,
+      std::string &_pluginName);
+
+  /// \brief Start compiling the QML of a plugin in the background
+  /// \param[in] _filename Plugin filename
+  public: void Precompile(const std::string &_filename);
+
+  /// \brief Load the libraries of plugins concurrently and start compiling
+  /// their QML in the background, so LoadPlugin only has to instantiate
+  /// them.
+  /// \param[in] _filenames Plugin filenames
+  public: void Preload(const std::vector<std::string> &_filenames);
+
+  /// \brief Instantiate a plugin and its card, without adding it to a
+  /// window
+  /// \param[in] _filename Plugin filename
+  /// \param[in] _pluginElem Element containing plugin configuration, may be
+  /// null
+  /// \return The plugin, null if it failed
+  public: std::shared_ptr<Plugin> Instantiate(const std::string &_filename,
+      const tinyxml2::XMLElement *_pluginElem);
+
+  /// \brief Create the placeholder of a lazily loaded plugin, which loads
+  /// the plugin the first time its card is shown
+  /// \param[in] _app Application
+  /// \param[in] _filename Plugin filename
+  /// \param[in] _pluginElem Element containing plugin configuration
+  /// \param[in] _preload Whether to load the plugin while idle
+  /// \return The placeholder, null if it failed
+  public: std::shared_ptr<Plugin> Placeholder(Application *_app,
+      const std::string &_filename, const tinyxml2::XMLElement *_pluginElem,
+      bool _preload);
+
+  /// \brief Load the plugin of a placeholder and put its card in the
+  /// placeholder's place
+  /// \param[in] _app Application
+  /// \param[in] _placeholder Placeholder, may have been removed
+  public: void Activate(Application *_app,
+      const QPointer<Plugin> &_placeholder);
+
+  /// \brief Load the next placeholder's plugin which should be loaded
+  /// while idle, and stop the idle timer once there are none left
+  /// \param[in] _app Application
+  public: void PreloadNext(Application *_app);
+
+  /// \brief Get the main window a plugin was added to
+  /// \param[in] _plugin Plugin
+  /// \return Its window, or the current one if it wasn't added to one
+  public: MainWindow *WindowOf(const Plugin *_plugin) const;
+
+  /// \brief Count the plugins added to a main window
+  /// \param[in] _window Window
+  /// \return Number of plugins
+  public: std::size_t PluginCount(const MainWindow *_window) const;
+
+  /// \brief Add a plugin of `pluginsAdded` to the indices
+  /// \param[in] _plugin Plugin
+  public: void Index(const std::shared_ptr<Plugin> &_plugin);
+
+  /// \brief Remove a plugin from the indices
+  /// \param[in] _plugin Plugin
+  public: void Unindex(const std::shared_ptr<Plugin> &_plugin);
+
+  /// \brief Load the next plugin of the config being loaded progressively,
+  /// and finish loading it once there are none left
+  /// \param[in] _app Application
+  public: void LoadNextPlugin(Application *_app);
+
+  /// \brief Warn about the removed plugins which are still alive, once
+  /// each, and forget those which were destroyed
+  public: void CheckLeaks();
+
+  /// \brief Get the filename a plugin was instantiated from
+  /// \param[in] _plugin Plugin
+  /// \return Its filename, empty if unknown
+  public: std::string FilenameOf(const Plugin *_plugin) const;
+
+  /// \brief Remove the plugins of an additional main window which was
+  /// closed, and delete it
+  /// \param[in] _app Application
+  /// \param[in] _window Window
+  public: void CloseWindow(Application *_app, MainWindow *_window);
+
+  /// \brief Suspend or resume laying out the main window's splits. They're
+  /// laid out again once resumed.
+  /// \param[in] _suspended True to suspend
+  public: void SetLayoutSuspended(bool _suspended);
+
+  /// \brief Cap the subscription rates while no main window is exposed,
+  /// and lift the cap once one is
+  public: void UpdateRateCap();
+
   /// \brief QML engine
   public: QQmlApplicationEngine *engine{nullptr};
 
-  /// \brief Pointer to main window
+  /// \brief Main window configs and plugins are loaded into
   public: MainWindow *mainWin{nullptr};
 
+  /// \brief All main windows, the first one receives the events
+  public: std::vector<MainWindow *> mainWindows;
+
   /// \brief Vector of pointers to dialogs
   public: std::vector<Dialog *> dialogs;
 
@@ -58,6 +340,33 @@ class Application::Implementation
   /// these until it is ok to unload the plugin's shared library.
   public: std::vector<std::shared_ptr<Plugin>> pluginsAdded;
 
+  /// \brief Plugins in `pluginsAdded` by their card's object name
+  public: std::unordered_map<std::string, std::shared_ptr<Plugin>>
+      pluginsByName;
+
+  /// \brief Plugins in `pluginsAdded` by filename, in the order they were
+  /// added
+  public: std::unordered_map<std::string,
+      std::vector<std::shared_ptr<Plugin>>> pluginsByFilename;
+
+  /// \brief Filename of each instantiated plugin, until it's removed
+  public: std::unordered_map<const Plugin *, std::string> filenames;
+
+  /// \brief A plugin which was removed, kept track of until it's destroyed
+  public: struct RemovedPlugin
+  {
+    /// \brief Name and filename, for reporting
+    std::string description;
+
+    /// \brief The plugin, expired once destroyed
+    std::weak_ptr<Plugin> plugin;
+
+    /// \brief Whether it was reported as leaked
+    bool reported{false};
+  };
+
+  /// \brief Removed plugins which may still be alive
+  public: std::vector<RemovedPlugin> removedPlugins;
 
   /// \brief Environment variable which holds paths to look for plugins
   public: std::string pluginPathEnv = "GZ_GUI_PLUGIN_PATH";
@@ -75,6 +384,116 @@ class Application::Implementation
 
   public: common::SignalHandler signalHandler;
 
+  /// \brief Topics shared by all plugins, created on demand
+  public: mutable std::unique_ptr<TopicRegistry> topics;
+
+  /// \brief Protects creating `topics`
+  public: mutable std::mutex topicsMutex;
+
+  /// \brief Subscriptions shared by all plugins, created on demand
+  public: mutable std::unique_ptr<SubscriptionHub> subscriptions;
+
+  /// \brief Rate cap of `subscriptions`, kept for when it's created.
+  /// Protected by `topicsMutex`.
+  public: double rateCap{0.0};
+
+  /// \brief Most messages per second of rate limited subscriptions while
+  /// no main window is exposed, 0 for no cap
+  public: double hiddenMaxRate{0.0};
+
+  /// \brief Service requests shared by all plugins, created on demand
+  public: mutable std::unique_ptr<AsyncRequests> requests;
+
+  /// \brief Transport nodes shared by all plugins, created on demand
+  public: mutable std::unique_ptr<NodePool> nodes;
+
+  /// \brief Worker threads shared by all plugins, started on demand
+  public: mutable std::unique_ptr<TaskPool> tasks;
+
+  /// \brief Priority and CPUs of `tasks`, kept for when it's started.
+  /// Protected by `topicsMutex`.
+  public: ThreadPolicy taskThreadPolicy;
+
+  /// \brief Number of threads loading the plugin libraries of a config,
+  /// 1 to load them one after another
+  public: unsigned int pluginLoadThreads{1};
+
+  /// \brief Libraries loaded by Preload, by plugin filename, until their
+  /// plugins are instantiated
+  public: std::map<std::string, PreloadedLibrary> preloaded;
+
+  /// \brief Protects `bundle` and `bundled`
+  public: std::mutex bundleMutex;
+
+  /// \brief Library bundling the core plugins, once found
+  public: PreloadedLibrary bundle;
+
+  /// \brief Plugin names in the bundle, by plugin filename
+  public: std::unordered_map<std::string, std::string> bundled;
+
+  /// \brief QML of the preloaded plugins, compiled in the background
+  public: std::vector<std::unique_ptr<QQmlComponent>> precompiled;
+
+  /// \brief Plugin libraries of each plugin directory, kept on disk
+  public: PluginIndex pluginIndex;
+
+  /// \brief Loads the lazy plugins which opted into preloading, one per
+  /// timeout. Its 0 interval makes it time out when there are no events to
+  /// process.
+  public: QTimer idleTimer;
+
+  /// \brief Watches the indexed plugin directories, so unchanged ones
+  /// aren't checked again
+  public: QFileSystemWatcher pluginWatcher;
+
+  /// \brief Whether LoadPlugin only queues plugins, so a config's plugins
+  /// are added to the window together
+  public: bool deferAddToWindow{false};
+
+  /// \brief Whether configs are loaded progressively
+  public: bool progressiveLoad{false};
+
+  /// \brief Plugin elements of the config being loaded progressively
+  /// which are still to be loaded, printed
+  public: std::deque<std::string> pendingPlugins;
+
+  /// \brief Number of plugins of the config being loaded progressively
+  public: int pendingTotal{0};
+
+  /// \brief Whether the plugins of that config loaded so far succeeded
+  public: bool pendingSuccess{true};
+
+  /// \brief Whether the libraries of that config are still to be preloaded
+  public: bool pendingPreload{false};
+
+  /// \brief Window that config is loaded into
+  public: QPointer<MainWindow> pendingWindow;
+
+  /// \brief Loads the pending plugins, one per timeout
+  public: QTimer progressiveTimer;
+
+  /// \brief Beats for the GUI thread while the stall watchdog runs
+  public: QTimer watchdogTimer;
+
+  /// \brief Whether the stall watchdog's topic is advertised, owned by
+  /// `watchdogTimer` in the node pool
+  public: bool stallTopic{false};
+
+  /// \brief Timeline of the startup
+  public: StartupTrace trace;
+
+  /// \brief File the startup trace is written to, empty if not tracing
+  public: std::string tracePath;
+
+  /// \brief Whether the main window's first frame was traced
+  public: std::atomic<bool> firstFrameTraced{false};
+
+  /// \brief Latencies from msg reception to the frames showing them
+  public: LatencyTrace latency;
+
+  /// \brief File the latency trace is written to, empty if not tracing
+  public: std::string latencyPath;
+
   /// \brief QT message handler that pipes qt messages into our console
   /// system.
   public: static void MessageHandler(QtMsgType _type,
@@ -91,11 +510,25 @@ enum class GZ_COMMON_HIDDEN AvailableAPIs
 /////////////////////////////////////////////////
 Application::Application(int &_argc, char **_argv, const WindowType _type,
                          const char *_renderEngineGuiApiBackend) :
-  QApplication(_argc, _argv),
+  QApplication(selectOpenGlGpu(_argc, _renderEngineGuiApiBackend), _argv),
   dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
+  const auto constructionStart = StartupTrace::Clock::now();
   gzdbg << "Initializing application." << std::endl;
 
+  // Trace the startup if requested, such as with `gz gui --startup-trace`
+  if (common::env("GZ_GUI_STARTUP_TRACE", this->dataPtr->tracePath) &&
+      !this->dataPtr->tracePath.empty())
+  {
+    this->dataPtr->trace.SetEnabled(true);
+  }
+
+  if (common::env("GZ_GUI_LATENCY_TRACE", this->dataPtr->latencyPath) &&
+      !this->dataPtr->latencyPath.empty())
+  {
+    this->dataPtr->latency.SetEnabled(true);
+  }
+
   this->setOrganizationName("Gazebo");
   this->setOrganizationDomain("gazebosim.org");
   this->setApplicationName("Gazebo GUI");
@@ -167,6 +600,26 @@ Application::Application(int &_argc, char **_argv, const WindowType _type,
 #  endif
     );
 
+    // Qt creates the device by index, as the window is first shown
+    const auto gpu = GpuSelection::Requested();
+    if (!gpu.empty())
+    {
+      auto index = GpuSelection::Index(gpu);
+#if QT_CONFIG(vulkan)
+      if (!index.has_value())
+        index = vulkanGpuIndex(gpu);
+#endif
+      if (index.has_value())
+      {
+        qputenv("QT_VK_PHYSICAL_DEVICE_INDEX", QByteArray::number(*index));
+      }
+      else
+      {
+        gzwarn << "No Vulkan GPU matches [" << gpu
+               << "]. Using the default GPU." << std::endl;
+      }
+    }
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
     QQuickWindow::setGraphicsApi(QSGRendererInterface::VulkanRhi);
 #else
@@ -202,6 +655,40 @@ Application::Application(int &_argc, char **_argv, const WindowType _type,
   this->dataPtr->defaultConfigPath = common::joinPaths(
         home, ".gz", "gui", "default.config");
 
+  // Plugin directories are listed again only once they change
+  this->dataPtr->pluginIndex.SetFile(common::joinPaths(
+        home, ".gz", "gui", "plugin_index"));
+  this->connect(&this->dataPtr->pluginWatcher,
+      &QFileSystemWatcher::directoryChanged, this,
+      [this](const QString &_dir)
+      {
+        this->dataPtr->pluginIndex.Invalidate(_dir.toStdString());
+        emit this->PluginListChanged();
+      });
+
+  // Configs loaded progressively get one plugin per event loop iteration
+  this->dataPtr->progressiveTimer.setInterval(0);
+  this->connect(&this->dataPtr->progressiveTimer, &QTimer::timeout, this,
+      [this]()
+      {
+        this->dataPtr->LoadNextPlugin(this);
+      });
+
+  // The GUI thread only beats when it gets back to the event loop
+  this->connect(&this->dataPtr->watchdogTimer, &QTimer::timeout, this,
+      []()
+      {
+        StallWatchdog::Beat();
+      });
+
+  // Lazy plugins are preloaded while there's nothing else to do
+  this->dataPtr->idleTimer.setInterval(0);
+  this->connect(&this->dataPtr->idleTimer, &QTimer::timeout, this,
+      [this]()
+      {
+        this->dataPtr->PreloadNext(this);
+      });
+
   // If it's a main window, initialize it
   if (_type == WindowType::kMainWindow)
   {
@@ -237,6 +724,9 @@ Application::Application(int &_argc, char **_argv, const WindowType _type,
   {
     gzerr << "Unknown WindowType [" << static_cast<int>(_type) << "]\n";
   }
+
+  this->dataPtr->trace.Record("Application::Application", "application",
+      constructionStart, StartupTrace::Clock::now());
 }
 
 /////////////////////////////////////////////////
@@ -244,18 +734,30 @@ Application::~Application()
 {
   gzdbg << "Terminating application." << std::endl;
 
-  if (this->dataPtr->mainWin && this->dataPtr->mainWin->QuickWindow())
+  if (this->dataPtr->watchdogTimer.isActive())
+    this->SetStallWatchdog(StallWatchdog::Options());
+
+  if (!this->dataPtr->tracePath.empty())
+    this->dataPtr->trace.Write(this->dataPtr->tracePath);
+
+  if (!this->dataPtr->latencyPath.empty())
+    this->dataPtr->latency.Write(this->dataPtr->latencyPath);
+
+  for (auto *window : this->dataPtr->mainWindows)
   {
+    if (nullptr == window->QuickWindow())
+      continue;
+
     // Detach object from main window and leave libraries for gz-common
-    auto plugins = this->dataPtr->mainWin->findChildren<Plugin *>();
+    auto plugins = window->findChildren<Plugin *>();
     for (auto plugin : plugins)
     {
       auto pluginName = plugin->CardItem()->objectName();
       this->RemovePlugin(pluginName.toStdString());
     }
-    if (this->dataPtr->mainWin->QuickWindow()->isVisible())
-      this->dataPtr->mainWin->QuickWindow()->close();
-    this->dataPtr->mainWin->deleteLater();
+    if (window->QuickWindow()->isVisible())
+      window->QuickWindow()->close();
+    window->deleteLater();
   }
 
   for (auto dialog : this->dataPtr->dialogs)
@@ -271,8 +773,28 @@ Application::~Application()
   std::queue<std::shared_ptr<Plugin>> empty;
   std::swap(this->dataPtr->pluginsToAdd, empty);
   this->dataPtr->pluginsAdded.clear();
+  this->dataPtr->pluginsByName.clear();
+  this->dataPtr->pluginsByFilename.clear();
+  this->dataPtr->filenames.clear();
   this->dataPtr->pluginPaths.clear();
   this->dataPtr->pluginPathEnv = "GZ_GUI_PLUGIN_PATH";
+
+  // Pending requests are cancelled before the threads their continuations
+  // may run on go away
+  std::unique_ptr<AsyncRequests> requests;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+    std::swap(requests, this->dataPtr->requests);
+  }
+  requests.reset();
+
+  // Running tasks are waited for, outside the lock in case they need it
+  std::unique_ptr<TaskPool> tasks;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+    std::swap(tasks, this->dataPtr->tasks);
+  }
+  tasks.reset();
 }
 
 /////////////////////////////////////////////////
@@ -302,8 +824,9 @@ bool Application::RemovePlugin(const std::string &_pluginName)
   cardItem->deleteLater();
 
   // Remove split on QML
-  auto bgItem = this->dataPtr->mainWin->QuickWindow()
-      ->findChild<QQuickItem *>("background");
+  auto *window = this->dataPtr->WindowOf(plugin.get());
+  auto bgItem = window ? window->QuickWindow()
+      ->findChild<QQuickItem *>("background") : nullptr;
   if (bgItem && cardItem->parentItem())
   {
     QMetaObject::invokeMethod(bgItem, "removeSplitItem",
@@ -345,6 +868,16 @@ bool Application::LoadConfig(const std::string &_config)
   }
 
   gzmsg << "Loading config [" << configFull << "]" << std::endl;
+  StartupTraceZone traceZone(&this->dataPtr->trace, "LoadConfig [" +
+      configFull + "]", "config");
+
+  // A config still being loaded progressively is replaced
+  if (this->dataPtr->progressiveTimer.isActive())
+  {
+    this->dataPtr->pendingPlugins.clear();
+    this->dataPtr->pendingSuccess = false;
+    this->dataPtr->LoadNextPlugin(this);
+  }
 
   // Clear all previous plugins
   auto plugins = this->dataPtr->mainWin->findChildren<Plugin *>();
@@ -353,39 +886,160 @@ bool Application::LoadConfig(const std::string &_config)
     auto pluginName = plugin->CardItem()->objectName();
     this->RemovePlugin(pluginName.toStdString());
   }
-  if (!this->dataPtr->pluginsAdded.empty())
+  if (this->dataPtr->PluginCount(this->dataPtr->mainWin) != 0)
   {
     gzerr << "The plugin list was not properly cleaned up." << std::endl;
   }
-  this->dataPtr->pluginsAdded.clear();
 
-  // Process each plugin
+  if (auto *profilerElem = doc.FirstChildElement("profiler"))
+  {
+    bool profiler{false};
+    if (profilerElem->QueryBoolText(&profiler) != tinyxml2::XML_SUCCESS)
+      gzerr << "Failed to parse <profiler>" << std::endl;
+    else
+      SetProfilerEnabled(profiler);
+  }
+
+  if (auto *threadsElem = doc.FirstChildElement("plugin_load_threads"))
+  {
+    unsigned int threads{1};
+    if (threadsElem->QueryUnsignedText(&threads) != tinyxml2::XML_SUCCESS)
+      gzerr << "Failed to parse <plugin_load_threads>" << std::endl;
+    else
+      this->SetPluginLoadThreads(threads);
+  }
+
+  if (auto *progressiveElem = doc.FirstChildElement("progressive_load"))
+  {
+    bool progressive{false};
+    if (progressiveElem->QueryBoolText(&progressive) != tinyxml2::XML_SUCCESS)
+      gzerr << "Failed to parse <progressive_load>" << std::endl;
+    else
+      this->SetProgressiveLoad(progressive);
+  }
+
+  if (auto *hiddenRateElem = doc.FirstChildElement("hidden_max_rate"))
+  {
+    double rate{0.0};
+    if (hiddenRateElem->QueryDoubleText(&rate) != tinyxml2::XML_SUCCESS)
+      gzerr << "Failed to parse <hidden_max_rate>" << std::endl;
+    else
+      this->SetHiddenMaxRate(rate);
+  }
+
+  if (auto *watchdogElem = doc.FirstChildElement("watchdog"))
+  {
+    StallWatchdog::Options options;
+    options.Load(watchdogElem);
+    this->SetStallWatchdog(options);
+  }
+
+  if (auto *threadsElem = doc.FirstChildElement("threads"))
+  {
+    if (auto *guiElem = threadsElem->FirstChildElement("gui"))
+    {
+      ThreadPolicy policy;
+      policy.Load(guiElem);
+      this->SetGuiThreadPolicy(policy);
+    }
+    if (auto *tasksElem = threadsElem->FirstChildElement("tasks"))
+    {
+      ThreadPolicy policy;
+      policy.Load(tasksElem);
+      this->SetTaskThreadPolicy(policy);
+    }
+  }
+
+  // Show the window with its config right away, and load the plugins from
+  // the event loop
+  if (this->dataPtr->progressiveLoad && this->dataPtr->mainWin)
+  {
+    if (auto *winElem = doc.FirstChildElement("window"))
+    {
+      this->LoadWindowConfig(*winElem);
+    }
+    this->ApplyConfig();
+
+    for (auto *pluginElem = doc.FirstChildElement("plugin");
+         pluginElem != nullptr;
+         pluginElem = pluginElem->NextSiblingElement("plugin"))
+    {
+      tinyxml2::XMLPrinter printer;
+      pluginElem->Accept(&printer);
+      this->dataPtr->pendingPlugins.emplace_back(printer.CStr());
+    }
+    this->dataPtr->pendingTotal =
+        static_cast<int>(this->dataPtr->pendingPlugins.size());
+    this->dataPtr->pendingSuccess = true;
+    this->dataPtr->pendingPreload = this->dataPtr->pluginLoadThreads > 1;
+    this->dataPtr->pendingWindow = this->dataPtr->mainWin;
+    this->dataPtr->mainWin->SetLoadProgress(0.0);
+    emit this->ConfigLoadProgress(0, this->dataPtr->pendingTotal);
+    this->dataPtr->progressiveTimer.start();
+    return true;
+  }
+
+  // Load the libraries ahead, concurrently
+  if (this->dataPtr->pluginLoadThreads > 1)
+  {
+    std::vector<std::string> filenames;
+    for (auto *pluginElem = doc.FirstChildElement("plugin");
+         pluginElem != nullptr;
+         pluginElem = pluginElem->NextSiblingElement("plugin"))
+    {
+      // Lazy plugins are only loaded once shown
+      bool preload{false};
+      if (this->dataPtr->mainWin && LazyConfig(pluginElem, preload))
+        continue;
+
+      const auto *filename = pluginElem->Attribute("filename");
+      if (filename)
+        filenames.push_back(filename);
+    }
+    this->dataPtr->Preload(filenames);
+  }
+
+  // Process each plugin, in order. They're only added to the window once
+  // they're all configured.
   bool successful = true;
+  this->dataPtr->deferAddToWindow = this->dataPtr->mainWin != nullptr;
   for (auto *pluginElem = doc.FirstChildElement("plugin");
        pluginElem != nullptr;
        pluginElem = pluginElem->NextSiblingElement("plugin"))
   {
     const auto *filename = pluginElem->Attribute("filename");
-    if (!this->LoadPlugin(filename, pluginElem))
+    if (!this->LoadPlugin(filename ? filename : "", pluginElem))
     {
       successful = false;
     }
   }
-
-  if (!successful)
-  {
-    return false;
-  }
+  this->dataPtr->deferAddToWindow = false;
+  this->dataPtr->preloaded.clear();
+  this->dataPtr->precompiled.clear();
+
+  // Add the cards and resize the window with the layout suspended, so the
+  // splits are laid out once instead of once per change
+  auto added = this->dataPtr->pluginsToAdd;
+  this->dataPtr->SetLayoutSuspended(true);
+  if (this->dataPtr->mainWin)
+    this->AddPluginsToWindow();
 
   // Process window properties
-  if (auto *winElem = doc.FirstChildElement("window"))
+  if (successful)
   {
-    this->LoadWindowConfig(*winElem);
+    if (auto *winElem = doc.FirstChildElement("window"))
+    {
+      this->LoadWindowConfig(*winElem);
+    }
+
+    this->ApplyConfig();
   }
+  this->dataPtr->SetLayoutSuspended(false);
 
-  this->ApplyConfig();
+  for (; !added.empty(); added.pop())
+    emit this->PluginAdded(added.front()->CardItem()->objectName());
 
-  return true;
+  return successful;
 }
 
 /////////////////////////////////////////////////
@@ -553,95 +1207,36 @@ bool Application::LoadPlugin(const std::string &_filename,
     return false;
   }
 
-  gzdbg << "Loading plugin [" << _filename << "]" << std::endl;
-
-  common::SystemPaths systemPaths;
-  systemPaths.SetPluginPathEnv(this->dataPtr->pluginPathEnv);
-
-  for (const auto &path : this->dataPtr->pluginPaths)
-    systemPaths.AddPluginPaths(path);
-
-  // Add default folder and install folder
-  std::string home;
-  common::env(GZ_HOMEDIR, home);
-  systemPaths.AddPluginPaths(home + "/.gz/gui/plugins");
-  systemPaths.AddPluginPaths(gz::gui::getPluginInstallDir());
-
-  auto pathToLib = systemPaths.FindSharedLibrary(_filename);
-  if (pathToLib.empty())
-  {
-    gzerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't find shared library." << std::endl;
-    return false;
-  }
-
-  // Load plugin
-  plugin::Loader pluginLoader;
-
-  auto pluginNames = pluginLoader.LoadLib(pathToLib, true);
-  if (pluginNames.empty())
-  {
-    gzerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't load library on path [" << pathToLib <<
-              "]." << std::endl;
-    return false;
-  }
-
-  // Go over all plugin names and get the first one that implements the
-  // gz::gui::Plugin interface
-  plugin::PluginPtr commonPlugin;
-  std::shared_ptr<gui::Plugin> plugin{nullptr};
-  for (const auto &pluginName : pluginNames)
-  {
-    commonPlugin = pluginLoader.Instantiate(pluginName);
-    if (!commonPlugin)
-      continue;
-
-    plugin = commonPlugin->QueryInterfaceSharedPtr<gz::gui::Plugin>();
-    if (plugin)
-      break;
-  }
-
-  if (!commonPlugin)
-  {
-    gzerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't instantiate plugin on path [" << pathToLib <<
-              "]. Tried plugin names: " << std::endl;
-
-    for (const auto &pluginName : pluginNames)
-    {
-      gzerr << " * " << pluginName << std::endl;
-    }
-    return false;
-  }
+  GZ_GUI_PROFILE("Application::LoadPlugin");
+  StartupTraceZone traceZone(&this->dataPtr->trace,
+      "LoadPlugin [" + _filename + "]", "plugin");
 
-  if (!plugin)
+  // Lazy plugins get a placeholder until they're shown. Dialogs are shown
+  // right away.
+  std::shared_ptr<Plugin> plugin;
+  bool preload{false};
+  if (this->dataPtr->mainWin && LazyConfig(_pluginElem, preload))
   {
-    gzerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't get [gz::gui::Plugin] interface."
-           << std::endl;
-    return false;
+    gzdbg << "Deferring plugin [" << _filename << "]" << std::endl;
+    plugin = this->dataPtr->Placeholder(this, _filename, _pluginElem,
+        preload);
   }
-
-  // Basic config in case there is none
-  if (!_pluginElem)
+  else
   {
-    std::string pluginStr = "<plugin filename=\"" + _filename + "\"></plugin>";
-
-    tinyxml2::XMLDocument pluginDoc;
-    pluginDoc.Parse(pluginStr.c_str());
-
-    plugin->Load(pluginDoc.FirstChildElement("plugin"));
+    gzdbg << "Loading plugin [" << _filename << "]" << std::endl;
+    plugin = this->dataPtr->Instantiate(_filename, _pluginElem);
   }
-  else
-    plugin->Load(_pluginElem);
 
-  if (nullptr == plugin->CardItem())
+  if (nullptr == plugin)
     return false;
 
   // Store plugin in queue to be added to the window
   this->dataPtr->pluginsToAdd.push(plugin);
 
+  // Added by LoadConfig with the rest of the config's plugins
+  if (this->dataPtr->deferAddToWindow)
+    return true;
+
   // Add to window or dialog
   if (this->dataPtr->mainWin)
     this->AddPluginsToWindow();
@@ -649,28 +1244,229 @@ bool Application::LoadPlugin(const std::string &_filename,
     this->InitializeDialogs();
 
   emit this->PluginAdded(plugin->CardItem()->objectName());
-  gzmsg << "Loaded plugin [" << _filename << "] from path [" << pathToLib
-         << "]" << std::endl;
 
   return true;
 }
 
 /////////////////////////////////////////////////
-std::shared_ptr<Plugin> Application::PluginByName(
-    const std::string &_pluginName) const
+void Application::SetProgressiveLoad(bool _progressive)
 {
-  for (auto &plugin : this->dataPtr->pluginsAdded)
-  {
-    auto *cardItem = plugin->CardItem();
-    if (!cardItem)
-      continue;
+  this->dataPtr->progressiveLoad = _progressive;
+}
 
-    if (cardItem->objectName().toStdString() != _pluginName)
-      continue;
+/////////////////////////////////////////////////
+bool Application::ProgressiveLoad() const
+{
+  return this->dataPtr->progressiveLoad;
+}
+
+/////////////////////////////////////////////////
+void Application::SetPluginLoadThreads(unsigned int _threads)
+{
+  this->dataPtr->pluginLoadThreads = std::max(1u, _threads);
+}
+
+/////////////////////////////////////////////////
+unsigned int Application::PluginLoadThreads() const
+{
+  return this->dataPtr->pluginLoadThreads;
+}
+
+/////////////////////////////////////////////////
+void Application::SetHiddenMaxRate(double _rate)
+{
+  this->dataPtr->hiddenMaxRate =
+      std::isfinite(_rate) ? std::max(0.0, _rate) : 0.0;
+  this->dataPtr->UpdateRateCap();
+}
+
+/////////////////////////////////////////////////
+double Application::HiddenMaxRate() const
+{
+  return this->dataPtr->hiddenMaxRate;
+}
+
+/////////////////////////////////////////////////
+bool Application::SetGuiThreadPolicy(const ThreadPolicy &_policy)
+{
+  if (QThread::currentThread() != this->thread())
+  {
+    gzerr << "The GUI thread policy must be set from the GUI thread"
+          << std::endl;
+    return false;
+  }
+  return _policy.ApplyToCurrentThread();
+}
 
-    return plugin;
+/////////////////////////////////////////////////
+bool Application::SetStallWatchdog(const StallWatchdog::Options &_options)
+{
+  if (QThread::currentThread() != this->thread())
+  {
+    gzerr << "The stall watchdog must be set from the GUI thread"
+          << std::endl;
+    return false;
   }
-  return nullptr;
+
+  auto &timer = this->dataPtr->watchdogTimer;
+  if (this->dataPtr->stallTopic)
+  {
+    this->Nodes()->Release(&timer);
+    this->dataPtr->stallTopic = false;
+  }
+
+  if (_options.threshold.count() <= 0)
+  {
+    StallWatchdog::Stop();
+    StallWatchdog::SetCallback(nullptr);
+    timer.stop();
+    StallWatchdog::Unwatch();
+    return true;
+  }
+
+  StallWatchdog::Callback callback;
+  if (!_options.topic.empty())
+  {
+    auto pub = this->Nodes()->Advertise<msgs::Param>(&timer,
+        _options.topic);
+    this->dataPtr->stallTopic = true;
+    callback = [pub](const StallWatchdog::Stall &_stall) mutable
+    {
+      msgs::Param msg;
+      auto setString = [&msg](const std::string &_key,
+          const std::string &_value)
+      {
+        auto &any = (*msg.mutable_params())[_key];
+        any.set_type(msgs::Any_ValueType_STRING);
+        any.set_string_value(_value);
+      };
+      setString("thread", _stall.thread);
+      setString("zones", common::join(_stall.zones, " > "));
+      setString("stack", common::join(_stall.stack, "\n"));
+
+      auto &duration = (*msg.mutable_params())["duration"];
+      duration.set_type(msgs::Any_ValueType_DOUBLE);
+      duration.set_double_value(
+          std::chrono::duration<double>(_stall.duration).count());
+      pub.Publish(msg);
+    };
+  }
+  StallWatchdog::SetCallback(std::move(callback));
+
+  if (!timer.isActive())
+  {
+    StallWatchdog::Watch("gui");
+    StallWatchdog::Beat();
+  }
+  timer.start(std::max<int>(1,
+      static_cast<int>(_options.threshold.count() / 4)));
+  StallWatchdog::Start(_options);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Application::SetTaskThreadPolicy(const ThreadPolicy &_policy)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+  this->dataPtr->taskThreadPolicy = _policy;
+  if (this->dataPtr->tasks)
+    this->dataPtr->tasks->SetThreadPolicy(_policy);
+}
+
+/////////////////////////////////////////////////
+TopicRegistry *Application::Topics() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+  if (!this->dataPtr->topics)
+    this->dataPtr->topics = std::make_unique<TopicRegistry>();
+  return this->dataPtr->topics.get();
+}
+
+/////////////////////////////////////////////////
+SubscriptionHub *Application::Subscriptions() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+  if (!this->dataPtr->subscriptions)
+  {
+    this->dataPtr->subscriptions = std::make_unique<SubscriptionHub>();
+    this->dataPtr->subscriptions->SetRateCap(this->dataPtr->rateCap);
+  }
+  return this->dataPtr->subscriptions.get();
+}
+
+/////////////////////////////////////////////////
+AsyncRequests *Application::Requests() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+  if (!this->dataPtr->requests)
+    this->dataPtr->requests = std::make_unique<AsyncRequests>();
+  return this->dataPtr->requests.get();
+}
+
+/////////////////////////////////////////////////
+NodePool *Application::Nodes() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+  if (!this->dataPtr->nodes)
+    this->dataPtr->nodes = std::make_unique<NodePool>();
+  return this->dataPtr->nodes.get();
+}
+
+/////////////////////////////////////////////////
+TaskPool *Application::Tasks() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicsMutex);
+  if (!this->dataPtr->tasks)
+  {
+    this->dataPtr->tasks = std::make_unique<TaskPool>();
+    if (!this->dataPtr->taskThreadPolicy.Empty())
+      this->dataPtr->tasks->SetThreadPolicy(this->dataPtr->taskThreadPolicy);
+  }
+  return this->dataPtr->tasks.get();
+}
+
+/////////////////////////////////////////////////
+StartupTrace *Application::Trace()
+{
+  return &this->dataPtr->trace;
+}
+
+/////////////////////////////////////////////////
+LatencyTrace *Application::Latency()
+{
+  return &this->dataPtr->latency;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<Plugin> Application::PluginByName(
+    const std::string &_pluginName) const
+{
+  auto it = this->dataPtr->pluginsByName.find(_pluginName);
+  if (it == this->dataPtr->pluginsByName.end())
+    return nullptr;
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> Application::LeakedPlugins() const
+{
+  std::vector<std::string> leaked;
+  for (const auto &removed : this->dataPtr->removedPlugins)
+  {
+    if (!removed.plugin.expired())
+      leaked.push_back(removed.description);
+  }
+  return leaked;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::shared_ptr<Plugin>> Application::PluginsByFilename(
+    const std::string &_filename) const
+{
+  auto it = this->dataPtr->pluginsByFilename.find(_filename);
+  if (it == this->dataPtr->pluginsByFilename.end())
+    return {};
+  return it->second;
 }
 
 /////////////////////////////////////////////////
@@ -679,14 +1475,122 @@ bool Application::CreateMainWindow()
   return this->InitializeMainWindow();
 }
 
+/////////////////////////////////////////////////
+MainWindow *Application::AddMainWindow()
+{
+  if (this->dataPtr->mainWindows.empty())
+    return this->InitializeMainWindow() ? this->dataPtr->mainWin : nullptr;
+
+  auto *first = this->dataPtr->mainWindows.front();
+  auto *previous = this->dataPtr->mainWin;
+  if (!this->InitializeMainWindow())
+  {
+    this->dataPtr->mainWin->deleteLater();
+    this->dataPtr->mainWin = previous;
+    return nullptr;
+  }
+
+  // Configs apply to the new window from the defaults
+  auto *window = this->dataPtr->mainWin;
+  this->dataPtr->windowConfig = WindowConfig();
+  window->setProperty("renderEngineBackendApiName",
+      first->property("renderEngineBackendApiName"));
+
+  // Only the last window closing quits, the others just go away once
+  // they're closed. Checked once the close event was handled, since the
+  // exit dialog may keep the window open.
+  this->connect(window->QuickWindow(), &QQuickWindow::closing, window,
+      [this, window]()
+      {
+        QTimer::singleShot(0, window, [this, window]()
+            {
+              if (this->dataPtr->mainWindows.size() > 1 &&
+                  !window->QuickWindow()->isVisible())
+              {
+                this->dataPtr->CloseWindow(this, window);
+              }
+            });
+      });
+
+  return window;
+}
+
+/////////////////////////////////////////////////
+std::vector<MainWindow *> Application::MainWindows() const
+{
+  return this->dataPtr->mainWindows;
+}
+
+/////////////////////////////////////////////////
+bool Application::LoadConfig(const std::string &_path, MainWindow *_window)
+{
+  if (std::find(this->dataPtr->mainWindows.begin(),
+      this->dataPtr->mainWindows.end(), _window) ==
+      this->dataPtr->mainWindows.end())
+  {
+    gzerr << "Can't load config [" << _path << "] into a window which "
+          << "isn't one of the application's main windows" << std::endl;
+    return false;
+  }
+
+  if (_window != this->dataPtr->mainWin)
+  {
+    this->dataPtr->mainWin = _window;
+    this->dataPtr->windowConfig = WindowConfig();
+  }
+  return this->LoadConfig(_path);
+}
+
 /////////////////////////////////////////////////
 bool Application::InitializeMainWindow()
 {
   gzdbg << "Create main window" << std::endl;
+  StartupTraceZone traceZone(&this->dataPtr->trace, "InitializeMainWindow",
+      "window");
 
   this->dataPtr->mainWin = new MainWindow();
   if (!this->dataPtr->mainWin->QuickWindow())
     return false;
+  this->dataPtr->mainWindows.push_back(this->dataPtr->mainWin);
+
+  // The first frame ends the startup. Marked from the render thread, when
+  // it's swapped.
+  if (this->dataPtr->trace.Enabled())
+  {
+    this->connect(this->dataPtr->mainWin->QuickWindow(),
+        &QQuickWindow::frameSwapped, this, [this]()
+        {
+          if (this->dataPtr->firstFrameTraced.exchange(true))
+            return;
+          this->dataPtr->trace.Mark("First frame", "window");
+          this->dataPtr->trace.Write(this->dataPtr->tracePath);
+        }, Qt::DirectConnection);
+  }
+
+  // Items drawn by QML, such as images, are in the frame once synchronized,
+  // and every frame is shown on the next swap. Both on the render thread.
+  if (this->dataPtr->latency.Enabled())
+  {
+    auto *quickWindow = this->dataPtr->mainWin->QuickWindow();
+    this->connect(quickWindow, &QQuickWindow::afterSynchronizing, this,
+        [this]()
+        {
+          this->dataPtr->latency.Rendered("window");
+          this->dataPtr->latency.Ready("window");
+        }, Qt::DirectConnection);
+    this->connect(quickWindow, &QQuickWindow::frameSwapped, this,
+        [this]()
+        {
+          this->dataPtr->latency.FrameSwapped();
+        }, Qt::DirectConnection);
+  }
+
+  // Slow down subscriptions while no window can be seen
+  this->connect(this->dataPtr->mainWin, &MainWindow::ExposedChanged, this,
+      [this]()
+      {
+        this->dataPtr->UpdateRateCap();
+      });
 
   this->dataPtr->mainWin->setParent(this);
 
@@ -710,6 +1614,9 @@ bool Application::AddPluginsToWindow()
   if (!this->dataPtr->mainWin || !this->dataPtr->mainWin->QuickWindow())
     return false;
 
+  StartupTraceZone traceZone(&this->dataPtr->trace, "AddPluginsToWindow",
+      "window");
+
   // Get main window background item
   auto *bgItem = this->dataPtr->mainWin->QuickWindow()
       ->findChild<QQuickItem *>("background");
@@ -725,6 +1632,7 @@ bool Application::AddPluginsToWindow()
     auto plugin = this->dataPtr->pluginsToAdd.front();
 
     this->dataPtr->pluginsAdded.push_back(plugin);
+    this->dataPtr->Index(plugin);
     this->dataPtr->pluginsToAdd.pop();
 
     if (plugin->DeleteLaterRequested())
@@ -767,7 +1675,8 @@ bool Application::AddPluginsToWindow()
         std::endl;
   }
 
-  this->dataPtr->mainWin->SetPluginCount(this->dataPtr->pluginsAdded.size());
+  this->dataPtr->mainWin->SetPluginCount(
+      this->dataPtr->PluginCount(this->dataPtr->mainWin));
 
   return true;
 }
@@ -810,6 +1719,7 @@ bool Application::InitializeDialogs()
         this, SLOT(OnPluginClose()));
 
     this->dataPtr->pluginsAdded.push_back(plugin);
+    this->dataPtr->Index(plugin);
 
     auto title = QString::fromStdString(plugin->Title());
     gzdbg << "Initialized dialog [" << title.toStdString() << "]" << std::endl;
@@ -822,12 +1732,14 @@ bool Application::InitializeDialogs()
 void Application::SetPluginPathEnv(const std::string &_env)
 {
   this->dataPtr->pluginPathEnv = _env;
+  emit this->PluginListChanged();
 }
 
 /////////////////////////////////////////////////
 void Application::AddPluginPath(const std::string &_path)
 {
   this->dataPtr->pluginPaths.push_back(_path);
+  emit this->PluginListChanged();
 }
 
 /////////////////////////////////////////////////
@@ -854,32 +1766,43 @@ std::vector<std::pair<std::string, std::vector<std::string>>>
 
   for (auto const &path : paths)
   {
-    std::vector<std::string> ps;
-
-    common::DirIter endIter;
-    for (common::DirIter dirIter(path);
-        dirIter != endIter; ++dirIter)
+    // Watched directories aren't even checked until they change
+    const auto dir = QString::fromStdString(path);
+    if (!this->dataPtr->pluginWatcher.directories().contains(dir) &&
+        !this->dataPtr->pluginWatcher.addPath(dir))
     {
-      auto plugin = common::basename(*dirIter);
-
-      // All we verify is that the file starts with shared library prefix and
-      // ends with shared library suffix, any further checks would require
-      // loading the plugin.
-
-      // TODO(anyone): Move this logic into gz-plugin to be reusable
+      this->dataPtr->pluginIndex.Invalidate(path);
+    }
 
-      // This computation could underflow the unsigned range, but that is okay
-      // as in such case we would check if the suffix is placed somewhere much
-      // further than allowed filename length.
-      const auto suffixPos = plugin.length() - strlen(SHARED_LIBRARY_SUFFIX);
+    plugins.emplace_back(path, this->dataPtr->pluginIndex.Plugins(path));
+  }
 
-      if (plugin.find(SHARED_LIBRARY_PREFIX) == 0 &&
-          plugin.rfind(SHARED_LIBRARY_SUFFIX) == suffixPos)
-        ps.push_back(plugin);
+#ifdef GZ_GUI_PLUGIN_BUNDLE
+  // The bundle is listed as the core plugins it contains
+  std::string pluginName;
+  this->dataPtr->Bundled(std::string(), pluginName);
+  std::vector<std::string> bundled;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->bundleMutex);
+    for (const auto &filename : this->dataPtr->bundled)
+    {
+      bundled.push_back(SHARED_LIBRARY_PREFIX + filename.first +
+          SHARED_LIBRARY_SUFFIX);
     }
+  }
+  std::sort(bundled.begin(), bundled.end());
 
-    plugins.emplace_back(path, ps);
+  const std::string bundleFile =
+      SHARED_LIBRARY_PREFIX GZ_GUI_PLUGIN_BUNDLE SHARED_LIBRARY_SUFFIX;
+  for (auto &dir : plugins)
+  {
+    auto bundle = std::find(dir.second.begin(), dir.second.end(), bundleFile);
+    if (bundle == dir.second.end())
+      continue;
+    dir.second.erase(bundle);
+    dir.second.insert(dir.second.end(), bundled.begin(), bundled.end());
   }
+#endif
 
   return plugins;
 }
@@ -894,29 +1817,661 @@ void Application::OnPluginClose()
 /////////////////////////////////////////////////
 void Application::RemovePlugin(std::shared_ptr<Plugin> _plugin)
 {
-  this->dataPtr->pluginsAdded.erase(std::remove(
-      this->dataPtr->pluginsAdded.begin(),
-      this->dataPtr->pluginsAdded.end(), _plugin),
-      this->dataPtr->pluginsAdded.end());
-
-  auto pluginCount = this->dataPtr->pluginsAdded.size();
+  auto *window = this->dataPtr->WindowOf(_plugin.get());
+  auto it = std::find(this->dataPtr->pluginsAdded.begin(),
+      this->dataPtr->pluginsAdded.end(), _plugin);
+  if (it != this->dataPtr->pluginsAdded.end())
+  {
+    const auto name = _plugin->CardItem()->objectName();
+    this->dataPtr->removedPlugins.push_back({"[" + name.toStdString() +
+        "] of [" + this->dataPtr->FilenameOf(_plugin.get()) + "]",
+        _plugin, false});
+
+    _plugin->Unload();
+    this->dataPtr->pluginsAdded.erase(it);
+    this->dataPtr->Unindex(_plugin);
+    this->dataPtr->filenames.erase(_plugin.get());
+    emit this->PluginRemoved(name);
+
+    QTimer::singleShot(kLeakCheckDelay, this, [this]()
+    {
+      this->dataPtr->CheckLeaks();
+    });
+  }
 
-  // Update main window count
-  if (this->dataPtr->mainWin)
+  // Update the plugin's window count
+  if (window)
   {
-    this->dataPtr->mainWin->SetPluginCount(pluginCount);
+    window->SetPluginCount(this->dataPtr->PluginCount(window));
   }
   // Or close app if it's the last dialog
-  else if (pluginCount == 0)
+  else if (this->dataPtr->pluginsAdded.empty())
   {
     this->exit();
   }
 }
 
+/////////////////////////////////////////////////
+std::shared_ptr<Plugin> Application::Implementation::Instantiate(
+    const std::string &_filename, const tinyxml2::XMLElement *_pluginElem)
+{
+  // Core plugins are instantiated from the bundle, if they're built into
+  // one, without looking for a library of their own
+  PreloadedLibrary library;
+  plugin::Loader *bundleLoader{nullptr};
+  std::string bundledName;
+  if (const auto *bundle = this->Bundled(_filename, bundledName))
+  {
+    library.path = bundle->path;
+    library.pluginNames = {bundledName};
+    bundleLoader = bundle->loader.get();
+  }
+  // Use the library loaded ahead, if any
+  else if (auto preloaded = this->preloaded.find(_filename);
+      preloaded != this->preloaded.end())
+  {
+    library = std::move(preloaded->second);
+    this->preloaded.erase(preloaded);
+  }
+  else
+  {
+    StartupTraceZone traceZone(&this->trace, "FindLibrary [" + _filename +
+        "]", "library");
+    library.path = this->FindLibrary(_filename);
+  }
+
+  const auto &pathToLib = library.path;
+  if (pathToLib.empty())
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't find shared library." << std::endl;
+    return nullptr;
+  }
+
+  // Load plugin
+  if (!library.loader && !bundleLoader)
+  {
+    StartupTraceZone traceZone(&this->trace, "LoadLib [" + _filename + "]",
+        "library");
+    library.loader = std::make_unique<plugin::Loader>();
+    library.pluginNames = library.loader->LoadLib(pathToLib, true);
+  }
+  auto &pluginLoader = bundleLoader ? *bundleLoader : *library.loader;
+
+  const auto &pluginNames = library.pluginNames;
+  if (pluginNames.empty())
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't load library on path [" << pathToLib <<
+              "]." << std::endl;
+    return nullptr;
+  }
+
+  // Go over all plugin names and get the first one that implements the
+  // gz::gui::Plugin interface
+  plugin::PluginPtr commonPlugin;
+  std::shared_ptr<gui::Plugin> plugin{nullptr};
+  {
+    StartupTraceZone traceZone(&this->trace, "Constructor [" + _filename +
+        "]", "plugin");
+    for (const auto &pluginName : pluginNames)
+    {
+      commonPlugin = pluginLoader.Instantiate(pluginName);
+      if (!commonPlugin)
+        continue;
+
+      plugin = commonPlugin->QueryInterfaceSharedPtr<gz::gui::Plugin>();
+      if (plugin)
+        break;
+    }
+  }
+
+  if (!commonPlugin)
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't instantiate plugin on path [" << pathToLib <<
+              "]. Tried plugin names: " << std::endl;
+
+    for (const auto &pluginName : pluginNames)
+    {
+      gzerr << " * " << pluginName << std::endl;
+    }
+    return nullptr;
+  }
+
+  if (!plugin)
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't get [gz::gui::Plugin] interface."
+           << std::endl;
+    return nullptr;
+  }
+
+  // Basic config in case there is none
+  if (!_pluginElem)
+  {
+    std::string pluginStr = "<plugin filename=\"" + _filename + "\"></plugin>";
+
+    tinyxml2::XMLDocument pluginDoc;
+    pluginDoc.Parse(pluginStr.c_str());
+
+    plugin->Load(pluginDoc.FirstChildElement("plugin"));
+  }
+  else
+    plugin->Load(_pluginElem);
+
+  if (nullptr == plugin->CardItem())
+    return nullptr;
+
+  gzmsg << "Loaded plugin [" << _filename << "] from path [" << pathToLib
+         << "]" << std::endl;
+
+  this->filenames[plugin.get()] = _filename;
+  return plugin;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<Plugin> Application::Implementation::Placeholder(
+    Application *_app, const std::string &_filename,
+    const tinyxml2::XMLElement *_pluginElem, bool _preload)
+{
+  tinyxml2::XMLPrinter printer;
+  if (!_pluginElem->Accept(&printer))
+  {
+    // LCOV_EXCL_START
+    gzerr << "Failed to print the config of plugin [" << _filename << "]"
+          << std::endl;
+    return nullptr;
+    // LCOV_EXCL_STOP
+  }
+  const std::string config(printer.CStr());
+
+  // The placeholder gets the plugin's card configuration
+  tinyxml2::XMLDocument doc;
+  doc.Parse(config.c_str());
+  auto *pluginElem = doc.FirstChildElement("plugin");
+  if (nullptr == pluginElem)
+    return nullptr;
+  pluginElem->SetAttribute("filename", kPlaceholderFilename);
+
+  auto placeholder = std::make_shared<LazyPlugin>();
+  placeholder->filename = _filename;
+  placeholder->preload = _preload;
+  placeholder->Load(pluginElem);
+  placeholder->SetConfig(config);
+
+  auto *cardItem = placeholder->CardItem();
+  if (nullptr == cardItem)
+    return nullptr;
+
+  // Load the plugin once the card is shown, from the event loop so the
+  // card isn't replaced from within its own signal
+  QPointer<Plugin> weakPlaceholder(placeholder.get());
+  auto onChange = [this, _app, weakPlaceholder]()
+  {
+    QTimer::singleShot(0, _app, [this, _app, weakPlaceholder]()
+    {
+      auto *lazy = static_cast<LazyPlugin *>(weakPlaceholder.data());
+      if (lazy && lazy->Shown())
+        this->Activate(_app, weakPlaceholder);
+    });
+  };
+  _app->connect(cardItem, &QQuickItem::visibleChanged, _app, onChange);
+  _app->connect(cardItem, &QQuickItem::stateChanged, _app, onChange);
+
+  // Covers cards which are shown as soon as they're added
+  onChange();
+
+  if (_preload)
+    this->idleTimer.start();
+
+  return placeholder;
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::Activate(Application *_app,
+    const QPointer<Plugin> &_placeholder)
+{
+  if (_placeholder.isNull())
+    return;
+
+  auto it = std::find_if(this->pluginsAdded.begin(), this->pluginsAdded.end(),
+      [&_placeholder](const std::shared_ptr<Plugin> &_plugin)
+      {
+        return _plugin.get() == _placeholder.data();
+      });
+  if (it == this->pluginsAdded.end())
+    return;
+
+  auto *lazy = dynamic_cast<LazyPlugin *>(it->get());
+  if (nullptr == lazy || lazy->failed)
+    return;
+
+  auto *placeholderCard = lazy->CardItem();
+  if (nullptr == placeholderCard || nullptr == placeholderCard->parentItem())
+    return;
+  auto *window = this->WindowOf(lazy);
+
+  // The saved config includes the current state of the card, such as
+  // whether it's collapsed
+  tinyxml2::XMLDocument doc;
+  doc.Parse(lazy->ConfigStr().c_str());
+
+  gzdbg << "Loading deferred plugin [" << lazy->filename << "]" << std::endl;
+  auto plugin = this->Instantiate(lazy->filename,
+      doc.FirstChildElement("plugin"));
+  if (nullptr == plugin)
+  {
+    lazy->failed = true;
+    return;
+  }
+
+  // Take the place of the placeholder
+  auto *cardItem = plugin->CardItem();
+  cardItem->setParentItem(placeholderCard->parentItem());
+  cardItem->setParent(this->engine);
+  plugin->setParent(window);
+  plugin->PostParentChanges();
+
+  window->connect(cardItem, SIGNAL(close()),
+      _app, SLOT(OnPluginClose()));
+
+  placeholderCard->deleteLater();
+  this->Unindex(*it);
+  *it = plugin;
+  this->Index(plugin);
+
+  emit _app->PluginRemoved(placeholderCard->objectName());
+  emit _app->PluginAdded(cardItem->objectName());
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::PreloadNext(Application *_app)
+{
+  for (const auto &plugin : this->pluginsAdded)
+  {
+    auto *lazy = dynamic_cast<LazyPlugin *>(plugin.get());
+    if (nullptr == lazy || !lazy->preload || lazy->failed)
+      continue;
+
+    // Activating replaces the placeholder in the list
+    lazy->preload = false;
+    this->Activate(_app, QPointer<Plugin>(lazy));
+    return;
+  }
+  this->idleTimer.stop();
+}
+
+/////////////////////////////////////////////////
+MainWindow *Application::Implementation::WindowOf(const Plugin *_plugin) const
+{
+  auto *window = qobject_cast<MainWindow *>(_plugin->parent());
+  return window ? window : this->mainWin;
+}
+
+/////////////////////////////////////////////////
+std::size_t Application::Implementation::PluginCount(
+    const MainWindow *_window) const
+{
+  return static_cast<std::size_t>(std::count_if(this->pluginsAdded.begin(),
+      this->pluginsAdded.end(),
+      [_window](const std::shared_ptr<Plugin> &_plugin)
+      {
+        return _plugin->parent() == _window;
+      }));
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::Index(
+    const std::shared_ptr<Plugin> &_plugin)
+{
+  // Cards are named once, when they're created
+  if (auto *cardItem = _plugin->CardItem())
+    this->pluginsByName[cardItem->objectName().toStdString()] = _plugin;
+
+  this->pluginsByFilename[this->FilenameOf(_plugin.get())].push_back(
+      _plugin);
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::Unindex(
+    const std::shared_ptr<Plugin> &_plugin)
+{
+  if (auto *cardItem = _plugin->CardItem())
+  {
+    auto it = this->pluginsByName.find(cardItem->objectName().toStdString());
+    if (it != this->pluginsByName.end() && it->second == _plugin)
+      this->pluginsByName.erase(it);
+  }
+
+  auto instances = this->pluginsByFilename.find(
+      this->FilenameOf(_plugin.get()));
+  if (instances == this->pluginsByFilename.end())
+    return;
+  auto &list = instances->second;
+  list.erase(std::remove(list.begin(), list.end(), _plugin), list.end());
+  if (list.empty())
+    this->pluginsByFilename.erase(instances);
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::LoadNextPlugin(Application *_app)
+{
+  // Configs and plugins loaded meanwhile go to the current window
+  if (!this->pendingPlugins.empty() &&
+      (this->pendingWindow.isNull() || this->pendingWindow != this->mainWin))
+  {
+    gzwarn << "Stopped loading a config, its window was replaced"
+           << std::endl;
+    this->pendingPlugins.clear();
+    this->pendingSuccess = false;
+  }
+
+  if (!this->pendingPlugins.empty())
+  {
+    // Libraries are loaded together, once the window is shown
+    if (this->pendingPreload)
+    {
+      this->pendingPreload = false;
+      std::vector<std::string> filenames;
+      for (const auto &config : this->pendingPlugins)
+      {
+        tinyxml2::XMLDocument doc;
+        doc.Parse(config.c_str());
+        auto *pluginElem = doc.FirstChildElement("plugin");
+        bool preload{false};
+        if (nullptr == pluginElem || LazyConfig(pluginElem, preload))
+          continue;
+        if (const auto *filename = pluginElem->Attribute("filename"))
+          filenames.push_back(filename);
+      }
+      this->Preload(filenames);
+      return;
+    }
+
+    tinyxml2::XMLDocument doc;
+    doc.Parse(this->pendingPlugins.front().c_str());
+    this->pendingPlugins.pop_front();
+    const auto *pluginElem = doc.FirstChildElement("plugin");
+    const auto *filename = pluginElem ? pluginElem->Attribute("filename") :
+        nullptr;
+    if (!_app->LoadPlugin(filename ? filename : "", pluginElem))
+      this->pendingSuccess = false;
+
+    const int loaded = this->pendingTotal -
+        static_cast<int>(this->pendingPlugins.size());
+    if (!this->pendingWindow.isNull())
+    {
+      this->pendingWindow->SetLoadProgress(
+          static_cast<double>(loaded) / this->pendingTotal);
+    }
+    emit _app->ConfigLoadProgress(loaded, this->pendingTotal);
+    if (!this->pendingPlugins.empty())
+      return;
+  }
+
+  // Done, the window config is applied again now that the plugins are in
+  this->progressiveTimer.stop();
+  this->preloaded.clear();
+  this->precompiled.clear();
+  if (!this->pendingWindow.isNull())
+  {
+    if (this->pendingWindow == this->mainWin)
+      _app->ApplyConfig();
+    this->pendingWindow->SetLoadProgress(1.0);
+  }
+  this->pendingWindow.clear();
+  emit _app->ConfigLoaded(this->pendingSuccess);
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::CheckLeaks()
+{
+  this->removedPlugins.erase(std::remove_if(this->removedPlugins.begin(),
+      this->removedPlugins.end(), [](const RemovedPlugin &_removed)
+      {
+        return _removed.plugin.expired();
+      }), this->removedPlugins.end());
+
+  for (auto &removed : this->removedPlugins)
+  {
+    if (removed.reported)
+      continue;
+    removed.reported = true;
+    gzwarn << "Plugin " << removed.description << " was removed but is "
+           << "still held in " << removed.plugin.use_count() << " places, "
+           << "so its resources aren't freed. It should release them in "
+           << "OnUnload." << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+std::string Application::Implementation::FilenameOf(
+    const Plugin *_plugin) const
+{
+  // Placeholders are listed under the plugin they stand in for
+  if (auto *lazy = dynamic_cast<const LazyPlugin *>(_plugin))
+    return lazy->filename;
+
+  auto it = this->filenames.find(_plugin);
+  return it == this->filenames.end() ? std::string() : it->second;
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::CloseWindow(Application *_app,
+    MainWindow *_window)
+{
+  auto it = std::find(this->mainWindows.begin(), this->mainWindows.end(),
+      _window);
+  if (it == this->mainWindows.end())
+    return;
+  this->mainWindows.erase(it);
+
+  for (auto *plugin : _window->findChildren<Plugin *>())
+    _app->RemovePlugin(plugin->CardItem()->objectName().toStdString());
+
+  if (this->mainWin == _window)
+  {
+    this->mainWin = this->mainWindows.back();
+    this->windowConfig = WindowConfig();
+  }
+
+  _window->QuickWindow()->deleteLater();
+  _window->deleteLater();
+
+  this->UpdateRateCap();
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::SetLayoutSuspended(bool _suspended)
+{
+  if (!this->mainWin || !this->mainWin->QuickWindow())
+    return;
+
+  auto *bgItem = this->mainWin->QuickWindow()->findChild<QQuickItem *>(
+      "background");
+  if (bgItem)
+    bgItem->setProperty("layoutSuspended", _suspended);
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::UpdateRateCap()
+{
+  const bool hidden = !this->mainWindows.empty() &&
+      std::none_of(this->mainWindows.begin(), this->mainWindows.end(),
+      [](const MainWindow *_window)
+      {
+        return _window->Exposed();
+      });
+  const double cap = hidden ? this->hiddenMaxRate : 0.0;
+
+  // The hub may be created from any thread, but isn't called with the
+  // lock held
+  SubscriptionHub *hub{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(this->topicsMutex);
+    if (cap == this->rateCap)
+      return;
+    this->rateCap = cap;
+    hub = this->subscriptions.get();
+  }
+  if (nullptr != hub)
+    hub->SetRateCap(cap);
+}
+
+//////////////////////////////////////////////////
+std::string Application::Implementation::FindLibrary(
+    const std::string &_filename) const
+{
+  common::SystemPaths systemPaths;
+  systemPaths.SetPluginPathEnv(this->pluginPathEnv);
+
+  for (const auto &path : this->pluginPaths)
+    systemPaths.AddPluginPaths(path);
+
+  // Add default folder and install folder
+  std::string home;
+  common::env(GZ_HOMEDIR, home);
+  systemPaths.AddPluginPaths(home + "/.gz/gui/plugins");
+  systemPaths.AddPluginPaths(gz::gui::getPluginInstallDir());
+
+  return systemPaths.FindSharedLibrary(_filename);
+}
+
 //////////////////////////////////////////////////
+const PreloadedLibrary *Application::Implementation::Bundled(
+    const std::string &_filename, std::string &_pluginName)
+{
+#ifdef GZ_GUI_PLUGIN_BUNDLE
+  std::lock_guard<std::mutex> lock(this->bundleMutex);
+
+  // Looked for again until found, as plugin paths may be added later
+  if (!this->bundle.loader)
+  {
+    StartupTraceZone traceZone(&this->trace,
+        "LoadLib [" GZ_GUI_PLUGIN_BUNDLE "]", "library");
+    this->bundle.path = this->FindLibrary(GZ_GUI_PLUGIN_BUNDLE);
+    if (this->bundle.path.empty())
+      return nullptr;
+
+    this->bundle.loader = std::make_unique<plugin::Loader>();
+    this->bundle.pluginNames =
+        this->bundle.loader->LoadLib(this->bundle.path, true);
+    if (this->bundle.pluginNames.empty())
+    {
+      gzerr << "Failed to load the core plugins from [" << this->bundle.path
+            << "]" << std::endl;
+    }
+
+    // Plugins are named after their class, such as
+    // "gz::gui::plugins::Publisher", and their filename is the class name
+    for (const auto &name : this->bundle.pluginNames)
+    {
+      const auto pos = name.rfind("::");
+      this->bundled[pos == std::string::npos ? name : name.substr(pos + 2)] =
+          name;
+    }
+  }
+
+  auto bundled = this->bundled.find(_filename);
+  if (bundled == this->bundled.end())
+    return nullptr;
+  _pluginName = bundled->second;
+  return &this->bundle;
+#else
+  (void) _filename;
+  (void) _pluginName;
+  return nullptr;
+#endif
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::Precompile(const std::string &_filename)
+{
+  // The engine keeps the compiled QML, so Plugin::Load finds it ready
+  const auto qmlFile = QString::fromStdString(
+      ":/" + _filename + "/" + _filename + ".qml");
+  if (QFile(qmlFile).exists())
+  {
+    this->precompiled.push_back(std::make_unique<QQmlComponent>(
+        this->engine, qmlFile, QQmlComponent::Asynchronous));
+  }
+}
+
+/////////////////////////////////////////////////
+void Application::Implementation::Preload(
+    const std::vector<std::string> &_filenames)
+{
+  // Each library once, plugins can be listed several times
+  std::vector<std::string> filenames;
+  std::set<std::string> unique;
+  for (const auto &filename : _filenames)
+  {
+    if (filename.empty() || this->preloaded.count(filename) != 0 ||
+        !unique.insert(filename).second)
+    {
+      continue;
+    }
+
+    // Bundled plugins are loaded already
+    std::string bundledName;
+    if (this->Bundled(filename, bundledName))
+      this->Precompile(filename);
+    else
+      filenames.push_back(filename);
+  }
+  if (filenames.empty())
+    return;
+
+  // Finding and opening libraries, including their static initialization,
+  // doesn't touch the GUI, so each thread takes the next library
+  std::vector<PreloadedLibrary> libraries(filenames.size());
+  std::atomic<std::size_t> next{0};
+  auto work = [&]()
+  {
+    for (auto i = next++; i < filenames.size(); i = next++)
+    {
+      auto &library = libraries[i];
+      StartupTraceZone traceZone(&this->trace, "Preload [" + filenames[i] +
+          "]", "library");
+      library.path = this->FindLibrary(filenames[i]);
+      if (library.path.empty())
+        continue;
+
+      library.loader = std::make_unique<plugin::Loader>();
+      library.pluginNames = library.loader->LoadLib(library.path, true);
+    }
+  };
+
+  const auto threadCount = std::min<std::size_t>(this->pluginLoadThreads,
+      filenames.size());
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < threadCount; ++i)
+    threads.emplace_back(work);
+  work();
+  for (auto &thread : threads)
+    thread.join();
+
+  for (std::size_t i = 0; i < filenames.size(); ++i)
+  {
+    // Errors are reported when the plugin is loaded
+    auto &library = libraries[i];
+    if (library.pluginNames.empty())
+      continue;
+
+    this->Precompile(filenames[i]);
+    this->preloaded[filenames[i]] = std::move(library);
+  }
+}
+
+/////////////////////////////////////////////////
 void Application::Implementation::MessageHandler(QtMsgType _type,
     const QMessageLogContext &_context, const QString &_msg)
 {
+  // Written on a thread of its own, with repeats suppressed, so noisy QML
+  // warnings such as binding loops don't stall the GUI thread
+  static AsyncLog log;
+
   std::string msg = "[QT] " + _msg.toStdString();
   if (_context.function)
     msg += std::string("(") + _context.function + ")";
@@ -924,21 +2479,25 @@ void Application::Implementation::MessageHandler(QtMsgType _type,
   switch (_type)
   {
     case QtDebugMsg:
-      gzdbg << msg << std::endl;
+      log.Write(AsyncLog::Level::DEBUG, std::move(msg));
       break;
     case QtInfoMsg:
-      gzmsg << msg << std::endl;
+      log.Write(AsyncLog::Level::INFO, std::move(msg));
       break;
     case QtWarningMsg:
-      gzwarn << msg << std::endl;
+      log.Write(AsyncLog::Level::WARNING, std::move(msg));
       break;
-    case QtFatalMsg:
     case QtCriticalMsg:
-      gzerr << msg << std::endl;
+      log.Write(AsyncLog::Level::ERROR, std::move(msg));
+      break;
+    case QtFatalMsg:
+      // Qt aborts right after
+      log.Write(AsyncLog::Level::ERROR, std::move(msg));
+      log.Flush();
       break;
     default:
-      gzwarn << "Unknown QT Message type[" << _type << "]: "
-        << msg << std::endl;
+      log.Write(AsyncLog::Level::WARNING, "Unknown QT Message type[" +
+          std::to_string(_type) + "]: " + msg);
       break;
   }
 }
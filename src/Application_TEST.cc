@@ -17,6 +17,12 @@
 
 #include <stdlib.h>
 #include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -116,6 +122,93 @@ TEST(ApplicationTest,
   EXPECT_TRUE(app.RemovePlugin(pluginName));
 }
 
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(PluginIndex))
+{
+  gz::common::Console::SetVerbosity(4);
+  // No Qt app
+  ASSERT_EQ(nullptr, qGuiApp);
+  Application app(g_argc, g_argv);
+
+  std::vector<std::string> added;
+  app.connect(&app, &Application::PluginAdded, [&added](
+      const QString &_pluginName)
+  {
+    added.push_back(_pluginName.toStdString());
+  });
+  std::vector<std::string> removed;
+  app.connect(&app, &Application::PluginRemoved, [&removed](
+      const QString &_pluginName)
+  {
+    removed.push_back(_pluginName.toStdString());
+  });
+  int listChanges{0};
+  app.connect(&app, &Application::PluginListChanged, [&listChanges]()
+  {
+    ++listChanges;
+  });
+
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+  EXPECT_EQ(1, listChanges);
+
+  EXPECT_TRUE(app.PluginsByFilename("TestPlugin").empty());
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+  ASSERT_EQ(2u, added.size());
+
+  // Instances are listed in the order they were added
+  auto instances = app.PluginsByFilename("TestPlugin");
+  ASSERT_EQ(2u, instances.size());
+  EXPECT_EQ(app.PluginByName(added[0]), instances[0]);
+  EXPECT_EQ(app.PluginByName(added[1]), instances[1]);
+
+  EXPECT_TRUE(app.RemovePlugin(added[0]));
+  EXPECT_EQ(std::vector<std::string>({added[0]}), removed);
+  EXPECT_EQ(nullptr, app.PluginByName(added[0]));
+  instances = app.PluginsByFilename("TestPlugin");
+  ASSERT_EQ(1u, instances.size());
+  EXPECT_EQ(app.PluginByName(added[1]), instances[0]);
+
+  EXPECT_FALSE(app.RemovePlugin(added[0]));
+  EXPECT_EQ(1u, removed.size());
+}
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(UnloadPlugin))
+{
+  gz::common::Console::SetVerbosity(4);
+  // No Qt app
+  ASSERT_EQ(nullptr, qGuiApp);
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  std::string pluginName;
+  app.connect(&app, &Application::PluginAdded, [&pluginName](
+      const QString &_pluginName)
+  {
+    pluginName = _pluginName.toStdString();
+  });
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+
+  // Something still holds the plugin once it's removed
+  auto plugin = app.PluginByName(pluginName);
+  ASSERT_NE(nullptr, plugin);
+  EXPECT_FALSE(plugin->Unloaded());
+  EXPECT_TRUE(app.LeakedPlugins().empty());
+
+  EXPECT_TRUE(app.RemovePlugin(pluginName));
+  EXPECT_TRUE(plugin->Unloaded());
+  auto leaked = app.LeakedPlugins();
+  ASSERT_EQ(1u, leaked.size());
+  EXPECT_NE(std::string::npos, leaked[0].find(pluginName));
+  EXPECT_NE(std::string::npos, leaked[0].find("TestPlugin"));
+
+  // Released
+  plugin.reset();
+  EXPECT_TRUE(app.LeakedPlugins().empty());
+}
+
 //////////////////////////////////////////////////
 TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadEnvPlugin))
 {
@@ -219,6 +312,210 @@ TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadConfig))
   }
 }
 
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(MultipleWindows))
+{
+  common::Console::SetVerbosity(4);
+
+  ASSERT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+  auto testConfig = std::string(PROJECT_SOURCE_PATH) +
+      "/test/config/test.config";
+
+  auto windows = app.MainWindows();
+  ASSERT_EQ(1u, windows.size());
+  auto *first = windows[0];
+  EXPECT_EQ(first, app.findChild<MainWindow *>());
+  EXPECT_TRUE(app.LoadConfig(testConfig));
+  const auto firstPlugins = first->findChildren<Plugin *>().size();
+  EXPECT_GT(firstPlugins, 0u);
+
+  // The new window gets its own window and plugins
+  auto *second = app.AddMainWindow();
+  ASSERT_NE(nullptr, second);
+  ASSERT_NE(nullptr, second->QuickWindow());
+  EXPECT_NE(first->QuickWindow(), second->QuickWindow());
+  EXPECT_EQ(2u, app.MainWindows().size());
+  EXPECT_TRUE(app.LoadConfig(testConfig, second));
+  EXPECT_EQ(firstPlugins, second->findChildren<Plugin *>().size());
+
+  // Loading into one window leaves the other's plugins
+  EXPECT_TRUE(app.LoadConfig(testConfig, first));
+  EXPECT_EQ(firstPlugins, first->findChildren<Plugin *>().size());
+  EXPECT_EQ(firstPlugins, second->findChildren<Plugin *>().size());
+
+  // The first window stays the one events go through
+  EXPECT_EQ(first, app.findChild<MainWindow *>());
+
+  // Closing the additional window removes it and its plugins
+  second->QuickWindow()->show();
+  second->QuickWindow()->close();
+  for (int i = 0; i < 10 && app.MainWindows().size() > 1; ++i)
+    QCoreApplication::processEvents();
+  ASSERT_EQ(1u, app.MainWindows().size());
+  EXPECT_EQ(first, app.MainWindows()[0]);
+  EXPECT_EQ(firstPlugins, first->findChildren<Plugin *>().size());
+
+  // Unknown windows are rejected
+  EXPECT_FALSE(app.LoadConfig(testConfig, nullptr));
+}
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ParallelLoad))
+{
+  common::Console::SetVerbosity(4);
+
+  ASSERT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv);
+  EXPECT_EQ(1u, app.PluginLoadThreads());
+  app.SetPluginLoadThreads(0);
+  EXPECT_EQ(1u, app.PluginLoadThreads());
+
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib/");
+
+  int added{0};
+  app.connect(&app, &Application::PluginAdded, [&](const QString &)
+  {
+    ++added;
+  });
+
+  // The config sets the number of threads
+  auto testSourcePath = std::string(PROJECT_SOURCE_PATH) + "/test/";
+  EXPECT_TRUE(app.LoadConfig(testSourcePath + "config/parallel.config"));
+  EXPECT_EQ(4u, app.PluginLoadThreads());
+
+  // All plugins were added, including repeated ones
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<Plugin *>();
+  EXPECT_EQ(4, plugins.size());
+  EXPECT_EQ(4, added);
+
+  // They were added with the layout suspended, and it was resumed
+  auto *bgItem = win->QuickWindow()->findChild<QQuickItem *>("background");
+  ASSERT_NE(nullptr, bgItem);
+  EXPECT_FALSE(bgItem->property("layoutSuspended").toBool());
+}
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ProgressiveLoad))
+{
+  common::Console::SetVerbosity(4);
+
+  ASSERT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv);
+  EXPECT_FALSE(app.ProgressiveLoad());
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib/");
+
+  std::vector<int> progress;
+  app.connect(&app, &Application::ConfigLoadProgress,
+      [&](int _loaded, int _total)
+  {
+    EXPECT_EQ(3, _total);
+    progress.push_back(_loaded);
+  });
+  int loaded{0};
+  app.connect(&app, &Application::ConfigLoaded, [&](bool _success)
+  {
+    EXPECT_TRUE(_success);
+    ++loaded;
+  });
+
+  // The window is ready before any plugin is loaded
+  auto testSourcePath = std::string(PROJECT_SOURCE_PATH) + "/test/";
+  EXPECT_TRUE(app.LoadConfig(testSourcePath + "config/progressive.config"));
+  EXPECT_TRUE(app.ProgressiveLoad());
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  EXPECT_TRUE(win->findChildren<Plugin *>().empty());
+  EXPECT_DOUBLE_EQ(0.0, win->LoadProgress());
+
+  // Plugins are loaded one per event loop iteration
+  int sleep{0};
+  while (loaded == 0 && sleep++ < 100)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(1, loaded);
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), progress);
+  EXPECT_EQ(3, win->findChildren<Plugin *>().size());
+  EXPECT_DOUBLE_EQ(1.0, win->LoadProgress());
+}
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LazyLoad))
+{
+  common::Console::SetVerbosity(4);
+
+  ASSERT_EQ(nullptr, qGuiApp);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib/");
+
+  auto testSourcePath = std::string(PROJECT_SOURCE_PATH) + "/test/";
+  EXPECT_TRUE(app.LoadConfig(testSourcePath + "config/lazy.config"));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Placeholders don't have a plugin class of their own
+  auto placeholders = [&win]()
+  {
+    std::vector<Plugin *> result;
+    for (auto *plugin : win->findChildren<Plugin *>())
+    {
+      if (std::string(plugin->metaObject()->className()) == "gz::gui::Plugin")
+        result.push_back(plugin);
+    }
+    return result;
+  };
+
+  // Collapsed lazy plugins aren't loaded yet
+  EXPECT_EQ(3, win->findChildren<Plugin *>().size());
+  EXPECT_EQ(2u, placeholders().size());
+
+  // The one which opted in is loaded while idle
+  for (int i = 0; i < 50 && placeholders().size() != 1u; ++i)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  auto remaining = placeholders();
+  ASSERT_EQ(1u, remaining.size());
+  EXPECT_EQ("Publisher", remaining[0]->Title());
+  EXPECT_NE(std::string::npos,
+      remaining[0]->ConfigStr().find("filename=\"Publisher\""));
+
+  // It keeps its collapsed state
+  int collapsed{0};
+  for (auto *plugin : win->findChildren<Plugin *>())
+  {
+    if (std::string(plugin->metaObject()->className()) ==
+        "gz::gui::TestPlugin" &&
+        plugin->CardItem()->state() == "docked_collapsed")
+    {
+      ++collapsed;
+    }
+  }
+  EXPECT_EQ(1, collapsed);
+
+  // The other one is loaded once expanded
+  remaining[0]->CardItem()->setProperty("state", "docked");
+  for (int i = 0; i < 50 && !placeholders().empty(); ++i)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(placeholders().empty());
+  EXPECT_EQ(3, win->findChildren<Plugin *>().size());
+}
+
 //////////////////////////////////////////////////
 TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadDefaultConfig))
 {
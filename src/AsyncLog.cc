@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/AsyncLog.hh"
+
+namespace gz::gui
+{
+/// \brief Private data for AsyncLog
+class AsyncLog::Implementation
+{
+  /// \brief Queued message
+  public: struct Message
+  {
+    /// \brief Severity
+    Level level;
+
+    /// \brief Text
+    std::string text;
+
+    /// \brief When it was logged
+    std::chrono::steady_clock::time_point time;
+  };
+
+  /// \brief Repeats of one message within the current period
+  public: struct Repeat
+  {
+    /// \brief Severity of the first repeat
+    Level level;
+
+    /// \brief Start of the period
+    std::chrono::steady_clock::time_point start;
+
+    /// \brief Times logged within the period
+    std::size_t count{0};
+
+    /// \brief Times suppressed within the period and not summarized yet
+    std::size_t suppressed{0};
+  };
+
+  /// \brief Log thread loop
+  public: void Run();
+
+  /// \brief Write a message, unless it's repeated too often. Only called
+  /// on the log thread.
+  /// \param[in] _msg Message
+  public: void Process(const Message &_msg);
+
+  /// \brief Write the summaries of suppressed messages whose period ended,
+  /// and forget those messages. Only called on the log thread.
+  /// \param[in] _now Current time
+  /// \param[in] _all True to also summarize the periods still going on
+  public: void Summarize(std::chrono::steady_clock::time_point _now,
+      bool _all);
+
+  /// \brief Write a summary line
+  /// \param[in] _text Suppressed message
+  /// \param[in] _repeat Its repeats
+  public: void WriteSummary(const std::string &_text, const Repeat &_repeat);
+
+  /// \brief Times the same message is written within a period
+  public: std::size_t maxRepeats;
+
+  /// \brief Length of the periods
+  public: std::chrono::steady_clock::duration period;
+
+  /// \brief Writes the lines
+  public: Writer writer;
+
+  /// \brief Most messages waiting to be written
+  public: std::size_t maxQueued;
+
+  /// \brief Protects `pending`, `dropped`, the flush counters and
+  /// `stopping`
+  public: std::mutex mutex;
+
+  /// \brief Wakes the log thread
+  public: std::condition_variable wakeCv;
+
+  /// \brief Notified each time the log thread is done with a batch
+  public: std::condition_variable flushedCv;
+
+  /// \brief Messages waiting to be written
+  public: std::vector<Message> pending;
+
+  /// \brief Messages dropped because the queue was full
+  public: std::size_t dropped{0};
+
+  /// \brief Number of flushes requested
+  public: uint64_t flushRequested{0};
+
+  /// \brief Number of flushes done
+  public: uint64_t flushDone{0};
+
+  /// \brief True once the log is being destroyed
+  public: bool stopping{false};
+
+  /// \brief Repeats of recent messages by text. Only accessed from the log
+  /// thread.
+  public: std::unordered_map<std::string, Repeat> repeats;
+
+  /// \brief Log thread, last so it starts once everything else is set up
+  public: std::thread thread;
+};
+
+/////////////////////////////////////////////////
+AsyncLog::AsyncLog(std::size_t _maxRepeats,
+    std::chrono::steady_clock::duration _period, Writer _writer,
+    std::size_t _maxQueued)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->maxRepeats = _maxRepeats;
+  this->dataPtr->period = _period;
+  this->dataPtr->maxQueued = _maxQueued;
+  this->dataPtr->writer = std::move(_writer);
+  if (!this->dataPtr->writer)
+  {
+    this->dataPtr->writer = [](Level _level, const std::string &_msg)
+    {
+      switch (_level)
+      {
+        case Level::DEBUG:
+          gzdbg << _msg << std::endl;
+          break;
+        case Level::INFO:
+          gzmsg << _msg << std::endl;
+          break;
+        case Level::WARNING:
+          gzwarn << _msg << std::endl;
+          break;
+        case Level::ERROR:
+          gzerr << _msg << std::endl;
+          break;
+      }
+    };
+  }
+  this->dataPtr->thread = std::thread(&Implementation::Run,
+      this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+AsyncLog::~AsyncLog()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stopping = true;
+  }
+  this->dataPtr->wakeCv.notify_one();
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+}
+
+/////////////////////////////////////////////////
+void AsyncLog::Write(Level _level, std::string _msg)
+{
+  const auto now = std::chrono::steady_clock::now();
+  bool wake;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->pending.size() >= this->dataPtr->maxQueued)
+    {
+      ++this->dataPtr->dropped;
+      return;
+    }
+    this->dataPtr->pending.push_back({_level, std::move(_msg), now});
+    wake = this->dataPtr->pending.size() == 1u;
+  }
+  if (wake)
+    this->dataPtr->wakeCv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void AsyncLog::Flush()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  const auto id = ++this->dataPtr->flushRequested;
+  this->dataPtr->wakeCv.notify_one();
+  this->dataPtr->flushedCv.wait(lock, [this, id]()
+      {
+        return this->dataPtr->flushDone >= id;
+      });
+}
+
+/////////////////////////////////////////////////
+void AsyncLog::Implementation::Run()
+{
+  std::vector<Message> batch;
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    // Wake up at least once a period to summarize ended periods
+    this->wakeCv.wait_for(lock, this->period, [this]()
+        {
+          return !this->pending.empty() || this->stopping ||
+              this->flushRequested != this->flushDone;
+        });
+
+    batch.swap(this->pending);
+    const auto dropped = std::exchange(this->dropped, 0u);
+    const auto flush = this->flushRequested;
+    const bool stop = this->stopping;
+    lock.unlock();
+
+    for (const auto &msg : batch)
+      this->Process(msg);
+    batch.clear();
+
+    if (dropped > 0)
+    {
+      this->writer(Level::WARNING, "Dropped " + std::to_string(dropped) +
+          " log messages, the log couldn't keep up");
+    }
+
+    this->Summarize(std::chrono::steady_clock::now(),
+        stop || flush != this->flushDone);
+
+    lock.lock();
+    this->flushDone = flush;
+    this->flushedCv.notify_all();
+    if (stop && this->pending.empty())
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+void AsyncLog::Implementation::Process(const Message &_msg)
+{
+  auto [it, inserted] = this->repeats.try_emplace(_msg.text);
+  auto &repeat = it->second;
+  if (inserted || _msg.time - repeat.start >= this->period)
+  {
+    if (repeat.suppressed > 0)
+      this->WriteSummary(_msg.text, repeat);
+    repeat.level = _msg.level;
+    repeat.start = _msg.time;
+    repeat.count = 0;
+    repeat.suppressed = 0;
+  }
+
+  if (++repeat.count <= this->maxRepeats)
+    this->writer(_msg.level, _msg.text);
+  else
+    ++repeat.suppressed;
+}
+
+/////////////////////////////////////////////////
+void AsyncLog::Implementation::Summarize(
+    std::chrono::steady_clock::time_point _now, bool _all)
+{
+  for (auto it = this->repeats.begin(); it != this->repeats.end();)
+  {
+    const bool ended = _now - it->second.start >= this->period;
+    if ((ended || _all) && it->second.suppressed > 0)
+    {
+      this->WriteSummary(it->first, it->second);
+      it->second.suppressed = 0;
+    }
+
+    // Messages which stopped repeating are forgotten
+    if (ended)
+      it = this->repeats.erase(it);
+    else
+      ++it;
+  }
+}
+
+/////////////////////////////////////////////////
+void AsyncLog::Implementation::WriteSummary(const std::string &_text,
+    const Repeat &_repeat)
+{
+  this->writer(_repeat.level, _text + " (suppressed " +
+      std::to_string(_repeat.suppressed) + " times)");
+}
+}  // namespace gz::gui
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/AsyncLog.hh"
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Lines written by a log
+struct Lines
+{
+  /// \brief Writer to give the log
+  AsyncLog::Writer Writer()
+  {
+    return [this](AsyncLog::Level _level, const std::string &_msg)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->lines.emplace_back(_level, _msg);
+    };
+  }
+
+  /// \brief Protects `lines`
+  std::mutex mutex;
+
+  /// \brief Lines in the order written
+  std::vector<std::pair<AsyncLog::Level, std::string>> lines;
+};
+
+/////////////////////////////////////////////////
+TEST(AsyncLogTest, Write)
+{
+  Lines lines;
+  {
+    AsyncLog log(5, std::chrono::seconds(10), lines.Writer());
+    log.Write(AsyncLog::Level::WARNING, "a");
+    log.Write(AsyncLog::Level::ERROR, "b");
+    log.Flush();
+    ASSERT_EQ(2u, lines.lines.size());
+    EXPECT_EQ(AsyncLog::Level::WARNING, lines.lines[0].first);
+    EXPECT_EQ("a", lines.lines[0].second);
+    EXPECT_EQ(AsyncLog::Level::ERROR, lines.lines[1].first);
+    EXPECT_EQ("b", lines.lines[1].second);
+
+    // Written when destroyed
+    log.Write(AsyncLog::Level::INFO, "c");
+  }
+  ASSERT_EQ(3u, lines.lines.size());
+  EXPECT_EQ("c", lines.lines[2].second);
+}
+
+/////////////////////////////////////////////////
+TEST(AsyncLogTest, Repeats)
+{
+  Lines lines;
+  AsyncLog log(3, std::chrono::seconds(10), lines.Writer());
+  for (int i = 0; i < 20; ++i)
+  {
+    log.Write(AsyncLog::Level::WARNING, "loop");
+    if (i == 10)
+      log.Write(AsyncLog::Level::WARNING, "other");
+  }
+  log.Flush();
+
+  std::vector<std::string> expected{"loop", "loop", "loop", "other",
+      "loop (suppressed 17 times)"};
+  ASSERT_EQ(expected.size(), lines.lines.size());
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(expected[i], lines.lines[i].second) << i;
+
+  // Still suppressed within the period, summarized again on flush
+  log.Write(AsyncLog::Level::WARNING, "loop");
+  log.Write(AsyncLog::Level::WARNING, "loop");
+  log.Flush();
+  ASSERT_EQ(6u, lines.lines.size());
+  EXPECT_EQ("loop (suppressed 2 times)", lines.lines.back().second);
+}
+
+/////////////////////////////////////////////////
+TEST(AsyncLogTest, Period)
+{
+  Lines lines;
+  AsyncLog log(1, std::chrono::milliseconds(50), lines.Writer());
+  log.Write(AsyncLog::Level::INFO, "tick");
+  log.Write(AsyncLog::Level::INFO, "tick");
+
+  // The summary is written once the period ends, without a flush
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(lines.mutex);
+      if (lines.lines.size() >= 2u)
+        break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  log.Flush();
+  ASSERT_EQ(2u, lines.lines.size());
+  EXPECT_EQ("tick (suppressed 1 times)", lines.lines[1].second);
+
+  // Written again in a new period
+  log.Write(AsyncLog::Level::INFO, "tick");
+  log.Flush();
+  ASSERT_EQ(3u, lines.lines.size());
+  EXPECT_EQ("tick", lines.lines[2].second);
+}
+
+/////////////////////////////////////////////////
+TEST(AsyncLogTest, Dropped)
+{
+  Lines lines;
+  AsyncLog log(100, std::chrono::seconds(10),
+      [&lines](AsyncLog::Level _level, const std::string &_msg)
+      {
+        // Slow writer, so the queue fills up
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(lines.mutex);
+        lines.lines.emplace_back(_level, _msg);
+      }, 4);
+  for (int i = 0; i < 50; ++i)
+    log.Write(AsyncLog::Level::INFO, std::to_string(i));
+  log.Flush();
+
+  ASSERT_LT(lines.lines.size(), 50u);
+  bool reported{false};
+  for (const auto &line : lines.lines)
+  {
+    if (line.second.find("Dropped") == 0u)
+      reported = true;
+  }
+  EXPECT_TRUE(reported);
+}
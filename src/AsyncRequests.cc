@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/AsyncRequests.hh"
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/TaskPool.hh"
+
+namespace gz::gui
+{
+/// \brief Request waiting for its outcome
+struct PendingRequest
+{
+  /// \brief Service name
+  std::string service;
+
+  /// \brief When it was made
+  std::chrono::steady_clock::time_point start;
+
+  /// \brief When it times out, if it does
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+
+  /// \brief Options
+  RequestOptions options;
+
+  /// \brief Sets the result
+  std::function<void(RequestStatus, std::chrono::steady_clock::duration)>
+      complete;
+
+  /// \brief Continuation
+  std::function<void()> then;
+
+  /// \brief True once something is completing it
+  bool claimed{false};
+};
+
+/// \brief State shared with the cancellers of the requests, which may
+/// outlive AsyncRequests
+class RequestsState
+{
+  /// \brief Cancel a request
+  /// \param[in] _id Request id
+  /// \return True if it was pending
+  public: bool Cancel(std::uint64_t _id)
+  {
+    PendingRequest request;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->dispatched.erase(_id);
+      auto it = this->pending.find(_id);
+      if (it == this->pending.end() || it->second.claimed)
+        return false;
+      request = std::move(it->second);
+      this->pending.erase(it);
+      this->pendingCounter.SetQueueDepth(this->pending.size());
+    }
+    request.complete(RequestStatus::CANCELLED,
+        std::chrono::steady_clock::now() - request.start);
+    return true;
+  }
+
+  /// \brief Protects everything below
+  public: std::mutex mutex;
+
+  /// \brief Wakes the timeout thread
+  public: std::condition_variable wake;
+
+  /// \brief True when the timeout thread must stop
+  public: bool stopping{false};
+
+  /// \brief Id of the next request
+  public: std::uint64_t nextId{1};
+
+  /// \brief Requests waiting for their outcome, by id
+  public: std::unordered_map<std::uint64_t, PendingRequest> pending;
+
+  /// \brief Owners of the requests whose continuation was dispatched to
+  /// another thread and hasn't run yet, by id
+  public: std::unordered_map<std::uint64_t, const void *> dispatched;
+
+  /// \brief Continuations waiting for the render thread
+  public: std::vector<std::function<void()>> renderQueue;
+
+  /// \brief Latency of the requests of each service
+  public: std::map<std::string, std::unique_ptr<PerformanceCounter>>
+      counters;
+
+  /// \brief Number of requests pending
+  public: PerformanceCounter pendingCounter{"AsyncRequests", "pending"};
+};
+
+/// \brief Private data
+class AsyncRequests::Implementation
+{
+  /// \brief Time requests out until stopped
+  public: void RunTimeouts();
+
+  /// \brief Object this is the data of, to finish requests which time out
+  public: AsyncRequests *owner{nullptr};
+
+  /// \brief State
+  public: std::shared_ptr<RequestsState> state{
+      std::make_shared<RequestsState>()};
+
+  /// \brief Runs the continuations for the render thread
+  public: RenderHookConnectionPtr renderHook;
+
+  /// \brief Times requests out
+  public: std::thread timeoutThread;
+
+  /// \brief Makes the requests, destroyed first so no reply arrives while
+  /// the rest is destroyed
+  public: transport::Node node;
+};
+
+/////////////////////////////////////////////////
+void AsyncRequests::Implementation::RunTimeouts()
+{
+  auto &st = *this->state;
+  std::unique_lock<std::mutex> lock(st.mutex);
+  while (!st.stopping)
+  {
+    std::optional<std::chrono::steady_clock::time_point> next;
+    for (const auto &[id, request] : st.pending)
+    {
+      if (!request.claimed && request.deadline &&
+          (!next || *request.deadline < *next))
+      {
+        next = request.deadline;
+      }
+    }
+    if (!next)
+    {
+      st.wake.wait(lock);
+      continue;
+    }
+    if (st.wake.wait_until(lock, *next) != std::cv_status::timeout)
+      continue;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::uint64_t> expired;
+    for (auto &[id, request] : st.pending)
+    {
+      if (!request.claimed && request.deadline && *request.deadline <= now)
+      {
+        request.claimed = true;
+        expired.push_back(id);
+      }
+    }
+    lock.unlock();
+    for (const auto id : expired)
+      this->owner->Finish(id, RequestStatus::TIMED_OUT);
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+AsyncRequests::AsyncRequests()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->owner = this;
+
+  std::weak_ptr<RequestsState> weak = this->dataPtr->state;
+  this->dataPtr->renderHook = RenderHooks::OnPreRender([weak]()
+  {
+    auto state = weak.lock();
+    if (nullptr == state)
+      return;
+    std::vector<std::function<void()>> queue;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      queue.swap(state->renderQueue);
+    }
+    for (const auto &task : queue)
+      task();
+  }, 0, "AsyncRequests");
+
+  this->dataPtr->timeoutThread = std::thread(
+      &Implementation::RunTimeouts, this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+AsyncRequests::~AsyncRequests()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+    this->dataPtr->state->stopping = true;
+  }
+  this->dataPtr->state->wake.notify_all();
+  this->dataPtr->timeoutThread.join();
+  this->dataPtr->renderHook.reset();
+
+  // Replies arriving meanwhile find their request gone
+  std::vector<std::uint64_t> ids;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+    for (const auto &[id, request] : this->dataPtr->state->pending)
+      ids.push_back(id);
+    this->dataPtr->state->dispatched.clear();
+    this->dataPtr->state->renderQueue.clear();
+  }
+  for (const auto id : ids)
+    this->dataPtr->state->Cancel(id);
+}
+
+/////////////////////////////////////////////////
+std::size_t AsyncRequests::CancelOwner(const void *_owner)
+{
+  if (nullptr == _owner)
+    return 0;
+
+  std::vector<std::uint64_t> ids;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+    for (const auto &[id, request] : this->dataPtr->state->pending)
+    {
+      if (request.options.owner == _owner)
+        ids.push_back(id);
+    }
+    auto &dispatched = this->dataPtr->state->dispatched;
+    for (auto it = dispatched.begin(); it != dispatched.end();)
+    {
+      if (it->second == _owner)
+        it = dispatched.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  std::size_t cancelled{0};
+  for (const auto id : ids)
+  {
+    if (this->dataPtr->state->Cancel(id))
+      ++cancelled;
+  }
+  return cancelled;
+}
+
+/////////////////////////////////////////////////
+std::size_t AsyncRequests::Pending() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+  return this->dataPtr->state->pending.size();
+}
+
+/////////////////////////////////////////////////
+transport::Node &AsyncRequests::Node()
+{
+  return this->dataPtr->node;
+}
+
+/////////////////////////////////////////////////
+std::uint64_t AsyncRequests::Begin(const std::string &_service,
+    const RequestOptions &_options,
+    std::function<void(RequestStatus,
+        std::chrono::steady_clock::duration)> _complete,
+    std::function<void()> _then)
+{
+  PendingRequest request;
+  request.service = _service;
+  request.start = std::chrono::steady_clock::now();
+  if (_options.timeout > std::chrono::steady_clock::duration::zero())
+    request.deadline = request.start + _options.timeout;
+  request.options = _options;
+  request.complete = std::move(_complete);
+  request.then = std::move(_then);
+
+  std::uint64_t id;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+    id = this->dataPtr->state->nextId++;
+    this->dataPtr->state->pending.emplace(id, std::move(request));
+    this->dataPtr->state->pendingCounter.SetQueueDepth(
+        this->dataPtr->state->pending.size());
+  }
+  if (_options.timeout > std::chrono::steady_clock::duration::zero())
+    this->dataPtr->state->wake.notify_all();
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool AsyncRequests::Claim(std::uint64_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+  auto it = this->dataPtr->state->pending.find(_id);
+  if (it == this->dataPtr->state->pending.end() || it->second.claimed)
+    return false;
+  it->second.claimed = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void AsyncRequests::Finish(std::uint64_t _id, RequestStatus _status)
+{
+  auto &state = *this->dataPtr->state;
+  PendingRequest request;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.pending.find(_id);
+    if (it == state.pending.end())
+      return;
+    request = std::move(it->second);
+    state.pending.erase(it);
+    state.pendingCounter.SetQueueDepth(state.pending.size());
+    if (request.then && request.options.thread != RequestThread::TRANSPORT)
+      state.dispatched.emplace(_id, request.options.owner);
+  }
+
+  const auto latency = std::chrono::steady_clock::now() - request.start;
+  if (PerformanceCounters::Enabled())
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto &counter = state.counters[request.service];
+    if (nullptr == counter)
+    {
+      counter = std::make_unique<PerformanceCounter>("AsyncRequests",
+          request.service);
+    }
+    counter->AddTime(latency);
+  }
+
+  // The result is set before the continuation may wait on it
+  request.complete(_status, latency);
+  if (!request.then)
+    return;
+
+  if (request.options.thread == RequestThread::TRANSPORT)
+  {
+    request.then();
+    return;
+  }
+
+  // Dropped if cancelled before it runs
+  std::weak_ptr<RequestsState> weak = this->dataPtr->state;
+  auto task = [weak, _id, then = std::move(request.then)]()
+  {
+    auto st = weak.lock();
+    if (nullptr == st)
+      return;
+    {
+      std::lock_guard<std::mutex> lock(st->mutex);
+      if (st->dispatched.erase(_id) == 0)
+        return;
+    }
+    then();
+  };
+
+  auto *app = App();
+  switch (request.options.thread)
+  {
+    case RequestThread::GUI:
+      if (nullptr != app)
+        QMetaObject::invokeMethod(app, task, Qt::QueuedConnection);
+      else
+        task();
+      break;
+    case RequestThread::RENDER:
+      {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.renderQueue.push_back(std::move(task));
+      }
+      RenderHooks::RequestRender();
+      break;
+    case RequestThread::POOL:
+      if (nullptr != app)
+        app->Tasks()->Submit(task, TaskPool::Priority::NORMAL);
+      else
+        task();
+      break;
+    default:
+      task();
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+std::function<bool()> AsyncRequests::Canceller(std::uint64_t _id)
+{
+  std::weak_ptr<RequestsState> weak = this->dataPtr->state;
+  return [weak, _id]()
+  {
+    auto state = weak.lock();
+    return nullptr != state && state->Cancel(_id);
+  };
+}
+}  // namespace gz::gui
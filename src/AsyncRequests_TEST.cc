@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include <gz/msgs/int32.pb.h>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/AsyncRequests.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Options for continuations on the transport threads
+/// \param[in] _timeout Timeout
+/// \return Options
+RequestOptions transportOptions(std::chrono::steady_clock::duration _timeout)
+{
+  RequestOptions options;
+  options.timeout = _timeout;
+  options.thread = RequestThread::TRANSPORT;
+  return options;
+}
+
+/////////////////////////////////////////////////
+TEST(AsyncRequestsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Reply))
+{
+  transport::Node server;
+  std::function<bool(const msgs::Int32 &, msgs::Int32 &)> doubler =
+      [](const msgs::Int32 &_req, msgs::Int32 &_rep)
+      {
+        _rep.set_data(_req.data() * 2);
+        return _req.data() >= 0;
+      };
+  ASSERT_TRUE(server.Advertise("/async_double", doubler));
+
+  AsyncRequests requests;
+  msgs::Int32 req;
+  req.set_data(21);
+  std::atomic<int> replied{0};
+  auto future = requests.Request<msgs::Int32, msgs::Int32>("/async_double",
+      req, [&](const RequestResult<msgs::Int32> &_result)
+      {
+        EXPECT_EQ(RequestStatus::OK, _result.status);
+        replied = _result.reply.data();
+      }, transportOptions(std::chrono::seconds(5)));
+  ASSERT_TRUE(future.Valid());
+
+  ASSERT_EQ(std::future_status::ready,
+      future.Future().wait_for(std::chrono::seconds(5)));
+  EXPECT_EQ(RequestStatus::OK, future.Status());
+  EXPECT_EQ(42, future.Future().get().reply.data());
+  EXPECT_GT(future.Future().get().latency.count(), 0);
+  EXPECT_EQ(42, replied);
+  EXPECT_EQ(0u, requests.Pending());
+
+  // The service replies that it failed
+  req.set_data(-1);
+  future = requests.Request<msgs::Int32, msgs::Int32>("/async_double", req,
+      {}, transportOptions(std::chrono::seconds(5)));
+  ASSERT_EQ(std::future_status::ready,
+      future.Future().wait_for(std::chrono::seconds(5)));
+  EXPECT_EQ(RequestStatus::FAILED, future.Status());
+
+  // Completed requests can't be cancelled
+  EXPECT_FALSE(future.Cancel());
+}
+
+/////////////////////////////////////////////////
+TEST(AsyncRequestsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Timeout))
+{
+  AsyncRequests requests;
+  std::atomic<bool> timedOut{false};
+  auto future = requests.Request<msgs::Int32, msgs::Int32>(
+      "/async_missing", msgs::Int32(),
+      [&](const RequestResult<msgs::Int32> &_result)
+      {
+        timedOut = _result.status == RequestStatus::TIMED_OUT;
+      }, transportOptions(std::chrono::milliseconds(200)));
+  EXPECT_EQ(RequestStatus::PENDING, future.Status());
+  EXPECT_EQ(1u, requests.Pending());
+
+  ASSERT_EQ(std::future_status::ready,
+      future.Future().wait_for(std::chrono::seconds(5)));
+  EXPECT_EQ(RequestStatus::TIMED_OUT, future.Status());
+  EXPECT_GE(future.Future().get().latency, std::chrono::milliseconds(200));
+  EXPECT_TRUE(timedOut);
+  EXPECT_EQ(0u, requests.Pending());
+}
+
+/////////////////////////////////////////////////
+TEST(AsyncRequestsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Cancel))
+{
+  AsyncRequests requests;
+  std::atomic<int> calls{0};
+  auto count = [&](const RequestResult<msgs::Int32> &)
+  {
+    ++calls;
+  };
+
+  // Without a timeout, only cancelling completes it
+  auto future = requests.Request<msgs::Int32, msgs::Int32>(
+      "/async_missing", msgs::Int32(), count,
+      transportOptions(std::chrono::seconds(0)));
+  EXPECT_TRUE(future.Cancel());
+  EXPECT_FALSE(future.Cancel());
+  EXPECT_EQ(RequestStatus::CANCELLED, future.Status());
+
+  // All the requests of an owner
+  int owner;
+  auto options = transportOptions(std::chrono::seconds(0));
+  options.owner = &owner;
+  auto first = requests.Request<msgs::Int32, msgs::Int32>(
+      "/async_missing", msgs::Int32(), count, options);
+  auto second = requests.Request<msgs::Int32, msgs::Int32>(
+      "/async_missing", msgs::Int32(), count, options);
+  auto other = requests.Request<msgs::Int32, msgs::Int32>(
+      "/async_missing", msgs::Int32(), count,
+      transportOptions(std::chrono::seconds(0)));
+  EXPECT_EQ(3u, requests.Pending());
+  EXPECT_EQ(2u, requests.CancelOwner(&owner));
+  EXPECT_EQ(RequestStatus::CANCELLED, first.Status());
+  EXPECT_EQ(RequestStatus::CANCELLED, second.Status());
+  EXPECT_EQ(RequestStatus::PENDING, other.Status());
+  EXPECT_EQ(0, calls);
+
+  // Handles outlive the requests, which cancel what's left
+  {
+    AsyncRequests scoped;
+    future = scoped.Request<msgs::Int32, msgs::Int32>("/async_missing",
+        msgs::Int32(), count, transportOptions(std::chrono::seconds(0)));
+  }
+  EXPECT_EQ(RequestStatus::CANCELLED, future.Status());
+  EXPECT_FALSE(future.Cancel());
+  EXPECT_EQ(0, calls);
+}
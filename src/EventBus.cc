@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/EventBus.hh"
+
+namespace
+{
+/// \brief A subscribed callback
+class Subscriber
+{
+  /// \brief The callback
+  public: std::function<void(const QEvent &)> callback;
+
+  /// \brief False once the connection has been destroyed
+  public: bool connected{true};
+};
+
+/////////////////////////////////////////////////
+/// \brief Protects the channels map
+/// \return Mutex
+std::mutex &channelsMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+}  // namespace
+
+namespace gz::gui
+{
+class EventBus::Channel
+{
+  /// \brief Add a subscriber
+  /// \param[in] _cb Callback
+  /// \return New subscriber, to be kept by a connection
+  public: std::shared_ptr<Subscriber> Connect(
+      std::function<void(const QEvent &)> _cb);
+
+  /// \brief Call all connected subscribers
+  /// \param[in] _event Event
+  public: void Run(const QEvent &_event);
+
+  /// \brief Remove disconnected subscribers and merge newly connected ones.
+  /// Must be called with the mutex locked, and not while iterating.
+  private: void Compact();
+
+  /// \brief Protects all members except `count`. Recursive so that
+  /// callbacks can subscribe and unsubscribe.
+  public: std::recursive_mutex mutex;
+
+  /// \brief Subscribers in the order they're called
+  private: std::vector<std::shared_ptr<Subscriber>> subscribers;
+
+  /// \brief Subscribers connected since the last event
+  private: std::vector<std::shared_ptr<Subscriber>> pending;
+
+  /// \brief True if subscribers have been disconnected since the last event
+  public: bool dirty{false};
+
+  /// \brief Number of connected subscribers, read without locking so events
+  /// nobody listens to are dropped right away
+  public: std::atomic<std::size_t> count{0};
+};
+
+/// \brief Private data for EventBusConnection
+class EventBusConnection::Implementation
+{
+  /// \brief Channel the subscriber belongs to
+  public: EventBus::Channel *channel{nullptr};
+
+  /// \brief The subscriber kept connected
+  public: std::shared_ptr<Subscriber> subscriber;
+};
+
+/////////////////////////////////////////////////
+EventBusConnection::EventBusConnection()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+EventBusConnection::~EventBusConnection()
+{
+  auto *channel = this->dataPtr->channel;
+  if (nullptr == channel || nullptr == this->dataPtr->subscriber)
+    return;
+
+  // Blocks while the channel's callbacks are running, so once this returns
+  // the callback is guaranteed not to be called anymore
+  std::lock_guard<std::recursive_mutex> lock(channel->mutex);
+  this->dataPtr->subscriber->connected = false;
+  channel->dirty = true;
+  --channel->count;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<Subscriber> EventBus::Channel::Connect(
+    std::function<void(const QEvent &)> _cb)
+{
+  auto subscriber = std::make_shared<Subscriber>();
+  subscriber->callback = std::move(_cb);
+
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  this->pending.push_back(subscriber);
+  ++this->count;
+  return subscriber;
+}
+
+/////////////////////////////////////////////////
+void EventBus::Channel::Compact()
+{
+  this->subscribers.erase(std::remove_if(this->subscribers.begin(),
+      this->subscribers.end(),
+      [](const std::shared_ptr<Subscriber> &_subscriber)
+      {
+        return !_subscriber->connected;
+      }), this->subscribers.end());
+
+  for (auto &subscriber : this->pending)
+  {
+    if (subscriber->connected)
+      this->subscribers.push_back(std::move(subscriber));
+  }
+  this->pending.clear();
+  this->dirty = false;
+}
+
+/////////////////////////////////////////////////
+void EventBus::Channel::Run(const QEvent &_event)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+
+  if (this->dirty || !this->pending.empty())
+    this->Compact();
+
+  // The vector isn't modified while iterating: callbacks which subscribe or
+  // unsubscribe only touch `pending` and `connected`.
+  for (const auto &subscriber : this->subscribers)
+  {
+    if (subscriber->connected && subscriber->callback)
+      subscriber->callback(_event);
+  }
+}
+
+/////////////////////////////////////////////////
+EventBus::Channel *EventBus::ChannelOf(QEvent::Type _type)
+{
+  // Channels are never destroyed, so connections and the channels cached by
+  // each library stay valid during static destruction
+  static auto *channels = new std::map<int, Channel *>();
+
+  std::lock_guard<std::mutex> lock(channelsMutex());
+  auto &channel = (*channels)[_type];
+  if (nullptr == channel)
+    channel = new Channel();
+  return channel;
+}
+
+/////////////////////////////////////////////////
+EventBusConnectionPtr EventBus::Subscribe(Channel *_channel,
+    std::function<void(const QEvent &)> _cb)
+{
+  auto connection = std::make_shared<EventBusConnection>();
+  connection->dataPtr->channel = _channel;
+  connection->dataPtr->subscriber = _channel->Connect(std::move(_cb));
+  return connection;
+}
+
+/////////////////////////////////////////////////
+void EventBus::Publish(Channel *_channel, const QEvent &_event)
+{
+  if (0u == _channel->count)
+    return;
+
+  _channel->Run(_event);
+}
+
+/////////////////////////////////////////////////
+void EventBus::Publish(const QEvent &_event)
+{
+  Publish(ChannelOf(_event.type()), _event);
+}
+
+/////////////////////////////////////////////////
+std::size_t EventBus::SubscriberCount(Channel *_channel)
+{
+  return _channel->count;
+}
+}  // namespace gz::gui
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/EventBus.hh"
+#include "gz/gui/GuiEvents.hh"
+#include "gz/gui/MainWindow.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./EventBus_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Event only used by this test
+class CountEvent : public QEvent
+{
+  /// \brief Constructor
+  /// \param[in] _count Count carried by the event
+  public: explicit CountEvent(int _count)
+      : QEvent(kType), count(_count)
+  {
+  }
+
+  /// \brief Unique type for this event.
+  public: static const QEvent::Type kType = QEvent::Type(QEvent::User + 1);
+
+  /// \brief Count carried by the event
+  public: int count{0};
+};
+
+/// \brief Another event only used by this test
+class OtherEvent : public QEvent
+{
+  /// \brief Constructor
+  public: OtherEvent()
+      : QEvent(kType)
+  {
+  }
+
+  /// \brief Unique type for this event.
+  public: static const QEvent::Type kType = QEvent::Type(QEvent::User + 2);
+};
+
+/////////////////////////////////////////////////
+TEST(EventBusTest, Subscribe)
+{
+  EXPECT_EQ(0u, EventBus::SubscriberCount<CountEvent>());
+
+  // Nobody listening
+  EventBus::Publish(CountEvent(1));
+
+  std::vector<int> order;
+  auto first = EventBus::Subscribe<CountEvent>(
+      [&](const CountEvent &_event)
+      {
+        order.push_back(_event.count);
+      });
+  auto second = EventBus::Subscribe<CountEvent>(
+      [&](const CountEvent &_event)
+      {
+        order.push_back(-_event.count);
+      });
+  int others{0};
+  auto other = EventBus::Subscribe<OtherEvent>(
+      [&](const OtherEvent &)
+      {
+        ++others;
+      });
+  EXPECT_EQ(2u, EventBus::SubscriberCount<CountEvent>());
+  EXPECT_EQ(1u, EventBus::SubscriberCount<OtherEvent>());
+
+  // Subscribers are called in order, and only for their type
+  EventBus::Publish(CountEvent(2));
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ(2, order[0]);
+  EXPECT_EQ(-2, order[1]);
+  EXPECT_EQ(0, others);
+
+  // Publishing as a QEvent finds the same subscribers
+  const CountEvent event(3);
+  EventBus::Publish(static_cast<const QEvent &>(event));
+  ASSERT_EQ(4u, order.size());
+  EXPECT_EQ(3, order[2]);
+
+  // Destroying the connection unsubscribes
+  second.reset();
+  EXPECT_EQ(1u, EventBus::SubscriberCount<CountEvent>());
+  EventBus::Publish(CountEvent(4));
+  ASSERT_EQ(5u, order.size());
+  EXPECT_EQ(4, order[4]);
+
+  EventBus::Publish(OtherEvent());
+  EXPECT_EQ(1, others);
+
+  first.reset();
+  other.reset();
+  EXPECT_EQ(0u, EventBus::SubscriberCount<CountEvent>());
+  EXPECT_EQ(0u, EventBus::SubscriberCount<OtherEvent>());
+}
+
+/////////////////////////////////////////////////
+TEST(EventBusTest, SubscribeFromCallback)
+{
+  int inner{0};
+  EventBusConnectionPtr innerConnection;
+  auto outer = EventBus::Subscribe<CountEvent>(
+      [&](const CountEvent &)
+      {
+        // Takes effect on the next event
+        if (!innerConnection)
+        {
+          innerConnection = EventBus::Subscribe<CountEvent>(
+              [&](const CountEvent &){++inner;});
+        }
+      });
+
+  EventBus::Publish(CountEvent(1));
+  EXPECT_EQ(0, inner);
+  EventBus::Publish(CountEvent(2));
+  EXPECT_EQ(1, inner);
+
+  innerConnection.reset();
+  outer.reset();
+}
+
+/////////////////////////////////////////////////
+TEST(EventBusTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(MainWindow))
+{
+  Application app(g_argc, g_argv);
+  auto *win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Events sent to the main window are published on the bus
+  math::Vector3d point;
+  auto connection = EventBus::Subscribe<events::HoverToScene>(
+      [&](const events::HoverToScene &_event)
+      {
+        point = _event.Point();
+      });
+
+  events::HoverToScene event({1, 2, 3});
+  app.sendEvent(win, &event);
+  EXPECT_EQ(math::Vector3d(1, 2, 3), point);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/gui/EventQueue.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(EventQueueTest, Batches)
+{
+  EventQueue<std::string> queue;
+  EXPECT_EQ(0u, queue.Size());
+
+  // Only the first item of a batch asks for a drain
+  EXPECT_TRUE(queue.Push("a"));
+  EXPECT_FALSE(queue.Push("b"));
+  EXPECT_FALSE(queue.Push("c"));
+  EXPECT_EQ(3u, queue.Size());
+
+  std::vector<std::string> drained;
+  EXPECT_EQ(3u, queue.Drain([&](std::string &_item)
+  {
+    drained.push_back(std::move(_item));
+  }));
+  ASSERT_EQ(3u, drained.size());
+  EXPECT_EQ("a", drained[0]);
+  EXPECT_EQ("b", drained[1]);
+  EXPECT_EQ("c", drained[2]);
+  EXPECT_EQ(0u, queue.Size());
+
+  // Nothing left
+  EXPECT_EQ(0u, queue.Drain([](std::string &){}));
+
+  // The next batch asks again, including items pushed by a handler
+  EXPECT_TRUE(queue.Push("d"));
+  bool pushed{false};
+  queue.Drain([&](std::string &)
+  {
+    pushed = queue.Push("e");
+  });
+  EXPECT_TRUE(pushed);
+  EXPECT_EQ(1u, queue.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(EventQueueTest, MoveOnly)
+{
+  EventQueue<std::unique_ptr<int>> queue;
+  queue.Push(std::make_unique<int>(5));
+
+  int value{0};
+  queue.Drain([&](std::unique_ptr<int> &_item)
+  {
+    value = *_item;
+  });
+  EXPECT_EQ(5, value);
+}
+
+/////////////////////////////////////////////////
+TEST(EventQueueTest, Producers)
+{
+  EventQueue<int> queue;
+
+  // Each producer's items stay in order
+  const int producers{4};
+  const int items{1000};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.emplace_back([&queue, p, items]()
+    {
+      for (int i = 0; i < items; ++i)
+        queue.Push(p * items + i);
+    });
+  }
+
+  std::vector<int> last(producers, -1);
+  int count{0};
+  bool ordered{true};
+  auto handler = [&](int &_item)
+  {
+    const int producer = _item / items;
+    ordered = ordered && _item > last[producer];
+    last[producer] = _item;
+    ++count;
+  };
+  while (count < producers * items)
+    queue.Drain(handler);
+
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(producers * items, count);
+  EXPECT_EQ(0u, queue.Size());
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/FrameTaps.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Most released frames kept for reuse
+constexpr std::size_t kMaxFreeFrames{4u};
+
+/// \brief A subscriber
+struct Tap
+{
+  /// \brief The callback
+  FrameTaps::Callback callback;
+
+  /// \brief What the subscriber wants
+  FrameTapOptions options;
+
+  /// \brief Time between frames, zero for all frames
+  std::chrono::steady_clock::duration period{0};
+
+  /// \brief Time the next frame is due, unset until the first one
+  std::optional<std::chrono::steady_clock::time_point> next;
+
+  /// \brief False once the connection has been destroyed
+  bool connected{true};
+};
+
+/// \brief All subscribers, and released frames
+class Registry
+{
+  /// \brief Protects the subscribers. Recursive so that callbacks can
+  /// subscribe and unsubscribe.
+  public: std::recursive_mutex mutex;
+
+  /// \brief Subscribers, in the order they subscribed
+  public: std::vector<std::shared_ptr<Tap>> taps;
+
+  /// \brief Protects the released frames
+  public: std::mutex poolMutex;
+
+  /// \brief Released frames, whose buffers are reused
+  public: std::vector<std::unique_ptr<TapFrame>> freeFrames;
+};
+
+/////////////////////////////////////////////////
+std::shared_ptr<Registry> &registry()
+{
+  static auto instance = std::make_shared<Registry>();
+  return instance;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a subscriber is due for a frame and wants it.
+/// Frames up to an eighth of the period early are accepted, so a rate
+/// which divides the render rate isn't halved by jitter.
+/// \param[in] _tap Subscriber
+/// \param[in] _time Time of the frame
+/// \return True if due
+bool isDue(const Tap &_tap, std::chrono::steady_clock::time_point _time)
+{
+  if (!_tap.connected)
+    return false;
+  if (_tap.next.has_value() && _time + _tap.period / 8 < *_tap.next)
+    return false;
+  return !_tap.options.wanted || _tap.options.wanted();
+}
+
+/////////////////////////////////////////////////
+/// \brief Set when a subscriber is due next, after handing it a frame
+/// \param[in] _tap Subscriber
+/// \param[in] _time Time of the frame
+void advance(Tap &_tap, std::chrono::steady_clock::time_point _time)
+{
+  if (_tap.period.count() <= 0)
+    return;
+
+  // Keep a steady rate, unless frames stopped coming for a while
+  if (!_tap.next.has_value() || *_tap.next + _tap.period < _time)
+    _tap.next = _time + _tap.period;
+  else
+    *_tap.next += _tap.period;
+}
+
+/////////////////////////////////////////////////
+/// \brief Size a frame is downscaled to for a subscriber
+/// \param[in] _frame The frame
+/// \param[in] _options What the subscriber wants
+/// \return Width and height, keeping the aspect ratio
+std::pair<unsigned int, unsigned int> fitSize(const TapFrame &_frame,
+    const FrameTapOptions &_options)
+{
+  double scale{1.0};
+  if (_options.maxWidth > 0u && _frame.width > _options.maxWidth)
+    scale = static_cast<double>(_options.maxWidth) / _frame.width;
+  if (_options.maxHeight > 0u && _frame.height > _options.maxHeight)
+  {
+    scale = std::min(scale,
+        static_cast<double>(_options.maxHeight) / _frame.height);
+  }
+  if (scale >= 1.0)
+    return {_frame.width, _frame.height};
+  return {std::max(1u, static_cast<unsigned int>(_frame.width * scale)),
+          std::max(1u, static_cast<unsigned int>(_frame.height * scale))};
+}
+
+/////////////////////////////////////////////////
+/// \brief Downscale a frame, averaging the pixels each pixel covers
+/// \param[in] _src Frame to downscale
+/// \param[in] _width New width, not larger than the frame's
+/// \param[in] _height New height, not larger than the frame's
+/// \param[out] _dst Downscaled frame
+void downscale(const TapFrame &_src, unsigned int _width,
+    unsigned int _height, TapFrame &_dst)
+{
+  _dst.index = _src.index;
+  _dst.time = _src.time;
+  _dst.width = _width;
+  _dst.height = _height;
+  _dst.format = _src.format;
+  _dst.bytesPerPixel = _src.bytesPerPixel;
+  _dst.texture = nullptr;
+
+  const std::size_t bpp = _src.bytesPerPixel;
+  _dst.data.resize(static_cast<std::size_t>(_width) * _height * bpp);
+  std::vector<unsigned int> sum(bpp);
+  for (std::size_t y = 0; y < _height; ++y)
+  {
+    const std::size_t y0 = y * _src.height / _height;
+    const std::size_t y1 = std::max(y0 + 1, (y + 1) * _src.height / _height);
+    for (std::size_t x = 0; x < _width; ++x)
+    {
+      const std::size_t x0 = x * _src.width / _width;
+      const std::size_t x1 = std::max(x0 + 1, (x + 1) * _src.width / _width);
+      std::fill(sum.begin(), sum.end(), 0u);
+      for (std::size_t sy = y0; sy < y1; ++sy)
+      {
+        const unsigned char *row =
+            _src.data.data() + (sy * _src.width + x0) * bpp;
+        for (std::size_t i = 0; i < (x1 - x0) * bpp; ++i)
+          sum[i % bpp] += row[i];
+      }
+      const auto count = static_cast<unsigned int>((y1 - y0) * (x1 - x0));
+      unsigned char *pixel = _dst.data.data() + (y * _width + x) * bpp;
+      for (std::size_t c = 0; c < bpp; ++c)
+        pixel[c] = static_cast<unsigned char>((sum[c] + count / 2) / count);
+    }
+  }
+}
+}  // namespace
+
+/// \brief Private data for FrameTapConnection
+class FrameTapConnection::Implementation
+{
+  /// \brief Registry the subscriber belongs to. Weak so that connections
+  /// outliving it during static destruction don't touch it.
+  public: std::weak_ptr<Registry> registry;
+
+  /// \brief The subscriber kept connected
+  public: std::shared_ptr<Tap> tap;
+};
+
+/////////////////////////////////////////////////
+FrameTapConnection::FrameTapConnection()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+FrameTapConnection::~FrameTapConnection()
+{
+  auto reg = this->dataPtr->registry.lock();
+  if (nullptr == reg || nullptr == this->dataPtr->tap)
+    return;
+
+  // Blocks while frames are being published, so once this returns the
+  // callback is guaranteed not to be called anymore
+  std::lock_guard<std::recursive_mutex> lock(reg->mutex);
+  this->dataPtr->tap->connected = false;
+  reg->taps.erase(std::remove(reg->taps.begin(), reg->taps.end(),
+      this->dataPtr->tap), reg->taps.end());
+}
+
+/////////////////////////////////////////////////
+FrameTapConnectionPtr FrameTaps::Subscribe(Callback _cb,
+    const FrameTapOptions &_options)
+{
+  auto tap = std::make_shared<Tap>();
+  tap->callback = std::move(_cb);
+  tap->options = _options;
+  if (_options.rate > 0.0)
+  {
+    tap->period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / _options.rate));
+  }
+
+  auto &reg = registry();
+  {
+    std::lock_guard<std::recursive_mutex> lock(reg->mutex);
+    reg->taps.push_back(tap);
+  }
+
+  auto connection = std::make_shared<FrameTapConnection>();
+  connection->dataPtr->registry = reg;
+  connection->dataPtr->tap = std::move(tap);
+  return connection;
+}
+
+/////////////////////////////////////////////////
+bool FrameTaps::Due(FrameTapOptions::Access _access,
+    std::chrono::steady_clock::time_point _time)
+{
+  auto &reg = registry();
+  std::lock_guard<std::recursive_mutex> lock(reg->mutex);
+  return std::any_of(reg->taps.begin(), reg->taps.end(),
+      [&](const std::shared_ptr<Tap> &_tap)
+      {
+        return _tap->options.access == _access && isDue(*_tap, _time);
+      });
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<TapFrame> FrameTaps::AcquireFrame()
+{
+  auto &reg = registry();
+  std::unique_ptr<TapFrame> frame;
+  {
+    std::lock_guard<std::mutex> lock(reg->poolMutex);
+    if (!reg->freeFrames.empty())
+    {
+      frame = std::move(reg->freeFrames.back());
+      reg->freeFrames.pop_back();
+    }
+  }
+  if (nullptr == frame)
+    frame = std::make_unique<TapFrame>();
+
+  // Once all subscribers are done with it, the frame goes back to the pool
+  // with its buffer allocated
+  std::weak_ptr<Registry> weakRegistry = reg;
+  return std::shared_ptr<TapFrame>(frame.release(),
+      [weakRegistry](TapFrame *_frame)
+      {
+        std::unique_ptr<TapFrame> released(_frame);
+        auto owner = weakRegistry.lock();
+        if (nullptr == owner)
+          return;
+        released->texture = nullptr;
+        std::lock_guard<std::mutex> lock(owner->poolMutex);
+        if (owner->freeFrames.size() < kMaxFreeFrames)
+          owner->freeFrames.push_back(std::move(released));
+      });
+}
+
+/////////////////////////////////////////////////
+void FrameTaps::Publish(FrameTapOptions::Access _access,
+    const std::shared_ptr<TapFrame> &_frame)
+{
+  if (nullptr == _frame)
+    return;
+
+  auto &reg = registry();
+  std::lock_guard<std::recursive_mutex> lock(reg->mutex);
+
+  // Callbacks may subscribe or unsubscribe
+  const auto taps = reg->taps;
+
+  // Frames downscaled so far, shared by subscribers wanting the same size
+  std::vector<std::pair<std::pair<unsigned int, unsigned int>,
+      TapFramePtr>> scaled;
+  for (const auto &tap : taps)
+  {
+    if (tap->options.access != _access || !isDue(*tap, _frame->time))
+      continue;
+    advance(*tap, _frame->time);
+
+    TapFramePtr frame = _frame;
+    if (_access == FrameTapOptions::Access::CPU)
+    {
+      const auto size = fitSize(*_frame, tap->options);
+      if (size.first != _frame->width || size.second != _frame->height)
+      {
+        auto it = std::find_if(scaled.begin(), scaled.end(),
+            [&size](const auto &_scaled)
+            {
+              return _scaled.first == size;
+            });
+        if (it == scaled.end())
+        {
+          auto newFrame = AcquireFrame();
+          downscale(*_frame, size.first, size.second, *newFrame);
+          it = scaled.emplace(scaled.end(), size, std::move(newFrame));
+        }
+        frame = it->second;
+      }
+    }
+    tap->callback(frame);
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTaps::SubscriberCount(FrameTapOptions::Access _access)
+{
+  auto &reg = registry();
+  std::lock_guard<std::recursive_mutex> lock(reg->mutex);
+  return static_cast<std::size_t>(std::count_if(reg->taps.begin(),
+      reg->taps.end(), [_access](const std::shared_ptr<Tap> &_tap)
+      {
+        return _tap->options.access == _access;
+      }));
+}
+}  // namespace gz::gui
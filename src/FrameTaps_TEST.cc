@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/FrameTaps.hh"
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Make a CPU frame whose pixels all have the same value
+/// \param[in] _index Frame index
+/// \param[in] _time Time the frame was rendered
+/// \param[in] _width Width
+/// \param[in] _height Height
+/// \param[in] _value Value of all channels
+/// \return The frame
+std::shared_ptr<TapFrame> makeFrame(std::uint64_t _index,
+    std::chrono::steady_clock::time_point _time, unsigned int _width = 4,
+    unsigned int _height = 2, unsigned char _value = 0)
+{
+  auto frame = FrameTaps::AcquireFrame();
+  frame->index = _index;
+  frame->time = _time;
+  frame->width = _width;
+  frame->height = _height;
+  frame->format = "RGB_INT8";
+  frame->bytesPerPixel = 3;
+  frame->data.assign(static_cast<std::size_t>(_width) * _height * 3, _value);
+  return frame;
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTapsTest, Rate)
+{
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(FrameTaps::Due(FrameTapOptions::Access::CPU, start));
+
+  std::vector<std::uint64_t> all;
+  std::vector<std::uint64_t> slow;
+  auto c0 = FrameTaps::Subscribe([&all](const TapFramePtr &_frame)
+  {
+    all.push_back(_frame->index);
+  });
+  FrameTapOptions options;
+  options.rate = 20.0;
+  auto c1 = FrameTaps::Subscribe([&slow](const TapFramePtr &_frame)
+  {
+    slow.push_back(_frame->index);
+  }, options);
+  EXPECT_EQ(2u, FrameTaps::SubscriberCount(FrameTapOptions::Access::CPU));
+  EXPECT_EQ(0u, FrameTaps::SubscriberCount(FrameTapOptions::Access::GPU));
+
+  // One second at 60 fps, with some jitter
+  for (std::uint64_t i = 0; i < 60; ++i)
+  {
+    const auto time = start + std::chrono::microseconds(
+        16667 * i + (i % 2 == 0 ? 300 : -300));
+    EXPECT_TRUE(FrameTaps::Due(FrameTapOptions::Access::CPU, time));
+    FrameTaps::Publish(FrameTapOptions::Access::CPU, makeFrame(i, time));
+  }
+  EXPECT_EQ(60u, all.size());
+  ASSERT_EQ(20u, slow.size());
+  for (std::size_t i = 0; i < slow.size(); ++i)
+    EXPECT_EQ(i * 3, slow[i]);
+
+  // GPU subscribers don't get CPU frames and vice versa
+  FrameTaps::Publish(FrameTapOptions::Access::GPU, makeFrame(60, start));
+  EXPECT_EQ(60u, all.size());
+
+  c0.reset();
+  c1.reset();
+  EXPECT_EQ(0u, FrameTaps::SubscriberCount(FrameTapOptions::Access::CPU));
+  EXPECT_FALSE(FrameTaps::Due(FrameTapOptions::Access::CPU, start));
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTapsTest, Wanted)
+{
+  bool wanted{false};
+  int calls{0};
+  FrameTapOptions options;
+  options.wanted = [&wanted]()
+  {
+    return wanted;
+  };
+  auto connection = FrameTaps::Subscribe([&calls](const TapFramePtr &)
+  {
+    ++calls;
+  }, options);
+
+  // Nothing is read back until the subscriber wants a frame
+  const auto now = std::chrono::steady_clock::now();
+  EXPECT_FALSE(FrameTaps::Due(FrameTapOptions::Access::CPU, now));
+  FrameTaps::Publish(FrameTapOptions::Access::CPU, makeFrame(0, now));
+  EXPECT_EQ(0, calls);
+
+  wanted = true;
+  EXPECT_TRUE(FrameTaps::Due(FrameTapOptions::Access::CPU, now));
+  FrameTaps::Publish(FrameTapOptions::Access::CPU, makeFrame(1, now));
+  EXPECT_EQ(1, calls);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTapsTest, SharedFrames)
+{
+  std::vector<TapFramePtr> frames(4);
+  auto subscribe = [&frames](std::size_t _i, unsigned int _maxWidth)
+  {
+    FrameTapOptions options;
+    options.maxWidth = _maxWidth;
+    return FrameTaps::Subscribe([&frames, _i](const TapFramePtr &_frame)
+    {
+      frames[_i] = _frame;
+    }, options);
+  };
+  auto c0 = subscribe(0, 0);
+  auto c1 = subscribe(1, 8);
+  auto c2 = subscribe(2, 2);
+  auto c3 = subscribe(3, 2);
+
+  // Two columns of each value
+  auto frame = makeFrame(0, std::chrono::steady_clock::now());
+  for (std::size_t i = 0; i < frame->data.size(); ++i)
+    frame->data[i] = (i / 6) % 2 == 0 ? 10 : 20;
+  FrameTaps::Publish(FrameTapOptions::Access::CPU, frame);
+
+  // Subscribers wanting the full size get the same frame
+  EXPECT_EQ(frame, frames[0]);
+  EXPECT_EQ(frame, frames[1]);
+
+  // Smaller sizes are downscaled once and shared
+  ASSERT_NE(nullptr, frames[2]);
+  EXPECT_EQ(frames[2], frames[3]);
+  EXPECT_EQ(2u, frames[2]->width);
+  EXPECT_EQ(1u, frames[2]->height);
+  EXPECT_EQ("RGB_INT8", frames[2]->format);
+  EXPECT_EQ(std::vector<unsigned char>({10, 10, 10, 20, 20, 20}),
+      frames[2]->data);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTapsTest, Unsubscribe)
+{
+  int calls{0};
+  FrameTapConnectionPtr connection;
+  connection = FrameTaps::Subscribe([&](const TapFramePtr &)
+  {
+    ++calls;
+    // Unsubscribing from the callback takes effect right away
+    connection.reset();
+  });
+  int otherCalls{0};
+  auto other = FrameTaps::Subscribe([&](const TapFramePtr &)
+  {
+    ++otherCalls;
+  });
+
+  const auto now = std::chrono::steady_clock::now();
+  FrameTaps::Publish(FrameTapOptions::Access::CPU, makeFrame(0, now));
+  FrameTaps::Publish(FrameTapOptions::Access::CPU, makeFrame(1, now));
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(2, otherCalls);
+  EXPECT_EQ(1u, FrameTaps::SubscriberCount(FrameTapOptions::Access::CPU));
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTapsTest, ReuseBuffers)
+{
+  // Empty the pool of the frames released by other tests
+  std::vector<std::shared_ptr<TapFrame>> drained;
+  for (int i = 0; i < 8; ++i)
+    drained.push_back(FrameTaps::AcquireFrame());
+
+  auto frame = makeFrame(0, std::chrono::steady_clock::now(), 64, 64);
+  const TapFrame *first = frame.get();
+  const unsigned char *data = frame->data.data();
+
+  // Still used by a subscriber
+  TapFramePtr kept = frame;
+  frame.reset();
+  auto other = FrameTaps::AcquireFrame();
+  EXPECT_NE(first, other.get());
+
+  // Released frames are reused along with their buffer
+  kept.reset();
+  auto reused = FrameTaps::AcquireFrame();
+  EXPECT_EQ(first, reused.get());
+  EXPECT_EQ(data, reused->data.data());
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <tinyxml2.h>
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Util.hh>
+
+#include "gz/gui/GpuSelection.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Variable holding the requested GPU
+constexpr const char *kGpuEnv{"GZ_GUI_GPU"};
+
+/////////////////////////////////////////////////
+/// \brief Remove surrounding whitespace and lower the case
+/// \param[in] _str String
+/// \return Trimmed lowercase string
+std::string normalized(const std::string &_str)
+{
+  const auto begin = _str.find_first_not_of(" \t\n\r");
+  if (begin == std::string::npos)
+    return {};
+  const auto end = _str.find_last_not_of(" \t\n\r");
+
+  std::string result = _str.substr(begin, end - begin + 1);
+  std::transform(result.begin(), result.end(), result.begin(),
+      [](unsigned char _c) {return std::tolower(_c);});
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Whether a GPU names a PCI device, the way DRI_PRIME takes them:
+/// vendor and device IDs such as "1002:687f", or a PCI tag such as
+/// "pci-0000_02_00_0"
+/// \param[in] _gpu Normalized GPU
+/// \return True if it's a PCI device
+bool isPciDevice(const std::string &_gpu)
+{
+  if (_gpu.rfind("pci-", 0) == 0)
+    return true;
+
+  if (_gpu.size() != 9 || _gpu[4] != ':')
+    return false;
+  for (std::size_t i = 0; i < _gpu.size(); ++i)
+  {
+    if (i != 4 && !std::isxdigit(static_cast<unsigned char>(_gpu[i])))
+      return false;
+  }
+  return true;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+std::string GpuSelection::Requested()
+{
+  std::string gpu;
+  common::env(kGpuEnv, gpu);
+  return normalized(gpu);
+}
+
+/////////////////////////////////////////////////
+void GpuSelection::SetRequested(const std::string &_gpu)
+{
+  if (normalized(_gpu).empty())
+    common::unsetenv(kGpuEnv);
+  else
+    common::setenv(kGpuEnv, _gpu);
+}
+
+/////////////////////////////////////////////////
+std::string GpuSelection::FromConfig(const std::string &_path)
+{
+  tinyxml2::XMLDocument doc;
+  if (_path.empty() || doc.LoadFile(_path.c_str()) != tinyxml2::XML_SUCCESS)
+    return {};
+
+  const auto *gpuElem = doc.FirstChildElement("gpu");
+  if (nullptr == gpuElem || nullptr == gpuElem->GetText())
+    return {};
+  return normalized(gpuElem->GetText());
+}
+
+/////////////////////////////////////////////////
+std::optional<unsigned int> GpuSelection::Index(const std::string &_gpu)
+{
+  const auto gpu = normalized(_gpu);
+  if (gpu.empty() || gpu.size() > 4 ||
+      !std::all_of(gpu.begin(), gpu.end(),
+          [](unsigned char _c) {return std::isdigit(_c);}))
+  {
+    return std::nullopt;
+  }
+  return static_cast<unsigned int>(std::stoul(gpu));
+}
+
+/////////////////////////////////////////////////
+std::optional<std::size_t> GpuSelection::Match(const std::string &_gpu,
+    const std::vector<std::string> &_names)
+{
+  if (auto index = Index(_gpu))
+  {
+    if (*index < _names.size())
+      return *index;
+    return std::nullopt;
+  }
+
+  const auto gpu = normalized(_gpu);
+  if (gpu.empty())
+    return std::nullopt;
+
+  for (std::size_t i = 0; i < _names.size(); ++i)
+  {
+    if (normalized(_names[i]).find(gpu) != std::string::npos)
+      return i;
+  }
+  return std::nullopt;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::pair<std::string, std::string>>
+    GpuSelection::OpenGlEnvironment(const std::string &_gpu)
+{
+  const auto gpu = normalized(_gpu);
+  if (auto index = Index(gpu))
+  {
+    if (0 == *index)
+      return {};
+    return {{"DRI_PRIME", std::to_string(*index)}};
+  }
+
+  if (isPciDevice(gpu))
+    return {{"DRI_PRIME", gpu}};
+
+  if (gpu.find("nvidia") != std::string::npos)
+  {
+    return {
+      {"__NV_PRIME_RENDER_OFFLOAD", "1"},
+      {"__GLX_VENDOR_LIBRARY_NAME", "nvidia"},
+      {"__VK_LAYER_NV_optimus", "NVIDIA_only"}};
+  }
+
+  return {};
+}
+
+/////////////////////////////////////////////////
+bool GpuSelection::ApplyOpenGlEnvironment()
+{
+  const auto gpu = Requested();
+  if (gpu.empty())
+    return true;
+
+#ifdef __linux__
+  const auto vars = OpenGlEnvironment(gpu);
+  if (vars.empty() && Index(gpu) != 0u)
+  {
+    gzwarn << "GPU [" << gpu << "] can't be chosen for OpenGL, use an "
+           << "index, a PCI device or \"nvidia\". Using the default GPU."
+           << std::endl;
+    return false;
+  }
+
+  for (const auto &[name, value] : vars)
+  {
+    std::string current;
+    if (common::env(name, current) && !current.empty())
+    {
+      gzdbg << "Keeping [" << name << "=" << current << "] for GPU [" << gpu
+            << "]" << std::endl;
+      continue;
+    }
+    gzdbg << "Setting [" << name << "=" << value << "] for GPU [" << gpu
+          << "]" << std::endl;
+    common::setenv(name, value);
+  }
+  return true;
+#else
+  gzwarn << "GPU [" << gpu << "] can only be chosen for OpenGL on Linux. "
+         << "Using the default GPU." << std::endl;
+  return false;
+#endif
+}
+}  // namespace gz::gui
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/GpuSelection.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(GpuSelectionTest, Match)
+{
+  const std::vector<std::string> names{
+      "Intel(R) UHD Graphics 630", "NVIDIA GeForce RTX 3080",
+      "NVIDIA RTX A6000"};
+
+  EXPECT_EQ(1u, GpuSelection::Index(" 1 "));
+  EXPECT_FALSE(GpuSelection::Index("nvidia").has_value());
+  EXPECT_FALSE(GpuSelection::Index("-1").has_value());
+  EXPECT_FALSE(GpuSelection::Index("").has_value());
+
+  // Indices, then the first name containing the request, without case
+  EXPECT_EQ(2u, GpuSelection::Match("2", names));
+  EXPECT_EQ(1u, GpuSelection::Match("nvidia", names));
+  EXPECT_EQ(2u, GpuSelection::Match("a6000", names));
+  EXPECT_EQ(0u, GpuSelection::Match("Intel", names));
+
+  EXPECT_FALSE(GpuSelection::Match("3", names).has_value());
+  EXPECT_FALSE(GpuSelection::Match("amd", names).has_value());
+  EXPECT_FALSE(GpuSelection::Match("", names).has_value());
+  EXPECT_FALSE(GpuSelection::Match("0", {}).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(GpuSelectionTest, OpenGlEnvironment)
+{
+  using Vars = std::vector<std::pair<std::string, std::string>>;
+
+  // The default GPU needs nothing
+  EXPECT_TRUE(GpuSelection::OpenGlEnvironment("").empty());
+  EXPECT_TRUE(GpuSelection::OpenGlEnvironment("0").empty());
+
+  EXPECT_EQ(Vars({{"DRI_PRIME", "1"}}),
+      GpuSelection::OpenGlEnvironment("1"));
+  EXPECT_EQ(Vars({{"DRI_PRIME", "1002:687f"}}),
+      GpuSelection::OpenGlEnvironment("1002:687F"));
+  EXPECT_EQ(Vars({{"DRI_PRIME", "pci-0000_02_00_0"}}),
+      GpuSelection::OpenGlEnvironment("pci-0000_02_00_0"));
+
+  auto vars = GpuSelection::OpenGlEnvironment("NVIDIA RTX");
+  ASSERT_FALSE(vars.empty());
+  EXPECT_EQ("__NV_PRIME_RENDER_OFFLOAD", vars[0].first);
+
+  // Other names can't be chosen for OpenGL
+  EXPECT_TRUE(GpuSelection::OpenGlEnvironment("radeon").empty());
+  EXPECT_TRUE(GpuSelection::OpenGlEnvironment("1002:68").empty());
+}
+
+/////////////////////////////////////////////////
+TEST(GpuSelectionTest, Requested)
+{
+  GpuSelection::SetRequested("NVIDIA");
+  EXPECT_EQ("nvidia", GpuSelection::Requested());
+
+  GpuSelection::SetRequested("");
+  EXPECT_TRUE(GpuSelection::Requested().empty());
+
+  // From a config file
+  const auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "GpuSelectionTest.config");
+  {
+    std::ofstream config(path);
+    config << "<window></window>\n<gpu> 1 </gpu>\n";
+  }
+  EXPECT_EQ("1", GpuSelection::FromConfig(path));
+  EXPECT_TRUE(GpuSelection::FromConfig(path + ".missing").empty());
+
+  {
+    std::ofstream config(path);
+    config << "<window></window>\n";
+  }
+  EXPECT_TRUE(GpuSelection::FromConfig(path).empty());
+  common::removeFile(path);
+}
+
+/////////////////////////////////////////////////
+TEST(GpuSelectionTest, ApplyOpenGlEnvironment)
+{
+  GpuSelection::SetRequested("");
+  EXPECT_TRUE(GpuSelection::ApplyOpenGlEnvironment());
+
+#ifdef __linux__
+  common::unsetenv("DRI_PRIME");
+  GpuSelection::SetRequested("1");
+  EXPECT_TRUE(GpuSelection::ApplyOpenGlEnvironment());
+  std::string value;
+  EXPECT_TRUE(common::env("DRI_PRIME", value));
+  EXPECT_EQ("1", value);
+
+  // Variables set by the user are kept
+  common::setenv("DRI_PRIME", "pci-0000_03_00_0");
+  GpuSelection::SetRequested("2");
+  EXPECT_TRUE(GpuSelection::ApplyOpenGlEnvironment());
+  EXPECT_TRUE(common::env("DRI_PRIME", value));
+  EXPECT_EQ("pci-0000_03_00_0", value);
+  common::unsetenv("DRI_PRIME");
+
+  GpuSelection::SetRequested("radeon");
+  EXPECT_FALSE(GpuSelection::ApplyOpenGlEnvironment());
+#endif
+
+  GpuSelection::SetRequested("");
+}
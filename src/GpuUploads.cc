@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "gz/gui/GpuUploads.hh"
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/RenderHooks.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Frames after which an upload outside the view counts as within
+/// it, about a second at 60 frames per second
+constexpr uint64_t kMaxWaitFrames{60};
+
+struct Entry;
+
+/// \brief State of a queue, kept alive by its pending uploads
+struct QueueState
+{
+  /// \brief Incremented when the queue is cleared or destroyed, which
+  /// drops the uploads pushed before
+  uint64_t generation{0};
+
+  /// \brief Number of uploads pending
+  std::size_t pending{0};
+
+  /// \brief Bytes of the uploads pending
+  std::size_t pendingBytes{0};
+
+  /// \brief Pending upload of each key
+  std::unordered_map<std::string, std::shared_ptr<Entry>> latest;
+
+  /// \brief Measures the uploads, null if the queue has no owner
+  std::unique_ptr<PerformanceCounter> counter;
+};
+
+/// \brief A staged upload
+struct Entry
+{
+  /// \brief Queue it was pushed to
+  std::shared_ptr<QueueState> queue;
+
+  /// \brief Generation of the queue when pushed
+  uint64_t generation{0};
+
+  /// \brief Frame it was pushed in
+  uint64_t frame{0};
+
+  /// \brief Key, empty if it can't be replaced
+  std::string key;
+
+  /// \brief Bytes copied to the GPU
+  std::size_t bytes{0};
+
+  /// \brief World box covered, unset if unknown
+  std::optional<math::AxisAlignedBox> bounds;
+
+  /// \brief The upload
+  GpuUploadQueue::Upload upload;
+};
+
+/// \brief Uploads of all queues, in the order they were pushed
+struct UploadList
+{
+  /// \brief Protects everything but `runMutex`, and the queue states.
+  /// Never held while an upload runs.
+  std::mutex mutex;
+
+  /// \brief Held while uploads run, so destroyed queues can wait for them.
+  /// Recursive so that uploads can destroy queues.
+  std::recursive_mutex runMutex;
+
+  /// \brief Pushed uploads, including dropped ones until they're reached.
+  /// Only Run removes entries, others only append, so Run's iterators stay
+  /// valid while the mutex is released.
+  std::list<std::shared_ptr<Entry>> entries;
+
+  /// \brief Number of uploads which weren't dropped
+  std::size_t pending{0};
+
+  /// \brief Bytes of the uploads which weren't dropped
+  std::size_t pendingBytes{0};
+
+  /// \brief Frames started by Run
+  uint64_t frame{0};
+
+  /// \brief Budget of the current frame, zero for no limit
+  std::size_t budget{0};
+
+  /// \brief Bytes uploaded in the current frame
+  std::size_t spent{0};
+
+  /// \brief View of the camera, unset to treat all uploads the same
+  std::optional<math::Frustum> view;
+};
+
+/////////////////////////////////////////////////
+std::shared_ptr<UploadList> &uploadList()
+{
+  static auto list = std::make_shared<UploadList>();
+  return list;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove an entry from the pending counts. Must be called with the
+/// list's mutex locked.
+/// \param[in] _list List of all uploads
+/// \param[in] _entry Entry taken out of the list
+void take(UploadList &_list, const Entry &_entry)
+{
+  auto &queue = *_entry.queue;
+  --queue.pending;
+  queue.pendingBytes -= _entry.bytes;
+  --_list.pending;
+  _list.pendingBytes -= _entry.bytes;
+  if (!_entry.key.empty())
+    queue.latest.erase(_entry.key);
+  if (queue.counter)
+    queue.counter->SetQueueDepth(queue.pending);
+}
+}  // namespace
+
+/// \brief Private data for GpuUploadQueue
+class GpuUploadQueue::Implementation
+{
+  /// \brief Drop pending uploads. Must be called with the list's mutex
+  /// locked.
+  /// \param[in] _list List of all uploads
+  public: void Drop(UploadList &_list)
+  {
+    ++this->state->generation;
+    _list.pending -= this->state->pending;
+    _list.pendingBytes -= this->state->pendingBytes;
+    this->state->pending = 0;
+    this->state->pendingBytes = 0;
+    this->state->latest.clear();
+    if (this->state->counter)
+      this->state->counter->SetQueueDepth(0);
+  }
+
+  /// \brief List of all uploads. Weak so that queues outliving it during
+  /// static destruction don't touch it.
+  public: std::weak_ptr<UploadList> list;
+
+  /// \brief State shared with the pending uploads
+  public: std::shared_ptr<QueueState> state;
+};
+
+/////////////////////////////////////////////////
+GpuUploadQueue::GpuUploadQueue(const std::string &_owner)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->list = uploadList();
+  this->dataPtr->state = std::make_shared<QueueState>();
+  if (!_owner.empty())
+  {
+    this->dataPtr->state->counter =
+        std::make_unique<PerformanceCounter>(_owner, "gpu upload");
+  }
+}
+
+/////////////////////////////////////////////////
+GpuUploadQueue::~GpuUploadQueue()
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(list->mutex);
+    this->dataPtr->Drop(*list);
+  }
+
+  // Blocks while the render thread is running uploads, so once this
+  // returns none of this queue's uploads is running anymore
+  std::lock_guard<std::recursive_mutex> runLock(list->runMutex);
+  this->dataPtr->state->counter.reset();
+}
+
+/////////////////////////////////////////////////
+void GpuUploadQueue::Push(std::size_t _bytes, Upload _upload,
+    const std::optional<math::AxisAlignedBox> &_bounds)
+{
+  this->PushLatest("", _bytes, std::move(_upload), _bounds);
+}
+
+/////////////////////////////////////////////////
+void GpuUploadQueue::PushLatest(const std::string &_key, std::size_t _bytes,
+    Upload _upload, const std::optional<math::AxisAlignedBox> &_bounds)
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list || !_upload)
+    return;
+
+  auto &state = this->dataPtr->state;
+  {
+    std::lock_guard<std::mutex> lock(list->mutex);
+    if (!_key.empty())
+    {
+      auto it = state->latest.find(_key);
+      if (it != state->latest.end())
+      {
+        auto &entry = *it->second;
+        state->pendingBytes = state->pendingBytes - entry.bytes + _bytes;
+        list->pendingBytes = list->pendingBytes - entry.bytes + _bytes;
+        entry.bytes = _bytes;
+        entry.bounds = _bounds;
+        entry.upload = std::move(_upload);
+        return;
+      }
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->queue = state;
+    entry->generation = state->generation;
+    entry->frame = list->frame;
+    entry->key = _key;
+    entry->bytes = _bytes;
+    entry->bounds = _bounds;
+    entry->upload = std::move(_upload);
+    if (!_key.empty())
+      state->latest[_key] = entry;
+    list->entries.push_back(std::move(entry));
+    ++list->pending;
+    list->pendingBytes += _bytes;
+    ++state->pending;
+    state->pendingBytes += _bytes;
+    if (state->counter)
+      state->counter->SetQueueDepth(state->pending);
+  }
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void GpuUploadQueue::Uploaded(std::size_t _bytes)
+{
+  if (this->dataPtr->state->counter)
+    this->dataPtr->state->counter->AddBytes(_bytes);
+
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return;
+
+  std::lock_guard<std::mutex> lock(list->mutex);
+  list->spent += _bytes;
+}
+
+/////////////////////////////////////////////////
+void GpuUploadQueue::Clear()
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(list->mutex);
+    this->dataPtr->Drop(*list);
+  }
+  std::lock_guard<std::recursive_mutex> runLock(list->runMutex);
+}
+
+/////////////////////////////////////////////////
+std::size_t GpuUploadQueue::Size() const
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return 0u;
+
+  std::lock_guard<std::mutex> lock(list->mutex);
+  return this->dataPtr->state->pending;
+}
+
+/////////////////////////////////////////////////
+std::size_t GpuUploadQueue::PendingBytes() const
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return 0u;
+
+  std::lock_guard<std::mutex> lock(list->mutex);
+  return this->dataPtr->state->pendingBytes;
+}
+
+/////////////////////////////////////////////////
+std::size_t GpuUploads::Run(std::size_t _budget)
+{
+  auto list = uploadList();
+  std::lock_guard<std::recursive_mutex> runLock(list->runMutex);
+
+  {
+    std::lock_guard<std::mutex> lock(list->mutex);
+    ++list->frame;
+    list->budget = _budget;
+    list->spent = 0;
+  }
+
+  // Whether an upload goes in the first pass. Called with the mutex locked.
+  auto visible = [&list](const Entry &_entry)
+  {
+    return !list->view || !_entry.bounds ||
+        list->frame - _entry.frame >= kMaxWaitFrames ||
+        list->view->Contains(*_entry.bounds);
+  };
+
+  std::size_t count{0};
+  bool left{false};
+  for (int pass = 0; pass < 2 && !left; ++pass)
+  {
+    std::list<std::shared_ptr<Entry>>::iterator it;
+    {
+      std::lock_guard<std::mutex> lock(list->mutex);
+      it = list->entries.begin();
+    }
+
+    while (true)
+    {
+      std::shared_ptr<Entry> entry;
+      {
+        std::lock_guard<std::mutex> lock(list->mutex);
+        while (it != list->entries.end())
+        {
+          const auto &candidate = *it;
+          if (candidate->generation != candidate->queue->generation)
+          {
+            it = list->entries.erase(it);
+            continue;
+          }
+          if (0 == pass && !visible(*candidate))
+          {
+            ++it;
+            continue;
+          }
+
+          // Keep the priority order, rather than fitting smaller uploads
+          // which come later
+          if (_budget > 0 && count > 0 &&
+              list->spent + candidate->bytes > _budget)
+          {
+            left = true;
+            break;
+          }
+
+          entry = std::move(*it);
+          it = list->entries.erase(it);
+          take(*list, *entry);
+          break;
+        }
+      }
+      if (nullptr == entry)
+        break;
+
+      if (entry->queue->counter)
+      {
+        PerformanceTimer timer(*entry->queue->counter);
+        entry->upload();
+        entry->queue->counter->AddBytes(entry->bytes);
+      }
+      else
+      {
+        entry->upload();
+      }
+      ++count;
+
+      std::lock_guard<std::mutex> lock(list->mutex);
+      list->spent += entry->bytes;
+    }
+  }
+
+  // Continue next frame
+  if (left)
+    RenderHooks::RequestRender();
+
+  return count;
+}
+
+/////////////////////////////////////////////////
+void GpuUploads::SetView(const std::optional<math::Frustum> &_frustum)
+{
+  auto list = uploadList();
+  std::lock_guard<std::mutex> lock(list->mutex);
+  list->view = _frustum;
+}
+
+/////////////////////////////////////////////////
+std::size_t GpuUploads::BudgetLeft()
+{
+  auto list = uploadList();
+  std::lock_guard<std::mutex> lock(list->mutex);
+  if (0 == list->budget)
+    return std::numeric_limits<std::size_t>::max();
+  return list->spent < list->budget ? list->budget - list->spent : 0u;
+}
+
+/////////////////////////////////////////////////
+std::size_t GpuUploads::PendingCount()
+{
+  auto list = uploadList();
+  std::lock_guard<std::mutex> lock(list->mutex);
+  return list->pending;
+}
+
+/////////////////////////////////////////////////
+std::size_t GpuUploads::PendingBytes()
+{
+  auto list = uploadList();
+  std::lock_guard<std::mutex> lock(list->mutex);
+  return list->pendingBytes;
+}
+}  // namespace gz::gui
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/Angle.hh>
+#include <gz/math/Pose3.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/GpuUploads.hh"
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/RenderHooks.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Box of 1 m around a point
+/// \param[in] _x X coordinate of the point
+/// \return Box
+math::AxisAlignedBox boxAt(double _x)
+{
+  return math::AxisAlignedBox(math::Vector3d(_x - 0.5, -0.5, -0.5),
+      math::Vector3d(_x + 0.5, 0.5, 0.5));
+}
+
+/////////////////////////////////////////////////
+TEST(GpuUploadsTest, Priority)
+{
+  std::vector<std::string> calls;
+  GpuUploadQueue queue;
+
+  // Camera at the origin, looking along +X
+  GpuUploads::SetView(math::Frustum(0.1, 100, math::Angle(1.57), 1.0,
+      math::Pose3d::Zero));
+
+  queue.Push(10, [&calls](){calls.push_back("behind");}, boxAt(-10));
+  queue.Push(10, [&calls](){calls.push_back("anywhere");});
+  queue.Push(10, [&calls](){calls.push_back("ahead");}, boxAt(10));
+  EXPECT_EQ(3u, queue.Size());
+  EXPECT_EQ(30u, queue.PendingBytes());
+
+  // Within the view first, then the rest, each in the order pushed
+  EXPECT_EQ(3u, GpuUploads::Run(0));
+  EXPECT_EQ(std::vector<std::string>({"anywhere", "ahead", "behind"}),
+      calls);
+  EXPECT_EQ(0u, GpuUploads::PendingCount());
+  EXPECT_EQ(0u, GpuUploads::PendingBytes());
+
+  // Without a view, all in the order pushed
+  GpuUploads::SetView(std::nullopt);
+  calls.clear();
+  queue.Push(10, [&calls](){calls.push_back("behind");}, boxAt(-10));
+  queue.Push(10, [&calls](){calls.push_back("ahead");}, boxAt(10));
+  GpuUploads::Run(0);
+  EXPECT_EQ(std::vector<std::string>({"behind", "ahead"}), calls);
+}
+
+/////////////////////////////////////////////////
+TEST(GpuUploadsTest, Budget)
+{
+  int requests{0};
+  auto connection = RenderHooks::OnRenderRequest([&requests](){++requests;});
+
+  std::vector<int> calls;
+  GpuUploadQueue queue("GpuUploadsTest");
+  for (int i = 0; i < 3; ++i)
+    queue.Push(100, [&calls, i](){calls.push_back(i);});
+  EXPECT_EQ(3, requests);
+  EXPECT_EQ(300u, GpuUploads::PendingBytes());
+
+  // Up to the budget, and a frame requested for the rest
+  EXPECT_EQ(1u, GpuUploads::Run(150));
+  EXPECT_EQ(4, requests);
+  EXPECT_EQ(50u, GpuUploads::BudgetLeft());
+
+  // Direct uploads take from what's left
+  queue.Uploaded(30);
+  EXPECT_EQ(20u, GpuUploads::BudgetLeft());
+
+  EXPECT_EQ(2u, GpuUploads::Run(250));
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), calls);
+  EXPECT_EQ(4, requests);
+
+  // Larger than the budget, but at least one upload runs
+  queue.Push(1000, [&calls](){calls.push_back(3);});
+  EXPECT_EQ(1u, GpuUploads::Run(100));
+  EXPECT_EQ(0u, GpuUploads::BudgetLeft());
+  EXPECT_EQ(4u, calls.size());
+
+  // No limit
+  EXPECT_EQ(0u, GpuUploads::Run(0));
+  EXPECT_EQ(std::numeric_limits<std::size_t>::max(),
+      GpuUploads::BudgetLeft());
+}
+
+/////////////////////////////////////////////////
+TEST(GpuUploadsTest, Starvation)
+{
+  GpuUploads::SetView(math::Frustum(0.1, 100, math::Angle(1.57), 1.0,
+      math::Pose3d::Zero));
+
+  bool behind{false};
+  int ahead{0};
+  GpuUploadQueue queue;
+  queue.Push(100, [&behind](){behind = true;}, boxAt(-10));
+
+  // Uploads outside the view run eventually, even while those within it
+  // use the whole budget
+  int frames{0};
+  while (!behind && frames < 1000)
+  {
+    queue.Push(100, [&ahead](){++ahead;}, boxAt(10));
+    GpuUploads::Run(100);
+    ++frames;
+  }
+  EXPECT_TRUE(behind);
+  EXPECT_LT(frames, 100);
+  EXPECT_GT(ahead, 10);
+
+  GpuUploads::SetView(std::nullopt);
+  queue.Clear();
+}
+
+/////////////////////////////////////////////////
+TEST(GpuUploadsTest, Latest)
+{
+  std::vector<std::string> calls;
+  GpuUploadQueue queue;
+
+  queue.PushLatest("tile", 100, [&calls](){calls.push_back("tile 0");});
+  queue.Push(10, [&calls](){calls.push_back("other");});
+  queue.PushLatest("tile", 50, [&calls](){calls.push_back("tile 1");});
+  EXPECT_EQ(2u, queue.Size());
+  EXPECT_EQ(60u, queue.PendingBytes());
+
+  // The latest upload keeps the place of the first
+  GpuUploads::Run(0);
+  EXPECT_EQ(std::vector<std::string>({"tile 1", "other"}), calls);
+
+  // Once run, the key can be pushed again
+  queue.PushLatest("tile", 100, [&calls](){calls.push_back("tile 2");});
+  EXPECT_EQ(1u, queue.Size());
+  GpuUploads::Run(0);
+  EXPECT_EQ("tile 2", calls.back());
+}
+
+/////////////////////////////////////////////////
+TEST(GpuUploadsTest, Drop)
+{
+  int calls{0};
+  auto kept = std::make_unique<GpuUploadQueue>();
+  auto destroyed = std::make_unique<GpuUploadQueue>();
+
+  kept->Push(1, [&calls](){++calls;});
+  destroyed->Push(2, [&calls](){calls += 10;});
+  kept->Clear();
+  EXPECT_EQ(0u, kept->Size());
+  EXPECT_EQ(0u, kept->PendingBytes());
+  kept->PushLatest("key", 4, [&calls](){calls += 100;});
+  destroyed.reset();
+  EXPECT_EQ(1u, GpuUploads::PendingCount());
+  EXPECT_EQ(4u, GpuUploads::PendingBytes());
+
+  EXPECT_EQ(1u, GpuUploads::Run(0));
+  EXPECT_EQ(100, calls);
+
+  // An upload may destroy its own queue
+  kept->Push(1, [&kept](){kept.reset();});
+  GpuUploads::Run(0);
+  EXPECT_EQ(nullptr, kept);
+}
+
+/////////////////////////////////////////////////
+TEST(GpuUploadsTest, Bandwidth)
+{
+  PerformanceCounters::SetEnabled(true);
+  PerformanceCounters::TakeSamples();
+
+  GpuUploadQueue queue("GpuUploadsBandwidth");
+  queue.Push(1000, [](){});
+  queue.Push(24, [](){});
+  GpuUploads::Run(0);
+  queue.Uploaded(1000);
+
+  // Queued and direct uploads are reported together
+  bool found{false};
+  for (const auto &sample : PerformanceCounters::TakeSamples())
+  {
+    if (sample.owner != "GpuUploadsBandwidth")
+      continue;
+    found = true;
+    EXPECT_EQ("gpu upload", sample.source);
+    EXPECT_EQ(2u, sample.calls);
+    EXPECT_EQ(2024u, sample.bytes);
+  }
+  EXPECT_TRUE(found);
+  PerformanceCounters::SetEnabled(false);
+}
@@ -0,0 +1,606 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/LatencyTrace.hh"
+
+namespace
+{
+/// \brief Upper bound of the first histogram bucket, in milliseconds
+constexpr double kFirstBucket{0.01};
+
+/// \brief Buckets per doubling of the latency
+constexpr int kBucketsPerOctave{4};
+
+/// \brief Number of bounded buckets, up to about 10 s. One more bucket
+/// counts anything longer.
+constexpr int kBucketCount{81};
+
+/// \brief Most spans open at once. Further spans aren't begun, so tags
+/// which are never closed don't grow the trace forever.
+constexpr std::size_t kMaxOpen{10000};
+
+/// \brief Most closed spans kept for the Chrome trace. The histograms keep
+/// counting past it.
+constexpr std::size_t kMaxClosed{200000};
+
+/// \brief Latencies binned on a log scale
+class Histogram
+{
+  /// \brief Add a latency
+  /// \param[in] _ms Latency in milliseconds
+  public: void Add(double _ms)
+  {
+    int bucket{0};
+    if (_ms > kFirstBucket)
+    {
+      bucket = static_cast<int>(std::ceil(
+          std::log2(_ms / kFirstBucket) * kBucketsPerOctave - 1e-9));
+      bucket = std::clamp(bucket, 0, kBucketCount);
+    }
+    ++this->counts[bucket];
+    ++this->count;
+    this->sum += _ms;
+    this->max = std::max(this->max, _ms);
+  }
+
+  /// \brief Get the upper bound of a bucket
+  /// \param[in] _bucket Bucket index
+  /// \return Bound in milliseconds, infinite for the last bucket
+  public: static double Upper(int _bucket)
+  {
+    if (_bucket >= kBucketCount)
+      return std::numeric_limits<double>::infinity();
+    return kFirstBucket * std::exp2(
+        static_cast<double>(_bucket) / kBucketsPerOctave);
+  }
+
+  /// \brief Get a percentile, as the upper bound of its bucket
+  /// \param[in] _fraction Fraction of the latencies below, in [0, 1]
+  /// \return Latency in milliseconds, at most the highest one
+  public: double Percentile(double _fraction) const
+  {
+    if (this->count == 0)
+      return 0.0;
+    const auto rank = static_cast<std::size_t>(
+        std::ceil(_fraction * static_cast<double>(this->count)));
+    std::size_t below{0};
+    for (int i = 0; i <= kBucketCount; ++i)
+    {
+      below += this->counts[i];
+      if (below >= std::max<std::size_t>(rank, 1))
+        return std::min(Upper(i), this->max);
+    }
+    return this->max;
+  }
+
+  /// \brief Count per bucket
+  public: std::array<std::size_t, kBucketCount + 1> counts{};
+
+  /// \brief Number of latencies
+  public: std::size_t count{0};
+
+  /// \brief Sum of the latencies, in milliseconds
+  public: double sum{0.0};
+
+  /// \brief Highest latency, in milliseconds
+  public: double max{0.0};
+};
+
+/// \brief Latencies of a stream
+class Stream
+{
+  /// \brief Track of the stream in the Chrome trace
+  public: unsigned int track{0};
+
+  /// \brief Latencies from the reception
+  public: Histogram fromReceive;
+
+  /// \brief Latencies from the header stamps
+  public: Histogram fromStamp;
+};
+
+/// \brief Span of a msg, from its reception to the frame showing it
+class Span
+{
+  /// \brief Stream of the msg
+  public: const std::string *stream{nullptr};
+
+  /// \brief Header stamp, in seconds since the epoch, 0 if none
+  public: double stamp{0.0};
+
+  /// \brief Reception time
+  public: gz::gui::LatencyTrace::Clock::time_point begin;
+
+  /// \brief Stages reached, in order
+  public: std::vector<std::pair<const char *,
+      gz::gui::LatencyTrace::Clock::time_point>> stages;
+};
+
+/// \brief Span closed, as written to the Chrome trace
+class ClosedSpan
+{
+  /// \brief Track of its stream
+  public: unsigned int track{0};
+
+  /// \brief Stream name
+  public: const std::string *stream{nullptr};
+
+  /// \brief Start, in microseconds since the trace was created
+  public: int64_t start{0};
+
+  /// \brief Duration, in microseconds
+  public: int64_t duration{0};
+
+  /// \brief Latency from the header stamp, in milliseconds, negative if
+  /// there's no stamp
+  public: double fromStamp{-1.0};
+
+  /// \brief Stage offsets from the start, in microseconds
+  public: std::vector<std::pair<const char *, int64_t>> stages;
+};
+
+/////////////////////////////////////////////////
+/// \brief Write a string as a JSON string
+/// \param[in] _stream Stream to write to
+/// \param[in] _str String to write
+void WriteJsonString(std::ostream &_stream, const std::string &_str)
+{
+  _stream << '"';
+  for (const char c : _str)
+  {
+    switch (c)
+    {
+      case '"':
+        _stream << "\\\"";
+        break;
+      case '\\':
+        _stream << "\\\\";
+        break;
+      case '\n':
+        _stream << "\\n";
+        break;
+      case '\t':
+        _stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          _stream << escaped;
+        }
+        else
+        {
+          _stream << c;
+        }
+    }
+  }
+  _stream << '"';
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a CSV field, quoted if needed
+/// \param[in] _stream Stream to write to
+/// \param[in] _str Field
+void WriteCsvField(std::ostream &_stream, const std::string &_str)
+{
+  if (_str.find_first_of(",\"\n") == std::string::npos)
+  {
+    _stream << _str;
+    return;
+  }
+  _stream << '"';
+  for (const char c : _str)
+  {
+    if (c == '"')
+      _stream << '"';
+    _stream << c;
+  }
+  _stream << '"';
+}
+}  // namespace
+
+namespace gz::gui
+{
+class LatencyTrace::Implementation
+{
+  /// \brief Close the spans whose frames are ready, when the window swaps
+  /// its buffers
+  /// \param[in] _now Swap time
+  /// \param[in] _wallNow Swap time, in seconds since the epoch
+  public: void Close(Clock::time_point _now, double _wallNow);
+
+  /// \brief Time origin of the Chrome trace
+  public: const Clock::time_point origin{Clock::now()};
+
+  /// \brief Whether spans are recorded
+  public: std::atomic<bool> enabled{false};
+
+  /// \brief Protects everything below
+  public: mutable std::mutex mutex;
+
+  /// \brief Id of the next span
+  public: std::uint64_t nextId{1};
+
+  /// \brief Streams by name. Map nodes don't move, so spans point to the
+  /// names.
+  public: std::map<std::string, Stream> streams;
+
+  /// \brief Open spans by id
+  public: std::unordered_map<std::uint64_t, Span> open;
+
+  /// \brief Spans held until the next frame of each channel
+  public: std::map<std::string, std::vector<std::uint64_t>> held;
+
+  /// \brief Spans rendered in each channel's latest frame, until the
+  /// window takes it
+  public: std::map<std::string, std::vector<std::uint64_t>> rendered;
+
+  /// \brief Spans whose frames the window took, until its next swap
+  public: std::vector<std::uint64_t> ready;
+
+  /// \brief Closed spans, for the Chrome trace
+  public: std::vector<ClosedSpan> closed;
+};
+
+/////////////////////////////////////////////////
+void LatencyTrace::Implementation::Close(Clock::time_point _now,
+    double _wallNow)
+{
+  using std::chrono::duration;
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  for (const auto id : this->ready)
+  {
+    auto it = this->open.find(id);
+    if (it == this->open.end())
+      continue;
+    const auto &span = it->second;
+    auto &stream = this->streams[*span.stream];
+
+    const double ms =
+        duration<double, std::milli>(_now - span.begin).count();
+    stream.fromReceive.Add(ms);
+    double fromStamp{-1.0};
+    if (span.stamp > 0.0)
+    {
+      fromStamp = std::max(0.0, (_wallNow - span.stamp) * 1000.0);
+      stream.fromStamp.Add(fromStamp);
+    }
+
+    if (this->closed.size() < kMaxClosed)
+    {
+      ClosedSpan record;
+      record.track = stream.track;
+      record.stream = span.stream;
+      record.start =
+          duration_cast<microseconds>(span.begin - this->origin).count();
+      record.duration =
+          duration_cast<microseconds>(_now - span.begin).count();
+      record.fromStamp = fromStamp;
+      for (const auto &[name, time] : span.stages)
+      {
+        record.stages.emplace_back(name,
+            duration_cast<microseconds>(time - span.begin).count());
+      }
+      this->closed.push_back(std::move(record));
+    }
+    this->open.erase(it);
+  }
+  this->ready.clear();
+}
+
+/////////////////////////////////////////////////
+LatencyTrace::LatencyTrace()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+LatencyTrace::~LatencyTrace() = default;
+
+/////////////////////////////////////////////////
+void LatencyTrace::SetEnabled(bool _enabled)
+{
+  this->dataPtr->enabled = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool LatencyTrace::Enabled() const
+{
+  return this->dataPtr->enabled;
+}
+
+/////////////////////////////////////////////////
+LatencyTrace::Tag LatencyTrace::Begin(const std::string &_stream,
+    double _stamp)
+{
+  Tag tag;
+  if (!this->dataPtr->enabled)
+    return tag;
+
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->open.size() >= kMaxOpen)
+    return tag;
+
+  auto stream = this->dataPtr->streams.find(_stream);
+  if (stream == this->dataPtr->streams.end())
+  {
+    Stream newStream;
+    newStream.track =
+        static_cast<unsigned int>(this->dataPtr->streams.size());
+    stream = this->dataPtr->streams.emplace(_stream, newStream).first;
+  }
+
+  tag.id = this->dataPtr->nextId++;
+  auto &span = this->dataPtr->open[tag.id];
+  span.stream = &stream->first;
+  span.stamp = _stamp;
+  span.begin = now;
+  return tag;
+}
+
+/////////////////////////////////////////////////
+void LatencyTrace::Stage(const Tag &_tag, const char *_stage)
+{
+  if (!_tag.Valid())
+    return;
+
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->open.find(_tag.id);
+  if (it != this->dataPtr->open.end())
+    it->second.stages.emplace_back(_stage, now);
+}
+
+/////////////////////////////////////////////////
+void LatencyTrace::Drop(const Tag &_tag)
+{
+  if (!_tag.Valid())
+    return;
+
+  // Ids left in the channels are skipped once their span is gone
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->open.erase(_tag.id);
+}
+
+/////////////////////////////////////////////////
+void LatencyTrace::Hold(const Tag &_tag, const std::string &_channel)
+{
+  if (!_tag.Valid())
+    return;
+
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->open.find(_tag.id);
+  if (it == this->dataPtr->open.end())
+    return;
+  it->second.stages.emplace_back("applied", now);
+  this->dataPtr->held[_channel].push_back(_tag.id);
+}
+
+/////////////////////////////////////////////////
+void LatencyTrace::Rendered(const std::string &_channel)
+{
+  if (!this->dataPtr->enabled)
+    return;
+
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto held = this->dataPtr->held.find(_channel);
+  if (held == this->dataPtr->held.end() || held->second.empty())
+    return;
+
+  auto &rendered = this->dataPtr->rendered[_channel];
+  for (const auto id : held->second)
+  {
+    auto it = this->dataPtr->open.find(id);
+    if (it == this->dataPtr->open.end())
+      continue;
+    it->second.stages.emplace_back("rendered", now);
+    rendered.push_back(id);
+  }
+  held->second.clear();
+}
+
+/////////////////////////////////////////////////
+void LatencyTrace::Ready(const std::string &_channel)
+{
+  if (!this->dataPtr->enabled)
+    return;
+
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto rendered = this->dataPtr->rendered.find(_channel);
+  if (rendered == this->dataPtr->rendered.end() ||
+      rendered->second.empty())
+  {
+    return;
+  }
+
+  for (const auto id : rendered->second)
+  {
+    auto it = this->dataPtr->open.find(id);
+    if (it == this->dataPtr->open.end())
+      continue;
+    it->second.stages.emplace_back("ready", now);
+    this->dataPtr->ready.push_back(id);
+  }
+  rendered->second.clear();
+}
+
+/////////////////////////////////////////////////
+void LatencyTrace::FrameSwapped()
+{
+  if (!this->dataPtr->enabled)
+    return;
+
+  const auto now = Clock::now();
+  const double wallNow = std::chrono::duration<double>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Close(now, wallNow);
+}
+
+/////////////////////////////////////////////////
+std::size_t LatencyTrace::OpenCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->open.size();
+}
+
+/////////////////////////////////////////////////
+LatencyTrace::Summary LatencyTrace::Latencies(const std::string &_stream,
+    bool _fromStamp) const
+{
+  Summary summary;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->streams.find(_stream);
+  if (it == this->dataPtr->streams.end())
+    return summary;
+
+  const auto &histogram =
+      _fromStamp ? it->second.fromStamp : it->second.fromReceive;
+  summary.count = histogram.count;
+  if (histogram.count == 0)
+    return summary;
+  summary.mean = histogram.sum / static_cast<double>(histogram.count);
+  summary.p50 = histogram.Percentile(0.5);
+  summary.p90 = histogram.Percentile(0.9);
+  summary.p99 = histogram.Percentile(0.99);
+  summary.max = histogram.max;
+  return summary;
+}
+
+/////////////////////////////////////////////////
+std::string LatencyTrace::Histograms() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  std::ostringstream stream;
+  stream << "stream,from,upper_ms,count\n";
+  for (const auto &[name, latencies] : this->dataPtr->streams)
+  {
+    for (const bool fromStamp : {false, true})
+    {
+      const auto &histogram =
+          fromStamp ? latencies.fromStamp : latencies.fromReceive;
+      for (int i = 0; i <= kBucketCount; ++i)
+      {
+        if (histogram.counts[i] == 0)
+          continue;
+        WriteCsvField(stream, name);
+        stream << (fromStamp ? ",stamp," : ",receive,");
+        if (i < kBucketCount)
+          stream << Histogram::Upper(i);
+        else
+          stream << "inf";
+        stream << ',' << histogram.counts[i] << '\n';
+      }
+    }
+  }
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+std::string LatencyTrace::ChromeTrace() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  std::ostringstream stream;
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first{true};
+
+  // Name the tracks after their streams
+  for (const auto &[name, latencies] : this->dataPtr->streams)
+  {
+    if (!first)
+      stream << ',';
+    first = false;
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << latencies.track << ",\"args\":{\"name\":";
+    WriteJsonString(stream, name);
+    stream << "}}";
+  }
+
+  for (const auto &span : this->dataPtr->closed)
+  {
+    if (!first)
+      stream << ',';
+    first = false;
+
+    stream << "{\"name\":";
+    WriteJsonString(stream, *span.stream);
+    stream << ",\"cat\":\"latency\",\"ph\":\"X\",\"dur\":" << span.duration
+           << ",\"ts\":" << span.start << ",\"pid\":1,\"tid\":"
+           << span.track << ",\"args\":{";
+    bool firstArg{true};
+    if (span.fromStamp >= 0.0)
+    {
+      stream << "\"from_stamp_ms\":" << span.fromStamp;
+      firstArg = false;
+    }
+    for (const auto &[name, offset] : span.stages)
+    {
+      if (!firstArg)
+        stream << ',';
+      firstArg = false;
+      WriteJsonString(stream, std::string(name) + "_us");
+      stream << ':' << offset;
+    }
+    stream << "}}";
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+bool LatencyTrace::Write(const std::string &_path) const
+{
+  const auto histogramPath = _path + ".histograms.csv";
+  std::ofstream trace(_path);
+  std::ofstream histograms(histogramPath);
+  if (!trace.is_open() || !histograms.is_open())
+  {
+    gzerr << "Failed to write latency trace [" << _path << "]"
+          << std::endl;
+    return false;
+  }
+  trace << this->ChromeTrace() << '\n';
+  histograms << this->Histograms();
+  return trace.good() && histograms.good();
+}
+}  // namespace gz::gui
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/LatencyTrace.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(LatencyTraceTest, Disabled)
+{
+  LatencyTrace trace;
+  EXPECT_FALSE(trace.Enabled());
+
+  auto tag = trace.Begin("poses", 0.0);
+  EXPECT_FALSE(tag.Valid());
+  trace.Hold(tag, "scene");
+  trace.Rendered("scene");
+  trace.Ready("scene");
+  trace.FrameSwapped();
+  EXPECT_EQ(0u, trace.OpenCount());
+  EXPECT_EQ(0u, trace.Latencies("poses").count);
+  EXPECT_EQ("stream,from,upper_ms,count\n", trace.Histograms());
+  EXPECT_EQ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}",
+      trace.ChromeTrace());
+}
+
+/////////////////////////////////////////////////
+TEST(LatencyTraceTest, Spans)
+{
+  LatencyTrace trace;
+  trace.SetEnabled(true);
+  EXPECT_TRUE(trace.Enabled());
+
+  const double wallNow = std::chrono::duration<double>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+  auto pose = trace.Begin("poses", wallNow - 0.5);
+  auto image = trace.Begin("image \"camera\"", 0.0);
+  auto dropped = trace.Begin("poses", 0.0);
+  ASSERT_TRUE(pose.Valid());
+  ASSERT_TRUE(image.Valid());
+  EXPECT_NE(pose.id, image.id);
+  EXPECT_EQ(3u, trace.OpenCount());
+
+  trace.Drop(dropped);
+  trace.Stage(image, "converted");
+  trace.Hold(pose, "scene");
+  trace.Hold(image, "window");
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+  // Spans close only once their channel's frame was rendered, taken by the
+  // window, and swapped
+  trace.Ready("scene");
+  trace.FrameSwapped();
+  EXPECT_EQ(2u, trace.OpenCount());
+  trace.Rendered("scene");
+  trace.FrameSwapped();
+  EXPECT_EQ(2u, trace.OpenCount());
+  trace.Ready("scene");
+  trace.FrameSwapped();
+  EXPECT_EQ(1u, trace.OpenCount());
+
+  // A span held after its channel rendered waits for the next frame
+  auto late = trace.Begin("poses", 0.0);
+  trace.Rendered("window");
+  trace.Hold(late, "scene");
+  trace.Ready("window");
+  trace.Ready("scene");
+  trace.FrameSwapped();
+  EXPECT_EQ(1u, trace.OpenCount());
+  trace.Drop(late);
+  EXPECT_EQ(0u, trace.OpenCount());
+
+  auto poses = trace.Latencies("poses");
+  EXPECT_EQ(1u, poses.count);
+  EXPECT_GE(poses.max, 2.0);
+  EXPECT_LE(poses.p50, poses.max);
+  EXPECT_DOUBLE_EQ(poses.max, poses.mean);
+
+  auto stamped = trace.Latencies("poses", true);
+  EXPECT_EQ(1u, stamped.count);
+  EXPECT_GE(stamped.max, 500.0);
+  EXPECT_EQ(0u, trace.Latencies("image \"camera\"", true).count);
+  EXPECT_EQ(1u, trace.Latencies("image \"camera\"").count);
+
+  const auto csv = trace.Histograms();
+  EXPECT_EQ(0u, csv.find("stream,from,upper_ms,count\n"));
+  EXPECT_NE(std::string::npos, csv.find("\nposes,receive,"));
+  EXPECT_NE(std::string::npos, csv.find("\nposes,stamp,"));
+  EXPECT_NE(std::string::npos, csv.find("\n\"image \"\"camera\"\"\","));
+
+  const auto json = trace.ChromeTrace();
+  EXPECT_NE(std::string::npos, json.find(
+      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+      "\"args\":{\"name\":\"poses\"}}"));
+  EXPECT_NE(std::string::npos, json.find(
+      "{\"name\":\"image \\\"camera\\\"\",\"cat\":\"latency\","
+      "\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"from_stamp_ms\":"));
+  EXPECT_NE(std::string::npos, json.find("\"converted_us\":"));
+  EXPECT_NE(std::string::npos, json.find("\"applied_us\":"));
+  EXPECT_NE(std::string::npos, json.find("\"ready_us\":"));
+
+  const auto path = (std::filesystem::temp_directory_path() /
+      "gz_gui_latency_trace_test.json").string();
+  ASSERT_TRUE(trace.Write(path));
+  std::ifstream stream(path);
+  std::stringstream contents;
+  contents << stream.rdbuf();
+  EXPECT_EQ(json + "\n", contents.str());
+  std::ifstream histogramStream(path + ".histograms.csv");
+  std::stringstream histogramContents;
+  histogramContents << histogramStream.rdbuf();
+  EXPECT_EQ(csv, histogramContents.str());
+  std::filesystem::remove(path);
+  std::filesystem::remove(path + ".histograms.csv");
+
+  EXPECT_FALSE(trace.Write("/nonexistent/dir/trace.json"));
+}
+
+/////////////////////////////////////////////////
+TEST(LatencyTraceTest, Percentiles)
+{
+  LatencyTrace trace;
+  trace.SetEnabled(true);
+
+  // Spans closed right away land in the lowest buckets
+  for (int i = 0; i < 100; ++i)
+  {
+    auto tag = trace.Begin("fast", 0.0);
+    trace.Hold(tag, "window");
+    trace.Rendered("window");
+    trace.Ready("window");
+    trace.FrameSwapped();
+  }
+  auto fast = trace.Latencies("fast");
+  EXPECT_EQ(100u, fast.count);
+  EXPECT_LE(fast.p50, fast.p90);
+  EXPECT_LE(fast.p90, fast.p99);
+  EXPECT_LE(fast.p99, fast.max);
+  EXPECT_LT(fast.p50, 5.0);
+}
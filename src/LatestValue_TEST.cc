@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "gz/gui/LatestValue.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(LatestValueTest, SetTake)
+{
+  LatestValue<std::string> latest;
+  EXPECT_FALSE(latest.HasValue());
+
+  std::string value{"untouched"};
+  EXPECT_FALSE(latest.Take(value));
+  EXPECT_EQ("untouched", value);
+
+  // Only the first value since last taken asks for a wake up, and the last
+  // one wins
+  EXPECT_TRUE(latest.Set("a"));
+  EXPECT_FALSE(latest.Set("b"));
+  EXPECT_FALSE(latest.Set("c"));
+  EXPECT_TRUE(latest.HasValue());
+
+  EXPECT_TRUE(latest.Take(value));
+  EXPECT_EQ("c", value);
+  EXPECT_FALSE(latest.HasValue());
+  EXPECT_FALSE(latest.Take(value));
+  EXPECT_EQ("c", value);
+
+  EXPECT_TRUE(latest.Set("d"));
+  EXPECT_TRUE(latest.Take(value));
+  EXPECT_EQ("d", value);
+}
+
+/////////////////////////////////////////////////
+TEST(LatestValueTest, Threads)
+{
+  LatestValue<int> latest;
+
+  const int count{10000};
+  int wakes{0};
+  std::thread producer([&]()
+  {
+    for (int i = 1; i <= count; ++i)
+    {
+      if (latest.Set(i))
+        ++wakes;
+    }
+  });
+
+  // Values only move forward, and the last one is always seen
+  int value{0};
+  int previous{0};
+  bool forward{true};
+  while (value < count)
+  {
+    if (latest.Take(value))
+    {
+      forward = forward && value > previous;
+      previous = value;
+    }
+  }
+  producer.join();
+
+  EXPECT_TRUE(forward);
+  EXPECT_EQ(count, value);
+  EXPECT_GE(wakes, 1);
+  EXPECT_LE(wakes, count);
+  EXPECT_FALSE(latest.HasValue());
+}
@@ -17,14 +17,25 @@
 
 #include <tinyxml2.h>
 #include <gz/utils/ImplPtr.hh>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <regex>
 #include <string>
+#include <thread>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include "gz/gui/Application.hh"
+#include "gz/gui/EventBus.hh"
+#include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/PerformanceCounters.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/StallWatchdog.hh"
 #include "gz/gui/qt.h"
 #include "gz/msgs/boolean.pb.h"
 #include "gz/msgs/server_control.pb.h"
@@ -39,6 +50,159 @@ std::string dirName(const std::string &_path)
   std::size_t found = _path.find_last_of("/\\");
   return _path.substr(0, found);
 }
+
+/////////////////////////////////////////////////
+/// \brief Write a file next to its destination, then move it over the
+/// destination, so it's never left partially written
+/// \param[in] _path Destination path
+/// \param[in] _contents File contents
+/// \return True if written
+bool writeFile(const std::string &_path, const std::string &_contents)
+{
+  // Create the intermediate directories if needed.
+  // We check for errors when we try to open the file.
+  gz::common::createDirectories(dirName(_path));
+
+  const std::string tmpPath = _path + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::out);
+    if (!out)
+      return false;
+    out << _contents;
+    if (!out.good())
+      return false;
+  }
+
+  std::error_code error;
+  std::filesystem::rename(tmpPath, _path, error);
+  if (error)
+  {
+    std::filesystem::remove(tmpPath, error);
+    return false;
+  }
+  return true;
+}
+
+/// \brief Event filter being measured on the current thread
+struct FilterTiming
+{
+  /// \brief Event being filtered
+  const QEvent *event{nullptr};
+
+  /// \brief Counter of the filter, null if none is being measured
+  gz::gui::PerformanceCounter *counter{nullptr};
+
+  /// \brief When the filter received the event
+  std::chrono::steady_clock::time_point start;
+};
+
+/// \brief Render events may be sent from render threads while the GUI
+/// thread sends other events, so each thread measures its own filters
+thread_local FilterTiming tFilterTiming;
+
+/////////////////////////////////////////////////
+/// \brief Check whether the time filters spend on an event is measured
+/// \param[in] _event Event
+/// \return True for render events
+bool isMeasured(const QEvent *_event)
+{
+  return _event->type() == gz::gui::events::Render::kType ||
+      _event->type() == gz::gui::events::PreRender::kType;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the time since the previous filter received an event to its
+/// counter
+/// \param[in] _event Event, the time is dropped if it's another event
+/// \param[in] _now Current time
+void endFilterTiming(const QEvent *_event,
+    const std::chrono::steady_clock::time_point &_now)
+{
+  auto &timing = tFilterTiming;
+  if (nullptr != timing.counter && timing.event == _event)
+    timing.counter->AddTime(_now - timing.start);
+  timing.counter = nullptr;
+  timing.event = nullptr;
+}
+
+/// \brief Installed in front of each event filter of the main window, so
+/// it receives events right before that filter. It ends the measurement of
+/// the previous filter and starts the one of its own filter.
+class FilterTimer : public QObject
+{
+  /// \brief Constructor
+  /// \param[in] _filter Filter measured, which becomes the parent
+  public: explicit FilterTimer(QObject *_filter)
+    : QObject(_filter),
+      owner(gz::gui::PerformanceCounters::OwnerName(
+          _filter->metaObject()->className())),
+      render(owner, "render event"),
+      preRender(owner, "pre-render event")
+  {
+  }
+
+  // Documentation inherited
+  public: bool eventFilter(QObject *, QEvent *_event) override
+  {
+    if (!isMeasured(_event))
+      return false;
+
+    auto *counter = _event->type() == gz::gui::events::Render::kType ?
+        &this->render : &this->preRender;
+    gz::gui::StallWatchdog::SetHandler(counter->Name());
+    if (!gz::gui::PerformanceCounters::Enabled())
+      return false;
+
+    const auto now = std::chrono::steady_clock::now();
+    endFilterTiming(_event, now);
+    tFilterTiming.event = _event;
+    tFilterTiming.counter = counter;
+    tFilterTiming.start = now;
+    return false;
+  }
+
+  /// \brief Class name of the filter, without namespaces
+  private: std::string owner;
+
+  /// \brief Time spent on events::Render
+  private: gz::gui::PerformanceCounter render;
+
+  /// \brief Time spent on events::PreRender
+  private: gz::gui::PerformanceCounter preRender;
+};
+
+/// \brief Installed in front of all filters of the main window, so
+/// measurements left over from an event which a filter consumed don't
+/// leak into the next one
+class FilterTimingReset : public QObject
+{
+  // Documentation inherited
+  public: bool eventFilter(QObject *, QEvent *_event) override
+  {
+    if (isMeasured(_event))
+    {
+      tFilterTiming = FilterTiming();
+      gz::gui::StallWatchdog::SetHandler(nullptr);
+    }
+    return false;
+  }
+};
+
+/// \brief Installed on the quick window to know when it's exposed or
+/// obscured, which QWindow has no signal for
+class ExposeWatcher : public QObject
+{
+  // Documentation inherited
+  public: bool eventFilter(QObject *, QEvent *_event) override
+  {
+    if (_event->type() == QEvent::Expose && this->cb)
+      this->cb();
+    return false;
+  }
+
+  /// \brief Called on each expose event
+  public: std::function<void()> cb;
+};
 }  // namespace
 
 namespace gz::gui
@@ -47,6 +211,9 @@ class MainWindow::Implementation
 {
   public: int pluginCount{0};
 
+  /// \brief Fraction of the config's plugins loaded
+  public: double loadProgress{1.0};
+
   /// \brief Pointer to quick window
   public: QQuickWindow *quickWindow{nullptr};
 
@@ -86,6 +253,48 @@ class MainWindow::Implementation
 
   /// \brief Communication node
   public: gz::transport::Node node {gz::transport::NodeOptions()};
+
+  /// \brief Saves the configuration periodically, see
+  /// WindowConfig::autosaveInterval
+  public: QTimer autosaveTimer;
+
+  /// \brief Thread writing the configs saved in the background
+  public: std::thread saveThread;
+
+  /// \brief Protects `pendingSaves` and `saving`
+  public: std::mutex saveMutex;
+
+  /// \brief Serializes writes, so foreground and background saves to the
+  /// same path don't share the temporary file
+  public: std::mutex writeMutex;
+
+  /// \brief Configs waiting to be written in the background, by path. Only
+  /// the latest config of each path is written.
+  public: std::map<std::string, std::string> pendingSaves;
+
+  /// \brief True while the save thread is running
+  public: bool saving{false};
+
+  /// \brief Objects measuring each event filter installed through
+  /// MainWindow::installEventFilter, keyed by filter. Each one is a child
+  /// of its filter, so it's destroyed along with it.
+  public: std::map<QObject *, QPointer<QObject>> filterTimers;
+
+  /// \brief Kept in front of all filters
+  public: FilterTimingReset filterTimingReset;
+
+  /// \brief Plugin names returned by PluginListModel, kept until the
+  /// plugin list or the config changes
+  public: QStringList pluginListModel;
+
+  /// \brief Whether `pluginListModel` is up to date
+  public: bool pluginListValid{false};
+
+  /// \brief Whether the window can be seen, see MainWindow::Exposed
+  public: bool exposed{false};
+
+  /// \brief Follows the window's expose events
+  public: ExposeWatcher exposeWatcher;
 };
 
 /////////////////////////////////////////////////
@@ -97,15 +306,37 @@ MainWindow::MainWindow()
   qmlRegisterUncreatableMetaObject(gui::staticMetaObject,
     "ExitAction", 1, 0, "ExitAction", "Error: namespace enum");
 
-  // Make MainWindow functions available from all QML files (using root)
-  App()->Engine()->rootContext()->setContextProperty("MainWindow", this);
-
-  // Load QML and keep pointer to generated QQuickWindow
   std::string qmlFile("qrc:qml/Main.qml");
-  App()->Engine()->load(QUrl(QString::fromStdString(qmlFile)));
+  auto *rootContext = App()->Engine()->rootContext();
+  if (!rootContext->contextProperty("MainWindow").isValid())
+  {
+    // Make MainWindow functions available from all QML files (using root)
+    rootContext->setContextProperty("MainWindow", this);
+
+    // Load QML and keep pointer to generated QQuickWindow
+    App()->Engine()->load(QUrl(QString::fromStdString(qmlFile)));
+    this->dataPtr->quickWindow = qobject_cast<QQuickWindow *>(
+        App()->Engine()->rootObjects().value(0));
+  }
+  else
+  {
+    // Additional windows resolve MainWindow to themselves within their own
+    // context. Like the first window, they're owned by the engine.
+    auto *context = new QQmlContext(rootContext, App()->Engine());
+    context->setContextProperty("MainWindow", this);
+    QQmlComponent component(App()->Engine(),
+        QUrl(QString::fromStdString(qmlFile)));
+    auto *object = component.create(context);
+    this->dataPtr->quickWindow = qobject_cast<QQuickWindow *>(object);
+    if (nullptr != object)
+      object->setParent(App()->Engine());
+    if (!this->dataPtr->quickWindow)
+    {
+      gzerr << component.errorString().toStdString();
+      delete object;
+    }
+  }
 
-  this->dataPtr->quickWindow = qobject_cast<QQuickWindow *>(
-      App()->Engine()->rootObjects().value(0));
   if (!this->dataPtr->quickWindow)
   {
     gzerr << "Internal error: Failed to instantiate QML file [" << qmlFile
@@ -114,14 +345,97 @@ MainWindow::MainWindow()
   }
 
   App()->setWindowIcon(QIcon(":/qml/images/gazebo_logo.png"));
+
+  // Expose events come when the window is covered or uncovered, or moved
+  // to another virtual desktop, where the platform reports it
+  auto updateExposed = [this]()
+  {
+    auto *window = this->dataPtr->quickWindow;
+    const bool exposed = window->isVisible() &&
+        window->visibility() != QWindow::Minimized && window->isExposed();
+    if (exposed == this->dataPtr->exposed)
+      return;
+    this->dataPtr->exposed = exposed;
+    emit this->ExposedChanged();
+  };
+  this->dataPtr->exposeWatcher.cb = updateExposed;
+  this->dataPtr->quickWindow->installEventFilter(
+      &this->dataPtr->exposeWatcher);
+  connect(this->dataPtr->quickWindow, &QWindow::visibilityChanged, this,
+      updateExposed);
+
+  connect(&this->dataPtr->autosaveTimer, &QTimer::timeout, this, [this]()
+  {
+    this->SaveConfigInBackground(App()->DefaultConfigPath());
+  });
+
+  // Plugin directories are only listed again once they change
+  connect(App(), &Application::PluginListChanged, this, [this]()
+  {
+    this->dataPtr->pluginListValid = false;
+    emit this->PluginListModelChanged();
+  });
+}
+
+/////////////////////////////////////////////////
+MainWindow::~MainWindow()
+{
+  // Pending saves are still written
+  if (this->dataPtr->saveThread.joinable())
+    this->dataPtr->saveThread.join();
+}
+
+/////////////////////////////////////////////////
+void MainWindow::installEventFilter(QObject *_filter)
+{
+  if (nullptr == _filter)
+    return;
+
+  // Installing a filter again moves it to the front, which is where the
+  // filters run from
+  auto &timer = this->dataPtr->filterTimers[_filter];
+  if (timer.isNull())
+    timer = new FilterTimer(_filter);
+  QObject::installEventFilter(_filter);
+  QObject::installEventFilter(timer);
+  QObject::installEventFilter(&this->dataPtr->filterTimingReset);
+}
+
+/////////////////////////////////////////////////
+void MainWindow::removeEventFilter(QObject *_filter)
+{
+  QObject::removeEventFilter(_filter);
+
+  auto it = this->dataPtr->filterTimers.find(_filter);
+  if (it == this->dataPtr->filterTimers.end())
+    return;
+  if (!it->second.isNull())
+  {
+    QObject::removeEventFilter(it->second);
+    it->second->deleteLater();
+  }
+  this->dataPtr->filterTimers.erase(it);
 }
 
 /////////////////////////////////////////////////
-MainWindow::~MainWindow() = default;
+bool MainWindow::event(QEvent *_event)
+{
+  // Ends the measurement of the last filter
+  if (isMeasured(_event))
+    endFilterTiming(_event, std::chrono::steady_clock::now());
+
+  if (_event->type() >= QEvent::User)
+    EventBus::Publish(*_event);
+
+  return QObject::event(_event);
+}
 
 /////////////////////////////////////////////////
 QStringList MainWindow::PluginListModel() const
 {
+  if (this->dataPtr->pluginListValid)
+    return this->dataPtr->pluginListModel;
+
   QStringList pluginNames;
   auto plugins = App()->PluginList();
   for (auto const &path : plugins)
@@ -137,7 +451,7 @@ QStringList MainWindow::PluginListModel() const
         strlen(SHARED_LIBRARY_SUFFIX));
 
       // Split WWWCamelCase3D -> WWW Camel Case 3D
-      std::regex reg("(\\B[A-Z][a-z])|(\\B[0-9])");
+      static const std::regex reg("(\\B[A-Z][a-z])|(\\B[0-9])");
       pluginName = std::regex_replace(pluginName, reg, " $&");
 
       // Show?
@@ -163,6 +477,8 @@ QStringList MainWindow::PluginListModel() const
   }
 
   pluginNames.sort();
+  this->dataPtr->pluginListModel = pluginNames;
+  this->dataPtr->pluginListValid = true;
   return pluginNames;
 }
 
@@ -235,21 +551,18 @@ void MainWindow::SaveConfig(const std::string &_path)
 {
   this->dataPtr->windowConfig = this->CurrentWindowConfig();
 
-  // Create the intermediate directories if needed.
-  // We check for errors when we try to open the file.
-  auto dirname = dirName(_path);
-  common::createDirectories(dirname);
-
-  // Open the file
-  std::ofstream out(_path.c_str(), std::ios::out);
-  if (!out)
+  bool written{false};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+    written = writeFile(_path, this->dataPtr->windowConfig.XMLString());
+  }
+  if (!written)
   {
     std::string str = "Unable to open file: " + _path;
     str += ".\nCheck file permissions.";
     emit this->notify(QString::fromStdString(str));
+    return;
   }
-  else
-    out << this->dataPtr->windowConfig.XMLString();
 
   std::string msg("Saved configuration to <b>" + _path + "</b>");
 
@@ -257,6 +570,52 @@ void MainWindow::SaveConfig(const std::string &_path)
   gzmsg << msg << std::endl;
 }
 
+/////////////////////////////////////////////////
+void MainWindow::SaveConfigInBackground(const std::string &_path)
+{
+  // Reading the window and cards must happen on this thread. Only cards
+  // which changed since the last save are serialized again.
+  this->dataPtr->windowConfig = this->CurrentWindowConfig();
+  auto config = this->dataPtr->windowConfig.XMLString();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->saveMutex);
+  this->dataPtr->pendingSaves[_path] = std::move(config);
+  if (this->dataPtr->saving)
+    return;
+
+  if (this->dataPtr->saveThread.joinable())
+    this->dataPtr->saveThread.join();
+
+  this->dataPtr->saving = true;
+  this->dataPtr->saveThread = std::thread([this]()
+  {
+    while (true)
+    {
+      std::string path;
+      std::string contents;
+      {
+        std::lock_guard<std::mutex> threadLock(this->dataPtr->saveMutex);
+        if (this->dataPtr->pendingSaves.empty())
+        {
+          this->dataPtr->saving = false;
+          return;
+        }
+        auto next = this->dataPtr->pendingSaves.begin();
+        path = next->first;
+        contents = std::move(next->second);
+        this->dataPtr->pendingSaves.erase(next);
+      }
+
+      std::lock_guard<std::mutex> writeLock(this->dataPtr->writeMutex);
+      if (writeFile(path, contents))
+        gzdbg << "Saved configuration to [" << path << "]" << std::endl;
+      else
+        gzerr << "Failed to save configuration to [" << path << "]"
+              << std::endl;
+    }
+  });
+}
+
 /////////////////////////////////////////////////
 void MainWindow::OnAddPlugin(QString _plugin)
 {
@@ -331,8 +690,20 @@ bool MainWindow::ApplyConfig(const WindowConfig &_config)
   this->SetShowDefaultDrawerOpts(_config.showDefaultDrawerOpts);
   this->SetShowPluginMenu(_config.showPluginMenu);
 
+  // Autosave
+  if (_config.autosaveInterval > 0.0)
+  {
+    this->dataPtr->autosaveTimer.start(
+        static_cast<int>(_config.autosaveInterval * 1000));
+  }
+  else
+  {
+    this->dataPtr->autosaveTimer.stop();
+  }
+
   // Keep a copy
   this->dataPtr->windowConfig = _config;
+  this->dataPtr->pluginListValid = false;
 
   // Notify view
   emit this->configChanged();
@@ -382,6 +753,7 @@ WindowConfig MainWindow::CurrentWindowConfig() const
   config.showDefaultDrawerOpts =
       this->dataPtr->windowConfig.showDefaultDrawerOpts;
   config.showPluginMenu = this->dataPtr->windowConfig.showPluginMenu;
+  config.autosaveInterval = this->dataPtr->windowConfig.autosaveInterval;
   config.pluginsFromPaths = this->dataPtr->windowConfig.pluginsFromPaths;
   config.showPlugins = this->dataPtr->windowConfig.showPlugins;
   config.ignoredProps = this->dataPtr->windowConfig.ignoredProps;
@@ -419,6 +791,10 @@ bool WindowConfig::MergeFromXML(const std::string &_windowXml)
   if (auto heightElem = winElem->FirstChildElement("height"))
     heightElem->QueryIntText(&this->height);
 
+  // Autosave
+  if (auto autosaveElem = winElem->FirstChildElement("autosave_interval"))
+    autosaveElem->QueryDoubleText(&this->autosaveInterval);
+
   // Docks state
   if (auto stateElem = winElem->FirstChildElement("state"))
   {
@@ -601,6 +977,14 @@ std::string WindowConfig::XMLString() const
     windowElem->InsertEndChild(elem);
   }
 
+  // Autosave
+  if (this->autosaveInterval > 0.0)
+  {
+    auto elem = doc.NewElement("autosave_interval");
+    elem->SetText(this->autosaveInterval);
+    windowElem->InsertEndChild(elem);
+  }
+
   // Style
   if (!this->IsIgnoring("style"))
   {
@@ -709,6 +1093,27 @@ void MainWindow::SetPluginCount(const int _pluginCount)
   emit this->PluginCountChanged();
 }
 
+/////////////////////////////////////////////////
+double MainWindow::LoadProgress() const
+{
+  return this->dataPtr->loadProgress;
+}
+
+/////////////////////////////////////////////////
+void MainWindow::SetLoadProgress(double _progress)
+{
+  if (_progress == this->dataPtr->loadProgress)
+    return;
+  this->dataPtr->loadProgress = _progress;
+  emit this->LoadProgressChanged();
+}
+
+/////////////////////////////////////////////////
+bool MainWindow::Exposed() const
+{
+  return this->dataPtr->exposed;
+}
+
 /////////////////////////////////////////////////
 QString MainWindow::MaterialTheme() const
 {
@@ -29,7 +29,9 @@
 
 #include "test_config.hh"  // NOLINT(build/include)
 #include "gz/gui/Application.hh"
+#include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/PerformanceCounters.hh"
 #include "gz/gui/Plugin.hh"
 
 std::string kTestConfigFile = "/tmp/gz-gui-test.config"; // NOLINT(*)
@@ -130,6 +132,37 @@ TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SaveConfigAs))
   mainWindow->deleteLater();
 }
 
+/////////////////////////////////////////////////
+TEST(MainWindowTest,
+    GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SaveConfigInBackground))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  {
+    MainWindow mainWindow;
+
+    // Only the last config of a path is needed
+    mainWindow.SaveConfigInBackground(kTestConfigFile);
+    mainWindow.SaveConfigInBackground(kTestConfigFile);
+
+    // Pending saves are written before the window is destroyed
+  }
+
+  QFile saved(QString::fromStdString(kTestConfigFile));
+  ASSERT_TRUE(saved.open(QFile::ReadOnly));
+
+  QString savedStr = QLatin1String(saved.readAll());
+  EXPECT_TRUE(savedStr.contains("<window>"));
+  EXPECT_TRUE(savedStr.contains("</window>"));
+
+  // The temporary file was moved over it
+  EXPECT_FALSE(QFile::exists(QString::fromStdString(kTestConfigFile +
+      ".tmp")));
+
+  std::remove(kTestConfigFile.c_str());
+}
+
 /////////////////////////////////////////////////
 TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnLoadConfig))
 {
@@ -256,6 +289,7 @@ TEST(WindowConfigTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(mergeFromXML))
   // Merge from XML
   c.MergeFromXML(std::string("<window><position_x>5000</position_x>")+
     "<menus><plugins from_paths=\"false\"/></menus>" +
+    "<autosave_interval>30</autosave_interval>" +
     "<ignore>size</ignore></window>");
 
   // Check values
@@ -272,9 +306,14 @@ TEST(WindowConfigTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(mergeFromXML))
   EXPECT_TRUE(c.showPluginMenu);
   EXPECT_FALSE(c.pluginsFromPaths);
   EXPECT_TRUE(c.showPlugins.empty());
+  EXPECT_DOUBLE_EQ(30.0, c.autosaveInterval);
   EXPECT_EQ(c.ignoredProps.size(), 2u);
   EXPECT_TRUE(c.IsIgnoring("state"));
   EXPECT_TRUE(c.IsIgnoring("size"));
+
+  // It's saved back
+  EXPECT_NE(std::string::npos,
+      c.XMLString().find("<autosave_interval>30</autosave_interval>"));
 }
 
 /////////////////////////////////////////////////
@@ -779,3 +818,61 @@ TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ApplyConfig))
 
   mainWindow->deleteLater();
 }
+
+/////////////////////////////////////////////////
+/// \brief Event filter taking a while to handle render events
+class SlowFilter : public QObject
+{
+  public: bool eventFilter(QObject *, QEvent *_event) override
+  {
+    if (_event->type() == events::Render::kType)
+      std::this_thread::sleep_for(2ms);
+    return false;
+  }
+};
+
+/////////////////////////////////////////////////
+TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(FilterTiming))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto *mainWindow = new MainWindow;
+  ASSERT_NE(nullptr, mainWindow);
+
+  SlowFilter slow;
+  QObject fast;
+  mainWindow->installEventFilter(&slow);
+  mainWindow->installEventFilter(&fast);
+
+  // Not measured while disabled
+  events::Render render;
+  PerformanceCounters::TakeSamples();
+  app.sendEvent(mainWindow, &render);
+  EXPECT_TRUE(PerformanceCounters::TakeSamples().empty());
+
+  PerformanceCounters::SetEnabled(true);
+  app.sendEvent(mainWindow, &render);
+  app.sendEvent(mainWindow, &render);
+  PerformanceCounters::SetEnabled(false);
+
+  // Both filters are plain QObjects as far as the meta object knows, so
+  // they share an owner name
+  auto samples = PerformanceCounters::TakeSamples();
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ("QObject", samples[0].owner);
+  EXPECT_EQ("render event", samples[0].source);
+  EXPECT_EQ(4u, samples[0].calls);
+  EXPECT_GE(samples[0].total, std::chrono::steady_clock::duration(4ms));
+  EXPECT_GE(samples[0].max, std::chrono::steady_clock::duration(2ms));
+
+  // Removed filters aren't measured
+  mainWindow->removeEventFilter(&slow);
+  mainWindow->removeEventFilter(&fast);
+  PerformanceCounters::SetEnabled(true);
+  app.sendEvent(mainWindow, &render);
+  PerformanceCounters::SetEnabled(false);
+  EXPECT_TRUE(PerformanceCounters::TakeSamples().empty());
+
+  mainWindow->deleteLater();
+}
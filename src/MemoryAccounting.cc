@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/gui/MemoryAccounting.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Bytes reported by one account
+struct Entry
+{
+  /// \brief Owner, such as "TopicEcho"
+  std::string owner;
+
+  /// \brief Category, such as "msgs"
+  std::string category;
+
+  /// \brief Where the memory lives
+  MemoryType type{MemoryType::CPU};
+
+  /// \brief Bytes held, updated without locking
+  std::atomic<std::size_t> bytes{0};
+};
+
+/// \brief All live accounts and the budgets
+class Registry
+{
+  /// \brief Protects all members
+  public: std::mutex mutex;
+
+  /// \brief Entries of the live accounts
+  public: std::vector<std::shared_ptr<Entry>> entries;
+
+  /// \brief Budget of each owner in bytes
+  public: std::unordered_map<std::string, std::size_t> budgets;
+};
+
+/////////////////////////////////////////////////
+std::shared_ptr<Registry> &registry()
+{
+  static auto instance = std::make_shared<Registry>();
+  return instance;
+}
+}  // namespace
+
+/// \brief Private data for MemoryAccount
+class MemoryAccount::Implementation
+{
+  /// \brief Registry the entry belongs to. Weak so that accounts outliving
+  /// it during static destruction don't touch it.
+  public: std::weak_ptr<Registry> registry;
+
+  /// \brief Entry of this account
+  public: std::shared_ptr<Entry> entry;
+};
+
+/////////////////////////////////////////////////
+MemoryAccount::MemoryAccount(const std::string &_owner,
+    const std::string &_category, MemoryType _type)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->entry = std::make_shared<Entry>();
+  this->dataPtr->entry->owner = _owner;
+  this->dataPtr->entry->category = _category;
+  this->dataPtr->entry->type = _type;
+
+  auto reg = registry();
+  this->dataPtr->registry = reg;
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  reg->entries.push_back(this->dataPtr->entry);
+}
+
+/////////////////////////////////////////////////
+MemoryAccount::~MemoryAccount()
+{
+  auto reg = this->dataPtr->registry.lock();
+  if (nullptr == reg)
+    return;
+
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  reg->entries.erase(std::remove(reg->entries.begin(), reg->entries.end(),
+      this->dataPtr->entry), reg->entries.end());
+}
+
+/////////////////////////////////////////////////
+void MemoryAccount::Set(std::size_t _bytes)
+{
+  this->dataPtr->entry->bytes.store(_bytes, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void MemoryAccount::Add(std::size_t _bytes)
+{
+  this->dataPtr->entry->bytes.fetch_add(_bytes, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void MemoryAccount::Remove(std::size_t _bytes)
+{
+  auto &bytes = this->dataPtr->entry->bytes;
+  auto current = bytes.load(std::memory_order_relaxed);
+  while (!bytes.compare_exchange_weak(current,
+      current > _bytes ? current - _bytes : 0, std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t MemoryAccount::Bytes() const
+{
+  return this->dataPtr->entry->bytes.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+std::vector<MemoryAccounting::Usage> MemoryAccounting::Snapshot()
+{
+  using Key = std::tuple<std::string, std::string, MemoryType>;
+  std::map<Key, Usage> usages;
+  {
+    auto reg = registry();
+    std::lock_guard<std::mutex> lock(reg->mutex);
+    for (const auto &entry : reg->entries)
+    {
+      auto &usage = usages[{entry->owner, entry->category, entry->type}];
+      usage.bytes += entry->bytes.load(std::memory_order_relaxed);
+      usage.accounts++;
+    }
+  }
+
+  std::vector<Usage> result;
+  result.reserve(usages.size());
+  for (auto &[key, usage] : usages)
+  {
+    std::tie(usage.owner, usage.category, usage.type) = key;
+    result.push_back(std::move(usage));
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::size_t MemoryAccounting::OwnerBytes(const std::string &_owner)
+{
+  std::size_t bytes{0};
+  auto reg = registry();
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  for (const auto &entry : reg->entries)
+  {
+    if (entry->owner == _owner)
+      bytes += entry->bytes.load(std::memory_order_relaxed);
+  }
+  return bytes;
+}
+
+/////////////////////////////////////////////////
+std::size_t MemoryAccounting::TotalBytes(MemoryType _type)
+{
+  std::size_t bytes{0};
+  auto reg = registry();
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  for (const auto &entry : reg->entries)
+  {
+    if (entry->type == _type)
+      bytes += entry->bytes.load(std::memory_order_relaxed);
+  }
+  return bytes;
+}
+
+/////////////////////////////////////////////////
+void MemoryAccounting::SetBudget(const std::string &_owner,
+    std::size_t _bytes)
+{
+  auto reg = registry();
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  if (_bytes == 0)
+    reg->budgets.erase(_owner);
+  else
+    reg->budgets[_owner] = _bytes;
+}
+
+/////////////////////////////////////////////////
+std::size_t MemoryAccounting::Budget(const std::string &_owner)
+{
+  auto reg = registry();
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  auto it = reg->budgets.find(_owner);
+  return it == reg->budgets.end() ? 0u : it->second;
+}
+
+/////////////////////////////////////////////////
+bool MemoryAccounting::OverBudget(const std::string &_owner)
+{
+  const auto budget = Budget(_owner);
+  return budget > 0 && OwnerBytes(_owner) > budget;
+}
+
+/////////////////////////////////////////////////
+std::string MemoryAccounting::FormatBytes(std::size_t _bytes)
+{
+  static const char *kUnits[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  double value = static_cast<double>(_bytes);
+  std::size_t unit{0};
+  while (value >= 1024.0 && unit + 1 < std::size(kUnits))
+  {
+    value /= 1024.0;
+    ++unit;
+  }
+
+  std::ostringstream stream;
+  if (unit == 0)
+    stream << _bytes << " " << kUnits[unit];
+  else
+    stream << std::fixed << std::setprecision(1) << value << " "
+           << kUnits[unit];
+  return stream.str();
+}
+}  // namespace gz::gui
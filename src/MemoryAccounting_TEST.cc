@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/MemoryAccounting.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(MemoryAccountingTest, Accounts)
+{
+  EXPECT_EQ(0u, MemoryAccounting::OwnerBytes("Test"));
+
+  auto msgs = std::make_unique<MemoryAccount>("Test", "msgs");
+  MemoryAccount moreMsgs("Test", "msgs");
+  MemoryAccount textures("Test", "textures", MemoryType::GPU);
+  MemoryAccount other("Other", "msgs");
+
+  msgs->Set(100);
+  moreMsgs.Add(50);
+  moreMsgs.Add(25);
+  moreMsgs.Remove(5);
+  textures.Set(1000);
+  other.Set(7);
+
+  EXPECT_EQ(100u, msgs->Bytes());
+  EXPECT_EQ(70u, moreMsgs.Bytes());
+  EXPECT_EQ(1170u, MemoryAccounting::OwnerBytes("Test"));
+  EXPECT_EQ(7u, MemoryAccounting::OwnerBytes("Other"));
+
+  // Accounts of the same owner, category and type are summed
+  auto snapshot = MemoryAccounting::Snapshot();
+  ASSERT_EQ(3u, snapshot.size());
+  EXPECT_EQ("Other", snapshot[0].owner);
+  EXPECT_EQ("Test", snapshot[1].owner);
+  EXPECT_EQ("msgs", snapshot[1].category);
+  EXPECT_EQ(MemoryType::CPU, snapshot[1].type);
+  EXPECT_EQ(170u, snapshot[1].bytes);
+  EXPECT_EQ(2u, snapshot[1].accounts);
+  EXPECT_EQ("textures", snapshot[2].category);
+  EXPECT_EQ(MemoryType::GPU, snapshot[2].type);
+  EXPECT_EQ(1000u, snapshot[2].bytes);
+
+  EXPECT_EQ(177u, MemoryAccounting::TotalBytes(MemoryType::CPU));
+  EXPECT_EQ(1000u, MemoryAccounting::TotalBytes(MemoryType::GPU));
+
+  // Removing more than held stops at zero
+  other.Remove(100);
+  EXPECT_EQ(0u, other.Bytes());
+
+  // Destroyed accounts stop counting
+  msgs.reset();
+  EXPECT_EQ(1070u, MemoryAccounting::OwnerBytes("Test"));
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryAccountingTest, Budget)
+{
+  MemoryAccount account("Budgeted", "msgs");
+  account.Set(2000);
+
+  EXPECT_EQ(0u, MemoryAccounting::Budget("Budgeted"));
+  EXPECT_FALSE(MemoryAccounting::OverBudget("Budgeted"));
+
+  MemoryAccounting::SetBudget("Budgeted", 1000);
+  EXPECT_EQ(1000u, MemoryAccounting::Budget("Budgeted"));
+  EXPECT_TRUE(MemoryAccounting::OverBudget("Budgeted"));
+
+  account.Set(500);
+  EXPECT_FALSE(MemoryAccounting::OverBudget("Budgeted"));
+
+  MemoryAccounting::SetBudget("Budgeted", 0);
+  EXPECT_EQ(0u, MemoryAccounting::Budget("Budgeted"));
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryAccountingTest, Threads)
+{
+  MemoryAccount account("Threads", "msgs");
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&account]()
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        account.Add(3);
+        account.Remove(1);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(8000u, account.Bytes());
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryAccountingTest, FormatBytes)
+{
+  EXPECT_EQ("0 B", MemoryAccounting::FormatBytes(0));
+  EXPECT_EQ("1023 B", MemoryAccounting::FormatBytes(1023));
+  EXPECT_EQ("1.5 KiB", MemoryAccounting::FormatBytes(1536));
+  EXPECT_EQ("2.0 GiB", MemoryAccounting::FormatBytes(2ull << 30));
+}
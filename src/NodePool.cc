@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/NodePool.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Publisher shared by the owners advertising the same topic
+class SharedPublisher
+{
+  /// \brief Publisher
+  public: transport::Node::Publisher publisher;
+
+  /// \brief Owners which advertised it
+  public: std::set<const void *> owners;
+};
+}  // namespace
+
+class NodePool::Implementation
+{
+  /// \brief Get the node of a namespace, creating it if needed. Must hold
+  /// `mutex`.
+  /// \param[in] _namespace Namespace
+  /// \return Node
+  public: transport::Node &NodeOf(const std::string &_namespace);
+
+  /// \brief Get the namespace of an owner. Must hold `mutex`.
+  /// \param[in] _owner Owner
+  /// \return Namespace
+  public: std::string NamespaceOf(const void *_owner) const;
+
+  /// \brief Protects all members
+  public: mutable std::mutex mutex;
+
+  /// \brief Node of each namespace
+  public: std::map<std::string, std::unique_ptr<transport::Node>> nodes;
+
+  /// \brief Namespace of the owners which set one
+  public: std::unordered_map<const void *, std::string> namespaces;
+
+  /// \brief Publishers, by namespace, topic and msg type
+  public: std::map<std::tuple<std::string, std::string, std::string>,
+      SharedPublisher> publishers;
+
+  /// \brief Owner of each service, by namespace and service
+  public: std::map<std::pair<std::string, std::string>, const void *>
+      services;
+};
+
+/////////////////////////////////////////////////
+transport::Node &NodePool::Implementation::NodeOf(
+    const std::string &_namespace)
+{
+  auto &node = this->nodes[_namespace];
+  if (nullptr == node)
+  {
+    transport::NodeOptions options;
+    options.SetNameSpace(_namespace);
+    node = std::make_unique<transport::Node>(options);
+  }
+  return *node;
+}
+
+/////////////////////////////////////////////////
+std::string NodePool::Implementation::NamespaceOf(const void *_owner) const
+{
+  auto it = this->namespaces.find(_owner);
+  return it == this->namespaces.end() ? std::string() : it->second;
+}
+
+/////////////////////////////////////////////////
+NodePool::NodePool()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+NodePool::~NodePool() = default;
+
+/////////////////////////////////////////////////
+bool NodePool::SetNamespace(const void *_owner,
+    const std::string &_namespace)
+{
+  // Validated the way nodes validate it
+  if (!_namespace.empty() &&
+      !transport::NodeOptions().SetNameSpace(_namespace))
+  {
+    gzerr << "Invalid transport namespace [" << _namespace << "]"
+          << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_namespace.empty())
+    this->dataPtr->namespaces.erase(_owner);
+  else
+    this->dataPtr->namespaces[_owner] = _namespace;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string NodePool::Namespace(const void *_owner) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->NamespaceOf(_owner);
+}
+
+/////////////////////////////////////////////////
+transport::Node &NodePool::Node(const void *_owner)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->NodeOf(this->dataPtr->NamespaceOf(_owner));
+}
+
+/////////////////////////////////////////////////
+transport::Node::Publisher NodePool::Advertise(const void *_owner,
+    const std::string &_topic, const std::string &_msgType,
+    const transport::AdvertiseMessageOptions &_options)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const auto ns = this->dataPtr->NamespaceOf(_owner);
+  auto &shared = this->dataPtr->publishers[{ns, _topic, _msgType}];
+  if (!shared.publisher)
+  {
+    shared.publisher =
+        this->dataPtr->NodeOf(ns).Advertise(_topic, _msgType, _options);
+    if (!shared.publisher)
+    {
+      this->dataPtr->publishers.erase({ns, _topic, _msgType});
+      return transport::Node::Publisher();
+    }
+  }
+  shared.owners.insert(_owner);
+  return shared.publisher;
+}
+
+/////////////////////////////////////////////////
+bool NodePool::AdvertiseServiceWith(const void *_owner,
+    const std::string &_service,
+    const std::function<bool(transport::Node &)> &_advertise)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const auto ns = this->dataPtr->NamespaceOf(_owner);
+  if (!_advertise(this->dataPtr->NodeOf(ns)))
+    return false;
+  this->dataPtr->services[{ns, _service}] = _owner;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void NodePool::Release(const void *_owner)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &publishers = this->dataPtr->publishers;
+  for (auto it = publishers.begin(); it != publishers.end();)
+  {
+    if (it->second.owners.erase(_owner) > 0 && it->second.owners.empty())
+    {
+      const auto &[ns, topic, msgType] = it->first;
+      this->dataPtr->NodeOf(ns).Unadvertise(topic);
+      it = publishers.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  auto &services = this->dataPtr->services;
+  for (auto it = services.begin(); it != services.end();)
+  {
+    if (it->second == _owner)
+    {
+      this->dataPtr->NodeOf(it->first.first).UnadvertiseSrv(
+          it->first.second);
+      it = services.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  this->dataPtr->namespaces.erase(_owner);
+}
+
+/////////////////////////////////////////////////
+std::size_t NodePool::NodeCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->nodes.size();
+}
+}  // namespace gz::gui
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <gz/msgs/int32.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/NodePool.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Whether a list holds a name
+/// \param[in] _names List
+/// \param[in] _name Name
+/// \return True if found
+bool contains(const std::vector<std::string> &_names,
+    const std::string &_name)
+{
+  return std::find(_names.begin(), _names.end(), _name) != _names.end();
+}
+
+/////////////////////////////////////////////////
+TEST(NodePoolTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Namespaces))
+{
+  NodePool pool;
+  EXPECT_EQ(0u, pool.NodeCount());
+
+  const int first{0};
+  const int second{0};
+  EXPECT_TRUE(pool.Namespace(&first).empty());
+  EXPECT_EQ(&pool.Node(), &pool.Node(&first));
+  EXPECT_EQ(1u, pool.NodeCount());
+
+  EXPECT_FALSE(pool.SetNamespace(&first, "not valid"));
+  EXPECT_TRUE(pool.Namespace(&first).empty());
+
+  EXPECT_TRUE(pool.SetNamespace(&first, "/robot1"));
+  EXPECT_TRUE(pool.SetNamespace(&second, "/robot1"));
+  EXPECT_EQ("/robot1", pool.Namespace(&first));
+  EXPECT_EQ(&pool.Node(&first), &pool.Node(&second));
+  EXPECT_NE(&pool.Node(), &pool.Node(&first));
+  EXPECT_EQ("/robot1", pool.Node(&first).Options().NameSpace());
+  EXPECT_EQ(2u, pool.NodeCount());
+
+  // Released owners go back to no namespace
+  pool.Release(&second);
+  EXPECT_TRUE(pool.Namespace(&second).empty());
+  EXPECT_EQ("/robot1", pool.Namespace(&first));
+}
+
+/////////////////////////////////////////////////
+TEST(NodePoolTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Advertise))
+{
+  NodePool pool;
+  const int first{0};
+  const int second{0};
+  ASSERT_TRUE(pool.SetNamespace(&first, "/pool_advertise"));
+  ASSERT_TRUE(pool.SetNamespace(&second, "/pool_advertise"));
+
+  // Shared by both owners
+  auto pub1 = pool.Advertise<msgs::StringMsg>(&first, "status");
+  auto pub2 = pool.Advertise<msgs::StringMsg>(&second, "status");
+  ASSERT_TRUE(pub1.Valid());
+  ASSERT_TRUE(pub2.Valid());
+  const std::string topic = "/pool_advertise/status";
+  EXPECT_TRUE(contains(pool.Node(&first).AdvertisedTopics(), topic));
+
+  // Until both released it
+  pool.Release(&first);
+  EXPECT_TRUE(contains(pool.Node(&second).AdvertisedTopics(), topic));
+  pool.Release(&second);
+  EXPECT_FALSE(contains(pool.Node(&second).AdvertisedTopics(), topic));
+
+  // Services are released with their owner
+  std::function<bool(const msgs::Int32 &, msgs::Int32 &)> echo =
+      [](const msgs::Int32 &_req, msgs::Int32 &_rep)
+      {
+        _rep = _req;
+        return true;
+      };
+  EXPECT_TRUE(pool.AdvertiseService(&first, "/pool_echo", echo));
+  EXPECT_TRUE(contains(pool.Node().AdvertisedServices(), "/pool_echo"));
+  pool.Release(&second);
+  EXPECT_TRUE(contains(pool.Node().AdvertisedServices(), "/pool_echo"));
+  pool.Release(&first);
+  EXPECT_FALSE(contains(pool.Node().AdvertisedServices(), "/pool_echo"));
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/StallWatchdog.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Calls counted by one counter
+struct Entry
+{
+  /// \brief Owner, such as "TapeMeasure"
+  std::string owner;
+
+  /// \brief Kind of callback
+  std::string source;
+
+  /// \brief Calls since the last sample
+  std::atomic<std::uint64_t> calls{0};
+
+  /// \brief Total time since the last sample, in nanoseconds
+  std::atomic<std::int64_t> total{0};
+
+  /// \brief Longest call since the last sample, in nanoseconds
+  std::atomic<std::int64_t> max{0};
+
+  /// \brief Last queue depth set
+  std::atomic<std::size_t> queueDepth{0};
+
+  /// \brief Calls over their budget since the last sample
+  std::atomic<std::uint64_t> overruns{0};
+
+  /// \brief Bytes transferred since the last sample
+  std::atomic<std::uint64_t> bytes{0};
+};
+
+/// \brief All live counters
+class Registry
+{
+  /// \brief Protects `entries`
+  public: std::mutex mutex;
+
+  /// \brief Entries of the live counters
+  public: std::vector<std::shared_ptr<Entry>> entries;
+};
+
+/////////////////////////////////////////////////
+std::shared_ptr<Registry> &registry()
+{
+  static auto instance = std::make_shared<Registry>();
+  return instance;
+}
+
+/// \brief Number of monitors which enabled the counters
+std::atomic<int> gEnabledCount{0};
+}  // namespace
+
+/// \brief Private data for PerformanceCounter
+class PerformanceCounter::Implementation
+{
+  /// \brief Registry the entry belongs to. Weak so that counters outliving
+  /// it during static destruction don't touch it.
+  public: std::weak_ptr<Registry> registry;
+
+  /// \brief Entry of this counter
+  public: std::shared_ptr<Entry> entry;
+
+  /// \brief Name reported by StallWatchdog while a timer measures
+  public: const char *zone{nullptr};
+};
+
+/////////////////////////////////////////////////
+PerformanceCounter::PerformanceCounter(const std::string &_owner,
+    const std::string &_source)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->entry = std::make_shared<Entry>();
+  this->dataPtr->entry->owner = _owner;
+  this->dataPtr->entry->source = _source;
+  this->dataPtr->zone = StallWatchdog::Intern(_owner + " " + _source);
+
+  auto reg = registry();
+  this->dataPtr->registry = reg;
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  reg->entries.push_back(this->dataPtr->entry);
+}
+
+/////////////////////////////////////////////////
+PerformanceCounter::~PerformanceCounter()
+{
+  auto reg = this->dataPtr->registry.lock();
+  if (nullptr == reg)
+    return;
+
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  reg->entries.erase(std::remove(reg->entries.begin(), reg->entries.end(),
+      this->dataPtr->entry), reg->entries.end());
+}
+
+/////////////////////////////////////////////////
+void PerformanceCounter::AddTime(std::chrono::steady_clock::duration _time)
+{
+  const std::int64_t ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(_time).count();
+  auto &entry = *this->dataPtr->entry;
+  entry.calls.fetch_add(1, std::memory_order_relaxed);
+  entry.total.fetch_add(ns, std::memory_order_relaxed);
+
+  auto max = entry.max.load(std::memory_order_relaxed);
+  while (ns > max && !entry.max.compare_exchange_weak(max, ns,
+      std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+void PerformanceCounter::AddOverrun()
+{
+  this->dataPtr->entry->overruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void PerformanceCounter::SetQueueDepth(std::size_t _depth)
+{
+  this->dataPtr->entry->queueDepth.store(_depth, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void PerformanceCounter::AddBytes(std::size_t _bytes)
+{
+  this->dataPtr->entry->bytes.fetch_add(_bytes, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+const char *PerformanceCounter::Name() const
+{
+  return this->dataPtr->zone;
+}
+
+/////////////////////////////////////////////////
+PerformanceTimer::PerformanceTimer(PerformanceCounter &_counter)
+  : counter(_counter)
+{
+  StallWatchdog::PushZone(_counter.Name());
+  if (PerformanceCounters::Enabled())
+    this->start = std::chrono::steady_clock::now();
+}
+
+/////////////////////////////////////////////////
+PerformanceTimer::~PerformanceTimer()
+{
+  if (this->start)
+    this->counter.AddTime(std::chrono::steady_clock::now() - *this->start);
+  StallWatchdog::PopZone();
+}
+
+/////////////////////////////////////////////////
+void PerformanceCounters::SetEnabled(bool _enabled)
+{
+  if (_enabled)
+  {
+    gEnabledCount.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto count = gEnabledCount.load(std::memory_order_relaxed);
+  while (count > 0 && !gEnabledCount.compare_exchange_weak(count, count - 1,
+      std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+bool PerformanceCounters::Enabled()
+{
+  return gEnabledCount.load(std::memory_order_relaxed) > 0;
+}
+
+/////////////////////////////////////////////////
+std::vector<PerformanceCounters::Sample> PerformanceCounters::TakeSamples()
+{
+  std::map<std::pair<std::string, std::string>, Sample> samples;
+  {
+    auto reg = registry();
+    std::lock_guard<std::mutex> lock(reg->mutex);
+    for (const auto &entry : reg->entries)
+    {
+      const auto calls = entry->calls.exchange(0, std::memory_order_relaxed);
+      const auto total = entry->total.exchange(0, std::memory_order_relaxed);
+      const auto max = entry->max.exchange(0, std::memory_order_relaxed);
+      const auto depth = entry->queueDepth.load(std::memory_order_relaxed);
+      const auto overruns =
+          entry->overruns.exchange(0, std::memory_order_relaxed);
+      const auto bytes = entry->bytes.exchange(0, std::memory_order_relaxed);
+      if (calls == 0 && depth == 0 && bytes == 0)
+        continue;
+
+      auto &sample = samples[{entry->owner, entry->source}];
+      sample.calls += calls;
+      sample.total += std::chrono::nanoseconds(total);
+      sample.max = std::max<std::chrono::steady_clock::duration>(sample.max,
+          std::chrono::nanoseconds(max));
+      sample.queueDepth += depth;
+      sample.overruns += overruns;
+      sample.bytes += bytes;
+    }
+  }
+
+  std::vector<Sample> result;
+  result.reserve(samples.size());
+  for (auto &[key, sample] : samples)
+  {
+    sample.owner = key.first;
+    sample.source = key.second;
+    result.push_back(std::move(sample));
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::string PerformanceCounters::OwnerName(const std::string &_className)
+{
+  const auto pos = _className.rfind("::");
+  if (pos == std::string::npos)
+    return _className;
+  return _className.substr(pos + 2);
+}
+}  // namespace gz::gui
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/RenderHooks.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(PerformanceCountersTest, Samples)
+{
+  PerformanceCounters::TakeSamples();
+
+  auto render = std::make_unique<PerformanceCounter>("Test", "render");
+  PerformanceCounter moreRender("Test", "render");
+  PerformanceCounter queue("Test", "queue");
+  PerformanceCounter idle("Idle", "render");
+
+  render->AddTime(2ms);
+  render->AddTime(5ms);
+  moreRender.AddTime(1ms);
+  queue.SetQueueDepth(3);
+
+  // Counters sharing an owner and source are summed, idle ones are left out
+  auto samples = PerformanceCounters::TakeSamples();
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ("Test", samples[0].owner);
+  EXPECT_EQ("queue", samples[0].source);
+  EXPECT_EQ(0u, samples[0].calls);
+  EXPECT_EQ(3u, samples[0].queueDepth);
+  EXPECT_EQ("render", samples[1].source);
+  EXPECT_EQ(3u, samples[1].calls);
+  EXPECT_EQ(std::chrono::steady_clock::duration(8ms), samples[1].total);
+  EXPECT_EQ(std::chrono::steady_clock::duration(5ms), samples[1].max);
+
+  // Calls are reset, queue depths are kept
+  samples = PerformanceCounters::TakeSamples();
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ("queue", samples[0].source);
+
+  queue.SetQueueDepth(0);
+  EXPECT_TRUE(PerformanceCounters::TakeSamples().empty());
+
+  // Bytes alone are reported, and reset
+  queue.AddBytes(1000);
+  queue.AddBytes(24);
+  samples = PerformanceCounters::TakeSamples();
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ(1024u, samples[0].bytes);
+  EXPECT_EQ(0u, samples[0].calls);
+  EXPECT_TRUE(PerformanceCounters::TakeSamples().empty());
+
+  // Destroyed counters stop reporting
+  render->AddTime(1ms);
+  render.reset();
+  EXPECT_TRUE(PerformanceCounters::TakeSamples().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PerformanceCountersTest, Timer)
+{
+  PerformanceCounters::TakeSamples();
+  PerformanceCounter counter("Test", "timer");
+  EXPECT_STREQ("Test timer", counter.Name());
+
+  // Nothing is measured while disabled
+  ASSERT_FALSE(PerformanceCounters::Enabled());
+  {
+    PerformanceTimer timer(counter);
+  }
+  EXPECT_TRUE(PerformanceCounters::TakeSamples().empty());
+
+  // Enabling is counted, so it stays enabled until all disable it
+  PerformanceCounters::SetEnabled(true);
+  PerformanceCounters::SetEnabled(true);
+  PerformanceCounters::SetEnabled(false);
+  EXPECT_TRUE(PerformanceCounters::Enabled());
+  {
+    PerformanceTimer timer(counter);
+    std::this_thread::sleep_for(2ms);
+  }
+  auto samples = PerformanceCounters::TakeSamples();
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ(1u, samples[0].calls);
+  EXPECT_GE(samples[0].total, std::chrono::steady_clock::duration(2ms));
+
+  PerformanceCounters::SetEnabled(false);
+  EXPECT_FALSE(PerformanceCounters::Enabled());
+
+  // Extra calls don't go below disabled
+  PerformanceCounters::SetEnabled(false);
+  PerformanceCounters::SetEnabled(true);
+  EXPECT_TRUE(PerformanceCounters::Enabled());
+  PerformanceCounters::SetEnabled(false);
+}
+
+/////////////////////////////////////////////////
+TEST(PerformanceCountersTest, RenderHooks)
+{
+  PerformanceCounters::TakeSamples();
+  PerformanceCounters::SetEnabled(true);
+
+  auto named = RenderHooks::OnRender([](){}, 0, "Plugin");
+  auto anonymous = RenderHooks::OnRender([](){});
+  auto preRender = RenderHooks::OnPreRender([](){}, 0, "Plugin");
+  RenderHooks::RunPreRender();
+  RenderHooks::RunRender();
+  RenderHooks::RunRender();
+
+  auto samples = PerformanceCounters::TakeSamples();
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ("Plugin", samples[0].owner);
+  EXPECT_EQ("pre-render hook", samples[0].source);
+  EXPECT_EQ(1u, samples[0].calls);
+  EXPECT_EQ("render hook", samples[1].source);
+  EXPECT_EQ(2u, samples[1].calls);
+
+  // Frame tasks over their budget are counted as overruns
+  named.reset();
+  preRender.reset();
+  auto task = RenderHooks::OnFrameTask(
+      [](std::chrono::steady_clock::time_point)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        return false;
+      }, 0, std::chrono::milliseconds(1), "Plugin");
+  RenderHooks::RunFrameTasks(std::chrono::milliseconds(0));
+  RenderHooks::RunFrameTasks(std::chrono::milliseconds(0));
+  samples = PerformanceCounters::TakeSamples();
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ("frame task", samples[0].source);
+  EXPECT_EQ(2u, samples[0].calls);
+  EXPECT_EQ(2u, samples[0].overruns);
+
+  PerformanceCounters::SetEnabled(false);
+}
+
+/////////////////////////////////////////////////
+TEST(PerformanceCountersTest, OwnerName)
+{
+  EXPECT_EQ("TapeMeasure",
+      PerformanceCounters::OwnerName("gz::gui::plugins::TapeMeasure"));
+  EXPECT_EQ("Plugin", PerformanceCounters::OwnerName("Plugin"));
+}
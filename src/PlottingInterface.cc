@@ -15,15 +15,53 @@
  *
 */
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <QMatrix4x4>
+#include <QMetaMethod>
+#include <QPointer>
+#include <QPointF>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <QSGVertexColorMaterial>
+#include <QUrl>
+
 #include <gz/common/Console.hh>
 #include <gz/common/StringUtils.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/msgs/Factory.hh>
+#include <gz/msgs/world_stats.pb.h>
 #include <gz/transport/Node.hh>
 #include <gz/transport/MessageInfo.hh>
 #include <gz/transport/Publisher.hh>
 
 #include "gz/gui/PlottingInterface.hh"
 #include "gz/gui/Application.hh"
+#include "gz/gui/NodePool.hh"
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/RecordedSeries.hh"
+#include "gz/gui/SignalAnalysis.hh"
+#include "gz/gui/SubscriptionHub.hh"
+#include "gz/gui/TaskPool.hh"
+#include "gz/gui/TimeSeries.hh"
 
 #include <gz/utils/ImplPtr.hh>
 
@@ -31,6 +69,431 @@
 // 1/60 Period like the GuiSystem frequency (60Hz)
 #define MAX_PERIOD_DIFF (0.0166666667)
 
+namespace
+{
+/// \brief Most values kept per field between flushes, older ones are
+/// dropped if the GUI doesn't keep up
+constexpr std::size_t kMaxPendingPoints = 10000;
+
+/// \brief Values of a field waiting to be sent to the GUI
+class SeriesBuffer
+{
+  /// \brief Field ID sent to the GUI, "<topic>-<field path>"
+  public: QString id;
+
+  /// \brief Time and value of each sample since the last flush
+  public: std::vector<QPointF> points;
+};
+
+/// \brief How a field is sampled, and its state
+class SamplingState
+{
+  /// \brief Sampling policy
+  public: gz::gui::SamplingPolicy policy{gz::gui::SamplingPolicy::DECIMATE};
+
+  /// \brief Sampling period in seconds
+  public: double period{MAX_PERIOD_DIFF};
+
+  /// \brief Time of the last plotted value
+  public: double lastTime{std::numeric_limits<double>::lowest()};
+
+  /// \brief Sum of the values received during the current period
+  public: double sum{0.0};
+
+  /// \brief Number of values received during the current period
+  public: int count{0};
+};
+
+/// \brief A field of a compiled field path
+class PathStep
+{
+  /// \brief Field within the msg of the previous step
+  public: const google::protobuf::FieldDescriptor *field{nullptr};
+
+  /// \brief Element of a repeated field, -1 if the field isn't repeated
+  public: int index{-1};
+};
+
+/// \brief A registered field path, compiled for one msg descriptor
+class FieldAccessor
+{
+  /// \brief Field path or ID, such as "pose-position-x"
+  public: std::string path;
+
+  /// \brief Data updated from the field
+  public: gz::gui::PlotData *data{nullptr};
+
+  /// \brief Fields from the msg down to the plotted one, empty if the path
+  /// doesn't lead to a plottable field
+  public: std::vector<PathStep> chain;
+
+  /// \brief Where new values of the field are queued
+  public: SeriesBuffer *buffer{nullptr};
+
+  /// \brief How the field is sampled
+  public: SamplingState *sampling{nullptr};
+};
+
+/////////////////////////////////////////////////
+/// \brief Read a base 128 varint of the protobuf wire format
+/// \param[in, out] _pos Start of the varint, moved past it
+/// \param[in] _end End of the data
+/// \param[out] _value Decoded value
+/// \return False if the data ends before the varint
+bool ReadVarint(const uint8_t *&_pos, const uint8_t *_end, uint64_t &_value)
+{
+  _value = 0;
+  for (int shift = 0; shift < 64 && _pos < _end; shift += 7)
+  {
+    const uint8_t byte = *_pos++;
+    _value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a little endian fixed size value of the wire format
+/// \param[in, out] _pos Start of the value, moved past it
+/// \param[in] _end End of the data
+/// \param[in] _bytes Size of the value, 4 or 8
+/// \param[out] _value Bits of the value
+/// \return False if the data ends before the value
+bool ReadFixed(const uint8_t *&_pos, const uint8_t *_end, int _bytes,
+    uint64_t &_value)
+{
+  if (_end - _pos < _bytes)
+    return false;
+
+  _value = 0;
+  for (int i = 0; i < _bytes; ++i)
+    _value |= static_cast<uint64_t>(_pos[i]) << (8 * i);
+  _pos += _bytes;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Skip a field value of the wire format
+/// \param[in, out] _pos Start of the value, moved past it
+/// \param[in] _end End of the data
+/// \param[in] _wireType Wire type of the field's tag
+/// \return False if the value is malformed or of an unsupported wire type
+bool SkipValue(const uint8_t *&_pos, const uint8_t *_end, uint64_t _wireType)
+{
+  uint64_t value{0};
+  switch (_wireType)
+  {
+    case 0:
+      return ReadVarint(_pos, _end, value);
+    case 1:
+      return ReadFixed(_pos, _end, 8, value);
+    case 2:
+      if (!ReadVarint(_pos, _end, value) ||
+          value > static_cast<uint64_t>(_end - _pos))
+      {
+        return false;
+      }
+      _pos += value;
+      return true;
+    case 5:
+      return ReadFixed(_pos, _end, 4, value);
+    // groups are deprecated and not used by gz msgs
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the wire type of a plottable field type
+/// \param[in] _type Field type
+/// \return Wire type, -1 if the type isn't plottable
+int PlottableWireType(google::protobuf::FieldDescriptor::Type _type)
+{
+  using FieldDescriptor = google::protobuf::FieldDescriptor;
+  switch (_type)
+  {
+    case FieldDescriptor::Type::TYPE_DOUBLE:
+      return 1;
+    case FieldDescriptor::Type::TYPE_FLOAT:
+      return 5;
+    case FieldDescriptor::Type::TYPE_INT32:
+    case FieldDescriptor::Type::TYPE_INT64:
+    case FieldDescriptor::Type::TYPE_BOOL:
+    case FieldDescriptor::Type::TYPE_UINT32:
+    case FieldDescriptor::Type::TYPE_UINT64:
+      return 0;
+    default:
+      return -1;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Decode a plottable value of the wire format
+/// \param[in, out] _pos Start of the value, moved past it
+/// \param[in] _end End of the data
+/// \param[in] _type Field type, which must be plottable
+/// \param[out] _value Decoded value
+/// \return False if the value is malformed
+bool DecodeValue(const uint8_t *&_pos, const uint8_t *_end,
+    google::protobuf::FieldDescriptor::Type _type, double &_value)
+{
+  using FieldDescriptor = google::protobuf::FieldDescriptor;
+  uint64_t bits{0};
+  if (_type == FieldDescriptor::Type::TYPE_DOUBLE)
+  {
+    if (!ReadFixed(_pos, _end, 8, bits))
+      return false;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    _value = value;
+    return true;
+  }
+  if (_type == FieldDescriptor::Type::TYPE_FLOAT)
+  {
+    if (!ReadFixed(_pos, _end, 4, bits))
+      return false;
+    const auto word = static_cast<uint32_t>(bits);
+    float value;
+    std::memcpy(&value, &word, sizeof(value));
+    _value = value;
+    return true;
+  }
+
+  if (!ReadVarint(_pos, _end, bits))
+    return false;
+
+  // negative int32 are sign extended to 64 bits
+  if (_type == FieldDescriptor::Type::TYPE_INT32)
+    _value = static_cast<int32_t>(bits);
+  else if (_type == FieldDescriptor::Type::TYPE_INT64)
+    _value = static_cast<double>(static_cast<int64_t>(bits));
+  else if (_type == FieldDescriptor::Type::TYPE_BOOL)
+    _value = bits != 0;
+  else if (_type == FieldDescriptor::Type::TYPE_UINT32)
+    _value = static_cast<uint32_t>(bits);
+  else
+    _value = static_cast<double>(bits);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a field path out of a serialized msg, decoding only the
+/// fields along the path and skipping over the others.
+///
+/// As when parsing, the last value of a field wins and the occurrences of an
+/// embedded msg are merged.
+/// \param[in] _data Start of the serialized msg
+/// \param[in] _end End of the serialized msg
+/// \param[in] _chain Compiled field path
+/// \param[in] _depth Step of the path the msg holds
+/// \param[out] _value Value of the field, left as is if it isn't found or
+/// if the last step is a msg. Values that aren't plottable read as 0.
+/// \return True if the field was found
+bool ScanPath(const uint8_t *_data, const uint8_t *_end,
+    const std::vector<PathStep> &_chain, std::size_t _depth, double &_value)
+{
+  const auto &step = _chain[_depth];
+  const auto number = static_cast<uint64_t>(step.field->number());
+  const bool last = _depth + 1 == _chain.size();
+  const int wireType = PlottableWireType(step.field->type());
+
+  int occurrence{0};
+  bool found{false};
+  const uint8_t *pos = _data;
+  while (pos < _end)
+  {
+    uint64_t tag{0};
+    if (!ReadVarint(pos, _end, tag))
+      return false;
+
+    const uint64_t tagWireType = tag & 0x7;
+    if ((tag >> 3) != number)
+    {
+      if (!SkipValue(pos, _end, tagWireType))
+        return false;
+      continue;
+    }
+
+    // embedded msg, or a leaf the caller only checks the presence of
+    if (!last || step.field->message_type())
+    {
+      uint64_t size{0};
+      if (tagWireType != 2 || !ReadVarint(pos, _end, size) ||
+          size > static_cast<uint64_t>(_end - pos))
+      {
+        return false;
+      }
+      const uint8_t *msgEnd = pos + size;
+      if (last)
+        found = true;
+      else if (step.index < 0)
+        found = ScanPath(pos, msgEnd, _chain, _depth + 1, _value) || found;
+      else if (occurrence++ == step.index)
+        return ScanPath(pos, msgEnd, _chain, _depth + 1, _value);
+      pos = msgEnd;
+      continue;
+    }
+
+    if (wireType < 0)
+    {
+      if (!SkipValue(pos, _end, tagWireType))
+        return false;
+      _value = 0.0;
+      found = true;
+      continue;
+    }
+
+    // packed repeated values
+    if (step.index >= 0 && tagWireType == 2)
+    {
+      uint64_t size{0};
+      if (!ReadVarint(pos, _end, size) ||
+          size > static_cast<uint64_t>(_end - pos))
+      {
+        return false;
+      }
+      const uint8_t *packedEnd = pos + size;
+      while (pos < packedEnd)
+      {
+        double value{0.0};
+        if (!DecodeValue(pos, packedEnd, step.field->type(), value))
+          return false;
+        if (occurrence++ == step.index)
+        {
+          _value = value;
+          return true;
+        }
+      }
+      continue;
+    }
+
+    if (tagWireType != static_cast<uint64_t>(wireType))
+      return false;
+
+    double value{0.0};
+    if (!DecodeValue(pos, _end, step.field->type(), value))
+      return false;
+
+    if (step.index < 0)
+    {
+      _value = value;
+      found = true;
+    }
+    else if (occurrence++ == step.index)
+    {
+      _value = value;
+      return true;
+    }
+  }
+  return found;
+}
+
+/// \brief Size of the write buffer of exported files
+constexpr std::size_t kExportBufferSize = 1 << 20;
+
+/// \brief A graph to write to a file
+class ExportJob
+{
+  /// \brief File to write
+  public: std::string filePath;
+
+  /// \brief Graph name, written in the file header
+  public: std::string name;
+
+  /// \brief Values of the graph, in time order
+  public: std::vector<gz::math::Vector2d> points;
+
+  /// \brief True for the binary format, false for CSV
+  public: bool binary{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Write a graph as CSV
+/// \param[in] _job Graph to write
+/// \param[in] _file Stream opened on the job's file
+void WriteCSV(const ExportJob &_job, std::ofstream &_file)
+{
+  _file.precision(std::numeric_limits<double>::digits10);
+  _file << "time, " << _job.name << '\n';
+  for (const auto &point : _job.points)
+    _file << point.X() << ", " << point.Y() << '\n';
+}
+
+/////////////////////////////////////////////////
+/// \brief Write the graphs to their files
+/// \param[in] _jobs Graphs to write
+/// \return True if all files were written
+bool WriteJobs(const std::vector<ExportJob> &_jobs)
+{
+  // One buffer for all files, and no flush per line
+  std::vector<char> buffer(kExportBufferSize);
+  bool success{true};
+  for (const auto &job : _jobs)
+  {
+    if (job.binary)
+    {
+      success = gz::gui::RecordedSeries::Write(job.filePath, job.name,
+          job.points) && success;
+      continue;
+    }
+
+    std::ofstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    file.open(job.filePath, std::ios::out);
+    if (!file.is_open())
+    {
+      gzwarn << "[Couldn't open file: " << job.filePath << "]" << std::endl;
+      success = false;
+      continue;
+    }
+
+    WriteCSV(job, file);
+
+    file.close();
+    if (file.fail())
+    {
+      gzwarn << "[Couldn't write file: " << job.filePath << "]" << std::endl;
+      success = false;
+    }
+  }
+  return success;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert the component maps given by QML
+/// \param[in] _components Map of each attribute
+/// \param[in] _chart chart id
+/// \return Valid subscriptions
+std::vector<gz::gui::PlotComponentSubscription> ParseComponents(
+    const QVariantList &_components, int _chart)
+{
+  std::vector<gz::gui::PlotComponentSubscription> subscriptions;
+  subscriptions.reserve(static_cast<std::size_t>(_components.size()));
+  for (const auto &component : _components)
+  {
+    const auto map = component.toMap();
+    bool entityOk{false};
+    bool typeIdOk{false};
+    gz::gui::PlotComponentSubscription subscription;
+    subscription.entity = map["entity"].toString().toULongLong(&entityOk);
+    subscription.typeId = map["typeId"].toString().toULongLong(&typeIdOk);
+    subscription.type = map["type"].toString().toStdString();
+    subscription.attribute = map["attribute"].toString().toStdString();
+    subscription.chart = _chart;
+    if (!entityOk || !typeIdOk)
+    {
+      gzerr << "Invalid component entity [" <<
+          map["entity"].toString().toStdString() << "] or type id [" <<
+          map["typeId"].toString().toStdString() << "]" << std::endl;
+      continue;
+    }
+    subscriptions.push_back(std::move(subscription));
+  }
+  return subscriptions;
+}
+}  // namespace
+
 namespace gz::gui
 {
 class PlotData::Implementation
@@ -50,9 +513,81 @@ class Topic::Implementation
   /// \brief Check the plotable types and get data from reflection
   /// \param[in] _msg Message to get data from
   /// \param[in] _field Field within the message to get
+  /// \param[in] _index Element of a repeated field, -1 if not repeated
   /// \return Plottable value as double, zero if not plottable
   public: double FieldData(const google::protobuf::Message &_msg,
-                           const google::protobuf::FieldDescriptor *_field);
+                           const google::protobuf::FieldDescriptor *_field,
+                           int _index = -1);
+
+  /// \brief Compile the header and registered field paths for a msg
+  /// descriptor, unless they're compiled already
+  /// \param[in] _descriptor Descriptor of the received msgs
+  public: void Compile(const google::protobuf::Descriptor *_descriptor);
+
+  /// \brief Compile a field path into the chain of fields leading to it
+  /// \param[in] _descriptor Descriptor of the msg holding the path
+  /// \param[in] _path Field names separated by '-'. Repeated fields are
+  /// followed by the index of an element, such as "pose-3-position-x".
+  /// \return Chain of fields, empty if the path isn't a plottable field
+  public: std::vector<PathStep> CompilePath(
+              const google::protobuf::Descriptor *_descriptor,
+              const std::string &_path);
+
+  /// \brief Get the value of a compiled field
+  /// \param[in] _msg Msg of the compiled descriptor
+  /// \param[in] _chain Compiled field path
+  /// \return Plottable value as double, zero for missing elements
+  public: double Value(const google::protobuf::Message &_msg,
+              const std::vector<PathStep> &_chain);
+
+  /// \brief Sample the registered fields of a received msg. Call it with
+  /// the mutex locked, once the msg's descriptor is compiled.
+  /// \param[in] _time Plotted time of the msg
+  /// \param[in] _headerTime Header time of the msg, DEFAULT_TIME if none
+  /// \param[in] _value Reads the value of a compiled field path in the msg
+  public: void Sample(double _time, double _headerTime,
+              const std::function<double(const std::vector<PathStep> &)>
+              &_value);
+
+  /// \brief Protects the fields and accessors, which are registered from
+  /// the GUI thread and used from the transport thread
+  public: std::mutex mutex;
+
+  /// \brief Descriptor the accessors were compiled for
+  public: const google::protobuf::Descriptor *descriptor{nullptr};
+
+  /// \brief True if fields were registered since the last compilation
+  public: bool dirty{true};
+
+  /// \brief Compiled registered fields
+  public: std::vector<FieldAccessor> accessors;
+
+  /// \brief Values of each field waiting for the next FlushGui
+  public: std::map<std::string, SeriesBuffer> pending;
+
+  /// \brief Sampling of each field
+  public: std::map<std::string, SamplingState> sampling;
+
+  /// \brief Header field, null if the msg has no header stamp
+  public: const google::protobuf::FieldDescriptor *headerField{nullptr};
+
+  /// \brief Stamp field of the header
+  public: const google::protobuf::FieldDescriptor *stampField{nullptr};
+
+  /// \brief Seconds of the stamp
+  public: const google::protobuf::FieldDescriptor *secField{nullptr};
+
+  /// \brief Nanoseconds of the stamp
+  public: const google::protobuf::FieldDescriptor *nsecField{nullptr};
+
+  /// \brief Path to the header, to check its presence in serialized msgs
+  public: std::vector<PathStep> headerChain;
+
+  /// \brief Path to the seconds of the stamp
+  public: std::vector<PathStep> secChain;
+
+  /// \brief Path to the nanoseconds of the stamp
+  public: std::vector<PathStep> nsecChain;
 
   /// \brief Topic name
   public: std::string name;
@@ -60,20 +595,46 @@ class Topic::Implementation
   /// \brief Default Plotting time
   public: std::shared_ptr<double> plottingTime;
 
-  /// \brief Previous header time to limit the frequency of publishing
-  public: double lastHeaderTime = 0;
-
   /// \brief Plotting fields to update its values
   public: std::map<std::string, gz::gui::PlotData*> fields;
 };
 
 class Transport::Implementation
 {
-  /// \brief Node for Commincation
-  public: gz::transport::Node node {gz::transport::NodeOptions()};
+  /// \brief Get the hub to subscribe through, the application's if there
+  /// is one
+  /// \return Subscription hub
+  public: SubscriptionHub *Hub();
+
+  /// \brief Subscribe to the serialized msgs of a topic, at `maxRate`
+  /// \param[in] _topic Topic name
+  /// \param[in] _handler Handler of the topic's msgs
+  public: void Subscribe(const std::string &_topic, Topic *_handler);
+
+  /// \brief Get the node for discovery queries, the application's shared
+  /// one if there's an application
+  /// \return Node
+  public: gz::transport::Node &Node();
+
+  /// \brief Node used without an application, created on demand
+  public: std::unique_ptr<gz::transport::Node> ownNode;
+
+  /// \brief Hub used without an application, created on demand
+  public: std::unique_ptr<SubscriptionHub> ownHub;
 
   /// \brief subscribed topics
   public: std::map<std::string, gz::gui::Topic*> topics;
+
+  /// \brief Subscription of each subscribed topic
+  public: std::map<std::string, HubSubscription> subscriptions;
+
+  /// \brief Sampling policy and period of each topic and field path,
+  /// applied when they're subscribed
+  public: std::map<std::pair<std::string, std::string>,
+      std::pair<SamplingPolicy, double>> sampling;
+
+  /// \brief Most messages per second received on each topic, 0 for all
+  public: double maxRate{0.0};
 };
 
 class PlottingInterface::Implementation
@@ -89,8 +650,110 @@ class PlottingInterface::Implementation
 
   /// \brief timer to update the plotting each time step
   public: QTimer timer {nullptr};
+
+  /// \brief Clock stamping msgs without header
+  public: PlotClock clock{PlotClock::STEADY};
+
+  /// \brief Start of the steady clock
+  public: std::chrono::steady_clock::time_point start{
+      std::chrono::steady_clock::now()};
+
+  /// \brief Node subscribed to the world statistics for SIM_TIME
+  public: gz::transport::Node clockNode;
+
+  /// \brief World statistics topic, empty if not subscribed
+  public: std::string clockTopic;
+
+  /// \brief timer to send the received transport values to the GUI, about
+  /// once per frame
+  public: QTimer flushTimer {nullptr};
+
+  /// \brief Get the stored values of a series, creating it if needed
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \return Stored values
+  public: TimeSeries &Series(int _chart, const QString &_fieldID);
+
+  /// \brief Statistics and spectrum of a series
+  public: struct Analysis
+  {
+    /// \brief Statistics over the statistics window
+    RollingStatistics statistics;
+
+    /// \brief Collects the spectrum windows, null if there's no spectrum
+    std::unique_ptr<Spectrum> spectrum;
+
+    /// \brief Latest amplitudes
+    std::vector<double> amplitudes;
+
+    /// \brief Sample rate of the latest amplitudes
+    double sampleRate{0.0};
+
+    /// \brief True while a spectrum is computed
+    bool pending{false};
+  };
+
+  /// \brief Add values to the analysis of a series, creating it if needed,
+  /// and compute its spectrum on a worker thread when a window is ready
+  /// \param[in] _owner Interface to send the spectrum to
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID or component key
+  /// \param[in] _points Time and value of each new value
+  public: void Analyze(PlottingInterface *_owner, int _chart,
+      const QString &_fieldID, const std::vector<QPointF> &_points);
+
+  /// \brief Analysis of each series, by chart and field ID like the store
+  public: std::map<std::pair<int, std::string>, Analysis> analyses;
+
+  /// \brief Time window of the statistics
+  public: double statisticsWindow{10.0};
+
+  /// \brief Series of a component attribute
+  public: struct ComponentTarget
+  {
+    /// \brief Field ID of its series, "entity,typeId,attribute"
+    QString fieldID;
+
+    /// \brief Charts plotting it
+    std::set<int> charts;
+  };
+
+  /// \brief Subscribed component attributes, by entity, type id and
+  /// attribute
+  public: std::map<std::tuple<uint64_t, uint64_t, std::string>,
+      ComponentTarget> components;
+
+  /// \brief True once a spectrum was computed on the worker threads
+  public: bool usesTasks{false};
+
+  /// \brief Full history of each plotted series, by chart and field ID.
+  /// Charts only draw a decimated view of it.
+  public: std::map<std::pair<int, std::string>, TimeSeries> store;
+
+  /// \brief Recordings overlaid on the charts, by chart and field ID
+  public: std::map<std::pair<int, std::string>,
+      std::unique_ptr<RecordedSeries>> recordings;
+
+  /// \brief Retention window of the series, 0 for no limit
+  public: double retention{0.0};
+
+  /// \brief Most values kept per series, 0 for the TimeSeries default
+  public: std::size_t maxPoints{0};
+
+  /// \brief Thread writing the exported files
+  public: std::thread exportThread;
+
+  /// \brief Protects the export queue
+  public: std::mutex exportMutex;
+
+  /// \brief Exports waiting to be written, one list of graphs per export
+  public: std::deque<std::vector<ExportJob>> exportQueue;
+
+  /// \brief True while the export thread is running
+  public: bool exporting{false};
 };
 
+
 //////////////////////////////////////////////////////
 PlotData::PlotData() :
     dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -174,6 +837,9 @@ std::string &Topic::Name() const
 //////////////////////////////////////////////////////
 void Topic::Register(const std::string &_fieldPath, int _chart)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->dirty = true;
+
   // if a new field create a new field and register the chart
   if (this->dataPtr->fields.count(_fieldPath) == 0)
     this->dataPtr->fields[_fieldPath] = new PlotData();
@@ -184,11 +850,18 @@ void Topic::Register(const std::string &_fieldPath, int _chart)
 //////////////////////////////////////////////////////
 void Topic::UnRegister(const std::string &_fieldPath, int _chart)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->dirty = true;
+
   this->dataPtr->fields[_fieldPath]->RemoveChart(_chart);
 
   // if no one registers to the field, remove it
   if (!this->dataPtr->fields[_fieldPath]->ChartCount())
+  {
+    delete this->dataPtr->fields[_fieldPath];
     this->dataPtr->fields.erase(_fieldPath);
+    this->dataPtr->sampling.erase(_fieldPath);
+  }
 }
 
 //////////////////////////////////////////////////////
@@ -197,6 +870,18 @@ int Topic::FieldCount() const
   return this->dataPtr->fields.size();
 }
 
+//////////////////////////////////////////////////////
+void Topic::SetSamplingPolicy(const std::string &_fieldPath,
+                              SamplingPolicy _policy, double _period)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &sampling = this->dataPtr->sampling[_fieldPath];
+  sampling.policy = _policy;
+  sampling.period = _period;
+  sampling.sum = 0.0;
+  sampling.count = 0;
+}
+
 //////////////////////////////////////////////////////
 std::map<std::string, PlotData*> &Topic::Fields()
 {
@@ -206,94 +891,130 @@ std::map<std::string, PlotData*> &Topic::Fields()
 //////////////////////////////////////////////////////
 void Topic::Callback(const google::protobuf::Message &_msg)
 {
-  // check for header time
+  GZ_GUI_PROFILE("Topic::Callback");
+
+  // msgs without header are stamped with the plotting clock
   double headerTime = 0.0;
-  if (!this->HasHeader(_msg, headerTime))
+  double time = 0.0;
+  if (this->HasHeader(_msg, headerTime))
+  {
+    time = headerTime;
+  }
+  else
   {
     if (!this->dataPtr->plottingTime)
         return;
 
     headerTime = DEFAULT_TIME;
+    time = *this->dataPtr->plottingTime;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Compile(_msg.GetDescriptor());
+  this->dataPtr->Sample(time, headerTime,
+      [&](const std::vector<PathStep> &_chain)
+      {
+        return this->dataPtr->Value(_msg, _chain);
+      });
+}
 
-    if (*this->dataPtr->plottingTime - this->dataPtr->lastHeaderTime
-          < MAX_PERIOD_DIFF)
+//////////////////////////////////////////////////////
+void Topic::RawCallback(const char *_data, std::size_t _size,
+                        const std::string &_msgType)
+{
+  GZ_GUI_PROFILE("Topic::RawCallback");
+
+  // Only generated msgs can be scanned, others are parsed
+  const auto *descriptor = google::protobuf::DescriptorPool::generated_pool()
+      ->FindMessageTypeByName(_msgType);
+  if (!descriptor)
+  {
+    auto msg = gz::msgs::Factory::New(_msgType);
+    if (!msg || !msg->ParseFromArray(_data, static_cast<int>(_size)))
+    {
+      gzerr << "Unable to parse msg of type [" << _msgType << "] on topic ["
+            << this->dataPtr->name << "]" << std::endl;
       return;
+    }
+    this->Callback(*msg);
+    return;
+  }
+
+  const auto *begin = reinterpret_cast<const uint8_t *>(_data);
+  const auto *end = begin + _size;
 
-    this->dataPtr->lastHeaderTime = *this->dataPtr->plottingTime;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Compile(descriptor);
+
+  // msgs without header are stamped with the plotting clock
+  double headerTime = 0.0;
+  double time = 0.0;
+  double unused = 0.0;
+  if (this->dataPtr->headerField &&
+      ScanPath(begin, end, this->dataPtr->headerChain, 0, unused))
+  {
+    double sec = 0.0;
+    double nsec = 0.0;
+    ScanPath(begin, end, this->dataPtr->secChain, 0, sec);
+    ScanPath(begin, end, this->dataPtr->nsecChain, 0, nsec);
+    headerTime = sec + nsec * std::pow(10, -9);
+    time = headerTime;
   }
   else
   {
-    if (headerTime - this->dataPtr->lastHeaderTime < MAX_PERIOD_DIFF)
+    if (!this->dataPtr->plottingTime)
         return;
 
-    this->dataPtr->lastHeaderTime = headerTime;
+    headerTime = DEFAULT_TIME;
+    time = *this->dataPtr->plottingTime;
   }
 
-  // loop over the registered fields and update them
-  for (const auto &fieldIt : this->dataPtr->fields)
-  {
-    const auto *msgDescriptor = _msg.GetDescriptor();
-    const auto *ref = _msg.GetReflection();
-
-    google::protobuf::Message *valueMsg = nullptr;
-
-    auto fieldFullPath = gz::common::Split(fieldIt.first, '-');
-    int pathSize = fieldFullPath.size();
+  this->dataPtr->Sample(time, headerTime,
+      [&](const std::vector<PathStep> &_chain)
+      {
+        // missing fields read as their default value
+        double value = 0.0;
+        ScanPath(begin, end, _chain, 0, value);
+        return value;
+      });
+}
 
-    // loop until you reach the last field in the path
-    for (int i = 0; i < pathSize-1 ; i++)
+//////////////////////////////////////////////////////
+void Topic::FlushGui()
+{
+  // Swap the values out, so the transport thread isn't blocked while the
+  // GUI plots them
+  std::vector<std::tuple<QString, std::set<int>, std::vector<QPointF>>>
+      batches;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto &[path, buffer] : this->dataPtr->pending)
     {
-      std::string fieldName = fieldFullPath[i];
-
-      const auto *field = msgDescriptor->FindFieldByName(fieldName);
-
-      msgDescriptor = field->message_type();
+      if (buffer.points.empty())
+        continue;
 
-      if (valueMsg)
+      auto field = this->dataPtr->fields.find(path);
+      if (field == this->dataPtr->fields.end() || !field->second)
       {
-        valueMsg = ref->MutableMessage
-                (const_cast<google::protobuf::Message *>(valueMsg), field);
+        buffer.points.clear();
+        continue;
       }
-      else
-      {
-        valueMsg = ref->MutableMessage
-                (const_cast<google::protobuf::Message *>(&_msg), field);
-      }
-
-      if (valueMsg)
-        ref = valueMsg->GetReflection();
-      else
-      {
-        gzwarn << "Invalid topic msg" << std::endl;
-        return;
-      }
-    }
-
-    std::string fieldName = fieldFullPath[pathSize-1];
-    double data = 0.0;
 
-    if (valueMsg)
-    {
-      const auto *field = valueMsg->GetDescriptor()->FindFieldByName(fieldName);
-      data = this->dataPtr->FieldData(*valueMsg, field);
-    }
-    else
-    {
-      const auto *field = msgDescriptor->FindFieldByName(fieldName);
-      data = this->dataPtr->FieldData(_msg, field);
+      batches.emplace_back(buffer.id, field->second->Charts(),
+          std::vector<QPointF>());
+      std::swap(std::get<2>(batches.back()), buffer.points);
     }
+  }
 
-    if (!fieldIt.second)
-      continue;
-
-    // Field Arrival Time
-    fieldIt.second->SetTime(headerTime);
-
-    // Field Value
-    fieldIt.second->SetValue(data);
+  for (const auto &[id, charts, points] : batches)
+  {
+    QVariantList list;
+    list.reserve(static_cast<int>(points.size()));
+    for (const auto &point : points)
+      list.append(point);
 
-    // Update Field Charts UI
-    this->UpdateGui(fieldIt.first);
+    for (auto const &chart : charts)
+      emit this->plotBatch(chart, id, list);
   }
 }
 
@@ -301,39 +1022,24 @@ void Topic::Callback(const google::protobuf::Message &_msg)
 bool Topic::HasHeader(const google::protobuf::Message &_msg,
                       double &_headerTime)
 {
-  const auto *ref = _msg.GetReflection();
-  const auto *header = _msg.GetDescriptor()->FindFieldByName("header");
-  auto found = ref->HasField(_msg, header);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Compile(_msg.GetDescriptor());
 
-  if (!found)
+  if (!this->dataPtr->headerField)
     return false;
 
-  const auto *stamp = header->message_type()->FindFieldByName("stamp");
-
-  if (!stamp)
+  const auto *ref = _msg.GetReflection();
+  if (!ref->HasField(_msg, this->dataPtr->headerField))
     return false;
 
-  auto *headerMsg = ref->MutableMessage
-          (const_cast<google::protobuf::Message *>(&_msg), header);
+  const auto &headerMsg = ref->GetMessage(_msg, this->dataPtr->headerField);
+  const auto &stampMsg = headerMsg.GetReflection()->GetMessage(headerMsg,
+      this->dataPtr->stampField);
 
-  if (!headerMsg)
-    return false;
+  auto sec = this->dataPtr->FieldData(stampMsg, this->dataPtr->secField);
+  auto nsec = this->dataPtr->FieldData(stampMsg, this->dataPtr->nsecField);
 
-  ref = headerMsg->GetReflection();
-
-  auto *stampMsg = ref->MutableMessage
-          (const_cast<google::protobuf::Message *>(headerMsg), stamp);
-
-  if (!stampMsg)
-    return false;
-
-  const auto *secField = stamp->message_type()->FindFieldByName("sec");
-  const auto *nsecField = stamp->message_type()->FindFieldByName("nsec");
-
-  auto sec = this->dataPtr->FieldData(*stampMsg, secField);
-  auto nsec = this->dataPtr->FieldData(*stampMsg, nsecField);
-
-  _headerTime = sec + nsec * std::pow(10, -9);
+  _headerTime = sec + nsec * std::pow(10, -9);
 
   return true;
 }
@@ -364,26 +1070,52 @@ void Topic::SetPlottingTimeRef(const std::shared_ptr<double> &_timeRef)
 
 //////////////////////////////////////////////////////
 double Topic::Implementation::FieldData(const google::protobuf::Message &_msg,
-                               const google::protobuf::FieldDescriptor *_field)
+                               const google::protobuf::FieldDescriptor *_field,
+                               int _index)
 {
   using FieldDescriptor = google::protobuf::FieldDescriptor;
   const auto *ref = _msg.GetReflection();
   auto type = _field->type();
 
+  const bool repeated = _index >= 0;
+  if (repeated && _index >= ref->FieldSize(_msg, _field))
+    return 0;
+
   if (type == FieldDescriptor::Type::TYPE_DOUBLE)
-    return ref->GetDouble(_msg, _field);
+  {
+    return repeated ? ref->GetRepeatedDouble(_msg, _field, _index) :
+        ref->GetDouble(_msg, _field);
+  }
   else if (type == FieldDescriptor::Type::TYPE_FLOAT)
-    return ref->GetFloat(_msg, _field);
+  {
+    return repeated ? ref->GetRepeatedFloat(_msg, _field, _index) :
+        ref->GetFloat(_msg, _field);
+  }
   else if (type == FieldDescriptor::Type::TYPE_INT32)
-    return ref->GetInt32(_msg, _field);
+  {
+    return repeated ? ref->GetRepeatedInt32(_msg, _field, _index) :
+        ref->GetInt32(_msg, _field);
+  }
   else if (type == FieldDescriptor::Type::TYPE_INT64)
-    return ref->GetInt64(_msg, _field);
+  {
+    return repeated ? ref->GetRepeatedInt64(_msg, _field, _index) :
+        ref->GetInt64(_msg, _field);
+  }
   else if (type == FieldDescriptor::Type::TYPE_BOOL)
-    return ref->GetBool(_msg, _field);
+  {
+    return repeated ? ref->GetRepeatedBool(_msg, _field, _index) :
+        ref->GetBool(_msg, _field);
+  }
   else if (type == FieldDescriptor::Type::TYPE_UINT32)
-    return ref->GetUInt32(_msg, _field);
+  {
+    return repeated ? ref->GetRepeatedUInt32(_msg, _field, _index) :
+        ref->GetUInt32(_msg, _field);
+  }
   else if (type == FieldDescriptor::Type::TYPE_UINT64)
-    return ref->GetUInt64(_msg, _field);
+  {
+    return repeated ? ref->GetRepeatedUInt64(_msg, _field, _index) :
+        ref->GetUInt64(_msg, _field);
+  }
   else
   {
     gzwarn << "Non Plotting Type" << std::endl;
@@ -391,6 +1123,215 @@ double Topic::Implementation::FieldData(const google::protobuf::Message &_msg,
   }
 }
 
+//////////////////////////////////////////////////////
+void Topic::Implementation::Compile(
+    const google::protobuf::Descriptor *_descriptor)
+{
+  if (_descriptor == this->descriptor && !this->dirty)
+    return;
+
+  this->descriptor = _descriptor;
+  this->dirty = false;
+
+  // header stamp
+  this->headerField = nullptr;
+  const auto *header = _descriptor->FindFieldByName("header");
+  if (header && !header->is_repeated() && header->message_type())
+  {
+    const auto *stamp = header->message_type()->FindFieldByName("stamp");
+    if (stamp && !stamp->is_repeated() && stamp->message_type())
+    {
+      this->secField = stamp->message_type()->FindFieldByName("sec");
+      this->nsecField = stamp->message_type()->FindFieldByName("nsec");
+      if (this->secField && this->nsecField)
+      {
+        this->headerField = header;
+        this->stampField = stamp;
+        this->headerChain = {PathStep{header, -1}};
+        this->secChain = {PathStep{header, -1}, PathStep{stamp, -1},
+            PathStep{this->secField, -1}};
+        this->nsecChain = {PathStep{header, -1}, PathStep{stamp, -1},
+            PathStep{this->nsecField, -1}};
+      }
+    }
+  }
+
+  // registered fields, keeping the values not sent yet
+  this->accessors.clear();
+  std::map<std::string, SeriesBuffer> buffers;
+  for (const auto &field : this->fields)
+  {
+    auto &buffer = buffers[field.first];
+    auto previous = this->pending.find(field.first);
+    if (previous != this->pending.end())
+      buffer = std::move(previous->second);
+    else
+      buffer.id = QString::fromStdString(this->name + "-" + field.first);
+
+    FieldAccessor accessor;
+    accessor.path = field.first;
+    accessor.data = field.second;
+    accessor.chain = this->CompilePath(_descriptor, field.first);
+    accessor.buffer = &buffer;
+    accessor.sampling = &this->sampling[field.first];
+    this->accessors.push_back(accessor);
+  }
+  this->pending = std::move(buffers);
+}
+
+//////////////////////////////////////////////////////
+std::vector<PathStep> Topic::Implementation::CompilePath(
+    const google::protobuf::Descriptor *_descriptor, const std::string &_path)
+{
+  std::vector<PathStep> chain;
+
+  auto fieldFullPath = gz::common::Split(_path, '-');
+  const auto *msgDescriptor = _descriptor;
+  for (std::size_t i = 0; i < fieldFullPath.size(); ++i)
+  {
+    PathStep step;
+    step.field = msgDescriptor ?
+        msgDescriptor->FindFieldByName(fieldFullPath[i]) : nullptr;
+
+    // repeated fields are followed by the index of an element
+    bool valid = step.field != nullptr;
+    if (valid && step.field->is_repeated())
+    {
+      const std::string index = i + 1 < fieldFullPath.size() ?
+          fieldFullPath[i + 1] : "";
+      valid = !index.empty() && index.size() < 10 &&
+          std::all_of(index.begin(), index.end(),
+          [](unsigned char _c){return std::isdigit(_c);});
+      if (valid)
+      {
+        step.index = std::stoi(index);
+        ++i;
+      }
+    }
+
+    // every field but the last one must be a msg
+    const bool last = i + 1 == fieldFullPath.size();
+    if (!valid || (last == (step.field->message_type() != nullptr)))
+    {
+      gzwarn << "Invalid field [" << _path << "] for msg ["
+             << _descriptor->full_name() << "]" << std::endl;
+      return {};
+    }
+
+    chain.push_back(step);
+    msgDescriptor = step.field->message_type();
+  }
+  return chain;
+}
+
+//////////////////////////////////////////////////////
+double Topic::Implementation::Value(const google::protobuf::Message &_msg,
+    const std::vector<PathStep> &_chain)
+{
+  // unset msgs read as their default instance, so nothing is allocated
+  const google::protobuf::Message *msg = &_msg;
+  for (std::size_t i = 0; i + 1 < _chain.size(); ++i)
+  {
+    const auto &step = _chain[i];
+    const auto *ref = msg->GetReflection();
+    if (step.index < 0)
+    {
+      msg = &ref->GetMessage(*msg, step.field);
+      continue;
+    }
+
+    if (step.index >= ref->FieldSize(*msg, step.field))
+      return 0;
+    msg = &ref->GetRepeatedMessage(*msg, step.field, step.index);
+  }
+
+  return this->FieldData(*msg, _chain.back().field, _chain.back().index);
+}
+
+//////////////////////////////////////////////////////
+void Topic::Implementation::Sample(double _time, double _headerTime,
+    const std::function<double(const std::vector<PathStep> &)> &_value)
+{
+  // loop over the registered fields and update them
+  for (const auto &accessor : this->accessors)
+  {
+    if (accessor.chain.empty() || !accessor.data)
+      continue;
+
+    // a new period starts once the period elapsed, or if the clock went back
+    auto &sampling = *accessor.sampling;
+    const bool newPeriod = _time < sampling.lastTime ||
+        _time - sampling.lastTime >= sampling.period;
+
+    // decimated fields aren't even read until their next period
+    if (sampling.policy == SamplingPolicy::DECIMATE && !newPeriod)
+      continue;
+
+    double value = _value(accessor.chain);
+    if (sampling.policy == SamplingPolicy::AVERAGE)
+    {
+      sampling.sum += value;
+      ++sampling.count;
+      if (!newPeriod)
+        continue;
+
+      value = sampling.sum / sampling.count;
+      sampling.sum = 0.0;
+      sampling.count = 0;
+    }
+    if (newPeriod)
+      sampling.lastTime = _time;
+
+    // Field Arrival Time
+    accessor.data->SetTime(_headerTime);
+
+    // Field Value
+    accessor.data->SetValue(value);
+
+    // Queue for the GUI
+    auto &points = accessor.buffer->points;
+    if (points.size() >= kMaxPendingPoints)
+      points.erase(points.begin());
+    points.emplace_back(_time, value);
+  }
+}
+
+////////////////////////////////////////////
+SubscriptionHub *Transport::Implementation::Hub()
+{
+  if (App())
+    return App()->Subscriptions();
+
+  if (!this->ownHub)
+    this->ownHub = std::make_unique<SubscriptionHub>();
+  return this->ownHub.get();
+}
+
+////////////////////////////////////////////
+gz::transport::Node &Transport::Implementation::Node()
+{
+  if (App())
+    return App()->Nodes()->Node();
+
+  if (!this->ownNode)
+    this->ownNode = std::make_unique<gz::transport::Node>();
+  return *this->ownNode;
+}
+
+////////////////////////////////////////////
+void Transport::Implementation::Subscribe(const std::string &_topic,
+    Topic *_handler)
+{
+  // only the plotted fields are decoded, msgs are parsed only if other
+  // plugins subscribed to the same topic need them
+  this->subscriptions[_topic] = this->Hub()->SubscribeRaw(
+      _topic, [_handler](const char *_data, std::size_t _size,
+      const std::string &_msgType)
+      {
+        _handler->RawCallback(_data, _size, _msgType);
+      }, this->maxRate);
+}
+
 ////////////////////////////////////////////
 Transport::Transport():
   dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -400,9 +1341,10 @@ Transport::Transport():
 ////////////////////////////////////////////
 Transport::~Transport()
 {
-  // unsubscribe from all topics in the transport
+  // unsubscribe from all topics before deleting their handlers
+  this->dataPtr->subscriptions.clear();
   for (const auto &topic : this->dataPtr->topics)
-    this->dataPtr->node.Unsubscribe(topic.first);
+    delete topic.second;
 }
 
 ////////////////////////////////////////////
@@ -417,7 +1359,8 @@ void Transport::Unsubscribe(const std::string &_topic,
     // if there is no registered fields, unsubscribe from the topic
     if (this->dataPtr->topics[_topic]->FieldCount() == 0)
     {
-      this->dataPtr->node.Unsubscribe(_topic);
+      this->dataPtr->subscriptions.erase(_topic);
+      delete this->dataPtr->topics[_topic];
       this->dataPtr->topics.erase(_topic);
     }
   }
@@ -435,19 +1378,31 @@ void Transport::Subscribe(const std::string &_topic,
     this->dataPtr->topics[_topic] = topicHandler;
 
     topicHandler->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback, topicHandler);
+    auto sampling = this->dataPtr->sampling.find({_topic, _fieldPath});
+    if (sampling != this->dataPtr->sampling.end())
+    {
+      topicHandler->SetSamplingPolicy(_fieldPath, sampling->second.first,
+          sampling->second.second);
+    }
 
     topicHandler->SetPlottingTimeRef(_time);
 
     connect(topicHandler, SIGNAL(plot(int, QString, double, double)),
             this, SLOT(onPlot(int, QString, double, double)));
+    connect(topicHandler, &Topic::plotBatch, this, &Transport::plotBatch);
+
+    this->dataPtr->Subscribe(_topic, topicHandler);
   }
   // already exist topic
   else
   {
     this->dataPtr->topics[_topic]->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback,
-                                  this->dataPtr->topics[_topic]);
+    auto sampling = this->dataPtr->sampling.find({_topic, _fieldPath});
+    if (sampling != this->dataPtr->sampling.end())
+    {
+      this->dataPtr->topics[_topic]->SetSamplingPolicy(_fieldPath,
+          sampling->second.first, sampling->second.second);
+    }
   }
 }
 
@@ -457,27 +1412,71 @@ const std::map<std::string, Topic*> &Transport::Topics()
   return this->dataPtr->topics;
 }
 
+//////////////////////////////////////////////////////
+void Transport::SetSamplingPolicy(const std::string &_topic,
+                                  const std::string &_fieldPath,
+                                  SamplingPolicy _policy, double _period)
+{
+  this->dataPtr->sampling[{_topic, _fieldPath}] = {_policy, _period};
+
+  auto topic = this->dataPtr->topics.find(_topic);
+  if (topic != this->dataPtr->topics.end())
+    topic->second->SetSamplingPolicy(_fieldPath, _policy, _period);
+}
+
+//////////////////////////////////////////////////////
+void Transport::SetMaxRate(double _rate)
+{
+  _rate = std::max(0.0, _rate);
+  if (_rate == this->dataPtr->maxRate)
+    return;
+  this->dataPtr->maxRate = _rate;
+
+  // The new subscription is made before the old one ends, so the topic
+  // stays subscribed
+  for (const auto &topic : this->dataPtr->topics)
+    this->dataPtr->Subscribe(topic.first, topic.second);
+}
+
+//////////////////////////////////////////////////////
+double Transport::MaxRate() const
+{
+  return this->dataPtr->maxRate;
+}
+
 //////////////////////////////////////////////////////
 void Transport::onPlot(int _chart, QString _fieldID, double _x, double _y)
 {
   emit this->plot(_chart, _fieldID, _x, _y);
 }
 
+//////////////////////////////////////////////////////
+void Transport::FlushGui()
+{
+  for (const auto &topic : this->dataPtr->topics)
+    topic.second->FlushGui();
+}
+
 //////////////////////////////////////////////////////
 void Transport::UnsubscribeOutdatedTopics()
 {
   // get all topics in the transport
   std::vector<std::string> topics;
-  this->dataPtr->node.TopicList(topics);
+  this->dataPtr->Node().TopicList(topics);
 
-  for (const auto &topic : this->dataPtr->topics)
+  for (auto topic = this->dataPtr->topics.begin();
+       topic != this->dataPtr->topics.end();)
   {
     // check if the topic exist
-    if (std::find(topics.begin(), topics.end(), topic.first) == topics.end())
+    if (std::find(topics.begin(), topics.end(), topic->first) == topics.end())
     {
-      this->dataPtr->node.Unsubscribe(topic.first);
-      delete topic.second;
-      this->dataPtr->topics.erase(topic.first);
+      this->dataPtr->subscriptions.erase(topic->first);
+      delete topic->second;
+      topic = this->dataPtr->topics.erase(topic);
+    }
+    else
+    {
+      ++topic;
     }
   }
 }
@@ -489,15 +1488,28 @@ PlottingInterface::PlottingInterface():
   connect(&this->dataPtr->transport,
           SIGNAL(plot(int, QString, double, double)), this,
           SLOT(onPlot(int, QString, double, double)));
+  connect(&this->dataPtr->transport, &Transport::plotBatch, this,
+          &PlottingInterface::onPlotBatch);
 
   this->dataPtr->timeout = 1;
   this->InitTimer();
 
   App()->Engine()->rootContext()->setContextProperty("PlottingIface", this);
+  qmlRegisterType<PlotLines>("GzPlotting", 1, 0, "PlotLines");
 }
 
 //////////////////////////////////////////////////////
-PlottingInterface::~PlottingInterface() = default;
+PlottingInterface::~PlottingInterface()
+{
+  // the export thread emits from this object
+  if (this->dataPtr->exportThread.joinable())
+    this->dataPtr->exportThread.join();
+
+  // spectrum tasks post to this object
+  auto *app = App();
+  if (this->dataPtr->usesTasks && nullptr != app)
+    app->Tasks()->CancelOwner(this);
+}
 
 //////////////////////////////////////////////////////
 void PlottingInterface::unsubscribe(int _chart,
@@ -507,6 +1519,10 @@ void PlottingInterface::unsubscribe(int _chart,
   this->dataPtr->transport.Unsubscribe(_topic.toStdString(),
                                        _fieldPath.toStdString(),
                                        _chart);
+  this->dataPtr->store.erase(
+      {_chart, _topic.toStdString() + "-" + _fieldPath.toStdString()});
+  this->dataPtr->analyses.erase(
+      {_chart, _topic.toStdString() + "-" + _fieldPath.toStdString()});
 }
 
 //////////////////////////////////////////////////////
@@ -516,34 +1532,308 @@ float PlottingInterface::Timeout() const
 }
 
 //////////////////////////////////////////////////////
+bool PlottingInterface::SetClock(PlotClock _clock,
+                                 const std::string &_statsTopic)
+{
+  if (_clock == PlotClock::SIM_TIME && _statsTopic.empty())
+  {
+    gzerr << "A world statistics topic is needed for the sim time clock"
+          << std::endl;
+    return false;
+  }
+
+  if (!this->dataPtr->clockTopic.empty())
+  {
+    this->dataPtr->clockNode.Unsubscribe(this->dataPtr->clockTopic);
+    this->dataPtr->clockTopic.clear();
+  }
+
+  if (_clock == PlotClock::STEADY)
+  {
+    // carry on from the current time
+    this->dataPtr->start = std::chrono::steady_clock::now() -
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(*this->dataPtr->plottingTimeRef));
+    this->dataPtr->clock = _clock;
+    return true;
+  }
+
+  auto timeRef = this->dataPtr->plottingTimeRef;
+  std::function<void(const msgs::WorldStatistics &)> cb =
+      [timeRef](const msgs::WorldStatistics &_msg)
+      {
+        *timeRef = _msg.sim_time().sec() +
+            _msg.sim_time().nsec() * std::pow(10, -9);
+      };
+  if (!this->dataPtr->clockNode.Subscribe(_statsTopic, cb))
+  {
+    gzerr << "Failed to subscribe to [" << _statsTopic << "]" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->clockTopic = _statsTopic;
+  this->dataPtr->clock = _clock;
+  return true;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetSamplingPolicy(const std::string &_topic,
+                                          const std::string &_fieldPath,
+                                          SamplingPolicy _policy,
+                                          double _period)
+{
+  this->dataPtr->transport.SetSamplingPolicy(_topic, _fieldPath, _policy,
+      _period);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetMaxRate(double _rate)
+{
+  this->dataPtr->transport.SetMaxRate(_rate);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetRetention(double _window)
+{
+  this->dataPtr->retention = _window;
+  for (auto &series : this->dataPtr->store)
+    series.second.SetRetention(_window);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetMaxPoints(std::size_t _maxPoints)
+{
+  this->dataPtr->maxPoints = _maxPoints;
+  for (auto &series : this->dataPtr->store)
+    series.second.SetMaxPoints(_maxPoints);
+}
+
+//////////////////////////////////////////////////////
+QVariantList PlottingInterface::Points(int _chart,
+                                       const QString &_fieldID) const
+{
+  QVariantList list;
+  auto it = this->dataPtr->store.find({_chart, _fieldID.toStdString()});
+  if (it == this->dataPtr->store.end())
+    return list;
+
+  const auto points = it->second.Points();
+  list.reserve(static_cast<int>(points.size()));
+  for (const auto &point : points)
+    list.append(QPointF(point.X(), point.Y()));
+  return list;
+}
+
+//////////////////////////////////////////////////////
+QVariantList PlottingInterface::decimated(int _chart, QString _fieldID,
+                                          double _xMin, double _xMax,
+                                          int _buckets)
+{
+  QVariantList list;
+  if (_buckets <= 0)
+    return list;
+
+  std::vector<math::Vector2d> points;
+  const auto buckets = static_cast<unsigned int>(_buckets);
+  if (const auto *series = this->Series(_chart, _fieldID))
+    points = series->Decimated(_xMin, _xMax, buckets);
+  else if (const auto *recording = this->Recording(_chart, _fieldID))
+    points = recording->Decimated(_xMin, _xMax, buckets);
+  list.reserve(static_cast<int>(points.size()));
+  for (const auto &point : points)
+    list.append(QPointF(point.X(), point.Y()));
+  return list;
+}
+
+//////////////////////////////////////////////////////
+const TimeSeries *PlottingInterface::Series(int _chart,
+                                            const QString &_fieldID) const
+{
+  auto it = this->dataPtr->store.find({_chart, _fieldID.toStdString()});
+  if (it == this->dataPtr->store.end())
+    return nullptr;
+  return &it->second;
+}
+
+//////////////////////////////////////////////////////
+QString PlottingInterface::loadRecording(int _chart, QString _path)
+{
+  const QUrl url(_path);
+  const std::string path = url.isLocalFile() ?
+      url.toLocalFile().toStdString() : _path.toStdString();
+  const std::string id = "recording-" + path;
+
+  auto &recording = this->dataPtr->recordings[{_chart, id}];
+  if (!recording)
+    recording = std::make_unique<RecordedSeries>();
+  if (!recording->IsOpen() && !recording->Open(path))
+  {
+    this->dataPtr->recordings.erase({_chart, id});
+    return QString();
+  }
+  return QString::fromStdString(id);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::unloadRecording(int _chart, QString _fieldID)
+{
+  this->dataPtr->recordings.erase({_chart, _fieldID.toStdString()});
+}
+
+//////////////////////////////////////////////////////
+QPointF PlottingInterface::recordingSpan(int _chart, QString _fieldID) const
+{
+  const auto *recording = this->Recording(_chart, _fieldID);
+  if (nullptr == recording)
+    return QPointF();
+  return QPointF(recording->Start(), recording->End());
+}
+
+//////////////////////////////////////////////////////
+const RecordedSeries *PlottingInterface::Recording(int _chart,
+    const QString &_fieldID) const
+{
+  auto it = this->dataPtr->recordings.find({_chart, _fieldID.toStdString()});
+  if (it == this->dataPtr->recordings.end())
+    return nullptr;
+  return it->second.get();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::OfferRecording(int _chart, const QString &_path)
+{
+  emit this->recordingOffered(_chart, _path);
+}
+
 void PlottingInterface::onComponentSubscribe(QString _entity, QString _typeId,
                                              QString _type, QString _attribute,
                                              int _chart)
 {
-  // convert the strings into
-  uint64_t entity, typeId;
-  std::istringstream issEntity(_entity.toStdString());
-  issEntity >> entity;
-  std::istringstream issTypeId(_typeId.toStdString());
-  issTypeId >> typeId;
-
-  emit this->ComponentSubscribe(entity, typeId, _type.toStdString(),
-                                _attribute.toStdString(), _chart);
+  QVariantMap component;
+  component["entity"] = _entity;
+  component["typeId"] = _typeId;
+  component["type"] = _type;
+  component["attribute"] = _attribute;
+  this->onComponentSubscribeBatch({component}, _chart);
 }
 
 //////////////////////////////////////////////////////
 void PlottingInterface::onComponentUnSubscribe(QString _entity, QString _typeId,
                                                QString _attribute, int _chart)
 {
-  // convert the strings into
-  uint64_t entity, typeId;
-  std::istringstream issEntity(_entity.toStdString());
-  issEntity >> entity;
-  std::istringstream issTypeId(_typeId.toStdString());
-  issTypeId >> typeId;
+  QVariantMap component;
+  component["entity"] = _entity;
+  component["typeId"] = _typeId;
+  component["attribute"] = _attribute;
+  this->onComponentUnSubscribeBatch({component}, _chart);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::onComponentSubscribeBatch(QVariantList _components,
+                                                  int _chart)
+{
+  this->SubscribeComponents(ParseComponents(_components, _chart));
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::onComponentUnSubscribeBatch(QVariantList _components,
+                                                    int _chart)
+{
+  this->UnsubscribeComponents(ParseComponents(_components, _chart));
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SubscribeComponents(
+    const std::vector<PlotComponentSubscription> &_subscriptions)
+{
+  if (_subscriptions.empty())
+    return;
+
+  for (const auto &sub : _subscriptions)
+  {
+    auto &target = this->dataPtr->components[
+        {sub.entity, sub.typeId, sub.attribute}];
+    if (target.fieldID.isEmpty())
+    {
+      target.fieldID = QString::number(sub.entity) + "," +
+          QString::number(sub.typeId) + "," +
+          QString::fromStdString(sub.attribute);
+    }
+    target.charts.insert(sub.chart);
+  }
+
+  if (this->isSignalConnected(QMetaMethod::fromSignal(
+      &PlottingInterface::ComponentSubscribeBatch)))
+  {
+    emit this->ComponentSubscribeBatch(_subscriptions);
+    return;
+  }
+  for (const auto &sub : _subscriptions)
+  {
+    emit this->ComponentSubscribe(sub.entity, sub.typeId, sub.type,
+                                  sub.attribute, sub.chart);
+  }
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::UnsubscribeComponents(
+    const std::vector<PlotComponentSubscription> &_subscriptions)
+{
+  if (_subscriptions.empty())
+    return;
 
-  emit this->ComponentUnSubscribe(entity, typeId,
-                                  _attribute.toStdString(), _chart);
+  if (this->isSignalConnected(QMetaMethod::fromSignal(
+      &PlottingInterface::ComponentUnSubscribeBatch)))
+  {
+    emit this->ComponentUnSubscribeBatch(_subscriptions);
+  }
+  else
+  {
+    for (const auto &sub : _subscriptions)
+    {
+      emit this->ComponentUnSubscribe(sub.entity, sub.typeId,
+                                      sub.attribute, sub.chart);
+    }
+  }
+
+  for (const auto &sub : _subscriptions)
+  {
+    const std::pair<int, std::string> key{sub.chart,
+        std::to_string(sub.entity) + "," + std::to_string(sub.typeId) +
+        "," + sub.attribute};
+    this->dataPtr->store.erase(key);
+    this->dataPtr->analyses.erase(key);
+
+    auto target = this->dataPtr->components.find(
+        {sub.entity, sub.typeId, sub.attribute});
+    if (target == this->dataPtr->components.end())
+      continue;
+    target->second.charts.erase(sub.chart);
+    if (target->second.charts.empty())
+      this->dataPtr->components.erase(target);
+  }
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::PlotComponents(double _time,
+    const std::vector<PlotComponentValue> &_values)
+{
+  std::map<std::pair<int, QString>, QVariantList> batches;
+  for (const auto &value : _values)
+  {
+    auto target = this->dataPtr->components.find(
+        {value.entity, value.typeId, value.attribute});
+    if (target == this->dataPtr->components.end())
+      continue;
+    for (const int chart : target->second.charts)
+    {
+      batches[{chart, target->second.fieldID}].append(
+          QPointF(_time, value.value));
+    }
+  }
+
+  for (const auto &[key, points] : batches)
+    this->onPlotBatch(key.first, key.second, points);
 }
 
 //////////////////////////////////////////////////////
@@ -562,6 +1852,12 @@ void PlottingInterface::InitTimer()
   this->dataPtr->timer.setInterval(this->dataPtr->timeout);
   connect(&this->dataPtr->timer, SIGNAL(timeout()), this, SLOT(UpdateTime()));
   this->dataPtr->timer.start();
+
+  // 1/60 Period like the GuiSystem frequency (60Hz)
+  this->dataPtr->flushTimer.setInterval(16);
+  connect(&this->dataPtr->flushTimer, SIGNAL(timeout()), this,
+          SLOT(FlushGui()));
+  this->dataPtr->flushTimer.start();
 }
 
 //////////////////////////////////////////////////////
@@ -573,20 +1869,181 @@ void PlottingInterface::onPlot(int _chart, QString _fieldID,
   if (static_cast<int>(_x) == DEFAULT_TIME)
       _x = *this->dataPtr->plottingTimeRef;
 
+  this->dataPtr->Series(_chart, _fieldID).Append(_x, _y);
+  this->dataPtr->Analyze(this, _chart, _fieldID, {QPointF(_x, _y)});
   emit this->plot(_chart, _fieldID, _x, _y);
 }
 
+//////////////////////////////////////////////////////
+void PlottingInterface::onPlotBatch(int _chart, QString _fieldID,
+                                    QVariantList _points)
+{
+  auto &series = this->dataPtr->Series(_chart, _fieldID);
+  std::vector<QPointF> values;
+  values.reserve(static_cast<std::size_t>(_points.size()));
+  for (const auto &point : _points)
+  {
+    values.push_back(point.toPointF());
+    series.Append(values.back().x(), values.back().y());
+  }
+  this->dataPtr->Analyze(this, _chart, _fieldID, values);
+  emit this->plotBatch(_chart, _fieldID, _points);
+}
+
+//////////////////////////////////////////////////////
+TimeSeries &PlottingInterface::Implementation::Series(int _chart,
+    const QString &_fieldID)
+{
+  auto [it, inserted] = this->store.try_emplace(
+      {_chart, _fieldID.toStdString()});
+  if (inserted)
+  {
+    it->second.SetRetention(this->retention);
+    if (this->maxPoints > 0)
+      it->second.SetMaxPoints(this->maxPoints);
+  }
+  return it->second;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::Implementation::Analyze(PlottingInterface *_owner,
+    int _chart, const QString &_fieldID, const std::vector<QPointF> &_points)
+{
+  auto [it, inserted] = this->analyses.try_emplace(
+      {_chart, _fieldID.toStdString()});
+  auto &analysis = it->second;
+  if (inserted)
+    analysis.statistics.SetWindow(this->statisticsWindow);
+
+  bool ready{false};
+  for (const auto &point : _points)
+  {
+    analysis.statistics.Add(point.x(), point.y());
+    if (analysis.spectrum)
+      ready = analysis.spectrum->Add(point.x(), point.y()) || ready;
+  }
+  if (!ready || analysis.pending)
+    return;
+
+  // Windows are small, the copy keeps the task away from the GUI thread's
+  // data
+  analysis.pending = true;
+  this->usesTasks = true;
+  auto key = it->first;
+  App()->Tasks()->Submit(
+      [_owner, key, values = analysis.spectrum->Window(),
+       sampleRate = analysis.spectrum->SampleRate()]()
+      {
+        auto amplitudes = Spectrum::Amplitudes(values);
+        QMetaObject::invokeMethod(_owner, [_owner, key, sampleRate,
+            amplitudes = std::move(amplitudes)]() mutable
+            {
+              auto found = _owner->dataPtr->analyses.find(key);
+              if (found == _owner->dataPtr->analyses.end())
+                return;
+              found->second.pending = false;
+
+              // Dropped if the spectrum was stopped or resized meanwhile
+              const auto &spectrum = found->second.spectrum;
+              if (!spectrum || amplitudes.size() != spectrum->Size() / 2 + 1)
+                return;
+              found->second.amplitudes = std::move(amplitudes);
+              found->second.sampleRate = sampleRate;
+              emit _owner->spectrumChanged(key.first,
+                  QString::fromStdString(key.second));
+            }, Qt::QueuedConnection);
+      }, TaskPool::Priority::LOW, _owner);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::SetStatisticsWindow(double _window)
+{
+  this->dataPtr->statisticsWindow = _window;
+  for (auto &analysis : this->dataPtr->analyses)
+    analysis.second.statistics.SetWindow(_window);
+}
+
+//////////////////////////////////////////////////////
+QVariantMap PlottingInterface::statistics(int _chart, QString _fieldID) const
+{
+  QVariantMap map;
+  auto it = this->dataPtr->analyses.find({_chart, _fieldID.toStdString()});
+  if (it == this->dataPtr->analyses.end())
+    return map;
+
+  const auto &stats = it->second.statistics;
+  map["count"] = static_cast<qulonglong>(stats.Count());
+  map["mean"] = stats.Mean();
+  map["variance"] = stats.Variance();
+  map["stdDev"] = stats.StdDev();
+  map["rms"] = stats.Rms();
+  map["min"] = stats.Min();
+  map["max"] = stats.Max();
+  return map;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::setSpectrum(int _chart, QString _fieldID, int _size)
+{
+  auto [it, inserted] = this->dataPtr->analyses.try_emplace(
+      {_chart, _fieldID.toStdString()});
+  auto &analysis = it->second;
+  if (inserted)
+    analysis.statistics.SetWindow(this->dataPtr->statisticsWindow);
+
+  analysis.amplitudes.clear();
+  analysis.sampleRate = 0.0;
+  if (_size <= 0)
+    analysis.spectrum.reset();
+  else
+    analysis.spectrum =
+        std::make_unique<Spectrum>(static_cast<std::size_t>(_size));
+}
+
+//////////////////////////////////////////////////////
+QVariantMap PlottingInterface::spectrum(int _chart, QString _fieldID) const
+{
+  QVariantMap map;
+  auto it = this->dataPtr->analyses.find({_chart, _fieldID.toStdString()});
+  if (it == this->dataPtr->analyses.end() || it->second.amplitudes.empty())
+    return map;
+
+  const auto &analysis = it->second;
+  QVariantList amplitudes;
+  amplitudes.reserve(static_cast<int>(analysis.amplitudes.size()));
+  for (const double amplitude : analysis.amplitudes)
+    amplitudes.append(amplitude);
+
+  map["sampleRate"] = analysis.sampleRate;
+  map["dominant"] = Spectrum::Dominant(analysis.amplitudes,
+      analysis.sampleRate);
+  map["amplitudes"] = amplitudes;
+  return map;
+}
+
 //////////////////////////////////////////////////////
 void PlottingInterface::UpdateTime()
 {
-  *this->dataPtr->plottingTimeRef += this->dataPtr->timeout * 0.001;
+  // Sampled instead of incremented, so a late timer doesn't make the plotting
+  // time drift
+  if (this->dataPtr->clock != PlotClock::STEADY)
+    return;
+
+  *this->dataPtr->plottingTimeRef = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - this->dataPtr->start).count();
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::FlushGui()
+{
+  this->dataPtr->transport.FlushGui();
 }
 
 //////////////////////////////////////////////////////
 std::string PlottingInterface::FilePath(QString _path, std::string _name,
                                         std::string _extention)
 {
-  if (_extention != "csv" && _extention != "pdf")
+  if (_extention != "csv" && _extention != "bin" && _extention != "pdf")
     return "";
 
   if (_path.toStdString().size() < 8)
@@ -609,10 +2066,25 @@ std::string PlottingInterface::FilePath(QString _path, std::string _name,
 bool PlottingInterface::exportCSV(QString _path, int _chart,
                                   QMap< QString, QVariant> _serieses)
 {
-  std::string plotName = "Plot" + std::to_string(_chart);
+  return this->exportData(_path, _chart, _serieses, "csv");
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::exportData(QString _path, int _chart,
+                                   QMap< QString, QVariant> _serieses,
+                                   QString _format)
+{
+  const auto extension = _format.toStdString();
+  if (extension != "csv" && extension != "bin")
+  {
+    gzwarn << "Unknown export format [" << extension << "]" << std::endl;
+    return false;
+  }
 
-  std::ofstream file;
+  std::string plotName = "Plot" + std::to_string(_chart);
 
+  // Copy the values on this thread, the files are written in the background
+  std::vector<ExportJob> jobs;
   QMap<QString, QVariant>::const_iterator series = _serieses.constBegin();
   while (series != _serieses.constEnd())
   {
@@ -641,7 +2113,7 @@ bool PlottingInterface::exportCSV(QString _path, int _chart,
 
     auto name = plotName +  "_" + key;
 
-    auto filePath = this->FilePath(_path , name, "csv");
+    auto filePath = this->FilePath(_path , name, extension);
 
     if (!filePath.size())
     {
@@ -649,22 +2121,350 @@ bool PlottingInterface::exportCSV(QString _path, int _chart,
         return false;
     }
 
-    file.open(filePath);
-    if (!file.is_open())
-        gzwarn << "[Couldn't open file: " << filePath << "]" << std::endl;
-
-    file << "time, " << key << std::endl;
+    ExportJob job;
+    job.filePath = filePath;
+    job.name = key;
 
-    auto points = series.value().toList();
-    for (int j = 0 ; j < points.size(); j++)
+    // full resolution values if they're stored, the chart only has a
+    // decimated view of them
+    auto stored = this->dataPtr->store.find(
+        {_chart, series.key().toStdString()});
+    if (stored != this->dataPtr->store.end())
     {
-        auto point = points.at(j).toPointF();
-        file << point.x() << ", " << point.y() << std::endl;
+      job.points = stored->second.Points();
+    }
+    else
+    {
+      auto points = series.value().toList();
+      job.points.reserve(points.size());
+      for (const auto &value : points)
+      {
+        auto point = value.toPointF();
+        job.points.emplace_back(point.x(), point.y());
+      }
     }
 
-    file.close();
+    jobs.push_back(std::move(job));
     ++series;
   }
+
+  for (auto &job : jobs)
+    job.binary = extension == "bin";
+
+  // Exports are written one after the other by a single thread
+  std::lock_guard<std::mutex> lock(this->dataPtr->exportMutex);
+  this->dataPtr->exportQueue.push_back(std::move(jobs));
+  if (this->dataPtr->exporting)
+    return true;
+
+  if (this->dataPtr->exportThread.joinable())
+    this->dataPtr->exportThread.join();
+
+  this->dataPtr->exporting = true;
+  this->dataPtr->exportThread = std::thread([this]()
+  {
+    while (true)
+    {
+      std::vector<ExportJob> next;
+      {
+        std::lock_guard<std::mutex> threadLock(this->dataPtr->exportMutex);
+        if (this->dataPtr->exportQueue.empty())
+        {
+          this->dataPtr->exporting = false;
+          return;
+        }
+        next = std::move(this->dataPtr->exportQueue.front());
+        this->dataPtr->exportQueue.pop_front();
+      }
+      emit this->exportFinished(WriteJobs(next));
+    }
+  });
   return true;
 }
+
+/// \brief Private data of PlotLines
+class PlotLines::Implementation
+{
+  /// \brief A drawn series
+  public: struct Line
+  {
+    /// \brief Line color
+    QColor color;
+
+    /// \brief Decimated values
+    DecimatedView view;
+
+    /// \brief True if the series is a recording
+    bool recording{false};
+
+    /// \brief Decimated values of a recording
+    std::vector<math::Vector2d> recorded;
+
+    /// \brief Time range and number of slices of `recorded`
+    std::tuple<double, double, unsigned int> recordedRange{0.0, 0.0, 0};
+
+    /// \brief Get the decimated values
+    /// \return Values of the recording or the live series
+    const std::vector<math::Vector2d> &Points() const
+    {
+      return this->recording ? this->recorded : this->view.Points();
+    }
+  };
+
+  /// \brief Interface storing the series
+  public: QPointer<PlottingInterface> source;
+
+  /// \brief Connections to `source`
+  public: std::vector<QMetaObject::Connection> connections;
+
+  /// \brief Chart ID of the series
+  public: int chart{-1};
+
+  /// \brief Range shown
+  public: QRectF range;
+
+  /// \brief Drawn series, by field ID. Read by the render thread while the
+  /// GUI thread is blocked.
+  public: std::map<QString, Line> lines;
+
+  /// \brief Whether the vertices must be written again though no values
+  /// changed, such as when colors change
+  public: bool rebuild{true};
+
+  /// \brief Time and value subtracted from the vertices, so they keep
+  /// their precision as floats
+  public: QPointF origin;
+};
+
+/////////////////////////////////////////////////
+PlotLines::PlotLines(QQuickItem *_parent)
+  : QQuickItem(_parent),
+    dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+  this->setFlag(QQuickItem::ItemHasContents);
+  this->connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+  this->connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
+}
+
+/////////////////////////////////////////////////
+PlotLines::~PlotLines() = default;
+
+/////////////////////////////////////////////////
+QObject *PlotLines::Source() const
+{
+  return this->dataPtr->source;
+}
+
+/////////////////////////////////////////////////
+void PlotLines::SetSource(QObject *_source)
+{
+  auto *source = qobject_cast<PlottingInterface *>(_source);
+  if (source == this->dataPtr->source)
+    return;
+
+  for (const auto &connection : this->dataPtr->connections)
+    this->disconnect(connection);
+  this->dataPtr->connections.clear();
+
+  this->dataPtr->source = source;
+  if (source)
+  {
+    // Redrawn at most once per frame, however many values arrive
+    this->dataPtr->connections.push_back(this->connect(source,
+        &PlottingInterface::plot, this,
+        [this](int _chart, QString, double, double)
+        {
+          if (_chart == this->dataPtr->chart)
+            this->update();
+        }));
+    this->dataPtr->connections.push_back(this->connect(source,
+        &PlottingInterface::plotBatch, this,
+        [this](int _chart, QString, QVariantList)
+        {
+          if (_chart == this->dataPtr->chart)
+            this->update();
+        }));
+  }
+  this->update();
+  emit this->SourceChanged();
+}
+
+/////////////////////////////////////////////////
+int PlotLines::ChartID() const
+{
+  return this->dataPtr->chart;
+}
+
+/////////////////////////////////////////////////
+void PlotLines::SetChartID(int _chart)
+{
+  if (_chart == this->dataPtr->chart)
+    return;
+  this->dataPtr->chart = _chart;
+  for (auto &line : this->dataPtr->lines)
+  {
+    line.second.view.Reset();
+    line.second.recording = false;
+  }
+  this->dataPtr->rebuild = true;
+  this->update();
+  emit this->ChartIDChanged();
+}
+
+/////////////////////////////////////////////////
+QRectF PlotLines::Range() const
+{
+  return this->dataPtr->range;
+}
+
+/////////////////////////////////////////////////
+void PlotLines::SetRange(const QRectF &_range)
+{
+  if (_range == this->dataPtr->range)
+    return;
+  this->dataPtr->range = _range;
+  this->update();
+  emit this->RangeChanged();
+}
+
+/////////////////////////////////////////////////
+void PlotLines::setSeries(const QString &_fieldID, const QColor &_color)
+{
+  this->dataPtr->lines[_fieldID].color = _color;
+  this->dataPtr->rebuild = true;
+  this->update();
+}
+
+/////////////////////////////////////////////////
+void PlotLines::removeSeries(const QString &_fieldID)
+{
+  if (this->dataPtr->lines.erase(_fieldID) == 0)
+    return;
+  this->dataPtr->rebuild = true;
+  this->update();
+}
+
+/////////////////////////////////////////////////
+QSGNode *PlotLines::updatePaintNode(QSGNode *_node, UpdatePaintNodeData *)
+{
+  auto *transform = static_cast<QSGTransformNode *>(_node);
+  QSGGeometryNode *node{nullptr};
+  if (nullptr == transform)
+  {
+    transform = new QSGTransformNode();
+    node = new QSGGeometryNode();
+    auto *geometry = new QSGGeometry(
+        QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawLines);
+    geometry->setLineWidth(1);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setMaterial(new QSGVertexColorMaterial());
+    node->setFlag(QSGNode::OwnsMaterial);
+    transform->appendChildNode(node);
+    this->dataPtr->rebuild = true;
+  }
+  else
+  {
+    node = static_cast<QSGGeometryNode *>(transform->firstChild());
+  }
+
+  const auto &range = this->dataPtr->range;
+  const double width = this->width();
+  const double height = this->height();
+  if (width <= 0.0 || height <= 0.0 || range.width() <= 0.0 ||
+      range.height() <= 0.0)
+  {
+    node->geometry()->allocate(0);
+    node->markDirty(QSGNode::DirtyGeometry);
+    this->dataPtr->rebuild = true;
+    return transform;
+  }
+
+  // One slice per pixel column
+  const auto buckets = static_cast<unsigned int>(std::ceil(width));
+  bool changed = this->dataPtr->rebuild;
+  int vertexCount{0};
+  for (auto &[fieldID, line] : this->dataPtr->lines)
+  {
+    const TimeSeries *series = this->dataPtr->source ?
+        this->dataPtr->source->Series(this->dataPtr->chart, fieldID) :
+        nullptr;
+    const RecordedSeries *recording =
+        nullptr == series && this->dataPtr->source ?
+        this->dataPtr->source->Recording(this->dataPtr->chart, fieldID) :
+        nullptr;
+    if (recording)
+    {
+      // Only decimated again when the range or the width changes
+      const auto recordedRange = std::make_tuple(range.left(),
+          range.right(), buckets);
+      if (!line.recording || recordedRange != line.recordedRange)
+      {
+        line.recorded = recording->Decimated(range.left(), range.right(),
+            buckets);
+        line.recordedRange = recordedRange;
+        line.recording = true;
+        changed = true;
+      }
+    }
+    else if (nullptr == series)
+    {
+      changed = changed || !line.Points().empty();
+      line.view.Reset();
+      line.recorded.clear();
+      line.recording = false;
+      continue;
+    }
+    else
+    {
+      changed = line.view.Update(*series, range.left(), range.right(),
+          buckets) || changed;
+    }
+    const auto count = static_cast<int>(line.Points().size());
+    if (count > 1)
+      vertexCount += 2 * (count - 1);
+  }
+
+  // All series in a single geometry, one segment per pair of vertices
+  if (changed)
+  {
+    this->dataPtr->origin = range.topLeft();
+    const auto &origin = this->dataPtr->origin;
+    auto *geometry = node->geometry();
+    geometry->allocate(vertexCount);
+    auto *vertex = geometry->vertexDataAsColoredPoint2D();
+    for (const auto &[fieldID, line] : this->dataPtr->lines)
+    {
+      const auto &points = line.Points();
+      const auto color = line.color.toRgb();
+      const auto alpha = color.alpha();
+      const auto r = static_cast<uchar>(color.red() * alpha / 255);
+      const auto g = static_cast<uchar>(color.green() * alpha / 255);
+      const auto b = static_cast<uchar>(color.blue() * alpha / 255);
+      const auto a = static_cast<uchar>(alpha);
+      for (std::size_t i = 1; i < points.size(); ++i)
+      {
+        (vertex++)->set(static_cast<float>(points[i - 1].X() - origin.x()),
+            static_cast<float>(points[i - 1].Y() - origin.y()), r, g, b, a);
+        (vertex++)->set(static_cast<float>(points[i].X() - origin.x()),
+            static_cast<float>(points[i].Y() - origin.y()), r, g, b, a);
+      }
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+    this->dataPtr->rebuild = false;
+  }
+
+  // From values relative to the origin to pixels, with values going up
+  const double scaleX = width / range.width();
+  const double scaleY = height / range.height();
+  QMatrix4x4 matrix;
+  matrix.translate(
+      static_cast<float>((this->dataPtr->origin.x() - range.left()) * scaleX),
+      static_cast<float>(height -
+          (this->dataPtr->origin.y() - range.top()) * scaleY));
+  matrix.scale(static_cast<float>(scaleX), static_cast<float>(-scaleY));
+  transform->setMatrix(matrix);
+  return transform;
+}
 }  // namespace gz::gui
@@ -16,10 +16,18 @@
 */
 #include <gtest/gtest.h>
 
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QPointF>
+
 #include <gz/msgs/collision.pb.h>
 #include <gz/msgs/header.pb.h>
 #include <gz/msgs/int32.pb.h>
 #include <gz/msgs/pose.pb.h>
+#include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/time.pb.h>
 #include <gz/msgs/vector3d.pb.h>
 
@@ -28,9 +36,16 @@
 #include <gz/utils/ExtraTestMacros.hh>
 
 #include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
 #include "gz/gui/Enums.hh"
 #include "gz/gui/PlottingInterface.hh"
 
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./PlottingInterface_TEST")),
+};
+
 using namespace gz;
 using namespace gui;
 
@@ -112,6 +127,223 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Topic))
   EXPECT_NE(static_cast<int>(fields["pose-position-x"]->Value()), 20);
 }
 
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(FieldPaths))
+{
+  common::Console::SetVerbosity(4);
+
+  msgs::Collision msg;
+  msg.mutable_pose()->mutable_position()->set_y(3);
+
+  auto timeRef = std::make_shared<double>(10);
+  auto topic = Topic("");
+  topic.SetPlottingTimeRef(timeRef);
+
+  topic.Register("pose-position-y", 1);
+  topic.Register("pose-orientation-w", 1);
+  topic.Register("pose-bogus-x", 1);
+  topic.Register("pose", 1);
+
+  topic.Callback(msg);
+
+  auto fields = topic.Fields();
+  EXPECT_DOUBLE_EQ(3.0, fields["pose-position-y"]->Value());
+
+  // unset msgs are read as defaults, without being created in the msg
+  EXPECT_DOUBLE_EQ(0.0, fields["pose-orientation-w"]->Value());
+  EXPECT_FALSE(msg.pose().has_orientation());
+
+  // invalid paths are skipped
+  EXPECT_DOUBLE_EQ(0.0, fields["pose-bogus-x"]->Value());
+  EXPECT_DOUBLE_EQ(0.0, fields["pose"]->Value());
+
+  // registering recompiles the paths
+  topic.Register("pose-position-x", 1);
+  msg.mutable_pose()->mutable_position()->set_x(7);
+  *timeRef += 1;
+  topic.Callback(msg);
+
+  fields = topic.Fields();
+  EXPECT_DOUBLE_EQ(7.0, fields["pose-position-x"]->Value());
+  EXPECT_DOUBLE_EQ(3.0, fields["pose-position-y"]->Value());
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RawCallback))
+{
+  common::Console::SetVerbosity(4);
+
+  msgs::Pose_V msg;
+  msg.mutable_header()->mutable_stamp()->set_sec(5);
+  msg.mutable_header()->mutable_stamp()->set_nsec(500000000);
+  for (int i = 0; i < 5000; ++i)
+  {
+    auto *pose = msg.add_pose();
+    pose->set_name("pose_" + std::to_string(i));
+    pose->mutable_position()->set_x(i * 0.5);
+    pose->set_id(i);
+  }
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+
+  auto topic = Topic("");
+  topic.Register("pose-1234-position-x", 1);
+  topic.Register("pose-4999-id", 1);
+  topic.Register("pose-5000-id", 1);
+  topic.Register("pose-1234-orientation-w", 1);
+  topic.Register("pose-position-x", 1);
+
+  // only the registered fields are decoded
+  topic.RawCallback(data.data(), data.size(), msg.GetTypeName());
+
+  auto fields = topic.Fields();
+  EXPECT_DOUBLE_EQ(617.0, fields["pose-1234-position-x"]->Value());
+  EXPECT_DOUBLE_EQ(4999.0, fields["pose-4999-id"]->Value());
+  EXPECT_DOUBLE_EQ(5.5, fields["pose-1234-position-x"]->Time());
+
+  // missing elements and unset fields read as 0, repeated fields need an
+  // index
+  EXPECT_DOUBLE_EQ(0.0, fields["pose-5000-id"]->Value());
+  EXPECT_DOUBLE_EQ(0.0, fields["pose-1234-orientation-w"]->Value());
+  EXPECT_DOUBLE_EQ(0.0, fields["pose-position-x"]->Value());
+
+  // same values as when parsing the msg
+  auto parsedTopic = Topic("");
+  parsedTopic.Register("pose-1234-position-x", 1);
+  parsedTopic.Register("pose-4999-id", 1);
+  parsedTopic.Callback(msg);
+
+  auto parsedFields = parsedTopic.Fields();
+  EXPECT_DOUBLE_EQ(617.0, parsedFields["pose-1234-position-x"]->Value());
+  EXPECT_DOUBLE_EQ(4999.0, parsedFields["pose-4999-id"]->Value());
+  EXPECT_DOUBLE_EQ(5.5, parsedFields["pose-1234-position-x"]->Time());
+
+  // truncated msgs don't crash
+  topic.RawCallback(data.data(), data.size() / 2, msg.GetTypeName());
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(FlushGui))
+{
+  common::Console::SetVerbosity(4);
+
+  auto timeRef = std::make_shared<double>(10);
+  auto topic = Topic("/batch");
+  topic.SetPlottingTimeRef(timeRef);
+  topic.Register("data", 1);
+  topic.Register("data", 2);
+
+  std::map<int, std::vector<QPointF>> received;
+  std::vector<std::string> ids;
+  QObject::connect(&topic, &Topic::plotBatch,
+      [&](int _chart, QString _fieldID, QVariantList _points)
+      {
+        ids.push_back(_fieldID.toStdString());
+        for (const auto &point : _points)
+          received[_chart].push_back(point.toPointF());
+      });
+
+  // nothing to send yet
+  topic.FlushGui();
+  EXPECT_TRUE(received.empty());
+
+  // values are queued with the plotting time until flushed
+  msgs::Int32 msg;
+  for (int i = 0; i < 3; ++i)
+  {
+    msg.set_data(i);
+    *timeRef += 1;
+    topic.Callback(msg);
+  }
+  EXPECT_TRUE(received.empty());
+
+  topic.FlushGui();
+  ASSERT_EQ(2u, received.size());
+  ASSERT_EQ(2u, ids.size());
+  EXPECT_EQ("/batch-data", ids[0]);
+  for (const auto &chart : {1, 2})
+  {
+    ASSERT_EQ(3u, received[chart].size());
+    for (int i = 0; i < 3; ++i)
+    {
+      EXPECT_DOUBLE_EQ(11.0 + i, received[chart][i].x());
+      EXPECT_DOUBLE_EQ(i, received[chart][i].y());
+    }
+  }
+
+  // already sent
+  received.clear();
+  topic.FlushGui();
+  EXPECT_TRUE(received.empty());
+}
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SamplingPolicy))
+{
+  common::Console::SetVerbosity(4);
+
+  auto timeRef = std::make_shared<double>(10);
+  auto topic = Topic("/sampling");
+  topic.SetPlottingTimeRef(timeRef);
+  topic.Register("data", 1);
+
+  std::vector<QPointF> received;
+  QObject::connect(&topic, &Topic::plotBatch,
+      [&](int, QString, QVariantList _points)
+      {
+        for (const auto &point : _points)
+          received.push_back(point.toPointF());
+      });
+
+  // 10 msgs within one sampling period
+  msgs::Int32 msg;
+  auto publish = [&]()
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      msg.set_data(i);
+      *timeRef += 0.001;
+      topic.Callback(msg);
+    }
+    topic.FlushGui();
+  };
+
+  // decimated by default, only the first one is kept
+  publish();
+  ASSERT_EQ(1u, received.size());
+  EXPECT_DOUBLE_EQ(0.0, received[0].y());
+
+  // all of them
+  received.clear();
+  topic.SetSamplingPolicy("data", SamplingPolicy::KEEP_ALL, 0.1);
+  publish();
+  ASSERT_EQ(10u, received.size());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_DOUBLE_EQ(i, received[i].y());
+
+  // averaged over 5 ms
+  received.clear();
+  topic.SetSamplingPolicy("data", SamplingPolicy::AVERAGE, 0.0045);
+  publish();
+  ASSERT_EQ(2u, received.size());
+  EXPECT_DOUBLE_EQ(0.0, received[0].y());
+  EXPECT_DOUBLE_EQ(3.0, received[1].y());
+
+  // a clock going back starts a new period
+  received.clear();
+  topic.SetSamplingPolicy("data", SamplingPolicy::DECIMATE, 1.0);
+  *timeRef = 0.0;
+  publish();
+  ASSERT_EQ(1u, received.size());
+  EXPECT_NEAR(0.001, received[0].x(), 1e-9);
+}
+
 //////////////////////////////////////////////////
 // Disable test on windows until we fix "LNK2001 unresolved external symbol"
 // error
@@ -233,6 +465,17 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Transport))
   EXPECT_EQ(topics["/test_topic"]->FieldCount(), 1);
 
 
+  // =========== Max Rate Test =================
+  EXPECT_DOUBLE_EQ(0.0, transport.MaxRate());
+  transport.SetMaxRate(-1);
+  EXPECT_DOUBLE_EQ(0.0, transport.MaxRate());
+
+  // Subscribed topics are kept, at the new rate
+  transport.SetMaxRate(5);
+  EXPECT_DOUBLE_EQ(5.0, transport.MaxRate());
+  EXPECT_EQ(2u, transport.Topics().size());
+
+
   // =========== UnSubscribe Test =================
 
   // test the deletion of the topic if it has no fields
@@ -242,3 +485,75 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Transport))
   topics = transport.Topics();
   EXPECT_EQ(static_cast<int>(topics.size()), 1);
 }
+
+//////////////////////////////////////////////////
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ComponentBatch))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+  PlottingInterface plotting;
+
+  // Without a batch receiver, one signal per attribute
+  int single{0};
+  QObject::connect(&plotting, &PlottingInterface::ComponentSubscribe,
+      [&](uint64_t, uint64_t, const std::string &, const std::string &, int)
+      {
+        ++single;
+      });
+
+  QVariantList components;
+  for (const QString attribute : {"x", "y"})
+  {
+    QVariantMap component;
+    component["entity"] = "12";
+    component["typeId"] = "34";
+    component["type"] = "Pose3d";
+    component["attribute"] = attribute;
+    components.append(component);
+  }
+  QVariantMap invalid;
+  invalid["entity"] = "twelve";
+  invalid["typeId"] = "34";
+  components.append(invalid);
+  plotting.onComponentSubscribeBatch(components, 1);
+  EXPECT_EQ(2, single);
+
+  // With one, a single signal
+  std::vector<PlotComponentSubscription> batch;
+  QObject::connect(&plotting, &PlottingInterface::ComponentSubscribeBatch,
+      [&](const std::vector<PlotComponentSubscription> &_subscriptions)
+      {
+        batch = _subscriptions;
+      });
+  plotting.SubscribeComponents({{12, 34, "Pose3d", "x", 2}});
+  EXPECT_EQ(2, single);
+  ASSERT_EQ(1u, batch.size());
+  EXPECT_EQ(12u, batch[0].entity);
+  EXPECT_EQ("x", batch[0].attribute);
+  EXPECT_EQ(2, batch[0].chart);
+
+  // A frame is sent as one batch per series
+  std::map<std::pair<int, QString>, int> batches;
+  QObject::connect(&plotting, &PlottingInterface::plotBatch,
+      [&](int _chart, QString _fieldID, QVariantList _points)
+      {
+        batches[{_chart, _fieldID}] += _points.size();
+      });
+  plotting.PlotComponents(1.5, {{12, 34, "x", 1.0}, {12, 34, "y", 2.0},
+                                {99, 34, "x", 3.0}});
+  EXPECT_EQ(3u, batches.size());
+  EXPECT_EQ(1, (batches[{1, "12,34,x"}]));
+  EXPECT_EQ(1, (batches[{1, "12,34,y"}]));
+  EXPECT_EQ(1, (batches[{2, "12,34,x"}]));
+  EXPECT_EQ(QVariantList({QPointF(1.5, 1.0)}), plotting.Points(2, "12,34,x"));
+  EXPECT_DOUBLE_EQ(2.0,
+      plotting.statistics(1, "12,34,y")["mean"].toDouble());
+
+  // Unsubscribed series are dropped
+  plotting.onComponentUnSubscribe("12", "34", "x", 1);
+  EXPECT_EQ(nullptr, plotting.Series(1, "12,34,x"));
+  batches.clear();
+  plotting.PlotComponents(2.0, {{12, 34, "x", 1.0}, {12, 34, "y", 2.0}});
+  EXPECT_EQ(2u, batches.size());
+  EXPECT_EQ(0u, (batches.count({1, "12,34,x"})));
+}
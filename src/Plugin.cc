@@ -16,13 +16,21 @@
  */
 
 #include <gz/utils/ImplPtr.hh>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include "gz/gui/Application.hh"
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/NodePool.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/StartupTrace.hh"
 
 namespace
 {
@@ -53,6 +61,35 @@ const std::unordered_set<std::string> kIgnoredProps{
     "objectName",
     "pluginName",
     "anchored"};
+
+/////////////////////////////////////////////////
+/// \brief Get the text a card property is saved as
+/// \param[in] _card Card item
+/// \param[in] _property Property of the card
+/// \param[out] _type Type, as written in the config
+/// \param[out] _value Value
+/// \return False if the property isn't saved
+bool propertyText(const QObject *_card, const QMetaProperty &_property,
+    std::string &_type, std::string &_value)
+{
+  // Explicitly skip some keys
+  if (kIgnoredProps.find(_property.name()) != kIgnoredProps.end())
+    return false;
+
+  // When setting, it will need to be string
+  _type = std::string(_property.typeName());
+  if (_type == "QString")
+    _type = "string";
+
+  if (_type != "double" && _type != "int" && _type != "bool" &&
+      _type != "string")
+  {
+    return false;
+  }
+
+  _value = _property.read(_card).toString().toStdString();
+  return true;
+}
 }  // namespace
 
 namespace gz::gui
@@ -84,6 +121,69 @@ class Plugin::Implementation
 
   /// \brief Holds all anchor information
   public: Anchors anchors;
+
+  /// \brief Whether the card changed since ConfigStr last serialized it
+  public: bool configDirty{true};
+
+  /// \brief Config last returned by ConfigStr
+  public: std::string serializedConfig;
+
+  /// \brief `serializedConfig` parsed, kept so only the card properties
+  /// which changed are written again
+  public: tinyxml2::XMLDocument configDoc;
+
+  /// \brief <gz-gui> element of `configDoc`, null until it's parsed
+  public: tinyxml2::XMLElement *guiElem{nullptr};
+
+  /// \brief <property> elements of `configDoc`, by card property index
+  public: std::unordered_map<int, tinyxml2::XMLElement *> propertyElems;
+
+  /// \brief Indices of the card properties notified by each card signal
+  public: std::unordered_map<int, std::vector<int>> propertiesBySignal;
+
+  /// \brief Indices of the card properties which changed since ConfigStr
+  /// last serialized the card
+  public: std::set<int> changedProperties;
+
+  /// \brief Whether all properties must be written again, because the
+  /// change isn't known to be limited to `changedProperties`
+  public: bool rebuildConfig{true};
+
+  /// \brief Whether Unload has been called
+  public: bool unloaded{false};
+
+  /// \brief Whether the card can't be seen. Only changed with
+  /// `suspendMutex` locked.
+  public: std::atomic<bool> suspended{false};
+
+  /// \brief Protects `suspended` changes and `pendingUpdates`
+  public: std::mutex suspendMutex;
+
+  /// \brief Latest update of each key requested while suspended
+  public: std::map<std::string, std::function<void()>> pendingUpdates;
+
+  /// \brief Timers stopped while suspended
+  public: std::vector<QPointer<QTimer>> pausableTimers;
+
+  /// \brief Timers which were active when the card was suspended
+  public: std::vector<QPointer<QTimer>> pausedTimers;
+
+  /// \brief Whether visibility changes are followed
+  public: bool followingVisibility{false};
+
+  /// \brief Follows the visibility of the card's window
+  public: QMetaObject::Connection windowConnection;
+
+  /// \brief Main window the card is in, if any, whose exposure is
+  /// followed
+  public: QPointer<MainWindow> mainWindow;
+
+  /// \brief Follows the exposure of `mainWindow`
+  public: QMetaObject::Connection exposedConnection;
+
+  /// \brief Whether tasks were submitted with RunInBackground, so they're
+  /// cancelled when unloaded or destroyed
+  public: std::atomic<bool> usesTasks{false};
 };
 
 /////////////////////////////////////////////////
@@ -94,6 +194,17 @@ Plugin::Plugin() : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 /////////////////////////////////////////////////
 Plugin::~Plugin()
 {
+  // Tasks may use the plugin
+  if (this->dataPtr->usesTasks)
+  {
+    if (auto *app = App())
+      app->Tasks()->CancelOwner(this);
+  }
+
+  // Topics and services advertised for the plugin
+  if (auto *app = App())
+    app->Nodes()->Release(this);
+
   if (this->dataPtr->pluginItem)
     delete this->dataPtr->pluginItem;
 }
@@ -137,6 +248,7 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
     return;
   }
 
+  const auto qmlStart = StartupTrace::Clock::now();
   QQmlComponent component(App()->Engine(), QString::fromStdString(qmlFile));
   if (component.isError())
   {
@@ -172,6 +284,9 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
     return;
   }
 
+  App()->Trace()->Record("QML [" + filename + "]", "qml", qmlStart,
+      StartupTrace::Clock::now());
+
   // Load common configuration
   const auto *guiElem = _pluginElem->FirstChildElement("gz-gui");
   if (guiElem)
@@ -180,6 +295,8 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
   }
 
   // Load custom configuration
+  StartupTraceZone traceZone(App()->Trace(), "LoadConfig [" + filename + "]",
+      "plugin");
   this->LoadConfig(_pluginElem);
 }
 
@@ -207,6 +324,13 @@ void Plugin::LoadCommonConfig(const tinyxml2::XMLElement *_guiElem)
       this->DeleteLater();
   }
 
+  // Transport namespace
+  elem = _guiElem->FirstChildElement("transport_namespace");
+  if (nullptr != elem && nullptr != elem->GetText() && nullptr != App())
+  {
+    App()->Nodes()->SetNamespace(this, elem->GetText());
+  }
+
   // Properties
   for (const auto *propElem = _guiElem->FirstChildElement("property");
       propElem != nullptr;
@@ -290,8 +414,83 @@ std::string Plugin::ConfigStr()
   // TODO(anyone): When plugins override this function they will lose the
   // card updates, must refactor config handling
 
+  // Unchanged since the last call
+  if (!this->dataPtr->configDirty &&
+      this->configStr == this->dataPtr->serializedConfig)
+  {
+    return this->configStr;
+  }
+
+  // Parse the config again only if it was replaced, otherwise only write
+  // the properties which changed
+  auto &doc = this->dataPtr->configDoc;
+  if (this->dataPtr->rebuildConfig || nullptr == this->dataPtr->guiElem ||
+      this->configStr != this->dataPtr->serializedConfig)
+  {
+    if (!this->ParseConfig())
+      return this->configStr;
+  }
+  else
+  {
+    for (const auto index : this->dataPtr->changedProperties)
+    {
+      auto elem = this->dataPtr->propertyElems.find(index);
+      if (elem == this->dataPtr->propertyElems.end())
+        continue;
+
+      std::string type;
+      std::string value;
+      if (propertyText(this->CardItem(),
+          this->CardItem()->metaObject()->property(index), type, value))
+      {
+        elem->second->SetText(value.c_str());
+      }
+    }
+  }
+  this->dataPtr->changedProperties.clear();
+
+  // Remove <anchors> if needed
+  // TODO(louise) Support setting anchors from UI and then saving it.
+  auto *guiElem = this->dataPtr->guiElem;
+  auto anchored = this->CardItem()->property("anchored").toBool();
+  if (!anchored)
+  {
+    for (auto *anchorElem = guiElem->FirstChildElement("anchors");
+        anchorElem != nullptr;)
+    {
+      auto *nextAnchor = anchorElem->NextSiblingElement("anchors");
+      guiElem->DeleteChild(anchorElem);
+      anchorElem = nextAnchor;
+    }
+  }
+
+  // Then convert XML back to string
+  tinyxml2::XMLPrinter printer;
+  if (!doc.FirstChildElement("plugin")->Accept(&printer))
+  {
+    // LCOV_EXCL_START
+    gzwarn << "There was an error parsing the plugin element for " <<
+        "[" << this->title << "]." << std::endl;
+    // LCOV_EXCL_STOP
+  }
+  else
+  {
+    this->configStr = std::string(printer.CStr());
+    this->dataPtr->serializedConfig = this->configStr;
+    this->dataPtr->configDirty = false;
+  }
+
+  return this->configStr;
+}
+
+/////////////////////////////////////////////////
+bool Plugin::ParseConfig()
+{
+  this->dataPtr->guiElem = nullptr;
+  this->dataPtr->propertyElems.clear();
+
   // Convert string to XML
-  tinyxml2::XMLDocument doc;
+  auto &doc = this->dataPtr->configDoc;
   doc.Parse(this->configStr.c_str());
 
   // <plugin>
@@ -301,7 +500,7 @@ std::string Plugin::ConfigStr()
     // LCOV_EXCL_START
     gzerr << "Missing <plugin> element, not updating config string."
           << std::endl;
-    return this->configStr;
+    return false;
     // LCOV_EXCL_STOP
   }
 
@@ -326,62 +525,44 @@ std::string Plugin::ConfigStr()
   const auto *meta = this->CardItem()->metaObject();
   for (int i = 0; i < meta->propertyCount(); ++i)
   {
-    const auto *key = meta->property(i).name();
-    auto type = std::string(meta->property(i).typeName());
-
-    // Explicitly skip some keys
-    if (kIgnoredProps.find(key) != kIgnoredProps.end())
-      continue;
-
-    // When setting, it will need to be string
-    if (type == "QString")
-      type = "string";
-
+    std::string type;
     std::string value;
-    if (type != "double" && type != "int" && type != "bool" && type != "string")
-    {
+    if (!propertyText(this->CardItem(), meta->property(i), type, value))
       continue;
-    }
-
-    value = this->CardItem()->property(meta->property(i).name())
-            .toString().toStdString();
 
     auto *elem = doc.NewElement("property");
-    elem->SetAttribute("key", key);
+    elem->SetAttribute("key", meta->property(i).name());
     elem->SetAttribute("type", type.c_str());
     elem->SetText(value.c_str());
     guiElem->InsertEndChild(elem);
+    this->dataPtr->propertyElems[i] = elem;
   }
 
-  // Remove <anchors> if needed
-  // TODO(louise) Support setting anchors from UI and then saving it.
-  auto anchored = this->CardItem()->property("anchored").toBool();
-  if (!anchored)
-  {
-    for (auto *anchorElem = guiElem->FirstChildElement("anchors");
-        anchorElem != nullptr;)
-    {
-      auto *nextAnchor = anchorElem->NextSiblingElement("anchors");
-      guiElem->DeleteChild(anchorElem);
-      anchorElem = nextAnchor;
-    }
-  }
+  this->dataPtr->guiElem = guiElem;
+  this->dataPtr->rebuildConfig = false;
+  return true;
+}
 
-  // Then convert XML back to string
-  tinyxml2::XMLPrinter printer;
-  if (!pluginElem->Accept(&printer))
+/////////////////////////////////////////////////
+void Plugin::MarkConfigDirty()
+{
+  this->dataPtr->configDirty = true;
+
+  // Card signals only change the properties they notify
+  auto properties = this->dataPtr->propertiesBySignal.end();
+  if (nullptr != this->dataPtr->cardItem &&
+      this->sender() == this->dataPtr->cardItem)
   {
-    // LCOV_EXCL_START
-    gzwarn << "There was an error parsing the plugin element for " <<
-        "[" << this->title << "]." << std::endl;
-    // LCOV_EXCL_STOP
+    properties = this->dataPtr->propertiesBySignal.find(
+        this->senderSignalIndex());
   }
-  else
+  if (properties == this->dataPtr->propertiesBySignal.end())
   {
-    this->configStr = std::string(printer.CStr());
+    this->dataPtr->rebuildConfig = true;
+    return;
   }
-
-  return this->configStr;
+  this->dataPtr->changedProperties.insert(properties->second.begin(),
+      properties->second.end());
 }
 
 /////////////////////////////////////////////////
@@ -404,6 +585,162 @@ bool Plugin::DeleteLaterRequested() const
   return this->dataPtr->deleteLaterRequested;
 }
 
+/////////////////////////////////////////////////
+void Plugin::Unload()
+{
+  if (this->dataPtr->unloaded)
+    return;
+  this->dataPtr->unloaded = true;
+
+  auto *app = App();
+  if (this->dataPtr->usesTasks && nullptr != app)
+    app->Tasks()->CancelOwner(this);
+
+  this->OnUnload();
+
+  if (nullptr != app)
+    app->Nodes()->Release(this);
+
+  // Plugins install themselves as filters of the application, of the main
+  // windows or of their quick windows
+  if (nullptr == app)
+    return;
+  app->removeEventFilter(this);
+  QObject::disconnect(app, nullptr, this, nullptr);
+  for (auto *window : app->findChildren<MainWindow *>())
+  {
+    window->removeEventFilter(this);
+    QObject::disconnect(window, nullptr, this, nullptr);
+    if (auto *quickWindow = window->QuickWindow())
+    {
+      quickWindow->removeEventFilter(this);
+      QObject::disconnect(quickWindow, nullptr, this, nullptr);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool Plugin::Unloaded() const
+{
+  return this->dataPtr->unloaded;
+}
+
+/////////////////////////////////////////////////
+void Plugin::OnUnload()
+{
+}
+
+/////////////////////////////////////////////////
+std::uint64_t Plugin::RunInBackground(std::function<void()> _task,
+    TaskPool::Priority _priority)
+{
+  auto *app = App();
+  if (nullptr == app)
+    return 0;
+
+  this->dataPtr->usesTasks = true;
+  return app->Tasks()->Submit(std::move(_task), _priority, this);
+}
+
+/////////////////////////////////////////////////
+void Plugin::RunOnMainThread(std::function<void()> _task)
+{
+  // Dropped by Qt if the plugin is destroyed first
+  QMetaObject::invokeMethod(this, [this, task = std::move(_task)]()
+  {
+    if (!this->dataPtr->unloaded && task)
+      task();
+  }, Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+bool Plugin::Suspended() const
+{
+  return this->dataPtr->suspended;
+}
+
+/////////////////////////////////////////////////
+void Plugin::UpdateWhenShown(const std::string &_key,
+    std::function<void()> _update)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->suspendMutex);
+    if (this->dataPtr->suspended)
+    {
+      this->dataPtr->pendingUpdates[_key] = std::move(_update);
+      return;
+    }
+  }
+  _update();
+}
+
+/////////////////////////////////////////////////
+void Plugin::PauseWhenHidden(QTimer *_timer)
+{
+  if (nullptr == _timer)
+    return;
+  this->dataPtr->pausableTimers.emplace_back(_timer);
+  if (this->dataPtr->suspended && _timer->isActive())
+  {
+    _timer->stop();
+    this->dataPtr->pausedTimers.emplace_back(_timer);
+  }
+}
+
+/////////////////////////////////////////////////
+void Plugin::UpdateSuspended()
+{
+  auto *cardItem = this->dataPtr->cardItem;
+  if (nullptr == cardItem)
+    return;
+
+  // Collapsed cards only show their title bar
+  auto *window = cardItem->window();
+  const auto state = cardItem->state();
+  const bool suspended = !cardItem->isVisible() ||
+      state.endsWith("_collapsed") ||
+      (nullptr != window && (!window->isVisible() ||
+      window->visibility() == QWindow::Minimized)) ||
+      (!this->dataPtr->mainWindow.isNull() &&
+      !this->dataPtr->mainWindow->Exposed());
+
+  std::map<std::string, std::function<void()>> updates;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->suspendMutex);
+    if (suspended == this->dataPtr->suspended)
+      return;
+    this->dataPtr->suspended = suspended;
+    std::swap(updates, this->dataPtr->pendingUpdates);
+  }
+
+  if (suspended)
+  {
+    for (const auto &timer : this->dataPtr->pausableTimers)
+    {
+      if (!timer.isNull() && timer->isActive())
+      {
+        timer->stop();
+        this->dataPtr->pausedTimers.push_back(timer);
+      }
+    }
+  }
+  else
+  {
+    for (const auto &timer : this->dataPtr->pausedTimers)
+    {
+      if (!timer.isNull())
+        timer->start();
+    }
+    this->dataPtr->pausedTimers.clear();
+
+    // Show the latest state
+    for (auto &update : updates)
+      update.second();
+  }
+
+  emit this->SuspendedChanged();
+}
+
 /////////////////////////////////////////////////
 QQuickItem *Plugin::PluginItem() const
 {
@@ -480,6 +817,25 @@ QQuickItem *Plugin::CardItem() const
   // Add plugin to card content
   this->dataPtr->pluginItem->setParentItem(cardContentItem);
 
+  // Any change to the card, such as moving or resizing it, makes ConfigStr
+  // serialize it again
+  const auto *pluginMeta = this->metaObject();
+  const auto dirtySlot = pluginMeta->method(
+      pluginMeta->indexOfSlot("MarkConfigDirty()"));
+  const auto *cardMeta = cardItem->metaObject();
+  for (int i = 0; i < cardMeta->propertyCount(); ++i)
+  {
+    const auto property = cardMeta->property(i);
+    if (property.hasNotifySignal())
+    {
+      auto &properties =
+          this->dataPtr->propertiesBySignal[property.notifySignalIndex()];
+      if (properties.empty())
+        connect(cardItem, property.notifySignal(), this, dirtySlot);
+      properties.push_back(i);
+    }
+  }
+
   this->dataPtr->cardItem = cardItem;
 
   return cardItem;
@@ -509,6 +865,43 @@ void Plugin::PostParentChanges()
   // Anchor
   this->ApplyAnchors();
 
+  // Suspend the card while it can't be seen
+  auto *cardItem = this->CardItem();
+  if (!this->dataPtr->followingVisibility && nullptr != cardItem)
+  {
+    this->dataPtr->followingVisibility = true;
+    auto update = [this]()
+    {
+      this->UpdateSuspended();
+    };
+    auto followWindow = [this, update](QQuickWindow *_window)
+    {
+      this->disconnect(this->dataPtr->windowConnection);
+      this->disconnect(this->dataPtr->exposedConnection);
+      this->dataPtr->mainWindow.clear();
+      if (nullptr != _window)
+      {
+        this->dataPtr->windowConnection = this->connect(_window,
+            &QWindow::visibilityChanged, this, update);
+
+        // Main windows also know when they're covered
+        for (auto *mainWindow : App()->MainWindows())
+        {
+          if (mainWindow->QuickWindow() != _window)
+            continue;
+          this->dataPtr->mainWindow = mainWindow;
+          this->dataPtr->exposedConnection = this->connect(mainWindow,
+              &MainWindow::ExposedChanged, this, update);
+        }
+      }
+      this->UpdateSuspended();
+    };
+    this->connect(cardItem, &QQuickItem::visibleChanged, this, update);
+    this->connect(cardItem, &QQuickItem::stateChanged, this, update);
+    this->connect(cardItem, &QQuickItem::windowChanged, this, followWindow);
+    followWindow(cardItem->window());
+  }
+
   // Re-apply other properties like size and position if present
   for (const auto &prop : this->dataPtr->cardProperties)
   {
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/PluginIndex.hh"
+
+namespace
+{
+/// \brief First line of index files, with the format version
+const char kIndexHeader[] = "gz-gui-plugin-index 1";
+
+/// \brief Indexed plugins of a directory
+class DirEntry
+{
+  /// \brief Modification time of the directory when it was listed
+  public: int64_t mtime{0};
+
+  /// \brief Plugin libraries in the directory
+  public: std::vector<std::string> plugins;
+
+  /// \brief True once `mtime` was checked in this session
+  public: bool checked{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the modification time of a directory
+/// \param[in] _dir Directory
+/// \param[out] _mtime Modification time, in file clock ticks
+/// \return False if the directory doesn't exist
+bool ModificationTime(const std::string &_dir, int64_t &_mtime)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(_dir, error);
+  if (error)
+    return false;
+
+  _mtime = static_cast<int64_t>(time.time_since_epoch().count());
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief List the plugin libraries of a directory
+/// \param[in] _dir Directory
+/// \return File names of the plugin libraries
+std::vector<std::string> ListPlugins(const std::string &_dir)
+{
+  std::vector<std::string> plugins;
+  std::error_code error;
+  for (std::filesystem::directory_iterator it(_dir, error), end;
+       !error && it != end; it.increment(error))
+  {
+    auto filename = it->path().filename().string();
+    if (gz::gui::PluginIndex::IsPluginLibrary(filename))
+      plugins.push_back(std::move(filename));
+  }
+  return plugins;
+}
+}  // namespace
+
+namespace gz::gui
+{
+class PluginIndex::Implementation
+{
+  /// \brief Read the index file, replacing the entries
+  /// \return True if read, or if there's no file
+  public: bool Read();
+
+  /// \brief Write the index file
+  /// \return True if written
+  public: bool Write() const;
+
+  /// \brief Protects all members
+  public: mutable std::mutex mutex;
+
+  /// \brief Index file, empty if not kept
+  public: std::string file;
+
+  /// \brief Indexed directories
+  public: std::map<std::string, DirEntry> dirs;
+};
+
+/////////////////////////////////////////////////
+PluginIndex::PluginIndex()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+PluginIndex::~PluginIndex() = default;
+
+/////////////////////////////////////////////////
+bool PluginIndex::SetFile(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->file = _path;
+  return this->dataPtr->Read();
+}
+
+/////////////////////////////////////////////////
+std::string PluginIndex::File() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->file;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> PluginIndex::Plugins(const std::string &_dir)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto &entry = this->dataPtr->dirs[_dir];
+  if (entry.checked)
+    return entry.plugins;
+
+  int64_t mtime{0};
+  if (!ModificationTime(_dir, mtime))
+  {
+    // Checked again next time, in case it's created
+    const bool changed = !entry.plugins.empty();
+    this->dataPtr->dirs.erase(_dir);
+    if (changed)
+      this->dataPtr->Write();
+    return {};
+  }
+
+  entry.checked = true;
+  if (mtime == entry.mtime)
+    return entry.plugins;
+
+  entry.mtime = mtime;
+  entry.plugins = ListPlugins(_dir);
+  auto plugins = entry.plugins;
+  this->dataPtr->Write();
+  return plugins;
+}
+
+/////////////////////////////////////////////////
+void PluginIndex::Invalidate(const std::string &_dir)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto entry = this->dataPtr->dirs.find(_dir);
+  if (entry != this->dataPtr->dirs.end())
+    entry->second.checked = false;
+}
+
+/////////////////////////////////////////////////
+bool PluginIndex::IsPluginLibrary(const std::string &_filename)
+{
+  // TODO(anyone): Move this logic into gz-plugin to be reusable
+  const std::size_t prefixSize = std::strlen(SHARED_LIBRARY_PREFIX);
+  const std::size_t suffixSize = std::strlen(SHARED_LIBRARY_SUFFIX);
+  return _filename.size() > prefixSize + suffixSize &&
+      _filename.compare(0, prefixSize, SHARED_LIBRARY_PREFIX) == 0 &&
+      _filename.compare(_filename.size() - suffixSize, suffixSize,
+          SHARED_LIBRARY_SUFFIX) == 0;
+}
+
+/////////////////////////////////////////////////
+bool PluginIndex::Implementation::Read()
+{
+  this->dirs.clear();
+  if (this->file.empty())
+    return true;
+
+  std::ifstream stream(this->file);
+  if (!stream.is_open())
+    return true;
+
+  // Each directory is a line with its time, path and number of plugins,
+  // followed by a line per plugin
+  std::string line;
+  if (!std::getline(stream, line) || line != kIndexHeader)
+  {
+    gzwarn << "Ignoring plugin index [" << this->file
+           << "] of an unknown format" << std::endl;
+    return false;
+  }
+
+  while (std::getline(stream, line))
+  {
+    const auto first = line.find('\t');
+    const auto last = line.rfind('\t');
+    if (first == std::string::npos || first == last)
+    {
+      gzwarn << "Ignoring corrupt plugin index [" << this->file << "]"
+             << std::endl;
+      this->dirs.clear();
+      return false;
+    }
+
+    DirEntry entry;
+    std::size_t count{0};
+    try
+    {
+      entry.mtime = std::stoll(line.substr(0, first));
+      count = std::stoul(line.substr(last + 1));
+    }
+    catch (...)
+    {
+      gzwarn << "Ignoring corrupt plugin index [" << this->file << "]"
+             << std::endl;
+      this->dirs.clear();
+      return false;
+    }
+
+    const auto dir = line.substr(first + 1, last - first - 1);
+    for (std::size_t i = 0; i < count && std::getline(stream, line); ++i)
+      entry.plugins.push_back(line);
+
+    this->dirs[dir] = std::move(entry);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PluginIndex::Implementation::Write() const
+{
+  if (this->file.empty())
+    return false;
+
+  // Written next to the index, then moved over it, so readers never see a
+  // partial file
+  std::error_code error;
+  const auto parent = std::filesystem::path(this->file).parent_path();
+  if (!parent.empty())
+    std::filesystem::create_directories(parent, error);
+
+  const std::string tmpFile = this->file + ".tmp";
+  {
+    std::ofstream stream(tmpFile);
+    if (!stream.is_open())
+    {
+      gzwarn << "Failed to write plugin index [" << tmpFile << "]"
+             << std::endl;
+      return false;
+    }
+
+    stream << kIndexHeader << '\n';
+    for (const auto &[dir, entry] : this->dirs)
+    {
+      stream << entry.mtime << '\t' << dir << '\t' << entry.plugins.size()
+             << '\n';
+      for (const auto &plugin : entry.plugins)
+        stream << plugin << '\n';
+    }
+  }
+
+  std::filesystem::rename(tmpFile, this->file, error);
+  if (error)
+  {
+    gzwarn << "Failed to write plugin index [" << this->file << "]: "
+           << error.message() << std::endl;
+    return false;
+  }
+  return true;
+}
+}  // namespace gz::gui
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/PluginIndex.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Create an empty file
+/// \param[in] _path Path to the file
+void touch(const std::filesystem::path &_path)
+{
+  std::ofstream file(_path);
+}
+
+/////////////////////////////////////////////////
+/// \brief Move the modification time of a directory forward, so changes
+/// are seen even within the file system's time resolution
+/// \param[in] _dir Directory
+void bumpTime(const std::filesystem::path &_dir)
+{
+  std::filesystem::last_write_time(_dir,
+      std::filesystem::last_write_time(_dir) + std::chrono::seconds(2));
+}
+
+/////////////////////////////////////////////////
+TEST(PluginIndexTest, Plugins)
+{
+  const auto dir = std::filesystem::temp_directory_path() /
+      "gz_gui_plugin_index_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir / "plugins");
+  const auto pluginDir = (dir / "plugins").string();
+
+  // Only names of shared libraries are listed
+  std::vector<std::string> candidates{"libFirst.so", "First.dll",
+      "libFirst.dylib", "README.md", "libSecond.so.1"};
+  std::vector<std::string> expected;
+  for (const auto &candidate : candidates)
+  {
+    touch(dir / "plugins" / candidate);
+    if (PluginIndex::IsPluginLibrary(candidate))
+      expected.push_back(candidate);
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_FALSE(PluginIndex::IsPluginLibrary("README.md"));
+
+  const auto indexFile = (dir / "index").string();
+  auto sorted = [](std::vector<std::string> _list)
+  {
+    std::sort(_list.begin(), _list.end());
+    return _list;
+  };
+
+  std::filesystem::file_time_type indexedTime;
+  {
+    PluginIndex index;
+    EXPECT_TRUE(index.SetFile(indexFile));
+    EXPECT_EQ(indexFile, index.File());
+    EXPECT_EQ(sorted(expected), sorted(index.Plugins(pluginDir)));
+    EXPECT_TRUE(std::filesystem::exists(indexFile));
+
+    // Checked directories aren't listed again until invalidated
+    auto added = expected[0];
+    added.replace(added.find("First"), 5, "Added");
+    touch(dir / "plugins" / added);
+    bumpTime(dir / "plugins");
+    EXPECT_EQ(expected.size(), index.Plugins(pluginDir).size());
+
+    index.Invalidate(pluginDir);
+    EXPECT_EQ(expected.size() + 1, index.Plugins(pluginDir).size());
+    indexedTime = std::filesystem::last_write_time(dir / "plugins");
+
+    // Missing directories have no plugins
+    EXPECT_TRUE(index.Plugins((dir / "missing").string()).empty());
+  }
+
+  // A new index starts from the file, without listing the directory again
+  {
+    std::filesystem::remove(dir / "plugins" / expected[0]);
+    std::filesystem::last_write_time(dir / "plugins", indexedTime);
+
+    PluginIndex index;
+    EXPECT_TRUE(index.SetFile(indexFile));
+    EXPECT_EQ(expected.size() + 1, index.Plugins(pluginDir).size());
+
+    // Once the directory changes, it's listed again
+    bumpTime(dir / "plugins");
+    index.Invalidate(pluginDir);
+    EXPECT_EQ(expected.size(), index.Plugins(pluginDir).size());
+  }
+
+  // Corrupt files are ignored
+  {
+    std::ofstream(indexFile) << "banana";
+    PluginIndex index;
+    EXPECT_FALSE(index.SetFile(indexFile));
+    EXPECT_EQ(expected.size(), index.Plugins(pluginDir).size());
+  }
+
+  std::filesystem::remove_all(dir);
+}
@@ -15,6 +15,9 @@
  *
 */
 
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <unordered_map>
 #include <gtest/gtest.h>
 
@@ -74,6 +77,117 @@ TEST(PluginTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(DeleteLater))
   EXPECT_EQ(1, win->findChildren<Plugin *>().size());
 }
 
+/////////////////////////////////////////////////
+TEST(PluginTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Suspended))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+  QCoreApplication::processEvents();
+
+  auto *plugin = win->findChildren<Plugin *>().at(0);
+  auto *cardItem = plugin->CardItem();
+  ASSERT_NE(nullptr, cardItem);
+  cardItem->setState("docked");
+  cardItem->setVisible(true);
+  EXPECT_FALSE(plugin->Suspended());
+
+  int changes{0};
+  plugin->connect(plugin, &Plugin::SuspendedChanged, [&changes]()
+  {
+    ++changes;
+  });
+
+  // Hidden cards are suspended
+  cardItem->setVisible(false);
+  EXPECT_TRUE(plugin->Suspended());
+  EXPECT_EQ(1, changes);
+  EXPECT_TRUE(plugin->property("suspended").toBool());
+
+  cardItem->setVisible(true);
+  EXPECT_FALSE(plugin->Suspended());
+  EXPECT_EQ(2, changes);
+
+  // So are collapsed ones
+  cardItem->setState("docked_collapsed");
+  EXPECT_TRUE(plugin->Suspended());
+  cardItem->setState("docked");
+  EXPECT_FALSE(plugin->Suspended());
+  EXPECT_EQ(4, changes);
+}
+
+/// \brief Plugin exposing its background task helpers
+class TaskPlugin : public Plugin
+{
+  public: using Plugin::RunInBackground;
+  public: using Plugin::RunOnMainThread;
+};
+
+/////////////////////////////////////////////////
+TEST(PluginTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(RunInBackground))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  ASSERT_NE(nullptr, app.Tasks());
+  EXPECT_LE(1u, app.Tasks()->ThreadCount());
+
+  TaskPlugin plugin;
+  const auto guiThread = std::this_thread::get_id();
+
+  // Results are passed back on the GUI thread
+  std::thread::id workThread;
+  int result{0};
+  EXPECT_NE(0u, plugin.RunInBackground([&workThread]()
+  {
+    workThread = std::this_thread::get_id();
+    return 42;
+  },
+  [&result, guiThread](int _value)
+  {
+    EXPECT_EQ(guiThread, std::this_thread::get_id());
+    result = _value;
+  }));
+
+  bool done{false};
+  plugin.RunInBackground([]{}, [&done]{ done = true; },
+      TaskPool::Priority::HIGH);
+
+  int sleep{0};
+  while ((result == 0 || !done) && sleep++ < 100)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(42, result);
+  EXPECT_TRUE(done);
+  EXPECT_NE(guiThread, workThread);
+
+  // Nothing runs on the GUI thread once unloaded, and running tasks are
+  // waited for
+  std::atomic<bool> started{false};
+  std::atomic<bool> finished{false};
+  bool continued{false};
+  plugin.RunInBackground([&started, &finished]()
+  {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    finished = true;
+  }, [&continued]{ continued = true; });
+  while (!started)
+    std::this_thread::yield();
+  plugin.Unload();
+  EXPECT_TRUE(finished);
+  QCoreApplication::processEvents();
+  EXPECT_FALSE(continued);
+}
+
 /////////////////////////////////////////////////
 TEST(PluginTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(InvalidXmlText))
 {
@@ -233,6 +347,31 @@ TEST(PluginTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ConfigStr))
         <<  itr->first;
   }
 
+  // Unchanged cards aren't serialized again, changed ones are
+  EXPECT_EQ(configStr, plugin->ConfigStr());
+  plugin->CardItem()->setProperty("z", 3.0);
+  configStr = plugin->ConfigStr();
+  EXPECT_NE(std::string::npos,
+      configStr.find("<property key=\"z\" type=\"double\">3</property>"))
+      << configStr;
+
+  // Only the changed property is written again, the others keep their
+  // values
+  plugin->CardItem()->setProperty("resizable", false);
+  configStr = plugin->ConfigStr();
+  EXPECT_NE(std::string::npos, configStr.find(
+      "<property key=\"resizable\" type=\"bool\">false</property>"))
+      << configStr;
+  EXPECT_NE(std::string::npos,
+      configStr.find("<property key=\"z\" type=\"double\">3</property>"))
+      << configStr;
+  EXPECT_NE(std::string::npos, configStr.find(
+      "<property key=\"width\" type=\"double\">300</property>"))
+      << configStr;
+
+  // Marking the config dirty writes everything again
+  plugin->MarkConfigDirty();
+  EXPECT_EQ(configStr, plugin->ConfigStr());
 }
 
 /////////////////////////////////////////////////
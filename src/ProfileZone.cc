@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <string>
+
+#include <gz/common/Profiler.hh>
+#include <gz/common/Util.hh>
+
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/StallWatchdog.hh"
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Whether zones are sent to the profiler, initialized from the
+/// environment
+/// \return The flag
+std::atomic<bool> &Enabled()
+{
+  static std::atomic<bool> enabled{[]()
+  {
+    std::string value;
+    return gz::common::env("GZ_GUI_PROFILER", value) &&
+        (value == "1" || value == "true");
+  }()};
+  return enabled;
+}
+}  // namespace
+
+namespace gz::gui
+{
+/////////////////////////////////////////////////
+void SetProfilerEnabled(bool _enabled)
+{
+  Enabled() = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool ProfilerEnabled()
+{
+  return Enabled();
+}
+
+/////////////////////////////////////////////////
+ProfileZone::ProfileZone(const char *_name, uint32_t *_hash)
+{
+  StallWatchdog::PushZone(_name);
+
+#if GZ_PROFILER_ENABLE
+  // The profiler, and its server, only start once it's enabled
+  if (!Enabled().load(std::memory_order_relaxed))
+    return;
+  this->active = true;
+  common::Profiler::Instance()->BeginSample(_name, _hash);
+#else
+  (void) _name;
+  (void) _hash;
+#endif
+}
+
+/////////////////////////////////////////////////
+ProfileZone::~ProfileZone()
+{
+#if GZ_PROFILER_ENABLE
+  if (this->active)
+    common::Profiler::Instance()->EndSample();
+#endif
+  StallWatchdog::PopZone();
+}
+}  // namespace gz::gui
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gz/gui/ProfileZone.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(ProfileZoneTest, Enabled)
+{
+  const bool initial = ProfilerEnabled();
+
+  SetProfilerEnabled(true);
+  EXPECT_TRUE(ProfilerEnabled());
+  {
+    GZ_GUI_PROFILE("ProfileZoneTest enabled");
+  }
+
+  SetProfilerEnabled(false);
+  EXPECT_FALSE(ProfilerEnabled());
+  {
+    GZ_GUI_PROFILE("ProfileZoneTest disabled");
+  }
+
+  // Zones on different lines of the same scope don't clash
+  GZ_GUI_PROFILE("ProfileZoneTest first");
+  GZ_GUI_PROFILE("ProfileZoneTest second");
+
+  SetProfilerEnabled(initial);
+}
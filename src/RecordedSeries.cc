@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/RecordedSeries.hh"
+
+namespace
+{
+/// \brief First bytes of a binary plot export
+constexpr char kMagic[8] = {'G', 'Z', 'P', 'L', 'O', 'T', '\0', '\1'};
+
+/// \brief Points per block whose extremes are summarized
+constexpr std::size_t kBlockSize = 1024;
+
+/// \brief Size of the write buffer
+constexpr std::size_t kWriteBufferSize = 1 << 20;
+
+/// \brief Extremes of a block of points
+struct BlockSummary
+{
+  /// \brief Index of the lowest point
+  std::size_t low{0};
+
+  /// \brief Index of the highest point
+  std::size_t high{0};
+
+  /// \brief True once computed
+  bool computed{false};
+};
+}
+
+namespace gz::gui
+{
+class RecordedSeries::Implementation
+{
+  /// \brief Read a double of the file, which may not be aligned
+  /// \param[in] _offset Offset of the double
+  /// \return Value
+  public: double Read(std::size_t _offset) const
+  {
+    double value;
+    std::memcpy(&value, this->data + _offset, sizeof(value));
+    return value;
+  }
+
+  /// \brief Time of a point
+  /// \param[in] _index Index of the point
+  /// \return Time
+  public: double Time(std::size_t _index) const
+  {
+    return this->Read(this->timesOffset + _index * sizeof(double));
+  }
+
+  /// \brief Value of a point
+  /// \param[in] _index Index of the point
+  /// \return Value
+  public: double Value(std::size_t _index) const
+  {
+    return this->Read(this->valuesOffset + _index * sizeof(double));
+  }
+
+  /// \brief Index of the first point at or after a time
+  /// \param[in] _time Time
+  /// \param[in] _first Lowest index to search
+  /// \param[in] _last Index past the highest one to search
+  /// \return Index, `_last` if all points are earlier
+  public: std::size_t LowerBound(double _time, std::size_t _first,
+      std::size_t _last) const;
+
+  /// \brief Index of the first point after a time
+  /// \param[in] _time Time
+  /// \return Index, Size() if no point is later
+  public: std::size_t UpperBound(double _time) const;
+
+  /// \brief Update the extremes of a bucket with those of a range of
+  /// points, from the block summaries where the range covers whole blocks.
+  /// Must be called with `mutex` locked.
+  /// \param[in] _first First point
+  /// \param[in] _last Point past the last one
+  /// \param[in, out] _low Index of the lowest point so far
+  /// \param[in, out] _high Index of the highest point so far
+  public: void Extremes(std::size_t _first, std::size_t _last,
+      std::size_t &_low, std::size_t &_high);
+
+  /// \brief Update extremes with the points of a range, one by one
+  /// \param[in] _first First point
+  /// \param[in] _last Point past the last one
+  /// \param[in, out] _low Index of the lowest point so far
+  /// \param[in, out] _high Index of the highest point so far
+  public: void Scan(std::size_t _first, std::size_t _last,
+      std::size_t &_low, std::size_t &_high) const;
+
+  /// \brief Mapped file, or `buffer` on Windows
+  public: const char *data{nullptr};
+
+  /// \brief Size of the mapped file
+  public: std::size_t length{0};
+
+#ifdef _WIN32
+  /// \brief Contents of the file, read since it isn't mapped
+  public: std::vector<char> buffer;
+#endif
+
+  /// \brief Name of the graph
+  public: std::string name;
+
+  /// \brief Number of points
+  public: std::size_t count{0};
+
+  /// \brief Offset of the first time
+  public: std::size_t timesOffset{0};
+
+  /// \brief Offset of the first value
+  public: std::size_t valuesOffset{0};
+
+  /// \brief Extremes of each block, computed when first needed
+  public: std::vector<BlockSummary> blocks;
+
+  /// \brief Number of blocks computed
+  public: std::size_t summarized{0};
+
+  /// \brief Protects `blocks` and `summarized`
+  public: mutable std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+std::size_t RecordedSeries::Implementation::LowerBound(double _time,
+    std::size_t _first, std::size_t _last) const
+{
+  while (_first < _last)
+  {
+    const std::size_t middle = _first + (_last - _first) / 2;
+    if (this->Time(middle) < _time)
+      _first = middle + 1;
+    else
+      _last = middle;
+  }
+  return _first;
+}
+
+/////////////////////////////////////////////////
+std::size_t RecordedSeries::Implementation::UpperBound(double _time) const
+{
+  std::size_t first{0};
+  std::size_t last{this->count};
+  while (first < last)
+  {
+    const std::size_t middle = first + (last - first) / 2;
+    if (this->Time(middle) <= _time)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return first;
+}
+
+/////////////////////////////////////////////////
+void RecordedSeries::Implementation::Scan(std::size_t _first,
+    std::size_t _last, std::size_t &_low, std::size_t &_high) const
+{
+  double low = this->Value(_low);
+  double high = this->Value(_high);
+  for (std::size_t i = _first; i < _last; ++i)
+  {
+    const double value = this->Value(i);
+    if (value < low)
+    {
+      low = value;
+      _low = i;
+    }
+    else if (value > high)
+    {
+      high = value;
+      _high = i;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void RecordedSeries::Implementation::Extremes(std::size_t _first,
+    std::size_t _last, std::size_t &_low, std::size_t &_high)
+{
+  // Points before the first whole block and after the last one are read
+  // one by one
+  const std::size_t firstBlock = (_first + kBlockSize - 1) / kBlockSize;
+  const std::size_t lastBlock = _last / kBlockSize;
+  if (firstBlock >= lastBlock)
+  {
+    this->Scan(_first, _last, _low, _high);
+    return;
+  }
+
+  this->Scan(_first, firstBlock * kBlockSize, _low, _high);
+  for (std::size_t b = firstBlock; b < lastBlock; ++b)
+  {
+    auto &block = this->blocks[b];
+    if (!block.computed)
+    {
+      block.low = block.high = b * kBlockSize;
+      this->Scan(b * kBlockSize + 1, (b + 1) * kBlockSize, block.low,
+          block.high);
+      block.computed = true;
+      ++this->summarized;
+    }
+
+    // Keep the earliest point of equal extremes, like a scan would
+    if (this->Value(block.low) < this->Value(_low))
+      _low = block.low;
+    if (this->Value(block.high) > this->Value(_high))
+      _high = block.high;
+  }
+  this->Scan(lastBlock * kBlockSize, _last, _low, _high);
+}
+
+/////////////////////////////////////////////////
+RecordedSeries::RecordedSeries()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+RecordedSeries::~RecordedSeries()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool RecordedSeries::Open(const std::string &_path)
+{
+  this->Close();
+  auto &d = *this->dataPtr;
+
+#ifndef _WIN32
+  const int fd = open(_path.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || fstat(fd, &info) != 0)
+  {
+    gzerr << "Failed to open recording [" << _path << "]: "
+           << std::strerror(errno) << std::endl;
+    if (fd >= 0)
+      close(fd);
+    return false;
+  }
+  d.length = static_cast<std::size_t>(info.st_size);
+  void *addr = d.length > 0 ?
+      mmap(nullptr, d.length, PROT_READ, MAP_PRIVATE, fd, 0) :
+      MAP_FAILED;
+  close(fd);
+  if (addr == MAP_FAILED)
+  {
+    gzerr << "Failed to map recording [" << _path << "]" << std::endl;
+    d.length = 0;
+    return false;
+  }
+  d.data = static_cast<const char *>(addr);
+#else
+  std::ifstream file(_path, std::ios::binary);
+  d.buffer.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  if (!file.good() && !file.eof())
+  {
+    gzerr << "Failed to open recording [" << _path << "]" << std::endl;
+    d.buffer.clear();
+    return false;
+  }
+  d.data = d.buffer.data();
+  d.length = d.buffer.size();
+#endif
+
+  // Header, then 2 columns of doubles
+  uint32_t nameSize{0};
+  uint64_t count{0};
+  bool valid = d.length >= sizeof(kMagic) + sizeof(nameSize) &&
+      std::memcmp(d.data, kMagic, sizeof(kMagic)) == 0;
+  if (valid)
+  {
+    std::memcpy(&nameSize, d.data + sizeof(kMagic), sizeof(nameSize));
+    d.timesOffset = sizeof(kMagic) + sizeof(nameSize) + nameSize +
+        sizeof(count);
+    valid = d.timesOffset <= d.length;
+  }
+  if (valid)
+  {
+    std::memcpy(&count, d.data + d.timesOffset - sizeof(count),
+        sizeof(count));
+    valid = count <= (d.length - d.timesOffset) / (2 * sizeof(double));
+  }
+  if (!valid)
+  {
+    gzerr << "File [" << _path << "] isn't a binary plot export"
+           << std::endl;
+    this->Close();
+    return false;
+  }
+
+  d.name.assign(d.data + sizeof(kMagic) + sizeof(nameSize), nameSize);
+  d.count = static_cast<std::size_t>(count);
+  d.valuesOffset = d.timesOffset + d.count * sizeof(double);
+  d.blocks.assign((d.count + kBlockSize - 1) / kBlockSize, BlockSummary());
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RecordedSeries::Close()
+{
+  auto &d = *this->dataPtr;
+#ifndef _WIN32
+  if (d.data)
+    munmap(const_cast<char *>(d.data), d.length);
+#else
+  d.buffer.clear();
+  d.buffer.shrink_to_fit();
+#endif
+  d.data = nullptr;
+  d.length = 0;
+  d.name.clear();
+  d.count = 0;
+  d.timesOffset = 0;
+  d.valuesOffset = 0;
+
+  std::lock_guard<std::mutex> lock(d.mutex);
+  d.blocks.clear();
+  d.summarized = 0;
+}
+
+/////////////////////////////////////////////////
+bool RecordedSeries::IsOpen() const
+{
+  return this->dataPtr->data != nullptr;
+}
+
+/////////////////////////////////////////////////
+const std::string &RecordedSeries::Name() const
+{
+  return this->dataPtr->name;
+}
+
+/////////////////////////////////////////////////
+std::size_t RecordedSeries::Size() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+double RecordedSeries::Start() const
+{
+  return this->dataPtr->count > 0 ? this->dataPtr->Time(0) : 0.0;
+}
+
+/////////////////////////////////////////////////
+double RecordedSeries::End() const
+{
+  return this->dataPtr->count > 0 ?
+      this->dataPtr->Time(this->dataPtr->count - 1) : 0.0;
+}
+
+/////////////////////////////////////////////////
+math::Vector2d RecordedSeries::Point(std::size_t _index) const
+{
+  return {this->dataPtr->Time(_index), this->dataPtr->Value(_index)};
+}
+
+/////////////////////////////////////////////////
+std::vector<math::Vector2d> RecordedSeries::Decimated(double _xMin,
+    double _xMax, unsigned int _buckets) const
+{
+  std::vector<math::Vector2d> points;
+  auto &d = *this->dataPtr;
+  if (_buckets == 0 || _xMax < _xMin || d.count == 0)
+    return points;
+
+  const std::size_t first = d.LowerBound(_xMin, 0, d.count);
+  const std::size_t last = d.UpperBound(_xMax);
+  if (first >= last)
+    return points;
+
+  // Few enough points to draw them all
+  if (last - first <= 2u * _buckets)
+  {
+    points.reserve(last - first);
+    for (std::size_t i = first; i < last; ++i)
+      points.push_back(this->Point(i));
+    return points;
+  }
+
+  // Keep the extremes of each bucket, in time order, so the line still
+  // looks the same
+  points.reserve(2u * _buckets);
+  const double width = (_xMax - _xMin) / _buckets;
+  auto bucketOf = [&](std::size_t _index) -> int64_t
+  {
+    if (width <= 0.0)
+      return 0;
+    return std::min(static_cast<int64_t>(_buckets) - 1,
+        static_cast<int64_t>(std::floor((d.Time(_index) - _xMin) / width)));
+  };
+
+  std::lock_guard<std::mutex> lock(d.mutex);
+  std::size_t start = first;
+  while (start < last)
+  {
+    // Points of the same bucket as the first, found by bisection
+    const int64_t bucket = bucketOf(start);
+    std::size_t end = start + 1;
+    std::size_t high = last;
+    while (end < high)
+    {
+      const std::size_t middle = end + (high - end) / 2;
+      if (bucketOf(middle) > bucket)
+        high = middle;
+      else
+        end = middle + 1;
+    }
+
+    std::size_t lowIndex = start;
+    std::size_t highIndex = start;
+    d.Extremes(start + 1, end, lowIndex, highIndex);
+    if (lowIndex == highIndex)
+    {
+      points.push_back(this->Point(lowIndex));
+    }
+    else
+    {
+      points.push_back(this->Point(std::min(lowIndex, highIndex)));
+      points.push_back(this->Point(std::max(lowIndex, highIndex)));
+    }
+    start = end;
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+std::size_t RecordedSeries::SummarizedBlocks() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->summarized;
+}
+
+/////////////////////////////////////////////////
+bool RecordedSeries::Write(const std::string &_path,
+    const std::string &_name, const std::vector<math::Vector2d> &_points)
+{
+  std::vector<char> buffer(kWriteBufferSize);
+  std::ofstream file;
+  file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  file.open(_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    gzerr << "Failed to open file [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  file.write(kMagic, sizeof(kMagic));
+
+  const auto nameSize = static_cast<uint32_t>(_name.size());
+  file.write(reinterpret_cast<const char *>(&nameSize), sizeof(nameSize));
+  file.write(_name.data(), nameSize);
+
+  const auto count = static_cast<uint64_t>(_points.size());
+  file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+
+  for (const auto &point : _points)
+  {
+    const double x = point.X();
+    file.write(reinterpret_cast<const char *>(&x), sizeof(x));
+  }
+  for (const auto &point : _points)
+  {
+    const double y = point.Y();
+    file.write(reinterpret_cast<const char *>(&y), sizeof(y));
+  }
+
+  file.close();
+  if (file.fail())
+  {
+    gzerr << "Failed to write file [" << _path << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+}  // namespace gz::gui
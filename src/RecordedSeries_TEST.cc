@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/RecordedSeries.hh"
+#include "gz/gui/TimeSeries.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Directory of the files written by a test, emptied
+/// \param[in] _name Test name
+/// \return Path of the directory
+std::string testDir(const std::string &_name)
+{
+  const auto dir = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "test", _name);
+  common::removeAll(dir);
+  common::createDirectories(dir);
+  return dir;
+}
+
+/////////////////////////////////////////////////
+TEST(RecordedSeriesTest, Open)
+{
+  const auto dir = testDir("recorded_series_open");
+
+  RecordedSeries series;
+  EXPECT_FALSE(series.IsOpen());
+  EXPECT_EQ(0u, series.Size());
+  EXPECT_TRUE(series.Decimated(0.0, 1.0, 10).empty());
+  EXPECT_FALSE(series.Open(common::joinPaths(dir, "missing.bin")));
+
+  // Not an export
+  const auto textPath = common::joinPaths(dir, "text.bin");
+  std::ofstream(textPath) << "time, value\n0, 1\n";
+  EXPECT_FALSE(series.Open(textPath));
+  EXPECT_FALSE(series.IsOpen());
+
+  std::vector<math::Vector2d> points;
+  for (int i = 0; i < 100; ++i)
+    points.emplace_back(1.0 + i * 0.5, i * i);
+  const auto path = common::joinPaths(dir, "squares.bin");
+  ASSERT_TRUE(RecordedSeries::Write(path, "/squares-data", points));
+
+  ASSERT_TRUE(series.Open(path));
+  EXPECT_TRUE(series.IsOpen());
+  EXPECT_EQ("/squares-data", series.Name());
+  ASSERT_EQ(100u, series.Size());
+  EXPECT_DOUBLE_EQ(1.0, series.Start());
+  EXPECT_DOUBLE_EQ(50.5, series.End());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(points[i], series.Point(i));
+
+  // Few points are returned as they are
+  auto decimated = series.Decimated(2.0, 5.0, 10);
+  ASSERT_EQ(7u, decimated.size());
+  EXPECT_EQ(points[2], decimated.front());
+  EXPECT_EQ(points[8], decimated.back());
+  EXPECT_TRUE(series.Decimated(100.0, 200.0, 10).empty());
+
+  // Truncated
+  const auto truncatedPath = common::joinPaths(dir, "truncated.bin");
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    std::ofstream out(truncatedPath, std::ios::binary);
+    out.write(data.data(), static_cast<std::streamsize>(data.size() - 8));
+  }
+  EXPECT_FALSE(series.Open(truncatedPath));
+  EXPECT_EQ(0u, series.Size());
+
+  series.Close();
+  EXPECT_FALSE(series.IsOpen());
+  common::removeAll(dir);
+}
+
+/////////////////////////////////////////////////
+TEST(RecordedSeriesTest, Decimated)
+{
+  const auto dir = testDir("recorded_series_decimated");
+
+  // Same as a live series
+  TimeSeries live;
+  std::vector<math::Vector2d> points;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const double x = i * 0.001;
+    const double y = std::sin(i * 0.01) + (i % 7 == 0 ? 0.5 : 0.0);
+    points.emplace_back(x, y);
+    live.Append(x, y);
+  }
+  const auto path = common::joinPaths(dir, "sine.bin");
+  ASSERT_TRUE(RecordedSeries::Write(path, "sine", points));
+
+  RecordedSeries series;
+  ASSERT_TRUE(series.Open(path));
+  EXPECT_EQ(0u, series.SummarizedBlocks());
+
+  for (unsigned int buckets : {300u, 20u})
+  {
+    for (const auto &range : std::vector<std::pair<double, double>>{
+        {0.0, 100.0}, {12.3456, 45.678}, {-10.0, 30.0}, {99.0, 99.5}})
+    {
+      const auto expected = live.Decimated(range.first, range.second,
+          buckets);
+      const auto decimated = series.Decimated(range.first, range.second,
+          buckets);
+      ASSERT_EQ(expected.size(), decimated.size());
+      for (std::size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(expected[i], decimated[i]) << i;
+    }
+  }
+
+  // Only buckets covering whole blocks of 1024 points use summaries, which
+  // are computed once
+  const auto summarized = series.SummarizedBlocks();
+  EXPECT_GT(summarized, 0u);
+  EXPECT_LE(summarized, 98u);
+  series.Decimated(0.0, 100.0, 20);
+  EXPECT_EQ(summarized, series.SummarizedBlocks());
+
+  series.Close();
+  EXPECT_EQ(0u, series.SummarizedBlocks());
+  common::removeAll(dir);
+}
@@ -0,0 +1,415 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/RenderHooks.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief A registered callback
+struct Hook
+{
+  /// \brief Lower runs first
+  int priority{0};
+
+  /// \brief Registration order, used to break priority ties
+  uint64_t order{0};
+
+  /// \brief The callback
+  RenderHooks::Callback callback;
+
+  /// \brief The task, for frame tasks
+  RenderHooks::Task task;
+
+  /// \brief Time the task may take each frame, zero for no limit of its
+  /// own
+  std::chrono::steady_clock::duration budget{0};
+
+  /// \brief True if the task was left out of the last frame
+  bool deferred{false};
+
+  /// \brief False once the connection has been destroyed
+  bool connected{true};
+
+  /// \brief Measures the callback, null if it has no owner
+  std::unique_ptr<PerformanceCounter> counter;
+};
+
+/// \brief All hooks registered for one stage of the frame
+class HookList
+{
+  /// \brief Register a callback
+  /// \param[in] _cb Callback
+  /// \param[in] _priority Lower runs first
+  /// \param[in] _owner Owner reported to PerformanceCounters, may be empty
+  /// \param[in] _source Kind of callback reported to PerformanceCounters
+  /// \return New hook, to be kept by a connection
+  public: std::shared_ptr<Hook> Connect(RenderHooks::Callback _cb,
+      int _priority, const std::string &_owner = "",
+      const std::string &_source = "");
+
+  /// \brief Register a hook
+  /// \param[in] _hook Hook, with its callback or task set
+  /// \return The hook, to be kept by a connection
+  public: std::shared_ptr<Hook> Add(std::shared_ptr<Hook> _hook);
+
+  /// \brief Call all connected callbacks
+  public: void Run();
+
+  /// \brief Call the connected tasks within a budget
+  /// \param[in] _budget Time after which no more tasks are started, zero
+  /// for no limit
+  /// \return True if a task has work left or was left out
+  public: bool RunTasks(std::chrono::steady_clock::duration _budget);
+
+  /// \brief Number of connected callbacks
+  /// \return Callback count
+  public: std::size_t Count();
+
+  /// \brief Remove disconnected hooks and merge newly connected ones.
+  /// Must be called with the mutex locked, and not while iterating.
+  private: void Compact();
+
+  /// \brief Protects all members. Recursive so that callbacks can connect
+  /// and disconnect hooks.
+  public: std::recursive_mutex mutex;
+
+  /// \brief Hooks sorted in the order they run
+  private: std::vector<std::shared_ptr<Hook>> hooks;
+
+  /// \brief Hooks connected since the last run
+  private: std::vector<std::shared_ptr<Hook>> pending;
+
+  /// \brief True if hooks have been disconnected since the last run
+  public: bool dirty{false};
+
+  /// \brief Order given to the next connected hook
+  private: uint64_t nextOrder{0};
+};
+
+/////////////////////////////////////////////////
+std::shared_ptr<HookList> &preRenderHooks()
+{
+  static auto list = std::make_shared<HookList>();
+  return list;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<HookList> &renderHooks()
+{
+  static auto list = std::make_shared<HookList>();
+  return list;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<HookList> &frameTaskHooks()
+{
+  static auto list = std::make_shared<HookList>();
+  return list;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<HookList> &renderRequestHooks()
+{
+  static auto list = std::make_shared<HookList>();
+  return list;
+}
+}  // namespace
+
+/// \brief Private data for RenderHookConnection
+class RenderHookConnection::Implementation
+{
+  /// \brief List the hook belongs to. Weak so that connections outliving
+  /// the registry during static destruction don't touch it.
+  public: std::weak_ptr<HookList> list;
+
+  /// \brief The hook kept connected
+  public: std::shared_ptr<Hook> hook;
+};
+
+/////////////////////////////////////////////////
+RenderHookConnection::RenderHookConnection()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+RenderHookConnection::~RenderHookConnection()
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list || nullptr == this->dataPtr->hook)
+    return;
+
+  // Blocks while the render thread is running callbacks, so once this
+  // returns the callback is guaranteed not to be called anymore
+  std::lock_guard<std::recursive_mutex> lock(list->mutex);
+  this->dataPtr->hook->connected = false;
+  list->dirty = true;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<Hook> HookList::Connect(RenderHooks::Callback _cb,
+    int _priority, const std::string &_owner, const std::string &_source)
+{
+  auto hook = std::make_shared<Hook>();
+  hook->priority = _priority;
+  hook->callback = std::move(_cb);
+  if (!_owner.empty())
+    hook->counter = std::make_unique<PerformanceCounter>(_owner, _source);
+  return this->Add(std::move(hook));
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<Hook> HookList::Add(std::shared_ptr<Hook> _hook)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  _hook->order = this->nextOrder++;
+  this->pending.push_back(_hook);
+  return _hook;
+}
+
+/////////////////////////////////////////////////
+void HookList::Compact()
+{
+  this->hooks.erase(std::remove_if(this->hooks.begin(), this->hooks.end(),
+      [](const std::shared_ptr<Hook> &_hook)
+      {
+        return !_hook->connected;
+      }), this->hooks.end());
+
+  for (auto &hook : this->pending)
+  {
+    if (hook->connected)
+      this->hooks.push_back(std::move(hook));
+  }
+  this->pending.clear();
+
+  std::sort(this->hooks.begin(), this->hooks.end(),
+      [](const std::shared_ptr<Hook> &_a, const std::shared_ptr<Hook> &_b)
+      {
+        if (_a->priority != _b->priority)
+          return _a->priority < _b->priority;
+        return _a->order < _b->order;
+      });
+
+  this->dirty = false;
+}
+
+/////////////////////////////////////////////////
+void HookList::Run()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+
+  if (this->dirty || !this->pending.empty())
+    this->Compact();
+
+  // The vector isn't modified while iterating: callbacks which connect or
+  // disconnect hooks only touch `pending` and `connected`.
+  for (const auto &hook : this->hooks)
+  {
+    if (!hook->connected || !hook->callback)
+      continue;
+
+    if (hook->counter)
+    {
+      PerformanceTimer timer(*hook->counter);
+      hook->callback();
+    }
+    else
+    {
+      hook->callback();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool HookList::RunTasks(std::chrono::steady_clock::duration _budget)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+
+  if (this->dirty || !this->pending.empty())
+    this->Compact();
+
+  // Tasks left out of the previous frame go first, so none starves
+  std::vector<Hook *> order;
+  order.reserve(this->hooks.size());
+  for (const auto &hook : this->hooks)
+  {
+    if (hook->deferred)
+      order.push_back(hook.get());
+  }
+  for (const auto &hook : this->hooks)
+  {
+    if (!hook->deferred)
+      order.push_back(hook.get());
+  }
+
+  const bool limited = _budget.count() > 0;
+  const auto frameEnd = std::chrono::steady_clock::now() + _budget;
+  bool ran{false};
+  bool workLeft{false};
+  for (auto *hook : order)
+  {
+    if (!hook->connected || !hook->task)
+      continue;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (limited && ran && start >= frameEnd)
+    {
+      hook->deferred = true;
+      workLeft = true;
+      continue;
+    }
+    hook->deferred = false;
+
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    if (hook->budget.count() > 0)
+      deadline = start + hook->budget;
+    if (limited)
+      deadline = std::min(deadline, frameEnd);
+
+    workLeft = hook->task(deadline) || workLeft;
+    ran = true;
+
+    if (hook->counter && PerformanceCounters::Enabled())
+    {
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+      hook->counter->AddTime(elapsed);
+      if (hook->budget.count() > 0 && elapsed > hook->budget)
+        hook->counter->AddOverrun();
+    }
+  }
+  return workLeft;
+}
+
+/////////////////////////////////////////////////
+std::size_t HookList::Count()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  auto isConnected = [](const std::shared_ptr<Hook> &_hook)
+  {
+    return _hook->connected;
+  };
+  return static_cast<std::size_t>(
+      std::count_if(this->hooks.begin(), this->hooks.end(), isConnected) +
+      std::count_if(this->pending.begin(), this->pending.end(), isConnected));
+}
+
+/////////////////////////////////////////////////
+RenderHookConnectionPtr RenderHooks::OnPreRender(Callback _cb, int _priority,
+    const std::string &_owner)
+{
+  auto connection = std::make_shared<RenderHookConnection>();
+  connection->dataPtr->list = preRenderHooks();
+  connection->dataPtr->hook = preRenderHooks()->Connect(std::move(_cb),
+      _priority, _owner, "pre-render hook");
+  return connection;
+}
+
+/////////////////////////////////////////////////
+RenderHookConnectionPtr RenderHooks::OnRender(Callback _cb, int _priority,
+    const std::string &_owner)
+{
+  auto connection = std::make_shared<RenderHookConnection>();
+  connection->dataPtr->list = renderHooks();
+  connection->dataPtr->hook = renderHooks()->Connect(std::move(_cb),
+      _priority, _owner, "render hook");
+  return connection;
+}
+
+/////////////////////////////////////////////////
+RenderHookConnectionPtr RenderHooks::OnFrameTask(Task _task, int _priority,
+    std::chrono::steady_clock::duration _budget, const std::string &_owner)
+{
+  auto hook = std::make_shared<Hook>();
+  hook->priority = _priority;
+  hook->task = std::move(_task);
+  hook->budget =
+      std::max(std::chrono::steady_clock::duration::zero(), _budget);
+  if (!_owner.empty())
+    hook->counter = std::make_unique<PerformanceCounter>(_owner, "frame task");
+
+  auto connection = std::make_shared<RenderHookConnection>();
+  connection->dataPtr->list = frameTaskHooks();
+  connection->dataPtr->hook = frameTaskHooks()->Add(std::move(hook));
+  return connection;
+}
+
+/////////////////////////////////////////////////
+RenderHookConnectionPtr RenderHooks::OnRenderRequest(Callback _cb)
+{
+  auto connection = std::make_shared<RenderHookConnection>();
+  connection->dataPtr->list = renderRequestHooks();
+  connection->dataPtr->hook =
+      renderRequestHooks()->Connect(std::move(_cb), 0);
+  return connection;
+}
+
+/////////////////////////////////////////////////
+void RenderHooks::RequestRender()
+{
+  renderRequestHooks()->Run();
+}
+
+/////////////////////////////////////////////////
+void RenderHooks::RunPreRender()
+{
+  preRenderHooks()->Run();
+}
+
+/////////////////////////////////////////////////
+void RenderHooks::RunRender()
+{
+  renderHooks()->Run();
+}
+
+/////////////////////////////////////////////////
+void RenderHooks::RunFrameTasks(std::chrono::steady_clock::duration _budget)
+{
+  if (frameTaskHooks()->RunTasks(_budget))
+    RequestRender();
+}
+
+/////////////////////////////////////////////////
+std::size_t RenderHooks::PreRenderCount()
+{
+  return preRenderHooks()->Count();
+}
+
+/////////////////////////////////////////////////
+std::size_t RenderHooks::RenderCount()
+{
+  return renderHooks()->Count();
+}
+
+/////////////////////////////////////////////////
+std::size_t RenderHooks::FrameTaskCount()
+{
+  return frameTaskHooks()->Count();
+}
+}  // namespace gz::gui
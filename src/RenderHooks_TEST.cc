@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/RenderHooks.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, Order)
+{
+  std::vector<int> calls;
+
+  auto c0 = RenderHooks::OnRender([&calls](){calls.push_back(0);}, 5);
+  auto c1 = RenderHooks::OnRender([&calls](){calls.push_back(1);}, -5);
+  auto c2 = RenderHooks::OnRender([&calls](){calls.push_back(2);}, 5);
+  auto c3 = RenderHooks::OnRender([&calls](){calls.push_back(3);});
+  EXPECT_EQ(4u, RenderHooks::RenderCount());
+  EXPECT_EQ(0u, RenderHooks::PreRenderCount());
+
+  RenderHooks::RunRender();
+  EXPECT_EQ(std::vector<int>({1, 3, 0, 2}), calls);
+
+  // Pre-render hooks are independent
+  calls.clear();
+  RenderHooks::RunPreRender();
+  EXPECT_TRUE(calls.empty());
+
+  // Destroying the connection unregisters
+  c3.reset();
+  EXPECT_EQ(3u, RenderHooks::RenderCount());
+  RenderHooks::RunRender();
+  EXPECT_EQ(std::vector<int>({1, 0, 2}), calls);
+
+  c0.reset();
+  c1.reset();
+  c2.reset();
+  EXPECT_EQ(0u, RenderHooks::RenderCount());
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, PreRender)
+{
+  int count{0};
+  {
+    auto c = RenderHooks::OnPreRender([&count](){count++;});
+    EXPECT_EQ(1u, RenderHooks::PreRenderCount());
+
+    RenderHooks::RunPreRender();
+    RenderHooks::RunRender();
+    EXPECT_EQ(1, count);
+  }
+  EXPECT_EQ(0u, RenderHooks::PreRenderCount());
+
+  RenderHooks::RunPreRender();
+  EXPECT_EQ(1, count);
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, RenderRequest)
+{
+  int count{0};
+  auto c = RenderHooks::OnRenderRequest([&count](){count++;});
+
+  // Running the frame stages doesn't count as a request
+  RenderHooks::RunPreRender();
+  RenderHooks::RunRender();
+  EXPECT_EQ(0, count);
+
+  RenderHooks::RequestRender();
+  RenderHooks::RequestRender();
+  EXPECT_EQ(2, count);
+
+  c.reset();
+  RenderHooks::RequestRender();
+  EXPECT_EQ(2, count);
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, ConnectFromCallback)
+{
+  int outer{0};
+  int inner{0};
+  RenderHookConnectionPtr innerConnection;
+  RenderHookConnectionPtr outerConnection;
+
+  outerConnection = RenderHooks::OnRender([&]()
+  {
+    outer++;
+    if (nullptr == innerConnection)
+      innerConnection = RenderHooks::OnRender([&inner](){inner++;});
+    else
+      outerConnection.reset();
+  });
+
+  // Hook connected during the first frame only runs on the next one
+  RenderHooks::RunRender();
+  EXPECT_EQ(1, outer);
+  EXPECT_EQ(0, inner);
+
+  // Outer hook disconnects itself, inner one still runs this frame
+  RenderHooks::RunRender();
+  EXPECT_EQ(2, outer);
+  EXPECT_EQ(1, inner);
+  EXPECT_EQ(nullptr, outerConnection);
+
+  RenderHooks::RunRender();
+  EXPECT_EQ(2, outer);
+  EXPECT_EQ(2, inner);
+
+  innerConnection.reset();
+  EXPECT_EQ(0u, RenderHooks::RenderCount());
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, FrameTasks)
+{
+  using namespace std::chrono_literals;
+
+  int requests{0};
+  auto request = RenderHooks::OnRenderRequest([&requests](){requests++;});
+
+  // A task with a burst of work spreads it over frames, within its budget
+  std::vector<int> calls;
+  int work{100};
+  std::chrono::steady_clock::time_point deadline;
+  auto burst = RenderHooks::OnFrameTask(
+      [&](std::chrono::steady_clock::time_point _deadline)
+      {
+        calls.push_back(0);
+        deadline = _deadline;
+        do
+        {
+          std::this_thread::sleep_for(1ms);
+          --work;
+        }
+        while (work > 0 && std::chrono::steady_clock::now() < _deadline);
+        return work > 0;
+      }, 0, 5ms);
+  auto idle = RenderHooks::OnFrameTask(
+      [&calls](std::chrono::steady_clock::time_point)
+      {
+        calls.push_back(1);
+        return false;
+      }, 5, 0ms);
+  EXPECT_EQ(2u, RenderHooks::FrameTaskCount());
+  EXPECT_EQ(0u, RenderHooks::RenderCount());
+
+  // The deadline is the task's own budget when the frame's is larger
+  auto start = std::chrono::steady_clock::now();
+  RenderHooks::RunFrameTasks(0ms);
+  EXPECT_EQ(std::vector<int>({0, 1}), calls);
+  EXPECT_GT(work, 0);
+  EXPECT_LE(deadline - start, 6ms);
+  EXPECT_EQ(1, requests);
+
+  // The frame's budget runs out before the second task, which goes first
+  // on the next frame
+  calls.clear();
+  RenderHooks::RunFrameTasks(1ms);
+  EXPECT_EQ(std::vector<int>({0}), calls);
+  EXPECT_EQ(2, requests);
+  calls.clear();
+  RenderHooks::RunFrameTasks(1ms);
+  EXPECT_EQ(1, calls.front());
+
+  // Once the work is done, no more frames are requested
+  burst.reset();
+  idle.reset();
+  calls.clear();
+  requests = 0;
+  auto done = RenderHooks::OnFrameTask(
+      [&calls](std::chrono::steady_clock::time_point)
+      {
+        calls.push_back(2);
+        return false;
+      });
+  RenderHooks::RunFrameTasks(1ms);
+  EXPECT_EQ(std::vector<int>({2}), calls);
+  EXPECT_EQ(0, requests);
+
+  done.reset();
+  EXPECT_EQ(0u, RenderHooks::FrameTaskCount());
+}
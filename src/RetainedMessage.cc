@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include <google/protobuf/descriptor.h>
+
+#include <gz/msgs/Factory.hh>
+
+#include "gz/gui/RetainedMessage.hh"
+
+namespace gz::gui
+{
+/////////////////////////////////////////////////
+std::shared_ptr<google::protobuf::Message> NewArenaMessage(
+    const std::string &_type)
+{
+  // Compiled in types have a prototype ready, others, such as the ones
+  // gz-msgs loads from descriptors, are made by the factory
+  const google::protobuf::Message *prototype{nullptr};
+  std::unique_ptr<google::protobuf::Message> made;
+  if (const auto *descriptor = google::protobuf::DescriptorPool::
+      generated_pool()->FindMessageTypeByName(_type))
+  {
+    prototype = google::protobuf::MessageFactory::generated_factory()->
+        GetPrototype(descriptor);
+  }
+  if (nullptr == prototype)
+  {
+    made = gz::msgs::Factory::New(_type);
+    prototype = made.get();
+  }
+  if (nullptr == prototype)
+    return nullptr;
+
+  auto arena = std::make_shared<google::protobuf::Arena>();
+  auto *msg = prototype->New(arena.get());
+  return std::shared_ptr<google::protobuf::Message>(std::move(arena), msg);
+}
+}  // namespace gz::gui
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <gz/msgs/scene.pb.h>
+
+#include "gz/gui/RetainedMessage.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RetainedMessageTest, NewArenaMessage)
+{
+  auto scene = NewArenaMessage<msgs::Scene>();
+  ASSERT_NE(nullptr, scene);
+  EXPECT_NE(nullptr, scene->GetArena());
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    auto *model = scene->add_model();
+    model->set_id(i);
+    model->set_name("model_" + std::to_string(i));
+    EXPECT_EQ(scene->GetArena(), model->GetArena());
+  }
+
+  // Type known at runtime
+  auto msg = NewArenaMessage("gz.msgs.Scene");
+  ASSERT_NE(nullptr, msg);
+  EXPECT_NE(nullptr, msg->GetArena());
+  ASSERT_NE(nullptr, dynamic_cast<msgs::Scene *>(msg.get()));
+  ASSERT_TRUE(msg->ParseFromString(scene->SerializeAsString()));
+  EXPECT_EQ(100, dynamic_cast<msgs::Scene *>(msg.get())->model_size());
+
+  EXPECT_EQ(nullptr, NewArenaMessage("gz.msgs.NotAType"));
+}
+
+/////////////////////////////////////////////////
+TEST(RetainedMessageTest, Retain)
+{
+  msgs::Scene scene;
+  scene.set_name("world");
+  scene.add_model()->set_name("box");
+  scene.add_model()->set_name("sphere");
+
+  auto copy = RetainCopy(scene);
+  ASSERT_NE(nullptr, copy);
+  EXPECT_NE(nullptr, copy->GetArena());
+  EXPECT_EQ(scene.SerializeAsString(), copy->SerializeAsString());
+
+  // Parts keep the whole message
+  auto sphere = RetainPart(copy, copy->model(1));
+  EXPECT_EQ(&copy->model(1), sphere.get());
+  std::weak_ptr<const msgs::Scene> weak = copy;
+  copy.reset();
+  EXPECT_FALSE(weak.expired());
+  EXPECT_EQ("sphere", sphere->name());
+  sphere.reset();
+  EXPECT_TRUE(weak.expired());
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneCommands.hh"
+
+namespace gz::gui
+{
+namespace
+{
+struct Entry;
+
+/// \brief State of a queue, kept alive by its pending commands
+struct QueueState
+{
+  /// \brief Incremented when the queue is cleared or destroyed, which
+  /// drops the commands pushed before
+  uint64_t generation{0};
+
+  /// \brief Number of commands pending
+  std::size_t pending{0};
+
+  /// \brief Pending command of each key
+  std::unordered_map<std::string, std::shared_ptr<Entry>> latest;
+
+  /// \brief Measures the commands, null if the queue has no owner
+  std::unique_ptr<PerformanceCounter> counter;
+};
+
+/// \brief A recorded command
+struct Entry
+{
+  /// \brief Queue it was pushed to
+  std::shared_ptr<QueueState> queue;
+
+  /// \brief Generation of the queue when pushed
+  uint64_t generation{0};
+
+  /// \brief Key, empty if it can't be replaced
+  std::string key;
+
+  /// \brief The command
+  SceneCommandQueue::Command command;
+};
+
+/// \brief Commands of all queues, in the order they were pushed
+struct CommandList
+{
+  /// \brief Protects `entries`, `pending` and the queue states. Never held
+  /// while a command runs.
+  std::mutex mutex;
+
+  /// \brief Held while commands run, so destroyed queues can wait for
+  /// them. Recursive so that commands can destroy queues.
+  std::recursive_mutex runMutex;
+
+  /// \brief Pushed commands, including dropped ones until they're reached
+  std::deque<std::shared_ptr<Entry>> entries;
+
+  /// \brief Number of commands which weren't dropped
+  std::size_t pending{0};
+};
+
+/////////////////////////////////////////////////
+std::shared_ptr<CommandList> &commandList()
+{
+  static auto list = std::make_shared<CommandList>();
+  return list;
+}
+}  // namespace
+
+/// \brief Private data for SceneCommandQueue
+class SceneCommandQueue::Implementation
+{
+  /// \brief Drop pending commands. Must be called with the list's mutex
+  /// locked.
+  /// \param[in] _list List of all commands
+  public: void Drop(CommandList &_list)
+  {
+    ++this->state->generation;
+    _list.pending -= this->state->pending;
+    this->state->pending = 0;
+    this->state->latest.clear();
+    if (this->state->counter)
+      this->state->counter->SetQueueDepth(0);
+  }
+
+  /// \brief List of all commands. Weak so that queues outliving it during
+  /// static destruction don't touch it.
+  public: std::weak_ptr<CommandList> list;
+
+  /// \brief State shared with the pending commands
+  public: std::shared_ptr<QueueState> state;
+};
+
+/////////////////////////////////////////////////
+SceneCommandQueue::SceneCommandQueue(const std::string &_owner)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->list = commandList();
+  this->dataPtr->state = std::make_shared<QueueState>();
+  if (!_owner.empty())
+  {
+    this->dataPtr->state->counter =
+        std::make_unique<PerformanceCounter>(_owner, "scene command");
+  }
+}
+
+/////////////////////////////////////////////////
+SceneCommandQueue::~SceneCommandQueue()
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(list->mutex);
+    this->dataPtr->Drop(*list);
+  }
+
+  // Blocks while the render thread is running commands, so once this
+  // returns none of this queue's commands is running anymore
+  std::lock_guard<std::recursive_mutex> runLock(list->runMutex);
+  this->dataPtr->state->counter.reset();
+}
+
+/////////////////////////////////////////////////
+void SceneCommandQueue::Push(Command _cmd)
+{
+  this->PushLatest("", std::move(_cmd));
+}
+
+/////////////////////////////////////////////////
+void SceneCommandQueue::PushLatest(const std::string &_key, Command _cmd)
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list || !_cmd)
+    return;
+
+  auto &state = this->dataPtr->state;
+  {
+    std::lock_guard<std::mutex> lock(list->mutex);
+    if (!_key.empty())
+    {
+      auto it = state->latest.find(_key);
+      if (it != state->latest.end())
+      {
+        it->second->command = std::move(_cmd);
+        return;
+      }
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->queue = state;
+    entry->generation = state->generation;
+    entry->key = _key;
+    entry->command = std::move(_cmd);
+    if (!_key.empty())
+      state->latest[_key] = entry;
+    list->entries.push_back(std::move(entry));
+    ++list->pending;
+    ++state->pending;
+    if (state->counter)
+      state->counter->SetQueueDepth(state->pending);
+  }
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void SceneCommandQueue::Clear()
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return;
+
+  std::lock_guard<std::mutex> lock(list->mutex);
+  this->dataPtr->Drop(*list);
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneCommandQueue::Size() const
+{
+  auto list = this->dataPtr->list.lock();
+  if (nullptr == list)
+    return 0u;
+
+  std::lock_guard<std::mutex> lock(list->mutex);
+  return this->dataPtr->state->pending;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneCommands::Run(std::chrono::steady_clock::duration _budget)
+{
+  auto list = commandList();
+  std::lock_guard<std::recursive_mutex> runLock(list->runMutex);
+
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t count{0};
+  bool left{false};
+  while (true)
+  {
+    std::shared_ptr<Entry> entry;
+    {
+      std::lock_guard<std::mutex> lock(list->mutex);
+      while (!list->entries.empty())
+      {
+        auto front = std::move(list->entries.front());
+        list->entries.pop_front();
+        if (front->generation == front->queue->generation)
+        {
+          entry = std::move(front);
+          break;
+        }
+      }
+      if (nullptr == entry)
+        break;
+
+      auto &queue = *entry->queue;
+      --queue.pending;
+      --list->pending;
+      if (!entry->key.empty())
+        queue.latest.erase(entry->key);
+      if (queue.counter)
+        queue.counter->SetQueueDepth(queue.pending);
+    }
+
+    if (entry->queue->counter)
+    {
+      PerformanceTimer timer(*entry->queue->counter);
+      entry->command();
+    }
+    else
+    {
+      entry->command();
+    }
+    ++count;
+
+    if (_budget > std::chrono::steady_clock::duration::zero() &&
+        std::chrono::steady_clock::now() - start >= _budget)
+    {
+      std::lock_guard<std::mutex> lock(list->mutex);
+      left = list->pending > 0;
+      break;
+    }
+  }
+
+  // Continue next frame
+  if (left)
+    RenderHooks::RequestRender();
+
+  return count;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneCommands::PendingCount()
+{
+  auto list = commandList();
+  std::lock_guard<std::mutex> lock(list->mutex);
+  return list->pending;
+}
+}  // namespace gz::gui
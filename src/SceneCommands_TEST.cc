@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneCommands.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SceneCommandsTest, Order)
+{
+  std::vector<std::string> calls;
+  SceneCommandQueue a;
+  SceneCommandQueue b("SceneCommandsTest");
+
+  a.Push([&calls](){calls.push_back("a0");});
+  b.Push([&calls](){calls.push_back("b0");});
+  a.Push([&calls](){calls.push_back("a1");});
+  EXPECT_EQ(2u, a.Size());
+  EXPECT_EQ(1u, b.Size());
+  EXPECT_EQ(3u, SceneCommands::PendingCount());
+
+  // All queues, in the order pushed
+  EXPECT_EQ(3u, SceneCommands::Run(std::chrono::steady_clock::duration(0)));
+  EXPECT_EQ(std::vector<std::string>({"a0", "b0", "a1"}), calls);
+  EXPECT_EQ(0u, SceneCommands::PendingCount());
+  EXPECT_EQ(0u, SceneCommands::Run(std::chrono::steady_clock::duration(0)));
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCommandsTest, Latest)
+{
+  std::vector<std::string> calls;
+  SceneCommandQueue queue;
+
+  queue.PushLatest("pose", [&calls](){calls.push_back("pose 0");});
+  queue.Push([&calls](){calls.push_back("color");});
+  queue.PushLatest("pose", [&calls](){calls.push_back("pose 1");});
+  EXPECT_EQ(2u, queue.Size());
+
+  // The latest command keeps the place of the first
+  SceneCommands::Run(std::chrono::steady_clock::duration(0));
+  EXPECT_EQ(std::vector<std::string>({"pose 1", "color"}), calls);
+
+  // Once run, the key can be pushed again
+  queue.PushLatest("pose", [&calls](){calls.push_back("pose 2");});
+  EXPECT_EQ(1u, queue.Size());
+  SceneCommands::Run(std::chrono::steady_clock::duration(0));
+  EXPECT_EQ("pose 2", calls.back());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCommandsTest, Drop)
+{
+  int calls{0};
+  auto kept = std::make_unique<SceneCommandQueue>();
+  auto destroyed = std::make_unique<SceneCommandQueue>();
+
+  kept->Push([&calls](){++calls;});
+  destroyed->Push([&calls](){calls += 10;});
+  kept->Clear();
+  EXPECT_EQ(0u, kept->Size());
+  kept->PushLatest("key", [&calls](){calls += 100;});
+  destroyed.reset();
+  EXPECT_EQ(1u, SceneCommands::PendingCount());
+
+  EXPECT_EQ(1u, SceneCommands::Run(std::chrono::steady_clock::duration(0)));
+  EXPECT_EQ(100, calls);
+
+  // A command may destroy its own queue
+  kept->Push([&kept](){kept.reset();});
+  SceneCommands::Run(std::chrono::steady_clock::duration(0));
+  EXPECT_EQ(nullptr, kept);
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCommandsTest, Budget)
+{
+  int requests{0};
+  auto connection = RenderHooks::OnRenderRequest([&requests](){++requests;});
+
+  SceneCommandQueue queue;
+  int calls{0};
+  for (int i = 0; i < 3; ++i)
+  {
+    queue.Push([&calls]()
+    {
+      ++calls;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+  }
+  EXPECT_EQ(3, requests);
+
+  // One command per run, and a frame requested for the rest
+  EXPECT_EQ(1u, SceneCommands::Run(std::chrono::microseconds(1)));
+  EXPECT_EQ(4, requests);
+  EXPECT_EQ(1u, SceneCommands::Run(std::chrono::microseconds(1)));
+  EXPECT_EQ(1u, SceneCommands::Run(std::chrono::microseconds(1)));
+  EXPECT_EQ(5, requests);
+  EXPECT_EQ(3, calls);
+}
+
+/////////////////////////////////////////////////
+TEST(SceneCommandsTest, Threads)
+{
+  SceneCommandQueue queue;
+  int calls{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&queue, &calls]()
+    {
+      for (int i = 0; i < 100; ++i)
+        queue.Push([&calls](){++calls;});
+    });
+  }
+
+  // Commands only run on the thread calling Run
+  std::size_t run{0};
+  while (run < 400u)
+    run += SceneCommands::Run(std::chrono::steady_clock::duration(0));
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(400, calls);
+}
@@ -0,0 +1,689 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "gz/gui/SceneHistory.hh"
+
+namespace
+{
+/// \brief Largest value of a quaternion component which isn't the largest
+const double kMaxSmallest{1.0 / std::sqrt(2.0)};
+
+/// \brief Largest 10 bit value
+const std::uint32_t kMaxQuantized{1023};
+
+/// \brief Pose as stored
+struct Quantized
+{
+  /// \brief Position, in multiples of the precision
+  std::array<std::int64_t, 3> pos{0, 0, 0};
+
+  /// \brief Rotation, compressed like PackedPoses does
+  std::uint32_t rot{0};
+
+  /// \brief Equality operator
+  /// \param[in] _other Other pose
+  /// \return True if both are stored the same
+  bool operator==(const Quantized &_other) const
+  {
+    return this->pos == _other.pos && this->rot == _other.rot;
+  }
+};
+
+/// \brief Flag of an entry whose position changed
+const std::uint8_t kPosChanged{1};
+
+/// \brief Flag of an entry whose rotation changed
+const std::uint8_t kRotChanged{2};
+
+/////////////////////////////////////////////////
+/// \brief Drop the largest component of a unit quaternion and quantize the
+/// others to 10 bits
+/// \param[in] _rot Rotation
+/// \return Index of the largest component in the 2 high bits, then the
+/// others
+std::uint32_t compress(const gz::math::Quaterniond &_rot)
+{
+  std::array<double, 4> q{_rot.W(), _rot.X(), _rot.Y(), _rot.Z()};
+  std::uint32_t largest{0};
+  for (std::uint32_t i = 1; i < 4; ++i)
+  {
+    if (std::abs(q[i]) > std::abs(q[largest]))
+      largest = i;
+  }
+
+  // q and -q are the same rotation, the dropped component is positive
+  const double sign = q[largest] < 0 ? -1.0 : 1.0;
+  std::uint32_t bits = largest << 30;
+  int shift{20};
+  for (std::uint32_t i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+    const double unit = (sign * q[i] / kMaxSmallest + 1.0) * 0.5;
+    const auto quantized = static_cast<std::uint32_t>(std::lround(
+        std::clamp(unit, 0.0, 1.0) * kMaxQuantized));
+    bits |= quantized << shift;
+    shift -= 10;
+  }
+  return bits;
+}
+
+/////////////////////////////////////////////////
+/// \brief Inverse of compress
+/// \param[in] _bits Compressed rotation
+/// \return Unit quaternion
+gz::math::Quaterniond decompress(std::uint32_t _bits)
+{
+  const std::uint32_t largest = _bits >> 30;
+  std::array<double, 4> q{0, 0, 0, 0};
+  double sum{0};
+  int shift{20};
+  for (std::uint32_t i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+    const double unit =
+        static_cast<double>((_bits >> shift) & kMaxQuantized) / kMaxQuantized;
+    q[i] = (unit * 2.0 - 1.0) * kMaxSmallest;
+    sum += q[i] * q[i];
+    shift -= 10;
+  }
+  q[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+  return gz::math::Quaterniond(q[0], q[1], q[2], q[3]);
+}
+
+/////////////////////////////////////////////////
+/// \brief Append an unsigned integer, 7 bits per byte, low bits first
+/// \param[in,out] _data Data
+/// \param[in] _value Value
+void writeVarint(std::string &_data, std::uint64_t _value)
+{
+  while (_value >= 0x80)
+  {
+    _data.push_back(static_cast<char>((_value & 0x7F) | 0x80));
+    _value >>= 7;
+  }
+  _data.push_back(static_cast<char>(_value));
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a signed integer, small magnitudes in few bytes
+/// \param[in,out] _data Data
+/// \param[in] _value Value
+void writeSigned(std::string &_data, std::int64_t _value)
+{
+  writeVarint(_data, (static_cast<std::uint64_t>(_value) << 1) ^
+      static_cast<std::uint64_t>(_value >> 63));
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an integer written by writeVarint
+/// \param[in,out] _pos Position in the data, moved past the integer
+/// \return Value
+std::uint64_t readVarint(const char *&_pos)
+{
+  std::uint64_t value{0};
+  int shift{0};
+  std::uint8_t byte;
+  do
+  {
+    byte = static_cast<std::uint8_t>(*_pos++);
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read an integer written by writeSigned
+/// \param[in,out] _pos Position in the data, moved past the integer
+/// \return Value
+std::int64_t readSigned(const char *&_pos)
+{
+  const std::uint64_t value = readVarint(_pos);
+  return static_cast<std::int64_t>(value >> 1) ^
+      -static_cast<std::int64_t>(value & 1);
+}
+
+/// \brief Samples of a few seconds, the first one full and the others
+/// only holding what changed
+struct Chunk
+{
+  /// \brief Time of the first sample
+  double start{0.0};
+
+  /// \brief Time of the last sample
+  double end{0.0};
+
+  /// \brief Samples, each made of its time in milliseconds after the
+  /// start, its number of entries, and for each entry, in order of id: the
+  /// difference with the previous id, flags, the difference with the
+  /// previous position if it changed and the rotation if it changed.
+  /// Differences are from zero in the first sample.
+  std::string data;
+};
+
+/// \brief Entity added or removed
+struct Event
+{
+  /// \brief Time
+  double stamp{0.0};
+
+  /// \brief Entity id
+  unsigned int id{0};
+
+  /// \brief True if added, false if removed
+  bool added{false};
+
+  /// \brief Data to create it again, if added
+  std::string data;
+};
+}  // namespace
+
+namespace gz::gui
+{
+/// \brief Private data
+class SceneHistory::Implementation
+{
+  /// \brief Store the poses received since the last sample
+  /// \param[in] _stamp Time of the sample
+  public: void Sample(double _stamp);
+
+  /// \brief Drop the oldest chunks beyond the duration or budget
+  public: void Trim();
+
+  /// \brief Decode the samples of a chunk up to a time
+  /// \param[in] _chunk Chunk
+  /// \param[in] _time Time
+  /// \param[out] _state Poses at that time
+  public: static void Decode(const Chunk &_chunk, double _time,
+      std::map<unsigned int, Quantized> &_state);
+
+  /// \brief Protects everything below
+  public: mutable std::mutex mutex;
+
+  /// \brief See SetDuration
+  public: double duration{600.0};
+
+  /// \brief See SetMaxBytes
+  public: std::size_t maxBytes{256u << 20};
+
+  /// \brief Time between samples
+  public: double period{0.1};
+
+  /// \brief See SetPrecision
+  public: double precision{0.001};
+
+  /// \brief See SetKeyframeInterval
+  public: double keyframeInterval{5.0};
+
+  /// \brief Latest pose received for each entity
+  public: std::unordered_map<unsigned int, Quantized> current;
+
+  /// \brief Pose of each entity as of the last sample of the last chunk
+  public: std::unordered_map<unsigned int, Quantized> sampled;
+
+  /// \brief Entities whose pose was received since the last sample
+  public: std::unordered_set<unsigned int> changed;
+
+  /// \brief Latest time recorded
+  public: std::optional<double> lastStamp;
+
+  /// \brief Time of the next sample, on a fixed grid so frames which don't
+  /// line up with the rate don't stretch the period
+  public: double nextSample{0.0};
+
+  /// \brief Chunks, oldest first
+  public: std::deque<Chunk> chunks;
+
+  /// \brief Additions and removals, oldest first. Before the first chunk,
+  /// only the latest addition of entities which weren't removed since is
+  /// kept.
+  public: std::deque<Event> events;
+
+  /// \brief Ids with events
+  public: std::unordered_map<unsigned int, std::size_t> tracked;
+
+  /// \brief Sum of the sizes of the chunks and events
+  public: std::size_t bytes{0};
+
+  /// \brief See Scrub
+  public: std::optional<double> scrubTime;
+};
+
+/////////////////////////////////////////////////
+void SceneHistory::Implementation::Sample(double _stamp)
+{
+  const bool keyframe = this->chunks.empty() ||
+      _stamp - this->chunks.back().start >= this->keyframeInterval;
+  if (!keyframe && this->changed.empty())
+    return;
+
+  std::vector<unsigned int> ids;
+  if (keyframe)
+  {
+    this->chunks.push_back(Chunk{_stamp, _stamp, {}});
+    this->sampled.clear();
+    ids.reserve(this->current.size());
+    for (const auto &[id, pose] : this->current)
+      ids.push_back(id);
+  }
+  else
+  {
+    ids.assign(this->changed.begin(), this->changed.end());
+  }
+  this->changed.clear();
+  std::sort(ids.begin(), ids.end());
+
+  auto &chunk = this->chunks.back();
+  const std::size_t sizeBefore = chunk.data.size();
+  std::string entries;
+  std::size_t count{0};
+  unsigned int previousId{0};
+  for (const auto id : ids)
+  {
+    auto it = this->current.find(id);
+    if (it == this->current.end())
+      continue;
+    const auto &pose = it->second;
+    auto [old, inserted] = this->sampled.try_emplace(id, Quantized{});
+    std::uint8_t flags{0};
+    if (inserted || old->second.pos != pose.pos)
+      flags |= kPosChanged;
+    if (inserted || old->second.rot != pose.rot)
+      flags |= kRotChanged;
+    if (0 == flags)
+      continue;
+
+    writeVarint(entries, id - previousId);
+    previousId = id;
+    entries.push_back(static_cast<char>(flags));
+    if (flags & kPosChanged)
+    {
+      for (std::size_t i = 0; i < 3; ++i)
+        writeSigned(entries, pose.pos[i] - old->second.pos[i]);
+    }
+    if (flags & kRotChanged)
+    {
+      for (int shift = 0; shift < 32; shift += 8)
+        entries.push_back(static_cast<char>((pose.rot >> shift) & 0xFF));
+    }
+    old->second = pose;
+    ++count;
+  }
+
+  if (0 == count && !keyframe)
+    return;
+
+  writeVarint(chunk.data, static_cast<std::uint64_t>(std::llround(
+      (_stamp - chunk.start) * 1000.0)));
+  writeVarint(chunk.data, count);
+  chunk.data += entries;
+  chunk.end = _stamp;
+  this->bytes += chunk.data.size() - sizeBefore;
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::Implementation::Trim()
+{
+  const double end = this->chunks.empty() ? 0.0 : this->chunks.back().end;
+  bool dropped{false};
+  while (this->chunks.size() > 1 &&
+      (this->bytes > this->maxBytes ||
+      end - this->chunks[1].start >= this->duration))
+  {
+    this->bytes -= this->chunks.front().data.size();
+    this->chunks.pop_front();
+    dropped = true;
+  }
+  if (!dropped)
+    return;
+
+  // Events before the history starts only matter for the entities still
+  // there when it starts
+  const double start = this->chunks.front().start;
+  std::unordered_map<unsigned int, std::size_t> latest;
+  std::size_t first{0};
+  for (; first < this->events.size() && this->events[first].stamp < start;
+      ++first)
+  {
+    latest[this->events[first].id] = first;
+  }
+  if (0 == first)
+    return;
+
+  std::deque<Event> kept;
+  for (std::size_t i = 0; i < this->events.size(); ++i)
+  {
+    auto &event = this->events[i];
+    const bool keep = i >= first ||
+        (latest[event.id] == i && event.added);
+    if (keep)
+    {
+      kept.push_back(std::move(event));
+      continue;
+    }
+    this->bytes -= event.data.size();
+    auto it = this->tracked.find(event.id);
+    if (it != this->tracked.end() && --it->second == 0)
+      this->tracked.erase(it);
+  }
+  this->events.swap(kept);
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::Implementation::Decode(const Chunk &_chunk, double _time,
+    std::map<unsigned int, Quantized> &_state)
+{
+  const char *pos = _chunk.data.data();
+  const char *end = pos + _chunk.data.size();
+  while (pos < end)
+  {
+    const double stamp = _chunk.start +
+        static_cast<double>(readVarint(pos)) / 1000.0;
+    if (stamp > _time + 1e-9)
+      return;
+
+    const std::uint64_t count = readVarint(pos);
+    unsigned int id{0};
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+      id += static_cast<unsigned int>(readVarint(pos));
+      const auto flags = static_cast<std::uint8_t>(*pos++);
+      auto &pose = _state[id];
+      if (flags & kPosChanged)
+      {
+        for (std::size_t k = 0; k < 3; ++k)
+          pose.pos[k] += readSigned(pos);
+      }
+      if (flags & kRotChanged)
+      {
+        pose.rot = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+          pose.rot |= static_cast<std::uint32_t>(
+              static_cast<std::uint8_t>(*pos++)) << shift;
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+SceneHistory::SceneHistory()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::SetDuration(double _seconds)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->duration = std::max(0.0, _seconds);
+  this->dataPtr->Trim();
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::SetMaxBytes(std::size_t _bytes)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->maxBytes = _bytes;
+  this->dataPtr->Trim();
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::SetRate(double _hz)
+{
+  if (_hz <= 0.0)
+    return;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->period = 1.0 / _hz;
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::SetPrecision(double _meters)
+{
+  if (_meters <= 0.0)
+    return;
+
+  // Recorded positions are in multiples of the previous precision
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->precision = _meters;
+  this->dataPtr->chunks.clear();
+  this->dataPtr->current.clear();
+  this->dataPtr->sampled.clear();
+  this->dataPtr->changed.clear();
+  this->dataPtr->bytes = 0;
+  for (const auto &event : this->dataPtr->events)
+    this->dataPtr->bytes += event.data.size();
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::SetKeyframeInterval(double _seconds)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->keyframeInterval = std::max(0.0, _seconds);
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::RecordPoses(double _stamp,
+    const std::vector<Pose> &_poses)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->lastStamp)
+    _stamp = std::max(_stamp, *this->dataPtr->lastStamp);
+
+  for (const auto &pose : _poses)
+  {
+    Quantized quantized;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      quantized.pos[i] = std::llround(pose.pose.Pos()[i] /
+          this->dataPtr->precision);
+    }
+    quantized.rot = compress(pose.pose.Rot());
+    auto [stored, inserted] =
+        this->dataPtr->current.try_emplace(pose.id, quantized);
+    if (!inserted && stored->second == quantized)
+      continue;
+    stored->second = quantized;
+    this->dataPtr->changed.insert(pose.id);
+  }
+
+  const bool due = this->dataPtr->chunks.empty() ||
+      _stamp >= this->dataPtr->nextSample - 1e-6;
+  this->dataPtr->lastStamp = _stamp;
+  if (!due)
+    return;
+  this->dataPtr->nextSample = this->dataPtr->chunks.empty() ? _stamp :
+      this->dataPtr->nextSample;
+  this->dataPtr->nextSample += this->dataPtr->period;
+  if (this->dataPtr->nextSample <= _stamp)
+    this->dataPtr->nextSample = _stamp + this->dataPtr->period;
+  this->dataPtr->Sample(_stamp);
+  this->dataPtr->Trim();
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::RecordAdded(double _stamp, unsigned int _id,
+    const std::string &_data)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->lastStamp)
+    _stamp = std::max(_stamp, *this->dataPtr->lastStamp);
+  this->dataPtr->lastStamp = _stamp;
+  this->dataPtr->events.push_back(Event{_stamp, _id, true, _data});
+  this->dataPtr->tracked[_id]++;
+  this->dataPtr->bytes += _data.size();
+  this->dataPtr->Trim();
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::RecordRemoved(double _stamp, unsigned int _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->current.erase(_id);
+  this->dataPtr->changed.erase(_id);
+
+  // Only entities whose addition is known can be brought back
+  if (this->dataPtr->tracked.count(_id) == 0)
+    return;
+  if (this->dataPtr->lastStamp)
+    _stamp = std::max(_stamp, *this->dataPtr->lastStamp);
+  this->dataPtr->lastStamp = _stamp;
+  this->dataPtr->events.push_back(Event{_stamp, _id, false, {}});
+  this->dataPtr->tracked[_id]++;
+}
+
+/////////////////////////////////////////////////
+bool SceneHistory::Range(double &_start, double &_end) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->chunks.empty())
+    return false;
+  _start = this->dataPtr->chunks.front().start;
+  _end = std::max(this->dataPtr->chunks.back().end,
+      this->dataPtr->lastStamp.value_or(_start));
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneHistory::Bytes() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->bytes;
+}
+
+/////////////////////////////////////////////////
+bool SceneHistory::PosesAt(double _time, std::vector<Pose> &_poses) const
+{
+  std::map<unsigned int, Quantized> state;
+  double precision;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    const auto &chunks = this->dataPtr->chunks;
+    if (chunks.empty())
+      return false;
+
+    // Poses received since the last sample are part of the present
+    if (_time >= this->dataPtr->lastStamp.value_or(chunks.back().end))
+    {
+      state.insert(this->dataPtr->current.begin(),
+          this->dataPtr->current.end());
+    }
+    else
+    {
+      auto chunk = std::upper_bound(chunks.begin(), chunks.end(), _time,
+          [](double _t, const Chunk &_chunk)
+          {
+            return _t < _chunk.start;
+          });
+      if (chunk != chunks.begin())
+        --chunk;
+      Implementation::Decode(*chunk, std::max(_time, chunk->start), state);
+    }
+    precision = this->dataPtr->precision;
+  }
+
+  _poses.clear();
+  _poses.reserve(state.size());
+  for (const auto &[id, pose] : state)
+  {
+    _poses.push_back({id, math::Pose3d(
+        math::Vector3d(static_cast<double>(pose.pos[0]) * precision,
+                       static_cast<double>(pose.pos[1]) * precision,
+                       static_cast<double>(pose.pos[2]) * precision),
+        decompress(pose.rot))});
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<SceneHistory::Added> SceneHistory::AliveAt(double _time) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::unordered_map<unsigned int, const Event *> latest;
+  for (const auto &event : this->dataPtr->events)
+  {
+    if (event.stamp > _time)
+      break;
+    latest[event.id] = &event;
+  }
+
+  std::vector<Added> alive;
+  for (const auto &[id, event] : latest)
+  {
+    if (event->added)
+      alive.push_back({event->stamp, id, event->data});
+  }
+  return alive;
+}
+
+/////////////////////////////////////////////////
+bool SceneHistory::Tracked(unsigned int _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->tracked.count(_id) > 0;
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::Scrub(double _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->scrubTime = _time;
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::Live()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->scrubTime.reset();
+}
+
+/////////////////////////////////////////////////
+std::optional<double> SceneHistory::ScrubTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->scrubTime;
+}
+
+/////////////////////////////////////////////////
+void SceneHistory::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->current.clear();
+  this->dataPtr->sampled.clear();
+  this->dataPtr->changed.clear();
+  this->dataPtr->lastStamp.reset();
+  this->dataPtr->chunks.clear();
+  this->dataPtr->events.clear();
+  this->dataPtr->tracked.clear();
+  this->dataPtr->bytes = 0;
+  this->dataPtr->scrubTime.reset();
+}
+}  // namespace gz::gui
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gz/gui/SceneHistory.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Entities 1 to _count, the first one moving along X
+/// \param[in] _count Number of entities
+/// \param[in] _time Time in seconds
+/// \return Poses
+std::vector<SceneHistory::Pose> scene(unsigned int _count, double _time)
+{
+  std::vector<SceneHistory::Pose> poses;
+  for (unsigned int i = 1; i <= _count; ++i)
+  {
+    const double x = i == 1 ? _time : static_cast<double>(i);
+    poses.push_back({i, math::Pose3d(x, 2, -3, 0.1 * i, 0.2, -0.3)});
+  }
+  return poses;
+}
+
+/////////////////////////////////////////////////
+TEST(SceneHistoryTest, Poses)
+{
+  SceneHistory history;
+  std::vector<SceneHistory::Pose> poses;
+  double start, end;
+  EXPECT_FALSE(history.Range(start, end));
+  EXPECT_FALSE(history.PosesAt(0.0, poses));
+
+  for (int i = 0; i <= 200; ++i)
+    history.RecordPoses(i * 0.05, scene(5, i * 0.05));
+
+  ASSERT_TRUE(history.Range(start, end));
+  EXPECT_DOUBLE_EQ(0.0, start);
+  EXPECT_DOUBLE_EQ(10.0, end);
+
+  // Samples are 0.1 s apart, the pose at a time is the latest sample
+  ASSERT_TRUE(history.PosesAt(3.27, poses));
+  ASSERT_EQ(5u, poses.size());
+  const auto expected = scene(5, 3.2);
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_EQ(expected[i].id, poses[i].id);
+    EXPECT_NEAR(expected[i].pose.Pos().X(), poses[i].pose.Pos().X(), 1e-3);
+    EXPECT_NEAR(expected[i].pose.Pos().Y(), poses[i].pose.Pos().Y(), 1e-3);
+    EXPECT_NEAR(expected[i].pose.Pos().Z(), poses[i].pose.Pos().Z(), 1e-3);
+
+    // Same rotation, up to the sign
+    const auto &a = expected[i].pose.Rot();
+    const auto &b = poses[i].pose.Rot();
+    const double dot = a.W() * b.W() + a.X() * b.X() + a.Y() * b.Y() +
+        a.Z() * b.Z();
+    EXPECT_NEAR(1.0, std::abs(dot), 1e-5);
+  }
+
+  // Clamped to the range
+  ASSERT_TRUE(history.PosesAt(-5.0, poses));
+  EXPECT_NEAR(0.0, poses[0].pose.Pos().X(), 1e-3);
+  ASSERT_TRUE(history.PosesAt(50.0, poses));
+  EXPECT_NEAR(10.0, poses[0].pose.Pos().X(), 1e-3);
+}
+
+/////////////////////////////////////////////////
+TEST(SceneHistoryTest, Deltas)
+{
+  // Still entities cost little beyond the full samples
+  SceneHistory still;
+  SceneHistory moving;
+  for (int i = 0; i <= 100; ++i)
+  {
+    still.RecordPoses(i * 0.1, scene(100, 0.0));
+    auto poses = scene(100, 0.0);
+    for (auto &pose : poses)
+      pose.pose.Pos().X() += i * 0.01;
+    moving.RecordPoses(i * 0.1, poses);
+  }
+  EXPECT_GT(still.Bytes(), 0u);
+  EXPECT_LT(still.Bytes() * 5, moving.Bytes());
+
+  // Moving entities take a few bytes per sample
+  EXPECT_LT(moving.Bytes(), 100u * 101u * 12u);
+}
+
+/////////////////////////////////////////////////
+TEST(SceneHistoryTest, Trim)
+{
+  SceneHistory history;
+  history.SetDuration(20.0);
+  for (int i = 0; i <= 600; ++i)
+    history.RecordPoses(i * 0.1, scene(10, i * 0.1));
+
+  double start, end;
+  ASSERT_TRUE(history.Range(start, end));
+  EXPECT_DOUBLE_EQ(60.0, end);
+  EXPECT_GE(start, 35.0);
+  EXPECT_LE(start, 40.0);
+
+  // Older history is dropped to stay within the budget
+  const std::size_t bytes = history.Bytes();
+  history.SetMaxBytes(bytes / 2);
+  EXPECT_LE(history.Bytes(), bytes / 2);
+  double trimmed;
+  ASSERT_TRUE(history.Range(trimmed, end));
+  EXPECT_GT(trimmed, start);
+
+  std::vector<SceneHistory::Pose> poses;
+  ASSERT_TRUE(history.PosesAt(trimmed, poses));
+  EXPECT_EQ(10u, poses.size());
+  EXPECT_NEAR(trimmed, poses[0].pose.Pos().X(), 1e-3);
+
+  history.Clear();
+  EXPECT_FALSE(history.Range(start, end));
+  EXPECT_EQ(0u, history.Bytes());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneHistoryTest, Events)
+{
+  SceneHistory history;
+  history.SetDuration(10.0);
+  history.RecordPoses(0.0, {});
+  history.RecordAdded(1.0, 1, "one");
+  history.RecordAdded(2.0, 2, "two");
+  history.RecordPoses(2.0, scene(2, 2.0));
+  history.RecordRemoved(3.0, 1);
+  history.RecordAdded(4.0, 2, "two again");
+
+  EXPECT_TRUE(history.Tracked(1));
+  EXPECT_TRUE(history.Tracked(2));
+  EXPECT_FALSE(history.Tracked(3));
+
+  // Removing an entity which wasn't added while recording is ignored
+  history.RecordRemoved(4.0, 3);
+  EXPECT_FALSE(history.Tracked(3));
+
+  EXPECT_TRUE(history.AliveAt(0.5).empty());
+  auto alive = history.AliveAt(2.5);
+  ASSERT_EQ(2u, alive.size());
+  alive = history.AliveAt(3.5);
+  ASSERT_EQ(1u, alive.size());
+  EXPECT_EQ(2u, alive[0].id);
+  EXPECT_EQ("two", alive[0].data);
+  alive = history.AliveAt(4.0);
+  ASSERT_EQ(1u, alive.size());
+  EXPECT_EQ("two again", alive[0].data);
+
+  // Removed entities have no pose afterwards
+  std::vector<SceneHistory::Pose> poses;
+  history.RecordPoses(5.0, {});
+  ASSERT_TRUE(history.PosesAt(5.0, poses));
+  ASSERT_EQ(1u, poses.size());
+  EXPECT_EQ(2u, poses[0].id);
+
+  // Once the history starts past them, only the latest addition of the
+  // remaining entities is kept
+  for (int i = 6; i <= 30; ++i)
+    history.RecordPoses(i, {});
+  EXPECT_FALSE(history.Tracked(1));
+  EXPECT_TRUE(history.Tracked(2));
+  alive = history.AliveAt(30.0);
+  ASSERT_EQ(1u, alive.size());
+  EXPECT_EQ("two again", alive[0].data);
+}
+
+/////////////////////////////////////////////////
+TEST(SceneHistoryTest, Scrub)
+{
+  SceneHistory history;
+  EXPECT_FALSE(history.ScrubTime());
+
+  history.Scrub(1.5);
+  ASSERT_TRUE(history.ScrubTime());
+  EXPECT_DOUBLE_EQ(1.5, *history.ScrubTime());
+
+  history.Live();
+  EXPECT_FALSE(history.ScrubTime());
+
+  history.Scrub(2.0);
+  history.Clear();
+  EXPECT_FALSE(history.ScrubTime());
+}
@@ -0,0 +1,693 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/SceneIndex.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Index of no node
+constexpr int kNull{-1};
+
+/// \brief Node of the tree
+struct Node
+{
+  /// \brief Minimum corner of the box. For leaves, the entity's box with
+  /// the margin, for other nodes the box around both children.
+  math::Vector3d min;
+
+  /// \brief Maximum corner of the box
+  math::Vector3d max;
+
+  /// \brief Minimum corner of the entity's box, only for leaves
+  math::Vector3d tightMin;
+
+  /// \brief Maximum corner of the entity's box, only for leaves
+  math::Vector3d tightMax;
+
+  /// \brief Parent, kNull for the root. Next free node for free nodes.
+  int parent{kNull};
+
+  /// \brief First child, kNull for leaves
+  int left{kNull};
+
+  /// \brief Second child, kNull for leaves
+  int right{kNull};
+
+  /// \brief Height of the subtree, 0 for leaves and -1 for free nodes
+  int height{0};
+
+  /// \brief Id of the entity, only for leaves
+  unsigned int id{0};
+
+  /// \brief Check if the node is a leaf
+  /// \return True for leaves
+  bool IsLeaf() const
+  {
+    return kNull == this->left;
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Half the surface area of a box, the cost of testing against it
+/// \param[in] _min Minimum corner
+/// \param[in] _max Maximum corner
+/// \return Cost
+double cost(const math::Vector3d &_min, const math::Vector3d &_max)
+{
+  const math::Vector3d size = _max - _min;
+  return size.X() * size.Y() + size.Y() * size.Z() + size.Z() * size.X();
+}
+
+/////////////////////////////////////////////////
+/// \brief Cost of the box around two boxes
+/// \param[in] _a First box
+/// \param[in] _b Second box
+/// \return Cost
+double mergedCost(const Node &_a, const Node &_b)
+{
+  return cost(math::Vector3d(std::min(_a.min.X(), _b.min.X()),
+      std::min(_a.min.Y(), _b.min.Y()), std::min(_a.min.Z(), _b.min.Z())),
+      math::Vector3d(std::max(_a.max.X(), _b.max.X()),
+      std::max(_a.max.Y(), _b.max.Y()), std::max(_a.max.Z(), _b.max.Z())));
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a box contains another
+/// \param[in] _outerMin Minimum corner of the outer box
+/// \param[in] _outerMax Maximum corner of the outer box
+/// \param[in] _min Minimum corner of the inner box
+/// \param[in] _max Maximum corner of the inner box
+/// \return True if the inner box is entirely inside
+bool contains(const math::Vector3d &_outerMin, const math::Vector3d &_outerMax,
+    const math::Vector3d &_min, const math::Vector3d &_max)
+{
+  return _outerMin.X() <= _min.X() && _outerMin.Y() <= _min.Y() &&
+      _outerMin.Z() <= _min.Z() && _max.X() <= _outerMax.X() &&
+      _max.Y() <= _outerMax.Y() && _max.Z() <= _outerMax.Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if two boxes overlap, touching counts
+/// \param[in] _minA Minimum corner of the first box
+/// \param[in] _maxA Maximum corner of the first box
+/// \param[in] _minB Minimum corner of the second box
+/// \param[in] _maxB Maximum corner of the second box
+/// \return True if they overlap
+bool overlap(const math::Vector3d &_minA, const math::Vector3d &_maxA,
+    const math::Vector3d &_minB, const math::Vector3d &_maxB)
+{
+  return _minA.X() <= _maxB.X() && _minB.X() <= _maxA.X() &&
+      _minA.Y() <= _maxB.Y() && _minB.Y() <= _maxA.Y() &&
+      _minA.Z() <= _maxB.Z() && _minB.Z() <= _maxA.Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a box is at least partly on the positive side of all
+/// planes
+/// \param[in] _planes Planes
+/// \param[in] _min Minimum corner of the box
+/// \param[in] _max Maximum corner of the box
+/// \return True unless the box is entirely behind a plane
+bool within(const std::vector<math::Planed> &_planes,
+    const math::Vector3d &_min, const math::Vector3d &_max)
+{
+  for (const auto &plane : _planes)
+  {
+    // Corner furthest along the normal
+    const auto &normal = plane.Normal();
+    const math::Vector3d corner(
+        normal.X() >= 0 ? _max.X() : _min.X(),
+        normal.Y() >= 0 ? _max.Y() : _min.Y(),
+        normal.Z() >= 0 ? _max.Z() : _min.Z());
+    if (plane.Distance(corner) < 0)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Distance from a point to a box
+/// \param[in] _point Point
+/// \param[in] _min Minimum corner of the box
+/// \param[in] _max Maximum corner of the box
+/// \return Distance, 0 inside
+double distance(const math::Vector3d &_point, const math::Vector3d &_min,
+    const math::Vector3d &_max)
+{
+  double squared{0.0};
+  for (int i = 0; i < 3; ++i)
+  {
+    const double d = std::max({_min[i] - _point[i], 0.0,
+        _point[i] - _max[i]});
+    squared += d * d;
+  }
+  return std::sqrt(squared);
+}
+
+/////////////////////////////////////////////////
+/// \brief Distance along a ray at which it enters a box
+/// \param[in] _origin Origin of the ray
+/// \param[in] _direction Direction of the ray, normalized
+/// \param[in] _maxDistance Length of the ray
+/// \param[in] _min Minimum corner of the box
+/// \param[in] _max Maximum corner of the box
+/// \return Distance, 0 if the origin is inside, negative if it misses
+double enter(const math::Vector3d &_origin, const math::Vector3d &_direction,
+    double _maxDistance, const math::Vector3d &_min,
+    const math::Vector3d &_max)
+{
+  double near{0.0};
+  double far{_maxDistance};
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(_direction[i]) < 1e-12)
+    {
+      if (_origin[i] < _min[i] || _origin[i] > _max[i])
+        return -1.0;
+      continue;
+    }
+    double t1 = (_min[i] - _origin[i]) / _direction[i];
+    double t2 = (_max[i] - _origin[i]) / _direction[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    near = std::max(near, t1);
+    far = std::min(far, t2);
+    if (near > far)
+      return -1.0;
+  }
+  return near;
+}
+}  // namespace
+
+/// \brief Private data
+class SceneIndex::Implementation
+{
+  /// \brief Take a free node, or add one
+  /// \return Index of the node
+  public: int Allocate();
+
+  /// \brief Put a node back in the free list
+  /// \param[in] _node Index of the node
+  public: void Free(int _node);
+
+  /// \brief Insert a leaf in the tree
+  /// \param[in] _leaf Index of the leaf, with its boxes set
+  public: void InsertLeaf(int _leaf);
+
+  /// \brief Take a leaf out of the tree, without freeing it
+  /// \param[in] _leaf Index of the leaf
+  public: void RemoveLeaf(int _leaf);
+
+  /// \brief Recompute the boxes and heights from a node up to the root,
+  /// rotating unbalanced nodes
+  /// \param[in] _node Index of the first node
+  public: void Refit(int _node);
+
+  /// \brief Rotate a node if one of its subtrees is more than one level
+  /// higher than the other
+  /// \param[in] _node Index of the node
+  /// \return Index of the node now at its place
+  public: int Balance(int _node);
+
+  /// \brief Recompute the box and height of a node from its children
+  /// \param[in] _node Index of the node
+  public: void Fit(int _node);
+
+  /// \brief Protects everything below
+  public: mutable std::shared_mutex mutex;
+
+  /// \brief Nodes, used and free
+  public: std::vector<Node> nodes;
+
+  /// \brief Root, kNull if empty
+  public: int root{kNull};
+
+  /// \brief First free node, kNull if none
+  public: int freeList{kNull};
+
+  /// \brief Leaf of each entity id
+  public: std::unordered_map<unsigned int, int> leaves;
+
+  /// \brief See SetMargin
+  public: double margin{0.1};
+};
+
+/////////////////////////////////////////////////
+int SceneIndex::Implementation::Allocate()
+{
+  if (kNull == this->freeList)
+  {
+    this->nodes.emplace_back();
+    return static_cast<int>(this->nodes.size()) - 1;
+  }
+  const int node = this->freeList;
+  this->freeList = this->nodes[node].parent;
+  this->nodes[node] = Node();
+  return node;
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::Implementation::Free(int _node)
+{
+  this->nodes[_node].parent = this->freeList;
+  this->nodes[_node].height = -1;
+  this->freeList = _node;
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::Implementation::Fit(int _node)
+{
+  auto &node = this->nodes[_node];
+  const auto &left = this->nodes[node.left];
+  const auto &right = this->nodes[node.right];
+  node.min.Set(std::min(left.min.X(), right.min.X()),
+      std::min(left.min.Y(), right.min.Y()),
+      std::min(left.min.Z(), right.min.Z()));
+  node.max.Set(std::max(left.max.X(), right.max.X()),
+      std::max(left.max.Y(), right.max.Y()),
+      std::max(left.max.Z(), right.max.Z()));
+  node.height = 1 + std::max(left.height, right.height);
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::Implementation::InsertLeaf(int _leaf)
+{
+  if (kNull == this->root)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = kNull;
+    return;
+  }
+
+  // Go down to the sibling which grows the boxes the least. Going down
+  // a child costs the growth of the current node, which all its ancestors
+  // share, and the growth of the child, or the whole box for a leaf.
+  const Node &leaf = this->nodes[_leaf];
+  int sibling = this->root;
+  while (!this->nodes[sibling].IsLeaf())
+  {
+    const Node &node = this->nodes[sibling];
+    const double area = cost(node.min, node.max);
+    const double merged = mergedCost(node, leaf);
+    const double here = 2.0 * merged;
+    const double inherited = 2.0 * (merged - area);
+
+    auto childCost = [&](int _child)
+    {
+      const Node &child = this->nodes[_child];
+      const double grown = mergedCost(child, leaf);
+      return inherited + (child.IsLeaf() ? grown :
+          grown - cost(child.min, child.max));
+    };
+    const double leftCost = childCost(node.left);
+    const double rightCost = childCost(node.right);
+    if (here < leftCost && here < rightCost)
+      break;
+    sibling = leftCost < rightCost ? node.left : node.right;
+  }
+
+  const int oldParent = this->nodes[sibling].parent;
+  const int newParent = this->Allocate();
+  this->nodes[newParent].parent = oldParent;
+  this->nodes[newParent].left = sibling;
+  this->nodes[newParent].right = _leaf;
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+  if (kNull == oldParent)
+  {
+    this->root = newParent;
+  }
+  else if (this->nodes[oldParent].left == sibling)
+  {
+    this->nodes[oldParent].left = newParent;
+  }
+  else
+  {
+    this->nodes[oldParent].right = newParent;
+  }
+
+  this->Refit(newParent);
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::Implementation::RemoveLeaf(int _leaf)
+{
+  if (this->root == _leaf)
+  {
+    this->root = kNull;
+    return;
+  }
+
+  // The sibling takes the parent's place
+  const int parent = this->nodes[_leaf].parent;
+  const int grandParent = this->nodes[parent].parent;
+  const int sibling = this->nodes[parent].left == _leaf ?
+      this->nodes[parent].right : this->nodes[parent].left;
+  this->nodes[sibling].parent = grandParent;
+  this->Free(parent);
+
+  if (kNull == grandParent)
+  {
+    this->root = sibling;
+    return;
+  }
+  if (this->nodes[grandParent].left == parent)
+    this->nodes[grandParent].left = sibling;
+  else
+    this->nodes[grandParent].right = sibling;
+  this->Refit(grandParent);
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::Implementation::Refit(int _node)
+{
+  for (int node = _node; kNull != node; node = this->nodes[node].parent)
+  {
+    this->Fit(node);
+    node = this->Balance(node);
+  }
+}
+
+/////////////////////////////////////////////////
+int SceneIndex::Implementation::Balance(int _a)
+{
+  // Children are balanced already, only _a may be off balance
+  Node &a = this->nodes[_a];
+  if (a.IsLeaf() || a.height < 2)
+    return _a;
+
+  const int b = a.left;
+  const int c = a.right;
+  const int balance = this->nodes[c].height - this->nodes[b].height;
+  if (balance >= -1 && balance <= 1)
+    return _a;
+
+  // Move the higher child up, and its lower child down under _a in its
+  // place
+  const bool rightHigher = balance > 0;
+  const int up = rightHigher ? c : b;
+  const int stay = rightHigher ? b : c;
+  const int f = this->nodes[up].left;
+  const int g = this->nodes[up].right;
+  const bool keepLeft = this->nodes[f].height > this->nodes[g].height;
+  const int kept = keepLeft ? f : g;
+  const int moved = keepLeft ? g : f;
+
+  Node &u = this->nodes[up];
+  u.parent = a.parent;
+  a.parent = up;
+  if (kNull == u.parent)
+    this->root = up;
+  else if (this->nodes[u.parent].left == _a)
+    this->nodes[u.parent].left = up;
+  else
+    this->nodes[u.parent].right = up;
+
+  u.left = _a;
+  u.right = kept;
+  if (rightHigher)
+  {
+    a.left = stay;
+    a.right = moved;
+  }
+  else
+  {
+    a.left = moved;
+    a.right = stay;
+  }
+  this->nodes[moved].parent = _a;
+
+  this->Fit(_a);
+  this->Fit(up);
+  return up;
+}
+
+/////////////////////////////////////////////////
+SceneIndex::SceneIndex()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::Set(unsigned int _id, const math::Vector3d &_min,
+    const math::Vector3d &_max)
+{
+  std::unique_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  auto &d = *this->dataPtr;
+
+  int leaf;
+  auto it = d.leaves.find(_id);
+  if (it != d.leaves.end())
+  {
+    leaf = it->second;
+    Node &node = d.nodes[leaf];
+    node.tightMin = _min;
+    node.tightMax = _max;
+    // Small moves stay within the margin and don't change the tree
+    if (contains(node.min, node.max, _min, _max))
+      return;
+    d.RemoveLeaf(leaf);
+  }
+  else
+  {
+    leaf = d.Allocate();
+    d.leaves[_id] = leaf;
+    d.nodes[leaf].id = _id;
+    d.nodes[leaf].tightMin = _min;
+    d.nodes[leaf].tightMax = _max;
+  }
+
+  const math::Vector3d margin(d.margin, d.margin, d.margin);
+  d.nodes[leaf].min = _min - margin;
+  d.nodes[leaf].max = _max + margin;
+  d.InsertLeaf(leaf);
+}
+
+/////////////////////////////////////////////////
+bool SceneIndex::Remove(unsigned int _id)
+{
+  std::unique_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->leaves.find(_id);
+  if (it == this->dataPtr->leaves.end())
+    return false;
+
+  this->dataPtr->RemoveLeaf(it->second);
+  this->dataPtr->Free(it->second);
+  this->dataPtr->leaves.erase(it);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::Clear()
+{
+  std::unique_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->nodes.clear();
+  this->dataPtr->leaves.clear();
+  this->dataPtr->root = kNull;
+  this->dataPtr->freeList = kNull;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneIndex::Count() const
+{
+  std::shared_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->leaves.size();
+}
+
+/////////////////////////////////////////////////
+bool SceneIndex::Box(unsigned int _id, math::Vector3d &_min,
+    math::Vector3d &_max) const
+{
+  std::shared_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->leaves.find(_id);
+  if (it == this->dataPtr->leaves.end())
+    return false;
+  _min = this->dataPtr->nodes[it->second].tightMin;
+  _max = this->dataPtr->nodes[it->second].tightMax;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SceneIndex::SetMargin(double _margin)
+{
+  std::unique_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->margin = std::max(0.0, _margin);
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> SceneIndex::Overlapping(
+    const math::Vector3d &_min, const math::Vector3d &_max) const
+{
+  std::shared_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  const auto &nodes = this->dataPtr->nodes;
+  std::vector<unsigned int> result;
+  if (kNull == this->dataPtr->root)
+    return result;
+
+  std::vector<int> stack{this->dataPtr->root};
+  while (!stack.empty())
+  {
+    const Node &node = nodes[stack.back()];
+    stack.pop_back();
+    if (!overlap(node.min, node.max, _min, _max))
+      continue;
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+    else if (overlap(node.tightMin, node.tightMax, _min, _max))
+    {
+      result.push_back(node.id);
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> SceneIndex::Within(
+    const std::vector<math::Planed> &_planes) const
+{
+  std::shared_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  const auto &nodes = this->dataPtr->nodes;
+  std::vector<unsigned int> result;
+  if (kNull == this->dataPtr->root)
+    return result;
+
+  std::vector<int> stack{this->dataPtr->root};
+  while (!stack.empty())
+  {
+    const Node &node = nodes[stack.back()];
+    stack.pop_back();
+    if (!within(_planes, node.min, node.max))
+      continue;
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+    else if (within(_planes, node.tightMin, node.tightMax))
+    {
+      result.push_back(node.id);
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<SceneIndexHit> SceneIndex::Nearest(const math::Vector3d &_point,
+    std::size_t _count, double _maxDistance) const
+{
+  std::shared_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  const auto &nodes = this->dataPtr->nodes;
+  std::vector<SceneIndexHit> result;
+  if (kNull == this->dataPtr->root || 0 == _count)
+    return result;
+
+  // Best first. Node boxes contain their entities' boxes, so a node is
+  // never further than anything under it, and entities come out in order
+  // of distance. Entities are queued with their exact distance, as -1 - id
+  // so they're told apart from nodes.
+  using Entry = std::pair<double, int64_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  queue.push({0.0, this->dataPtr->root});
+  while (!queue.empty() && result.size() < _count)
+  {
+    const auto [dist, index] = queue.top();
+    queue.pop();
+    if (dist > _maxDistance)
+      break;
+
+    if (index < 0)
+    {
+      result.push_back({static_cast<unsigned int>(-1 - index), dist});
+      continue;
+    }
+
+    const Node &node = nodes[static_cast<std::size_t>(index)];
+    if (node.IsLeaf())
+    {
+      queue.push({distance(_point, node.tightMin, node.tightMax),
+          -1 - static_cast<int64_t>(node.id)});
+      continue;
+    }
+    for (const int child : {node.left, node.right})
+    {
+      queue.push({distance(_point, nodes[child].min, nodes[child].max),
+          child});
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<SceneIndexHit> SceneIndex::Raycast(const math::Vector3d &_origin,
+    const math::Vector3d &_direction, double _maxDistance) const
+{
+  std::vector<SceneIndexHit> result;
+  const double length = _direction.Length();
+  if (length <= 0 || !std::isfinite(length))
+    return result;
+  const math::Vector3d direction = _direction / length;
+
+  std::shared_lock<std::shared_mutex> lock(this->dataPtr->mutex);
+  const auto &nodes = this->dataPtr->nodes;
+  if (kNull == this->dataPtr->root)
+    return result;
+
+  std::vector<int> stack{this->dataPtr->root};
+  while (!stack.empty())
+  {
+    const Node &node = nodes[stack.back()];
+    stack.pop_back();
+    if (enter(_origin, direction, _maxDistance, node.min, node.max) < 0)
+      continue;
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+      continue;
+    }
+    const double dist = enter(_origin, direction, _maxDistance,
+        node.tightMin, node.tightMax);
+    if (dist >= 0)
+      result.push_back({node.id, dist});
+  }
+  lock.unlock();
+
+  std::sort(result.begin(), result.end(),
+      [](const SceneIndexHit &_a, const SceneIndexHit &_b)
+      {
+        return _a.distance < _b.distance ||
+            (_a.distance == _b.distance && _a.id < _b.id);
+      });
+  return result;
+}
+}  // namespace gz::gui
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gz/gui/SceneIndex.hh"
+
+using namespace gz;
+using namespace gui;
+
+namespace
+{
+/// \brief Set a unit box centered at a point
+/// \param[in] _index Index
+/// \param[in] _id Entity id
+/// \param[in] _center Center of the box
+void setUnitBox(SceneIndex &_index, unsigned int _id,
+    const math::Vector3d &_center)
+{
+  const math::Vector3d half(0.5, 0.5, 0.5);
+  _index.Set(_id, _center - half, _center + half);
+}
+
+/// \brief Get the ids of hits, sorted
+std::vector<unsigned int> ids(const std::vector<SceneIndexHit> &_hits)
+{
+  std::vector<unsigned int> result;
+  for (const auto &hit : _hits)
+    result.push_back(hit.id);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/// \brief Sort ids
+std::vector<unsigned int> sorted(std::vector<unsigned int> _ids)
+{
+  std::sort(_ids.begin(), _ids.end());
+  return _ids;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(SceneIndexTest, Empty)
+{
+  SceneIndex index;
+  EXPECT_EQ(0u, index.Count());
+  EXPECT_TRUE(index.Overlapping(math::Vector3d(-1, -1, -1),
+      math::Vector3d(1, 1, 1)).empty());
+  EXPECT_TRUE(index.Nearest(math::Vector3d::Zero, 5).empty());
+  EXPECT_TRUE(index.Raycast(math::Vector3d::Zero,
+      math::Vector3d::UnitX).empty());
+  EXPECT_FALSE(index.Remove(1));
+
+  math::Vector3d min, max;
+  EXPECT_FALSE(index.Box(1, min, max));
+}
+
+/////////////////////////////////////////////////
+TEST(SceneIndexTest, SetRemove)
+{
+  SceneIndex index;
+  setUnitBox(index, 1, math::Vector3d(0, 0, 0));
+  setUnitBox(index, 2, math::Vector3d(5, 0, 0));
+  setUnitBox(index, 3, math::Vector3d(10, 0, 0));
+  EXPECT_EQ(3u, index.Count());
+
+  math::Vector3d min, max;
+  ASSERT_TRUE(index.Box(2, min, max));
+  EXPECT_EQ(math::Vector3d(4.5, -0.5, -0.5), min);
+  EXPECT_EQ(math::Vector3d(5.5, 0.5, 0.5), max);
+
+  // Within the margin, then far away
+  setUnitBox(index, 2, math::Vector3d(5.05, 0, 0));
+  ASSERT_TRUE(index.Box(2, min, max));
+  EXPECT_EQ(math::Vector3d(4.55, -0.5, -0.5), min);
+  EXPECT_EQ(std::vector<unsigned int>({2}), sorted(index.Overlapping(
+      math::Vector3d(5.52, 0, 0), math::Vector3d(5.6, 1, 1))));
+  EXPECT_TRUE(index.Overlapping(math::Vector3d(4.46, 0, 0),
+      math::Vector3d(4.5, 1, 1)).empty());
+
+  setUnitBox(index, 2, math::Vector3d(0, 20, 0));
+  EXPECT_EQ(3u, index.Count());
+  EXPECT_EQ(std::vector<unsigned int>({2}), sorted(index.Overlapping(
+      math::Vector3d(-1, 19, -1), math::Vector3d(1, 21, 1))));
+
+  EXPECT_TRUE(index.Remove(2));
+  EXPECT_FALSE(index.Remove(2));
+  EXPECT_EQ(2u, index.Count());
+  EXPECT_TRUE(index.Overlapping(math::Vector3d(-1, 19, -1),
+      math::Vector3d(1, 21, 1)).empty());
+
+  index.Clear();
+  EXPECT_EQ(0u, index.Count());
+  setUnitBox(index, 4, math::Vector3d(0, 0, 0));
+  EXPECT_EQ(1u, index.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneIndexTest, Nearest)
+{
+  SceneIndex index;
+  for (unsigned int i = 0; i < 10; ++i)
+    setUnitBox(index, i, math::Vector3d(2.0 * i, 0, 0));
+
+  auto hits = index.Nearest(math::Vector3d(6.2, 0, 0), 3);
+  ASSERT_EQ(3u, hits.size());
+  EXPECT_EQ(3u, hits[0].id);
+  EXPECT_DOUBLE_EQ(0.0, hits[0].distance);
+  EXPECT_EQ(std::vector<unsigned int>({2, 3, 4}), ids(hits));
+  EXPECT_NEAR(1.3, hits[1].distance, 1e-9);
+  EXPECT_NEAR(1.7, hits[2].distance, 1e-9);
+
+  // Limited by distance
+  hits = index.Nearest(math::Vector3d(6.2, 3, 0), 10, 2.6);
+  EXPECT_EQ(std::vector<unsigned int>({3}), ids(hits));
+  EXPECT_NEAR(2.5, hits[0].distance, 1e-9);
+
+  EXPECT_TRUE(index.Nearest(math::Vector3d(6.2, 0, 0), 0).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneIndexTest, Raycast)
+{
+  SceneIndex index;
+  for (unsigned int i = 0; i < 10; ++i)
+    setUnitBox(index, i, math::Vector3d(2.0 * i, 0, 0));
+  setUnitBox(index, 100, math::Vector3d(4, 5, 0));
+
+  // Along the row, from inside the first box, direction not normalized
+  auto hits = index.Raycast(math::Vector3d(0, 0, 0),
+      math::Vector3d(3, 0, 0), 5.0);
+  ASSERT_EQ(3u, hits.size());
+  EXPECT_EQ(0u, hits[0].id);
+  EXPECT_DOUBLE_EQ(0.0, hits[0].distance);
+  EXPECT_EQ(1u, hits[1].id);
+  EXPECT_DOUBLE_EQ(1.5, hits[1].distance);
+  EXPECT_EQ(2u, hits[2].id);
+  EXPECT_DOUBLE_EQ(3.5, hits[2].distance);
+
+  // Down onto a box, like picking from above
+  hits = index.Raycast(math::Vector3d(4, 5, 10), math::Vector3d(0, 0, -1));
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(100u, hits[0].id);
+  EXPECT_DOUBLE_EQ(9.5, hits[0].distance);
+
+  // Misses, and going away
+  EXPECT_TRUE(index.Raycast(math::Vector3d(4, 2.5, 10),
+      math::Vector3d(0, 0, -1)).empty());
+  EXPECT_TRUE(index.Raycast(math::Vector3d(-2, 0, 0),
+      math::Vector3d(-1, 0, 0)).empty());
+  EXPECT_TRUE(index.Raycast(math::Vector3d(-2, 0, 0),
+      math::Vector3d::Zero).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneIndexTest, Within)
+{
+  SceneIndex index;
+  for (unsigned int i = 0; i < 10; ++i)
+    setUnitBox(index, i, math::Vector3d(2.0 * i, 0, 0));
+
+  // Slab keeping 3 <= x <= 8, boxes partly inside count
+  const std::vector<math::Planed> slab{
+    math::Planed(math::Vector3d(1, 0, 0), 3.0),
+    math::Planed(math::Vector3d(-1, 0, 0), -8.0)
+  };
+  EXPECT_EQ(std::vector<unsigned int>({2, 3, 4}), sorted(index.Within(
+      slab)));
+
+  // Tilted plane, above z = x - 10
+  const std::vector<math::Planed> tilted{
+    math::Planed(math::Vector3d(-1, 0, 1).Normalized(),
+        -10.0 / std::sqrt(2.0))
+  };
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 3, 4, 5}),
+      sorted(index.Within(tilted)));
+
+  EXPECT_EQ(10u, index.Within({}).size());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneIndexTest, MatchesScan)
+{
+  // Random boxes moving around, compared to testing all of them
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> size(0.1, 3.0);
+  std::uniform_real_distribution<double> step(-0.2, 0.2);
+
+  const unsigned int count{500};
+  std::vector<math::Vector3d> mins(count);
+  std::vector<math::Vector3d> maxs(count);
+  std::vector<bool> present(count, true);
+  SceneIndex index;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    mins[i].Set(position(random), position(random), position(random));
+    maxs[i] = mins[i] + math::Vector3d(size(random), size(random),
+        size(random));
+    index.Set(i, mins[i], maxs[i]);
+  }
+
+  for (int round = 0; round < 20; ++round)
+  {
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      if (i % 10 == static_cast<unsigned int>(round) % 2)
+      {
+        present[i] = !present[i];
+        if (!present[i])
+        {
+          EXPECT_TRUE(index.Remove(i));
+          continue;
+        }
+      }
+      if (!present[i])
+        continue;
+      // Mostly small moves, sometimes a jump
+      const math::Vector3d move = i % 7 == 0 ?
+          math::Vector3d(position(random), 0, 0) :
+          math::Vector3d(step(random), step(random), step(random));
+      mins[i] += move;
+      maxs[i] += move;
+      index.Set(i, mins[i], maxs[i]);
+    }
+
+    const math::Vector3d point(position(random), position(random),
+        position(random));
+    const math::Vector3d queryMin = point - math::Vector3d(10, 10, 10);
+    const math::Vector3d queryMax = point + math::Vector3d(10, 10, 10);
+    const math::Vector3d direction(step(random), step(random),
+        step(random));
+
+    std::vector<unsigned int> expectedOverlap;
+    std::vector<unsigned int> expectedRay;
+    std::vector<double> distances;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      if (!present[i])
+        continue;
+      if (mins[i].X() <= queryMax.X() && queryMin.X() <= maxs[i].X() &&
+          mins[i].Y() <= queryMax.Y() && queryMin.Y() <= maxs[i].Y() &&
+          mins[i].Z() <= queryMax.Z() && queryMin.Z() <= maxs[i].Z())
+      {
+        expectedOverlap.push_back(i);
+      }
+
+      double squared{0.0};
+      for (int a = 0; a < 3; ++a)
+      {
+        const double d = std::max({mins[i][a] - point[a], 0.0,
+            point[a] - maxs[i][a]});
+        squared += d * d;
+      }
+      distances.push_back(std::sqrt(squared));
+
+      // Sampling the ray finely enough for boxes at least 0.1 thick
+      const math::Vector3d unit = direction.Normalized();
+      for (double t = 0; t < 200; t += 0.01)
+      {
+        const math::Vector3d p = point + unit * t;
+        if (p.X() >= mins[i].X() && p.X() <= maxs[i].X() &&
+            p.Y() >= mins[i].Y() && p.Y() <= maxs[i].Y() &&
+            p.Z() >= mins[i].Z() && p.Z() <= maxs[i].Z())
+        {
+          expectedRay.push_back(i);
+          break;
+        }
+      }
+    }
+
+    EXPECT_EQ(expectedOverlap, sorted(index.Overlapping(queryMin,
+        queryMax)));
+    EXPECT_EQ(expectedRay, ids(index.Raycast(point, direction, 200.0)));
+
+    std::sort(distances.begin(), distances.end());
+    const auto nearest = index.Nearest(point, 5);
+    ASSERT_EQ(5u, nearest.size());
+    for (std::size_t n = 0; n < nearest.size(); ++n)
+      EXPECT_NEAR(distances[n], nearest[n].distance, 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SceneIndexTest, Threads)
+{
+  // Queries on another thread while entities move
+  SceneIndex index;
+  for (unsigned int i = 0; i < 100; ++i)
+    setUnitBox(index, i, math::Vector3d(2.0 * i, 0, 0));
+
+  std::atomic<bool> done{false};
+  std::thread reader([&]
+  {
+    while (!done)
+    {
+      auto hits = index.Raycast(math::Vector3d(-10, 0, 0),
+          math::Vector3d::UnitX);
+      EXPECT_EQ(100u, hits.size());
+      EXPECT_EQ(5u, index.Nearest(math::Vector3d(50, 0, 0), 5).size());
+    }
+  });
+
+  for (int round = 0; round < 200; ++round)
+  {
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+      setUnitBox(index, i, math::Vector3d(2.0 * i,
+          0.3 * std::sin(round * 0.1 + i), 0));
+    }
+  }
+  done = true;
+  reader.join();
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include "gz/gui/SceneLabels.hh"
+
+namespace gz::gui
+{
+/// \brief Private data
+class SceneLabels::Implementation
+{
+  /// \brief Protects everything below
+  public: mutable std::mutex mutex;
+
+  /// \brief Labels by owner and id
+  public: std::map<std::pair<const void *, uint64_t>, SceneLabel> labels;
+
+  /// \brief See SetCellSize
+  public: double cellSize{32.0};
+
+  /// \brief See SetMaxLabels
+  public: std::size_t maxLabels{256};
+
+  /// \brief See SetMaxDistance
+  public: double maxDistance{0.0};
+};
+
+namespace
+{
+/// \brief A label which passed culling
+class Candidate
+{
+  /// \brief Label
+  public: const SceneLabel *label{nullptr};
+
+  /// \brief Screen position and depth
+  public: math::Vector3d screen;
+};
+}  // namespace
+
+/////////////////////////////////////////////////
+bool PlacedLabel::operator==(const PlacedLabel &_other) const
+{
+  return this->text == _other.text && this->color == _other.color &&
+      this->position == _other.position;
+}
+
+/////////////////////////////////////////////////
+SceneLabels::SceneLabels()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+void SceneLabels::Set(const void *_owner, uint64_t _id, SceneLabel _label)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->labels[{_owner, _id}] = std::move(_label);
+}
+
+/////////////////////////////////////////////////
+void SceneLabels::Remove(const void *_owner, uint64_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->labels.erase({_owner, _id});
+}
+
+/////////////////////////////////////////////////
+void SceneLabels::RemoveAll(const void *_owner)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &labels = this->dataPtr->labels;
+  labels.erase(labels.lower_bound({_owner, 0}),
+      labels.upper_bound({_owner, UINT64_MAX}));
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneLabels::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->labels.size();
+}
+
+/////////////////////////////////////////////////
+void SceneLabels::SetCellSize(double _pixels)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->cellSize = std::max(0.0, _pixels);
+}
+
+/////////////////////////////////////////////////
+void SceneLabels::SetMaxLabels(std::size_t _count)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->maxLabels = _count;
+}
+
+/////////////////////////////////////////////////
+void SceneLabels::SetMaxDistance(double _distance)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->maxDistance = std::max(0.0, _distance);
+}
+
+/////////////////////////////////////////////////
+std::vector<PlacedLabel> SceneLabels::Layout(const Projector &_project,
+    unsigned int _width, unsigned int _height) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const double maxDistance = this->dataPtr->maxDistance;
+
+  // Cull labels behind the camera, off the screen and too far
+  std::vector<Candidate> candidates;
+  for (const auto &entry : this->dataPtr->labels)
+  {
+    if (entry.second.text.empty())
+      continue;
+
+    const auto screen = _project(entry.second);
+    if (!screen || screen->Z() <= 0.0 ||
+        (maxDistance > 0.0 && screen->Z() > maxDistance) ||
+        screen->X() < 0.0 || screen->X() >= _width ||
+        screen->Y() < 0.0 || screen->Y() >= _height)
+    {
+      continue;
+    }
+    candidates.push_back({&entry.second, *screen});
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+      [](const Candidate &_a, const Candidate &_b)
+      {
+        if (_a.label->priority != _b.label->priority)
+          return _a.label->priority > _b.label->priority;
+        return _a.screen.Z() < _b.screen.Z();
+      });
+
+  // Keep one label per cell, the first placed
+  const double cellSize = this->dataPtr->cellSize;
+  const std::size_t maxLabels = this->dataPtr->maxLabels;
+  const uint64_t columns = cellSize > 0.0 ?
+      static_cast<uint64_t>(std::ceil(_width / cellSize)) : 0;
+  std::unordered_set<uint64_t> taken;
+  std::vector<PlacedLabel> placed;
+  for (const auto &candidate : candidates)
+  {
+    if (maxLabels > 0 && placed.size() >= maxLabels)
+      break;
+
+    if (cellSize > 0.0)
+    {
+      const auto column =
+          static_cast<uint64_t>(candidate.screen.X() / cellSize);
+      const auto row = static_cast<uint64_t>(candidate.screen.Y() / cellSize);
+      if (!taken.insert(row * columns + column).second)
+        continue;
+    }
+
+    PlacedLabel label;
+    label.text = candidate.label->text;
+    label.color = candidate.label->color;
+    label.position.Set(candidate.screen.X(), candidate.screen.Y());
+    label.depth = candidate.screen.Z();
+    placed.push_back(std::move(label));
+  }
+  return placed;
+}
+}  // namespace gz::gui
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/SceneLabels.hh"
+
+using namespace gz;
+using namespace gui;
+
+namespace
+{
+/// \brief Project labels straight to the screen, the world's X and Y are
+/// pixels and its Z the depth
+std::optional<math::Vector3d> project(const SceneLabel &_label)
+{
+  if (_label.visualId != 0)
+    return std::nullopt;
+  return _label.position;
+}
+
+/// \brief Get the texts of placed labels
+std::vector<std::string> texts(const std::vector<PlacedLabel> &_placed)
+{
+  std::vector<std::string> result;
+  for (const auto &label : _placed)
+    result.push_back(label.text);
+  return result;
+}
+
+/// \brief Make a label
+SceneLabel label(const std::string &_text, double _x, double _y,
+    double _depth, int _priority = 0)
+{
+  SceneLabel result;
+  result.text = _text;
+  result.position.Set(_x, _y, _depth);
+  result.priority = _priority;
+  return result;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(SceneLabelsTest, SetRemove)
+{
+  SceneLabels labels;
+  int owner1, owner2;
+  labels.Set(&owner1, 1, label("a", 10, 10, 1));
+  labels.Set(&owner1, 2, label("b", 100, 10, 1));
+  labels.Set(&owner2, 1, label("c", 200, 10, 1));
+  EXPECT_EQ(3u, labels.Count());
+
+  // Replace
+  labels.Set(&owner1, 1, label("d", 10, 10, 1));
+  EXPECT_EQ(3u, labels.Count());
+
+  labels.Remove(&owner2, 1);
+  labels.Remove(&owner2, 5);
+  EXPECT_EQ(2u, labels.Count());
+  EXPECT_EQ(std::vector<std::string>({"d", "b"}),
+      texts(labels.Layout(project, 640, 480)));
+
+  labels.Set(&owner2, 1, label("c", 200, 10, 1));
+  labels.RemoveAll(&owner1);
+  EXPECT_EQ(std::vector<std::string>({"c"}),
+      texts(labels.Layout(project, 640, 480)));
+}
+
+/////////////////////////////////////////////////
+TEST(SceneLabelsTest, Culling)
+{
+  SceneLabels labels;
+  labels.SetCellSize(0);
+  int owner;
+  labels.Set(&owner, 1, label("visible", 10, 10, 5));
+  labels.Set(&owner, 2, label("behind", 10, 10, -5));
+  labels.Set(&owner, 3, label("left", -1, 10, 5));
+  labels.Set(&owner, 4, label("below", 10, 480, 5));
+  labels.Set(&owner, 5, label("far", 10, 10, 50));
+  labels.Set(&owner, 6, label("", 10, 10, 5));
+  auto gone = label("gone", 10, 10, 5);
+  gone.visualId = 3;
+  labels.Set(&owner, 7, gone);
+
+  EXPECT_EQ(std::vector<std::string>({"visible", "far"}),
+      texts(labels.Layout(project, 640, 480)));
+
+  labels.SetMaxDistance(10);
+  auto placed = labels.Layout(project, 640, 480);
+  ASSERT_EQ(1u, placed.size());
+  EXPECT_EQ("visible", placed[0].text);
+  EXPECT_EQ(math::Vector2d(10, 10), placed[0].position);
+  EXPECT_DOUBLE_EQ(5.0, placed[0].depth);
+}
+
+/////////////////////////////////////////////////
+TEST(SceneLabelsTest, Density)
+{
+  SceneLabels labels;
+  labels.SetCellSize(50);
+  int owner;
+
+  // Closest first in each cell, unless a label has a higher priority
+  labels.Set(&owner, 1, label("far", 10, 10, 20));
+  labels.Set(&owner, 2, label("near", 40, 40, 10));
+  labels.Set(&owner, 3, label("other cell", 60, 10, 30));
+  labels.Set(&owner, 4, label("important", 110, 10, 40, 1));
+  labels.Set(&owner, 5, label("same cell", 120, 20, 1));
+  EXPECT_EQ(std::vector<std::string>({"important", "near", "other cell"}),
+      texts(labels.Layout(project, 640, 480)));
+
+  labels.SetMaxLabels(2);
+  EXPECT_EQ(std::vector<std::string>({"important", "near"}),
+      texts(labels.Layout(project, 640, 480)));
+
+  // Without cells, overlapping labels are all kept
+  labels.SetCellSize(0);
+  labels.SetMaxLabels(0);
+  EXPECT_EQ(5u, labels.Layout(project, 640, 480).size());
+}
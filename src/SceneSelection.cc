@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include "gz/gui/SceneSelection.hh"
+
+namespace gz::gui
+{
+/// \brief Private data
+class SceneSelection::Implementation
+{
+  /// \brief Protects everything below
+  public: mutable std::mutex mutex;
+
+  /// \brief Selected ids
+  public: std::unordered_set<unsigned int> ids;
+
+  /// \brief See Version
+  public: uint64_t version{0};
+};
+
+/////////////////////////////////////////////////
+SceneSelection::SceneSelection()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+void SceneSelection::Set(const std::vector<unsigned int> &_ids)
+{
+  std::unordered_set<unsigned int> ids(_ids.begin(), _ids.end());
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (ids == this->dataPtr->ids)
+    return;
+  this->dataPtr->ids = std::move(ids);
+  ++this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+void SceneSelection::Add(const std::vector<unsigned int> &_ids)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const std::size_t before = this->dataPtr->ids.size();
+  this->dataPtr->ids.insert(_ids.begin(), _ids.end());
+  if (this->dataPtr->ids.size() != before)
+    ++this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+void SceneSelection::Remove(const std::vector<unsigned int> &_ids)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::size_t removed{0};
+  for (const auto id : _ids)
+    removed += this->dataPtr->ids.erase(id);
+  if (removed > 0)
+    ++this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+bool SceneSelection::Toggle(unsigned int _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  ++this->dataPtr->version;
+  if (this->dataPtr->ids.erase(_id) > 0)
+    return false;
+  this->dataPtr->ids.insert(_id);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SceneSelection::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->ids.empty())
+    return;
+  this->dataPtr->ids.clear();
+  ++this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+bool SceneSelection::Contains(unsigned int _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->ids.count(_id) > 0;
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> SceneSelection::Ids() const
+{
+  std::vector<unsigned int> ids;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    ids.assign(this->dataPtr->ids.begin(), this->dataPtr->ids.end());
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+/////////////////////////////////////////////////
+bool SceneSelection::IdsIfChanged(uint64_t &_version,
+    std::vector<unsigned int> &_ids) const
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (_version == this->dataPtr->version)
+      return false;
+    _version = this->dataPtr->version;
+    _ids.assign(this->dataPtr->ids.begin(), this->dataPtr->ids.end());
+  }
+  std::sort(_ids.begin(), _ids.end());
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneSelection::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->ids.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t SceneSelection::Version() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->version;
+}
+}  // namespace gz::gui
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/gui/SceneSelection.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SceneSelectionTest, Change)
+{
+  SceneSelection selection;
+  EXPECT_EQ(0u, selection.Count());
+  EXPECT_EQ(0u, selection.Version());
+
+  selection.Set({5, 3, 5, 1});
+  EXPECT_EQ(3u, selection.Count());
+  EXPECT_EQ(std::vector<unsigned int>({1, 3, 5}), selection.Ids());
+  EXPECT_TRUE(selection.Contains(3));
+  EXPECT_FALSE(selection.Contains(4));
+  EXPECT_EQ(1u, selection.Version());
+
+  selection.Add({4, 5});
+  EXPECT_EQ(std::vector<unsigned int>({1, 3, 4, 5}), selection.Ids());
+  selection.Remove({1, 2});
+  EXPECT_EQ(std::vector<unsigned int>({3, 4, 5}), selection.Ids());
+  EXPECT_EQ(3u, selection.Version());
+
+  EXPECT_FALSE(selection.Toggle(4));
+  EXPECT_TRUE(selection.Toggle(7));
+  EXPECT_EQ(std::vector<unsigned int>({3, 5, 7}), selection.Ids());
+
+  selection.Clear();
+  EXPECT_EQ(0u, selection.Count());
+  EXPECT_EQ(6u, selection.Version());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneSelectionTest, Version)
+{
+  SceneSelection selection;
+  selection.Set({1, 2});
+  const uint64_t version = selection.Version();
+
+  // Changes which leave the selection as it was don't count
+  selection.Set({2, 1});
+  selection.Add({1});
+  selection.Remove({3});
+  EXPECT_EQ(version, selection.Version());
+  selection.Clear();
+  selection.Clear();
+  EXPECT_EQ(version + 1, selection.Version());
+
+  uint64_t seen{0};
+  std::vector<unsigned int> ids;
+  selection.Add({8, 6});
+  EXPECT_TRUE(selection.IdsIfChanged(seen, ids));
+  EXPECT_EQ(selection.Version(), seen);
+  EXPECT_EQ(std::vector<unsigned int>({6, 8}), ids);
+
+  ids.clear();
+  EXPECT_FALSE(selection.IdsIfChanged(seen, ids));
+  EXPECT_TRUE(ids.empty());
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "gz/gui/SceneServices.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Shared objects
+class Registry
+{
+  /// \brief Protects `objects`
+  public: std::mutex mutex;
+
+  /// \brief Objects by name, then by type name. Types are compared by name
+  /// because type_info objects may differ across shared libraries.
+  public: std::unordered_map<std::string,
+      std::map<std::string, std::weak_ptr<void>>> objects;
+};
+
+/////////////////////////////////////////////////
+Registry &registry()
+{
+  static Registry instance;
+  return instance;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+void SceneServices::Remove(const std::string &_name)
+{
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.objects.erase(_name);
+}
+
+/////////////////////////////////////////////////
+void SceneServices::SetObject(const std::string &_name,
+    const std::type_info &_type, std::weak_ptr<void> _object)
+{
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  if (_object.expired())
+  {
+    auto it = reg.objects.find(_name);
+    if (it == reg.objects.end())
+      return;
+    it->second.erase(_type.name());
+    if (it->second.empty())
+      reg.objects.erase(it);
+    return;
+  }
+  reg.objects[_name][_type.name()] = std::move(_object);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<void> SceneServices::Object(const std::string &_name,
+    const std::type_info &_type)
+{
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  auto it = reg.objects.find(_name);
+  if (it == reg.objects.end())
+    return nullptr;
+
+  auto typeIt = it->second.find(_type.name());
+  if (typeIt == it->second.end())
+    return nullptr;
+  return typeIt->second.lock();
+}
+}  // namespace gz::gui
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/SceneServices.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SceneServicesTest, SetGet)
+{
+  EXPECT_EQ(nullptr, SceneServices::Get<int>("test"));
+
+  auto number = std::make_shared<int>(3);
+  auto text = std::make_shared<std::string>("banana");
+  SceneServices::Set("test", number);
+  SceneServices::Set("test", text);
+
+  // Objects are found by name and type
+  ASSERT_NE(nullptr, SceneServices::Get<int>("test"));
+  EXPECT_EQ(3, *SceneServices::Get<int>("test"));
+  ASSERT_NE(nullptr, SceneServices::Get<std::string>("test"));
+  EXPECT_EQ("banana", *SceneServices::Get<std::string>("test"));
+  EXPECT_EQ(nullptr, SceneServices::Get<double>("test"));
+  EXPECT_EQ(nullptr, SceneServices::Get<int>("other"));
+
+  // Replace
+  auto otherNumber = std::make_shared<int>(4);
+  SceneServices::Set("test", otherNumber);
+  EXPECT_EQ(4, *SceneServices::Get<int>("test"));
+
+  // Remove a type
+  SceneServices::Set("test", std::shared_ptr<int>());
+  EXPECT_EQ(nullptr, SceneServices::Get<int>("test"));
+  EXPECT_NE(nullptr, SceneServices::Get<std::string>("test"));
+
+  // Remove all types
+  SceneServices::Remove("test");
+  EXPECT_EQ(nullptr, SceneServices::Get<std::string>("test"));
+}
+
+/////////////////////////////////////////////////
+TEST(SceneServicesTest, Weak)
+{
+  auto number = std::make_shared<int>(3);
+  SceneServices::Set(SceneServices::kUserCamera, number);
+  EXPECT_NE(nullptr, SceneServices::Get<int>(SceneServices::kUserCamera));
+
+  // The registry doesn't keep objects alive
+  std::weak_ptr<int> weak = number;
+  number.reset();
+  EXPECT_TRUE(weak.expired());
+  EXPECT_EQ(nullptr, SceneServices::Get<int>(SceneServices::kUserCamera));
+
+  SceneServices::Remove(SceneServices::kUserCamera);
+}
@@ -15,84 +15,544 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include "gz/gui/Enums.hh"
 #include "gz/gui/SearchModel.hh"
 
-namespace gz::gui
+namespace
 {
-/////////////////////////////////////////////////
-bool SearchModel::filterAcceptsRow(const int _srcRow,
-      const QModelIndex &_srcParent) const
+/// \brief Item of the source model, as indexed for searching
+class SearchNode
 {
-  // Item index in search model.
-  auto id = this->sourceModel()->index(_srcRow, 0, _srcParent);
+  /// \brief Index on the source model. Only used while the source model's
+  /// rows are unchanged, after which the whole index is built again.
+  public: QModelIndex index;
+
+  /// \brief Lowercase text of the filter role
+  public: QString text;
+
+  /// \brief Position of the parent node, -1 for top level items
+  public: int parent{-1};
+
+  /// \brief True for titles, which are never accepted
+  public: bool title{false};
+};
+
+/// \brief Nodes in depth-first order, so parents come before children.
+/// Never modified once built, so searches on the worker thread can share it.
+using SearchNodes = std::vector<SearchNode>;
+
+/// \brief Outcome of matching all nodes against a search
+class SearchResult
+{
+  /// \brief Lowercase words matched
+  public: QStringList words;
 
-  // Ignore titles.
-  if (this->sourceModel()->data(id, DataRole::TYPE).toString() ==
-      "title")
+  /// \brief Per node, true if its text contains any of the words
+  public: std::vector<char> hit;
+
+  /// \brief Per node, true if the row is accepted by the search
+  public: std::vector<char> accepted;
+
+  /// \brief Per node, true if a descendant contains any of the words
+  public: std::vector<char> expand;
+};
+
+/////////////////////////////////////////////////
+/// \brief Split a search into lowercase words
+/// \param[in] _search Search string
+/// \return Words, without empty ones or duplicates
+QStringList searchWords(const QString &_search)
+{
+  QStringList words;
+  for (const auto &word : _search.toLower().split(" ", Qt::SkipEmptyParts))
   {
-    return false;
+    if (!words.contains(word))
+      words.push_back(word);
   }
+  return words;
+}
 
-  // Collapsed by default.
-  this->sourceModel()->blockSignals(true);
-  this->sourceModel()->setData(id, false, DataRole::TO_EXPAND);
-  this->sourceModel()->blockSignals(false);
+/////////////////////////////////////////////////
+/// \brief Match all nodes against a search
+/// \param[in] _nodes Nodes
+/// \param[in] _words Lowercase words
+/// \param[in] _previous Result of the last search on the same nodes, if
+/// any, used to skip nodes which can't match
+/// \param[in] _cancelled Checked now and then, matching stops if it
+/// returns true
+/// \return Result, or null if cancelled
+std::shared_ptr<SearchResult> matchNodes(const SearchNodes &_nodes,
+    const QStringList &_words, const SearchResult *_previous,
+    const std::function<bool()> &_cancelled)
+{
+  auto result = std::make_shared<SearchResult>();
+  result->words = _words;
+  result->hit.assign(_nodes.size(), false);
+  result->accepted.assign(_nodes.size(), false);
+  result->expand.assign(_nodes.size(), false);
 
   // Empty search matches everything.
-  if (this->search.isEmpty())
-    return true;
+  if (_words.isEmpty())
+  {
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+      result->accepted[i] = !_nodes[i].title;
+    return result;
+  }
 
-  // Each word must match at least once, either self, parent or child.
-  auto words = this->search.split(" ");
-  for (const auto &word : words)
+  // If each word contains one of the words last matched, such as after
+  // typing more characters, texts which didn't contain any of those can't
+  // contain any of these
+  bool narrowing = nullptr != _previous && !_previous->words.isEmpty() &&
+      _previous->hit.size() == _nodes.size();
+  for (int w = 0; narrowing && w < _words.size(); ++w)
   {
-    if (word.isEmpty())
-      continue;
+    narrowing = std::any_of(_previous->words.begin(),
+        _previous->words.end(), [&](const QString &_matched)
+        {
+          return _words[w].contains(_matched);
+        });
+  }
+
+  // A row is fully accepted if each word is contained by itself or an
+  // ancestor. Count how many nodes on the current path contain each word,
+  // walking the nodes in depth-first order.
+  std::vector<int> covered(_words.size(), 0);
+  int missing = _words.size();
+  // Nodes on the current path, and where their words start in pathWords
+  std::vector<std::pair<int, std::size_t>> path;
+  std::vector<int> pathWords;
+
+  for (int i = 0; i < static_cast<int>(_nodes.size()); ++i)
+  {
+    if (0 == i % 1024 && _cancelled && _cancelled())
+      return nullptr;
+
+    const auto &node = _nodes[i];
 
-    // Expand this if at least one child contains the word.
-    // Note that this is not enough for this to be accepted, we need to match
-    // all words.
-    if (this->HasChildAcceptsItself(id, word))
+    // Leave the nodes which aren't ancestors of this one
+    while (!path.empty() && path.back().first != node.parent)
     {
-      this->sourceModel()->blockSignals(true);
-      this->sourceModel()->setData(id, true, DataRole::TO_EXPAND);
-      this->sourceModel()->blockSignals(false);
+      for (auto w = path.back().second; w < pathWords.size(); ++w)
+      {
+        if (0 == --covered[pathWords[w]])
+          ++missing;
+      }
+      pathWords.resize(path.back().second);
+      path.pop_back();
     }
 
-    // At least one of the children fits rule 1.
-    if (this->HasAcceptedChildren(_srcRow, _srcParent))
-      continue;
-
-    // Row itself contains this word.
-    if (this->FilterAcceptsRowItself(_srcRow, _srcParent, word))
-      continue;
+    path.emplace_back(i, pathWords.size());
 
-    // One of the ancestors contains this word.
-    QModelIndex parentIndex = _srcParent;
-    bool parentAccepted = false;
-    while (parentIndex.isValid())
+    if (!narrowing || _previous->hit[i])
     {
-      if (this->FilterAcceptsRowItself(parentIndex.row(),
-          parentIndex.parent(), word))
+      for (int w = 0; w < _words.size(); ++w)
       {
-        parentAccepted = true;
-        break;
+        if (!node.text.contains(_words[w]))
+          continue;
+
+        result->hit[i] = true;
+        pathWords.push_back(w);
+        if (0 == covered[w]++)
+          --missing;
       }
-      parentIndex = parentIndex.parent();
     }
 
-    if (parentAccepted)
+    result->accepted[i] = !node.title && 0 == missing;
+  }
+
+  // Children come after their parents, so walking backwards, each node is
+  // final before it's propagated to its parent.
+  // A row is also accepted if one of its children is, and expanded if one of
+  // its descendants contains a word.
+  for (int i = static_cast<int>(_nodes.size()) - 1; i >= 0; --i)
+  {
+    const int parent = _nodes[i].parent;
+    if (parent < 0)
       continue;
 
-    // This word can't be found on the row or a parent, and no child is fully
-    // accepted.
-    return false;
+    if (result->hit[i] || result->expand[i])
+      result->expand[parent] = true;
+    if (result->accepted[i] && !_nodes[parent].title)
+      result->accepted[parent] = true;
+  }
+  return result;
+}
+}  // namespace
+
+namespace gz::gui
+{
+class SearchModel::Implementation
+{
+  /// \brief Constructor
+  /// \param[in] _model Model that owns this
+  public: explicit Implementation(SearchModel *_model);
+
+  /// \brief Destructor. Stops the worker thread.
+  public: ~Implementation();
+
+  /// \brief Index all items of the source model, in depth-first order
+  /// \param[in] _model Source model
+  /// \param[in] _role Role holding the text searched
+  public: void Build(const QAbstractItemModel *_model, int _role) const;
+
+  /// \brief Add the descendants of an item to the index
+  /// \param[in] _model Source model
+  /// \param[in] _role Role holding the text searched
+  /// \param[in] _parent Index of the item on the source model
+  /// \param[in] _parentNode Position of the item's node
+  /// \param[in] _nodes Nodes being built
+  public: void BuildChildren(const QAbstractItemModel *_model, int _role,
+      const QModelIndex &_parent, int _parentNode, SearchNodes &_nodes) const;
+
+  /// \brief Build the index and match it if they're out of date
+  public: void Update() const;
+
+  /// \brief Position of an item's node, if indexed
+  /// \param[in] _srcIndex Index on the source model
+  /// \return Position, or nullopt
+  public: std::optional<int> Find(const QModelIndex &_srcIndex) const;
+
+  /// \brief Hand the current search to the worker thread
+  public: void StartAsyncSearch();
+
+  /// \brief Match searches handed over by StartAsyncSearch, on the worker
+  /// thread
+  public: void RunWorker();
+
+  /// \brief Use the result of a search matched on the worker thread, on the
+  /// GUI thread
+  /// \param[in] _result Result
+  /// \param[in] _generation Generation of the search
+  /// \param[in] _nodes Nodes the result is for
+  public: void FinishAsyncSearch(std::shared_ptr<SearchResult> _result,
+      uint64_t _generation, std::shared_ptr<const SearchNodes> _nodes);
+
+  /// \brief Model that owns this
+  public: SearchModel *model{nullptr};
+
+  /// \brief Indexed nodes
+  public: mutable std::shared_ptr<const SearchNodes> nodes;
+
+  /// \brief Position of each item's node
+  public: mutable QHash<QModelIndex, int> nodeOf;
+
+  /// \brief Result of the last search matched against the nodes
+  public: mutable std::shared_ptr<const SearchResult> result;
+
+  /// \brief Lowercase words of the search, without duplicates
+  public: QStringList words;
+
+  /// \brief True if the index must be built again before it's used
+  public: mutable bool indexDirty{true};
+
+  /// \brief True if the nodes must be matched again before they're used
+  public: mutable bool matchDirty{true};
+
+  /// \brief Filter role the index was built for
+  public: mutable int role{-1};
+
+  /// \brief Connections to the source model's signals
+  public: std::vector<QMetaObject::Connection> connections;
+
+  /// \brief True to match searches on the worker thread
+  public: bool async{false};
+
+  /// \brief Waits for the search to stop changing before matching it
+  public: QTimer delayTimer;
+
+  /// \brief Incremented for each search handed to the worker thread, so
+  /// older ones are cancelled
+  public: std::atomic<uint64_t> generation{0};
+
+  /// \brief Protects the job and stopping flag
+  public: std::mutex workerMutex;
+
+  /// \brief Wakes up the worker thread
+  public: std::condition_variable workerCv;
+
+  /// \brief Search waiting for the worker thread
+  public: std::function<void()> job;
+
+  /// \brief True when the worker thread must return
+  public: bool stopping{false};
+
+  /// \brief Matches searches in async mode, started when first needed
+  public: std::thread worker;
+};
+
+/////////////////////////////////////////////////
+SearchModel::Implementation::Implementation(SearchModel *_model)
+  : model(_model)
+{
+  this->delayTimer.setSingleShot(true);
+  this->delayTimer.setInterval(150);
+}
+
+/////////////////////////////////////////////////
+SearchModel::Implementation::~Implementation()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->stopping = true;
+    ++this->generation;
+  }
+  this->workerCv.notify_one();
+  if (this->worker.joinable())
+    this->worker.join();
+}
+
+/////////////////////////////////////////////////
+void SearchModel::Implementation::Build(const QAbstractItemModel *_model,
+    int _role) const
+{
+  auto built = std::make_shared<SearchNodes>();
+  this->nodeOf.clear();
+  if (nullptr != _model)
+    this->BuildChildren(_model, _role, QModelIndex(), -1, *built);
+
+  this->nodes = std::move(built);
+  this->result.reset();
+  this->role = _role;
+  this->indexDirty = false;
+  this->matchDirty = true;
+}
+
+/////////////////////////////////////////////////
+void SearchModel::Implementation::BuildChildren(
+    const QAbstractItemModel *_model, int _role, const QModelIndex &_parent,
+    int _parentNode, SearchNodes &_nodes) const
+{
+  const int rows = _model->rowCount(_parent);
+  for (int row = 0; row < rows; ++row)
+  {
+    SearchNode node;
+    node.index = _model->index(row, 0, _parent);
+    node.text = _model->data(node.index, _role).toString().toLower();
+    node.parent = _parentNode;
+    node.title = _model->data(node.index, DataRole::TYPE).toString() ==
+        "title";
+
+    const int position = static_cast<int>(_nodes.size());
+    this->nodeOf.insert(node.index, position);
+    const auto index = node.index;
+    _nodes.push_back(std::move(node));
+
+    this->BuildChildren(_model, _role, index, position, _nodes);
+  }
+}
+
+/////////////////////////////////////////////////
+void SearchModel::Implementation::Update() const
+{
+  const int filterRole = this->model->filterRole();
+  if (this->indexDirty || filterRole != this->role)
+    this->Build(this->model->sourceModel(), filterRole);
+
+  // Rows changed since the index was built are matched right away, even in
+  // async mode, since they must be filtered when they're added
+  if (this->matchDirty || nullptr == this->result)
+  {
+    this->result = matchNodes(*this->nodes, this->words, this->result.get(),
+        nullptr);
+    this->matchDirty = false;
+  }
+}
+
+/////////////////////////////////////////////////
+std::optional<int> SearchModel::Implementation::Find(
+    const QModelIndex &_srcIndex) const
+{
+  auto it = this->nodeOf.find(_srcIndex.sibling(_srcIndex.row(), 0));
+  if (it == this->nodeOf.end())
+    return std::nullopt;
+  return it.value();
+}
+
+/////////////////////////////////////////////////
+void SearchModel::Implementation::StartAsyncSearch()
+{
+  // Only the nodes are read by the worker thread, and they're never
+  // modified: a new index is built if the source model changes meanwhile
+  this->Update();
+  auto searchNodes = this->nodes;
+  auto previous = this->result;
+  auto searchWords = this->words;
+  const uint64_t searchGeneration = ++this->generation;
+
+  {
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->job = [this, searchNodes, previous, searchWords, searchGeneration]()
+    {
+      auto searchResult = matchNodes(*searchNodes, searchWords,
+          previous.get(), [this, searchGeneration]()
+          {
+            return this->generation != searchGeneration;
+          });
+      if (nullptr == searchResult)
+        return;
+
+      QMetaObject::invokeMethod(this->model,
+          [this, searchResult, searchGeneration, searchNodes]()
+          {
+            this->FinishAsyncSearch(searchResult, searchGeneration,
+                searchNodes);
+          }, Qt::QueuedConnection);
+    };
+
+    if (!this->worker.joinable())
+      this->worker = std::thread(&Implementation::RunWorker, this);
+  }
+  this->workerCv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void SearchModel::Implementation::RunWorker()
+{
+  std::unique_lock<std::mutex> lock(this->workerMutex);
+  while (true)
+  {
+    this->workerCv.wait(lock, [this]
+    {
+      return this->stopping || this->job;
+    });
+    if (this->stopping)
+      return;
+
+    auto current = std::move(this->job);
+    this->job = nullptr;
+    lock.unlock();
+    current();
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+void SearchModel::Implementation::FinishAsyncSearch(
+    std::shared_ptr<SearchResult> _result, uint64_t _generation,
+    std::shared_ptr<const SearchNodes> _nodes)
+{
+  // A newer search was started meanwhile
+  if (_generation != this->generation)
+    return;
+
+  // The source model changed meanwhile, match again on the new index
+  if (this->indexDirty || _nodes != this->nodes)
+  {
+    this->StartAsyncSearch();
+    return;
+  }
+
+  this->result = std::move(_result);
+  this->matchDirty = false;
+
+  this->model->invalidateFilter();
+  emit this->model->layoutChanged();
+}
+
+/////////////////////////////////////////////////
+SearchModel::SearchModel()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>(this))
+{
+  QObject::connect(&this->dataPtr->delayTimer, &QTimer::timeout, this,
+      [this]()
+      {
+        this->dataPtr->StartAsyncSearch();
+      });
+}
+
+/////////////////////////////////////////////////
+SearchModel::~SearchModel() = default;
+
+/////////////////////////////////////////////////
+void SearchModel::setSourceModel(QAbstractItemModel *_model)
+{
+  for (const auto &connection : this->dataPtr->connections)
+    this->disconnect(connection);
+  this->dataPtr->connections.clear();
+  this->dataPtr->indexDirty = true;
+
+  // Connected before the base class connects its own handlers, so the index
+  // is marked out of date before they filter the changed rows
+  if (nullptr != _model)
+  {
+    auto rebuild = [this]()
+    {
+      this->dataPtr->indexDirty = true;
+    };
+    auto &connections = this->dataPtr->connections;
+    connections.push_back(connect(_model,
+        &QAbstractItemModel::rowsInserted, this, rebuild));
+    connections.push_back(connect(_model,
+        &QAbstractItemModel::rowsRemoved, this, rebuild));
+    connections.push_back(connect(_model,
+        &QAbstractItemModel::rowsMoved, this, rebuild));
+    connections.push_back(connect(_model,
+        &QAbstractItemModel::modelReset, this, rebuild));
+    connections.push_back(connect(_model,
+        &QAbstractItemModel::layoutChanged, this, rebuild));
+    connections.push_back(connect(_model,
+        &QAbstractItemModel::dataChanged, this,
+        [this](const QModelIndex &, const QModelIndex &,
+            const QVector<int> &_roles)
+        {
+          // Only the searched text and the type are indexed
+          if (_roles.isEmpty() || _roles.contains(this->filterRole()) ||
+              _roles.contains(DataRole::TYPE))
+          {
+            this->dataPtr->indexDirty = true;
+          }
+        }));
   }
 
-  return true;
+  QSortFilterProxyModel::setSourceModel(_model);
+}
+
+/////////////////////////////////////////////////
+QVariant SearchModel::data(const QModelIndex &_index, int _role) const
+{
+  if (_role != DataRole::TO_EXPAND)
+    return QSortFilterProxyModel::data(_index, _role);
+
+  if (!_index.isValid())
+    return QVariant();
+
+  this->dataPtr->Update();
+  const auto node = this->dataPtr->Find(this->mapToSource(_index));
+  return node && this->dataPtr->result->expand[*node];
+}
+
+/////////////////////////////////////////////////
+bool SearchModel::filterAcceptsRow(const int _srcRow,
+      const QModelIndex &_srcParent) const
+{
+  this->dataPtr->Update();
+
+  const auto id = this->sourceModel()->index(_srcRow, 0, _srcParent);
+  auto node = this->dataPtr->Find(id);
+
+  // Rows changed without the model telling
+  if (!node)
+  {
+    this->dataPtr->indexDirty = true;
+    this->dataPtr->Update();
+    node = this->dataPtr->Find(id);
+  }
+  return node && this->dataPtr->result->accepted[*node];
 }
 
 /////////////////////////////////////////////////
@@ -146,6 +606,16 @@ bool SearchModel::HasChildAcceptsItself(const QModelIndex &_srcParent,
 void SearchModel::SetSearch(const QString &_search)
 {
   this->search = _search;
+  this->dataPtr->words = searchWords(_search);
+
+  // Rows keep the previous search's filter until the worker thread is done
+  if (this->dataPtr->async)
+  {
+    this->dataPtr->delayTimer.start();
+    return;
+  }
+
+  this->dataPtr->matchDirty = true;
 
   // Trigger repaint on whole model
   this->invalidateFilter();
@@ -154,4 +624,40 @@ void SearchModel::SetSearch(const QString &_search)
   // TopicsStats
   emit this->layoutChanged();
 }
+
+/////////////////////////////////////////////////
+void SearchModel::SetAsync(bool _async)
+{
+  if (_async == this->dataPtr->async)
+    return;
+
+  this->dataPtr->async = _async;
+  if (_async)
+    return;
+
+  // Match the latest search right away, discarding any still running
+  this->dataPtr->delayTimer.stop();
+  ++this->dataPtr->generation;
+  this->dataPtr->matchDirty = true;
+  this->invalidateFilter();
+  emit this->layoutChanged();
+}
+
+/////////////////////////////////////////////////
+bool SearchModel::Async() const
+{
+  return this->dataPtr->async;
+}
+
+/////////////////////////////////////////////////
+void SearchModel::SetSearchDelay(const std::chrono::milliseconds &_delay)
+{
+  this->dataPtr->delayTimer.setInterval(static_cast<int>(_delay.count()));
+}
+
+/////////////////////////////////////////////////
+std::chrono::milliseconds SearchModel::SearchDelay() const
+{
+  return std::chrono::milliseconds(this->dataPtr->delayTimer.interval());
+}
 }  // namespace gz::gui
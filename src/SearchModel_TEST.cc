@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include <gz/common/Console.hh>
 
 #include "test_config.hh"  // NOLINT(build/include)
@@ -173,3 +176,151 @@ TEST(SearchModelTest, NestedStructure)
   }
 }
 
+
+/////////////////////////////////////////////////
+TEST(SearchModelTest, Incremental)
+{
+  common::Console::SetVerbosity(4);
+
+  // A source model
+  // - robot
+  // -- base_link
+  // -- arm
+  // --- gripper
+  // - ground
+  auto sourceModel = new QStandardItemModel();
+  ASSERT_NE(nullptr, sourceModel);
+
+  auto robot = new QStandardItem();
+  robot->setData("robot", DataRole::DISPLAY_NAME);
+  sourceModel->appendRow(robot);
+
+  auto base = new QStandardItem();
+  base->setData("Base_Link", DataRole::DISPLAY_NAME);
+  robot->appendRow(base);
+
+  auto arm = new QStandardItem();
+  arm->setData("arm", DataRole::DISPLAY_NAME);
+  robot->appendRow(arm);
+
+  auto gripper = new QStandardItem();
+  gripper->setData("gripper", DataRole::DISPLAY_NAME);
+  arm->appendRow(gripper);
+
+  auto ground = new QStandardItem();
+  ground->setData("ground", DataRole::DISPLAY_NAME);
+  sourceModel->appendRow(ground);
+
+  auto searchModel = new SearchModel();
+  ASSERT_NE(nullptr, searchModel);
+  searchModel->setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel->setSourceModel(sourceModel);
+  EXPECT_EQ(2, searchModel->rowCount());
+
+  // Typing more characters narrows the results, case insensitive
+  searchModel->SetSearch("g");
+  EXPECT_EQ(2, searchModel->rowCount());
+
+  searchModel->SetSearch("gr");
+  EXPECT_EQ(2, searchModel->rowCount());
+
+  searchModel->SetSearch("gri");
+  EXPECT_EQ(1, searchModel->rowCount());
+  auto robotId = searchModel->index(0, 0);
+  EXPECT_TRUE(searchModel->data(robotId, DataRole::TO_EXPAND).toBool());
+  EXPECT_EQ(2, countRowsOfIndex(robotId));
+
+  searchModel->SetSearch("grip");
+  EXPECT_EQ(1, searchModel->rowCount());
+
+  // Deleting characters widens them again
+  searchModel->SetSearch("g");
+  EXPECT_EQ(2, searchModel->rowCount());
+
+  searchModel->SetSearch("LINK");
+  EXPECT_EQ(1, searchModel->rowCount());
+  robotId = searchModel->index(0, 0);
+  EXPECT_EQ(1, countRowsOfIndex(robotId));
+
+  // Adding a word
+  searchModel->SetSearch("LINK robot");
+  EXPECT_EQ(1, searchModel->rowCount());
+  searchModel->SetSearch("LINK robot arm");
+  EXPECT_EQ(0, searchModel->rowCount());
+
+  // The source model isn't modified
+  EXPECT_FALSE(robot->data(DataRole::TO_EXPAND).isValid());
+
+  // Rows added and text changed after the search are filtered too
+  searchModel->SetSearch("grip");
+  auto grip2 = new QStandardItem();
+  grip2->setData("grip2", DataRole::DISPLAY_NAME);
+  sourceModel->appendRow(grip2);
+  EXPECT_EQ(2, searchModel->rowCount());
+
+  ground->setData("ground_grip", DataRole::DISPLAY_NAME);
+  EXPECT_EQ(3, searchModel->rowCount());
+
+  sourceModel->removeRow(0);
+  EXPECT_EQ(2, searchModel->rowCount());
+}
+
+/////////////////////////////////////////////////
+TEST(SearchModelTest, Async)
+{
+  common::Console::SetVerbosity(4);
+
+  // Needed for the timer and the results posted by the worker thread
+  int argc = 1;
+  char *argv[] =
+  {
+    reinterpret_cast<char*>(const_cast<char*>("./SearchModel_TEST")),
+  };
+  QCoreApplication app(argc, argv);
+
+  auto sourceModel = new QStandardItemModel();
+  ASSERT_NE(nullptr, sourceModel);
+  for (int i = 0; i < 1000; ++i)
+  {
+    auto it = new QStandardItem();
+    it->setData(QString("item_%1").arg(i), DataRole::DISPLAY_NAME);
+    sourceModel->appendRow(it);
+  }
+
+  auto searchModel = new SearchModel();
+  ASSERT_NE(nullptr, searchModel);
+  searchModel->setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel->setSourceModel(sourceModel);
+  EXPECT_FALSE(searchModel->Async());
+  EXPECT_EQ(1000, searchModel->rowCount());
+
+  searchModel->SetAsync(true);
+  EXPECT_TRUE(searchModel->Async());
+  searchModel->SetSearchDelay(std::chrono::milliseconds(10));
+  EXPECT_EQ(std::chrono::milliseconds(10), searchModel->SearchDelay());
+
+  auto waitForRows = [&](int _rows)
+  {
+    for (int i = 0; i < 500 && searchModel->rowCount() != _rows; ++i)
+    {
+      QCoreApplication::processEvents();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return searchModel->rowCount() == _rows;
+  };
+
+  // Rows aren't filtered until the search is matched. Only the last of the
+  // searches typed quickly is used.
+  searchModel->SetSearch("item_9");
+  searchModel->SetSearch("item_99");
+  EXPECT_EQ(1000, searchModel->rowCount());
+  EXPECT_TRUE(waitForRows(11));
+
+  // Back to matching right away
+  searchModel->SetSearch("item_999");
+  searchModel->SetAsync(false);
+  EXPECT_EQ(1, searchModel->rowCount());
+
+  delete searchModel;
+  delete sourceModel;
+}
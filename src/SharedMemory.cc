@@ -0,0 +1,501 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/SharedMemory.hh"
+
+namespace
+{
+/// \brief "GZSM", at the start of every segment
+constexpr uint32_t kMagic{0x4d535a47};
+
+/// \brief Version of the segment layout
+constexpr uint32_t kVersion{1};
+
+/// \brief Size of the segment header and of each slot header, so slots
+/// start on their own cache line
+constexpr std::size_t kHeaderSize{64};
+
+/// \brief Smallest slot capacity
+constexpr std::size_t kMinCapacity{64 * 1024};
+
+/// \brief Most segments a reader keeps mapped
+constexpr std::size_t kMaxMappings{8};
+
+/// \brief Start of a segment
+struct SegmentHeader
+{
+  /// \brief kMagic
+  uint32_t magic;
+
+  /// \brief kVersion
+  uint32_t version;
+
+  /// \brief Number of slots
+  uint32_t slots;
+
+  /// \brief Capacity of each slot, a multiple of kHeaderSize
+  uint32_t capacity;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the size of a segment
+/// \param[in] _slots Number of slots
+/// \param[in] _capacity Capacity of each slot
+/// \return Size in bytes
+std::size_t segmentSize(std::size_t _slots, std::size_t _capacity)
+{
+  return kHeaderSize + _slots * (kHeaderSize + _capacity);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the name of this host
+/// \return Host name, empty if unknown
+std::string hostName()
+{
+#ifndef _WIN32
+  char name[256]{};
+  if (gethostname(name, sizeof(name) - 1) == 0)
+    return name;
+#endif
+  return std::string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a value of a descriptor
+/// \param[in] _descriptor Descriptor
+/// \param[in] _key Key
+/// \return Value, empty if missing
+std::string descriptorValue(const gz::msgs::Header &_descriptor,
+    const std::string &_key)
+{
+  for (const auto &data : _descriptor.data())
+  {
+    if (data.key() == _key && data.value_size() > 0)
+      return data.value(0);
+  }
+  return std::string();
+}
+
+/// \brief Number of publishers created by this process, to name their
+/// segments
+std::atomic<unsigned int> g_publisherCount{0};
+}  // namespace
+
+namespace gz::gui
+{
+class SharedMemoryPublisher::Implementation
+{
+  /// \brief Create and map a segment
+  /// \param[in] _capacity Capacity of each slot
+  /// \return True if mapped
+  public: bool Map(std::size_t _capacity);
+
+  /// \brief Unmap and remove the current segment
+  public: void Unmap();
+
+  /// \brief Node advertising the topics
+  public: transport::Node node;
+
+  /// \brief Publisher of the messages themselves
+  public: transport::Node::Publisher publisher;
+
+  /// \brief Publisher of the descriptors
+  public: transport::Node::Publisher descriptorPublisher;
+
+  /// \brief Message type
+  public: std::string msgType;
+
+  /// \brief Number of slots
+  public: std::size_t slots{4};
+
+  /// \brief Prefix of the segment names, unique to the publisher
+  public: std::string prefix;
+
+  /// \brief Number of segments created so far
+  public: unsigned int generation{0};
+
+  /// \brief Name of the current segment, empty if none
+  public: std::string segment;
+
+  /// \brief Start of the current segment
+  public: char *addr{nullptr};
+
+  /// \brief Capacity of each slot of the current segment
+  public: std::size_t capacity{0};
+
+  /// \brief Number of messages written so far
+  public: uint64_t written{0};
+
+  /// \brief Descriptor, reused for each message
+  public: msgs::Header descriptor;
+};
+
+class SharedMemoryReader::Implementation
+{
+  /// \brief Mapped segment
+  public: struct Mapping
+  {
+    /// \brief Segment name
+    std::string name;
+
+    /// \brief Start of the segment
+    const char *addr{nullptr};
+
+    /// \brief Size of the mapping
+    std::size_t length{0};
+  };
+
+  /// \brief Find or map a segment
+  /// \param[in] _name Segment name
+  /// \return Mapping, null if the segment can't be mapped
+  public: const Mapping *Find(const std::string &_name);
+
+  /// \brief Mapped segments, most recently used last
+  public: std::vector<Mapping> mappings;
+
+  /// \brief Segments which couldn't be mapped
+  public: std::set<std::string> failed;
+
+  /// \brief Name of this host
+  public: std::string host{hostName()};
+};
+
+/////////////////////////////////////////////////
+std::string SharedMemoryTopic(const std::string &_topic)
+{
+  return _topic + "/shm";
+}
+
+/////////////////////////////////////////////////
+SharedMemoryPublisher::SharedMemoryPublisher(const std::string &_topic,
+    const std::string &_msgType, std::size_t _slots)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->msgType = _msgType;
+  this->dataPtr->slots = std::max<std::size_t>(2, _slots);
+  this->dataPtr->publisher = this->dataPtr->node.Advertise(_topic, _msgType);
+  this->dataPtr->descriptorPublisher =
+      this->dataPtr->node.Advertise<msgs::Header>(SharedMemoryTopic(_topic));
+#ifndef _WIN32
+  this->dataPtr->prefix = "/gz-gui-" + std::to_string(getpid()) + "-" +
+      std::to_string(g_publisherCount++);
+#endif
+
+  auto addData = [this](const std::string &_key)
+  {
+    auto data = this->dataPtr->descriptor.add_data();
+    data->set_key(_key);
+    data->add_value();
+  };
+  addData("host");
+  addData("segment");
+  addData("slot");
+  addData("sequence");
+  addData("size");
+  addData("type");
+  this->dataPtr->descriptor.mutable_data(0)->set_value(0, hostName());
+  this->dataPtr->descriptor.mutable_data(5)->set_value(0, _msgType);
+}
+
+/////////////////////////////////////////////////
+SharedMemoryPublisher::~SharedMemoryPublisher()
+{
+  this->dataPtr->Unmap();
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryPublisher::Valid() const
+{
+  return this->dataPtr->publisher.Valid() &&
+      this->dataPtr->descriptorPublisher.Valid();
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryPublisher::Publish(const google::protobuf::Message &_msg)
+{
+  bool result{true};
+  if (this->dataPtr->publisher.HasConnections())
+    result = this->dataPtr->publisher.Publish(_msg);
+
+#ifndef _WIN32
+  if (!this->dataPtr->descriptorPublisher.HasConnections())
+    return result;
+
+  const std::size_t size = _msg.ByteSizeLong();
+  if (size > this->dataPtr->capacity)
+  {
+    this->dataPtr->Unmap();
+    if (!this->dataPtr->Map(size))
+      return false;
+  }
+
+  const auto index = this->dataPtr->written % this->dataPtr->slots;
+  char *slot = this->dataPtr->addr + kHeaderSize +
+      index * (kHeaderSize + this->dataPtr->capacity);
+  auto *sequence = reinterpret_cast<std::atomic<uint64_t> *>(slot);
+
+  // Odd while writing, so readers of the previous message see it's gone
+  const uint64_t number = 2 * (++this->dataPtr->written);
+  sequence->store(number - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  if (!_msg.SerializeToArray(slot + kHeaderSize, static_cast<int>(size)))
+  {
+    gzerr << "Failed to serialize message of type [" << this->dataPtr->msgType
+          << "] to shared memory" << std::endl;
+    return false;
+  }
+  sequence->store(number, std::memory_order_release);
+
+  auto &descriptor = this->dataPtr->descriptor;
+  descriptor.mutable_data(1)->set_value(0, this->dataPtr->segment);
+  descriptor.mutable_data(2)->set_value(0, std::to_string(index));
+  descriptor.mutable_data(3)->set_value(0, std::to_string(number));
+  descriptor.mutable_data(4)->set_value(0, std::to_string(size));
+  result = this->dataPtr->descriptorPublisher.Publish(descriptor) && result;
+#endif
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::string SharedMemoryPublisher::SegmentName() const
+{
+  return this->dataPtr->segment;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryPublisher::Implementation::Map(std::size_t _capacity)
+{
+#ifndef _WIN32
+  // Room to grow, aligned so each slot starts on a cache line
+  _capacity = std::max(kMinCapacity, _capacity + _capacity / 2);
+  _capacity = (_capacity + kHeaderSize - 1) / kHeaderSize * kHeaderSize;
+  const std::size_t length = segmentSize(this->slots, _capacity);
+
+  const auto name = this->prefix + "-" + std::to_string(this->generation++);
+  const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzerr << "Failed to create shared memory segment [" << name << "]: "
+          << std::strerror(errno) << std::endl;
+    return false;
+  }
+  void *addr = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(length)) == 0)
+    addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+  {
+    gzerr << "Failed to map shared memory segment [" << name << "] of "
+          << length << " bytes: " << std::strerror(errno) << std::endl;
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  // The segment is zero filled, so all slots start at sequence 0
+  this->addr = static_cast<char *>(addr);
+  for (std::size_t i = 0; i < this->slots; ++i)
+  {
+    new (this->addr + kHeaderSize + i * (kHeaderSize + _capacity))
+        std::atomic<uint64_t>(0);
+  }
+  auto *header = reinterpret_cast<SegmentHeader *>(this->addr);
+  header->version = kVersion;
+  header->slots = static_cast<uint32_t>(this->slots);
+  header->capacity = static_cast<uint32_t>(_capacity);
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = kMagic;
+
+  this->segment = name;
+  this->capacity = _capacity;
+  return true;
+#else
+  (void)_capacity;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+void SharedMemoryPublisher::Implementation::Unmap()
+{
+#ifndef _WIN32
+  if (nullptr == this->addr)
+    return;
+  munmap(this->addr, segmentSize(this->slots, this->capacity));
+  shm_unlink(this->segment.c_str());
+  this->addr = nullptr;
+  this->capacity = 0;
+  this->segment.clear();
+#endif
+}
+
+/////////////////////////////////////////////////
+SharedMemoryReader::SharedMemoryReader()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+SharedMemoryReader::~SharedMemoryReader()
+{
+#ifndef _WIN32
+  for (const auto &mapping : this->dataPtr->mappings)
+    munmap(const_cast<char *>(mapping.addr), mapping.length);
+#endif
+}
+
+/////////////////////////////////////////////////
+const SharedMemoryReader::Implementation::Mapping *
+    SharedMemoryReader::Implementation::Find(const std::string &_name)
+{
+  auto it = std::find_if(this->mappings.begin(), this->mappings.end(),
+      [&_name](const Mapping &_mapping)
+      {
+        return _mapping.name == _name;
+      });
+  if (it != this->mappings.end())
+  {
+    if (it + 1 != this->mappings.end())
+      std::rotate(it, it + 1, this->mappings.end());
+    return &this->mappings.back();
+  }
+
+#ifndef _WIN32
+  if (this->failed.count(_name) > 0)
+    return nullptr;
+
+  Mapping mapping;
+  mapping.name = _name;
+  const int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+  struct stat info;
+  if (fd >= 0 && fstat(fd, &info) == 0 &&
+      static_cast<std::size_t>(info.st_size) >= kHeaderSize)
+  {
+    mapping.length = static_cast<std::size_t>(info.st_size);
+    void *addr = mmap(nullptr, mapping.length, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr != MAP_FAILED)
+      mapping.addr = static_cast<const char *>(addr);
+  }
+  if (fd >= 0)
+    close(fd);
+
+  if (nullptr != mapping.addr)
+  {
+    auto *header = reinterpret_cast<const SegmentHeader *>(mapping.addr);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->magic != kMagic || header->version != kVersion ||
+        header->capacity % kHeaderSize != 0 ||
+        segmentSize(header->slots, header->capacity) > mapping.length)
+    {
+      munmap(const_cast<char *>(mapping.addr), mapping.length);
+      mapping.addr = nullptr;
+    }
+  }
+
+  if (nullptr == mapping.addr)
+  {
+    this->failed.insert(_name);
+    return nullptr;
+  }
+
+  if (this->mappings.size() >= kMaxMappings)
+  {
+    munmap(const_cast<char *>(this->mappings.front().addr),
+        this->mappings.front().length);
+    this->mappings.erase(this->mappings.begin());
+  }
+  this->mappings.push_back(mapping);
+  return &this->mappings.back();
+#else
+  return nullptr;
+#endif
+}
+
+/////////////////////////////////////////////////
+SharedMemoryReader::Result SharedMemoryReader::Read(
+    const msgs::Header &_descriptor, SharedMemoryView &_view)
+{
+  if (this->dataPtr->host.empty() ||
+      descriptorValue(_descriptor, "host") != this->dataPtr->host)
+  {
+    return Result::UNAVAILABLE;
+  }
+
+  uint64_t slotIndex{0};
+  uint64_t sequence{0};
+  uint64_t size{0};
+  try
+  {
+    slotIndex = std::stoull(descriptorValue(_descriptor, "slot"));
+    sequence = std::stoull(descriptorValue(_descriptor, "sequence"));
+    size = std::stoull(descriptorValue(_descriptor, "size"));
+  }
+  catch (const std::exception &)
+  {
+    return Result::UNAVAILABLE;
+  }
+
+  auto mapping = this->dataPtr->Find(descriptorValue(_descriptor, "segment"));
+  if (nullptr == mapping)
+    return Result::UNAVAILABLE;
+
+  auto *header = reinterpret_cast<const SegmentHeader *>(mapping->addr);
+  if (slotIndex >= header->slots || size > header->capacity)
+    return Result::UNAVAILABLE;
+
+  const char *slot = mapping->addr + kHeaderSize +
+      slotIndex * (kHeaderSize + header->capacity);
+  auto *slotSequence = reinterpret_cast<const std::atomic<uint64_t> *>(slot);
+  if (slotSequence->load(std::memory_order_acquire) != sequence)
+    return Result::STALE;
+
+  _view.data = slot + kHeaderSize;
+  _view.size = static_cast<std::size_t>(size);
+  _view.type = descriptorValue(_descriptor, "type");
+  _view.slot = slotSequence;
+  _view.sequence = sequence;
+  return Result::OK;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryReader::Unchanged(const SharedMemoryView &_view)
+{
+  if (nullptr == _view.slot)
+    return false;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return static_cast<const std::atomic<uint64_t> *>(_view.slot)->load(
+      std::memory_order_relaxed) == _view.sequence;
+}
+}  // namespace gz::gui
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/SharedMemory.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Wait until a condition is true, up to 3 s
+/// \param[in] _condition Condition to wait for
+/// \return True if the condition became true
+bool waitFor(const std::function<bool()> &_condition)
+{
+  for (int sleep = 0; sleep < 30 && !_condition(); ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  return _condition();
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryTest, Topic)
+{
+  EXPECT_EQ("/camera/shm", SharedMemoryTopic("/camera"));
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(PublishAndRead))
+{
+  SharedMemoryPublisher publisher("/shm_test", "gz.msgs.StringMsg", 2);
+  ASSERT_TRUE(publisher.Valid());
+
+  // Nobody listens, nothing is written
+  msgs::StringMsg msg;
+  msg.set_data("nobody");
+  EXPECT_TRUE(publisher.Publish(msg));
+  EXPECT_TRUE(publisher.SegmentName().empty());
+
+  std::mutex mutex;
+  std::vector<msgs::Header> descriptors;
+  std::function<void(const msgs::Header &)> cb =
+      [&](const msgs::Header &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        descriptors.push_back(_msg);
+      };
+  transport::Node node;
+  ASSERT_TRUE(node.Subscribe(SharedMemoryTopic("/shm_test"), cb));
+
+  msg.set_data("first");
+  EXPECT_TRUE(waitFor([&]()
+  {
+    publisher.Publish(msg);
+    std::lock_guard<std::mutex> lock(mutex);
+    return !descriptors.empty();
+  }));
+  EXPECT_FALSE(publisher.SegmentName().empty());
+
+  msgs::Header first;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    first = descriptors.back();
+  }
+
+  SharedMemoryReader reader;
+  SharedMemoryView view;
+  ASSERT_EQ(SharedMemoryReader::Result::OK, reader.Read(first, view));
+  EXPECT_EQ("gz.msgs.StringMsg", view.type);
+  msgs::StringMsg received;
+  ASSERT_TRUE(received.ParseFromArray(view.data,
+      static_cast<int>(view.size)));
+  EXPECT_EQ("first", received.data());
+  EXPECT_TRUE(SharedMemoryReader::Unchanged(view));
+
+  // With 2 slots, the second message after it rewrites its slot
+  msg.set_data("second");
+  publisher.Publish(msg);
+  EXPECT_TRUE(SharedMemoryReader::Unchanged(view));
+  msg.set_data("third");
+  publisher.Publish(msg);
+  EXPECT_FALSE(SharedMemoryReader::Unchanged(view));
+  EXPECT_EQ(SharedMemoryReader::Result::STALE, reader.Read(first, view));
+
+  // A message larger than the slots moves to a new segment
+  const auto segment = publisher.SegmentName();
+  msg.set_data(std::string(1024 * 1024, 'x'));
+  publisher.Publish(msg);
+  EXPECT_NE(segment, publisher.SegmentName());
+  EXPECT_TRUE(waitFor([&]()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return descriptors.back().data(1).value(0) == publisher.SegmentName();
+  }));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(SharedMemoryReader::Result::OK,
+        reader.Read(descriptors.back(), view));
+  }
+  ASSERT_TRUE(received.ParseFromArray(view.data,
+      static_cast<int>(view.size)));
+  EXPECT_EQ(1024u * 1024u, received.data().size());
+  EXPECT_TRUE(SharedMemoryReader::Unchanged(view));
+
+  // Another host, or a segment which is gone
+  auto elsewhere = first;
+  elsewhere.mutable_data(0)->set_value(0, "elsewhere");
+  EXPECT_EQ(SharedMemoryReader::Result::UNAVAILABLE,
+      reader.Read(elsewhere, view));
+  auto gone = first;
+  gone.mutable_data(1)->set_value(0, "/gz-gui-gone");
+  EXPECT_EQ(SharedMemoryReader::Result::UNAVAILABLE, reader.Read(gone, view));
+  EXPECT_EQ(SharedMemoryReader::Result::UNAVAILABLE,
+      reader.Read(msgs::Header(), view));
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TopicSubscribers))
+{
+  SharedMemoryPublisher publisher("/shm_test_topic", "gz.msgs.StringMsg");
+
+  // Subscribers of the topic itself, such as on other hosts, still get
+  // the messages
+  std::mutex mutex;
+  std::string received;
+  std::function<void(const msgs::StringMsg &)> cb =
+      [&](const msgs::StringMsg &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received = _msg.data();
+      };
+  transport::Node node;
+  ASSERT_TRUE(node.Subscribe("/shm_test_topic", cb));
+
+  msgs::StringMsg msg;
+  msg.set_data("hello");
+  EXPECT_TRUE(waitFor([&]()
+  {
+    publisher.Publish(msg);
+    std::lock_guard<std::mutex> lock(mutex);
+    return received == "hello";
+  }));
+
+  // No descriptor subscribers, so no segment
+  EXPECT_TRUE(publisher.SegmentName().empty());
+}
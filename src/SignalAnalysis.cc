@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/SignalAnalysis.hh"
+
+namespace
+{
+/// \brief Pi
+constexpr double kPi = 3.14159265358979323846;
+
+/// \brief Whether a number is a power of two
+/// \param[in] _n Number
+/// \return True for 1, 2, 4...
+bool IsPowerOfTwo(std::size_t _n)
+{
+  return _n > 0 && (_n & (_n - 1)) == 0;
+}
+
+/// \brief In place radix-2 FFT, with real and imaginary parts in separate
+/// arrays so the butterflies of a stage are contiguous loops the compiler
+/// can vectorize.
+/// \param[in, out] _re Real parts
+/// \param[in, out] _im Imaginary parts
+void Fft(std::vector<double> &_re, std::vector<double> &_im)
+{
+  const std::size_t n = _re.size();
+
+  for (std::size_t i = 1, j = 0; i < n; ++i)
+  {
+    std::size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+    {
+      std::swap(_re[i], _re[j]);
+      std::swap(_im[i], _im[j]);
+    }
+  }
+
+  std::vector<double> cosTable(n / 2);
+  std::vector<double> sinTable(n / 2);
+  for (std::size_t k = 0; k < n / 2; ++k)
+  {
+    cosTable[k] = std::cos(2.0 * kPi * k / n);
+    sinTable[k] = -std::sin(2.0 * kPi * k / n);
+  }
+
+  std::vector<double> wr(n / 2);
+  std::vector<double> wi(n / 2);
+  for (std::size_t len = 2; len <= n; len <<= 1)
+  {
+    const std::size_t half = len / 2;
+    const std::size_t step = n / len;
+    for (std::size_t k = 0; k < half; ++k)
+    {
+      wr[k] = cosTable[k * step];
+      wi[k] = sinTable[k * step];
+    }
+
+    for (std::size_t start = 0; start < n; start += len)
+    {
+      double *__restrict ar = _re.data() + start;
+      double *__restrict ai = _im.data() + start;
+      double *__restrict br = ar + half;
+      double *__restrict bi = ai + half;
+      for (std::size_t k = 0; k < half; ++k)
+      {
+        const double tr = br[k] * wr[k] - bi[k] * wi[k];
+        const double ti = br[k] * wi[k] + bi[k] * wr[k];
+        br[k] = ar[k] - tr;
+        bi[k] = ai[k] - ti;
+        ar[k] += tr;
+        ai[k] += ti;
+      }
+    }
+  }
+}
+}  // namespace
+
+namespace gz::gui
+{
+class RollingStatistics::Implementation
+{
+  /// \brief Drop the values older than the window
+  /// \param[in] _now Time of the newest value
+  public: void Expire(double _now);
+
+  /// \brief Time window, 0 for all values
+  public: double window{0.0};
+
+  /// \brief Values within the window, only kept if there's a window
+  public: std::deque<std::pair<double, double>> values;
+
+  /// \brief Candidates for the minimum, increasing values
+  public: std::deque<std::pair<double, double>> minQueue;
+
+  /// \brief Candidates for the maximum, decreasing values
+  public: std::deque<std::pair<double, double>> maxQueue;
+
+  /// \brief Number of values
+  public: std::size_t count{0};
+
+  /// \brief Running mean
+  public: double mean{0.0};
+
+  /// \brief Running sum of squared differences from the mean
+  public: double m2{0.0};
+
+  /// \brief Minimum without a window
+  public: double min{0.0};
+
+  /// \brief Maximum without a window
+  public: double max{0.0};
+};
+
+class Spectrum::Implementation
+{
+  /// \brief Window size, a power of two
+  public: std::size_t size{0};
+
+  /// \brief Ring of the latest values
+  public: std::vector<double> values;
+
+  /// \brief Ring of the latest times
+  public: std::vector<double> times;
+
+  /// \brief Next ring slot to write
+  public: std::size_t next{0};
+
+  /// \brief Values added, up to the size
+  public: std::size_t filled{0};
+
+  /// \brief Values added since the last window was ready
+  public: std::size_t sinceReady{0};
+
+  /// \brief Latest full window, in time order
+  public: std::vector<double> window;
+
+  /// \brief Sample rate of the latest full window
+  public: double sampleRate{0.0};
+};
+
+/////////////////////////////////////////////////
+void RollingStatistics::Implementation::Expire(double _now)
+{
+  const double cutoff = _now - this->window;
+  while (!this->values.empty() && this->values.front().first < cutoff)
+  {
+    const double x = this->values.front().second;
+    this->values.pop_front();
+    if (--this->count == 0)
+    {
+      this->mean = 0.0;
+      this->m2 = 0.0;
+      continue;
+    }
+    const double delta = x - this->mean;
+    this->mean -= delta / static_cast<double>(this->count);
+    this->m2 = std::max(0.0, this->m2 - delta * (x - this->mean));
+  }
+  while (!this->minQueue.empty() && this->minQueue.front().first < cutoff)
+    this->minQueue.pop_front();
+  while (!this->maxQueue.empty() && this->maxQueue.front().first < cutoff)
+    this->maxQueue.pop_front();
+}
+
+/////////////////////////////////////////////////
+RollingStatistics::RollingStatistics(double _window)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->SetWindow(_window);
+}
+
+/////////////////////////////////////////////////
+RollingStatistics::~RollingStatistics() = default;
+
+/////////////////////////////////////////////////
+void RollingStatistics::SetWindow(double _window)
+{
+  this->Clear();
+  this->dataPtr->window = std::max(0.0, _window);
+}
+
+/////////////////////////////////////////////////
+double RollingStatistics::Window() const
+{
+  return this->dataPtr->window;
+}
+
+/////////////////////////////////////////////////
+void RollingStatistics::Add(double _time, double _value)
+{
+  if (!std::isfinite(_value))
+    return;
+
+  auto &d = *this->dataPtr;
+  if (d.window > 0.0)
+  {
+    d.values.emplace_back(_time, _value);
+    while (!d.minQueue.empty() && d.minQueue.back().second >= _value)
+      d.minQueue.pop_back();
+    d.minQueue.emplace_back(_time, _value);
+    while (!d.maxQueue.empty() && d.maxQueue.back().second <= _value)
+      d.maxQueue.pop_back();
+    d.maxQueue.emplace_back(_time, _value);
+  }
+  else if (d.count == 0)
+  {
+    d.min = _value;
+    d.max = _value;
+  }
+  else
+  {
+    d.min = std::min(d.min, _value);
+    d.max = std::max(d.max, _value);
+  }
+
+  ++d.count;
+  const double delta = _value - d.mean;
+  d.mean += delta / static_cast<double>(d.count);
+  d.m2 += delta * (_value - d.mean);
+
+  if (d.window > 0.0)
+    d.Expire(_time);
+}
+
+/////////////////////////////////////////////////
+void RollingStatistics::Clear()
+{
+  auto &d = *this->dataPtr;
+  d.values.clear();
+  d.minQueue.clear();
+  d.maxQueue.clear();
+  d.count = 0;
+  d.mean = 0.0;
+  d.m2 = 0.0;
+  d.min = 0.0;
+  d.max = 0.0;
+}
+
+/////////////////////////////////////////////////
+std::size_t RollingStatistics::Count() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+double RollingStatistics::Mean() const
+{
+  return this->dataPtr->mean;
+}
+
+/////////////////////////////////////////////////
+double RollingStatistics::Variance() const
+{
+  if (this->dataPtr->count == 0)
+    return 0.0;
+  return this->dataPtr->m2 / static_cast<double>(this->dataPtr->count);
+}
+
+/////////////////////////////////////////////////
+double RollingStatistics::StdDev() const
+{
+  return std::sqrt(this->Variance());
+}
+
+/////////////////////////////////////////////////
+double RollingStatistics::Rms() const
+{
+  return std::sqrt(this->Mean() * this->Mean() + this->Variance());
+}
+
+/////////////////////////////////////////////////
+double RollingStatistics::Min() const
+{
+  const auto &d = *this->dataPtr;
+  if (d.window > 0.0)
+    return d.minQueue.empty() ? 0.0 : d.minQueue.front().second;
+  return d.min;
+}
+
+/////////////////////////////////////////////////
+double RollingStatistics::Max() const
+{
+  const auto &d = *this->dataPtr;
+  if (d.window > 0.0)
+    return d.maxQueue.empty() ? 0.0 : d.maxQueue.front().second;
+  return d.max;
+}
+
+/////////////////////////////////////////////////
+Spectrum::Spectrum(std::size_t _size)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  std::size_t size = 8;
+  while (size < _size)
+    size <<= 1;
+  this->dataPtr->size = size;
+  this->dataPtr->values.resize(size);
+  this->dataPtr->times.resize(size);
+}
+
+/////////////////////////////////////////////////
+Spectrum::~Spectrum() = default;
+
+/////////////////////////////////////////////////
+std::size_t Spectrum::Size() const
+{
+  return this->dataPtr->size;
+}
+
+/////////////////////////////////////////////////
+bool Spectrum::Add(double _time, double _value)
+{
+  if (!std::isfinite(_value))
+    return false;
+
+  auto &d = *this->dataPtr;
+  d.values[d.next] = _value;
+  d.times[d.next] = _time;
+  d.next = (d.next + 1) & (d.size - 1);
+  d.filled = std::min(d.filled + 1, d.size);
+  ++d.sinceReady;
+
+  if (d.filled < d.size || d.sinceReady < d.size / 2)
+    return false;
+
+  // The oldest value is in the next slot to write
+  d.window.resize(d.size);
+  std::copy(d.values.begin() + d.next, d.values.end(), d.window.begin());
+  std::copy(d.values.begin(), d.values.begin() + d.next,
+      d.window.begin() + (d.size - d.next));
+
+  const double span = _time - d.times[d.next];
+  d.sampleRate = span > 0.0 ? static_cast<double>(d.size - 1) / span : 0.0;
+  d.sinceReady = 0;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Spectrum::Clear()
+{
+  this->dataPtr->next = 0;
+  this->dataPtr->filled = 0;
+  this->dataPtr->sinceReady = 0;
+  this->dataPtr->window.clear();
+  this->dataPtr->sampleRate = 0.0;
+}
+
+/////////////////////////////////////////////////
+std::vector<double> Spectrum::Window() const
+{
+  return this->dataPtr->window;
+}
+
+/////////////////////////////////////////////////
+double Spectrum::SampleRate() const
+{
+  return this->dataPtr->sampleRate;
+}
+
+/////////////////////////////////////////////////
+std::vector<double> Spectrum::Amplitudes(const std::vector<double> &_values)
+{
+  const std::size_t n = _values.size();
+  if (n < 2 || !IsPowerOfTwo(n))
+    return {};
+
+  // The mean is removed before windowing, so it doesn't leak into the low
+  // frequencies, and put back as the amplitude at 0
+  double mean{0.0};
+  for (const double value : _values)
+    mean += value;
+  mean /= static_cast<double>(n);
+
+  // Periodic Hann window, whose values add up to n / 2
+  std::vector<double> re(n);
+  std::vector<double> im(n, 0.0);
+  const double k = 2.0 * kPi / static_cast<double>(n);
+  for (std::size_t i = 0; i < n; ++i)
+    re[i] = (_values[i] - mean) * 0.5 * (1.0 - std::cos(k * i));
+
+  Fft(re, im);
+
+  std::vector<double> amplitudes(n / 2 + 1);
+  const double scale = 4.0 / static_cast<double>(n);
+  for (std::size_t i = 0; i <= n / 2; ++i)
+    amplitudes[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]) * scale;
+  amplitudes[0] = std::abs(mean);
+  amplitudes[n / 2] *= 0.5;
+  return amplitudes;
+}
+
+/////////////////////////////////////////////////
+double Spectrum::Dominant(const std::vector<double> &_amplitudes,
+    double _sampleRate)
+{
+  if (_amplitudes.size() < 3 || _sampleRate <= 0.0)
+    return 0.0;
+
+  std::size_t peak = 1;
+  for (std::size_t i = 2; i < _amplitudes.size(); ++i)
+  {
+    if (_amplitudes[i] > _amplitudes[peak])
+      peak = i;
+  }
+  if (_amplitudes[peak] <= 0.0)
+    return 0.0;
+
+  // Parabola through the peak and its neighbours
+  double offset{0.0};
+  if (peak + 1 < _amplitudes.size())
+  {
+    const double a = _amplitudes[peak - 1];
+    const double b = _amplitudes[peak];
+    const double c = _amplitudes[peak + 1];
+    const double denominator = a - 2.0 * b + c;
+    if (denominator < 0.0)
+      offset = std::clamp(0.5 * (a - c) / denominator, -0.5, 0.5);
+  }
+
+  const double n = 2.0 * static_cast<double>(_amplitudes.size() - 1);
+  return (static_cast<double>(peak) + offset) * _sampleRate / n;
+}
+}  // namespace gz::gui
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/SignalAnalysis.hh"
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Pi
+constexpr double kPi = 3.14159265358979323846;
+
+/////////////////////////////////////////////////
+TEST(SignalAnalysisTest, CumulativeStatistics)
+{
+  RollingStatistics stats;
+  EXPECT_DOUBLE_EQ(0.0, stats.Window());
+  EXPECT_EQ(0u, stats.Count());
+  EXPECT_DOUBLE_EQ(0.0, stats.Mean());
+  EXPECT_DOUBLE_EQ(0.0, stats.Variance());
+
+  for (double value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0})
+    stats.Add(0.0, value);
+  stats.Add(0.0, std::nan(""));
+
+  EXPECT_EQ(8u, stats.Count());
+  EXPECT_DOUBLE_EQ(5.0, stats.Mean());
+  EXPECT_DOUBLE_EQ(4.0, stats.Variance());
+  EXPECT_DOUBLE_EQ(2.0, stats.StdDev());
+  EXPECT_DOUBLE_EQ(std::sqrt(29.0), stats.Rms());
+  EXPECT_DOUBLE_EQ(2.0, stats.Min());
+  EXPECT_DOUBLE_EQ(9.0, stats.Max());
+
+  stats.Clear();
+  EXPECT_EQ(0u, stats.Count());
+  EXPECT_DOUBLE_EQ(0.0, stats.Max());
+}
+
+/////////////////////////////////////////////////
+TEST(SignalAnalysisTest, RollingStatistics)
+{
+  RollingStatistics stats(10.0);
+  EXPECT_DOUBLE_EQ(10.0, stats.Window());
+
+  // Compare with a brute force pass over the values within the window
+  std::vector<std::pair<double, double>> values;
+  for (int i = 0; i < 500; ++i)
+  {
+    const double time = i * 0.1;
+    const double value = std::sin(i * 0.37) * 100.0 + i;
+    stats.Add(time, value);
+    values.emplace_back(time, value);
+
+    double sum{0.0};
+    double min{value};
+    double max{value};
+    int count{0};
+    for (const auto &[t, v] : values)
+    {
+      if (t < time - 10.0)
+        continue;
+      sum += v;
+      min = std::min(min, v);
+      max = std::max(max, v);
+      ++count;
+    }
+    const double mean = sum / count;
+    double squares{0.0};
+    for (const auto &[t, v] : values)
+    {
+      if (t >= time - 10.0)
+        squares += (v - mean) * (v - mean);
+    }
+
+    ASSERT_EQ(static_cast<std::size_t>(count), stats.Count()) << i;
+    EXPECT_NEAR(mean, stats.Mean(), 1e-9) << i;
+    EXPECT_NEAR(squares / count, stats.Variance(), 1e-6) << i;
+    EXPECT_DOUBLE_EQ(min, stats.Min()) << i;
+    EXPECT_DOUBLE_EQ(max, stats.Max()) << i;
+  }
+
+  // Changing the window starts over
+  stats.SetWindow(1.0);
+  EXPECT_EQ(0u, stats.Count());
+  stats.Add(100.0, 3.0);
+  stats.Add(102.0, 5.0);
+  EXPECT_EQ(1u, stats.Count());
+  EXPECT_DOUBLE_EQ(5.0, stats.Mean());
+  EXPECT_DOUBLE_EQ(0.0, stats.Variance());
+  EXPECT_DOUBLE_EQ(5.0, stats.Min());
+}
+
+/////////////////////////////////////////////////
+TEST(SignalAnalysisTest, Amplitudes)
+{
+  EXPECT_TRUE(Spectrum::Amplitudes({}).empty());
+  EXPECT_TRUE(Spectrum::Amplitudes({1.0, 2.0, 3.0}).empty());
+
+  // 3 units of offset, amplitude 2 at 8 cycles per window and 0.5 at 20
+  const std::size_t n = 256;
+  std::vector<double> values(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    values[i] = 3.0 + 2.0 * std::sin(2.0 * kPi * 8.0 * i / n) +
+        0.5 * std::cos(2.0 * kPi * 20.0 * i / n);
+  }
+
+  const auto amplitudes = Spectrum::Amplitudes(values);
+  ASSERT_EQ(n / 2 + 1, amplitudes.size());
+  EXPECT_NEAR(3.0, amplitudes[0], 1e-9);
+  EXPECT_NEAR(2.0, amplitudes[8], 1e-9);
+  EXPECT_NEAR(0.5, amplitudes[20], 1e-9);
+  EXPECT_NEAR(0.0, amplitudes[50], 1e-9);
+
+  // 256 values per second
+  EXPECT_NEAR(8.0, Spectrum::Dominant(amplitudes, 256.0), 1e-9);
+  EXPECT_DOUBLE_EQ(0.0, Spectrum::Dominant(amplitudes, 0.0));
+}
+
+/////////////////////////////////////////////////
+TEST(SignalAnalysisTest, Spectrum)
+{
+  Spectrum spectrum(100);
+  EXPECT_EQ(128u, spectrum.Size());
+  EXPECT_TRUE(spectrum.Window().empty());
+  EXPECT_DOUBLE_EQ(0.0, spectrum.SampleRate());
+
+  // 12.3 Hz sampled at 200 Hz, a window is ready every 64 values once the
+  // first 128 are in
+  int ready{0};
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double time = i / 200.0;
+    if (spectrum.Add(time, std::sin(2.0 * kPi * 12.3 * time)))
+    {
+      ++ready;
+      EXPECT_EQ(0, (i + 1 - 128) % 64) << i;
+    }
+  }
+  EXPECT_EQ(14, ready);
+
+  // The latest window holds values 832 to 959
+
+  const auto window = spectrum.Window();
+  ASSERT_EQ(128u, window.size());
+  EXPECT_NEAR(std::sin(2.0 * kPi * 12.3 * 959 / 200.0), window.back(),
+      1e-12);
+  EXPECT_NEAR(std::sin(2.0 * kPi * 12.3 * 832 / 200.0), window.front(),
+      1e-12);
+  EXPECT_NEAR(200.0, spectrum.SampleRate(), 1e-9);
+
+  // Between frequency steps of 200 / 128 Hz
+  const double dominant = Spectrum::Dominant(
+      Spectrum::Amplitudes(window), spectrum.SampleRate());
+  EXPECT_NEAR(12.3, dominant, 0.2);
+
+  spectrum.Clear();
+  EXPECT_TRUE(spectrum.Window().empty());
+  EXPECT_FALSE(spectrum.Add(10.0, 1.0));
+}
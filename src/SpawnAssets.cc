@@ -0,0 +1,589 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <tinyxml2.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Pose3.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/SpawnAssets.hh"
+#include "gz/gui/TaskPool.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Deepest chain of included models followed, so includes which
+/// include themselves end
+constexpr int kMaxIncludeDepth{8};
+
+/// \brief Material elements holding a texture file
+const char *const kTextureElements[] = {"albedo_map", "normal_map",
+    "roughness_map", "metalness_map", "emissive_map"};
+
+/// \brief A source being resolved or resolved
+struct CacheEntry
+{
+  /// \brief Result
+  SpawnFuture future;
+
+  /// \brief Value of `tick` when it was last asked for
+  std::uint64_t lastUse{0};
+};
+
+/// \brief Results of the most recent sources
+class Cache
+{
+  /// \brief Protects all members
+  public: std::mutex mutex;
+
+  /// \brief Entries, by source
+  public: std::unordered_map<std::string, CacheEntry> entries;
+
+  /// \brief Incremented on each use, to order them
+  public: std::uint64_t tick{0};
+};
+
+/////////////////////////////////////////////////
+Cache &cache()
+{
+  static Cache instance;
+  return instance;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a source is a description rather than a path
+/// \param[in] _source Source
+/// \return True if it starts with an XML tag
+bool isDescription(const std::string &_source)
+{
+  auto it = std::find_if(_source.begin(), _source.end(), [](char _c)
+      {
+        return !std::isspace(static_cast<unsigned char>(_c));
+      });
+  return it != _source.end() && *it == '<';
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the text of an element without surrounding whitespace
+/// \param[in] _elem Element, may be null
+/// \return Text, empty if there's none
+std::string text(const tinyxml2::XMLElement *_elem)
+{
+  if (nullptr == _elem || nullptr == _elem->GetText())
+    return std::string();
+  std::string str = _elem->GetText();
+  const auto first = str.find_first_not_of(" \t\r\n");
+  if (first == std::string::npos)
+    return std::string();
+  return str.substr(first, str.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the numbers of an element's text
+/// \param[in] _elem Element, may be null
+/// \return Numbers, up to the first which can't be read
+std::vector<double> numbers(const tinyxml2::XMLElement *_elem)
+{
+  std::vector<double> values;
+  std::istringstream stream(text(_elem));
+  double value;
+  while (stream >> value)
+    values.push_back(value);
+  return values;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a number child of an element
+/// \param[in] _elem Element
+/// \param[in] _name Child name
+/// \param[in] _default Value if it's missing
+/// \return Value
+double number(const tinyxml2::XMLElement *_elem, const char *_name,
+    double _default)
+{
+  auto values = numbers(_elem->FirstChildElement(_name));
+  return values.empty() ? _default : values[0];
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a vector child of an element
+/// \param[in] _elem Element
+/// \param[in] _name Child name
+/// \param[in] _default Value if it's missing
+/// \return Value
+math::Vector3d vector(const tinyxml2::XMLElement *_elem, const char *_name,
+    const math::Vector3d &_default)
+{
+  auto values = numbers(_elem->FirstChildElement(_name));
+  if (values.size() < 3)
+    return _default;
+  return {values[0], values[1], values[2]};
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the pose of an element relative to its parent. Poses
+/// relative to other frames are taken as relative to the parent, which
+/// is close enough for a preview.
+/// \param[in] _elem Element
+/// \return Pose, identity if it has none
+math::Pose3d pose(const tinyxml2::XMLElement *_elem)
+{
+  const auto *poseElem = _elem->FirstChildElement("pose");
+  auto values = numbers(poseElem);
+  if (values.size() == 7)
+  {
+    // x y z qx qy qz qw
+    return math::Pose3d(values[0], values[1], values[2], values[6],
+        values[3], values[4], values[5]);
+  }
+  if (values.size() != 6)
+    return math::Pose3d::Zero;
+
+  const char *degrees = poseElem->Attribute("degrees");
+  if (nullptr != degrees &&
+      (std::string(degrees) == "true" || std::string(degrees) == "1"))
+  {
+    for (std::size_t i = 3; i < 6; ++i)
+      values[i] *= GZ_PI / 180.0;
+  }
+  return math::Pose3d(values[0], values[1], values[2], values[3],
+      values[4], values[5]);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a file
+/// \param[in] _path File path
+/// \param[out] _content Its content
+/// \return False if it couldn't be read
+bool readFile(const std::string &_path, std::string &_content)
+{
+  std::ifstream file(_path, std::ios::binary);
+  if (!file)
+    return false;
+  std::ostringstream stream;
+  stream << file.rdbuf();
+  _content = stream.str();
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF file of a model directory, named in its model.config
+/// \param[in] _dir Model directory
+/// \return File path
+std::string modelFile(const std::string &_dir)
+{
+  std::string name = "model.sdf";
+  tinyxml2::XMLDocument config;
+  const auto configPath = common::joinPaths(_dir, "model.config");
+  if (common::exists(configPath) &&
+      config.LoadFile(configPath.c_str()) == tinyxml2::XML_SUCCESS)
+  {
+    const auto *modelElem = config.FirstChildElement("model");
+    const auto sdf = text(nullptr == modelElem ? nullptr :
+        modelElem->FirstChildElement("sdf"));
+    if (!sdf.empty())
+      name = sdf;
+  }
+  return common::joinPaths(_dir, name);
+}
+
+/////////////////////////////////////////////////
+/// \brief Resolve the URI of an asset
+/// \param[in] _uri URI, such as a path relative to the file referencing
+/// it, a file:// or model:// URI, or anything common::findFile resolves
+/// \param[in] _dir Directory of the file referencing it, empty for
+/// descriptions
+/// \return Resolved path, empty if it's not found
+std::string resolve(const std::string &_uri, const std::string &_dir)
+{
+  std::string path = _uri;
+  if (path.rfind("file://", 0) == 0)
+    path = path.substr(7);
+  if (!_dir.empty() && !path.empty() && path[0] != '/' &&
+      path.find("://") == std::string::npos)
+  {
+    const auto relative = common::joinPaths(_dir, path);
+    if (common::exists(relative))
+      return relative;
+  }
+  if (common::exists(path))
+    return path;
+  return common::findFile(_uri);
+}
+
+/// \brief Walks a description, collecting its assets
+class Resolver
+{
+  /// \brief Constructor
+  /// \param[in] _resource Resource filled
+  /// \param[in] _loadMeshes Whether to load the meshes
+  public: Resolver(SpawnResource &_resource, bool _loadMeshes)
+    : resource(_resource), loadMeshes(_loadMeshes)
+  {
+  }
+
+  /// \brief Walk the children of a node
+  /// \param[in] _node Document or element
+  /// \param[in] _pose Pose of the node in the resource's frame
+  /// \param[in] _dir Directory of the file being walked
+  /// \param[in] _depth Number of includes followed to get there
+  /// \param[in] _top True for the top level of the source or of an
+  /// included file, whose model is placed where it's spawned or included
+  /// regardless of its own pose
+  public: void Walk(const tinyxml2::XMLNode *_node, const math::Pose3d &_pose,
+      const std::string &_dir, int _depth, bool _top)
+  {
+    for (const auto *elem = _node->FirstChildElement(); nullptr != elem;
+         elem = elem->NextSiblingElement())
+    {
+      const std::string name = elem->Name();
+      if (name == "sdf")
+      {
+        this->Walk(elem, _pose, _dir, _depth, _top);
+      }
+      else if (name == "world")
+      {
+        this->Walk(elem, _pose, _dir, _depth, false);
+      }
+      else if (name == "model" || name == "actor")
+      {
+        this->Walk(elem, _top ? _pose : _pose * pose(elem), _dir, _depth,
+            false);
+      }
+      else if (name == "link")
+      {
+        this->Walk(elem, _pose * pose(elem), _dir, _depth, false);
+      }
+      else if (name == "visual")
+      {
+        this->Visual(elem, _pose * pose(elem), _dir);
+      }
+      else if (name == "include")
+      {
+        this->Include(elem, _top ? _pose : _pose * pose(elem), _dir,
+            _depth);
+      }
+    }
+  }
+
+  /// \brief Follow an include
+  /// \param[in] _elem Include element
+  /// \param[in] _pose Pose of the included model
+  /// \param[in] _dir Directory of the file including it
+  /// \param[in] _depth Number of includes followed to get there
+  private: void Include(const tinyxml2::XMLElement *_elem,
+      const math::Pose3d &_pose, const std::string &_dir, int _depth)
+  {
+    const auto uri = text(_elem->FirstChildElement("uri"));
+    if (uri.empty() || _depth >= kMaxIncludeDepth)
+      return;
+
+    auto path = resolve(uri, _dir);
+    if (!path.empty() && common::isDirectory(path))
+      path = modelFile(path);
+
+    std::string content;
+    tinyxml2::XMLDocument doc;
+    if (path.empty() || !readFile(path, content) ||
+        doc.Parse(content.c_str()) != tinyxml2::XML_SUCCESS)
+    {
+      this->resource.missing.push_back(uri);
+      return;
+    }
+    this->Walk(&doc, _pose, common::parentPath(path), _depth + 1, true);
+  }
+
+  /// \brief Collect the geometry and textures of a visual
+  /// \param[in] _elem Visual element
+  /// \param[in] _pose Pose of the visual
+  /// \param[in] _dir Directory of the file being walked
+  private: void Visual(const tinyxml2::XMLElement *_elem,
+      const math::Pose3d &_pose, const std::string &_dir)
+  {
+    if (const auto *material = _elem->FirstChildElement("material"))
+      this->Textures(material, _dir);
+
+    const auto *geometry = _elem->FirstChildElement("geometry");
+    const auto *shape = nullptr == geometry ? nullptr :
+        geometry->FirstChildElement();
+    if (nullptr == shape)
+      return;
+
+    const std::string name = shape->Name();
+    if (name == "box")
+    {
+      const auto half = vector(shape, "size", math::Vector3d::One) * 0.5;
+      this->AddBox(-half, half, _pose);
+    }
+    else if (name == "sphere")
+    {
+      const double r = number(shape, "radius", 1.0);
+      this->AddBox(-math::Vector3d(r, r, r), math::Vector3d(r, r, r), _pose);
+    }
+    else if (name == "ellipsoid")
+    {
+      const auto radii = vector(shape, "radii", math::Vector3d::One);
+      this->AddBox(-radii, radii, _pose);
+    }
+    else if (name == "cylinder" || name == "cone" || name == "capsule")
+    {
+      const double r = number(shape, "radius", 1.0);
+      double halfLength = number(shape, "length", 1.0) * 0.5;
+      if (name == "capsule")
+        halfLength += r;
+      const math::Vector3d half(r, r, halfLength);
+      this->AddBox(-half, half, _pose);
+    }
+    else if (name == "plane")
+    {
+      auto size = numbers(shape->FirstChildElement("size"));
+      if (size.size() < 2)
+        size = {1.0, 1.0};
+      const math::Vector3d half(size[0] * 0.5, size[1] * 0.5, 0.0);
+      this->AddBox(-half, half, _pose);
+    }
+    else if (name == "mesh")
+    {
+      this->Mesh(shape, _pose, _dir);
+    }
+  }
+
+  /// \brief Resolve, load and measure a mesh
+  /// \param[in] _elem Mesh element
+  /// \param[in] _pose Pose of the visual
+  /// \param[in] _dir Directory of the file being walked
+  private: void Mesh(const tinyxml2::XMLElement *_elem,
+      const math::Pose3d &_pose, const std::string &_dir)
+  {
+    const auto uri = text(_elem->FirstChildElement("uri"));
+    if (uri.empty())
+      return;
+    const auto path = resolve(uri, _dir);
+    if (path.empty())
+    {
+      this->resource.missing.push_back(uri);
+      return;
+    }
+    if (this->known.insert(path).second)
+      this->resource.meshes.push_back(path);
+    if (!this->loadMeshes)
+      return;
+
+    const auto *mesh = common::MeshManager::Instance()->Load(path);
+    if (nullptr == mesh)
+      return;
+    math::Vector3d center;
+    math::Vector3d min;
+    math::Vector3d max;
+    mesh->AABB(center, min, max);
+    const auto scale = vector(_elem, "scale", math::Vector3d::One);
+    this->AddBox(min * scale, max * scale, _pose);
+  }
+
+  /// \brief Collect the textures of a material
+  /// \param[in] _elem Material element, or one of its descendants
+  /// \param[in] _dir Directory of the file being walked
+  private: void Textures(const tinyxml2::XMLElement *_elem,
+      const std::string &_dir)
+  {
+    for (const auto *elem = _elem->FirstChildElement(); nullptr != elem;
+         elem = elem->NextSiblingElement())
+    {
+      const bool texture = std::any_of(std::begin(kTextureElements),
+          std::end(kTextureElements), [&](const char *_name)
+          {
+            return std::string(_name) == elem->Name();
+          });
+      if (!texture)
+      {
+        this->Textures(elem, _dir);
+        continue;
+      }
+
+      const auto uri = text(elem);
+      if (uri.empty())
+        continue;
+      const auto path = resolve(uri, _dir);
+      if (path.empty())
+        this->resource.missing.push_back(uri);
+      else if (this->known.insert(path).second)
+        this->resource.textures.push_back(path);
+    }
+  }
+
+  /// \brief Grow the resource's box around a box given in a visual's frame
+  /// \param[in] _min Minimum corner
+  /// \param[in] _max Maximum corner
+  /// \param[in] _pose Pose of the visual
+  private: void AddBox(const math::Vector3d &_min, const math::Vector3d &_max,
+      const math::Pose3d &_pose)
+  {
+    for (int i = 0; i < 8; ++i)
+    {
+      const math::Vector3d corner(
+          (i & 1) ? _max.X() : _min.X(),
+          (i & 2) ? _max.Y() : _min.Y(),
+          (i & 4) ? _max.Z() : _min.Z());
+      const auto point = _pose.Pos() + _pose.Rot().RotateVector(corner);
+      this->resource.box.Merge(math::AxisAlignedBox(point, point));
+    }
+  }
+
+  /// \brief Resource filled
+  private: SpawnResource &resource;
+
+  /// \brief Whether to load the meshes
+  private: bool loadMeshes;
+
+  /// \brief Files already collected
+  private: std::unordered_set<std::string> known;
+};
+}  // namespace
+
+/////////////////////////////////////////////////
+SpawnFuture SpawnAssets::Prefetch(const std::string &_source)
+{
+  auto &c = cache();
+  auto promise =
+      std::make_shared<std::promise<std::shared_ptr<const SpawnResource>>>();
+  SpawnFuture future;
+  {
+    std::lock_guard<std::mutex> lock(c.mutex);
+    auto it = c.entries.find(_source);
+    if (it != c.entries.end())
+    {
+      it->second.lastUse = ++c.tick;
+      return it->second.future;
+    }
+
+    while (c.entries.size() >= kCacheSize)
+    {
+      c.entries.erase(std::min_element(c.entries.begin(), c.entries.end(),
+          [](const auto &_a, const auto &_b)
+          {
+            return _a.second.lastUse < _b.second.lastUse;
+          }));
+    }
+    future = promise->get_future().share();
+    c.entries.emplace(_source, CacheEntry{future, ++c.tick});
+  }
+
+  auto task = [promise, _source]()
+  {
+    promise->set_value(std::make_shared<const SpawnResource>(
+        Resolve(_source)));
+  };
+
+  // The user is waiting on it, with the model under the mouse
+  if (auto *app = App())
+    app->Tasks()->Submit(task, TaskPool::Priority::HIGH);
+  else
+    task();
+  return future;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const SpawnResource> SpawnAssets::Ready(
+    const std::string &_source)
+{
+  SpawnFuture future;
+  {
+    auto &c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    auto it = c.entries.find(_source);
+    if (it == c.entries.end())
+      return nullptr;
+    future = it->second.future;
+  }
+
+  if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    return nullptr;
+
+  // Broken if the application's tasks were dropped on shutdown
+  try
+  {
+    return future.get();
+  }
+  catch (const std::future_error &)
+  {
+    return nullptr;
+  }
+}
+
+/////////////////////////////////////////////////
+SpawnResource SpawnAssets::Resolve(const std::string &_source,
+    bool _loadMeshes)
+{
+  SpawnResource resource;
+  std::string dir;
+  if (isDescription(_source))
+  {
+    resource.sdf = _source;
+  }
+  else
+  {
+    auto path = resolve(_source, std::string());
+    if (!path.empty() && common::isDirectory(path))
+      path = modelFile(path);
+    if (path.empty() || !readFile(path, resource.sdf))
+    {
+      resource.error = "Unable to find or read [" + _source + "]";
+      return resource;
+    }
+    resource.file = path;
+    dir = common::parentPath(path);
+  }
+
+  tinyxml2::XMLDocument doc;
+  if (doc.Parse(resource.sdf.c_str()) != tinyxml2::XML_SUCCESS)
+  {
+    resource.error = std::string("Unable to parse the description: ") +
+        (nullptr == doc.ErrorStr() ? "" : doc.ErrorStr());
+    return resource;
+  }
+  resource.valid = true;
+
+  Resolver(resource, _loadMeshes).Walk(&doc, math::Pose3d::Zero, dir, 0,
+      true);
+  return resource;
+}
+
+/////////////////////////////////////////////////
+void SpawnAssets::Clear()
+{
+  auto &c = cache();
+  std::lock_guard<std::mutex> lock(c.mutex);
+  c.entries.clear();
+}
+}  // namespace gz::gui
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gz/gui/SpawnAssets.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Write a file, creating its directory
+/// \param[in] _path File path
+/// \param[in] _content Content
+void writeFile(const std::filesystem::path &_path, const std::string &_content)
+{
+  std::filesystem::create_directories(_path.parent_path());
+  std::ofstream file(_path);
+  file << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(SpawnAssetsTest, Primitives)
+{
+  // The model's own pose is replaced by where it's spawned
+  auto resource = SpawnAssets::Resolve(
+      "<?xml version='1.0'?>"
+      "<sdf version='1.11'>"
+      "  <model name='m'>"
+      "    <pose>100 100 100 0 0 0</pose>"
+      "    <link name='l'>"
+      "      <pose>0 0 1 0 0 0</pose>"
+      "      <visual name='box'>"
+      "        <geometry><box><size>2 4 2</size></box></geometry>"
+      "      </visual>"
+      "      <visual name='sphere'>"
+      "        <pose>3 0 0 0 0 0</pose>"
+      "        <geometry><sphere><radius>0.5</radius></sphere></geometry>"
+      "      </visual>"
+      "      <collision name='ignored'>"
+      "        <geometry><box><size>100 100 100</size></box></geometry>"
+      "      </collision>"
+      "    </link>"
+      "  </model>"
+      "</sdf>", false);
+  ASSERT_TRUE(resource.valid) << resource.error;
+  EXPECT_TRUE(resource.file.empty());
+  EXPECT_TRUE(resource.meshes.empty());
+  EXPECT_TRUE(resource.missing.empty());
+  EXPECT_EQ(math::Vector3d(-1, -2, 0), resource.box.Min());
+  EXPECT_EQ(math::Vector3d(3.5, 2, 2), resource.box.Max());
+
+  // Rotated visuals, in degrees, and a description without <sdf>
+  resource = SpawnAssets::Resolve(
+      "<model name='m'><link name='l'><visual name='v'>"
+      "  <pose degrees='true'>0 0 0 0 0 90</pose>"
+      "  <geometry><box><size>4 2 2</size></box></geometry>"
+      "</visual></link></model>", false);
+  ASSERT_TRUE(resource.valid) << resource.error;
+  EXPECT_NEAR(-1.0, resource.box.Min().X(), 1e-9);
+  EXPECT_NEAR(-2.0, resource.box.Min().Y(), 1e-9);
+  EXPECT_NEAR(1.0, resource.box.Max().X(), 1e-9);
+  EXPECT_NEAR(2.0, resource.box.Max().Y(), 1e-9);
+
+  // Nothing to measure
+  resource = SpawnAssets::Resolve("<model name='m'/>", false);
+  EXPECT_TRUE(resource.valid);
+  EXPECT_FALSE(resource.box.Min().X() <= resource.box.Max().X());
+}
+
+/////////////////////////////////////////////////
+TEST(SpawnAssetsTest, Includes)
+{
+  const auto dir = std::filesystem::temp_directory_path() /
+      "gz_gui_spawn_assets";
+  std::filesystem::remove_all(dir);
+  writeFile(dir / "crate" / "model.config",
+      "<model><name>crate</name><sdf version='1.11'>crate.sdf</sdf></model>");
+  writeFile(dir / "crate" / "crate.sdf",
+      "<sdf version='1.11'><model name='crate'>"
+      "  <pose>50 0 0 0 0 0</pose>"
+      "  <link name='l'><visual name='v'>"
+      "    <geometry><mesh><uri>meshes/crate.dae</uri></mesh></geometry>"
+      "    <material><pbr><metal>"
+      "      <albedo_map>materials/crate.png</albedo_map>"
+      "      <normal_map>materials/missing.png</normal_map>"
+      "    </metal></pbr></material>"
+      "  </visual>"
+      "  <visual name='lid'>"
+      "    <geometry><box><size>1 1 1</size></box></geometry>"
+      "  </visual></link>"
+      "</model></sdf>");
+  writeFile(dir / "crate" / "meshes" / "crate.dae", "");
+  writeFile(dir / "crate" / "materials" / "crate.png", "");
+
+  auto resource = SpawnAssets::Resolve(
+      "<sdf version='1.11'><world name='w'>"
+      "  <include>"
+      "    <uri>" + (dir / "crate").string() + "</uri>"
+      "    <pose>0 0 10 0 0 0</pose>"
+      "  </include>"
+      "  <include><uri>model://unknown_model_xyz</uri></include>"
+      "</world></sdf>", false);
+  ASSERT_TRUE(resource.valid) << resource.error;
+  ASSERT_EQ(1u, resource.meshes.size());
+  EXPECT_EQ(std::filesystem::path(resource.meshes[0]),
+      dir / "crate" / "meshes" / "crate.dae");
+  ASSERT_EQ(1u, resource.textures.size());
+  EXPECT_EQ(std::filesystem::path(resource.textures[0]),
+      dir / "crate" / "materials" / "crate.png");
+  EXPECT_EQ(2u, resource.missing.size());
+  EXPECT_NE(resource.missing.end(), std::find(resource.missing.begin(),
+      resource.missing.end(), "model://unknown_model_xyz"));
+
+  // Placed by the include, not by the included model's pose
+  EXPECT_EQ(math::Vector3d(-0.5, -0.5, 9.5), resource.box.Min());
+  EXPECT_EQ(math::Vector3d(0.5, 0.5, 10.5), resource.box.Max());
+
+  // From the model directory itself
+  resource = SpawnAssets::Resolve((dir / "crate").string(), false);
+  ASSERT_TRUE(resource.valid) << resource.error;
+  EXPECT_EQ(std::filesystem::path(resource.file),
+      dir / "crate" / "crate.sdf");
+  EXPECT_EQ(1u, resource.meshes.size());
+
+  std::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST(SpawnAssetsTest, Errors)
+{
+  auto resource = SpawnAssets::Resolve("/no/such/model_xyz.sdf", false);
+  EXPECT_FALSE(resource.valid);
+  EXPECT_FALSE(resource.error.empty());
+
+  resource = SpawnAssets::Resolve("<sdf><model name='m'>", false);
+  EXPECT_FALSE(resource.valid);
+  EXPECT_FALSE(resource.error.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SpawnAssetsTest, Prefetch)
+{
+  SpawnAssets::Clear();
+  const std::string source =
+      "<model name='m'><link name='l'><visual name='v'>"
+      "<geometry><sphere><radius>1</radius></sphere></geometry>"
+      "</visual></link></model>";
+  EXPECT_EQ(nullptr, SpawnAssets::Ready(source));
+
+  // Without an application, it's resolved right away
+  auto future = SpawnAssets::Prefetch(source);
+  ASSERT_TRUE(future.valid());
+  auto resource = SpawnAssets::Ready(source);
+  ASSERT_NE(nullptr, resource);
+  EXPECT_TRUE(resource->valid);
+  EXPECT_EQ(math::Vector3d(1, 1, 1), resource->box.Max());
+  EXPECT_EQ(resource, future.get());
+
+  // Resolved once
+  EXPECT_EQ(resource, SpawnAssets::Prefetch(source).get());
+
+  // Only the most recent sources are kept
+  for (std::size_t i = 0; i < SpawnAssets::kCacheSize; ++i)
+    SpawnAssets::Prefetch("<model name='m" + std::to_string(i) + "'/>");
+  EXPECT_EQ(nullptr, SpawnAssets::Ready(source));
+  EXPECT_NE(nullptr, SpawnAssets::Ready("<model name='m0'/>"));
+
+  SpawnAssets::Clear();
+  EXPECT_EQ(nullptr, SpawnAssets::Ready("<model name='m0'/>"));
+}
@@ -0,0 +1,549 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <tinyxml2.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// __GLIBC__ is defined by the headers above
+#if defined(__linux__) && defined(__GLIBC__)
+#  define GZ_GUI_WATCHDOG_STACKS 1
+#  include <execinfo.h>
+#  include <pthread.h>
+#  include <signal.h>
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/StallWatchdog.hh"
+
+namespace gz::gui
+{
+namespace
+{
+/// \brief Most scopes recorded per thread, deeper ones are counted only
+constexpr std::size_t kMaxZones{16};
+
+/////////////////////////////////////////////////
+/// \brief Current time, for the atomics of the slots
+/// \return Nanoseconds since the steady clock's epoch
+std::int64_t nowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// \brief State of a watched thread
+struct Slot
+{
+  /// \brief Name the thread is reported as
+  std::string name;
+
+  /// \brief Time of the last beat, or of becoming idle, in nanoseconds
+  std::atomic<std::int64_t> lastBeat{0};
+
+  /// \brief False while the thread waits for work
+  std::atomic<bool> busy{false};
+
+  /// \brief Event handler running, null if none
+  std::atomic<const char *> handler{nullptr};
+
+  /// \brief Scopes entered, outermost first
+  std::array<std::atomic<const char *>, kMaxZones> zones{};
+
+  /// \brief Number of scopes entered, including those past kMaxZones
+  std::atomic<std::size_t> depth{0};
+
+#ifdef GZ_GUI_WATCHDOG_STACKS
+  /// \brief Thread, to interrupt it for its stack
+  pthread_t thread{};
+#endif
+
+  /// \brief Beat after which the thread stalled, 0 if it's not stalled.
+  /// Only touched by the watchdog's thread.
+  std::int64_t stalledBeat{0};
+};
+
+/// \brief Watched threads and the watchdog's thread
+class Registry
+{
+  /// \brief Destructor, stops the watchdog's thread
+  public: ~Registry()
+  {
+    this->Stop();
+  }
+
+  /// \brief Stop the watchdog's thread and wait for it
+  public: void Stop()
+  {
+    std::thread thread;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->running = false;
+      thread = std::move(this->thread);
+    }
+    this->wake.notify_all();
+    if (thread.joinable())
+      thread.join();
+  }
+
+  /// \brief Body of the watchdog's thread
+  public: void Run();
+
+  /// \brief Protects all members
+  public: std::mutex mutex;
+
+  /// \brief Wakes the watchdog's thread early, when stopping or when the
+  /// options change
+  public: std::condition_variable wake;
+
+  /// \brief Watched threads
+  public: std::vector<std::shared_ptr<Slot>> slots;
+
+  /// \brief Current options
+  public: StallWatchdog::Options options;
+
+  /// \brief Called on each stall
+  public: StallWatchdog::Callback callback;
+
+  /// \brief True while the watchdog's thread should run
+  public: bool running{false};
+
+  /// \brief Watchdog's thread
+  public: std::thread thread;
+};
+
+/////////////////////////////////////////////////
+std::shared_ptr<Registry> &registry()
+{
+  static auto instance = std::make_shared<Registry>();
+  return instance;
+}
+
+/// \brief Slot of the calling thread, null if it's not watched. Kept apart
+/// from `tWatched` so the fast paths don't check for its construction.
+thread_local Slot *tSlot{nullptr};
+
+/// \brief Unwatches its thread when the thread exits
+struct Watched
+{
+  /// \brief Destructor
+  ~Watched()
+  {
+    this->Reset();
+  }
+
+  /// \brief Remove the slot from the registry
+  void Reset()
+  {
+    tSlot = nullptr;
+    auto reg = this->registry.lock();
+    if (nullptr == reg || nullptr == this->slot)
+      return;
+
+    std::lock_guard<std::mutex> lock(reg->mutex);
+    reg->slots.erase(std::remove(reg->slots.begin(), reg->slots.end(),
+        this->slot), reg->slots.end());
+    this->slot.reset();
+  }
+
+  /// \brief Registry holding the slot, weak so that threads outliving it
+  /// during static destruction don't touch it
+  std::weak_ptr<Registry> registry;
+
+  /// \brief Slot of the thread
+  std::shared_ptr<Slot> slot;
+};
+
+/// \brief Slot ownership of the calling thread
+thread_local Watched tWatched;
+
+#ifdef GZ_GUI_WATCHDOG_STACKS
+/// \brief Most frames captured
+constexpr int kMaxFrames{64};
+
+/// \brief Frames written by the interrupted thread
+void *gFrames[kMaxFrames];
+
+/// \brief Number of frames in `gFrames`, negative until they're written
+std::atomic<int> gFrameCount{-1};
+
+/////////////////////////////////////////////////
+/// \brief Signal interrupting a thread for its stack
+/// \return Signal number
+int stackSignal()
+{
+  return SIGRTMIN + 3;
+}
+
+/////////////////////////////////////////////////
+/// \brief Handler of stackSignal, run by the interrupted thread
+void onStackSignal(int)
+{
+  gFrameCount.store(backtrace(gFrames, kMaxFrames),
+      std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+/// \brief Install the handler of stackSignal, once
+/// \return True if installed
+bool installStackHandler()
+{
+  static const bool installed = []()
+  {
+    // The first call loads libgcc, which isn't safe from a handler
+    void *frame{nullptr};
+    backtrace(&frame, 1);
+
+    struct sigaction action{};
+    action.sa_handler = onStackSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(stackSignal(), &action, nullptr) != 0)
+    {
+      gzwarn << "Failed to install the stall watchdog's signal handler, "
+             << "stalls won't have stack traces." << std::endl;
+      return false;
+    }
+    return true;
+  }();
+  return installed;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the stack of a thread
+/// \param[in] _thread Thread
+/// \return Frames, innermost first, empty if the thread didn't answer
+std::vector<std::string> captureStack(pthread_t _thread)
+{
+  if (!installStackHandler())
+    return {};
+
+  gFrameCount.store(-1, std::memory_order_relaxed);
+  if (pthread_kill(_thread, stackSignal()) != 0)
+    return {};
+
+  int count{-1};
+  for (int i = 0; i < 100; ++i)
+  {
+    count = gFrameCount.load(std::memory_order_acquire);
+    if (count >= 0)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (count <= 0)
+    return {};
+
+  std::vector<std::string> stack;
+  char **symbols = backtrace_symbols(gFrames, count);
+  if (nullptr == symbols)
+    return {};
+
+  // Skip the handler
+  for (int i = 1; i < count; ++i)
+    stack.emplace_back(symbols[i]);
+  free(symbols);
+  return stack;
+}
+#endif
+
+/////////////////////////////////////////////////
+/// \brief Describe a stall for the console
+/// \param[in] _stall Stall
+/// \return Description, ending with a new line
+std::string describe(const StallWatchdog::Stall &_stall)
+{
+  std::ostringstream out;
+  out << "Thread [" << _stall.thread << "] stalled for "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(
+          _stall.duration).count() << " ms";
+  if (!_stall.zones.empty())
+  {
+    out << " in [";
+    for (std::size_t i = 0; i < _stall.zones.size(); ++i)
+      out << (i > 0 ? " > " : "") << _stall.zones[i];
+    out << "]";
+  }
+  out << std::endl;
+  for (const auto &frame : _stall.stack)
+    out << "    " << frame << std::endl;
+  return out.str();
+}
+
+/////////////////////////////////////////////////
+void Registry::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (this->running)
+  {
+    const auto period = std::max<std::chrono::steady_clock::duration>(
+        this->options.threshold / 4, std::chrono::milliseconds(10));
+    this->wake.wait_for(lock, period);
+    if (!this->running)
+      break;
+
+    // Stacks take a while, and callbacks may watch threads
+    const auto slots = this->slots;
+    const auto opts = this->options;
+    const auto cb = this->callback;
+    lock.unlock();
+
+    const std::int64_t threshold =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        opts.threshold).count();
+    for (const auto &slot : slots)
+    {
+      const auto beat = slot->lastBeat.load(std::memory_order_acquire);
+      if (0 != slot->stalledBeat && beat != slot->stalledBeat)
+      {
+        gzmsg << "Thread [" << slot->name << "] responsive again after "
+              << (beat - slot->stalledBeat) / 1000000 << " ms" << std::endl;
+        slot->stalledBeat = 0;
+      }
+
+      const auto elapsed = nowNs() - beat;
+      if (!slot->busy.load(std::memory_order_acquire) ||
+          beat == slot->stalledBeat || elapsed < threshold)
+      {
+        continue;
+      }
+      slot->stalledBeat = beat;
+
+      StallWatchdog::Stall stall;
+      stall.thread = slot->name;
+      stall.duration = std::chrono::nanoseconds(elapsed);
+      if (auto *handler = slot->handler.load(std::memory_order_relaxed))
+        stall.zones.emplace_back(handler);
+      const auto depth = std::min(
+          slot->depth.load(std::memory_order_acquire), kMaxZones);
+      for (std::size_t i = 0; i < depth; ++i)
+      {
+        if (auto *zone = slot->zones[i].load(std::memory_order_relaxed))
+          stall.zones.emplace_back(zone);
+      }
+#ifdef GZ_GUI_WATCHDOG_STACKS
+      if (opts.stackTraces)
+        stall.stack = captureStack(slot->thread);
+#endif
+
+      gzwarn << describe(stall);
+      if (cb)
+        cb(stall);
+    }
+
+    lock.lock();
+  }
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+bool StallWatchdog::Options::Load(const tinyxml2::XMLElement *_elem)
+{
+  if (nullptr == _elem)
+    return true;
+
+  bool valid{true};
+  this->threshold = std::chrono::milliseconds(1000);
+  if (auto *thresholdElem = _elem->FirstChildElement("threshold"))
+  {
+    unsigned int ms{0};
+    if (thresholdElem->QueryUnsignedText(&ms) != tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Failed to parse <threshold>" << std::endl;
+      valid = false;
+    }
+    else
+    {
+      this->threshold = std::chrono::milliseconds(ms);
+    }
+  }
+
+  if (auto *stackElem = _elem->FirstChildElement("stack_trace"))
+  {
+    if (stackElem->QueryBoolText(&this->stackTraces) !=
+        tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Failed to parse <stack_trace>" << std::endl;
+      valid = false;
+    }
+  }
+
+  if (auto *topicElem = _elem->FirstChildElement("topic"))
+  {
+    if (nullptr != topicElem->GetText())
+      this->topic = topicElem->GetText();
+  }
+  return valid;
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::Start(const Options &_options)
+{
+  if (_options.threshold.count() <= 0)
+  {
+    Stop();
+    return;
+  }
+
+#ifdef GZ_GUI_WATCHDOG_STACKS
+  if (_options.stackTraces)
+    installStackHandler();
+#else
+  if (_options.stackTraces)
+  {
+    gzwarn << "Stack traces of stalled threads aren't supported on this "
+           << "platform." << std::endl;
+  }
+#endif
+
+  auto reg = registry();
+  {
+    std::lock_guard<std::mutex> lock(reg->mutex);
+    reg->options = _options;
+    if (!reg->running)
+    {
+      reg->running = true;
+      reg->thread = std::thread([r = reg.get()]() {r->Run();});
+    }
+  }
+  reg->wake.notify_all();
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::Stop()
+{
+  registry()->Stop();
+}
+
+/////////////////////////////////////////////////
+bool StallWatchdog::Running()
+{
+  auto reg = registry();
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  return reg->running;
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::SetCallback(Callback _callback)
+{
+  auto reg = registry();
+  std::lock_guard<std::mutex> lock(reg->mutex);
+  reg->callback = std::move(_callback);
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::Watch(const std::string &_name)
+{
+  tWatched.Reset();
+
+  auto slot = std::make_shared<Slot>();
+  slot->name = _name;
+  slot->lastBeat = nowNs();
+#ifdef GZ_GUI_WATCHDOG_STACKS
+  slot->thread = pthread_self();
+#endif
+
+  auto reg = registry();
+  {
+    std::lock_guard<std::mutex> lock(reg->mutex);
+    reg->slots.push_back(slot);
+  }
+  tWatched.registry = reg;
+  tWatched.slot = slot;
+  tSlot = slot.get();
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::Unwatch()
+{
+  tWatched.Reset();
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::Beat()
+{
+  auto *slot = tSlot;
+  if (nullptr == slot)
+    return;
+  slot->handler.store(nullptr, std::memory_order_relaxed);
+  slot->lastBeat.store(nowNs(), std::memory_order_release);
+  slot->busy.store(true, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::Idle()
+{
+  auto *slot = tSlot;
+  if (nullptr == slot)
+    return;
+  slot->busy.store(false, std::memory_order_release);
+  slot->lastBeat.store(nowNs(), std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::PushZone(const char *_name)
+{
+  auto *slot = tSlot;
+  if (nullptr == slot)
+    return;
+  const auto depth = slot->depth.load(std::memory_order_relaxed);
+  if (depth < kMaxZones)
+    slot->zones[depth].store(_name, std::memory_order_relaxed);
+  slot->depth.store(depth + 1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::PopZone()
+{
+  auto *slot = tSlot;
+  if (nullptr == slot)
+    return;
+  const auto depth = slot->depth.load(std::memory_order_relaxed);
+  if (depth > 0)
+    slot->depth.store(depth - 1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void StallWatchdog::SetHandler(const char *_name)
+{
+  if (auto *slot = tSlot)
+    slot->handler.store(_name, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+const char *StallWatchdog::Intern(const std::string &_name)
+{
+  // Never freed, interned names are used until the process exits
+  static auto *names = new std::unordered_set<std::string>();
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  return names->insert(_name).first->c_str();
+}
+}  // namespace gz::gui
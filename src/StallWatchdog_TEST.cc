@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <tinyxml2.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/StallWatchdog.hh"
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Stalls reported to the callback
+class Stalls
+{
+  /// \brief Constructor, starts receiving stalls
+  public: Stalls()
+  {
+    StallWatchdog::SetCallback([this](const StallWatchdog::Stall &_stall)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stalls.push_back(_stall);
+    });
+  }
+
+  /// \brief Destructor, stops receiving stalls
+  public: ~Stalls()
+  {
+    StallWatchdog::SetCallback(nullptr);
+  }
+
+  /// \brief Get the stalls received so far
+  /// \return Stalls
+  public: std::vector<StallWatchdog::Stall> Get()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stalls;
+  }
+
+  /// \brief Protects `stalls`
+  private: std::mutex mutex;
+
+  /// \brief Stalls received
+  private: std::vector<StallWatchdog::Stall> stalls;
+};
+
+/////////////////////////////////////////////////
+TEST(StallWatchdogTest, Stall)
+{
+  Stalls stalls;
+  StallWatchdog::Options options;
+  options.threshold = std::chrono::milliseconds(50);
+  StallWatchdog::Start(options);
+  EXPECT_TRUE(StallWatchdog::Running());
+
+  std::thread worker([]()
+  {
+    StallWatchdog::Watch("worker");
+
+    // Waiting for work isn't a stall
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    StallWatchdog::Beat();
+    static const char *kHandler = StallWatchdog::Intern("Handler");
+    StallWatchdog::SetHandler(kHandler);
+    {
+      GZ_GUI_PROFILE("StallWatchdogTest outer");
+      GZ_GUI_PROFILE("StallWatchdogTest inner");
+      std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    }
+    StallWatchdog::Idle();
+  });
+  worker.join();
+
+  // Unwatched threads aren't reported
+  {
+    GZ_GUI_PROFILE("StallWatchdogTest unwatched");
+    StallWatchdog::Beat();
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  }
+
+  StallWatchdog::Stop();
+  EXPECT_FALSE(StallWatchdog::Running());
+
+  // Reported once
+  auto received = stalls.Get();
+  ASSERT_EQ(1u, received.size());
+  EXPECT_EQ("worker", received[0].thread);
+  EXPECT_GE(received[0].duration, std::chrono::milliseconds(50));
+  EXPECT_EQ(std::vector<std::string>({"Handler",
+      "StallWatchdogTest outer", "StallWatchdogTest inner"}),
+      received[0].zones);
+  EXPECT_TRUE(received[0].stack.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(StallWatchdogTest, StackTrace)
+{
+#if defined(__linux__) && defined(__GLIBC__)
+  Stalls stalls;
+  StallWatchdog::Options options;
+  options.threshold = std::chrono::milliseconds(50);
+  options.stackTraces = true;
+  StallWatchdog::Start(options);
+
+  std::thread worker([]()
+  {
+    StallWatchdog::Watch("worker");
+    StallWatchdog::Beat();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    StallWatchdog::Unwatch();
+  });
+  worker.join();
+  StallWatchdog::Stop();
+
+  auto received = stalls.Get();
+  ASSERT_EQ(1u, received.size());
+  EXPECT_FALSE(received[0].stack.empty());
+#endif
+}
+
+/////////////////////////////////////////////////
+TEST(StallWatchdogTest, Load)
+{
+  tinyxml2::XMLDocument doc;
+  ASSERT_EQ(tinyxml2::XML_SUCCESS, doc.Parse(
+      "<watchdog><stack_trace>true</stack_trace>"
+      "<topic>/gui/stalls</topic></watchdog>"));
+  StallWatchdog::Options options;
+  EXPECT_TRUE(options.Load(doc.FirstChildElement("watchdog")));
+  EXPECT_EQ(std::chrono::milliseconds(1000), options.threshold);
+  EXPECT_TRUE(options.stackTraces);
+  EXPECT_EQ("/gui/stalls", options.topic);
+
+  ASSERT_EQ(tinyxml2::XML_SUCCESS, doc.Parse(
+      "<watchdog><threshold>250</threshold></watchdog>"));
+  EXPECT_TRUE(options.Load(doc.FirstChildElement("watchdog")));
+  EXPECT_EQ(std::chrono::milliseconds(250), options.threshold);
+
+  ASSERT_EQ(tinyxml2::XML_SUCCESS, doc.Parse(
+      "<watchdog><threshold>soon</threshold></watchdog>"));
+  EXPECT_FALSE(options.Load(doc.FirstChildElement("watchdog")));
+  EXPECT_EQ(std::chrono::milliseconds(1000), options.threshold);
+
+  // Zero stops watching
+  options.threshold = std::chrono::milliseconds(0);
+  StallWatchdog::Start(options);
+  EXPECT_FALSE(StallWatchdog::Running());
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/StartupTrace.hh"
+
+namespace
+{
+/// \brief A recorded phase or instant
+class TraceEvent
+{
+  /// \brief Event name
+  public: std::string name;
+
+  /// \brief Event category
+  public: std::string category;
+
+  /// \brief Start, in microseconds since the trace was created
+  public: int64_t start{0};
+
+  /// \brief Duration in microseconds, -1 for instants
+  public: int64_t duration{-1};
+
+  /// \brief Track of the recording thread
+  public: unsigned int track{0};
+};
+
+/////////////////////////////////////////////////
+/// \brief Write a string as a JSON string
+/// \param[in] _stream Stream to write to
+/// \param[in] _str String to write
+void WriteJsonString(std::ostream &_stream, const std::string &_str)
+{
+  _stream << '"';
+  for (const char c : _str)
+  {
+    switch (c)
+    {
+      case '"':
+        _stream << "\\\"";
+        break;
+      case '\\':
+        _stream << "\\\\";
+        break;
+      case '\n':
+        _stream << "\\n";
+        break;
+      case '\t':
+        _stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          _stream << escaped;
+        }
+        else
+        {
+          _stream << c;
+        }
+    }
+  }
+  _stream << '"';
+}
+}  // namespace
+
+namespace gz::gui
+{
+class StartupTrace::Implementation
+{
+  /// \brief Add an event
+  /// \param[in] _event Event, the track is set here
+  public: void Add(TraceEvent &&_event);
+
+  /// \brief Time origin of the events
+  public: const Clock::time_point origin{Clock::now()};
+
+  /// \brief Whether events are recorded
+  public: std::atomic<bool> enabled{false};
+
+  /// \brief Protects `events` and `tracks`
+  public: mutable std::mutex mutex;
+
+  /// \brief Recorded events, in recording order
+  public: std::vector<TraceEvent> events;
+
+  /// \brief Track of each thread which recorded events, the first one
+  /// is 0
+  public: std::map<std::thread::id, unsigned int> tracks;
+};
+
+class StartupTraceZone::Implementation
+{
+  /// \brief Trace to record to, null if it isn't enabled
+  public: StartupTrace *trace{nullptr};
+
+  /// \brief Phase name
+  public: std::string name;
+
+  /// \brief Phase category
+  public: std::string category;
+
+  /// \brief Start of the phase
+  public: StartupTrace::Clock::time_point start;
+};
+
+/////////////////////////////////////////////////
+void StartupTrace::Implementation::Add(TraceEvent &&_event)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto track = this->tracks.emplace(std::this_thread::get_id(),
+      static_cast<unsigned int>(this->tracks.size()));
+  _event.track = track.first->second;
+  this->events.push_back(std::move(_event));
+}
+
+/////////////////////////////////////////////////
+StartupTrace::StartupTrace()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+StartupTrace::~StartupTrace() = default;
+
+/////////////////////////////////////////////////
+void StartupTrace::SetEnabled(bool _enabled)
+{
+  this->dataPtr->enabled = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool StartupTrace::Enabled() const
+{
+  return this->dataPtr->enabled;
+}
+
+/////////////////////////////////////////////////
+void StartupTrace::Record(const std::string &_name,
+    const std::string &_category, Clock::time_point _start,
+    Clock::time_point _end)
+{
+  if (!this->dataPtr->enabled)
+    return;
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  TraceEvent event;
+  event.name = _name;
+  event.category = _category;
+  event.start =
+      duration_cast<microseconds>(_start - this->dataPtr->origin).count();
+  event.duration = std::max<int64_t>(0,
+      duration_cast<microseconds>(_end - _start).count());
+  this->dataPtr->Add(std::move(event));
+}
+
+/////////////////////////////////////////////////
+void StartupTrace::Mark(const std::string &_name,
+    const std::string &_category)
+{
+  if (!this->dataPtr->enabled)
+    return;
+
+  TraceEvent event;
+  event.name = _name;
+  event.category = _category;
+  event.start = std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - this->dataPtr->origin).count();
+  this->dataPtr->Add(std::move(event));
+}
+
+/////////////////////////////////////////////////
+std::size_t StartupTrace::EventCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->events.size();
+}
+
+/////////////////////////////////////////////////
+std::string StartupTrace::ChromeTrace() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  std::ostringstream stream;
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first{true};
+  for (const auto &event : this->dataPtr->events)
+  {
+    if (!first)
+      stream << ',';
+    first = false;
+
+    stream << "{\"name\":";
+    WriteJsonString(stream, event.name);
+    stream << ",\"cat\":";
+    WriteJsonString(stream, event.category);
+    if (event.duration < 0)
+      stream << ",\"ph\":\"i\",\"s\":\"t\"";
+    else
+      stream << ",\"ph\":\"X\",\"dur\":" << event.duration;
+    stream << ",\"ts\":" << event.start << ",\"pid\":1,\"tid\":"
+           << event.track << '}';
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+bool StartupTrace::Write(const std::string &_path) const
+{
+  std::ofstream stream(_path);
+  if (!stream.is_open())
+  {
+    gzerr << "Failed to write startup trace [" << _path << "]" << std::endl;
+    return false;
+  }
+  stream << this->ChromeTrace() << '\n';
+  return stream.good();
+}
+
+/////////////////////////////////////////////////
+StartupTraceZone::StartupTraceZone(StartupTrace *_trace,
+    const std::string &_name, const std::string &_category)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  if (nullptr == _trace || !_trace->Enabled())
+    return;
+
+  this->dataPtr->trace = _trace;
+  this->dataPtr->name = _name;
+  this->dataPtr->category = _category;
+  this->dataPtr->start = StartupTrace::Clock::now();
+}
+
+/////////////////////////////////////////////////
+StartupTraceZone::~StartupTraceZone()
+{
+  if (nullptr == this->dataPtr->trace)
+    return;
+
+  this->dataPtr->trace->Record(this->dataPtr->name, this->dataPtr->category,
+      this->dataPtr->start, StartupTrace::Clock::now());
+}
+}  // namespace gz::gui
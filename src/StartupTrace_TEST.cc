@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/StartupTrace.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(StartupTraceTest, Disabled)
+{
+  StartupTrace trace;
+  EXPECT_FALSE(trace.Enabled());
+
+  trace.Mark("ignored", "test");
+  {
+    StartupTraceZone zone(&trace, "ignored", "test");
+  }
+  StartupTraceZone nullZone(nullptr, "ignored", "test");
+  EXPECT_EQ(0u, trace.EventCount());
+  EXPECT_EQ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}",
+      trace.ChromeTrace());
+}
+
+/////////////////////////////////////////////////
+TEST(StartupTraceTest, Record)
+{
+  StartupTrace trace;
+  trace.SetEnabled(true);
+  EXPECT_TRUE(trace.Enabled());
+
+  const auto start = StartupTrace::Clock::now();
+  trace.Record("LoadPlugin [\"Quoted\"]", "plugin", start,
+      start + std::chrono::milliseconds(5));
+  trace.Mark("First frame", "window");
+  {
+    StartupTraceZone zone(&trace, "Zone", "test");
+  }
+
+  // Other threads get their own track
+  std::thread thread([&trace]()
+  {
+    trace.Mark("Worker", "test");
+  });
+  thread.join();
+  EXPECT_EQ(4u, trace.EventCount());
+
+  const auto json = trace.ChromeTrace();
+  EXPECT_NE(std::string::npos, json.find(
+      "{\"name\":\"LoadPlugin [\\\"Quoted\\\"]\",\"cat\":\"plugin\","
+      "\"ph\":\"X\",\"dur\":5000,\"ts\":"));
+  EXPECT_NE(std::string::npos, json.find(
+      "{\"name\":\"First frame\",\"cat\":\"window\",\"ph\":\"i\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Zone\""));
+  EXPECT_NE(std::string::npos, json.find("\"pid\":1,\"tid\":0}"));
+  EXPECT_NE(std::string::npos, json.find("\"pid\":1,\"tid\":1}"));
+
+  // Written as is
+  const auto path = (std::filesystem::temp_directory_path() /
+      "gz_gui_startup_trace_test.json").string();
+  ASSERT_TRUE(trace.Write(path));
+  std::ifstream stream(path);
+  std::stringstream contents;
+  contents << stream.rdbuf();
+  EXPECT_EQ(json + "\n", contents.str());
+  std::filesystem::remove(path);
+
+  EXPECT_FALSE(trace.Write("/nonexistent/dir/trace.json"));
+}
@@ -0,0 +1,1043 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/param.pb.h>
+#include <gz/transport/MessageInfo.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/SubscribeOptions.hh>
+
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/RetainedMessage.hh"
+#include "gz/gui/SharedMemory.hh"
+#include "gz/gui/SubscriptionHub.hh"
+
+namespace
+{
+/// \brief Callback subscribed to the transport node
+using TransportCallback = std::function<void(const char *, const size_t,
+    const gz::transport::MessageInfo &)>;
+
+/// \brief Seconds between feedback messages of a topic
+constexpr double kFeedbackPeriod{1.0};
+
+/// \brief Messages of one consumer since the last feedback. Counted while
+/// feedback is off too, and reset once it starts.
+class ConsumerStats
+{
+  /// \brief Messages passed to the consumer
+  public: std::atomic<uint64_t> delivered{0};
+
+  /// \brief Messages skipped for arriving faster than the consumer's rate
+  public: std::atomic<uint64_t> skipped{0};
+
+  /// \brief Messages the consumer reported it didn't use
+  public: std::atomic<uint64_t> dropped{0};
+};
+
+/// \brief Feedback publisher of a topic, replaced each time feedback is
+/// enabled so measuring starts over
+class FeedbackState
+{
+  /// \brief Publisher on the feedback topic
+  public: gz::transport::Node::Publisher publisher;
+
+  /// \brief Id of the hub, see HubState::consumerId
+  public: std::string consumerId;
+
+  /// \brief Start of the current period, protected by the topic's
+  /// `dispatchMutex`
+  public: std::chrono::steady_clock::time_point start;
+
+  /// \brief False until the first message starts the first period,
+  /// protected by the topic's `dispatchMutex`
+  public: bool started{false};
+};
+
+/// \brief Spaces out the messages of a consumer slower than its topic
+class Throttle
+{
+  /// \brief Whether a message is due, and if so schedule the next one
+  /// \param[in] _now Arrival time of the message
+  /// \param[in] _rate Messages per second the consumer gets
+  /// \return True to pass the message to the consumer
+  public: bool Due(std::chrono::steady_clock::time_point _now, double _rate)
+  {
+    if (_now < this->next)
+      return false;
+
+    // Keep the phase while messages keep coming, restart after a gap
+    const auto period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / _rate));
+    this->next += period;
+    if (this->next < _now)
+      this->next = _now + period;
+    return true;
+  }
+
+  /// \brief Most messages per second the consumer asked for
+  public: double maxRate{0.0};
+
+  /// \brief When the next message is due
+  public: std::chrono::steady_clock::time_point next;
+};
+
+/// \brief Consumers of one topic
+class TopicEntry
+{
+  /// \brief Held while calling the callbacks, so unsubscribing waits for
+  /// the call in progress. Recursive so callbacks can unsubscribe.
+  public: std::recursive_mutex dispatchMutex;
+
+  /// \brief Callbacks by subscription ID, protected by `dispatchMutex`
+  public: std::map<uint64_t,
+      std::shared_ptr<gz::gui::SubscriptionHub::Callback>> callbacks;
+
+  /// \brief Callbacks of serialized messages by subscription ID, protected
+  /// by `dispatchMutex`
+  public: std::map<uint64_t,
+      std::shared_ptr<gz::gui::SubscriptionHub::RawCallback>> rawCallbacks;
+
+  /// \brief Consumers slower than the topic, by subscription ID, protected
+  /// by `dispatchMutex`
+  public: std::map<uint64_t, Throttle> throttles;
+
+  /// \brief Messages of each consumer, by subscription ID, protected by
+  /// `dispatchMutex`
+  public: std::map<uint64_t, std::shared_ptr<ConsumerStats>> stats;
+
+  /// \brief Messages which arrived since the last feedback, protected by
+  /// `dispatchMutex`
+  public: uint64_t received{0};
+
+  /// \brief Whether feedback is published, protected by the hub's mutex
+  public: bool feedback{false};
+
+  /// \brief Feedback publisher, null while feedback is off. Only accessed
+  /// with std::atomic_load and std::atomic_store, since the hub's mutex
+  /// can't be taken while dispatching.
+  public: std::shared_ptr<FeedbackState> feedbackState;
+
+  /// \brief Number of subscriptions, protected by the hub's mutex. The
+  /// topic is unsubscribed when it drops to 0.
+  public: std::size_t refs{0};
+
+  /// \brief Most messages per second of each subscription, 0 for all,
+  /// protected by the hub's mutex
+  public: std::map<uint64_t, double> maxRates;
+
+  /// \brief Rate the topic is subscribed with, 0 for all messages.
+  /// Written with the hub's mutex held.
+  public: std::atomic<double> rate{0.0};
+
+  /// \brief Hub's rate cap, copied here for the transport threads.
+  /// Written with the hub's mutex held.
+  public: std::atomic<double> cap{0.0};
+
+  /// \brief Callback subscribed to the transport node
+  public: TransportCallback transportCb;
+
+  /// \brief Whether messages may come through shared memory, protected by
+  /// the hub's mutex
+  public: bool sharedMemory{false};
+
+  /// \brief True while messages come through shared memory, then only
+  /// their descriptors are subscribed. Written with the hub's mutex held.
+  public: std::atomic<bool> sharedMemoryActive{false};
+
+  /// \brief True once the shared memory couldn't be read, then the
+  /// descriptors are ignored. Written with the hub's mutex held.
+  public: std::atomic<bool> sharedMemoryFailed{false};
+
+  /// \brief Reads the messages in shared memory, protected by
+  /// `dispatchMutex`
+  public: gz::gui::SharedMemoryReader reader;
+
+  /// \brief Callback subscribed to the shared memory descriptors
+  public: TransportCallback descriptorCb;
+
+  /// \brief Measures the time spent parsing and in the callbacks.
+  /// Subscriptions don't know which plugin they belong to, so the time is
+  /// reported per topic.
+  public: std::unique_ptr<gz::gui::PerformanceCounter> counter;
+};
+
+/////////////////////////////////////////////////
+/// \brief Make an id telling this hub apart from those of other GUIs
+/// \return Random hexadecimal id
+std::string randomId()
+{
+  std::random_device device;
+  std::ostringstream id;
+  id << std::hex << device() << device();
+  return id.str();
+}
+
+/// \brief State of the hub, shared with the handles so they outlive it
+/// safely
+class HubState : public std::enable_shared_from_this<HubState>
+{
+  /// \brief Add a subscription
+  /// \param[in] _topic Topic name
+  /// \param[in] _cb Callback of parsed messages, may be null
+  /// \param[in] _rawCb Callback of serialized messages, may be null
+  /// \param[in] _maxRate Most messages per second, 0 for all
+  /// \param[out] _stats Messages of the new consumer
+  /// \return Subscription ID, 0 if the topic couldn't be subscribed to
+  public: uint64_t Subscribe(const std::string &_topic,
+      const gz::gui::SubscriptionHub::Callback &_cb,
+      const gz::gui::SubscriptionHub::RawCallback &_rawCb, double _maxRate,
+      std::shared_ptr<ConsumerStats> &_stats);
+
+  /// \brief Start or stop publishing the feedback of a topic. Must be
+  /// called with `mutex` locked.
+  /// \param[in] _topic Topic name
+  /// \param[in] _entry Consumers of the topic
+  /// \param[in] _enable True to publish feedback
+  public: void SetFeedback(const std::string &_topic, TopicEntry &_entry,
+      bool _enable);
+
+  /// \brief Publish the feedback of a topic if its period is over. Must be
+  /// called with the topic's `dispatchMutex` locked.
+  /// \param[in] _entry Consumers of the topic
+  /// \param[in] _feedback Feedback publisher of the topic
+  /// \param[in] _now Current time
+  public: static void PublishFeedback(TopicEntry &_entry,
+      FeedbackState &_feedback, std::chrono::steady_clock::time_point _now);
+
+  /// \brief Subscribe the transport node to a topic. Must be called with
+  /// `mutex` locked.
+  /// \param[in] _topic Topic name
+  /// \param[in] _entry Consumers of the topic
+  /// \return True if subscribed
+  public: bool SubscribeTransport(const std::string &_topic,
+      TopicEntry &_entry);
+
+  /// \brief Unsubscribe the transport node from a topic and its
+  /// descriptors. Must be called with `mutex` locked.
+  /// \param[in] _topic Topic name
+  /// \param[in] _entry Consumers of the topic
+  public: void UnsubscribeTransport(const std::string &_topic,
+      const TopicEntry &_entry);
+
+  /// \brief Switch a topic to or from shared memory
+  /// \param[in] _topic Topic name
+  /// \param[in] _entry Consumers of the topic
+  /// \param[in] _active True to receive it through shared memory
+  /// \param[in] _failed True if the shared memory couldn't be read, so
+  /// its descriptors are unsubscribed
+  public: void SetSharedMemoryActive(const std::string &_topic,
+      TopicEntry &_entry, bool _active, bool _failed);
+
+  /// \brief Subscribe the transport node again if the rate of the fastest
+  /// consumer changed. Must be called with `mutex` locked.
+  /// \param[in] _topic Topic name
+  /// \param[in] _entry Consumers of the topic
+  public: void UpdateRate(const std::string &_topic, TopicEntry &_entry);
+
+  /// \brief Remove a subscription
+  /// \param[in] _topic Topic name
+  /// \param[in] _id Subscription ID
+  public: void Unsubscribe(const std::string &_topic, uint64_t _id);
+
+  /// \brief Parse a message and pass it to the consumers of its topic
+  /// \param[in] _entry Consumers of the topic
+  /// \param[in] _data Serialized message
+  /// \param[in] _size Size of the serialized message
+  /// \param[in] _msgType Message type
+  /// \param[in] _topic Topic name
+  /// \param[in] _view If the message is in shared memory, its view, to
+  /// check it wasn't rewritten while it was parsed
+  public: static void Dispatch(const std::shared_ptr<TopicEntry> &_entry,
+      const char *_data, std::size_t _size, const std::string &_msgType,
+      const std::string &_topic,
+      const gz::gui::SharedMemoryView *_view = nullptr);
+
+  /// \brief Read the message described by a shared memory descriptor and
+  /// pass it to the consumers of its topic
+  /// \param[in] _hub Hub, which may be gone
+  /// \param[in] _topic Topic name
+  /// \param[in] _entry Consumers of the topic
+  /// \param[in] _data Serialized descriptor
+  /// \param[in] _size Size of the serialized descriptor
+  public: static void DispatchSharedMemory(const std::weak_ptr<HubState> &_hub,
+      const std::string &_topic, const std::shared_ptr<TopicEntry> &_entry,
+      const char *_data, std::size_t _size);
+
+  /// \brief Protects `topics` and `nextId`. Never held while calling
+  /// callbacks.
+  public: mutable std::mutex mutex;
+
+  /// \brief Node holding one subscription per topic
+  public: gz::transport::Node node;
+
+  /// \brief Consumers of each subscribed topic
+  public: std::map<std::string, std::shared_ptr<TopicEntry>> topics;
+
+  /// \brief Next subscription ID
+  public: uint64_t nextId{1};
+
+  /// \brief Most messages per second of rate limited consumers, 0 for no
+  /// cap, protected by `mutex`
+  public: double cap{0.0};
+
+  /// \brief Topics which may be received through shared memory, protected
+  /// by `mutex`
+  public: std::set<std::string> sharedMemoryTopics;
+
+  /// \brief Topics whose feedback is published, protected by `mutex`
+  public: std::set<std::string> feedbackTopics;
+
+  /// \brief Id of the hub in feedback messages
+  public: std::string consumerId{randomId()};
+};
+
+/////////////////////////////////////////////////
+/// \brief Set a param of a feedback msg
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \param[in] _value Value
+void setParam(gz::msgs::Param &_msg, const std::string &_key, double _value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(gz::msgs::Any_ValueType_DOUBLE);
+  any.set_double_value(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the rate a consumer gets messages at
+/// \param[in] _maxRate Rate the consumer asked for, 0 for all
+/// \param[in] _cap Hub's rate cap, 0 for none
+/// \return Messages per second, 0 for all. Consumers which asked for all
+/// messages aren't capped, since they may be counting or recording them.
+double cappedRate(double _maxRate, double _cap)
+{
+  if (_maxRate <= 0.0 || _cap <= 0.0)
+    return _maxRate;
+  return std::min(_maxRate, _cap);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the rate of the fastest consumer of a topic
+/// \param[in] _entry Consumers of the topic
+/// \return Messages per second, 0 if a consumer needs all of them
+double fastestRate(const TopicEntry &_entry)
+{
+  double rate{0.0};
+  for (const auto &consumer : _entry.maxRates)
+  {
+    const double consumerRate = cappedRate(consumer.second, _entry.cap);
+    if (consumerRate <= 0.0)
+      return 0.0;
+    rate = std::max(rate, consumerRate);
+  }
+  return rate;
+}
+
+/////////////////////////////////////////////////
+uint64_t HubState::Subscribe(const std::string &_topic,
+    const gz::gui::SubscriptionHub::Callback &_cb,
+    const gz::gui::SubscriptionHub::RawCallback &_rawCb, double _maxRate,
+    std::shared_ptr<ConsumerStats> &_stats)
+{
+  _maxRate = std::isfinite(_maxRate) ? std::max(0.0, _maxRate) : 0.0;
+
+  std::shared_ptr<TopicEntry> entry;
+  uint64_t id{0};
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    id = this->nextId++;
+    auto it = this->topics.find(_topic);
+    if (it == this->topics.end())
+    {
+      entry = std::make_shared<TopicEntry>();
+      entry->counter =
+          std::make_unique<gz::gui::PerformanceCounter>("Transport", _topic);
+      std::weak_ptr<TopicEntry> weakEntry = entry;
+      entry->transportCb =
+          [weakEntry](const char *_data, const size_t _size,
+              const gz::transport::MessageInfo &_info)
+          {
+            // Messages still arriving after switching to shared memory
+            // were already received through it
+            auto topicEntry = weakEntry.lock();
+            if (topicEntry && !topicEntry->sharedMemoryActive)
+            {
+              HubState::Dispatch(topicEntry, _data, _size, _info.Type(),
+                  _info.Topic());
+            }
+          };
+      std::weak_ptr<HubState> weakHub = this->shared_from_this();
+      entry->descriptorCb =
+          [weakHub, weakEntry, _topic](const char *_data, const size_t _size,
+              const gz::transport::MessageInfo &)
+          {
+            auto topicEntry = weakEntry.lock();
+            if (topicEntry)
+            {
+              HubState::DispatchSharedMemory(weakHub, _topic, topicEntry,
+                  _data, _size);
+            }
+          };
+      entry->sharedMemory = this->sharedMemoryTopics.count(_topic) > 0;
+      entry->maxRates[id] = _maxRate;
+      entry->cap = this->cap;
+      entry->rate = cappedRate(_maxRate, this->cap);
+      if (!this->SubscribeTransport(_topic, *entry))
+      {
+        gzerr << "Failed to subscribe to topic [" << _topic << "]"
+              << std::endl;
+        return 0;
+      }
+      this->topics[_topic] = entry;
+      if (this->feedbackTopics.count(_topic) > 0)
+        this->SetFeedback(_topic, *entry, true);
+    }
+    else
+    {
+      entry = it->second;
+      entry->maxRates[id] = _maxRate;
+      this->UpdateRate(_topic, *entry);
+    }
+    ++entry->refs;
+  }
+
+  // The reference keeps the entry subscribed until the callback is added
+  std::lock_guard<std::recursive_mutex> lock(entry->dispatchMutex);
+  _stats = std::make_shared<ConsumerStats>();
+  entry->stats[id] = _stats;
+  if (_maxRate > 0.0)
+  {
+    Throttle throttle;
+    throttle.maxRate = _maxRate;
+    entry->throttles[id] = throttle;
+  }
+  if (_cb)
+  {
+    entry->callbacks[id] =
+        std::make_shared<gz::gui::SubscriptionHub::Callback>(_cb);
+  }
+  else
+  {
+    entry->rawCallbacks[id] =
+        std::make_shared<gz::gui::SubscriptionHub::RawCallback>(_rawCb);
+  }
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool HubState::SubscribeTransport(const std::string &_topic,
+    TopicEntry &_entry)
+{
+  // Transport only takes whole rates, rounded up so no consumer misses
+  // messages. Slower consumers are throttled by the hub.
+  gz::transport::SubscribeOptions opts;
+  if (_entry.rate > 0.0)
+  {
+    opts.SetMsgsPerSec(static_cast<uint64_t>(std::ceil(_entry.rate)));
+  }
+
+  // Descriptors come at the same rate as the messages they describe
+  bool result{true};
+  if (_entry.sharedMemory && !_entry.sharedMemoryFailed)
+  {
+    result = this->node.SubscribeRaw(gz::gui::SharedMemoryTopic(_topic),
+        _entry.descriptorCb, "gz.msgs.Header", opts);
+  }
+  if (!_entry.sharedMemoryActive)
+  {
+    result = this->node.SubscribeRaw(_topic, _entry.transportCb,
+        gz::transport::kGenericMessageType, opts);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+void HubState::UnsubscribeTransport(const std::string &_topic,
+    const TopicEntry &_entry)
+{
+  if (!_entry.sharedMemoryActive)
+    this->node.Unsubscribe(_topic);
+  if (_entry.sharedMemory && !_entry.sharedMemoryFailed)
+    this->node.Unsubscribe(gz::gui::SharedMemoryTopic(_topic));
+}
+
+/////////////////////////////////////////////////
+void HubState::SetSharedMemoryActive(const std::string &_topic,
+    TopicEntry &_entry, bool _active, bool _failed)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto it = this->topics.find(_topic);
+  if (it == this->topics.end() || it->second.get() != &_entry ||
+      !_entry.sharedMemory)
+  {
+    return;
+  }
+
+  if (_failed && !_entry.sharedMemoryActive)
+  {
+    this->node.Unsubscribe(gz::gui::SharedMemoryTopic(_topic));
+    _entry.sharedMemoryFailed = true;
+    return;
+  }
+  if (_entry.sharedMemoryActive == _active)
+    return;
+
+  this->UnsubscribeTransport(_topic, _entry);
+  _entry.sharedMemoryActive = _active;
+  _entry.sharedMemoryFailed = _failed;
+  if (!this->SubscribeTransport(_topic, _entry))
+  {
+    gzerr << "Failed to subscribe to topic [" << _topic << "]" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void HubState::SetFeedback(const std::string &_topic, TopicEntry &_entry,
+    bool _enable)
+{
+  _entry.feedback = _enable;
+  std::shared_ptr<FeedbackState> feedback;
+  if (_enable)
+  {
+    feedback = std::make_shared<FeedbackState>();
+    feedback->publisher = this->node.Advertise<gz::msgs::Param>(
+        gz::gui::FeedbackTopic(_topic));
+    feedback->consumerId = this->consumerId;
+    if (!feedback->publisher)
+    {
+      gzerr << "Failed to advertise feedback of topic [" << _topic << "]"
+            << std::endl;
+      return;
+    }
+  }
+  std::atomic_store(&_entry.feedbackState, feedback);
+}
+
+/////////////////////////////////////////////////
+void HubState::PublishFeedback(TopicEntry &_entry, FeedbackState &_feedback,
+    std::chrono::steady_clock::time_point _now)
+{
+  // What was counted before feedback started isn't part of any period
+  if (!_feedback.started)
+  {
+    _feedback.started = true;
+    _feedback.start = _now;
+    _entry.received = 0;
+    for (auto &[id, stats] : _entry.stats)
+    {
+      stats->delivered = 0;
+      stats->skipped = 0;
+      stats->dropped = 0;
+    }
+    return;
+  }
+
+  const double period =
+      std::chrono::duration<double>(_now - _feedback.start).count();
+  if (period < kFeedbackPeriod)
+    return;
+
+  uint64_t skipped{0};
+  uint64_t dropped{0};
+  double consumedRate{0.0};
+  for (auto &[id, stats] : _entry.stats)
+  {
+    const uint64_t consumerDelivered = stats->delivered.exchange(0);
+    const uint64_t consumerDropped = stats->dropped.exchange(0);
+    skipped += stats->skipped.exchange(0);
+    dropped += consumerDropped;
+    const uint64_t used = consumerDelivered -
+        std::min(consumerDelivered, consumerDropped);
+    consumedRate = std::max(consumedRate, used / period);
+  }
+
+  gz::msgs::Param msg;
+  auto &any = (*msg.mutable_params())["consumer"];
+  any.set_type(gz::msgs::Any_ValueType_STRING);
+  any.set_string_value(_feedback.consumerId);
+  setParam(msg, "period", period);
+  setParam(msg, "requested_rate", _entry.rate);
+  setParam(msg, "received_rate", _entry.received / period);
+  setParam(msg, "consumed_rate", consumedRate);
+  setParam(msg, "skipped", static_cast<double>(skipped));
+  setParam(msg, "dropped", static_cast<double>(dropped));
+  setParam(msg, "consumers", static_cast<double>(_entry.stats.size()));
+  _feedback.publisher.Publish(msg);
+
+  _entry.received = 0;
+  _feedback.start = _now;
+}
+
+/////////////////////////////////////////////////
+void HubState::UpdateRate(const std::string &_topic, TopicEntry &_entry)
+{
+  const double rate = fastestRate(_entry);
+  if (rate == _entry.rate)
+    return;
+
+  _entry.rate = rate;
+  this->UnsubscribeTransport(_topic, _entry);
+  if (!this->SubscribeTransport(_topic, _entry))
+  {
+    gzerr << "Failed to subscribe to topic [" << _topic << "] at "
+          << rate << " msgs/s" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void HubState::Unsubscribe(const std::string &_topic, uint64_t _id)
+{
+  std::shared_ptr<TopicEntry> entry;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->topics.find(_topic);
+    if (it == this->topics.end())
+      return;
+    entry = it->second;
+  }
+
+  // Waits for a dispatch in progress
+  {
+    std::lock_guard<std::recursive_mutex> lock(entry->dispatchMutex);
+    if (entry->callbacks.erase(_id) == 0 &&
+        entry->rawCallbacks.erase(_id) == 0)
+    {
+      return;
+    }
+    entry->throttles.erase(_id);
+    entry->stats.erase(_id);
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  entry->maxRates.erase(_id);
+  if (--entry->refs == 0)
+  {
+    this->UnsubscribeTransport(_topic, *entry);
+    std::atomic_store(&entry->feedbackState,
+        std::shared_ptr<FeedbackState>());
+    this->topics.erase(_topic);
+  }
+  else
+  {
+    // The fastest consumer may be gone
+    this->UpdateRate(_topic, *entry);
+  }
+}
+
+/////////////////////////////////////////////////
+void HubState::Dispatch(const std::shared_ptr<TopicEntry> &_entry,
+    const char *_data, std::size_t _size, const std::string &_msgType,
+    const std::string &_topic, const gz::gui::SharedMemoryView *_view)
+{
+  std::lock_guard<std::recursive_mutex> lock(_entry->dispatchMutex);
+  gz::gui::PerformanceTimer timer(*_entry->counter);
+
+  // Consumers as fast as the topic get every message transport delivers,
+  // slower ones only once their period has passed
+  const auto now = std::chrono::steady_clock::now();
+  const double rate = _entry->rate;
+  const double cap = _entry->cap;
+  auto throttled = [&](uint64_t _id)
+  {
+    auto throttle = _entry->throttles.find(_id);
+    if (throttle == _entry->throttles.end())
+      return false;
+    const double consumerRate = cappedRate(throttle->second.maxRate, cap);
+    if (consumerRate <= 0.0 ||
+        (rate > 0.0 && consumerRate >= std::ceil(rate)))
+    {
+      return false;
+    }
+    return !throttle->second.Due(now, consumerRate);
+  };
+  auto due = [&](uint64_t _id)
+  {
+    const bool skip = throttled(_id);
+    auto stats = _entry->stats.find(_id);
+    if (stats != _entry->stats.end())
+      ++(skip ? stats->second->skipped : stats->second->delivered);
+    return !skip;
+  };
+
+  // Feedback covers the messages up to this one
+  if (auto feedback = std::atomic_load(&_entry->feedbackState))
+    HubState::PublishFeedback(*_entry, *feedback, now);
+  ++_entry->received;
+
+  // Copied so callbacks can unsubscribe
+  std::vector<std::shared_ptr<gz::gui::SubscriptionHub::RawCallback>>
+      rawCallbacks;
+  rawCallbacks.reserve(_entry->rawCallbacks.size());
+  for (const auto &callback : _entry->rawCallbacks)
+  {
+    if (due(callback.first))
+      rawCallbacks.push_back(callback.second);
+  }
+
+  std::vector<std::shared_ptr<gz::gui::SubscriptionHub::Callback>> callbacks;
+  callbacks.reserve(_entry->callbacks.size());
+  for (const auto &callback : _entry->callbacks)
+  {
+    if (due(callback.first))
+      callbacks.push_back(callback.second);
+  }
+
+  // Messages in shared memory may be rewritten at any time. Consumers of
+  // serialized messages get a copy, parsed messages are checked once
+  // they're parsed.
+  std::vector<char> copy;
+  if (nullptr != _view && !rawCallbacks.empty())
+  {
+    copy.assign(_data, _data + _size);
+    if (!gz::gui::SharedMemoryReader::Unchanged(*_view))
+      return;
+    _data = copy.data();
+    _view = nullptr;
+  }
+
+  for (const auto &callback : rawCallbacks)
+    (*callback)(_data, _size, _msgType);
+
+  // Parsed once for all consumers, and only if one needs it. Consumers
+  // may keep the message for a while, and large ones such as scenes have
+  // many sub-messages, so it's parsed into an arena.
+  if (callbacks.empty())
+    return;
+
+  auto msg = gz::gui::NewArenaMessage(_msgType);
+  if (!msg)
+  {
+    gzerr << "Unable to create message of type [" << _msgType
+          << "] received on topic [" << _topic << "]" << std::endl;
+    return;
+  }
+  const bool parsed = msg->ParseFromArray(_data, static_cast<int>(_size));
+  if (nullptr != _view && !gz::gui::SharedMemoryReader::Unchanged(*_view))
+    return;
+  if (!parsed)
+  {
+    gzerr << "Failed to parse message of type [" << _msgType
+          << "] received on topic [" << _topic << "]" << std::endl;
+    return;
+  }
+  std::shared_ptr<const google::protobuf::Message> constMsg = msg;
+
+  for (const auto &callback : callbacks)
+    (*callback)(constMsg);
+}
+
+/////////////////////////////////////////////////
+void HubState::DispatchSharedMemory(const std::weak_ptr<HubState> &_hub,
+    const std::string &_topic, const std::shared_ptr<TopicEntry> &_entry,
+    const char *_data, std::size_t _size)
+{
+  if (_entry->sharedMemoryFailed)
+    return;
+
+  gz::msgs::Header descriptor;
+  if (!descriptor.ParseFromArray(_data, static_cast<int>(_size)))
+    return;
+
+  std::lock_guard<std::recursive_mutex> lock(_entry->dispatchMutex);
+  gz::gui::SharedMemoryView view;
+  const auto result = _entry->reader.Read(descriptor, view);
+
+  // The publisher is more than a ring ahead, the message is lost
+  if (result == gz::gui::SharedMemoryReader::Result::STALE)
+    return;
+
+  auto hub = _hub.lock();
+  if (!hub)
+    return;
+
+  if (result == gz::gui::SharedMemoryReader::Result::UNAVAILABLE)
+  {
+    gzmsg << "Shared memory of topic [" << _topic << "] can't be read, "
+          << "receiving it through transport" << std::endl;
+    hub->SetSharedMemoryActive(_topic, *_entry, false, true);
+    return;
+  }
+
+  if (!_entry->sharedMemoryActive)
+  {
+    gzmsg << "Receiving topic [" << _topic << "] through shared memory"
+          << std::endl;
+    hub->SetSharedMemoryActive(_topic, *_entry, true, false);
+  }
+  HubState::Dispatch(_entry, view.data, view.size, view.type, _topic, &view);
+}
+}  // namespace
+
+namespace gz::gui
+{
+/////////////////////////////////////////////////
+std::string FeedbackTopic(const std::string &_topic)
+{
+  return _topic + "/feedback";
+}
+
+class HubSubscription::Implementation
+{
+  /// \brief Hub of the subscription, which may be gone
+  public: std::weak_ptr<HubState> hub;
+
+  /// \brief Subscribed topic
+  public: std::string topic;
+
+  /// \brief Subscription ID, 0 if empty
+  public: uint64_t id{0};
+
+  /// \brief Messages of the consumer, null if empty
+  public: std::shared_ptr<ConsumerStats> stats;
+};
+
+class SubscriptionHub::Implementation
+{
+  /// \brief State shared with the handles
+  public: std::shared_ptr<HubState> state{std::make_shared<HubState>()};
+};
+
+/////////////////////////////////////////////////
+HubSubscription::HubSubscription()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+HubSubscription::HubSubscription(HubSubscription &&_other) noexcept
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  std::swap(*this->dataPtr, *_other.dataPtr);
+}
+
+/////////////////////////////////////////////////
+HubSubscription &HubSubscription::operator=(HubSubscription &&_other) noexcept
+{
+  if (this != &_other)
+  {
+    this->Reset();
+    std::swap(*this->dataPtr, *_other.dataPtr);
+  }
+  return *this;
+}
+
+/////////////////////////////////////////////////
+HubSubscription::~HubSubscription()
+{
+  this->Reset();
+}
+
+/////////////////////////////////////////////////
+void HubSubscription::Reset()
+{
+  if (this->dataPtr->id == 0)
+    return;
+
+  auto hub = this->dataPtr->hub.lock();
+  if (hub)
+    hub->Unsubscribe(this->dataPtr->topic, this->dataPtr->id);
+
+  this->dataPtr->hub.reset();
+  this->dataPtr->topic.clear();
+  this->dataPtr->id = 0;
+  this->dataPtr->stats.reset();
+}
+
+/////////////////////////////////////////////////
+bool HubSubscription::Valid() const
+{
+  return this->dataPtr->id != 0 && !this->dataPtr->hub.expired();
+}
+
+/////////////////////////////////////////////////
+std::string HubSubscription::Topic() const
+{
+  return this->dataPtr->topic;
+}
+
+/////////////////////////////////////////////////
+void HubSubscription::ReportDropped(std::size_t _count) const
+{
+  if (this->dataPtr->stats)
+    this->dataPtr->stats->dropped += _count;
+}
+
+/////////////////////////////////////////////////
+SubscriptionHub::SubscriptionHub()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+SubscriptionHub::~SubscriptionHub() = default;
+
+/////////////////////////////////////////////////
+HubSubscription SubscriptionHub::Subscribe(const std::string &_topic,
+    const Callback &_cb, double _maxRate)
+{
+  HubSubscription subscription;
+  if (!_cb)
+    return subscription;
+
+  std::shared_ptr<ConsumerStats> stats;
+  auto id = this->dataPtr->state->Subscribe(_topic, _cb, nullptr, _maxRate,
+      stats);
+  if (id == 0)
+    return subscription;
+
+  subscription.dataPtr->hub = this->dataPtr->state;
+  subscription.dataPtr->topic = _topic;
+  subscription.dataPtr->id = id;
+  subscription.dataPtr->stats = stats;
+  return subscription;
+}
+
+/////////////////////////////////////////////////
+HubSubscription SubscriptionHub::SubscribeRaw(const std::string &_topic,
+    const RawCallback &_cb, double _maxRate)
+{
+  HubSubscription subscription;
+  if (!_cb)
+    return subscription;
+
+  std::shared_ptr<ConsumerStats> stats;
+  auto id = this->dataPtr->state->Subscribe(_topic, nullptr, _cb, _maxRate,
+      stats);
+  if (id == 0)
+    return subscription;
+
+  subscription.dataPtr->hub = this->dataPtr->state;
+  subscription.dataPtr->topic = _topic;
+  subscription.dataPtr->id = id;
+  subscription.dataPtr->stats = stats;
+  return subscription;
+}
+
+/////////////////////////////////////////////////
+std::size_t SubscriptionHub::SubscriberCount(const std::string &_topic) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+  auto it = this->dataPtr->state->topics.find(_topic);
+  if (it == this->dataPtr->state->topics.end())
+    return 0;
+  return it->second->refs;
+}
+
+/////////////////////////////////////////////////
+double SubscriptionHub::SubscribedRate(const std::string &_topic) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+  auto it = this->dataPtr->state->topics.find(_topic);
+  if (it == this->dataPtr->state->topics.end())
+    return 0.0;
+  return it->second->rate;
+}
+
+/////////////////////////////////////////////////
+void SubscriptionHub::SetRateCap(double _rate)
+{
+  auto &state = *this->dataPtr->state;
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.cap = std::isfinite(_rate) ? std::max(0.0, _rate) : 0.0;
+  for (auto &[topic, entry] : state.topics)
+  {
+    entry->cap = state.cap;
+    state.UpdateRate(topic, *entry);
+  }
+}
+
+/////////////////////////////////////////////////
+void SubscriptionHub::SetSharedMemory(const std::string &_topic,
+    bool _enable)
+{
+  auto &state = *this->dataPtr->state;
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (_enable)
+    state.sharedMemoryTopics.insert(_topic);
+  else
+    state.sharedMemoryTopics.erase(_topic);
+
+  auto it = state.topics.find(_topic);
+  if (it == state.topics.end() || it->second->sharedMemory == _enable)
+    return;
+
+  auto &entry = *it->second;
+  state.UnsubscribeTransport(_topic, entry);
+  entry.sharedMemory = _enable;
+  entry.sharedMemoryActive = false;
+  entry.sharedMemoryFailed = false;
+  if (!state.SubscribeTransport(_topic, entry))
+    gzerr << "Failed to subscribe to topic [" << _topic << "]" << std::endl;
+}
+
+/////////////////////////////////////////////////
+bool SubscriptionHub::SharedMemoryActive(const std::string &_topic) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+  auto it = this->dataPtr->state->topics.find(_topic);
+  return it != this->dataPtr->state->topics.end() &&
+      it->second->sharedMemoryActive;
+}
+
+/////////////////////////////////////////////////
+void SubscriptionHub::SetFeedback(const std::string &_topic, bool _enable)
+{
+  auto &state = *this->dataPtr->state;
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (_enable)
+    state.feedbackTopics.insert(_topic);
+  else
+    state.feedbackTopics.erase(_topic);
+
+  auto it = state.topics.find(_topic);
+  if (it != state.topics.end() && it->second->feedback != _enable)
+    state.SetFeedback(_topic, *it->second, _enable);
+}
+
+/////////////////////////////////////////////////
+bool SubscriptionHub::Feedback(const std::string &_topic) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+  return this->dataPtr->state->feedbackTopics.count(_topic) > 0;
+}
+
+/////////////////////////////////////////////////
+double SubscriptionHub::RateCap() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->state->mutex);
+  return this->dataPtr->state->cap;
+}
+}  // namespace gz::gui
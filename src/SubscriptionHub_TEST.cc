@@ -0,0 +1,559 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/int32.pb.h>
+#include <gz/msgs/param.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/SharedMemory.hh"
+#include "gz/gui/SubscriptionHub.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./SubscriptionHub_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Wait until a condition is true, up to 3 s
+/// \param[in] _condition Condition to wait for
+/// \return True if the condition became true
+bool waitFor(const std::function<bool()> &_condition)
+{
+  for (int sleep = 0; sleep < 30 && !_condition(); ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  return _condition();
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Subscribe))
+{
+  SubscriptionHub hub;
+  EXPECT_EQ(0u, hub.SubscriberCount("/hub_int"));
+
+  // Both consumers receive the same message
+  std::mutex mutex;
+  std::shared_ptr<const google::protobuf::Message> first;
+  std::shared_ptr<const google::protobuf::Message> second;
+  auto subFirst = hub.Subscribe("/hub_int",
+      [&](const std::shared_ptr<const google::protobuf::Message> &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        first = _msg;
+      });
+  auto subSecond = hub.Subscribe("/hub_int",
+      [&](const std::shared_ptr<const google::protobuf::Message> &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        second = _msg;
+      });
+
+  std::atomic<int> typedData{-1};
+  auto subTyped = hub.Subscribe<msgs::Int32>("/hub_int",
+      std::function<void(const msgs::Int32 &)>(
+      [&](const msgs::Int32 &_msg){typedData = _msg.data();}));
+
+  ASSERT_TRUE(subFirst.Valid());
+  ASSERT_TRUE(subSecond.Valid());
+  ASSERT_TRUE(subTyped.Valid());
+  EXPECT_EQ("/hub_int", subFirst.Topic());
+  EXPECT_EQ(3u, hub.SubscriberCount("/hub_int"));
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>("/hub_int");
+  msgs::Int32 msg;
+  msg.set_data(5);
+
+  EXPECT_TRUE(waitFor([&]()
+  {
+    pub.Publish(msg);
+    std::lock_guard<std::mutex> lock(mutex);
+    return first && second && typedData == 5;
+  }));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(first.get(), second.get());
+    const auto *intMsg = dynamic_cast<const msgs::Int32 *>(first.get());
+    ASSERT_NE(nullptr, intMsg);
+    EXPECT_EQ(5, intMsg->data());
+  }
+
+  // Moved handles keep the subscription
+  HubSubscription moved = std::move(subSecond);
+  EXPECT_FALSE(subSecond.Valid());
+  EXPECT_TRUE(moved.Valid());
+  EXPECT_EQ(3u, hub.SubscriberCount("/hub_int"));
+
+  // Resetting ends it
+  subFirst.Reset();
+  EXPECT_FALSE(subFirst.Valid());
+  EXPECT_EQ(2u, hub.SubscriberCount("/hub_int"));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    first.reset();
+  }
+  msg.set_data(6);
+  EXPECT_TRUE(waitFor([&]()
+  {
+    pub.Publish(msg);
+    return typedData == 6;
+  }));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(nullptr, first);
+  }
+
+  moved.Reset();
+  subTyped.Reset();
+  EXPECT_EQ(0u, hub.SubscriberCount("/hub_int"));
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TypeMismatch))
+{
+  SubscriptionHub hub;
+
+  std::atomic<int> received{0};
+  auto sub = hub.Subscribe<msgs::Int32>("/hub_string",
+      std::function<void(const msgs::Int32 &)>(
+      [&](const msgs::Int32 &){++received;}));
+  std::atomic<int> any{0};
+  auto subAny = hub.Subscribe("/hub_string",
+      [&](const std::shared_ptr<const google::protobuf::Message> &){++any;});
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/hub_string");
+  msgs::StringMsg msg;
+  msg.set_data("banana");
+
+  EXPECT_TRUE(waitFor([&]()
+  {
+    pub.Publish(msg);
+    return any > 0;
+  }));
+  EXPECT_EQ(0, received);
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SubscribeRaw))
+{
+  SubscriptionHub hub;
+
+  std::mutex mutex;
+  std::string data;
+  std::string msgType;
+  auto sub = hub.SubscribeRaw("/hub_raw",
+      [&](const char *_data, std::size_t _size, const std::string &_msgType)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        data.assign(_data, _size);
+        msgType = _msgType;
+      });
+  ASSERT_TRUE(sub.Valid());
+  EXPECT_EQ(1u, hub.SubscriberCount("/hub_raw"));
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>("/hub_raw");
+  msgs::Int32 msg;
+  msg.set_data(7);
+
+  EXPECT_TRUE(waitFor([&]()
+  {
+    pub.Publish(msg);
+    std::lock_guard<std::mutex> lock(mutex);
+    return !data.empty();
+  }));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ("gz.msgs.Int32", msgType);
+    msgs::Int32 received;
+    ASSERT_TRUE(received.ParseFromString(data));
+    EXPECT_EQ(7, received.data());
+  }
+
+  // raw and parsed consumers share the topic
+  std::atomic<int> parsed{-1};
+  auto subParsed = hub.Subscribe<msgs::Int32>("/hub_raw",
+      std::function<void(const msgs::Int32 &)>(
+      [&](const msgs::Int32 &_msg){parsed = _msg.data();}));
+  EXPECT_EQ(2u, hub.SubscriberCount("/hub_raw"));
+  EXPECT_TRUE(waitFor([&]()
+  {
+    pub.Publish(msg);
+    return parsed == 7;
+  }));
+
+  sub.Reset();
+  subParsed.Reset();
+  EXPECT_EQ(0u, hub.SubscriberCount("/hub_raw"));
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(MaxRate))
+{
+  SubscriptionHub hub;
+  std::atomic<int> all{0};
+  std::atomic<int> slow{0};
+  std::atomic<int> raw{0};
+  auto subSlow = hub.Subscribe("/hub_rate",
+      [&](const std::shared_ptr<const google::protobuf::Message> &)
+      {
+        ++slow;
+      }, 5.0);
+  ASSERT_TRUE(subSlow.Valid());
+  EXPECT_DOUBLE_EQ(5.0, hub.SubscribedRate("/hub_rate"));
+
+  // The fastest consumer sets the rate, and unlimited ones lift it
+  auto subRaw = hub.SubscribeRaw("/hub_rate",
+      [&](const char *, std::size_t, const std::string &)
+      {
+        ++raw;
+      }, 20.0);
+  EXPECT_DOUBLE_EQ(20.0, hub.SubscribedRate("/hub_rate"));
+  auto subAll = hub.Subscribe("/hub_rate",
+      [&](const std::shared_ptr<const google::protobuf::Message> &)
+      {
+        ++all;
+      });
+  EXPECT_DOUBLE_EQ(0.0, hub.SubscribedRate("/hub_rate"));
+
+  // Publish at 100 Hz for a second
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>("/hub_rate");
+  ASSERT_TRUE(waitFor([&]()
+  {
+    msgs::Int32 msg;
+    pub.Publish(msg);
+    return all > 0;
+  }));
+  all = 0;
+  slow = 0;
+  raw = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+  {
+    msgs::Int32 msg;
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  EXPECT_GT(all, 50);
+  EXPECT_GE(slow, 3);
+  EXPECT_LE(slow, 7);
+  EXPECT_GE(raw, 15);
+  EXPECT_LE(raw, 22);
+
+  // Back to the slowest rate once the others are gone
+  subAll.Reset();
+  EXPECT_DOUBLE_EQ(20.0, hub.SubscribedRate("/hub_rate"));
+  subRaw.Reset();
+  EXPECT_DOUBLE_EQ(5.0, hub.SubscribedRate("/hub_rate"));
+  subSlow.Reset();
+  EXPECT_DOUBLE_EQ(0.0, hub.SubscribedRate("/hub_rate"));
+  EXPECT_EQ(0u, hub.SubscriberCount("/hub_rate"));
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RateCap))
+{
+  SubscriptionHub hub;
+  std::atomic<int> fast{0};
+  auto subFast = hub.Subscribe("/hub_cap",
+      [&](const std::shared_ptr<const google::protobuf::Message> &)
+      {
+        ++fast;
+      }, 50.0);
+  ASSERT_TRUE(subFast.Valid());
+  EXPECT_DOUBLE_EQ(0.0, hub.RateCap());
+
+  // Rate limited consumers are capped, including those subscribing later
+  hub.SetRateCap(2.0);
+  EXPECT_DOUBLE_EQ(2.0, hub.RateCap());
+  EXPECT_DOUBLE_EQ(2.0, hub.SubscribedRate("/hub_cap"));
+  auto subSlow = hub.SubscribeRaw("/hub_cap",
+      [](const char *, std::size_t, const std::string &){}, 1.0);
+  EXPECT_DOUBLE_EQ(2.0, hub.SubscribedRate("/hub_cap"));
+
+  // Consumers of all messages aren't
+  auto subAll = hub.SubscribeRaw("/hub_cap",
+      [](const char *, std::size_t, const std::string &){});
+  EXPECT_DOUBLE_EQ(0.0, hub.SubscribedRate("/hub_cap"));
+  subAll.Reset();
+  EXPECT_DOUBLE_EQ(2.0, hub.SubscribedRate("/hub_cap"));
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>("/hub_cap");
+  ASSERT_TRUE(waitFor([&]()
+  {
+    msgs::Int32 msg;
+    pub.Publish(msg);
+    return fast > 0;
+  }));
+  fast = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+  {
+    msgs::Int32 msg;
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_LE(fast, 3);
+
+  // Removing the cap restores the consumers' own rates
+  hub.SetRateCap(0.0);
+  EXPECT_DOUBLE_EQ(50.0, hub.SubscribedRate("/hub_cap"));
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Feedback))
+{
+  EXPECT_EQ("/hub_feedback/feedback", FeedbackTopic("/hub_feedback"));
+
+  SubscriptionHub hub;
+  EXPECT_FALSE(hub.Feedback("/hub_feedback"));
+  hub.SetFeedback("/hub_feedback", true);
+  EXPECT_TRUE(hub.Feedback("/hub_feedback"));
+
+  // A consumer dropping every other message it gets
+  std::atomic<int> received{0};
+  HubSubscription sub;
+  sub = hub.Subscribe("/hub_feedback",
+      [&](const std::shared_ptr<const google::protobuf::Message> &)
+      {
+        if (++received % 2 == 0)
+          sub.ReportDropped();
+      }, 20.0);
+  ASSERT_TRUE(sub.Valid());
+
+  std::mutex mutex;
+  msgs::Param feedback;
+  transport::Node node;
+  std::function<void(const msgs::Param &)> feedbackCb =
+      [&](const msgs::Param &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        feedback = _msg;
+      };
+  ASSERT_TRUE(node.Subscribe(FeedbackTopic("/hub_feedback"), feedbackCb));
+
+  // Publish at 100 Hz until feedback of a whole period arrives
+  auto pub = node.Advertise<msgs::Int32>("/hub_feedback");
+  auto param = [&](const std::string &_key)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = feedback.params().find(_key);
+    return it == feedback.params().end() ? -1.0 : it->second.double_value();
+  };
+  for (int i = 0; i < 300 && param("period") < 0.0; ++i)
+  {
+    msgs::Int32 msg;
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_GE(param("period"), 1.0);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_FALSE(feedback.params().at("consumer").string_value().empty());
+  }
+  EXPECT_DOUBLE_EQ(20.0, param("requested_rate"));
+  EXPECT_DOUBLE_EQ(1.0, param("consumers"));
+  EXPECT_GT(param("received_rate"), 10.0);
+  EXPECT_LE(param("received_rate"), 25.0);
+  EXPECT_GT(param("consumed_rate"), 5.0);
+  EXPECT_LE(param("consumed_rate"), 12.0);
+  EXPECT_GT(param("dropped"), 5.0);
+
+  // Stops once disabled
+  hub.SetFeedback("/hub_feedback", false);
+  EXPECT_FALSE(hub.Feedback("/hub_feedback"));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    feedback.Clear();
+  }
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start <
+      std::chrono::milliseconds(1500))
+  {
+    msgs::Int32 msg;
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_LT(param("period"), 0.0);
+
+  // Reporting through an empty handle does nothing
+  sub.Reset();
+  sub.ReportDropped(3);
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SharedMemory))
+{
+  SubscriptionHub hub;
+  hub.SetSharedMemory("/hub_shm", true);
+
+  std::atomic<int> parsed{0};
+  std::atomic<int> raw{0};
+  std::string last;
+  std::mutex mutex;
+  auto sub = hub.Subscribe<msgs::StringMsg>("/hub_shm",
+      std::function<void(const msgs::StringMsg &)>(
+      [&](const msgs::StringMsg &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        last = _msg.data();
+        ++parsed;
+      }));
+  auto subRaw = hub.SubscribeRaw("/hub_shm",
+      [&](const char *, std::size_t, const std::string &_type)
+      {
+        EXPECT_EQ("gz.msgs.StringMsg", _type);
+        ++raw;
+      });
+
+  SharedMemoryPublisher publisher("/hub_shm", "gz.msgs.StringMsg");
+  msgs::StringMsg msg;
+  msg.set_data("shared");
+  EXPECT_TRUE(waitFor([&]()
+  {
+    publisher.Publish(msg);
+    return hub.SharedMemoryActive("/hub_shm");
+  }));
+
+  // Only the shared memory is used from now on
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const int parsedBefore = parsed;
+  const int rawBefore = raw;
+  for (int i = 0; i < 5; ++i)
+  {
+    msg.set_data("shared " + std::to_string(i));
+    publisher.Publish(msg);
+  }
+  EXPECT_TRUE(waitFor([&]() {return parsed == parsedBefore + 5;}));
+  EXPECT_TRUE(waitFor([&]() {return raw == rawBefore + 5;}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(parsedBefore + 5, parsed);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ("shared 4", last);
+  }
+
+  // Back to transport
+  hub.SetSharedMemory("/hub_shm", false);
+  EXPECT_FALSE(hub.SharedMemoryActive("/hub_shm"));
+  msg.set_data("transport");
+  EXPECT_TRUE(waitFor([&]()
+  {
+    publisher.Publish(msg);
+    std::lock_guard<std::mutex> lock(mutex);
+    return last == "transport";
+  }));
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest,
+    GZ_UTILS_TEST_DISABLED_ON_WIN32(SharedMemoryFallback))
+{
+  SubscriptionHub hub;
+  hub.SetSharedMemory("/hub_shm_remote", true);
+
+  std::atomic<int> received{0};
+  auto sub = hub.Subscribe<msgs::Int32>("/hub_shm_remote",
+      std::function<void(const msgs::Int32 &)>(
+      [&](const msgs::Int32 &)
+      {
+        ++received;
+      }));
+
+  // Descriptors of a publisher on another host
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>("/hub_shm_remote");
+  auto descriptorPub = node.Advertise<msgs::Header>(
+      SharedMemoryTopic("/hub_shm_remote"));
+  msgs::Header descriptor;
+  auto data = descriptor.add_data();
+  data->set_key("host");
+  data->add_value("elsewhere");
+
+  EXPECT_TRUE(waitFor([&]()
+  {
+    descriptorPub.Publish(descriptor);
+    pub.Publish(msgs::Int32());
+    return received > 0;
+  }));
+  EXPECT_FALSE(hub.SharedMemoryActive("/hub_shm_remote"));
+
+  // The descriptors aren't even subscribed anymore
+  EXPECT_TRUE(waitFor([&]()
+  {
+    return !descriptorPub.HasConnections();
+  }));
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Lifetime))
+{
+  // Invalid topic
+  HubSubscription invalid;
+  {
+    SubscriptionHub hub;
+    invalid = hub.Subscribe("invalid topic",
+        [](const std::shared_ptr<const google::protobuf::Message> &){});
+    EXPECT_FALSE(invalid.Valid());
+
+    // Handles can outlive the hub
+    invalid = hub.Subscribe("/hub_lifetime",
+        [](const std::shared_ptr<const google::protobuf::Message> &){});
+    EXPECT_TRUE(invalid.Valid());
+  }
+  EXPECT_FALSE(invalid.Valid());
+  invalid.Reset();
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionHubTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Application))
+{
+  gui::Application app(g_argc, g_argv);
+
+  auto hub = app.Subscriptions();
+  ASSERT_NE(nullptr, hub);
+  EXPECT_EQ(hub, app.Subscriptions());
+}
@@ -0,0 +1,387 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/TaskPool.hh"
+
+namespace
+{
+/// \brief Queued task
+struct Task
+{
+  /// \brief ID returned by Submit
+  std::uint64_t id{0};
+
+  /// \brief Object the task belongs to
+  const void *owner{nullptr};
+
+  /// \brief Work to run
+  std::function<void()> work;
+};
+
+/// \brief Pool whose thread is the calling thread, if any
+thread_local const void *tCurrentPool{nullptr};
+
+/// \brief Index of the calling thread in `tCurrentPool`
+thread_local std::size_t tCurrentWorker{0};
+}
+
+namespace gz::gui
+{
+class TaskPool::Implementation
+{
+  /// \brief One thread and its queues
+  public: struct Worker
+  {
+    /// \brief Protects `queues`
+    std::mutex mutex;
+
+    /// \brief Queued tasks, by priority
+    std::array<std::deque<Task>, 3> queues;
+
+    /// \brief Thread running the tasks
+    std::thread thread;
+  };
+
+  /// \brief Take the next task for a thread: the highest priority task,
+  /// from its own queue first, the newest one, and otherwise the oldest one
+  /// of another thread. The task's owner is counted as running.
+  /// \param[in] _index Index of the thread
+  /// \param[out] _task Task taken
+  /// \return False if there were no tasks
+  public: bool Take(std::size_t _index, Task &_task);
+
+  /// \brief Loop of a thread
+  /// \param[in] _index Index of the thread
+  public: void Run(std::size_t _index);
+
+  /// \brief Apply the thread policy if it changed since the calling
+  /// thread last applied it
+  /// \param[in,out] _applied Version the thread last applied
+  public: void ApplyPolicy(std::uint64_t &_applied);
+
+  /// \brief Threads
+  public: std::vector<std::unique_ptr<Worker>> workers;
+
+  /// \brief Number of queued tasks. Only increased with `sleepMutex`
+  /// locked, so threads don't miss tasks while going to sleep.
+  public: std::atomic<std::size_t> pending{0};
+
+  /// \brief Protects `stop`, and waiting on `wake`
+  public: std::mutex sleepMutex;
+
+  /// \brief Wakes up threads when tasks are queued or the pool stops
+  public: std::condition_variable wake;
+
+  /// \brief Whether the threads should exit
+  public: bool stop{false};
+
+  /// \brief Priority and CPUs of the threads. Protected by `sleepMutex`.
+  public: ThreadPolicy policy;
+
+  /// \brief Incremented each time `policy` is set
+  public: std::atomic<std::uint64_t> policyVersion{0};
+
+  /// \brief ID of the next task
+  public: std::atomic<std::uint64_t> nextId{1};
+
+  /// \brief Thread which gets the next task submitted from outside the
+  /// pool
+  public: std::atomic<std::size_t> nextWorker{0};
+
+  /// \brief Protects `running`
+  public: std::mutex runningMutex;
+
+  /// \brief Notified when tasks finish
+  public: std::condition_variable runningDone;
+
+  /// \brief Number of running tasks by owner
+  public: std::unordered_map<const void *, std::size_t> running;
+};
+
+/////////////////////////////////////////////////
+bool TaskPool::Implementation::Take(std::size_t _index, Task &_task)
+{
+  const std::size_t count = this->workers.size();
+  for (int priority = static_cast<int>(Priority::HIGH);
+       priority >= static_cast<int>(Priority::LOW); --priority)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto &worker = *this->workers[(_index + i) % count];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      auto &queue = worker.queues[priority];
+      if (queue.empty())
+        continue;
+
+      if (i == 0)
+      {
+        _task = std::move(queue.back());
+        queue.pop_back();
+      }
+      else
+      {
+        _task = std::move(queue.front());
+        queue.pop_front();
+      }
+      --this->pending;
+
+      // Counted before the queue is unlocked, so CancelOwner can't miss it
+      std::lock_guard<std::mutex> runningLock(this->runningMutex);
+      ++this->running[_task.owner];
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+void TaskPool::Implementation::ApplyPolicy(std::uint64_t &_applied)
+{
+  if (this->policyVersion == _applied)
+    return;
+
+  ThreadPolicy current;
+  {
+    std::lock_guard<std::mutex> lock(this->sleepMutex);
+    current = this->policy;
+    _applied = this->policyVersion;
+  }
+  current.ApplyToCurrentThread();
+}
+
+/////////////////////////////////////////////////
+void TaskPool::Implementation::Run(std::size_t _index)
+{
+  tCurrentPool = this;
+  tCurrentWorker = _index;
+  std::uint64_t appliedPolicy{0};
+
+  while (true)
+  {
+    Task task;
+    if (!this->Take(_index, task))
+    {
+      std::unique_lock<std::mutex> lock(this->sleepMutex);
+      this->wake.wait(lock, [this, &appliedPolicy]
+      {
+        return this->stop || this->pending > 0 ||
+            this->policyVersion != appliedPolicy;
+      });
+      if (this->stop)
+        return;
+      lock.unlock();
+      this->ApplyPolicy(appliedPolicy);
+      continue;
+    }
+
+    this->ApplyPolicy(appliedPolicy);
+
+    try
+    {
+      task.work();
+    }
+    catch (const std::exception &_e)
+    {
+      gzerr << "Task [" << task.id << "] failed: " << _e.what() << std::endl;
+    }
+    catch (...)
+    {
+      gzerr << "Task [" << task.id << "] failed." << std::endl;
+    }
+    task.work = nullptr;
+
+    std::lock_guard<std::mutex> lock(this->runningMutex);
+    auto it = this->running.find(task.owner);
+    if (it != this->running.end() && --it->second == 0)
+      this->running.erase(it);
+    this->runningDone.notify_all();
+  }
+}
+
+/////////////////////////////////////////////////
+TaskPool::TaskPool(unsigned int _threads)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  // One core is left to the GUI thread
+  if (_threads == 0)
+    _threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+  for (unsigned int i = 0; i < _threads; ++i)
+  {
+    this->dataPtr->workers.push_back(
+        std::make_unique<Implementation::Worker>());
+  }
+
+  // Started once all queues exist, since threads take from each other
+  for (std::size_t i = 0; i < this->dataPtr->workers.size(); ++i)
+  {
+    this->dataPtr->workers[i]->thread = std::thread(
+        &Implementation::Run, this->dataPtr.get(), i);
+  }
+}
+
+/////////////////////////////////////////////////
+TaskPool::~TaskPool()
+{
+  for (auto &worker : this->dataPtr->workers)
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    for (auto &queue : worker->queues)
+      queue.clear();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->sleepMutex);
+    this->dataPtr->stop = true;
+    this->dataPtr->pending = 0;
+  }
+  this->dataPtr->wake.notify_all();
+
+  for (auto &worker : this->dataPtr->workers)
+  {
+    if (worker->thread.joinable())
+      worker->thread.join();
+  }
+}
+
+/////////////////////////////////////////////////
+unsigned int TaskPool::ThreadCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->workers.size());
+}
+
+/////////////////////////////////////////////////
+std::uint64_t TaskPool::Submit(std::function<void()> _task,
+    Priority _priority, const void *_owner)
+{
+  if (!_task)
+    return 0;
+
+  Task task;
+  task.id = this->dataPtr->nextId++;
+  task.owner = _owner;
+  task.work = std::move(_task);
+  const auto id = task.id;
+
+  // Tasks queued by a task stay on its thread, where their data is likely
+  // still cached
+  const std::size_t index = tCurrentPool == this->dataPtr.get() ?
+      tCurrentWorker :
+      this->dataPtr->nextWorker++ % this->dataPtr->workers.size();
+
+  auto &worker = *this->dataPtr->workers[index];
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queues[static_cast<int>(_priority)].push_back(std::move(task));
+
+    std::lock_guard<std::mutex> sleepLock(this->dataPtr->sleepMutex);
+    ++this->dataPtr->pending;
+  }
+  this->dataPtr->wake.notify_one();
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool TaskPool::Cancel(std::uint64_t _id)
+{
+  for (auto &worker : this->dataPtr->workers)
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    for (auto &queue : worker->queues)
+    {
+      auto it = std::find_if(queue.begin(), queue.end(),
+          [_id](const Task &_task)
+          {
+            return _task.id == _id;
+          });
+      if (it == queue.end())
+        continue;
+      queue.erase(it);
+      --this->dataPtr->pending;
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+std::size_t TaskPool::CancelOwner(const void *_owner)
+{
+  std::size_t removed{0};
+  for (auto &worker : this->dataPtr->workers)
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    for (auto &queue : worker->queues)
+    {
+      auto it = std::remove_if(queue.begin(), queue.end(),
+          [_owner](const Task &_task)
+          {
+            return _task.owner == _owner;
+          });
+      const auto count = static_cast<std::size_t>(
+          std::distance(it, queue.end()));
+      queue.erase(it, queue.end());
+      this->dataPtr->pending -= count;
+      removed += count;
+    }
+  }
+
+  if (tCurrentPool != this->dataPtr.get())
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->runningMutex);
+    this->dataPtr->runningDone.wait(lock, [this, _owner]
+    {
+      return this->dataPtr->running.find(_owner) ==
+          this->dataPtr->running.end();
+    });
+  }
+  return removed;
+}
+
+/////////////////////////////////////////////////
+std::size_t TaskPool::Pending() const
+{
+  return this->dataPtr->pending;
+}
+
+/////////////////////////////////////////////////
+void TaskPool::SetThreadPolicy(const ThreadPolicy &_policy)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->sleepMutex);
+    this->dataPtr->policy = _policy;
+    ++this->dataPtr->policyVersion;
+  }
+  this->dataPtr->wake.notify_all();
+}
+}  // namespace gz::gui
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#  include <sys/resource.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#include "gz/gui/TaskPool.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TaskPoolTest, Run)
+{
+  TaskPool pool(4);
+  EXPECT_EQ(4u, pool.ThreadCount());
+  EXPECT_EQ(0u, pool.Submit(nullptr));
+
+  std::atomic<int> count{0};
+  std::vector<std::future<void>> done;
+  for (int i = 0; i < 100; ++i)
+  {
+    auto promise = std::make_shared<std::promise<void>>();
+    done.push_back(promise->get_future());
+    EXPECT_NE(0u, pool.Submit([&count, promise]
+    {
+      ++count;
+      promise->set_value();
+    }));
+  }
+  for (auto &future : done)
+    future.wait();
+  EXPECT_EQ(100, count);
+
+  // Exceptions don't stop the threads
+  std::promise<void> after;
+  pool.Submit([]{ throw std::runtime_error("failed"); });
+  pool.Submit([&after]{ after.set_value(); });
+  after.get_future().wait();
+
+  // Tasks can submit tasks
+  std::promise<int> nested;
+  pool.Submit([&pool, &nested]
+  {
+    pool.Submit([&nested]{ nested.set_value(3); });
+  });
+  EXPECT_EQ(3, nested.get_future().get());
+}
+
+/////////////////////////////////////////////////
+TEST(TaskPoolTest, Priorities)
+{
+  TaskPool pool(1);
+
+  // Block the only thread while tasks are queued
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  pool.Submit([&started, released]
+  {
+    started.set_value();
+    released.wait();
+  });
+  started.get_future().wait();
+
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&mutex, &order](int _value)
+  {
+    return [&mutex, &order, _value]
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(_value);
+    };
+  };
+  // Tasks of the same priority on a thread's own queue run newest first,
+  // so this one runs last
+  std::promise<void> last;
+  pool.Submit([&last]{ last.set_value(); }, TaskPool::Priority::LOW);
+
+  pool.Submit(record(0), TaskPool::Priority::LOW);
+  pool.Submit(record(1), TaskPool::Priority::NORMAL);
+  pool.Submit(record(2), TaskPool::Priority::HIGH);
+  EXPECT_EQ(4u, pool.Pending());
+
+  release.set_value();
+  last.get_future().wait();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(std::vector<int>({2, 1, 0}), order);
+}
+
+/////////////////////////////////////////////////
+TEST(TaskPoolTest, Cancel)
+{
+  TaskPool pool(1);
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  std::atomic<bool> finished{false};
+  int owner{0};
+  pool.Submit([&started, &finished, released]
+  {
+    started.set_value();
+    released.wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    finished = true;
+  }, TaskPool::Priority::NORMAL, &owner);
+  started.get_future().wait();
+
+  std::atomic<int> count{0};
+  auto id = pool.Submit([&count]{ ++count; });
+  pool.Submit([&count]{ ++count; }, TaskPool::Priority::NORMAL, &owner);
+  pool.Submit([&count]{ ++count; }, TaskPool::Priority::HIGH, &owner);
+  EXPECT_EQ(3u, pool.Pending());
+
+  EXPECT_TRUE(pool.Cancel(id));
+  EXPECT_FALSE(pool.Cancel(id));
+  EXPECT_EQ(2u, pool.Pending());
+
+  // Queued tasks of the owner are dropped, and the running one is waited
+  // for
+  release.set_value();
+  EXPECT_EQ(2u, pool.CancelOwner(&owner));
+  EXPECT_TRUE(finished);
+  EXPECT_EQ(0u, pool.Pending());
+
+  std::promise<void> last;
+  pool.Submit([&last]{ last.set_value(); });
+  last.get_future().wait();
+  EXPECT_EQ(0, count);
+}
+
+#ifdef __linux__
+/////////////////////////////////////////////////
+TEST(TaskPoolTest, ThreadPolicy)
+{
+  TaskPool pool(2);
+
+  // Lowering the priority doesn't need privileges
+  ThreadPolicy policy;
+  policy.priority = ThreadPolicy::Priority::LOW;
+  pool.SetThreadPolicy(policy);
+
+  std::mutex mutex;
+  std::vector<int> nices;
+  std::vector<std::future<void>> done;
+  for (int i = 0; i < 8; ++i)
+  {
+    auto promise = std::make_shared<std::promise<void>>();
+    done.push_back(promise->get_future());
+    pool.Submit([&mutex, &nices, promise]
+    {
+      const int nice = getpriority(PRIO_PROCESS,
+          static_cast<id_t>(syscall(SYS_gettid)));
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        nices.push_back(nice);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      promise->set_value();
+    });
+  }
+  for (auto &future : done)
+    future.wait();
+
+  EXPECT_EQ(std::vector<int>(8, 10), nices);
+}
+#endif
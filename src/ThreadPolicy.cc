@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/resource.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#elif defined(_WIN32)
+#  include <windows.h>
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/ThreadPolicy.hh"
+
+namespace gz::gui
+{
+/////////////////////////////////////////////////
+bool ThreadPolicy::Empty() const
+{
+  return this->priority == Priority::DEFAULT && this->cpus.empty();
+}
+
+/////////////////////////////////////////////////
+bool ThreadPolicy::Load(const tinyxml2::XMLElement *_elem)
+{
+  if (nullptr == _elem)
+    return true;
+
+  bool valid{true};
+  if (auto *priorityElem = _elem->FirstChildElement("priority"))
+  {
+    const std::string text = priorityElem->GetText() == nullptr ? "" :
+        priorityElem->GetText();
+    if (text == "low")
+      this->priority = Priority::LOW;
+    else if (text == "normal")
+      this->priority = Priority::NORMAL;
+    else if (text == "high")
+      this->priority = Priority::HIGH;
+    else
+    {
+      gzerr << "Failed to parse <priority> value [" << text
+            << "], expected low, normal or high" << std::endl;
+      valid = false;
+    }
+  }
+
+  std::optional<std::vector<unsigned int>> cpuList;
+  if (auto *cpusElem = _elem->FirstChildElement("cpus"))
+  {
+    const std::string text = cpusElem->GetText() == nullptr ? "" :
+        cpusElem->GetText();
+    cpuList = ParseCpuList(text);
+    if (!cpuList.has_value())
+    {
+      gzerr << "Failed to parse <cpus> value [" << text << "]" << std::endl;
+      valid = false;
+    }
+  }
+
+  if (auto *nodeElem = _elem->FirstChildElement("numa_node"))
+  {
+    unsigned int node{0};
+    if (nodeElem->QueryUnsignedText(&node) != tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Failed to parse <numa_node>" << std::endl;
+      valid = false;
+    }
+    else
+    {
+      auto nodeCpus = NumaNodeCpus(node);
+      if (nodeCpus.empty())
+      {
+        gzerr << "NUMA node [" << node << "] not found" << std::endl;
+        valid = false;
+      }
+      else if (cpuList.has_value())
+      {
+        std::vector<unsigned int> both;
+        std::set_intersection(cpuList->begin(), cpuList->end(),
+            nodeCpus.begin(), nodeCpus.end(), std::back_inserter(both));
+        cpuList = both;
+      }
+      else
+      {
+        cpuList = nodeCpus;
+      }
+    }
+  }
+
+  if (cpuList.has_value())
+  {
+    if (cpuList->empty())
+    {
+      gzerr << "No CPUs left for the thread in <cpus> and <numa_node>"
+            << std::endl;
+      valid = false;
+    }
+    else
+    {
+      this->cpus = *cpuList;
+    }
+  }
+  return valid;
+}
+
+/////////////////////////////////////////////////
+bool ThreadPolicy::ApplyToCurrentThread() const
+{
+  if (this->Empty())
+    return true;
+
+  bool applied{true};
+#ifdef __linux__
+  if (this->priority != Priority::DEFAULT)
+  {
+    const int nice = this->priority == Priority::LOW ? 10 :
+        this->priority == Priority::HIGH ? -10 : 0;
+
+    // Nice values are per thread on Linux, for the thread's own ID
+    const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, nice) != 0)
+    {
+      gzwarn << "Failed to set the thread priority to nice value [" << nice
+             << "]: " << std::strerror(errno) << ". Raising it needs "
+             << "CAP_SYS_NICE or a higher RLIMIT_NICE." << std::endl;
+      applied = false;
+    }
+  }
+
+  if (!this->cpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : this->cpus)
+    {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &set);
+    }
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(set),
+        &set);
+    if (error != 0)
+    {
+      gzwarn << "Failed to set the thread CPU affinity: "
+             << std::strerror(error) << std::endl;
+      applied = false;
+    }
+  }
+#elif defined(_WIN32)
+  if (this->priority != Priority::DEFAULT)
+  {
+    const int priority = this->priority == Priority::LOW ?
+        THREAD_PRIORITY_BELOW_NORMAL :
+        this->priority == Priority::HIGH ?
+        THREAD_PRIORITY_ABOVE_NORMAL : THREAD_PRIORITY_NORMAL;
+    if (!SetThreadPriority(GetCurrentThread(), priority))
+    {
+      gzwarn << "Failed to set the thread priority" << std::endl;
+      applied = false;
+    }
+  }
+
+  if (!this->cpus.empty())
+  {
+    DWORD_PTR mask{0};
+    for (const auto cpu : this->cpus)
+    {
+      if (cpu < sizeof(mask) * 8)
+        mask |= DWORD_PTR{1} << cpu;
+    }
+    if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+    {
+      gzwarn << "Failed to set the thread CPU affinity" << std::endl;
+      applied = false;
+    }
+  }
+#else
+  gzwarn << "Thread priorities and CPU affinity aren't supported on this "
+         << "platform" << std::endl;
+  applied = false;
+#endif
+  return applied;
+}
+
+/////////////////////////////////////////////////
+std::optional<std::vector<unsigned int>> ThreadPolicy::ParseCpuList(
+    const std::string &_list)
+{
+  std::vector<unsigned int> result;
+  std::stringstream stream(_list);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    item.erase(std::remove_if(item.begin(), item.end(), ::isspace),
+        item.end());
+    if (item.empty())
+      return std::nullopt;
+
+    const auto dash = item.find('-');
+    unsigned int first{0};
+    unsigned int last{0};
+    try
+    {
+      std::size_t used{0};
+      first = static_cast<unsigned int>(std::stoul(item, &used));
+      last = first;
+      if (dash != std::string::npos)
+      {
+        if (used != dash)
+          return std::nullopt;
+        const std::string end = item.substr(dash + 1);
+        last = static_cast<unsigned int>(std::stoul(end, &used));
+        if (used != end.size())
+          return std::nullopt;
+      }
+      else if (used != item.size())
+      {
+        return std::nullopt;
+      }
+    }
+    catch (const std::exception &)
+    {
+      return std::nullopt;
+    }
+
+    // Ranges of more CPUs than any machine has are typos
+    if (last < first || last - first > 4096u)
+      return std::nullopt;
+    for (unsigned int cpu = first; cpu <= last; ++cpu)
+      result.push_back(cpu);
+  }
+
+  if (result.empty())
+    return std::nullopt;
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> ThreadPolicy::NumaNodeCpus(unsigned int _node)
+{
+#ifdef __linux__
+  std::ifstream file("/sys/devices/system/node/node" +
+      std::to_string(_node) + "/cpulist");
+  std::string list;
+  if (file && std::getline(file, list))
+  {
+    if (auto cpus = ParseCpuList(list))
+      return *cpus;
+  }
+#else
+  (void)_node;
+#endif
+  return {};
+}
+}  // namespace gz::gui
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/resource.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#include "gz/gui/ThreadPolicy.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(ThreadPolicyTest, ParseCpuList)
+{
+  using Cpus = std::vector<unsigned int>;
+  EXPECT_EQ(Cpus({3}), ThreadPolicy::ParseCpuList("3"));
+  EXPECT_EQ(Cpus({0, 1, 2, 3, 8}), ThreadPolicy::ParseCpuList("8,0-3"));
+  EXPECT_EQ(Cpus({1, 2}), ThreadPolicy::ParseCpuList(" 1, 2,1-2 "));
+
+  EXPECT_FALSE(ThreadPolicy::ParseCpuList("").has_value());
+  EXPECT_FALSE(ThreadPolicy::ParseCpuList("1,,2").has_value());
+  EXPECT_FALSE(ThreadPolicy::ParseCpuList("3-1").has_value());
+  EXPECT_FALSE(ThreadPolicy::ParseCpuList("a").has_value());
+  EXPECT_FALSE(ThreadPolicy::ParseCpuList("1-").has_value());
+  EXPECT_FALSE(ThreadPolicy::ParseCpuList("1x").has_value());
+  EXPECT_FALSE(ThreadPolicy::ParseCpuList("-1").has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(ThreadPolicyTest, Load)
+{
+  ThreadPolicy policy;
+  EXPECT_TRUE(policy.Empty());
+  EXPECT_TRUE(policy.Load(nullptr));
+  EXPECT_TRUE(policy.ApplyToCurrentThread());
+
+  tinyxml2::XMLDocument doc;
+  doc.Parse(
+      "<thread><priority>low</priority><cpus>2-3,0</cpus></thread>");
+  EXPECT_TRUE(policy.Load(doc.FirstChildElement("thread")));
+  EXPECT_FALSE(policy.Empty());
+  EXPECT_EQ(ThreadPolicy::Priority::LOW, policy.priority);
+  EXPECT_EQ(std::vector<unsigned int>({0, 2, 3}), policy.cpus);
+
+  // Invalid values are ignored
+  ThreadPolicy invalid;
+  doc.Parse(
+      "<thread><priority>max</priority><cpus>x</cpus></thread>");
+  EXPECT_FALSE(invalid.Load(doc.FirstChildElement("thread")));
+  EXPECT_TRUE(invalid.Empty());
+}
+
+#ifdef __linux__
+/////////////////////////////////////////////////
+TEST(ThreadPolicyTest, NumaNode)
+{
+  // Machines without NUMA still have node 0
+  auto cpus = ThreadPolicy::NumaNodeCpus(0);
+  if (cpus.empty())
+    GTEST_SKIP() << "No NUMA information";
+
+  tinyxml2::XMLDocument doc;
+  doc.Parse("<thread><numa_node>0</numa_node></thread>");
+  ThreadPolicy policy;
+  EXPECT_TRUE(policy.Load(doc.FirstChildElement("thread")));
+  EXPECT_EQ(cpus, policy.cpus);
+
+  // Only the CPUs in both
+  const std::string both = "<thread><cpus>" +
+      std::to_string(cpus.front()) +
+      ",100000</cpus><numa_node>0</numa_node></thread>";
+  doc.Parse(both.c_str());
+  ThreadPolicy bothPolicy;
+  EXPECT_TRUE(bothPolicy.Load(doc.FirstChildElement("thread")));
+  EXPECT_EQ(std::vector<unsigned int>({cpus.front()}), bothPolicy.cpus);
+
+  doc.Parse("<thread><numa_node>100000</numa_node></thread>");
+  ThreadPolicy missing;
+  EXPECT_FALSE(missing.Load(doc.FirstChildElement("thread")));
+  EXPECT_TRUE(missing.cpus.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ThreadPolicyTest, Apply)
+{
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  unsigned int cpu{0};
+  while (!CPU_ISSET(cpu, &allowed))
+    ++cpu;
+
+  // Applied to a new thread, lowering its priority doesn't need privileges
+  ThreadPolicy policy;
+  policy.priority = ThreadPolicy::Priority::LOW;
+  policy.cpus = {cpu};
+
+  bool applied{false};
+  int nice{0};
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  std::thread thread([&]()
+  {
+    applied = policy.ApplyToCurrentThread();
+    nice = getpriority(PRIO_PROCESS,
+        static_cast<id_t>(syscall(SYS_gettid)));
+    pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+  });
+  thread.join();
+
+  EXPECT_TRUE(applied);
+  EXPECT_EQ(10, nice);
+  EXPECT_EQ(1, CPU_COUNT(&set));
+  EXPECT_TRUE(CPU_ISSET(cpu, &set));
+}
+#endif
@@ -0,0 +1,543 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include "gz/gui/TimeSeries.hh"
+
+namespace
+{
+/// \brief Points per chunk
+constexpr std::size_t kChunkSize = 4096;
+}  // namespace
+
+namespace gz::gui
+{
+class TimeSeries::Implementation
+{
+  /// \brief Time of the oldest point within the retention window
+  /// \return Lowest time kept, lowest double if there's no window
+  public: double Cutoff() const;
+
+  /// \brief Call a function for every retained point in a time range, in
+  /// time order
+  /// \param[in] _xMin Start of the range
+  /// \param[in] _xMax End of the range
+  /// \param[in] _func Function to call for each point
+  public: template<typename Func>
+          void Visit(double _xMin, double _xMax, Func _func) const;
+
+  /// \brief Drop the chunks outside of the retention window and the point
+  /// limit
+  public: void Trim();
+
+  /// \brief Stored points, the oldest first
+  public: std::deque<std::vector<math::Vector2d>> chunks;
+
+  /// \brief Number of stored points, including those not trimmed yet
+  public: std::size_t size{0};
+
+  /// \brief Time window to keep, 0 to keep all
+  public: double retention{0.0};
+
+  /// \brief Most points to keep, 4M points are 64 MB
+  public: std::size_t maxPoints{1u << 22};
+};
+
+/////////////////////////////////////////////////
+double TimeSeries::Implementation::Cutoff() const
+{
+  if (this->retention <= 0.0 || this->chunks.empty())
+    return std::numeric_limits<double>::lowest();
+  return this->chunks.back().back().X() - this->retention;
+}
+
+/////////////////////////////////////////////////
+template<typename Func>
+void TimeSeries::Implementation::Visit(double _xMin, double _xMax,
+    Func _func) const
+{
+  _xMin = std::max(_xMin, this->Cutoff());
+  for (const auto &chunk : this->chunks)
+  {
+    // Whole chunks are skipped based on their first and last points
+    if (chunk.back().X() < _xMin)
+      continue;
+    if (chunk.front().X() > _xMax)
+      break;
+
+    auto it = chunk.begin();
+    if (it->X() < _xMin)
+    {
+      it = std::lower_bound(chunk.begin(), chunk.end(), _xMin,
+          [](const math::Vector2d &_point, double _x)
+          {
+            return _point.X() < _x;
+          });
+    }
+    for (; it != chunk.end() && it->X() <= _xMax; ++it)
+      _func(*it);
+  }
+}
+
+/////////////////////////////////////////////////
+void TimeSeries::Implementation::Trim()
+{
+  // Whole chunks only, so up to one chunk more than the limit is kept
+  const double cutoff = this->Cutoff();
+  while (this->chunks.size() > 1 &&
+      (this->chunks.front().back().X() < cutoff ||
+      this->size - this->chunks.front().size() >= this->maxPoints))
+  {
+    this->size -= this->chunks.front().size();
+    this->chunks.pop_front();
+  }
+}
+
+/////////////////////////////////////////////////
+TimeSeries::TimeSeries()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+TimeSeries::~TimeSeries() = default;
+
+/////////////////////////////////////////////////
+void TimeSeries::SetRetention(double _window)
+{
+  this->dataPtr->retention = std::max(0.0, _window);
+  this->dataPtr->Trim();
+}
+
+/////////////////////////////////////////////////
+double TimeSeries::Retention() const
+{
+  return this->dataPtr->retention;
+}
+
+/////////////////////////////////////////////////
+void TimeSeries::SetMaxPoints(std::size_t _maxPoints)
+{
+  this->dataPtr->maxPoints = _maxPoints;
+  this->dataPtr->Trim();
+}
+
+/////////////////////////////////////////////////
+std::size_t TimeSeries::MaxPoints() const
+{
+  return this->dataPtr->maxPoints;
+}
+
+/////////////////////////////////////////////////
+void TimeSeries::Append(double _x, double _y)
+{
+  if (this->dataPtr->chunks.empty() ||
+      this->dataPtr->chunks.back().size() >= kChunkSize)
+  {
+    this->dataPtr->chunks.emplace_back();
+    this->dataPtr->chunks.back().reserve(kChunkSize);
+  }
+  this->dataPtr->chunks.back().emplace_back(_x, _y);
+  ++this->dataPtr->size;
+  this->dataPtr->Trim();
+}
+
+/////////////////////////////////////////////////
+void TimeSeries::Clear()
+{
+  this->dataPtr->chunks.clear();
+  this->dataPtr->size = 0;
+}
+
+/////////////////////////////////////////////////
+std::size_t TimeSeries::Size() const
+{
+  std::size_t count{0};
+  this->dataPtr->Visit(std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::max(),
+      [&count](const math::Vector2d &){++count;});
+  return count;
+}
+
+/////////////////////////////////////////////////
+bool TimeSeries::Empty() const
+{
+  // Trimming keeps the newest point
+  return this->dataPtr->chunks.empty();
+}
+
+/////////////////////////////////////////////////
+double TimeSeries::Start() const
+{
+  const double cutoff = this->dataPtr->Cutoff();
+  for (const auto &chunk : this->dataPtr->chunks)
+  {
+    if (chunk.back().X() < cutoff)
+      continue;
+    auto it = std::lower_bound(chunk.begin(), chunk.end(), cutoff,
+        [](const math::Vector2d &_point, double _x)
+        {
+          return _point.X() < _x;
+        });
+    return it->X();
+  }
+  return 0.0;
+}
+
+/////////////////////////////////////////////////
+double TimeSeries::End() const
+{
+  if (this->dataPtr->chunks.empty())
+    return 0.0;
+  return this->dataPtr->chunks.back().back().X();
+}
+
+/////////////////////////////////////////////////
+std::vector<math::Vector2d> TimeSeries::Points() const
+{
+  std::vector<math::Vector2d> points;
+  points.reserve(this->dataPtr->size);
+  this->dataPtr->Visit(std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::max(),
+      [&points](const math::Vector2d &_point){points.push_back(_point);});
+  return points;
+}
+
+/////////////////////////////////////////////////
+std::vector<math::Vector2d> TimeSeries::Decimated(double _xMin,
+    double _xMax, unsigned int _buckets) const
+{
+  std::vector<math::Vector2d> points;
+  if (_buckets == 0 || _xMax < _xMin)
+    return points;
+
+  std::size_t count{0};
+  this->dataPtr->Visit(_xMin, _xMax,
+      [&count](const math::Vector2d &){++count;});
+
+  // Few enough points to draw them all
+  if (count <= 2u * _buckets)
+  {
+    points.reserve(count);
+    this->dataPtr->Visit(_xMin, _xMax,
+        [&points](const math::Vector2d &_point){points.push_back(_point);});
+    return points;
+  }
+
+  // Keep the extremes of each bucket, in the order they arrived, so the
+  // line still looks the same
+  points.reserve(2u * _buckets);
+  const double width = (_xMax - _xMin) / _buckets;
+  int64_t bucket{-1};
+  math::Vector2d low;
+  math::Vector2d high;
+  std::size_t lowIndex{0};
+  std::size_t highIndex{0};
+  std::size_t index{0};
+  auto flush = [&]()
+  {
+    if (bucket < 0)
+      return;
+    if (lowIndex == highIndex)
+    {
+      points.push_back(low);
+    }
+    else if (lowIndex < highIndex)
+    {
+      points.push_back(low);
+      points.push_back(high);
+    }
+    else
+    {
+      points.push_back(high);
+      points.push_back(low);
+    }
+  };
+
+  this->dataPtr->Visit(_xMin, _xMax, [&](const math::Vector2d &_point)
+  {
+    int64_t pointBucket{0};
+    if (width > 0.0)
+    {
+      pointBucket = std::min(static_cast<int64_t>(_buckets) - 1,
+          static_cast<int64_t>(std::floor((_point.X() - _xMin) / width)));
+    }
+
+    if (pointBucket != bucket)
+    {
+      flush();
+      bucket = pointBucket;
+      low = high = _point;
+      lowIndex = highIndex = index;
+    }
+    else if (_point.Y() < low.Y())
+    {
+      low = _point;
+      lowIndex = index;
+    }
+    else if (_point.Y() > high.Y())
+    {
+      high = _point;
+      highIndex = index;
+    }
+    ++index;
+  });
+  flush();
+
+  return points;
+}
+
+/////////////////////////////////////////////////
+std::vector<math::Vector2d> TimeSeries::Decimated(
+    unsigned int _buckets) const
+{
+  if (this->dataPtr->chunks.empty())
+    return {};
+
+  const double xMin = std::max(this->dataPtr->chunks.front().front().X(),
+      this->dataPtr->Cutoff());
+  const double xMax = this->dataPtr->chunks.back().back().X();
+  return this->Decimated(xMin, xMax, _buckets);
+}
+
+class DecimatedView::Implementation
+{
+  /// \brief Index of the slice holding a time
+  /// \param[in] _x Time
+  /// \return Slice index
+  public: int64_t Slice(double _x) const;
+
+  /// \brief Forget the kept slices and the points
+  public: void Clear();
+
+  /// \brief Duration of a slice
+  public: double width{0.0};
+
+  /// \brief Whether `begin` and `completeEnd` are set
+  public: bool valid{false};
+
+  /// \brief First kept slice
+  public: int64_t begin{0};
+
+  /// \brief Slices from `begin` to this one, excluded, won't change
+  /// anymore
+  public: int64_t completeEnd{0};
+
+  /// \brief Number of points in the slices which won't change anymore,
+  /// at the start of `points`
+  public: std::size_t completeCount{0};
+
+  /// \brief Decimated points
+  public: std::vector<math::Vector2d> points;
+};
+
+/////////////////////////////////////////////////
+int64_t DecimatedView::Implementation::Slice(double _x) const
+{
+  // Clamped so far away times can't overflow
+  constexpr double kLimit = static_cast<double>(int64_t{1} << 62);
+  return static_cast<int64_t>(
+      std::clamp(std::floor(_x / this->width), -kLimit, kLimit));
+}
+
+/////////////////////////////////////////////////
+void DecimatedView::Implementation::Clear()
+{
+  this->valid = false;
+  this->completeCount = 0;
+  this->points.clear();
+}
+
+/////////////////////////////////////////////////
+DecimatedView::DecimatedView()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+DecimatedView::~DecimatedView() = default;
+
+/////////////////////////////////////////////////
+void DecimatedView::Reset()
+{
+  this->dataPtr->Clear();
+}
+
+/////////////////////////////////////////////////
+const std::vector<math::Vector2d> &DecimatedView::Points() const
+{
+  return this->dataPtr->points;
+}
+
+/////////////////////////////////////////////////
+bool DecimatedView::Update(const TimeSeries &_series, double _xMin,
+    double _xMax, unsigned int _buckets)
+{
+  auto &d = *this->dataPtr;
+  if (_buckets == 0 || !(_xMax > _xMin) || _series.Empty())
+  {
+    const bool changed = !d.points.empty();
+    d.Clear();
+    return changed;
+  }
+
+  bool changed{false};
+  const double width = (_xMax - _xMin) / _buckets;
+  if (!d.valid || std::abs(width - d.width) > 1e-9 * width)
+  {
+    changed = !d.points.empty();
+    d.Clear();
+    d.width = width;
+  }
+
+  const int64_t first = std::max(d.Slice(_xMin), d.Slice(_series.Start()));
+  const int64_t last = d.Slice(_xMax);
+
+  // Scrolled back before the kept slices
+  if (d.valid && first < d.begin)
+  {
+    changed = changed || !d.points.empty();
+    d.Clear();
+  }
+  if (!d.valid)
+  {
+    d.valid = true;
+    d.begin = first;
+    d.completeEnd = first;
+  }
+
+  // Drop the kept slices which scrolled out, on either side
+  auto sliceStart = [&d](int64_t _slice)
+  {
+    return std::partition_point(d.points.begin(),
+        d.points.begin() + d.completeCount,
+        [&d, _slice](const math::Vector2d &_point)
+        {
+          return d.Slice(_point.X()) < _slice;
+        });
+  };
+  if (first > d.begin)
+  {
+    auto end = sliceStart(first);
+    const auto count = static_cast<std::size_t>(end - d.points.begin());
+    d.points.erase(d.points.begin(), end);
+    d.completeCount -= count;
+    changed = changed || count > 0;
+    d.begin = first;
+    d.completeEnd = std::max(d.completeEnd, first);
+  }
+  if (d.completeEnd > last + 1)
+  {
+    auto start = sliceStart(last + 1);
+    const auto count = static_cast<std::size_t>(
+        d.points.begin() + d.completeCount - start);
+    d.points.erase(start, d.points.begin() + d.completeCount);
+    d.completeCount -= count;
+    changed = changed || count > 0;
+    d.completeEnd = last + 1;
+  }
+
+  // Decimate the slices which may still change, keeping the extremes of
+  // each in the order they arrived, like TimeSeries::Decimated
+  std::vector<math::Vector2d> tail;
+  int64_t slice{d.completeEnd - 1};
+  math::Vector2d low;
+  math::Vector2d high;
+  std::size_t lowIndex{0};
+  std::size_t highIndex{0};
+  std::size_t index{0};
+  auto flush = [&]()
+  {
+    if (slice < d.completeEnd)
+      return;
+    if (lowIndex == highIndex)
+    {
+      tail.push_back(low);
+    }
+    else if (lowIndex < highIndex)
+    {
+      tail.push_back(low);
+      tail.push_back(high);
+    }
+    else
+    {
+      tail.push_back(high);
+      tail.push_back(low);
+    }
+  };
+  _series.dataPtr->Visit((d.completeEnd - 1) * width, (last + 1) * width,
+      [&](const math::Vector2d &_point)
+  {
+    const int64_t pointSlice = d.Slice(_point.X());
+    if (pointSlice < d.completeEnd || pointSlice > last)
+      return;
+    if (pointSlice != slice)
+    {
+      flush();
+      slice = pointSlice;
+      low = _point;
+      high = _point;
+      lowIndex = index;
+      highIndex = index;
+    }
+    else if (_point.Y() < low.Y())
+    {
+      low = _point;
+      lowIndex = index;
+    }
+    else if (_point.Y() > high.Y())
+    {
+      high = _point;
+      highIndex = index;
+    }
+    ++index;
+  });
+  flush();
+  if (!std::equal(d.points.begin() + d.completeCount, d.points.end(),
+      tail.begin(), tail.end(),
+      [](const math::Vector2d &_a, const math::Vector2d &_b)
+      {
+        return _a.X() == _b.X() && _a.Y() == _b.Y();
+      }))
+  {
+    d.points.resize(d.completeCount);
+    d.points.insert(d.points.end(), tail.begin(), tail.end());
+    changed = true;
+  }
+
+  // Points are appended in time order, so slices before the newest
+  // point's won't change anymore
+  const int64_t completeLimit = std::min(d.Slice(_series.End()), last + 1);
+  if (completeLimit > d.completeEnd)
+  {
+    auto end = std::partition_point(d.points.begin() + d.completeCount,
+        d.points.end(), [&d, completeLimit](const math::Vector2d &_point)
+        {
+          return d.Slice(_point.X()) < completeLimit;
+        });
+    d.completeCount = static_cast<std::size_t>(end - d.points.begin());
+    d.completeEnd = completeLimit;
+  }
+  return changed;
+}
+}  // namespace gz::gui
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/TimeSeries.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, Append)
+{
+  TimeSeries series;
+  EXPECT_EQ(0u, series.Size());
+  EXPECT_TRUE(series.Empty());
+  EXPECT_TRUE(series.Points().empty());
+  EXPECT_TRUE(series.Decimated(10).empty());
+
+  for (int i = 0; i < 10000; ++i)
+    series.Append(i * 0.001, i);
+  EXPECT_EQ(10000u, series.Size());
+
+  auto points = series.Points();
+  ASSERT_EQ(10000u, points.size());
+  for (int i = 0; i < 10000; ++i)
+  {
+    EXPECT_DOUBLE_EQ(i * 0.001, points[i].X());
+    EXPECT_DOUBLE_EQ(i, points[i].Y());
+  }
+
+  series.Clear();
+  EXPECT_EQ(0u, series.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, Retention)
+{
+  TimeSeries series;
+  EXPECT_DOUBLE_EQ(0.0, series.Retention());
+  series.SetRetention(10.0);
+  EXPECT_DOUBLE_EQ(10.0, series.Retention());
+
+  // 30 s at 1 kHz
+  for (int i = 0; i < 30000; ++i)
+    series.Append(i * 0.001, 1.0);
+
+  auto points = series.Points();
+  ASSERT_FALSE(points.empty());
+  EXPECT_NEAR(19.999, points.front().X(), 1.5e-3);
+  EXPECT_NEAR(29.999, points.back().X(), 1e-9);
+  EXPECT_EQ(points.size(), series.Size());
+  EXPECT_DOUBLE_EQ(points.front().X(), series.Start());
+  EXPECT_DOUBLE_EQ(points.back().X(), series.End());
+  EXPECT_GE(series.Size(), 10000u);
+  EXPECT_LE(series.Size(), 10002u);
+
+  // Point limit
+  series.SetRetention(0.0);
+  series.SetMaxPoints(5000);
+  EXPECT_EQ(5000u, series.MaxPoints());
+  for (int i = 30000; i < 60000; ++i)
+    series.Append(i * 0.001, 1.0);
+  EXPECT_GE(series.Size(), 5000u);
+  EXPECT_LT(series.Size(), 5000u + 4096u);
+  EXPECT_NEAR(59.999, series.Points().back().X(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, Decimated)
+{
+  TimeSeries series;
+  for (int i = 0; i < 100000; ++i)
+    series.Append(i * 0.001, std::sin(i * 0.01));
+
+  // Each bucket keeps its extremes, in time order
+  auto points = series.Decimated(500);
+  EXPECT_LE(points.size(), 1000u);
+  EXPECT_GE(points.size(), 500u);
+  for (std::size_t i = 1; i < points.size(); ++i)
+    EXPECT_LE(points[i - 1].X(), points[i].X());
+
+  double low{0.0};
+  double high{0.0};
+  for (const auto &point : points)
+  {
+    low = std::min(low, point.Y());
+    high = std::max(high, point.Y());
+  }
+  EXPECT_NEAR(-1.0, low, 1e-3);
+  EXPECT_NEAR(1.0, high, 1e-3);
+
+  // Small ranges are returned in full
+  points = series.Decimated(9.9995, 10.0045, 10);
+  ASSERT_EQ(5u, points.size());
+  EXPECT_NEAR(10.0, points.front().X(), 1e-9);
+
+  // Invalid input
+  EXPECT_TRUE(series.Decimated(0).empty());
+  EXPECT_TRUE(series.Decimated(10.0, 5.0, 10).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeSeriesTest, DecimatedView)
+{
+  TimeSeries series;
+  DecimatedView view;
+  EXPECT_FALSE(view.Update(series, 0.0, 1.0, 100));
+  EXPECT_TRUE(view.Points().empty());
+
+  // 1 kHz, shown 1 s at a time over 100 slices
+  auto append = [&series](int _from, int _to)
+  {
+    for (int i = _from; i < _to; ++i)
+      series.Append(i * 0.001, std::sin(i * 0.01));
+  };
+
+  // Points of a view decimating the whole range at once
+  auto expected = [&series](double _xMin, double _xMax,
+      unsigned int _buckets)
+  {
+    DecimatedView fresh;
+    fresh.Update(series, _xMin, _xMax, _buckets);
+    return fresh.Points();
+  };
+
+  append(0, 500);
+  EXPECT_TRUE(view.Update(series, 0.0, 1.0, 100));
+  EXPECT_EQ(series.Decimated(0.0, 1.0, 100), view.Points());
+  EXPECT_FALSE(view.Update(series, 0.0, 1.0, 100));
+
+  // New points only change the newest slices
+  append(500, 1000);
+  EXPECT_TRUE(view.Update(series, 0.0, 1.0, 100));
+  EXPECT_EQ(expected(0.0, 1.0, 100), view.Points());
+  EXPECT_LE(view.Points().size(), 200u);
+  EXPECT_FALSE(view.Update(series, 0.0, 1.0, 100));
+
+  // Scrolling keeps the slices still in range
+  append(1000, 1500);
+  EXPECT_TRUE(view.Update(series, 0.5, 1.5, 100));
+  auto points = view.Points();
+  ASSERT_FALSE(points.empty());
+  EXPECT_GE(points.front().X(), 0.5 - 1e-9);
+  EXPECT_EQ(expected(0.5, 1.5, 100), points);
+
+  // Scrolling back decimates again
+  EXPECT_TRUE(view.Update(series, 0.1, 1.1, 100));
+  EXPECT_EQ(expected(0.1, 1.1, 100), view.Points());
+
+  // So does zooming
+  EXPECT_TRUE(view.Update(series, 0.0, 1.5, 50));
+  EXPECT_LE(view.Points().size(), 102u);
+  EXPECT_EQ(expected(0.0, 1.5, 50), view.Points());
+
+  series.Clear();
+  EXPECT_TRUE(view.Update(series, 0.0, 1.5, 50));
+  EXPECT_TRUE(view.Points().empty());
+}
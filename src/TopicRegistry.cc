@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/TopicRegistry.hh"
+
+namespace gz::gui
+{
+class TopicRegistry::Implementation
+{
+  /// \brief Node used for discovery queries
+  public: transport::Node node;
+
+  /// \brief Protects `topics`
+  public: mutable std::mutex dataMutex;
+
+  /// \brief Message types published on each known topic
+  public: std::map<std::string, std::vector<std::string>> topics;
+
+  /// \brief Only one scan runs at a time
+  public: std::mutex scanMutex;
+
+  /// \brief Protects the members below, used to wake up the thread
+  public: std::mutex threadMutex;
+
+  /// \brief Wakes up the scanning thread
+  public: std::condition_variable threadCv;
+
+  /// \brief Time between background scans
+  public: std::chrono::milliseconds period{1000};
+
+  /// \brief True when a scan was requested through Refresh
+  public: bool refreshRequested{false};
+
+  /// \brief True to stop the thread
+  public: bool stopping{false};
+
+  /// \brief Background scanning thread
+  public: std::thread thread;
+};
+
+/////////////////////////////////////////////////
+TopicRegistry::TopicRegistry()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->thread = std::thread([this]
+  {
+    auto lastScan = std::chrono::steady_clock::now();
+    while (true)
+    {
+      {
+        // The period is checked again on every wake up, in case it changed
+        std::unique_lock<std::mutex> lock(this->dataPtr->threadMutex);
+        while (!this->dataPtr->stopping && !this->dataPtr->refreshRequested &&
+            std::chrono::steady_clock::now() < lastScan + this->dataPtr->period)
+        {
+          this->dataPtr->threadCv.wait_until(lock,
+              lastScan + this->dataPtr->period);
+        }
+        if (this->dataPtr->stopping)
+          return;
+        this->dataPtr->refreshRequested = false;
+      }
+      this->Scan();
+      lastScan = std::chrono::steady_clock::now();
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+TopicRegistry::~TopicRegistry()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->threadMutex);
+    this->dataPtr->stopping = true;
+  }
+  this->dataPtr->threadCv.notify_all();
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> TopicRegistry::Topics(
+    const std::string &_msgType) const
+{
+  std::vector<std::string> result;
+  std::lock_guard<std::mutex> lock(this->dataPtr->dataMutex);
+  for (const auto &[topic, types] : this->dataPtr->topics)
+  {
+    if (_msgType.empty() ||
+        std::find(types.begin(), types.end(), _msgType) != types.end())
+    {
+      result.push_back(topic);
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> TopicRegistry::MsgTypes(
+    const std::string &_topic) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->dataMutex);
+  auto it = this->dataPtr->topics.find(_topic);
+  if (it == this->dataPtr->topics.end())
+    return {};
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+void TopicRegistry::Scan()
+{
+  std::lock_guard<std::mutex> scanLock(this->dataPtr->scanMutex);
+
+  std::vector<std::string> allTopics;
+  this->dataPtr->node.TopicList(allTopics);
+  const std::set<std::string> current(allTopics.begin(), allTopics.end());
+
+  // Only topics which weren't known yet need a discovery query. Scans don't
+  // run in parallel, so the cache can be read without holding the lock
+  // while querying.
+  std::vector<std::string> removed;
+  std::map<std::string, std::vector<std::string>> added;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->dataMutex);
+    for (const auto &entry : this->dataPtr->topics)
+    {
+      if (current.find(entry.first) == current.end())
+        removed.push_back(entry.first);
+    }
+    for (const auto &topic : current)
+    {
+      if (this->dataPtr->topics.find(topic) == this->dataPtr->topics.end())
+        added[topic];
+    }
+  }
+
+  for (auto it = added.begin(); it != added.end();)
+  {
+    std::vector<transport::MessagePublisher> publishers;
+    std::vector<transport::MessagePublisher> subscribers;
+    this->dataPtr->node.TopicInfo(it->first, publishers, subscribers);
+    for (const auto &pub : publishers)
+    {
+      if (std::find(it->second.begin(), it->second.end(),
+          pub.MsgTypeName()) == it->second.end())
+      {
+        it->second.push_back(pub.MsgTypeName());
+      }
+    }
+
+    // Try again on the next scan if the publishers aren't known yet
+    if (it->second.empty())
+      it = added.erase(it);
+    else
+      ++it;
+  }
+
+  if (added.empty() && removed.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->dataMutex);
+    for (const auto &topic : removed)
+      this->dataPtr->topics.erase(topic);
+    for (auto &[topic, types] : added)
+      this->dataPtr->topics[topic] = std::move(types);
+  }
+
+  for (const auto &topic : removed)
+    emit this->TopicRemoved(QString::fromStdString(topic));
+  for (const auto &entry : added)
+    emit this->TopicAdded(QString::fromStdString(entry.first));
+  emit this->TopicsChanged();
+}
+
+/////////////////////////////////////////////////
+void TopicRegistry::Refresh()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->threadMutex);
+    this->dataPtr->refreshRequested = true;
+  }
+  this->dataPtr->threadCv.notify_all();
+}
+
+/////////////////////////////////////////////////
+void TopicRegistry::SetScanPeriod(const std::chrono::milliseconds &_period)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->threadMutex);
+    this->dataPtr->period = _period;
+  }
+  this->dataPtr->threadCv.notify_all();
+}
+}  // namespace gz::gui
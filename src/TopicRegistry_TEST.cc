@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/TopicRegistry.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./TopicRegistry_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TopicRegistryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Scan))
+{
+  TopicRegistry registry;
+
+  std::vector<std::string> added;
+  std::vector<std::string> removed;
+  int changed{0};
+  QObject::connect(&registry, &TopicRegistry::TopicAdded,
+      [&added](const QString &_topic){added.push_back(_topic.toStdString());});
+  QObject::connect(&registry, &TopicRegistry::TopicRemoved,
+      [&removed](const QString &_topic)
+      {
+        removed.push_back(_topic.toStdString());
+      });
+  QObject::connect(&registry, &TopicRegistry::TopicsChanged,
+      [&changed](){changed++;});
+
+  auto contains = [](const std::vector<std::string> &_list,
+      const std::string &_topic)
+  {
+    return std::find(_list.begin(), _list.end(), _topic) != _list.end();
+  };
+
+  // Keep the background thread from scanning while checking signals
+  registry.SetScanPeriod(std::chrono::hours(1));
+
+  auto node = std::make_unique<transport::Node>();
+  auto pubImage = node->Advertise<msgs::Image>("/registry_image");
+  auto pubString = node->Advertise<msgs::StringMsg>("/registry_string");
+  registry.Scan();
+
+  auto imageTopics = registry.Topics("gz.msgs.Image");
+  ASSERT_EQ(1u, imageTopics.size());
+  EXPECT_EQ("/registry_image", imageTopics[0]);
+  EXPECT_TRUE(contains(registry.Topics(), "/registry_image"));
+  EXPECT_TRUE(contains(registry.Topics(), "/registry_string"));
+  EXPECT_TRUE(registry.Topics("gz.msgs.Bogus").empty());
+
+  EXPECT_EQ(std::vector<std::string>({"gz.msgs.StringMsg"}),
+      registry.MsgTypes("/registry_string"));
+  EXPECT_TRUE(registry.MsgTypes("/registry_unknown").empty());
+
+  // Signals emitted from the calling thread arrive directly
+  EXPECT_TRUE(contains(added, "/registry_image"));
+  EXPECT_TRUE(contains(added, "/registry_string"));
+  EXPECT_EQ(1, changed);
+
+  // Nothing new
+  int changedBefore = changed;
+  registry.Scan();
+  EXPECT_EQ(changedBefore, changed);
+
+  // Removing the publishers removes the topics
+  pubImage = transport::Node::Publisher();
+  pubString = transport::Node::Publisher();
+  node.reset();
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (contains(registry.Topics(), "/registry_image") && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    registry.Scan();
+    ++sleep;
+  }
+  EXPECT_FALSE(contains(registry.Topics(), "/registry_image"));
+  EXPECT_TRUE(contains(removed, "/registry_image"));
+  EXPECT_GT(changed, changedBefore);
+}
+
+/////////////////////////////////////////////////
+TEST(TopicRegistryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(BackgroundScan))
+{
+  TopicRegistry registry;
+  registry.SetScanPeriod(std::chrono::milliseconds(50));
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>("/registry_background");
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (registry.Topics("gz.msgs.Image").empty() && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ++sleep;
+  }
+  ASSERT_EQ(1u, registry.Topics("gz.msgs.Image").size());
+  EXPECT_EQ("/registry_background", registry.Topics("gz.msgs.Image")[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(TopicRegistryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Application))
+{
+  gui::Application app(g_argc, g_argv);
+
+  auto registry = app.Topics();
+  ASSERT_NE(nullptr, registry);
+  EXPECT_EQ(registry, app.Topics());
+}
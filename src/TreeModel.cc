@@ -0,0 +1,424 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/Enums.hh"
+#include "gz/gui/TreeModel.hh"
+
+namespace gz::gui
+{
+/// \brief Parent of the ids which are free to be reused
+static constexpr int kFree = -2;
+
+class TreeModel::Implementation
+{
+  /// \brief Get the children of a node
+  /// \param[in] _node Valid node, or kRoot
+  /// \return Children, in row order
+  public: std::vector<int> &ChildrenOf(int _node)
+  {
+    return _node == kRoot ? this->roots : this->children[_node];
+  }
+
+  /// \brief Get the children of a node
+  /// \param[in] _node Valid node, or kRoot
+  /// \return Children, in row order
+  public: const std::vector<int> &ChildrenOf(int _node) const
+  {
+    return _node == kRoot ? this->roots : this->children[_node];
+  }
+
+  /// \brief Whether a node exists
+  /// \param[in] _node Node
+  /// \return True if it does
+  public: bool Valid(int _node) const
+  {
+    return _node >= 0 && _node < static_cast<int>(this->parents.size()) &&
+        this->parents[_node] != kFree;
+  }
+
+  /// \brief Update the rows of children, from a row to the last one
+  /// \param[in] _parent Parent node, or kRoot
+  /// \param[in] _row First row to update
+  public: void Renumber(int _parent, int _row)
+  {
+    const auto &siblings = this->ChildrenOf(_parent);
+    for (int row = _row; row < static_cast<int>(siblings.size()); ++row)
+      this->rows[siblings[row]] = row;
+  }
+
+  /// \brief Parent of each node, kRoot for top level nodes and kFree for
+  /// reusable ids
+  public: std::vector<int> parents;
+
+  /// \brief Row of each node under its parent
+  public: std::vector<int> rows;
+
+  /// \brief Children of each node, in row order. Leaves don't allocate.
+  public: std::vector<std::vector<int>> children;
+
+  /// \brief Top level nodes, in row order
+  public: std::vector<int> roots;
+
+  /// \brief Removed ids, reused before growing the arrays
+  public: std::vector<int> freeIds;
+
+  /// \brief Number of nodes
+  public: std::size_t count{0};
+
+  /// \brief Depth of BeginReset calls
+  public: int resetDepth{0};
+};
+
+/////////////////////////////////////////////////
+TreeModel::TreeModel()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+TreeModel::~TreeModel() = default;
+
+/////////////////////////////////////////////////
+std::vector<int> TreeModel::InsertNodes(int _parent, int _row, int _count)
+{
+  if (_count <= 0 || (_parent != kRoot && !this->dataPtr->Valid(_parent)))
+    return {};
+
+  if (_row < 0 || _row > this->ChildCount(_parent))
+    return {};
+
+  // New ids aren't reachable through indices until they're linked
+  std::vector<int> nodes;
+  nodes.reserve(_count);
+  for (int i = 0; i < _count; ++i)
+  {
+    int node;
+    if (!this->dataPtr->freeIds.empty())
+    {
+      node = this->dataPtr->freeIds.back();
+      this->dataPtr->freeIds.pop_back();
+    }
+    else
+    {
+      node = static_cast<int>(this->dataPtr->parents.size());
+      this->dataPtr->parents.push_back(kFree);
+      this->dataPtr->rows.push_back(-1);
+      this->dataPtr->children.emplace_back();
+    }
+    this->dataPtr->parents[node] = _parent;
+    nodes.push_back(node);
+  }
+  this->NodesInserting(nodes);
+
+  const bool notify = this->dataPtr->resetDepth == 0;
+  if (notify)
+  {
+    this->beginInsertRows(this->IndexOf(_parent), _row, _row + _count - 1);
+  }
+  // Taken once the arrays grew
+  auto &siblings = this->dataPtr->ChildrenOf(_parent);
+  siblings.insert(siblings.begin() + _row, nodes.begin(), nodes.end());
+  this->dataPtr->Renumber(_parent, _row);
+  this->dataPtr->count += nodes.size();
+  if (notify)
+    this->endInsertRows();
+
+  return nodes;
+}
+
+/////////////////////////////////////////////////
+std::vector<int> TreeModel::AppendNodes(int _parent, int _count)
+{
+  return this->InsertNodes(_parent, this->ChildCount(_parent), _count);
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::RemoveNodes(int _parent, int _row, int _count)
+{
+  if (_count <= 0 || (_parent != kRoot && !this->dataPtr->Valid(_parent)))
+    return false;
+
+  auto &siblings = this->dataPtr->ChildrenOf(_parent);
+  if (_row < 0 || _row + _count > static_cast<int>(siblings.size()))
+    return false;
+
+  const bool notify = this->dataPtr->resetDepth == 0;
+  if (notify)
+  {
+    this->beginRemoveRows(this->IndexOf(_parent), _row, _row + _count - 1);
+  }
+
+  // The nodes and their descendants
+  std::vector<int> removed(siblings.begin() + _row,
+      siblings.begin() + _row + _count);
+  for (std::size_t i = 0; i < removed.size(); ++i)
+  {
+    const auto &nodeChildren = this->dataPtr->children[removed[i]];
+    removed.insert(removed.end(), nodeChildren.begin(), nodeChildren.end());
+  }
+
+  siblings.erase(siblings.begin() + _row, siblings.begin() + _row + _count);
+  this->dataPtr->Renumber(_parent, _row);
+  for (auto node : removed)
+  {
+    this->dataPtr->parents[node] = kFree;
+    this->dataPtr->rows[node] = -1;
+    std::vector<int>().swap(this->dataPtr->children[node]);
+    this->dataPtr->freeIds.push_back(node);
+  }
+  this->dataPtr->count -= removed.size();
+
+  if (notify)
+    this->endRemoveRows();
+
+  this->NodesRemoved(removed);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::RemoveNode(int _node)
+{
+  if (!this->dataPtr->Valid(_node))
+    return false;
+  return this->RemoveNodes(this->dataPtr->parents[_node],
+      this->dataPtr->rows[_node], 1);
+}
+
+/////////////////////////////////////////////////
+void TreeModel::Clear()
+{
+  std::vector<int> removed;
+  removed.reserve(this->dataPtr->count);
+  for (int node = 0; node < static_cast<int>(this->dataPtr->parents.size());
+      ++node)
+  {
+    if (this->dataPtr->parents[node] != kFree)
+      removed.push_back(node);
+  }
+
+  this->BeginReset();
+  this->dataPtr->parents.clear();
+  this->dataPtr->rows.clear();
+  this->dataPtr->children.clear();
+  this->dataPtr->roots.clear();
+  this->dataPtr->freeIds.clear();
+  this->dataPtr->count = 0;
+  this->EndReset();
+
+  if (!removed.empty())
+    this->NodesRemoved(removed);
+}
+
+/////////////////////////////////////////////////
+void TreeModel::BeginReset()
+{
+  if (this->dataPtr->resetDepth++ == 0)
+    this->beginResetModel();
+}
+
+/////////////////////////////////////////////////
+void TreeModel::EndReset()
+{
+  if (this->dataPtr->resetDepth == 0)
+    return;
+  if (--this->dataPtr->resetDepth == 0)
+    this->endResetModel();
+}
+
+/////////////////////////////////////////////////
+void TreeModel::NodesChanged(const std::vector<int> &_nodes,
+    const QVector<int> &_roles)
+{
+  if (this->dataPtr->resetDepth > 0)
+    return;
+
+  // First and last row changed under each parent
+  std::unordered_map<int, std::pair<int, int>> ranges;
+  for (auto node : _nodes)
+  {
+    if (!this->dataPtr->Valid(node))
+      continue;
+    const int row = this->dataPtr->rows[node];
+    auto [it, added] = ranges.try_emplace(this->dataPtr->parents[node],
+        row, row);
+    if (!added)
+    {
+      it->second.first = std::min(it->second.first, row);
+      it->second.second = std::max(it->second.second, row);
+    }
+  }
+
+  for (const auto &[parent, range] : ranges)
+  {
+    const auto parentIndex = this->IndexOf(parent);
+    emit this->dataChanged(this->index(range.first, 0, parentIndex),
+        this->index(range.second, this->columnCount(parentIndex) - 1,
+        parentIndex), _roles);
+  }
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::Valid(int _node) const
+{
+  return this->dataPtr->Valid(_node);
+}
+
+/////////////////////////////////////////////////
+int TreeModel::Parent(int _node) const
+{
+  return this->dataPtr->Valid(_node) ? this->dataPtr->parents[_node] : kRoot;
+}
+
+/////////////////////////////////////////////////
+int TreeModel::Row(int _node) const
+{
+  return this->dataPtr->Valid(_node) ? this->dataPtr->rows[_node] : -1;
+}
+
+/////////////////////////////////////////////////
+int TreeModel::ChildCount(int _node) const
+{
+  if (_node != kRoot && !this->dataPtr->Valid(_node))
+    return 0;
+  return static_cast<int>(this->dataPtr->ChildrenOf(_node).size());
+}
+
+/////////////////////////////////////////////////
+int TreeModel::Child(int _node, int _row) const
+{
+  if (_row < 0 || _row >= this->ChildCount(_node))
+    return kRoot;
+  return this->dataPtr->ChildrenOf(_node)[_row];
+}
+
+/////////////////////////////////////////////////
+std::size_t TreeModel::NodeCount() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+QModelIndex TreeModel::IndexOf(int _node, int _column) const
+{
+  if (!this->dataPtr->Valid(_node))
+    return QModelIndex();
+  return this->createIndex(this->dataPtr->rows[_node], _column,
+      static_cast<quintptr>(_node));
+}
+
+/////////////////////////////////////////////////
+int TreeModel::NodeOf(const QModelIndex &_index) const
+{
+  if (!_index.isValid() || _index.model() != this)
+    return kRoot;
+  return static_cast<int>(_index.internalId());
+}
+
+/////////////////////////////////////////////////
+void TreeModel::NodesInserting(const std::vector<int> &)
+{
+}
+
+/////////////////////////////////////////////////
+void TreeModel::NodesRemoved(const std::vector<int> &)
+{
+}
+
+/////////////////////////////////////////////////
+QModelIndex TreeModel::index(int _row, int _column,
+    const QModelIndex &_parent) const
+{
+  if (_column < 0 || _column >= this->columnCount(_parent) ||
+      _parent.column() > 0)
+  {
+    return QModelIndex();
+  }
+
+  const int node = this->Child(this->NodeOf(_parent), _row);
+  if (node == kRoot)
+    return QModelIndex();
+  return this->createIndex(_row, _column, static_cast<quintptr>(node));
+}
+
+/////////////////////////////////////////////////
+QModelIndex TreeModel::parent(const QModelIndex &_index) const
+{
+  return this->IndexOf(this->Parent(this->NodeOf(_index)));
+}
+
+/////////////////////////////////////////////////
+int TreeModel::rowCount(const QModelIndex &_parent) const
+{
+  // Only the first column has children
+  if (_parent.column() > 0)
+    return 0;
+  return this->ChildCount(this->NodeOf(_parent));
+}
+
+/////////////////////////////////////////////////
+int TreeModel::columnCount(const QModelIndex &) const
+{
+  return 1;
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::hasChildren(const QModelIndex &_parent) const
+{
+  return this->rowCount(_parent) > 0;
+}
+
+/////////////////////////////////////////////////
+QVariant TreeModel::data(const QModelIndex &_index, int _role) const
+{
+  const int node = this->NodeOf(_index);
+  if (!this->dataPtr->Valid(node))
+    return QVariant();
+  return this->NodeData(node, _index.column(), _role);
+}
+
+/////////////////////////////////////////////////
+Qt::ItemFlags TreeModel::flags(const QModelIndex &_index) const
+{
+  if (!this->dataPtr->Valid(this->NodeOf(_index)))
+    return Qt::NoItemFlags;
+  return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+}
+
+/////////////////////////////////////////////////
+QMimeData *TreeModel::mimeData(const QModelIndexList &_indexes) const
+{
+  QMimeData *curMimeData = new QMimeData();
+
+  for (auto const &idx : _indexes)
+  {
+    if (idx.isValid())
+    {
+      QString text = this->data(idx, DataRole::URI_QUERY).toString();
+      curMimeData->setData("application/x-item", text.toLatin1().data());
+
+      break;
+    }
+  }
+
+  return curMimeData;
+}
+}  // namespace gz::gui
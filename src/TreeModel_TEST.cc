@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gz/gui/Enums.hh"
+#include "gz/gui/SearchModel.hh"
+#include "gz/gui/TreeModel.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Tree of names, kept in an array indexed by node
+class NameTree : public TreeModel
+{
+  /// \brief Add named children to a node
+  /// \param[in] _parent Parent node
+  /// \param[in] _names Names of the children
+  /// \return Ids of the children
+  public: std::vector<int> Add(int _parent,
+      const std::vector<std::string> &_names)
+  {
+    this->pending = _names;
+    return this->AppendNodes(_parent, static_cast<int>(_names.size()));
+  }
+
+  // Documentation inherited
+  protected: QVariant NodeData(int _node, int, int _role) const override
+  {
+    if (_role != DataRole::DISPLAY_NAME && _role != Qt::DisplayRole)
+      return QVariant();
+    return QString::fromStdString(this->names[_node]);
+  }
+
+  // Documentation inherited
+  protected: void NodesInserting(const std::vector<int> &_nodes) override
+  {
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+    {
+      if (_nodes[i] >= static_cast<int>(this->names.size()))
+        this->names.resize(_nodes[i] + 1);
+      this->names[_nodes[i]] = this->pending[i];
+    }
+  }
+
+  // Documentation inherited
+  protected: void NodesRemoved(const std::vector<int> &_nodes) override
+  {
+    this->removed += static_cast<int>(_nodes.size());
+  }
+
+  /// \brief Name of each node
+  public: std::vector<std::string> names;
+
+  /// \brief Names of the nodes being added
+  public: std::vector<std::string> pending;
+
+  /// \brief Number of nodes removed
+  public: int removed{0};
+};
+
+/////////////////////////////////////////////////
+TEST(TreeModelTest, Structure)
+{
+  NameTree model;
+  EXPECT_EQ(0, model.rowCount());
+  EXPECT_EQ(0u, model.NodeCount());
+
+  // - robot
+  // -- base_link
+  // -- arm
+  // - ground
+  const auto top = model.Add(TreeModel::kRoot, {"robot", "ground"});
+  ASSERT_EQ(2u, top.size());
+  const auto links = model.Add(top[0], {"base_link", "arm"});
+  ASSERT_EQ(2u, links.size());
+  EXPECT_EQ(4u, model.NodeCount());
+
+  EXPECT_EQ(2, model.rowCount());
+  EXPECT_TRUE(model.hasChildren(model.IndexOf(top[0])));
+  EXPECT_FALSE(model.hasChildren(model.IndexOf(top[1])));
+  EXPECT_EQ(top[0], model.Parent(links[1]));
+  EXPECT_EQ(1, model.Row(links[1]));
+  EXPECT_EQ(links[1], model.Child(top[0], 1));
+  EXPECT_EQ(TreeModel::kRoot, model.Child(top[0], 2));
+
+  // Indices round trip
+  const auto arm = model.index(1, 0, model.index(0, 0));
+  EXPECT_EQ("arm", arm.data(DataRole::DISPLAY_NAME).toString());
+  EXPECT_EQ(links[1], model.NodeOf(arm));
+  EXPECT_EQ(model.index(0, 0), arm.parent());
+  EXPECT_FALSE(model.index(0, 0).parent().isValid());
+  EXPECT_FALSE(model.index(2, 0).isValid());
+  EXPECT_FALSE(model.index(0, 1).isValid());
+
+  // Inserted in the middle, later rows move down
+  model.pending = {"camera"};
+  const auto camera = model.InsertNodes(top[0], 1, 1);
+  ASSERT_EQ(1u, camera.size());
+  EXPECT_EQ(1, model.Row(camera[0]));
+  EXPECT_EQ(2, model.Row(links[1]));
+  EXPECT_EQ("arm",
+      model.index(2, 0, model.IndexOf(top[0])).data().toString());
+
+  // Invalid parents and rows
+  EXPECT_TRUE(model.InsertNodes(1000, 0, 1).empty());
+  EXPECT_TRUE(model.InsertNodes(top[0], 5, 1).empty());
+  EXPECT_FALSE(model.RemoveNodes(top[0], 2, 2));
+  EXPECT_FALSE(model.RemoveNode(1000));
+}
+
+/////////////////////////////////////////////////
+TEST(TreeModelTest, Remove)
+{
+  NameTree model;
+  const auto top = model.Add(TreeModel::kRoot, {"a", "b", "c"});
+  const auto children = model.Add(top[1], {"b1", "b2"});
+  model.Add(children[0], {"b1a"});
+  EXPECT_EQ(6u, model.NodeCount());
+
+  // Descendants go along
+  EXPECT_TRUE(model.RemoveNode(top[1]));
+  EXPECT_EQ(4, model.removed);
+  EXPECT_EQ(2u, model.NodeCount());
+  EXPECT_FALSE(model.Valid(top[1]));
+  EXPECT_FALSE(model.Valid(children[0]));
+  EXPECT_EQ(1, model.Row(top[2]));
+  EXPECT_EQ("c", model.index(1, 0).data().toString());
+
+  // Ids are reused
+  const auto again = model.Add(top[0], {"a1", "a2", "a3", "a4", "a5"});
+  EXPECT_EQ(7u, model.NodeCount());
+  EXPECT_EQ(7u, model.names.size());
+  EXPECT_EQ("a5", model.index(4, 0, model.index(0, 0)).data().toString());
+
+  model.Clear();
+  EXPECT_EQ(0u, model.NodeCount());
+  EXPECT_EQ(0, model.rowCount());
+  EXPECT_EQ(11, model.removed);
+  EXPECT_FALSE(model.Valid(again[0]));
+}
+
+/////////////////////////////////////////////////
+TEST(TreeModelTest, Signals)
+{
+  NameTree model;
+  int inserted{0};
+  int removed{0};
+  int changed{0};
+  int resets{0};
+  QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+      [&]() { ++inserted; });
+  QObject::connect(&model, &QAbstractItemModel::rowsRemoved,
+      [&]() { ++removed; });
+  QObject::connect(&model, &QAbstractItemModel::dataChanged,
+      [&]() { ++changed; });
+  QObject::connect(&model, &QAbstractItemModel::modelReset,
+      [&]() { ++resets; });
+
+  // One notification per batch
+  const std::vector<std::string> names(1000, "entity");
+  const auto top = model.Add(TreeModel::kRoot, names);
+  EXPECT_EQ(1, inserted);
+  EXPECT_TRUE(model.RemoveNodes(TreeModel::kRoot, 10, 500));
+  EXPECT_EQ(1, removed);
+
+  // One change per parent
+  const auto children = model.Add(top[0], {"x", "y", "z"});
+  EXPECT_EQ(2, inserted);
+  model.NodesChanged({top[1], top[5], children[0], children[2], 1000000});
+  EXPECT_EQ(2, changed);
+
+  // Nothing until the outermost reset ends
+  model.BeginReset();
+  model.BeginReset();
+  model.Add(top[0], names);
+  model.RemoveNode(children[1]);
+  model.NodesChanged({top[1]});
+  model.EndReset();
+  EXPECT_EQ(0, resets);
+  model.EndReset();
+  EXPECT_EQ(1, resets);
+  EXPECT_EQ(2, inserted);
+  EXPECT_EQ(1, removed);
+  EXPECT_EQ(2, changed);
+  EXPECT_EQ(1002, model.rowCount(model.IndexOf(top[0])));
+}
+
+/////////////////////////////////////////////////
+TEST(TreeModelTest, Search)
+{
+  // - robot
+  // -- base_link
+  // -- arm
+  // --- gripper
+  // - ground
+  NameTree model;
+  const auto top = model.Add(TreeModel::kRoot, {"robot", "ground"});
+  const auto links = model.Add(top[0], {"base_link", "arm"});
+  model.Add(links[1], {"gripper"});
+
+  SearchModel searchModel;
+  searchModel.setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel.setSourceModel(&model);
+  EXPECT_EQ(2, searchModel.rowCount());
+
+  searchModel.SetSearch("grip");
+  ASSERT_EQ(1, searchModel.rowCount());
+  auto robot = searchModel.index(0, 0);
+  EXPECT_TRUE(searchModel.data(robot, DataRole::TO_EXPAND).toBool());
+  ASSERT_EQ(1, searchModel.rowCount(robot));
+  EXPECT_EQ("arm", searchModel.index(0, 0, robot).data().toString());
+
+  // Added and changed nodes are filtered
+  model.Add(TreeModel::kRoot, {"gripper_spare"});
+  EXPECT_EQ(2, searchModel.rowCount());
+
+  model.names[top[1]] = "ground_grip";
+  model.NodesChanged({top[1]}, {DataRole::DISPLAY_NAME});
+  EXPECT_EQ(3, searchModel.rowCount());
+
+  // And so are nodes added while resetting
+  model.BeginReset();
+  model.Clear();
+  model.Add(TreeModel::kRoot, {"table", "chair"});
+  model.EndReset();
+  EXPECT_EQ(0, searchModel.rowCount());
+  searchModel.SetSearch("");
+  EXPECT_EQ(2, searchModel.rowCount());
+}
@@ -25,6 +25,8 @@ GZ_GUI_COMPLETION_LIST="
   -s --standalone
   -c --config
   -v --verbose
+  --startup-trace
+  --gpu
   -h --help
   --force-version
   --versions
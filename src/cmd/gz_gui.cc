@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Native `gz-gui` launcher. It takes the same options as `gz gui` without
+// going through Ruby, and validates the config before starting Qt. With
+// `--server`, it starts a warm process which waits with its application and
+// main window initialized, and which opens the windows of later launches,
+// sharing the QML engine, plugin libraries and render engine between them.
+// Warm servers are per GPU, so several can serve windows on different cards.
+
+#include <tinyxml2.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QProcess>
+#include <QQuickWindow>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/config.hh"
+#include "gz/gui/GpuSelection.hh"
+#include "gz/gui/gz.hh"
+#include "gz/gui/MainWindow.hh"
+
+namespace
+{
+/// \brief Command line options
+struct Options
+{
+  /// \brief Config file to open, empty for the default one
+  std::string config;
+
+  /// \brief Plugin to run standalone
+  std::string standalone;
+
+  /// \brief Console verbosity
+  std::string verbose{"1"};
+
+  /// \brief Startup trace file
+  std::string startupTrace;
+
+  /// \brief GPU to render on, empty for the default one
+  std::string gpu;
+
+  /// \brief True to list the plugins
+  bool list{false};
+
+  /// \brief True to run as a warm server
+  bool server{false};
+
+  /// \brief True to never use a warm server
+  bool noServer{false};
+};
+
+/// \brief Usage message, after the command
+constexpr const char *kUsage =
+    " [options]\n\n"
+    "Options:\n\n"
+    "  -l [ --list ]              List all available plugins.\n\n"
+    "  -s [ --standalone ] arg    Run a plugin as a standalone window.\n\n"
+    "  -c [ --config ] arg        Open the main window with a configuration "
+    "file.\n\n"
+    "  -v [ --verbose ] [arg]     Adjust the level of console output (0~4).\n"
+    "                             Without arguments, level 3.\n\n"
+    "  --startup-trace arg        Write a timeline of the startup to a file,\n"
+    "                             in the Chrome trace event format.\n\n"
+    "  --gpu arg                  Render on a GPU, given its index or part of\n"
+    "                             its name, such as 1 or nvidia.\n\n"
+    "  --server                   Start a warm process which later main\n"
+    "                             windows are opened in.\n\n"
+    "  --no-server                Don't use a warm process even if one is\n"
+    "                             running.\n\n"
+    "  --version                  Print the version.\n\n"
+    "  -h [ --help ]              Print this help message.\n";
+
+/// \brief How long to wait for a warm server to accept a window
+constexpr int kServerTimeoutMs{1000};
+
+//////////////////////////////////////////////////
+/// \brief Name of the local socket of the warm server, per version, user
+/// and GPU
+/// \param[in] _gpu GPU the server renders on, empty for the default one
+/// \return Socket name
+QString serverName(const std::string &_gpu)
+{
+  auto name = QString("gz-gui%1-%2").arg(GZ_GUI_MAJOR_VERSION).arg(getuid());
+
+  QString gpu;
+  for (const unsigned char c : _gpu)
+  {
+    if (std::isalnum(c))
+      gpu += QChar(std::tolower(c));
+  }
+  if (!gpu.isEmpty())
+    name += "-gpu-" + gpu;
+  return name;
+}
+
+//////////////////////////////////////////////////
+/// \brief GPU a launch renders on: from the command line, then the
+/// environment, then the config
+/// \param[in] _options Options
+/// \return Index or name, empty for the default one
+std::string requestedGpu(const Options &_options)
+{
+  if (!_options.gpu.empty())
+    return _options.gpu;
+
+  auto gpu = gz::gui::GpuSelection::Requested();
+  if (gpu.empty())
+    gpu = gz::gui::GpuSelection::FromConfig(_options.config);
+  return gpu;
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse the command line
+/// \param[in] _argc Argument count
+/// \param[in] _argv Arguments
+/// \param[out] _options Options
+/// \return Exit code to return right away, or -1 to go on
+int parse(int _argc, char **_argv, Options &_options)
+{
+  for (int i = 1; i < _argc; ++i)
+  {
+    const std::string arg = _argv[i];
+    const bool hasValue = i + 1 < _argc && _argv[i + 1][0] != '-';
+    if (arg == "-h" || arg == "--help")
+    {
+      std::cout << "Gazebo GUI launcher.\n\n  " << _argv[0] << kUsage;
+      return 0;
+    }
+    else if (arg == "--version")
+    {
+      std::cout << GZ_GUI_VERSION_FULL << std::endl;
+      return 0;
+    }
+    else if (arg == "-l" || arg == "--list")
+    {
+      _options.list = true;
+    }
+    else if ((arg == "-c" || arg == "--config") && hasValue)
+    {
+      _options.config = _argv[++i];
+    }
+    else if ((arg == "-s" || arg == "--standalone") && hasValue)
+    {
+      _options.standalone = _argv[++i];
+    }
+    else if (arg == "-v" || arg == "--verbose")
+    {
+      _options.verbose = hasValue ? _argv[++i] : "3";
+    }
+    else if (arg == "--startup-trace" && hasValue)
+    {
+      _options.startupTrace = _argv[++i];
+    }
+    else if (arg == "--gpu" && hasValue)
+    {
+      _options.gpu = _argv[++i];
+    }
+    else if (arg == "--server")
+    {
+      _options.server = true;
+    }
+    else if (arg == "--no-server")
+    {
+      _options.noServer = true;
+    }
+    else
+    {
+      std::cerr << "Invalid argument [" << arg << "]\n\n  " << _argv[0]
+                << kUsage;
+      return 1;
+    }
+  }
+  return -1;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check a config file before starting Qt, if it's found relative to
+/// the working directory. Other paths are resolved by the application.
+/// \param[in, out] _config Config path, made absolute if found
+/// \return False if it's found and isn't valid XML
+bool validateConfig(std::string &_config)
+{
+  if (_config.empty() || !gz::common::isFile(_config))
+    return true;
+
+  tinyxml2::XMLDocument doc;
+  if (doc.LoadFile(_config.c_str()) != tinyxml2::XML_SUCCESS)
+  {
+    std::cerr << "Failed to parse config [" << _config << "]: "
+              << doc.ErrorStr() << std::endl;
+    return false;
+  }
+
+  _config = gz::common::absPath(_config);
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Hand the window to a warm server, if one's running
+/// \param[in] _options Options
+/// \return True if the server took it
+bool sendToServer(const Options &_options)
+{
+  int argc{1};
+  char arg0[] = "gz-gui";
+  char *argv[] = {arg0};
+  QCoreApplication app(argc, argv);
+
+  QLocalSocket socket;
+  socket.connectToServer(serverName(requestedGpu(_options)));
+  if (!socket.waitForConnected(kServerTimeoutMs))
+    return false;
+
+  // One line: verbosity, then the config, empty for the default window
+  socket.write(QByteArray::fromStdString(
+      _options.verbose + "\t" + _options.config + "\n"));
+  if (!socket.waitForBytesWritten(kServerTimeoutMs))
+    return false;
+
+  while (!socket.canReadLine())
+  {
+    if (!socket.waitForReadyRead(kServerTimeoutMs))
+      return false;
+  }
+  return socket.readLine() == "ok\n";
+}
+
+//////////////////////////////////////////////////
+/// \brief Run a warm server, which waits with its main window hidden until
+/// a launch hands it a config, and opens the configs of later launches in
+/// additional main windows
+/// \param[in] _argc Argument count
+/// \param[in] _argv Arguments
+/// \param[in] _options Options
+/// \return Exit code
+int runServer(int _argc, char **_argv, const Options &_options)
+{
+  const auto name = serverName(requestedGpu(_options));
+  {
+    int argc{1};
+    char arg0[] = "gz-gui";
+    char *argv[] = {arg0};
+    QCoreApplication probeApp(argc, argv);
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(kServerTimeoutMs))
+    {
+      gzmsg << "A warm server is already running" << std::endl;
+      return 0;
+    }
+  }
+
+  cmdVerbose(_options.verbose.c_str());
+  if (!_options.gpu.empty())
+    cmdGpu(_options.gpu.c_str());
+  gz::gui::Application app(_argc, _argv);
+  auto *mainWindow = app.findChild<gz::gui::MainWindow *>();
+  if (nullptr == mainWindow || nullptr == mainWindow->QuickWindow())
+    return 1;
+  mainWindow->QuickWindow()->hide();
+
+  // Keeps serving once all windows are closed
+  app.setQuitOnLastWindowClosed(false);
+
+  // Left behind by a server which crashed, nothing's listening on it
+  QLocalServer::removeServer(name);
+
+  QLocalServer server;
+  if (!server.listen(name))
+  {
+    gzerr << "Failed to listen on [" << server.fullServerName().toStdString()
+          << "]: " << server.errorString().toStdString() << std::endl;
+    return 1;
+  }
+
+  QObject::connect(&server, &QLocalServer::newConnection, &app,
+      [&]()
+      {
+        auto *socket = server.nextPendingConnection();
+        QObject::connect(socket, &QLocalSocket::disconnected,
+            socket, &QObject::deleteLater);
+        QObject::connect(socket, &QLocalSocket::readyRead, &app,
+            [&, socket]()
+            {
+              if (!socket->canReadLine())
+                return;
+
+              const auto request = QString::fromUtf8(
+                  socket->readLine()).trimmed().split('\t');
+              const std::string verbose = request.value(0).toStdString();
+              const std::string config = request.value(1).toStdString();
+
+              socket->write("ok\n");
+              socket->flush();
+              socket->disconnectFromServer();
+
+              // The first window is reused while it's hidden, closing the
+              // additional ones deletes them
+              gz::gui::MainWindow *window{nullptr};
+              for (auto *existing : app.MainWindows())
+              {
+                if (!existing->QuickWindow()->isVisible())
+                  window = existing;
+              }
+              if (nullptr == window)
+                window = app.AddMainWindow();
+              if (nullptr == window)
+                return;
+
+              cmdVerbose(verbose.c_str());
+              bool loaded{true};
+              if (config.empty())
+              {
+                // Empty windows open even without a default config yet
+                app.LoadConfig(app.DefaultConfigPath(), window);
+              }
+              else
+              {
+                loaded = app.LoadConfig(config, window);
+              }
+
+              // Failed windows stay hidden for the next launch
+              if (loaded)
+                window->QuickWindow()->show();
+            });
+      });
+
+  gzmsg << "Warm server listening on ["
+        << server.fullServerName().toStdString() << "]" << std::endl;
+  return app.exec();
+}
+}  // namespace
+
+//////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  Options options;
+  const int code = parse(_argc, _argv, options);
+  if (code >= 0)
+    return code;
+
+  if (options.server)
+    return runServer(_argc, _argv, options);
+
+  if (options.list)
+  {
+    cmdPluginList();
+    return 0;
+  }
+
+  if (!validateConfig(options.config))
+    return 1;
+
+  // Main windows go to a warm server when there's one. Traces measure a
+  // startup of their own.
+  if (options.standalone.empty() && options.startupTrace.empty() &&
+      !options.noServer && sendToServer(options))
+  {
+    return 0;
+  }
+
+  cmdVerbose(options.verbose.c_str());
+  if (!options.startupTrace.empty())
+    cmdStartupTrace(options.startupTrace.c_str());
+  if (!options.gpu.empty())
+    cmdGpu(options.gpu.c_str());
+
+  if (!options.standalone.empty())
+    cmdStandalone(options.standalone.c_str());
+  else if (!options.config.empty())
+    cmdConfig(options.config.c_str());
+  else
+    cmdEmptyWindow();
+  return 0;
+}
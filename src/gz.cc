@@ -20,10 +20,12 @@
 #include <iostream>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Util.hh>
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/config.hh"
 #include "gz/gui/Export.hh"
+#include "gz/gui/GpuSelection.hh"
 #include "gz/gui/gz.hh"
 #include "gz/gui/MainWindow.hh"
 
@@ -97,6 +99,14 @@ extern "C" GZ_GUI_VISIBLE void cmdConfig(const char *_config)
 {
   startConsoleLog();
 
+  // The GPU is chosen before the application starts, the command line
+  // taking precedence
+  if (gz::gui::GpuSelection::Requested().empty())
+  {
+    gz::gui::GpuSelection::SetRequested(
+        gz::gui::GpuSelection::FromConfig(_config));
+  }
+
   gz::gui::Application app(g_argc, g_argv);
 
   if (!app.findChild<gz::gui::MainWindow *>())
@@ -118,6 +128,20 @@ extern "C" GZ_GUI_VISIBLE void cmdVerbose(const char *_verbosity)
   gz::common::Console::SetVerbosity(std::atoi(_verbosity));
 }
 
+//////////////////////////////////////////////////
+extern "C" GZ_GUI_VISIBLE void cmdStartupTrace(const char *_path)
+{
+  // Read by the application as it starts
+  gz::common::setenv("GZ_GUI_STARTUP_TRACE", _path);
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_GUI_VISIBLE void cmdGpu(const char *_gpu)
+{
+  // Read by the application as it starts
+  gz::gui::GpuSelection::SetRequested(_gpu);
+}
+
 //////////////////////////////////////////////////
 extern "C" GZ_GUI_VISIBLE void cmdEmptyWindow()
 {
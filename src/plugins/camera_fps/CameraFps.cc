@@ -16,22 +16,68 @@
 */
 
 #include <gz/utils/ImplPtr.hh>
-#include <list>
+#include <algorithm>
+#include <chrono>
+#include <optional>
 #include <string>
+#include <variant>
+
+#include <gz/msgs/param.pb.h>
 
 #include <gz/common/Console.hh>
 #include <gz/plugin/Register.hh>
-#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/rendering/Utils.hh>
+#include <gz/transport/Node.hh>
 
-#include "gz/gui/Application.hh"
-#include "gz/gui/GuiEvents.hh"
-#include "gz/gui/MainWindow.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneServices.hh"
 
 #include "CameraFps.hh"
+#include "FrameTimeWindow.hh"
 
 namespace gz::gui::plugins
 {
+/// \brief Frame pacing of the window, computed in the render thread
+struct FramePacing
+{
+  /// \brief Frames per second from the mean frame time
+  double fps{0.0};
+
+  /// \brief Median frame time, in seconds
+  double p50{0.0};
+
+  /// \brief 95th percentile frame time, in seconds
+  double p95{0.0};
+
+  /// \brief 99th percentile frame time, in seconds
+  double p99{0.0};
+
+  /// \brief Longest frame time, in seconds
+  double max{0.0};
+
+  /// \brief Stability, see FrameTimeWindow::Stability
+  double stability{0.0};
+
+  /// \brief True if the scene reported when frames were shown, in which
+  /// case the present fields below are set
+  bool presented{false};
+
+  /// \brief Median time between frames being shown, in seconds
+  double presentP50{0.0};
+
+  /// \brief 99th percentile time between frames being shown, in seconds
+  double presentP99{0.0};
+
+  /// \brief Stability of the times between frames being shown
+  double presentStability{0.0};
+
+  /// \brief Number of frames in the window shown more than half a display
+  /// refresh late
+  std::size_t missed{0};
+};
+
 /// \brief Private data class for CameraFps
 class CameraFps::Implementation
 {
@@ -39,46 +85,228 @@ class CameraFps::Implementation
   public: std::optional<std::chrono::steady_clock::time_point>
       prevCameraUpdateTime;
 
-  /// \brief A moving window of camera update times
-  public: std::list<std::chrono::duration<double>> cameraUpdateTimes;
+  /// \brief Frame times of the last frames. Only used in the render thread.
+  public: FrameTimeWindow frameTimes{240u};
+
+  /// \brief Times between the last frames being shown. Only used in the
+  /// render thread.
+  public: FrameTimeWindow presentTimes{240u};
+
+  /// \brief Last value of the camera's "present-time" user data, in
+  /// seconds. Only used in the render thread.
+  public: std::optional<double> lastPresent;
 
-  /// \brief Sum of all update times in the moving window
-  public: std::chrono::duration<double> cameraUpdateTimeSum;
+  /// \brief Display refresh interval, in seconds, 0 if unknown. Only used
+  /// in the render thread.
+  public: double refreshInterval{0.0};
 
-  /// \brief Size of camera update time window
-  /// \todo(anyone) make this configurable
-  public: unsigned int cameraFPSWindowSize = 20u;
+  /// \brief Seconds between display updates
+  public: std::chrono::steady_clock::duration updatePeriod{
+      std::chrono::milliseconds(250)};
+
+  /// \brief When the display was last updated. Only used in the render
+  /// thread.
+  public: std::optional<std::chrono::steady_clock::time_point> lastUpdate;
 
   /// \brief Camera FPS string value
   public: QString cameraFPSValue;
+
+  /// \brief Frame time percentiles string value
+  public: QString frameTimesValue;
+
+  /// \brief Present interval percentiles string value
+  public: QString presentTimesValue;
+
+  /// \brief Whether Qt displays the user camera's texture without copying
+  /// it, unset until the scene reports it
+  public: std::optional<bool> zeroCopy;
+
+  /// \brief Node to publish the frame pacing
+  public: transport::Node node;
+
+  /// \brief Publishes the frame pacing, invalid if not publishing
+  public: transport::Node::Publisher pacingPub;
+
+  /// \brief Keeps OnRender registered. Last member so it's destroyed
+  /// first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
 };
 
+/////////////////////////////////////////////////
+/// \brief Set a double parameter of a message
+/// \param[in] _msg Message
+/// \param[in] _key Parameter name
+/// \param[in] _value Value
+static void setParam(msgs::Param &_msg, const std::string &_key,
+    double _value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_DOUBLE);
+  any.set_double_value(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Find out whether the 3D scene hands frames to Qt without copying
+/// them, as reported through the user camera's "zero-copy" user data.
+/// \return The value, or nothing if it's not known yet
+static std::optional<bool> zeroCopyFromScene()
+{
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (!camera)
+    return std::nullopt;
+
+  const auto zeroCopy = camera->UserData("zero-copy");
+  if (auto value = std::get_if<bool>(&zeroCopy))
+    return *value;
+  return std::nullopt;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a double user data of the user camera
+/// \param[in] _key User data key
+/// \return The value, or nothing if it's not set
+static std::optional<double> userDataFromScene(const std::string &_key)
+{
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (!camera)
+    return std::nullopt;
+
+  const auto data = camera->UserData(_key);
+  if (auto value = std::get_if<double>(&data))
+    return *value;
+  return std::nullopt;
+}
+
+/////////////////////////////////////////////////
+void CameraFps::UpdatePresentTimes()
+{
+  // The scene reports when its frames are shown, after Qt's buffer swap,
+  // which is what the pacing looks like on screen
+  const auto present = userDataFromScene("present-time");
+  if (!present.has_value() || present == this->dataPtr->lastPresent)
+    return;
+
+  if (this->dataPtr->lastPresent.has_value())
+  {
+    const std::chrono::duration<double> interval(
+        *present - *this->dataPtr->lastPresent);
+    this->dataPtr->presentTimes.Add(std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(interval));
+  }
+  this->dataPtr->lastPresent = present;
+  this->dataPtr->refreshInterval =
+      userDataFromScene("refresh-interval").value_or(0.0);
+}
+
 /////////////////////////////////////////////////
 void CameraFps::OnRender()
 {
-  auto now = std::chrono::steady_clock::now();
+  if (!this->dataPtr->zeroCopy.has_value())
+  {
+    this->dataPtr->zeroCopy = zeroCopyFromScene();
+    if (this->dataPtr->zeroCopy.has_value())
+      emit this->ZeroCopyChanged();
+  }
+
+  const auto now = std::chrono::steady_clock::now();
   if (!this->dataPtr->prevCameraUpdateTime.has_value())
   {
     this->dataPtr->prevCameraUpdateTime = now;
+    this->dataPtr->lastUpdate = now;
     return;
   }
 
-  const std::chrono::duration<double> dt =
-    std::chrono::steady_clock::now() - *this->dataPtr->prevCameraUpdateTime;
+  this->dataPtr->frameTimes.Add(now - *this->dataPtr->prevCameraUpdateTime);
   this->dataPtr->prevCameraUpdateTime = now;
-  this->dataPtr->cameraUpdateTimeSum += dt;
-  if (this->dataPtr->cameraUpdateTimes.size() >=
-      this->dataPtr->cameraFPSWindowSize)
+  this->UpdatePresentTimes();
+
+  // Only format and display at the update rate, frames don't allocate
+  if (now - *this->dataPtr->lastUpdate < this->dataPtr->updatePeriod)
+    return;
+  this->dataPtr->lastUpdate = now;
+
+  const auto &window = this->dataPtr->frameTimes;
+  FramePacing pacing;
+  const double mean = window.Mean();
+  pacing.fps = mean > 0.0 ? 1.0 / mean : 0.0;
+  pacing.p50 = window.Percentile(50.0);
+  pacing.p95 = window.Percentile(95.0);
+  pacing.p99 = window.Percentile(99.0);
+  pacing.max = window.Max();
+  pacing.stability = window.Stability();
+
+  const auto &presentWindow = this->dataPtr->presentTimes;
+  pacing.presented = presentWindow.Count() > 0u;
+  pacing.presentP50 = presentWindow.Percentile(50.0);
+  pacing.presentP99 = presentWindow.Percentile(99.0);
+  pacing.presentStability = presentWindow.Stability();
+  if (this->dataPtr->refreshInterval > 0.0)
+  {
+    pacing.missed =
+        presentWindow.CountOver(this->dataPtr->refreshInterval * 1.5);
+  }
+
+  QMetaObject::invokeMethod(this, [this, pacing]()
+      {
+        this->UpdatePacing(pacing);
+      }, Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+void CameraFps::UpdatePacing(const FramePacing &_pacing)
+{
+  const auto ms = [](double _seconds)
+  {
+    return QString::number(_seconds * 1e3, 'f', 1);
+  };
+
+  this->SetCameraFpsValue(QString::number(_pacing.fps, 'f', 1));
+
+  const QString frameTimes = "p50 " + ms(_pacing.p50) +
+      "  p95 " + ms(_pacing.p95) +
+      "  p99 " + ms(_pacing.p99) +
+      "  max " + ms(_pacing.max) + " ms  stability " +
+      QString::number(_pacing.stability * 100.0, 'f', 0) + "%";
+  if (frameTimes != this->dataPtr->frameTimesValue)
+  {
+    this->dataPtr->frameTimesValue = frameTimes;
+    emit this->FrameTimesValueChanged();
+  }
+
+  QString presentTimes;
+  if (_pacing.presented)
+  {
+    presentTimes = "shown p50 " + ms(_pacing.presentP50) +
+        "  p99 " + ms(_pacing.presentP99) + " ms  stability " +
+        QString::number(_pacing.presentStability * 100.0, 'f', 0) +
+        "%  missed " + QString::number(_pacing.missed);
+  }
+  if (presentTimes != this->dataPtr->presentTimesValue)
   {
-    auto first = this->dataPtr->cameraUpdateTimes.front();
-    this->dataPtr->cameraUpdateTimes.pop_front();
-    this->dataPtr->cameraUpdateTimeSum -= first;
-    double sum = this->dataPtr->cameraUpdateTimeSum.count();
-    double avg = sum /
-        static_cast<double>(this->dataPtr->cameraFPSWindowSize);
-    this->SetCameraFpsValue(QString::fromStdString(std::to_string(1.0/avg)));
+    this->dataPtr->presentTimesValue = presentTimes;
+    emit this->PresentTimesValueChanged();
   }
-  this->dataPtr->cameraUpdateTimes.push_back(dt);
+
+  if (!this->dataPtr->pacingPub)
+    return;
+
+  msgs::Param msg;
+  setParam(msg, "fps", _pacing.fps);
+  setParam(msg, "frame_time_p50", _pacing.p50);
+  setParam(msg, "frame_time_p95", _pacing.p95);
+  setParam(msg, "frame_time_p99", _pacing.p99);
+  setParam(msg, "frame_time_max", _pacing.max);
+  setParam(msg, "stability", _pacing.stability);
+  if (_pacing.presented)
+  {
+    setParam(msg, "present_interval_p50", _pacing.presentP50);
+    setParam(msg, "present_interval_p99", _pacing.presentP99);
+    setParam(msg, "present_stability", _pacing.presentStability);
+    setParam(msg, "missed_refreshes", static_cast<double>(_pacing.missed));
+  }
+  this->dataPtr->pacingPub.Publish(msg);
 }
 
 /////////////////////////////////////////////////
@@ -91,23 +319,61 @@ CameraFps::CameraFps()
 CameraFps::~CameraFps() = default;
 
 /////////////////////////////////////////////////
-void CameraFps::LoadConfig(const tinyxml2::XMLElement *)
+void CameraFps::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Camera FPS";
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
-}
+  int windowSize{240};
+  double updateRate{4.0};
+  std::string pacingTopic{"/gui/camera_fps"};
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("window_size"))
+      elem->QueryIntText(&windowSize);
+    if (auto elem = _pluginElem->FirstChildElement("update_rate"))
+      elem->QueryDoubleText(&updateRate);
+    if (auto elem = _pluginElem->FirstChildElement("stats_topic"))
+      pacingTopic = nullptr == elem->GetText() ? "" : elem->GetText();
+  }
 
-/////////////////////////////////////////////////
-bool CameraFps::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
+  if (windowSize < 1)
+  {
+    gzwarn << "Invalid <window_size> [" << windowSize << "], using 240"
+           << std::endl;
+    windowSize = 240;
+  }
+  this->dataPtr->frameTimes =
+      FrameTimeWindow(static_cast<std::size_t>(windowSize));
+  this->dataPtr->presentTimes =
+      FrameTimeWindow(static_cast<std::size_t>(windowSize));
+
+  if (updateRate <= 0.0)
+  {
+    gzwarn << "Invalid <update_rate> [" << updateRate << "], using 4"
+           << std::endl;
+    updateRate = 4.0;
+  }
+  this->dataPtr->updatePeriod =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / updateRate));
+
+  if (!pacingTopic.empty())
   {
-    this->OnRender();
+    this->dataPtr->pacingPub =
+        this->dataPtr->node.Advertise<msgs::Param>(pacingTopic);
+    if (!this->dataPtr->pacingPub)
+    {
+      gzerr << "Failed to advertise frame pacing on topic [" << pacingTopic
+            << "]" << std::endl;
+    }
   }
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+
+  this->dataPtr->renderConnection = RenderHooks::OnRender(
+      [this]()
+      {
+        this->OnRender();
+      }, 0, "CameraFps");
 }
 
 /////////////////////////////////////////////////
@@ -116,9 +382,29 @@ QString CameraFps::CameraFpsValue() const
   return this->dataPtr->cameraFPSValue;
 }
 
+/////////////////////////////////////////////////
+QString CameraFps::FrameTimesValue() const
+{
+  return this->dataPtr->frameTimesValue;
+}
+
+/////////////////////////////////////////////////
+QString CameraFps::PresentTimesValue() const
+{
+  return this->dataPtr->presentTimesValue;
+}
+
+/////////////////////////////////////////////////
+bool CameraFps::ZeroCopy() const
+{
+  return this->dataPtr->zeroCopy.value_or(false);
+}
+
 /////////////////////////////////////////////////
 void CameraFps::SetCameraFpsValue(const QString &_value)
 {
+  if (_value == this->dataPtr->cameraFPSValue)
+    return;
   this->dataPtr->cameraFPSValue = _value;
   emit this->CameraFpsValueChanged();
 }
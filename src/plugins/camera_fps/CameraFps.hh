@@ -25,7 +25,31 @@
 
 namespace gz::gui::plugins
 {
+  struct FramePacing;
+
   /// \brief This plugin displays the GUI camera's Framerate Per Second (FPS)
+  /// and how steadily frames are paced: the 50th, 95th and 99th percentile
+  /// and longest frame times over a window of frames, which show the
+  /// stutters an average hides. When the scene reports when its frames are
+  /// shown, through the user camera's "present-time" user data, the times
+  /// between frames reaching the screen are shown too, along with how many
+  /// were shown a display refresh late.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<window_size\> : Frames to compute the statistics over, defaults
+  ///                      to 240.
+  /// * \<update_rate\> : Display updates per second, defaults to 4.
+  /// * \<stats_topic\> : Topic to publish the statistics on at each display
+  ///                      update, as msgs::Param with "fps",
+  ///                      "frame_time_p50", "frame_time_p95",
+  ///                      "frame_time_p99", "frame_time_max" in seconds and
+  ///                      "stability" between 0 and 1. Once frames are
+  ///                      known to be shown, also "present_interval_p50",
+  ///                      "present_interval_p99" in seconds,
+  ///                      "present_stability" and "missed_refreshes".
+  ///                      Defaults to "/gui/camera_fps", empty to not
+  ///                      publish.
   class CameraFps : public Plugin
   {
     Q_OBJECT
@@ -38,6 +62,30 @@ namespace gz::gui::plugins
       NOTIFY CameraFpsValueChanged
     )
 
+    /// \brief Frame time percentiles, longest frame time and stability
+    Q_PROPERTY(
+      QString frameTimesValue
+      READ FrameTimesValue
+      NOTIFY FrameTimesValueChanged
+    )
+
+    /// \brief Percentiles and stability of the times between frames being
+    /// shown, and the number shown late. Empty until the scene reports
+    /// them.
+    Q_PROPERTY(
+      QString presentTimesValue
+      READ PresentTimesValue
+      NOTIFY PresentTimesValueChanged
+    )
+
+    /// \brief True if the 3D scene hands its frames to Qt without copying
+    /// them
+    Q_PROPERTY(
+      bool zeroCopy
+      READ ZeroCopy
+      NOTIFY ZeroCopyChanged
+    )
+
     /// \brief Constructor
     public: CameraFps();
 
@@ -59,11 +107,39 @@ namespace gz::gui::plugins
     /// \brief Notify that camera FPS value has changed
     signals: void CameraFpsValueChanged();
 
+    /// \brief Get the frame time statistics string
+    /// \return Percentiles, longest frame time and stability
+    public: Q_INVOKABLE QString FrameTimesValue() const;
+
+    /// \brief Notify that the frame time statistics have changed
+    signals: void FrameTimesValueChanged();
+
+    /// \brief Get the statistics of the times between frames being shown
+    /// \return Percentiles, stability and late frames, empty if unknown
+    public: Q_INVOKABLE QString PresentTimesValue() const;
+
+    /// \brief Notify that the present time statistics have changed
+    signals: void PresentTimesValueChanged();
+
+    /// \brief Get whether the 3D scene hands its frames to Qt without
+    /// copying them, sampling the texture the camera rendered into directly.
+    /// \return True if the zero-copy path is active
+    public: Q_INVOKABLE bool ZeroCopy() const;
+
+    /// \brief Notify that the zero-copy state is known
+    signals: void ZeroCopyChanged();
+
     /// \brief Perform rendering calls in the rendering thread.
     private: void OnRender();
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
+    /// \brief Add the time since the last frame was shown, if the scene
+    /// reported a new one. Called in the rendering thread.
+    private: void UpdatePresentTimes();
+
+    /// \brief Display and publish the frame pacing. Called in the GUI
+    /// thread at the update rate.
+    /// \param[in] _pacing Frame pacing computed in the render thread
+    private: void UpdatePacing(const FramePacing &_pacing);
 
     /// \internal
     /// \brief Pointer to private data.
@@ -22,24 +22,80 @@ import QtQuick.Layouts 1.3
 Rectangle {
   id: cameraFps
   color: "transparent"
-  Layout.minimumWidth: 150
-  Layout.minimumHeight: 80
+  Layout.minimumWidth: 300
+  Layout.minimumHeight: 100
 
-  RowLayout {
-    id: cameraFpsLayout
+  ColumnLayout {
     anchors.fill: parent
     anchors.margins: 10
 
+    RowLayout {
+      id: cameraFpsLayout
+      Layout.fillWidth: true
+
+      Label {
+        ToolTip.text: qsTr("Camera FPS")
+        font.weight: Font.DemiBold
+        text: "FPS"
+      }
+
+      Label {
+        objectName: "cameraFps"
+        text: CameraFps.cameraFPSValue
+        Layout.alignment: Qt.AlignRight
+      }
+
+      Label {
+        objectName: "zeroCopy"
+        ToolTip.visible: zeroCopyArea.containsMouse
+        ToolTip.text: CameraFps.zeroCopy ?
+            qsTr("Frames are displayed without being copied") :
+            qsTr("Frames are copied before being displayed")
+        text: CameraFps.zeroCopy ? "zero-copy" : "copy"
+        color: "gray"
+        Layout.alignment: Qt.AlignRight
+
+        MouseArea {
+          id: zeroCopyArea
+          anchors.fill: parent
+          hoverEnabled: true
+        }
+      }
+    }
+
     Label {
-      ToolTip.text: qsTr("Camera FPS")
-      font.weight: Font.DemiBold
-      text: "FPS"
+      objectName: "frameTimes"
+      ToolTip.visible: frameTimesArea.containsMouse
+      ToolTip.text:
+          qsTr("Frame times of the last frames, stability drops on stutters")
+      text: CameraFps.frameTimesValue
+      font.pointSize: 9
+      Layout.fillWidth: true
+      elide: Text.ElideRight
+
+      MouseArea {
+        id: frameTimesArea
+        anchors.fill: parent
+        hoverEnabled: true
+      }
     }
 
     Label {
-      objectName: "cameraFps"
-      text: CameraFps.cameraFPSValue
-      Layout.alignment: Qt.AlignRight
+      objectName: "presentTimes"
+      visible: CameraFps.presentTimesValue !== ""
+      ToolTip.visible: presentTimesArea.containsMouse
+      ToolTip.text: qsTr("Times between the last frames being shown, " +
+          "missed counts frames shown a display refresh late")
+      text: CameraFps.presentTimesValue
+      font.pointSize: 9
+      Layout.fillWidth: true
+      elide: Text.ElideRight
+
+      MouseArea {
+        id: presentTimesArea
+        anchors.fill: parent
+        hoverEnabled: true
+      }
     }
   }
 }
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "FrameTimeWindow.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Longest time counted, in microseconds
+static constexpr std::uint64_t kMaxTime{10000000};
+
+/////////////////////////////////////////////////
+FrameTimeWindow::FrameTimeWindow(std::size_t _size)
+  : ring(std::max<std::size_t>(_size, 1u), 0u)
+{
+}
+
+/////////////////////////////////////////////////
+void FrameTimeWindow::Add(std::chrono::steady_clock::duration _time)
+{
+  const auto us = std::min<std::uint64_t>(kMaxTime, static_cast<std::uint64_t>(
+      std::max<std::int64_t>(0, std::chrono::duration_cast<
+      std::chrono::microseconds>(_time).count())));
+
+  auto &slot = this->ring[this->next];
+  if (this->count == this->ring.size())
+  {
+    --this->buckets[Bucket(slot)];
+    this->sum -= slot;
+    this->sumSquares -= slot * slot;
+  }
+  else
+  {
+    ++this->count;
+  }
+
+  slot = us;
+  ++this->buckets[Bucket(us)];
+  this->sum += us;
+  this->sumSquares += us * us;
+  this->next = (this->next + 1) % this->ring.size();
+}
+
+/////////////////////////////////////////////////
+void FrameTimeWindow::Clear()
+{
+  this->next = 0;
+  this->count = 0;
+  this->buckets.fill(0);
+  this->sum = 0;
+  this->sumSquares = 0;
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTimeWindow::Count() const
+{
+  return this->count;
+}
+
+/////////////////////////////////////////////////
+double FrameTimeWindow::Percentile(double _percentile) const
+{
+  if (this->count == 0)
+    return 0.0;
+
+  const auto rank = std::max<std::size_t>(1u, static_cast<std::size_t>(
+      std::ceil(std::clamp(_percentile, 0.0, 100.0) / 100.0 * this->count)));
+  std::size_t seen{0};
+  for (std::size_t i = 0; i < kBucketCount; ++i)
+  {
+    seen += this->buckets[i];
+    if (seen >= rank)
+      return std::min(BucketMax(i) * 1e-6, this->Max());
+  }
+  return this->Max();
+}
+
+/////////////////////////////////////////////////
+double FrameTimeWindow::Max() const
+{
+  std::uint64_t max{0};
+  for (std::size_t i = 0; i < this->count; ++i)
+    max = std::max(max, this->ring[i]);
+  return max * 1e-6;
+}
+
+/////////////////////////////////////////////////
+double FrameTimeWindow::Mean() const
+{
+  if (this->count == 0)
+    return 0.0;
+  return static_cast<double>(this->sum) / this->count * 1e-6;
+}
+
+/////////////////////////////////////////////////
+double FrameTimeWindow::Stability() const
+{
+  if (this->count == 0 || this->sum == 0)
+    return 0.0;
+
+  const double n = static_cast<double>(this->count);
+  const double mean = static_cast<double>(this->sum) / n;
+  const double variance = std::max(0.0,
+      static_cast<double>(this->sumSquares) / n - mean * mean);
+  return std::clamp(1.0 - std::sqrt(variance) / mean, 0.0, 1.0);
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTimeWindow::CountOver(double _seconds) const
+{
+  const double us = _seconds * 1e6;
+  return static_cast<std::size_t>(std::count_if(this->ring.begin(),
+      this->ring.begin() + this->count,
+      [us](std::uint64_t _time)
+      {
+        return _time > us;
+      }));
+}
+
+/////////////////////////////////////////////////
+std::size_t FrameTimeWindow::Bucket(std::uint64_t _us)
+{
+  // The first 32 buckets are exact, then each power of two is split in 16
+  std::size_t shift{0};
+  while ((_us >> shift) >= 32u)
+    ++shift;
+  return 16u * shift + static_cast<std::size_t>(_us >> shift);
+}
+
+/////////////////////////////////////////////////
+std::uint64_t FrameTimeWindow::BucketMax(std::size_t _bucket)
+{
+  if (_bucket < 32u)
+    return _bucket;
+
+  const std::size_t shift = _bucket / 16u - 1u;
+  const std::uint64_t min = (_bucket - 16u * shift) << shift;
+  return min + (std::uint64_t{1} << shift) - 1u;
+}
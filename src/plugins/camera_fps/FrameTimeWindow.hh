@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_FRAMETIMEWINDOW_HH_
+#define GZ_GUI_PLUGINS_FRAMETIMEWINDOW_HH_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#ifndef _WIN32
+#  define FrameTimeWindow_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(CameraFps_EXPORTS))
+#    define FrameTimeWindow_EXPORTS_API __declspec(dllexport)
+#  else
+#    define FrameTimeWindow_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Frame times of the last frames, in a ring buffer allocated once,
+  /// with a histogram of them to read percentiles without sorting.
+  ///
+  /// The histogram has log-linear buckets in microseconds, as in HDR
+  /// histograms: 16 linear buckets per power of two, so percentiles are
+  /// within about 6% of the exact value. Times over 10 s are counted as
+  /// 10 s. Adding a frame doesn't allocate.
+  class FrameTimeWindow_EXPORTS_API FrameTimeWindow
+  {
+    /// \brief Constructor
+    /// \param[in] _size Frames in the window, at least 1
+    public: explicit FrameTimeWindow(std::size_t _size);
+
+    /// \brief Add the time of a frame, dropping the oldest one if the window
+    /// is full
+    /// \param[in] _time Time since the previous frame
+    public: void Add(std::chrono::steady_clock::duration _time);
+
+    /// \brief Remove all frames
+    public: void Clear();
+
+    /// \brief Number of frames in the window
+    /// \return Between 0 and the window size
+    public: std::size_t Count() const;
+
+    /// \brief Frame time below which a share of the frames are
+    /// \param[in] _percentile Between 0 and 100
+    /// \return Upper bound of the histogram bucket, in seconds, or 0 if empty
+    public: double Percentile(double _percentile) const;
+
+    /// \brief Longest frame time in the window
+    /// \return Seconds, or 0 if empty
+    public: double Max() const;
+
+    /// \brief Average frame time in the window
+    /// \return Seconds, or 0 if empty
+    public: double Mean() const;
+
+    /// \brief How steady frames are paced: 1 minus the coefficient of
+    /// variation of the frame times, clamped to [0, 1]. 1 means all frames
+    /// took the same time.
+    /// \return Stability, or 0 if empty
+    public: double Stability() const;
+
+    /// \brief Number of frames which took longer than a time
+    /// \param[in] _seconds Time in seconds
+    /// \return Number of frames in the window
+    public: std::size_t CountOver(double _seconds) const;
+
+    /// \brief Bucket a time falls in
+    /// \param[in] _us Time in microseconds
+    /// \return Bucket index
+    private: static std::size_t Bucket(std::uint64_t _us);
+
+    /// \brief Largest time a bucket holds
+    /// \param[in] _bucket Bucket index
+    /// \return Time in microseconds
+    private: static std::uint64_t BucketMax(std::size_t _bucket);
+
+    /// \brief Number of buckets, covering up to 10 s
+    private: static constexpr std::size_t kBucketCount{336};
+
+    /// \brief Frame times in microseconds, oldest at `next` once full
+    private: std::vector<std::uint64_t> ring;
+
+    /// \brief Where the next frame time goes in `ring`
+    private: std::size_t next{0};
+
+    /// \brief Number of frame times in `ring`
+    private: std::size_t count{0};
+
+    /// \brief Number of frame times per bucket
+    private: std::array<std::uint32_t, kBucketCount> buckets{};
+
+    /// \brief Sum of the frame times, in microseconds
+    private: std::uint64_t sum{0};
+
+    /// \brief Sum of the squared frame times, in squared microseconds
+    private: std::uint64_t sumSquares{0};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_FRAMETIMEWINDOW_HH_
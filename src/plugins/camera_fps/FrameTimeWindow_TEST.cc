@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "FrameTimeWindow.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(FrameTimeWindowTest, Empty)
+{
+  FrameTimeWindow window(10);
+  EXPECT_EQ(0u, window.Count());
+  EXPECT_DOUBLE_EQ(0.0, window.Percentile(50));
+  EXPECT_DOUBLE_EQ(0.0, window.Max());
+  EXPECT_DOUBLE_EQ(0.0, window.Mean());
+  EXPECT_DOUBLE_EQ(0.0, window.Stability());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTimeWindowTest, Steady)
+{
+  FrameTimeWindow window(100);
+  for (int i = 0; i < 100; ++i)
+    window.Add(16667us);
+
+  EXPECT_EQ(100u, window.Count());
+  EXPECT_DOUBLE_EQ(0.016667, window.Max());
+  EXPECT_DOUBLE_EQ(0.016667, window.Mean());
+  EXPECT_DOUBLE_EQ(0.016667, window.Percentile(99));
+  EXPECT_DOUBLE_EQ(1.0, window.Stability());
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTimeWindowTest, Stutter)
+{
+  // 98 frames at 60 FPS and 2 stutters, which an average hides
+  FrameTimeWindow window(100);
+  for (int i = 0; i < 100; ++i)
+    window.Add(i % 50 == 0 ? 100ms : 16ms);
+
+  EXPECT_NEAR(0.016, window.Percentile(50), 0.016 * 0.07);
+  EXPECT_NEAR(0.016, window.Percentile(95), 0.016 * 0.07);
+  EXPECT_NEAR(0.1, window.Percentile(99), 0.1 * 0.07);
+  EXPECT_DOUBLE_EQ(0.1, window.Max());
+  EXPECT_NEAR(0.01768, window.Mean(), 1e-9);
+  EXPECT_LT(window.Stability(), 0.5);
+  EXPECT_GT(window.Stability(), 0.0);
+
+  EXPECT_EQ(2u, window.CountOver(0.016 * 1.5));
+  EXPECT_EQ(0u, window.CountOver(0.1));
+  EXPECT_EQ(100u, window.CountOver(0.0));
+}
+
+/////////////////////////////////////////////////
+TEST(FrameTimeWindowTest, Window)
+{
+  FrameTimeWindow window(4);
+  window.Add(1s);
+  for (int i = 0; i < 4; ++i)
+    window.Add(10ms);
+
+  // The slow frame dropped out of the window
+  EXPECT_EQ(4u, window.Count());
+  EXPECT_DOUBLE_EQ(0.01, window.Max());
+  EXPECT_DOUBLE_EQ(0.01, window.Mean());
+  EXPECT_DOUBLE_EQ(0.01, window.Percentile(100));
+
+  // Times past the histogram are clamped
+  window.Add(60s);
+  EXPECT_DOUBLE_EQ(10.0, window.Max());
+
+  window.Clear();
+  EXPECT_EQ(0u, window.Count());
+  EXPECT_DOUBLE_EQ(0.0, window.Max());
+}
@@ -17,10 +17,15 @@
 */
 
 #include <gz/utils/ImplPtr.hh>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <optional>
+#include <vector>
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/cameratrack.pb.h>
@@ -30,7 +35,6 @@
 #include <gz/msgs/vector3d.pb.h>
 
 #include <gz/common/Console.hh>
-#include <gz/common/Profiler.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/rendering/Camera.hh>
@@ -42,6 +46,11 @@
 #include "gz/gui/Conversions.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/NodePool.hh"
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneServices.hh"
+#include "gz/gui/SubscriptionHub.hh"
 
 #include <gz/transport/Node.hh>
 
@@ -100,9 +109,46 @@ class CameraTracking::Implementation
   /// \param[in] _e Key release event
   public: void HandleKeyRelease(events::KeyReleaseOnScene *_e);
 
-  /// \brief Protects variable changed through services.
+  /// \brief Queue a change to the tracking state, to be applied at the start
+  /// of the next render so that callbacks don't wait for the render hook.
+  /// \param[in] _request Change to apply on the render thread
+  public: void Request(std::function<void()> _request);
+
+  /// \brief Node resolved from a target name
+  public: struct CachedNode
+  {
+    /// \brief Name the node was resolved from
+    std::string name;
+
+    /// \brief Weak so that the cache doesn't keep deleted nodes alive
+    std::weak_ptr<rendering::Node> node;
+  };
+
+  /// \brief Get the node of a target, looking it up by name only when the
+  /// target changed or the cached node left the scene.
+  /// \param[in] _name Target name
+  /// \param[in,out] _cache Node previously resolved for this target
+  /// \return Node, null if the name is empty or not found
+  public: rendering::NodePtr TargetNode(const std::string &_name,
+      CachedNode &_cache);
+
+  /// \brief Protects `requests`, and the tracking state read by the camera
+  /// pose timer. That state is only written on the render thread, which
+  /// takes the lock just for those writes.
   public: std::mutex mutex;
 
+  /// \brief Changes received since the last render
+  public: std::vector<std::function<void()>> requests;
+
+  /// \brief Node of `moveToTarget`
+  public: CachedNode moveToNode;
+
+  /// \brief Node of `selectedFollowTarget`
+  public: CachedNode followNode;
+
+  /// \brief Node of `selectedTrackTarget`
+  public: CachedNode trackNode;
+
   //// \brief Pointer to the rendering scene
   public: rendering::ScenePtr scene = nullptr;
 
@@ -155,8 +201,11 @@ class CameraTracking::Implementation
   /// \brief Helper object to move user camera
   public: gz::rendering::MoveToHelper moveToHelper;
 
-  /// \brief Transport node
-  public: transport::Node node;
+  /// \brief Plugin the topics and services are advertised for
+  public: const void *owner{nullptr};
+
+  /// \brief Subscription to the track topic
+  public: HubSubscription trackSubscription;
 
   /// \brief Move to service
   public: std::string moveToService;
@@ -193,62 +242,89 @@ class CameraTracking::Implementation
 
   /// \brief Timer to keep publishing camera poses.
   public: QTimer *timer{nullptr};
+
+  /// \brief Maximum rate to publish the camera pose and tracking status at,
+  /// in Hz. Zero disables publishing.
+  public: double publishRate{50.0};
+
+  /// \brief Distance in meters, or angle in radians, the camera must move
+  /// for its pose to be published again
+  public: double poseThreshold{1e-3};
+
+  /// \brief Last camera pose published
+  public: std::optional<math::Pose3d> publishedPose;
+
+  /// \brief Last tracking status published, serialized
+  public: std::string publishedTrackStatus;
+
+  /// \brief Whether the pose publisher had subscribers on the last check,
+  /// so new subscribers get the current pose even if the camera is still
+  public: bool poseConnected{false};
+
+  /// \brief Whether the tracking status publisher had subscribers on the
+  /// last check
+  public: bool trackStatusConnected{false};
+
+  /// \brief Whether the camera moved enough since the last published pose
+  /// \param[in] _pose Current camera pose
+  /// \return True if the pose should be published
+  public: bool PoseChanged(const math::Pose3d &_pose) const;
 };
 
 /////////////////////////////////////////////////
 void CameraTracking::Implementation::Initialize()
 {
-  // Attach to the first camera we find
-  for (unsigned int i = 0; i < scene->NodeCount(); ++i)
-  {
-    auto cam = std::dynamic_pointer_cast<rendering::Camera>(
-      scene->NodeByIndex(i));
-    if (cam)
-    {
-      this->camera = cam;
-      gzdbg << "CameraTracking plugin is moving camera ["
-             << this->camera->Name() << "]" << std::endl;
-      break;
-    }
-  }
-  if (!this->camera)
+  auto cam = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (!cam)
   {
     gzerr << "Camera is not available" << std::endl;
     return;
   }
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->camera = cam;
+  }
+  gzdbg << "CameraTracking plugin is moving camera ["
+         << cam->Name() << "]" << std::endl;
 
   // move to
   this->moveToService = "/gui/move_to";
-  this->node.Advertise(this->moveToService,
+  auto *nodes = App()->Nodes();
+  nodes->AdvertiseService(this->owner, this->moveToService,
       &Implementation::OnMoveTo, this);
   gzmsg << "Move to service on ["
          << this->moveToService << "]" << std::endl;
 
   // follow
   this->followService = "/gui/follow";
-  this->node.Advertise(this->followService,
+  nodes->AdvertiseService(this->owner, this->followService,
       &Implementation::OnFollow, this);
   gzmsg << "Follow service on ["
          << this->followService << "] (deprecated)" << std::endl;
 
   // track
   this->trackTopic = "/gui/track";
-  this->node.Subscribe(this->trackTopic,
-      &Implementation::OnTrackSub, this);
+  this->trackSubscription =
+      App()->Subscriptions()->Subscribe<msgs::CameraTrack>(this->trackTopic,
+      [this](const msgs::CameraTrack &_msg)
+      {
+        this->OnTrackSub(_msg);
+      });
   gzmsg << "Tracking topic on ["
          << this->trackTopic << "]" << std::endl;
 
   // tracking status
   this->trackStatusTopic = "/gui/currently_tracked";
   this->trackStatusPub =
-    this->node.Advertise<msgs::CameraTrack>(this->trackStatusTopic);
+    nodes->Advertise<msgs::CameraTrack>(this->owner, this->trackStatusTopic);
   gzmsg << "Tracking status topic on ["
          << this->trackStatusTopic << "]" << std::endl;
 
   // move to pose service
   this->moveToPoseService =
       "/gui/move_to/pose";
-  this->node.Advertise(this->moveToPoseService,
+  nodes->AdvertiseService(this->owner, this->moveToPoseService,
       &Implementation::OnMoveToPose, this);
   gzmsg << "Move to pose service on ["
          << this->moveToPoseService << "]" << std::endl;
@@ -256,13 +332,13 @@ void CameraTracking::Implementation::Initialize()
   // camera position topic
   this->cameraPoseTopic = "/gui/camera/pose";
   this->cameraPosePub =
-    this->node.Advertise<msgs::Pose>(this->cameraPoseTopic);
+    nodes->Advertise<msgs::Pose>(this->owner, this->cameraPoseTopic);
   gzmsg << "Camera pose topic advertised on ["
          << this->cameraPoseTopic << "]" << std::endl;
 
   // follow offset
   this->followOffsetService = "/gui/follow/offset";
-  this->node.Advertise(this->followOffsetService,
+  nodes->AdvertiseService(this->owner, this->followOffsetService,
       &Implementation::OnFollowOffset, this);
   gzmsg << "Follow offset service on ["
           << this->followOffsetService << "] (deprecated)" << std::endl;
@@ -272,8 +348,10 @@ void CameraTracking::Implementation::Initialize()
 bool CameraTracking::Implementation::OnMoveTo(const msgs::StringMsg &_msg,
   msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  this->moveToTarget = _msg.data();
+  this->Request([this, target = _msg.data()]()
+  {
+    this->moveToTarget = target;
+  });
 
   _res.set_data(true);
   return true;
@@ -283,59 +361,61 @@ bool CameraTracking::Implementation::OnMoveTo(const msgs::StringMsg &_msg,
 bool CameraTracking::Implementation::OnFollow(const msgs::StringMsg &_msg,
   msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  this->selectedFollowTarget = _msg.data();
+  this->Request([this, target = _msg.data()]()
+  {
+    this->selectedFollowTarget = target;
+    this->trackMode = gz::msgs::CameraTrack::FOLLOW;
+    this->newTrack = true;
+  });
 
   _res.set_data(true);
-
-  this->trackMode = gz::msgs::CameraTrack::FOLLOW;
-
-  this->newTrack = true;
   return true;
 }
 
 /////////////////////////////////////////////////
 void CameraTracking::Implementation::OnTrackSub(const msgs::CameraTrack &_msg)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
   gzmsg << "Got new track message." << std::endl;
 
-  if (_msg.track_mode() != gz::msgs::CameraTrack::USE_LAST)
+  this->Request([this, _msg]()
   {
-    this->trackMode = _msg.track_mode();
-  }
-  if (!_msg.follow_target().name().empty())
-  {
-    this->selectedFollowTarget = _msg.follow_target().name();
-  }
-  if (!_msg.track_target().name().empty())
-  {
-    this->selectedTrackTarget = _msg.track_target().name();
-  }
-  if (_msg.follow_target().name().empty() && _msg.track_target().name().empty()
-        && _msg.track_mode() != gz::msgs::CameraTrack::USE_LAST)
-  {
-    gzmsg << "Track and Follow target names empty."<< std::endl;
-  }
-  if (_msg.has_follow_offset())
-  {
-    this->followOffset = msgs::Convert(_msg.follow_offset());
-  }
-  if (_msg.has_track_offset())
-  {
-    this->trackOffset = msgs::Convert(_msg.track_offset());
-  }
-  if (_msg.track_pgain() > 0.00001)
-  {
-    this->trackPGain = _msg.track_pgain();
-  }
-  if (_msg.follow_pgain() > 0.00001)
-  {
-    this->followPGain = _msg.follow_pgain();
-  }
+    if (_msg.track_mode() != gz::msgs::CameraTrack::USE_LAST)
+    {
+      this->trackMode = _msg.track_mode();
+    }
+    if (!_msg.follow_target().name().empty())
+    {
+      this->selectedFollowTarget = _msg.follow_target().name();
+    }
+    if (!_msg.track_target().name().empty())
+    {
+      this->selectedTrackTarget = _msg.track_target().name();
+    }
+    if (_msg.follow_target().name().empty() &&
+          _msg.track_target().name().empty() &&
+          _msg.track_mode() != gz::msgs::CameraTrack::USE_LAST)
+    {
+      gzmsg << "Track and Follow target names empty."<< std::endl;
+    }
+    if (_msg.has_follow_offset())
+    {
+      this->followOffset = msgs::Convert(_msg.follow_offset());
+    }
+    if (_msg.has_track_offset())
+    {
+      this->trackOffset = msgs::Convert(_msg.track_offset());
+    }
+    if (_msg.track_pgain() > 0.00001)
+    {
+      this->trackPGain = _msg.track_pgain();
+    }
+    if (_msg.follow_pgain() > 0.00001)
+    {
+      this->followPGain = _msg.follow_pgain();
+    }
 
-  this->newTrack = true;
-  return;
+    this->newTrack = true;
+  });
 }
 
 /////////////////////////////////////////////////
@@ -355,12 +435,14 @@ void CameraTracking::Implementation::OnMoveToPoseComplete()
 bool CameraTracking::Implementation::OnFollowOffset(const msgs::Vector3d &_msg,
   msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  if (!this->selectedFollowTarget.empty())
+  this->Request([this, offset = msgs::Convert(_msg)]()
   {
-    this->newTrack = true;
-    this->followOffset = msgs::Convert(_msg);
-  }
+    if (!this->selectedFollowTarget.empty())
+    {
+      this->newTrack = true;
+      this->followOffset = offset;
+    }
+  });
 
   _res.set_data(true);
   return true;
@@ -370,7 +452,6 @@ bool CameraTracking::Implementation::OnFollowOffset(const msgs::Vector3d &_msg,
 bool CameraTracking::Implementation::OnMoveToPose(const msgs::GUICamera &_msg,
   msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
   math::Pose3d pose = msgs::Convert(_msg.pose());
 
   // If there is no orientation in the message, then set a Rot value in the
@@ -387,26 +468,56 @@ bool CameraTracking::Implementation::OnMoveToPose(const msgs::GUICamera &_msg,
   if (!_msg.pose().has_position())
     pose.Pos().X() = math::INF_D;
 
-  this->moveToPoseValue = pose;
+  const double duration = _msg.duration() > 0 ? _msg.duration() : 0.5;
+  this->Request([this, pose, duration]()
+  {
+    this->moveToPoseValue = pose;
+    this->moveToPoseDuration = duration;
+  });
+
+  _res.set_data(true);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void CameraTracking::Implementation::Request(std::function<void()> _request)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->requests.push_back(std::move(_request));
+  }
+  RenderHooks::RequestRender();
+}
 
-  if (_msg.duration() > 0)
+/////////////////////////////////////////////////
+rendering::NodePtr CameraTracking::Implementation::TargetNode(
+    const std::string &_name, CachedNode &_cache)
+{
+  if (_name.empty())
   {
-    this->moveToPoseDuration = _msg.duration();
+    _cache = CachedNode();
+    return nullptr;
   }
-  else
+
+  if (_cache.name == _name)
   {
-    this->moveToPoseDuration = 0.5;
+    // Removed nodes may be kept alive by others, such as the camera
+    // following them, so check the scene still has it. That's a lookup by
+    // id, while NodeByName scans all nodes.
+    auto node = _cache.node.lock();
+    if (node && this->scene->HasNode(node))
+      return node;
   }
 
-  _res.set_data(true);
-  return true;
+  auto node = this->scene->NodeByName(_name);
+  _cache.name = _name;
+  _cache.node = node;
+  return node;
 }
 
 /////////////////////////////////////////////////
 void CameraTracking::Implementation::OnRender()
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-
   if (nullptr == this->scene)
   {
     this->scene = rendering::sceneFromFirstRenderEngine();
@@ -419,15 +530,24 @@ void CameraTracking::Implementation::OnRender()
   if (!this->camera)
     return;
 
+  // Apply the changes received since the last frame. Only this and the
+  // writes to state read by the timer hold the lock, not the whole hook.
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (auto &request : this->requests)
+      request();
+    this->requests.clear();
+  }
+
   // Move To
   {
-    GZ_PROFILE("CameraTracking::Implementation::OnRender MoveTo");
+    GZ_GUI_PROFILE("CameraTracking::Implementation::OnRender MoveTo");
     if (!this->moveToTarget.empty())
     {
       if (this->moveToHelper.Idle())
       {
-        rendering::NodePtr target = scene->NodeByName(
-            this->moveToTarget);
+        rendering::NodePtr target = this->TargetNode(this->moveToTarget,
+            this->moveToNode);
         if (target)
         {
           this->moveToHelper.MoveTo(this->camera, target, 0.5,
@@ -453,7 +573,7 @@ void CameraTracking::Implementation::OnRender()
 
   // Move to pose
   {
-    GZ_PROFILE("CameraTracking::Implementation::OnRender MoveToPose");
+    GZ_GUI_PROFILE("CameraTracking::Implementation::OnRender MoveToPose");
     if (this->moveToPoseValue)
     {
       if (this->moveToHelper.Idle())
@@ -476,25 +596,28 @@ void CameraTracking::Implementation::OnRender()
 
   // Track
   {
-    GZ_PROFILE("CameraTracking::Implementation::OnRender Track");
+    GZ_GUI_PROFILE("CameraTracking::Implementation::OnRender Track");
+    rendering::NodePtr targetFollow = this->TargetNode(
+        this->selectedFollowTarget, this->followNode);
+    rendering::NodePtr targetTrack = this->TargetNode(
+        this->selectedTrackTarget, this->trackNode);
+
     // reset track mode if target node got removed
     if (!this->selectedFollowTarget.empty())
     {
-      rendering::NodePtr targetFollow = this->scene->NodeByName(
-            this->selectedFollowTarget);
       if (!targetFollow && !this->selectedTargetWait)
       {
         this->camera->SetFollowTarget(nullptr);
+        std::lock_guard<std::mutex> lock(this->mutex);
         this->selectedFollowTarget.clear();
       }
     }
     if (!this->selectedTrackTarget.empty())
     {
-      rendering::NodePtr targetTrack = this->scene->NodeByName(
-            this->selectedTrackTarget);
       if (!targetTrack && !this->selectedTargetWait)
       {
         this->camera->SetTrackTarget(nullptr);
+        std::lock_guard<std::mutex> lock(this->mutex);
         this->selectedTrackTarget.clear();
       }
     }
@@ -506,10 +629,6 @@ void CameraTracking::Implementation::OnRender()
     if (!this->selectedTrackTarget.empty() ||
           !this->selectedFollowTarget.empty())
     {
-      rendering::NodePtr targetFollow = this->scene->NodeByName(
-            this->selectedFollowTarget);
-      rendering::NodePtr targetTrack = this->scene->NodeByName(
-            this->selectedTrackTarget);
       if (targetFollow || targetTrack)
       {
         if (this->trackMode == gz::msgs::CameraTrack::FOLLOW_FREE_LOOK ||
@@ -568,6 +687,7 @@ void CameraTracking::Implementation::OnRender()
                << this->selectedTrackTarget << "' not found" << std::endl;
         gzerr << "Unable to follow target. Target: '"
                << this->selectedFollowTarget << "' not found" << std::endl;
+        std::lock_guard<std::mutex> lock(this->mutex);
         this->selectedFollowTarget.clear();
         this->selectedTrackTarget.clear();
       }
@@ -590,18 +710,33 @@ void CameraTracking::Implementation::OnRender()
 CameraTracking::CameraTracking()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
+  this->dataPtr->owner = this;
   this->dataPtr->timer = new QTimer(this);
   connect(this->dataPtr->timer, &QTimer::timeout, this->dataPtr->timer, [=]()
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
     if (!this->dataPtr->camera)
      return;
-    if (this->dataPtr->cameraPosePub.HasConnections())
+
+    // Only publish when something changed, or to new subscribers
+    const bool poseConnected = this->dataPtr->cameraPosePub.HasConnections();
+    if (poseConnected)
     {
-      auto poseMsg = msgs::Convert(this->dataPtr->camera->WorldPose());
-      this->dataPtr->cameraPosePub.Publish(poseMsg);
+      const auto pose = this->dataPtr->camera->WorldPose();
+      if (!this->dataPtr->poseConnected || this->dataPtr->PoseChanged(pose))
+      {
+        this->dataPtr->cameraPosePub.Publish(msgs::Convert(pose));
+        this->dataPtr->publishedPose = pose;
+      }
     }
-    if (this->dataPtr->trackStatusPub.HasConnections())
+    this->dataPtr->poseConnected = poseConnected;
+
+    const bool trackStatusConnected =
+        this->dataPtr->trackStatusPub.HasConnections();
+    const bool newTrackStatusSubscriber =
+        trackStatusConnected && !this->dataPtr->trackStatusConnected;
+    this->dataPtr->trackStatusConnected = trackStatusConnected;
+    if (trackStatusConnected)
     {
       if (this->dataPtr->trackMode == gz::msgs::CameraTrack::TRACK)
       {
@@ -689,15 +824,40 @@ CameraTracking::CameraTracking()
         this->dataPtr->trackMsg.clear_follow_pgain();
       }
 
-      this->dataPtr->trackStatusPub.Publish(this->dataPtr->trackMsg);
+      auto trackStatus = this->dataPtr->trackMsg.SerializeAsString();
+      if (newTrackStatusSubscriber ||
+          trackStatus != this->dataPtr->publishedTrackStatus)
+      {
+        this->dataPtr->trackStatusPub.Publish(this->dataPtr->trackMsg);
+        this->dataPtr->publishedTrackStatus = std::move(trackStatus);
+      }
     }
   });
-  this->dataPtr->timer->setInterval(1000.0 / 50.0);
-  this->dataPtr->timer->start();
 }
 
 /////////////////////////////////////////////////
-CameraTracking::~CameraTracking() = default;
+bool CameraTracking::Implementation::PoseChanged(
+    const math::Pose3d &_pose) const
+{
+  if (!this->publishedPose)
+    return true;
+
+  if (_pose.Pos().Distance(this->publishedPose->Pos()) > this->poseThreshold)
+    return true;
+
+  const auto delta = this->publishedPose->Rot().Inverse() * _pose.Rot();
+  const double angle = 2.0 * std::acos(std::min(1.0, std::abs(delta.W())));
+  return angle > this->poseThreshold;
+}
+
+/////////////////////////////////////////////////
+CameraTracking::~CameraTracking()
+{
+  // The callbacks use the private data
+  this->dataPtr->trackSubscription.Reset();
+  if (auto *app = App())
+    app->Nodes()->Release(this);
+}
 
 /////////////////////////////////////////////////
 void CameraTracking::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
@@ -731,6 +891,27 @@ void CameraTracking::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
             << this->dataPtr->followPGain << "]" << std::endl;
       this->dataPtr->newTrack = true;
     }
+    if (auto elem = _pluginElem->FirstChildElement("publish_rate"))
+    {
+      elem->QueryDoubleText(&this->dataPtr->publishRate);
+    }
+    if (auto elem = _pluginElem->FirstChildElement("pose_threshold"))
+    {
+      elem->QueryDoubleText(&this->dataPtr->poseThreshold);
+    }
+  }
+
+  if (this->dataPtr->publishRate > 0.0)
+  {
+    this->dataPtr->timer->setInterval(
+        static_cast<int>(1000.0 / this->dataPtr->publishRate));
+    this->dataPtr->timer->start();
+  }
+  else
+  {
+    this->dataPtr->timer->stop();
+    gzmsg << "CameraTracking: Camera pose and tracking status publishing "
+          << "disabled" << std::endl;
   }
 
   App()->findChild<MainWindow *>()->installEventFilter(this);
@@ -742,15 +923,22 @@ void CameraTracking::Implementation::HandleKeyRelease(
 {
   if (_e->Key().Key() == Qt::Key_Escape)
   {
-    this->trackMode = gz::msgs::CameraTrack::NONE;
-    if (!this->selectedFollowTarget.empty() ||
-          !this->selectedTrackTarget.empty())
+    bool tracking{false};
     {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      tracking = !this->selectedFollowTarget.empty() ||
+          !this->selectedTrackTarget.empty();
+    }
+
+    this->Request([this]()
+    {
+      this->trackMode = gz::msgs::CameraTrack::NONE;
       this->selectedFollowTarget = std::string();
       this->selectedTrackTarget = std::string();
+    });
 
+    if (tracking)
       _e->accept();
-    }
   }
 }
 
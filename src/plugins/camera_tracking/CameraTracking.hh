@@ -40,7 +40,23 @@ namespace gz::gui::plugins
   ///                   identified by name, offset, pgain, track type.
   ///
   /// Topics:
-  /// * `/gui/camera/pose`: Publishes the current user camera pose.
+  /// * `/gui/camera/pose`: Publishes the current user camera pose when it
+  ///                       changes.
+  /// * `/gui/currently_tracked`: Publishes the tracking status when it
+  ///                             changes.
+  ///
+  /// Both are also published once to new subscribers.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<follow_target\> : Name of a target to follow once it appears.
+  /// * \<follow_offset\> : Offset of the camera from the followed target.
+  /// * \<follow_pgain\> : Follow P gain.
+  /// * \<publish_rate\> : Maximum rate to publish the topics above at, in
+  ///                      Hz. Defaults to 50, 0 disables publishing.
+  /// * \<pose_threshold\> : Distance in meters, or angle in radians, the
+  ///                        camera must move for its pose to be published
+  ///                        again. Defaults to 0.001.
   class CameraTracking : public Plugin
   {
     Q_OBJECT
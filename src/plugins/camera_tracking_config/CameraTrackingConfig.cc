@@ -30,8 +30,7 @@
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/Conversions.hh"
-#include "gz/gui/GuiEvents.hh"
-#include "gz/gui/MainWindow.hh"
+#include "gz/gui/RenderHooks.hh"
 
 #include <gz/transport/Node.hh>
 
@@ -66,6 +65,10 @@ class gz::gui::plugins::CameraTrackingConfigPrivate
 
   /// \brief track publisher
   public: transport::Node::Publisher trackingPub;
+
+  /// \brief Keeps the render callback registered. Last member so it's
+  /// destroyed first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
 };
 
 using namespace gz;
@@ -95,23 +98,12 @@ void CameraTrackingConfig::LoadConfig(const tinyxml2::XMLElement *)
   gzmsg << "CameraTrackingConfig: Tracking topic publisher advertised on ["
          << this->dataPtr->cameraTrackingTopic << "]" << std::endl;
 
-  gui::App()->findChild<
-      MainWindow *>()->installEventFilter(this);
-}
-
-/////////////////////////////////////////////////
-bool CameraTrackingConfig::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
-  {
-    if (this->dataPtr->newTrackingUpdate)
-    {
-      this->dataPtr->UpdateTracking();
-    }
-  }
-
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  this->dataPtr->renderConnection = RenderHooks::OnRender(
+      [this]()
+      {
+        if (this->dataPtr->newTrackingUpdate)
+          this->dataPtr->UpdateTracking();
+      }, 0, "CameraTrackingConfig");
 }
 
 /////////////////////////////////////////////////
@@ -134,6 +126,7 @@ void CameraTrackingConfig::SetTracking(
           << this->dataPtr->followOffset << "), PGain("
           << this->dataPtr->followPGain << ")" << std::endl;
     this->dataPtr->newTrackingUpdate = true;
+    RenderHooks::RequestRender();
   }
 }
 
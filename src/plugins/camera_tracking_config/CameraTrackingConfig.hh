@@ -59,9 +59,6 @@ namespace plugins
           double _tx, double _ty, double _tz, double _tp,
           double _fx, double _fy, double _fz, double _fp);
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<CameraTrackingConfigPrivate> dataPtr;
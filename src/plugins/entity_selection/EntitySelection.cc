@@ -0,0 +1,493 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/MouseEvent.hh>
+#include <gz/gui/Application.hh>
+#include <gz/gui/EventBus.hh>
+#include <gz/gui/GuiEvents.hh>
+#include <gz/gui/MainWindow.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/SceneIndex.hh>
+#include <gz/gui/SceneSelection.hh>
+#include <gz/gui/SceneServices.hh>
+#include <gz/math/Color.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RayQuery.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+#include "EntitySelection.hh"
+#include "SelectionGeometry.hh"
+
+namespace gz::gui::plugins
+{
+/// \brief Rendering objects drawing lines
+struct DrawnLines
+{
+  /// \brief Visual holding the lines
+  rendering::VisualPtr visual;
+
+  /// \brief Line geometry
+  rendering::MarkerPtr marker;
+
+  /// \brief Material, for the color
+  rendering::MaterialPtr material;
+};
+
+class EntitySelection::Implementation
+{
+  /// \brief Describe the user camera for SelectionGeometry
+  /// \param[in] _camera User camera
+  /// \return Its view
+  public: static SelectionGeometry::View View(
+      const rendering::CameraPtr &_camera);
+
+  /// \brief Find the entity under a pixel. Called in the render thread.
+  /// \param[in] _camera User camera
+  /// \param[in] _index Index of the scene's entities
+  /// \param[in] _pixel Pixel, from the top left corner of the image
+  /// \return Id of the entity, if there's one
+  public: static std::optional<unsigned int> Pick(
+      const rendering::CameraPtr &_camera, const SceneIndex &_index,
+      const math::Vector2d &_pixel);
+
+  /// \brief Handle a mouse press. Called in the render thread.
+  /// \param[in] _mouse Mouse event
+  public: void OnPress(const common::MouseEvent &_mouse);
+
+  /// \brief Handle a mouse drag. Called in the render thread.
+  /// \param[in] _mouse Mouse event
+  public: void OnDrag(const common::MouseEvent &_mouse);
+
+  /// \brief Handle a left button release. Called in the render thread.
+  /// \param[in] _mouse Mouse event
+  public: void OnRelease(const common::MouseEvent &_mouse);
+
+  /// \brief Update the outlines and the selection rectangle. Called in the
+  /// render thread before each frame.
+  /// \return True if the selection changed since the last call
+  public: bool Draw();
+
+  /// \brief Create objects drawing lines. Called in the render thread.
+  /// \param[in] _scene Scene to draw in
+  /// \param[in] _type Type of lines
+  /// \return The objects, added to the scene
+  public: DrawnLines CreateLines(const rendering::ScenePtr &_scene,
+      rendering::MarkerType _type) const;
+
+  /// \brief Selected entities, shared with other plugins
+  public: std::shared_ptr<SceneSelection> selection;
+
+  /// \brief Color of the outlines and selection rectangle
+  public: math::Color color{1.0f, 0.6f, 0.0f, 1.0f};
+
+  /// \brief Number of selected entities, read by the GUI
+  public: std::atomic<int> count{0};
+
+  /// \brief True while a selection rectangle is being dragged. The
+  /// rectangle's state is only used in the render thread.
+  public: bool banding{false};
+
+  /// \brief True if the rectangle adds to the selection instead of
+  /// replacing it
+  public: bool bandAdds{false};
+
+  /// \brief Corner of the rectangle where the drag started, in pixels
+  public: math::Vector2d bandStart;
+
+  /// \brief Corner of the rectangle under the cursor, in pixels
+  public: math::Vector2d bandEnd;
+
+  /// \brief Selection version last drawn
+  public: uint64_t drawnVersion{0};
+
+  /// \brief Selected ids last drawn, sorted
+  public: std::vector<unsigned int> drawnIds;
+
+  /// \brief Outline points last drawn. Entities move, so their boxes are
+  /// fetched again each frame, but the marker is only rebuilt when these
+  /// change.
+  public: std::vector<math::Vector3d> drawnPoints;
+
+  /// \brief Outlines of the selected entities
+  public: DrawnLines outlines;
+
+  /// \brief Selection rectangle
+  public: DrawnLines band;
+
+  /// \brief Keeps the selection drawn before each frame. Destroyed before
+  /// the rest, after the event connections.
+  public: RenderHookConnectionPtr renderConnection;
+
+  /// \brief Keep the scene events subscribed. Last, so they're
+  /// unsubscribed before the rest is destroyed.
+  public: std::vector<EventBusConnectionPtr> eventConnections;
+};
+
+/////////////////////////////////////////////////
+/// \brief Let the camera orbit with the left button, or stop it so the
+/// button drags a selection rectangle instead
+/// \param[in] _block True to stop orbiting
+static void blockOrbit(bool _block)
+{
+  events::BlockOrbit event(_block);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &event);
+}
+
+/////////////////////////////////////////////////
+SelectionGeometry::View EntitySelection::Implementation::View(
+    const rendering::CameraPtr &_camera)
+{
+  SelectionGeometry::View view;
+  view.pose = _camera->WorldPose();
+  view.hfov = _camera->HFOV().Radian();
+  view.width = _camera->ImageWidth();
+  view.height = _camera->ImageHeight();
+  view.near = _camera->NearClipPlane();
+  view.far = _camera->FarClipPlane();
+  return view;
+}
+
+/////////////////////////////////////////////////
+std::optional<unsigned int> EntitySelection::Implementation::Pick(
+    const rendering::CameraPtr &_camera, const SceneIndex &_index,
+    const math::Vector2d &_pixel)
+{
+  const auto view = View(_camera);
+
+  // The closest point of the rendered geometry tells apart entities whose
+  // boxes overlap, such as an object on a table. The smallest box around
+  // it is the most specific entity.
+  auto rayQuery = SceneServices::Get<rendering::RayQuery>(
+      SceneServices::kUserCameraRayQuery);
+  if (nullptr != rayQuery)
+  {
+    rayQuery->SetFromCamera(_camera, math::Vector2d(
+        2.0 * _pixel.X() / std::max(1u, view.width) - 1.0,
+        1.0 - 2.0 * _pixel.Y() / std::max(1u, view.height)));
+    const auto result = rayQuery->ClosestPoint();
+    if (result)
+    {
+      const math::Vector3d epsilon(1e-3, 1e-3, 1e-3);
+      std::optional<unsigned int> smallest;
+      double smallestVolume{std::numeric_limits<double>::max()};
+      for (const auto id : _index.Overlapping(result.point - epsilon,
+          result.point + epsilon))
+      {
+        math::Vector3d min, max;
+        if (!_index.Box(id, min, max))
+          continue;
+        const auto size = max - min;
+        const double volume = size.X() * size.Y() * size.Z();
+        if (volume < smallestVolume)
+        {
+          smallestVolume = volume;
+          smallest = id;
+        }
+      }
+      if (smallest)
+        return smallest;
+    }
+  }
+
+  // Otherwise settle for the first box along the ray
+  const auto origin = view.pose.Pos();
+  const auto hits = _index.Raycast(origin,
+      SelectionGeometry::Unproject(view, _pixel, 1.0) - origin, view.far);
+  if (hits.empty())
+    return std::nullopt;
+  return hits.front().id;
+}
+
+/////////////////////////////////////////////////
+void EntitySelection::Implementation::OnPress(
+    const common::MouseEvent &_mouse)
+{
+  if (_mouse.Button() != common::MouseEvent::LEFT || !_mouse.Shift())
+    return;
+
+  this->banding = true;
+  this->bandAdds = _mouse.Control();
+  this->bandStart = math::Vector2d(_mouse.Pos().X(), _mouse.Pos().Y());
+  this->bandEnd = this->bandStart;
+  blockOrbit(true);
+}
+
+/////////////////////////////////////////////////
+void EntitySelection::Implementation::OnDrag(
+    const common::MouseEvent &_mouse)
+{
+  if (!this->banding)
+    return;
+
+  this->bandEnd = math::Vector2d(_mouse.Pos().X(), _mouse.Pos().Y());
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void EntitySelection::Implementation::OnRelease(
+    const common::MouseEvent &_mouse)
+{
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  auto index = SceneServices::Get<SceneIndex>(SceneServices::kSceneIndex);
+
+  if (this->banding)
+  {
+    this->banding = false;
+    blockOrbit(false);
+    RenderHooks::RequestRender();
+    if (nullptr == camera || nullptr == index)
+      return;
+
+    this->bandEnd = math::Vector2d(_mouse.Pos().X(), _mouse.Pos().Y());
+    const auto planes = SelectionGeometry::RectFrustum(View(camera),
+        this->bandStart, this->bandEnd);
+    const auto ids = planes.empty() ?
+        std::vector<unsigned int>() : index->Within(planes);
+    if (this->bandAdds)
+      this->selection->Add(ids);
+    else
+      this->selection->Set(ids);
+    return;
+  }
+
+  // Releasing after orbiting the camera isn't a click
+  if (_mouse.Dragging() || nullptr == camera || nullptr == index)
+    return;
+
+  const auto id = Pick(camera, *index,
+      math::Vector2d(_mouse.Pos().X(), _mouse.Pos().Y()));
+  if (_mouse.Control())
+  {
+    if (id)
+      this->selection->Toggle(*id);
+  }
+  else if (id)
+  {
+    this->selection->Set({*id});
+  }
+  else
+  {
+    this->selection->Clear();
+  }
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+DrawnLines EntitySelection::Implementation::CreateLines(
+    const rendering::ScenePtr &_scene, rendering::MarkerType _type) const
+{
+  DrawnLines lines;
+  lines.visual = _scene->CreateVisual();
+  lines.visual->SetVisibilityFlags(
+      GZ_VISIBILITY_GUI & ~GZ_VISIBILITY_SELECTABLE);
+  lines.material = _scene->CreateMaterial();
+  lines.material->SetCastShadows(false);
+  lines.material->SetAmbient(this->color);
+  lines.material->SetDiffuse(this->color);
+  lines.material->SetEmissive(this->color);
+  lines.marker = _scene->CreateMarker();
+  lines.marker->SetType(_type);
+  lines.visual->AddGeometry(lines.marker);
+  lines.visual->SetMaterial(lines.material, false);
+  _scene->RootVisual()->AddChild(lines.visual);
+  return lines;
+}
+
+/////////////////////////////////////////////////
+bool EntitySelection::Implementation::Draw()
+{
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (nullptr == camera)
+    return false;
+  auto scene = camera->Scene();
+
+  const bool changed = this->selection->IdsIfChanged(this->drawnVersion,
+      this->drawnIds);
+  if (changed)
+    this->count = static_cast<int>(this->drawnIds.size());
+
+  std::vector<math::Vector3d> points;
+  auto index = SceneServices::Get<SceneIndex>(SceneServices::kSceneIndex);
+  if (nullptr != index)
+  {
+    points.reserve(this->drawnIds.size() * 24);
+    for (const auto id : this->drawnIds)
+    {
+      math::Vector3d min, max;
+      if (index->Box(id, min, max))
+        SelectionGeometry::AppendBoxEdges(min, max, points);
+    }
+  }
+
+  if (points != this->drawnPoints)
+  {
+    if (nullptr == this->outlines.visual)
+    {
+      this->outlines = this->CreateLines(scene,
+          rendering::MarkerType::MT_LINE_LIST);
+    }
+    this->outlines.marker->ClearPoints();
+    for (const auto &point : points)
+      this->outlines.marker->AddPoint(point, this->color);
+    this->outlines.visual->SetVisible(!points.empty());
+    this->drawnPoints = std::move(points);
+  }
+
+  if (this->banding)
+  {
+    if (nullptr == this->band.visual)
+    {
+      this->band = this->CreateLines(scene,
+          rendering::MarkerType::MT_LINE_STRIP);
+    }
+
+    // Just beyond the near plane, so the rectangle is in front of the
+    // scene
+    const auto view = View(camera);
+    const double depth = view.near * 1.01;
+    this->band.marker->ClearPoints();
+    for (const auto &corner : {this->bandStart,
+        math::Vector2d(this->bandEnd.X(), this->bandStart.Y()),
+        this->bandEnd,
+        math::Vector2d(this->bandStart.X(), this->bandEnd.Y()),
+        this->bandStart})
+    {
+      this->band.marker->AddPoint(
+          SelectionGeometry::Unproject(view, corner, depth), this->color);
+    }
+    this->band.visual->SetVisible(true);
+  }
+  else if (nullptr != this->band.visual)
+  {
+    this->band.visual->SetVisible(false);
+  }
+
+  return changed;
+}
+
+/////////////////////////////////////////////////
+EntitySelection::EntitySelection()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+EntitySelection::~EntitySelection() = default;
+
+/////////////////////////////////////////////////
+void EntitySelection::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Entity selection";
+
+  if (_pluginElem)
+  {
+    auto elem = _pluginElem->FirstChildElement("color");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      std::stringstream colorStr;
+      colorStr << std::string(elem->GetText());
+      colorStr >> this->dataPtr->color;
+    }
+  }
+
+  // Join the selection of another plugin, if there's one
+  this->dataPtr->selection = SceneServices::Get<SceneSelection>(
+      SceneServices::kSelection);
+  if (nullptr == this->dataPtr->selection)
+  {
+    this->dataPtr->selection = std::make_shared<SceneSelection>();
+    SceneServices::Set(SceneServices::kSelection, this->dataPtr->selection);
+  }
+
+  this->dataPtr->renderConnection = RenderHooks::OnPreRender(
+      [this]()
+      {
+        if (this->dataPtr->Draw())
+          emit this->SelectedCountChanged();
+      }, 0, "EntitySelection");
+
+  this->dataPtr->eventConnections.push_back(
+      EventBus::Subscribe<events::MousePressOnScene>(
+      [this](const events::MousePressOnScene &_event)
+      {
+        this->dataPtr->OnPress(_event.Mouse());
+      }));
+  this->dataPtr->eventConnections.push_back(
+      EventBus::Subscribe<events::DragOnScene>(
+      [this](const events::DragOnScene &_event)
+      {
+        this->dataPtr->OnDrag(_event.Mouse());
+      }));
+  this->dataPtr->eventConnections.push_back(
+      EventBus::Subscribe<events::LeftClickOnScene>(
+      [this](const events::LeftClickOnScene &_event)
+      {
+        this->dataPtr->OnRelease(_event.Mouse());
+      }));
+
+  App()->findChild<MainWindow *>()->QuickWindow()->installEventFilter(this);
+}
+
+/////////////////////////////////////////////////
+int EntitySelection::SelectedCount() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+void EntitySelection::OnClear()
+{
+  this->dataPtr->selection->Clear();
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+bool EntitySelection::eventFilter(QObject *_obj, QEvent *_event)
+{
+  if (_event->type() == QEvent::KeyRelease)
+  {
+    auto keyEvent = static_cast<QKeyEvent *>(_event);
+    if (keyEvent->key() == Qt::Key_Escape &&
+        nullptr != this->dataPtr->selection)
+    {
+      this->OnClear();
+    }
+  }
+
+  return QObject::eventFilter(_obj, _event);
+}
+}  // namespace gz::gui::plugins
+
+// Register this plugin
+GZ_ADD_PLUGIN(gz::gui::plugins::EntitySelection,
+              gz::gui::Plugin)
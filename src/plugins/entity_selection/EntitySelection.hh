@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_ENTITYSELECTION_HH_
+#define GZ_GUI_PLUGINS_ENTITYSELECTION_HH_
+
+#include <gz/utils/ImplPtr.hh>
+
+#include <gz/gui/Plugin.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Selects entities of the 3D scene and outlines them.
+  ///
+  /// * Left click selects the entity under the cursor, or clears the
+  ///   selection when clicking the background.
+  /// * Ctrl + left click adds or removes the entity under the cursor.
+  /// * Shift + left drag selects the entities inside a rectangle, and
+  ///   Ctrl + Shift + left drag adds them to the selection.
+  /// * Escape clears the selection.
+  ///
+  /// Entities are found through the SceneIndex shared by the plugin loading
+  /// the scene, so the TransportSceneManager must be loaded with
+  /// `<scene_index>`. The selection is shared with other plugins as
+  /// SceneServices::kSelection.
+  ///
+  /// Selected entities are outlined by the edges of their boxes, all drawn
+  /// by a single line list, so the cost of drawing the selection hardly
+  /// grows with its size and the entities' own materials are untouched.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<color\> : Color of the outlines and selection rectangle, defaults
+  ///               to `1 0.6 0 1`.
+  class EntitySelection : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Number of selected entities
+    Q_PROPERTY(
+      int selectedCount
+      READ SelectedCount
+      NOTIFY SelectedCountChanged
+    )
+
+    /// \brief Constructor
+    public: EntitySelection();
+
+    /// \brief Destructor
+    public: ~EntitySelection() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    /// \brief Get the number of selected entities
+    /// \return Number of entities
+    public: Q_INVOKABLE int SelectedCount() const;
+
+    /// \brief Callback in Qt thread when the clear button is clicked
+    public slots: void OnClear();
+
+    /// \brief Notify that the number of selected entities changed
+    signals: void SelectedCountChanged();
+
+    // Documentation inherited
+    protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+#endif  // GZ_GUI_PLUGINS_ENTITYSELECTION_HH_
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Controls.Material 2.2
+import QtQuick.Layouts 1.3
+
+ToolBar {
+  id: entitySelection
+  Layout.minimumWidth: 250
+  Layout.minimumHeight: 60
+
+  background: Rectangle {
+    color: "transparent"
+  }
+
+  RowLayout {
+    spacing: 8
+    Text {
+      text: qsTr("Selected: " + EntitySelection.selectedCount)
+      font.pointSize: 14
+      color: Material.theme == Material.Light ? "#444444" : "#bbbbbb"
+    }
+    Button {
+      text: qsTr("Clear")
+      enabled: EntitySelection.selectedCount > 0
+      ToolTip.text: "Clear the selection (Esc)"
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      onClicked: {
+        EntitySelection.OnClear();
+      }
+    }
+  }
+}
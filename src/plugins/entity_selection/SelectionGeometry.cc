@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "SelectionGeometry.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Convert a pixel to normalized device coordinates
+/// \param[in] _view Camera
+/// \param[in] _pixel Pixel, from the top left corner
+/// \return X from -1 on the left to 1 on the right, Y from -1 at the
+/// bottom to 1 at the top
+math::Vector2d normalized(const SelectionGeometry::View &_view,
+    const math::Vector2d &_pixel)
+{
+  return math::Vector2d(
+      2.0 * _pixel.X() / std::max(1u, _view.width) - 1.0,
+      1.0 - 2.0 * _pixel.Y() / std::max(1u, _view.height));
+}
+
+/////////////////////////////////////////////////
+/// \brief Tangents of half the fields of view
+/// \param[in] _view Camera
+/// \return Horizontal, then vertical
+math::Vector2d halfTangents(const SelectionGeometry::View &_view)
+{
+  const double tanH = std::tan(_view.hfov * 0.5);
+  const double aspect = static_cast<double>(std::max(1u, _view.width)) /
+      std::max(1u, _view.height);
+  return math::Vector2d(tanH, tanH / aspect);
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+std::vector<math::Planed> SelectionGeometry::RectFrustum(const View &_view,
+    const math::Vector2d &_corner, const math::Vector2d &_opposite)
+{
+  const auto a = normalized(_view, _corner);
+  const auto b = normalized(_view, _opposite);
+  const double left = std::min(a.X(), b.X());
+  const double right = std::max(a.X(), b.X());
+  const double bottom = std::min(a.Y(), b.Y());
+  const double top = std::max(a.Y(), b.Y());
+  if (right <= left || top <= bottom)
+    return {};
+
+  // A point at (x, y, z) in the camera frame is at -y / (x tanH)
+  // horizontally and z / (x tanV) vertically
+  const auto tan = halfTangents(_view);
+  const std::vector<std::pair<math::Vector3d, double>> local{
+    {math::Vector3d(1, 0, 0), _view.near},
+    {math::Vector3d(-1, 0, 0), -_view.far},
+    {math::Vector3d(-left * tan.X(), -1, 0), 0.0},
+    {math::Vector3d(right * tan.X(), 1, 0), 0.0},
+    {math::Vector3d(-bottom * tan.Y(), 0, 1), 0.0},
+    {math::Vector3d(top * tan.Y(), 0, -1), 0.0}
+  };
+
+  std::vector<math::Planed> planes;
+  planes.reserve(local.size());
+  for (const auto &[normal, offset] : local)
+  {
+    const math::Vector3d world =
+        _view.pose.Rot().RotateVector(normal.Normalized());
+    const double scaled = offset / normal.Length();
+    planes.emplace_back(world, scaled + world.Dot(_view.pose.Pos()));
+  }
+  return planes;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d SelectionGeometry::Unproject(const View &_view,
+    const math::Vector2d &_pixel, double _depth)
+{
+  const auto ndc = normalized(_view, _pixel);
+  const auto tan = halfTangents(_view);
+  const math::Vector3d local(_depth, -ndc.X() * tan.X() * _depth,
+      ndc.Y() * tan.Y() * _depth);
+  return _view.pose.Pos() + _view.pose.Rot().RotateVector(local);
+}
+
+/////////////////////////////////////////////////
+void SelectionGeometry::AppendBoxEdges(const math::Vector3d &_min,
+    const math::Vector3d &_max, std::vector<math::Vector3d> &_points)
+{
+  // Corner i takes the max along X if bit 0 is set, Y bit 1 and Z bit 2
+  auto corner = [&](int _i)
+  {
+    return math::Vector3d(
+        (_i & 1) ? _max.X() : _min.X(),
+        (_i & 2) ? _max.Y() : _min.Y(),
+        (_i & 4) ? _max.Z() : _min.Z());
+  };
+
+  // Each edge joins corners differing by one bit
+  for (int i = 0; i < 8; ++i)
+  {
+    for (int bit = 1; bit < 8; bit <<= 1)
+    {
+      if (i & bit)
+        continue;
+      _points.push_back(corner(i));
+      _points.push_back(corner(i | bit));
+    }
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_SELECTIONGEOMETRY_HH_
+#define GZ_GUI_PLUGINS_SELECTIONGEOMETRY_HH_
+
+#include <vector>
+
+#include <gz/math/Plane.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#ifndef _WIN32
+#  define SelectionGeometry_EXPORTS_API \
+     __attribute__ ((visibility ("default")))
+#else
+#  if (defined(EntitySelection_EXPORTS))
+#    define SelectionGeometry_EXPORTS_API __declspec(dllexport)
+#  else
+#    define SelectionGeometry_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Geometry of the EntitySelection plugin, kept apart from the
+  /// rendering objects so it can be tested without a render engine
+  class SelectionGeometry_EXPORTS_API SelectionGeometry
+  {
+    /// \brief Perspective camera, looking along its X axis with Y to the
+    /// left and Z up
+    public: struct View
+    {
+      /// \brief World pose
+      math::Pose3d pose;
+
+      /// \brief Horizontal field of view, in radians
+      double hfov{1.0};
+
+      /// \brief Image width in pixels
+      unsigned int width{1};
+
+      /// \brief Image height in pixels
+      unsigned int height{1};
+
+      /// \brief Distance to the near clip plane
+      double near{0.1};
+
+      /// \brief Distance to the far clip plane
+      double far{1000.0};
+    };
+
+    /// \brief Compute the part of a camera's view frustum inside a
+    /// rectangle of its image
+    /// \param[in] _view Camera
+    /// \param[in] _corner One corner of the rectangle, in pixels from the
+    /// top left corner of the image
+    /// \param[in] _opposite The opposite corner
+    /// \return Planes bounding the volume, pointing inwards, in the world
+    /// frame. Empty if the rectangle has no area.
+    public: static std::vector<math::Planed> RectFrustum(const View &_view,
+        const math::Vector2d &_corner, const math::Vector2d &_opposite);
+
+    /// \brief Compute the point of the world at a pixel, at a distance in
+    /// front of the camera
+    /// \param[in] _view Camera
+    /// \param[in] _pixel Pixel, from the top left corner of the image
+    /// \param[in] _depth Distance along the camera's X axis
+    /// \return Point in the world frame
+    public: static math::Vector3d Unproject(const View &_view,
+        const math::Vector2d &_pixel, double _depth);
+
+    /// \brief Add the edges of a box, as a line list
+    /// \param[in] _min Minimum corner of the box
+    /// \param[in] _max Maximum corner of the box
+    /// \param[in,out] _points 24 points are appended, 2 per edge
+    public: static void AppendBoxEdges(const math::Vector3d &_min,
+        const math::Vector3d &_max, std::vector<math::Vector3d> &_points);
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_SELECTIONGEOMETRY_HH_
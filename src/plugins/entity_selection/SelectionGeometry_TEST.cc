@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+
+#include "SelectionGeometry.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+/////////////////////////////////////////////////
+bool inside(const std::vector<math::Planed> &_planes,
+    const math::Vector3d &_point)
+{
+  for (const auto &plane : _planes)
+  {
+    if (plane.Distance(_point) < 0)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+SelectionGeometry::View view()
+{
+  SelectionGeometry::View v;
+  v.pose = math::Pose3d(1, 2, 3, 0, 0, GZ_PI * 0.5);
+  v.hfov = GZ_PI * 0.5;
+  v.width = 800;
+  v.height = 400;
+  v.near = 0.1;
+  v.far = 100.0;
+  return v;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(SelectionGeometryTest, Unproject)
+{
+  const auto v = view();
+
+  // The camera looks along world +Y, so its left is world -X
+  const auto center = SelectionGeometry::Unproject(v, {400, 200}, 10);
+  EXPECT_NEAR(1.0, center.X(), 1e-9);
+  EXPECT_NEAR(12.0, center.Y(), 1e-9);
+  EXPECT_NEAR(3.0, center.Z(), 1e-9);
+
+  // With a 90 degree field of view the image edges are at 45 degrees, and
+  // the image is half as tall as it is wide
+  const auto topLeft = SelectionGeometry::Unproject(v, {0, 0}, 10);
+  EXPECT_NEAR(-9.0, topLeft.X(), 1e-9);
+  EXPECT_NEAR(12.0, topLeft.Y(), 1e-9);
+  EXPECT_NEAR(8.0, topLeft.Z(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(SelectionGeometryTest, RectFrustum)
+{
+  const auto v = view();
+  EXPECT_TRUE(SelectionGeometry::RectFrustum(v, {10, 10}, {10, 50}).empty());
+
+  // Corners may be given in any order
+  const auto planes = SelectionGeometry::RectFrustum(v, {600, 300},
+      {200, 100});
+  ASSERT_EQ(6u, planes.size());
+
+  // Points seen inside the rectangle are inside, at any depth between the
+  // clip planes
+  for (const double depth : {0.2, 1.0, 50.0, 99.0})
+  {
+    for (const auto &pixel : {math::Vector2d(400, 200),
+        math::Vector2d(210, 110), math::Vector2d(590, 290)})
+    {
+      EXPECT_TRUE(inside(planes,
+          SelectionGeometry::Unproject(v, pixel, depth)))
+          << pixel << " at " << depth;
+    }
+    for (const auto &pixel : {math::Vector2d(190, 200),
+        math::Vector2d(610, 200), math::Vector2d(400, 90),
+        math::Vector2d(400, 310)})
+    {
+      EXPECT_FALSE(inside(planes,
+          SelectionGeometry::Unproject(v, pixel, depth)))
+          << pixel << " at " << depth;
+    }
+  }
+
+  EXPECT_FALSE(inside(planes,
+      SelectionGeometry::Unproject(v, {400, 200}, 0.05)));
+  EXPECT_FALSE(inside(planes,
+      SelectionGeometry::Unproject(v, {400, 200}, 101.0)));
+}
+
+/////////////////////////////////////////////////
+TEST(SelectionGeometryTest, AppendBoxEdges)
+{
+  std::vector<math::Vector3d> points{math::Vector3d(9, 9, 9)};
+  SelectionGeometry::AppendBoxEdges({0, 0, 0}, {1, 2, 3}, points);
+  ASSERT_EQ(25u, points.size());
+
+  // 12 distinct edges, each along a single axis with the box's length
+  std::set<std::pair<std::vector<double>, std::vector<double>>> edges;
+  double total{0.0};
+  for (std::size_t i = 1; i < points.size(); i += 2)
+  {
+    const auto &a = points[i];
+    const auto &b = points[i + 1];
+    const auto d = b - a;
+    EXPECT_EQ(2, (d.X() == 0) + (d.Y() == 0) + (d.Z() == 0));
+    total += d.Length();
+    edges.insert({{a.X(), a.Y(), a.Z()}, {b.X(), b.Y(), b.Z()}});
+  }
+  EXPECT_EQ(12u, edges.size());
+  EXPECT_DOUBLE_EQ(4.0 * (1 + 2 + 3), total);
+}
@@ -15,20 +15,32 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
+#include <QFile>
+
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
 #include <gz/gui/Application.hh>
 #include <gz/gui/Conversions.hh>
-#include <gz/gui/GuiEvents.hh>
-#include <gz/gui/MainWindow.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/SceneCommands.hh>
+#include <gz/gui/SceneServices.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Pose3.hh>
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Grid.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/rendering/ShaderParams.hh>
+#include <gz/rendering/Visual.hh>
 
 #include "GridConfig.hh"
 
@@ -50,6 +62,26 @@ namespace gz::gui::plugins
 
     /// \brief Grid color
     math::Color color{math::Color(0.7f, 0.7f, 0.7f, 1.0f)};
+
+    /// \brief True for a grid drawn by shaders, without cell counts
+    bool infinite{false};
+
+    /// \brief Distance from the camera at which an infinite grid has faded
+    /// out
+    double fadeDistance{200.0};
+  };
+
+  /// \brief Grid drawn by shaders on a plane which follows the camera
+  struct InfiniteGrid
+  {
+    /// \brief Parameters it was inserted with
+    GridParam param;
+
+    /// \brief Visual holding the plane
+    rendering::VisualPtr visual;
+
+    /// \brief Material with the grid shaders
+    rendering::MaterialPtr material;
   };
 
   class GridConfig::Implementation
@@ -66,20 +98,28 @@ namespace gz::gui::plugins
     /// \brief Grids to add at startup
     public: std::vector<GridParam> startupGrids;
 
+    /// \brief Infinite grids, which are updated every frame
+    public: std::vector<InfiniteGrid> infiniteGrids;
+
     /// \brief Pointer to selected grid
     rendering::GridPtr grid{nullptr};
 
     /// \brief Pointer to scene
     rendering::ScenePtr scene{nullptr};
 
-    /// \brief Flag that indicates whether there are new updates to be rendered.
-    public: bool dirty{false};
-
     /// \brief True if name list needs to be refreshed.
     public: bool refreshList{true};
 
     /// \brief Visible state
     bool visible{true};
+
+    /// \brief Parameter changes to apply on the render thread. Destroyed
+    /// before the data its commands use.
+    public: SceneCommandQueue commands{"GridConfig"};
+
+    /// \brief Keeps the render callback registered. Last member so it's
+    /// destroyed first, while the rest of the data is still valid.
+    public: RenderHookConnectionPtr renderConnection;
   };
 
 /////////////////////////////////////////////////
@@ -124,6 +164,12 @@ void GridConfig::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       if (auto lengthElem = insertElem->FirstChildElement("cell_length"))
         lengthElem->QueryDoubleText(&gridParam.cellLength);
 
+      if (auto infiniteElem = insertElem->FirstChildElement("infinite"))
+        infiniteElem->QueryBoolText(&gridParam.infinite);
+
+      if (auto fadeElem = insertElem->FirstChildElement("fade_distance"))
+        fadeElem->QueryDoubleText(&gridParam.fadeDistance);
+
       auto elem = insertElem->FirstChildElement("pose");
       if (nullptr != elem && nullptr != elem->GetText())
       {
@@ -144,33 +190,28 @@ void GridConfig::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     }
   }
 
-  gui::App()->findChild<
-      MainWindow *>()->installEventFilter(this);
-}
-
-/////////////////////////////////////////////////
-bool GridConfig::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
-  {
-    if (nullptr == this->dataPtr->scene)
-      this->dataPtr->scene = rendering::sceneFromFirstRenderEngine();
+  this->dataPtr->renderConnection = RenderHooks::OnRender(
+      [this]()
+      {
+        if (nullptr == this->dataPtr->scene)
+          this->dataPtr->scene = rendering::sceneFromFirstRenderEngine();
 
-    if (nullptr != this->dataPtr->scene)
-    {
-      // Create grid setup at startup
-      this->CreateGrids();
+        if (nullptr != this->dataPtr->scene)
+        {
+          // Create grid setup at startup
+          this->CreateGrids();
 
-      // Update combo box
-      this->RefreshList();
+          // Follow the camera
+          this->UpdateInfiniteGrids();
 
-      // Update selected grid
-      this->UpdateGrid();
-    }
-  }
+          // Update combo box
+          this->RefreshList();
 
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+          // Connect to the selected grid, its parameters are applied by
+          // scene commands
+          this->ConnectToGrid();
+        }
+      }, 0, "GridConfig");
 }
 
 /////////////////////////////////////////////////
@@ -181,6 +222,12 @@ void GridConfig::CreateGrids()
 
   for (const auto &gridParam : this->dataPtr->startupGrids)
   {
+    if (gridParam.infinite)
+    {
+      this->CreateInfiniteGrid(gridParam);
+      continue;
+    }
+
     auto grid = this->dataPtr->scene->CreateGrid();
     grid->SetCellCount(gridParam.hCellCount);
     grid->SetVerticalCellCount(gridParam.vCellCount);
@@ -197,59 +244,185 @@ void GridConfig::CreateGrids()
     mat->SetSpecular(gridParam.color);
     gridVis->SetMaterial(mat);
 
-    this->dataPtr->dirty = true;
-
     gzdbg << "Created grid [" << grid->Name() << "]" << std::endl;
   }
   this->dataPtr->startupGrids.clear();
 }
 
 /////////////////////////////////////////////////
-void GridConfig::UpdateGrid()
+/// \brief Write a shader from the plugin's resources to disk, where the
+/// render engine can load it from
+/// \param[in] _name File name of the shader
+/// \return Path to the shader, empty on failure
+static std::string shaderFile(const std::string &_name)
+{
+  std::string home;
+  common::env(GZ_HOMEDIR, home);
+  const auto dir = common::joinPaths(home, ".gz", "gui", "shaders");
+  if (!common::exists(dir) && !common::createDirectories(dir))
+  {
+    gzerr << "Failed to create directory [" << dir << "]" << std::endl;
+    return "";
+  }
+
+  QFile resource(QString::fromStdString(":/GridConfig/shaders/" + _name));
+  if (!resource.open(QIODevice::ReadOnly))
+  {
+    gzerr << "Missing shader [" << _name << "]" << std::endl;
+    return "";
+  }
+  const auto data = resource.readAll();
+
+  // Only rewritten when it changed, such as after an upgrade
+  const auto path = common::joinPaths(dir, _name);
+  QFile file(QString::fromStdString(path));
+  if (file.open(QIODevice::ReadOnly) && file.readAll() == data)
+    return path;
+  file.close();
+
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+      file.write(data) != data.size())
+  {
+    gzerr << "Failed to write shader [" << path << "]" << std::endl;
+    return "";
+  }
+  return path;
+}
+
+/////////////////////////////////////////////////
+void GridConfig::CreateInfiniteGrid(const GridParam &_param)
+{
+  auto scene = this->dataPtr->scene;
+  if (nullptr == scene->Engine() || scene->Engine()->Name() != "ogre2")
+  {
+    gzwarn << "Infinite grids need the ogre2 render engine, skipping"
+           << std::endl;
+    return;
+  }
+
+  const auto vertexShader = shaderFile("infinite_grid_vs.glsl");
+  const auto fragmentShader = shaderFile("infinite_grid_fs.glsl");
+  if (vertexShader.empty() || fragmentShader.empty())
+    return;
+
+  InfiniteGrid grid;
+  grid.param = _param;
+
+  grid.material = scene->CreateMaterial();
+  grid.material->SetVertexShader(vertexShader);
+  grid.material->SetFragmentShader(fragmentShader);
+  grid.material->SetCastShadows(false);
+  grid.material->SetDepthWriteEnabled(false);
+
+  // Enables blending, the fragment shader sets the alpha of the lines
+  grid.material->SetTransparency(0.001);
+
+  auto params = grid.material->FragmentShaderParams();
+  (*params)["cell_length"] = static_cast<float>(_param.cellLength);
+  float color[4]{_param.color.R(), _param.color.G(), _param.color.B(),
+      _param.color.A()};
+  (*params)["color"].InitializeBuffer(4);
+  (*params)["color"].UpdateBuffer(color);
+  (*params)["camera"].InitializeBuffer(4);
+  (*grid.material->VertexShaderParams())["origin"].InitializeBuffer(4);
+
+  grid.visual = scene->CreateVisual();
+  grid.visual->AddGeometry(scene->CreatePlane());
+  grid.visual->SetMaterial(grid.material, false);
+  scene->RootVisual()->AddChild(grid.visual);
+
+  gzdbg << "Created infinite grid [" << grid.visual->Name() << "]"
+        << std::endl;
+  this->dataPtr->infiniteGrids.push_back(std::move(grid));
+}
+
+/////////////////////////////////////////////////
+void GridConfig::UpdateInfiniteGrids()
+{
+  if (this->dataPtr->infiniteGrids.empty())
+    return;
+
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (nullptr == camera)
+    return;
+
+  const auto cameraPos = camera->WorldPosition();
+  for (auto &grid : this->dataPtr->infiniteGrids)
+  {
+    // The plane only needs to reach where the grid has faded out, which is
+    // further from higher up
+    const double height = grid.param.pose.Pos().Z();
+    const double fade = std::max(grid.param.fadeDistance,
+        10.0 * std::abs(cameraPos.Z() - height));
+    const double scale = 2.0 * fade;
+
+    grid.visual->SetWorldPosition(cameraPos.X(), cameraPos.Y(), height);
+    grid.visual->SetLocalScale(scale, scale, 1.0);
+
+    float origin[4]{static_cast<float>(cameraPos.X()),
+        static_cast<float>(cameraPos.Y()), static_cast<float>(height),
+        static_cast<float>(scale)};
+    (*grid.material->VertexShaderParams())["origin"].UpdateBuffer(origin);
+
+    float cameraParam[4]{static_cast<float>(cameraPos.X()),
+        static_cast<float>(cameraPos.Y()), static_cast<float>(cameraPos.Z()),
+        static_cast<float>(fade)};
+    (*grid.material->FragmentShaderParams())["camera"].UpdateBuffer(
+        cameraParam);
+  }
+}
+
+/////////////////////////////////////////////////
+void GridConfig::UpdateGrid(const GridParam &_param, bool _visible)
 {
   // Connect to a grid
-  if (!this->dataPtr->grid)
+  if (!this->dataPtr->grid && this->dataPtr->scene)
     this->ConnectToGrid();
 
   // If not connected, don't update
   if (!this->dataPtr->grid)
     return;
 
-  if (!this->dataPtr->dirty)
-    return;
-
-  this->dataPtr->grid->SetVerticalCellCount(
-    this->dataPtr->gridParam.vCellCount);
-  this->dataPtr->grid->SetCellCount(
-    this->dataPtr->gridParam.hCellCount);
-  this->dataPtr->grid->SetCellLength(
-    this->dataPtr->gridParam.cellLength);
+  this->dataPtr->grid->SetVerticalCellCount(_param.vCellCount);
+  this->dataPtr->grid->SetCellCount(_param.hCellCount);
+  this->dataPtr->grid->SetCellLength(_param.cellLength);
 
   auto visual = this->dataPtr->grid->Parent();
   if (visual)
   {
-    visual->SetLocalPose(this->dataPtr->gridParam.pose);
+    visual->SetLocalPose(_param.pose);
 
     auto mat = visual->Material();
     if (mat)
     {
-      mat->SetAmbient(this->dataPtr->gridParam.color);
-      mat->SetDiffuse(this->dataPtr->gridParam.color);
-      mat->SetSpecular(this->dataPtr->gridParam.color);
+      mat->SetAmbient(_param.color);
+      mat->SetDiffuse(_param.color);
+      mat->SetSpecular(_param.color);
     }
     else
     {
       gzerr << "Grid visual missing material" << std::endl;
     }
 
-    visual->SetVisible(this->dataPtr->visible);
+    visual->SetVisible(_visible);
   }
   else
   {
     gzerr << "Grid missing parent visual" << std::endl;
   }
+}
 
-  this->dataPtr->dirty = false;
+/////////////////////////////////////////////////
+void GridConfig::RecordGridUpdate()
+{
+  // Copies, the parameters keep changing on the GUI thread
+  this->dataPtr->commands.PushLatest("grid",
+      [this, param = this->dataPtr->gridParam,
+       visible = this->dataPtr->visible]()
+      {
+        this->UpdateGrid(param, visible);
+      });
 }
 
 /////////////////////////////////////////////////
@@ -307,7 +480,7 @@ void GridConfig::OnName(const QString &_name)
   this->dataPtr->grid = nullptr;
 
   // Don't change the grid we're about to connected to
-  this->dataPtr->dirty = false;
+  this->dataPtr->commands.Clear();
 }
 
 /////////////////////////////////////////////////
@@ -327,21 +500,21 @@ void GridConfig::SetNameList(const QStringList &_nameList)
 void GridConfig::UpdateVCellCount(int _cellCount)
 {
   this->dataPtr->gridParam.vCellCount = _cellCount;
-  this->dataPtr->dirty = true;
+  this->RecordGridUpdate();
 }
 
 /////////////////////////////////////////////////
 void GridConfig::UpdateHCellCount(int _cellCount)
 {
   this->dataPtr->gridParam.hCellCount = _cellCount;
-  this->dataPtr->dirty = true;
+  this->RecordGridUpdate();
 }
 
 /////////////////////////////////////////////////
 void GridConfig::UpdateCellLength(double _length)
 {
   this->dataPtr->gridParam.cellLength = _length;
-  this->dataPtr->dirty = true;
+  this->RecordGridUpdate();
 }
 
 /////////////////////////////////////////////////
@@ -350,27 +523,28 @@ void GridConfig::SetPose(
   double _roll, double _pitch, double _yaw)
 {
   this->dataPtr->gridParam.pose = math::Pose3d(_x, _y, _z, _roll, _pitch, _yaw);
-  this->dataPtr->dirty = true;
+  this->RecordGridUpdate();
 }
 
 /////////////////////////////////////////////////
 void GridConfig::SetColor(double _r, double _g, double _b, double _a)
 {
   this->dataPtr->gridParam.color = math::Color(_r, _g, _b, _a);
-  this->dataPtr->dirty = true;
+  this->RecordGridUpdate();
 }
 
 /////////////////////////////////////////////////
 void GridConfig::OnShow(bool _checked)
 {
   this->dataPtr->visible = _checked;
-  this->dataPtr->dirty = true;
+  this->RecordGridUpdate();
 }
 
 /////////////////////////////////////////////////
 void GridConfig::OnRefresh()
 {
   this->dataPtr->refreshList = true;
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
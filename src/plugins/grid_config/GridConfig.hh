@@ -27,6 +27,7 @@
 namespace gz::gui::plugins
 {
   class GridConfigPrivate;
+  struct GridParam;
 
   /// \brief Manages grids in a Gazebo Rendering scene. This plugin can be
   /// used for:
@@ -44,6 +45,16 @@ namespace gz::gui::plugins
   ///   * \<cell_length\> : Length of each cell, defaults to 1.
   ///   * \<pose\> : Grid pose, defaults to the origin.
   ///   * \<color\> : Grid color, defaults to (0.7, 0.7, 0.7, 1.0)
+  ///   * \<infinite\> : True to draw a horizontal grid with shaders instead,
+  ///                    on a plane which follows the camera. It has no cell
+  ///                    counts, and only the height of its pose is used.
+  ///                    Cells are \<cell_length\> up close and grow tenfold
+  ///                    as they'd get too small on screen. Needs ogre2, and
+  ///                    it can't be edited from the plugin. Defaults to
+  ///                    false.
+  ///   * \<fade_distance\> : Distance from the camera at which an infinite
+  ///                         grid has faded out, which grows with the
+  ///                         camera's height. Defaults to 200.
   class GridConfig : public gz::gui::Plugin
   {
     Q_OBJECT
@@ -65,14 +76,26 @@ namespace gz::gui::plugins
     // Documentation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *) override;
 
-    // Documentation inherited
-    protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \brief Create grids defined at startup
     public: void CreateGrids();
 
-    /// \brief Update grid
-    public: void UpdateGrid();
+    /// \brief Create an infinite grid
+    /// \param[in] _param Parameters it was inserted with
+    private: void CreateInfiniteGrid(const GridParam &_param);
+
+    /// \brief Apply parameters to the connected grid. This is called in the
+    /// rendering thread, by the commands recorded when they change.
+    /// \param[in] _param Parameters
+    /// \param[in] _visible Visibility
+    public: void UpdateGrid(const GridParam &_param, bool _visible);
+
+    /// \brief Record a command applying the current parameters, replacing
+    /// the one not applied yet
+    private: void RecordGridUpdate();
+
+    /// \brief Move infinite grids under the camera. This is called in the
+    /// rendering thread.
+    public: void UpdateInfiniteGrids();
 
     /// \brief Callback to retrieve existing grid.
     public: void ConnectToGrid();
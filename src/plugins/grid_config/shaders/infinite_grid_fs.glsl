@@ -0,0 +1,67 @@
+#version 330
+
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Draws the lines of the infinite grid procedurally. Cells grow tenfold
+// whenever they'd get closer than kMinPixels on screen, blending between
+// levels, and the grid fades out with the distance to the camera.
+
+in vec3 worldPos;
+
+// Length of the finest cells
+uniform float cell_length;
+
+// Line color
+uniform vec4 color;
+
+// xyz: camera position, w: distance at which the grid has faded out
+uniform vec4 camera;
+
+out vec4 fragColor;
+
+const float kMinPixels = 8.0;
+
+// Coverage of the lines of cells of a size, one pixel wide
+float lines(vec2 _pos, float _size)
+{
+  vec2 coord = _pos / _size;
+  vec2 width = fwidth(coord);
+  vec2 dist = abs(fract(coord - 0.5) - 0.5) / width;
+  return 1.0 - min(min(dist.x, dist.y), 1.0);
+}
+
+void main()
+{
+  vec2 pixel = fwidth(worldPos.xy);
+  float lod = max(0.0,
+      log(length(pixel) * kMinPixels / cell_length) / log(10.0) + 1.0);
+  float lodFade = fract(lod);
+  float size = cell_length * pow(10.0, floor(lod));
+
+  float alpha = max(lines(worldPos.xy, size) * (1.0 - lodFade),
+      max(lines(worldPos.xy, size * 10.0),
+          lines(worldPos.xy, size * 100.0)));
+
+  float dist = distance(worldPos, camera.xyz);
+  alpha *= 1.0 - smoothstep(0.5 * camera.w, camera.w, dist);
+
+  if (alpha < 0.01)
+    discard;
+
+  fragColor = vec4(color.rgb, color.a * alpha);
+}
@@ -0,0 +1,36 @@
+#version 330
+
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Ground plane of the infinite grid, which follows the camera. Passes the
+// world position on to the fragment shader, which draws the lines.
+
+in vec4 vertex;
+
+uniform mat4 worldviewproj_matrix;
+
+// xyz: world position of the plane's center, w: its scale
+uniform vec4 origin;
+
+out vec3 worldPos;
+
+void main()
+{
+  gl_Position = worldviewproj_matrix * vertex;
+  worldPos = vec3(origin.xy + vertex.xy * origin.w, origin.z);
+}
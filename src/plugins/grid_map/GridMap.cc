@@ -0,0 +1,693 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Image.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+#include <gz/gui/Application.hh>
+#include <gz/gui/GpuUploads.hh>
+#include <gz/gui/MemoryAccounting.hh>
+#include <gz/gui/ProfileZone.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/SubscriptionHub.hh>
+#include <gz/gui/TaskPool.hh>
+#include <gz/gui/TopicRegistry.hh>
+
+#include "GridMap.hh"
+#include "GridTiles.hh"
+
+namespace gz::gui::plugins
+{
+namespace
+{
+/// \brief Pixels of a tile, ready to be uploaded
+class TilePixels
+{
+  /// \brief Cells of the tile
+  public: GridTiles::Rect rect;
+
+  /// \brief RGBA8 pixels, see GridTiles::TileImage
+  public: std::vector<uint8_t> rgba;
+};
+
+/// \brief Size and placement of the grid
+class Layout
+{
+  /// \brief Number of columns
+  public: unsigned int width{0};
+
+  /// \brief Number of rows
+  public: unsigned int height{0};
+
+  /// \brief Cells along each side of a tile
+  public: unsigned int tileSize{0};
+
+  /// \brief Size of a cell, in meters
+  public: double resolution{0};
+
+  /// \brief Pose of the grid's first cell corner in the world
+  public: math::Pose3d origin;
+};
+
+/// \brief Number of tile textures created, to name them. Textures are
+/// cached by name, so each upload needs a new one.
+std::atomic<uint64_t> g_textureCount{0};
+
+/////////////////////////////////////////////////
+/// \brief Get the box covered by a tile in the world
+/// \param[in] _layout Layout of the grid
+/// \param[in] _rect Cells of the tile
+/// \return Box
+math::AxisAlignedBox tileBounds(const Layout &_layout,
+    const GridTiles::Rect &_rect)
+{
+  const double res = _layout.resolution;
+  const double x[2]{_rect.x * res, (_rect.x + _rect.width) * res};
+  const double y[2]{_rect.y * res, (_rect.y + _rect.height) * res};
+  math::Vector3d min;
+  math::Vector3d max;
+  for (int i = 0; i < 4; ++i)
+  {
+    const math::Vector3d corner = _layout.origin.Pos() +
+        _layout.origin.Rot().RotateVector(
+        math::Vector3d(x[i % 2], y[i / 2], 0));
+    if (i == 0)
+    {
+      min = corner;
+      max = corner;
+    }
+    min.Min(corner);
+    max.Max(corner);
+  }
+  return math::AxisAlignedBox(min, max);
+}
+}  // namespace
+
+/// \brief Private data class for GridMap
+class GridMap::Implementation
+{
+  /// \brief Convert the dirty tiles and queue them for upload. Must hold
+  /// `gridMutex`.
+  public: void Convert();
+
+  /// \brief Queue the grid's layout for the render thread. Tiles waiting
+  /// to be uploaded are dropped. Must hold `gridMutex`.
+  public: void PublishLayout();
+
+  /// \brief Render callback, lays out the tiles and stages new pixels for
+  /// upload
+  public: void OnRender();
+
+  /// \brief Upload the pixels of a tile. Called on the render thread.
+  /// \param[in] _index Index of the tile
+  /// \param[in] _tile Pixels of the tile
+  public: void UploadTile(std::size_t _index, const TilePixels &_tile);
+
+  /// \brief Destroy the tiles' visuals and materials. Called on the render
+  /// thread.
+  public: void DestroyTiles();
+
+  /// \brief Subscription to whole grids
+  public: HubSubscription gridSubscription;
+
+  /// \brief Subscription to parts of the grid
+  public: HubSubscription updateSubscription;
+
+  /// \brief Topic of whole grids
+  public: std::string topic;
+
+  /// \brief Topics publishing occupancy grids
+  public: QStringList topicList;
+
+  /// \brief Most messages per second to receive on each topic, 0 for all
+  public: double maxRate{0.0};
+
+  /// \brief Cells along each side of a tile
+  public: unsigned int tileSize{256};
+
+  /// \brief Name of the palette. Only accessed from the main thread.
+  public: std::string paletteName{"map"};
+
+  /// \brief Protects the grid, from the transport threads, the main thread
+  /// and background tasks
+  public: std::mutex gridMutex;
+
+  /// \brief Cells of the grid
+  public: GridTiles tiles;
+
+  /// \brief True once a whole grid was received
+  public: bool hasGrid{false};
+
+  /// \brief Size of a cell, in meters
+  public: double resolution{0};
+
+  /// \brief Pose of the grid in the world
+  public: math::Pose3d origin;
+
+  /// \brief Color of each cell value
+  public: GridTiles::Palette palette{GridTiles::MapPalette()};
+
+  /// \brief Protects the data handed to the render thread. Locked after
+  /// `gridMutex`.
+  public: std::mutex pendingMutex;
+
+  /// \brief Tiles waiting to be uploaded, by index. A tile converted again
+  /// before it was uploaded replaces the older pixels.
+  public: std::map<std::size_t, TilePixels> pendingTiles;
+
+  /// \brief Latest layout
+  public: Layout pendingLayout;
+
+  /// \brief Incremented each time the layout changes
+  public: uint64_t layoutVersion{0};
+
+  /// \brief True if showing
+  public: std::atomic<bool> showing{true};
+
+  /// \brief Scene the grid is rendered in. Only accessed from the render
+  /// thread, and by the destructor once rendering stopped.
+  public: rendering::ScenePtr scene{nullptr};
+
+  /// \brief Visual at the grid's origin, holding the tiles
+  public: rendering::VisualPtr visual{nullptr};
+
+  /// \brief Visual of each tile, null until the tile is first uploaded
+  public: std::vector<rendering::VisualPtr> tileVisuals;
+
+  /// \brief Material of each tile, holding its texture
+  public: std::vector<rendering::MaterialPtr> tileMaterials;
+
+  /// \brief Layout of the tiles shown
+  public: Layout layout;
+
+  /// \brief Version of the layout shown
+  public: uint64_t renderedVersion{0};
+
+  /// \brief Graphics memory taken by the tiles' textures
+  public: MemoryAccount memory{"GridMap", "tiles", MemoryType::GPU};
+
+  /// \brief Tiles waiting to be uploaded within the scene's upload budget,
+  /// those the camera sees first
+  public: GpuUploadQueue uploads{"GridMap"};
+
+  /// \brief Keeps the render callback registered. Last member so it's
+  /// destroyed first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
+};
+
+/////////////////////////////////////////////////
+GridMap::GridMap()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+GridMap::~GridMap()
+{
+  this->dataPtr->gridSubscription.Reset();
+  this->dataPtr->updateSubscription.Reset();
+  if (auto *app = App())
+    app->Tasks()->CancelOwner(this);
+  this->dataPtr->renderConnection.reset();
+  this->dataPtr->uploads.Clear();
+  if (nullptr == this->dataPtr->scene)
+    return;
+
+  // Rendering calls must be made from the render thread, so destroy the
+  // tiles from a callback which disconnects itself
+  auto scene = this->dataPtr->scene;
+  auto visual = this->dataPtr->visual;
+  auto materials = std::move(this->dataPtr->tileMaterials);
+  auto connection = std::make_shared<RenderHookConnectionPtr>();
+  *connection = RenderHooks::OnRender(
+      [scene, visual, materials, connection]()
+  {
+    scene->DestroyVisual(visual, true /* recursive */);
+    for (const auto &material : materials)
+    {
+      if (material)
+        scene->DestroyMaterial(material);
+    }
+    connection->reset();
+  });
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void GridMap::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Grid map";
+
+  std::string updateTopic;
+  if (_pluginElem)
+  {
+    // Before subscribing to the topics
+    if (auto elem = _pluginElem->FirstChildElement("max_rate"))
+    {
+      double maxRate{0.0};
+      if (elem->QueryDoubleText(&maxRate) != tinyxml2::XML_SUCCESS ||
+          maxRate < 0)
+      {
+        gzerr << "Failed to parse <max_rate> value: " << elem->GetText()
+               << std::endl;
+      }
+      else
+      {
+        this->dataPtr->maxRate = maxRate;
+      }
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("tile_size"))
+    {
+      int tileSize{0};
+      if (elem->QueryIntText(&tileSize) != tinyxml2::XML_SUCCESS ||
+          tileSize < 1)
+      {
+        gzerr << "Failed to parse <tile_size> value: " << elem->GetText()
+               << std::endl;
+      }
+      else
+      {
+        this->dataPtr->tileSize = static_cast<unsigned int>(tileSize);
+      }
+    }
+
+    auto paletteElem = _pluginElem->FirstChildElement("palette");
+    if (nullptr != paletteElem && nullptr != paletteElem->GetText())
+      this->SetPalette(QString::fromStdString(paletteElem->GetText()));
+
+    auto updateElem = _pluginElem->FirstChildElement("update_topic");
+    if (nullptr != updateElem && nullptr != updateElem->GetText())
+      updateTopic = updateElem->GetText();
+
+    auto topicElem = _pluginElem->FirstChildElement("topic");
+    if (nullptr != topicElem && nullptr != topicElem->GetText())
+    {
+      this->dataPtr->topicList = {topicElem->GetText()};
+      emit this->TopicListChanged();
+      this->OnTopic(this->dataPtr->topicList.at(0));
+    }
+  }
+
+  if (!updateTopic.empty())
+  {
+    this->dataPtr->updateSubscription =
+        App()->Subscriptions()->SubscribeShared<msgs::OccupancyGrid>(
+        updateTopic,
+        [this](const std::shared_ptr<const msgs::OccupancyGrid> &_msg)
+        {
+          this->OnGridUpdate(_msg);
+        }, this->dataPtr->maxRate);
+    if (!this->dataPtr->updateSubscription.Valid())
+    {
+      gzerr << "Unable to subscribe to topic [" << updateTopic << "]"
+             << std::endl;
+    }
+  }
+
+  this->dataPtr->renderConnection = RenderHooks::OnRender(
+      [this]()
+      {
+        this->dataPtr->OnRender();
+      }, 0, "GridMap");
+}
+
+/////////////////////////////////////////////////
+void GridMap::OnGrid(const std::shared_ptr<const msgs::OccupancyGrid> &_msg)
+{
+  GZ_GUI_PROFILE("GridMap::OnGrid");
+  const auto &info = _msg->info();
+  if (static_cast<std::size_t>(info.width()) * info.height() !=
+      _msg->data().size() || !(info.resolution() > 0))
+  {
+    gzerr << "Occupancy grid of [" << info.width() << "x" << info.height()
+           << "] cells at [" << info.resolution() << "] m has ["
+           << _msg->data().size() << "] cells, ignoring it" << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->gridMutex);
+  auto &d = *this->dataPtr;
+  const auto origin = msgs::Convert(info.origin());
+  if (!d.hasGrid || info.width() != d.tiles.Width() ||
+      info.height() != d.tiles.Height() ||
+      info.resolution() != d.resolution)
+  {
+    d.tiles.Reset(info.width(), info.height(), d.tileSize);
+    d.hasGrid = true;
+    d.resolution = info.resolution();
+    d.origin = origin;
+    d.PublishLayout();
+  }
+  else if (origin != d.origin)
+  {
+    d.origin = origin;
+    d.PublishLayout();
+  }
+
+  // Same grid, only the tiles which changed are converted
+  d.tiles.SetCells(reinterpret_cast<const int8_t *>(_msg->data().data()));
+  d.Convert();
+}
+
+/////////////////////////////////////////////////
+void GridMap::OnGridUpdate(
+    const std::shared_ptr<const msgs::OccupancyGrid> &_msg)
+{
+  GZ_GUI_PROFILE("GridMap::OnGridUpdate");
+  const auto &info = _msg->info();
+  if (static_cast<std::size_t>(info.width()) * info.height() !=
+      _msg->data().size())
+  {
+    gzerr << "Occupancy grid update of [" << info.width() << "x"
+           << info.height() << "] cells has [" << _msg->data().size()
+           << "] cells, ignoring it" << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->gridMutex);
+  auto &d = *this->dataPtr;
+  if (!d.hasGrid)
+    return;
+  if (std::abs(info.resolution() - d.resolution) > 1e-6 * d.resolution)
+  {
+    gzerr << "Occupancy grid update at [" << info.resolution()
+           << "] m doesn't match the grid at [" << d.resolution
+           << "] m, ignoring it" << std::endl;
+    return;
+  }
+
+  // Place the part by its origin, in the grid's frame
+  const auto offset =
+      (d.origin.Inverse() * msgs::Convert(info.origin())).Pos();
+  d.tiles.SetRegion(std::llround(offset.X() / d.resolution),
+      std::llround(offset.Y() / d.resolution), info.width(), info.height(),
+      reinterpret_cast<const int8_t *>(_msg->data().data()));
+  d.Convert();
+}
+
+/////////////////////////////////////////////////
+void GridMap::Implementation::Convert()
+{
+  const auto dirty = this->tiles.TakeDirty();
+  if (dirty.empty())
+    return;
+
+  std::vector<std::pair<std::size_t, TilePixels>> converted(dirty.size());
+  for (std::size_t i = 0; i < dirty.size(); ++i)
+  {
+    converted[i].first = dirty[i];
+    converted[i].second.rect = this->tiles.Tile(dirty[i]);
+    this->tiles.TileImage(dirty[i], this->palette, converted[i].second.rgba);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    for (auto &[index, pixels] : converted)
+      this->pendingTiles[index] = std::move(pixels);
+  }
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void GridMap::Implementation::PublishLayout()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    this->pendingLayout.width = this->tiles.Width();
+    this->pendingLayout.height = this->tiles.Height();
+    this->pendingLayout.tileSize = this->tiles.TileSize();
+    this->pendingLayout.resolution = this->resolution;
+    this->pendingLayout.origin = this->origin;
+    ++this->layoutVersion;
+    this->pendingTiles.clear();
+  }
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void GridMap::Implementation::OnRender()
+{
+  if (nullptr == this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+
+    this->visual = this->scene->CreateVisual();
+    this->scene->RootVisual()->AddChild(this->visual);
+  }
+  this->visual->SetVisible(this->showing);
+
+  std::map<std::size_t, TilePixels> tiles;
+  Layout newLayout;
+  uint64_t version;
+  {
+    std::lock_guard<std::mutex> lock(this->pendingMutex);
+    if (this->pendingTiles.empty() &&
+        this->layoutVersion == this->renderedVersion)
+    {
+      return;
+    }
+    std::swap(tiles, this->pendingTiles);
+    newLayout = this->pendingLayout;
+    version = this->layoutVersion;
+  }
+
+  GZ_GUI_PROFILE("GridMap::OnRender");
+  if (version != this->renderedVersion)
+  {
+    // Tiles are kept when the grid only moves
+    if (newLayout.width != this->layout.width ||
+        newLayout.height != this->layout.height ||
+        newLayout.tileSize != this->layout.tileSize ||
+        newLayout.resolution != this->layout.resolution)
+    {
+      this->uploads.Clear();
+      this->DestroyTiles();
+      const std::size_t columns = newLayout.tileSize == 0 ? 0 :
+          (newLayout.width + newLayout.tileSize - 1) / newLayout.tileSize;
+      const std::size_t rows = newLayout.tileSize == 0 ? 0 :
+          (newLayout.height + newLayout.tileSize - 1) / newLayout.tileSize;
+      this->tileVisuals.resize(columns * rows);
+      this->tileMaterials.resize(columns * rows);
+      this->memory.Set(static_cast<std::size_t>(newLayout.width) *
+          newLayout.height * 4);
+    }
+    this->visual->SetLocalPose(newLayout.origin);
+    this->layout = newLayout;
+    this->renderedVersion = version;
+  }
+
+  for (auto &[index, tile] : tiles)
+  {
+    if (index >= this->tileVisuals.size())
+      continue;
+
+    const std::size_t bytes = tile.rgba.size();
+    const auto bounds = tileBounds(this->layout, tile.rect);
+    this->uploads.PushLatest(std::to_string(index), bytes,
+        [this, index = index, tile = std::move(tile)]()
+        {
+          this->UploadTile(index, tile);
+        }, bounds);
+  }
+}
+
+/////////////////////////////////////////////////
+void GridMap::Implementation::UploadTile(std::size_t _index,
+    const TilePixels &_tile)
+{
+  if (_index >= this->tileVisuals.size())
+    return;
+
+  GZ_GUI_PROFILE("GridMap::UploadTile");
+  const double resolution = this->layout.resolution;
+  auto &tileVisual = this->tileVisuals[_index];
+  if (nullptr == tileVisual)
+  {
+    // Planes are 1 m wide and centered on their visual
+    tileVisual = this->scene->CreateVisual();
+    tileVisual->AddGeometry(this->scene->CreatePlane());
+    tileVisual->SetLocalScale(_tile.rect.width * resolution,
+        _tile.rect.height * resolution, 1.0);
+    tileVisual->SetLocalPosition(
+        (_tile.rect.x + _tile.rect.width * 0.5) * resolution,
+        (_tile.rect.y + _tile.rect.height * 0.5) * resolution, 0.0);
+    this->visual->AddChild(tileVisual);
+  }
+
+  auto image = std::make_shared<common::Image>();
+  image->SetFromData(_tile.rgba.data(), _tile.rect.width, _tile.rect.height,
+      common::Image::RGBA_INT8);
+
+  // Unlit, so cells show their palette color. Transparent cells are
+  // discarded.
+  auto material = this->scene->CreateMaterial();
+  material->SetDiffuse(math::Color::White);
+  material->SetLightingEnabled(false);
+  material->SetAlphaFromTexture(true, 0.5, true /* two sided */);
+  material->SetTexture("GridMap::" + std::to_string(++g_textureCount),
+      image);
+  tileVisual->SetMaterial(material, false /* clone */);
+
+  // The previous texture goes with the previous material
+  auto &previous = this->tileMaterials[_index];
+  if (nullptr != previous)
+    this->scene->DestroyMaterial(previous);
+  previous = material;
+}
+
+/////////////////////////////////////////////////
+void GridMap::Implementation::DestroyTiles()
+{
+  for (auto &tileVisual : this->tileVisuals)
+  {
+    if (nullptr != tileVisual)
+      this->scene->DestroyVisual(tileVisual, true /* recursive */);
+  }
+  for (auto &material : this->tileMaterials)
+  {
+    if (nullptr != material)
+      this->scene->DestroyMaterial(material);
+  }
+  this->tileVisuals.clear();
+  this->tileMaterials.clear();
+}
+
+/////////////////////////////////////////////////
+QStringList GridMap::TopicList() const
+{
+  return this->dataPtr->topicList;
+}
+
+/////////////////////////////////////////////////
+void GridMap::OnTopic(const QString &_topic)
+{
+  // Unsubscribe from previous choice
+  this->dataPtr->gridSubscription.Reset();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->gridMutex);
+    this->dataPtr->hasGrid = false;
+    this->dataPtr->tiles.Reset(0, 0, this->dataPtr->tileSize);
+    this->dataPtr->resolution = 0;
+    this->dataPtr->PublishLayout();
+  }
+
+  this->dataPtr->topic = _topic.toStdString();
+  if (this->dataPtr->topic.empty())
+    return;
+
+  this->dataPtr->gridSubscription =
+      App()->Subscriptions()->SubscribeShared<msgs::OccupancyGrid>(
+      this->dataPtr->topic,
+      [this](const std::shared_ptr<const msgs::OccupancyGrid> &_msg)
+      {
+        this->OnGrid(_msg);
+      }, this->dataPtr->maxRate);
+  if (!this->dataPtr->gridSubscription.Valid())
+  {
+    gzerr << "Unable to subscribe to topic [" << this->dataPtr->topic << "]"
+           << std::endl;
+    return;
+  }
+  gzmsg << "Subscribed to " << this->dataPtr->topic << std::endl;
+}
+
+/////////////////////////////////////////////////
+QString GridMap::Palette() const
+{
+  return QString::fromStdString(this->dataPtr->paletteName);
+}
+
+/////////////////////////////////////////////////
+void GridMap::SetPalette(const QString &_palette)
+{
+  const std::string name = _palette.toStdString();
+  if (name == this->dataPtr->paletteName)
+    return;
+
+  auto palette = GridTiles::PaletteByName(name);
+  if (!palette)
+  {
+    gzerr << "Unknown palette [" << name << "], expected \"map\", "
+           << "\"costmap\" or \"raw\"" << std::endl;
+    return;
+  }
+  this->dataPtr->paletteName = name;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->gridMutex);
+    this->dataPtr->palette = *palette;
+  }
+  emit this->PaletteChanged();
+
+  // The whole grid is converted again, off the main thread
+  this->RunInBackground([this]()
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->gridMutex);
+    this->dataPtr->tiles.MarkAllDirty();
+    this->dataPtr->Convert();
+  });
+}
+
+/////////////////////////////////////////////////
+void GridMap::Show(bool _show)
+{
+  this->dataPtr->showing = _show;
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void GridMap::OnRefresh()
+{
+  gzmsg << "Refreshing topic list for occupancy grid messages."
+         << std::endl;
+
+  this->dataPtr->topicList.clear();
+  auto registry = App()->Topics();
+  registry->Scan();
+  for (const auto &topic : registry->Topics("gz.msgs.OccupancyGrid"))
+    this->dataPtr->topicList.push_back(QString::fromStdString(topic));
+  emit this->TopicListChanged();
+
+  if (!this->dataPtr->topicList.empty())
+    this->OnTopic(this->dataPtr->topicList.at(0));
+}
+}  // namespace gz::gui::plugins
+
+// Register this plugin
+GZ_ADD_PLUGIN(gz::gui::plugins::GridMap,
+              gz::gui::Plugin)
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_GRIDMAP_HH_
+#define GZ_GUI_PLUGINS_GRIDMAP_HH_
+
+#include <memory>
+
+#include <gz/msgs/occupancy_grid.pb.h>
+
+#include "gz/gui/Plugin.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Show `gz::msgs::OccupancyGrid` messages, such as navigation
+  /// maps and costmaps, as textured planes in a 3D scene.
+  ///
+  /// The grid is split into square tiles, each one a plane with its own
+  /// texture. Cell values are colored through a palette, and only the
+  /// tiles whose cells changed are converted and uploaded again, so a
+  /// costmap which changes around the robot costs little however large it
+  /// is. Conversion happens on the thread receiving the messages, the
+  /// render thread only uploads the tiles, within the scene's GPU upload
+  /// budget and those the camera sees first, see GpuUploadQueue.
+  ///
+  /// Requirements:
+  /// * A plugin that loads a 3D scene, such as `MinimalScene`
+  ///
+  /// Parameters:
+  ///
+  /// * `<topic>`: Topic to receive whole grids on. Grids with the same
+  ///   size and resolution as the one shown are compared to it tile by
+  ///   tile.
+  /// * `<update_topic>`: Optional. Topic to receive parts of the grid on,
+  ///   as `gz::msgs::OccupancyGrid` messages smaller than the grid, with
+  ///   the same resolution and orientation, whose origin places them in
+  ///   the grid. Parts received before a whole grid are dropped.
+  /// * `<palette>`: Optional. How to color the cells: "map" for occupancy
+  ///   maps, "costmap" for costmaps, whose free and unknown cells are
+  ///   transparent, or "raw" for values in gray levels. Can be changed
+  ///   from the GUI. Defaults to "map".
+  /// * `<tile_size>`: Optional. Number of cells along each side of a tile.
+  ///   Smaller tiles upload less around small changes, but take more draw
+  ///   calls. Defaults to 256.
+  /// * `<max_rate>`: Optional. Most messages per second to receive on each
+  ///   topic. Defaults to 0, all messages.
+  class GridMap : public gz::gui::Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Topics publishing occupancy grids
+    Q_PROPERTY(
+      QStringList topicList
+      READ TopicList
+      NOTIFY TopicListChanged
+    )
+
+    /// \brief Palette coloring the cells
+    Q_PROPERTY(
+      QString palette
+      READ Palette
+      WRITE SetPalette
+      NOTIFY PaletteChanged
+    )
+
+    /// \brief Constructor
+    public: GridMap();
+
+    /// \brief Destructor
+    public: ~GridMap() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    /// \brief Callback for whole grids
+    /// \param[in] _msg Grid, shared with other subscribers
+    public: void OnGrid(const std::shared_ptr<const msgs::OccupancyGrid> &_msg);
+
+    /// \brief Callback for parts of the grid
+    /// \param[in] _msg Part of the grid, shared with other subscribers
+    public: void OnGridUpdate(
+        const std::shared_ptr<const msgs::OccupancyGrid> &_msg);
+
+    /// \brief Get the topics publishing occupancy grids
+    /// \return Topics
+    public: Q_INVOKABLE QStringList TopicList() const;
+
+    /// \brief Notify that the topic list has changed
+    signals: void TopicListChanged();
+
+    /// \brief Subscribe to a topic of whole grids, clearing the grid shown
+    /// \param[in] _topic Topic
+    public: Q_INVOKABLE void OnTopic(const QString &_topic);
+
+    /// \brief Get the palette coloring the cells
+    /// \return Palette name
+    public: Q_INVOKABLE QString Palette() const;
+
+    /// \brief Color the cells with another palette, converting all tiles
+    /// again in the background
+    /// \param[in] _palette "map", "costmap" or "raw"
+    public: Q_INVOKABLE void SetPalette(const QString &_palette);
+
+    /// \brief Notify that the palette has changed
+    signals: void PaletteChanged();
+
+    /// \brief Set whether to show the grid
+    /// \param[in] _show True to show
+    public: Q_INVOKABLE void Show(bool _show);
+
+    /// \brief Refresh the list of topics publishing occupancy grids
+    public: Q_INVOKABLE void OnRefresh();
+
+    /// \internal
+    /// \brief Pointer to private data
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Controls.Material 2.1
+import QtQuick.Layouts 1.3
+import gz.gui 1.0
+import "qrc:/qml"
+
+ColumnLayout {
+  spacing: 10
+  Layout.minimumWidth: 300
+  Layout.minimumHeight: 150
+  anchors.fill: parent
+  anchors.leftMargin: 10
+  anchors.rightMargin: 10
+
+  RowLayout {
+    spacing: 10
+    Layout.fillWidth: true
+
+    Switch {
+      Layout.fillWidth: true
+      text: qsTr("Show")
+      checked: true
+      onToggled: {
+        GridMap.Show(checked)
+      }
+    }
+
+    RoundButton {
+      objectName: "refreshButton"
+      text: "\u21bb"
+      Material.background: Material.primary
+      onClicked: {
+        GridMap.OnRefresh();
+        topicCombo.currentIndex = 0
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Refresh list of topics publishing occupancy grids")
+    }
+  }
+
+  GridLayout {
+    columns: 3
+    columnSpacing: 10
+    Layout.fillWidth: true
+
+    Label {
+      Layout.columnSpan: 1
+      text: "Grid"
+    }
+
+    ComboBox {
+      id: topicCombo
+      objectName: "topicCombo"
+      Layout.columnSpan: 2
+      Layout.fillWidth: true
+      model: GridMap.topicList
+      currentIndex: 0
+      onActivated: {
+        GridMap.OnTopic(textAt(index));
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Gazebo Transport topics publishing OccupancyGrid messages")
+    }
+
+    Label {
+      Layout.columnSpan: 1
+      text: "Palette"
+    }
+
+    ComboBox {
+      objectName: "paletteCombo"
+      Layout.columnSpan: 2
+      Layout.fillWidth: true
+      model: ["map", "costmap", "raw"]
+      currentIndex: Math.max(0, model.indexOf(GridMap.palette))
+      onActivated: {
+        GridMap.SetPalette(textAt(index));
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Colors of the cell values")
+    }
+  }
+
+  Item {
+    Layout.fillHeight: true
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "test_config.hh"  // NOLINT(build/include)
+#include "GridMap.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./GridMap_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(GridMapTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Load))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"GridMap\">"
+      "<palette>costmap</palette>"
+      "<tile_size>64</tile_size>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("GridMap",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::GridMap *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Grid map");
+  EXPECT_EQ(plugin->Palette(), "costmap");
+
+  // Unknown palettes are ignored
+  plugin->SetPalette("rainbow");
+  EXPECT_EQ(plugin->Palette(), "costmap");
+  plugin->SetPalette("raw");
+  EXPECT_EQ(plugin->Palette(), "raw");
+
+  // Cleanup
+  plugins.clear();
+}
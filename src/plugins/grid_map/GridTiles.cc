@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "GridTiles.hh"
+
+namespace gz::gui::plugins
+{
+class GridTiles::Implementation
+{
+  /// \brief Number of columns
+  public: unsigned int width{0};
+
+  /// \brief Number of rows
+  public: unsigned int height{0};
+
+  /// \brief Cells along each side of a tile
+  public: unsigned int tileSize{1};
+
+  /// \brief Number of tile columns
+  public: unsigned int tileColumns{0};
+
+  /// \brief Cells, row-major
+  public: std::vector<int8_t> cells;
+
+  /// \brief Whether each tile is dirty
+  public: std::vector<bool> dirty;
+
+  /// \brief Number of dirty tiles
+  public: std::size_t dirtyCount{0};
+};
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Pack a color
+/// \param[in] _r Red
+/// \param[in] _g Green
+/// \param[in] _b Blue
+/// \param[in] _a Alpha
+/// \return Color, 0xRRGGBBAA
+uint32_t rgba(uint32_t _r, uint32_t _g, uint32_t _b, uint32_t _a = 255)
+{
+  return (_r << 24) | (_g << 16) | (_b << 8) | _a;
+}
+
+/// \brief Color of values out of range
+const uint32_t kInvalid = rgba(0, 255, 0);
+}  // namespace
+
+/////////////////////////////////////////////////
+GridTiles::GridTiles()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+GridTiles::~GridTiles() = default;
+
+/////////////////////////////////////////////////
+GridTiles::Palette GridTiles::MapPalette()
+{
+  Palette palette;
+  palette.fill(kInvalid);
+  for (uint32_t v = 0; v <= 100; ++v)
+  {
+    const uint32_t gray = 255 - (v * 255 + 50) / 100;
+    palette[v] = rgba(gray, gray, gray);
+  }
+  palette[255] = rgba(205, 205, 205);
+  return palette;
+}
+
+/////////////////////////////////////////////////
+GridTiles::Palette GridTiles::CostmapPalette()
+{
+  Palette palette;
+  palette.fill(kInvalid);
+  palette[0] = 0;
+  for (uint32_t v = 1; v <= 98; ++v)
+  {
+    const uint32_t red = ((v - 1) * 255 + 48) / 97;
+    palette[v] = rgba(red, 0, 255 - red);
+  }
+  palette[99] = rgba(0, 255, 255);
+  palette[100] = rgba(255, 0, 255);
+  palette[255] = 0;
+  return palette;
+}
+
+/////////////////////////////////////////////////
+GridTiles::Palette GridTiles::RawPalette()
+{
+  Palette palette;
+  for (uint32_t v = 0; v < palette.size(); ++v)
+    palette[v] = rgba(v, v, v);
+  return palette;
+}
+
+/////////////////////////////////////////////////
+std::optional<GridTiles::Palette> GridTiles::PaletteByName(
+    const std::string &_name)
+{
+  if (_name == "map")
+    return MapPalette();
+  if (_name == "costmap")
+    return CostmapPalette();
+  if (_name == "raw")
+    return RawPalette();
+  return std::nullopt;
+}
+
+/////////////////////////////////////////////////
+void GridTiles::Reset(unsigned int _width, unsigned int _height,
+    unsigned int _tileSize)
+{
+  auto &d = *this->dataPtr;
+  d.width = _width;
+  d.height = _height;
+  d.tileSize = std::max(1u, _tileSize);
+  d.tileColumns = (d.width + d.tileSize - 1) / d.tileSize;
+  d.cells.assign(static_cast<std::size_t>(d.width) * d.height, -1);
+  d.dirty.assign(this->TileCount(), true);
+  d.dirtyCount = d.dirty.size();
+}
+
+/////////////////////////////////////////////////
+unsigned int GridTiles::Width() const
+{
+  return this->dataPtr->width;
+}
+
+/////////////////////////////////////////////////
+unsigned int GridTiles::Height() const
+{
+  return this->dataPtr->height;
+}
+
+/////////////////////////////////////////////////
+unsigned int GridTiles::TileSize() const
+{
+  return this->dataPtr->tileSize;
+}
+
+/////////////////////////////////////////////////
+std::size_t GridTiles::TileCount() const
+{
+  const auto &d = *this->dataPtr;
+  const std::size_t rows = (d.height + d.tileSize - 1) / d.tileSize;
+  return rows * d.tileColumns;
+}
+
+/////////////////////////////////////////////////
+GridTiles::Rect GridTiles::Tile(std::size_t _index) const
+{
+  const auto &d = *this->dataPtr;
+  Rect rect;
+  rect.x = static_cast<unsigned int>(_index % d.tileColumns) * d.tileSize;
+  rect.y = static_cast<unsigned int>(_index / d.tileColumns) * d.tileSize;
+  rect.width = std::min(d.tileSize, d.width - rect.x);
+  rect.height = std::min(d.tileSize, d.height - rect.y);
+  return rect;
+}
+
+/////////////////////////////////////////////////
+int8_t GridTiles::Cell(unsigned int _x, unsigned int _y) const
+{
+  const auto &d = *this->dataPtr;
+  return d.cells[static_cast<std::size_t>(_y) * d.width + _x];
+}
+
+/////////////////////////////////////////////////
+std::size_t GridTiles::SetCells(const int8_t *_data)
+{
+  return this->SetRegion(0, 0, this->dataPtr->width, this->dataPtr->height,
+      _data);
+}
+
+/////////////////////////////////////////////////
+std::size_t GridTiles::SetRegion(int64_t _x, int64_t _y,
+    unsigned int _width, unsigned int _height, const int8_t *_data)
+{
+  auto &d = *this->dataPtr;
+  const int64_t xBegin = std::max<int64_t>(0, _x);
+  const int64_t yBegin = std::max<int64_t>(0, _y);
+  const int64_t xEnd = std::min<int64_t>(d.width, _x + _width);
+  const int64_t yEnd = std::min<int64_t>(d.height, _y + _height);
+  if (xBegin >= xEnd || yBegin >= yEnd)
+    return 0;
+
+  // Rows are compared a tile at a time, so unchanged tiles are skipped
+  // without looking at their cells one by one
+  const std::size_t before = d.dirtyCount;
+  for (int64_t y = yBegin; y < yEnd; ++y)
+  {
+    const int8_t *src = _data + (y - _y) * _width;
+    int8_t *dst = d.cells.data() + y * d.width;
+    const std::size_t tileRow = (y / d.tileSize) * d.tileColumns;
+    for (int64_t x = xBegin; x < xEnd;)
+    {
+      const int64_t end = std::min<int64_t>(xEnd,
+          (x / d.tileSize + 1) * d.tileSize);
+      const std::size_t count = static_cast<std::size_t>(end - x);
+      if (std::memcmp(dst + x, src + (x - _x), count) != 0)
+      {
+        std::memcpy(dst + x, src + (x - _x), count);
+        const std::size_t tile = tileRow + x / d.tileSize;
+        if (!d.dirty[tile])
+        {
+          d.dirty[tile] = true;
+          ++d.dirtyCount;
+        }
+      }
+      x = end;
+    }
+  }
+  return d.dirtyCount - before;
+}
+
+/////////////////////////////////////////////////
+void GridTiles::MarkAllDirty()
+{
+  auto &d = *this->dataPtr;
+  d.dirty.assign(d.dirty.size(), true);
+  d.dirtyCount = d.dirty.size();
+}
+
+/////////////////////////////////////////////////
+std::vector<std::size_t> GridTiles::TakeDirty()
+{
+  auto &d = *this->dataPtr;
+  std::vector<std::size_t> tiles;
+  tiles.reserve(d.dirtyCount);
+  for (std::size_t i = 0; i < d.dirty.size() && tiles.size() < d.dirtyCount;
+      ++i)
+  {
+    if (d.dirty[i])
+    {
+      tiles.push_back(i);
+      d.dirty[i] = false;
+    }
+  }
+  d.dirtyCount = 0;
+  return tiles;
+}
+
+/////////////////////////////////////////////////
+void GridTiles::TileImage(std::size_t _index, const Palette &_palette,
+    std::vector<uint8_t> &_rgba) const
+{
+  const auto &d = *this->dataPtr;
+  const Rect rect = this->Tile(_index);
+  _rgba.resize(static_cast<std::size_t>(rect.width) * rect.height * 4);
+  uint8_t *out = _rgba.data();
+  for (unsigned int row = 0; row < rect.height; ++row)
+  {
+    const int8_t *cells = d.cells.data() +
+        static_cast<std::size_t>(rect.y + rect.height - 1 - row) * d.width +
+        rect.x;
+    for (unsigned int col = 0; col < rect.width; ++col)
+    {
+      const uint32_t color = _palette[static_cast<uint8_t>(cells[col])];
+      *out++ = static_cast<uint8_t>(color >> 24);
+      *out++ = static_cast<uint8_t>(color >> 16);
+      *out++ = static_cast<uint8_t>(color >> 8);
+      *out++ = static_cast<uint8_t>(color);
+    }
+  }
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_GRIDTILES_HH_
+#define GZ_GUI_PLUGINS_GRIDTILES_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#ifndef _WIN32
+#  define GridTiles_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(GridMap_EXPORTS))
+#    define GridTiles_EXPORTS_API __declspec(dllexport)
+#  else
+#    define GridTiles_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Cells of an occupancy or cost grid, split into square tiles
+  /// which are converted to images separately, so an update only converts
+  /// and uploads the tiles it changed.
+  ///
+  /// Cells are int8 values, row-major, with row 0 at the grid's origin,
+  /// as in `gz::msgs::OccupancyGrid`. Tiles are numbered row-major too, and
+  /// the tiles on the last column and row are cropped to the grid.
+  class GridTiles_EXPORTS_API GridTiles
+  {
+    /// \brief Color of each cell value, packed as RGBA8, 0xRRGGBBAA,
+    /// indexed by the value read as uint8, so -1 is at 255
+    public: using Palette = std::array<uint32_t, 256>;
+
+    /// \brief Cells covered by a tile
+    public: struct Rect
+    {
+      /// \brief Column of the first cell
+      unsigned int x{0};
+
+      /// \brief Row of the first cell
+      unsigned int y{0};
+
+      /// \brief Number of columns
+      unsigned int width{0};
+
+      /// \brief Number of rows
+      unsigned int height{0};
+    };
+
+    /// \brief Constructor of an empty grid
+    public: GridTiles();
+
+    /// \brief Destructor
+    public: ~GridTiles();
+
+    /// \brief Palette of occupancy maps: free cells (0) are white, occupied
+    /// ones (100) black, unknown ones (-1) gray. Values out of range are
+    /// green.
+    /// \return Palette
+    public: static Palette MapPalette();
+
+    /// \brief Palette of costmaps: free cells (0) and unknown ones (-1) are
+    /// transparent, costs from 1 to 98 go from blue to red, inscribed cells
+    /// (99) are cyan and lethal ones (100) magenta. Values out of range
+    /// are green.
+    /// \return Palette
+    public: static Palette CostmapPalette();
+
+    /// \brief Palette showing the values as they are, from black at 0 to
+    /// white at 255, -1 included
+    /// \return Palette
+    public: static Palette RawPalette();
+
+    /// \brief Get a palette from its name
+    /// \param[in] _name "map", "costmap" or "raw"
+    /// \return Palette, or nullopt if the name is unknown
+    public: static std::optional<Palette> PaletteByName(
+        const std::string &_name);
+
+    /// \brief Resize the grid. All cells are set to -1, and all tiles are
+    /// dirty.
+    /// \param[in] _width Number of columns
+    /// \param[in] _height Number of rows
+    /// \param[in] _tileSize Number of cells along each side of a tile, at
+    /// least 1
+    public: void Reset(unsigned int _width, unsigned int _height,
+        unsigned int _tileSize);
+
+    /// \brief Get the number of columns
+    /// \return Number of columns
+    public: unsigned int Width() const;
+
+    /// \brief Get the number of rows
+    /// \return Number of rows
+    public: unsigned int Height() const;
+
+    /// \brief Get the number of cells along each side of a tile
+    /// \return Tile size
+    public: unsigned int TileSize() const;
+
+    /// \brief Get the number of tiles
+    /// \return Number of tiles
+    public: std::size_t TileCount() const;
+
+    /// \brief Get the cells covered by a tile
+    /// \param[in] _index Index of the tile, lower than TileCount()
+    /// \return Cells of the tile
+    public: Rect Tile(std::size_t _index) const;
+
+    /// \brief Get a cell
+    /// \param[in] _x Column
+    /// \param[in] _y Row
+    /// \return Value of the cell
+    public: int8_t Cell(unsigned int _x, unsigned int _y) const;
+
+    /// \brief Set all cells. Only the tiles whose cells changed become
+    /// dirty.
+    /// \param[in] _data Width() * Height() cells
+    /// \return Number of tiles which became dirty
+    public: std::size_t SetCells(const int8_t *_data);
+
+    /// \brief Set a rectangle of cells, clipped to the grid. Only the
+    /// tiles whose cells changed become dirty.
+    /// \param[in] _x Column of the first cell, may be negative
+    /// \param[in] _y Row of the first cell, may be negative
+    /// \param[in] _width Number of columns
+    /// \param[in] _height Number of rows
+    /// \param[in] _data `_width` * `_height` cells, row-major
+    /// \return Number of tiles which became dirty
+    public: std::size_t SetRegion(int64_t _x, int64_t _y,
+        unsigned int _width, unsigned int _height, const int8_t *_data);
+
+    /// \brief Mark all tiles dirty, such as when the palette changes
+    public: void MarkAllDirty();
+
+    /// \brief Take the tiles which changed since the last call
+    /// \return Indices of the dirty tiles, in increasing order
+    public: std::vector<std::size_t> TakeDirty();
+
+    /// \brief Convert a tile to an RGBA8 image. The image is flipped
+    /// vertically, its first row is the tile's last row, so it reads as
+    /// seen from above with the grid's Y axis pointing up.
+    /// \param[in] _index Index of the tile
+    /// \param[in] _palette Color of each value
+    /// \param[out] _rgba Pixels, resized to 4 bytes per cell
+    public: void TileImage(std::size_t _index, const Palette &_palette,
+        std::vector<uint8_t> &_rgba) const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "GridTiles.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(GridTilesTest, Tiles)
+{
+  GridTiles tiles;
+  EXPECT_EQ(0u, tiles.TileCount());
+  EXPECT_TRUE(tiles.TakeDirty().empty());
+
+  // 3 x 2 tiles, cropped on the last column and row
+  tiles.Reset(10, 7, 4);
+  EXPECT_EQ(10u, tiles.Width());
+  EXPECT_EQ(7u, tiles.Height());
+  EXPECT_EQ(4u, tiles.TileSize());
+  ASSERT_EQ(6u, tiles.TileCount());
+  EXPECT_EQ(-1, tiles.Cell(9, 6));
+
+  auto rect = tiles.Tile(5);
+  EXPECT_EQ(8u, rect.x);
+  EXPECT_EQ(4u, rect.y);
+  EXPECT_EQ(2u, rect.width);
+  EXPECT_EQ(3u, rect.height);
+
+  // All dirty after a reset
+  EXPECT_EQ(6u, tiles.TakeDirty().size());
+  EXPECT_TRUE(tiles.TakeDirty().empty());
+
+  // Only the tiles which changed
+  std::vector<int8_t> cells(70, -1);
+  EXPECT_EQ(0u, tiles.SetCells(cells.data()));
+  cells[5 * 10 + 9] = 100;
+  cells[1 * 10 + 1] = 50;
+  EXPECT_EQ(2u, tiles.SetCells(cells.data()));
+  EXPECT_EQ((std::vector<std::size_t>{0, 5}), tiles.TakeDirty());
+  EXPECT_EQ(100, tiles.Cell(9, 5));
+  EXPECT_EQ(50, tiles.Cell(1, 1));
+
+  // Regions are clipped
+  const std::vector<int8_t> patch{1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(1u, tiles.SetRegion(-1, 2, 3, 2, patch.data()));
+  EXPECT_EQ((std::vector<std::size_t>{0}), tiles.TakeDirty());
+  EXPECT_EQ(2, tiles.Cell(0, 2));
+  EXPECT_EQ(3, tiles.Cell(1, 2));
+  EXPECT_EQ(5, tiles.Cell(0, 3));
+  EXPECT_EQ(6, tiles.Cell(1, 3));
+  EXPECT_EQ(0u, tiles.SetRegion(-1, 2, 3, 2, patch.data()));
+  EXPECT_EQ(0u, tiles.SetRegion(20, 0, 3, 2, patch.data()));
+
+  // Across tiles
+  EXPECT_EQ(4u, tiles.SetRegion(3, 3, 3, 2, patch.data()));
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 3, 4}), tiles.TakeDirty());
+
+  tiles.MarkAllDirty();
+  EXPECT_EQ(6u, tiles.TakeDirty().size());
+}
+
+/////////////////////////////////////////////////
+TEST(GridTilesTest, TileImage)
+{
+  GridTiles tiles;
+  tiles.Reset(3, 2, 2);
+  const std::vector<int8_t> cells{0, 100, -1, 50, 120, 0};
+  tiles.SetCells(cells.data());
+
+  // Flipped, the first row of the image is the last row of the tile
+  std::vector<uint8_t> rgba;
+  tiles.TileImage(0, GridTiles::MapPalette(), rgba);
+  EXPECT_EQ((std::vector<uint8_t>{
+      127, 127, 127, 255,  0, 255, 0, 255,
+      255, 255, 255, 255,  0, 0, 0, 255}), rgba);
+
+  tiles.TileImage(1, GridTiles::MapPalette(), rgba);
+  EXPECT_EQ((std::vector<uint8_t>{
+      255, 255, 255, 255,
+      205, 205, 205, 255}), rgba);
+
+  // Free and unknown cells are transparent on costmaps
+  tiles.TileImage(1, GridTiles::CostmapPalette(), rgba);
+  EXPECT_EQ(0u, rgba[3]);
+  EXPECT_EQ(0u, rgba[7]);
+  const auto costmap = GridTiles::CostmapPalette();
+  EXPECT_EQ(0x0000FFFFu, costmap[1]);
+  EXPECT_EQ(0xFF0000FFu, costmap[98]);
+
+  EXPECT_EQ(0xFFFFFFFFu, (*GridTiles::PaletteByName("raw"))[255]);
+  EXPECT_TRUE(GridTiles::PaletteByName("map"));
+  EXPECT_FALSE(GridTiles::PaletteByName("rainbow"));
+}
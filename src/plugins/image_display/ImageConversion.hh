@@ -0,0 +1,478 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_GUI_PLUGINS_IMAGEDISPLAY_IMAGECONVERSION_HH_
+#define GZ_GUI_PLUGINS_IMAGEDISPLAY_IMAGECONVERSION_HH_
+
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/image.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QImage>
+#include <QImageReader>
+#include <QSize>
+
+#include <gz/common/Console.hh>
+
+#include "Normalize.hh"
+
+namespace gz::gui::plugins
+{
+  /// \brief Get the row stride of an image msg, checking it holds all
+  /// pixels
+  /// \param[in] _msg Image
+  /// \param[in] _bytesPerPixel Size of each pixel
+  /// \return Bytes per row, 0 if the data is too small
+  inline std::size_t ImageRowStride(const msgs::Image &_msg,
+      std::size_t _bytesPerPixel)
+  {
+    const std::size_t minStep = _msg.width() * _bytesPerPixel;
+    const std::size_t step = _msg.step() != 0 ? _msg.step() : minStep;
+    if (step < minStep || _msg.height() == 0 ||
+        _msg.data().size() < step * (_msg.height() - 1) + minStep)
+    {
+      gzerr << "Image data is too small for " << _msg.width() << "x"
+             << _msg.height() << " pixels" << std::endl;
+      return 0;
+    }
+    return step;
+  }
+
+  /// \brief Reads the rows of a single channel image msg, in place when
+  /// they're aligned for T, optionally keeping only every few pixels
+  template<typename T>
+  class ImageRows
+  {
+    /// \brief Constructor
+    /// \param[in] _msg Image with one channel of type T, must outlive this
+    /// \param[in] _step Bytes per row of the msg, see ImageRowStride
+    /// \param[in] _factor Only every `_factor`th pixel of every `_factor`th
+    /// row is read
+    public: ImageRows(const msgs::Image &_msg, std::size_t _step,
+        unsigned int _factor)
+      : msg(_msg), step(_step), factor(_factor),
+        width((_msg.width() + _factor - 1) / _factor),
+        height((_msg.height() + _factor - 1) / _factor)
+    {
+    }
+
+    /// \brief Get a row
+    /// \param[in] _y Row index, less than `height`
+    /// \return `width` values, valid until the next call
+    public: const T *Row(unsigned int _y)
+    {
+      const char *src =
+          this->msg.data().data() + _y * this->factor * this->step;
+      if (1 == this->factor &&
+          reinterpret_cast<std::uintptr_t>(src) % alignof(T) == 0)
+      {
+        return reinterpret_cast<const T *>(src);
+      }
+      this->buffer.resize(this->width);
+      if (1 == this->factor)
+      {
+        std::memcpy(this->buffer.data(), src, this->width * sizeof(T));
+      }
+      else
+      {
+        for (unsigned int x = 0; x < this->width; ++x)
+        {
+          std::memcpy(&this->buffer[x], src + x * this->factor * sizeof(T),
+              sizeof(T));
+        }
+      }
+      return this->buffer.data();
+    }
+
+    /// \brief Find the range of the values, ignoring NaNs and positive
+    /// infinity
+    /// \param[out] _min Minimum value
+    /// \param[out] _max Maximum value
+    public: void Range(float &_min, float &_max)
+    {
+      T min = std::numeric_limits<T>::max();
+      T max = std::numeric_limits<T>::lowest();
+      for (unsigned int y = 0; y < this->height; ++y)
+        Normalizer::Range(this->Row(y), this->width, min, max);
+      _min = static_cast<float>(min);
+      _max = static_cast<float>(max);
+    }
+
+    /// \brief Image read
+    private: const msgs::Image &msg;
+
+    /// \brief Bytes per row of the msg
+    private: const std::size_t step;
+
+    /// \brief Subsampling factor
+    private: const unsigned int factor;
+
+    /// \brief Values per row read
+    public: const unsigned int width;
+
+    /// \brief Rows read
+    public: const unsigned int height;
+
+    /// \brief Copy of the row, when it can't be read in place
+    private: std::vector<T> buffer;
+  };
+
+  /// \brief Scale a single channel image to 8 bit grayscale, straight from
+  /// the msg buffer. Same output as common::Image::ConvertToRGBImage, up to
+  /// rounding.
+  /// \param[in] _msg Image with one channel of type T
+  /// \param[in] _min Value shown as black, the data's minimum if not set
+  /// \param[in] _max Value shown as white, the data's maximum if not set
+  /// \param[in] _flip True to show lower values brighter
+  /// \param[in] _factor Only every `_factor`th pixel of every `_factor`th
+  /// row is converted, to get a smaller image
+  /// \return Grayscale image, null if the msg is malformed
+  template<typename T>
+  QImage NormalizeImage(const msgs::Image &_msg, std::optional<float> _min,
+      std::optional<float> _max, bool _flip, unsigned int _factor = 1)
+  {
+    const std::size_t step = ImageRowStride(_msg, sizeof(T));
+    if (0 == step)
+      return QImage();
+
+    // Rows are read in place, unless they aren't aligned for T or are
+    // subsampled
+    ImageRows<T> rows(_msg, step, _factor);
+
+    // Find the range in the data if not given, ignoring infinite values
+    if (!_min || !_max)
+    {
+      float min;
+      float max;
+      rows.Range(min, max);
+      if (!_min)
+        _min = min;
+      if (!_max)
+        _max = max;
+    }
+
+    const Normalizer normalizer(*_min, *_max, _flip);
+    QImage image(rows.width, rows.height, QImage::Format_Grayscale8);
+    for (unsigned int y = 0; y < rows.height; ++y)
+      normalizer.Apply(rows.Row(y), rows.width, image.scanLine(y));
+    return image;
+  }
+
+  /// \brief Pack a single channel image into 16 bits per pixel, for a
+  /// shader to color on the GPU. The values are scaled to the range of the
+  /// data, the high byte goes in red and the low byte in green. Blue is 255,
+  /// or 0 for NaN and infinite values.
+  ///
+  /// The range is stored in the "min" and "max" texts of the image, and
+  /// the "depth" text is "1" for depth images, "0" otherwise.
+  /// \param[in] _msg Image with one channel of type T
+  /// \param[in] _depth True for depth images, whose range starts at 0
+  /// unless there are negative values
+  /// \param[in] _factor Only every `_factor`th pixel of every `_factor`th
+  /// row is packed, to get a smaller image
+  /// \return RGB32 image, null if the msg is malformed
+  template<typename T>
+  QImage PackImage(const msgs::Image &_msg, bool _depth,
+      unsigned int _factor = 1)
+  {
+    const std::size_t step = ImageRowStride(_msg, sizeof(T));
+    if (0 == step)
+      return QImage();
+
+    ImageRows<T> rows(_msg, step, _factor);
+    float min;
+    float max;
+    rows.Range(min, max);
+    if (min > max)
+    {
+      // No finite values
+      min = 0.0f;
+      max = 0.0f;
+    }
+    if (_depth)
+      min = std::min(min, 0.0f);
+    const float scale = max > min ? 65535.0f / (max - min) : 0.0f;
+
+    QImage image(rows.width, rows.height, QImage::Format_RGB32);
+    for (unsigned int y = 0; y < rows.height; ++y)
+    {
+      const T *src = rows.Row(y);
+      auto *dst = reinterpret_cast<uint32_t *>(image.scanLine(y));
+      for (unsigned int x = 0; x < rows.width; ++x)
+      {
+        const float value = static_cast<float>(src[x]);
+        if (!std::isfinite(value))
+        {
+          dst[x] = 0xFF000000u;
+          continue;
+        }
+        const auto packed = static_cast<uint32_t>(std::clamp(
+            (value - min) * scale + 0.5f, 0.0f, 65535.0f));
+        dst[x] = 0xFF0000FFu | (packed << 8);
+      }
+    }
+    image.setText("min", QString::number(static_cast<double>(min), 'g', 9));
+    image.setText("max", QString::number(static_cast<double>(max), 'g', 9));
+    image.setText("depth", _depth ? "1" : "0");
+    return image;
+  }
+
+  /// \brief Colors of a colormap, to look values up on the GPU
+  /// \param[in] _name "gray", "turbo" or "jet"
+  /// \return 256x1 RGB32 image, from the lowest value to the highest, null
+  /// for unknown names
+  inline QImage ColormapLut(const std::string &_name)
+  {
+    QImage lut(256, 1, QImage::Format_RGB32);
+    auto *dst = reinterpret_cast<QRgb *>(lut.scanLine(0));
+    auto channel = [](double _v)
+    {
+      return static_cast<int>(std::clamp(_v, 0.0, 1.0) * 255.0 + 0.5);
+    };
+    for (int i = 0; i < 256; ++i)
+    {
+      const double t = i / 255.0;
+      double r;
+      double g;
+      double b;
+      if (_name == "gray")
+      {
+        r = g = b = t;
+      }
+      else if (_name == "jet")
+      {
+        r = 1.5 - std::abs(4.0 * t - 3.0);
+        g = 1.5 - std::abs(4.0 * t - 2.0);
+        b = 1.5 - std::abs(4.0 * t - 1.0);
+      }
+      else if (_name == "turbo")
+      {
+        // Polynomial fit of the Turbo colormap
+        r = 0.13572138 + t * (4.61539260 + t * (-42.66032258 +
+            t * (132.13108234 + t * (-152.94239396 + t * 59.28637943))));
+        g = 0.09140261 + t * (2.19418839 + t * (4.84296658 +
+            t * (-14.18503333 + t * (4.27729857 + t * 2.82956604))));
+        b = 0.10667330 + t * (12.64194608 + t * (-60.58204836 +
+            t * (110.36276771 + t * (-89.90310912 + t * 27.34824973))));
+      }
+      else
+      {
+        return QImage();
+      }
+      dst[i] = qRgb(channel(r), channel(g), channel(b));
+    }
+    return lut;
+  }
+
+  /// \brief Demosaic a Bayer image, giving each pixel the colors of the 2x2
+  /// cell it belongs to
+  /// \param[in] _msg 8 bit Bayer image
+  /// \param[in] _red Index of the red sample in each cell, row major
+  /// \param[in] _blue Index of the blue sample in each cell, row major
+  /// \param[in] _factor Only every `_factor`th pixel of every `_factor`th
+  /// row is converted, to get a smaller image
+  /// \return RGB image, null if the msg is malformed
+  inline QImage DemosaicImage(const msgs::Image &_msg, int _red, int _blue,
+      unsigned int _factor = 1)
+  {
+    const unsigned int srcWidth = _msg.width();
+    const unsigned int srcHeight = _msg.height();
+    const std::size_t step = ImageRowStride(_msg, 1);
+    if (0 == step || srcWidth < 2 || srcHeight < 2)
+      return QImage();
+
+    // The two green samples are the other ones
+    int green[2];
+    for (int i = 0, g = 0; i < 4; ++i)
+    {
+      if (i != _red && i != _blue)
+        green[g++] = i;
+    }
+
+    const unsigned int width = (srcWidth + _factor - 1) / _factor;
+    const unsigned int height = (srcHeight + _factor - 1) / _factor;
+    const auto *data = reinterpret_cast<const uint8_t *>(_msg.data().data());
+    QImage image(width, height, QImage::Format_RGB888);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      // Odd sizes reuse the last full cell
+      const unsigned int y0 = std::min((y * _factor) & ~1u, srcHeight - 2);
+      uchar *dst = image.scanLine(y);
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        const unsigned int x0 = std::min((x * _factor) & ~1u, srcWidth - 2);
+        const uint8_t cell[4]{
+            data[y0 * step + x0], data[y0 * step + x0 + 1],
+            data[(y0 + 1) * step + x0], data[(y0 + 1) * step + x0 + 1]};
+        dst[3 * x] = cell[_red];
+        dst[3 * x + 1] = static_cast<uchar>(
+            (cell[green[0]] + cell[green[1]] + 1) / 2);
+        dst[3 * x + 2] = cell[_blue];
+      }
+    }
+    return image;
+  }
+
+  /// \brief Convert an image msg into an image Qt can upload as a texture,
+  /// without intermediate buffers
+  /// \param[in] _msg Image msg, kept alive by the image if it's used as is
+  /// \param[in] _min Value shown as black in single channel images, found
+  /// in each image if not set
+  /// \param[in] _max Value shown as white in single channel images, found
+  /// in each image if not set
+  /// \param[in] _factor Only every `_factor`th pixel of every `_factor`th
+  /// row is converted, to get a smaller image
+  /// \return Converted image, null if not supported
+  inline QImage ConvertImage(const std::shared_ptr<const msgs::Image> &_msg,
+      std::optional<float> _min, std::optional<float> _max,
+      unsigned int _factor = 1)
+  {
+    _factor = std::max(1u, _factor);
+    switch (_msg->pixel_format_type())
+    {
+      case msgs::PixelFormatType::RGB_INT8:
+      {
+        const std::size_t step = ImageRowStride(*_msg, 3);
+        if (0 == step)
+          return QImage();
+
+        // Use the msg buffer directly, the image keeps the msg alive
+        const auto *data = reinterpret_cast<const uchar *>(
+            _msg->data().data());
+        if (1 == _factor)
+        {
+          return QImage(data, _msg->width(), _msg->height(),
+              static_cast<qsizetype>(step), QImage::Format_RGB888,
+              [](void *_info)
+              {
+                delete static_cast<std::shared_ptr<const msgs::Image> *>(
+                    _info);
+              },
+              new std::shared_ptr<const msgs::Image>(_msg));
+        }
+
+        const unsigned int width = (_msg->width() + _factor - 1) / _factor;
+        const unsigned int height = (_msg->height() + _factor - 1) / _factor;
+        QImage image(width, height, QImage::Format_RGB888);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+          const uchar *src = data + y * _factor * step;
+          uchar *dst = image.scanLine(y);
+          for (unsigned int x = 0; x < width; ++x)
+            std::memcpy(dst + 3 * x, src + 3 * x * _factor, 3);
+        }
+        return image;
+      }
+      // specify custom min max and also flip the pixel values
+      // i.e. darker pixels = higher values and brighter pixels = lower
+      // values
+      case msgs::PixelFormatType::R_FLOAT32:
+        return NormalizeImage<float>(*_msg, _min ? _min : 0.0f, _max, true,
+            _factor);
+      case msgs::PixelFormatType::L_INT16:
+        return NormalizeImage<uint16_t>(*_msg, _min, _max, false, _factor);
+      case msgs::PixelFormatType::L_INT8:
+        return NormalizeImage<uint8_t>(*_msg, _min, _max, false, _factor);
+      case msgs::PixelFormatType::BAYER_RGGB8:
+        return DemosaicImage(*_msg, 0, 3, _factor);
+      case msgs::PixelFormatType::BAYER_BGGR8:
+        return DemosaicImage(*_msg, 3, 0, _factor);
+      case msgs::PixelFormatType::BAYER_GBRG8:
+        return DemosaicImage(*_msg, 2, 1, _factor);
+      case msgs::PixelFormatType::BAYER_GRBG8:
+        return DemosaicImage(*_msg, 1, 2, _factor);
+      default:
+        break;
+    }
+
+    gzwarn << "Unsupported image type: "
+            << _msg->pixel_format_type() << std::endl;
+    return QImage();
+  }
+
+  /// \brief Convert an image msg for a shader which colors it on the GPU.
+  /// Single channel images are packed by PackImage, others are converted
+  /// as by ConvertImage.
+  /// \param[in] _msg Image msg
+  /// \param[in] _factor Only every `_factor`th pixel of every `_factor`th
+  /// row is converted, to get a smaller image
+  /// \return Converted image, null if not supported
+  inline QImage PackValues(const std::shared_ptr<const msgs::Image> &_msg,
+      unsigned int _factor = 1)
+  {
+    _factor = std::max(1u, _factor);
+    switch (_msg->pixel_format_type())
+    {
+      case msgs::PixelFormatType::R_FLOAT32:
+        return PackImage<float>(*_msg, true, _factor);
+      case msgs::PixelFormatType::L_INT16:
+        return PackImage<uint16_t>(*_msg, false, _factor);
+      case msgs::PixelFormatType::L_INT8:
+        return PackImage<uint8_t>(*_msg, false, _factor);
+      default:
+        return ConvertImage(_msg, std::nullopt, std::nullopt, _factor);
+    }
+  }
+
+  /// \brief Decode a compressed image, in any format Qt can read, such as
+  /// JPEG and PNG
+  /// \param[in] _msg Encoded image
+  /// \param[in] _maxSize Size to fit the image in, keeping its aspect
+  /// ratio. Formats like JPEG decode smaller images faster. Full size if
+  /// empty.
+  /// \return Decoded image, null if it couldn't be decoded
+  inline QImage DecodeImage(const msgs::Bytes &_msg,
+      const QSize &_maxSize = QSize())
+  {
+    // Read straight from the msg
+    QByteArray bytes = QByteArray::fromRawData(_msg.data().data(),
+        static_cast<int>(_msg.data().size()));
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    const QSize size = reader.size();
+    if (!_maxSize.isEmpty() && size.isValid() &&
+        (size.width() > _maxSize.width() ||
+        size.height() > _maxSize.height()))
+    {
+      reader.setScaledSize(size.scaled(_maxSize, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull())
+    {
+      gzwarn << "Failed to decode compressed image of " << _msg.data().size()
+              << " bytes: " << reader.errorString().toStdString()
+              << std::endl;
+    }
+    return image;
+  }
+}  // namespace gz::gui::plugins
+
+#endif
@@ -15,42 +15,273 @@
  *
 */
 
+#include <gz/msgs/bytes.pb.h>
 #include <gz/msgs/image.pb.h>
 
 #include "ImageDisplay.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
-#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gz/common/Console.hh>
-#include <gz/common/Image.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/MemoryAccounting.hh"
+#include "gz/gui/NodePool.hh"
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/SubscriptionHub.hh"
+#include "gz/gui/TopicRegistry.hh"
+
+#include "ImageConversion.hh"
 
 namespace gz::gui::plugins
 {
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Get the stamp of a msg header
+/// \param[in] _header Header
+/// \return Seconds, 0 if there's no stamp
+double headerStamp(const msgs::Header &_header)
+{
+  if (!_header.has_stamp())
+    return 0.0;
+  return _header.stamp().sec() + _header.stamp().nsec() * 1e-9;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a pixel of an image msg
+/// \param[in] _msg Image
+/// \param[in] _x Column, less than the width
+/// \param[in] _y Row, less than the height
+/// \return Its value, or its channels separated by spaces, empty if the
+/// format isn't supported or the msg is malformed
+std::string pixelValue(const msgs::Image &_msg, unsigned int _x,
+    unsigned int _y)
+{
+  std::size_t size;
+  switch (_msg.pixel_format_type())
+  {
+    case msgs::PixelFormatType::RGB_INT8:
+      size = 3;
+      break;
+    case msgs::PixelFormatType::R_FLOAT32:
+      size = sizeof(float);
+      break;
+    case msgs::PixelFormatType::L_INT16:
+      size = sizeof(uint16_t);
+      break;
+    case msgs::PixelFormatType::L_INT8:
+    case msgs::PixelFormatType::BAYER_RGGB8:
+    case msgs::PixelFormatType::BAYER_BGGR8:
+    case msgs::PixelFormatType::BAYER_GBRG8:
+    case msgs::PixelFormatType::BAYER_GRBG8:
+      size = 1;
+      break;
+    default:
+      return std::string();
+  }
+  const std::size_t step = ImageRowStride(_msg, size);
+  if (0 == step)
+    return std::string();
+
+  const char *pixel = _msg.data().data() + _y * step + _x * size;
+  std::ostringstream value;
+  if (_msg.pixel_format_type() == msgs::PixelFormatType::R_FLOAT32)
+  {
+    float depth;
+    std::memcpy(&depth, pixel, sizeof(depth));
+    value << depth;
+  }
+  else if (_msg.pixel_format_type() == msgs::PixelFormatType::L_INT16)
+  {
+    uint16_t level;
+    std::memcpy(&level, pixel, sizeof(level));
+    value << level;
+  }
+  else
+  {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(pixel);
+    for (std::size_t i = 0; i < size; ++i)
+      value << (i > 0 ? " " : "") << static_cast<int>(bytes[i]);
+  }
+  return value.str();
+}
+}  // namespace
+
 class ImageDisplay::Implementation
 {
+  /// \brief Worker thread loop, converts the latest msg when one arrives
+  public: void RunWorker();
+
+  /// \brief Stop and join the worker threads
+  public: void StopWorkers();
+
+  /// \brief Replace the pending conversion
+  /// \param[in] _convert Converts the latest msg
+  /// \param[in] _tag Latency trace tag of the msg
+  /// \param[in] _msg Raw image converted, null for compressed images
+  public: void SetPending(std::function<QImage()> &&_convert,
+      const LatencyTrace::Tag &_tag,
+      const std::shared_ptr<const msgs::Image> &_msg);
+
+  /// \brief Convert a raw image, as set by the colormap
+  /// \param[in] _msg Image
+  /// \return Converted image
+  public: QImage Convert(const std::shared_ptr<const msgs::Image> &_msg);
+
   /// \brief List of topics publishing image messages.
   public: QStringList topicList;
 
-  /// \brief Holds data to set as the next image
-  public: msgs::Image imageMsg;
+  /// \brief Converts the latest msg into the next image. Newer msgs
+  /// replace it if it hasn't been picked by a worker yet.
+  public: std::function<QImage()> pending;
+
+  /// \brief Latency trace tag of the `pending` msg
+  public: LatencyTrace::Tag pendingTag;
+
+  /// \brief Raw image converted by `pending`, null if it's compressed
+  public: std::shared_ptr<const msgs::Image> pendingMsg;
+
+  /// \brief Sequence number of the last conversion picked by a worker
+  public: uint64_t pickedSeq{0};
+
+  /// \brief Sequence number of `convertedImage`
+  public: uint64_t convertedSeq{0};
+
+  /// \brief Latest converted image, waiting to be displayed
+  public: QImage convertedImage;
+
+  /// \brief Latency trace tag of `convertedImage`
+  public: LatencyTrace::Tag convertedTag;
+
+  /// \brief Raw image `convertedImage` comes from, null if it's compressed
+  public: std::shared_ptr<const msgs::Image> convertedMsg;
+
+  /// \brief Latest image displayed. Only accessed from the main thread.
+  public: QImage displayedImage;
+
+  /// \brief Raw image `displayedImage` comes from, null if it's
+  /// compressed. Only accessed from the main thread.
+  public: std::shared_ptr<const msgs::Image> displayedMsg;
+
+  /// \brief Colormap of single channel images, "none" to scale them to
+  /// grayscale on the CPU
+  public: std::string colormap{"none"};
+
+  /// \brief True to pack single channel images for the colormap shader.
+  /// Read by the worker threads.
+  public: std::atomic<bool> packValues{false};
+
+  /// \brief True if the displayed image holds packed values
+  public: bool packed{false};
+
+  /// \brief Value packed as 0 in the displayed image
+  public: float valueMin{0.0f};
+
+  /// \brief Value packed as 65535 in the displayed image
+  public: float valueMax{0.0f};
+
+  /// \brief True if the displayed image is a packed depth image
+  public: bool depthImage{false};
+
+  /// \brief Value shown with the lowest color
+  public: float rangeMin{0.0f};
+
+  /// \brief Value shown with the highest color
+  public: float rangeMax{1.0f};
+
+  /// \brief True if the range follows the values of each image
+  public: bool autoRange{true};
+
+  /// \brief When workers may pick the next conversion, to respect
+  /// `maxFps`
+  public: std::chrono::steady_clock::time_point nextPick;
+
+  /// \brief True if ProcessImage is already queued on the main thread
+  public: bool processQueued{false};
+
+  /// \brief Number of images replaced before being displayed
+  public: uint64_t droppedFrames{0};
+
+  /// \brief True when the worker threads should exit
+  public: bool stopping{false};
+
+  /// \brief Number of images displayed. Only accessed from the main thread.
+  public: uint64_t displayedFrames{0};
+
+  /// \brief Number of dropped frames shown on the GUI. Only accessed from
+  /// the main thread.
+  public: uint64_t droppedGui{0};
+
+  /// \brief Maximum number of images displayed per second, 0 for no limit
+  public: double maxFps{0.0};
+
+  /// \brief Most messages per second to receive, 0 for all
+  public: double maxRate{0.0};
+
+  /// \brief True to receive images through shared memory from publishers
+  /// on the same host
+  public: bool sharedMemory{true};
+
+  /// \brief True to publish how fast images are displayed, so the
+  /// publisher can adapt
+  public: bool feedback{false};
+
+  /// \brief Value shown as black in single channel images
+  public: std::optional<float> minValue;
 
-  /// \brief Node for communication.
-  public: transport::Node node;
+  /// \brief Value shown as white in single channel images
+  public: std::optional<float> maxValue;
 
-  /// \brief Mutex for accessing image data
-  public: std::recursive_mutex imageMutex;
+  /// \brief True to subscribe to compressed images on topics without
+  /// publishers yet
+  public: bool compressed{false};
+
+  /// \brief Number of worker threads
+  public: unsigned int decodeThreads{1};
+
+  /// \brief Subscription to the image topic, shared with other plugins
+  public: HubSubscription subscription;
+
+  /// \brief Protects the msg and image handed between threads, and the
+  /// counters
+  public: std::mutex imageMutex;
+
+  /// \brief Wakes up the worker threads
+  public: std::condition_variable imageCv;
+
+  /// \brief Called from the worker thread when an image is ready
+  public: std::function<void()> imageReadyCb;
+
+  /// \brief Convert and decode images off the main thread. Consecutive
+  /// images are converted in parallel when there are more than one.
+  public: std::vector<std::thread> workers;
 
   /// \brief To provide images for QML.
   public: ImageProvider *provider{nullptr};
+
+  /// \brief Reports the bytes of the displayed image
+  public: MemoryAccount memory{"ImageDisplay", "images"};
 };
 
 /////////////////////////////////////////////////
@@ -62,6 +293,8 @@ ImageDisplay::ImageDisplay()
 /////////////////////////////////////////////////
 ImageDisplay::~ImageDisplay()
 {
+  this->dataPtr->subscription.Reset();
+  this->dataPtr->StopWorkers();
   App()->Engine()->removeImageProvider(
       this->CardItem()->objectName() + "imagedisplay");
 }
@@ -84,6 +317,90 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto pickerElem = _pluginElem->FirstChildElement("topic_picker"))
       pickerElem->QueryBoolText(&topicPicker);
+
+    if (auto fpsElem = _pluginElem->FirstChildElement("max_fps"))
+    {
+      double maxFps{0.0};
+      if (fpsElem->QueryDoubleText(&maxFps) != tinyxml2::XML_SUCCESS ||
+          maxFps < 0)
+      {
+        gzerr << "Failed to parse <max_fps> value: " << fpsElem->GetText()
+               << std::endl;
+      }
+      else
+      {
+        this->dataPtr->maxFps = maxFps;
+      }
+    }
+
+    if (auto rateElem = _pluginElem->FirstChildElement("max_rate"))
+    {
+      double maxRate{0.0};
+      if (rateElem->QueryDoubleText(&maxRate) != tinyxml2::XML_SUCCESS ||
+          maxRate < 0)
+      {
+        gzerr << "Failed to parse <max_rate> value: " << rateElem->GetText()
+               << std::endl;
+      }
+      else
+      {
+        this->dataPtr->maxRate = maxRate;
+      }
+    }
+
+    if (auto minElem = _pluginElem->FirstChildElement("min_value"))
+    {
+      float value{0.0f};
+      if (minElem->QueryFloatText(&value) == tinyxml2::XML_SUCCESS)
+        this->dataPtr->minValue = value;
+      else
+        gzerr << "Failed to parse <min_value>" << std::endl;
+    }
+
+    if (auto maxElem = _pluginElem->FirstChildElement("max_value"))
+    {
+      float value{0.0f};
+      if (maxElem->QueryFloatText(&value) == tinyxml2::XML_SUCCESS)
+        this->dataPtr->maxValue = value;
+      else
+        gzerr << "Failed to parse <max_value>" << std::endl;
+    }
+
+    if (auto compressedElem = _pluginElem->FirstChildElement("compressed"))
+      compressedElem->QueryBoolText(&this->dataPtr->compressed);
+
+    if (auto shmElem = _pluginElem->FirstChildElement("shared_memory"))
+      shmElem->QueryBoolText(&this->dataPtr->sharedMemory);
+
+    if (auto feedbackElem = _pluginElem->FirstChildElement("feedback"))
+      feedbackElem->QueryBoolText(&this->dataPtr->feedback);
+
+    auto colormapElem = _pluginElem->FirstChildElement("colormap");
+    if (nullptr != colormapElem && nullptr != colormapElem->GetText())
+      this->SetColormap(colormapElem->GetText());
+
+    if (auto threadsElem = _pluginElem->FirstChildElement("decode_threads"))
+    {
+      int threads{1};
+      if (threadsElem->QueryIntText(&threads) != tinyxml2::XML_SUCCESS ||
+          threads < 1)
+      {
+        gzerr << "Failed to parse <decode_threads> value: "
+               << threadsElem->GetText() << std::endl;
+      }
+      else
+      {
+        this->dataPtr->decodeThreads = static_cast<unsigned int>(threads);
+      }
+    }
+  }
+
+  // A fixed range shows the same values on every image
+  if (this->dataPtr->minValue && this->dataPtr->maxValue)
+  {
+    this->dataPtr->rangeMin = *this->dataPtr->minValue;
+    this->dataPtr->rangeMax = *this->dataPtr->maxValue;
+    this->dataPtr->autoRange = false;
   }
 
   if (topic.empty() && !topicPicker)
@@ -100,97 +417,220 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     this->OnRefresh();
 
   this->dataPtr->provider = new ImageProvider();
+  for (const auto &name : {"gray", "turbo", "jet"})
+  {
+    this->dataPtr->provider->SetNamedImage(QString("lut/") + name,
+        ColormapLut(name));
+  }
   App()->Engine()->addImageProvider(
       this->CardItem()->objectName() + "imagedisplay", this->dataPtr->provider);
+
+  // Called from the worker thread
+  this->dataPtr->imageReadyCb = [this]()
+  {
+    QMetaObject::invokeMethod(this, "ProcessImage", Qt::QueuedConnection);
+  };
+  for (unsigned int i = 0; i < this->dataPtr->decodeThreads; ++i)
+  {
+    this->dataPtr->workers.emplace_back(&Implementation::RunWorker,
+        this->dataPtr.get());
+  }
 }
 
 /////////////////////////////////////////////////
-void ImageDisplay::ProcessImage()
+void ImageDisplay::Implementation::RunWorker()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+  using namespace std::chrono;
+
+  std::unique_lock<std::mutex> lock(this->imageMutex);
+  while (true)
+  {
+    // Wait for a msg and until the next image is due, msgs arriving
+    // meanwhile replace the pending one
+    while (!this->stopping)
+    {
+      if (!this->pending)
+        this->imageCv.wait(lock);
+      else if (steady_clock::now() < this->nextPick)
+        this->imageCv.wait_until(lock, this->nextPick);
+      else
+        break;
+    }
+    if (this->stopping)
+      return;
+
+    auto convert = std::move(this->pending);
+    this->pending = nullptr;
+    const auto tag = this->pendingTag;
+    this->pendingTag = LatencyTrace::Tag();
+    auto msg = std::move(this->pendingMsg);
+    this->pendingMsg.reset();
+    const uint64_t seq = ++this->pickedSeq;
+    if (this->maxFps > 0.0)
+    {
+      this->nextPick = steady_clock::now() +
+          duration_cast<steady_clock::duration>(
+          duration<double>(1.0 / this->maxFps));
+    }
+    lock.unlock();
 
-  unsigned int height = this->dataPtr->imageMsg.height();
-  unsigned int width = this->dataPtr->imageMsg.width();
-  QImage::Format qFormat = QImage::Format_RGB888;
+    QImage image = convert();
+    App()->Latency()->Stage(tag, "converted");
 
-  QImage image = QImage(width, height, qFormat);
+    lock.lock();
+    if (image.isNull())
+    {
+      App()->Latency()->Drop(tag);
+      continue;
+    }
 
-  common::Image output;
-  switch (this->dataPtr->imageMsg.pixel_format_type())
+    // Another worker may have finished a newer image first
+    if (seq < this->convertedSeq || !this->convertedImage.isNull())
+      this->droppedFrames++;
+    if (seq < this->convertedSeq)
+    {
+      App()->Latency()->Drop(tag);
+      continue;
+    }
+    if (!this->convertedImage.isNull())
+      App()->Latency()->Drop(this->convertedTag);
+    this->convertedImage = std::move(image);
+    this->convertedTag = tag;
+    this->convertedMsg = std::move(msg);
+    this->convertedSeq = seq;
+
+    // Only one pending image is displayed, however fast they're converted
+    if (!this->processQueued)
+    {
+      this->processQueued = true;
+      this->imageReadyCb();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::Implementation::StopWorkers()
+{
   {
-    case msgs::PixelFormatType::RGB_INT8:
-      // copy image data buffer directly to QImage
-      image = QImage(reinterpret_cast<const uchar *>(
-          this->dataPtr->imageMsg.data().c_str()), width, height,
-          3 * width, qFormat);
-      break;
-    // for other cases, convert to RGB common::Image
-    case msgs::PixelFormatType::R_FLOAT32:
-      // specify custom min max and also flip the pixel values
-      // i.e. darker pixels = higher values and brighter pixels = lower values
-      common::Image::ConvertToRGBImage<float>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output,
-          0.0f, std::numeric_limits<float>::lowest(), true);
-      break;
-    case msgs::PixelFormatType::L_INT16:
-      common::Image::ConvertToRGBImage<uint16_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-       break;
-    case msgs::PixelFormatType::L_INT8:
-      common::Image::ConvertToRGBImage<uint8_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-      break;
-    case msgs::PixelFormatType::BAYER_RGGB8:
-    case msgs::PixelFormatType::BAYER_BGGR8:
-    case msgs::PixelFormatType::BAYER_GBRG8:
-    case msgs::PixelFormatType::BAYER_GRBG8:
-      common::Image::ConvertToRGBImage<uint8_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-      break;
-    default:
+    std::lock_guard<std::mutex> lock(this->imageMutex);
+    this->stopping = true;
+  }
+  this->imageCv.notify_all();
+  for (auto &worker : this->workers)
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::Implementation::SetPending(
+    std::function<QImage()> &&_convert, const LatencyTrace::Tag &_tag,
+    const std::shared_ptr<const msgs::Image> &_msg)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->imageMutex);
+    if (this->pending)
     {
-      gzwarn << "Unsupported image type: "
-              << this->dataPtr->imageMsg.pixel_format_type() << std::endl;
-      return;
+      this->droppedFrames++;
+      App()->Latency()->Drop(this->pendingTag);
     }
+    this->pending = std::move(_convert);
+    this->pendingTag = _tag;
+    this->pendingMsg = _msg;
   }
-  common::Image::PixelFormatType pixelFormat =
-      common::Image::ConvertPixelFormat(
-      msgs::ConvertPixelFormatType(
-      this->dataPtr->imageMsg.pixel_format_type()));
+  this->imageCv.notify_one();
+}
+
+/////////////////////////////////////////////////
+QImage ImageDisplay::Implementation::Convert(
+    const std::shared_ptr<const msgs::Image> &_msg)
+{
+  if (this->packValues)
+    return PackValues(_msg);
+  return ConvertImage(_msg, this->minValue, this->maxValue);
+}
 
+/////////////////////////////////////////////////
+void ImageDisplay::ProcessImage()
+{
+  GZ_GUI_PROFILE("ImageDisplay::ProcessImage");
 
-  // if not rgb, copy values from common::Image to QImage
-  if (pixelFormat != common::Image::PixelFormatType::RGB_INT8)
+  QImage image;
+  LatencyTrace::Tag tag;
+  std::shared_ptr<const msgs::Image> msg;
+  uint64_t dropped;
   {
-    auto data = output.Data();
+    std::lock_guard<std::mutex> lock(this->dataPtr->imageMutex);
+    this->dataPtr->processQueued = false;
+    image = std::move(this->dataPtr->convertedImage);
+    this->dataPtr->convertedImage = QImage();
+    tag = this->dataPtr->convertedTag;
+    this->dataPtr->convertedTag = LatencyTrace::Tag();
+    msg = std::move(this->dataPtr->convertedMsg);
+    this->dataPtr->convertedMsg.reset();
+    dropped = this->dataPtr->droppedFrames;
+  }
+  if (image.isNull())
+    return;
 
-    for (unsigned int j = 0; j < height; ++j)
+  this->dataPtr->displayedImage = image;
+  this->dataPtr->displayedMsg = std::move(msg);
+
+  // Range of the packed values, for the shader
+  const QString minText = image.text("min");
+  this->dataPtr->packed = !minText.isEmpty();
+  if (this->dataPtr->packed)
+  {
+    this->dataPtr->valueMin = minText.toFloat();
+    this->dataPtr->valueMax = image.text("max").toFloat();
+    this->dataPtr->depthImage = image.text("depth") == "1";
+    if (this->dataPtr->autoRange &&
+        (this->dataPtr->rangeMin != this->dataPtr->valueMin ||
+         this->dataPtr->rangeMax != this->dataPtr->valueMax))
     {
-      for (unsigned int i = 0; i < width; ++i)
-      {
-        unsigned int idx = j*width*3 + i * 3;
-        int r = data[idx];
-        int g = data[idx + 1];
-        int b = data[idx + 2];
-        QRgb value = qRgb(r, g, b);
-        image.setPixel(i, j, value);
-      }
+      this->dataPtr->rangeMin = this->dataPtr->valueMin;
+      this->dataPtr->rangeMax = this->dataPtr->valueMax;
+      emit this->RangeChanged();
     }
   }
+  emit this->ValueRangeChanged();
 
+  this->dataPtr->memory.Set(static_cast<std::size_t>(image.sizeInBytes()));
   this->dataPtr->provider->SetImage(image);
+  App()->Latency()->Hold(tag, "window");
+  this->dataPtr->displayedFrames++;
+  if (dropped > this->dataPtr->droppedGui)
+  {
+    this->dataPtr->subscription.ReportDropped(
+        dropped - this->dataPtr->droppedGui);
+  }
+  this->dataPtr->droppedGui = dropped;
   emit this->newImage();
+  emit this->FramesChanged();
 }
 
 /////////////////////////////////////////////////
-void ImageDisplay::OnImageMsg(const msgs::Image &_msg)
+void ImageDisplay::OnImageMsg(const std::shared_ptr<const msgs::Image> &_msg,
+    const LatencyTrace::Tag &_tag)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
-  this->dataPtr->imageMsg = _msg;
+  auto msg = _msg;
+  this->dataPtr->SetPending([msg, this]()
+  {
+    return this->dataPtr->Convert(msg);
+  }, _tag, _msg);
+}
 
-  // Signal to main thread that the image changed
-  QMetaObject::invokeMethod(this, "ProcessImage");
+/////////////////////////////////////////////////
+void ImageDisplay::OnCompressedMsg(
+    const std::shared_ptr<const msgs::Bytes> &_msg,
+    const LatencyTrace::Tag &_tag)
+{
+  auto msg = _msg;
+  this->dataPtr->SetPending([msg]()
+  {
+    return DecodeImage(*msg);
+  }, _tag, nullptr);
 }
 
 /////////////////////////////////////////////////
@@ -205,13 +645,44 @@ void ImageDisplay::OnTopic(const QString _topic)
   }
 
   // Unsubscribe
-  auto subs = this->dataPtr->node.SubscribedTopics();
-  for (const auto &sub : subs)
-    this->dataPtr->node.Unsubscribe(sub);
-
-  // Subscribe to new topic
-  if (!this->dataPtr->node.Subscribe(topic, &ImageDisplay::OnImageMsg,
-      this))
+  this->dataPtr->subscription.Reset();
+
+  // Subscribe to new topic, with the type of its publishers
+  bool compressed = this->dataPtr->compressed;
+  std::vector<transport::MessagePublisher> publishers;
+  std::vector<transport::MessagePublisher> subscribers;
+  App()->Nodes()->Node().TopicInfo(topic, publishers, subscribers);
+  if (!publishers.empty())
+    compressed = publishers.front().MsgTypeName() == "gz.msgs.Bytes";
+
+  // The shared msg is used as is, without copying it
+  const std::string stream = "image " + topic;
+  App()->Subscriptions()->SetSharedMemory(topic, this->dataPtr->sharedMemory);
+  App()->Subscriptions()->SetFeedback(topic, this->dataPtr->feedback);
+  this->dataPtr->subscription = App()->Subscriptions()->Subscribe(topic,
+      [this, compressed, stream](
+      const std::shared_ptr<const google::protobuf::Message> &_msg)
+      {
+        if (compressed)
+        {
+          auto bytes = std::dynamic_pointer_cast<const msgs::Bytes>(_msg);
+          if (bytes)
+          {
+            this->OnCompressedMsg(bytes, App()->Latency()->Begin(stream,
+                headerStamp(bytes->header())));
+          }
+        }
+        else
+        {
+          auto image = std::dynamic_pointer_cast<const msgs::Image>(_msg);
+          if (image)
+          {
+            this->OnImageMsg(image, App()->Latency()->Begin(stream,
+                headerStamp(image->header())));
+          }
+        }
+      }, this->dataPtr->maxRate);
+  if (!this->dataPtr->subscription.Valid())
   {
     // LCOV_EXCL_START
     gzerr << "Unable to subscribe to topic [" << topic << "]" << std::endl;
@@ -228,23 +699,17 @@ void ImageDisplay::OnRefresh()
   // Clear
   this->dataPtr->topicList.clear();
 
-  // Get updated list
-  std::vector<std::string> allTopics;
-  this->dataPtr->node.TopicList(allTopics);
-  for (const auto &topic : allTopics)
+  // Get updated list, sorted and without duplicates
+  auto registry = App()->Topics();
+  registry->Scan();
+  std::set<std::string> topics;
+  for (const auto &type : {"gz.msgs.Image", "gz.msgs.Bytes"})
   {
-    std::vector<transport::MessagePublisher> publishers;
-    std::vector<transport::MessagePublisher> subscribers;
-    this->dataPtr->node.TopicInfo(topic, publishers, subscribers);
-    for (const auto &pub : publishers)
-    {
-      if (pub.MsgTypeName() == "gz.msgs.Image")
-      {
-        this->dataPtr->topicList.push_back(QString::fromStdString(topic));
-        break;
-      }
-    }
+    for (const auto &topic : registry->Topics(type))
+      topics.insert(topic);
   }
+  for (const auto &topic : topics)
+    this->dataPtr->topicList.push_back(QString::fromStdString(topic));
 
   // Select first one
   if (this->dataPtr->topicList.count() > 0)
@@ -258,12 +723,161 @@ QStringList ImageDisplay::TopicList() const
   return this->dataPtr->topicList;
 }
 
+/////////////////////////////////////////////////
+int ImageDisplay::DisplayedFrames() const
+{
+  return static_cast<int>(this->dataPtr->displayedFrames);
+}
+
+/////////////////////////////////////////////////
+int ImageDisplay::DroppedFrames() const
+{
+  return static_cast<int>(this->dataPtr->droppedGui);
+}
+
 /////////////////////////////////////////////////
 void ImageDisplay::SetTopicList(const QStringList &_topicList)
 {
   this->dataPtr->topicList = _topicList;
   emit this->TopicListChanged();
 }
+
+/////////////////////////////////////////////////
+QString ImageDisplay::Colormap() const
+{
+  return QString::fromStdString(this->dataPtr->colormap);
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::SetColormap(const QString &_colormap)
+{
+  const std::string colormap = _colormap.toStdString();
+  if (colormap != "none" && colormap != "gray" && colormap != "turbo" &&
+      colormap != "jet")
+  {
+    gzerr << "Unknown colormap [" << colormap << "], expected none, gray, "
+           << "turbo or jet" << std::endl;
+    return;
+  }
+  if (colormap == this->dataPtr->colormap)
+    return;
+  this->dataPtr->colormap = colormap;
+
+  // Changing colormaps only changes the shader, but switching between
+  // packed values and grayscale needs the latest image converted again
+  const bool packValues = colormap != "none";
+  if (packValues != this->dataPtr->packValues)
+  {
+    this->dataPtr->packValues = packValues;
+    auto msg = this->dataPtr->displayedMsg;
+    if (msg)
+    {
+      this->dataPtr->SetPending([msg, this]()
+      {
+        return this->dataPtr->Convert(msg);
+      }, LatencyTrace::Tag(), msg);
+    }
+  }
+  emit this->ColormapChanged();
+}
+
+/////////////////////////////////////////////////
+bool ImageDisplay::Packed() const
+{
+  return this->dataPtr->packed;
+}
+
+/////////////////////////////////////////////////
+float ImageDisplay::ValueMin() const
+{
+  return this->dataPtr->valueMin;
+}
+
+/////////////////////////////////////////////////
+float ImageDisplay::ValueMax() const
+{
+  return this->dataPtr->valueMax;
+}
+
+/////////////////////////////////////////////////
+bool ImageDisplay::DepthImage() const
+{
+  return this->dataPtr->depthImage;
+}
+
+/////////////////////////////////////////////////
+float ImageDisplay::RangeMin() const
+{
+  return this->dataPtr->rangeMin;
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::SetRangeMin(float _min)
+{
+  this->dataPtr->rangeMin = _min;
+  this->dataPtr->autoRange = false;
+  emit this->RangeChanged();
+}
+
+/////////////////////////////////////////////////
+float ImageDisplay::RangeMax() const
+{
+  return this->dataPtr->rangeMax;
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::SetRangeMax(float _max)
+{
+  this->dataPtr->rangeMax = _max;
+  this->dataPtr->autoRange = false;
+  emit this->RangeChanged();
+}
+
+/////////////////////////////////////////////////
+bool ImageDisplay::AutoRange() const
+{
+  return this->dataPtr->autoRange;
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::SetAutoRange(bool _auto)
+{
+  this->dataPtr->autoRange = _auto;
+  if (_auto && this->dataPtr->packed)
+  {
+    this->dataPtr->rangeMin = this->dataPtr->valueMin;
+    this->dataPtr->rangeMax = this->dataPtr->valueMax;
+  }
+  emit this->RangeChanged();
+}
+
+/////////////////////////////////////////////////
+QString ImageDisplay::PixelInfo(double _u, double _v) const
+{
+  const auto &msg = this->dataPtr->displayedMsg;
+  const auto &image = this->dataPtr->displayedImage;
+  const int width = msg ? static_cast<int>(msg->width()) : image.width();
+  const int height = msg ? static_cast<int>(msg->height()) : image.height();
+  if (width <= 0 || height <= 0 || _u < 0 || _u >= 1 || _v < 0 || _v >= 1)
+    return QString();
+
+  const int x = static_cast<int>(std::floor(_u * width));
+  const int y = static_cast<int>(std::floor(_v * height));
+  std::string value;
+  if (msg)
+  {
+    value = pixelValue(*msg, static_cast<unsigned int>(x),
+        static_cast<unsigned int>(y));
+  }
+  else
+  {
+    const QColor color = image.pixelColor(x, y);
+    value = std::to_string(color.red()) + " " +
+        std::to_string(color.green()) + " " + std::to_string(color.blue());
+  }
+  return QString("%1, %2: %3").arg(x).arg(y).arg(
+      QString::fromStdString(value));
+}
 }  // namespace gz::gui::plugins
 
 // Register this plugin
@@ -19,9 +19,11 @@
 #define GZ_GUI_PLUGINS_IMAGEDISPLAY_HH_
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <QQuickImageProvider>
 
+#include <gz/msgs/bytes.pb.h>
 #include <gz/msgs/image.pb.h>
 
 #ifndef _WIN32
@@ -34,6 +36,7 @@
 #  endif
 #endif
 
+#include "gz/gui/LatencyTrace.hh"
 #include "gz/gui/Plugin.hh"
 
 #include <gz/utils/ImplPtr.hh>
@@ -47,9 +50,13 @@ namespace gz::gui::plugins
     {
     }
 
-    public: QImage requestImage(const QString &, QSize *,
+    public: QImage requestImage(const QString &_id, QSize *,
         const QSize &) override
     {
+      auto named = this->namedImages.find(_id);
+      if (named != this->namedImages.end())
+        return QImage(named->second);
+
       if (!this->img.isNull())
       {
         // Must return a copy
@@ -68,7 +75,20 @@ namespace gz::gui::plugins
       this->img = _image;
     }
 
+    /// \brief Serve an image which doesn't change under a fixed id, such as
+    /// a colormap
+    /// \param[in] _id Image id, the part of the source after the provider
+    /// name
+    /// \param[in] _image Image
+    public: void SetNamedImage(const QString &_id, const QImage &_image)
+    {
+      this->namedImages[_id] = _image;
+    }
+
     private: QImage img;
+
+    /// \brief Images served under fixed ids
+    private: std::map<QString, QImage> namedImages;
   };
 
   /// \brief Display images coming through a Gazebo Transport topic.
@@ -78,6 +98,57 @@ namespace gz::gui::plugins
   /// \<topic\> : Set the topic to receive image messages.
   /// \<topic_picker\> : Whether to show the topic picker, true by default. If
   ///                    this is false, a \<topic\> must be specified.
+  /// \<max_fps\> : Maximum number of images displayed per second, 0 by
+  ///               default for no limit. Only the latest image is displayed,
+  ///               images arriving faster are dropped.
+  /// \<max_rate\> : Most messages per second to receive, 0 by default for
+  ///                all of them. Unlike \<max_fps\>, messages above this
+  ///                rate are dropped by the transport subscription, before
+  ///                they're delivered and deserialized.
+  /// \<min_value\> : Value shown as black in single channel images, or
+  ///                 white in depth images. Found in each image by default,
+  ///                 except for depth images where it's 0.
+  /// \<max_value\> : Value shown as white in single channel images, or
+  ///                 black in depth images. Found in each image by default.
+  ///                 Images are converted faster when both values are set.
+  /// \<compressed\> : Whether the topic carries compressed images, false by
+  ///                  default. Only needed for topics without publishers
+  ///                  yet, otherwise their msg type tells.
+  /// \<decode_threads\> : Number of threads converting and decoding
+  ///                      images, 1 by default. More threads decode
+  ///                      consecutive images in parallel.
+  /// \<shared_memory\> : Whether to receive images through shared memory
+  ///                     when they're published by a SharedMemoryPublisher
+  ///                     on the same host, true by default. Falls back to
+  ///                     transport otherwise.
+  /// \<feedback\> : Whether to publish how fast images are displayed on
+  ///                FeedbackTopic() of the image topic, so cooperating
+  ///                publishers can lower their rate or resolution. False
+  ///                by default. See SubscriptionHub::SetFeedback.
+  /// \<colormap\> : How single channel images, such as depth images, are
+  ///                colored: "gray", "turbo" or "jet" to color them on the
+  ///                GPU, see below, or "none" to scale them to grayscale on
+  ///                the CPU. Defaults to "none". Can be changed from the
+  ///                GUI.
+  ///
+  /// ## Viewing
+  ///
+  /// Images can be zoomed with the mouse wheel, panned by dragging and
+  /// reset with a double click, and the value of the pixel under the mouse
+  /// is shown. These only transform the image on the GPU.
+  ///
+  /// With a colormap, single channel images are packed into 16 bits per
+  /// pixel over their whole range, and a shader colors them through a
+  /// lookup table, so the displayed range can be changed without
+  /// converting the image again. The range follows each image unless it's
+  /// set, or both \<min_value\> and \<max_value\> are given. If the shader
+  /// can't be compiled, such as on a scene graph backend other than
+  /// OpenGL, the colormap falls back to "none".  ///
+  /// ## Compressed images
+  ///
+  /// Besides raw gz.msgs.Image, topics of gz.msgs.Bytes are displayed,
+  /// where each msg holds one image encoded in a format Qt can read, such as
+  /// JPEG or PNG.
   class ImageDisplay_EXPORTS_API ImageDisplay : public Plugin
   {
     Q_OBJECT
@@ -90,6 +161,83 @@ namespace gz::gui::plugins
       NOTIFY TopicListChanged
     )
 
+    /// \brief Number of images displayed
+    Q_PROPERTY(
+      int displayedFrames
+      READ DisplayedFrames
+      NOTIFY FramesChanged
+    )
+
+    /// \brief Number of images dropped because a newer one arrived before
+    /// they were displayed
+    Q_PROPERTY(
+      int droppedFrames
+      READ DroppedFrames
+      NOTIFY FramesChanged
+    )
+
+    /// \brief Colormap of single channel images, "none" to scale them to
+    /// grayscale on the CPU
+    Q_PROPERTY(
+      QString colormap
+      READ Colormap
+      WRITE SetColormap
+      NOTIFY ColormapChanged
+    )
+
+    /// \brief True if the latest image holds values packed by PackImage,
+    /// which are colored on the GPU
+    Q_PROPERTY(
+      bool packed
+      READ Packed
+      NOTIFY ValueRangeChanged
+    )
+
+    /// \brief Value packed as 0 in the latest image
+    Q_PROPERTY(
+      float valueMin
+      READ ValueMin
+      NOTIFY ValueRangeChanged
+    )
+
+    /// \brief Value packed as 65535 in the latest image
+    Q_PROPERTY(
+      float valueMax
+      READ ValueMax
+      NOTIFY ValueRangeChanged
+    )
+
+    /// \brief True if the latest packed image is a depth image
+    Q_PROPERTY(
+      bool depthImage
+      READ DepthImage
+      NOTIFY ValueRangeChanged
+    )
+
+    /// \brief Value shown with the lowest color of the colormap
+    Q_PROPERTY(
+      float rangeMin
+      READ RangeMin
+      WRITE SetRangeMin
+      NOTIFY RangeChanged
+    )
+
+    /// \brief Value shown with the highest color of the colormap
+    Q_PROPERTY(
+      float rangeMax
+      READ RangeMax
+      WRITE SetRangeMax
+      NOTIFY RangeChanged
+    )
+
+    /// \brief True if the range follows the values of each image
+    Q_PROPERTY(
+      bool autoRange
+      READ AutoRange
+      WRITE SetAutoRange
+      NOTIFY RangeChanged
+    )
+
     /// \brief Constructor
     public: ImageDisplay();
 
@@ -118,14 +266,108 @@ namespace gz::gui::plugins
     /// \brief Notify that topic list has changed
     signals: void TopicListChanged();
 
+    /// \brief Get the number of images displayed
+    /// \return Images displayed so far
+    public: Q_INVOKABLE int DisplayedFrames() const;
+
+    /// \brief Get the number of images dropped
+    /// \return Images dropped so far
+    public: Q_INVOKABLE int DroppedFrames() const;
+
+    /// \brief Notify that the frame counters have changed
+    signals: void FramesChanged();
+
+    /// \brief Get the colormap
+    /// \return "none", "gray", "turbo" or "jet"
+    public: Q_INVOKABLE QString Colormap() const;
+
+    /// \brief Set the colormap. The latest image is converted again if it
+    /// changes between "none" and a colormap.
+    /// \param[in] _colormap "none", "gray", "turbo" or "jet"
+    public: Q_INVOKABLE void SetColormap(const QString &_colormap);
+
+    /// \brief Notify that the colormap has changed
+    signals: void ColormapChanged();
+
+    /// \brief Get whether the latest image holds packed values
+    /// \return True if it does
+    public: Q_INVOKABLE bool Packed() const;
+
+    /// \brief Get the value packed as 0 in the latest image
+    /// \return Value
+    public: Q_INVOKABLE float ValueMin() const;
+
+    /// \brief Get the value packed as 65535 in the latest image
+    /// \return Value
+    public: Q_INVOKABLE float ValueMax() const;
+
+    /// \brief Get whether the latest packed image is a depth image
+    /// \return True if it is
+    public: Q_INVOKABLE bool DepthImage() const;
+
+    /// \brief Notify that the packed values of the latest image have
+    /// changed
+    signals: void ValueRangeChanged();
+
+    /// \brief Get the value shown with the lowest color
+    /// \return Value
+    public: Q_INVOKABLE float RangeMin() const;
+
+    /// \brief Set the value shown with the lowest color, which stops the
+    /// range from following the images
+    /// \param[in] _min Value
+    public: Q_INVOKABLE void SetRangeMin(float _min);
+
+    /// \brief Get the value shown with the highest color
+    /// \return Value
+    public: Q_INVOKABLE float RangeMax() const;
+
+    /// \brief Set the value shown with the highest color, which stops the
+    /// range from following the images
+    /// \param[in] _max Value
+    public: Q_INVOKABLE void SetRangeMax(float _max);
+
+    /// \brief Get whether the range follows the values of each image
+    /// \return True if it does
+    public: Q_INVOKABLE bool AutoRange() const;
+
+    /// \brief Set whether the range follows the values of each image
+    /// \param[in] _auto True to follow them, starting with the latest
+    /// image
+    public: Q_INVOKABLE void SetAutoRange(bool _auto);
+
+    /// \brief Notify that the displayed range has changed
+    signals: void RangeChanged();
+
+    /// \brief Describe a pixel of the latest image, with its exact value
+    /// read from the msg
+    /// \param[in] _u Horizontal position, from 0 at the left edge to 1 at
+    /// the right edge
+    /// \param[in] _v Vertical position, from 0 at the top edge to 1 at the
+    /// bottom edge
+    /// \return Pixel coordinates and value, such as "12, 34: 1.5", empty
+    /// outside of the image
+    public: Q_INVOKABLE QString PixelInfo(double _u, double _v) const;
+
     /// \brief Notify that a new image has been received.
     signals: void newImage();
 
     private slots: void ProcessImage();
 
     /// \brief Subscriber callback when new image is received
-    /// \param[in] _msg New image
-    private: void OnImageMsg(const gz::msgs::Image &_msg);
+    /// \param[in] _msg New image, shared with other subscribers
+    /// \param[in] _tag Latency trace tag of the msg
+    private: void OnImageMsg(
+        const std::shared_ptr<const gz::msgs::Image> &_msg,
+        const LatencyTrace::Tag &_tag);
+
+    /// \brief Subscriber callback when a new compressed image is received
+    /// \param[in] _msg Encoded image, such as JPEG or PNG, shared with
+    /// other subscribers
+    /// \param[in] _tag Latency trace tag of the msg
+    private: void OnCompressedMsg(
+        const std::shared_ptr<const gz::msgs::Bytes> &_msg,
+        const LatencyTrace::Tag &_tag);
 
     /// \internal
     /// \brief Pointer to private data.
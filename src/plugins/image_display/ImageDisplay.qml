@@ -88,16 +88,241 @@ Rectangle {
         ToolTip.text: qsTr("Gazebo Transport topics publishing Image messages")
       }
     }
-    Image {
-      id: image
-      fillMode: Image.PreserveAspectFit
+    RowLayout {
+      Label {
+        text: "Colormap"
+      }
+      ComboBox {
+        id: colormapCombo
+        objectName: "colormapCombo"
+        Layout.fillWidth: true
+        model: ["none", "gray", "turbo", "jet"]
+        currentIndex: model.indexOf(ImageDisplay.colormap)
+        onActivated: {
+          ImageDisplay.SetColormap(textAt(index));
+        }
+        ToolTip.visible: hovered
+        ToolTip.delay: tooltipDelay
+        ToolTip.timeout: tooltipTimeout
+        ToolTip.text: qsTr("Color single channel images on the GPU, or \"none\" for grayscale")
+      }
+    }
+    RowLayout {
+      visible: ImageDisplay.packed
+      CheckBox {
+        text: "Auto"
+        checked: ImageDisplay.autoRange
+        onToggled: {
+          ImageDisplay.SetAutoRange(checked);
+        }
+        ToolTip.visible: hovered
+        ToolTip.delay: tooltipDelay
+        ToolTip.timeout: tooltipTimeout
+        ToolTip.text: qsTr("Follow the range of each image")
+      }
+      TextField {
+        objectName: "rangeMin"
+        Layout.fillWidth: true
+        text: ImageDisplay.rangeMin.toPrecision(5)
+        validator: DoubleValidator {}
+        onEditingFinished: {
+          ImageDisplay.SetRangeMin(parseFloat(text));
+        }
+      }
+      TextField {
+        objectName: "rangeMax"
+        Layout.fillWidth: true
+        text: ImageDisplay.rangeMax.toPrecision(5)
+        validator: DoubleValidator {}
+        onEditingFinished: {
+          ImageDisplay.SetRangeMax(parseFloat(text));
+        }
+      }
+    }
+    Item {
+      id: view
       Layout.fillHeight: true
       Layout.fillWidth: true
-      verticalAlignment: Image.AlignTop
-      function reload() {
-        // Force image request to C++
-        source = "image://" + uniqueName + "/" + Math.random().toString(36).substr(2, 5);
+      clip: true
+
+      /**
+       * Scale of the image, 1 to fit the view
+       */
+      property real zoom: 1.0
+
+      /**
+       * Offset of the zoomed image, in pixels of the view
+       */
+      property real panX: 0.0
+      property real panY: 0.0
+
+      /**
+       * True when the image holds values colored by the shader
+       */
+      property bool packed: ImageDisplay.packed
+
+      function reset() {
+        zoom = 1.0;
+        panX = 0.0;
+        panY = 0.0;
       }
+
+      // Zooming and panning only transform the image on the GPU
+      Item {
+        id: content
+        width: view.width
+        height: view.height
+        transform: [
+          Scale {
+            xScale: view.zoom
+            yScale: view.zoom
+          },
+          Translate {
+            x: view.panX
+            y: view.panY
+          }
+        ]
+
+        Image {
+          id: image
+          anchors.fill: parent
+          fillMode: Image.PreserveAspectFit
+          verticalAlignment: Image.AlignTop
+          // Packed values must not be interpolated, and pixels are shown
+          // sharp once zoomed in
+          smooth: !view.packed && view.zoom < 4
+          visible: !view.packed
+          function reload() {
+            // Force image request to C++
+            source = "image://" + uniqueName + "/" + Math.random().toString(36).substr(2, 5);
+          }
+        }
+
+        Image {
+          id: lut
+          visible: false
+          // Gray until an image converted without colormap replaces a
+          // packed one
+          source: "image://" + uniqueName + "/lut/" +
+              (ImageDisplay.colormap === "none" ? "gray" : ImageDisplay.colormap)
+        }
+
+        // Maps the packed values through the colormap, so changing the
+        // range only changes uniforms
+        ShaderEffect {
+          id: colormapShader
+          x: (image.width - image.paintedWidth) / 2
+          y: 0
+          width: image.paintedWidth
+          height: image.paintedHeight
+          visible: view.packed
+
+          property variant source: image
+          property variant lut: lut
+          property real span: ImageDisplay.valueMax - ImageDisplay.valueMin
+          property real low: span > 0 ?
+              (ImageDisplay.rangeMin - ImageDisplay.valueMin) / span : 0.0
+          property real high: span > 0 ?
+              (ImageDisplay.rangeMax - ImageDisplay.valueMin) / span : 1.0
+          // Closer is brighter on gray depth images, as without a colormap
+          property real invert:
+              ImageDisplay.depthImage && ImageDisplay.colormap === "gray" ?
+              1.0 : 0.0
+
+          fragmentShader: "
+            varying highp vec2 qt_TexCoord0;
+            uniform sampler2D source;
+            uniform sampler2D lut;
+            uniform lowp float qt_Opacity;
+            uniform highp float low;
+            uniform highp float high;
+            uniform lowp float invert;
+            void main() {
+              highp vec4 p = texture2D(source, qt_TexCoord0);
+              if (p.b < 0.5) {
+                gl_FragColor = vec4(0.0, 0.0, 0.0, qt_Opacity);
+                return;
+              }
+              highp float v = (p.r * 65280.0 + p.g * 255.0) / 65535.0;
+              highp float t = clamp((v - low) / max(high - low, 1e-6),
+                  0.0, 1.0);
+              t = mix(t, 1.0 - t, invert);
+              gl_FragColor = texture2D(lut,
+                  vec2(t * 255.0 / 256.0 + 0.5 / 256.0, 0.5)) * qt_Opacity;
+            }"
+
+          onStatusChanged: {
+            if (status === ShaderEffect.Error) {
+              console.warn("ImageDisplay: colormap shader failed, " +
+                  "falling back to grayscale: " + log);
+              ImageDisplay.SetColormap("none");
+            }
+          }
+        }
+      }
+
+      MouseArea {
+        anchors.fill: parent
+        hoverEnabled: true
+        property real lastX: 0
+        property real lastY: 0
+
+        onPressed: {
+          lastX = mouse.x;
+          lastY = mouse.y;
+        }
+        onPositionChanged: {
+          if (pressed) {
+            view.panX += mouse.x - lastX;
+            view.panY += mouse.y - lastY;
+            lastX = mouse.x;
+            lastY = mouse.y;
+          }
+
+          // Position within the painted image, before zooming
+          const cx = (mouse.x - view.panX) / view.zoom;
+          const cy = (mouse.y - view.panY) / view.zoom;
+          const left = (image.width - image.paintedWidth) / 2;
+          if (image.paintedWidth <= 0 || image.paintedHeight <= 0) {
+            pixelLabel.text = "";
+            return;
+          }
+          pixelLabel.text = ImageDisplay.PixelInfo(
+              (cx - left) / image.paintedWidth, cy / image.paintedHeight);
+        }
+        onExited: {
+          pixelLabel.text = "";
+        }
+        onWheel: {
+          // Zoom around the cursor
+          const factor = wheel.angleDelta.y > 0 ? 1.25 : 0.8;
+          const zoom = Math.min(Math.max(view.zoom * factor, 1.0), 64.0);
+          if (zoom === 1.0) {
+            view.reset();
+            return;
+          }
+          const cx = (wheel.x - view.panX) / view.zoom;
+          const cy = (wheel.y - view.panY) / view.zoom;
+          view.panX = wheel.x - cx * zoom;
+          view.panY = wheel.y - cy * zoom;
+          view.zoom = zoom;
+        }
+        onDoubleClicked: {
+          view.reset();
+        }
+      }
+    }
+    Label {
+      id: pixelLabel
+      objectName: "pixelLabel"
+      Layout.fillWidth: true
+      text: ""
+    }
+    Label {
+      objectName: "framesLabel"
+      Layout.fillWidth: true
+      text: "Displayed: " + ImageDisplay.displayedFrames +
+            "  Dropped: " + ImageDisplay.droppedFrames
     }
   }
 }
@@ -17,6 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <vector>
+
+#include <QBuffer>
+
+#include <gz/msgs/bytes.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 
 #include <gz/common/Console.hh>
@@ -539,6 +545,259 @@ TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ReceiveImageInt16))
   plugins.clear();
 }
 
+/////////////////////////////////////////////////
+TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(LatestImageWins))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"ImageDisplay\">"
+      "<topic>/image_latest_test</topic>"
+      "<topic_picker>false</topic_picker>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::ImageDisplay *>();
+  EXPECT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->DisplayedFrames(), 0);
+  EXPECT_EQ(plugin->DroppedFrames(), 0);
+
+  auto providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplay");
+  ASSERT_NE(providerBase, nullptr);
+  auto imageProvider = static_cast<plugins::ImageProvider *>(providerBase);
+  ASSERT_NE(imageProvider, nullptr);
+
+  // Publish a burst of images without processing events
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>("/image_latest_test");
+
+  const int count{5};
+  for (int i = 1; i <= count; ++i)
+  {
+    msgs::Image msg;
+    msg.set_height(10);
+    msg.set_width(20);
+    msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+    msg.set_step(msg.width() * 3);
+
+    // Each image is a different shade of red
+    std::string data(msg.step() * msg.height(), '\0');
+    for (std::size_t p = 0; p < data.size(); p += 3)
+      data[p] = static_cast<char>(i * 50);
+    msg.set_data(data);
+    pub.Publish(msg);
+  }
+
+  // Give it time to be received, the ones arriving before the GUI processes
+  // events replace each other
+  int sleep = 0;
+  int maxSleep = 30;
+  while (plugin->DisplayedFrames() + plugin->DroppedFrames() < count &&
+      sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+
+  // Only the images which weren't replaced were displayed, and the latest
+  // one is shown
+  EXPECT_GE(plugin->DisplayedFrames(), 1);
+  EXPECT_EQ(plugin->DisplayedFrames() + plugin->DroppedFrames(), count);
+
+  QSize dummySize;
+  QImage img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+  EXPECT_EQ(img.width(), 20);
+  EXPECT_EQ(img.height(), 10);
+  EXPECT_EQ(img.pixelColor(0, 0).red(), count * 50);
+
+  // Cleanup
+  plugins.clear();
+}
+
+/////////////////////////////////////////////////
+TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(FixedRange))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"ImageDisplay\">"
+      "<topic>/image_range_test</topic>"
+      "<topic_picker>false</topic_picker>"
+      "<min_value>0</min_value>"
+      "<max_value>1000</max_value>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::ImageDisplay *>();
+  EXPECT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  auto providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplay");
+  ASSERT_NE(providerBase, nullptr);
+  auto imageProvider = static_cast<plugins::ImageProvider *>(providerBase);
+  ASSERT_NE(imageProvider, nullptr);
+
+  // Top half is in range, bottom half is above it
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>("/image_range_test");
+  {
+    msgs::Image msg;
+    msg.set_height(10);
+    msg.set_width(20);
+    msg.set_pixel_format_type(msgs::PixelFormatType::L_INT16);
+    msg.set_step(msg.width() * sizeof(uint16_t));
+
+    std::vector<uint16_t> data(msg.width() * msg.height());
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = i < data.size() / 2 ? 500 : 1500;
+    msg.set_data(data.data(), data.size() * sizeof(uint16_t));
+    pub.Publish(msg);
+  }
+
+  // Give it time to be processed
+  int sleep = 0;
+  int maxSleep = 30;
+  while (plugin->DisplayedFrames() == 0 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+
+  QSize dummySize;
+  QImage img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+  EXPECT_EQ(img.width(), 20);
+  EXPECT_EQ(img.height(), 10);
+  for (int y = 0; y < img.height(); ++y)
+  {
+    for (int x = 0; x < img.width(); ++x)
+      EXPECT_EQ(img.pixelColor(x, y).red(), y < 5 ? 127 : 255);
+  }
+
+  // Cleanup
+  plugins.clear();
+}
+
+/////////////////////////////////////////////////
+TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(CompressedImage))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin, the topic has no publishers yet
+  const char *pluginStr =
+    "<plugin filename=\"ImageDisplay\">"
+      "<topic>/image_compressed_test</topic>"
+      "<topic_picker>false</topic_picker>"
+      "<compressed>true</compressed>"
+      "<decode_threads>2</decode_threads>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::ImageDisplay *>();
+  EXPECT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  auto providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplay");
+  ASSERT_NE(providerBase, nullptr);
+  auto imageProvider = static_cast<plugins::ImageProvider *>(providerBase);
+  ASSERT_NE(imageProvider, nullptr);
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Bytes>("/image_compressed_test");
+
+  // Garbage isn't displayed
+  {
+    msgs::Bytes msg;
+    msg.set_data("not an image");
+    pub.Publish(msg);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  QCoreApplication::processEvents();
+  EXPECT_EQ(plugin->DisplayedFrames(), 0);
+
+  // Blue PNG
+  {
+    QImage source(20, 10, QImage::Format_RGB888);
+    source.fill(QColor(0, 0, 255));
+    QByteArray encoded;
+    QBuffer buffer(&encoded);
+    buffer.open(QIODevice::WriteOnly);
+    ASSERT_TRUE(source.save(&buffer, "PNG"));
+
+    msgs::Bytes msg;
+    msg.set_data(encoded.constData(), encoded.size());
+    pub.Publish(msg);
+  }
+
+  // Give it time to be processed
+  int sleep = 0;
+  int maxSleep = 30;
+  while (plugin->DisplayedFrames() == 0 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+
+  QSize dummySize;
+  QImage img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+  EXPECT_EQ(img.width(), 20);
+  EXPECT_EQ(img.height(), 10);
+  EXPECT_EQ(img.pixelColor(0, 0).red(), 0);
+  EXPECT_EQ(img.pixelColor(0, 0).green(), 0);
+  EXPECT_EQ(img.pixelColor(0, 0).blue(), 255);
+
+  // Cleanup
+  plugins.clear();
+}
+
 /////////////////////////////////////////////////
 TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TopicPicker))
 {
@@ -612,3 +871,119 @@ TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TopicPicker))
   // Cleanup
   plugins.clear();
 }
+
+/////////////////////////////////////////////////
+TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Colormap))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"ImageDisplay\">"
+      "<topic>/image_colormap_test</topic>"
+      "<colormap>turbo</colormap>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::ImageDisplay *>();
+  EXPECT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_EQ("turbo", plugin->Colormap().toStdString());
+  EXPECT_TRUE(plugin->AutoRange());
+
+  auto providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplay");
+  ASSERT_NE(providerBase, nullptr);
+  auto imageProvider = static_cast<plugins::ImageProvider *>(providerBase);
+
+  // Colormaps are served as lookup tables
+  QSize dummySize;
+  QImage lut = imageProvider->requestImage("lut/turbo", &dummySize,
+      dummySize);
+  EXPECT_EQ(256, lut.width());
+  EXPECT_EQ(1, lut.height());
+
+  // Depths from 0 to 3 m, with a NaN in the corner
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>("/image_colormap_test");
+  {
+    msgs::Image msg;
+    msg.set_height(4);
+    msg.set_width(8);
+    msg.set_pixel_format_type(msgs::PixelFormatType::R_FLOAT32);
+    msg.set_step(msg.width() * sizeof(float));
+
+    std::vector<float> data(msg.width() * msg.height());
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<float>(i / msg.width());
+    data[0] = std::numeric_limits<float>::quiet_NaN();
+    msg.set_data(data.data(), data.size() * sizeof(float));
+    pub.Publish(msg);
+  }
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (plugin->DisplayedFrames() == 0 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+
+  // Values are packed into red and green, over the image's range
+  EXPECT_TRUE(plugin->Packed());
+  EXPECT_TRUE(plugin->DepthImage());
+  EXPECT_FLOAT_EQ(0.0f, plugin->ValueMin());
+  EXPECT_FLOAT_EQ(3.0f, plugin->ValueMax());
+  EXPECT_FLOAT_EQ(0.0f, plugin->RangeMin());
+  EXPECT_FLOAT_EQ(3.0f, plugin->RangeMax());
+
+  QImage img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+  ASSERT_EQ(8, img.width());
+  ASSERT_EQ(4, img.height());
+  EXPECT_EQ(0, qBlue(img.pixel(0, 0)));
+  EXPECT_EQ(255, qBlue(img.pixel(1, 0)));
+  EXPECT_EQ(0, qRed(img.pixel(1, 0)));
+  EXPECT_EQ(0, qGreen(img.pixel(1, 0)));
+  EXPECT_EQ(255, qRed(img.pixel(0, 3)));
+  EXPECT_EQ(255, qGreen(img.pixel(0, 3)));
+
+  // Exact values are read from the msg
+  EXPECT_EQ("3, 2: 2", plugin->PixelInfo(0.4, 0.6).toStdString());
+  EXPECT_TRUE(plugin->PixelInfo(1.0, 0.5).isEmpty());
+
+  // Changing the range doesn't convert the image again
+  plugin->SetRangeMax(2.0f);
+  EXPECT_FALSE(plugin->AutoRange());
+  EXPECT_FLOAT_EQ(2.0f, plugin->RangeMax());
+  EXPECT_EQ(1, plugin->DisplayedFrames());
+
+  // Without colormap, the latest image is converted to grayscale again
+  plugin->SetColormap("none");
+  sleep = 0;
+  while (plugin->DisplayedFrames() < 2 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  EXPECT_FALSE(plugin->Packed());
+  img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+  EXPECT_EQ(QImage::Format_Grayscale8, img.format());
+
+  // Cleanup
+  plugins.clear();
+}
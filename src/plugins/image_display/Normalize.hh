@@ -0,0 +1,471 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_GUI_PLUGINS_IMAGEDISPLAY_NORMALIZE_HH_
+#define GZ_GUI_PLUGINS_IMAGEDISPLAY_NORMALIZE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define GZ_GUI_NORMALIZE_AVX2
+  #include <immintrin.h>
+#elif defined(__aarch64__)
+  #define GZ_GUI_NORMALIZE_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Scales single channel values to 8 bit grayscale, and finds the
+  /// range of values to scale.
+  ///
+  /// Values are mapped linearly, the minimum to 0 and the maximum to 255,
+  /// or the other way around if flipped. Values outside of the range,
+  /// including NaNs, are clamped.
+  ///
+  /// Float and 16 bit values use an AVX2 kernel picked at runtime on x86
+  /// CPUs that support it, and a NEON one on 64-bit ARM. Otherwise, and for
+  /// other types, values are scaled one by one.
+  class Normalizer
+  {
+    /// \brief Constructor
+    /// \param[in] _min Value mapped to black, or white if flipped
+    /// \param[in] _max Value mapped to white, or black if flipped
+    /// \param[in] _flip True to show lower values brighter
+    public: Normalizer(float _min, float _max, bool _flip)
+      : min(_min), range(_max - _min), flip(_flip)
+    {
+      if (std::abs(this->range) <= 1e-6f)
+        this->range = 1.0f;
+    }
+
+    /// \brief Grow a range to include values. NaNs and positive infinity
+    /// are ignored.
+    /// \param[in] _values Values to include
+    /// \param[in] _count Number of values
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    public: template<typename T>
+    static void Range(const T *_values, std::size_t _count, T &_min,
+        T &_max)
+    {
+      RangeScalar(_values, 0, _count, _min, _max);
+    }
+
+    /// \brief Range of float values, see Range
+    /// \param[in] _values Values to include
+    /// \param[in] _count Number of values
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    public: static void Range(const float *_values, std::size_t _count,
+        float &_min, float &_max)
+    {
+#if defined(GZ_GUI_NORMALIZE_AVX2)
+      if (Avx2())
+        return RangeAvx2(_values, _count, _min, _max);
+#elif defined(GZ_GUI_NORMALIZE_NEON)
+      return RangeNeon(_values, _count, _min, _max);
+#endif
+      RangeScalar(_values, 0, _count, _min, _max);
+    }
+
+    /// \brief Range of 16 bit values, see Range
+    /// \param[in] _values Values to include
+    /// \param[in] _count Number of values
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    public: static void Range(const uint16_t *_values, std::size_t _count,
+        uint16_t &_min, uint16_t &_max)
+    {
+#if defined(GZ_GUI_NORMALIZE_AVX2)
+      if (Avx2())
+        return RangeAvx2(_values, _count, _min, _max);
+#elif defined(GZ_GUI_NORMALIZE_NEON)
+      return RangeNeon(_values, _count, _min, _max);
+#endif
+      RangeScalar(_values, 0, _count, _min, _max);
+    }
+
+    /// \brief Grow a range one value at a time, see Range
+    /// \param[in] _values Values to include
+    /// \param[in] _begin Index of the first value
+    /// \param[in] _end Index past the last value
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    public: template<typename T>
+    static void RangeScalar(const T *_values, std::size_t _begin,
+        std::size_t _end, T &_min, T &_max)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        const T v = _values[i];
+        if (std::numeric_limits<T>::has_infinity &&
+            std::numeric_limits<T>::infinity() == v)
+        {
+          continue;
+        }
+        if (v > _max)
+          _max = v;
+        if (v < _min)
+          _min = v;
+      }
+    }
+
+    /// \brief Scale values to 8 bit
+    /// \param[in] _values Values to scale
+    /// \param[in] _count Number of values
+    /// \param[out] _out Scaled values, must have room for `_count` values
+    public: template<typename T>
+    void Apply(const T *_values, std::size_t _count, uint8_t *_out) const
+    {
+      this->ApplyScalar(_values, 0, _count, _out);
+    }
+
+    /// \brief Scale float values, see Apply
+    /// \param[in] _values Values to scale
+    /// \param[in] _count Number of values
+    /// \param[out] _out Scaled values
+    public: void Apply(const float *_values, std::size_t _count,
+        uint8_t *_out) const
+    {
+#if defined(GZ_GUI_NORMALIZE_AVX2)
+      if (Avx2())
+        return this->ApplyAvx2(_values, _count, _out);
+#elif defined(GZ_GUI_NORMALIZE_NEON)
+      return this->ApplyNeon(_values, _count, _out);
+#endif
+      this->ApplyScalar(_values, 0, _count, _out);
+    }
+
+    /// \brief Scale 16 bit values, see Apply
+    /// \param[in] _values Values to scale
+    /// \param[in] _count Number of values
+    /// \param[out] _out Scaled values
+    public: void Apply(const uint16_t *_values, std::size_t _count,
+        uint8_t *_out) const
+    {
+#if defined(GZ_GUI_NORMALIZE_AVX2)
+      if (Avx2())
+        return this->ApplyAvx2(_values, _count, _out);
+#elif defined(GZ_GUI_NORMALIZE_NEON)
+      return this->ApplyNeon(_values, _count, _out);
+#endif
+      this->ApplyScalar(_values, 0, _count, _out);
+    }
+
+    /// \brief Scale values one by one, see Apply
+    /// \param[in] _values Values to scale
+    /// \param[in] _begin Index of the first value
+    /// \param[in] _end Index past the last value
+    /// \param[out] _out Scaled values, indexed like `_values`
+    public: template<typename T>
+    void ApplyScalar(const T *_values, std::size_t _begin,
+        std::size_t _end, uint8_t *_out) const
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        float t = (static_cast<float>(_values[i]) - this->min) / this->range;
+        if (this->flip)
+          t = 1.0f - t;
+
+        // Written so NaNs are clamped to 0
+        if (!(t > 0.0f))
+          t = 0.0f;
+        else if (t > 1.0f)
+          t = 1.0f;
+        _out[i] = static_cast<uint8_t>(t * 255.0f);
+      }
+    }
+
+#if defined(GZ_GUI_NORMALIZE_AVX2)
+    /// \brief Whether the CPU supports AVX2
+    /// \return True if the AVX2 kernels can be used
+    private: static bool Avx2()
+    {
+      static const bool avx2 = __builtin_cpu_supports("avx2");
+      return avx2;
+    }
+
+    /// \brief Range of float values, 8 at a time, see Range
+    /// \param[in] _values Values to include
+    /// \param[in] _count Number of values
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    private: __attribute__((target("avx2")))
+    static void RangeAvx2(const float *_values, std::size_t _count,
+        float &_min, float &_max)
+    {
+      const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+      const __m256 highest = _mm256_set1_ps(std::numeric_limits<float>::max());
+      const __m256 lowest =
+          _mm256_set1_ps(std::numeric_limits<float>::lowest());
+      __m256 minV = _mm256_set1_ps(_min);
+      __m256 maxV = _mm256_set1_ps(_max);
+
+      std::size_t i{0};
+      for (; i + 8 <= _count; i += 8)
+      {
+        const __m256 v = _mm256_loadu_ps(_values + i);
+
+        // False for NaNs too
+        const __m256 valid = _mm256_cmp_ps(v, inf, _CMP_NEQ_OQ);
+        minV = _mm256_min_ps(minV, _mm256_blendv_ps(highest, v, valid));
+        maxV = _mm256_max_ps(maxV, _mm256_blendv_ps(lowest, v, valid));
+      }
+
+      alignas(32) float mins[8];
+      alignas(32) float maxs[8];
+      _mm256_store_ps(mins, minV);
+      _mm256_store_ps(maxs, maxV);
+      for (int lane = 0; lane < 8; ++lane)
+      {
+        _min = std::min(_min, mins[lane]);
+        _max = std::max(_max, maxs[lane]);
+      }
+      RangeScalar(_values, i, _count, _min, _max);
+    }
+
+    /// \brief Range of 16 bit values, 16 at a time, see Range
+    /// \param[in] _values Values to include
+    /// \param[in] _count Number of values
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    private: __attribute__((target("avx2")))
+    static void RangeAvx2(const uint16_t *_values, std::size_t _count,
+        uint16_t &_min, uint16_t &_max)
+    {
+      __m256i minV = _mm256_set1_epi16(static_cast<int16_t>(_min));
+      __m256i maxV = _mm256_set1_epi16(static_cast<int16_t>(_max));
+
+      std::size_t i{0};
+      for (; i + 16 <= _count; i += 16)
+      {
+        const __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(_values + i));
+        minV = _mm256_min_epu16(minV, v);
+        maxV = _mm256_max_epu16(maxV, v);
+      }
+
+      alignas(32) uint16_t mins[16];
+      alignas(32) uint16_t maxs[16];
+      _mm256_store_si256(reinterpret_cast<__m256i *>(mins), minV);
+      _mm256_store_si256(reinterpret_cast<__m256i *>(maxs), maxV);
+      for (int lane = 0; lane < 16; ++lane)
+      {
+        _min = std::min(_min, mins[lane]);
+        _max = std::max(_max, maxs[lane]);
+      }
+      RangeScalar(_values, i, _count, _min, _max);
+    }
+
+    /// \brief Scale 8 values and store them, see Apply
+    /// \param[in] _v Values to scale
+    /// \param[out] _out Where to store the scaled values
+    private: __attribute__((target("avx2")))
+    void ScaleAvx2(__m256 _v, uint8_t *_out) const
+    {
+      const __m256 zero = _mm256_setzero_ps();
+      const __m256 one = _mm256_set1_ps(1.0f);
+
+      __m256 t = _mm256_div_ps(
+          _mm256_sub_ps(_v, _mm256_set1_ps(this->min)),
+          _mm256_set1_ps(this->range));
+      if (this->flip)
+        t = _mm256_sub_ps(one, t);
+
+      // Operand order makes NaNs clamp to 0
+      t = _mm256_min_ps(_mm256_max_ps(t, zero), one);
+      const __m256i scaled = _mm256_cvttps_epi32(
+          _mm256_mul_ps(t, _mm256_set1_ps(255.0f)));
+
+      // Narrow to bytes, each 128 bit lane holds 4 of them
+      __m256i packed = _mm256_packus_epi32(scaled, scaled);
+      packed = _mm256_packus_epi16(packed, packed);
+      packed = _mm256_permutevar8x32_epi32(packed,
+          _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(_out),
+          _mm256_castsi256_si128(packed));
+    }
+
+    /// \brief Scale float values, 8 at a time, see Apply
+    /// \param[in] _values Values to scale
+    /// \param[in] _count Number of values
+    /// \param[out] _out Scaled values
+    private: __attribute__((target("avx2")))
+    void ApplyAvx2(const float *_values, std::size_t _count,
+        uint8_t *_out) const
+    {
+      std::size_t i{0};
+      for (; i + 8 <= _count; i += 8)
+        this->ScaleAvx2(_mm256_loadu_ps(_values + i), _out + i);
+      this->ApplyScalar(_values, i, _count, _out);
+    }
+
+    /// \brief Scale 16 bit values, 8 at a time, see Apply
+    /// \param[in] _values Values to scale
+    /// \param[in] _count Number of values
+    /// \param[out] _out Scaled values
+    private: __attribute__((target("avx2")))
+    void ApplyAvx2(const uint16_t *_values, std::size_t _count,
+        uint8_t *_out) const
+    {
+      std::size_t i{0};
+      for (; i + 8 <= _count; i += 8)
+      {
+        const __m128i v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(_values + i));
+        this->ScaleAvx2(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v)),
+            _out + i);
+      }
+      this->ApplyScalar(_values, i, _count, _out);
+    }
+#elif defined(GZ_GUI_NORMALIZE_NEON)
+    /// \brief Range of float values, 4 at a time, see Range
+    /// \param[in] _values Values to include
+    /// \param[in] _count Number of values
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    private: static void RangeNeon(const float *_values, std::size_t _count,
+        float &_min, float &_max)
+    {
+      const float32x4_t inf =
+          vdupq_n_f32(std::numeric_limits<float>::infinity());
+      const float32x4_t highest =
+          vdupq_n_f32(std::numeric_limits<float>::max());
+      const float32x4_t lowest =
+          vdupq_n_f32(std::numeric_limits<float>::lowest());
+      float32x4_t minV = vdupq_n_f32(_min);
+      float32x4_t maxV = vdupq_n_f32(_max);
+
+      std::size_t i{0};
+      for (; i + 4 <= _count; i += 4)
+      {
+        const float32x4_t v = vld1q_f32(_values + i);
+        const uint32x4_t valid =
+            vandq_u32(vceqq_f32(v, v), vmvnq_u32(vceqq_f32(v, inf)));
+        minV = vminq_f32(minV, vbslq_f32(valid, v, highest));
+        maxV = vmaxq_f32(maxV, vbslq_f32(valid, v, lowest));
+      }
+      _min = std::min(_min, vminvq_f32(minV));
+      _max = std::max(_max, vmaxvq_f32(maxV));
+      RangeScalar(_values, i, _count, _min, _max);
+    }
+
+    /// \brief Range of 16 bit values, 8 at a time, see Range
+    /// \param[in] _values Values to include
+    /// \param[in] _count Number of values
+    /// \param[in, out] _min Minimum value
+    /// \param[in, out] _max Maximum value
+    private: static void RangeNeon(const uint16_t *_values,
+        std::size_t _count, uint16_t &_min, uint16_t &_max)
+    {
+      uint16x8_t minV = vdupq_n_u16(_min);
+      uint16x8_t maxV = vdupq_n_u16(_max);
+
+      std::size_t i{0};
+      for (; i + 8 <= _count; i += 8)
+      {
+        const uint16x8_t v = vld1q_u16(_values + i);
+        minV = vminq_u16(minV, v);
+        maxV = vmaxq_u16(maxV, v);
+      }
+      _min = vminvq_u16(minV);
+      _max = vmaxvq_u16(maxV);
+      RangeScalar(_values, i, _count, _min, _max);
+    }
+
+    /// \brief Scale 4 values, see Apply
+    /// \param[in] _v Values to scale
+    /// \return Scaled values
+    private: uint32x4_t ScaleNeon(float32x4_t _v) const
+    {
+      const float32x4_t zero = vdupq_n_f32(0.0f);
+      const float32x4_t one = vdupq_n_f32(1.0f);
+
+      float32x4_t t = vdivq_f32(vsubq_f32(_v, vdupq_n_f32(this->min)),
+          vdupq_n_f32(this->range));
+      if (this->flip)
+        t = vsubq_f32(one, t);
+
+      // These return the number when the other operand is a NaN
+      t = vminnmq_f32(vmaxnmq_f32(t, zero), one);
+      return vcvtq_u32_f32(vmulq_f32(t, vdupq_n_f32(255.0f)));
+    }
+
+    /// \brief Narrow 8 scaled values to bytes and store them
+    /// \param[in] _low First 4 values
+    /// \param[in] _high Last 4 values
+    /// \param[out] _out Where to store the values
+    private: static void StoreNeon(uint32x4_t _low, uint32x4_t _high,
+        uint8_t *_out)
+    {
+      vst1_u8(_out, vmovn_u16(vcombine_u16(vmovn_u32(_low),
+          vmovn_u32(_high))));
+    }
+
+    /// \brief Scale float values, 8 at a time, see Apply
+    /// \param[in] _values Values to scale
+    /// \param[in] _count Number of values
+    /// \param[out] _out Scaled values
+    private: void ApplyNeon(const float *_values, std::size_t _count,
+        uint8_t *_out) const
+    {
+      std::size_t i{0};
+      for (; i + 8 <= _count; i += 8)
+      {
+        StoreNeon(this->ScaleNeon(vld1q_f32(_values + i)),
+            this->ScaleNeon(vld1q_f32(_values + i + 4)), _out + i);
+      }
+      this->ApplyScalar(_values, i, _count, _out);
+    }
+
+    /// \brief Scale 16 bit values, 8 at a time, see Apply
+    /// \param[in] _values Values to scale
+    /// \param[in] _count Number of values
+    /// \param[out] _out Scaled values
+    private: void ApplyNeon(const uint16_t *_values, std::size_t _count,
+        uint8_t *_out) const
+    {
+      std::size_t i{0};
+      for (; i + 8 <= _count; i += 8)
+      {
+        const uint16x8_t v = vld1q_u16(_values + i);
+        StoreNeon(
+            this->ScaleNeon(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)))),
+            this->ScaleNeon(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v)))),
+            _out + i);
+      }
+      this->ApplyScalar(_values, i, _count, _out);
+    }
+#endif
+
+    /// \brief Value mapped to 0 before flipping
+    private: float min;
+
+    /// \brief Difference between the values mapped to 255 and 0, not 0
+    private: float range;
+
+    /// \brief True to show lower values brighter
+    private: bool flip;
+  };
+}  // namespace gz::gui::plugins
+
+#endif
@@ -0,0 +1,440 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ImageGrid.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/Application.hh"
+
+#include "../image_display/ImageConversion.hh"
+
+namespace gz::gui::plugins
+{
+namespace
+{
+/// \brief Converts an image msg, given the size of its tile
+using Conversion = std::function<QImage(const QSize &)>;
+
+/// \brief State of one tile
+class Tile
+{
+  /// \brief Converts the latest msg. Newer msgs replace it if it hasn't
+  /// been picked by a worker yet.
+  public: Conversion pending;
+
+  /// \brief Sequence number of the last conversion picked by a worker
+  public: uint64_t pickedSeq{0};
+
+  /// \brief Sequence number of `convertedImage`
+  public: uint64_t convertedSeq{0};
+
+  /// \brief Latest converted image, waiting to be displayed
+  public: QImage convertedImage;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the factor to subsample an image to about the size of a
+/// tile, without going below it
+/// \param[in] _width Image width
+/// \param[in] _height Image height
+/// \param[in] _tileSize Tile size, empty if unknown
+/// \return Subsampling factor, 1 for full resolution
+unsigned int subsampling(unsigned int _width, unsigned int _height,
+    const QSize &_tileSize)
+{
+  if (_tileSize.isEmpty())
+    return 1u;
+  return std::max(1u, std::min(
+      _width / static_cast<unsigned int>(_tileSize.width()),
+      _height / static_cast<unsigned int>(_tileSize.height())));
+}
+}  // namespace
+
+class ImageGrid::Implementation
+{
+  /// \brief Worker thread loop, converts the latest msg of any tile
+  public: void RunWorker();
+
+  /// \brief Stop and join the worker threads
+  public: void StopWorkers();
+
+  /// \brief Replace the pending conversion of a tile
+  /// \param[in] _tile Tile index
+  /// \param[in] _convert Converts the latest msg
+  public: void SetPending(int _tile, Conversion &&_convert);
+
+  /// \brief Topic of each tile
+  public: QStringList topics;
+
+  /// \brief Number of columns
+  public: int columns{1};
+
+  /// \brief State of each tile
+  public: std::vector<Tile> tiles;
+
+  /// \brief Tile to look at first for pending work, so all tiles get
+  /// converted under load
+  public: std::size_t nextTile{0};
+
+  /// \brief Size of a tile on screen, in pixels
+  public: QSize tileSize;
+
+  /// \brief True if ProcessImages is already queued on the main thread
+  public: bool processQueued{false};
+
+  /// \brief Number of images replaced before being displayed
+  public: uint64_t droppedFrames{0};
+
+  /// \brief True when the worker threads should exit
+  public: bool stopping{false};
+
+  /// \brief Number of images displayed. Only accessed from the main thread.
+  public: uint64_t displayedFrames{0};
+
+  /// \brief Number of dropped frames shown on the GUI. Only accessed from
+  /// the main thread.
+  public: uint64_t droppedGui{0};
+
+  /// \brief Number of worker threads
+  public: unsigned int decodeThreads{2};
+
+  /// \brief Node for communication.
+  public: transport::Node node;
+
+  /// \brief Protects the tiles, the tile size and the counters
+  public: std::mutex mutex;
+
+  /// \brief Wakes up the worker threads
+  public: std::condition_variable cv;
+
+  /// \brief Called from the worker threads when images are ready
+  public: std::function<void()> imagesReadyCb;
+
+  /// \brief Convert and decode the images of all tiles
+  public: std::vector<std::thread> workers;
+
+  /// \brief To provide images for QML.
+  public: ImageGridProvider *provider{nullptr};
+};
+
+/////////////////////////////////////////////////
+ImageGrid::ImageGrid()
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+ImageGrid::~ImageGrid()
+{
+  this->dataPtr->StopWorkers();
+  if (nullptr != this->dataPtr->provider)
+  {
+    App()->Engine()->removeImageProvider(
+        this->CardItem()->objectName() + "imagegrid");
+  }
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  // Default name in case user didn't define one
+  if (this->title.empty())
+    this->title = "Image grid";
+
+  std::vector<bool> compressed;
+  int columns{0};
+
+  // Read configuration
+  if (_pluginElem)
+  {
+    for (auto topicElem = _pluginElem->FirstChildElement("topic");
+        topicElem != nullptr;
+        topicElem = topicElem->NextSiblingElement("topic"))
+    {
+      if (nullptr == topicElem->GetText())
+        continue;
+      this->dataPtr->topics.push_back(topicElem->GetText());
+      compressed.push_back(topicElem->BoolAttribute("compressed", false));
+    }
+
+    if (auto columnsElem = _pluginElem->FirstChildElement("columns"))
+      columnsElem->QueryIntText(&columns);
+
+    if (auto threadsElem = _pluginElem->FirstChildElement("decode_threads"))
+    {
+      int threads{2};
+      if (threadsElem->QueryIntText(&threads) != tinyxml2::XML_SUCCESS ||
+          threads < 1)
+      {
+        gzerr << "Failed to parse <decode_threads> value: "
+               << threadsElem->GetText() << std::endl;
+      }
+      else
+      {
+        this->dataPtr->decodeThreads = static_cast<unsigned int>(threads);
+      }
+    }
+  }
+
+  const int count = this->dataPtr->topics.size();
+  if (0 == count)
+    gzwarn << "No <topic> to display" << std::endl;
+
+  this->dataPtr->columns = columns > 0 ? columns :
+      std::max(1, static_cast<int>(std::ceil(std::sqrt(count))));
+  this->dataPtr->tiles.resize(count);
+
+  this->dataPtr->provider = new ImageGridProvider();
+  App()->Engine()->addImageProvider(
+      this->CardItem()->objectName() + "imagegrid", this->dataPtr->provider);
+
+  // Called from the worker threads
+  this->dataPtr->imagesReadyCb = [this]()
+  {
+    QMetaObject::invokeMethod(this, "ProcessImages", Qt::QueuedConnection);
+  };
+  for (unsigned int i = 0; i < this->dataPtr->decodeThreads; ++i)
+  {
+    this->dataPtr->workers.emplace_back(&Implementation::RunWorker,
+        this->dataPtr.get());
+  }
+
+  // Subscribe to each topic, with the type of its publishers
+  for (int tile = 0; tile < count; ++tile)
+  {
+    const auto topic = this->dataPtr->topics[tile].toStdString();
+    std::vector<transport::MessagePublisher> publishers;
+    std::vector<transport::MessagePublisher> subscribers;
+    this->dataPtr->node.TopicInfo(topic, publishers, subscribers);
+    if (!publishers.empty())
+      compressed[tile] = publishers.front().MsgTypeName() == "gz.msgs.Bytes";
+
+    bool subscribed{false};
+    if (compressed[tile])
+    {
+      std::function<void(const msgs::Bytes &)> cb =
+          [this, tile](const msgs::Bytes &_msg)
+          {
+            this->OnCompressedMsg(tile, _msg);
+          };
+      subscribed = this->dataPtr->node.Subscribe(topic, cb);
+    }
+    else
+    {
+      std::function<void(const msgs::Image &)> cb =
+          [this, tile](const msgs::Image &_msg)
+          {
+            this->OnImageMsg(tile, _msg);
+          };
+      subscribed = this->dataPtr->node.Subscribe(topic, cb);
+    }
+
+    if (!subscribed)
+      gzerr << "Unable to subscribe to topic [" << topic << "]" << std::endl;
+  }
+
+  emit this->TopicsChanged();
+  emit this->ColumnsChanged();
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::Implementation::RunWorker()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    // Pick the next tile with a pending msg, round robin
+    std::size_t tileIndex{0};
+    this->cv.wait(lock, [this, &tileIndex]
+    {
+      if (this->stopping)
+        return true;
+      for (std::size_t i = 0; i < this->tiles.size(); ++i)
+      {
+        tileIndex = (this->nextTile + i) % this->tiles.size();
+        if (this->tiles[tileIndex].pending)
+          return true;
+      }
+      return false;
+    });
+    if (this->stopping)
+      return;
+
+    Tile &tile = this->tiles[tileIndex];
+    auto convert = std::move(tile.pending);
+    tile.pending = nullptr;
+    const uint64_t seq = ++tile.pickedSeq;
+    const QSize size = this->tileSize;
+    this->nextTile = tileIndex + 1;
+    lock.unlock();
+
+    QImage image = convert(size);
+
+    lock.lock();
+    if (image.isNull())
+      continue;
+
+    // Another worker may have finished a newer image of this tile first
+    if (seq < tile.convertedSeq || !tile.convertedImage.isNull())
+      this->droppedFrames++;
+    if (seq < tile.convertedSeq)
+      continue;
+    tile.convertedImage = std::move(image);
+    tile.convertedSeq = seq;
+
+    if (!this->processQueued)
+    {
+      this->processQueued = true;
+      this->imagesReadyCb();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::Implementation::StopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopping = true;
+  }
+  this->cv.notify_all();
+  for (auto &worker : this->workers)
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::Implementation::SetPending(int _tile, Conversion &&_convert)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto &tile = this->tiles[_tile];
+    if (tile.pending)
+      this->droppedFrames++;
+    tile.pending = std::move(_convert);
+  }
+  this->cv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::ProcessImages()
+{
+  std::vector<std::pair<int, QImage>> images;
+  uint64_t dropped;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->processQueued = false;
+    for (std::size_t i = 0; i < this->dataPtr->tiles.size(); ++i)
+    {
+      auto &tile = this->dataPtr->tiles[i];
+      if (tile.convertedImage.isNull())
+        continue;
+      images.emplace_back(static_cast<int>(i),
+          std::move(tile.convertedImage));
+      tile.convertedImage = QImage();
+    }
+    dropped = this->dataPtr->droppedFrames;
+  }
+  if (images.empty())
+    return;
+
+  for (const auto &[tile, image] : images)
+  {
+    this->dataPtr->provider->SetImage(tile, image);
+    this->dataPtr->displayedFrames++;
+    emit this->newImage(tile);
+  }
+  this->dataPtr->droppedGui = dropped;
+  emit this->FramesChanged();
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::OnImageMsg(int _tile, const msgs::Image &_msg)
+{
+  auto msg = std::make_shared<const msgs::Image>(_msg);
+  this->dataPtr->SetPending(_tile, [msg](const QSize &_tileSize)
+  {
+    return ConvertImage(msg, std::nullopt, std::nullopt,
+        subsampling(msg->width(), msg->height(), _tileSize));
+  });
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::OnCompressedMsg(int _tile, const msgs::Bytes &_msg)
+{
+  auto msg = std::make_shared<const msgs::Bytes>(_msg);
+  this->dataPtr->SetPending(_tile, [msg](const QSize &_tileSize)
+  {
+    return DecodeImage(*msg, _tileSize);
+  });
+}
+
+/////////////////////////////////////////////////
+QStringList ImageGrid::Topics() const
+{
+  return this->dataPtr->topics;
+}
+
+/////////////////////////////////////////////////
+int ImageGrid::Columns() const
+{
+  return this->dataPtr->columns;
+}
+
+/////////////////////////////////////////////////
+int ImageGrid::DisplayedFrames() const
+{
+  return static_cast<int>(this->dataPtr->displayedFrames);
+}
+
+/////////////////////////////////////////////////
+int ImageGrid::DroppedFrames() const
+{
+  return static_cast<int>(this->dataPtr->droppedGui);
+}
+
+/////////////////////////////////////////////////
+void ImageGrid::SetTileSize(int _width, int _height)
+{
+  // Tiles which aren't laid out yet keep the last size
+  if (_width <= 0 || _height <= 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->tileSize = QSize(_width, _height);
+}
+}  // namespace gz::gui::plugins
+
+// Register this plugin
+GZ_ADD_PLUGIN(gz::gui::plugins::ImageGrid,
+              gz::gui::Plugin)
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_IMAGEGRID_HH_
+#define GZ_GUI_PLUGINS_IMAGEGRID_HH_
+
+#include <mutex>
+#include <vector>
+
+#include <QQuickImageProvider>
+
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/image.pb.h>
+
+#ifndef _WIN32
+#  define ImageGrid_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(ImageGrid_EXPORTS))
+#    define ImageGrid_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ImageGrid_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+#include "gz/gui/Plugin.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Provides the images of all tiles of an ImageGrid. Images are
+  /// requested as "<tile>/<anything>".
+  class ImageGridProvider : public QQuickImageProvider
+  {
+    /// \brief Constructor
+    public: ImageGridProvider()
+       : QQuickImageProvider(QQuickImageProvider::Image)
+    {
+    }
+
+    // Documentation inherited
+    public: QImage requestImage(const QString &_id, QSize *,
+        const QSize &) override
+    {
+      bool ok{false};
+      const int tile = _id.section('/', 0, 0).toInt(&ok);
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (ok && tile >= 0 && tile < static_cast<int>(this->images.size()) &&
+            !this->images[tile].isNull())
+        {
+          // Must return a copy
+          QImage copy(this->images[tile]);
+          return copy;
+        }
+      }
+
+      // Placeholder in case we have no image yet
+      QImage i(320, 240, QImage::Format_RGB888);
+      i.fill(QColor(128, 128, 128, 100));
+      return i;
+    }
+
+    /// \brief Set the image of a tile
+    /// \param[in] _tile Tile index
+    /// \param[in] _image New image
+    public: void SetImage(int _tile, const QImage &_image)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (_tile >= static_cast<int>(this->images.size()))
+        this->images.resize(_tile + 1);
+      this->images[_tile] = _image;
+    }
+
+    /// \brief Protects `images`, which are requested from QML's threads
+    private: std::mutex mutex;
+
+    /// \brief Latest image of each tile
+    private: std::vector<QImage> images;
+  };
+
+  /// \brief Display images from several Gazebo Transport topics in a grid.
+  ///
+  /// All tiles share one pool of worker threads, which convert the latest
+  /// image of each topic. Images are converted or decoded at about the
+  /// size of a tile on screen, so large images don't cost a full resolution
+  /// conversion to be shown small.
+  ///
+  /// Topics can carry raw gz.msgs.Image or compressed gz.msgs.Bytes, see
+  /// ImageDisplay.
+  ///
+  /// ## Configuration
+  ///
+  /// \<topic\> : Topic to display, one element per tile. Set the
+  ///             `compressed` attribute to true for topics of compressed
+  ///             images without publishers yet.
+  /// \<columns\> : Number of columns, by default the grid is about square.
+  /// \<decode_threads\> : Number of threads converting and decoding
+  ///                      images, 2 by default.
+  class ImageGrid_EXPORTS_API ImageGrid : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Topics of each tile
+    Q_PROPERTY(
+      QStringList topics
+      READ Topics
+      NOTIFY TopicsChanged
+    )
+
+    /// \brief Number of columns
+    Q_PROPERTY(
+      int columns
+      READ Columns
+      NOTIFY ColumnsChanged
+    )
+
+    /// \brief Number of images displayed, over all tiles
+    Q_PROPERTY(
+      int displayedFrames
+      READ DisplayedFrames
+      NOTIFY FramesChanged
+    )
+
+    /// \brief Number of images dropped because a newer one of the same tile
+    /// arrived before they were displayed
+    Q_PROPERTY(
+      int droppedFrames
+      READ DroppedFrames
+      NOTIFY FramesChanged
+    )
+
+    /// \brief Constructor
+    public: ImageGrid();
+
+    /// \brief Destructor
+    public: ~ImageGrid() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the topics of each tile
+    /// \return Topics
+    public: Q_INVOKABLE QStringList Topics() const;
+
+    /// \brief Notify that the topics have changed
+    signals: void TopicsChanged();
+
+    /// \brief Get the number of columns
+    /// \return Number of columns
+    public: Q_INVOKABLE int Columns() const;
+
+    /// \brief Notify that the number of columns has changed
+    signals: void ColumnsChanged();
+
+    /// \brief Get the number of images displayed
+    /// \return Images displayed so far
+    public: Q_INVOKABLE int DisplayedFrames() const;
+
+    /// \brief Get the number of images dropped
+    /// \return Images dropped so far
+    public: Q_INVOKABLE int DroppedFrames() const;
+
+    /// \brief Notify that the frame counters have changed
+    signals: void FramesChanged();
+
+    /// \brief Set the size of a tile on screen, in pixels. Images are
+    /// converted at about this size.
+    /// \param[in] _width Tile width
+    /// \param[in] _height Tile height
+    public: Q_INVOKABLE void SetTileSize(int _width, int _height);
+
+    /// \brief Notify that a tile has a new image
+    /// \param[in] _tile Tile index
+    signals: void newImage(int _tile);
+
+    /// \brief Hand the converted images to QML
+    private slots: void ProcessImages();
+
+    /// \brief Subscriber callback when a new image is received
+    /// \param[in] _tile Tile showing the topic
+    /// \param[in] _msg New image
+    private: void OnImageMsg(int _tile, const msgs::Image &_msg);
+
+    /// \brief Subscriber callback when a new compressed image is received
+    /// \param[in] _tile Tile showing the topic
+    /// \param[in] _msg Encoded image
+    private: void OnCompressedMsg(int _tile, const msgs::Bytes &_msg);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_IMAGEGRID_HH_
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+import QtQuick.Window 2.2
+
+Rectangle {
+  id: imageGrid
+  color: "transparent"
+  anchors.fill: parent
+  Layout.minimumWidth: 400
+  Layout.minimumHeight: 300
+
+  /**
+   * Unique name for this plugin instance
+   */
+  property string uniqueName: ""
+
+  onParentChanged: {
+    if (undefined === parent)
+      return;
+
+    uniqueName = parent.card().objectName + "imagegrid";
+    for (var i = 0; i < tiles.count; ++i)
+      tiles.itemAt(i).reload();
+  }
+
+  Connections {
+    target: ImageGrid
+    function onNewImage(_tile) {
+      var tile = tiles.itemAt(_tile);
+      if (tile)
+        tile.reload();
+    }
+  }
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    GridLayout {
+      id: grid
+      objectName: "tileGrid"
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+      columns: ImageGrid.columns
+
+      Repeater {
+        id: tiles
+        model: ImageGrid.topics
+
+        Item {
+          Layout.fillWidth: true
+          Layout.fillHeight: true
+
+          function reload() {
+            // Force image request to C++
+            image.source = "image://" + uniqueName + "/" + index + "/" +
+                Math.random().toString(36).substr(2, 5);
+          }
+
+          // Images are converted at about the size of the tiles, which are
+          // all the same
+          onWidthChanged: updateSize()
+          onHeightChanged: updateSize()
+          function updateSize() {
+            if (index !== 0)
+              return;
+            ImageGrid.SetTileSize(width * Screen.devicePixelRatio,
+                height * Screen.devicePixelRatio);
+          }
+
+          Image {
+            id: image
+            anchors.fill: parent
+            fillMode: Image.PreserveAspectFit
+            cache: false
+          }
+
+          Label {
+            anchors.left: parent.left
+            anchors.bottom: parent.bottom
+            anchors.right: parent.right
+            elide: Text.ElideLeft
+            text: modelData
+          }
+        }
+      }
+    }
+
+    Label {
+      objectName: "framesLabel"
+      Layout.fillWidth: true
+      text: "Displayed: " + ImageGrid.displayedFrames +
+            "  Dropped: " + ImageGrid.droppedFrames
+    }
+  }
+}
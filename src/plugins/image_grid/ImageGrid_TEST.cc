@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gz/msgs/image.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "test_config.hh"  // NOLINT(build/include)
+#include "ImageGrid.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./ImageGrid_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(ImageGridTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Load))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  EXPECT_TRUE(app.LoadPlugin("ImageGrid"));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::ImageGrid *>();
+  EXPECT_EQ(plugins.size(), 1);
+
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Image grid");
+  EXPECT_TRUE(plugin->Topics().empty());
+  EXPECT_EQ(plugin->Columns(), 1);
+
+  // Cleanup
+  plugins.clear();
+}
+
+/////////////////////////////////////////////////
+TEST(ImageGridTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ReceiveImages))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"ImageGrid\">"
+      "<topic>/grid_test_0</topic>"
+      "<topic>/grid_test_1</topic>"
+      "<topic>/grid_test_2</topic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageGrid",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  // Get plugin
+  auto plugins = win->findChildren<plugins::ImageGrid *>();
+  EXPECT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  ASSERT_EQ(plugin->Topics().size(), 3);
+  EXPECT_EQ(plugin->Topics()[1], "/grid_test_1");
+  EXPECT_EQ(plugin->Columns(), 2);
+
+  auto providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagegrid");
+  ASSERT_NE(providerBase, nullptr);
+  auto imageProvider = static_cast<plugins::ImageGridProvider *>(providerBase);
+  ASSERT_NE(imageProvider, nullptr);
+
+  // Tiles are much smaller than the image
+  plugin->SetTileSize(100, 50);
+
+  // Red image on the second tile
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>("/grid_test_1");
+  {
+    msgs::Image msg;
+    msg.set_height(200);
+    msg.set_width(400);
+    msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+    msg.set_step(msg.width() * 3);
+
+    std::string data(msg.step() * msg.height(), '\0');
+    for (std::size_t p = 0; p < data.size(); p += 3)
+      data[p] = static_cast<char>(255);
+    msg.set_data(data);
+    pub.Publish(msg);
+  }
+
+  // Give it time to be processed
+  int sleep = 0;
+  int maxSleep = 30;
+  while (plugin->DisplayedFrames() == 0 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  EXPECT_EQ(plugin->DisplayedFrames(), 1);
+
+  // Converted at the tile size
+  QSize dummySize;
+  QImage img = imageProvider->requestImage("1/a", &dummySize, dummySize);
+  EXPECT_EQ(img.width(), 100);
+  EXPECT_EQ(img.height(), 50);
+  EXPECT_EQ(img.pixelColor(0, 0).red(), 255);
+  EXPECT_EQ(img.pixelColor(0, 0).green(), 0);
+  EXPECT_EQ(img.pixelColor(0, 0).blue(), 0);
+
+  // Other tiles still have placeholders
+  img = imageProvider->requestImage("0/a", &dummySize, dummySize);
+  EXPECT_TRUE(img.allGray());
+
+  // Cleanup
+  plugins.clear();
+}
@@ -20,6 +20,8 @@
 #include <gz/msgs/stringmsg.pb.h>
 
 #include <gz/utils/ImplPtr.hh>
+#include <chrono>
+#include <optional>
 #include <string>
 #include <mutex>
 
@@ -28,6 +30,8 @@
 #include <gz/gui/Application.hh>
 #include <gz/gui/GuiEvents.hh>
 #include <gz/gui/MainWindow.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/SceneServices.hh>
 
 #include <gz/plugin/Register.hh>
 
@@ -80,6 +84,35 @@ class InteractiveViewControl::Implementation
   /// camera to target point so it remains the same size on screen.
   public: void UpdateReferenceVisual();
 
+  /// \brief Ways a drag moves the camera
+  public: enum class Motion
+  {
+    /// \brief Pan
+    kPan,
+
+    /// \brief Orbit
+    kOrbit,
+
+    /// \brief Zoom
+    kZoom
+  };
+
+  /// \brief Move the camera for a drag
+  /// \param[in] _motion How to move it
+  /// \param[in] _drag Drag distance in pixels, scaled by the sensitivity
+  public: void Move(Motion _motion, const math::Vector2d &_drag);
+
+  /// \brief Extrapolate a drag by `predictionTime`, taking back what was
+  /// extrapolated for the previous frame.
+  /// \param[in] _motion How the drag moves the camera
+  /// \param[in] _drag Drag distance since the previous frame
+  /// \return Distance to add to the drag
+  public: math::Vector2d Predict(Motion _motion,
+      const math::Vector2d &_drag);
+
+  /// \brief Take back the extrapolated drag, once the drag stops
+  public: void UndoPrediction();
+
   /// \brief Flag to indicate if mouse event is dirty
   public: bool mouseDirty = false;
 
@@ -134,6 +167,11 @@ class InteractiveViewControl::Implementation
   /// \brief Ray query for mouse clicks
   public: rendering::RayQueryPtr rayQuery{nullptr};
 
+  /// \brief Mouse position `target` was found at while scrolling. Zooming
+  /// keeps using it until the mouse moves or another event arrives, so
+  /// scrolling doesn't make a ray query every frame.
+  public: std::optional<math::Vector2i> scrollPos;
+
   //// \brief Pointer to the rendering scene
   public: rendering::ScenePtr scene{nullptr};
 
@@ -145,6 +183,22 @@ class InteractiveViewControl::Implementation
 
   /// \brief View control sensitivity value. Must be greater than 0.
   public: double viewControlSensitivity = 1.0;
+
+  /// \brief Seconds drags are extrapolated by, 0 to disable it
+  public: double predictionTime{0.0};
+
+  /// \brief Drag distance currently extrapolated
+  public: math::Vector2d predicted{math::Vector2d::Zero};
+
+  /// \brief How the extrapolated drag moved the camera
+  public: Motion predictedMotion{Motion::kPan};
+
+  /// \brief When the camera was last moved by a drag, unset between drags
+  public: std::optional<std::chrono::steady_clock::time_point> lastMoveTime;
+
+  /// \brief Keeps OnRender registered. Last member so it's destroyed
+  /// first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
 };
 
 /////////////////////////////////////////////////
@@ -156,37 +210,20 @@ void InteractiveViewControl::Implementation::OnRender()
     if (!this->scene)
       return;
 
-    for (unsigned int i = 0; i < this->scene->NodeCount(); ++i)
-    {
-      auto cam = std::dynamic_pointer_cast<rendering::Camera>(
-        this->scene->NodeByIndex(i));
-      if (cam)
-      {
-        bool isUserCamera = false;
-        try
-        {
-          isUserCamera = std::get<bool>(cam->UserData("user-camera"));
-        }
-        catch (std::bad_variant_access &)
-        {
-          continue;
-        }
-        if (isUserCamera)
-        {
-          this->camera = cam;
-          gzdbg << "InteractiveViewControl plugin is moving camera ["
-                 << this->camera->Name() << "]" << std::endl;
-          break;
-        }
-      }
-    }
-
+    this->camera = SceneServices::Get<rendering::Camera>(
+        SceneServices::kUserCamera);
     if (!this->camera)
     {
       gzerr << "InteractiveViewControl camera is not available" << std::endl;
       return;
     }
-    this->rayQuery = this->camera->Scene()->CreateRayQuery();
+    gzdbg << "InteractiveViewControl plugin is moving camera ["
+           << this->camera->Name() << "]" << std::endl;
+
+    this->rayQuery = SceneServices::Get<rendering::RayQuery>(
+        SceneServices::kUserCameraRayQuery);
+    if (!this->rayQuery)
+      this->rayQuery = this->camera->Scene()->CreateRayQuery();
   }
 
   if (this->blockOrbit)
@@ -198,6 +235,16 @@ void InteractiveViewControl::Implementation::OnRender()
   if (!this->camera)
     return;
 
+  // Take back the extrapolated drag once no new drag arrived for as long as
+  // it extrapolated
+  if (!this->mouseDirty && this->lastMoveTime &&
+      std::chrono::steady_clock::now() - *this->lastMoveTime >
+      std::chrono::duration<double>(this->predictionTime))
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->UndoPrediction();
+  }
+
   // hover
   if (this->hoverDirty)
   {
@@ -256,10 +303,17 @@ void InteractiveViewControl::Implementation::OnRender()
     this->refVisual->SetVisible(true);
   }
 
+  if (this->mouseEvent.Type() != common::MouseEvent::MOVE)
+    this->UndoPrediction();
+
   if (this->mouseEvent.Type() == common::MouseEvent::SCROLL)
   {
-    this->target = rendering::screenToScene(
-      this->mouseEvent.Pos(), this->camera, this->rayQuery);
+    if (this->scrollPos != this->mouseEvent.Pos())
+    {
+      this->target = rendering::screenToScene(
+        this->mouseEvent.Pos(), this->camera, this->rayQuery);
+      this->scrollPos = this->mouseEvent.Pos();
+    }
 
     this->viewControl->SetTarget(this->target);
     double distance = this->camera->WorldPosition().Distance(
@@ -272,6 +326,7 @@ void InteractiveViewControl::Implementation::OnRender()
   }
   else if (this->mouseEvent.Type() == common::MouseEvent::PRESS)
   {
+    this->scrollPos.reset();
     this->target = rendering::screenToScene(
       this->mouseEvent.PressPos(), this->camera, this->rayQuery);
 
@@ -281,33 +336,37 @@ void InteractiveViewControl::Implementation::OnRender()
   }
   else
   {
-    math::Vector2d newDrag = this->drag * this->viewControlSensitivity;
+    this->scrollPos.reset();
+
+    std::optional<Motion> motion;
     // Pan with left button
     if (this->mouseEvent.Buttons() & common::MouseEvent::LEFT)
     {
       if (Qt::ShiftModifier == QGuiApplication::queryKeyboardModifiers())
-        this->viewControl->Orbit(newDrag);
+        motion = Motion::kOrbit;
       else
-        this->viewControl->Pan(newDrag);
-      this->UpdateReferenceVisual();
+        motion = Motion::kPan;
     }
     // Orbit with middle button
     else if (this->mouseEvent.Buttons() & common::MouseEvent::MIDDLE)
     {
-      this->viewControl->Orbit(newDrag);
-      this->UpdateReferenceVisual();
+      motion = Motion::kOrbit;
     }
     // Zoom with right button
     else if (this->mouseEvent.Buttons() & common::MouseEvent::RIGHT)
     {
-      double hfov = this->camera->HFOV().Radian();
-      double vfov = 2.0f * atan(tan(hfov / 2.0f) / this->camera->AspectRatio());
-      double distance = this->camera->WorldPosition().Distance(this->target);
-      double amount = ((-newDrag.Y() /
-          static_cast<double>(this->camera->ImageHeight()))
-          * distance * tan(vfov/2.0) * 6.0);
-      this->viewControl->Zoom(amount);
-      this->UpdateReferenceVisual();
+      motion = Motion::kZoom;
+    }
+
+    if (motion)
+    {
+      math::Vector2d newDrag = this->drag * this->viewControlSensitivity;
+      newDrag += this->Predict(*motion, newDrag);
+      this->Move(*motion, newDrag);
+    }
+    else
+    {
+      this->UndoPrediction();
     }
   }
 
@@ -315,6 +374,67 @@ void InteractiveViewControl::Implementation::OnRender()
   this->mouseDirty = false;
 }
 
+/////////////////////////////////////////////////
+void InteractiveViewControl::Implementation::Move(Motion _motion,
+    const math::Vector2d &_drag)
+{
+  if (_motion == Motion::kPan)
+  {
+    this->viewControl->Pan(_drag);
+  }
+  else if (_motion == Motion::kOrbit)
+  {
+    this->viewControl->Orbit(_drag);
+  }
+  else
+  {
+    double hfov = this->camera->HFOV().Radian();
+    double vfov = 2.0f * atan(tan(hfov / 2.0f) / this->camera->AspectRatio());
+    double distance = this->camera->WorldPosition().Distance(this->target);
+    double amount = ((-_drag.Y() /
+        static_cast<double>(this->camera->ImageHeight()))
+        * distance * tan(vfov/2.0) * 6.0);
+    this->viewControl->Zoom(amount);
+  }
+  this->UpdateReferenceVisual();
+}
+
+/////////////////////////////////////////////////
+math::Vector2d InteractiveViewControl::Implementation::Predict(
+    Motion _motion, const math::Vector2d &_drag)
+{
+  if (this->predictionTime <= 0.0)
+    return math::Vector2d::Zero;
+
+  if (_motion != this->predictedMotion)
+    this->UndoPrediction();
+
+  // Velocity of the drag since the camera last moved
+  const auto now = std::chrono::steady_clock::now();
+  math::Vector2d prediction{math::Vector2d::Zero};
+  if (this->lastMoveTime)
+  {
+    const std::chrono::duration<double> dt = now - *this->lastMoveTime;
+    if (dt.count() > 0.0)
+      prediction = _drag / dt.count() * this->predictionTime;
+  }
+
+  const math::Vector2d correction = prediction - this->predicted;
+  this->predicted = prediction;
+  this->predictedMotion = _motion;
+  this->lastMoveTime = now;
+  return correction;
+}
+
+/////////////////////////////////////////////////
+void InteractiveViewControl::Implementation::UndoPrediction()
+{
+  if (this->predicted != math::Vector2d::Zero && this->viewControl)
+    this->Move(this->predictedMotion, -this->predicted);
+  this->predicted = math::Vector2d::Zero;
+  this->lastMoveTime.reset();
+}
+
 /////////////////////////////////////////////////
 void InteractiveViewControl::Implementation::UpdateReferenceVisual()
 {
@@ -351,6 +471,7 @@ bool InteractiveViewControl::Implementation::OnViewControl(
   // set up a new view controller
   this->mouseDirty = true;
 
+  RenderHooks::RequestRender();
   _res.set_data(true);
   return true;
 }
@@ -362,6 +483,7 @@ bool InteractiveViewControl::Implementation::OnReferenceVisual(
   std::lock_guard<std::mutex> lock(this->mutex);
   this->enableRefVisual = _msg.data();
 
+  RenderHooks::RequestRender();
   _res.set_data(true);
   return true;
 }
@@ -397,11 +519,32 @@ InteractiveViewControl::~InteractiveViewControl() = default;
 
 /////////////////////////////////////////////////
 void InteractiveViewControl::LoadConfig(
-  const tinyxml2::XMLElement * /*_pluginElem*/)
+  const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Interactive view control";
 
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("prediction"))
+    {
+      double prediction{0.0};
+      if (elem->QueryDoubleText(&prediction) != tinyxml2::XML_SUCCESS ||
+          prediction < 0.0)
+      {
+        gzerr << "Unable to set <prediction>, expected a positive number of "
+              << "seconds. Not predicting." << std::endl;
+        prediction = 0.0;
+      }
+      this->dataPtr->predictionTime = prediction;
+    }
+  }
+
+  // Apply input before the camera renders, so it shows in the same frame
+  // instead of the next one
+  this->dataPtr->renderConnection = RenderHooks::OnPreRender(
+      [this]() { this->dataPtr->OnRender(); }, 0, "InteractiveViewControl");
+
   // camera view control mode
   this->dataPtr->cameraViewControlService = "/gui/camera/view_control";
   this->dataPtr->node.Advertise(this->dataPtr->cameraViewControlService,
@@ -435,11 +578,7 @@ void InteractiveViewControl::LoadConfig(
 /////////////////////////////////////////////////
 bool InteractiveViewControl::eventFilter(QObject *_obj, QEvent *_event)
 {
-  if (_event->type() == events::Render::kType)
-  {
-    this->dataPtr->OnRender();
-  }
-  else if (_event->type() == events::LeftClickOnScene::kType)
+  if (_event->type() == events::LeftClickOnScene::kType)
   {
     auto leftClickOnScene =
       reinterpret_cast<gz::gui::events::LeftClickOnScene *>(_event);
@@ -47,6 +47,17 @@ namespace gz::gui::plugins
   ///
   /// * `orbit`: perspective projection
   /// * `ortho`: orthographic projection
+  ///
+  /// Input is applied right before the user camera renders, so it shows in
+  /// the same frame.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<prediction\> : Seconds to extrapolate drags by, at their current
+  ///                    speed, to make up for slow frames. What's
+  ///                    extrapolated is taken back on the next frame, so
+  ///                    the camera ends where the drag did. Defaults to 0,
+  ///                    no prediction.
   class InteractiveViewControl : public Plugin
   {
     Q_OBJECT
@@ -16,19 +16,30 @@
 */
 
 #include <algorithm>
-#include <list>
-#include <map>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include <QQmlProperty>
 
 #include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/header.pb.h>
 #include <gz/msgs/marker.pb.h>
 #include <gz/msgs/marker_v.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
 #include <gz/msgs/world_stats.pb.h>
 
 #include <gz/common/Console.hh>
-#include <gz/common/Profiler.hh>
 #include <gz/common/StringUtils.hh>
 
 #include <gz/math/Rand.hh>
@@ -43,19 +54,506 @@
 #include <gz/transport/Node.hh>
 
 #include "gz/gui/Application.hh"
-#include "gz/gui/GuiEvents.hh"
+#include "gz/gui/GpuUploads.hh"
 #include "gz/gui/Helpers.hh"
-#include "gz/gui/MainWindow.hh"
+#include "gz/gui/LatencyTrace.hh"
+#include "gz/gui/MarkerSink.hh"
+#include "gz/gui/NodePool.hh"
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneLabels.hh"
+#include "gz/gui/SceneServices.hh"
+#include "gz/gui/SubscriptionHub.hh"
 
 #include "MarkerManager.hh"
 
 namespace gz::gui::plugins
 {
+namespace
+{
+/// \brief Bytes of each point uploaded by markers, its position and color
+constexpr std::size_t kBytesPerPoint{sizeof(float) * 3 + sizeof(float) * 4};
+
+/// \brief A marker and what was last applied to it, so that modifications
+/// only update what changed
+class MarkerState
+{
+  /// \brief Visual holding the marker
+  public: rendering::VisualPtr visual;
+
+  /// \brief The marker geometry, holding the first chunk of points
+  public: rendering::MarkerPtr marker;
+
+  /// \brief Geometries holding the following chunks of points, with the
+  /// same type and material as `marker`. See markerChunkSize.
+  public: std::vector<rendering::MarkerPtr> chunks;
+
+  /// \brief Last render type set
+  public: rendering::MarkerType type{rendering::MarkerType::MT_NONE};
+
+  /// \brief Hash of the last material msg applied
+  public: std::size_t materialHash{0};
+
+  /// \brief Last point size set
+  public: std::optional<double> size;
+
+  /// \brief Points currently in the marker
+  public: std::vector<math::Vector3d> points;
+
+  /// \brief Color of each point in `points`
+  public: std::vector<math::Color> colors;
+
+  /// \brief Label showing the text of TEXT markers, set on SceneLabels
+  public: std::optional<SceneLabel> label;
+};
+
+/// \brief Markers of one namespace
+class Namespace
+{
+  /// \brief Namespace name
+  public: std::string name;
+
+  /// \brief Markers by id
+  public: std::unordered_map<uint64_t, MarkerState> markers;
+};
+
+/// \brief Identifies a marker by interned namespace and id
+class MarkerKey
+{
+  /// \brief Equality
+  /// \param[in] _other Key to compare to
+  /// \return True if both keys are the same
+  public: bool operator==(const MarkerKey &_other) const
+  {
+    return this->ns == _other.ns && this->id == _other.id;
+  }
+
+  /// \brief Namespace id, see MarkerManager::Implementation::NamespaceId
+  public: uint32_t ns;
+
+  /// \brief Marker id
+  public: uint64_t id;
+};
+
+/// \brief Hash of a MarkerKey
+class MarkerKeyHash
+{
+  /// \brief Hash a key
+  /// \param[in] _key Key
+  /// \return Hash
+  public: std::size_t operator()(const MarkerKey &_key) const
+  {
+    return std::hash<uint64_t>()(_key.id) ^
+        (std::hash<uint32_t>()(_key.ns) * 0x9e3779b97f4a7c15ull);
+  }
+};
+
+/// \brief When a marker with a lifetime expires
+class Expiry
+{
+  /// \brief Sim time the marker expires at
+  public: std::chrono::steady_clock::duration time;
+
+  /// \brief Marker namespace id
+  public: uint32_t ns;
+
+  /// \brief Marker id
+  public: uint64_t id;
+
+  /// \brief Order expiries so that the earliest is at the top of the heap
+  /// \param[in] _other Expiry to compare to
+  /// \return True if this expiry is later than `_other`
+  public: bool operator>(const Expiry &_other) const
+  {
+    return this->time > _other.time;
+  }
+};
+
+/// \brief Points of a marker set from a packed buffer, see
+/// MarkerManager's bulk service
+class BulkUpdate
+{
+  /// \brief Marker namespace
+  public: std::string ns;
+
+  /// \brief Marker id
+  public: uint64_t id{0};
+
+  /// \brief Render type, unset to keep the current one
+  public: std::optional<rendering::MarkerType> type;
+
+  /// \brief Point size, unset to keep the current one
+  public: std::optional<double> size;
+
+  /// \brief Index of the first point overwritten, unset to replace all of
+  /// the marker's points
+  public: std::optional<std::size_t> offset;
+
+  /// \brief Decoded points
+  public: std::vector<math::Vector3d> points;
+
+  /// \brief Color of each point in `points`
+  public: std::vector<math::Color> colors;
+};
+
+/// \brief A msg waiting to be processed on the render thread
+using QueuedMsg = std::variant<msgs::Marker, BulkUpdate>;
+
+/// \brief Markers of a namespace, copied to be listed without holding up
+/// the render thread
+class ListedNamespace
+{
+  /// \brief Namespace name
+  public: std::string name;
+
+  /// \brief Number of markers
+  public: std::size_t count{0};
+
+  /// \brief Marker ids, sorted. Empty when only counting.
+  public: std::vector<uint64_t> ids;
+};
+
+/// \brief What to list, see MarkerManager's list query service
+class ListQuery
+{
+  /// \brief Namespaces to list, empty for all
+  public: std::vector<std::string> namespaces;
+
+  /// \brief Number of markers skipped
+  public: std::size_t offset{0};
+
+  /// \brief Maximum number of markers listed, 0 for no limit
+  public: std::size_t limit{0};
+
+  /// \brief True to only count the markers of each namespace
+  public: bool summary{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the stamp of a msg header
+/// \param[in] _header Header
+/// \return Seconds, 0 if there's no stamp
+double headerStamp(const msgs::Header &_header)
+{
+  if (!_header.has_stamp())
+    return 0.0;
+  return _header.stamp().sec() + _header.stamp().nsec() * 1e-9;
+}
+
+/////////////////////////////////////////////////
+/// \brief Combine two ADD_MODIFY msgs for the same marker into one with the
+/// same effect as applying both in order. Fields unset on the newer msg keep
+/// the older value.
+/// \param[in] _older Msg received first
+/// \param[in,out] _newer Msg received last, becomes the combined msg
+void mergeMarkerMsg(const msgs::Marker &_older, msgs::Marker &_newer)
+{
+  if (_newer.point_size() == 0)
+  {
+    *_newer.mutable_point() = _older.point();
+    if (_newer.materials_size() == 0)
+      *_newer.mutable_materials() = _older.materials();
+  }
+  if (!_newer.has_material() && _older.has_material())
+    *_newer.mutable_material() = _older.material();
+  if (!_newer.has_pose() && _older.has_pose())
+    *_newer.mutable_pose() = _older.pose();
+  if (!_newer.has_scale() && _older.has_scale())
+    *_newer.mutable_scale() = _older.scale();
+  if (_newer.parent().empty())
+    _newer.set_parent(_older.parent());
+  if (_newer.type() == msgs::Marker::NONE)
+    _newer.set_type(_older.type());
+  if (_newer.text().empty())
+    _newer.set_text(_older.text());
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a list query from the data of a request header
+/// \param[in] _header Header, see MarkerManager's list query service
+/// \param[out] _query Query
+/// \return False if a value is malformed
+bool parseListQuery(const msgs::Header &_header, ListQuery &_query)
+{
+  for (const auto &data : _header.data())
+  {
+    if (data.key() == "ns")
+    {
+      _query.namespaces.insert(_query.namespaces.end(),
+          data.value().begin(), data.value().end());
+      continue;
+    }
+    if (data.value_size() == 0)
+      continue;
+
+    const std::string &value = data.value(0);
+    if (data.key() == "summary")
+    {
+      _query.summary = value == "true" || value == "1";
+      continue;
+    }
+
+    std::size_t *number{nullptr};
+    if (data.key() == "offset")
+      number = &_query.offset;
+    else if (data.key() == "limit")
+      number = &_query.limit;
+    else
+      continue;
+
+    std::stringstream ss(value);
+    long long parsed{-1};
+    if (!(ss >> parsed) || parsed < 0)
+    {
+      gzerr << "Invalid marker list " << data.key() << " [" << value << "]"
+             << std::endl;
+      return false;
+    }
+    *number = static_cast<std::size_t>(parsed);
+  }
+
+  // Each namespace is listed once
+  std::sort(_query.namespaces.begin(), _query.namespaces.end());
+  _query.namespaces.erase(std::unique(_query.namespaces.begin(),
+      _query.namespaces.end()), _query.namespaces.end());
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Fill a list reply from copied markers, ordered by namespace then
+/// id, so pages are stable while the markers don't change
+/// \param[in,out] _listed Copied markers, sorted in place
+/// \param[in] _query Query
+/// \param[out] _rep Reply, see MarkerManager's list query service
+void fillListReply(std::vector<ListedNamespace> &_listed,
+    const ListQuery &_query, msgs::Marker_V &_rep)
+{
+  std::sort(_listed.begin(), _listed.end(),
+      [](const ListedNamespace &_a, const ListedNamespace &_b)
+      {
+        return _a.name < _b.name;
+      });
+
+  std::size_t total{0};
+  for (const auto &ns : _listed)
+    total += ns.count;
+
+  auto addData = [&_rep](const std::string &_key,
+      const std::vector<std::string> &_values)
+  {
+    auto *data = _rep.mutable_header()->add_data();
+    data->set_key(_key);
+    for (const auto &value : _values)
+      data->add_value(value);
+  };
+  addData("total", {std::to_string(total)});
+
+  if (_query.summary)
+  {
+    for (const auto &ns : _listed)
+      addData("count", {ns.name, std::to_string(ns.count)});
+    return;
+  }
+
+  const std::size_t end = _query.limit == 0 ? total :
+      std::min(total, _query.offset + _query.limit);
+  std::size_t index{0};
+  for (auto &ns : _listed)
+  {
+    if (index + ns.count <= _query.offset)
+    {
+      index += ns.count;
+      continue;
+    }
+    if (index >= end)
+      break;
+
+    std::sort(ns.ids.begin(), ns.ids.end());
+    const std::size_t first = _query.offset > index ? _query.offset - index : 0;
+    const std::size_t last = std::min(ns.count, end - index);
+    for (std::size_t i = first; i < last; ++i)
+    {
+      auto *markerMsg = _rep.add_marker();
+      markerMsg->set_ns(ns.name);
+      markerMsg->set_id(ns.ids[i]);
+    }
+    index += ns.count;
+  }
+
+  if (end < total)
+    addData("next_offset", {std::to_string(end)});
+}
+
+/////////////////////////////////////////////////
+/// \brief Decode a bulk msg without going through per-point msgs
+/// \param[in] _msg Packed points, see MarkerManager's bulk service
+/// \param[out] _update Decoded update
+/// \return False if the msg is malformed
+bool decodeBulkMsg(const msgs::PointCloudPacked &_msg, BulkUpdate &_update)
+{
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.value_size() == 0)
+      continue;
+
+    const std::string &value = data.value(0);
+    std::stringstream ss(value);
+    if (data.key() == "ns")
+    {
+      _update.ns = value;
+    }
+    else if (data.key() == "id")
+    {
+      ss >> _update.id;
+    }
+    else if (data.key() == "size")
+    {
+      double size;
+      if (ss >> size)
+        _update.size = size;
+    }
+    else if (data.key() == "offset")
+    {
+      double offset{-1};
+      ss >> offset;
+      if (offset < 0)
+      {
+        gzerr << "Invalid bulk marker offset [" << value << "]" << std::endl;
+        return false;
+      }
+      _update.offset = static_cast<std::size_t>(offset);
+    }
+    else if (data.key() == "type")
+    {
+      if (value == "points")
+        _update.type = rendering::MarkerType::MT_POINTS;
+      else if (value == "line_list")
+        _update.type = rendering::MarkerType::MT_LINE_LIST;
+      else if (value == "line_strip")
+        _update.type = rendering::MarkerType::MT_LINE_STRIP;
+      else if (value == "triangle_list")
+        _update.type = rendering::MarkerType::MT_TRIANGLE_LIST;
+      else
+      {
+        gzerr << "Unsupported bulk marker type [" << value << "]"
+               << std::endl;
+        return false;
+      }
+    }
+  }
+
+  if (_update.id == 0)
+  {
+    gzerr << "Bulk marker msgs need a non-zero id" << std::endl;
+    return false;
+  }
+
+  if (_msg.is_bigendian())
+  {
+    gzerr << "Big endian bulk marker msgs aren't supported" << std::endl;
+    return false;
+  }
+
+  // Byte offset of each field within a point, -1 if missing
+  int fieldOffsets[4]{-1, -1, -1, -1};
+  const char *fieldNames[4]{"x", "y", "z", "rgba"};
+  const msgs::PointCloudPacked::Field::DataType fieldTypes[4]{
+      msgs::PointCloudPacked::Field::FLOAT32,
+      msgs::PointCloudPacked::Field::FLOAT32,
+      msgs::PointCloudPacked::Field::FLOAT32,
+      msgs::PointCloudPacked::Field::UINT32};
+  for (const auto &field : _msg.field())
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      if (field.name() != fieldNames[i])
+        continue;
+
+      if (field.datatype() != fieldTypes[i] ||
+          field.offset() + 4 > _msg.point_step())
+      {
+        gzerr << "Invalid bulk marker field [" << field.name() << "]"
+               << std::endl;
+        return false;
+      }
+      fieldOffsets[i] = static_cast<int>(field.offset());
+    }
+  }
+
+  if (fieldOffsets[0] < 0 || fieldOffsets[1] < 0 || fieldOffsets[2] < 0)
+  {
+    gzerr << "Bulk marker msgs need float32 x, y and z fields" << std::endl;
+    return false;
+  }
+
+  const std::size_t width = _msg.width();
+  const std::size_t height = _msg.height();
+  const std::size_t pointStep = _msg.point_step();
+  const std::size_t rowStep =
+      _msg.row_step() != 0 ? _msg.row_step() : width * pointStep;
+  const std::string &data = _msg.data();
+  if (width * height > 0 &&
+      ((height - 1) * rowStep + width * pointStep > data.size() ||
+       width * pointStep > rowStep))
+  {
+    gzerr << "Bulk marker msg data is smaller than its "
+           << width << "x" << height << " points" << std::endl;
+    return false;
+  }
+
+  _update.points.reserve(width * height);
+  _update.colors.reserve(width * height);
+  for (std::size_t row = 0; row < height; ++row)
+  {
+    const char *point = data.data() + row * rowStep;
+    for (std::size_t col = 0; col < width; ++col, point += pointStep)
+    {
+      float xyz[3];
+      for (int i = 0; i < 3; ++i)
+        std::memcpy(&xyz[i], point + fieldOffsets[i], sizeof(float));
+      _update.points.emplace_back(xyz[0], xyz[1], xyz[2]);
+
+      math::Color color = math::Color::White;
+      if (fieldOffsets[3] >= 0)
+      {
+        math::Color::RGBA rgba;
+        std::memcpy(&rgba, point + fieldOffsets[3], sizeof(rgba));
+        color.SetFromRGBA(rgba);
+      }
+      _update.colors.push_back(color);
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Most points held by each geometry of a marker. Larger markers,
+/// such as growing maps, are split so an update only uploads the chunks it
+/// touches. Line strips can't be split.
+/// \param[in] _type Render type
+/// \return Points per chunk, a multiple of 2 and 3 so no line or triangle
+/// straddles two chunks
+std::size_t markerChunkSize(rendering::MarkerType _type)
+{
+  if (_type == rendering::MarkerType::MT_LINE_STRIP)
+    return std::numeric_limits<std::size_t>::max();
+  return 65532;
+}
+}  // namespace
+
+class InProcessSink;
+
 /// \brief Private data class for MarkerManager
 class MarkerManager::Implementation
 {
+  /// \brief Destructor, detaches the sink
+  public: ~Implementation();
+
   /// \brief Update markers based on msgs received
-  public: void OnRender();
+  /// \param[in] _deadline Time after which no more msgs are processed
+  /// \return True if msgs are left for the next frames
+  public: bool OnRender(std::chrono::steady_clock::time_point _deadline);
 
   /// \brief Initialize services and subcriptions
   public: void Initialize();
@@ -65,15 +563,52 @@ class MarkerManager::Implementation
   /// \return True if the marker was processed successfully.
   public: bool ProcessMarkerMsg(const gz::msgs::Marker &_msg);
 
+  /// \brief Processes a bulk update.
+  /// \param[in] _update The update, its points are moved out.
+  /// \return True if the update was applied.
+  public: bool ProcessBulkUpdate(BulkUpdate &_update);
+
   /// \brief Services callback that returns a list of markers.
   /// \param[out] _rep Service reply
   /// \return True on success.
   public: bool OnList(gz::msgs::Marker_V &_rep);
 
+  /// \brief Services callback that returns some of the markers, or their
+  /// count per namespace.
+  /// \param[in] _req Query, in the header data
+  /// \param[out] _rep Service reply
+  /// \return False if the query is malformed.
+  public: bool OnListQuery(const gz::msgs::Header &_req,
+      gz::msgs::Marker_V &_rep);
+
+  /// \brief Copy the markers to list, holding `mutex` only for the copy.
+  /// \param[in] _query Namespaces to copy, and whether ids are needed
+  /// \return Copied markers, unsorted
+  public: std::vector<ListedNamespace> CopyListed(const ListQuery &_query);
+
   /// \brief Callback that receives marker messages.
   /// \param[in] _req The marker message.
   public: void OnMarkerMsg(const gz::msgs::Marker &_req);
 
+  /// \brief Queue a marker message, combining it with a queued modification
+  /// of the same marker if possible. Must be called with `mutex` locked.
+  /// \param[in] _msg The marker message, moved into the queue.
+  /// \param[in] _tag Latency trace tag of the message, if any
+  public: void Enqueue(gz::msgs::Marker _msg,
+      const LatencyTrace::Tag &_tag);
+
+  /// \brief Queue a bulk update, superseding a queued update replacing all
+  /// points of the same marker if possible. Must be called with `mutex`
+  /// locked.
+  /// \param[in] _update The update, moved into the queue.
+  /// \param[in] _tags Latency trace tags of the update, if any
+  public: void EnqueueBulk(BulkUpdate &&_update,
+      std::vector<LatencyTrace::Tag> &&_tags);
+
+  /// \brief Callback that receives packed points for the bulk service.
+  /// \param[in] _req The packed points.
+  public: void OnBulkMsg(const gz::msgs::PointCloudPacked &_req);
+
   /// \brief Callback that receives multiple marker messages.
   /// \param[in] _req The vector of marker messages
   /// \param[in] _res Response data
@@ -90,11 +625,78 @@ class MarkerManager::Implementation
   public: void SetVisual(const gz::msgs::Marker &_msg,
                          const rendering::VisualPtr &_visualPtr);
 
-  /// \brief Sets Marker from marker message.
+  /// \brief Sets Marker from marker message, only updating the values
+  /// which differ from the ones last applied.
   /// \param[in] _msg The message data.
-  /// \param[out] _markerPtr The message pointer to set.
+  /// \param[in] _type Render type, see MsgToType
+  /// \param[in,out] _state The marker to set, and what was applied to it.
   public: void SetMarker(const gz::msgs::Marker &_msg,
-                         const rendering::MarkerPtr &_markerPtr);
+                         rendering::MarkerType _type,
+                         MarkerState &_state);
+
+  /// \brief Overwrite and append points of a marker. Points can be moved in
+  /// place, but not recolored or removed, so only the chunks which lose
+  /// points or change color are rebuilt, and others get their changed
+  /// points moved and new ones appended. The cost is proportional to the
+  /// points given, not to the size of the marker.
+  /// \param[in,out] _state Marker
+  /// \param[in] _offset Index of the first point to overwrite, at most the
+  /// current number of points
+  /// \param[in] _points New points
+  /// \param[in] _colors Color of each point in `_points`
+  /// \param[in] _truncate Whether points past the new ones are removed
+  public: void UpdatePoints(MarkerState &_state, std::size_t _offset,
+                            std::vector<math::Vector3d> &&_points,
+                            std::vector<math::Color> &&_colors,
+                            bool _truncate);
+
+  /// \brief Get the geometry holding a chunk of points of a marker,
+  /// creating it if it's the one past the last
+  /// \param[in,out] _state Marker
+  /// \param[in] _index Chunk index
+  /// \return The geometry
+  public: rendering::MarkerPtr Chunk(MarkerState &_state,
+                                     std::size_t _index);
+
+  /// \brief Set the render type of a marker, laying out its points in
+  /// chunks again if they're split differently for the new type
+  /// \param[in,out] _state Marker
+  /// \param[in] _type New render type
+  public: void SetType(MarkerState &_state, rendering::MarkerType _type);
+
+  /// \brief Show the text of TEXT markers with the scene's labels, which
+  /// are drawn in one batch, and remove it from other markers
+  /// \param[in] _msg The message data.
+  /// \param[in] _type Render type, see MsgToType
+  /// \param[in,out] _state The marker
+  public: void SetLabel(const gz::msgs::Marker &_msg,
+                        rendering::MarkerType _type,
+                        MarkerState &_state);
+
+  /// \brief Remove the label of a marker, if it has one
+  /// \param[in,out] _state The marker
+  public: void RemoveLabel(MarkerState &_state);
+
+  /// \brief Remember when a marker expires, if it has a lifetime
+  /// \param[in] _ns Marker namespace id
+  /// \param[in] _id Marker id
+  /// \param[in] _state Marker
+  public: void AddExpiry(uint32_t _ns, uint64_t _id,
+      const MarkerState &_state);
+
+  /// \brief Get the id of a namespace, interning it the first time.
+  /// Ids stay valid for the lifetime of the plugin, so they can be compared
+  /// instead of the namespace strings.
+  /// \param[in] _ns Namespace, empty for the global namespace
+  /// \return Index in `namespaces`
+  public: uint32_t NamespaceId(const std::string &_ns);
+
+  /// \brief Destroy all the markers of a namespace at once
+  /// \param[in] _ns Namespace id
+  public: void ClearNamespace(uint32_t _ns);
+
+  /// \brief Destroy all markers which expired
+  public: void ExpireMarkers();
 
   /// \brief Converts a Gazebo msg material to Gazebo Rendering
   //         material.
@@ -109,177 +711,842 @@ class MarkerManager::Implementation
   public: gz::rendering::MarkerType MsgToType(
                     const gz::msgs::Marker &_msg);
 
-  //// \brief Pointer to the rendering scene
-  public: rendering::ScenePtr scene{nullptr};
+  //// \brief Pointer to the rendering scene
+  public: rendering::ScenePtr scene{nullptr};
+
+  /// \brief Mutex to protect message list.
+  public: std::mutex mutex;
+
+  /// \brief List of marker messages and bulk updates to process.
+  public: std::deque<QueuedMsg> markerMsgs;
+
+  /// \brief Latency trace tags of the msgs combined into each entry of
+  /// `markerMsgs`, when tracing
+  public: std::deque<std::vector<LatencyTrace::Tag>> markerTags;
+
+  /// \brief Sequence number of the message at the front of `markerMsgs`
+  public: uint64_t frontSeq{0};
+
+  /// \brief Sequence number of the queued ADD_MODIFY msg of each marker,
+  /// keyed by namespace and id. Cleared by deletions, so modifications are
+  /// never moved across them.
+  public: std::unordered_map<MarkerKey, uint64_t, MarkerKeyHash>
+      queuedModifies;
+
+  /// \brief Sequence number of the queued bulk update replacing all points
+  /// of each marker. Cleared by any other msg for the same marker.
+  public: std::unordered_map<MarkerKey, uint64_t, MarkerKeyHash> queuedBulk;
+
+  /// \brief Maximum number of msgs processed per frame, 0 for no limit
+  public: std::size_t maxMsgsPerFrame{0};
+
+  /// \brief Last backlog reported
+  public: std::size_t reportedBacklog{0};
+
+  /// \brief Called from the render thread with the number of msgs left
+  /// waiting for the next frame
+  public: std::function<void(std::size_t)> backlogCb;
+
+  /// \brief Backlog shown on the GUI. Only accessed from the main thread.
+  public: int backlog{0};
+
+  /// \brief Namespace name to namespace id
+  public: std::unordered_map<std::string, uint32_t> namespaceIds;
+
+  /// \brief Markers, indexed by namespace id. Namespaces are never removed,
+  /// an empty one is the same as one which doesn't exist.
+  public: std::vector<Namespace> namespaces;
+
+  /// \brief Number of markers in all namespaces
+  public: std::size_t markerCount{0};
+
+  /// \brief Markers with a lifetime, earliest expiry first. Entries are not
+  /// removed when markers are modified or deleted, instead they're skipped
+  /// when popped if they don't match the marker's current lifetime.
+  public: std::priority_queue<Expiry, std::vector<Expiry>,
+      std::greater<Expiry>> expiries;
+
+  /// \brief Size of `expiries` at which stale entries are dropped
+  public: std::size_t compactExpiriesAt{1024};
+
+  /// \brief Plugin the services are advertised for
+  public: const void *owner{nullptr};
+
+  /// \brief Subscription to the world statistics
+  public: HubSubscription statsSubscription;
+
+  /// \brief Topic name for the marker service
+  public: std::string topicName = "/marker";
+
+  /// \brief Sim time according to world stats message
+  public: std::chrono::steady_clock::duration simTime;
+
+  /// \brief Previous sim time received
+  public: std::chrono::steady_clock::duration lastSimTime;
+
+  /// \brief The last marker message received
+  public: gz::msgs::Marker msg;
+
+  /// \brief True to print console warnings if the user tries to perform an
+  /// action with an inexistent marker.
+  public: bool warnOnActionFailure{true};
+
+  /// \brief Time each frame may spend processing marker msgs
+  public: std::chrono::steady_clock::duration frameBudget{
+      std::chrono::milliseconds(4)};
+
+  /// \brief Queues markers from plugins in the same process, shared
+  /// through SceneServices
+  public: std::shared_ptr<InProcessSink> sink;
+
+  /// \brief Reports the points uploaded, and takes them from the scene's
+  /// upload budget
+  public: GpuUploadQueue uploads{"MarkerManager"};
+
+  /// \brief Keeps the frame task registered. Last member so it's
+  /// destroyed first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
+};
+
+/////////////////////////////////////////////////
+/// \brief MarkerSink queueing straight into a MarkerManager. It may outlive
+/// the plugin, in which case it's detached and refuses everything.
+class InProcessSink : public MarkerSink
+{
+  /// \brief Constructor
+  /// \param[in] _impl Marker manager to queue into
+  public: explicit InProcessSink(MarkerManager::Implementation *_impl)
+    : impl(_impl)
+  {
+  }
+
+  // Documentation inherited
+  public: bool Submit(msgs::Marker &&_msg) override;
+
+  // Documentation inherited
+  public: bool Submit(std::vector<msgs::Marker> &&_msgs) override;
+
+  // Documentation inherited
+  public: bool SetPoints(MarkerPoints &&_points) override;
+
+  /// \brief Stop queueing into the marker manager, once it's destroyed
+  public: void Detach();
+
+  /// \brief Protects `impl`. Locked before the marker manager's mutex.
+  private: std::mutex mutex;
+
+  /// \brief Marker manager, null once detached
+  private: MarkerManager::Implementation *impl;
+};
+
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::Initialize()
+{
+  if (!this->scene)
+  {
+    gzerr << "Scene pointer is invalid" << std::endl;
+    return;
+  }
+
+  if (this->topicName.empty())
+  {
+    gzerr << "Unable to advertise marker service. Topic name empty."
+           << std::endl;
+    return;
+  }
+
+  // Advertise the list service
+  auto *nodes = App()->Nodes();
+  if (!nodes->AdvertiseService(this->owner, this->topicName + "/list",
+      &Implementation::OnList, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "/list service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "/list service.\n";
+
+  // Advertise the list query service
+  if (!nodes->AdvertiseService(this->owner, this->topicName + "/list/query",
+      &Implementation::OnListQuery, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "/list/query service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "/list/query service.\n";
+
+  // Advertise to the marker service
+  if (!nodes->AdvertiseService(this->owner, this->topicName,
+        &Implementation::OnMarkerMsg, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << " service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "/list.\n";
+
+  // Advertise to the marker_array service
+  if (!nodes->AdvertiseService(this->owner, this->topicName + "_array",
+        &Implementation::OnMarkerMsgArray, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "_array service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "_array.\n";
+
+  // Advertise the bulk service
+  if (!nodes->AdvertiseService(this->owner, this->topicName + "/bulk",
+        &Implementation::OnBulkMsg, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "/bulk service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "/bulk.\n";
+}
+
+/////////////////////////////////////////////////
+bool MarkerManager::Implementation::OnRender(
+    std::chrono::steady_clock::time_point _deadline)
+{
+  GZ_GUI_PROFILE("MarkerManager::OnRender");
+  if (!this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return false;
+
+    this->Initialize();
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  // Process the marker messages in order, up to the time and GPU upload
+  // budgets for this frame. At least one is processed per frame.
+  std::size_t count{0};
+  while (!this->markerMsgs.empty() &&
+      (0 == this->maxMsgsPerFrame || count < this->maxMsgsPerFrame) &&
+      (0 == count || (std::chrono::steady_clock::now() < _deadline &&
+       GpuUploads::BudgetLeft() > 0)))
+  {
+    auto &front = this->markerMsgs.front();
+    if (auto *markerMsg = std::get_if<gz::msgs::Marker>(&front))
+    {
+      this->ProcessMarkerMsg(*markerMsg);
+      this->uploads.Uploaded(markerMsg->point_size() * kBytesPerPoint);
+    }
+    else
+    {
+      // Points are moved out of the update
+      auto &bulk = std::get<BulkUpdate>(front);
+      const std::size_t bytes = bulk.points.size() * kBytesPerPoint;
+      this->ProcessBulkUpdate(bulk);
+      this->uploads.Uploaded(bytes);
+    }
+    for (const auto &tag : this->markerTags.front())
+      App()->Latency()->Hold(tag, "scene");
+    this->markerMsgs.pop_front();
+    this->markerTags.pop_front();
+    this->frontSeq++;
+    count++;
+  }
+
+  if (this->markerMsgs.empty())
+  {
+    this->queuedModifies.clear();
+    this->queuedBulk.clear();
+  }
+
+  if (this->markerMsgs.size() != this->reportedBacklog)
+  {
+    this->reportedBacklog = this->markerMsgs.size();
+    if (this->backlogCb)
+      this->backlogCb(this->reportedBacklog);
+  }
+
+  this->ExpireMarkers();
+  this->lastSimTime = this->simTime;
+  return !this->markerMsgs.empty();
+}
+
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::AddExpiry(uint32_t _ns,
+    uint64_t _id, const MarkerState &_state)
+{
+  const auto lifetime = _state.marker->Lifetime();
+  if (lifetime.count() == 0)
+    return;
+
+  // Stale entries pile up when markers are modified or deleted before
+  // expiring, rebuild the heap with the live ones only once in a while
+  if (this->expiries.size() >= this->compactExpiriesAt)
+  {
+    std::vector<Expiry> live;
+    for (uint32_t ns = 0; ns < this->namespaces.size(); ++ns)
+    {
+      for (const auto &[id, state] : this->namespaces[ns].markers)
+      {
+        if (state.marker && state.marker->Lifetime().count() != 0)
+          live.push_back({state.marker->Lifetime(), ns, id});
+      }
+    }
+    this->compactExpiriesAt = 2 * live.size() + 1024;
+    this->expiries = decltype(this->expiries)(std::greater<Expiry>(),
+        std::move(live));
+  }
+
+  this->expiries.push({lifetime, _ns, _id});
+}
+
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::ExpireMarkers()
+{
+  // If sim time went back, e.g. on reset, all markers with a lifetime expire
+  const bool reset = this->simTime < this->lastSimTime;
+
+  while (!this->expiries.empty() &&
+      (reset || this->expiries.top().time <= this->simTime))
+  {
+    const Expiry expiry = this->expiries.top();
+    this->expiries.pop();
+
+    auto &markers = this->namespaces[expiry.ns].markers;
+    auto it = markers.find(expiry.id);
+    if (it == markers.end())
+      continue;
+
+    // Skip stale entries, the marker was modified since
+    const auto &markerPtr = it->second.marker;
+    if (nullptr == markerPtr || markerPtr->Lifetime().count() == 0 ||
+        markerPtr->Lifetime() != expiry.time)
+    {
+      continue;
+    }
+
+    this->RemoveLabel(it->second);
+    this->scene->DestroyVisual(it->second.visual);
+    markers.erase(it);
+    this->markerCount--;
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::SetLabel(const gz::msgs::Marker &_msg,
+    rendering::MarkerType _type, MarkerState &_state)
+{
+  if (_type != rendering::MarkerType::MT_TEXT)
+  {
+    this->RemoveLabel(_state);
+    return;
+  }
+
+  auto labels = SceneServices::Get<SceneLabels>(SceneServices::kLabels);
+  if (nullptr == labels)
+    return;
+
+  if (!_state.label)
+    _state.label.emplace();
+  if (!_msg.text().empty())
+    _state.label->text = _msg.text();
+  if (_msg.has_material() && _msg.material().has_diffuse())
+    _state.label->color = msgs::Convert(_msg.material().diffuse());
+  _state.label->visualId = _state.visual->Id();
+  labels->Set(this, _state.visual->Id(), *_state.label);
+}
+
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::RemoveLabel(MarkerState &_state)
+{
+  if (!_state.label)
+    return;
+
+  if (auto labels = SceneServices::Get<SceneLabels>(SceneServices::kLabels))
+    labels->Remove(this, _state.visual->Id());
+  _state.label.reset();
+}
+
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::UpdatePoints(MarkerState &_state,
+    std::size_t _offset, std::vector<math::Vector3d> &&_points,
+    std::vector<math::Color> &&_colors, bool _truncate)
+{
+  const std::size_t oldCount = _state.points.size();
+  const std::size_t end = _offset + _points.size();
+  const std::size_t newCount = _truncate ? end : std::max(oldCount, end);
+  const std::size_t chunkSize = markerChunkSize(_state.type);
+
+  // Values once updated
+  auto point = [&](std::size_t _i) -> const math::Vector3d &
+  {
+    return _i >= _offset && _i < end ?
+        _points[_i - _offset] : _state.points[_i];
+  };
+  auto color = [&](std::size_t _i) -> const math::Color &
+  {
+    return _i >= _offset && _i < end ?
+        _colors[_i - _offset] : _state.colors[_i];
+  };
+
+  // Only the chunks holding the given points change, or lose points
+  for (std::size_t c = _offset / chunkSize; c * chunkSize < end; ++c)
+  {
+    const std::size_t begin = c * chunkSize;
+    const std::size_t chunkEnd =
+        begin + std::min(chunkSize, std::max(oldCount, end) - begin);
+    const std::size_t oldEnd = std::clamp(oldCount, begin, chunkEnd);
+    const std::size_t newEnd = std::min(newCount, chunkEnd);
+    const std::size_t first = std::max(begin, _offset);
+    const std::size_t last = std::min(oldEnd, end);
+
+    bool rebuild = newEnd < oldEnd;
+    for (std::size_t i = first; i < last && !rebuild; ++i)
+      rebuild = _colors[i - _offset] != _state.colors[i];
+
+    const rendering::MarkerPtr chunk = this->Chunk(_state, c);
+    if (rebuild)
+    {
+      chunk->ClearPoints();
+      for (std::size_t i = begin; i < newEnd; ++i)
+        chunk->AddPoint(point(i), color(i));
+      continue;
+    }
+
+    for (std::size_t i = first; i < last; ++i)
+    {
+      if (_points[i - _offset] != _state.points[i])
+      {
+        chunk->SetPoint(static_cast<unsigned int>(i - begin),
+            _points[i - _offset]);
+      }
+    }
+    for (std::size_t i = oldEnd; i < newEnd; ++i)
+      chunk->AddPoint(point(i), color(i));
+  }
+
+  // Truncated chunks past the new points
+  const std::size_t chunkCount =
+      newCount == 0 ? 1 : (newCount - 1) / chunkSize + 1;
+  while (_state.chunks.size() >= chunkCount)
+  {
+    _state.visual->RemoveGeometry(_state.chunks.back());
+    _state.chunks.back()->Destroy();
+    _state.chunks.pop_back();
+  }
+  if (newCount == 0 && oldCount > 0)
+    _state.marker->ClearPoints();
+
+  if (_offset == 0 && _truncate)
+  {
+    _state.points = std::move(_points);
+    _state.colors = std::move(_colors);
+    return;
+  }
+
+  // Vectors grow geometrically, so appending is amortized O(delta)
+  _state.points.resize(newCount);
+  _state.colors.resize(newCount);
+  std::move(_points.begin(), _points.end(), _state.points.begin() + _offset);
+  std::move(_colors.begin(), _colors.end(), _state.colors.begin() + _offset);
+}
 
-  /// \brief Mutex to protect message list.
-  public: std::mutex mutex;
+/////////////////////////////////////////////////
+rendering::MarkerPtr MarkerManager::Implementation::Chunk(
+    MarkerState &_state, std::size_t _index)
+{
+  if (_index == 0)
+    return _state.marker;
+  if (_index <= _state.chunks.size())
+    return _state.chunks[_index - 1];
+
+  rendering::MarkerPtr chunk = this->scene->CreateMarker();
+  chunk->SetType(_state.type);
+  chunk->SetLayer(_state.marker->Layer());
+  if (_state.size)
+    chunk->SetSize(*_state.size);
+  if (auto material = _state.marker->Material())
+    chunk->SetMaterial(material, true /* clone */);
+  _state.visual->AddGeometry(chunk);
+  _state.chunks.push_back(chunk);
+  return chunk;
+}
 
-  /// \brief List of marker message to process.
-  public: std::list<gz::msgs::Marker> markerMsgs;
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::SetType(MarkerState &_state,
+    rendering::MarkerType _type)
+{
+  if (_state.chunks.empty() && _state.points.size() <= markerChunkSize(_type))
+  {
+    _state.marker->SetType(_type);
+    _state.type = _type;
+    return;
+  }
 
-  /// \brief Map of visuals
-  public: std::map<std::string,
-      std::map<uint64_t, gz::rendering::VisualPtr>> visuals;
+  // Split the points for the new type
+  auto points = std::move(_state.points);
+  auto colors = std::move(_state.colors);
+  _state.points.clear();
+  _state.colors.clear();
+  for (const auto &chunk : _state.chunks)
+  {
+    _state.visual->RemoveGeometry(chunk);
+    chunk->Destroy();
+  }
+  _state.chunks.clear();
+  _state.marker->ClearPoints();
+  _state.marker->SetType(_type);
+  _state.type = _type;
+  this->UpdatePoints(_state, 0, std::move(points), std::move(colors), true);
+}
 
-  /// \brief Gazebo node
-  public: gz::transport::Node node {gz::transport::NodeOptions()};
+/////////////////////////////////////////////////
+uint32_t MarkerManager::Implementation::NamespaceId(const std::string &_ns)
+{
+  auto [it, inserted] = this->namespaceIds.try_emplace(_ns,
+      static_cast<uint32_t>(this->namespaces.size()));
+  if (inserted)
+  {
+    this->namespaces.emplace_back();
+    this->namespaces.back().name = _ns;
+  }
+  return it->second;
+}
 
-  /// \brief Topic name for the marker service
-  public: std::string topicName = "/marker";
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::ClearNamespace(uint32_t _ns)
+{
+  auto &markers = this->namespaces[_ns].markers;
+  for (auto &it : markers)
+  {
+    this->RemoveLabel(it.second);
+    this->scene->DestroyVisual(it.second.visual);
+  }
+  this->markerCount -= markers.size();
 
-  /// \brief Sim time according to world stats message
-  public: std::chrono::steady_clock::duration simTime;
+  // Swap instead of clear to give back the buckets, which clear keeps
+  std::unordered_map<uint64_t, MarkerState>().swap(markers);
+}
 
-  /// \brief Previous sim time received
-  public: std::chrono::steady_clock::duration lastSimTime;
+/////////////////////////////////////////////////
+bool MarkerManager::Implementation::OnList(gz::msgs::Marker_V &_rep)
+{
+  _rep.Clear();
+  auto listed = this->CopyListed(ListQuery());
+  fillListReply(listed, ListQuery(), _rep);
+  return true;
+}
 
-  /// \brief The last marker message received
-  public: gz::msgs::Marker msg;
+/////////////////////////////////////////////////
+bool MarkerManager::Implementation::OnListQuery(const gz::msgs::Header &_req,
+    gz::msgs::Marker_V &_rep)
+{
+  _rep.Clear();
+  ListQuery query;
+  if (!parseListQuery(_req, query))
+    return false;
 
-  /// \brief True to print console warnings if the user tries to perform an
-  /// action with an inexistent marker.
-  public: bool warnOnActionFailure{true};
-};
+  auto listed = this->CopyListed(query);
+  fillListReply(listed, query, _rep);
+  return true;
+}
 
 /////////////////////////////////////////////////
-void MarkerManager::Implementation::Initialize()
+std::vector<ListedNamespace> MarkerManager::Implementation::CopyListed(
+    const ListQuery &_query)
 {
-  if (!this->scene)
+  GZ_GUI_PROFILE("MarkerManager::CopyListed");
+  std::vector<ListedNamespace> listed;
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  auto copy = [&](const Namespace &_ns)
   {
-    gzerr << "Scene pointer is invalid" << std::endl;
-    return;
-  }
+    if (_ns.markers.empty())
+      return;
+    ListedNamespace ns;
+    ns.name = _ns.name;
+    ns.count = _ns.markers.size();
+    if (!_query.summary)
+    {
+      ns.ids.reserve(ns.count);
+      for (const auto &iter : _ns.markers)
+        ns.ids.push_back(iter.first);
+    }
+    listed.push_back(std::move(ns));
+  };
 
-  if (this->topicName.empty())
+  if (_query.namespaces.empty())
   {
-    gzerr << "Unable to advertise marker service. Topic name empty."
-           << std::endl;
-    return;
+    for (const auto &ns : this->namespaces)
+      copy(ns);
+    return listed;
   }
 
-  // Advertise the list service
-  if (!this->node.Advertise(this->topicName + "/list",
-      &Implementation::OnList, this))
+  // Namespace names are interned, so filtering doesn't visit the others
+  for (const auto &name : _query.namespaces)
   {
-    gzerr << "Unable to advertise to the " << this->topicName
-           << "/list service.\n";
+    auto it = this->namespaceIds.find(name);
+    if (it != this->namespaceIds.end())
+      copy(this->namespaces[it->second]);
   }
+  return listed;
+}
 
-  gzdbg << "Advertise " << this->topicName << "/list service.\n";
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::OnMarkerMsg(const gz::msgs::Marker &_req)
+{
+  const auto tag = App()->Latency()->Begin("markers",
+      headerStamp(_req.header()));
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->Enqueue(_req, tag);
+  RenderHooks::RequestRender();
+}
 
-  // Advertise to the marker service
-  if (!this->node.Advertise(this->topicName,
-        &Implementation::OnMarkerMsg, this))
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::Enqueue(gz::msgs::Marker _msg,
+    const LatencyTrace::Tag &_tag)
+{
+  const uint64_t seq = this->frontSeq + this->markerMsgs.size();
+  std::vector<LatencyTrace::Tag> tags;
+  if (_tag.Valid())
+    tags.push_back(_tag);
+
+  if (_msg.action() == gz::msgs::Marker::ADD_MODIFY)
   {
-    gzerr << "Unable to advertise to the " << this->topicName
-           << " service.\n";
+    // Markers without an id get a new random one, so they're never combined
+    if (_msg.id() == 0)
+    {
+      this->markerMsgs.push_back(std::move(_msg));
+      this->markerTags.push_back(std::move(tags));
+      return;
+    }
+
+    const MarkerKey key{this->NamespaceId(_msg.ns()), _msg.id()};
+    this->queuedBulk.erase(key);
+    auto it = this->queuedModifies.find(key);
+    if (it != this->queuedModifies.end() && it->second >= this->frontSeq)
+    {
+      // Still queued, replace it with the combination of both
+      auto &queued = std::get<gz::msgs::Marker>(
+          this->markerMsgs[it->second - this->frontSeq]);
+      mergeMarkerMsg(queued, _msg);
+      queued = std::move(_msg);
+
+      // Both msgs are shown once the combination is applied
+      auto &queuedTags = this->markerTags[it->second - this->frontSeq];
+      queuedTags.insert(queuedTags.end(), tags.begin(), tags.end());
+      return;
+    }
+
+    this->queuedModifies[key] = seq;
+  }
+  else if (_msg.action() == gz::msgs::Marker::DELETE_MARKER)
+  {
+    const MarkerKey key{this->NamespaceId(_msg.ns()), _msg.id()};
+    this->queuedModifies.erase(key);
+    this->queuedBulk.erase(key);
+  }
+  else
+  {
+    this->queuedModifies.clear();
+    this->queuedBulk.clear();
   }
 
-  gzdbg << "Advertise " << this->topicName << "/list.\n";
+  this->markerMsgs.push_back(std::move(_msg));
+  this->markerTags.push_back(std::move(tags));
+}
 
-  // Advertise to the marker_array service
-  if (!this->node.Advertise(this->topicName + "_array",
-        &Implementation::OnMarkerMsgArray, this))
+/////////////////////////////////////////////////
+void MarkerManager::Implementation::OnBulkMsg(
+    const gz::msgs::PointCloudPacked &_req)
+{
+  const auto tag = App()->Latency()->Begin("marker bulk",
+      headerStamp(_req.header()));
+  std::vector<LatencyTrace::Tag> tags;
+  if (tag.Valid())
+    tags.push_back(tag);
+
+  // Decode before locking, so large buffers don't hold up the render thread
+  BulkUpdate update;
+  if (!decodeBulkMsg(_req, update))
   {
-    gzerr << "Unable to advertise to the " << this->topicName
-           << "_array service.\n";
+    App()->Latency()->Drop(tag);
+    return;
   }
 
-  gzdbg << "Advertise " << this->topicName << "_array.\n";
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->EnqueueBulk(std::move(update), std::move(tags));
+  }
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
-void MarkerManager::Implementation::OnRender()
+void MarkerManager::Implementation::EnqueueBulk(BulkUpdate &&_update,
+    std::vector<LatencyTrace::Tag> &&_tags)
 {
-  if (!this->scene)
+  const uint64_t seq = this->frontSeq + this->markerMsgs.size();
+  const MarkerKey key{this->NamespaceId(_update.ns), _update.id};
+
+  // Queued modifications can't be combined across this update anymore
+  this->queuedModifies.erase(key);
+
+  if (_update.offset)
   {
-    this->scene = rendering::sceneFromFirstRenderEngine();
-    if (nullptr == this->scene)
+    this->queuedBulk.erase(key);
+  }
+  else
+  {
+    // A queued update replacing all points is superseded by this one
+    auto it = this->queuedBulk.find(key);
+    if (it != this->queuedBulk.end() && it->second >= this->frontSeq)
+    {
+      auto &queued = std::get<BulkUpdate>(
+          this->markerMsgs[it->second - this->frontSeq]);
+      if (!_update.type)
+        _update.type = queued.type;
+      if (!_update.size)
+        _update.size = queued.size;
+      queued = std::move(_update);
+
+      // The superseded update is never shown
+      auto &queuedTags = this->markerTags[it->second - this->frontSeq];
+      for (const auto &queuedTag : queuedTags)
+        App()->Latency()->Drop(queuedTag);
+      queuedTags = std::move(_tags);
       return;
-
-    this->Initialize();
+    }
+    this->queuedBulk[key] = seq;
   }
 
+  this->markerMsgs.push_back(std::move(_update));
+  this->markerTags.push_back(std::move(_tags));
+}
+
+/////////////////////////////////////////////////
+bool InProcessSink::Submit(msgs::Marker &&_msg)
+{
   std::lock_guard<std::mutex> lock(this->mutex);
-  // Process the marker messages.
-  for (auto markerIter = this->markerMsgs.begin();
-       markerIter != this->markerMsgs.end();)
+  if (nullptr == this->impl)
+    return false;
+
+  const auto tag = App()->Latency()->Begin("markers",
+      headerStamp(_msg.header()));
   {
-    this->ProcessMarkerMsg(*markerIter);
-    this->markerMsgs.erase(markerIter++);
+    std::lock_guard<std::mutex> implLock(this->impl->mutex);
+    this->impl->Enqueue(std::move(_msg), tag);
   }
+  RenderHooks::RequestRender();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool InProcessSink::Submit(std::vector<msgs::Marker> &&_msgs)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (nullptr == this->impl)
+    return false;
+  if (_msgs.empty())
+    return true;
 
-  // Erase any markers that have a lifetime.
-  for (auto mit = this->visuals.begin();
-       mit != this->visuals.end();)
+  // Traced as one msg, like the array service
+  const auto tag = App()->Latency()->Begin("markers",
+      headerStamp(_msgs.back().header()));
   {
-    for (auto it = mit->second.cbegin();
-         it != mit->second.cend(); ++it)
+    std::lock_guard<std::mutex> implLock(this->impl->mutex);
+    for (std::size_t i = 0; i < _msgs.size(); ++i)
     {
-      if (it->second->GeometryCount() == 0u)
-        continue;
-
-      gz::rendering::MarkerPtr markerPtr =
-            std::dynamic_pointer_cast<gz::rendering::Marker>
-            (it->second->GeometryByIndex(0u));
-      if (markerPtr != nullptr)
-      {
-        if (markerPtr->Lifetime().count() != 0 &&
-            (markerPtr->Lifetime() <= this->simTime ||
-            this->simTime < this->lastSimTime))
-        {
-          this->scene->DestroyVisual(it->second);
-          it = mit->second.erase(it);
-          break;
-        }
-      }
+      this->impl->Enqueue(std::move(_msgs[i]),
+          i + 1 == _msgs.size() ? tag : LatencyTrace::Tag());
     }
-
-    // Erase a namespace if it's empty
-    if (mit->second.empty())
-      mit = this->visuals.erase(mit);
-    else
-      ++mit;
   }
-  this->lastSimTime = this->simTime;
+  _msgs.clear();
+  RenderHooks::RequestRender();
+  return true;
 }
 
 /////////////////////////////////////////////////
-bool MarkerManager::Implementation::OnList(gz::msgs::Marker_V &_rep)
+bool InProcessSink::SetPoints(MarkerPoints &&_points)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  _rep.clear_marker();
+  if (_points.id == 0)
+  {
+    gzerr << "Marker points need a non-zero id" << std::endl;
+    return false;
+  }
 
-  // Create the list of visuals
-  for (const auto &mIter : this->visuals)
+  std::optional<rendering::MarkerType> type;
+  if (_points.type)
   {
-    for (const auto &iter : mIter.second)
+    switch (*_points.type)
     {
-      gz::msgs::Marker *markerMsg = _rep.add_marker();
-      markerMsg->set_ns(mIter.first);
-      markerMsg->set_id(iter.first);
+      case msgs::Marker::POINTS:
+        type = rendering::MarkerType::MT_POINTS;
+        break;
+      case msgs::Marker::LINE_LIST:
+        type = rendering::MarkerType::MT_LINE_LIST;
+        break;
+      case msgs::Marker::LINE_STRIP:
+        type = rendering::MarkerType::MT_LINE_STRIP;
+        break;
+      case msgs::Marker::TRIANGLE_LIST:
+        type = rendering::MarkerType::MT_TRIANGLE_LIST;
+        break;
+      default:
+        gzerr << "Unsupported marker points type [" << *_points.type << "]"
+               << std::endl;
+        return false;
     }
   }
 
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (nullptr == this->impl)
+    return false;
+
+  BulkUpdate update;
+  update.ns = std::move(_points.ns);
+  update.id = _points.id;
+  update.type = type;
+  update.size = _points.size;
+  update.offset = _points.offset;
+  update.points = std::move(_points.points);
+  update.colors = std::move(_points.colors);
+  update.colors.resize(update.points.size(), math::Color::White);
+
+  std::vector<LatencyTrace::Tag> tags;
+  const auto tag = App()->Latency()->Begin("marker bulk", 0.0);
+  if (tag.Valid())
+    tags.push_back(tag);
+  {
+    std::lock_guard<std::mutex> implLock(this->impl->mutex);
+    this->impl->EnqueueBulk(std::move(update), std::move(tags));
+  }
+  RenderHooks::RequestRender();
   return true;
 }
 
 /////////////////////////////////////////////////
-void MarkerManager::Implementation::OnMarkerMsg(const gz::msgs::Marker &_req)
+void InProcessSink::Detach()
 {
   std::lock_guard<std::mutex> lock(this->mutex);
-  this->markerMsgs.push_back(_req);
+  this->impl = nullptr;
 }
 
 /////////////////////////////////////////////////
 bool MarkerManager::Implementation::OnMarkerMsgArray(
     const gz::msgs::Marker_V&_req, gz::msgs::Boolean &_res)
 {
+  // Traced as one msg, shown once its last marker is applied
+  const auto tag = App()->Latency()->Begin("markers",
+      headerStamp(_req.header()));
   std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_req.marker().begin(), _req.marker().end(),
-            std::back_inserter(this->markerMsgs));
+  for (int i = 0; i < _req.marker_size(); ++i)
+  {
+    this->Enqueue(_req.marker(i),
+        i + 1 == _req.marker_size() ? tag : LatencyTrace::Tag());
+  }
+  if (_req.marker_size() == 0)
+    App()->Latency()->Drop(tag);
   _res.set_data(true);
+  RenderHooks::RequestRender();
   return true;
 }
 
@@ -287,6 +1554,8 @@ bool MarkerManager::Implementation::OnMarkerMsgArray(
 bool MarkerManager::Implementation::ProcessMarkerMsg(
     const gz::msgs::Marker &_msg)
 {
+  GZ_GUI_PROFILE("MarkerManager::ProcessMarkerMsg");
+
   // Get the namespace, if it exists. Otherwise, use the global namespace
   std::string ns;
   if (!_msg.ns().empty())
@@ -295,7 +1564,8 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
   }
 
   // Get the namespace that the marker belongs to
-  auto nsIter = this->visuals.find(ns);
+  const uint32_t nsId = this->NamespaceId(ns);
+  auto &markers = this->namespaces[nsId].markers;
 
   // If an id is given
   size_t id;
@@ -308,44 +1578,42 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
   {
     id = gz::math::Rand::IntUniform(0, gz::math::MAX_I32);
 
-    // Make sure it's unique if namespace is given
-    if (nsIter != this->visuals.end())
-    {
-      while (nsIter->second.find(id) != nsIter->second.end())
-        id = gz::math::Rand::IntUniform(gz::math::MIN_UI32,
-                                        gz::math::MAX_UI32);
-    }
+    // Make sure it's unique in the namespace
+    while (markers.find(id) != markers.end())
+      id = gz::math::Rand::IntUniform(gz::math::MIN_UI32,
+                                      gz::math::MAX_UI32);
   }
 
   // Get visual for this namespace and id
-  std::map<uint64_t, rendering::VisualPtr>::iterator visualIter;
-  if (nsIter != this->visuals.end())
-    visualIter = nsIter->second.find(id);
+  auto visualIter = markers.find(id);
 
   // Add/modify a marker
   if (_msg.action() == gz::msgs::Marker::ADD_MODIFY)
   {
     // Modify an existing marker, identified by namespace and id
-    if (nsIter != this->visuals.end() &&
-        visualIter != nsIter->second.end())
+    if (visualIter != markers.end())
     {
-      if (visualIter->second->GeometryCount() > 0u)
+      // TODO(anyone): Update so that multiple markers can
+      //               be attached to one visual
+      auto &state = visualIter->second;
+      if (state.marker)
       {
-        // TODO(anyone): Update so that multiple markers can
-        //               be attached to one visual
-        gz::rendering::MarkerPtr markerPtr =
-              std::dynamic_pointer_cast<gz::rendering::Marker>
-              (visualIter->second->GeometryByIndex(0));
-
-        visualIter->second->RemoveGeometryByIndex(0);
-
         // Set the visual values from the Marker Message
-        this->SetVisual(_msg, visualIter->second);
+        this->SetVisual(_msg, state.visual);
+
+        // Changing the render type needs the geometry to be attached again,
+        // everything else is updated in place
+        const auto markerType = this->MsgToType(_msg);
+        const bool reattach = markerType != state.type;
+        if (reattach)
+          state.visual->RemoveGeometry(state.marker);
 
         // Set the marker values from the Marker Message
-        this->SetMarker(_msg, markerPtr);
+        this->SetMarker(_msg, markerType, state);
+        this->AddExpiry(nsId, id, state);
 
-        visualIter->second->AddGeometry(markerPtr);
+        if (reattach)
+          state.visual->AddGeometry(state.marker);
       }
     }
     // Otherwise create a new marker
@@ -359,16 +1627,18 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
       rendering::VisualPtr visualPtr = this->scene->CreateVisual(name);
 
       // Create and load the marker
-      rendering::MarkerPtr markerPtr = this->scene->CreateMarker();
+      MarkerState state;
+      state.visual = visualPtr;
+      state.marker = this->scene->CreateMarker();
 
       // Set the visual values from the Marker Message
       this->SetVisual(_msg, visualPtr);
 
       // Set the marker values from the Marker Message
-      this->SetMarker(_msg, markerPtr);
+      this->SetMarker(_msg, this->MsgToType(_msg), state);
 
       // Add populated marker to the visual
-      visualPtr->AddGeometry(markerPtr);
+      visualPtr->AddGeometry(state.marker);
 
       // Add visual to root visual
       if (!visualPtr->HasParent())
@@ -377,22 +1647,21 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
       }
 
       // Store the visual
-      this->visuals[ns][id] = visualPtr;
+      this->AddExpiry(nsId, id, state);
+      markers[id] = std::move(state);
+      this->markerCount++;
     }
   }
   // Remove a single marker
   else if (_msg.action() == gz::msgs::Marker::DELETE_MARKER)
   {
     // Remove the marker if it can be found.
-    if (nsIter != this->visuals.end() &&
-        visualIter != nsIter->second.end())
+    if (visualIter != markers.end())
     {
-      this->scene->DestroyVisual(visualIter->second);
-      this->visuals[ns].erase(visualIter);
-
-      // Remove namespace if empty
-      if (this->visuals[ns].empty())
-        this->visuals.erase(nsIter);
+      this->RemoveLabel(visualIter->second);
+      this->scene->DestroyVisual(visualIter->second.visual);
+      markers.erase(visualIter);
+      this->markerCount--;
     }
     else
     {
@@ -408,7 +1677,7 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
   else if (_msg.action() == gz::msgs::Marker::DELETE_ALL)
   {
     // If given namespace doesn't exist
-    if (!ns.empty() && nsIter == this->visuals.end())
+    if (!ns.empty() && markers.empty())
     {
       if (this->warnOnActionFailure)
       {
@@ -418,27 +1687,16 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
       return false;
     }
     // Remove all markers in the specified namespace
-    else if (nsIter != this->visuals.end())
+    else if (!markers.empty())
     {
-      for (const auto &it : nsIter->second)
-      {
-        this->scene->DestroyVisual(it.second);
-      }
-      nsIter->second.clear();
-      this->visuals.erase(nsIter);
+      this->ClearNamespace(nsId);
     }
     // Remove all markers in all namespaces.
     else
     {
-      for (nsIter = this->visuals.begin();
-           nsIter != this->visuals.end(); ++nsIter)
-      {
-        for (const auto &it : nsIter->second)
-        {
-          this->scene->DestroyVisual(it.second);
-        }
-      }
-      this->visuals.clear();
+      for (uint32_t i = 0; i < this->namespaces.size(); ++i)
+        this->ClearNamespace(i);
+      this->expiries = {};
     }
   }
   else
@@ -450,6 +1708,87 @@ bool MarkerManager::Implementation::ProcessMarkerMsg(
   return true;
 }
 
+/////////////////////////////////////////////////
+bool MarkerManager::Implementation::ProcessBulkUpdate(BulkUpdate &_update)
+{
+  const uint32_t nsId = this->NamespaceId(_update.ns);
+  auto &markers = this->namespaces[nsId].markers;
+
+  auto it = markers.find(_update.id);
+  if (it == markers.end())
+  {
+    if (_update.offset.value_or(0) > 0)
+    {
+      gzerr << "Can't update points of inexistent marker with id["
+             << _update.id << "] in namespace[" << _update.ns << "]"
+             << std::endl;
+      return false;
+    }
+
+    MarkerState state;
+    state.visual = this->scene->CreateVisual("__GZ_MARKER_VISUAL_" +
+        _update.ns + "_" + std::to_string(_update.id));
+    state.marker = this->scene->CreateMarker();
+
+    // Unlit, so points show their own color
+    rendering::MaterialPtr material = this->scene->CreateMaterial();
+    material->SetDiffuse(math::Color::White);
+    material->SetLightingEnabled(false);
+    state.marker->SetMaterial(material, true /* clone */);
+    this->scene->DestroyMaterial(material);
+
+    state.type = _update.type.value_or(rendering::MarkerType::MT_POINTS);
+    state.marker->SetType(state.type);
+    state.visual->AddGeometry(state.marker);
+    this->scene->RootVisual()->AddChild(state.visual);
+
+    it = markers.emplace(_update.id, std::move(state)).first;
+    this->markerCount++;
+  }
+
+  auto &state = it->second;
+  if (nullptr == state.marker)
+    return false;
+
+  if (_update.type && *_update.type != state.type)
+  {
+    this->RemoveLabel(state);
+    state.visual->RemoveGeometry(state.marker);
+    this->SetType(state, *_update.type);
+    state.visual->AddGeometry(state.marker);
+  }
+
+  if (_update.size && _update.size != state.size)
+  {
+    state.marker->SetSize(*_update.size);
+    for (const auto &chunk : state.chunks)
+      chunk->SetSize(*_update.size);
+    state.size = _update.size;
+  }
+
+  if (!_update.offset)
+  {
+    this->UpdatePoints(state, 0, std::move(_update.points),
+        std::move(_update.colors), true);
+    return true;
+  }
+
+  // Partial update, overwrite a range of the current points
+  const std::size_t offset = *_update.offset;
+  if (offset > state.points.size())
+  {
+    gzerr << "Bulk marker offset [" << offset << "] is past the ["
+           << state.points.size() << "] points of marker with id["
+           << _update.id << "] in namespace[" << _update.ns << "]"
+           << std::endl;
+    return false;
+  }
+
+  this->UpdatePoints(state, offset, std::move(_update.points),
+      std::move(_update.colors), false);
+  return true;
+}
+
 /////////////////////////////////////////////////
 void MarkerManager::Implementation::SetVisual(const gz::msgs::Marker &_msg,
                            const rendering::VisualPtr &_visualPtr)
@@ -477,8 +1816,9 @@ void MarkerManager::Implementation::SetVisual(const gz::msgs::Marker &_msg,
     _visualPtr->SetLocalPose(pose);
   }
 
-  // Set Visual Parent
-  if (!_msg.parent().empty())
+  // Set Visual Parent, unless it didn't change
+  if (!_msg.parent().empty() && !(_visualPtr->HasParent() &&
+      _visualPtr->Parent()->Name() == _msg.parent()))
   {
     if (_visualPtr->HasParent())
     {
@@ -502,9 +1842,13 @@ void MarkerManager::Implementation::SetVisual(const gz::msgs::Marker &_msg,
 
 /////////////////////////////////////////////////
 void MarkerManager::Implementation::SetMarker(const gz::msgs::Marker &_msg,
-                           const rendering::MarkerPtr &_markerPtr)
+                           rendering::MarkerType _type,
+                           MarkerState &_state)
 {
-  _markerPtr->SetLayer(_msg.layer());
+  const rendering::MarkerPtr &markerPtr = _state.marker;
+  markerPtr->SetLayer(_msg.layer());
+  for (const auto &chunk : _state.chunks)
+    chunk->SetLayer(_msg.layer());
 
   // Set Marker Lifetime
   std::chrono::steady_clock::duration lifetime =
@@ -513,51 +1857,69 @@ void MarkerManager::Implementation::SetMarker(const gz::msgs::Marker &_msg,
 
   if (lifetime.count() != 0)
   {
-    _markerPtr->SetLifetime(lifetime + this->simTime);
+    markerPtr->SetLifetime(lifetime + this->simTime);
   }
   else
   {
-    _markerPtr->SetLifetime(std::chrono::seconds(0));
+    markerPtr->SetLifetime(std::chrono::seconds(0));
   }
   // Set Marker Render Type
-  gz::rendering::MarkerType markerType = MsgToType(_msg);
-  _markerPtr->SetType(markerType);
+  if (_type != _state.type)
+    this->SetType(_state, _type);
 
-  // Set Marker Material
+  // Set Marker Material, if it changed
   if (_msg.has_material())
   {
-    rendering::MaterialPtr materialPtr = MsgToMaterial(_msg);
-    _markerPtr->SetMaterial(materialPtr, true /* clone */);
-
-    // clean up material after clone
-    this->scene->DestroyMaterial(materialPtr);
+    const std::size_t materialHash =
+        std::hash<std::string>()(_msg.material().SerializeAsString());
+    if (materialHash != _state.materialHash)
+    {
+      rendering::MaterialPtr materialPtr = MsgToMaterial(_msg);
+      markerPtr->SetMaterial(materialPtr, true /* clone */);
+      for (const auto &chunk : _state.chunks)
+        chunk->SetMaterial(materialPtr, true /* clone */);
+
+      // clean up material after clone
+      this->scene->DestroyMaterial(materialPtr);
+      _state.materialHash = materialHash;
+    }
   }
 
-  // Assume the presence of points means we clear old ones
+  // Assume the presence of points means we replace old ones
   if (_msg.point().size() > 0)
   {
-    _markerPtr->ClearPoints();
-  }
-
-  // Set Marker Points
-  for (int i = 0; i < _msg.point().size(); ++i)
-  {
-    math::Vector3d vector(
-        _msg.point(i).x(),
-        _msg.point(i).y(),
-        _msg.point(i).z());
-
-    math::Color color = msgs::Convert(_msg.material().diffuse());
-    if (i < _msg.materials().size())
+    std::vector<math::Vector3d> points;
+    std::vector<math::Color> colors;
+    points.reserve(_msg.point().size());
+    colors.reserve(_msg.point().size());
+    for (int i = 0; i < _msg.point().size(); ++i)
     {
-      color = msgs::Convert(_msg.materials(i).diffuse());
+      points.emplace_back(
+          _msg.point(i).x(),
+          _msg.point(i).y(),
+          _msg.point(i).z());
+
+      math::Color color = msgs::Convert(_msg.material().diffuse());
+      if (i < _msg.materials().size())
+      {
+        color = msgs::Convert(_msg.materials(i).diffuse());
+      }
+      colors.push_back(color);
     }
-    _markerPtr->AddPoint(vector, color);
+
+    this->UpdatePoints(_state, 0, std::move(points), std::move(colors),
+        true);
   }
-  if (_msg.has_scale())
+  if (_msg.has_scale() && _msg.scale().x() != _state.size)
   {
-    _markerPtr->SetSize(_msg.scale().x());
+    markerPtr->SetSize(_msg.scale().x());
+    for (const auto &chunk : _state.chunks)
+      chunk->SetSize(_msg.scale().x());
+    _state.size = _msg.scale().x();
   }
+
+  // Text isn't drawn as geometry, which most engines don't support
+  this->SetLabel(_msg, _type, _state);
 }
 
 /////////////////////////////////////////////////
@@ -643,6 +2005,7 @@ void MarkerManager::Implementation::OnWorldStatsMsg(
   const gz::msgs::WorldStatistics &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
+  const auto prevSimTime = this->simTime;
   std::chrono::steady_clock::duration timePoint;
   if (_msg.has_sim_time())
   {
@@ -658,16 +2021,55 @@ void MarkerManager::Implementation::OnWorldStatsMsg(
         _msg.real_time().nsec());
     this->simTime = timePoint;
   }
+
+  // Markers with a lifetime may expire
+  if (this->simTime != prevSimTime && this->markerCount > 0)
+    RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+int MarkerManager::Backlog() const
+{
+  return this->dataPtr->backlog;
+}
+
+/////////////////////////////////////////////////
+void MarkerManager::SetBacklog(int _backlog)
+{
+  this->dataPtr->backlog = _backlog;
+  emit this->BacklogChanged();
 }
 
 /////////////////////////////////////////////////
 MarkerManager::MarkerManager()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
+  this->dataPtr->owner = this;
+}
+
+/////////////////////////////////////////////////
+MarkerManager::~MarkerManager()
+{
+  // The callbacks use the private data
+  this->dataPtr->statsSubscription.Reset();
+  if (auto *app = App())
+    app->Nodes()->Release(this);
 }
 
 /////////////////////////////////////////////////
-MarkerManager::~MarkerManager() = default;
+MarkerManager::Implementation::~Implementation()
+{
+  if (auto labels = SceneServices::Get<SceneLabels>(SceneServices::kLabels))
+    labels->RemoveAll(this);
+
+  if (!this->sink)
+    return;
+
+  // Plugins may still hold the sink, it refuses everything from now on
+  this->sink->Detach();
+  if (SceneServices::Get<MarkerSink>(SceneServices::kMarkers) == this->sink)
+    SceneServices::Set<MarkerSink>(SceneServices::kMarkers, nullptr);
+}
 
 /////////////////////////////////////////////////
 void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
@@ -694,6 +2096,40 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
       }
     }
 
+    elem = _pluginElem->FirstChildElement("max_messages_per_frame");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      int maxMsgs{0};
+      if (elem->QueryIntText(&maxMsgs) != tinyxml2::XML_SUCCESS ||
+          maxMsgs < 0)
+      {
+        gzerr << "Failed to parse <max_messages_per_frame> value: "
+               << elem->GetText() << std::endl;
+      }
+      else
+      {
+        this->dataPtr->maxMsgsPerFrame = static_cast<std::size_t>(maxMsgs);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("frame_budget");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double budget{0.0};
+      if (elem->QueryDoubleText(&budget) != tinyxml2::XML_SUCCESS ||
+          budget < 0.0)
+      {
+        gzerr << "Failed to parse <frame_budget> value: "
+               << elem->GetText() << std::endl;
+      }
+      else
+      {
+        this->dataPtr->frameBudget = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budget));
+      }
+    }
+
     if ((elem = _pluginElem->FirstChildElement("warn_on_action_failure")))
     {
       if (elem->QueryBoolText(&this->dataPtr->warnOnActionFailure) !=
@@ -742,8 +2178,13 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
   if (!statsTopic.empty())
   {
     // Subscribe to world_stats
-    if (!this->dataPtr->node.Subscribe(statsTopic,
-        &Implementation::OnWorldStatsMsg, this->dataPtr.get()))
+    this->dataPtr->statsSubscription =
+        App()->Subscriptions()->Subscribe<msgs::WorldStatistics>(statsTopic,
+        [this](const msgs::WorldStatistics &_msg)
+        {
+          this->dataPtr->OnWorldStatsMsg(_msg);
+        });
+    if (!this->dataPtr->statsSubscription.Valid())
     {
       gzerr << "Failed to subscribe to [" << statsTopic << "]" << std::endl;
     }
@@ -763,18 +2204,25 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
   QQmlProperty::write(this->PluginItem(), "statsTopic",
       QString::fromStdString(statsTopic));
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
-}
-
-/////////////////////////////////////////////////
-bool MarkerManager::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
+  // Called from the render thread
+  this->dataPtr->backlogCb = [this](std::size_t _backlog)
   {
-    this->dataPtr->OnRender();
-  }
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+    QMetaObject::invokeMethod(this, "SetBacklog", Qt::QueuedConnection,
+        Q_ARG(int, static_cast<int>(_backlog)));
+  };
+
+  // Frame tasks run before the render callbacks, so they see up to date
+  // markers. Bursts of msgs are spread over several frames.
+  this->dataPtr->renderConnection = RenderHooks::OnFrameTask(
+      [this](std::chrono::steady_clock::time_point _deadline)
+      {
+        return this->dataPtr->OnRender(_deadline);
+      }, -10, this->dataPtr->frameBudget, "MarkerManager");
+
+  // Plugins in the same process queue markers directly, without msgs
+  this->dataPtr->sink = std::make_shared<InProcessSink>(this->dataPtr.get());
+  SceneServices::Set<MarkerSink>(SceneServices::kMarkers,
+      this->dataPtr->sink);
 }
 }  // namespace gz::gui::plugins
 
@@ -36,10 +36,85 @@ namespace gz::gui::plugins
   /// Defaults to `/world/[world name]/stats`.
   /// * `<warn_on_action_failure>`: True to display warnings if the user
   /// attempts to perform an invalid action. Defaults to true.
+  /// * `<max_messages_per_frame>`: Optional. Maximum number of marker
+  /// messages processed each frame, the rest wait for the following frames.
+  /// Queued modifications of the same marker are combined. Defaults to 0,
+  /// no limit.
+  /// * `<frame_budget>`: Optional. Milliseconds each frame may spend
+  /// processing marker messages, within MinimalScene's
+  /// `<frame_task_budget>`, see RenderHooks::OnFrameTask. The rest wait
+  /// for the following frames. At least one message is processed per
+  /// frame. Zero only limits it to the frame's budget. Defaults to 4.
+  /// Messages also wait once the points processed this frame used up
+  /// MinimalScene's `<gpu_upload_budget>`.
+  ///
+  /// TEXT markers are shown with the scene's labels, see SceneLabels, which
+  /// are all drawn in one batch and thinned out when crowded. Their text
+  /// follows the marker's pose, at its origin.
+  ///
+  /// ## Bulk service
+  ///
+  /// Large point, line and triangle markers can be sent to
+  /// `<topic_name>/bulk` as a `gz.msgs.PointCloudPacked`, which is decoded
+  /// straight from its packed data instead of going through one msg per
+  /// point:
+  ///
+  /// * Fields: float32 `x`, `y` and `z`, and optionally an uint32 `rgba`
+  /// color packed as 0xRRGGBBAA. Points without color are white.
+  /// * Header data `ns` and `id`: The marker, the id must not be 0.
+  /// * Header data `type`: Optional. `points`, `line_list`, `line_strip` or
+  /// `triangle_list`. Defaults to `points` for new markers and to the
+  /// current type otherwise.
+  /// * Header data `size`: Optional. Point size.
+  /// * Header data `offset`: Optional. Index of the first point to
+  /// overwrite, points past the end are appended. Without it, all the
+  /// marker's points are replaced.
+  ///
+  /// Markers other than line strips are split into geometries of at most
+  /// 65532 points, so an update with an offset, such as appending to a
+  /// growing map, only uploads the geometries it touches and costs as much
+  /// as the points sent. Recoloring a point rebuilds its geometry.
+  ///
+  /// ## Listing
+  ///
+  /// `<topic_name>/list` replies with all markers. With many markers, use
+  /// `<topic_name>/list/query` instead, which takes a `gz.msgs.Header`
+  /// whose data holds the query:
+  ///
+  /// * `ns`: Optional. Namespaces to list, all values are used. Defaults to
+  /// all namespaces.
+  /// * `offset`: Optional. Number of markers skipped. Defaults to 0.
+  /// * `limit`: Optional. Maximum number of markers listed. Defaults to 0,
+  /// no limit.
+  /// * `summary`: Optional. `true` to only count the markers of each
+  /// namespace.
+  ///
+  /// Both reply with a `gz.msgs.Marker_V` ordered by namespace then id,
+  /// with only their namespace and id set. Its header data holds `total`,
+  /// the number of markers matching, `next_offset` if there are more to
+  /// list, and in summary mode a `count` per namespace, whose values are
+  /// the namespace and its number of markers. Markers are copied before
+  /// the reply is built, so listing doesn't hold up rendering for long.
+  ///
+  /// ## In-process API
+  ///
+  /// Plugins in the same process can skip the services and their
+  /// serialization through the gz::gui::MarkerSink shared as
+  /// SceneServices::kMarkers. It takes marker msgs by move, and points as
+  /// gz::gui::MarkerPoints, which are queued as they are, like the bulk
+  /// service's decoded points. If several MarkerManagers are loaded, the
+  /// last one gets them.
   class MarkerManager : public Plugin
   {
     Q_OBJECT
 
+    /// \brief Number of marker messages waiting to be processed
+    Q_PROPERTY(
+      int backlog
+      READ Backlog
+      NOTIFY BacklogChanged
+    )
+
     /// \brief Constructor
     public: MarkerManager();
 
@@ -50,8 +125,16 @@ namespace gz::gui::plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
+    /// \brief Get the backlog.
+    /// \return Number of marker messages waiting to be processed.
+    public: Q_INVOKABLE int Backlog() const;
+
+    /// \brief Set the backlog.
+    /// \param[in] _backlog Number of marker messages waiting.
+    public: Q_INVOKABLE void SetBacklog(int _backlog);
+
+    /// \brief Notify that the backlog has changed
+    signals: void BacklogChanged();
 
     /// \internal
     /// \brief Pointer to private data.
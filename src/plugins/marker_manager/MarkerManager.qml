@@ -31,7 +31,10 @@ ColumnLayout {
   property string message: 'Services provided:<br><ul>' +
       '<li>' + topicName + '</li>' +
       '<li>' + topicName + '_array</li>' +
-      '<li>' + topicName + '/list</li></ul><br>Topics subscribed:<br><ul>' +
+      '<li>' + topicName + '/bulk</li>' +
+      '<li>' + topicName + '/list</li>' +
+      '<li>' + topicName + '/list/query</li></ul>' +
+      '<br>Topics subscribed:<br><ul>' +
       '<li>' + statsTopic + '</li></ul>'
 
   Label {
@@ -40,6 +43,12 @@ ColumnLayout {
     text: message
   }
 
+  Label {
+    Layout.fillWidth: true
+    visible: MarkerManager.backlog > 0
+    text: "Backlog: " + MarkerManager.backlog + " messages"
+  }
+
   Item {
     width: 10
     Layout.fillHeight: true
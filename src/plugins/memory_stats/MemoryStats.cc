@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <set>
+#include <string>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/param_v.pb.h>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/MemoryAccounting.hh"
+
+#include "MemoryStats.hh"
+
+namespace gz::gui::plugins
+{
+class MemoryStats::Implementation
+{
+  /// \brief Usage of each owner and category, for QML
+  public: QVariantList usages;
+
+  /// \brief Total CPU memory, for QML
+  public: QString cpuTotal;
+
+  /// \brief Total GPU memory, for QML
+  public: QString gpuTotal;
+
+  /// \brief Owners over budget, so they're only logged once
+  public: std::set<std::string> overBudget;
+
+  /// \brief Triggers updates
+  public: QTimer timer;
+
+  /// \brief Transport node
+  public: transport::Node node;
+
+  /// \brief Publishes the usages
+  public: transport::Node::Publisher pub;
+};
+
+/////////////////////////////////////////////////
+/// \brief Set a param of a usage msg
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \param[in] _value Value
+static void setParam(msgs::Param &_msg, const std::string &_key,
+    const std::string &_value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_STRING);
+  any.set_string_value(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Set a param of a usage msg. Sizes are sent as doubles, which
+/// hold them exactly up to petabytes, unlike the 32 bit integers.
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \param[in] _value Value
+static void setParam(msgs::Param &_msg, const std::string &_key,
+    std::size_t _value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_DOUBLE);
+  any.set_double_value(static_cast<double>(_value));
+}
+
+/////////////////////////////////////////////////
+MemoryStats::MemoryStats()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->connect(&this->dataPtr->timer, &QTimer::timeout,
+      this, &MemoryStats::Update);
+}
+
+/////////////////////////////////////////////////
+MemoryStats::~MemoryStats() = default;
+
+/////////////////////////////////////////////////
+void MemoryStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Memory stats";
+
+  std::string topic{"/gui/memory"};
+  double period{1.0};
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("topic"))
+    {
+      if (nullptr != elem->GetText())
+        topic = elem->GetText();
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("period"))
+      elem->QueryDoubleText(&period);
+
+    for (auto elem = _pluginElem->FirstChildElement("budget");
+        nullptr != elem; elem = elem->NextSiblingElement("budget"))
+    {
+      const char *owner = elem->Attribute("owner");
+      double mib{0.0};
+      if (nullptr == owner ||
+          elem->QueryDoubleText(&mib) != tinyxml2::XML_SUCCESS || mib < 0.0)
+      {
+        gzerr << "Budgets need an owner attribute and a size in MiB, such "
+              << "as <budget owner=\"TopicEcho\">256</budget>" << std::endl;
+        continue;
+      }
+      MemoryAccounting::SetBudget(owner,
+          static_cast<std::size_t>(mib * 1024.0 * 1024.0));
+    }
+  }
+
+  if (!topic.empty())
+  {
+    this->dataPtr->pub =
+        this->dataPtr->node.Advertise<msgs::Param_V>(topic);
+    if (!this->dataPtr->pub)
+    {
+      gzerr << "Failed to advertise memory stats on topic [" << topic << "]"
+            << std::endl;
+    }
+  }
+
+  if (period <= 0.0)
+  {
+    gzwarn << "Invalid <period> [" << period << "], using 1 s" << std::endl;
+    period = 1.0;
+  }
+  this->dataPtr->timer.start(static_cast<int>(period * 1000.0));
+  this->Update();
+}
+
+/////////////////////////////////////////////////
+void MemoryStats::Update()
+{
+  const auto snapshot = MemoryAccounting::Snapshot();
+
+  QVariantList usages;
+  msgs::Param_V msg;
+  std::set<std::string> overBudget;
+  for (const auto &usage : snapshot)
+  {
+    const bool over = MemoryAccounting::OverBudget(usage.owner);
+    const auto budget = MemoryAccounting::Budget(usage.owner);
+    if (over && overBudget.insert(usage.owner).second &&
+        this->dataPtr->overBudget.count(usage.owner) == 0)
+    {
+      gzwarn << "[" << usage.owner << "] holds "
+             << MemoryAccounting::FormatBytes(
+                MemoryAccounting::OwnerBytes(usage.owner))
+             << ", more than its budget of "
+             << MemoryAccounting::FormatBytes(budget) << std::endl;
+    }
+
+    const std::string type = usage.type == MemoryType::GPU ? "gpu" : "cpu";
+
+    QVariantMap map;
+    map["owner"] = QString::fromStdString(usage.owner);
+    map["category"] = QString::fromStdString(usage.category);
+    map["type"] = QString::fromStdString(type);
+    map["bytes"] = QString::fromStdString(
+        MemoryAccounting::FormatBytes(usage.bytes));
+    map["overBudget"] = over;
+    usages.append(map);
+
+    auto *param = msg.add_param();
+    setParam(*param, "owner", usage.owner);
+    setParam(*param, "category", usage.category);
+    setParam(*param, "type", type);
+    setParam(*param, "bytes", usage.bytes);
+    setParam(*param, "budget", budget);
+  }
+  this->dataPtr->overBudget = std::move(overBudget);
+
+  this->dataPtr->usages = std::move(usages);
+  this->dataPtr->cpuTotal = QString::fromStdString(
+      MemoryAccounting::FormatBytes(
+      MemoryAccounting::TotalBytes(MemoryType::CPU)));
+  this->dataPtr->gpuTotal = QString::fromStdString(
+      MemoryAccounting::FormatBytes(
+      MemoryAccounting::TotalBytes(MemoryType::GPU)));
+  emit this->UsagesChanged();
+
+  if (this->dataPtr->pub)
+    this->dataPtr->pub.Publish(msg);
+}
+
+/////////////////////////////////////////////////
+QVariantList MemoryStats::Usages() const
+{
+  return this->dataPtr->usages;
+}
+
+/////////////////////////////////////////////////
+QString MemoryStats::CpuTotal() const
+{
+  return this->dataPtr->cpuTotal;
+}
+
+/////////////////////////////////////////////////
+QString MemoryStats::GpuTotal() const
+{
+  return this->dataPtr->gpuTotal;
+}
+}  // namespace gz::gui::plugins
+
+// Register this plugin
+GZ_ADD_PLUGIN(gz::gui::plugins::MemoryStats,
+              gz::gui::Plugin)
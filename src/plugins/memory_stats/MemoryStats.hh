@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MEMORYSTATS_HH_
+#define GZ_GUI_PLUGINS_MEMORYSTATS_HH_
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz::gui::plugins
+{
+  /// \brief Displays the memory plugins report through MemoryAccount, per
+  /// plugin and category, and publishes it on a topic.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : Topic to publish gz::msgs::Param_V on, defaults to
+  ///               "/gui/memory". Each param holds one owner and category:
+  ///     * "owner" (string) : Plugin holding the memory.
+  ///     * "category" (string) : What the memory holds.
+  ///     * "type" (string) : "cpu" or "gpu".
+  ///     * "bytes" (double) : Bytes held.
+  ///     * "budget" (double) : Budget of the owner in bytes, 0 if none.
+  /// * \<period\> : Seconds between updates, defaults to 1.
+  /// * \<budget owner="..."\> : Most MiB the owner is expected to hold, CPU
+  ///                            and GPU combined. Exceeding it is shown in
+  ///                            red and logged once. May be repeated.
+  class MemoryStats : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Usage of each owner and category, as maps with "owner",
+    /// "category", "type", "bytes" and "overBudget"
+    Q_PROPERTY(
+      QVariantList usages
+      READ Usages
+      NOTIFY UsagesChanged
+    )
+
+    /// \brief Total CPU memory reported
+    Q_PROPERTY(
+      QString cpuTotal
+      READ CpuTotal
+      NOTIFY UsagesChanged
+    )
+
+    /// \brief Total GPU memory reported
+    Q_PROPERTY(
+      QString gpuTotal
+      READ GpuTotal
+      NOTIFY UsagesChanged
+    )
+
+    /// \brief Constructor
+    public: MemoryStats();
+
+    /// \brief Destructor
+    public: ~MemoryStats() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the usage of each owner and category
+    /// \return List of maps
+    public: Q_INVOKABLE QVariantList Usages() const;
+
+    /// \brief Get the total CPU memory reported
+    /// \return Size, such as "1.5 MiB"
+    public: Q_INVOKABLE QString CpuTotal() const;
+
+    /// \brief Get the total GPU memory reported
+    /// \return Size, such as "1.5 MiB"
+    public: Q_INVOKABLE QString GpuTotal() const;
+
+    /// \brief Read the accounts, update the display and publish
+    public: void Update();
+
+    /// \brief Notify that the usages have been updated
+    signals: void UsagesChanged();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MEMORYSTATS_HH_
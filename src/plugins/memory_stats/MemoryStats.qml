@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: memoryStats
+  color: "transparent"
+  Layout.minimumWidth: 300
+  Layout.minimumHeight: 200
+
+  // Only used for its color, so labels over budget can go back to it
+  Label {
+    id: defaultColor
+    visible: false
+  }
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    RowLayout {
+      Label {
+        font.weight: Font.DemiBold
+        text: "CPU"
+      }
+
+      Label {
+        objectName: "cpuTotal"
+        text: MemoryStats.cpuTotal
+        Layout.fillWidth: true
+      }
+
+      Label {
+        font.weight: Font.DemiBold
+        text: "GPU"
+      }
+
+      Label {
+        objectName: "gpuTotal"
+        text: MemoryStats.gpuTotal
+        Layout.fillWidth: true
+      }
+    }
+
+    ListView {
+      objectName: "usages"
+      clip: true
+      model: MemoryStats.usages
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+
+      delegate: RowLayout {
+        width: ListView.view.width
+
+        Label {
+          text: modelData.owner
+          color: modelData.overBudget ? "red" : defaultColor.color
+          Layout.preferredWidth: parent.width * 0.35
+          elide: Text.ElideRight
+        }
+
+        Label {
+          text: modelData.category
+          Layout.preferredWidth: parent.width * 0.3
+          elide: Text.ElideRight
+        }
+
+        Label {
+          text: modelData.type
+          color: "gray"
+        }
+
+        Label {
+          text: modelData.bytes
+          color: modelData.overBudget ? "red" : defaultColor.color
+          horizontalAlignment: Text.AlignRight
+          Layout.fillWidth: true
+        }
+      }
+    }
+  }
+}
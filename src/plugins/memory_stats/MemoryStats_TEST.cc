@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/param_v.pb.h>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/MemoryAccounting.hh"
+#include "gz/gui/Plugin.hh"
+#include "MemoryStats.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./MemoryStats_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(MemoryStatsTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Publish))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  MemoryAccount msgAccount("MemoryStatsTest", "msgs");
+  msgAccount.Set(3u << 20);
+  MemoryAccount textures("MemoryStatsTest", "textures", MemoryType::GPU);
+  textures.Set(1u << 20);
+
+  // Subscribe before the plugin publishes
+  std::mutex mutex;
+  std::map<std::string, double> bytes;
+  double budget{0.0};
+  std::atomic<bool> received{false};
+  transport::Node node;
+  std::function<void(const msgs::Param_V &)> cb =
+      [&](const msgs::Param_V &_msg)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &param : _msg.param())
+    {
+      if (param.params().at("owner").string_value() != "MemoryStatsTest")
+        continue;
+      bytes[param.params().at("category").string_value()] =
+          param.params().at("bytes").double_value();
+      budget = param.params().at("budget").double_value();
+    }
+    received = true;
+  };
+  ASSERT_TRUE(node.Subscribe("/memory_stats_test", cb));
+
+  const char *pluginStr =
+    "<plugin filename=\"MemoryStats\">"
+      "<topic>/memory_stats_test</topic>"
+      "<period>0.05</period>"
+      "<budget owner=\"MemoryStatsTest\">2</budget>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MemoryStats",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugin = win->findChild<plugins::MemoryStats *>();
+  ASSERT_NE(nullptr, plugin);
+  EXPECT_EQ(plugin->Title(), "Memory stats");
+
+  // The budget is given in MiB
+  EXPECT_EQ(2u << 20, MemoryAccounting::Budget("MemoryStatsTest"));
+  EXPECT_TRUE(MemoryAccounting::OverBudget("MemoryStatsTest"));
+
+  int sleep = 0;
+  while (!received && sleep < 100)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ++sleep;
+  }
+  ASSERT_TRUE(received);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_DOUBLE_EQ(3.0 * (1 << 20), bytes["msgs"]);
+    EXPECT_DOUBLE_EQ(1.0 * (1 << 20), bytes["textures"]);
+    EXPECT_DOUBLE_EQ(2.0 * (1 << 20), budget);
+  }
+
+  bool found{false};
+  for (const auto &usage : plugin->Usages())
+  {
+    const auto map = usage.toMap();
+    if (map["owner"].toString() != "MemoryStatsTest")
+      continue;
+    found = true;
+    EXPECT_TRUE(map["overBudget"].toBool());
+  }
+  EXPECT_TRUE(found);
+  EXPECT_EQ("1.0 MiB", plugin->GpuTotal().toStdString());
+
+  MemoryAccounting::SetBudget("MemoryStatsTest", 0);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "EnginePreload.hh"
+
+#include <map>
+#include <memory>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/common/SystemPaths.hh>
+#include <gz/plugin/Loader.hh>
+#include <gz/rendering/InstallationDirectories.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/StartupTrace.hh"
+
+namespace gz::gui::plugins
+{
+class EnginePreload::Implementation
+{
+  /// \brief Loads the library
+  public: std::thread thread;
+
+  /// \brief Holds the library open, may outlive gz-rendering's own use
+  public: std::unique_ptr<plugin::Loader> loader;
+
+  /// \brief Whether the library was loaded, set by `thread`
+  public: bool loaded{false};
+};
+
+/////////////////////////////////////////////////
+EnginePreload::EnginePreload()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+EnginePreload::~EnginePreload()
+{
+  this->Wait();
+}
+
+/////////////////////////////////////////////////
+std::string EnginePreload::LibraryName(const std::string &_engine)
+{
+  // Same as gz-rendering's RenderEngineManager
+  static const std::map<std::string, std::string> kLibraries{
+      {"ogre", "gz-rendering-ogre"},
+      {"ogre2", "gz-rendering-ogre2"},
+      {"optix", "gz-rendering-optix"}};
+  auto it = kLibraries.find(_engine);
+  return it == kLibraries.end() ? _engine : it->second;
+}
+
+/////////////////////////////////////////////////
+void EnginePreload::Start(const std::string &_engine)
+{
+  if (_engine.empty() || this->dataPtr->thread.joinable() ||
+      this->dataPtr->loader)
+  {
+    return;
+  }
+
+  this->dataPtr->loader = std::make_unique<plugin::Loader>();
+  auto *trace = App() ? App()->Trace() : nullptr;
+  this->dataPtr->thread = std::thread([this, _engine, trace]()
+  {
+    StartupTraceZone traceZone(trace, "Preload engine [" + _engine + "]",
+        "render");
+
+    // Looked for where gz-rendering looks for it
+    common::SystemPaths systemPaths;
+    systemPaths.SetPluginPathEnv("GZ_RENDERING_PLUGIN_PATH");
+    systemPaths.AddPluginPaths(rendering::getEngineInstallDir());
+    const auto path = systemPaths.FindSharedLibrary(LibraryName(_engine));
+    if (path.empty())
+    {
+      // Reported by gz-rendering when the engine is loaded
+      gzdbg << "Engine [" << _engine << "] not found to preload"
+            << std::endl;
+      return;
+    }
+
+    this->dataPtr->loaded =
+        !this->dataPtr->loader->LoadLib(path, true).empty();
+  });
+}
+
+/////////////////////////////////////////////////
+bool EnginePreload::Wait()
+{
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+  return this->dataPtr->loaded;
+}
+}  // namespace gz::gui::plugins
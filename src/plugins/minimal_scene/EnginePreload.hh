@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_ENGINEPRELOAD_HH_
+#define GZ_GUI_PLUGINS_ENGINEPRELOAD_HH_
+
+#include <string>
+
+#include <gz/utils/ImplPtr.hh>
+
+#ifndef _WIN32
+#  define EnginePreload_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(MinimalScene_EXPORTS))
+#    define EnginePreload_EXPORTS_API __declspec(dllexport)
+#  else
+#    define EnginePreload_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Loads a render engine's plugin library on a thread of its
+  /// own, while the other plugins and the QML are loaded, so that the
+  /// render thread finds it loaded once the window is shown.
+  ///
+  /// Opening the library also opens the libraries it depends on, such as
+  /// Ogre's, and runs their static initialization, which doesn't need a
+  /// graphics context. Initializing the engine and creating the scene do,
+  /// so they're still done on the render thread, where gz-rendering opens
+  /// the same library again, which is then only a lookup.
+  ///
+  /// Start and Wait are called from one thread at a time.
+  class EnginePreload_EXPORTS_API EnginePreload
+  {
+    /// \brief Constructor
+    public: EnginePreload();
+
+    /// \brief Destructor, waits for the library to be loaded. It's kept
+    /// open as long as gz-rendering uses it.
+    public: ~EnginePreload();
+
+    /// \brief Get the name of an engine's plugin library, the way
+    /// gz-rendering names them
+    /// \param[in] _engine Engine name, such as "ogre2"
+    /// \return Library name, such as "gz-rendering-ogre2". Names of other
+    /// engines are library names already.
+    public: static std::string LibraryName(const std::string &_engine);
+
+    /// \brief Start loading an engine's library in the background. Does
+    /// nothing if it was started already.
+    /// \param[in] _engine Engine name, nothing is loaded if empty
+    public: void Start(const std::string &_engine);
+
+    /// \brief Wait for the library to be loaded
+    /// \return True if it was found and loaded, false if it wasn't, or if
+    /// loading wasn't started
+    public: bool Wait();
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
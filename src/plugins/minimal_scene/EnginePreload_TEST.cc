@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "EnginePreload.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(EnginePreloadTest, LibraryName)
+{
+  EXPECT_EQ("gz-rendering-ogre", EnginePreload::LibraryName("ogre"));
+  EXPECT_EQ("gz-rendering-ogre2", EnginePreload::LibraryName("ogre2"));
+  EXPECT_EQ("gz-rendering-optix", EnginePreload::LibraryName("optix"));
+  EXPECT_EQ("my-engine", EnginePreload::LibraryName("my-engine"));
+}
+
+/////////////////////////////////////////////////
+TEST(EnginePreloadTest, NotLoaded)
+{
+  // Not started
+  EnginePreload preload;
+  EXPECT_FALSE(preload.Wait());
+
+  // Nothing to load
+  preload.Start("");
+  EXPECT_FALSE(preload.Wait());
+
+  // Not found
+  EnginePreload missing;
+  missing.Start("not-an-engine");
+  EXPECT_FALSE(missing.Wait());
+  EXPECT_FALSE(missing.Wait());
+}
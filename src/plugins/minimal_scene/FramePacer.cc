@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "FramePacer.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+void FramePacer::SetRefreshInterval(Clock::duration _interval)
+{
+  this->nominalInterval = std::max(Clock::duration::zero(), _interval);
+  this->interval = this->nominalInterval;
+}
+
+/////////////////////////////////////////////////
+FramePacer::Clock::duration FramePacer::RefreshInterval() const
+{
+  return this->interval;
+}
+
+/////////////////////////////////////////////////
+void FramePacer::SetMargin(Clock::duration _margin)
+{
+  this->margin = std::max(Clock::duration::zero(), _margin);
+}
+
+/////////////////////////////////////////////////
+void FramePacer::Presented(Clock::time_point _time)
+{
+  if (this->lastPresent.has_value() &&
+      this->interval > Clock::duration::zero() &&
+      _time > *this->lastPresent)
+  {
+    // Swaps may skip refreshes, so the interval is the time since the last
+    // one divided by the refreshes it spans
+    const auto elapsed = _time - *this->lastPresent;
+    const double refreshes = std::round(
+        static_cast<double>(elapsed.count()) / this->interval.count());
+    if (refreshes >= 1.0)
+    {
+      const auto measured = Clock::duration(static_cast<Clock::rep>(
+          elapsed.count() / refreshes));
+      const auto tolerance = this->nominalInterval / 10;
+      if (measured > this->nominalInterval - tolerance &&
+          measured < this->nominalInterval + tolerance)
+      {
+        this->interval += (measured - this->interval) / 16;
+      }
+    }
+  }
+  this->lastPresent = _time;
+}
+
+/////////////////////////////////////////////////
+void FramePacer::Rendered(Clock::duration _duration)
+{
+  if (_duration > this->renderEstimate)
+    this->renderEstimate = _duration;
+  else
+    this->renderEstimate -= (this->renderEstimate - _duration) / 32;
+}
+
+/////////////////////////////////////////////////
+FramePacer::Clock::duration FramePacer::RenderEstimate() const
+{
+  return this->renderEstimate;
+}
+
+/////////////////////////////////////////////////
+FramePacer::Clock::time_point FramePacer::NextStart(
+    Clock::time_point _now) const
+{
+  if (!this->lastPresent.has_value() ||
+      this->interval <= Clock::duration::zero())
+  {
+    return _now;
+  }
+
+  // First refresh the frame can be done by, if started now
+  const auto lead = this->renderEstimate + this->margin;
+  const auto earliest = _now + lead;
+  auto refreshes = (earliest - *this->lastPresent) / this->interval;
+  auto refresh = *this->lastPresent + refreshes * this->interval;
+  if (refresh < earliest)
+    refresh += this->interval;
+
+  return std::max(_now, refresh - lead);
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_FRAMEPACER_HH_
+#define GZ_GUI_PLUGINS_FRAMEPACER_HH_
+
+#include <chrono>
+#include <optional>
+
+#ifndef _WIN32
+#  define FramePacer_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(MinimalScene_EXPORTS))
+#    define FramePacer_EXPORTS_API __declspec(dllexport)
+#  else
+#    define FramePacer_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Predicts when the display refreshes from the times frames were
+  /// presented, and when to start rendering so a frame is done just before
+  /// the refresh at which it's picked up. Starting at a steady offset from
+  /// vsync, instead of as soon as possible, keeps the time between a frame
+  /// being rendered and shown constant, so motion looks smooth even when
+  /// render times vary.
+  ///
+  /// Not thread safe.
+  class FramePacer_EXPORTS_API FramePacer
+  {
+    /// \brief Clock used for all times
+    public: using Clock = std::chrono::steady_clock;
+
+    /// \brief Set the display's nominal refresh interval. The estimate
+    /// follows the present times within 10% of it.
+    /// \param[in] _interval Refresh interval, zero if unknown, which
+    /// disables pacing
+    public: void SetRefreshInterval(Clock::duration _interval);
+
+    /// \brief Get the estimated refresh interval
+    /// \return Refresh interval, zero if unknown
+    public: Clock::duration RefreshInterval() const;
+
+    /// \brief Set how long before the predicted refresh frames should be
+    /// done, to absorb scheduling noise
+    /// \param[in] _margin Margin, defaults to 2 ms
+    public: void SetMargin(Clock::duration _margin);
+
+    /// \brief Record a buffer swap, which is assumed to return at a
+    /// display refresh
+    /// \param[in] _time When the swap returned
+    public: void Presented(Clock::time_point _time);
+
+    /// \brief Record how long a frame took to render. The estimate rises
+    /// right away with slower frames and decays slowly with faster ones.
+    /// \param[in] _duration Render time
+    public: void Rendered(Clock::duration _duration);
+
+    /// \brief Get the render time frames are expected to take
+    /// \return Estimated render time
+    public: Clock::duration RenderEstimate() const;
+
+    /// \brief Get when to start rendering the next frame
+    /// \param[in] _now Current time
+    /// \return Start time, never before _now and less than a refresh
+    /// interval after it. _now until a refresh interval and a present time
+    /// are known.
+    public: Clock::time_point NextStart(Clock::time_point _now) const;
+
+    /// \brief Nominal refresh interval
+    private: Clock::duration nominalInterval{0};
+
+    /// \brief Estimated refresh interval
+    private: Clock::duration interval{0};
+
+    /// \brief Time frames should be done before the refresh
+    private: Clock::duration margin{std::chrono::milliseconds(2)};
+
+    /// \brief Estimated render time
+    private: Clock::duration renderEstimate{0};
+
+    /// \brief Last present time, which gives the refresh phase
+    private: std::optional<Clock::time_point> lastPresent;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_FRAMEPACER_HH_
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "FramePacer.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Convert a duration to milliseconds
+/// \param[in] _duration Duration
+/// \return Milliseconds
+static double toMs(FramePacer::Clock::duration _duration)
+{
+  return std::chrono::duration<double, std::milli>(_duration).count();
+}
+
+/////////////////////////////////////////////////
+TEST(FramePacerTest, Unknown)
+{
+  FramePacer pacer;
+  const auto now = FramePacer::Clock::now();
+
+  // No refresh interval
+  pacer.Presented(now);
+  EXPECT_EQ(now, pacer.NextStart(now));
+
+  // No present time
+  FramePacer other;
+  other.SetRefreshInterval(16ms);
+  EXPECT_EQ(now, other.NextStart(now));
+}
+
+/////////////////////////////////////////////////
+TEST(FramePacerTest, NextStart)
+{
+  FramePacer pacer;
+  pacer.SetRefreshInterval(16ms);
+  pacer.SetMargin(2ms);
+  pacer.Rendered(4ms);
+  EXPECT_EQ(4ms, pacer.RenderEstimate());
+
+  const FramePacer::Clock::time_point vsync{1s};
+  pacer.Presented(vsync);
+
+  // Done 2 ms before the next refresh
+  EXPECT_EQ(vsync + 10ms, pacer.NextStart(vsync + 1ms));
+
+  // Too late for it, so aim for the one after
+  EXPECT_EQ(vsync + 26ms, pacer.NextStart(vsync + 11ms));
+
+  // Right on time
+  EXPECT_EQ(vsync + 10ms, pacer.NextStart(vsync + 10ms));
+
+  // Frames slower than a refresh start right away
+  pacer.Rendered(20ms);
+  EXPECT_EQ(20ms, pacer.RenderEstimate());
+  EXPECT_EQ(vsync + 10ms, pacer.NextStart(vsync + 10ms));
+  EXPECT_EQ(vsync + 26ms, pacer.NextStart(vsync + 11ms));
+}
+
+/////////////////////////////////////////////////
+TEST(FramePacerTest, RenderEstimate)
+{
+  FramePacer pacer;
+  pacer.Rendered(8ms);
+  EXPECT_EQ(8ms, pacer.RenderEstimate());
+
+  // Decays slowly, so a fast frame doesn't make the next one late
+  pacer.Rendered(0ms);
+  EXPECT_EQ(7750us, pacer.RenderEstimate());
+  for (int i = 0; i < 500; ++i)
+    pacer.Rendered(4ms);
+  EXPECT_NEAR(4.0, toMs(pacer.RenderEstimate()), 0.01);
+}
+
+/////////////////////////////////////////////////
+TEST(FramePacerTest, RefreshInterval)
+{
+  FramePacer pacer;
+  EXPECT_EQ(FramePacer::Clock::duration::zero(), pacer.RefreshInterval());
+
+  pacer.SetRefreshInterval(16ms);
+  EXPECT_EQ(16ms, pacer.RefreshInterval());
+
+  // The display actually runs at 16.5 ms. Skipped refreshes count too.
+  FramePacer::Clock::time_point vsync{1s};
+  for (int i = 0; i < 200; ++i)
+  {
+    pacer.Presented(vsync);
+    vsync += (i % 3 == 0 ? 33ms : 16500us);
+  }
+  EXPECT_NEAR(16.5, toMs(pacer.RefreshInterval()), 0.05);
+
+  // Far off intervals, such as a window stalled for a while, are ignored
+  const auto interval = pacer.RefreshInterval();
+  pacer.Presented(vsync + 23ms);
+  pacer.Presented(vsync + 23ms + 13ms);
+  EXPECT_EQ(interval, pacer.RefreshInterval());
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "InputRecording.hh"
+
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+
+namespace gz::gui::plugins
+{
+/// \brief First line of a recording, with the format version
+static const char kInputHeader[] = "gz-gui-input 1";
+
+/////////////////////////////////////////////////
+InputRecorder::~InputRecorder()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool InputRecorder::Start(const std::string &_path)
+{
+  const auto dir = common::parentPath(_path);
+  if (!dir.empty() && !common::isDirectory(dir) &&
+      !common::createDirectories(dir))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->file = std::ofstream(_path, std::ios::trunc);
+  if (!this->file)
+    return false;
+
+  this->file << kInputHeader << '\n';
+  this->start = std::chrono::steady_clock::now();
+  this->count = 0;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void InputRecorder::Stop()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->file.is_open())
+    return;
+  this->file.close();
+  gzmsg << "Recorded " << this->count << " input events" << std::endl;
+}
+
+/////////////////////////////////////////////////
+bool InputRecorder::Recording() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->file.is_open();
+}
+
+/////////////////////////////////////////////////
+void InputRecorder::Add(const common::MouseEvent &_event)
+{
+  RecordedInput input;
+  input.kind = RecordedInput::Kind::MOUSE;
+  input.mouse = _event;
+  this->Add(std::move(input));
+}
+
+/////////////////////////////////////////////////
+void InputRecorder::Add(const common::KeyEvent &_event, bool _press)
+{
+  RecordedInput input;
+  input.kind = _press ? RecordedInput::Kind::KEY_PRESS :
+      RecordedInput::Kind::KEY_RELEASE;
+  input.key = _event;
+  this->Add(std::move(input));
+}
+
+/////////////////////////////////////////////////
+void InputRecorder::Add(RecordedInput _input)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->file.is_open())
+    return;
+
+  _input.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - this->start);
+
+  // Flushed right away, so a recording is usable even if the app crashes
+  this->file << SerializeInput(_input) << std::endl;
+  ++this->count;
+}
+
+/////////////////////////////////////////////////
+bool InputReplay::Load(const std::string &_path)
+{
+  std::ifstream file(_path);
+  std::string line;
+  if (!std::getline(file, line) || line != kInputHeader)
+    return false;
+
+  std::vector<RecordedInput> loaded;
+  std::size_t malformed{0};
+  while (std::getline(file, line))
+  {
+    RecordedInput input;
+    if (ParseInput(line, input))
+      loaded.push_back(std::move(input));
+    else
+      ++malformed;
+  }
+  if (malformed > 0)
+  {
+    gzwarn << "Skipped " << malformed << " malformed lines in input "
+           << "recording [" << _path << "]" << std::endl;
+  }
+
+  this->SetEvents(std::move(loaded));
+  return true;
+}
+
+/////////////////////////////////////////////////
+void InputReplay::SetEvents(std::vector<RecordedInput> _events)
+{
+  this->events = std::move(_events);
+  this->next = 0;
+}
+
+/////////////////////////////////////////////////
+std::vector<RecordedInput> InputReplay::Take(
+    std::chrono::nanoseconds _elapsed)
+{
+  std::vector<RecordedInput> due;
+  while (this->next < this->events.size() &&
+      this->events[this->next].time <= _elapsed)
+  {
+    due.push_back(this->events[this->next++]);
+  }
+  return due;
+}
+
+/////////////////////////////////////////////////
+std::chrono::nanoseconds InputReplay::NextTime() const
+{
+  if (this->Done())
+    return std::chrono::nanoseconds(-1);
+  return this->events[this->next].time;
+}
+
+/////////////////////////////////////////////////
+bool InputReplay::Done() const
+{
+  return this->next >= this->events.size();
+}
+
+/////////////////////////////////////////////////
+std::size_t InputReplay::Size() const
+{
+  return this->events.size();
+}
+
+/////////////////////////////////////////////////
+std::string SerializeInput(const RecordedInput &_input)
+{
+  std::ostringstream line;
+  if (_input.kind == RecordedInput::Kind::MOUSE)
+  {
+    // Every field the renderer and its listeners read, since they can't be
+    // derived from other events once replayed
+    const auto &e = _input.mouse;
+    line << "mouse " << _input.time.count() << ' '
+         << static_cast<int>(e.Type()) << ' '
+         << static_cast<int>(e.Button()) << ' ' << e.Buttons() << ' '
+         << e.Pos().X() << ' ' << e.Pos().Y() << ' '
+         << e.PrevPos().X() << ' ' << e.PrevPos().Y() << ' '
+         << e.PressPos().X() << ' ' << e.PressPos().Y() << ' '
+         << e.Scroll().X() << ' ' << e.Scroll().Y() << ' '
+         << e.MoveScale() << ' ' << e.Dragging() << ' ' << e.Shift() << ' '
+         << e.Alt() << ' ' << e.Control();
+  }
+  else
+  {
+    const auto &e = _input.key;
+    line << (_input.kind == RecordedInput::Kind::KEY_PRESS ?
+        "key_press " : "key_release ") << _input.time.count() << ' '
+         << static_cast<int>(e.Type()) << ' ' << e.Key() << ' '
+         << e.Control() << ' ' << e.Shift() << ' ' << e.Alt() << ' '
+         << std::quoted(e.Text());
+  }
+  return line.str();
+}
+
+/////////////////////////////////////////////////
+bool ParseInput(const std::string &_line, RecordedInput &_input)
+{
+  std::istringstream line(_line);
+  std::string kind;
+  int64_t time{0};
+  int type{0};
+  if (!(line >> kind >> time >> type) || time < 0)
+    return false;
+  _input.time = std::chrono::nanoseconds(time);
+
+  if (kind == "mouse")
+  {
+    int button{0};
+    unsigned int buttons{0};
+    int x, y, prevX, prevY, pressX, pressY, scrollX, scrollY;
+    float moveScale{1.0f};
+    bool dragging, shift, alt, control;
+    if (!(line >> button >> buttons >> x >> y >> prevX >> prevY >> pressX
+        >> pressY >> scrollX >> scrollY >> moveScale >> dragging >> shift
+        >> alt >> control) ||
+        type < common::MouseEvent::NO_EVENT ||
+        type > common::MouseEvent::SCROLL)
+    {
+      return false;
+    }
+
+    common::MouseEvent e;
+    e.SetType(static_cast<common::MouseEvent::EventType>(type));
+    e.SetButton(static_cast<common::MouseEvent::MouseButton>(button));
+    e.SetButtons(buttons);
+    e.SetPos(x, y);
+    e.SetPrevPos(prevX, prevY);
+    e.SetPressPos(pressX, pressY);
+    e.SetScroll(scrollX, scrollY);
+    e.SetMoveScale(moveScale);
+    e.SetDragging(dragging);
+    e.SetShift(shift);
+    e.SetAlt(alt);
+    e.SetControl(control);
+    _input.kind = RecordedInput::Kind::MOUSE;
+    _input.mouse = e;
+    return true;
+  }
+
+  if (kind == "key_press" || kind == "key_release")
+  {
+    int key{0};
+    bool control, shift, alt;
+    std::string text;
+    if (!(line >> key >> control >> shift >> alt >> std::quoted(text)) ||
+        type < common::KeyEvent::NO_EVENT ||
+        type > common::KeyEvent::RELEASE)
+    {
+      return false;
+    }
+
+    common::KeyEvent e;
+    e.SetType(static_cast<common::KeyEvent::EventType>(type));
+    e.SetKey(key);
+    e.SetText(text);
+    e.SetControl(control);
+    e.SetShift(shift);
+    e.SetAlt(alt);
+    _input.kind = kind == "key_press" ? RecordedInput::Kind::KEY_PRESS :
+        RecordedInput::Kind::KEY_RELEASE;
+    _input.key = e;
+    return true;
+  }
+
+  return false;
+}
+}  // namespace gz::gui::plugins
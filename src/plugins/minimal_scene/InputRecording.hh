@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_INPUTRECORDING_HH_
+#define GZ_GUI_PLUGINS_INPUTRECORDING_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gz/common/KeyEvent.hh>
+#include <gz/common/MouseEvent.hh>
+
+#ifndef _WIN32
+#  define InputRecording_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(MinimalScene_EXPORTS))
+#    define InputRecording_EXPORTS_API __declspec(dllexport)
+#  else
+#    define InputRecording_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief A mouse or key event received by the scene
+  struct InputRecording_EXPORTS_API RecordedInput
+  {
+    /// \brief Which of the renderer's handlers received the event
+    enum class Kind
+    {
+      /// \brief GzRenderer::NewMouseEvent
+      MOUSE,
+
+      /// \brief GzRenderer::HandleKeyPress
+      KEY_PRESS,
+
+      /// \brief GzRenderer::HandleKeyRelease
+      KEY_RELEASE
+    };
+
+    /// \brief Handler which received the event
+    Kind kind{Kind::MOUSE};
+
+    /// \brief Time since the recording started
+    std::chrono::nanoseconds time{0};
+
+    /// \brief Event, if kind is MOUSE
+    common::MouseEvent mouse;
+
+    /// \brief Event, if kind is KEY_PRESS or KEY_RELEASE
+    common::KeyEvent key;
+  };
+
+  /// \brief Writes the mouse and key events received by the scene to a
+  /// file as they come, one per line, with the time since recording
+  /// started. Thread safe.
+  class InputRecording_EXPORTS_API InputRecorder
+  {
+    /// \brief Destructor, stops recording
+    public: ~InputRecorder();
+
+    /// \brief Start recording, replacing the file if it exists
+    /// \param[in] _path File path, its directory is created if needed
+    /// \return True if the file could be opened
+    public: bool Start(const std::string &_path);
+
+    /// \brief Stop recording and close the file
+    public: void Stop();
+
+    /// \brief Whether events are being recorded
+    /// \return True between Start and Stop
+    public: bool Recording() const;
+
+    /// \brief Record a mouse event, ignored unless recording
+    /// \param[in] _event Event
+    public: void Add(const common::MouseEvent &_event);
+
+    /// \brief Record a key event, ignored unless recording
+    /// \param[in] _event Event
+    /// \param[in] _press True if received by the press handler
+    public: void Add(const common::KeyEvent &_event, bool _press);
+
+    /// \brief Record an event, ignored unless recording
+    /// \param[in] _input Event. Its time is replaced by the time since
+    /// recording started.
+    private: void Add(RecordedInput _input);
+
+    /// \brief Protects the members below
+    private: mutable std::mutex mutex;
+
+    /// \brief Open while recording
+    private: std::ofstream file;
+
+    /// \brief When recording started
+    private: std::chrono::steady_clock::time_point start;
+
+    /// \brief Number of events recorded
+    private: std::size_t count{0};
+  };
+
+  /// \brief Feeds the events of a recording back in at the times they were
+  /// recorded. Not thread safe.
+  class InputRecording_EXPORTS_API InputReplay
+  {
+    /// \brief Load a recording
+    /// \param[in] _path File written by InputRecorder
+    /// \return False if the file couldn't be read or isn't a recording.
+    /// Malformed lines are skipped.
+    public: bool Load(const std::string &_path);
+
+    /// \brief Set the events to replay
+    /// \param[in] _events Events, in time order
+    public: void SetEvents(std::vector<RecordedInput> _events);
+
+    /// \brief Take the events which are due
+    /// \param[in] _elapsed Time since the replay started
+    /// \return Events recorded at or before _elapsed which haven't been
+    /// taken yet, in order
+    public: std::vector<RecordedInput> Take(std::chrono::nanoseconds _elapsed);
+
+    /// \brief Time of the next event
+    /// \return Time since the replay started, negative once all events
+    /// were taken
+    public: std::chrono::nanoseconds NextTime() const;
+
+    /// \brief Whether all events were taken
+    /// \return True once done
+    public: bool Done() const;
+
+    /// \brief Number of events
+    /// \return Number loaded
+    public: std::size_t Size() const;
+
+    /// \brief Events
+    private: std::vector<RecordedInput> events;
+
+    /// \brief Index of the next event to take
+    private: std::size_t next{0};
+  };
+
+  /// \brief Write an event as a line of a recording
+  /// \param[in] _input Event
+  /// \return Line, without the line break
+  InputRecording_EXPORTS_API std::string SerializeInput(
+      const RecordedInput &_input);
+
+  /// \brief Read an event from a line of a recording
+  /// \param[in] _line Line
+  /// \param[out] _input Event
+  /// \return False if the line is malformed
+  InputRecording_EXPORTS_API bool ParseInput(const std::string &_line,
+      RecordedInput &_input);
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_INPUTRECORDING_HH_
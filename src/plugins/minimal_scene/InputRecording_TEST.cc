@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "InputRecording.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(InputRecordingTest, Serialize)
+{
+  RecordedInput drag;
+  drag.time = std::chrono::milliseconds(1500);
+  drag.mouse.SetType(common::MouseEvent::MOVE);
+  drag.mouse.SetButton(common::MouseEvent::LEFT);
+  drag.mouse.SetButtons(common::MouseEvent::LEFT | common::MouseEvent::RIGHT);
+  drag.mouse.SetPos(10, 20);
+  drag.mouse.SetPrevPos(9, 18);
+  drag.mouse.SetPressPos(1, 2);
+  drag.mouse.SetScroll(0, -3);
+  drag.mouse.SetMoveScale(0.5f);
+  drag.mouse.SetDragging(true);
+  drag.mouse.SetControl(true);
+
+  RecordedInput parsed;
+  ASSERT_TRUE(ParseInput(SerializeInput(drag), parsed));
+  EXPECT_EQ(RecordedInput::Kind::MOUSE, parsed.kind);
+  EXPECT_EQ(drag.time, parsed.time);
+  EXPECT_EQ(common::MouseEvent::MOVE, parsed.mouse.Type());
+  EXPECT_EQ(common::MouseEvent::LEFT, parsed.mouse.Button());
+  EXPECT_EQ(drag.mouse.Buttons(), parsed.mouse.Buttons());
+  EXPECT_EQ(math::Vector2i(10, 20), parsed.mouse.Pos());
+  EXPECT_EQ(math::Vector2i(9, 18), parsed.mouse.PrevPos());
+  EXPECT_EQ(math::Vector2i(1, 2), parsed.mouse.PressPos());
+  EXPECT_EQ(math::Vector2i(0, -3), parsed.mouse.Scroll());
+  EXPECT_FLOAT_EQ(0.5f, parsed.mouse.MoveScale());
+  EXPECT_TRUE(parsed.mouse.Dragging());
+  EXPECT_TRUE(parsed.mouse.Control());
+  EXPECT_FALSE(parsed.mouse.Shift());
+  EXPECT_FALSE(parsed.mouse.Alt());
+
+  // Text with spaces and quotes survives
+  RecordedInput key;
+  key.kind = RecordedInput::Kind::KEY_RELEASE;
+  key.time = std::chrono::nanoseconds(42);
+  key.key.SetType(common::KeyEvent::RELEASE);
+  key.key.SetKey(32);
+  key.key.SetText("a \"b\" c");
+  key.key.SetShift(true);
+
+  ASSERT_TRUE(ParseInput(SerializeInput(key), parsed));
+  EXPECT_EQ(RecordedInput::Kind::KEY_RELEASE, parsed.kind);
+  EXPECT_EQ(key.time, parsed.time);
+  EXPECT_EQ(common::KeyEvent::RELEASE, parsed.key.Type());
+  EXPECT_EQ(32, parsed.key.Key());
+  EXPECT_EQ("a \"b\" c", parsed.key.Text());
+  EXPECT_TRUE(parsed.key.Shift());
+  EXPECT_FALSE(parsed.key.Control());
+
+  EXPECT_FALSE(ParseInput("", parsed));
+  EXPECT_FALSE(ParseInput("mouse 10 1 1", parsed));
+  EXPECT_FALSE(ParseInput("mouse -1 1 1 0 0 0 0 0 0 0 0 0 1 0 0 0 0",
+      parsed));
+  EXPECT_FALSE(ParseInput("wheel 10 1", parsed));
+}
+
+/////////////////////////////////////////////////
+TEST(InputRecordingTest, RecordReplay)
+{
+  const auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH), "test",
+      "input_recording", "session.txt");
+  common::removeAll(common::parentPath(path));
+
+  InputRecorder recorder;
+  EXPECT_FALSE(recorder.Recording());
+
+  // Ignored until started
+  recorder.Add(common::MouseEvent());
+
+  // The directory is created
+  ASSERT_TRUE(recorder.Start(path));
+  EXPECT_TRUE(recorder.Recording());
+
+  common::MouseEvent press;
+  press.SetType(common::MouseEvent::PRESS);
+  press.SetPos(5, 6);
+  recorder.Add(press);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  common::KeyEvent key;
+  key.SetType(common::KeyEvent::PRESS);
+  key.SetKey(65);
+  recorder.Add(key, true);
+  recorder.Stop();
+  EXPECT_FALSE(recorder.Recording());
+
+  // Ignored once stopped
+  recorder.Add(press);
+
+  InputReplay replay;
+  ASSERT_TRUE(replay.Load(path));
+  ASSERT_EQ(2u, replay.Size());
+  EXPECT_FALSE(replay.Done());
+
+  // Events come out once due, in order
+  const auto pressTime = replay.NextTime();
+  auto events = replay.Take(pressTime);
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(RecordedInput::Kind::MOUSE, events[0].kind);
+  EXPECT_EQ(math::Vector2i(5, 6), events[0].mouse.Pos());
+
+  const auto keyTime = replay.NextTime();
+  EXPECT_GE(keyTime - pressTime, std::chrono::milliseconds(10));
+  EXPECT_TRUE(replay.Take(keyTime - std::chrono::nanoseconds(1)).empty());
+
+  events = replay.Take(keyTime);
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(RecordedInput::Kind::KEY_PRESS, events[0].kind);
+  EXPECT_EQ(65, events[0].key.Key());
+  EXPECT_TRUE(replay.Done());
+  EXPECT_GT(std::chrono::nanoseconds(0), replay.NextTime());
+  EXPECT_TRUE(replay.Take(std::chrono::hours(1)).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(InputRecordingTest, Malformed)
+{
+  const auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH), "test",
+      "input_recording", "malformed.txt");
+  ASSERT_TRUE(common::createDirectories(common::parentPath(path)));
+
+  InputReplay replay;
+  EXPECT_FALSE(replay.Load(path + ".missing"));
+
+  {
+    std::ofstream file(path);
+    file << "not a recording\n";
+  }
+  EXPECT_FALSE(replay.Load(path));
+
+  // Malformed lines are skipped
+  {
+    std::ofstream file(path);
+    file << "gz-gui-input 1\n"
+         << "mouse 10 1 0 0 1 2 0 0 0 0 0 0 1 0 0 0 0\n"
+         << "garbage\n"
+         << "key_press 20 1 65 0 0 0 \"a\"\n";
+  }
+  ASSERT_TRUE(replay.Load(path));
+  EXPECT_EQ(2u, replay.Size());
+  EXPECT_EQ(std::chrono::nanoseconds(10), replay.NextTime());
+}
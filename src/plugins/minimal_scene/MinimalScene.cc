@@ -16,44 +16,91 @@
 */
 
 #include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/diagnostics.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 
+#include "EnginePreload.hh"
+#include "FramePacer.hh"
+#include "InputRecording.hh"
 #include "MinimalScene.hh"
 #include "MinimalSceneRhi.hh"
+#include "MinimalSceneRhiHeadless.hh"
 #include "MinimalSceneRhiMetal.hh"
 #include "MinimalSceneRhiOpenGL.hh"
 #include "MinimalSceneRhiVulkan.hh"
+#include "QualityPresets.hh"
+#include "RenderWarmup.hh"
+#include "SharpenMaterial.hh"
+#include "TextureResizer.hh"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
 #include <list>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <regex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 #include <gz/common/KeyEvent.hh>
 #include <gz/common/MouseEvent.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/Frustum.hh>
+#include <gz/math/Pose3.hh>
 #include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector4.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/rendering/config.hh>
 #include <gz/rendering/Camera.hh>
+#include <gz/rendering/DirectionalLight.hh>
+#include <gz/rendering/Image.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/PixelFormat.hh>
 #include <gz/rendering/RayQuery.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
 #include <gz/rendering/Utils.hh>
 #include <gz/transport/Node.hh>
+#include <gz/transport/log/Playback.hh>
+#include <gz/transport/log/Recorder.hh>
+#include <gz/msgs/param.pb.h>
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/Conversions.hh"
+#include "gz/gui/FrameTaps.hh"
+#include "gz/gui/GpuUploads.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/Helpers.hh"
+#include "gz/gui/LatencyTrace.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/MemoryAccounting.hh"
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneCommands.hh"
+#include "gz/gui/SceneServices.hh"
+#include "gz/gui/SpawnAssets.hh"
+#include "gz/gui/StallWatchdog.hh"
+#include "gz/gui/StartupTrace.hh"
+
+#include <QAbstractListModel>
+#include <QScreen>
 
 #if GZ_GUI_HAVE_VULKAN
+#  include <QVulkanFunctions>
 #  include <QVulkanInstance>
 #  include <gz/rendering/RenderEngineVulkanExternalDeviceStructs.hh>
 #endif  // GZ_GUI_HAVE_VULKAN
@@ -62,15 +109,54 @@ Q_DECLARE_METATYPE(gz::gui::plugins::RenderSync*)
 
 namespace gz::gui::plugins
 {
+/// \brief Stages of GzRenderer::Render which are timed when frame timing is
+/// enabled
+enum FrameStage : std::size_t
+{
+  /// \brief Broadcasting mouse and keyboard events
+  kInputStage,
+
+  /// \brief Pre-render hooks and listeners
+  kPreRenderStage,
+
+  /// \brief Updating the scene and rendering the cameras
+  kCameraUpdateStage,
+
+  /// \brief Render hooks and listeners
+  kRenderStage,
+
+  /// \brief Handing the textures over to Qt
+  kTextureHandoffStage,
+
+  /// \brief Number of stages
+  kFrameStageCount
+};
+
+/// \brief Name each FrameStage is published with
+static const std::array<const char *, kFrameStageCount> kFrameStageNames{
+    "input", "pre_render", "camera_update", "render", "texture_handoff"};
+
+/// \brief Profiler sample name of each FrameStage
+static const std::array<const char *, kFrameStageCount> kFrameStageSamples{
+    "GzRenderer::Render input", "GzRenderer::Render pre_render",
+    "GzRenderer::Render camera_update", "GzRenderer::Render render",
+    "GzRenderer::Render texture_handoff"};
+
 /// \brief Private data class for GzRenderer
 class GzRenderer::Implementation
 {
+  /// \brief Loads the engine's library while the plugins are loaded
+  public: EnginePreload enginePreload;
+
   /// \brief Flag to indicate if mouse event is dirty
   public: bool mouseDirty{false};
 
   /// \brief Flag to indicate if hover event is dirty
   public: bool hoverDirty{false};
 
+  /// \brief Whether the first frame was rendered, for the startup trace
+  public: bool firstFrameRendered{false};
+
   /// \brief Flag to indicate if drop event is dirty
   public: bool dropDirty{false};
 
@@ -97,6 +183,23 @@ class GzRenderer::Implementation
   /// \brief User camera
   public: rendering::CameraPtr camera{nullptr};
 
+  /// \brief Cameras of the extra views, in the order of GzRenderer::views
+  public: std::vector<rendering::CameraPtr> viewCameras;
+
+  /// \brief Value of the camera's "zero-copy" user data, unset until the
+  /// first frame
+  public: std::optional<bool> zeroCopy;
+
+  /// \brief Number of frames rendered, see TapFrame::index
+  public: std::uint64_t frameIndex{0u};
+
+  /// \brief Image the camera is copied into for FrameTaps subscribers
+  public: std::optional<rendering::Image> tapImage;
+
+  /// \brief Last present time reported through the camera's
+  /// "present-time" user data, see RenderSync::lastFramePresent
+  public: int64_t lastFramePresent{0};
+
   /// \brief The currently hovered mouse position in screen coordinates
   public: math::Vector2i mouseHoverPos{math::Vector2i::Zero};
 
@@ -106,9 +209,48 @@ class GzRenderer::Implementation
   /// \brief The dropped text in the scene
   public: std::string dropText{""};
 
+  /// \brief Text being dragged over the scene, empty when nothing is
+  public: std::string spawnDragText;
+
+  /// \brief Position of the text being dragged in screen coordinates
+  public: math::Vector2i spawnDragPos{math::Vector2i::Zero};
+
+  /// \brief Box following the text dragged over the scene, kept hidden
+  /// once created. Only accessed from the render thread.
+  public: rendering::VisualPtr spawnPreview;
+
   /// \brief Ray query for mouse clicks
   public: rendering::RayQueryPtr rayQuery{nullptr};
 
+  /// \brief Result of the last ray query made for input events
+  public: struct Pick
+  {
+    /// \brief Position on the texture
+    math::Vector2i screenPos;
+
+    /// \brief Camera pose when it was made
+    math::Pose3d cameraPose;
+
+    /// \brief Value of inputFrame when it was made
+    std::uint64_t frame{0};
+
+    /// \brief Position in the scene
+    math::Vector3d scenePos;
+  };
+
+  /// \brief Last pick, reused while the mouse and camera are still
+  public: std::optional<Pick> lastPick;
+
+  /// \brief Number of times input events were handled
+  public: std::uint64_t inputFrame{0};
+
+  /// \brief Get the scene position under a point of the texture. A click
+  /// right after hovering the same point, without the camera moving, reuses
+  /// the hover's ray query instead of making a new one.
+  /// \param[in] _pos Position on the texture
+  /// \return Position in the scene
+  public: math::Vector3d ScreenToScene(const math::Vector2i &_pos);
+
   /// \brief View control focus target
   public: math::Vector3d target;
 
@@ -117,6 +259,155 @@ class GzRenderer::Implementation
 
   /// \brief Render hardware interface for the texture
   public: std::unique_ptr<GzCameraTextureRhi> rhi;
+
+  /// \brief Event sent every frame before rendering. It's created once and
+  /// reused so that rendering a frame doesn't allocate.
+  public: gui::events::PreRender preRenderEvent;
+
+  /// \brief Event sent every frame after rendering. It's created once and
+  /// reused so that rendering a frame doesn't allocate.
+  public: gui::events::Render renderEvent;
+
+  /// \brief Camera pose at the end of the previous frame, used to keep
+  /// rendering on demand scenes while the camera moves.
+  public: math::Pose3d lastCameraPose{math::Pose3d::Zero};
+
+  /// \brief Fraction of the item size the texture is currently rendered
+  /// at. Only changes when using dynamic resolution.
+  public: double resolutionScale{1.0};
+
+  /// \brief True to resize the texture without waiting for the size to be
+  /// stable, such as when the resolution scale changes
+  public: bool resizeNow{false};
+
+  /// \brief Decides when the texture is resized
+  public: TextureResizer textureResizer;
+
+  /// \brief Texture size over item size, on each axis. Differs from the
+  /// resolution scale while the texture is being resized or when its size
+  /// is rounded up.
+  public: math::Vector2d textureScale{1.0, 1.0};
+
+  /// \brief Moving average of the time it takes to render a frame, in
+  /// seconds. Negative until the first frame at the current resolution.
+  public: double avgFrameTime{-1.0};
+
+  /// \brief Number of consecutive frames the camera hasn't moved
+  public: unsigned int stillFrames{0u};
+
+  /// \brief Number of frames the camera must stay still before going back
+  /// to full resolution
+  public: const unsigned int kSettleFrames = 10u;
+
+  /// \brief How much the resolution scale changes at a time
+  public: const double kResolutionStep = 0.1;
+
+  /// \brief Protects `pendingQuality` and `qualityDirty`
+  public: std::mutex qualityMutex;
+
+  /// \brief Quality preset requested through GzRenderer::SetQuality
+  public: std::string pendingQuality;
+
+  /// \brief True if `pendingQuality` hasn't been applied yet
+  public: bool qualityDirty{false};
+
+  /// \brief Index of the quality preset applied, -1 if none
+  public: int qualityIndex{-1};
+
+  /// \brief Decides when to lower the quality preset
+  public: QualityGovernor qualityGovernor;
+
+  /// \brief Lights whose shadows were turned off by the quality preset
+  public: std::unordered_set<unsigned int> shadowsDisabled;
+
+  /// \brief Number of lights in the scene when shadows were last limited
+  public: unsigned int shadowLightCount{0u};
+
+  /// \brief Let at most some lights cast shadows, directional lights
+  /// first, and restore the shadows of lights which were turned off
+  /// before, if they fit now
+  /// \param[in] _scene Scene
+  /// \param[in] _max Most lights casting shadows
+  public: void LimitShadowLights(const rendering::ScenePtr &_scene,
+      unsigned int _max);
+
+  /// \brief View controller which has been requested and hasn't been
+  /// replied to yet
+  public: std::string pendingViewController;
+
+  /// \brief Protects viewControllerReply
+  public: std::mutex viewControllerMutex;
+
+  /// \brief Reply to the last view controller request: the requested
+  /// controller and whether it was set. Written from a transport thread and
+  /// handled on the render thread.
+  public: std::optional<std::pair<std::string, bool>> viewControllerReply;
+
+  /// \brief Time spent in each FrameStage since the last report
+  public: std::array<std::chrono::steady_clock::duration, kFrameStageCount>
+      stageTimes{};
+
+  /// \brief Time spent rendering frames since the last report
+  public: std::chrono::steady_clock::duration frameTimes{};
+
+  /// \brief GPU time of the measurements received since the last report,
+  /// in seconds
+  public: double gpuTimes{0.0};
+
+  /// \brief Number of GPU measurements received since the last report
+  public: unsigned int gpuSamples{0u};
+
+  /// \brief Number of frames timed since the last report
+  public: unsigned int timedFrames{0u};
+
+  /// \brief When the oldest mouse event not handled yet arrived. Protected
+  /// by `mutex`.
+  public: std::optional<std::chrono::steady_clock::time_point> inputTime;
+
+  /// \brief When the oldest mouse event handled by the current frame
+  /// arrived
+  public: std::optional<std::chrono::steady_clock::time_point>
+      frameInputTime;
+
+  /// \brief Time from mouse events arriving to the frames showing them
+  /// being handed over, since the last report
+  public: std::chrono::steady_clock::duration inputLatencies{};
+
+  /// \brief Number of frames which handled mouse events since the last
+  /// report
+  public: unsigned int inputFrames{0u};
+
+  /// \brief When frame timing was last reported
+  public: std::chrono::steady_clock::time_point lastTimingReport;
+
+  /// \brief How often frame timing is reported
+  public: const std::chrono::milliseconds kTimingReportPeriod{500};
+
+  /// \brief Publishes frame timing
+  public: transport::Node::Publisher frameTimingPub;
+
+  /// \brief Node used to request the view controller. Kept alive so its
+  /// discovery doesn't need to be set up again on the render thread, and
+  /// so that asynchronous replies can arrive. Declared after the
+  /// data its callbacks use, so it is destroyed first.
+  public: transport::Node node;
+
+  /// \brief Convert a position on the item to the matching position on the
+  /// texture, which is smaller when the resolution is scaled down, and
+  /// differs while the texture is being resized.
+  /// \param[in] _pos Position on the item
+  /// \return Position on the texture
+  public: math::Vector2i ToTexture(const math::Vector2i &_pos) const;
+
+  /// \brief Convert all positions in a mouse event with ToTexture
+  /// \param[in] _e Mouse event in item coordinates
+  /// \return Mouse event in texture coordinates
+  public: common::MouseEvent ToTexture(const common::MouseEvent &_e) const;
+
+  /// \brief Reports an estimate of the render textures' size, assuming 4
+  /// bytes per pixel, including the swap chain when decoupled
+  public: MemoryAccount textureMemory{"MinimalScene", "render textures",
+      MemoryType::GPU};
 };
 
 /// \brief Qt and Ogre rendering is happening in different threads
@@ -155,6 +446,13 @@ class GzRenderer::Implementation
 ///
 /// For more info see
 /// https://github.com/gazebosim/gz-rendering/issues/304
+///
+/// Optionally, the threads can be decoupled with a small swap chain
+/// (see bufferCount). In that mode the worker copies each finished frame
+/// into a buffer Qt is not displaying and publishes it, and Qt picks up the
+/// latest published buffer before drawing. The threads then only exchange
+/// texture handles under swapMutex, at the cost of the VRAM for the extra
+/// textures and one GPU copy per frame.
 class RenderSync
 {
   /// \brief Cond. variable to synchronize rendering on specific events
@@ -200,6 +498,151 @@ class RenderSync
 
   /// \brief Must be called from GUI thread when shutting down
   public: void Shutdown();
+
+  /// \brief Whether the worker and Qt threads run decoupled using a swap
+  /// chain, instead of being serialized.
+  /// \return True if bufferCount is larger than 1.
+  public: bool Decoupled() const;
+
+  /// \brief Must be called from worker thread to get the buffer it should
+  /// copy the next frame into. This is never the buffer Qt is displaying.
+  /// With only 2 buffers, a frame Qt hasn't picked up yet may be dropped.
+  /// \return Index of the buffer
+  public: int AcquireBackBuffer();
+
+  /// \brief Must be called from worker thread once a frame has been copied
+  /// into a buffer returned by AcquireBackBuffer.
+  /// \param[in] _index Buffer index
+  /// \param[in] _texturePtr Pointer to the buffer's texture Id
+  /// \param[in] _size Size of the buffer's texture
+  public: void PublishBuffer(int _index, void *_texturePtr,
+      const QSize &_size);
+
+  /// \brief Must be called from Qt thread before drawing. If a new frame
+  /// has been published, it becomes the front buffer.
+  /// \param[out] _texturePtr Pointer to the new front texture Id
+  /// \param[out] _size Size of the new front texture
+  /// \return True if there was a new frame
+  public: bool TakeReadyBuffer(void *&_texturePtr, QSize &_size);
+
+  /// \brief Ask for frames to be rendered when rendering on demand.
+  /// Thread safe.
+  /// \param[in] _count Minimum number of frames to render from now on
+  public: void RequestFrames(unsigned int _count);
+
+  /// \brief Check whether the next frame should be rendered and, if so,
+  /// consume one of the requested frames.
+  /// \return True if the next frame should be rendered. Always true when
+  /// rendering continuously.
+  public: bool ConsumeFrameRequest();
+
+  /// \brief True if there's no Qt thread to synchronize with, see
+  /// RenderWindowItem::StartHeadless. Must be set before rendering starts.
+  public: bool headless = false;
+
+  /// \brief Number of textures frames are rotated through. 1 (default)
+  /// serializes both threads as described above, 2 or 3 decouple them.
+  /// Must be set before rendering starts.
+  public: unsigned int bufferCount = 1u;
+
+  /// \brief Protects the swap chain state below
+  public: std::mutex swapMutex;
+
+  /// \brief Texture Id and size of each buffer in the swap chain
+  public: std::vector<std::pair<void *, QSize>> buffers
+      /*GUARDED_BY(swapMutex)*/;
+
+  /// \brief Buffer displayed by Qt, -1 if none
+  public: int frontBuffer = -1 /*GUARDED_BY(swapMutex)*/;
+
+  /// \brief Latest buffer published by the worker which Qt hasn't picked up
+  /// yet, -1 if none
+  public: int readyBuffer = -1 /*GUARDED_BY(swapMutex)*/;
+
+  /// \brief True while a frame request is queued or being rendered. Used
+  /// to coalesce requests from Qt when the threads are decoupled.
+  public: std::atomic<bool> renderPending{false};
+
+  /// \brief True to only render frames which have been requested with
+  /// RequestFrames. Must be set before the render thread starts.
+  public: bool renderOnDemand = false;
+
+  /// \brief Number of frames still to render when rendering on demand.
+  /// The first frame is always rendered.
+  public: std::atomic<unsigned int> requestedFrames{1u};
+
+  /// \brief Must be called from Qt thread. Get how long to wait before
+  /// requesting the next frame so frames aren't rendered faster than
+  /// maxFps.
+  /// \return Time to wait, zero if a frame can be requested now
+  public: std::chrono::milliseconds FrameCapDelay() const;
+
+  /// \brief Maximum frames per second, 0 for no limit. Must be set before
+  /// rendering starts.
+  public: double maxFps = 0.0;
+
+  /// \brief True while the scene can't be seen, see Plugin::Suspended
+  public: std::atomic<bool> hidden{false};
+
+  /// \brief Maximum frames per second while hidden, 0 to render none.
+  /// Must be set before rendering starts.
+  public: double hiddenFps = 1.0;
+
+  /// \brief When the Qt thread last requested a frame
+  public: std::chrono::steady_clock::time_point lastFrameRequest;
+
+  /// \brief True if a window update has been scheduled for when the frame
+  /// rate cap allows the next frame
+  public: std::atomic<bool> updateScheduled{false};
+
+  /// \brief Must be called from Qt's render thread after each buffer
+  /// swap, to follow the display refresh and report when new frames were
+  /// shown.
+  public: void Presented();
+
+  /// \brief Must be called from worker thread before rendering. When
+  /// pacing frames, sleeps until the frame should start so it's done just
+  /// before the display refresh at which Qt picks it up.
+  /// \return True if the frame is paced, in which case Rendered must be
+  /// called once it's done
+  public: bool WaitForFrameStart();
+
+  /// \brief Must be called from worker thread after a paced frame.
+  /// \param[in] _duration How long it took to render
+  public: void Rendered(std::chrono::steady_clock::duration _duration);
+
+  /// \brief Set the display's refresh rate. Thread safe.
+  /// \param[in] _hz Refresh rate, 0 if unknown
+  public: void SetRefreshRate(double _hz);
+
+  /// \brief True to start each frame at a predicted offset before the
+  /// display refresh. Only used when decoupled, since serialized threads
+  /// are already driven by Qt's vsync throttled loop. Must be set before
+  /// rendering starts.
+  public: bool vsyncPacing = false;
+
+  /// \brief Protects pacer
+  public: std::mutex pacerMutex;
+
+  /// \brief Predicts the display refresh, see FramePacer
+  public: FramePacer pacer /*GUARDED_BY(pacerMutex)*/;
+
+  /// \brief True from when Qt picks up a new frame until it's presented.
+  /// Only accessed from Qt's render thread.
+  public: bool framePending = false;
+
+  /// \brief When the last new frame was presented, in nanoseconds of the
+  /// steady clock, 0 until the first one
+  public: std::atomic<int64_t> lastFramePresent{0};
+
+  /// \brief Display refresh interval in nanoseconds, 0 if unknown
+  public: std::atomic<int64_t> refreshInterval{0};
+
+  /// \brief Texture Id and size of each extra view rendered in the last
+  /// frame. Written by the worker while rendering and read by
+  /// TextureNode::NewTexture on the worker thread right after, so it's
+  /// only accessed from the worker thread.
+  public: std::vector<std::pair<void *, QSize>> viewTextures;
 };
 
 /// \brief Private data class for RenderWindowItem
@@ -233,11 +676,180 @@ class gz::gui::plugins::RenderWindowItem::Implementation
 
   /// \brief List of our QT connections.
   public: QList<QMetaObject::Connection> connections;
+
+  /// \brief Called on the main thread once the first frame is ready, then
+  /// cleared
+  public: std::function<void()> firstFrameCb;
+
+  /// \brief Priority and CPUs of the render thread
+  public: ThreadPolicy renderThreadPolicy;
+
+  /// \brief See \<render_scale\>
+  public: double renderScale{1.0};
+
+  /// \brief True if renderScale is relative to physical pixels
+  public: bool renderScaleDevicePixels{false};
+
+  /// \brief Sharpening strength while the texture is upscaled
+  public: float sharpen{0.0f};
+
+  /// \brief True if rendering without a window, see \<headless\>
+  public: bool headless{false};
+
+  /// \brief Node receiving remote input, see \<input_topic\>
+  public: transport::Node node;
+
+  /// \brief File of input events to record or replay, see
+  /// \<input_recording\>. Empty for neither.
+  public: std::string inputPath;
+
+  /// \brief Transport log to record or replay, empty for none
+  public: std::string transportLogPath;
+
+  /// \brief Topics to record into transportLogPath
+  public: std::vector<std::string> transportTopics;
+
+  /// \brief Records transport msgs while recording input
+  public: std::unique_ptr<transport::log::Recorder> transportRecorder;
+
+  /// \brief Events being replayed, empty while recording
+  public: InputReplay inputReplay;
+
+  /// \brief Labels last handed to labelsCb
+  public: std::vector<PlacedLabel> placedLabels;
+
+  /// \brief True to close the application once the replay is done
+  public: bool quitAfterReplay{false};
+
+  /// \brief When the replay started
+  public: std::chrono::steady_clock::time_point replayStart;
+
+  /// \brief Fires when the next replayed event is due
+  public: QTimer replayTimer;
+
+  /// \brief Publishes the transport msgs of the replay
+  public: std::unique_ptr<transport::log::Playback> transportPlayback;
+
+  /// \brief Handle of the transport replay, null if there's none
+  public: transport::log::PlaybackHandlePtr playbackHandle;
+
+  /// \brief Wakes up the scene when rendering on demand. Last member so
+  /// it's destroyed first.
+  public: RenderHookConnectionPtr renderRequestConnection;
+};
+
+/// \brief Labels shown over the scene, for QML. Rows are updated in place
+/// so their delegates are reused from frame to frame.
+class SceneLabelModel : public QAbstractListModel
+{
+  /// \brief Roles of the label properties
+  public: enum Role
+  {
+    /// \brief Text, QString
+    kTextRole = Qt::UserRole + 1,
+
+    /// \brief Horizontal position of the anchor, fraction of the width
+    kXRole,
+
+    /// \brief Vertical position of the anchor, fraction of the height
+    kYRole,
+
+    /// \brief Color, QColor
+    kColorRole
+  };
+
+  // Documentation inherited
+  public: int rowCount(const QModelIndex &_parent) const override
+  {
+    return _parent.isValid() ? 0 : static_cast<int>(this->labels.size());
+  }
+
+  // Documentation inherited
+  public: QVariant data(const QModelIndex &_index, int _role) const override
+  {
+    if (!_index.isValid() ||
+        _index.row() >= static_cast<int>(this->labels.size()))
+    {
+      return QVariant();
+    }
+
+    const auto &label = this->labels[static_cast<std::size_t>(_index.row())];
+    switch (_role)
+    {
+      case kTextRole:
+        return QString::fromStdString(label.text);
+      case kXRole:
+        return this->width > 0 ? label.position.X() / this->width : 0.0;
+      case kYRole:
+        return this->height > 0 ? label.position.Y() / this->height : 0.0;
+      case kColorRole:
+        return gz::gui::convert(label.color);
+      default:
+        return QVariant();
+    }
+  }
+
+  // Documentation inherited
+  public: QHash<int, QByteArray> roleNames() const override
+  {
+    return {{kTextRole, "labelText"}, {kXRole, "labelX"},
+        {kYRole, "labelY"}, {kColorRole, "labelColor"}};
+  }
+
+  /// \brief Replace the labels
+  /// \param[in] _labels Labels placed on the screen
+  /// \param[in] _width Screen width in pixels
+  /// \param[in] _height Screen height in pixels
+  public: void Set(std::vector<PlacedLabel> _labels, unsigned int _width,
+      unsigned int _height)
+  {
+    const int oldCount = static_cast<int>(this->labels.size());
+    const int newCount = static_cast<int>(_labels.size());
+    if (newCount < oldCount)
+    {
+      this->beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+      this->labels.resize(_labels.size());
+      this->endRemoveRows();
+    }
+
+    const int kept = std::min(oldCount, newCount);
+    this->width = _width;
+    this->height = _height;
+    for (int i = 0; i < kept; ++i)
+      this->labels[i] = std::move(_labels[i]);
+    if (kept > 0)
+      emit this->dataChanged(this->index(0), this->index(kept - 1));
+
+    if (newCount > oldCount)
+    {
+      this->beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+      for (int i = oldCount; i < newCount; ++i)
+        this->labels.push_back(std::move(_labels[i]));
+      this->endInsertRows();
+    }
+  }
+
+  /// \brief Labels placed on the screen
+  private: std::vector<PlacedLabel> labels;
+
+  /// \brief Screen width in pixels
+  private: double width{0.0};
+
+  /// \brief Screen height in pixels
+  private: double height{0.0};
 };
 
 /// \brief Private data class for MinimalScene
 class gz::gui::plugins::MinimalScene::Implementation
 {
+  /// \brief Labels shown over the scene
+  public: SceneLabelModel labels;
+
+  /// \brief True to preview text dragged over the scene
+  public: bool spawnPreview{true};
+
+  /// \brief Text being dragged over the scene, empty when nothing is
+  public: QString dragText;
 };
 
 QList<QThread *> RenderWindowItem::Implementation::threads;
@@ -301,900 +913,2311 @@ void RenderSync::Shutdown()
 }
 
 /////////////////////////////////////////////////
-GzRenderer::GzRenderer()
-  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+bool RenderSync::Decoupled() const
 {
-  const std::string backendApiName = gz::gui::renderEngineBackendApiName();
-  if (backendApiName == "vulkan")
-  {
-    this->SetGraphicsAPI(rendering::GraphicsAPI::VULKAN);
-  }
-  else if (backendApiName == "metal")
-  {
-    this->SetGraphicsAPI(rendering::GraphicsAPI::METAL);
-  }
-  else
-  {
-    this->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
-  }
+  return this->bufferCount > 1u;
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::Render(RenderSync *_renderSync,
-                        RenderThreadRhi &_renderThreadRhi)
+int RenderSync::AcquireBackBuffer()
 {
-  std::unique_lock<std::mutex> lock(_renderSync->mutex);
-  _renderSync->WaitForQtThreadAndBlock(lock);
+  std::lock_guard<std::mutex> lock(this->swapMutex);
 
-  if (this->textureDirty)
+  if (this->buffers.size() != this->bufferCount)
+    this->buffers.resize(this->bufferCount, {nullptr, QSize()});
+
+  for (int i = 0; i < static_cast<int>(this->bufferCount); ++i)
   {
-    // TODO(anyone) If SwapFromThread gets implemented,
-    // then we only need to lock when texture is dirty
-    // (but we still need to lock the whole routine if
-    // debugging from RenderDoc or if user is not willing
-    // to sacrifice VRAM)
-    //
-    // std::unique_lock<std::mutex> lock(renderSync->mutex);
-    // _renderSync->WaitForQtThreadAndBlock(lock);
-    this->dataPtr->camera->SetImageWidth(this->textureSize.width());
-    this->dataPtr->camera->SetImageHeight(this->textureSize.height());
-    this->dataPtr->camera->SetHFOV(this->cameraHFOV);
-    // setting the size should cause the render texture to be rebuilt
-    this->dataPtr->camera->PreRender();
-    this->textureDirty = false;
+    if (i != this->frontBuffer && i != this->readyBuffer)
+      return i;
+  }
+
+  // All other buffers are taken, so Qt hasn't consumed the last frame yet.
+  // Drop it in favor of the one about to be copied.
+  const int index = this->readyBuffer;
+  this->readyBuffer = -1;
+  return index;
+}
 
-    // TODO(anyone) See SwapFromThread comments
-    // _renderSync->ReleaseQtThreadFromBlock(lock);
+/////////////////////////////////////////////////
+void RenderSync::PublishBuffer(int _index, void *_texturePtr,
+    const QSize &_size)
+{
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  if (_index < 0 || _index >= static_cast<int>(this->buffers.size()) ||
+      nullptr == _texturePtr)
+  {
+    return;
   }
 
-  // Update the render interface (texture)
-  _renderThreadRhi.Update(this->dataPtr->camera);
+  this->buffers[_index] = {_texturePtr, _size};
+  this->readyBuffer = _index;
+}
 
-  // view control
-  this->HandleMouseEvent();
+/////////////////////////////////////////////////
+bool RenderSync::TakeReadyBuffer(void *&_texturePtr, QSize &_size)
+{
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  if (this->readyBuffer < 0)
+    return false;
+
+  this->frontBuffer = this->readyBuffer;
+  this->readyBuffer = -1;
+  _texturePtr = this->buffers[this->frontBuffer].first;
+  _size = this->buffers[this->frontBuffer].second;
+  return true;
+}
 
-  if (gz::gui::App())
+/////////////////////////////////////////////////
+void RenderSync::RequestFrames(unsigned int _count)
+{
+  unsigned int current = this->requestedFrames;
+  while (current < _count &&
+      !this->requestedFrames.compare_exchange_weak(current, _count))
   {
-    gz::gui::App()->sendEvent(
-        gz::gui::App()->findChild<gz::gui::MainWindow *>(),
-        new gui::events::PreRender());
   }
+}
 
-  // update and render to texture
-  this->dataPtr->camera->Update();
+/////////////////////////////////////////////////
+bool RenderSync::ConsumeFrameRequest()
+{
+  if (!this->renderOnDemand)
+    return true;
 
-  if (!this->cameraViewController.empty())
+  unsigned int current = this->requestedFrames;
+  while (current > 0u &&
+      !this->requestedFrames.compare_exchange_weak(current, current - 1u))
   {
-    std::string viewControlService = "/gui/camera/view_control";
-    transport::Node node;
-    std::function<void(const msgs::Boolean &, const bool)> cb =
-        [&](const msgs::Boolean &/*_rep*/, const bool _result)
-    {
-      if (!_result)
-      {
-        // LCOV_EXCL_START
-        gzerr << "Error setting view controller. Check if the View Angle GUI "
-                 "plugin is loaded." << std::endl;
-        // LCOV_EXCL_STOP
-      }
-      this->cameraViewController = "";
-    };
-
-    msgs::StringMsg req;
-    req.set_data(this->cameraViewController);
-    node.Request(viewControlService, req, cb);
   }
+  return current > 0u;
+}
 
-  if (gz::gui::App())
+/////////////////////////////////////////////////
+std::chrono::milliseconds RenderSync::FrameCapDelay() const
+{
+  double fps = this->maxFps;
+  if (this->hidden && this->hiddenFps > 0.0 &&
+      (fps <= 0.0 || this->hiddenFps < fps))
   {
-    gz::gui::App()->sendEvent(
-        gz::gui::App()->findChild<gz::gui::MainWindow *>(),
-        new gui::events::Render());
+    fps = this->hiddenFps;
   }
-  _renderSync->ReleaseQtThreadFromBlock(lock);
+  if (fps <= 0.0)
+    return std::chrono::milliseconds(0);
+
+  const auto period = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / fps));
+  const auto now = std::chrono::steady_clock::now();
+  const auto next = this->lastFrameRequest + period;
+  if (now >= next)
+    return std::chrono::milliseconds(0);
+
+  return std::chrono::ceil<std::chrono::milliseconds>(next - now);
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::HandleMouseEvent()
+void RenderSync::Presented()
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (const auto &e : this->dataPtr->mouseEvents)
+  const auto now = std::chrono::steady_clock::now();
   {
-    this->dataPtr->mouseEvent = e;
-
-    this->BroadcastDrag();
-    this->BroadcastMousePress();
-    this->BroadcastLeftClick();
-    this->BroadcastRightClick();
-    this->BroadcastScroll();
-    this->BroadcastKeyPress();
-    this->BroadcastKeyRelease();
+    std::lock_guard<std::mutex> lock(this->pacerMutex);
+    this->pacer.Presented(now);
   }
-  this->dataPtr->mouseEvents.clear();
 
-  this->BroadcastHoverPos();
-  this->BroadcastDrop();
-  this->dataPtr->mouseDirty = false;
+  if (this->framePending)
+  {
+    this->framePending = false;
+    this->lastFramePresent = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(now.time_since_epoch()).count();
+  }
 }
 
-////////////////////////////////////////////////
-void GzRenderer::HandleKeyPress(const common::KeyEvent &_e)
+/////////////////////////////////////////////////
+bool RenderSync::WaitForFrameStart()
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->keyEvent = _e;
+  // Hidden frames aren't shown, so there's nothing to align them with
+  if (!this->vsyncPacing || !this->Decoupled() || this->hidden)
+    return false;
 
-  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
-  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
-  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
+  std::chrono::steady_clock::time_point start;
+  {
+    std::lock_guard<std::mutex> lock(this->pacerMutex);
+    start = this->pacer.NextStart(std::chrono::steady_clock::now());
+  }
+  std::this_thread::sleep_until(start);
+  return true;
 }
 
-////////////////////////////////////////////////
-void GzRenderer::HandleKeyRelease(const common::KeyEvent &_e)
+/////////////////////////////////////////////////
+void RenderSync::Rendered(std::chrono::steady_clock::duration _duration)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->keyEvent = _e;
-
-  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
-  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
-  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
+  std::lock_guard<std::mutex> lock(this->pacerMutex);
+  this->pacer.Rendered(_duration);
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastDrop()
+void RenderSync::SetRefreshRate(double _hz)
 {
-  if (!this->dataPtr->dropDirty)
-    return;
-  events::DropOnScene dropOnSceneEvent(
-    this->dataPtr->dropText, this->dataPtr->mouseDropPos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &dropOnSceneEvent);
-  this->dataPtr->dropDirty = false;
+  const auto interval = _hz > 0.0 ?
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / _hz)) :
+      std::chrono::steady_clock::duration::zero();
+  {
+    std::lock_guard<std::mutex> lock(this->pacerMutex);
+    this->pacer.SetRefreshInterval(interval);
+  }
+  this->refreshInterval = std::chrono::duration_cast<
+      std::chrono::nanoseconds>(interval).count();
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastHoverPos()
+void GzRenderer::Implementation::LimitShadowLights(
+    const rendering::ScenePtr &_scene, unsigned int _max)
 {
-  if (!this->dataPtr->hoverDirty)
-    return;
-
-  auto pos = rendering::screenToScene(this->dataPtr->mouseHoverPos,
-      this->dataPtr->camera, this->dataPtr->rayQuery, 1000);
-
-  events::HoverToScene hoverToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverToSceneEvent);
-
-  common::MouseEvent hoverMouseEvent = this->dataPtr->mouseEvent;
-  hoverMouseEvent.SetPos(this->dataPtr->mouseHoverPos);
-  hoverMouseEvent.SetDragging(false);
-  hoverMouseEvent.SetType(common::MouseEvent::MOVE);
-  events::HoverOnScene hoverOnSceneEvent(hoverMouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverOnSceneEvent);
+  std::vector<rendering::LightPtr> casters;
+  for (unsigned int i = 0; i < _scene->LightCount(); ++i)
+  {
+    auto light = _scene->LightByIndex(i);
+    if (nullptr != light && (light->CastShadows() ||
+        this->shadowsDisabled.count(light->Id()) > 0))
+    {
+      casters.push_back(light);
+    }
+  }
+  std::stable_partition(casters.begin(), casters.end(),
+      [](const rendering::LightPtr &_light)
+      {
+        return nullptr !=
+            std::dynamic_pointer_cast<rendering::DirectionalLight>(_light);
+      });
 
-  this->dataPtr->hoverDirty = false;
+  // Rebuilt so lights removed from the scene are forgotten
+  this->shadowsDisabled.clear();
+  for (std::size_t i = 0; i < casters.size(); ++i)
+  {
+    const bool cast = i < _max;
+    if (casters[i]->CastShadows() != cast)
+      casters[i]->SetCastShadows(cast);
+    if (!cast)
+      this->shadowsDisabled.insert(casters[i]->Id());
+  }
+  this->shadowLightCount = _scene->LightCount();
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastDrag()
+math::Vector2i GzRenderer::Implementation::ToTexture(
+    const math::Vector2i &_pos) const
 {
-  if (!this->dataPtr->mouseDirty)
-    return;
-
-  // Only broadcast drag if dragging
-  if (!this->dataPtr->mouseEvent.Dragging())
-    return;
+  if (this->textureScale == math::Vector2d::One)
+    return _pos;
 
-  events::DragOnScene dragEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &dragEvent);
+  return math::Vector2i(
+      static_cast<int>(std::lround(_pos.X() * this->textureScale.X())),
+      static_cast<int>(std::lround(_pos.Y() * this->textureScale.Y())));
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastLeftClick()
-{
-  if (!this->dataPtr->mouseDirty)
-    return;
-
-  if (this->dataPtr->mouseEvent.Button() != common::MouseEvent::LEFT ||
-      this->dataPtr->mouseEvent.Type() != common::MouseEvent::RELEASE)
-    return;
-
-  auto pos = rendering::screenToScene(this->dataPtr->mouseEvent.Pos(),
-      this->dataPtr->camera, this->dataPtr->rayQuery, 1000);
-
-  events::LeftClickToScene leftClickToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickToSceneEvent);
-
-  events::LeftClickOnScene leftClickOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickOnSceneEvent);
-}
-
-/////////////////////////////////////////////////
-void GzRenderer::BroadcastRightClick()
-{
-  if (!this->dataPtr->mouseDirty)
-    return;
-
-  if (this->dataPtr->mouseEvent.Button() != common::MouseEvent::RIGHT ||
-      this->dataPtr->mouseEvent.Type() != common::MouseEvent::RELEASE)
-    return;
-
-  auto pos = rendering::screenToScene(this->dataPtr->mouseEvent.Pos(),
-      this->dataPtr->camera, this->dataPtr->rayQuery, 1000);
-
-  events::RightClickToScene rightClickToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickToSceneEvent);
-
-  events::RightClickOnScene rightClickOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickOnSceneEvent);
-}
-
-/////////////////////////////////////////////////
-void GzRenderer::BroadcastMousePress()
+common::MouseEvent GzRenderer::Implementation::ToTexture(
+    const common::MouseEvent &_e) const
 {
-  if (!this->dataPtr->mouseDirty)
-    return;
-
-  if (this->dataPtr->mouseEvent.Type() != common::MouseEvent::PRESS)
-    return;
-
-  events::MousePressOnScene event(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &event);
+  if (this->textureScale == math::Vector2d::One)
+    return _e;
+
+  common::MouseEvent e = _e;
+  e.SetPos(this->ToTexture(_e.Pos()));
+  e.SetPrevPos(this->ToTexture(_e.PrevPos()));
+  e.SetPressPos(this->ToTexture(_e.PressPos()));
+  return e;
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastScroll()
+/// \brief Size of the texture of an extra view
+/// \param[in] _view The view
+/// \param[in] _itemSize Size of the item displaying the main texture
+/// \return Texture size
+static QSize viewSize(const SceneView &_view, const QSize &_itemSize)
 {
-  if (!this->dataPtr->mouseDirty)
-    return;
-
-  if (this->dataPtr->mouseEvent.Type() != common::MouseEvent::SCROLL)
-    return;
-
-  events::ScrollOnScene scrollOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &scrollOnSceneEvent);
+  return QSize(
+      std::max(1, static_cast<int>(
+          std::lround(_itemSize.width() * _view.rect.Z()))),
+      std::max(1, static_cast<int>(
+          std::lround(_itemSize.height() * _view.rect.W()))));
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastKeyRelease()
+GzRenderer::GzRenderer()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
 {
-  if (this->dataPtr->keyEvent.Type() != common::KeyEvent::RELEASE)
-    return;
-
-  events::KeyReleaseOnScene keyRelease(this->dataPtr->keyEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &keyRelease);
-
-  this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
+  const std::string backendApiName = gz::gui::renderEngineBackendApiName();
+  if (backendApiName == "vulkan")
+  {
+    this->SetGraphicsAPI(rendering::GraphicsAPI::VULKAN);
+  }
+  else if (backendApiName == "metal")
+  {
+    this->SetGraphicsAPI(rendering::GraphicsAPI::METAL);
+  }
+  else
+  {
+    this->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+  }
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastKeyPress()
+void GzRenderer::Render(RenderSync *_renderSync,
+                        RenderThreadRhi &_renderThreadRhi)
 {
-  if (this->dataPtr->keyEvent.Type() != common::KeyEvent::PRESS)
-    return;
-
-  events::KeyPressOnScene keyPress(this->dataPtr->keyEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &keyPress);
-
-  this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
-}
+  // When decoupled, Qt only ever samples the swap chain textures, never the
+  // camera's own texture, so the camera can render (and even be resized)
+  // without waiting for the Qt thread.
+  std::unique_lock<std::mutex> lock(_renderSync->mutex, std::defer_lock);
+  if (!_renderSync->Decoupled() && !_renderSync->headless)
+  {
+    lock.lock();
+    _renderSync->WaitForQtThreadAndBlock(lock);
+  }
 
-/////////////////////////////////////////////////
-rendering::CameraPtr GzRenderer::Camera()
-{
-  return this->dataPtr->camera;
-}
+  const auto frameStart = std::chrono::steady_clock::now();
+  GZ_GUI_PROFILE("GzRenderer::Render");
 
-#if GZ_GUI_HAVE_VULKAN
-namespace {
-/////////////////////////////////////////////////
-/// \brief fillQtInstanceExtensionsToOgre
-/// Extract Vulkan Instance extension information to be sent to OgreNext
-/// \param[in] inst Qt's Vulkan Instance to extract
-/// \param[out] externalInstance Data to be sent to OgreNext
-void fillQtInstanceExtensionsToOgre(
-  const QVulkanInstance *inst,
-  rendering::GzVulkanExternalInstance &externalInstance)
-{
+  // While the item is being resized, keep rendering at the old size and
+  // let Qt stretch the texture, until the size is stable
+  auto &resizer = this->dataPtr->textureResizer;
+  if (this->textureDirty)
   {
-    QByteArrayList extensions = inst->extensions();
-
-    for (const auto &ext : extensions)
-    {
-      externalInstance.instanceExtensions.push_back(VkExtensionProperties{});
-      VkExtensionProperties &extProp =
-        externalInstance.instanceExtensions.back();
-      strncpy(extProp.extensionName, ext.constData(),
-              VK_MAX_EXTENSION_NAME_SIZE);
-      extProp.extensionName[VK_MAX_EXTENSION_NAME_SIZE - 1u] = 0;
-    }
+    const double scale = this->dataPtr->resolutionScale * this->renderScale;
+    resizer.SetDelay(this->resizeDelay);
+    resizer.SetStep(this->textureSizeStep);
+    resizer.Request(math::Vector2i(
+        static_cast<int>(std::lround(this->itemSize.width() * scale)),
+        static_cast<int>(std::lround(this->itemSize.height() * scale))),
+        frameStart, this->dataPtr->resizeNow);
+    this->dataPtr->resizeNow = false;
+    this->dataPtr->camera->SetHFOV(this->cameraHFOV);
+    this->textureDirty = false;
   }
 
+  if (auto newSize = resizer.Update(frameStart))
   {
-    QByteArrayList layers = inst->layers();
+    this->textureSize = QSize(newSize->X(), newSize->Y());
 
-    for (const auto &layer : layers)
+    // Only rebuild render textures whose size changed. Qt keeps sampling a
+    // texture for as long as its handle and size are the same, so a texture
+    // must never be rebuilt at the same size.
+    auto resize = [](rendering::CameraPtr &_camera, const QSize &_size)
     {
-      externalInstance.instanceLayers.push_back(VkLayerProperties{});
-      VkLayerProperties &layerProp = externalInstance.instanceLayers.back();
-      strncpy(layerProp.layerName, layer.constData(),
-              VK_MAX_EXTENSION_NAME_SIZE);
-      layerProp.layerName[VK_MAX_EXTENSION_NAME_SIZE - 1u] = 0;
+      if (_camera->ImageWidth() == static_cast<unsigned int>(_size.width()) &&
+          _camera->ImageHeight() == static_cast<unsigned int>(_size.height()))
+      {
+        return;
+      }
+      _camera->SetImageWidth(_size.width());
+      _camera->SetImageHeight(_size.height());
+      // setting the size should cause the render texture to be rebuilt
+      _camera->PreRender();
+    };
+    resize(this->dataPtr->camera, this->textureSize);
+
+    for (std::size_t i = 0; i < this->dataPtr->viewCameras.size(); ++i)
+    {
+      resize(this->dataPtr->viewCameras[i],
+          viewSize(this->views[i], this->itemSize));
     }
+
+    std::size_t pixels = static_cast<std::size_t>(this->textureSize.width()) *
+        static_cast<std::size_t>(this->textureSize.height());
+    if (_renderSync->Decoupled())
+      pixels *= 1u + _renderSync->bufferCount;
+    for (const auto &viewCamera : this->dataPtr->viewCameras)
+      pixels += viewCamera->ImageWidth() * viewCamera->ImageHeight();
+    this->dataPtr->textureMemory.Set(pixels * 4u);
   }
-}
+  else if (resizer.Pending())
+  {
+    // Come back once the size may be stable
+    _renderSync->RequestFrames(1u);
+  }
+  this->dataPtr->textureScale.Set(
+      static_cast<double>(this->textureSize.width()) /
+      std::max(1, this->itemSize.width()),
+      static_cast<double>(this->textureSize.height()) /
+      std::max(1, this->itemSize.height()));
 
-/////////////////////////////////////////////////
-/// \brief fillQtDeviceExtensionsToOgre
-/// Extract Vulkan Device extension info to be sent to OgreNext
-/// This data is obtained from Environment variables
-/// \param[out] externalDevice Data to be sent to OgreNext
-void fillQtDeviceExtensionsToOgre(
-  rendering::GzVulkanExternalDevice &externalDevice)
-{
-  // We know Qt adds these by looking at
-  //  qt-everywhere-src-5.15.2/qtbase/src/gui/rhi/qrhivulkan.cpp
-  QVector<QString> deviceExtensions;
-  deviceExtensions.append("VK_KHR_swapchain");
+  // Update the render interface (texture)
+  _renderThreadRhi.Update(this->dataPtr->camera);
 
-  QByteArray envExts = qgetenv("QT_VULKAN_DEVICE_EXTENSIONS");
-  if (!envExts.isEmpty())
+  // Let plugins like CameraFps know whether Qt samples the camera's texture
+  // directly. The swap chain copies every frame into another texture.
+  const bool zeroCopy = !_renderSync->Decoupled() &&
+      _renderThreadRhi.ZeroCopy(this->dataPtr->camera);
+  if (this->dataPtr->zeroCopy != zeroCopy)
   {
-    QByteArrayList envExtList = envExts.split(';');
-    for (const auto &ext : envExtList)
-    {
-      if (!ext.isEmpty())
-      {
-        deviceExtensions.append(ext);
-      }
-    }
+    this->dataPtr->zeroCopy = zeroCopy;
+    this->dataPtr->camera->SetUserData("zero-copy", zeroCopy);
   }
 
-  for (const auto &ext : deviceExtensions)
+  // And when the last frames were shown, to measure how evenly they're
+  // paced on screen rather than in this thread
+  const int64_t presented = _renderSync->lastFramePresent;
+  if (presented != this->dataPtr->lastFramePresent)
   {
-    externalDevice.deviceExtensions.push_back(VkExtensionProperties{});
-    VkExtensionProperties &extProp = externalDevice.deviceExtensions.back();
-    strncpy(extProp.extensionName, ext.toStdString().c_str(),
-            VK_MAX_EXTENSION_NAME_SIZE - 1u);
-    extProp.extensionName[VK_MAX_EXTENSION_NAME_SIZE - 1u] = 0;
+    this->dataPtr->lastFramePresent = presented;
+    this->dataPtr->camera->SetUserData("present-time", presented * 1e-9);
+    this->dataPtr->camera->SetUserData("refresh-interval",
+        _renderSync->refreshInterval * 1e-9);
   }
-}
-}  // namespace
-#endif  // GZ_GUI_HAVE_VULKAN
-
-/////////////////////////////////////////////////
-std::string GzRenderer::Initialize(RenderThreadRhi &_rhi)
-{
-  if (this->initialized)
-    return {};
 
-  // Currently only support one engine at a time
-  rendering::RenderEngine *engine{nullptr};
-  auto loadedEngines = rendering::loadedEngines();
+  // Profiler sample of the current stage, ended before the next one starts
+  static std::array<uint32_t, kFrameStageCount> stageHashes{};
+  std::optional<ProfileZone> stageZone;
+  stageZone.emplace(kFrameStageSamples[kInputStage],
+      &stageHashes[kInputStage]);
 
-  // Load engine if there's no engine yet
-  if (loadedEngines.empty())
+  // Time spent in each stage, see ReportFrameTiming
+  auto stageStart = std::chrono::steady_clock::now();
+  auto endStage = [this, &stageStart, &stageZone](FrameStage _stage)
   {
-    QQuickWindow *quickWindow =
-      gz::gui::App()->findChild<gz::gui::MainWindow *>()->QuickWindow();
+    stageZone.reset();
+    if (_stage + 1 < kFrameStageCount)
+    {
+      stageZone.emplace(kFrameStageSamples[_stage + 1],
+          &stageHashes[_stage + 1]);
+    }
 
-    this->dataPtr->rhiParams["winID"] = std::to_string(quickWindow->winId());
+    if (!this->frameTiming)
+      return;
+    const auto now = std::chrono::steady_clock::now();
+    this->dataPtr->stageTimes[_stage] += now - stageStart;
+    stageStart = now;
+  };
 
-#if GZ_GUI_HAVE_VULKAN
-    // externalInstance & externalDevice MUST be declared at this scope
-    // because we save their stack addresses into this->dataPtr->rhiParams
-    // and must be alive until rendering::engine() returns.
-    rendering::GzVulkanExternalInstance externalInstance;
-    rendering::GzVulkanExternalDevice externalDevice;
-    if (this->dataPtr->rhiParams.find("vulkan") !=
-        this->dataPtr->rhiParams.end())
-    {
-      QSGRendererInterface *qtRenderInterface =
-        quickWindow->rendererInterface();
+  this->ApplyQuality();
 
-      const QVulkanInstance *inst = reinterpret_cast<const QVulkanInstance *>(
-        qtRenderInterface->getResource(
-          quickWindow, QSGRendererInterface::VulkanInstanceResource));
-      GZ_ASSERT(inst && inst->isValid(), "Invalid QVulkanInstance!");
+  // view control
+  this->HandleMouseEvent();
+  endStage(kInputStage);
 
-      externalInstance.instance = inst->vkInstance();
+  gui::SceneCommands::Run(this->sceneCommandBudget);
 
-      externalDevice.physicalDevice =
-        *reinterpret_cast<VkPhysicalDevice *>(qtRenderInterface->getResource(
-          quickWindow, QSGRendererInterface::PhysicalDeviceResource));
-      externalDevice.device =
-        *reinterpret_cast<VkDevice *>(qtRenderInterface->getResource(
-          quickWindow, QSGRendererInterface::DeviceResource));
-      externalDevice.graphicsQueue =
-        *reinterpret_cast<VkQueue *>(qtRenderInterface->getResource(
-          quickWindow, QSGRendererInterface::CommandQueueResource));
-      externalDevice.presentQueue = externalDevice.graphicsQueue;
+  // What the camera sees is uploaded first
+  auto &camera = this->dataPtr->camera;
+  gui::GpuUploads::SetView(math::Frustum(camera->NearClipPlane(),
+      camera->FarClipPlane(), camera->HFOV(), camera->AspectRatio(),
+      camera->WorldPose()));
+  gui::GpuUploads::Run(this->gpuUploadBudget);
 
-      fillQtInstanceExtensionsToOgre(inst, externalInstance);
-      fillQtDeviceExtensionsToOgre(externalDevice);
+  gui::RenderHooks::RunPreRender();
+  if (gz::gui::App())
+  {
+    this->dataPtr->preRenderEvent.setAccepted(true);
+    gz::gui::App()->sendEvent(
+        gz::gui::App()->findChild<gz::gui::MainWindow *>(),
+        &this->dataPtr->preRenderEvent);
+  }
+  endStage(kPreRenderStage);
 
-      this->dataPtr->rhiParams["external_instance"] =
-        std::to_string(reinterpret_cast<uintptr_t>(&externalInstance));
-      this->dataPtr->rhiParams["external_device"] =
-        std::to_string(reinterpret_cast<uintptr_t>(&externalDevice));
-    }
-#endif
+  if (this->frameTiming)
+    _renderThreadRhi.BeginGpuTimer();
 
-    engine = rendering::engine(this->engineName, this->dataPtr->rhiParams);
+  // update and render to texture
+  if (this->dataPtr->viewCameras.empty())
+  {
+    this->dataPtr->camera->Update();
   }
   else
   {
-    if (!this->engineName.empty() && loadedEngines.front() != this->engineName)
+    // Same as Camera::Update, but the scene is only updated and flushed once
+    // for all views
+    rendering::ScenePtr scene = this->dataPtr->camera->Scene();
+    scene->PreRender();
+    this->dataPtr->camera->Render();
+    this->dataPtr->camera->PostRender();
+    for (auto &viewCamera : this->dataPtr->viewCameras)
     {
-      gzwarn << "Failed to load engine [" << this->engineName
-             << "]. Using engine [" << loadedEngines.front()
-             << "], which is already loaded. Currently only one engine is "
-             << "supported at a time." << std::endl;
+      viewCamera->Render();
+      viewCamera->PostRender();
     }
-    this->engineName = loadedEngines.front();
-    engine = rendering::engine(loadedEngines.front());
+    if (!scene->LegacyAutoGpuFlush())
+      scene->PostRender();
   }
 
-  if (engine == nullptr)
+  if (this->frameTiming)
+    _renderThreadRhi.EndGpuTimer();
+  endStage(kCameraUpdateStage);
+
+  this->UpdateLabels();
+
+  // Msgs applied by the render callbacks of the previous frame are in this
+  // one
+  if (gz::gui::App())
+    gz::gui::App()->Latency()->Rendered("scene");
+
+  this->UpdateViewController();
+
+  this->PublishFrameTaps(_renderThreadRhi);
+
+  gui::RenderHooks::RunFrameTasks(this->frameTaskBudget);
+  gui::RenderHooks::RunRender();
+  if (gz::gui::App())
   {
-    return "Engine [" + this->engineName + "] is not supported";
+    this->dataPtr->renderEvent.setAccepted(true);
+    gz::gui::App()->sendEvent(
+        gz::gui::App()->findChild<gz::gui::MainWindow *>(),
+        &this->dataPtr->renderEvent);
   }
+  endStage(kRenderStage);
 
-  // Scene
-  if (engine->SceneCount() > 0)
+  // Keep rendering on demand scenes while the camera moves, for example
+  // during a move to animation or while following a target.
+  const math::Pose3d cameraPose = this->dataPtr->camera->WorldPose();
+  const bool cameraMoved = cameraPose != this->dataPtr->lastCameraPose;
+  if (cameraMoved)
   {
-    return "Currently only one plugin providing a 3D scene is supported at a "
-            "time.";
+    this->dataPtr->lastCameraPose = cameraPose;
+    _renderSync->RequestFrames(1u);
   }
 
-  gzdbg << "Create scene [" << this->sceneName << "]" << std::endl;
-  auto scene = engine->CreateScene(this->sceneName);
-  if (nullptr == scene)
+  // The texture is resized at the start of the next frame, so ask for it
+  const std::chrono::duration<double> frameTime =
+      std::chrono::steady_clock::now() - frameStart;
+  if (this->UpdateResolutionScale(frameTime.count(), cameraMoved))
+    _renderSync->RequestFrames(1u);
+
+  if (this->dataPtr->qualityIndex > 0 &&
+      this->dataPtr->qualityGovernor.Add(frameTime.count()))
   {
-    return "Failed to create scene [" + this->sceneName + "] for engine [" +
-        this->engineName + "]";
+    const auto &lower = QualityPresets()[this->dataPtr->qualityIndex - 1];
+    gzmsg << "Frames are slower than " << this->qualityTargetFps
+          << " FPS, lowering the quality to [" << lower.name << "]"
+          << std::endl;
+    this->SetQuality(lower.name);
+    _renderSync->RequestFrames(1u);
   }
-  scene->SetAmbientLight(this->ambientLight);
-  scene->SetBackgroundColor(this->backgroundColor);
-  scene->SetCameraPassCountPerGpuFlush(6u);
 
-  if (this->skyEnable)
+  // Hand the views over along with the main texture. The render interface
+  // only tracks one texture at a time, so point it back at the main camera
+  // afterwards.
+  if (!this->dataPtr->viewCameras.empty())
   {
-    scene->SetSkyEnabled(true);
+    _renderSync->viewTextures.resize(this->dataPtr->viewCameras.size());
+    for (std::size_t i = 0; i < this->dataPtr->viewCameras.size(); ++i)
+    {
+      auto &viewCamera = this->dataPtr->viewCameras[i];
+      _renderThreadRhi.Update(viewCamera);
+      _renderSync->viewTextures[i] = {_renderThreadRhi.TexturePtr(),
+          QSize(static_cast<int>(viewCamera->ImageWidth()),
+                static_cast<int>(viewCamera->ImageHeight()))};
+    }
+    _renderThreadRhi.Update(this->dataPtr->camera);
   }
 
-  if (!scene->SetShadowTextureSize(rendering::LightType::DIRECTIONAL,
-      this->directionalLightTextureSize))
+  if (_renderSync->Decoupled())
   {
-    gzerr << "Unable to set directional light shadow <texture_size> to '"
-          << this->directionalLightTextureSize
-          << "'. Using default texture size of "
-          << scene->ShadowTextureSize(rendering::LightType::DIRECTIONAL)
-          << std::endl;
+    const int index = _renderSync->AcquireBackBuffer();
+    void *texturePtr = _renderThreadRhi.CopyToSwapBuffer(
+        static_cast<unsigned int>(index), this->textureSize);
+    _renderSync->PublishBuffer(index, texturePtr, this->textureSize);
   }
+  else if (!_renderSync->headless)
+  {
+    _renderSync->ReleaseQtThreadFromBlock(lock);
+  }
+  endStage(kTextureHandoffStage);
 
-  auto root = scene->RootVisual();
-
-  // Camera
-  this->dataPtr->camera = scene->CreateCamera();
-  this->dataPtr->camera->SetUserData("user-camera", true);
-  root->AddChild(this->dataPtr->camera);
-  this->dataPtr->camera->SetLocalPose(this->cameraPose);
-  this->dataPtr->camera->SetNearClipPlane(this->cameraNearClip);
-  this->dataPtr->camera->SetFarClipPlane(this->cameraFarClip);
-  this->dataPtr->camera->SetImageWidth(this->textureSize.width());
-  this->dataPtr->camera->SetImageHeight(this->textureSize.height());
-  this->dataPtr->camera->SetImageFormat(this->dataPtr->camera->ImageFormat(),
-                                        true);
-  this->dataPtr->camera->SetAntiAliasing(8);
-  this->dataPtr->camera->SetHFOV(this->cameraHFOV);
-  // setting the size and calling PreRender should cause the render texture to
-  // be rebuilt
-  this->dataPtr->camera->PreRender();
-
-  // Update the render interface (texture)
-  _rhi.Update(this->dataPtr->camera);
+  if (this->dataPtr->frameInputTime)
+  {
+    this->dataPtr->inputLatencies +=
+        std::chrono::steady_clock::now() - *this->dataPtr->frameInputTime;
+    this->dataPtr->inputFrames++;
+    this->dataPtr->frameInputTime.reset();
+  }
 
-  // Ray Query
-  this->dataPtr->rayQuery = this->dataPtr->camera->Scene()->CreateRayQuery();
+  // After releasing Qt, so reporting doesn't hold it up
+  if (this->frameTiming)
+    this->ReportFrameTiming(_renderThreadRhi, frameStart);
 
-  this->initialized = true;
-  return {};
+  if (!this->dataPtr->firstFrameRendered && gz::gui::App())
+  {
+    this->dataPtr->firstFrameRendered = true;
+    gz::gui::App()->Trace()->Mark("MinimalScene first frame", "render");
+  }
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI)
+void GzRenderer::ReportFrameTiming(RenderThreadRhi &_rhi,
+    const std::chrono::steady_clock::time_point &_frameStart)
 {
-  // Create render interface and reset params
-  this->dataPtr->rhiParams.clear();
+  const auto now = std::chrono::steady_clock::now();
+  this->dataPtr->frameTimes += now - _frameStart;
+  this->dataPtr->timedFrames++;
 
-  if (_graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  double gpuTime{0.0};
+  if (_rhi.GpuTime(gpuTime))
   {
-    gzdbg << "Creating gz-rendering interface for OpenGL" << std::endl;
-    this->dataPtr->rhiParams["useCurrentGLContext"] = "1";
-    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiOpenGL>();
+    this->dataPtr->gpuTimes += gpuTime;
+    this->dataPtr->gpuSamples++;
   }
-  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
+
+  if (now - this->dataPtr->lastTimingReport <
+      this->dataPtr->kTimingReportPeriod)
   {
-    gzdbg << "Creating gz-rendering interface for Vulkan" << std::endl;
-    this->dataPtr->rhiParams["vulkan"] = "1";
-#if GZ_GUI_HAVE_VULKAN
-    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiVulkan>();
-#else
-    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiOpenGL>();
-#endif
+    return;
   }
-#if GZ_GUI_HAVE_METAL
-  else if (_graphicsAPI == rendering::GraphicsAPI::METAL)
+  this->dataPtr->lastTimingReport = now;
+
+  msgs::Diagnostics msg;
+  std::ostringstream summary;
+  summary << std::fixed << std::setprecision(2);
+  auto add = [&msg, &summary](const std::string &_name,
+      const std::chrono::steady_clock::duration &_time)
   {
-    gzdbg << "Creating gz-renderering interface for Metal" << std::endl;
-    this->dataPtr->rhiParams["metal"] = "1";
-    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiMetal>();
+    const auto sec = std::chrono::duration_cast<std::chrono::seconds>(_time);
+    const auto nsec =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_time - sec);
+    auto *time = msg.add_time();
+    time->set_name(_name);
+    time->mutable_elapsed()->set_sec(sec.count());
+    time->mutable_elapsed()->set_nsec(static_cast<int32_t>(nsec.count()));
+
+    if (summary.tellp() > 0)
+      summary << "\n";
+    summary << _name << ": "
+            << std::chrono::duration<double, std::milli>(_time).count()
+            << " ms";
+  };
+
+  const unsigned int frames = this->dataPtr->timedFrames;
+  for (std::size_t i = 0; i < kFrameStageCount; ++i)
+    add(kFrameStageNames[i], this->dataPtr->stageTimes[i] / frames);
+  if (this->dataPtr->gpuSamples > 0u)
+  {
+    add("gpu", std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(
+        this->dataPtr->gpuTimes / this->dataPtr->gpuSamples)));
   }
-#endif
+  add("frame", this->dataPtr->frameTimes / frames);
+  if (this->dataPtr->inputFrames > 0u)
+  {
+    add("input_latency",
+        this->dataPtr->inputLatencies / this->dataPtr->inputFrames);
+  }
+
+  // Qt Quick frames, which may not match the frames rendered here
+  const auto quick = this->quickTiming ?
+      this->quickTiming->Take() : QuickFrameTiming::Averages();
+  if (quick.frames > 0u)
+  {
+    add("qt_polish", quick.polish);
+    add("qt_sync", quick.sync);
+    add("qt_render", quick.render);
+    add("qt_swap", quick.swap);
+    add("qt_frame", quick.frame);
+    add("qt_max_frame", quick.maxFrame);
+  }
+
+  if (this->dataPtr->frameTimingPub)
+    this->dataPtr->frameTimingPub.Publish(msg);
+  if (this->frameTimingCb)
+    this->frameTimingCb(summary.str());
+
+  this->dataPtr->stageTimes.fill(std::chrono::steady_clock::duration::zero());
+  this->dataPtr->frameTimes = std::chrono::steady_clock::duration::zero();
+  this->dataPtr->gpuTimes = 0.0;
+  this->dataPtr->gpuSamples = 0u;
+  this->dataPtr->timedFrames = 0u;
+  this->dataPtr->inputLatencies = std::chrono::steady_clock::duration::zero();
+  this->dataPtr->inputFrames = 0u;
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::Destroy()
+void GzRenderer::UpdateViewController()
 {
-  auto *engine = rendering::engine(this->engineName);
-  if (engine == nullptr)
+  if (this->cameraViewController.empty())
     return;
-  auto scene = engine->SceneByName(this->sceneName);
-  if (scene == nullptr)
+
+  std::optional<std::pair<std::string, bool>> reply;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->viewControllerMutex);
+    reply.swap(this->dataPtr->viewControllerReply);
+  }
+
+  if (reply.has_value() && reply->first == this->cameraViewController)
+  {
+    if (!reply->second)
+    {
+      // LCOV_EXCL_START
+      gzerr << "Error setting view controller. Check if the View Angle GUI "
+               "plugin is loaded." << std::endl;
+      // LCOV_EXCL_STOP
+    }
+    this->cameraViewController.clear();
+    this->dataPtr->pendingViewController.clear();
     return;
-  scene->DestroySensor(this->dataPtr->camera);
+  }
 
-  // If that was the last sensor, destroy scene
-  if (scene->SensorCount() == 0)
+  // Already waiting for a reply
+  if (this->dataPtr->pendingViewController == this->cameraViewController)
+    return;
+
+  const std::string controller = this->cameraViewController;
+  std::function<void(const msgs::Boolean &, const bool)> cb =
+      [this, controller](const msgs::Boolean &/*_rep*/, const bool _result)
   {
-    gzdbg << "Destroy scene [" << scene->Name() << "]" << std::endl;
-    engine->DestroyScene(scene);
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->viewControllerMutex);
+      this->dataPtr->viewControllerReply = {controller, _result};
+    }
+    // Handle the reply even if the scene is idle
+    RenderHooks::RequestRender();
+  };
+
+  msgs::StringMsg req;
+  req.set_data(controller);
+  if (this->dataPtr->node.Request("/gui/camera/view_control", req, cb))
+    this->dataPtr->pendingViewController = controller;
+}
 
-    // TODO(anyone) If that was the last scene, terminate engine?
+/////////////////////////////////////////////////
+math::Vector3d GzRenderer::Implementation::ScreenToScene(
+    const math::Vector2i &_pos)
+{
+  // The scene may change under a still mouse, so only reuse picks made
+  // during this or the previous frame
+  const auto cameraPose = this->camera->WorldPose();
+  if (this->lastPick && this->lastPick->screenPos == _pos &&
+      this->lastPick->cameraPose == cameraPose &&
+      this->inputFrame - this->lastPick->frame <= 1u)
+  {
+    return this->lastPick->scenePos;
   }
 
-  // clean up in the rendering thread
-  this->dataPtr->camera.reset();
-  this->dataPtr->rayQuery.reset();
+  Pick pick;
+  pick.screenPos = _pos;
+  pick.cameraPose = cameraPose;
+  pick.frame = this->inputFrame;
+  pick.scenePos = rendering::screenToScene(_pos, this->camera,
+      this->rayQuery, 1000);
+  this->lastPick = pick;
+  return pick.scenePos;
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::NewHoverEvent(const math::Vector2i &_hoverPos)
+void GzRenderer::HandleMouseEvent()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->mouseHoverPos = _hoverPos;
-  this->dataPtr->hoverDirty = true;
+  ++this->dataPtr->inputFrame;
+  this->dataPtr->frameInputTime = this->dataPtr->inputTime;
+  this->dataPtr->inputTime.reset();
+  for (const auto &e : this->dataPtr->mouseEvents)
+  {
+    this->dataPtr->mouseEvent = this->dataPtr->ToTexture(e);
+
+    this->BroadcastDrag();
+    this->BroadcastMousePress();
+    this->BroadcastLeftClick();
+    this->BroadcastRightClick();
+    this->BroadcastScroll();
+    this->BroadcastKeyPress();
+    this->BroadcastKeyRelease();
+  }
+  this->dataPtr->mouseEvents.clear();
+
+  this->BroadcastHoverPos();
+  this->BroadcastDrop();
+  this->UpdateSpawnPreview();
+  this->dataPtr->mouseDirty = false;
 }
 
-/////////////////////////////////////////////////
-void GzRenderer::NewDropEvent(const std::string &_dropText,
-  const math::Vector2i &_dropPos)
+////////////////////////////////////////////////
+void GzRenderer::HandleKeyPress(const common::KeyEvent &_e)
 {
+  if (this->inputRecorder)
+    this->inputRecorder->Add(_e, true);
+
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->dropText = _dropText;
-  this->dataPtr->mouseDropPos = _dropPos;
-  this->dataPtr->dropDirty = true;
+
+  this->dataPtr->keyEvent = _e;
+
+  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
+  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
+  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
 }
 
-/////////////////////////////////////////////////
-void GzRenderer::NewMouseEvent(const common::MouseEvent &_e)
+////////////////////////////////////////////////
+void GzRenderer::HandleKeyRelease(const common::KeyEvent &_e)
 {
+  if (this->inputRecorder)
+    this->inputRecorder->Add(_e, false);
+
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  if (this->dataPtr->mouseEvents.size() >= this->dataPtr->kMaxMouseEventSize)
-    this->dataPtr->mouseEvents.pop_front();
-  this->dataPtr->mouseEvents.push_back(_e);
-  this->dataPtr->mouseDirty = true;
+
+  this->dataPtr->keyEvent = _e;
+
+  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
+  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
+  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
 }
 
 /////////////////////////////////////////////////
-RenderThread::RenderThread()
+void GzRenderer::BroadcastDrop()
 {
-  // Set default graphics API to OpenGL
-  const std::string backendApiName = gz::gui::renderEngineBackendApiName();
-  if (backendApiName == "vulkan")
+  if (!this->dataPtr->dropDirty)
+    return;
+  events::DropOnScene dropOnSceneEvent(
+    this->dataPtr->dropText, this->dataPtr->ToTexture(
+    this->dataPtr->mouseDropPos));
+  App()->sendEvent(App()->findChild<MainWindow *>(), &dropOnSceneEvent);
+  this->dataPtr->dropDirty = false;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::UpdateSpawnPreview()
+{
+  auto &preview = this->dataPtr->spawnPreview;
+  if (this->dataPtr->spawnDragText.empty())
   {
-    this->SetGraphicsAPI(rendering::GraphicsAPI::VULKAN);
+    if (nullptr != preview)
+      preview->SetVisible(false);
+    return;
   }
-  else if (backendApiName == "metal")
+
+  if (nullptr == preview)
   {
-    this->SetGraphicsAPI(rendering::GraphicsAPI::METAL);
+    auto scene = this->dataPtr->camera->Scene();
+    preview = scene->CreateVisual();
+    preview->AddGeometry(scene->CreateBox());
+    auto material = scene->CreateMaterial();
+    material->SetDiffuse(0.3, 0.6, 1.0);
+    material->SetEmissive(0.1, 0.2, 0.4);
+    material->SetTransparency(0.6);
+    material->SetCastShadows(false);
+    preview->SetMaterial(material, false);
+    scene->RootVisual()->AddChild(preview);
   }
-  else
+
+  // The box must not be hit by its own ray query
+  preview->SetVisible(false);
+  const auto pos = this->dataPtr->ScreenToScene(
+      this->dataPtr->ToTexture(this->dataPtr->spawnDragPos));
+  preview->SetVisible(true);
+
+  // A unit box until the resource is resolved, or if its size is unknown
+  math::Vector3d center(0, 0, 0.5);
+  math::Vector3d size(1, 1, 1);
+  auto resource = SpawnAssets::Ready(this->dataPtr->spawnDragText);
+  if (nullptr == resource)
   {
-    this->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+    // Come back once it's resolved
+    RenderHooks::RequestRender();
   }
-
-  RenderWindowItem::Implementation::threads << this;
-  qRegisterMetaType<RenderSync*>("RenderSync*");
+  else if (resource->box.Min().X() <= resource->box.Max().X())
+  {
+    center = resource->box.Center();
+    size = resource->box.Size();
+    size.Max(math::Vector3d(0.01, 0.01, 0.01));
+  }
+  preview->SetLocalPosition(pos + center);
+  preview->SetLocalScale(size);
 }
 
 /////////////////////////////////////////////////
-void RenderThread::SetErrorCb(std::function<void(const QString&)> _cb)
+void GzRenderer::BroadcastHoverPos()
 {
-  this->errorCb = std::move(_cb);
-}
+  if (!this->dataPtr->hoverDirty)
+    return;
 
-/////////////////////////////////////////////////
-void RenderThread::RenderNext(RenderSync *_renderSync)
-{
-  this->rhi->RenderNext(_renderSync);
-  emit this->TextureReady(
-    this->rhi->TexturePtr(),
-    this->rhi->TextureSize());
-}
+  const math::Vector2i hoverPos =
+      this->dataPtr->ToTexture(this->dataPtr->mouseHoverPos);
+  auto pos = this->dataPtr->ScreenToScene(hoverPos);
 
-/////////////////////////////////////////////////
-void RenderThread::ShutDown()
-{
-  // The render interface calls Destroy on GzRendering
-  this->rhi->ShutDown();
+  events::HoverToScene hoverToSceneEvent(pos);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverToSceneEvent);
 
-  // Stop event processing, move the thread to GUI and make sure it is deleted.
-  this->exit();
-  if (this->gzRenderer.initialized)
-    this->moveToThread(QGuiApplication::instance()->thread());
+  common::MouseEvent hoverMouseEvent = this->dataPtr->mouseEvent;
+  hoverMouseEvent.SetPos(hoverPos);
+  hoverMouseEvent.SetDragging(false);
+  hoverMouseEvent.SetType(common::MouseEvent::MOVE);
+  events::HoverOnScene hoverOnSceneEvent(hoverMouseEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverOnSceneEvent);
+
+  this->dataPtr->hoverDirty = false;
 }
 
 /////////////////////////////////////////////////
-void RenderThread::SizeChanged()
+void GzRenderer::BroadcastDrag()
 {
-  auto *item = qobject_cast<QQuickItem *>(this->sender());
-  if (item == nullptr)
-  {
-    gzerr << "Internal error, sender is not QQuickItem." << std::endl;
+  if (!this->dataPtr->mouseDirty)
     return;
-  }
 
-  if (item->width() <= 0 || item->height() <= 0)
+  // Only broadcast drag if dragging
+  if (!this->dataPtr->mouseEvent.Dragging())
     return;
 
-  this->gzRenderer.textureSize =
-    QSize(static_cast<int>(item->width()), static_cast<int>(item->height()));
-  this->gzRenderer.textureDirty = true;
+  events::DragOnScene dragEvent(this->dataPtr->mouseEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &dragEvent);
 }
 
 /////////////////////////////////////////////////
-QOffscreenSurface *RenderThread::Surface() const
+void GzRenderer::BroadcastLeftClick()
 {
-  return this->rhi->Surface();
-}
+  if (!this->dataPtr->mouseDirty)
+    return;
 
-/////////////////////////////////////////////////
-void RenderThread::SetSurface(QOffscreenSurface *_surface)
-{
-  this->rhi->SetSurface(_surface);
-}
+  if (this->dataPtr->mouseEvent.Button() != common::MouseEvent::LEFT ||
+      this->dataPtr->mouseEvent.Type() != common::MouseEvent::RELEASE)
+    return;
 
-/////////////////////////////////////////////////
-QOpenGLContext *RenderThread::Context() const
-{
-  return this->rhi->Context();
-}
+  auto pos = this->dataPtr->ScreenToScene(this->dataPtr->mouseEvent.Pos());
 
-/////////////////////////////////////////////////
-void RenderThread::SetContext(QOpenGLContext *_context)
-{
-  this->rhi->SetContext(_context);
+  events::LeftClickToScene leftClickToSceneEvent(pos);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickToSceneEvent);
+
+  events::LeftClickOnScene leftClickOnSceneEvent(this->dataPtr->mouseEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
-void RenderThread::SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI)
+void GzRenderer::BroadcastRightClick()
 {
-  // Set the graphics API for the GzRenderer
-  this->gzRenderer.SetGraphicsAPI(_graphicsAPI);
+  if (!this->dataPtr->mouseDirty)
+    return;
 
-  // Create the render interface
-  if (_graphicsAPI == rendering::GraphicsAPI::OPENGL)
-  {
-    gzdbg << "Creating render thread interface for OpenGL" << std::endl;
-    this->rhi = std::make_unique<RenderThreadRhiOpenGL>(&this->gzRenderer);
-  }
+  if (this->dataPtr->mouseEvent.Button() != common::MouseEvent::RIGHT ||
+      this->dataPtr->mouseEvent.Type() != common::MouseEvent::RELEASE)
+    return;
 
-#if GZ_GUI_HAVE_VULKAN
-  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
-  {
-    gzdbg << "Creating render thread interface for Vulkan" << std::endl;
-    this->rhi = std::make_unique<RenderThreadRhiVulkan>(&this->gzRenderer);
-  }
-#endif  // GZ_GUI_HAVE_VULKAN
-#if GZ_GUI_HAVE_METAL
-  else if (_graphicsAPI == rendering::GraphicsAPI::METAL)
-  {
-    gzdbg << "Creating render thread interface for Metal" << std::endl;
-    this->rhi = std::make_unique<RenderThreadRhiMetal>(&this->gzRenderer);
-  }
-#endif  // GZ_GUI_HAVE_METAL
+  auto pos = this->dataPtr->ScreenToScene(this->dataPtr->mouseEvent.Pos());
+
+  events::RightClickToScene rightClickToSceneEvent(pos);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickToSceneEvent);
+
+  events::RightClickOnScene rightClickOnSceneEvent(this->dataPtr->mouseEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
-std::string RenderThread::Initialize()
+void GzRenderer::BroadcastMousePress()
 {
-  auto loadingError = this->rhi->Initialize();
-  if (!loadingError.empty())
-  {
-    this->errorCb(QString::fromStdString(loadingError));
-  }
-  return loadingError;
+  if (!this->dataPtr->mouseDirty)
+    return;
+
+  if (this->dataPtr->mouseEvent.Type() != common::MouseEvent::PRESS)
+    return;
+
+  events::MousePressOnScene event(this->dataPtr->mouseEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &event);
 }
 
 /////////////////////////////////////////////////
-TextureNode::TextureNode(QQuickWindow *_window, RenderSync &_renderSync,
-                         const rendering::GraphicsAPI &_graphicsAPI,
-                         rendering::CameraPtr &_camera):
-  renderSync(_renderSync),
-  window(_window)
+void GzRenderer::BroadcastScroll()
 {
-  (void) _camera;
-  if (_graphicsAPI == rendering::GraphicsAPI::OPENGL)
-  {
-    gzdbg << "Creating texture node render interface for OpenGL" << std::endl;
-    this->rhi = std::make_unique<TextureNodeRhiOpenGL>(_window);
-  }
-#if GZ_GUI_HAVE_VULKAN
-  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
-  {
-    gzdbg << "Creating texture node render interface for Vulkan" << std::endl;
-    this->rhi = std::make_unique<TextureNodeRhiVulkan>(_window, _camera);
-  }
-#endif  // GZ_GUI_HAVE_VULKAN
-#if GZ_GUI_HAVE_METAL
-  else if (_graphicsAPI == rendering::GraphicsAPI::METAL)
-  {
-    gzdbg << "Creating texture node render interface for Metal" << std::endl;
-    this->rhi = std::make_unique<TextureNodeRhiMetal>(_window);
-  }
-#endif  // GZ_GUI_HAVE_METAL
+  if (!this->dataPtr->mouseDirty)
+    return;
 
-  this->setTexture(this->rhi->Texture());
+  if (this->dataPtr->mouseEvent.Type() != common::MouseEvent::SCROLL)
+    return;
+
+  events::ScrollOnScene scrollOnSceneEvent(this->dataPtr->mouseEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &scrollOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
-TextureNode::~TextureNode() = default;
+void GzRenderer::BroadcastKeyRelease()
+{
+  if (this->dataPtr->keyEvent.Type() != common::KeyEvent::RELEASE)
+    return;
+
+  events::KeyReleaseOnScene keyRelease(this->dataPtr->keyEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &keyRelease);
+
+  this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
+}
 
 /////////////////////////////////////////////////
-void TextureNode::NewTexture(void* _texturePtr, const QSize &_size)
+void GzRenderer::BroadcastKeyPress()
 {
-  this->rhi->NewTexture(_texturePtr, _size);
+  if (this->dataPtr->keyEvent.Type() != common::KeyEvent::PRESS)
+    return;
 
-  // We cannot call QQuickWindow::update directly here, as this is only allowed
-  // from the rendering thread or GUI thread.
-  emit PendingNewTexture();
+  events::KeyPressOnScene keyPress(this->dataPtr->keyEvent);
+  App()->sendEvent(App()->findChild<MainWindow *>(), &keyPress);
+
+  this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
 }
 
 /////////////////////////////////////////////////
-void TextureNode::PrepareNode()
+void GzRenderer::SetQuality(const std::string &_preset)
 {
-  this->rhi->PrepareNode();
+  std::lock_guard<std::mutex> lock(this->dataPtr->qualityMutex);
+  this->dataPtr->pendingQuality = _preset;
+  this->dataPtr->qualityDirty = true;
+}
 
-  if (this->rhi->HasNewTexture())
+/////////////////////////////////////////////////
+void GzRenderer::ApplyQuality()
+{
+  bool changed{false};
   {
-    this->setTexture(this->rhi->Texture());
+    std::lock_guard<std::mutex> lock(this->dataPtr->qualityMutex);
+    if (this->dataPtr->qualityDirty)
+    {
+      this->dataPtr->qualityIndex =
+          QualityPresetIndex(this->dataPtr->pendingQuality);
+      this->dataPtr->qualityDirty = false;
+      changed = true;
+    }
+  }
+  if (this->dataPtr->qualityIndex < 0)
+    return;
 
-    this->markDirty(DirtyMaterial);
+  auto scene = this->dataPtr->camera->Scene();
+  const auto &preset = QualityPresets()[this->dataPtr->qualityIndex];
+  if (changed)
+  {
+    if (!scene->SetShadowTextureSize(rendering::LightType::DIRECTIONAL,
+        preset.shadowTextureSize))
+    {
+      gzwarn << "Unable to set the shadow texture size of quality ["
+             << preset.name << "] to '" << preset.shadowTextureSize
+             << "'. Using " << scene->ShadowTextureSize(
+             rendering::LightType::DIRECTIONAL) << std::endl;
+    }
+    if (this->skyEnable)
+      scene->SetSkyEnabled(preset.sky);
 
-    // This will notify the rendering thread that the texture is now being
-    // rendered and it can start rendering to the other one.
-    // emit TextureInUse(&this->renderSync); See comment below
+    // Give the new preset time to take effect before judging it
+    this->dataPtr->qualityGovernor.Reset();
+    if (this->qualityCb)
+      this->qualityCb(preset.name);
   }
-  // NOTE: The original code from Qt samples only emitted when
-  // newId is not null.
-  //
-  // This is correct... for their case.
-  // However we need to synchronize the threads when resolution changes,
-  // and we're also currently doing everything in lockstep (i.e. both Qt
-  // and worker thread are serialized,
-  // see https://github.com/gazebosim/gz-rendering/issues/304 )
-  //
-  // We need to emit even if newId == 0 because it's safe as long as both
-  // threads are forcefully serialized and otherwise we may get a
-  // deadlock (this func. called twice in a row with the worker thread still
-  // finishing the 1st iteration, may result in a deadlock for newer versions
-  // of Qt; as WaitForWorkerThread will be called with no corresponding
-  // WaitForQtThreadAndBlock as the worker thread thinks there are
-  // no more jobs to do.
-  //
-  // If we want these to run in worker thread and stay resolution-synchronized,
-  // we probably should use a different method of signals and slots
-  // to send work to the worker thread and get results back
-  emit TextureInUse(&this->renderSync);
 
-  this->renderSync.WaitForWorkerThread();
+  // Lights come and go with the scene, so the limit is applied again
+  // whenever their number changes
+  if (changed || scene->LightCount() != this->dataPtr->shadowLightCount)
+    this->dataPtr->LimitShadowLights(scene, preset.maxShadowLights);
 }
 
 /////////////////////////////////////////////////
-RenderWindowItem::RenderWindowItem(QQuickItem *_parent)
-  : QQuickItem(_parent), dataPtr(utils::MakeUniqueImpl<Implementation>())
+bool GzRenderer::UpdateResolutionScale(double _frameTime, bool _cameraMoved)
 {
-  this->setAcceptedMouseButtons(Qt::AllButtons);
-  this->setFlag(ItemHasContents);
-  this->dataPtr->renderThread = new RenderThread();
-}
+  if (!this->dynamicResolution || this->targetFps <= 0.0)
+    return false;
 
-/////////////////////////////////////////////////
-RenderWindowItem::~RenderWindowItem()
-{
-  this->StopRendering();
+  auto &avg = this->dataPtr->avgFrameTime;
+  avg = avg < 0.0 ? _frameTime : 0.9 * avg + 0.1 * _frameTime;
+
+  if (_cameraMoved)
+    this->dataPtr->stillFrames = 0u;
+  else if (this->dataPtr->stillFrames < this->dataPtr->kSettleFrames)
+    ++this->dataPtr->stillFrames;
+
+  const double scale = this->dataPtr->resolutionScale;
+  const double budget = 1.0 / this->targetFps;
+  double newScale = scale;
+  if (this->dataPtr->stillFrames >= this->dataPtr->kSettleFrames)
+  {
+    // The scene has settled, show it in full detail
+    newScale = 1.0;
+  }
+  else if (avg > budget)
+  {
+    newScale = std::max(this->minResolutionScale,
+        scale - this->dataPtr->kResolutionStep);
+  }
+  // Cost grows with the square of the scale, so leave some headroom before
+  // scaling back up to avoid oscillating
+  else if (avg < 0.6 * budget)
+  {
+    newScale = std::min(1.0, scale + this->dataPtr->kResolutionStep);
+  }
+
+  if (std::abs(newScale - scale) < 1e-6)
+    return newScale < 1.0;
+
+  this->dataPtr->resolutionScale = newScale;
+  this->dataPtr->avgFrameTime = -1.0;
+  this->dataPtr->resizeNow = true;
+  this->textureDirty = true;
+  return true;
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::StopRendering()
+void GzRenderer::UpdateLabels()
 {
-  // Disconnect our QT connections.
-  for (const auto &conn : qAsConst(this->dataPtr->connections))
-    QObject::disconnect(conn);
+  if (!this->labelsCb)
+    return;
 
-  this->dataPtr->renderSync.Shutdown();
-  QMetaObject::invokeMethod(this->dataPtr->renderThread,
-                            "ShutDown",
-                            Qt::QueuedConnection);
+  GZ_GUI_PROFILE("GzRenderer::UpdateLabels");
+  auto camera = this->dataPtr->camera;
+  const unsigned int width = camera->ImageWidth();
+  const unsigned int height = camera->ImageHeight();
+  std::vector<PlacedLabel> placed;
+  if (this->labels->Count() > 0)
+  {
+    rendering::ScenePtr scene = camera->Scene();
+    const math::Pose3d cameraPose = camera->WorldPose();
+    const math::Vector3d forward = cameraPose.Rot().XAxis();
+    placed = this->labels->Layout(
+        [&](const SceneLabel &_label) -> std::optional<math::Vector3d>
+        {
+          math::Vector3d position = _label.position;
+          if (_label.visualId != 0)
+          {
+            auto visual = scene->VisualById(_label.visualId);
+            if (nullptr == visual)
+              return std::nullopt;
+            position += visual->WorldPosition();
+          }
 
-  this->dataPtr->renderThread->wait();
+          // Project doesn't tell points behind the camera apart
+          const double depth = (position - cameraPose.Pos()).Dot(forward);
+          if (depth <= 0.0)
+            return std::nullopt;
+          const auto screen = camera->Project(position);
+          return math::Vector3d(screen.X(), screen.Y(), depth);
+        }, width, height);
+  }
+
+  // Nothing to hand over while the camera and the labels stay still
+  if (placed == this->dataPtr->placedLabels)
+    return;
+  this->dataPtr->placedLabels = placed;
+  this->labelsCb(std::move(placed), width, height);
 }
 
 /////////////////////////////////////////////////
-// This slot will run on the main thread
-void RenderWindowItem::Ready()
+void GzRenderer::PublishFrameTaps(RenderThreadRhi &_renderThreadRhi)
 {
-  if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  const auto now = std::chrono::steady_clock::now();
+  const std::uint64_t index = this->dataPtr->frameIndex++;
+  auto &camera = this->dataPtr->camera;
+  const auto format = camera->ImageFormat();
+
+  auto fill = [&](TapFrame &_frame)
   {
-    this->dataPtr->renderThread->SetSurface(new QOffscreenSurface());
-    this->dataPtr->renderThread->Surface()->setFormat(
-        this->dataPtr->renderThread->Context()->format());
-    this->dataPtr->renderThread->Surface()->create();
+    _frame.index = index;
+    _frame.time = now;
+    _frame.width = camera->ImageWidth();
+    _frame.height = camera->ImageHeight();
+    _frame.format = rendering::PixelUtil::Name(format);
+    _frame.bytesPerPixel = rendering::PixelUtil::BytesPerPixel(format);
+  };
+
+  if (FrameTaps::Due(FrameTapOptions::Access::GPU, now))
+  {
+    auto frame = FrameTaps::AcquireFrame();
+    fill(*frame);
+    frame->data.clear();
+    frame->texture = _renderThreadRhi.TexturePtr();
+    FrameTaps::Publish(FrameTapOptions::Access::GPU, frame);
   }
 
-  // Carry out initialization on main thread before moving to render thread
-  if (!this->dataPtr->renderThread->Initialize().empty())
+  if (!FrameTaps::Due(FrameTapOptions::Access::CPU, now))
+    return;
+
+  if (rendering::PixelUtil::BytesPerChannel(format) != 1u)
   {
+    static bool warned{false};
+    if (!warned)
+    {
+      gzwarn << "Frames of camera [" << camera->Name() << "] with image "
+             << "format [" << rendering::PixelUtil::Name(format)
+             << "] can't be tapped, only 8 bit channels are supported."
+             << std::endl;
+      warned = true;
+    }
     return;
   }
 
-  if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  // The one readback of this frame, shared by all subscribers
+  auto &image = this->dataPtr->tapImage;
+  if (!image.has_value() || image->Width() != camera->ImageWidth() ||
+      image->Height() != camera->ImageHeight() || image->Format() != format)
   {
-    // Move context to the render thread
-    this->dataPtr->renderThread->Context()->moveToThread(
-        this->dataPtr->renderThread);
+    image = camera->CreateImage();
   }
+  camera->Copy(*image);
+
+  auto frame = FrameTaps::AcquireFrame();
+  fill(*frame);
+  frame->texture = nullptr;
+  const auto *data = image->Data<unsigned char>();
+  frame->data.assign(data, data + image->MemorySize());
+  FrameTaps::Publish(FrameTapOptions::Access::CPU, frame);
+}
 
-  this->dataPtr->renderThread->moveToThread(this->dataPtr->renderThread);
-
-  this->dataPtr->renderThread->gzRenderer.textureSize =
-    QSize(static_cast<int>(std::max({ this->width(), 1.0 })),
-          static_cast<int>(std::max({ this->height(), 1.0 })));
-
-  this->connect(this, &QQuickItem::widthChanged,
-      this->dataPtr->renderThread, &RenderThread::SizeChanged);
-  this->connect(this, &QQuickItem::heightChanged,
-      this->dataPtr->renderThread, &RenderThread::SizeChanged);
-
-  this->dataPtr->renderThread->start();
-  this->dataPtr->initializing = false;
-  this->dataPtr->initialized = true;
-  this->update();
+/////////////////////////////////////////////////
+rendering::CameraPtr GzRenderer::Camera()
+{
+  return this->dataPtr->camera;
 }
 
 /////////////////////////////////////////////////
-QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
-    QQuickItem::UpdatePaintNodeData * /*_data*/)
+rendering::CameraPtr GzRenderer::ViewCamera(std::size_t _index)
 {
-  TextureNode *node = static_cast<TextureNode *>(_node);
+  if (_index >= this->dataPtr->viewCameras.size())
+    return nullptr;
+  return this->dataPtr->viewCameras[_index];
+}
 
-  if (!this->dataPtr->initialized)
+#if GZ_GUI_HAVE_VULKAN
+namespace {
+/////////////////////////////////////////////////
+/// \brief fillQtInstanceExtensionsToOgre
+/// Extract Vulkan Instance extension information to be sent to OgreNext
+/// \param[in] inst Qt's Vulkan Instance to extract
+/// \param[out] externalInstance Data to be sent to OgreNext
+void fillQtInstanceExtensionsToOgre(
+  const QVulkanInstance *inst,
+  rendering::GzVulkanExternalInstance &externalInstance)
+{
   {
-    // Exit immediately if still initializing
-    if (this->dataPtr->initializing)
+    QByteArrayList extensions = inst->extensions();
+
+    for (const auto &ext : extensions)
     {
-      return nullptr;
+      externalInstance.instanceExtensions.push_back(VkExtensionProperties{});
+      VkExtensionProperties &extProp =
+        externalInstance.instanceExtensions.back();
+      strncpy(extProp.extensionName, ext.constData(),
+              VK_MAX_EXTENSION_NAME_SIZE);
+      extProp.extensionName[VK_MAX_EXTENSION_NAME_SIZE - 1u] = 0;
     }
-    this->dataPtr->initializing = true;
+  }
 
-    // Set the render thread's render system
-    this->dataPtr->renderThread->SetGraphicsAPI(
-        this->dataPtr->graphicsAPI);
+  {
+    QByteArrayList layers = inst->layers();
 
-    if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+    for (const auto &layer : layers)
     {
-      auto *rif = this->window()->rendererInterface();
+      externalInstance.instanceLayers.push_back(VkLayerProperties{});
+      VkLayerProperties &layerProp = externalInstance.instanceLayers.back();
+      strncpy(layerProp.layerName, layer.constData(),
+              VK_MAX_EXTENSION_NAME_SIZE);
+      layerProp.layerName[VK_MAX_EXTENSION_NAME_SIZE - 1u] = 0;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief fillQtDeviceExtensionsToOgre
+/// Extract Vulkan Device extension info to be sent to OgreNext
+/// This data is obtained from Environment variables
+/// \param[out] externalDevice Data to be sent to OgreNext
+void fillQtDeviceExtensionsToOgre(
+  rendering::GzVulkanExternalDevice &externalDevice)
+{
+  // We know Qt adds these by looking at
+  //  qt-everywhere-src-5.15.2/qtbase/src/gui/rhi/qrhivulkan.cpp
+  QVector<QString> deviceExtensions;
+  deviceExtensions.append("VK_KHR_swapchain");
+
+  QByteArray envExts = qgetenv("QT_VULKAN_DEVICE_EXTENSIONS");
+  if (!envExts.isEmpty())
+  {
+    QByteArrayList envExtList = envExts.split(';');
+    for (const auto &ext : envExtList)
+    {
+      if (!ext.isEmpty())
+      {
+        deviceExtensions.append(ext);
+      }
+    }
+  }
+
+  for (const auto &ext : deviceExtensions)
+  {
+    externalDevice.deviceExtensions.push_back(VkExtensionProperties{});
+    VkExtensionProperties &extProp = externalDevice.deviceExtensions.back();
+    strncpy(extProp.extensionName, ext.toStdString().c_str(),
+            VK_MAX_EXTENSION_NAME_SIZE - 1u);
+    extProp.extensionName[VK_MAX_EXTENSION_NAME_SIZE - 1u] = 0;
+  }
+}
+}  // namespace
+#endif  // GZ_GUI_HAVE_VULKAN
+
+/////////////////////////////////////////////////
+std::string GzRenderer::Initialize(RenderThreadRhi &_rhi)
+{
+  if (this->initialized)
+    return {};
+
+  StartupTraceZone traceZone(
+      gz::gui::App() ? gz::gui::App()->Trace() : nullptr,
+      "MinimalScene initialize", "render");
+
+  // Currently only support one engine at a time
+  rendering::RenderEngine *engine{nullptr};
+  auto loadedEngines = rendering::loadedEngines();
+
+  // Load engine if there's no engine yet
+  if (loadedEngines.empty())
+  {
+    QQuickWindow *quickWindow{nullptr};
+    if (this->headless)
+    {
+      // The engine creates its own context on an EGL device, without a
+      // window or Qt's context
+      this->dataPtr->rhiParams.erase("useCurrentGLContext");
+      this->dataPtr->rhiParams["headless"] = "1";
+    }
+    else
+    {
+      quickWindow =
+        gz::gui::App()->findChild<gz::gui::MainWindow *>()->QuickWindow();
+      this->dataPtr->rhiParams["winID"] =
+        std::to_string(quickWindow->winId());
+    }
+
+#if GZ_GUI_HAVE_VULKAN
+    // externalInstance & externalDevice MUST be declared at this scope
+    // because we save their stack addresses into this->dataPtr->rhiParams
+    // and must be alive until rendering::engine() returns.
+    rendering::GzVulkanExternalInstance externalInstance;
+    rendering::GzVulkanExternalDevice externalDevice;
+    if (nullptr != quickWindow && this->dataPtr->rhiParams.find("vulkan") !=
+        this->dataPtr->rhiParams.end())
+    {
+      QSGRendererInterface *qtRenderInterface =
+        quickWindow->rendererInterface();
+
+      const QVulkanInstance *inst = reinterpret_cast<const QVulkanInstance *>(
+        qtRenderInterface->getResource(
+          quickWindow, QSGRendererInterface::VulkanInstanceResource));
+      GZ_ASSERT(inst && inst->isValid(), "Invalid QVulkanInstance!");
+
+      externalInstance.instance = inst->vkInstance();
+
+      externalDevice.physicalDevice =
+        *reinterpret_cast<VkPhysicalDevice *>(qtRenderInterface->getResource(
+          quickWindow, QSGRendererInterface::PhysicalDeviceResource));
+      externalDevice.device =
+        *reinterpret_cast<VkDevice *>(qtRenderInterface->getResource(
+          quickWindow, QSGRendererInterface::DeviceResource));
+      externalDevice.graphicsQueue =
+        *reinterpret_cast<VkQueue *>(qtRenderInterface->getResource(
+          quickWindow, QSGRendererInterface::CommandQueueResource));
+      externalDevice.presentQueue = externalDevice.graphicsQueue;
+
+      // Qt chose the device, see GpuSelection
+      VkPhysicalDeviceProperties properties;
+      inst->functions()->vkGetPhysicalDeviceProperties(
+          externalDevice.physicalDevice, &properties);
+      gzmsg << "Rendering on GPU [" << properties.deviceName
+            << "] with Vulkan" << std::endl;
+
+      fillQtInstanceExtensionsToOgre(inst, externalInstance);
+      fillQtDeviceExtensionsToOgre(externalDevice);
+
+      this->dataPtr->rhiParams["external_instance"] =
+        std::to_string(reinterpret_cast<uintptr_t>(&externalInstance));
+      this->dataPtr->rhiParams["external_device"] =
+        std::to_string(reinterpret_cast<uintptr_t>(&externalDevice));
+    }
+#endif
+
+    this->dataPtr->enginePreload.Wait();
+    engine = rendering::engine(this->engineName, this->dataPtr->rhiParams);
+  }
+  else
+  {
+    if (!this->engineName.empty() && loadedEngines.front() != this->engineName)
+    {
+      gzwarn << "Failed to load engine [" << this->engineName
+             << "]. Using engine [" << loadedEngines.front()
+             << "], which is already loaded. Currently only one engine is "
+             << "supported at a time." << std::endl;
+    }
+    this->engineName = loadedEngines.front();
+    engine = rendering::engine(loadedEngines.front());
+  }
+
+  if (engine == nullptr)
+  {
+    return "Engine [" + this->engineName + "] is not supported";
+  }
+
+  // Scene
+  if (engine->SceneCount() > 0)
+  {
+    return "Currently only one plugin providing a 3D scene is supported at a "
+            "time.";
+  }
+
+  gzdbg << "Create scene [" << this->sceneName << "]" << std::endl;
+  auto scene = engine->CreateScene(this->sceneName);
+  if (nullptr == scene)
+  {
+    return "Failed to create scene [" + this->sceneName + "] for engine [" +
+        this->engineName + "]";
+  }
+  scene->SetAmbientLight(this->ambientLight);
+  scene->SetBackgroundColor(this->backgroundColor);
+  scene->SetCameraPassCountPerGpuFlush(6u);
+
+  if (this->skyEnable)
+  {
+    scene->SetSkyEnabled(true);
+  }
+
+  if (!scene->SetShadowTextureSize(rendering::LightType::DIRECTIONAL,
+      this->directionalLightTextureSize))
+  {
+    gzerr << "Unable to set directional light shadow <texture_size> to '"
+          << this->directionalLightTextureSize
+          << "'. Using default texture size of "
+          << scene->ShadowTextureSize(rendering::LightType::DIRECTIONAL)
+          << std::endl;
+  }
+
+  this->dataPtr->qualityGovernor = QualityGovernor(this->qualityTargetFps);
+
+  auto root = scene->RootVisual();
+
+  // Camera
+  this->dataPtr->camera = scene->CreateCamera();
+  this->dataPtr->camera->SetUserData("user-camera", true);
+  root->AddChild(this->dataPtr->camera);
+  this->dataPtr->camera->SetLocalPose(this->cameraPose);
+  this->dataPtr->camera->SetNearClipPlane(this->cameraNearClip);
+  this->dataPtr->camera->SetFarClipPlane(this->cameraFarClip);
+  this->dataPtr->camera->SetImageWidth(this->textureSize.width());
+  this->dataPtr->camera->SetImageHeight(this->textureSize.height());
+  this->dataPtr->camera->SetImageFormat(this->dataPtr->camera->ImageFormat(),
+                                        true);
+  this->dataPtr->camera->SetAntiAliasing(8);
+  this->dataPtr->camera->SetHFOV(this->cameraHFOV);
+  // setting the size and calling PreRender should cause the render texture to
+  // be rebuilt
+  this->dataPtr->camera->PreRender();
+
+  // Extra views. Their textures are sized on the first frame.
+  for (const auto &view : this->views)
+  {
+    auto viewCamera = scene->CreateCamera();
+    root->AddChild(viewCamera);
+    viewCamera->SetLocalPose(view.pose);
+    viewCamera->SetNearClipPlane(this->cameraNearClip);
+    viewCamera->SetFarClipPlane(this->cameraFarClip);
+    const QSize size = viewSize(view, this->itemSize);
+    viewCamera->SetImageWidth(size.width());
+    viewCamera->SetImageHeight(size.height());
+    viewCamera->SetImageFormat(viewCamera->ImageFormat(), true);
+    viewCamera->SetAntiAliasing(8);
+    viewCamera->SetHFOV(view.hfov);
+    viewCamera->PreRender();
+    this->dataPtr->viewCameras.push_back(viewCamera);
+  }
+
+  // Update the render interface (texture)
+  _rhi.Update(this->dataPtr->camera);
+
+  if (this->frameTiming && !this->frameTimingTopic.empty())
+  {
+    this->dataPtr->frameTimingPub =
+        this->dataPtr->node.Advertise<msgs::Diagnostics>(
+        this->frameTimingTopic);
+    if (!this->dataPtr->frameTimingPub)
+    {
+      gzerr << "Failed to advertise frame timing on topic ["
+            << this->frameTimingTopic << "]" << std::endl;
+    }
+  }
+
+  // Ray Query
+  this->dataPtr->rayQuery = this->dataPtr->camera->Scene()->CreateRayQuery();
+  this->dataPtr->rayQuery->SetPreferGpu(this->gpuRayQuery);
+
+  // Build the shaders of the previous session's meshes and materials now,
+  // rather than while they're first seen
+  if (this->warmup && !this->shaderCacheDir.empty())
+  {
+    StartupTraceZone warmupZone(
+        gz::gui::App() ? gz::gui::App()->Trace() : nullptr,
+        "MinimalScene warm-up", "render");
+    RunWarmup(scene, LoadWarmup(common::joinPaths(this->shaderCacheDir,
+        "warmup_" + this->sceneName)));
+  }
+
+  // Share them with other plugins, so they don't search the scene
+  SceneServices::Set(SceneServices::kUserCamera, this->dataPtr->camera);
+  SceneServices::Set(SceneServices::kUserCameraRayQuery,
+      this->dataPtr->rayQuery);
+  SceneServices::Set(SceneServices::kLabels, this->labels);
+
+  this->initialized = true;
+  return {};
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::PreloadEngine()
+{
+  this->dataPtr->enginePreload.Start(this->engineName);
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI)
+{
+  // Create render interface and reset params
+  this->dataPtr->rhiParams.clear();
+
+  if (_graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  {
+    gzdbg << "Creating gz-rendering interface for OpenGL" << std::endl;
+    this->dataPtr->rhiParams["useCurrentGLContext"] = "1";
+    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiOpenGL>();
+  }
+  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
+  {
+    gzdbg << "Creating gz-rendering interface for Vulkan" << std::endl;
+    this->dataPtr->rhiParams["vulkan"] = "1";
+#if GZ_GUI_HAVE_VULKAN
+    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiVulkan>();
+#else
+    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiOpenGL>();
+#endif
+  }
+#if GZ_GUI_HAVE_METAL
+  else if (_graphicsAPI == rendering::GraphicsAPI::METAL)
+  {
+    gzdbg << "Creating gz-renderering interface for Metal" << std::endl;
+    this->dataPtr->rhiParams["metal"] = "1";
+    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiMetal>();
+  }
+#endif
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::Destroy()
+{
+  auto *engine = rendering::engine(this->engineName);
+  if (engine == nullptr)
+    return;
+  auto scene = engine->SceneByName(this->sceneName);
+  if (scene == nullptr)
+    return;
+  SceneServices::Remove(SceneServices::kUserCamera);
+  SceneServices::Remove(SceneServices::kUserCameraRayQuery);
+
+  // What the next session warms up with
+  if (this->warmup && !this->shaderCacheDir.empty())
+  {
+    const auto path = common::joinPaths(this->shaderCacheDir,
+        "warmup_" + this->sceneName);
+    if (!SaveWarmup(path, CollectWarmup(scene, 512u)))
+      gzwarn << "Failed to save warm-up list [" << path << "]" << std::endl;
+  }
+
+  scene->DestroySensor(this->dataPtr->camera);
+  for (auto &viewCamera : this->dataPtr->viewCameras)
+    scene->DestroySensor(viewCamera);
+
+  // If that was the last sensor, destroy scene
+  if (scene->SensorCount() == 0)
+  {
+    gzdbg << "Destroy scene [" << scene->Name() << "]" << std::endl;
+    engine->DestroyScene(scene);
+
+    // TODO(anyone) If that was the last scene, terminate engine?
+  }
+
+  // clean up in the rendering thread
+  this->dataPtr->spawnPreview.reset();
+  this->dataPtr->camera.reset();
+  this->dataPtr->viewCameras.clear();
+  this->dataPtr->rayQuery.reset();
+  this->dataPtr->lastPick.reset();
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::NewSpawnDrag(const std::string &_text,
+    const math::Vector2i &_pos)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->spawnDragText = _text;
+  this->dataPtr->spawnDragPos = _pos;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::NewHoverEvent(const math::Vector2i &_hoverPos)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Don't broadcast the same position again
+  if (_hoverPos == this->dataPtr->mouseHoverPos)
+    return;
+
+  this->dataPtr->mouseHoverPos = _hoverPos;
+  this->dataPtr->hoverDirty = true;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::NewDropEvent(const std::string &_dropText,
+  const math::Vector2i &_dropPos)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->dropText = _dropText;
+  this->dataPtr->mouseDropPos = _dropPos;
+  this->dataPtr->dropDirty = true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a mouse event can be merged into the event queued
+/// before it. Only moves and scrolls in the same state are merged, so
+/// presses, releases and the start and end of drags are never lost.
+/// \param[in] _prev Event queued last
+/// \param[in] _next New event
+/// \return True if _next can be merged into _prev
+static bool canCoalesce(const common::MouseEvent &_prev,
+    const common::MouseEvent &_next)
+{
+  if (_prev.Type() != _next.Type())
+    return false;
+
+  if (_next.Type() != common::MouseEvent::MOVE &&
+      _next.Type() != common::MouseEvent::SCROLL)
+  {
+    return false;
+  }
+
+  return _prev.Buttons() == _next.Buttons() &&
+      _prev.Dragging() == _next.Dragging() &&
+      _prev.PressPos() == _next.PressPos() &&
+      _prev.Control() == _next.Control() &&
+      _prev.Shift() == _next.Shift() &&
+      _prev.Alt() == _next.Alt();
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::NewMouseEvent(const common::MouseEvent &_e)
+{
+  if (this->inputRecorder)
+    this->inputRecorder->Add(_e);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->mouseDirty = true;
+  if (this->frameTiming && !this->dataPtr->inputTime)
+    this->dataPtr->inputTime = std::chrono::steady_clock::now();
+
+  // High polling rate mice send many events per frame. Consecutive moves
+  // only need the latest position, since listeners compute deltas from the
+  // positions they've already seen, and scrolls can be added up.
+  auto &events = this->dataPtr->mouseEvents;
+  if (!events.empty() && canCoalesce(events.back(), _e))
+  {
+    common::MouseEvent &last = events.back();
+    if (_e.Type() == common::MouseEvent::SCROLL)
+    {
+      const math::Vector2i scroll = last.Scroll() + _e.Scroll();
+      last = _e;
+      last.SetScroll(scroll);
+    }
+    else
+    {
+      last = _e;
+    }
+    return;
+  }
+
+  if (events.size() >= this->dataPtr->kMaxMouseEventSize)
+    events.pop_front();
+  events.push_back(_e);
+}
+
+/////////////////////////////////////////////////
+RenderThread::RenderThread()
+{
+  // Set default graphics API to OpenGL
+  const std::string backendApiName = gz::gui::renderEngineBackendApiName();
+  if (backendApiName == "vulkan")
+  {
+    this->SetGraphicsAPI(rendering::GraphicsAPI::VULKAN);
+  }
+  else if (backendApiName == "metal")
+  {
+    this->SetGraphicsAPI(rendering::GraphicsAPI::METAL);
+  }
+  else
+  {
+    this->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+  }
+
+  RenderWindowItem::Implementation::threads << this;
+  qRegisterMetaType<RenderSync*>("RenderSync*");
+}
+
+/////////////////////////////////////////////////
+void RenderThread::SetErrorCb(std::function<void(const QString&)> _cb)
+{
+  this->errorCb = std::move(_cb);
+}
+
+/////////////////////////////////////////////////
+void RenderThread::RenderNext(RenderSync *_renderSync)
+{
+  const bool paced = _renderSync->WaitForFrameStart();
+
+  // Stalls are frames taking too long, not waits between frames
+  if (!this->watched)
+  {
+    StallWatchdog::Watch("render");
+    this->watched = true;
+  }
+  StallWatchdog::Beat();
+
+  // Any request Qt makes from now on needs a new frame
+  _renderSync->renderPending = false;
+
+  const auto start = std::chrono::steady_clock::now();
+  this->rhi->RenderNext(_renderSync);
+  if (paced)
+    _renderSync->Rendered(std::chrono::steady_clock::now() - start);
+  emit this->TextureReady(
+    this->rhi->TexturePtr(),
+    this->rhi->TextureSize());
+  StallWatchdog::Idle();
+}
+
+/////////////////////////////////////////////////
+void RenderThread::ShutDown()
+{
+  // The render interface calls Destroy on GzRendering
+  this->rhi->ShutDown();
+  if (this->watched)
+  {
+    StallWatchdog::Unwatch();
+    this->watched = false;
+  }
+
+  // Stop event processing, move the thread to GUI and make sure it is deleted.
+  this->exit();
+  if (this->gzRenderer.initialized)
+    this->moveToThread(QGuiApplication::instance()->thread());
+}
+
+/////////////////////////////////////////////////
+void RenderThread::SizeChanged()
+{
+  auto *item = qobject_cast<QQuickItem *>(this->sender());
+  if (item == nullptr)
+  {
+    gzerr << "Internal error, sender is not QQuickItem." << std::endl;
+    return;
+  }
+
+  if (item->width() <= 0 || item->height() <= 0)
+    return;
+
+  this->gzRenderer.itemSize =
+    QSize(static_cast<int>(item->width()), static_cast<int>(item->height()));
+  this->gzRenderer.textureDirty = true;
+}
+
+/////////////////////////////////////////////////
+bool RenderThread::SupportsSwapBuffers() const
+{
+  return this->rhi->SupportsSwapBuffers();
+}
+
+/////////////////////////////////////////////////
+QOffscreenSurface *RenderThread::Surface() const
+{
+  return this->rhi->Surface();
+}
+
+/////////////////////////////////////////////////
+void RenderThread::SetSurface(QOffscreenSurface *_surface)
+{
+  this->rhi->SetSurface(_surface);
+}
+
+/////////////////////////////////////////////////
+QOpenGLContext *RenderThread::Context() const
+{
+  return this->rhi->Context();
+}
+
+/////////////////////////////////////////////////
+void RenderThread::SetContext(QOpenGLContext *_context)
+{
+  this->rhi->SetContext(_context);
+}
+
+/////////////////////////////////////////////////
+void RenderThread::SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI)
+{
+  // Set the graphics API for the GzRenderer
+  this->gzRenderer.SetGraphicsAPI(_graphicsAPI);
+
+  // Create the render interface
+  if (_graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  {
+    gzdbg << "Creating render thread interface for OpenGL" << std::endl;
+    this->rhi = std::make_unique<RenderThreadRhiOpenGL>(&this->gzRenderer);
+  }
+
+#if GZ_GUI_HAVE_VULKAN
+  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
+  {
+    gzdbg << "Creating render thread interface for Vulkan" << std::endl;
+    this->rhi = std::make_unique<RenderThreadRhiVulkan>(&this->gzRenderer);
+  }
+#endif  // GZ_GUI_HAVE_VULKAN
+#if GZ_GUI_HAVE_METAL
+  else if (_graphicsAPI == rendering::GraphicsAPI::METAL)
+  {
+    gzdbg << "Creating render thread interface for Metal" << std::endl;
+    this->rhi = std::make_unique<RenderThreadRhiMetal>(&this->gzRenderer);
+  }
+#endif  // GZ_GUI_HAVE_METAL
+}
+
+/////////////////////////////////////////////////
+void RenderThread::SetHeadless()
+{
+  this->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+  this->gzRenderer.headless = true;
+
+  gzdbg << "Creating render thread interface for headless rendering"
+        << std::endl;
+  this->rhi = std::make_unique<RenderThreadRhiHeadless>(&this->gzRenderer);
+}
+
+/////////////////////////////////////////////////
+std::string RenderThread::Initialize()
+{
+  auto loadingError = this->rhi->Initialize();
+  if (!loadingError.empty())
+  {
+    this->errorCb(QString::fromStdString(loadingError));
+  }
+  return loadingError;
+}
+
+/////////////////////////////////////////////////
+TextureNode::TextureNode(QQuickWindow *_window, RenderSync &_renderSync,
+                         const rendering::GraphicsAPI &_graphicsAPI,
+                         rendering::CameraPtr &_camera):
+  renderSync(_renderSync),
+  window(_window)
+{
+  this->rhi = CreateRhi(_window, _graphicsAPI, _camera);
+
+  this->setTexture(this->rhi->Texture());
+
+  // The texture may be smaller than the item when using dynamic resolution
+  this->setFiltering(QSGTexture::Linear);
+
+  this->defaultMaterial = this->material();
+  this->defaultOpaqueMaterial = this->opaqueMaterial();
+}
+
+/////////////////////////////////////////////////
+TextureNode::~TextureNode() = default;
+
+/////////////////////////////////////////////////
+std::unique_ptr<TextureNodeRhi> TextureNode::CreateRhi(QQuickWindow *_window,
+    const rendering::GraphicsAPI &_graphicsAPI, rendering::CameraPtr &_camera)
+{
+  (void) _camera;
+  if (_graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  {
+    gzdbg << "Creating texture node render interface for OpenGL" << std::endl;
+    return std::make_unique<TextureNodeRhiOpenGL>(_window);
+  }
+#if GZ_GUI_HAVE_VULKAN
+  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
+  {
+    gzdbg << "Creating texture node render interface for Vulkan" << std::endl;
+    return std::make_unique<TextureNodeRhiVulkan>(_window, _camera);
+  }
+#endif  // GZ_GUI_HAVE_VULKAN
+#if GZ_GUI_HAVE_METAL
+  else if (_graphicsAPI == rendering::GraphicsAPI::METAL)
+  {
+    gzdbg << "Creating texture node render interface for Metal" << std::endl;
+    return std::make_unique<TextureNodeRhiMetal>(_window);
+  }
+#endif  // GZ_GUI_HAVE_METAL
+
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+void TextureNode::AddView(const rendering::GraphicsAPI &_graphicsAPI,
+    rendering::CameraPtr &_camera, const math::Vector4d &_rect)
+{
+  ViewNode view;
+  view.rhi = CreateRhi(this->window, _graphicsAPI, _camera);
+  if (nullptr == view.rhi)
+    return;
+
+  // Drawn on top of the main texture because it's a child. The scene graph
+  // deletes it along with this node.
+  view.node = new QSGSimpleTextureNode();
+  view.node->setTexture(view.rhi->Texture());
+  view.node->setFiltering(QSGTexture::Linear);
+  view.rect = _rect;
+  this->appendChildNode(view.node);
+
+  this->views.push_back(std::move(view));
+}
+
+/////////////////////////////////////////////////
+void TextureNode::SetNodeRect(const QRectF &_rect)
+{
+  this->setRect(_rect);
+
+  for (auto &view : this->views)
+  {
+    view.node->setRect(QRectF(
+        _rect.x() + view.rect.X() * _rect.width(),
+        _rect.y() + view.rect.Y() * _rect.height(),
+        view.rect.Z() * _rect.width(),
+        view.rect.W() * _rect.height()));
+  }
+
+  this->UpdateMaterial();
+}
+
+/////////////////////////////////////////////////
+void TextureNode::SetSharpening(float _strength)
+{
+  if (_strength <= 0.0f)
+  {
+    this->sharpenMaterial.reset();
+  }
+  else if (this->window->rendererInterface()->graphicsApi() !=
+      QSGRendererInterface::OpenGL)
+  {
+    gzwarn << "<sharpen> is only supported by the OpenGL scene graph, "
+           << "the scene won't be sharpened." << std::endl;
+    this->sharpenMaterial.reset();
+  }
+  else
+  {
+    if (!this->sharpenMaterial)
+      this->sharpenMaterial = std::make_unique<SharpenMaterial>();
+    this->sharpenMaterial->SetStrength(_strength);
+  }
+  this->UpdateMaterial();
+}
+
+/////////////////////////////////////////////////
+void TextureNode::UpdateMaterial()
+{
+  QSGTexture *texture = this->texture();
+  bool upscaled{false};
+  if (this->sharpenMaterial && nullptr != texture)
+  {
+    const double ratio = this->window->devicePixelRatio();
+    const QSize size = texture->textureSize();
+    upscaled = size.width() < this->rect().width() * ratio - 0.5 ||
+               size.height() < this->rect().height() * ratio - 0.5;
+  }
+
+  QSGMaterial *newMaterial = this->defaultMaterial;
+  QSGMaterial *newOpaqueMaterial = this->defaultOpaqueMaterial;
+  if (upscaled)
+  {
+    this->sharpenMaterial->SetTexture(texture);
+    newMaterial = this->sharpenMaterial.get();
+    newOpaqueMaterial = nullptr;
+  }
+
+  if (this->material() != newMaterial ||
+      this->opaqueMaterial() != newOpaqueMaterial)
+  {
+    this->setMaterial(newMaterial);
+    this->setOpaqueMaterial(newOpaqueMaterial);
+    this->markDirty(DirtyMaterial);
+  }
+}
+
+/////////////////////////////////////////////////
+void TextureNode::NewTexture(void* _texturePtr, const QSize &_size)
+{
+  // When decoupled, PrepareNode picks up the texture from RenderSync instead,
+  // so Qt never switches to a buffer the worker may be writing to.
+  if (!this->renderSync.Decoupled())
+  {
+    this->rhi->NewTexture(_texturePtr, _size);
+
+    // Views are rendered in the same frame, and this is called from the
+    // worker thread right after
+    const std::size_t count = std::min(this->views.size(),
+        this->renderSync.viewTextures.size());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const auto &texture = this->renderSync.viewTextures[i];
+      this->views[i].rhi->NewTexture(texture.first, texture.second);
+    }
+  }
+
+  // We cannot call QQuickWindow::update directly here, as this is only allowed
+  // from the rendering thread or GUI thread.
+  emit PendingNewTexture();
+}
+
+/////////////////////////////////////////////////
+void TextureNode::PrepareNode()
+{
+  if (this->renderSync.Decoupled())
+  {
+    void *texturePtr{nullptr};
+    QSize textureSize;
+    if (this->renderSync.TakeReadyBuffer(texturePtr, textureSize))
+      this->rhi->NewTexture(texturePtr, textureSize);
+  }
+
+  this->rhi->PrepareNode();
+
+  if (this->rhi->HasNewTexture())
+  {
+    this->setTexture(this->rhi->Texture());
+    this->UpdateMaterial();
+
+    this->markDirty(DirtyMaterial);
+    this->renderSync.framePending = true;
+
+    if (App())
+      App()->Latency()->Ready("scene");
+
+    // This will notify the rendering thread that the texture is now being
+    // rendered and it can start rendering to the other one.
+    // emit TextureInUse(&this->renderSync); See comment below
+  }
+
+  for (auto &view : this->views)
+  {
+    view.rhi->PrepareNode();
+    if (view.rhi->HasNewTexture())
+    {
+      view.node->setTexture(view.rhi->Texture());
+      view.node->markDirty(DirtyMaterial);
+    }
+  }
+  // NOTE: The original code from Qt samples only emitted when
+  // newId is not null.
+  //
+  // This is correct... for their case.
+  // However we need to synchronize the threads when resolution changes,
+  // and we're also currently doing everything in lockstep (i.e. both Qt
+  // and worker thread are serialized,
+  // see https://github.com/gazebosim/gz-rendering/issues/304 )
+  //
+  // We need to emit even if newId == 0 because it's safe as long as both
+  // threads are forcefully serialized and otherwise we may get a
+  // deadlock (this func. called twice in a row with the worker thread still
+  // finishing the 1st iteration, may result in a deadlock for newer versions
+  // of Qt; as WaitForWorkerThread will be called with no corresponding
+  // WaitForQtThreadAndBlock as the worker thread thinks there are
+  // no more jobs to do.
+  //
+  // If we want these to run in worker thread and stay resolution-synchronized,
+  // we probably should use a different method of signals and slots
+  // to send work to the worker thread and get results back
+  if (this->renderSync.Decoupled())
+  {
+    // Ask for the next frame without waiting for it. Requests are coalesced
+    // so a slow worker doesn't build up a backlog of queued frames.
+    if (!this->renderSync.renderPending && this->CanRequestFrame())
+    {
+      this->renderSync.renderPending = true;
+      emit TextureInUse(&this->renderSync);
+    }
+    return;
+  }
+
+  // When rendering on demand or capping the frame rate, leave the worker
+  // waiting for us until a new frame can be rendered. Neither thread waits
+  // here, so they stay paired.
+  if (!this->CanRequestFrame())
+    return;
+
+  emit TextureInUse(&this->renderSync);
+
+  this->renderSync.WaitForWorkerThread();
+}
+
+/////////////////////////////////////////////////
+bool TextureNode::CanRequestFrame()
+{
+  // Nothing is rendered while hidden, until RenderWindowItem::SetHidden
+  // updates the window again
+  if (this->renderSync.hidden && this->renderSync.hiddenFps <= 0.0)
+    return false;
+
+  const auto delay = this->renderSync.FrameCapDelay();
+  if (delay.count() > 0)
+  {
+    // Come back once the cap allows a frame. The timer must be started from
+    // the thread the window lives in.
+    if (!this->renderSync.updateScheduled.exchange(true))
+    {
+      QQuickWindow *window = this->window;
+      QMetaObject::invokeMethod(window, [window, delay]()
+      {
+        QTimer::singleShot(delay, window, &QQuickWindow::update);
+      }, Qt::QueuedConnection);
+    }
+    return false;
+  }
+  this->renderSync.updateScheduled = false;
+
+  if (!this->renderSync.ConsumeFrameRequest())
+    return false;
+
+  this->renderSync.lastFrameRequest = std::chrono::steady_clock::now();
+  return true;
+}
+
+/////////////////////////////////////////////////
+RenderWindowItem::RenderWindowItem(QQuickItem *_parent)
+  : QQuickItem(_parent), dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->setAcceptedMouseButtons(Qt::AllButtons);
+  this->setFlag(ItemHasContents);
+  this->dataPtr->renderThread = new RenderThread();
+}
+
+/////////////////////////////////////////////////
+RenderWindowItem::~RenderWindowItem()
+{
+  this->StopRendering();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::StopRendering()
+{
+  this->dataPtr->renderRequestConnection.reset();
+
+  this->dataPtr->replayTimer.stop();
+  if (this->dataPtr->playbackHandle)
+    this->dataPtr->playbackHandle->Stop();
+  this->dataPtr->transportRecorder.reset();
+  if (this->dataPtr->renderThread->gzRenderer.inputRecorder)
+    this->dataPtr->renderThread->gzRenderer.inputRecorder->Stop();
+
+  // Disconnect our QT connections.
+  for (const auto &conn : qAsConst(this->dataPtr->connections))
+    QObject::disconnect(conn);
+
+  this->dataPtr->renderSync.Shutdown();
+  QMetaObject::invokeMethod(this->dataPtr->renderThread,
+                            "ShutDown",
+                            Qt::QueuedConnection);
+
+  this->dataPtr->renderThread->wait();
+}
+
+/////////////////////////////////////////////////
+// This slot will run on the main thread
+void RenderWindowItem::Ready()
+{
+  if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  {
+    this->dataPtr->renderThread->SetSurface(new QOffscreenSurface());
+    this->dataPtr->renderThread->Surface()->setFormat(
+        this->dataPtr->renderThread->Context()->format());
+    this->dataPtr->renderThread->Surface()->create();
+  }
+
+  // Carry out initialization on main thread before moving to render thread
+  if (!this->dataPtr->renderThread->Initialize().empty())
+  {
+    return;
+  }
+
+  if (this->dataPtr->renderSync.Decoupled() &&
+      !this->dataPtr->renderThread->SupportsSwapBuffers())
+  {
+    gzwarn << "<texture_buffer_count> is not supported with graphics API ["
+           << rendering::GraphicsAPIUtils::Str(this->dataPtr->graphicsAPI)
+           << "]. Rendering will be synchronized with the Qt thread."
+           << std::endl;
+    this->dataPtr->renderSync.bufferCount = 1u;
+  }
+
+  if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  {
+    // Move context to the render thread
+    this->dataPtr->renderThread->Context()->moveToThread(
+        this->dataPtr->renderThread);
+  }
+
+  this->dataPtr->renderThread->moveToThread(this->dataPtr->renderThread);
+
+  this->dataPtr->renderThread->gzRenderer.itemSize =
+    QSize(static_cast<int>(std::max({ this->width(), 1.0 })),
+          static_cast<int>(std::max({ this->height(), 1.0 })));
+
+  this->connect(this, &QQuickItem::widthChanged,
+      this->dataPtr->renderThread, &RenderThread::SizeChanged);
+  this->connect(this, &QQuickItem::heightChanged,
+      this->dataPtr->renderThread, &RenderThread::SizeChanged);
+
+  // A scale relative to physical pixels follows the screen the window is on
+  auto *renderThread = this->dataPtr->renderThread;
+  auto renderScale = [this]()
+  {
+    double scale = this->dataPtr->renderScale;
+    if (this->dataPtr->renderScaleDevicePixels && nullptr != this->window())
+      scale *= this->window()->devicePixelRatio();
+    return scale;
+  };
+  renderThread->gzRenderer.renderScale = renderScale();
+  if (this->dataPtr->renderScaleDevicePixels && nullptr != this->window())
+  {
+    this->connect(this->window(), &QWindow::screenChanged, this,
+        [this, renderThread, renderScale]()
+        {
+          const double scale = renderScale();
+          QMetaObject::invokeMethod(renderThread, [renderThread, scale]()
+          {
+            renderThread->gzRenderer.renderScale = scale;
+            renderThread->gzRenderer.textureDirty = true;
+          }, Qt::QueuedConnection);
+          this->dataPtr->renderSync.RequestFrames(2u);
+          this->update();
+        });
+  }
+
+  if (this->dataPtr->renderSync.renderOnDemand)
+  {
+    this->dataPtr->renderRequestConnection = RenderHooks::OnRenderRequest(
+        [this]()
+        {
+          this->RequestRender();
+        });
+
+    // The new size reaches the render thread through its event queue, after
+    // the frame which is already waiting to be rendered, so it only shows up
+    // on the one after.
+    auto onResize = [this]()
+    {
+      this->dataPtr->renderSync.RequestFrames(2u);
+      this->update();
+    };
+    this->connect(this, &QQuickItem::widthChanged, this, onResize);
+    this->connect(this, &QQuickItem::heightChanged, this, onResize);
+  }
+
+  // Applied by the render thread itself, before its event loop starts
+  if (!this->dataPtr->renderThreadPolicy.Empty())
+  {
+    const ThreadPolicy policy = this->dataPtr->renderThreadPolicy;
+    this->connect(this->dataPtr->renderThread, &QThread::started,
+        this->dataPtr->renderThread, [policy]()
+        {
+          policy.ApplyToCurrentThread();
+        }, Qt::DirectConnection);
+  }
+
+  this->dataPtr->renderThread->start();
+  this->dataPtr->initializing = false;
+  this->dataPtr->initialized = true;
+  this->update();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::StartHeadless(const QSize &_size, double _fps)
+{
+  if (this->dataPtr->initialized || this->dataPtr->initializing)
+  {
+    gzerr << "Unable to render headless, rendering has already started"
+          << std::endl;
+    return;
+  }
+  this->dataPtr->headless = true;
+  this->dataPtr->initialized = true;
+
+  // There's no Qt thread to hand textures to, so frames are neither
+  // synchronized with it nor copied into a swap chain
+  auto *renderThread = this->dataPtr->renderThread;
+  auto *renderSync = &this->dataPtr->renderSync;
+  renderSync->headless = true;
+  renderSync->bufferCount = 1u;
+  renderThread->SetHeadless();
+  renderThread->gzRenderer.itemSize = _size;
+  renderThread->gzRenderer.renderScale = this->dataPtr->renderScale;
+  renderThread->moveToThread(renderThread);
+
+  if (this->dataPtr->firstFrameCb)
+  {
+    this->dataPtr->connections << this->connect(renderThread,
+        &RenderThread::TextureReady, this, [this]()
+        {
+          auto cb = std::move(this->dataPtr->firstFrameCb);
+          this->dataPtr->firstFrameCb = nullptr;
+          if (cb)
+            cb();
+        }, Qt::QueuedConnection);
+  }
+
+  if (renderSync->renderOnDemand)
+  {
+    this->dataPtr->renderRequestConnection = RenderHooks::OnRenderRequest(
+        [this]()
+        {
+          this->RequestRender();
+        });
+  }
+
+  // The render thread paces itself with a timer, since there's no window
+  // to drive it. The engine is loaded on the first frame, on that thread.
+  const ThreadPolicy policy = this->dataPtr->renderThreadPolicy;
+  const auto period = std::chrono::milliseconds(
+      static_cast<int64_t>(std::lround(1000.0 / _fps)));
+  this->connect(renderThread, &QThread::started, renderThread,
+      [renderThread, renderSync, policy, period]()
+      {
+        if (!policy.Empty())
+          policy.ApplyToCurrentThread();
+
+        auto *timer = new QTimer(renderThread);
+        timer->setTimerType(Qt::PreciseTimer);
+        QObject::connect(timer, &QTimer::timeout, renderThread,
+            [renderThread, renderSync]()
+            {
+              if (renderSync->ConsumeFrameRequest())
+                renderThread->RenderNext(renderSync);
+            });
+        timer->start(period);
+      }, Qt::DirectConnection);
+
+  gzmsg << "Rendering headless at " << _size.width() << "x"
+        << _size.height() << ", " << _fps << " FPS" << std::endl;
+  renderThread->start();
+}
+
+/////////////////////////////////////////////////
+QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
+    QQuickItem::UpdatePaintNodeData * /*_data*/)
+{
+  TextureNode *node = static_cast<TextureNode *>(_node);
+
+  // Nothing is shown while rendering headless
+  if (this->dataPtr->headless)
+    return nullptr;
+
+  if (!this->dataPtr->initialized)
+  {
+    // Exit immediately if still initializing
+    if (this->dataPtr->initializing)
+    {
+      return nullptr;
+    }
+    this->dataPtr->initializing = true;
+
+    // Set the render thread's render system
+    this->dataPtr->renderThread->SetGraphicsAPI(
+        this->dataPtr->graphicsAPI);
+
+    if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+    {
+      auto *rif = this->window()->rendererInterface();
       Q_ASSERT(rif->graphicsApi() == QSGRendererInterface::OpenGL);
 
       auto *current =  static_cast<QOpenGLContext*>(
@@ -1241,6 +3264,15 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
     auto camera = this->dataPtr->renderThread->gzRenderer.Camera();
     node = new TextureNode(this->window(), this->dataPtr->renderSync,
                            this->dataPtr->graphicsAPI, camera);
+    node->SetSharpening(this->dataPtr->sharpen);
+
+    auto &renderer = this->dataPtr->renderThread->gzRenderer;
+    for (std::size_t i = 0; i < renderer.views.size(); ++i)
+    {
+      auto viewCamera = renderer.ViewCamera(i);
+      node->AddView(this->dataPtr->graphicsAPI, viewCamera,
+          renderer.views[i].rect);
+    }
 
     // Set up connections to get the production of render texture in sync with
     // vsync on the rendering thread.
@@ -1262,6 +3294,18 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
     this->dataPtr->connections << this->connect(this->dataPtr->renderThread,
         &RenderThread::TextureReady, node, &TextureNode::NewTexture,
         Qt::DirectConnection);
+    if (this->dataPtr->firstFrameCb)
+    {
+      this->dataPtr->connections << this->connect(
+          this->dataPtr->renderThread, &RenderThread::TextureReady, this,
+          [this]()
+          {
+            auto cb = std::move(this->dataPtr->firstFrameCb);
+            this->dataPtr->firstFrameCb = nullptr;
+            if (cb)
+              cb();
+          }, Qt::QueuedConnection);
+    }
     this->dataPtr->connections << this->connect(node,
         &TextureNode::PendingNewTexture, this->window(),
         &QQuickWindow::update, Qt::QueuedConnection);
@@ -1272,13 +3316,54 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
         &TextureNode::TextureInUse, this->dataPtr->renderThread,
         &RenderThread::RenderNext, Qt::QueuedConnection);
 
+    // Follow the display refresh from the times Qt's buffer swaps return,
+    // to pace frames and report when they're shown
+    RenderSync *renderSync = &this->dataPtr->renderSync;
+    this->dataPtr->connections << this->connect(this->window(),
+        &QQuickWindow::frameSwapped, this->window(), [renderSync]()
+        {
+          renderSync->Presented();
+        }, Qt::DirectConnection);
+    auto updateRefreshRate = [this]()
+    {
+      QScreen *screen = this->window()->screen();
+      this->dataPtr->renderSync.SetRefreshRate(
+          screen ? screen->refreshRate() : 0.0);
+    };
+    updateRefreshRate();
+    this->dataPtr->connections << this->connect(this->window(),
+        &QWindow::screenChanged, this, updateRefreshRate);
+
+    // Time the phases of Qt Quick frames, each signal being emitted on the
+    // thread running the phase
+    if (auto quickTiming = renderer.quickTiming)
+    {
+      QQuickWindow *window = this->window();
+      this->dataPtr->connections << this->connect(window,
+          &QQuickWindow::afterAnimating, window,
+          [quickTiming]() {quickTiming->Animated();}, Qt::DirectConnection);
+      this->dataPtr->connections << this->connect(window,
+          &QQuickWindow::beforeSynchronizing, window,
+          [quickTiming]() {quickTiming->BeginSync();}, Qt::DirectConnection);
+      this->dataPtr->connections << this->connect(window,
+          &QQuickWindow::afterSynchronizing, window,
+          [quickTiming]() {quickTiming->EndSync();}, Qt::DirectConnection);
+      this->dataPtr->connections << this->connect(window,
+          &QQuickWindow::afterRendering, window,
+          [quickTiming]() {quickTiming->EndRender();}, Qt::DirectConnection);
+      this->dataPtr->connections << this->connect(window,
+          &QQuickWindow::frameSwapped, window,
+          [quickTiming]() {quickTiming->Swapped();}, Qt::DirectConnection);
+    }
+
     // Get the production of FBO textures started..
+    this->dataPtr->renderSync.renderPending = true;
     QMetaObject::invokeMethod(this->dataPtr->renderThread, "RenderNext",
       Qt::QueuedConnection,
       Q_ARG(RenderSync*, &node->renderSync));
   }
 
-  node->setRect(this->boundingRect());
+  node->SetNodeRect(this->boundingRect());
 
   return node;
 }
@@ -1290,298 +3375,1167 @@ void RenderWindowItem::SetBackgroundColor(const math::Color &_color)
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::SetAmbientLight(const math::Color &_ambient)
+void RenderWindowItem::SetAmbientLight(const math::Color &_ambient)
+{
+  this->dataPtr->renderThread->gzRenderer.ambientLight = _ambient;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetEngineName(const std::string &_name)
+{
+  this->dataPtr->renderThread->gzRenderer.engineName = _name;
+  this->dataPtr->renderThread->gzRenderer.PreloadEngine();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetSceneName(const std::string &_name)
+{
+  this->dataPtr->renderThread->gzRenderer.sceneName = _name;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetCameraPose(const math::Pose3d &_pose)
+{
+  this->dataPtr->renderThread->gzRenderer.cameraPose = _pose;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetCameraNearClip(double _near)
+{
+  this->dataPtr->renderThread->gzRenderer.cameraNearClip = _near;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetCameraFarClip(double _far)
+{
+  this->dataPtr->renderThread->gzRenderer.cameraFarClip = _far;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetSkyEnabled(const bool &_sky)
+{
+  this->dataPtr->renderThread->gzRenderer.skyEnable = _sky;
+}
+
+/////////////////////////////////////////////////
+bool RenderWindowItem::SetShadowTextureSize(rendering::LightType _lightType,
+    unsigned int _textureSize)
+{
+  if (_lightType == rendering::LightType::DIRECTIONAL)
+  {
+    this->dataPtr->renderThread->gzRenderer.directionalLightTextureSize =
+        _textureSize;
+    return true;
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetGraphicsAPI(
+    const rendering::GraphicsAPI &_graphicsAPI)
+{
+  this->dataPtr->graphicsAPI = _graphicsAPI;
+  this->dataPtr->renderThread->SetGraphicsAPI(_graphicsAPI);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetTextureBufferCount(unsigned int _count)
+{
+  this->dataPtr->renderSync.bufferCount = _count;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderOnDemand(bool _onDemand)
+{
+  this->dataPtr->renderSync.renderOnDemand = _onDemand;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetMaxFps(double _fps)
+{
+  this->dataPtr->renderSync.maxFps = _fps;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetFrameTaskBudget(
+    std::chrono::steady_clock::duration _budget)
+{
+  this->dataPtr->renderThread->gzRenderer.frameTaskBudget = _budget;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderThreadPolicy(const ThreadPolicy &_policy)
+{
+  this->dataPtr->renderThreadPolicy = _policy;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetVsyncPacing(bool _pacing)
+{
+  this->dataPtr->renderSync.vsyncPacing = _pacing;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetResizeDelay(
+    std::chrono::steady_clock::duration _delay)
+{
+  this->dataPtr->renderThread->gzRenderer.resizeDelay = _delay;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetTextureSizeStep(int _step)
+{
+  this->dataPtr->renderThread->gzRenderer.textureSizeStep = _step;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderScale(double _scale, bool _devicePixels,
+    double _sharpen)
+{
+  this->dataPtr->renderScale = _scale;
+  this->dataPtr->renderScaleDevicePixels = _devicePixels;
+  this->dataPtr->sharpen = static_cast<float>(std::clamp(_sharpen, 0.0, 1.0));
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetHiddenFps(double _fps)
+{
+  this->dataPtr->renderSync.hiddenFps = _fps;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetHidden(bool _hidden)
+{
+  if (this->dataPtr->renderSync.hidden.exchange(_hidden) == _hidden)
+    return;
+
+  // Show the current scene right away, without waiting for the frame the
+  // hidden rate scheduled
+  if (!_hidden)
+  {
+    this->dataPtr->renderSync.RequestFrames(1u);
+    this->update();
+  }
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetSceneCommandBudget(
+    std::chrono::steady_clock::duration _budget)
+{
+  this->dataPtr->renderThread->gzRenderer.sceneCommandBudget = _budget;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetGpuUploadBudget(std::size_t _budget)
+{
+  this->dataPtr->renderThread->gzRenderer.gpuUploadBudget = _budget;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetDynamicResolution(bool _enabled, double _targetFps,
+    double _minScale)
+{
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  renderer.dynamicResolution = _enabled;
+  renderer.targetFps = _targetFps;
+  renderer.minResolutionScale = _minScale;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetViews(const std::vector<SceneView> &_views)
+{
+  if (!_views.empty() && this->dataPtr->renderSync.Decoupled())
+  {
+    gzwarn << "<view> is not supported with <texture_buffer_count> larger "
+           << "than 1. Only the main view will be rendered." << std::endl;
+    return;
+  }
+
+  this->dataPtr->renderThread->gzRenderer.views = _views;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetFrameTiming(const std::string &_topic,
+    std::function<void(const std::string &)> _cb)
+{
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  renderer.frameTiming = true;
+  renderer.frameTimingTopic = _topic;
+  renderer.frameTimingCb = std::move(_cb);
+  renderer.quickTiming = std::make_shared<QuickFrameTiming>();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<SceneLabels> RenderWindowItem::Labels() const
+{
+  return this->dataPtr->renderThread->gzRenderer.labels;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetLabelsCallback(std::function<void(
+    std::vector<PlacedLabel>, unsigned int, unsigned int)> _cb)
+{
+  this->dataPtr->renderThread->gzRenderer.labelsCb = std::move(_cb);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetGpuRayQuery(bool _gpu)
+{
+  this->dataPtr->renderThread->gzRenderer.gpuRayQuery = _gpu;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetShaderCache(const std::string &_dir, bool _warmup)
 {
-  this->dataPtr->renderThread->gzRenderer.ambientLight = _ambient;
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  renderer.shaderCacheDir = _dir;
+  renderer.warmup = _warmup;
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::SetEngineName(const std::string &_name)
+void RenderWindowItem::SetQuality(const std::string &_preset)
 {
-  this->dataPtr->renderThread->gzRenderer.engineName = _name;
+  this->dataPtr->renderThread->gzRenderer.SetQuality(_preset);
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::SetSceneName(const std::string &_name)
+void RenderWindowItem::SetQualityDowngrade(double _targetFps,
+    std::function<void(const std::string &)> _cb)
 {
-  this->dataPtr->renderThread->gzRenderer.sceneName = _name;
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  renderer.qualityTargetFps = _targetFps;
+  renderer.qualityCb = std::move(_cb);
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::SetCameraPose(const math::Pose3d &_pose)
+void RenderWindowItem::RequestRender()
 {
-  this->dataPtr->renderThread->gzRenderer.cameraPose = _pose;
+  if (!this->dataPtr->renderSync.renderOnDemand)
+    return;
+
+  this->dataPtr->renderSync.RequestFrames(1u);
+
+  // May be called from any thread
+  QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::SetCameraNearClip(double _near)
+void RenderWindowItem::SetCameraHFOV(const math::Angle &_fov)
 {
-  this->dataPtr->renderThread->gzRenderer.cameraNearClip = _near;
+  this->dataPtr->renderThread->gzRenderer.cameraHFOV = _fov;
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::SetCameraFarClip(double _far)
+void RenderWindowItem::SetCameraViewController(
+  const std::string &_view_controller)
 {
-  this->dataPtr->renderThread->gzRenderer.cameraFarClip = _far;
+  this->dataPtr->renderThread->gzRenderer.cameraViewController =
+    _view_controller;
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::SetSkyEnabled(const bool &_sky)
+MinimalScene::MinimalScene()
+  : Plugin(), dataPtr(utils::MakeUniqueImpl<Implementation>())
 {
-  this->dataPtr->renderThread->gzRenderer.skyEnable = _sky;
+  qmlRegisterType<RenderWindowItem>("RenderWindow", 1, 0, "RenderWindow");
 }
 
 /////////////////////////////////////////////////
-bool RenderWindowItem::SetShadowTextureSize(rendering::LightType _lightType,
-    unsigned int _textureSize)
+void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
-  if (_lightType == rendering::LightType::DIRECTIONAL)
+  RenderWindowItem *renderWindow =
+      this->PluginItem()->findChild<RenderWindowItem *>();
+  if (!renderWindow)
   {
-    this->dataPtr->renderThread->gzRenderer.directionalLightTextureSize =
-        _textureSize;
-    return true;
+    gzerr << "Unable to find Render Window item. "
+           << "Render window will not be created" << std::endl;
+    return;
   }
+  renderWindow->SetErrorCb(std::bind(&MinimalScene::SetLoadingError, this,
+      std::placeholders::_1));
+  renderWindow->SetFirstFrameCb([this, renderWindow]()
+  {
+    this->sceneReady = true;
+    emit this->SceneReadyChanged();
 
-  return false;
-}
+    // Input is recorded and replayed from the first frame
+    renderWindow->StartInputSession();
+  });
 
-/////////////////////////////////////////////////
-void RenderWindowItem::SetGraphicsAPI(
-    const rendering::GraphicsAPI &_graphicsAPI)
-{
-  this->dataPtr->graphicsAPI = _graphicsAPI;
-  this->dataPtr->renderThread->SetGraphicsAPI(_graphicsAPI);
-}
+  // Called from the render thread
+  renderWindow->SetLabelsCallback([this](std::vector<PlacedLabel> _labels,
+      unsigned int _width, unsigned int _height)
+  {
+    QMetaObject::invokeMethod(this,
+        [this, labels = std::move(_labels), _width, _height]() mutable
+        {
+          this->dataPtr->labels.Set(std::move(labels), _width, _height);
+        }, Qt::QueuedConnection);
+  });
 
-/////////////////////////////////////////////////
-void RenderWindowItem::SetCameraHFOV(const math::Angle &_fov)
-{
-  this->dataPtr->renderThread->gzRenderer.cameraHFOV = _fov;
-}
+  if (this->title.empty())
+    this->title = "3D Scene";
+
+  std::string cmdRenderEngine = gui::renderEngineName();
+
+  // Size and frame rate, see <headless>
+  std::optional<std::pair<QSize, double>> headless;
+
+  // Custom parameters
+  if (_pluginElem)
+  {
+    // Only pick engine from XML if none is set on the Window
+    if (cmdRenderEngine.empty())
+    {
+      auto elem = _pluginElem->FirstChildElement("engine");
+      if (nullptr != elem && nullptr != elem->GetText())
+      {
+        cmdRenderEngine = elem->GetText();
+      }
+    }
+
+    auto elem = _pluginElem->FirstChildElement("scene");
+    if (nullptr != elem && nullptr != elem->GetText())
+      renderWindow->SetSceneName(elem->GetText());
+
+    elem = _pluginElem->FirstChildElement("ambient_light");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      math::Color ambient;
+      std::stringstream colorStr;
+      colorStr << std::string(elem->GetText());
+      colorStr >> ambient;
+      renderWindow->SetAmbientLight(ambient);
+    }
+
+    elem = _pluginElem->FirstChildElement("background_color");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      math::Color bgColor;
+      std::stringstream colorStr;
+      colorStr << std::string(elem->GetText());
+      colorStr >> bgColor;
+      renderWindow->SetBackgroundColor(bgColor);
+    }
+
+    elem = _pluginElem->FirstChildElement("camera_pose");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      math::Pose3d pose;
+      std::stringstream poseStr;
+      poseStr << std::string(elem->GetText());
+      poseStr >> pose;
+      renderWindow->SetCameraPose(pose);
+    }
+
+    elem = _pluginElem->FirstChildElement("camera_clip");
+    if (nullptr != elem && !elem->NoChildren())
+    {
+      auto child = elem->FirstChildElement("near");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        double n;
+        std::stringstream nearStr;
+        nearStr << std::string(child->GetText());
+        nearStr >> n;
+        if (nearStr.fail())
+        {
+          gzerr << "Unable to set <near> to '" << nearStr.str()
+                 << "' using default near clip distance" << std::endl;
+        }
+        else
+        {
+          renderWindow->SetCameraNearClip(n);
+        }
+      }
+
+      child = elem->FirstChildElement("far");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        double f;
+        std::stringstream farStr;
+        farStr << std::string(child->GetText());
+        farStr >> f;
+        if (farStr.fail())
+        {
+          gzerr << "Unable to set <far> to '" << farStr.str()
+                 << "' using default far clip distance" << std::endl;
+        }
+        else
+        {
+          renderWindow->SetCameraFarClip(f);
+        }
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("sky");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      renderWindow->SetSkyEnabled(true);
+      if (!elem->NoChildren())
+        gzwarn << "Child elements of <sky> are not supported yet"
+                << std::endl;
+    }
+
+    elem = _pluginElem->FirstChildElement("shadows");
+    if (nullptr != elem && !elem->NoChildren())
+    {
+      auto textureSizeElem = elem->FirstChildElement("texture_size");
+      if (nullptr != elem && nullptr != textureSizeElem->GetText())
+      {
+        unsigned int texSize;
+        std::stringstream texSizeStr;
+        texSizeStr << std::string(textureSizeElem->GetText());
+        texSizeStr >> texSize;
+        if (texSizeStr.fail())
+        {
+          gzerr << "Unable to set shadow <texture_size> to '"
+                << texSizeStr.str()
+                << "' using default texture size" << std::endl;
+        }
+        else
+        {
+          std::string lightType = textureSizeElem->Attribute("light_type");
+          if (lightType == "directional")
+          {
+            if (!renderWindow->SetShadowTextureSize(
+                rendering::LightType::DIRECTIONAL, texSize))
+            {
+              gzerr << "Unable to set shadow <texture_size> to '"
+                    << texSizeStr.str()
+                    << "' using default texture size" << std::endl;
+            }
+          }
+          else
+          {
+            gzerr << "Setting shadow <texture_size> for light type ["
+                  << lightType << "] is not supported." << std::endl;
+          }
+        }
+      }
+    }
+
+    const std::string backendApiName = gz::gui::renderEngineBackendApiName();
+    if (backendApiName == "vulkan")
+    {
+      renderWindow->SetGraphicsAPI(rendering::GraphicsAPI::VULKAN);
+    }
+    else if (backendApiName == "metal")
+    {
+      renderWindow->SetGraphicsAPI(rendering::GraphicsAPI::METAL);
+    }
+    else
+    {
+      renderWindow->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+    }
+
+    elem = _pluginElem->FirstChildElement("graphics_api");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      rendering::GraphicsAPI graphicsAPI =
+          rendering::GraphicsAPIUtils::Set(elem->GetText());
+      renderWindow->SetGraphicsAPI(graphicsAPI);
+    }
+
+    elem = _pluginElem->FirstChildElement("horizontal_fov");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double fovDeg;
+      math::Angle fov;
+      std::stringstream fovStr;
+      fovStr << std::string(elem->GetText());
+      fovStr >> fovDeg;
+      if (fovStr.fail())
+      {
+        gzerr << "Unable to set <horizontal_fov> to '" << fovStr.str()
+              << "' using default horizontal field of view" << std::endl;
+      }
+      else
+      {
+        fov.SetDegree(fovDeg);
+        renderWindow->SetCameraHFOV(fov);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("view_controller");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      renderWindow->SetCameraViewController(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("texture_buffer_count");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      unsigned int count;
+      std::stringstream countStr;
+      countStr << std::string(elem->GetText());
+      countStr >> count;
+      if (countStr.fail() || count < 1u || count > 3u)
+      {
+        gzerr << "Unable to set <texture_buffer_count> to '"
+              << countStr.str() << "', valid values are 1, 2 and 3. "
+              << "Rendering will be synchronized with the Qt thread."
+              << std::endl;
+      }
+      else
+      {
+        renderWindow->SetTextureBufferCount(count);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("vsync_pacing");
+    if (nullptr != elem)
+    {
+      bool pacing{false};
+      if (elem->QueryBoolText(&pacing) != tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Unable to set <vsync_pacing>, expected a boolean. "
+              << "Frames won't be paced." << std::endl;
+      }
+      else
+      {
+        renderWindow->SetVsyncPacing(pacing);
+      }
+    }
 
-/////////////////////////////////////////////////
-void RenderWindowItem::SetCameraViewController(
-  const std::string &_view_controller)
-{
-  this->dataPtr->renderThread->gzRenderer.cameraViewController =
-    _view_controller;
-}
+    elem = _pluginElem->FirstChildElement("render_thread");
+    if (nullptr != elem)
+    {
+      ThreadPolicy policy;
+      policy.Load(elem);
+      renderWindow->SetRenderThreadPolicy(policy);
+    }
 
-/////////////////////////////////////////////////
-MinimalScene::MinimalScene()
-  : Plugin(), dataPtr(utils::MakeUniqueImpl<Implementation>())
-{
-  qmlRegisterType<RenderWindowItem>("RenderWindow", 1, 0, "RenderWindow");
-}
+    elem = _pluginElem->FirstChildElement("render_on_demand");
+    if (nullptr != elem)
+    {
+      bool onDemand{false};
+      if (elem->QueryBoolText(&onDemand) != tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Unable to set <render_on_demand>, expected a boolean. "
+              << "Rendering continuously." << std::endl;
+      }
+      else
+      {
+        renderWindow->SetRenderOnDemand(onDemand);
+      }
+    }
 
-/////////////////////////////////////////////////
-void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
-{
-  RenderWindowItem *renderWindow =
-      this->PluginItem()->findChild<RenderWindowItem *>();
-  if (!renderWindow)
-  {
-    gzerr << "Unable to find Render Window item. "
-           << "Render window will not be created" << std::endl;
-    return;
-  }
-  renderWindow->SetErrorCb(std::bind(&MinimalScene::SetLoadingError, this,
-      std::placeholders::_1));
+    double maxFps{0.0};
+    elem = _pluginElem->FirstChildElement("max_fps");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      std::stringstream fpsStr;
+      fpsStr << std::string(elem->GetText());
+      fpsStr >> maxFps;
+      if (fpsStr.fail() || maxFps < 0.0)
+      {
+        gzerr << "Unable to set <max_fps> to '" << fpsStr.str()
+              << "', using no limit" << std::endl;
+        maxFps = 0.0;
+      }
+      renderWindow->SetMaxFps(maxFps);
+    }
 
-  if (this->title.empty())
-    this->title = "3D Scene";
+    elem = _pluginElem->FirstChildElement("hidden_fps");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double hiddenFps{1.0};
+      if (elem->QueryDoubleText(&hiddenFps) != tinyxml2::XML_SUCCESS ||
+          hiddenFps < 0.0)
+      {
+        gzerr << "Unable to set <hidden_fps> to '" << elem->GetText()
+              << "', using 1" << std::endl;
+        hiddenFps = 1.0;
+      }
+      renderWindow->SetHiddenFps(hiddenFps);
+    }
 
-  std::string cmdRenderEngine = gui::renderEngineName();
-  // Custom parameters
-  if (_pluginElem)
-  {
-    // Only pick engine from XML if none is set on the Window
-    if (cmdRenderEngine.empty())
+    elem = _pluginElem->FirstChildElement("scene_command_budget");
+    if (nullptr != elem && nullptr != elem->GetText())
     {
-      auto elem = _pluginElem->FirstChildElement("engine");
-      if (nullptr != elem && nullptr != elem->GetText())
+      double budget{0.0};
+      std::stringstream budgetStr;
+      budgetStr << std::string(elem->GetText());
+      budgetStr >> budget;
+      if (budgetStr.fail() || budget < 0.0)
       {
-        cmdRenderEngine = elem->GetText();
+        gzerr << "Unable to set <scene_command_budget> to '"
+              << budgetStr.str() << "', using default" << std::endl;
+      }
+      else
+      {
+        renderWindow->SetSceneCommandBudget(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budget)));
       }
     }
 
-    auto elem = _pluginElem->FirstChildElement("scene");
+    elem = _pluginElem->FirstChildElement("frame_task_budget");
     if (nullptr != elem && nullptr != elem->GetText())
-      renderWindow->SetSceneName(elem->GetText());
+    {
+      double budget{0.0};
+      std::stringstream budgetStr;
+      budgetStr << std::string(elem->GetText());
+      budgetStr >> budget;
+      if (budgetStr.fail() || budget < 0.0)
+      {
+        gzerr << "Unable to set <frame_task_budget> to '"
+              << budgetStr.str() << "', using default" << std::endl;
+      }
+      else
+      {
+        renderWindow->SetFrameTaskBudget(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budget)));
+      }
+    }
 
-    elem = _pluginElem->FirstChildElement("ambient_light");
+    elem = _pluginElem->FirstChildElement("gpu_upload_budget");
     if (nullptr != elem && nullptr != elem->GetText())
     {
-      math::Color ambient;
-      std::stringstream colorStr;
-      colorStr << std::string(elem->GetText());
-      colorStr >> ambient;
-      renderWindow->SetAmbientLight(ambient);
+      double budget{0.0};
+      if (elem->QueryDoubleText(&budget) != tinyxml2::XML_SUCCESS ||
+          budget < 0.0)
+      {
+        gzerr << "Unable to set <gpu_upload_budget> to '" << elem->GetText()
+              << "', using default" << std::endl;
+      }
+      else
+      {
+        renderWindow->SetGpuUploadBudget(
+            static_cast<std::size_t>(budget * 1024 * 1024));
+      }
     }
 
-    elem = _pluginElem->FirstChildElement("background_color");
+    elem = _pluginElem->FirstChildElement("resize_delay");
     if (nullptr != elem && nullptr != elem->GetText())
     {
-      math::Color bgColor;
-      std::stringstream colorStr;
-      colorStr << std::string(elem->GetText());
-      colorStr >> bgColor;
-      renderWindow->SetBackgroundColor(bgColor);
+      double delay{0.0};
+      if (elem->QueryDoubleText(&delay) != tinyxml2::XML_SUCCESS ||
+          delay < 0.0)
+      {
+        gzerr << "Unable to set <resize_delay> to '" << elem->GetText()
+              << "', using default" << std::endl;
+      }
+      else
+      {
+        renderWindow->SetResizeDelay(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(delay)));
+      }
     }
 
-    elem = _pluginElem->FirstChildElement("camera_pose");
+    elem = _pluginElem->FirstChildElement("texture_size_step");
     if (nullptr != elem && nullptr != elem->GetText())
     {
-      math::Pose3d pose;
-      std::stringstream poseStr;
-      poseStr << std::string(elem->GetText());
-      poseStr >> pose;
-      renderWindow->SetCameraPose(pose);
+      int step{1};
+      if (elem->QueryIntText(&step) != tinyxml2::XML_SUCCESS || step < 1)
+      {
+        gzerr << "Unable to set <texture_size_step> to '" << elem->GetText()
+              << "', using 1" << std::endl;
+      }
+      else
+      {
+        renderWindow->SetTextureSizeStep(step);
+      }
     }
 
-    elem = _pluginElem->FirstChildElement("camera_clip");
-    if (nullptr != elem && !elem->NoChildren())
+    elem = _pluginElem->FirstChildElement("render_scale");
+    if (nullptr != elem)
     {
-      auto child = elem->FirstChildElement("near");
+      double scale{1.0};
+      auto child = elem->FirstChildElement("scale");
+      if (nullptr != child && nullptr != child->GetText() &&
+          (child->QueryDoubleText(&scale) != tinyxml2::XML_SUCCESS ||
+           scale <= 0.0))
+      {
+        gzerr << "Unable to set <scale> to '" << child->GetText()
+              << "', using 1" << std::endl;
+        scale = 1.0;
+      }
+
+      bool devicePixels{false};
+      child = elem->FirstChildElement("device_pixels");
+      if (nullptr != child &&
+          child->QueryBoolText(&devicePixels) != tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Unable to set <device_pixels>, expected a boolean. "
+              << "Scaling logical pixels." << std::endl;
+        devicePixels = false;
+      }
+
+      double sharpen{0.0};
+      child = elem->FirstChildElement("sharpen");
+      if (nullptr != child && nullptr != child->GetText() &&
+          (child->QueryDoubleText(&sharpen) != tinyxml2::XML_SUCCESS ||
+           sharpen < 0.0 || sharpen > 1.0))
+      {
+        gzerr << "Unable to set <sharpen> to '" << child->GetText()
+              << "', using 0" << std::endl;
+        sharpen = 0.0;
+      }
+
+      renderWindow->SetRenderScale(scale, devicePixels, sharpen);
+    }
+
+    elem = _pluginElem->FirstChildElement("dynamic_resolution");
+    if (nullptr != elem)
+    {
+      double targetFps = maxFps > 0.0 ? maxFps : 30.0;
+      auto child = elem->FirstChildElement("target_fps");
       if (nullptr != child && nullptr != child->GetText())
       {
-        double n;
-        std::stringstream nearStr;
-        nearStr << std::string(child->GetText());
-        nearStr >> n;
-        if (nearStr.fail())
+        double fps;
+        std::stringstream fpsStr;
+        fpsStr << std::string(child->GetText());
+        fpsStr >> fps;
+        if (fpsStr.fail() || fps <= 0.0)
         {
-          gzerr << "Unable to set <near> to '" << nearStr.str()
-                 << "' using default near clip distance" << std::endl;
+          gzerr << "Unable to set <target_fps> to '" << fpsStr.str()
+                << "' using default target of " << targetFps << std::endl;
         }
         else
         {
-          renderWindow->SetCameraNearClip(n);
+          targetFps = fps;
         }
       }
 
-      child = elem->FirstChildElement("far");
+      double minScale{0.5};
+      child = elem->FirstChildElement("min_scale");
       if (nullptr != child && nullptr != child->GetText())
       {
-        double f;
-        std::stringstream farStr;
-        farStr << std::string(child->GetText());
-        farStr >> f;
-        if (farStr.fail())
+        double scale;
+        std::stringstream scaleStr;
+        scaleStr << std::string(child->GetText());
+        scaleStr >> scale;
+        if (scaleStr.fail() || scale <= 0.0 || scale > 1.0)
         {
-          gzerr << "Unable to set <far> to '" << farStr.str()
-                 << "' using default far clip distance" << std::endl;
+          gzerr << "Unable to set <min_scale> to '" << scaleStr.str()
+                << "' using default of " << minScale << std::endl;
         }
         else
         {
-          renderWindow->SetCameraFarClip(f);
+          minScale = scale;
         }
       }
+
+      renderWindow->SetDynamicResolution(true, targetFps, minScale);
     }
 
-    elem = _pluginElem->FirstChildElement("sky");
-    if (nullptr != elem && nullptr != elem->GetText())
+    elem = _pluginElem->FirstChildElement("headless");
+    if (nullptr != elem)
     {
-      renderWindow->SetSkyEnabled(true);
-      if (!elem->NoChildren())
-        gzwarn << "Child elements of <sky> are not supported yet"
-                << std::endl;
+      QSize size(1280, 720);
+      auto child = elem->FirstChildElement("size");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        int width{0};
+        int height{0};
+        std::stringstream sizeStr;
+        sizeStr << std::string(child->GetText());
+        sizeStr >> width >> height;
+        if (sizeStr.fail() || width <= 0 || height <= 0)
+        {
+          gzerr << "Unable to set <size> to '" << sizeStr.str()
+                << "' using default of 1280 720" << std::endl;
+        }
+        else
+        {
+          size = QSize(width, height);
+        }
+      }
+
+      double fps = maxFps > 0.0 ? maxFps : 30.0;
+      child = elem->FirstChildElement("fps");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        double value{0.0};
+        if (child->QueryDoubleText(&value) != tinyxml2::XML_SUCCESS ||
+            value <= 0.0)
+        {
+          gzerr << "Unable to set <fps> to '" << child->GetText()
+                << "' using default of " << fps << std::endl;
+        }
+        else
+        {
+          fps = value;
+        }
+      }
+      headless = std::make_pair(size, fps);
     }
 
-    elem = _pluginElem->FirstChildElement("shadows");
-    if (nullptr != elem && !elem->NoChildren())
+    elem = _pluginElem->FirstChildElement("quality");
+    if (nullptr != elem)
     {
-      auto textureSizeElem = elem->FirstChildElement("texture_size");
-      if (nullptr != elem && nullptr != textureSizeElem->GetText())
+      auto child = elem->FirstChildElement("preset");
+      if (nullptr != child && nullptr != child->GetText())
       {
-        unsigned int texSize;
-        std::stringstream texSizeStr;
-        texSizeStr << std::string(textureSizeElem->GetText());
-        texSizeStr >> texSize;
-        if (texSizeStr.fail())
+        const std::string preset = child->GetText();
+        if (QualityPresetIndex(preset) < 0)
         {
-          gzerr << "Unable to set shadow <texture_size> to '"
-                << texSizeStr.str()
-                << "' using default texture size" << std::endl;
+          gzerr << "Unknown quality <preset> '" << preset
+                << "', expected low, medium, high or ultra" << std::endl;
+        }
+        else
+        {
+          this->quality = QString::fromStdString(preset);
+          renderWindow->SetQuality(preset);
+        }
+      }
+
+      double targetFps{0.0};
+      child = elem->FirstChildElement("auto_downgrade");
+      if (nullptr != child)
+      {
+        targetFps = maxFps > 0.0 ? maxFps : 30.0;
+        auto fpsElem = child->FirstChildElement("target_fps");
+        if (nullptr != fpsElem && nullptr != fpsElem->GetText())
+        {
+          double fps;
+          std::stringstream fpsStr;
+          fpsStr << std::string(fpsElem->GetText());
+          fpsStr >> fps;
+          if (fpsStr.fail() || fps <= 0.0)
+          {
+            gzerr << "Unable to set <target_fps> to '" << fpsStr.str()
+                  << "' using default target of " << targetFps << std::endl;
+          }
+          else
+          {
+            targetFps = fps;
+          }
+        }
+      }
+
+      // Called from the render thread whenever a preset is applied
+      renderWindow->SetQualityDowngrade(targetFps,
+          [this](const std::string &_preset)
+          {
+            QMetaObject::invokeMethod(this,
+                [this, preset = QString::fromStdString(_preset)]()
+                {
+                  if (this->quality == preset)
+                    return;
+                  this->quality = preset;
+                  emit this->QualityChanged();
+                }, Qt::QueuedConnection);
+          });
+    }
+
+    std::vector<SceneView> views;
+    for (auto viewElem = _pluginElem->FirstChildElement("view");
+         nullptr != viewElem;
+         viewElem = viewElem->NextSiblingElement("view"))
+    {
+      SceneView view;
+
+      auto child = viewElem->FirstChildElement("pose");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        math::Pose3d pose;
+        std::stringstream poseStr;
+        poseStr << std::string(child->GetText());
+        poseStr >> pose;
+        if (poseStr.fail())
+        {
+          gzerr << "Unable to set view <pose> to '" << poseStr.str()
+                << "' using default pose" << std::endl;
+        }
+        else
+        {
+          view.pose = pose;
+        }
+      }
+
+      child = viewElem->FirstChildElement("horizontal_fov");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        double fovDeg;
+        std::stringstream fovStr;
+        fovStr << std::string(child->GetText());
+        fovStr >> fovDeg;
+        if (fovStr.fail())
+        {
+          gzerr << "Unable to set view <horizontal_fov> to '" << fovStr.str()
+                << "' using default horizontal field of view" << std::endl;
+        }
+        else
+        {
+          view.hfov.SetDegree(fovDeg);
+        }
+      }
+
+      child = viewElem->FirstChildElement("rect");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        math::Vector4d rect;
+        std::stringstream rectStr;
+        rectStr << std::string(child->GetText());
+        rectStr >> rect;
+        if (rectStr.fail() || rect.Z() <= 0.0 || rect.W() <= 0.0)
+        {
+          gzerr << "Unable to set view <rect> to '" << rectStr.str()
+                << "' using default area" << std::endl;
+        }
+        else
+        {
+          view.rect = rect;
+        }
+      }
+
+      views.push_back(view);
+    }
+    if (!views.empty())
+      renderWindow->SetViews(views);
+
+    elem = _pluginElem->FirstChildElement("frame_timing");
+    if (nullptr != elem)
+    {
+      std::string topic{"/gui/frame_timing"};
+      auto child = elem->FirstChildElement("topic");
+      if (nullptr != child && nullptr != child->GetText())
+        topic = child->GetText();
+
+      bool overlay{true};
+      child = elem->FirstChildElement("overlay");
+      if (nullptr != child &&
+          child->QueryBoolText(&overlay) != tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Unable to set <overlay>, expected a boolean. "
+              << "Showing the frame timing overlay." << std::endl;
+        overlay = true;
+      }
+
+      std::function<void(const std::string &)> cb;
+      if (overlay)
+      {
+        // Called from the render thread
+        cb = [this](const std::string &_summary)
+        {
+          auto summary = QString::fromStdString(_summary);
+          this->UpdateWhenShown("frame timing", [this, summary]()
+          {
+            QMetaObject::invokeMethod(this, "SetFrameTiming",
+                Qt::QueuedConnection, Q_ARG(QString, summary));
+          });
+        };
+      }
+      renderWindow->SetFrameTiming(topic, cb);
+    }
+
+    elem = _pluginElem->FirstChildElement("labels");
+    if (nullptr != elem)
+    {
+      auto labels = renderWindow->Labels();
+      double value{0.0};
+      auto child = elem->FirstChildElement("cell_size");
+      if (nullptr != child)
+      {
+        if (child->QueryDoubleText(&value) == tinyxml2::XML_SUCCESS &&
+            value >= 0.0)
+        {
+          labels->SetCellSize(value);
+        }
+        else
+        {
+          gzerr << "Unable to set <cell_size>, expected a non-negative "
+                << "number." << std::endl;
+        }
+      }
+
+      int count{0};
+      child = elem->FirstChildElement("max_labels");
+      if (nullptr != child)
+      {
+        if (child->QueryIntText(&count) == tinyxml2::XML_SUCCESS &&
+            count >= 0)
+        {
+          labels->SetMaxLabels(static_cast<std::size_t>(count));
+        }
+        else
+        {
+          gzerr << "Unable to set <max_labels>, expected a non-negative "
+                << "integer." << std::endl;
+        }
+      }
+
+      child = elem->FirstChildElement("max_distance");
+      if (nullptr != child)
+      {
+        if (child->QueryDoubleText(&value) == tinyxml2::XML_SUCCESS &&
+            value >= 0.0)
+        {
+          labels->SetMaxDistance(value);
         }
         else
         {
-          std::string lightType = textureSizeElem->Attribute("light_type");
-          if (lightType == "directional")
+          gzerr << "Unable to set <max_distance>, expected a non-negative "
+                << "number." << std::endl;
+        }
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("input_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+      renderWindow->SetInputTopic(elem->GetText());
+
+    elem = _pluginElem->FirstChildElement("input_recording");
+    if (nullptr != elem)
+    {
+      std::string mode{"record"};
+      auto child = elem->FirstChildElement("mode");
+      if (nullptr != child && nullptr != child->GetText())
+        mode = child->GetText();
+
+      std::string path;
+      child = elem->FirstChildElement("path");
+      if (nullptr != child && nullptr != child->GetText())
+        path = child->GetText();
+
+      std::string transportLog;
+      child = elem->FirstChildElement("transport_log");
+      if (nullptr != child && nullptr != child->GetText())
+        transportLog = child->GetText();
+
+      if (path.empty())
+      {
+        gzerr << "Unable to set <input_recording>, missing <path>."
+              << std::endl;
+      }
+      else if (mode == "record")
+      {
+        std::vector<std::string> topics;
+        for (child = elem->FirstChildElement("topic"); nullptr != child;
+            child = child->NextSiblingElement("topic"))
+        {
+          if (nullptr == child->GetText())
+            continue;
+          try
           {
-            if (!renderWindow->SetShadowTextureSize(
-                rendering::LightType::DIRECTIONAL, texSize))
-            {
-              gzerr << "Unable to set shadow <texture_size> to '"
-                    << texSizeStr.str()
-                    << "' using default texture size" << std::endl;
-            }
+            std::regex check(child->GetText());
+            topics.push_back(child->GetText());
           }
-          else
+          catch (const std::regex_error &)
           {
-            gzerr << "Setting shadow <texture_size> for light type ["
-                  << lightType << "] is not supported." << std::endl;
+            gzerr << "Unable to set <topic> to '" << child->GetText()
+                  << "', not a valid regular expression" << std::endl;
           }
         }
+        renderWindow->SetInputRecording(path, transportLog, topics);
+      }
+      else if (mode == "replay")
+      {
+        bool quit{false};
+        child = elem->FirstChildElement("quit");
+        if (nullptr != child &&
+            child->QueryBoolText(&quit) != tinyxml2::XML_SUCCESS)
+        {
+          gzerr << "Unable to set <quit>, expected a boolean." << std::endl;
+          quit = false;
+        }
+        renderWindow->SetInputReplay(path, transportLog, quit);
+      }
+      else
+      {
+        gzerr << "Unable to set <mode> to '" << mode << "', expected "
+              << "'record' or 'replay'" << std::endl;
       }
     }
 
-    const std::string backendApiName = gz::gui::renderEngineBackendApiName();
-    if (backendApiName == "vulkan")
-    {
-      renderWindow->SetGraphicsAPI(rendering::GraphicsAPI::VULKAN);
-    }
-    else if (backendApiName == "metal")
-    {
-      renderWindow->SetGraphicsAPI(rendering::GraphicsAPI::METAL);
-    }
-    else
+    elem = _pluginElem->FirstChildElement("spawn_preview");
+    if (nullptr != elem &&
+        elem->QueryBoolText(&this->dataPtr->spawnPreview) !=
+        tinyxml2::XML_SUCCESS)
     {
-      renderWindow->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+      gzerr << "Unable to set <spawn_preview>, expected a boolean."
+            << std::endl;
     }
 
-    elem = _pluginElem->FirstChildElement("graphics_api");
-    if (nullptr != elem && nullptr != elem->GetText())
+    elem = _pluginElem->FirstChildElement("gpu_ray_query");
+    if (nullptr != elem)
     {
-      rendering::GraphicsAPI graphicsAPI =
-          rendering::GraphicsAPIUtils::Set(elem->GetText());
-      renderWindow->SetGraphicsAPI(graphicsAPI);
+      bool gpu{false};
+      if (elem->QueryBoolText(&gpu) != tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Unable to set <gpu_ray_query>, expected a boolean. "
+              << "Using CPU ray queries." << std::endl;
+      }
+      renderWindow->SetGpuRayQuery(gpu);
     }
 
-    elem = _pluginElem->FirstChildElement("horizontal_fov");
-    if (nullptr != elem && nullptr != elem->GetText())
+    elem = _pluginElem->FirstChildElement("shader_cache");
+    if (nullptr != elem)
     {
-      double fovDeg;
-      math::Angle fov;
-      std::stringstream fovStr;
-      fovStr << std::string(elem->GetText());
-      fovStr >> fovDeg;
-      if (fovStr.fail())
+      std::string home;
+      common::env(GZ_HOMEDIR, home);
+      std::string dir = common::joinPaths(home, ".gz", "gui", "shader_cache");
+      auto child = elem->FirstChildElement("directory");
+      if (nullptr != child && nullptr != child->GetText())
+        dir = child->GetText();
+
+      bool warmup{false};
+      child = elem->FirstChildElement("warmup");
+      if (nullptr != child &&
+          child->QueryBoolText(&warmup) != tinyxml2::XML_SUCCESS)
       {
-        gzerr << "Unable to set <horizontal_fov> to '" << fovStr.str()
-              << "' using default horizontal field of view" << std::endl;
+        gzerr << "Unable to set <shader_cache><warmup>, expected a boolean."
+              << std::endl;
+      }
+
+      if (!common::isDirectory(dir) && !common::createDirectories(dir))
+      {
+        gzerr << "Failed to create shader cache [" << dir << "]"
+              << std::endl;
       }
       else
       {
-        fov.SetDegree(fovDeg);
-        renderWindow->SetCameraHFOV(fov);
+        // Drivers read these when they're loaded, so they only apply if
+        // nothing was rendered yet, such as for configs loaded at startup
+        for (const auto *var : {"MESA_SHADER_CACHE_DIR",
+            "__GL_SHADER_DISK_CACHE_PATH"})
+        {
+          std::string value;
+          if (!common::env(var, value))
+            common::setenv(var, dir);
+        }
+        renderWindow->SetShaderCache(dir, warmup);
       }
     }
-
-    elem = _pluginElem->FirstChildElement("view_controller");
-    if (nullptr != elem && nullptr != elem->GetText())
-    {
-      renderWindow->SetCameraViewController(elem->GetText());
-    }
   }
 
   renderWindow->SetEngineName(cmdRenderEngine);
+
+  // Slow down while the scene can't be seen. Plugins keep updating the
+  // scene, and it's shown as soon as it can be seen again.
+  renderWindow->SetHidden(this->Suspended());
+  this->connect(this, &Plugin::SuspendedChanged, renderWindow,
+      [this, renderWindow]()
+      {
+        renderWindow->SetHidden(this->Suspended());
+      });
+
+  // Last, since the render thread starts right away
+  if (headless)
+    renderWindow->StartHeadless(headless->first, headless->second);
 }
 
 /////////////////////////////////////////////////
 void RenderWindowItem::OnHovered(const gz::math::Vector2i &_hoverPos)
 {
   this->dataPtr->renderThread->gzRenderer.NewHoverEvent(_hoverPos);
+  this->RequestRender();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::OnSpawnDrag(const QString &_text,
+    const gz::math::Vector2i &_pos)
+{
+  this->dataPtr->renderThread->gzRenderer.NewSpawnDrag(
+    _text.toStdString(), _pos);
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -1590,6 +4544,7 @@ void RenderWindowItem::OnDropped(const QString &_drop,
 {
   this->dataPtr->renderThread->gzRenderer.NewDropEvent(
     _drop.toStdString(), _dropPos);
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -1599,13 +4554,42 @@ void RenderWindowItem::SetErrorCb(std::function<void(const QString&)> _cb)
 }
 
 /////////////////////////////////////////////////
-void RenderWindowItem::mousePressEvent(QMouseEvent *_e)
+void RenderWindowItem::SetFirstFrameCb(std::function<void()> _cb)
+{
+  this->dataPtr->firstFrameCb = std::move(_cb);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::NewMouseEvent(common::MouseEvent _e)
 {
-  this->dataPtr->mouseEvent = convert(*_e);
-  this->dataPtr->mouseEvent.SetPressPos(this->dataPtr->mouseEvent.Pos());
+  // Store values that depend on previous events
+  auto pressPos = this->dataPtr->mouseEvent.PressPos();
+  auto dragging = this->dataPtr->mouseEvent.Dragging();
 
+  if (_e.Type() == common::MouseEvent::PRESS)
+  {
+    _e.SetPressPos(_e.Pos());
+  }
+  else if (_e.Type() == common::MouseEvent::RELEASE)
+  {
+    _e.SetPressPos(pressPos);
+    _e.SetDragging(dragging);
+  }
+  else if (_e.Type() == common::MouseEvent::MOVE && _e.Dragging())
+  {
+    _e.SetPressPos(pressPos);
+  }
+
+  this->dataPtr->mouseEvent = _e;
   this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
       this->dataPtr->mouseEvent);
+  this->RequestRender();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::mousePressEvent(QMouseEvent *_e)
+{
+  this->NewMouseEvent(convert(*_e));
 }
 
 ////////////////////////////////////////////////
@@ -1631,31 +4615,13 @@ void RenderWindowItem::keyReleaseEvent(QKeyEvent *_e)
 ////////////////////////////////////////////////
 void RenderWindowItem::mouseReleaseEvent(QMouseEvent *_e)
 {
-  // Store values that depend on previous events
-  auto pressPos = this->dataPtr->mouseEvent.PressPos();
-  auto dragging = this->dataPtr->mouseEvent.Dragging();
-
-  this->dataPtr->mouseEvent = convert(*_e);
-  this->dataPtr->mouseEvent.SetPressPos(pressPos);
-  this->dataPtr->mouseEvent.SetDragging(dragging);
-
-  this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
-      this->dataPtr->mouseEvent);
+  this->NewMouseEvent(convert(*_e));
 }
 
 ////////////////////////////////////////////////
 void RenderWindowItem::mouseMoveEvent(QMouseEvent *_e)
 {
-  // Store values that depend on previous events
-  auto pressPos = this->dataPtr->mouseEvent.PressPos();
-
-  this->dataPtr->mouseEvent = convert(*_e);
-
-  if (this->dataPtr->mouseEvent.Dragging())
-    this->dataPtr->mouseEvent.SetPressPos(pressPos);
-
-  this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
-      this->dataPtr->mouseEvent);
+  this->NewMouseEvent(convert(*_e));
 }
 
 ////////////////////////////////////////////////
@@ -1663,21 +4629,268 @@ void RenderWindowItem::wheelEvent(QWheelEvent *_e)
 {
   this->forceActiveFocus();
 
-  this->dataPtr->mouseEvent = convert(*_e);
-  this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
-    this->dataPtr->mouseEvent);
+  this->NewMouseEvent(convert(*_e));
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a value from the params of a remote input msg
+/// \param[in] _msg Input msg
+/// \param[in] _key Param name
+/// \return The param, or an empty value if missing
+static msgs::Any inputParam(const msgs::Param &_msg, const std::string &_key)
+{
+  auto it = _msg.params().find(_key);
+  if (it == _msg.params().end())
+    return msgs::Any();
+  return it->second;
+}
+
+/////////////////////////////////////////////////
+bool RenderWindowItem::SetInputTopic(const std::string &_topic)
+{
+  // Called from a transport thread, the events are handled on the GUI
+  // thread like local ones
+  std::function<void(const msgs::Param &)> cb =
+      [this](const msgs::Param &_msg)
+  {
+    QMetaObject::invokeMethod(this, [this, _msg]()
+    {
+      const auto type = inputParam(_msg, "type").string_value();
+      const bool control = inputParam(_msg, "control").bool_value();
+      const bool shift = inputParam(_msg, "shift").bool_value();
+      const bool alt = inputParam(_msg, "alt").bool_value();
+
+      if (type == "key_press" || type == "key_release")
+      {
+        common::KeyEvent event;
+        event.SetKey(inputParam(_msg, "key").int_value());
+        event.SetText(inputParam(_msg, "text").string_value());
+        event.SetControl(control);
+        event.SetShift(shift);
+        event.SetAlt(alt);
+        if (type == "key_press")
+        {
+          event.SetType(common::KeyEvent::PRESS);
+          this->HandleKeyPress(event);
+        }
+        else
+        {
+          event.SetType(common::KeyEvent::RELEASE);
+          this->HandleKeyRelease(event);
+        }
+        return;
+      }
+
+      common::MouseEvent event;
+      if (type == "press")
+        event.SetType(common::MouseEvent::PRESS);
+      else if (type == "release")
+        event.SetType(common::MouseEvent::RELEASE);
+      else if (type == "move")
+        event.SetType(common::MouseEvent::MOVE);
+      else if (type == "scroll")
+        event.SetType(common::MouseEvent::SCROLL);
+      else
+      {
+        gzwarn << "Ignoring remote input of unknown type [" << type << "]"
+               << std::endl;
+        return;
+      }
+
+      event.SetPos(inputParam(_msg, "x").int_value(),
+          inputParam(_msg, "y").int_value());
+      event.SetButton(static_cast<common::MouseEvent::MouseButton>(
+          inputParam(_msg, "button").int_value()));
+      event.SetButtons(static_cast<unsigned int>(
+          inputParam(_msg, "buttons").int_value()));
+      event.SetControl(control);
+      event.SetShift(shift);
+      event.SetAlt(alt);
+      if (event.Type() == common::MouseEvent::MOVE)
+        event.SetDragging(event.Buttons() != 0 || event.Button() != 0);
+      if (event.Type() == common::MouseEvent::SCROLL)
+      {
+        const int scroll = inputParam(_msg, "scroll").int_value() < 0 ?
+            -1 : 1;
+        event.SetScroll(scroll, scroll);
+      }
+      this->NewMouseEvent(event);
+    }, Qt::QueuedConnection);
+  };
+
+  if (!this->dataPtr->node.Subscribe(_topic, cb))
+  {
+    gzerr << "Failed to subscribe to input topic [" << _topic << "]"
+          << std::endl;
+    return false;
+  }
+  gzmsg << "Handling remote input from [" << _topic << "]" << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetInputRecording(const std::string &_path,
+    const std::string &_transportLog, const std::vector<std::string> &_topics)
+{
+  this->dataPtr->inputPath = _path;
+  this->dataPtr->transportLogPath = _transportLog;
+  this->dataPtr->transportTopics = _topics;
+
+  // Events are ignored until the recording starts
+  this->dataPtr->renderThread->gzRenderer.inputRecorder =
+      std::make_shared<InputRecorder>();
+}
+
+/////////////////////////////////////////////////
+bool RenderWindowItem::SetInputReplay(const std::string &_path,
+    const std::string &_transportLog, bool _quit)
+{
+  if (!this->dataPtr->inputReplay.Load(_path))
+  {
+    gzerr << "Failed to load input recording [" << _path << "]"
+          << std::endl;
+    return false;
+  }
+  this->dataPtr->inputPath = _path;
+  this->dataPtr->transportLogPath = _transportLog;
+  this->dataPtr->quitAfterReplay = _quit;
+  this->dataPtr->renderThread->gzRenderer.inputRecorder.reset();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::StartInputSession()
+{
+  if (this->dataPtr->inputPath.empty())
+    return;
+
+  auto &recorder = this->dataPtr->renderThread->gzRenderer.inputRecorder;
+  if (recorder)
+  {
+    if (!this->dataPtr->transportLogPath.empty())
+    {
+      this->dataPtr->transportRecorder =
+          std::make_unique<transport::log::Recorder>();
+      auto topics = this->dataPtr->transportTopics;
+      if (topics.empty())
+        topics.push_back(".*");
+      for (const auto &topic : topics)
+        this->dataPtr->transportRecorder->AddTopic(std::regex(topic));
+      if (this->dataPtr->transportRecorder->Start(
+          this->dataPtr->transportLogPath) !=
+          transport::log::RecorderError::SUCCESS)
+      {
+        gzerr << "Failed to record transport log ["
+              << this->dataPtr->transportLogPath << "]" << std::endl;
+        this->dataPtr->transportRecorder.reset();
+      }
+    }
+
+    if (!recorder->Start(this->dataPtr->inputPath))
+    {
+      gzerr << "Failed to record input to [" << this->dataPtr->inputPath
+            << "]" << std::endl;
+      return;
+    }
+    gzmsg << "Recording input to [" << this->dataPtr->inputPath << "]"
+          << std::endl;
+    return;
+  }
+
+  if (!this->dataPtr->transportLogPath.empty())
+  {
+    this->dataPtr->transportPlayback =
+        std::make_unique<transport::log::Playback>(
+        this->dataPtr->transportLogPath);
+    if (!this->dataPtr->transportPlayback->Valid())
+    {
+      gzerr << "Failed to open transport log ["
+            << this->dataPtr->transportLogPath << "]" << std::endl;
+      this->dataPtr->transportPlayback.reset();
+    }
+    else
+    {
+      // Blocks while the topics are advertised and discovered, so both
+      // replays start together
+      this->dataPtr->transportPlayback->AddTopic(std::regex(".*"));
+      this->dataPtr->playbackHandle =
+          this->dataPtr->transportPlayback->Start();
+    }
+  }
+
+  gzmsg << "Replaying " << this->dataPtr->inputReplay.Size()
+        << " input events from [" << this->dataPtr->inputPath << "]"
+        << std::endl;
+  this->dataPtr->replayStart = std::chrono::steady_clock::now();
+  this->dataPtr->replayTimer.setSingleShot(true);
+  this->dataPtr->replayTimer.setTimerType(Qt::PreciseTimer);
+  this->connect(&this->dataPtr->replayTimer, &QTimer::timeout, this,
+      &RenderWindowItem::ReplayInput);
+  this->ReplayInput();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::ReplayInput()
+{
+  auto &replay = this->dataPtr->inputReplay;
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  const auto elapsed = std::chrono::steady_clock::now() -
+      this->dataPtr->replayStart;
+
+  // Fed to the renderer where they were recorded
+  auto due = replay.Take(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+  for (const auto &input : due)
+  {
+    switch (input.kind)
+    {
+      case RecordedInput::Kind::MOUSE:
+        renderer.NewMouseEvent(input.mouse);
+        break;
+      case RecordedInput::Kind::KEY_PRESS:
+        renderer.HandleKeyPress(input.key);
+        break;
+      case RecordedInput::Kind::KEY_RELEASE:
+        renderer.HandleKeyRelease(input.key);
+        break;
+    }
+  }
+  if (!due.empty())
+    this->RequestRender();
+
+  if (!replay.Done())
+  {
+    this->dataPtr->replayTimer.start(
+        std::chrono::ceil<std::chrono::milliseconds>(
+        replay.NextTime() - elapsed));
+    return;
+  }
+
+  // Wait for the transport msgs to be published too
+  if (this->dataPtr->playbackHandle &&
+      !this->dataPtr->playbackHandle->Finished())
+  {
+    this->dataPtr->replayTimer.start(std::chrono::milliseconds(100));
+    return;
+  }
+
+  gzmsg << "Input replay done" << std::endl;
+  if (this->dataPtr->quitAfterReplay && nullptr != gz::gui::App())
+    gz::gui::App()->quit();
 }
 
 ////////////////////////////////////////////////
 void RenderWindowItem::HandleKeyPress(const common::KeyEvent &_e)
 {
   this->dataPtr->renderThread->gzRenderer.HandleKeyPress(_e);
+  this->RequestRender();
 }
 
 ////////////////////////////////////////////////
 void RenderWindowItem::HandleKeyRelease(const common::KeyEvent &_e)
 {
   this->dataPtr->renderThread->gzRenderer.HandleKeyRelease(_e);
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -1687,9 +4900,42 @@ void MinimalScene::OnHovered(int _mouseX, int _mouseY)
   renderWindow->OnHovered({_mouseX, _mouseY});
 }
 
+/////////////////////////////////////////////////
+void MinimalScene::OnDragEntered(const QString &_text, int _mouseX,
+    int _mouseY)
+{
+  if (!this->dataPtr->spawnPreview || _text.isEmpty())
+    return;
+
+  // Whoever handles the drop finds it resolved, or being resolved
+  this->dataPtr->dragText = _text;
+  SpawnAssets::Prefetch(_text.toStdString());
+  this->OnDragMoved(_mouseX, _mouseY);
+}
+
+/////////////////////////////////////////////////
+void MinimalScene::OnDragMoved(int _mouseX, int _mouseY)
+{
+  if (this->dataPtr->dragText.isEmpty())
+    return;
+  auto *renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
+  renderWindow->OnSpawnDrag(this->dataPtr->dragText, {_mouseX, _mouseY});
+}
+
+/////////////////////////////////////////////////
+void MinimalScene::OnDragExited()
+{
+  if (this->dataPtr->dragText.isEmpty())
+    return;
+  this->dataPtr->dragText.clear();
+  auto *renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
+  renderWindow->OnSpawnDrag(QString(), math::Vector2i::Zero);
+}
+
 /////////////////////////////////////////////////
 void MinimalScene::OnDropped(const QString &_drop, int _mouseX, int _mouseY)
 {
+  this->OnDragExited();
   auto *renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
   renderWindow->OnDropped(_drop, {_mouseX, _mouseY});
 }
@@ -1707,6 +4953,57 @@ QString MinimalScene::LoadingError() const
   return this->loadingError;
 }
 
+/////////////////////////////////////////////////
+QObject *MinimalScene::Labels()
+{
+  return &this->dataPtr->labels;
+}
+
+/////////////////////////////////////////////////
+QString MinimalScene::FrameTiming() const
+{
+  return this->frameTiming;
+}
+
+/////////////////////////////////////////////////
+void MinimalScene::SetFrameTiming(const QString &_frameTiming)
+{
+  this->frameTiming = _frameTiming;
+  emit this->FrameTimingChanged();
+}
+
+/////////////////////////////////////////////////
+bool MinimalScene::SceneReady() const
+{
+  return this->sceneReady;
+}
+
+/////////////////////////////////////////////////
+QString MinimalScene::Quality() const
+{
+  return this->quality;
+}
+
+/////////////////////////////////////////////////
+void MinimalScene::SetQuality(const QString &_quality)
+{
+  if (QualityPresetIndex(_quality.toStdString()) < 0)
+  {
+    gzerr << "Unknown quality preset [" << _quality.toStdString()
+          << "], expected low, medium, high or ultra" << std::endl;
+    return;
+  }
+
+  auto *renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
+  if (nullptr != renderWindow)
+    renderWindow->SetQuality(_quality.toStdString());
+
+  if (this->quality == _quality)
+    return;
+  this->quality = _quality;
+  emit this->QualityChanged();
+}
+
 /////////////////////////////////////////////////
 void MinimalScene::SetLoadingError(const QString &_loadingError)
 {
@@ -18,21 +18,30 @@
 #ifndef GZ_GUI_PLUGINS_MINIMALSCENE_HH_
 #define GZ_GUI_PLUGINS_MINIMALSCENE_HH_
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <gz/common/KeyEvent.hh>
 #include <gz/common/MouseEvent.hh>
+#include <gz/math/Angle.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector2.hh>
+#include <gz/math/Vector4.hh>
 #include <gz/utils/ImplPtr.hh>
 #include <gz/rendering/GraphicsAPI.hh>
 #include <gz/rendering/Light.hh>
 
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/SceneLabels.hh"
+#include "gz/gui/ThreadPolicy.hh"
 
 #include "MinimalSceneRhi.hh"
+#include "QuickFrameTiming.hh"
 
 namespace gz::gui::plugins
 {
@@ -67,6 +76,225 @@ namespace gz::gui::plugins
   ///                      'opengl', 'metal'. Defaults to 'opengl'.
   /// * \<view_controller> : Set the view controller (InteractiveViewControl
   ///                        currently supports types: ortho or orbit).
+  /// * \<texture_buffer_count\> : Number of textures rendered frames are
+  ///                             rotated through. With 1 (default), the
+  ///                             render and Qt threads wait for each other
+  ///                             every frame. With 2 or 3, the scene renders
+  ///                             into a back texture while Qt displays the
+  ///                             front one, at the cost of extra VRAM. Only
+  ///                             supported with OpenGL.
+  /// * \<vsync_pacing\> : If true and \<texture_buffer_count\> is 2 or 3,
+  ///                      each frame starts rendering at a predicted
+  ///                      offset before the display refresh, from the
+  ///                      times Qt's buffer swaps return and recent render
+  ///                      times, so it's done just before Qt picks it up.
+  ///                      Frames are then shown at a steady delay after
+  ///                      being rendered, which looks smoother than
+  ///                      rendering as soon as possible. With 1 buffer,
+  ///                      Qt's vsync throttled loop already starts each
+  ///                      frame. Defaults to false.
+  /// * \<render_thread\> : Priority and CPUs of the render thread, with
+  ///                       optional \<priority\>, \<cpus\> and
+  ///                       \<numa_node\> children, see
+  ///                       gz::gui::ThreadPolicy::Load. Raising its
+  ///                       priority keeps frames coming when a simulation
+  ///                       on the same machine uses all cores. Optional,
+  ///                       the thread starts like any other by default.
+  /// * \<render_on_demand\> : If true, only render a new frame when
+  ///                          something changes, such as scene updates,
+  ///                          mouse and keyboard input, resizing, camera
+  ///                          motion, or plugins calling
+  ///                          RenderHooks::RequestRender. Defaults to false,
+  ///                          which renders continuously.
+  /// * \<max_fps\> : Maximum frames per second the scene renders at.
+  ///                 Defaults to 0, no limit other than the display's.
+  /// * \<hidden_fps\> : Maximum frames per second while the scene can't be
+  ///                    seen, such as while its window is minimized or
+  ///                    covered, see Plugin::Suspended. Plugins keep
+  ///                    updating the scene, so it's current as soon as it's
+  ///                    seen again. Zero renders nothing while hidden.
+  ///                    Defaults to 1.
+  /// * \<scene_command_budget\> : Milliseconds each frame may spend making
+  ///                              the scene changes plugins recorded in a
+  ///                              SceneCommandQueue, before the pre-render
+  ///                              hooks. The rest wait for the next frame.
+  ///                              Zero makes them all. Defaults to 10.
+  /// * \<frame_task_budget\> : Milliseconds each frame may spend running
+  ///                           the tasks plugins registered with
+  ///                           RenderHooks::OnFrameTask, before the render
+  ///                           hooks. Tasks left out run first on the next
+  ///                           frame. Zero runs them all. Defaults to 5.
+  /// * \<gpu_upload_budget\> : Megabytes each frame may upload to the GPU
+  ///                           for the plugins which stage their data in a
+  ///                           GpuUploadQueue, or check
+  ///                           GpuUploads::BudgetLeft, such as PointCloud,
+  ///                           GridMap, MarkerManager and
+  ///                           TransportSceneManager. What the camera sees
+  ///                           goes first, the rest waits for the next
+  ///                           frames, so a burst of large messages doesn't
+  ///                           stall one frame. Zero uploads everything
+  ///                           right away. Defaults to 8.
+  /// * \<resize_delay\> : Milliseconds the scene's size must be stable
+  ///                      before its texture is resized. Until then, the
+  ///                      old texture is stretched to fit, so dragging a
+  ///                      window or a dock doesn't rebuild the texture at
+  ///                      every step. Zero resizes right away. Defaults to
+  ///                      100.
+  /// * \<texture_size_step\> : Texture sizes are rounded up to a multiple
+  ///                           of this many pixels, so small size changes
+  ///                           don't rebuild the texture. The texture is
+  ///                           then slightly stretched to fit. Defaults to
+  ///                           1, which keeps the exact size.
+  /// * \<render_scale\> : Resolution of the scene's texture relative to the
+  ///                      item. Rendering below the display's resolution,
+  ///                      such as on HiDPI screens, makes the scene cheaper
+  ///                      while the rest of the UI stays crisp. The texture
+  ///                      is upscaled with linear filtering. Optional.
+  ///     * \<scale\> : Fraction of the item size, defaults to 1.
+  ///     * \<device_pixels\> : True if the scale is relative to the
+  ///                           item's size in physical pixels, which follows
+  ///                           the screen's device pixel ratio. False if
+  ///                           it's relative to its size in logical pixels.
+  ///                           Defaults to false.
+  ///     * \<sharpen\> : Strength of a sharpening filter applied while the
+  ///                     texture is upscaled, from 0 to 1. Only supported
+  ///                     with OpenGL. Defaults to 0, which doesn't sharpen.
+  /// * \<headless\> : If present, the scene is rendered with OpenGL on an
+  ///                  EGL device of its own, without a window server, such
+  ///                  as on GPU servers and in CI. Nothing is shown and
+  ///                  there's no mouse input, frames are only consumed by
+  ///                  plugins through FrameTaps, such as Screenshot
+  ///                  streaming. Requires an engine which supports it, such
+  ///                  as ogre2. Optional.
+  ///     * \<size\> : Width and height in pixels, defaults to "1280 720".
+  ///     * \<fps\> : Frames per second, defaults to \<max_fps\> if set, 30
+  ///                 otherwise. \<render_on_demand\> still applies.
+  /// * \<dynamic_resolution\> : If present, the texture is rendered at a
+  ///                            lower resolution and upscaled while frames
+  ///                            are too slow, and at full resolution once
+  ///                            the camera stops moving.
+  ///     * \<target_fps\> : Frame rate to keep, defaults to \<max_fps\> if
+  ///                        set, 30 otherwise.
+  ///     * \<min_scale\> : Lowest resolution as a fraction of the full
+  ///                       one, defaults to 0.5.
+  /// * \<view\> : Extra view of the same scene, shown as an inset on top of
+  ///              the main one. May be repeated. All views are rendered by
+  ///              the same render thread and context within each frame, so
+  ///              the scene is only updated once. Views only display the
+  ///              scene, mouse and keyboard input always goes to the main
+  ///              camera. Not supported with \<texture_buffer_count\>
+  ///              larger than 1.
+  ///     * \<pose\> : Pose of the view's camera, defaults to looking down
+  ///                  from 10 m above the origin.
+  ///     * \<horizontal_fov\> : Horizontal FOV in degrees, defaults to 90.
+  ///     * \<rect\> : Area covered by the view as "x y width height"
+  ///                  fractions of the main view, with x and y being the
+  ///                  top left corner. Defaults to "0.7 0.05 0.25 0.25".
+  /// * \<frame_timing\> : If present, measure how long each stage of a
+  ///                      frame takes on the render thread: input handling,
+  ///                      pre-render listeners, the camera update, render
+  ///                      listeners and the texture handoff, plus GPU time
+  ///                      where supported (OpenGL). Averages are reported
+  ///                      twice per second. While the mouse is used, the
+  ///                      input latency is reported too, from mouse events
+  ///                      arriving to the frame showing them being handed
+  ///                      over to Qt. The Qt Quick frames showing the
+  ///                      scene are timed too, from the window's signals:
+  ///                      polishing items on the GUI thread, then
+  ///                      synchronizing, rendering and swapping on the
+  ///                      scene graph's render thread, reported with a
+  ///                      "qt_" prefix.
+  ///     * \<topic\> : Topic to publish gz::msgs::Diagnostics on, defaults
+  ///                   to "/gui/frame_timing".
+  ///     * \<overlay\> : True to also show the timing on top of the scene.
+  ///                     Defaults to true.
+  /// * \<input_topic\> : If set, mouse and key events received as
+  ///                     gz::msgs::Param on this topic are handled like
+  ///                     local input. Together with the Screenshot plugin's
+  ///                     \<stream_topic\>, this lets thin clients without a
+  ///                     GPU operate the scene remotely. Each msg holds one
+  ///                     event in its params:
+  ///     * "type" (string) : "press", "release", "move", "scroll",
+  ///                         "key_press" or "key_release".
+  ///     * "x", "y" (int) : Mouse position in pixels of the scene.
+  ///     * "button" (int) : Button pressed or released, 1 for left, 2 for
+  ///                        middle and 4 for right.
+  ///     * "buttons" (int) : Buttons held down, combined the same way.
+  ///     * "scroll" (int) : Scroll steps, positive towards the user.
+  ///     * "key" (int) : Qt::Key of key events.
+  ///     * "text" (string) : Text of key events.
+  ///     * "control", "shift", "alt" (bool) : Modifiers held down.
+  /// * \<input_recording\> : Record the mouse and key events the scene
+  ///                        receives, with their times, or replay them, to
+  ///                        reproduce performance problems which depend on
+  ///                        a sequence of camera moves and clicks. Both
+  ///                        start with the first frame. Replays are best
+  ///                        run with \<headless\> and \<frame_timing\>.
+  ///                        Optional.
+  ///     * \<mode\> : "record" or "replay". Defaults to "record".
+  ///     * \<path\> : File of input events. Required.
+  ///     * \<transport_log\> : Log of the transport msgs received while
+  ///                           recording, which are published again while
+  ///                           replaying. Optional, transport traffic isn't
+  ///                           recorded by default.
+  ///     * \<topic\> : Regular expression of the topics to record into
+  ///                   \<transport_log\>. May be repeated. Defaults to all
+  ///                   topics.
+  ///     * \<quit\> : True to close the application once a replay is
+  ///                  done. Defaults to false.
+  /// * \<gpu_ray_query\> : If true, the scene position under the mouse is
+  ///                       found by reading back a GPU buffer rendered from
+  ///                       the user camera, where the render engine
+  ///                       supports it, instead of testing the ray against
+  ///                       meshes on the CPU. Faster in scenes with dense
+  ///                       meshes. Defaults to false.
+  /// * \<shader_cache\> : Keeps compiled shaders across sessions, so the
+  ///                      first frames of later sessions don't hitch while
+  ///                      they're built.
+  ///     * \<directory\> : Cache directory, defaults to
+  ///                       "~/.gz/gui/shader_cache". The GL and Vulkan
+  ///                       drivers' shader caches are pointed at it unless
+  ///                       their environment variables are already set.
+  ///     * \<warmup\> : If true, the meshes and materials in the scene are
+  ///                    listed in the directory when the scene is closed,
+  ///                    and rendered once offscreen when the next session
+  ///                    starts, before the first frame. Defaults to false.
+  /// * \<quality\> : Lighting quality presets, which can also be switched
+  ///                 at runtime through the `quality` property without
+  ///                 reloading the scene.
+  ///     * \<preset\> : "low", "medium", "high" or "ultra". Each sets the
+  ///                    directional shadow map size (1024 to 8192, shared
+  ///                    by all its cascades), how many lights cast
+  ///                    shadows at once (1, 2, 4 or 8, directional lights
+  ///                    first) and, on low, hides the \<sky\>. Overrides
+  ///                    \<shadows\>. Optional, nothing is changed by
+  ///                    default.
+  ///     * \<auto_downgrade\> : If present, the preset is lowered one step
+  ///                            at a time while frames are slower than a
+  ///                            target for a couple of seconds, so a config
+  ///                            asking for "ultra" still runs smoothly on
+  ///                            slower GPUs. It's never raised back
+  ///                            automatically.
+  ///         * \<target_fps\> : Frame rate to keep, defaults to
+  ///                            \<max_fps\> if set, 30 otherwise.
+  /// * \<labels\> : Limits of the labels other plugins show over the scene
+  ///                through SceneLabels, such as entity names and text
+  ///                markers. They're all drawn by one overlay, using Qt's
+  ///                distance field text. Optional, these are the defaults:
+  ///     * \<cell_size\> : Only one label is shown per square screen cell
+  ///                       of this size, in pixels, the closest. Zero
+  ///                       shows overlapping labels. Defaults to 32.
+  ///     * \<max_labels\> : Most labels shown at once, zero for no limit.
+  ///                        Defaults to 256.
+  ///     * \<max_distance\> : Labels farther from the camera than this, in
+  ///                          meters, are hidden. Zero for no limit, which
+  ///                          is the default.
+  /// * \<spawn_preview\> : If true, text dragged over the scene, such as a
+  ///                       model's path from a resource list, starts being
+  ///                       resolved with SpawnAssets right away, so its
+  ///                       meshes are loaded by the time it's dropped, and
+  ///                       a translucent box of its size follows the mouse
+  ///                       until then. Defaults to true.
   class MinimalScene : public Plugin
   {
     Q_OBJECT
@@ -79,6 +307,35 @@ namespace gz::gui::plugins
       NOTIFY LoadingErrorChanged
     )
 
+    /// \brief Frame timing summary, see \<frame_timing\>
+    Q_PROPERTY(
+      QString frameTiming
+      READ FrameTiming
+      NOTIFY FrameTimingChanged
+    )
+
+    /// \brief True once the first frame is shown
+    Q_PROPERTY(
+      bool sceneReady
+      READ SceneReady
+      NOTIFY SceneReadyChanged
+    )
+
+    /// \brief Labels shown over the scene, see \<labels\>
+    Q_PROPERTY(
+      QObject *labels
+      READ Labels
+      CONSTANT
+    )
+
+    /// \brief Quality preset applied, see \<quality\>. Empty if none.
+    Q_PROPERTY(
+      QString quality
+      READ Quality
+      WRITE SetQuality
+      NOTIFY QualityChanged
+    )
+
     /// \brief Constructor
     public: MinimalScene();
 
@@ -98,6 +355,23 @@ namespace gz::gui::plugins
     public slots: void OnDropped(const QString &_drop,
         int _mouseX, int _mouseY);
 
+    /// \brief Callback when text starts being dragged over the scene. It's
+    /// resolved with SpawnAssets and previewed until it's dropped or
+    /// dragged away.
+    /// \param[in] _text Dragged string, such as a model's path or SDF
+    /// \param[in] _mouseX x coordinate of mouse position.
+    /// \param[in] _mouseY y coordinate of mouse position.
+    public slots: void OnDragEntered(const QString &_text,
+        int _mouseX, int _mouseY);
+
+    /// \brief Callback when the text dragged over the scene moves.
+    /// \param[in] _mouseX x coordinate of mouse position.
+    /// \param[in] _mouseY y coordinate of mouse position.
+    public slots: void OnDragMoved(int _mouseX, int _mouseY);
+
+    /// \brief Callback when the text dragged over the scene leaves it.
+    public slots: void OnDragExited();
+
     // Documentation inherited
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
@@ -113,15 +387,77 @@ namespace gz::gui::plugins
     /// \brief Notify that loading error has changed
     signals: void LoadingErrorChanged();
 
+    /// \brief Get the frame timing summary shown on the overlay.
+    /// \return Summary, empty if frame timing isn't shown.
+    public: Q_INVOKABLE QString FrameTiming() const;
+
+    /// \brief Set the frame timing summary shown on the overlay.
+    /// \param[in] _frameTiming Summary.
+    public: Q_INVOKABLE void SetFrameTiming(const QString &_frameTiming);
+
+    /// \brief Notify that the frame timing summary has changed
+    signals: void FrameTimingChanged();
+
+    /// \brief Get the labels shown over the scene
+    /// \return List model with the "labelText", "labelX", "labelY" and
+    /// "labelColor" roles. Positions are fractions of the scene's size.
+    public: Q_INVOKABLE QObject *Labels();
+
+    /// \brief Whether the first frame is shown. Until then, the card shows
+    /// that the render engine is starting.
+    /// \return True once the first frame is ready
+    public: Q_INVOKABLE bool SceneReady() const;
+
+    /// \brief Notify that the first frame is ready
+    signals: void SceneReadyChanged();
+
+    /// \brief Get the quality preset applied
+    /// \return "low", "medium", "high", "ultra" or empty if none
+    public: Q_INVOKABLE QString Quality() const;
+
+    /// \brief Apply a quality preset without reloading the scene
+    /// \param[in] _quality "low", "medium", "high" or "ultra"
+    public: Q_INVOKABLE void SetQuality(const QString &_quality);
+
+    /// \brief Notify that the quality preset has changed, including when
+    /// it's lowered automatically
+    signals: void QualityChanged();
+
     /// \brief Loading error message
     public: QString loadingError;
 
+    /// \brief Frame timing summary
+    public: QString frameTiming;
+
+    /// \brief Quality preset
+    public: QString quality;
+
+    /// \brief Whether the first frame is ready
+    public: bool sceneReady{false};
+
     /// \internal
     /// \brief Pointer to private data.
     GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
   };
 
+  class InputRecorder;
   class RenderSync;
+  class SharpenMaterial;
+
+  /// \brief Extra view of the scene rendered by GzRenderer along with the
+  /// main camera. See the \<view\> config.
+  class SceneView
+  {
+    /// \brief Pose of the view's camera
+    public: math::Pose3d pose = math::Pose3d(0, 0, 10, 0, M_PI * 0.5, 0);
+
+    /// \brief Horizontal FOV of the view's camera
+    public: math::Angle hfov = math::Angle(M_PI * 0.5);
+
+    /// \brief Area of the item covered by the view: x and y of its top left
+    /// corner, width and height, all as fractions of the item size.
+    public: math::Vector4d rect = math::Vector4d(0.7, 0.05, 0.25, 0.25);
+  };
 
   /// \brief gz-rendering renderer.
   /// All gz-rendering calls should be performed inside this class as it makes
@@ -147,6 +483,10 @@ namespace gz::gui::plugins
     /// occurred.
     public: std::string Initialize(RenderThreadRhi &_rhi);
 
+    /// \brief Start loading the library of `engineName` in the background,
+    /// so Initialize finds it loaded. Call before the render thread starts.
+    public: void PreloadEngine();
+
     /// \brief Set the graphics API
     /// \param[in] _graphicsAPI The type of graphics API
     public: void SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI);
@@ -168,6 +508,12 @@ namespace gz::gui::plugins
     public: void NewDropEvent(const std::string &_dropText,
       const math::Vector2i &_dropPos);
 
+    /// \brief Text dragged over the scene moved
+    /// \param[in] _text Dragged text, empty once it's dropped or leaves
+    /// \param[in] _pos Mouse screen position
+    public: void NewSpawnDrag(const std::string &_text,
+      const math::Vector2i &_pos);
+
     /// \brief Handle key press event for snapping
     /// \param[in] _e The key event to process.
     public: void HandleKeyPress(const common::KeyEvent &_e);
@@ -179,6 +525,10 @@ namespace gz::gui::plugins
     /// \brief Handle mouse event for view control
     private: void HandleMouseEvent();
 
+    /// \brief Show a box of the size of the resource dragged over the
+    /// scene where it would be dropped, or hide it
+    private: void UpdateSpawnPreview();
+
     /// \brief Broadcasts the currently hovered 3d scene location.
     private: void BroadcastHoverPos();
 
@@ -206,6 +556,43 @@ namespace gz::gui::plugins
     /// \brief Broadcasts a key press event within the scene
     private: void BroadcastKeyPress();
 
+    /// \brief Request the view controller set in cameraViewController
+    /// without blocking, and handle the reply once it arrives.
+    private: void UpdateViewController();
+
+    /// \brief Hand the frame which was just rendered to the FrameTaps
+    /// subscribers due for it, reading it back from the GPU at most once
+    /// \param[in] _renderThreadRhi Render interface holding the texture
+    private: void PublishFrameTaps(RenderThreadRhi &_renderThreadRhi);
+
+    /// \brief Place the labels on the screen for the frame which was just
+    /// rendered, and hand them to labelsCb if they changed
+    private: void UpdateLabels();
+
+    /// \brief Adjust the resolution scale used by dynamic resolution
+    /// \param[in] _frameTime Time it took to render the last frame, in
+    /// seconds
+    /// \param[in] _cameraMoved True if the camera moved during the frame
+    /// \return True if another frame should be rendered, because the scale
+    /// changed or is still below full resolution
+    private: bool UpdateResolutionScale(double _frameTime, bool _cameraMoved);
+
+    /// \brief Request a quality preset, applied at the start of the next
+    /// frame. Thread safe.
+    /// \param[in] _preset Preset name, see QualityPresets
+    public: void SetQuality(const std::string &_preset);
+
+    /// \brief Apply the quality preset requested, if it changed, and keep
+    /// the number of shadow casting lights within it as lights are added
+    private: void ApplyQuality();
+
+    /// \brief Add the current frame to the frame timing and report the
+    /// averages once the report period has passed.
+    /// \param[in] _rhi Render interface to get the GPU time from
+    /// \param[in] _frameStart When the frame started
+    private: void ReportFrameTiming(RenderThreadRhi &_rhi,
+        const std::chrono::steady_clock::time_point &_frameStart);
+
     /// \brief Render engine to use
     public: std::string engineName = "ogre";
 
@@ -230,12 +617,54 @@ namespace gz::gui::plugins
     /// \brief True if engine has been initialized;
     public: bool initialized = false;
 
+    /// \brief Size of the item displaying the texture. The texture is
+    /// rendered at a fraction of it when using dynamic resolution.
+    public: QSize itemSize = QSize(1024, 1024);
+
     /// \brief Render texture size
     public: QSize textureSize = QSize(1024, 1024);
 
     /// \brief Flag to indicate texture size has changed.
     public: bool textureDirty = true;
 
+    /// \brief True to lower the resolution of the texture while frames
+    /// take longer than targetFps allows.
+    public: bool dynamicResolution = false;
+
+    /// \brief Frame rate dynamic resolution tries to keep
+    public: double targetFps = 30.0;
+
+    /// \brief Lowest fraction of the item size the texture is rendered at
+    /// when using dynamic resolution
+    public: double minResolutionScale = 0.5;
+
+    /// \brief Time each frame may spend running SceneCommandQueue commands,
+    /// zero for no limit
+    public: std::chrono::steady_clock::duration sceneCommandBudget{
+        std::chrono::milliseconds(10)};
+
+    /// \brief Time each frame may spend running RenderHooks frame tasks,
+    /// zero for no limit
+    public: std::chrono::steady_clock::duration frameTaskBudget{
+        std::chrono::milliseconds(5)};
+
+    /// \brief Bytes each frame may upload through GpuUploads, zero for no
+    /// limit
+    public: std::size_t gpuUploadBudget{8 * 1024 * 1024};
+
+    /// \brief Time the item size must be stable before the texture is
+    /// resized, zero to resize right away
+    public: std::chrono::steady_clock::duration resizeDelay{
+        std::chrono::milliseconds(100)};
+
+    /// \brief Texture sizes are rounded up to a multiple of this, in
+    /// pixels
+    public: int textureSizeStep{1};
+
+    /// \brief Texture size over the item size in logical pixels, before
+    /// dynamic resolution is applied
+    public: double renderScale{1.0};
+
     /// \brief True if sky is enabled;
     public: bool skyEnable = false;
 
@@ -248,10 +677,75 @@ namespace gz::gui::plugins
     /// \brief View controller type
     public: std::string cameraViewController{""};
 
+    /// \brief Extra views rendered after the main camera. Must be set
+    /// before initialization.
+    public: std::vector<SceneView> views;
+
+    /// \brief True to measure how long each stage of a frame takes. See
+    /// the \<frame_timing\> config. Must be set before initialization.
+    public: bool frameTiming = false;
+
+    /// \brief Topic frame timing is published on, empty to not publish it
+    public: std::string frameTimingTopic = "/gui/frame_timing";
+
+    /// \brief Times the Qt Quick frames when frame timing is enabled, fed
+    /// from the window's signals and reported along with the stages
+    public: std::shared_ptr<QuickFrameTiming> quickTiming;
+
+    /// \brief True to render without a window or Qt's context. See the
+    /// \<headless\> config. Must be set before initialization.
+    public: bool headless = false;
+
+    /// \brief True to prefer GPU ray queries for mouse events. See the
+    /// \<gpu_ray_query\> config. Must be set before initialization.
+    public: bool gpuRayQuery = false;
+
+    /// \brief Directory for the shader cache and the warm-up list, empty to
+    /// not keep one. See the \<shader_cache\> config. Must be set before
+    /// initialization.
+    public: std::string shaderCacheDir;
+
+    /// \brief True to render the meshes and materials of the previous
+    /// session before the first frame. Must be set before initialization.
+    public: bool warmup = false;
+
+    /// \brief Called from the render thread with a human readable summary
+    /// each time frame timing is reported
+    public: std::function<void(const std::string &)> frameTimingCb;
+
+    /// \brief Labels shown over the scene, shared through SceneServices
+    /// once the scene is initialized
+    public: std::shared_ptr<SceneLabels> labels{
+        std::make_shared<SceneLabels>()};
+
+    /// \brief Called from the render thread with the labels placed on the
+    /// screen and the screen's width and height, each time they change
+    public: std::function<void(std::vector<PlacedLabel>, unsigned int,
+        unsigned int)> labelsCb;
+
+    /// \brief Records the mouse and key events received, null to not
+    /// record them. See the \<input_recording\> config. Must be set before
+    /// initialization.
+    public: std::shared_ptr<InputRecorder> inputRecorder;
+
+    /// \brief Frame rate below which the quality preset is lowered, 0 to
+    /// never lower it. Must be set before initialization.
+    public: double qualityTargetFps = 0.0;
+
+    /// \brief Called from the render thread with the name of each quality
+    /// preset applied
+    public: std::function<void(const std::string &)> qualityCb;
+
     /// \brief Retrieves the internal camera.
     /// TODO(darksylinc): Remove this hack.
     public: rendering::CameraPtr Camera();
 
+    /// \brief Retrieves the camera of one of the extra views.
+    /// \param[in] _index Index of the view in views
+    /// \return The camera, null if there's no such view or the renderer
+    /// isn't initialized yet
+    public: rendering::CameraPtr ViewCamera(std::size_t _index);
+
     /// \internal
     /// \brief Pointer to private data.
     GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
@@ -307,15 +801,27 @@ namespace gz::gui::plugins
     /// \param[in] _graphicsAPI The type of graphics API
     public: void SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI);
 
+    /// \brief Render with OpenGL on an EGL device of its own, without a
+    /// window or Qt's context. Replaces the graphics API set before.
+    public: void SetHeadless();
+
     /// \brief Carry out initialisation.
     /// On macOS this must be run on the main thread
     public: std::string Initialize();
 
+    /// \brief Whether the graphics API supports rendering with a swap chain
+    /// \return True if supported
+    /// \sa RenderWindowItem::SetTextureBufferCount
+    public: bool SupportsSwapBuffers() const;
+
     /// \brief gz-rendering renderer
     public: GzRenderer gzRenderer;
 
     /// \brief Pointer to render interface to handle OpenGL/Metal compatibility
     private: std::unique_ptr<RenderThreadRhi> rhi;
+
+    /// \brief True once the thread is watched by StallWatchdog
+    private: bool watched{false};
   };
 
   /// \brief A QQUickItem that manages the render window
@@ -337,7 +843,8 @@ namespace gz::gui::plugins
     /// \param[in] _ambient Color of ambient light
     public: void SetAmbientLight(const math::Color &_ambient);
 
-    /// \brief Set engine name used to create the render window
+    /// \brief Set engine name used to create the render window, and start
+    /// loading the engine in the background
     /// \param[in] _name Name of render engine
     public: void SetEngineName(const std::string &_name);
 
@@ -368,6 +875,12 @@ namespace gz::gui::plugins
     public: void OnDropped(const QString &_drop,
         const gz::math::Vector2i &_dropPos);
 
+    /// \brief Called when text dragged over the scene moves.
+    /// \param[in] _text Dragged string, empty once it's dropped or leaves
+    /// \param[in] _pos Mouse position.
+    public: void OnSpawnDrag(const QString &_text,
+        const gz::math::Vector2i &_pos);
+
     /// \brief Set if sky is enabled
     /// \param[in] _sky True to enable the sky, false otherwise.
     public: void SetSkyEnabled(const bool &_sky);
@@ -386,6 +899,187 @@ namespace gz::gui::plugins
     /// \param[in] _graphicsAPI The type of graphics API
     public: void SetGraphicsAPI(const rendering::GraphicsAPI& _graphicsAPI);
 
+    /// \brief Set the number of textures rendered frames are rotated
+    /// through. See the \<texture_buffer_count\> config.
+    /// \param[in] _count Number of textures, 1 to keep the render and Qt
+    /// threads serialized.
+    public: void SetTextureBufferCount(unsigned int _count);
+
+    /// \brief Set the priority and CPUs of the render thread. Must be
+    /// called before rendering starts.
+    /// \param[in] _policy Policy
+    public: void SetRenderThreadPolicy(const ThreadPolicy &_policy);
+
+    /// \brief Set whether frames start at a predicted offset before the
+    /// display refresh. See the \<vsync_pacing\> config. Must be called
+    /// before rendering starts.
+    /// \param[in] _pacing True to pace frames
+    public: void SetVsyncPacing(bool _pacing);
+
+    /// \brief Set whether to only render frames when requested, instead of
+    /// continuously. Must be called before rendering starts.
+    /// \param[in] _onDemand True to render on demand
+    public: void SetRenderOnDemand(bool _onDemand);
+
+    /// \brief Set the maximum rate frames are rendered at.
+    /// \param[in] _fps Frames per second, 0 for no limit
+    public: void SetMaxFps(double _fps);
+
+    /// \brief Set the maximum rate frames are rendered at while hidden.
+    /// Must be called before rendering starts.
+    /// \param[in] _fps Frames per second, 0 to render none
+    public: void SetHiddenFps(double _fps);
+
+    /// \brief Set whether the scene can be seen. Frames are rendered at
+    /// most at the hidden rate while it can't.
+    /// \param[in] _hidden True while hidden
+    public: void SetHidden(bool _hidden);
+
+    /// \brief Set the time each frame may spend running the scene commands
+    /// recorded by plugins.
+    /// \param[in] _budget Budget, zero for no limit
+    public: void SetSceneCommandBudget(
+        std::chrono::steady_clock::duration _budget);
+
+    /// \brief Set the time each frame may spend running the frame tasks
+    /// registered by plugins.
+    /// \param[in] _budget Budget, zero for no limit
+    public: void SetFrameTaskBudget(
+        std::chrono::steady_clock::duration _budget);
+
+    /// \brief Set the bytes each frame may upload to the GPU through
+    /// GpuUploads. See the \<gpu_upload_budget\> config.
+    /// \param[in] _budget Budget, zero for no limit
+    public: void SetGpuUploadBudget(std::size_t _budget);
+
+    /// \brief Set how long the size must be stable before the texture is
+    /// resized. See the \<resize_delay\> config.
+    /// \param[in] _delay Delay, zero to resize right away
+    public: void SetResizeDelay(std::chrono::steady_clock::duration _delay);
+
+    /// \brief Set the step texture sizes are rounded up to. See the
+    /// \<texture_size_step\> config.
+    /// \param[in] _step Pixels, 1 to keep the exact size
+    public: void SetTextureSizeStep(int _step);
+
+    /// \brief Set the resolution of the texture relative to the item. See
+    /// the \<render_scale\> config.
+    /// \param[in] _scale Fraction of the item size, larger than 0
+    /// \param[in] _devicePixels True if relative to the size in physical
+    /// pixels, false if in logical pixels
+    /// \param[in] _sharpen Sharpening strength while upscaling, from 0 to 1
+    public: void SetRenderScale(double _scale, bool _devicePixels,
+        double _sharpen);
+
+    /// \brief Start rendering without a window server, instead of once the
+    /// item is shown. See the \<headless\> config. Must be called after
+    /// everything else is configured, since the render thread starts right
+    /// away.
+    /// \param[in] _size Size of the item to render for, in pixels
+    /// \param[in] _fps Frames per second to render at, larger than 0
+    public: void StartHeadless(const QSize &_size, double _fps);
+
+    /// \brief Render at a lower resolution and upscale while the scene is
+    /// too slow to keep the target frame rate, and go back to full
+    /// resolution once the camera stops moving.
+    /// \param[in] _enabled True to enable dynamic resolution
+    /// \param[in] _targetFps Frame rate to keep
+    /// \param[in] _minScale Lowest fraction of the full resolution to use,
+    /// between 0 and 1
+    public: void SetDynamicResolution(bool _enabled, double _targetFps,
+        double _minScale);
+
+    /// \brief Set extra views of the scene to render as insets on top of the
+    /// main one. See the \<view\> config. Must be called before rendering
+    /// starts.
+    /// \param[in] _views Views to render
+    public: void SetViews(const std::vector<SceneView> &_views);
+
+    /// \brief Measure how long each stage of a frame takes and report it
+    /// periodically. Must be called before rendering starts.
+    /// \param[in] _topic Topic to publish the timing on, empty to not
+    /// publish it
+    /// \param[in] _cb Called from the render thread with a human readable
+    /// summary each time the timing is reported, may be empty
+    public: void SetFrameTiming(const std::string &_topic,
+        std::function<void(const std::string &)> _cb);
+
+    /// \brief Get the labels shown over the scene
+    /// \return Labels
+    public: std::shared_ptr<SceneLabels> Labels() const;
+
+    /// \brief Set the function receiving the labels placed on the screen.
+    /// Must be called before rendering starts.
+    /// \param[in] _cb Called from the render thread with the labels and the
+    /// screen's width and height, each time they change
+    public: void SetLabelsCallback(std::function<void(
+        std::vector<PlacedLabel>, unsigned int, unsigned int)> _cb);
+
+    /// \brief Prefer GPU ray queries to find the scene position under the
+    /// mouse. Must be called before rendering starts.
+    /// \param[in] _gpu True to prefer the GPU
+    public: void SetGpuRayQuery(bool _gpu);
+
+    /// \brief Set the shader cache directory and whether to warm up the
+    /// render engine with the previous session's meshes and materials. Must
+    /// be called before rendering starts.
+    /// \param[in] _dir Directory, empty to not keep a cache
+    /// \param[in] _warmup True to warm up
+    public: void SetShaderCache(const std::string &_dir, bool _warmup);
+
+    /// \brief Apply a lighting quality preset at the next frame, without
+    /// reloading the scene. See the \<quality\> config.
+    /// \param[in] _preset "low", "medium", "high" or "ultra"
+    public: void SetQuality(const std::string &_preset);
+
+    /// \brief Lower the quality preset while frames are too slow. Must be
+    /// called before rendering starts.
+    /// \param[in] _targetFps Frame rate to keep, 0 to never lower it
+    /// \param[in] _cb Called from the render thread with the name of each
+    /// preset applied, may be empty
+    public: void SetQualityDowngrade(double _targetFps,
+        std::function<void(const std::string &)> _cb);
+
+    /// \brief Request a new frame when rendering on demand. Does nothing
+    /// when rendering continuously. Thread safe.
+    public: void RequestRender();
+
+    /// \brief Handle mouse and key events received on a topic, see the
+    /// \<input_topic\> config.
+    /// \param[in] _topic Topic of gz::msgs::Param input events
+    /// \return True if subscribed
+    public: bool SetInputTopic(const std::string &_topic);
+
+    /// \brief Record the mouse and key events received, starting with the
+    /// first frame. See the \<input_recording\> config. Must be called
+    /// before rendering starts.
+    /// \param[in] _path File of input events
+    /// \param[in] _transportLog Log for the transport msgs received, empty
+    /// to not record them
+    /// \param[in] _topics Regular expressions of the topics to record
+    public: void SetInputRecording(const std::string &_path,
+        const std::string &_transportLog,
+        const std::vector<std::string> &_topics);
+
+    /// \brief Replay recorded mouse and key events, starting with the first
+    /// frame. See the \<input_recording\> config. Must be called before
+    /// rendering starts.
+    /// \param[in] _path File of input events
+    /// \param[in] _transportLog Log of transport msgs to publish along
+    /// with the events, empty for none
+    /// \param[in] _quit True to close the application once done
+    /// \return False if the file couldn't be loaded
+    public: bool SetInputReplay(const std::string &_path,
+        const std::string &_transportLog, bool _quit);
+
+    /// \brief Start the recording or replay which was set, if any. Called
+    /// on the main thread with the first frame.
+    public: void StartInputSession();
+
+    /// \brief Feed the replayed events which are due to the renderer and
+    /// schedule the next ones
+    private: void ReplayInput();
+
     /// \brief Set the camera view controller
     /// \param[in] _view_controller The camera view controller type to set
     public: void SetCameraViewController(const std::string &_view_controller);
@@ -405,9 +1099,19 @@ namespace gz::gui::plugins
     /// \param[in] _cb Error callback
     public: void SetErrorCb(std::function<void(const QString &)> _cb);
 
+    /// \brief Set a callback to be called once the first frame is ready.
+    /// Must be called before rendering starts.
+    /// \param[in] _cb Called on the main thread
+    public: void SetFirstFrameCb(std::function<void()> _cb);
+
     /// \brief Stop rendering and shutdown resources.
     public: void StopRendering();
 
+    /// \brief Forward a local or remote mouse event to the renderer,
+    /// keeping track of the press position and dragging state
+    /// \param[in] _e Mouse event in item coordinates
+    private: void NewMouseEvent(common::MouseEvent _e);
+
     // Documentation inherited
     protected: virtual void mousePressEvent(QMouseEvent *_e) override;
 
@@ -470,6 +1174,25 @@ namespace gz::gui::plugins
     /// pending texture
     public slots: void PrepareNode();
 
+    /// \brief Add an inset displaying the texture of an extra view. Its
+    /// frames are received along with the main texture.
+    /// \param[in] _graphicsAPI The type of graphics API
+    /// \param[in] _camera Camera owning the view's texture handle
+    /// \param[in] _rect Area covered by the view, see SceneView::rect
+    public: void AddView(const rendering::GraphicsAPI &_graphicsAPI,
+                         rendering::CameraPtr &_camera,
+                         const math::Vector4d &_rect);
+
+    /// \brief Set the area covered by the node and lay out the views
+    /// within it.
+    /// \param[in] _rect Area covered by the main texture
+    public: void SetNodeRect(const QRectF &_rect);
+
+    /// \brief Sharpen the texture while it's upscaled. Only supported by
+    /// the OpenGL scene graph.
+    /// \param[in] _strength From 0, which disables sharpening, to 1
+    public: void SetSharpening(float _strength);
+
     /// \param[in] _renderSync RenderSync to send to the worker thread
           signals: void TextureInUse(gz::gui::plugins::RenderSync *_renderSync);
 
@@ -477,6 +1200,26 @@ namespace gz::gui::plugins
     /// update
     signals: void PendingNewTexture();
 
+    /// \brief Check whether a frame can be requested from the worker now,
+    /// taking render on demand and the frame rate cap into account. If the
+    /// cap is the reason, a window update is scheduled for when it allows a
+    /// frame.
+    /// \return True if a frame should be requested
+    private: bool CanRequestFrame();
+
+    /// \brief Create the render interface for the graphics API
+    /// \param[in] _window Window to display the texture
+    /// \param[in] _graphicsAPI The type of graphics API
+    /// \param[in] _camera Camera owning the texture handle
+    /// \return New render interface
+    private: static std::unique_ptr<TextureNodeRhi> CreateRhi(
+        QQuickWindow *_window, const rendering::GraphicsAPI &_graphicsAPI,
+        rendering::CameraPtr &_camera);
+
+    /// \brief Draw the texture with the sharpening material while it's
+    /// smaller than the node on screen, and with the default one otherwise
+    private: void UpdateMaterial();
+
     /// \brief Texture size
     public: QSize size = QSize(0, 0);
 
@@ -491,6 +1234,32 @@ namespace gz::gui::plugins
 
     /// \brief Pointer to render interface to handle OpenGL/Metal compatibility
     private: std::unique_ptr<TextureNodeRhi> rhi;
+
+    /// \brief Material sharpening the upscaled texture, null if disabled
+    private: std::unique_ptr<SharpenMaterial> sharpenMaterial;
+
+    /// \brief Materials of QSGSimpleTextureNode, restored when the texture
+    /// isn't upscaled
+    private: QSGMaterial *defaultMaterial{nullptr};
+
+    /// \brief See defaultMaterial
+    private: QSGMaterial *defaultOpaqueMaterial{nullptr};
+
+    /// \brief Inset displaying an extra view
+    private: class ViewNode
+    {
+      /// \brief Render interface for the view's texture
+      public: std::unique_ptr<TextureNodeRhi> rhi;
+
+      /// \brief Child node drawing the texture, owned by this node
+      public: QSGSimpleTextureNode *node = nullptr;
+
+      /// \brief See SceneView::rect
+      public: math::Vector4d rect;
+    };
+
+    /// \brief Insets of all extra views, in the order of GzRenderer::views
+    private: std::vector<ViewNode> views;
   };
 }  // namespace gz::gui::plugins
 
@@ -49,6 +49,64 @@ Rectangle {
     visible: MinimalScene.loadingError.length == 0
   }
 
+  // Labels other plugins show over the scene, see SceneLabels. Text items
+  // share a distance field glyph atlas and are drawn in one batch.
+  Item {
+    id: labelOverlay
+    objectName: "labels"
+    anchors.fill: renderWindow
+    visible: MinimalScene.loadingError.length == 0
+
+    Repeater {
+      model: MinimalScene.labels
+      delegate: Text {
+        x: labelX * labelOverlay.width - width / 2
+        y: labelY * labelOverlay.height - height
+        text: labelText
+        color: labelColor
+        renderType: Text.QtRendering
+        style: Text.Outline
+        styleColor: "black"
+      }
+    }
+  }
+
+  // Until the render engine shows its first frame
+  Column {
+    anchors.centerIn: parent
+    spacing: 10
+    visible: !MinimalScene.sceneReady &&
+             MinimalScene.loadingError.length == 0
+
+    BusyIndicator {
+      anchors.horizontalCenter: parent.horizontalCenter
+      running: parent.visible
+    }
+
+    Label {
+      text: "Starting the 3D view"
+    }
+  }
+
+  Label {
+    id: frameTimingOverlay
+    objectName: "frameTiming"
+    anchors.top: parent.top
+    anchors.left: parent.left
+    anchors.margins: 10
+    padding: 5
+    visible: MinimalScene.frameTiming.length > 0 &&
+             MinimalScene.loadingError.length == 0
+    text: MinimalScene.frameTiming
+    font.family: "Monospace"
+    color: "white"
+    background: Rectangle {
+      color: "black"
+      opacity: 0.5
+      radius: 3
+    }
+  }
+
 
   onParentChanged: {
     if (undefined === parent)
@@ -61,6 +119,18 @@ Rectangle {
   DropArea {
   anchors.fill: renderWindow
 
+  onEntered: {
+    MinimalScene.OnDragEntered(drag.text, drag.x, drag.y)
+  }
+
+  onPositionChanged: {
+    MinimalScene.OnDragMoved(drag.x, drag.y)
+  }
+
+  onExited: {
+    MinimalScene.OnDragExited()
+  }
+
   onDropped: {
     MinimalScene.OnDropped(drop.text, drag.x, drag.y)
   }
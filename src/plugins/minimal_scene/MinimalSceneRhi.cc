@@ -49,6 +49,42 @@ void RenderThreadRhi::SetContext(QOpenGLContext *) //NOLINT
   /* no-op */
 }
 
+/////////////////////////////////////////////////
+bool RenderThreadRhi::SupportsSwapBuffers() const
+{
+  return false;
+}
+
+/////////////////////////////////////////////////
+void *RenderThreadRhi::CopyToSwapBuffer(unsigned int, const QSize &) //NOLINT
+{
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+bool RenderThreadRhi::ZeroCopy(rendering::CameraPtr &) const //NOLINT
+{
+  return false;
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhi::BeginGpuTimer()
+{
+  /* no-op */
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhi::EndGpuTimer()
+{
+  /* no-op */
+}
+
+/////////////////////////////////////////////////
+bool RenderThreadRhi::GpuTime(double &) //NOLINT
+{
+  return false;
+}
+
 /////////////////////////////////////////////////
 TextureNodeRhi::~TextureNodeRhi() = default;
 }  // namespace gz::gui::plugins
@@ -105,6 +105,44 @@ namespace gz::gui::plugins
 
     /// \brief Shutdown the thread and the render engine
     public: virtual void ShutDown() = 0;
+
+    /// \brief Whether this interface can copy rendered frames into a swap
+    /// chain of textures, which lets the worker and Qt threads run decoupled.
+    /// \return True if CopyToSwapBuffer is implemented. Defaults to false.
+    public: virtual bool SupportsSwapBuffers() const;
+
+    /// \brief Copy the texture the camera has just rendered into a texture
+    /// owned by the swap chain, so the camera can start rendering the next
+    /// frame while Qt displays this one.
+    /// Must be called from the worker thread, after rendering.
+    /// \param[in] _index Index of the swap chain buffer to copy into
+    /// \param[in] _size Size of the rendered texture
+    /// \return Pointer to the graphics API texture Id of the swap chain
+    /// buffer, or nullptr if swap chains aren't supported.
+    public: virtual void *CopyToSwapBuffer(unsigned int _index,
+        const QSize &_size);
+
+    /// \brief Whether Qt samples the texture a camera renders into
+    /// directly, without it being copied or read back on the way.
+    /// \param[in] _camera Camera providing the texture
+    /// \return True if the texture is shared with Qt. Defaults to false.
+    public: virtual bool ZeroCopy(rendering::CameraPtr &_camera) const;
+
+    /// \brief Start measuring how long the GPU takes to execute the work
+    /// submitted from now on. Must be called from the worker thread. Does
+    /// nothing by default.
+    public: virtual void BeginGpuTimer();
+
+    /// \brief Stop the measurement started by BeginGpuTimer. The result is
+    /// available a few frames later through GpuTime.
+    public: virtual void EndGpuTimer();
+
+    /// \brief Get the result of the latest GPU measurement which has
+    /// completed since the last call. Never waits for the GPU.
+    /// \param[out] _seconds Time the GPU took, in seconds
+    /// \return True if there was a new result. Always false if GPU timers
+    /// aren't supported.
+    public: virtual bool GpuTime(double &_seconds);
   };
 
   /// \brief Render interface class to handle OpenGL / Metal compatibility
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "MinimalSceneRhiHeadless.hh"
+
+#include "MinimalScene.hh"
+
+#include <gz/common/Console.hh>
+#include <gz/rendering/Camera.hh>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/////////////////////////////////////////////////
+namespace gz::gui::plugins
+{
+  class RenderThreadRhiHeadlessPrivate
+  {
+    public: GzRenderer *renderer = nullptr;
+    public: void *texturePtr = nullptr;
+  };
+
+/////////////////////////////////////////////////
+RenderThreadRhiHeadless::~RenderThreadRhiHeadless() = default;
+
+/////////////////////////////////////////////////
+RenderThreadRhiHeadless::RenderThreadRhiHeadless(GzRenderer *_renderer)
+    : dataPtr(std::make_unique<RenderThreadRhiHeadlessPrivate>())
+{
+  this->dataPtr->renderer = _renderer;
+}
+
+/////////////////////////////////////////////////
+std::string RenderThreadRhiHeadless::Initialize()
+{
+  return this->dataPtr->renderer->Initialize(*this);
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiHeadless::Update(rendering::CameraPtr _camera)
+{
+  this->dataPtr->texturePtr = reinterpret_cast<void *>(
+    static_cast<intptr_t>(_camera->RenderTextureGLId()));
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiHeadless::RenderNext(RenderSync *_renderSync)
+{
+  // The engine's context is created and made current on the thread which
+  // initializes it, so that must be the render thread
+  if (!this->dataPtr->renderer->initialized)
+  {
+    const auto loadingError = this->Initialize();
+    if (!this->dataPtr->renderer->initialized)
+    {
+      gzerr << "Unable to initialize headless renderer: " << loadingError
+            << std::endl;
+      return;
+    }
+  }
+
+  this->dataPtr->renderer->Render(_renderSync, *this);
+}
+
+/////////////////////////////////////////////////
+void* RenderThreadRhiHeadless::TexturePtr() const
+{
+  return this->dataPtr->texturePtr;
+}
+
+/////////////////////////////////////////////////
+QSize RenderThreadRhiHeadless::TextureSize() const
+{
+  return this->dataPtr->renderer->textureSize;
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiHeadless::ShutDown()
+{
+  this->dataPtr->renderer->Destroy();
+  this->dataPtr->texturePtr = nullptr;
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MINIMALSCENE_MINIMALSCENERHIHEADLESS_HH_
+#define GZ_GUI_PLUGINS_MINIMALSCENE_MINIMALSCENERHIHEADLESS_HH_
+
+#include "MinimalSceneRhi.hh"
+
+#include <QSize>
+
+#include <memory>
+#include <string>
+
+namespace gz::gui::plugins
+{
+  /// \brief Private data for RenderThreadRhiHeadless
+  class RenderThreadRhiHeadlessPrivate;
+
+  /// \brief Implementation of RenderThreadRhi which renders without a
+  /// window server. The render engine creates its own context on a
+  /// surfaceless EGL device, which isn't shared with Qt, so frames are only
+  /// consumed through FrameTaps.
+  class RenderThreadRhiHeadless : public RenderThreadRhi
+  {
+    // Documentation inherited
+    public: virtual ~RenderThreadRhiHeadless() override;
+
+    /// \brief Constructor
+    /// \param[in] _renderer The gz-rendering renderer
+    public: explicit RenderThreadRhiHeadless(GzRenderer *_renderer);
+
+    // Documentation inherited
+    public: virtual std::string Initialize() override;
+
+    // Documentation inherited
+    public: virtual void Update(rendering::CameraPtr _camera) override;
+
+    // Documentation inherited
+    public: virtual void RenderNext(RenderSync *_renderSync) override;
+
+    // Documentation inherited
+    public: virtual void* TexturePtr() const override;
+
+    // Documentation inherited
+    public: virtual QSize TextureSize() const override;
+
+    // Documentation inherited
+    public: virtual void ShutDown() override;
+
+    /// \internal Prevent copy and assignment
+    private: RenderThreadRhiHeadless(
+        const RenderThreadRhiHeadless &_other) = delete;
+    private: RenderThreadRhiHeadless& operator=(
+        const RenderThreadRhiHeadless &_other) = delete;
+
+    /// \internal Pointer to private data
+    private: std::unique_ptr<RenderThreadRhiHeadlessPrivate> dataPtr;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MINIMALSCENE_MINIMALSCENERHIHEADLESS_HH_
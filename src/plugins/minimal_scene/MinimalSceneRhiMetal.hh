@@ -77,6 +77,10 @@ namespace gz::gui::plugins
     // Documentation inherited
     public: virtual QSize TextureSize() const override;
 
+    // Documentation inherited
+    public: virtual bool ZeroCopy(rendering::CameraPtr &_camera) const
+        override;
+
     // Documentation inherited
     public: virtual void ShutDown() override;
 
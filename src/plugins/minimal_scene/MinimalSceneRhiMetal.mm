@@ -58,6 +58,10 @@ namespace plugins
     public: id<MTLTexture> newMetalTexture = nil;
     public: QSize size {0, 0};
     public: QSize newSize {0, 0};
+
+    /// \brief Texture and size currently wrapped by texture
+    public: id<MTLTexture> currentMetalTexture = nil;
+    public: QSize currentSize {0, 0};
     public: QMutex mutex;
     public: QSGTexture *texture = nullptr;
     public: QQuickWindow *window = nullptr;
@@ -144,6 +148,13 @@ QSize RenderThreadRhiMetal::TextureSize() const
   return this->dataPtr->renderer->textureSize;
 }
 
+/////////////////////////////////////////////////
+bool RenderThreadRhiMetal::ZeroCopy(rendering::CameraPtr &) const //NOLINT
+{
+  // Qt samples the texture the camera renders into
+  return true;
+}
+
 /////////////////////////////////////////////////
 void RenderThreadRhiMetal::ShutDown()
 {
@@ -204,8 +215,21 @@ void TextureNodeRhiMetal::PrepareNode()
   this->dataPtr->metalTexture = nil;
   this->dataPtr->mutex.unlock();
 
+  // The camera keeps rendering into the same texture until it's resized, so
+  // keep sampling it through the same Qt texture instead of wrapping it
+  // again every frame.
+  if (this->dataPtr->newMetalTexture &&
+      this->dataPtr->newMetalTexture == this->dataPtr->currentMetalTexture &&
+      this->dataPtr->newSize == this->dataPtr->currentSize)
+  {
+    this->dataPtr->newMetalTexture = nil;
+  }
+
   if (this->dataPtr->newMetalTexture)
   {
+    this->dataPtr->currentMetalTexture = this->dataPtr->newMetalTexture;
+    this->dataPtr->currentSize = this->dataPtr->newSize;
+
     delete this->dataPtr->texture;
     this->dataPtr->texture = nullptr;
 
@@ -24,12 +24,21 @@
 #include <gz/rendering/Camera.hh>
 
 #include <QMutex>
+#include <QOpenGLExtraFunctions>
 #include <QQuickWindow>
 #include <QSGTexture>
 #include <QSize>
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
+
+// Not defined by OpenGL ES headers, from GL_ARB_timer_query
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
 
 /////////////////////////////////////////////////
 namespace gz::gui::plugins
@@ -48,6 +57,71 @@ namespace gz::gui::plugins
 
     /// \brief For fallback support if we can't render directly to Qt API
     public: std::unique_ptr<EngineToQtInterface> engineToQtInterface;
+
+    /// \brief Textures of the swap chain, see CopyToSwapBuffer
+    public: std::vector<GLuint> swapTextures;
+
+    /// \brief Size of each texture in swapTextures
+    public: std::vector<QSize> swapSizes;
+
+    /// \brief Framebuffer bound to the camera texture when copying
+    public: GLuint readFbo = 0;
+
+    /// \brief Framebuffer bound to the swap chain texture when copying
+    public: GLuint drawFbo = 0;
+
+    /// \brief Number of GPU timer queries which can be in flight. Results
+    /// are read a few frames later so the worker never waits for the GPU.
+    public: static constexpr std::size_t kTimerQueryCount = 3u;
+
+    /// \brief Time elapsed queries, see BeginGpuTimer. All 0 until first
+    /// used.
+    public: std::array<GLuint, kTimerQueryCount> timerQueries{};
+
+    /// \brief True for the queries which have been issued and whose result
+    /// hasn't been read yet
+    public: std::array<bool, kTimerQueryCount> timerPending{};
+
+    /// \brief Query the next measurement uses. Also the oldest pending one.
+    public: std::size_t timerNext = 0u;
+
+    /// \brief True between BeginGpuTimer and EndGpuTimer
+    public: bool timerActive = false;
+
+    /// \brief Whether the context supports timer queries, unset until
+    /// checked
+    public: std::optional<bool> timerSupported;
+
+    /// \brief Delete all swap chain resources.
+    /// The context must be current.
+    public: void DestroySwapBuffers()
+    {
+      if (this->swapTextures.empty() && this->readFbo == 0)
+        return;
+
+      QOpenGLFunctions *glFuncs = this->context->functions();
+      glFuncs->glDeleteTextures(static_cast<GLsizei>(this->swapTextures.size()),
+          this->swapTextures.data());
+      glFuncs->glDeleteFramebuffers(1, &this->readFbo);
+      glFuncs->glDeleteFramebuffers(1, &this->drawFbo);
+      this->swapTextures.clear();
+      this->swapSizes.clear();
+      this->readFbo = 0;
+      this->drawFbo = 0;
+    }
+
+    /// \brief Delete the GPU timer queries. The context must be current.
+    public: void DestroyTimerQueries()
+    {
+      if (this->timerQueries[0] == 0)
+        return;
+
+      this->context->extraFunctions()->glDeleteQueries(
+          static_cast<GLsizei>(this->timerQueries.size()),
+          this->timerQueries.data());
+      this->timerQueries.fill(0);
+      this->timerPending.fill(false);
+    }
   };
 
   class TextureNodeRhiOpenGLPrivate
@@ -56,6 +130,11 @@ namespace gz::gui::plugins
     public: GLuint newTextureId = 0;
     public: QSize size {0, 0};
     public: QSize newSize {0, 0};
+
+    /// \brief Texture and size currently wrapped by texture
+    public: GLuint currentTextureId = 0;
+    public: QSize currentSize {0, 0};
+
     public: QMutex mutex;
     public: QSGTexture *texture = nullptr;
     public: QQuickWindow *window = nullptr;
@@ -137,6 +216,13 @@ std::string RenderThreadRhiOpenGL::Initialize()
 {
   this->dataPtr->context->makeCurrent(this->dataPtr->surface);
 
+  // The driver chose the GPU, see GpuSelection
+  QOpenGLFunctions *glFuncs = this->dataPtr->context->functions();
+  const auto *gpu = glFuncs->glGetString(GL_RENDERER);
+  gzmsg << "Rendering on GPU ["
+        << (gpu ? reinterpret_cast<const char *>(gpu) : "unknown")
+        << "] with OpenGL" << std::endl;
+
   this->dataPtr->engineToQtInterface.reset(
     new EngineToQtInterface(this->dataPtr->context));
 
@@ -192,6 +278,180 @@ QSize RenderThreadRhiOpenGL::TextureSize() const
   return this->dataPtr->renderer->textureSize;
 }
 
+/////////////////////////////////////////////////
+bool RenderThreadRhiOpenGL::SupportsSwapBuffers() const
+{
+  return true;
+}
+
+/////////////////////////////////////////////////
+void *RenderThreadRhiOpenGL::CopyToSwapBuffer(unsigned int _index,
+    const QSize &_size)
+{
+  if (this->dataPtr->swapTextures.size() <= _index)
+  {
+    this->dataPtr->swapTextures.resize(_index + 1u, 0);
+    this->dataPtr->swapSizes.resize(_index + 1u);
+  }
+
+  QOpenGLFunctions *glFuncs = this->dataPtr->context->functions();
+  QOpenGLExtraFunctions *glExtraFuncs =
+      this->dataPtr->context->extraFunctions();
+
+  // (Re)create the destination texture if this is its first use or the
+  // render texture has been resized since
+  GLuint &texture = this->dataPtr->swapTextures[_index];
+  if (texture == 0 || this->dataPtr->swapSizes[_index] != _size)
+  {
+    glFuncs->glDeleteTextures(1, &texture);
+    glFuncs->glGenTextures(1, &texture);
+    glFuncs->glBindTexture(GL_TEXTURE_2D, texture);
+    glFuncs->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glFuncs->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFuncs->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
+        GL_CLAMP_TO_EDGE);
+    glFuncs->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
+        GL_CLAMP_TO_EDGE);
+    glFuncs->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
+        _size.width(), _size.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    this->dataPtr->swapSizes[_index] = _size;
+  }
+
+  if (this->dataPtr->readFbo == 0)
+  {
+    glFuncs->glGenFramebuffers(1, &this->dataPtr->readFbo);
+    glFuncs->glGenFramebuffers(1, &this->dataPtr->drawFbo);
+  }
+
+  // The render engine caches GL state, so restore the bindings it expects
+  GLint prevReadFbo = 0;
+  GLint prevDrawFbo = 0;
+  glFuncs->glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+  glFuncs->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFbo);
+
+  const GLuint cameraTexture = static_cast<GLuint>(
+      reinterpret_cast<intptr_t>(this->dataPtr->texturePtr));
+
+  glFuncs->glBindFramebuffer(GL_READ_FRAMEBUFFER, this->dataPtr->readFbo);
+  glFuncs->glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+      GL_TEXTURE_2D, cameraTexture, 0);
+  glFuncs->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->dataPtr->drawFbo);
+  glFuncs->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+      GL_TEXTURE_2D, texture, 0);
+
+  glExtraFuncs->glBlitFramebuffer(
+      0, 0, _size.width(), _size.height(),
+      0, 0, _size.width(), _size.height(),
+      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+  glFuncs->glBindFramebuffer(GL_READ_FRAMEBUFFER,
+      static_cast<GLuint>(prevReadFbo));
+  glFuncs->glBindFramebuffer(GL_DRAW_FRAMEBUFFER,
+      static_cast<GLuint>(prevDrawFbo));
+
+  // Qt samples the texture from its own context, so the copy must have
+  // landed before we hand it over. This only blocks the worker thread.
+  GLsync fence = glExtraFuncs->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glExtraFuncs->glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+      1000000000u);
+  glExtraFuncs->glDeleteSync(fence);
+
+  this->dataPtr->texturePtr = reinterpret_cast<void *>(
+    static_cast<intptr_t>(texture));
+  return this->dataPtr->texturePtr;
+}
+
+/////////////////////////////////////////////////
+bool RenderThreadRhiOpenGL::ZeroCopy(rendering::CameraPtr &_camera) const
+{
+  // Engines which can't render with OpenGL are read back and uploaded
+  return nullptr != this->dataPtr->engineToQtInterface &&
+      !this->dataPtr->engineToQtInterface->NeedsFallback(_camera);
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiOpenGL::BeginGpuTimer()
+{
+  if (!this->dataPtr->timerSupported.has_value())
+  {
+    const QOpenGLContext *context = this->dataPtr->context;
+    this->dataPtr->timerSupported =
+        context->hasExtension(QByteArrayLiteral("GL_ARB_timer_query")) ||
+        (!context->isOpenGLES() &&
+         context->format().version() >= qMakePair(3, 3));
+  }
+  if (!*this->dataPtr->timerSupported)
+    return;
+
+  QOpenGLExtraFunctions *glExtraFuncs =
+      this->dataPtr->context->extraFunctions();
+  if (this->dataPtr->timerQueries[0] == 0)
+  {
+    glExtraFuncs->glGenQueries(
+        static_cast<GLsizei>(this->dataPtr->timerQueries.size()),
+        this->dataPtr->timerQueries.data());
+  }
+
+  // All queries are still waiting for the GPU, skip this frame
+  const std::size_t index = this->dataPtr->timerNext;
+  if (this->dataPtr->timerPending[index])
+    return;
+
+  glExtraFuncs->glBeginQuery(GL_TIME_ELAPSED,
+      this->dataPtr->timerQueries[index]);
+  this->dataPtr->timerActive = true;
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiOpenGL::EndGpuTimer()
+{
+  if (!this->dataPtr->timerActive)
+    return;
+
+  this->dataPtr->context->extraFunctions()->glEndQuery(GL_TIME_ELAPSED);
+  this->dataPtr->timerActive = false;
+
+  const std::size_t index = this->dataPtr->timerNext;
+  this->dataPtr->timerPending[index] = true;
+  this->dataPtr->timerNext = (index + 1u) % this->dataPtr->timerQueries.size();
+}
+
+/////////////////////////////////////////////////
+bool RenderThreadRhiOpenGL::GpuTime(double &_seconds)
+{
+  if (this->dataPtr->timerQueries[0] == 0)
+    return false;
+
+  QOpenGLExtraFunctions *glExtraFuncs =
+      this->dataPtr->context->extraFunctions();
+
+  // Read results from the oldest query on, stopping at the first one the
+  // GPU hasn't finished yet
+  bool found{false};
+  const std::size_t count = this->dataPtr->timerQueries.size();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const std::size_t index = (this->dataPtr->timerNext + i) % count;
+    if (!this->dataPtr->timerPending[index])
+      continue;
+
+    const GLuint query = this->dataPtr->timerQueries[index];
+    GLuint available = 0;
+    glExtraFuncs->glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE,
+        &available);
+    if (!available)
+      break;
+
+    // In nanoseconds, 32 bits are enough for a few seconds
+    GLuint elapsed = 0;
+    glExtraFuncs->glGetQueryObjectuiv(query, GL_QUERY_RESULT, &elapsed);
+    this->dataPtr->timerPending[index] = false;
+    _seconds = static_cast<double>(elapsed) * 1e-9;
+    found = true;
+  }
+  return found;
+}
+
 /////////////////////////////////////////////////
 void RenderThreadRhiOpenGL::ShutDown()
 {
@@ -201,6 +461,13 @@ void RenderThreadRhiOpenGL::ShutDown()
 
   if (this->dataPtr->context)
   {
+    if (this->dataPtr->surface)
+    {
+      this->dataPtr->context->makeCurrent(this->dataPtr->surface);
+      this->dataPtr->DestroySwapBuffers();
+      this->dataPtr->DestroyTimerQueries();
+    }
+
     this->dataPtr->context->doneCurrent();
     delete this->dataPtr->context;
     this->dataPtr->context = nullptr;
@@ -263,10 +530,22 @@ void TextureNodeRhiOpenGL::PrepareNode()
   this->dataPtr->textureId = 0;
   this->dataPtr->mutex.unlock();
 
-  if (this->dataPtr->newTextureId != 0)
+  if (this->dataPtr->newTextureId == 0)
+    return;
+
+  // The camera keeps rendering into the same texture until it's resized, so
+  // keep sampling it through the same Qt texture instead of wrapping it
+  // again every frame.
+  if (this->dataPtr->newTextureId == this->dataPtr->currentTextureId &&
+      this->dataPtr->newSize == this->dataPtr->currentSize)
   {
-    this->dataPtr->CreateTexture(
-      &this->dataPtr->newTextureId, this->dataPtr->newSize);
+    this->dataPtr->newTextureId = 0;
+    return;
   }
+
+  this->dataPtr->CreateTexture(
+    &this->dataPtr->newTextureId, this->dataPtr->newSize);
+  this->dataPtr->currentTextureId = this->dataPtr->newTextureId;
+  this->dataPtr->currentSize = this->dataPtr->newSize;
 }
 }  // namespace gz::gui::plugins
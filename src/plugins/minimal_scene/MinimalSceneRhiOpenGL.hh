@@ -92,6 +92,26 @@ namespace gz::gui::plugins
     // Documentation inherited
     public: virtual void ShutDown() override;
 
+    // Documentation inherited
+    public: virtual bool SupportsSwapBuffers() const override;
+
+    // Documentation inherited
+    public: virtual void *CopyToSwapBuffer(unsigned int _index,
+        const QSize &_size) override;
+
+    // Documentation inherited
+    public: virtual bool ZeroCopy(rendering::CameraPtr &_camera) const
+        override;
+
+    // Documentation inherited
+    public: virtual void BeginGpuTimer() override;
+
+    // Documentation inherited
+    public: virtual void EndGpuTimer() override;
+
+    // Documentation inherited
+    public: virtual bool GpuTime(double &_seconds) override;
+
     /// \internal Prevent copy and assignment
     private: RenderThreadRhiOpenGL(
         const RenderThreadRhiOpenGL &_other) = delete;
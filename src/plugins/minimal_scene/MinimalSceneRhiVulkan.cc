@@ -57,6 +57,10 @@ class TextureNodeRhiVulkanPrivate
   public: std::weak_ptr<rendering::Camera> lastCamera;
   public: QSize size {0, 0};
   public: QSize newSize {0, 0};
+
+  /// \brief Image and size currently wrapped by texture
+  public: VkImage currentTextureId = 0;
+  public: QSize currentSize {0, 0};
   public: QMutex mutex;
   public: QSGTexture *texture = nullptr;
   public: QQuickWindow *window = nullptr;
@@ -171,6 +175,15 @@ QSize RenderThreadRhiVulkan::TextureSize() const
   return this->dataPtr->renderer->textureSize;
 }
 
+/////////////////////////////////////////////////
+bool RenderThreadRhiVulkan::ZeroCopy(rendering::CameraPtr &) const //NOLINT
+{
+  // Qt samples the image the camera renders into. Both share the same
+  // device and queue, so the barrier recorded by PrepareForExternalSampling
+  // is all the synchronization needed.
+  return true;
+}
+
 /////////////////////////////////////////////////
 void RenderThreadRhiVulkan::ShutDown()
 {
@@ -203,10 +216,12 @@ TextureNodeRhiVulkan::TextureNodeRhiVulkan(QQuickWindow *_window,
   _camera->RenderTextureMetalId(&this->dataPtr->textureId);
   this->dataPtr->lastCamera = _camera;
 
-  this->dataPtr->CreateTexture(
-    &this->dataPtr->textureId,
+  this->dataPtr->currentTextureId = this->dataPtr->textureId;
+  this->dataPtr->currentSize =
     QSize(static_cast<int>(_camera->ImageWidth()),
-          static_cast<int>(_camera->ImageHeight())));
+          static_cast<int>(_camera->ImageHeight()));
+  this->dataPtr->CreateTexture(
+    &this->dataPtr->textureId, this->dataPtr->currentSize);
 }
 
 /////////////////////////////////////////////////
@@ -246,11 +261,23 @@ void TextureNodeRhiVulkan::PrepareNode()
   auto lastCamera = this->dataPtr->lastCamera.lock();
   lastCamera->PrepareForExternalSampling();
 
-  if (this->dataPtr->newTextureId != nullptr)
+  if (this->dataPtr->newTextureId == nullptr)
+    return;
+
+  // The camera keeps rendering into the same image until it's resized, so
+  // keep sampling it through the same texture. Wrapping it again would
+  // recreate the Qt texture and its resource bindings every frame.
+  if (this->dataPtr->newTextureId == this->dataPtr->currentTextureId &&
+      this->dataPtr->newSize == this->dataPtr->currentSize)
   {
-    this->dataPtr->CreateTexture(
-      &this->dataPtr->newTextureId, this->dataPtr->newSize);
+    this->dataPtr->newTextureId = nullptr;
+    return;
   }
+
+  this->dataPtr->CreateTexture(
+    &this->dataPtr->newTextureId, this->dataPtr->newSize);
+  this->dataPtr->currentTextureId = this->dataPtr->newTextureId;
+  this->dataPtr->currentSize = this->dataPtr->newSize;
 }
 }  // namespace gz::gui::plugins
 #endif  // GZ_GUI_HAVE_VULKAN
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "QualityPresets.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+const std::vector<QualityPreset> &QualityPresets()
+{
+  static const std::vector<QualityPreset> presets{
+    {"low", 1024u, 1u, false},
+    {"medium", 2048u, 2u, true},
+    {"high", 4096u, 4u, true},
+    {"ultra", 8192u, 8u, true},
+  };
+  return presets;
+}
+
+/////////////////////////////////////////////////
+int QualityPresetIndex(const std::string &_name)
+{
+  const auto &presets = QualityPresets();
+  for (std::size_t i = 0; i < presets.size(); ++i)
+  {
+    if (presets[i].name == _name)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+/////////////////////////////////////////////////
+QualityGovernor::QualityGovernor(double _targetFps, double _sustain)
+  : budget(_targetFps > 0.0 ? 1.0 / _targetFps : 0.0),
+    sustain(_sustain)
+{
+}
+
+/////////////////////////////////////////////////
+bool QualityGovernor::Add(double _frameTime)
+{
+  if (this->budget <= 0.0)
+    return false;
+
+  this->average = this->average < 0.0 ? _frameTime :
+      0.9 * this->average + 0.1 * _frameTime;
+  if (this->average <= this->budget)
+  {
+    this->over = 0.0;
+    return false;
+  }
+
+  // Counted in rendered time rather than frames, so it takes about as long
+  // to react on fast and slow machines
+  this->over += _frameTime;
+  if (this->over < this->sustain)
+    return false;
+
+  this->Reset();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void QualityGovernor::Reset()
+{
+  this->average = -1.0;
+  this->over = 0.0;
+}
+}  // namespace gz::gui::plugins
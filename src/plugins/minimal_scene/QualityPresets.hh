@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_QUALITYPRESETS_HH_
+#define GZ_GUI_PLUGINS_QUALITYPRESETS_HH_
+
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#  define QualityPresets_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(MinimalScene_EXPORTS))
+#    define QualityPresets_EXPORTS_API __declspec(dllexport)
+#  else
+#    define QualityPresets_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Lighting settings picked together, from the cheapest to the
+  /// best looking, see the \<quality\> config of MinimalScene
+  struct QualityPresets_EXPORTS_API QualityPreset
+  {
+    /// \brief Name, such as "medium"
+    std::string name;
+
+    /// \brief Size of the directional light shadow map, shared by all its
+    /// cascades
+    unsigned int shadowTextureSize{2048u};
+
+    /// \brief Most lights casting shadows at once, directional lights
+    /// first. Other lights keep lighting the scene without shadows.
+    unsigned int maxShadowLights{0u};
+
+    /// \brief False to hide the sky even if it's enabled
+    bool sky{true};
+  };
+
+  /// \brief Get all presets, from the cheapest to the best looking
+  /// \return "low", "medium", "high" and "ultra"
+  QualityPresets_EXPORTS_API
+  const std::vector<QualityPreset> &QualityPresets();
+
+  /// \brief Find a preset by name
+  /// \param[in] _name Name, such as "high"
+  /// \return Index in QualityPresets, -1 if there's no such preset
+  QualityPresets_EXPORTS_API int QualityPresetIndex(const std::string &_name);
+
+  /// \brief Decides when frames have been over budget for long enough to
+  /// lower the quality. A single slow frame, such as while loading a model,
+  /// doesn't count, only a sustained slowdown does.
+  class QualityPresets_EXPORTS_API QualityGovernor
+  {
+    /// \brief Constructor
+    /// \param[in] _targetFps Frame rate to keep
+    /// \param[in] _sustain Seconds frames must stay over budget
+    public: explicit QualityGovernor(double _targetFps = 30.0,
+        double _sustain = 2.0);
+
+    /// \brief Add the time a frame took to render
+    /// \param[in] _frameTime Seconds
+    /// \return True if the quality should be lowered. The governor then
+    /// starts over, so the lower quality gets time to take effect.
+    public: bool Add(double _frameTime);
+
+    /// \brief Start over, such as after the quality was changed by hand
+    public: void Reset();
+
+    /// \brief Frame time budget, in seconds
+    private: double budget;
+
+    /// \brief Seconds frames must stay over budget
+    private: double sustain;
+
+    /// \brief Moving average of the frame time, negative until the first
+    /// frame
+    private: double average{-1.0};
+
+    /// \brief Seconds of frames rendered since the average went over
+    /// budget
+    private: double over{0.0};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_QUALITYPRESETS_HH_
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "QualityPresets.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(QualityPresetsTest, Presets)
+{
+  const auto &presets = QualityPresets();
+  ASSERT_EQ(4u, presets.size());
+  EXPECT_EQ(0, QualityPresetIndex("low"));
+  EXPECT_EQ(3, QualityPresetIndex("ultra"));
+  EXPECT_EQ(-1, QualityPresetIndex("extreme"));
+  EXPECT_EQ(-1, QualityPresetIndex(""));
+
+  // Each preset costs more than the previous one
+  for (std::size_t i = 1; i < presets.size(); ++i)
+  {
+    EXPECT_GT(presets[i].shadowTextureSize, presets[i - 1].shadowTextureSize);
+    EXPECT_GE(presets[i].maxShadowLights, presets[i - 1].maxShadowLights);
+  }
+  EXPECT_FALSE(presets[0].sky);
+}
+
+/////////////////////////////////////////////////
+TEST(QualityPresetsTest, GovernorSustained)
+{
+  // 10 Hz budget, so 0.1 s per frame, and 1 s of slow frames to react
+  QualityGovernor governor(10.0, 1.0);
+
+  // Fast frames never downgrade
+  for (int i = 0; i < 100; ++i)
+    EXPECT_FALSE(governor.Add(0.05));
+
+  // A single slow frame doesn't either
+  EXPECT_FALSE(governor.Add(0.5));
+  EXPECT_FALSE(governor.Add(0.05));
+
+  // Sustained slow frames do, once per second of them
+  int downgrades{0};
+  for (int i = 0; i < 7; ++i)
+  {
+    if (governor.Add(0.2))
+      ++downgrades;
+  }
+  EXPECT_EQ(1, downgrades);
+}
+
+/////////////////////////////////////////////////
+TEST(QualityPresetsTest, GovernorDisabled)
+{
+  QualityGovernor governor(0.0);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_FALSE(governor.Add(1.0));
+}
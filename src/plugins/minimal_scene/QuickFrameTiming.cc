@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "gz/gui/ProfileZone.hh"
+
+#include "QuickFrameTiming.hh"
+
+namespace
+{
+/// \brief Phase of the frame in progress on the render thread
+enum Phase
+{
+  /// \brief Synchronizing
+  kSyncPhase,
+
+  /// \brief Rendering
+  kRenderPhase,
+
+  /// \brief Swapping buffers
+  kSwapPhase,
+
+  /// \brief No frame in progress
+  kIdlePhase
+};
+
+/// \brief Profiler sample name of each phase but kIdlePhase
+const std::array<const char *, kIdlePhase> kPhaseSamples{
+    "QQuickWindow sync", "QQuickWindow render", "QQuickWindow swap"};
+}
+
+namespace gz::gui::plugins
+{
+class QuickFrameTiming::Implementation
+{
+  /// \brief Move on to a phase, and to its profiler sample. Must be called
+  /// with `mutex` locked.
+  /// \param[in] _phase New phase
+  /// \param[in] _time Time the phase starts
+  /// \return Time spent in the previous phase
+  public: Clock::duration Enter(Phase _phase, Clock::time_point _time);
+
+  /// \brief Protects all members
+  public: std::mutex mutex;
+
+  /// \brief Phase of the frame in progress
+  public: Phase phase{kIdlePhase};
+
+  /// \brief Start of the current phase
+  public: Clock::time_point phaseStart;
+
+  /// \brief Profiler sample of the current phase
+  public: std::optional<ProfileZone> zone;
+
+  /// \brief Cached hashes of the sample names
+  public: std::array<uint32_t, kIdlePhase> hashes{};
+
+  /// \brief Last `afterAnimating` not followed by a sync yet
+  public: std::optional<Clock::time_point> animated;
+
+  /// \brief Time spent in each phase of the frame in progress
+  public: Averages current;
+
+  /// \brief Whether the frame in progress was polished
+  public: bool polished{false};
+
+  /// \brief Sums of the frames swapped since the last Take
+  public: Averages sums;
+
+  /// \brief Frames polished since the last Take
+  public: unsigned int polishedFrames{0};
+};
+
+/////////////////////////////////////////////////
+QuickFrameTiming::Clock::duration QuickFrameTiming::Implementation::Enter(
+    Phase _phase, Clock::time_point _time)
+{
+  const auto elapsed = _time - this->phaseStart;
+  this->phase = _phase;
+  this->phaseStart = _time;
+
+  // Ended before the next one begins, on the same thread
+  this->zone.reset();
+  if (_phase != kIdlePhase)
+    this->zone.emplace(kPhaseSamples[_phase], &this->hashes[_phase]);
+  return elapsed;
+}
+
+/////////////////////////////////////////////////
+QuickFrameTiming::QuickFrameTiming()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+QuickFrameTiming::~QuickFrameTiming() = default;
+
+/////////////////////////////////////////////////
+void QuickFrameTiming::Animated(Clock::time_point _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->animated = _time;
+}
+
+/////////////////////////////////////////////////
+void QuickFrameTiming::BeginSync(Clock::time_point _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &d = *this->dataPtr;
+
+  // A frame which wasn't swapped is dropped
+  d.current = Averages();
+  d.polished = d.animated.has_value();
+  if (d.polished)
+    d.current.polish = _time - *d.animated;
+  d.animated.reset();
+  d.Enter(kSyncPhase, _time);
+}
+
+/////////////////////////////////////////////////
+void QuickFrameTiming::EndSync(Clock::time_point _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->phase != kSyncPhase)
+    return;
+  this->dataPtr->current.sync = this->dataPtr->Enter(kRenderPhase, _time);
+}
+
+/////////////////////////////////////////////////
+void QuickFrameTiming::EndRender(Clock::time_point _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->phase != kRenderPhase)
+    return;
+  this->dataPtr->current.render = this->dataPtr->Enter(kSwapPhase, _time);
+}
+
+/////////////////////////////////////////////////
+void QuickFrameTiming::Swapped(Clock::time_point _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &d = *this->dataPtr;
+  if (d.phase != kSwapPhase)
+  {
+    d.Enter(kIdlePhase, _time);
+    return;
+  }
+
+  auto &current = d.current;
+  current.swap = d.Enter(kIdlePhase, _time);
+  current.frame = current.sync + current.render + current.swap;
+
+  auto &sums = d.sums;
+  sums.polish += current.polish;
+  sums.sync += current.sync;
+  sums.render += current.render;
+  sums.swap += current.swap;
+  sums.frame += current.frame;
+  sums.maxFrame = std::max(sums.maxFrame, current.frame);
+  ++sums.frames;
+  if (d.polished)
+    ++d.polishedFrames;
+}
+
+/////////////////////////////////////////////////
+QuickFrameTiming::Averages QuickFrameTiming::Take()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &d = *this->dataPtr;
+  Averages averages;
+  if (d.sums.frames > 0u)
+  {
+    const auto frames = d.sums.frames;
+    averages.sync = d.sums.sync / frames;
+    averages.render = d.sums.render / frames;
+    averages.swap = d.sums.swap / frames;
+    averages.frame = d.sums.frame / frames;
+    averages.maxFrame = d.sums.maxFrame;
+    averages.frames = frames;
+    if (d.polishedFrames > 0u)
+      averages.polish = d.sums.polish / d.polishedFrames;
+  }
+  d.sums = Averages();
+  d.polishedFrames = 0u;
+  return averages;
+}
+}  // namespace gz::gui::plugins
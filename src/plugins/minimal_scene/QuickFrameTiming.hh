@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_QUICKFRAMETIMING_HH_
+#define GZ_GUI_PLUGINS_QUICKFRAMETIMING_HH_
+
+#include <chrono>
+
+#include <gz/utils/ImplPtr.hh>
+
+#ifndef _WIN32
+#  define QuickFrameTiming_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(MinimalScene_EXPORTS))
+#    define QuickFrameTiming_EXPORTS_API __declspec(dllexport)
+#  else
+#    define QuickFrameTiming_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Times the phases of Qt Quick frames, from the QQuickWindow
+  /// signals, so they can be reported along with the GzRenderer stages:
+  ///
+  /// * polish: from `afterAnimating` on the GUI thread, once animations
+  ///   advanced, to `beforeSynchronizing`, which covers polishing items and
+  ///   the bindings it triggers
+  /// * sync: `beforeSynchronizing` to `afterSynchronizing`, while the GUI
+  ///   thread is blocked and items update their nodes
+  /// * render: `afterSynchronizing` to `afterRendering`, which includes the
+  ///   `beforeRendering` slots, such as TextureNode::PrepareNode
+  /// * swap: `afterRendering` to `frameSwapped`
+  /// * frame: `beforeSynchronizing` to `frameSwapped`
+  ///
+  /// The render thread phases are also profiler samples, so they show on
+  /// the same timeline as the GzRenderer stages.
+  ///
+  /// The GUI thread only calls Animated, the scene graph's render thread
+  /// calls the others, and Take may be called from any thread.
+  class QuickFrameTiming_EXPORTS_API QuickFrameTiming
+  {
+    /// \brief Clock used for all times
+    public: using Clock = std::chrono::steady_clock;
+
+    /// \brief Average time of each phase
+    public: struct Averages
+    {
+      /// \brief Polishing items, 0 if `afterAnimating` wasn't emitted
+      Clock::duration polish{0};
+
+      /// \brief Synchronizing the scene graph
+      Clock::duration sync{0};
+
+      /// \brief Rendering the scene graph
+      Clock::duration render{0};
+
+      /// \brief Swapping buffers
+      Clock::duration swap{0};
+
+      /// \brief Whole frame on the render thread
+      Clock::duration frame{0};
+
+      /// \brief Longest frame
+      Clock::duration maxFrame{0};
+
+      /// \brief Frames swapped
+      unsigned int frames{0};
+    };
+
+    /// \brief Constructor
+    public: QuickFrameTiming();
+
+    /// \brief Destructor
+    public: ~QuickFrameTiming();
+
+    /// \brief Animations advanced, `afterAnimating`
+    /// \param[in] _time Time of the signal
+    public: void Animated(Clock::time_point _time = Clock::now());
+
+    /// \brief Synchronization starts, `beforeSynchronizing`
+    /// \param[in] _time Time of the signal
+    public: void BeginSync(Clock::time_point _time = Clock::now());
+
+    /// \brief Synchronization is done, `afterSynchronizing`
+    /// \param[in] _time Time of the signal
+    public: void EndSync(Clock::time_point _time = Clock::now());
+
+    /// \brief Rendering is done, `afterRendering`
+    /// \param[in] _time Time of the signal
+    public: void EndRender(Clock::time_point _time = Clock::now());
+
+    /// \brief Buffers were swapped, `frameSwapped`
+    /// \param[in] _time Time of the signal
+    public: void Swapped(Clock::time_point _time = Clock::now());
+
+    /// \brief Get the averages of the frames swapped since the last call,
+    /// and start over
+    /// \return Averages, with no frames if none were swapped
+    public: Averages Take();
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "QuickFrameTiming.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(QuickFrameTimingTest, Phases)
+{
+  QuickFrameTiming timing;
+  EXPECT_EQ(0u, timing.Take().frames);
+
+  // Polished, 2 ms polish, 1 ms sync, 5 ms render, 2 ms swap
+  const QuickFrameTiming::Clock::time_point t0;
+  timing.Animated(t0);
+  timing.BeginSync(t0 + 2ms);
+  timing.EndSync(t0 + 3ms);
+  timing.EndRender(t0 + 8ms);
+  timing.Swapped(t0 + 10ms);
+
+  // Not polished, 3 ms sync, 9 ms render, 4 ms swap
+  const auto t1 = t0 + 20ms;
+  timing.BeginSync(t1);
+  timing.EndSync(t1 + 3ms);
+  timing.EndRender(t1 + 12ms);
+  timing.Swapped(t1 + 16ms);
+
+  auto averages = timing.Take();
+  EXPECT_EQ(2u, averages.frames);
+  EXPECT_EQ(2ms, averages.polish);
+  EXPECT_EQ(2ms, averages.sync);
+  EXPECT_EQ(7ms, averages.render);
+  EXPECT_EQ(3ms, averages.swap);
+  EXPECT_EQ(12ms, averages.frame);
+  EXPECT_EQ(16ms, averages.maxFrame);
+
+  // Started over
+  averages = timing.Take();
+  EXPECT_EQ(0u, averages.frames);
+  EXPECT_EQ(0ms, averages.frame);
+  EXPECT_EQ(0ms, averages.maxFrame);
+}
+
+/////////////////////////////////////////////////
+TEST(QuickFrameTimingTest, Incomplete)
+{
+  QuickFrameTiming timing;
+  const QuickFrameTiming::Clock::time_point t0;
+
+  // Signals out of order are ignored
+  timing.EndSync(t0);
+  timing.EndRender(t0 + 1ms);
+  timing.Swapped(t0 + 2ms);
+  EXPECT_EQ(0u, timing.Take().frames);
+
+  // A frame synchronized but not rendered is dropped
+  timing.BeginSync(t0 + 10ms);
+  timing.EndSync(t0 + 11ms);
+  timing.BeginSync(t0 + 20ms);
+  timing.EndSync(t0 + 21ms);
+  timing.EndRender(t0 + 22ms);
+  timing.Swapped(t0 + 23ms);
+  const auto averages = timing.Take();
+  EXPECT_EQ(1u, averages.frames);
+  EXPECT_EQ(0ms, averages.polish);
+  EXPECT_EQ(3ms, averages.frame);
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "RenderWarmup.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Mesh.hh>
+#include <gz/rendering/MeshDescriptor.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+bool WarmupEntry::operator<(const WarmupEntry &_other) const
+{
+  return std::tie(this->mesh, this->texture, this->normalMap,
+      this->transparent) < std::tie(_other.mesh, _other.texture,
+      _other.normalMap, _other.transparent);
+}
+
+/////////////////////////////////////////////////
+bool WarmupEntry::operator==(const WarmupEntry &_other) const
+{
+  return !(*this < _other) && !(_other < *this);
+}
+
+/////////////////////////////////////////////////
+std::vector<WarmupEntry> LoadWarmup(const std::string &_path)
+{
+  std::vector<WarmupEntry> entries;
+  std::ifstream file(_path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    // One entry per line: mesh, texture, normal map and transparency,
+    // separated by tabs
+    std::istringstream fields(line);
+    WarmupEntry entry;
+    std::string transparent;
+    if (!std::getline(fields, entry.mesh, '\t') || entry.mesh.empty() ||
+        !std::getline(fields, entry.texture, '\t') ||
+        !std::getline(fields, entry.normalMap, '\t') ||
+        !std::getline(fields, transparent))
+    {
+      continue;
+    }
+    entry.transparent = transparent == "1";
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+/////////////////////////////////////////////////
+bool SaveWarmup(const std::string &_path,
+    const std::vector<WarmupEntry> &_entries)
+{
+  const auto dir = common::parentPath(_path);
+  if (!dir.empty() && !common::isDirectory(dir) &&
+      !common::createDirectories(dir))
+  {
+    return false;
+  }
+
+  std::ofstream file(_path, std::ios::trunc);
+  for (const auto &entry : _entries)
+  {
+    file << entry.mesh << '\t' << entry.texture << '\t' << entry.normalMap
+         << '\t' << (entry.transparent ? "1" : "0") << '\n';
+  }
+  return static_cast<bool>(file);
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the entries of a visual and its children
+/// \param[in] _visual Visual
+/// \param[in] _max Most entries to collect
+/// \param[in, out] _entries Entries collected so far
+static void collect(const rendering::VisualPtr &_visual, std::size_t _max,
+    std::set<WarmupEntry> &_entries)
+{
+  const auto add = [&](const std::string &_mesh,
+      const rendering::MaterialPtr &_material)
+  {
+    if (_mesh.empty() || _entries.size() >= _max)
+      return;
+    WarmupEntry entry;
+    entry.mesh = _mesh;
+    if (_material)
+    {
+      entry.texture = _material->Texture();
+      entry.normalMap = _material->NormalMap();
+      entry.transparent = _material->Transparency() > 0.0;
+    }
+    _entries.insert(entry);
+  };
+
+  for (unsigned int i = 0; i < _visual->GeometryCount(); ++i)
+  {
+    auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(
+        _visual->GeometryByIndex(i));
+    if (nullptr == mesh)
+      continue;
+
+    const auto &descriptor = mesh->Descriptor();
+    const std::string name = descriptor.mesh ? descriptor.mesh->Name() :
+        descriptor.meshName;
+    if (mesh->SubMeshCount() == 0)
+      add(name, mesh->Material());
+    for (unsigned int s = 0; s < mesh->SubMeshCount(); ++s)
+      add(name, mesh->SubMeshByIndex(s)->Material());
+  }
+
+  for (unsigned int i = 0; i < _visual->ChildCount(); ++i)
+  {
+    auto child = std::dynamic_pointer_cast<rendering::Visual>(
+        _visual->ChildByIndex(i));
+    if (child)
+      collect(child, _max, _entries);
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<WarmupEntry> CollectWarmup(const rendering::ScenePtr &_scene,
+    std::size_t _max)
+{
+  std::set<WarmupEntry> entries;
+  if (_scene)
+    collect(_scene->RootVisual(), _max, entries);
+  return {entries.begin(), entries.end()};
+}
+
+/////////////////////////////////////////////////
+std::size_t RunWarmup(const rendering::ScenePtr &_scene,
+    const std::vector<WarmupEntry> &_entries)
+{
+  if (nullptr == _scene || _entries.empty())
+    return 0;
+
+  // Far from the scene, so only the warm-up visuals are in view
+  auto root = _scene->CreateVisual();
+  root->SetWorldPosition(0, 0, -1e5);
+  _scene->RootVisual()->AddChild(root);
+
+  auto camera = _scene->CreateCamera();
+  camera->SetImageWidth(64);
+  camera->SetImageHeight(64);
+  camera->SetNearClipPlane(0.01);
+  camera->SetFarClipPlane(100.0);
+  root->AddChild(camera);
+  camera->SetLocalPose(math::Pose3d(-10, 0, 0, 0, 0, 0));
+
+  std::vector<rendering::MaterialPtr> materials;
+  std::size_t count{0};
+  for (const auto &entry : _entries)
+  {
+    rendering::MeshDescriptor descriptor;
+    descriptor.meshName = entry.mesh;
+    descriptor.mesh = common::MeshManager::Instance()->Load(entry.mesh);
+    if (nullptr == descriptor.mesh)
+      continue;
+
+    auto mesh = _scene->CreateMesh(descriptor);
+    if (nullptr == mesh)
+      continue;
+
+    auto material = _scene->CreateMaterial();
+    if (!entry.texture.empty())
+      material->SetTexture(entry.texture);
+    if (!entry.normalMap.empty())
+      material->SetNormalMap(entry.normalMap);
+    material->SetTransparency(entry.transparent ? 0.5 : 0.0);
+    materials.push_back(material);
+
+    // All in view at once, one frame builds them all
+    auto visual = _scene->CreateVisual();
+    visual->AddGeometry(mesh);
+    visual->SetMaterial(material, false);
+    root->AddChild(visual);
+    ++count;
+  }
+
+  camera->Update();
+
+  root->RemoveChild(camera);
+  _scene->DestroySensor(camera);
+  _scene->DestroyVisual(root, true);
+  for (auto &material : materials)
+    _scene->DestroyMaterial(material);
+
+  gzdbg << "Warmed up " << count << " of " << _entries.size()
+        << " meshes and materials" << std::endl;
+  return count;
+}
+}  // namespace gz::gui::plugins
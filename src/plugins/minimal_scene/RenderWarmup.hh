@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_RENDERWARMUP_HH_
+#define GZ_GUI_PLUGINS_RENDERWARMUP_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gz/rendering/RenderTypes.hh>
+
+#ifndef _WIN32
+#  define RenderWarmup_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(MinimalScene_EXPORTS))
+#    define RenderWarmup_EXPORTS_API __declspec(dllexport)
+#  else
+#    define RenderWarmup_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief A mesh and the features of its material, which together decide
+  /// the shaders and pipelines the render engine builds for it
+  struct RenderWarmup_EXPORTS_API WarmupEntry
+  {
+    /// \brief Mesh name, as known to the mesh manager
+    std::string mesh;
+
+    /// \brief Albedo map, empty if none
+    std::string texture;
+
+    /// \brief Normal map, empty if none
+    std::string normalMap;
+
+    /// \brief True if the material is transparent
+    bool transparent{false};
+
+    /// \brief Order entries, to remove duplicates
+    /// \param[in] _other Other entry
+    /// \return True if this one goes first
+    bool operator<(const WarmupEntry &_other) const;
+
+    /// \brief Compare entries
+    /// \param[in] _other Other entry
+    /// \return True if they're the same
+    bool operator==(const WarmupEntry &_other) const;
+  };
+
+  /// \brief Read the entries a previous session saved
+  /// \param[in] _path File path
+  /// \return Entries, empty if the file doesn't exist
+  RenderWarmup_EXPORTS_API std::vector<WarmupEntry> LoadWarmup(
+      const std::string &_path);
+
+  /// \brief Save entries for the next session
+  /// \param[in] _path File path, its directory is created if needed
+  /// \param[in] _entries Entries
+  /// \return True if saved
+  RenderWarmup_EXPORTS_API bool SaveWarmup(const std::string &_path,
+      const std::vector<WarmupEntry> &_entries);
+
+  /// \brief Collect the mesh and material combinations of a scene. Call
+  /// from the render thread.
+  /// \param[in] _scene Scene
+  /// \param[in] _max Most entries to collect
+  /// \return Unique entries
+  RenderWarmup_EXPORTS_API std::vector<WarmupEntry> CollectWarmup(
+      const rendering::ScenePtr &_scene, std::size_t _max);
+
+  /// \brief Render each entry once with a small offscreen camera, so the
+  /// render engine builds their shaders and pipelines before they're first
+  /// seen. Call from the render thread, before the first frame.
+  /// \param[in] _scene Scene
+  /// \param[in] _entries Entries
+  /// \return Number of entries rendered, ones whose mesh failed to load
+  /// are skipped
+  RenderWarmup_EXPORTS_API std::size_t RunWarmup(
+      const rendering::ScenePtr &_scene,
+      const std::vector<WarmupEntry> &_entries);
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_RENDERWARMUP_HH_
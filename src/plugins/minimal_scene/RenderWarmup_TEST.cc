@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "RenderWarmup.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(RenderWarmupTest, SaveLoad)
+{
+  const auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH), "test",
+      "render_warmup", "warmup_scene");
+  common::removeAll(common::parentPath(path));
+
+  // Missing file
+  EXPECT_TRUE(LoadWarmup(path).empty());
+
+  std::vector<WarmupEntry> entries(2);
+  entries[0].mesh = "unit_box";
+  entries[1].mesh = "/models/robot.dae";
+  entries[1].texture = "/models/robot.png";
+  entries[1].normalMap = "/models/robot_normal.png";
+  entries[1].transparent = true;
+
+  // The directory is created
+  ASSERT_TRUE(SaveWarmup(path, entries));
+  EXPECT_EQ(entries, LoadWarmup(path));
+
+  // Saving again replaces the list
+  entries.pop_back();
+  ASSERT_TRUE(SaveWarmup(path, entries));
+  EXPECT_EQ(entries, LoadWarmup(path));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderWarmupTest, Malformed)
+{
+  const auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH), "test",
+      "render_warmup", "malformed");
+  ASSERT_TRUE(SaveWarmup(path, {}));
+  {
+    std::ofstream file(path);
+    file << "no tabs\n\t\t\t0\nbox\t\t\t1\n";
+  }
+
+  // Lines without all fields or without a mesh are skipped
+  auto entries = LoadWarmup(path);
+  ASSERT_EQ(1u, entries.size());
+  EXPECT_EQ("box", entries[0].mesh);
+  EXPECT_TRUE(entries[0].transparent);
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include <QOpenGLShaderProgram>
+#include <QVector2D>
+
+#include "SharpenMaterial.hh"
+
+namespace
+{
+/// \brief Draws a SharpenMaterial, subtracting the average of the four
+/// neighbouring texels from each one
+class SharpenShader : public QSGMaterialShader
+{
+  // Documentation inherited
+  protected: const char *vertexShader() const override
+  {
+    return
+      "uniform highp mat4 qt_Matrix;\n"
+      "attribute highp vec4 qt_VertexPosition;\n"
+      "attribute highp vec2 qt_VertexTexCoord;\n"
+      "varying highp vec2 texCoord;\n"
+      "void main() {\n"
+      "  texCoord = qt_VertexTexCoord;\n"
+      "  gl_Position = qt_Matrix * qt_VertexPosition;\n"
+      "}\n";
+  }
+
+  // Documentation inherited
+  protected: const char *fragmentShader() const override
+  {
+    return
+      "uniform sampler2D qt_Texture;\n"
+      "uniform highp vec2 texelSize;\n"
+      "uniform mediump float strength;\n"
+      "varying highp vec2 texCoord;\n"
+      "void main() {\n"
+      "  mediump vec4 color = texture2D(qt_Texture, texCoord);\n"
+      "  mediump vec3 blur = 0.25 * (\n"
+      "      texture2D(qt_Texture, texCoord + vec2(texelSize.x, 0.0)).rgb +\n"
+      "      texture2D(qt_Texture, texCoord - vec2(texelSize.x, 0.0)).rgb +\n"
+      "      texture2D(qt_Texture, texCoord + vec2(0.0, texelSize.y)).rgb +\n"
+      "      texture2D(qt_Texture, texCoord - vec2(0.0, texelSize.y)).rgb);\n"
+      "  gl_FragColor = vec4(\n"
+      "      clamp(color.rgb + strength * (color.rgb - blur), 0.0, 1.0),\n"
+      "      color.a);\n"
+      "}\n";
+  }
+
+  // Documentation inherited
+  public: char const *const *attributeNames() const override
+  {
+    static const char *names[] =
+        {"qt_VertexPosition", "qt_VertexTexCoord", nullptr};
+    return names;
+  }
+
+  // Documentation inherited
+  public: void updateState(const RenderState &_state,
+      QSGMaterial *_newMaterial, QSGMaterial * /*_oldMaterial*/) override
+  {
+    if (_state.isMatrixDirty())
+      this->program()->setUniformValue(this->matrixId,
+          _state.combinedMatrix());
+
+    auto *material = static_cast<gz::gui::plugins::SharpenMaterial *>(
+        _newMaterial);
+    QSGTexture *texture = material->Texture();
+    if (nullptr == texture)
+      return;
+
+    // Sample between texels when upscaling
+    texture->setFiltering(QSGTexture::Linear);
+    texture->bind();
+
+    const QSize size = texture->textureSize();
+    this->program()->setUniformValue(this->texelSizeId,
+        QVector2D(1.0f / std::max(1, size.width()),
+                  1.0f / std::max(1, size.height())));
+    this->program()->setUniformValue(this->strengthId,
+        material->Strength());
+  }
+
+  // Documentation inherited
+  protected: void initialize() override
+  {
+    this->matrixId = this->program()->uniformLocation("qt_Matrix");
+    this->texelSizeId = this->program()->uniformLocation("texelSize");
+    this->strengthId = this->program()->uniformLocation("strength");
+  }
+
+  /// \brief Location of the transform uniform
+  private: int matrixId{-1};
+
+  /// \brief Location of the texel size uniform
+  private: int texelSizeId{-1};
+
+  /// \brief Location of the strength uniform
+  private: int strengthId{-1};
+};
+}
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+SharpenMaterial::SharpenMaterial() = default;
+
+/////////////////////////////////////////////////
+QSGMaterialType *SharpenMaterial::type() const
+{
+  static QSGMaterialType type;
+  return &type;
+}
+
+/////////////////////////////////////////////////
+QSGMaterialShader *SharpenMaterial::createShader() const
+{
+  return new SharpenShader;
+}
+
+/////////////////////////////////////////////////
+int SharpenMaterial::compare(const QSGMaterial *_other) const
+{
+  auto *other = static_cast<const SharpenMaterial *>(_other);
+  if (this->texture != other->texture)
+    return this->texture < other->texture ? -1 : 1;
+  if (this->strength != other->strength)
+    return this->strength < other->strength ? -1 : 1;
+  return 0;
+}
+
+/////////////////////////////////////////////////
+void SharpenMaterial::SetTexture(QSGTexture *_texture)
+{
+  this->texture = _texture;
+}
+
+/////////////////////////////////////////////////
+QSGTexture *SharpenMaterial::Texture() const
+{
+  return this->texture;
+}
+
+/////////////////////////////////////////////////
+void SharpenMaterial::SetStrength(float _strength)
+{
+  this->strength = std::clamp(_strength, 0.0f, 1.0f);
+}
+
+/////////////////////////////////////////////////
+float SharpenMaterial::Strength() const
+{
+  return this->strength;
+}
+}  // namespace gz::gui::plugins
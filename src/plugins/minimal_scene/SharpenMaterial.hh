@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_SHARPENMATERIAL_HH_
+#define GZ_GUI_PLUGINS_SHARPENMATERIAL_HH_
+
+#include <QSGMaterial>
+#include <QSGTexture>
+
+namespace gz::gui::plugins
+{
+  /// \brief Scene graph material which draws a texture through an unsharp
+  /// mask, to bring back some of the detail lost when a texture rendered
+  /// below the item's resolution is upscaled.
+  ///
+  /// Only supported by the OpenGL scene graph.
+  class SharpenMaterial : public QSGMaterial
+  {
+    /// \brief Constructor
+    public: SharpenMaterial();
+
+    // Documentation inherited
+    public: QSGMaterialType *type() const override;
+
+    // Documentation inherited
+    public: QSGMaterialShader *createShader() const override;
+
+    // Documentation inherited
+    public: int compare(const QSGMaterial *_other) const override;
+
+    /// \brief Set the texture to draw
+    /// \param[in] _texture Texture, not owned
+    public: void SetTexture(QSGTexture *_texture);
+
+    /// \brief Get the texture to draw
+    /// \return Texture, null until set
+    public: QSGTexture *Texture() const;
+
+    /// \brief Set how much the texture is sharpened
+    /// \param[in] _strength From 0, which draws the texture as is, to 1
+    public: void SetStrength(float _strength);
+
+    /// \brief Get how much the texture is sharpened
+    /// \return Strength between 0 and 1
+    public: float Strength() const;
+
+    /// \brief Texture to draw
+    private: QSGTexture *texture{nullptr};
+
+    /// \brief Sharpening strength
+    private: float strength{0.5f};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_SHARPENMATERIAL_HH_
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "TextureResizer.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+void TextureResizer::SetDelay(Clock::duration _delay)
+{
+  this->delay = std::max(Clock::duration::zero(), _delay);
+}
+
+/////////////////////////////////////////////////
+void TextureResizer::SetStep(int _step)
+{
+  this->step = std::max(1, _step);
+}
+
+/////////////////////////////////////////////////
+void TextureResizer::Request(const math::Vector2i &_size,
+    Clock::time_point _now, bool _immediate)
+{
+  const math::Vector2i size(std::max(1, _size.X()), std::max(1, _size.Y()));
+  this->immediate = this->immediate || _immediate;
+  if (this->pending && size == this->requested)
+    return;
+
+  this->requested = size;
+  this->requestTime = _now;
+  this->pending = true;
+}
+
+/////////////////////////////////////////////////
+std::optional<math::Vector2i> TextureResizer::Update(Clock::time_point _now)
+{
+  if (!this->pending)
+    return std::nullopt;
+
+  const bool first = this->size.X() == 0;
+  if (!first && !this->immediate && _now - this->requestTime < this->delay)
+    return std::nullopt;
+
+  this->pending = false;
+  this->immediate = false;
+  const auto rounded = this->RoundUp(this->requested);
+  if (rounded == this->size)
+    return std::nullopt;
+
+  this->size = rounded;
+  return this->size;
+}
+
+/////////////////////////////////////////////////
+bool TextureResizer::Pending() const
+{
+  return this->pending;
+}
+
+/////////////////////////////////////////////////
+const math::Vector2i &TextureResizer::Size() const
+{
+  return this->size;
+}
+
+/////////////////////////////////////////////////
+math::Vector2i TextureResizer::RoundUp(const math::Vector2i &_size) const
+{
+  auto roundUp = [this](int _value)
+  {
+    return (_value + this->step - 1) / this->step * this->step;
+  };
+  return math::Vector2i(roundUp(_size.X()), roundUp(_size.Y()));
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TEXTURERESIZER_HH_
+#define GZ_GUI_PLUGINS_TEXTURERESIZER_HH_
+
+#include <chrono>
+#include <optional>
+
+#include <gz/math/Vector2.hh>
+
+#ifndef _WIN32
+#  define TextureResizer_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(MinimalScene_EXPORTS))
+#    define TextureResizer_EXPORTS_API __declspec(dllexport)
+#  else
+#    define TextureResizer_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Decides when to resize a render texture. While the size keeps
+  /// changing, such as while a window is dragged or a dock animates, the
+  /// texture keeps its size and is scaled to fit, and it's only resized once
+  /// the size has been stable for a while. Sizes are rounded up to a
+  /// multiple of a step, so small changes don't rebuild the texture.
+  ///
+  /// Not thread safe.
+  class TextureResizer_EXPORTS_API TextureResizer
+  {
+    /// \brief Clock used for all times
+    public: using Clock = std::chrono::steady_clock;
+
+    /// \brief Set how long the size must be stable before resizing
+    /// \param[in] _delay Delay, zero to resize right away
+    public: void SetDelay(Clock::duration _delay);
+
+    /// \brief Set the step sizes are rounded up to
+    /// \param[in] _step Pixels, 1 to keep sizes as they are
+    public: void SetStep(int _step);
+
+    /// \brief Request a size
+    /// \param[in] _size Size in pixels, each at least 1
+    /// \param[in] _now Current time
+    /// \param[in] _immediate True to resize on the next Update, without
+    /// waiting for the size to be stable
+    public: void Request(const math::Vector2i &_size, Clock::time_point _now,
+        bool _immediate = false);
+
+    /// \brief Check whether the texture should be resized now. The first
+    /// size requested is always applied right away.
+    /// \param[in] _now Current time
+    /// \return New texture size, or nothing to keep the current one
+    public: std::optional<math::Vector2i> Update(Clock::time_point _now);
+
+    /// \brief Whether a requested size is waiting to be applied
+    /// \return True until Update applies or drops the last request
+    public: bool Pending() const;
+
+    /// \brief Get the current texture size
+    /// \return Size in pixels, zero until the first Update
+    public: const math::Vector2i &Size() const;
+
+    /// \brief Round a size up to a multiple of the step
+    /// \param[in] _size Size in pixels
+    /// \return Rounded size
+    private: math::Vector2i RoundUp(const math::Vector2i &_size) const;
+
+    /// \brief Time the size must be stable
+    private: Clock::duration delay{0};
+
+    /// \brief Sizes are rounded up to a multiple of this
+    private: int step{1};
+
+    /// \brief Current texture size
+    private: math::Vector2i size{0, 0};
+
+    /// \brief Last size requested
+    private: math::Vector2i requested{0, 0};
+
+    /// \brief When the requested size last changed
+    private: Clock::time_point requestTime;
+
+    /// \brief True if `requested` hasn't been applied yet
+    private: bool pending{false};
+
+    /// \brief True to apply `requested` without waiting
+    private: bool immediate{false};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_TEXTURERESIZER_HH_
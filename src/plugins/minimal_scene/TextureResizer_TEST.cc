@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+
+#include "TextureResizer.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(TextureResizerTest, Immediate)
+{
+  TextureResizer resizer;
+  const TextureResizer::Clock::time_point now{1s};
+  EXPECT_FALSE(resizer.Update(now).has_value());
+  EXPECT_EQ(math::Vector2i(0, 0), resizer.Size());
+
+  // Without a delay, sizes are applied right away
+  resizer.Request(math::Vector2i(800, 600), now);
+  EXPECT_TRUE(resizer.Pending());
+  EXPECT_EQ(math::Vector2i(800, 600), resizer.Update(now));
+  EXPECT_FALSE(resizer.Pending());
+  EXPECT_EQ(math::Vector2i(800, 600), resizer.Size());
+
+  // Same size
+  resizer.Request(math::Vector2i(800, 600), now);
+  EXPECT_FALSE(resizer.Update(now).has_value());
+
+  // Sizes are at least 1
+  resizer.Request(math::Vector2i(0, -5), now);
+  EXPECT_EQ(math::Vector2i(1, 1), resizer.Update(now));
+}
+
+/////////////////////////////////////////////////
+TEST(TextureResizerTest, Delay)
+{
+  TextureResizer resizer;
+  resizer.SetDelay(100ms);
+  TextureResizer::Clock::time_point now{1s};
+
+  // The first size is applied right away
+  resizer.Request(math::Vector2i(800, 600), now);
+  EXPECT_EQ(math::Vector2i(800, 600), resizer.Update(now));
+
+  // A drag keeps the old size
+  for (int i = 1; i <= 10; ++i)
+  {
+    now += 20ms;
+    resizer.Request(math::Vector2i(800 + i * 10, 600), now);
+    EXPECT_FALSE(resizer.Update(now).has_value());
+    EXPECT_TRUE(resizer.Pending());
+  }
+
+  // Until it's stable for long enough
+  now += 60ms;
+  resizer.Request(math::Vector2i(900, 600), now);
+  EXPECT_FALSE(resizer.Update(now).has_value());
+  now += 40ms;
+  EXPECT_EQ(math::Vector2i(900, 600), resizer.Update(now));
+  EXPECT_FALSE(resizer.Pending());
+
+  // Unless asked to resize right away
+  resizer.Request(math::Vector2i(450, 300), now, true);
+  EXPECT_EQ(math::Vector2i(450, 300), resizer.Update(now));
+
+  // Going back to the current size before the delay resizes nothing
+  resizer.Request(math::Vector2i(500, 300), now);
+  resizer.Request(math::Vector2i(450, 300), now + 10ms);
+  EXPECT_FALSE(resizer.Update(now + 200ms).has_value());
+  EXPECT_FALSE(resizer.Pending());
+}
+
+/////////////////////////////////////////////////
+TEST(TextureResizerTest, Step)
+{
+  TextureResizer resizer;
+  resizer.SetStep(64);
+  const TextureResizer::Clock::time_point now{1s};
+
+  resizer.Request(math::Vector2i(800, 600), now);
+  EXPECT_EQ(math::Vector2i(832, 640), resizer.Update(now));
+
+  // Within the same step
+  resizer.Request(math::Vector2i(830, 580), now);
+  EXPECT_FALSE(resizer.Update(now).has_value());
+  EXPECT_EQ(math::Vector2i(832, 640), resizer.Size());
+
+  // Shrinking past a step frees memory
+  resizer.Request(math::Vector2i(700, 576), now);
+  EXPECT_EQ(math::Vector2i(704, 576), resizer.Update(now));
+}
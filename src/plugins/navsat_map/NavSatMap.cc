@@ -18,16 +18,25 @@
 #include "NavSatMap.hh"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
+#include <gz/transport/SubscribeOptions.hh>
 
 #include "gz/gui/Application.hh"
+#include "gz/gui/LatestValue.hh"
+#include "gz/gui/TopicRegistry.hh"
 
 namespace gz::gui::plugins
 {
@@ -36,14 +45,40 @@ class NavSatMap::Implementation
   /// \brief List of topics publishing navSat messages.
   public: QStringList topicList;
 
-  /// \brief Holds data to set as the next navSat
+  /// \brief Latest message received
+  public: LatestValue<msgs::NavSat> latestMsg;
+
+  /// \brief Latest message processed, only used on the GUI thread
   public: msgs::NavSat navSatMsg;
 
   /// \brief Node for communication.
   public: transport::Node node;
 
-  /// \brief Mutex for accessing navSat data
-  public: std::recursive_mutex navSatMutex;
+  /// \brief Most messages per second to receive, 0 for all
+  public: double maxRate{0.0};
+
+  /// \brief Parameters of the map plugin, which configure its tile cache
+  public: QVariantMap mapParameters;
+
+  /// \brief Seconds ahead of the vehicle to prefetch tiles for, zero to
+  /// disable prefetching
+  public: double prefetchTime{0.0};
+
+  /// \brief A fix and when it was received
+  public: struct Fix
+  {
+    /// \brief Latitude in degrees
+    double latitude;
+
+    /// \brief Longitude in degrees
+    double longitude;
+
+    /// \brief When it was processed
+    std::chrono::steady_clock::time_point time;
+  };
+
+  /// \brief Previous fix, to estimate the velocity
+  public: std::optional<Fix> lastFix;
 };
 
 /////////////////////////////////////////////////
@@ -73,8 +108,26 @@ void NavSatMap::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto pickerElem = _pluginElem->FirstChildElement("topic_picker"))
       pickerElem->QueryBoolText(&topicPicker);
+
+    if (auto rateElem = _pluginElem->FirstChildElement("max_rate"))
+    {
+      double maxRate{0.0};
+      if (rateElem->QueryDoubleText(&maxRate) != tinyxml2::XML_SUCCESS ||
+          maxRate < 0)
+      {
+        gzerr << "Failed to parse <max_rate> value: " << rateElem->GetText()
+               << std::endl;
+      }
+      else
+      {
+        this->dataPtr->maxRate = maxRate;
+      }
+    }
   }
 
+  this->LoadCacheConfig(
+      _pluginElem ? _pluginElem->FirstChildElement("cache") : nullptr);
+
   if (topic.empty() && !topicPicker)
   {
     gzwarn << "Can't hide topic picker without a default topic." << std::endl;
@@ -92,23 +145,135 @@ void NavSatMap::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     this->OnRefresh();
 }
 
+/////////////////////////////////////////////////
+void NavSatMap::LoadCacheConfig(const tinyxml2::XMLElement *_cacheElem)
+{
+  std::string home;
+  common::env(GZ_HOMEDIR, home);
+  std::string directory =
+      common::joinPaths(home, ".gz", "gui", "navsat_map", "tiles");
+  std::string offlineDirectory;
+  double diskSize{50.0};
+  double memorySize{-1.0};
+  bool offline{false};
+
+  if (_cacheElem)
+  {
+    if (auto elem = _cacheElem->FirstChildElement("directory"))
+    {
+      if (nullptr != elem->GetText())
+        directory = elem->GetText();
+    }
+
+    if (auto elem = _cacheElem->FirstChildElement("offline_directory"))
+    {
+      if (nullptr != elem->GetText())
+        offlineDirectory = elem->GetText();
+    }
+
+    if (auto elem = _cacheElem->FirstChildElement("disk_size"))
+      elem->QueryDoubleText(&diskSize);
+
+    if (auto elem = _cacheElem->FirstChildElement("memory_size"))
+      elem->QueryDoubleText(&memorySize);
+
+    if (auto elem = _cacheElem->FirstChildElement("offline"))
+      elem->QueryBoolText(&offline);
+
+    if (auto elem = _cacheElem->FirstChildElement("prefetch_time"))
+      elem->QueryDoubleText(&this->dataPtr->prefetchTime);
+  }
+
+  if (offline && offlineDirectory.empty())
+  {
+    gzwarn << "Offline map without an <offline_directory>, only tiles "
+           << "already in [" << directory << "] will be shown" << std::endl;
+  }
+
+  // The map plugin's file tile cache keeps the most recently used tiles in
+  // memory and on disk, sizes are in bytes
+  auto &params = this->dataPtr->mapParameters;
+  params.clear();
+  if (!directory.empty())
+  {
+    if (!common::exists(directory) && !common::createDirectories(directory))
+    {
+      gzwarn << "Failed to create tile cache [" << directory << "]"
+             << std::endl;
+    }
+    params["osm.mapping.cache.directory"] = QString::fromStdString(directory);
+  }
+  if (diskSize >= 0.0)
+  {
+    params["osm.mapping.cache.disk.size"] =
+        static_cast<int>(diskSize * 1024 * 1024);
+  }
+  if (memorySize >= 0.0)
+  {
+    params["osm.mapping.cache.memory.size"] =
+        static_cast<int>(memorySize * 1024 * 1024);
+  }
+
+  // Pre-seeded tile packs are looked up before the network and are never
+  // evicted
+  if (!offlineDirectory.empty())
+  {
+    params["osm.mapping.offline.directory"] =
+        QString::fromStdString(offlineDirectory);
+  }
+
+  // Offline, don't block on fetching the list of tile providers, tiles
+  // which aren't cached won't load
+  if (offline)
+    params["osm.mapping.providersrepository.disabled"] = true;
+
+  emit this->MapParametersChanged();
+}
+
 /////////////////////////////////////////////////
 void NavSatMap::ProcessMessage()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->navSatMutex);
+  if (!this->dataPtr->latestMsg.Take(this->dataPtr->navSatMsg))
+    return;
+
+  const double latitude = this->dataPtr->navSatMsg.latitude_deg();
+  const double longitude = this->dataPtr->navSatMsg.longitude_deg();
+  emit this->newMessage(latitude, longitude);
+
+  if (this->dataPtr->prefetchTime <= 0.0)
+    return;
+
+  // Extrapolate the velocity between the last two fixes, which is precise
+  // enough to pick tiles
+  const auto now = std::chrono::steady_clock::now();
+  const auto lastFix = this->dataPtr->lastFix;
+  this->dataPtr->lastFix = Implementation::Fix{latitude, longitude, now};
+  if (!lastFix)
+    return;
+
+  const double dt = std::chrono::duration<double>(now - lastFix->time).count();
+  if (dt <= 0.0 || (latitude == lastFix->latitude &&
+      longitude == lastFix->longitude))
+  {
+    return;
+  }
 
-  emit this->newMessage(this->dataPtr->navSatMsg.latitude_deg(),
-      this->dataPtr->navSatMsg.longitude_deg());
+  const double scale = this->dataPtr->prefetchTime / dt;
+  const double aheadLatitude = std::clamp(
+      latitude + (latitude - lastFix->latitude) * scale, -85.0, 85.0);
+  double aheadLongitude =
+      longitude + (longitude - lastFix->longitude) * scale;
+  aheadLongitude = std::remainder(aheadLongitude, 360.0);
+  emit this->prefetch(aheadLatitude, aheadLongitude);
 }
 
 /////////////////////////////////////////////////
 void NavSatMap::OnMessage(const msgs::NavSat &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->navSatMutex);
-  this->dataPtr->navSatMsg = _msg;
-
-  // Signal to main thread that the navSat changed
-  QMetaObject::invokeMethod(this, "ProcessMessage");
+  // Signal to main thread that the navSat changed, once it's taken the
+  // previous message
+  if (this->dataPtr->latestMsg.Set(_msg))
+    QMetaObject::invokeMethod(this, "ProcessMessage", Qt::QueuedConnection);
 }
 
 /////////////////////////////////////////////////
@@ -124,8 +289,14 @@ void NavSatMap::OnTopic(const QString _topic)
     this->dataPtr->node.Unsubscribe(sub);
 
   // Subscribe to new topic
+  transport::SubscribeOptions opts;
+  if (this->dataPtr->maxRate > 0.0)
+  {
+    opts.SetMsgsPerSec(
+        static_cast<uint64_t>(std::ceil(this->dataPtr->maxRate)));
+  }
   if (!this->dataPtr->node.Subscribe(topic, &NavSatMap::OnMessage,
-      this))
+      this, opts))
   {
     gzerr << "Unable to subscribe to topic [" << topic << "]" << std::endl;
   }
@@ -138,22 +309,10 @@ void NavSatMap::OnRefresh()
   this->dataPtr->topicList.clear();
 
   // Get updated list
-  std::vector<std::string> allTopics;
-  this->dataPtr->node.TopicList(allTopics);
-  for (const auto &topic : allTopics)
-  {
-    std::vector<transport::MessagePublisher> publishers;
-    std::vector<transport::MessagePublisher> subscribers;
-    this->dataPtr->node.TopicInfo(topic, publishers, subscribers);
-    for (const auto &pub : publishers)
-    {
-      if (pub.MsgTypeName() == "gz.msgs.NavSat")
-      {
-        this->dataPtr->topicList.push_back(QString::fromStdString(topic));
-        break;
-      }
-    }
-  }
+  auto registry = App()->Topics();
+  registry->Scan();
+  for (const auto &topic : registry->Topics("gz.msgs.NavSat"))
+    this->dataPtr->topicList.push_back(QString::fromStdString(topic));
 
   // Select first one
   if (this->dataPtr->topicList.count() > 0)
@@ -161,6 +320,12 @@ void NavSatMap::OnRefresh()
   emit this->TopicListChanged();
 }
 
+/////////////////////////////////////////////////
+QVariantMap NavSatMap::MapParameters() const
+{
+  return this->dataPtr->mapParameters;
+}
+
 /////////////////////////////////////////////////
 QStringList NavSatMap::TopicList() const
 {
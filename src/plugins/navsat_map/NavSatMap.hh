@@ -36,6 +36,25 @@ namespace gz::gui::plugins
   /// \<topic\> : Set the topic to receive NavSat messages.
   /// \<topic_picker\> : Whether to show the topic picker, true by default. If
   ///                    this is false, a \<topic\> must be specified.
+  /// \<max_rate\> : Most messages per second to receive, rounded up to a
+  ///                whole number. Messages above this rate are dropped by
+  ///                the transport subscription, before they're delivered
+  ///                and deserialized. 0 by default, for all of them.
+  /// \<cache\> : Map tile cache, which keeps the most recently used tiles in
+  ///             memory and on disk across sessions.
+  ///   * \<directory\> : Disk cache, defaults to
+  ///                     "$HOME/.gz/gui/navsat_map/tiles".
+  ///   * \<disk_size\> : Size of the disk cache in MB, defaults to 50.
+  ///   * \<memory_size\> : Size of the memory cache in MB, defaults to the
+  ///                       map plugin's.
+  ///   * \<offline_directory\> : Pre-seeded tiles, looked up before the
+  ///                             network and never evicted. Files are named
+  ///                             like those of the disk cache.
+  ///   * \<offline\> : True to not fetch the list of tile providers, so
+  ///                   that the map doesn't stall without a connection.
+  ///   * \<prefetch_time\> : Seconds ahead of the vehicle to fetch tiles
+  ///                         for, extrapolating its last two fixes.
+  ///                         Defaults to 0, disabled.
   class NavSatMap : public Plugin
   {
     Q_OBJECT
@@ -48,6 +67,13 @@ namespace gz::gui::plugins
       NOTIFY TopicListChanged
     )
 
+    /// \brief Parameters of the map plugin
+    Q_PROPERTY(
+      QVariantMap mapParameters
+      READ MapParameters
+      NOTIFY MapParametersChanged
+    )
+
     /// \brief Constructor
     public: NavSatMap();
 
@@ -74,11 +100,29 @@ namespace gz::gui::plugins
     /// \brief Notify that topic list has changed
     signals: void TopicListChanged();
 
+    /// \brief Get the parameters of the map plugin, which configure its
+    /// tile cache
+    /// \return Parameter names and values
+    public: Q_INVOKABLE QVariantMap MapParameters() const;
+
+    /// \brief Notify that the map parameters have changed
+    signals: void MapParametersChanged();
+
+    /// \brief Notify that tiles around a position the vehicle is heading to
+    /// should be fetched.
+    /// \param[in] _latitudeDeg Latitude in degrees
+    /// \param[in] _longitudeDeg Longitude in degrees
+    signals: void prefetch(double _latitudeDeg, double _longitudeDeg);
+
     /// \brief Notify that a new message has been received.
     /// \param[in] _latitudeDeg Latitude in degrees
     /// \param[in] _longitudeDeg Longitude in degrees
     signals: void newMessage(double _latitudeDeg, double _longitudeDeg);
 
+    /// \brief Load the tile cache configuration
+    /// \param[in] _cacheElem \<cache\> element, may be null
+    private: void LoadCacheConfig(const tinyxml2::XMLElement *_cacheElem);
+
     /// \brief Callback in main thread when message changes
     private slots: void ProcessMessage();
 
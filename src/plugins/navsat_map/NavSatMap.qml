@@ -27,6 +27,31 @@ Item {
   property double longitude: 0.0
   property bool centering: true
 
+  // Created once the tile cache parameters are known, since a map's plugin
+  // can't be changed
+  property var mapPlugin: null
+
+  function createMapPlugin() {
+    if (mapPlugin !== null) {
+      return;
+    }
+
+    var params = NavSatMap.mapParameters;
+    var qml = 'import QtLocation 5.6; Plugin { name: "osm";';
+    for (var name in params) {
+      qml += ' PluginParameter { name: ' + JSON.stringify(name) +
+          '; value: ' + JSON.stringify(params[name]) + ' }';
+    }
+    qml += ' }';
+    mapPlugin = Qt.createQmlObject(qml, navSatMap, "mapPlugin");
+  }
+
+  Component.onCompleted: {
+    if (Object.keys(NavSatMap.mapParameters).length > 0) {
+      createMapPlugin();
+    }
+  }
+
   Layout.minimumWidth: 280
   Layout.minimumHeight: 455
   anchors.topMargin: 5
@@ -89,9 +114,16 @@ Item {
     }
   }
 
-  Plugin {
-    id: mapPlugin
-    name: "osm"
+  // Never shown, it shares the tile cache with the map and fetches the tiles
+  // ahead of the vehicle
+  Map {
+    id: prefetchMap
+    anchors.fill: map
+    opacity: 0
+    enabled: false
+    plugin: mapPlugin
+    copyrightsVisible: false
+    zoomLevel: map.zoomLevel
   }
 
   Map {
@@ -163,5 +195,16 @@ Item {
       latitude = _latitudeDeg
       longitude = _longitudeDeg
     }
+    onMapParametersChanged: {
+      createMapPlugin()
+    }
+    onPrefetch: {
+      if (mapPlugin === null) {
+        return;
+      }
+      prefetchMap.center = QtPositioning.coordinate(_latitudeDeg,
+          _longitudeDeg)
+      prefetchMap.prefetchData()
+    }
   }
 }
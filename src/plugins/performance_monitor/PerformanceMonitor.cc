@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/diagnostics.pb.h>
+#include <gz/plugin/Register.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/SubscriptionHub.hh"
+
+#include "PerformanceMonitor.hh"
+
+namespace gz::gui::plugins
+{
+class PerformanceMonitor::Implementation
+{
+  /// \brief Samples of the last period, for QML
+  public: QVariantList samples;
+
+  /// \brief Frame timing text, for QML
+  public: QString frameTiming;
+
+  /// \brief Triggers updates
+  public: QTimer timer;
+
+  /// \brief When the counters were last read
+  public: std::chrono::steady_clock::time_point lastUpdate;
+
+  /// \brief True once the counters have been enabled by this plugin
+  public: bool enabled{false};
+
+  /// \brief Subscription to the frame timing of the 3D scene
+  public: HubSubscription frameTimingSubscription;
+};
+
+/////////////////////////////////////////////////
+/// \brief Format a duration in milliseconds
+/// \param[in] _time Duration
+/// \return Text such as "1.25 ms"
+static QString formatMs(std::chrono::steady_clock::duration _time)
+{
+  return QString::number(
+      std::chrono::duration<double, std::milli>(_time).count(), 'f', 3) +
+      " ms";
+}
+
+/////////////////////////////////////////////////
+PerformanceMonitor::PerformanceMonitor()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->connect(&this->dataPtr->timer, &QTimer::timeout,
+      this, &PerformanceMonitor::Update);
+}
+
+/////////////////////////////////////////////////
+PerformanceMonitor::~PerformanceMonitor()
+{
+  if (this->dataPtr->enabled)
+    PerformanceCounters::SetEnabled(false);
+}
+
+/////////////////////////////////////////////////
+void PerformanceMonitor::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Performance monitor";
+
+  double period{1.0};
+  std::string frameTimingTopic{"/gui/frame_timing"};
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("period"))
+      elem->QueryDoubleText(&period);
+
+    if (auto elem = _pluginElem->FirstChildElement("frame_timing_topic"))
+    {
+      if (nullptr != elem->GetText())
+        frameTimingTopic = elem->GetText();
+    }
+  }
+
+  if (!frameTimingTopic.empty())
+  {
+    this->dataPtr->frameTimingSubscription =
+        App()->Subscriptions()->Subscribe<msgs::Diagnostics>(
+        frameTimingTopic,
+        std::function<void(const msgs::Diagnostics &)>(
+        [this](const msgs::Diagnostics &_msg)
+        {
+          std::ostringstream text;
+          text << std::fixed << std::setprecision(3);
+          for (const auto &time : _msg.time())
+          {
+            const double ms = time.elapsed().sec() * 1e3 +
+                time.elapsed().nsec() * 1e-6;
+            if (text.tellp() > 0)
+              text << "\n";
+            text << time.name() << ": " << ms << " ms";
+          }
+
+          // Called from a transport thread
+          QMetaObject::invokeMethod(this,
+              [this, frameTiming = QString::fromStdString(text.str())]()
+              {
+                this->dataPtr->frameTiming = frameTiming;
+                emit this->FrameTimingChanged();
+              }, Qt::QueuedConnection);
+        }));
+  }
+
+  if (period <= 0.0)
+  {
+    gzwarn << "Invalid <period> [" << period << "], using 1 s" << std::endl;
+    period = 1.0;
+  }
+
+  if (!this->dataPtr->enabled)
+  {
+    PerformanceCounters::SetEnabled(true);
+    this->dataPtr->enabled = true;
+    this->dataPtr->lastUpdate = std::chrono::steady_clock::now();
+  }
+  this->dataPtr->timer.start(static_cast<int>(period * 1000.0));
+}
+
+/////////////////////////////////////////////////
+void PerformanceMonitor::Update()
+{
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> elapsed =
+      now - this->dataPtr->lastUpdate;
+  this->dataPtr->lastUpdate = now;
+  if (elapsed.count() <= 0.0)
+    return;
+
+  auto samples = PerformanceCounters::TakeSamples();
+  std::stable_sort(samples.begin(), samples.end(),
+      [](const PerformanceCounters::Sample &_a,
+         const PerformanceCounters::Sample &_b)
+      {
+        return _a.total > _b.total;
+      });
+
+  QVariantList list;
+  for (const auto &sample : samples)
+  {
+    QVariantMap map;
+    map["owner"] = QString::fromStdString(sample.owner);
+    map["source"] = QString::fromStdString(sample.source);
+    map["calls"] = QString::number(
+        static_cast<double>(sample.calls) / elapsed.count(), 'f', 1) + "/s";
+    map["average"] = sample.calls == 0 ? QString("-") :
+        formatMs(sample.total / static_cast<int64_t>(sample.calls));
+    map["max"] = sample.calls == 0 ? QString("-") : formatMs(sample.max);
+
+    // Share of the wall time spent in the callbacks, which may exceed 100%
+    // when they run on several threads
+    map["load"] = QString::number(100.0 *
+        std::chrono::duration<double>(sample.total).count() /
+        elapsed.count(), 'f', 1) + "%";
+    map["queue"] = static_cast<qulonglong>(sample.queueDepth);
+    map["overruns"] = static_cast<qulonglong>(sample.overruns);
+    map["bandwidth"] = sample.bytes == 0 ? QString("-") :
+        QString::number(static_cast<double>(sample.bytes) / 1e6 /
+        elapsed.count(), 'f', 1) + " MB/s";
+    list.append(map);
+  }
+
+  this->dataPtr->samples = std::move(list);
+  emit this->SamplesChanged();
+}
+
+/////////////////////////////////////////////////
+QVariantList PerformanceMonitor::Samples() const
+{
+  return this->dataPtr->samples;
+}
+
+/////////////////////////////////////////////////
+QString PerformanceMonitor::FrameTiming() const
+{
+  return this->dataPtr->frameTiming;
+}
+}  // namespace gz::gui::plugins
+
+// Register this plugin
+GZ_ADD_PLUGIN(gz::gui::plugins::PerformanceMonitor,
+              gz::gui::Plugin)
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_PERFORMANCEMONITOR_HH_
+#define GZ_GUI_PLUGINS_PERFORMANCEMONITOR_HH_
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz::gui::plugins
+{
+  /// \brief Shows where the time of the GUI goes, per plugin, to find which
+  /// plugin eats the frame budget: time spent in render hooks, in event
+  /// filters handling events::Render and events::PreRender, in transport
+  /// callbacks per topic, the depth of the queues plugins report, and the
+  /// bandwidth of their GPU uploads. It also shows the frame stages
+  /// measured by MinimalScene, and how often frame tasks overran their
+  /// budget.
+  ///
+  /// Measurements are enabled through PerformanceCounters while the plugin
+  /// is loaded, and cost a clock read per callback.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<period\> : Seconds between updates, defaults to 1.
+  /// * \<frame_timing_topic\> : Topic MinimalScene publishes its frame
+  ///                            timing on, defaults to "/gui/frame_timing".
+  ///                            MinimalScene only publishes it with its
+  ///                            \<frame_timing\> option.
+  class PerformanceMonitor : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Time spent by each owner and source during the last period,
+    /// as maps with "owner", "source", "calls", "average", "max", "load",
+    /// "queue", "overruns" and "bandwidth", sorted by decreasing time
+    Q_PROPERTY(
+      QVariantList samples
+      READ Samples
+      NOTIFY SamplesChanged
+    )
+
+    /// \brief Frame stages reported by the 3D scene, one "stage: time" per
+    /// line
+    Q_PROPERTY(
+      QString frameTiming
+      READ FrameTiming
+      NOTIFY FrameTimingChanged
+    )
+
+    /// \brief Constructor
+    public: PerformanceMonitor();
+
+    /// \brief Destructor
+    public: ~PerformanceMonitor() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the time spent by each owner and source
+    /// \return List of maps
+    public: Q_INVOKABLE QVariantList Samples() const;
+
+    /// \brief Get the frame stages reported by the 3D scene
+    /// \return Text, empty until reported
+    public: Q_INVOKABLE QString FrameTiming() const;
+
+    /// \brief Read the counters and update the display
+    public: void Update();
+
+    /// \brief Notify that the samples have been updated
+    signals: void SamplesChanged();
+
+    /// \brief Notify that the frame timing has been updated
+    signals: void FrameTimingChanged();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_PERFORMANCEMONITOR_HH_
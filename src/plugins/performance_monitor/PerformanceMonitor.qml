@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: performanceMonitor
+  color: "transparent"
+  Layout.minimumWidth: 450
+  Layout.minimumHeight: 300
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    Label {
+      font.weight: Font.DemiBold
+      text: "Frame"
+    }
+
+    Label {
+      objectName: "frameTiming"
+      text: PerformanceMonitor.frameTiming === "" ?
+          qsTr("Enable <frame_timing> on the 3D scene to see its stages") :
+          PerformanceMonitor.frameTiming
+      color: PerformanceMonitor.frameTiming === "" ? "gray" : label.color
+      Layout.fillWidth: true
+      wrapMode: Text.WordWrap
+
+      // Only used for its default color
+      Label {
+        id: label
+        visible: false
+      }
+    }
+
+    RowLayout {
+      Layout.fillWidth: true
+
+      Repeater {
+        model: [
+          {"text": "Plugin", "width": 0.2},
+          {"text": "Source", "width": 0.2},
+          {"text": "Calls", "width": 0.1},
+          {"text": "Average", "width": 0.1},
+          {"text": "Max", "width": 0.1},
+          {"text": "Load", "width": 0.1},
+          {"text": "Queue", "width": 0.05},
+          {"text": "Overruns", "width": 0.05},
+          {"text": "Upload", "width": 0.1}
+        ]
+
+        Label {
+          font.weight: Font.DemiBold
+          text: modelData.text
+          Layout.preferredWidth: performanceMonitor.width * modelData.width
+        }
+      }
+    }
+
+    ListView {
+      objectName: "samples"
+      clip: true
+      model: PerformanceMonitor.samples
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+
+      delegate: RowLayout {
+        width: ListView.view.width
+
+        Repeater {
+          model: [
+            {"key": "owner", "width": 0.2},
+            {"key": "source", "width": 0.2},
+            {"key": "calls", "width": 0.1},
+            {"key": "average", "width": 0.1},
+            {"key": "max", "width": 0.1},
+            {"key": "load", "width": 0.1},
+            {"key": "queue", "width": 0.05},
+            {"key": "overruns", "width": 0.05},
+            {"key": "bandwidth", "width": 0.1}
+          ]
+
+          Label {
+            text: parent.sample[modelData.key]
+            elide: Text.ElideRight
+            Layout.preferredWidth: performanceMonitor.width * modelData.width
+          }
+        }
+
+        property var sample: modelData
+      }
+    }
+  }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/diagnostics.pb.h>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/Plugin.hh"
+#include "PerformanceMonitor.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./PerformanceMonitor_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(PerformanceMonitorTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Samples))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_FALSE(PerformanceCounters::Enabled());
+
+  const char *pluginStr =
+    "<plugin filename=\"PerformanceMonitor\">"
+      "<period>0.05</period>"
+      "<frame_timing_topic>/perf_test_timing</frame_timing_topic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("PerformanceMonitor",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugin = win->findChild<plugins::PerformanceMonitor *>();
+  ASSERT_NE(nullptr, plugin);
+  EXPECT_EQ(plugin->Title(), "Performance monitor");
+
+  // Counters are measured while the plugin is loaded
+  EXPECT_TRUE(PerformanceCounters::Enabled());
+
+  PerformanceCounter counter("PerfTest", "test");
+  counter.AddTime(2ms);
+  counter.SetQueueDepth(4);
+  counter.AddBytes(1000000);
+
+  bool found{false};
+  int sleep = 0;
+  while (!found && sleep < 100)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(10ms);
+    ++sleep;
+
+    for (const auto &sample : plugin->Samples())
+    {
+      const auto map = sample.toMap();
+      if (map["owner"].toString() != "PerfTest")
+        continue;
+      found = true;
+      EXPECT_EQ("test", map["source"].toString().toStdString());
+      EXPECT_EQ(4u, map["queue"].toULongLong());
+      EXPECT_NE("-", map["bandwidth"].toString().toStdString());
+    }
+  }
+  EXPECT_TRUE(found);
+
+  // Frame stages reported by the scene
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Diagnostics>("/perf_test_timing");
+  msgs::Diagnostics msg;
+  auto time = msg.add_time();
+  time->set_name("render");
+  time->mutable_elapsed()->set_nsec(1500000);
+
+  sleep = 0;
+  while (plugin->FrameTiming().isEmpty() && sleep < 100)
+  {
+    pub.Publish(msg);
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(10ms);
+    ++sleep;
+  }
+  EXPECT_EQ("render: 1.500 ms", plugin->FrameTiming().toStdString());
+}
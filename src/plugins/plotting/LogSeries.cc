@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include <QPointF>
+
+#include <gz/common/Console.hh>
+#include <gz/gui/PlottingInterface.hh>
+#include <gz/gui/RecordedSeries.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/transport/log/QueryOptions.hh>
+
+#include "LogSeries.hh"
+
+namespace gz::gui::plugins
+{
+/// \brief Msgs decoded between flushes of the field's values, below the
+/// values a Topic keeps between flushes
+constexpr std::size_t kFlushInterval = 1000;
+
+/////////////////////////////////////////////////
+bool ExportLogField(const std::string &_logPath, const std::string &_topic,
+    const std::string &_fieldPath, const std::string &_outPath)
+{
+  transport::log::Log log;
+  if (!log.Open(_logPath))
+  {
+    gzerr << "Failed to open log [" << _logPath << "]" << std::endl;
+    return false;
+  }
+
+  // Decoded by a Topic, like the live values
+  Topic topic(_topic);
+  topic.Register(_fieldPath, 0);
+  topic.SetSamplingPolicy(_fieldPath, SamplingPolicy::KEEP_ALL, 0.0);
+  auto receivedTime = std::make_shared<double>(0.0);
+  topic.SetPlottingTimeRef(receivedTime);
+
+  std::vector<math::Vector2d> points;
+  QObject::connect(&topic, &Topic::plotBatch,
+      [&points](int, QString, QVariantList _points)
+      {
+        for (const auto &point : _points)
+        {
+          const auto p = point.toPointF();
+          points.emplace_back(p.x(), p.y());
+        }
+      });
+
+  bool first{true};
+  std::chrono::nanoseconds start{0};
+  std::size_t pending{0};
+  for (const auto &msg : log.QueryMessages(
+      transport::log::TopicList(_topic)))
+  {
+    if (first)
+    {
+      start = msg.TimeReceived();
+      first = false;
+    }
+    *receivedTime = std::chrono::duration<double>(
+        msg.TimeReceived() - start).count();
+
+    const auto &data = msg.Data();
+    topic.RawCallback(data.data(), data.size(), msg.Type());
+    if (++pending == kFlushInterval)
+    {
+      topic.FlushGui();
+      pending = 0;
+    }
+  }
+  topic.FlushGui();
+
+  if (first)
+  {
+    gzerr << "No msgs on topic [" << _topic << "] in log [" << _logPath
+           << "]" << std::endl;
+    return false;
+  }
+
+  // Header stamps may go back in time, while exports are in time order
+  std::stable_sort(points.begin(), points.end(),
+      [](const math::Vector2d &_a, const math::Vector2d &_b)
+      {
+        return _a.X() < _b.X();
+      });
+  return RecordedSeries::Write(_outPath, _topic + "-" + _fieldPath, points);
+}
+
+/////////////////////////////////////////////////
+std::string LogFieldExport(const std::string &_logPath,
+    const std::string &_topic, const std::string &_fieldPath)
+{
+  std::string suffix = _topic + "-" + _fieldPath;
+  std::replace_if(suffix.begin(), suffix.end(),
+      [](unsigned char _c){return !std::isalnum(_c) && _c != '-';}, '_');
+  const std::string outPath = _logPath + "." + suffix + ".bin";
+
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  const auto logTime = fs::last_write_time(_logPath, ec);
+  if (ec)
+  {
+    gzerr << "Failed to open log [" << _logPath << "]: " << ec.message()
+           << std::endl;
+    return std::string();
+  }
+  const auto outTime = fs::last_write_time(outPath, ec);
+  if (!ec && outTime >= logTime)
+    return outPath;
+
+  if (!ExportLogField(_logPath, _topic, _fieldPath, outPath))
+    return std::string();
+  return outPath;
+}
+}  // namespace gz::gui::plugins
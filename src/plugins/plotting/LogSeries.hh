@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_LOGSERIES_HH_
+#define GZ_GUI_PLUGINS_LOGSERIES_HH_
+
+#include <string>
+
+#ifndef _WIN32
+#  define LogSeries_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportPlotting_EXPORTS))
+#    define LogSeries_EXPORTS_API __declspec(dllexport)
+#  else
+#    define LogSeries_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Write the values of a field recorded in a gz-transport log as
+  /// a binary plot export, which can then be mapped by RecordedSeries.
+  ///
+  /// Logs are SQLite databases, which can't be mapped, so a field is
+  /// converted once and the export is reused while it's newer than the
+  /// log. Fields are decoded like live plots: msgs with a header stamp are
+  /// plotted at their stamp, the others at the time they were received,
+  /// from the first msg of the topic. Every value is kept.
+  /// \param[in] _logPath Path of the log
+  /// \param[in] _topic Topic of the field
+  /// \param[in] _fieldPath Path of the field, such as "pose-position-x"
+  /// \param[in] _outPath Path of the export to write
+  /// \return False if the log couldn't be read, the topic has no msgs or
+  /// the export couldn't be written
+  LogSeries_EXPORTS_API bool ExportLogField(const std::string &_logPath,
+      const std::string &_topic, const std::string &_fieldPath,
+      const std::string &_outPath);
+
+  /// \brief Get the path of the export of a logged field, next to the log,
+  /// converting the field first if the export is missing or older than the
+  /// log
+  /// \param[in] _logPath Path of the log
+  /// \param[in] _topic Topic of the field
+  /// \param[in] _fieldPath Path of the field
+  /// \return Path of the export, empty if it couldn't be written
+  /// \sa ExportLogField
+  LogSeries_EXPORTS_API std::string LogFieldExport(
+      const std::string &_logPath, const std::string &_topic,
+      const std::string &_fieldPath);
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/gui/RecordedSeries.hh>
+#include <gz/msgs/double.pb.h>
+#include <gz/transport/log/Log.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "LogSeries.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(LogSeriesTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Export))
+{
+  const auto dir = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "test", "log_series_export");
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+  const auto logPath = common::joinPaths(dir, "run.tlog");
+
+  // A value every 10 ms, and another topic
+  {
+    transport::log::Log log;
+    ASSERT_TRUE(log.Open(logPath, std::ios_base::out));
+    const std::chrono::nanoseconds start(std::chrono::seconds(1000));
+    for (int i = 0; i < 2500; ++i)
+    {
+      msgs::Double msg;
+      msg.set_data(i * 0.5);
+      const auto data = msg.SerializeAsString();
+      const auto time = start + std::chrono::milliseconds(10 * i);
+      log.InsertMessage(time, "/value", msg.GetTypeName(), data.data(),
+          data.size());
+      log.InsertMessage(time, "/other", msg.GetTypeName(), data.data(),
+          data.size());
+    }
+  }
+
+  EXPECT_TRUE(LogFieldExport(common::joinPaths(dir, "missing.tlog"),
+      "/value", "data").empty());
+  EXPECT_FALSE(ExportLogField(logPath, "/missing", "data",
+      common::joinPaths(dir, "missing.bin")));
+
+  const auto path = LogFieldExport(logPath, "/value", "data");
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(logPath + "._value-data.bin", path);
+
+  RecordedSeries series;
+  ASSERT_TRUE(series.Open(path));
+  EXPECT_EQ("/value-data", series.Name());
+  ASSERT_EQ(2500u, series.Size());
+
+  // Msgs without header are plotted from the first one
+  EXPECT_DOUBLE_EQ(0.0, series.Start());
+  EXPECT_NEAR(24.99, series.End(), 1e-9);
+  for (std::size_t i = 0; i < series.Size(); ++i)
+  {
+    EXPECT_NEAR(i * 0.01, series.Point(i).X(), 1e-9);
+    EXPECT_DOUBLE_EQ(i * 0.5, series.Point(i).Y());
+  }
+
+  // The export is reused while it's newer than the log
+  series.Close();
+  ASSERT_TRUE(RecordedSeries::Write(path, "cached", {{0.0, 1.0}}));
+  EXPECT_EQ(path, LogFieldExport(logPath, "/value", "data"));
+  ASSERT_TRUE(series.Open(path));
+  EXPECT_EQ("cached", series.Name());
+
+  series.Close();
+  common::removeAll(dir);
+}
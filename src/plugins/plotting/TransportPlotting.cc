@@ -14,23 +14,106 @@
  * limitations under the License.
  *
 */
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/utils/ImplPtr.hh>
+#include "LogSeries.hh"
 #include "TransportPlotting.hh"
 
 namespace gz::gui::plugins
 {
 //////////////////////////////////////////
-TransportPlotting::TransportPlotting() = default;
+TransportPlotting::TransportPlotting()
+  : plotting(std::make_unique<PlottingInterface>())
+{
+}
 
 //////////////////////////////////////////
-TransportPlotting::~TransportPlotting() = default;
+TransportPlotting::~TransportPlotting()
+{
+  if (this->importThread.joinable())
+    this->importThread.join();
+}
 
 //////////////////////////////////////////
-void TransportPlotting::LoadConfig(const tinyxml2::XMLElement *)
+void TransportPlotting::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Transport plotting";
+
+  if (!_pluginElem)
+    return;
+
+  if (auto rateElem = _pluginElem->FirstChildElement("max_rate"))
+  {
+    double maxRate{0.0};
+    if (rateElem->QueryDoubleText(&maxRate) != tinyxml2::XML_SUCCESS ||
+        maxRate < 0)
+    {
+      gzerr << "Failed to parse <max_rate> value: " << rateElem->GetText()
+            << std::endl;
+    }
+    else
+    {
+      this->plotting->SetMaxRate(maxRate);
+    }
+  }
+
+  // Logged fields to overlay
+  struct LoggedField
+  {
+    std::string log;
+    std::string topic;
+    std::string field;
+    int chart{1};
+  };
+  std::vector<LoggedField> fields;
+  for (auto recordingElem = _pluginElem->FirstChildElement("recording");
+       recordingElem != nullptr;
+       recordingElem = recordingElem->NextSiblingElement("recording"))
+  {
+    LoggedField field;
+    auto logElem = recordingElem->FirstChildElement("log");
+    auto topicElem = recordingElem->FirstChildElement("topic");
+    auto fieldElem = recordingElem->FirstChildElement("field");
+    if (!logElem || !logElem->GetText() || !topicElem ||
+        !topicElem->GetText() || !fieldElem || !fieldElem->GetText())
+    {
+      gzerr << "A <recording> needs a <log>, a <topic> and a <field>"
+            << std::endl;
+      continue;
+    }
+    field.log = logElem->GetText();
+    field.topic = topicElem->GetText();
+    field.field = fieldElem->GetText();
+    if (auto chartElem = recordingElem->FirstChildElement("chart"))
+      chartElem->QueryIntText(&field.chart);
+    fields.push_back(field);
+  }
+  if (fields.empty() || this->importThread.joinable())
+    return;
+
+  // Converting a large log takes a while, the charts are offered each field
+  // once it's ready
+  PlottingInterface *plottingPtr = this->plotting.get();
+  this->importThread = std::thread([fields, plottingPtr]
+  {
+    for (const auto &field : fields)
+    {
+      const auto path = LogFieldExport(field.log, field.topic, field.field);
+      if (path.empty())
+        continue;
+
+      const int chart = field.chart;
+      QMetaObject::invokeMethod(plottingPtr, [plottingPtr, chart, path]
+      {
+        plottingPtr->OfferRecording(chart, QString::fromStdString(path));
+      }, Qt::QueuedConnection);
+    }
+  });
 }
 }  // namespace gz::gui::plugins
 //
@@ -24,11 +24,28 @@
 #include <gz/utils/SuppressWarning.hh>
 
 #include <memory>
+#include <thread>
 
 namespace gz::gui::plugins
 {
 /// \brief Plots fields from Gazebo Transport topics.
 /// Fields can be dragged from the Topic Viewer or the Component Inspector.
+///
+/// ## Configuration
+///
+/// \<max_rate\> : Most messages per second received on each plotted
+///                topic, 0 by default for all of them. Messages above this
+///                rate are dropped by the transport subscription, before
+///                they're delivered.
+///
+/// \<recording\> : Field recorded in a gz-transport log, overlaid on a
+///                chart, may be repeated. The field is converted once to a
+///                binary plot export next to the log, on a worker thread,
+///                which is then mapped rather than loaded.
+///   * \<log\> : Path of the log
+///   * \<topic\> : Topic of the field
+///   * \<field\> : Path of the field, such as "pose-position-x"
+///   * \<chart\> : ID of the chart, 1 by default for the first chart
 class TransportPlotting : public gz::gui::Plugin
 {
   Q_OBJECT
@@ -41,6 +58,13 @@ class TransportPlotting : public gz::gui::Plugin
 
   // Documentation inherited
   public: void LoadConfig(const tinyxml2::XMLElement *) override;
+
+  /// \brief Stores and delivers the plotted values, and draws them through
+  /// the charts' PlotLines
+  private: std::unique_ptr<PlottingInterface> plotting;
+
+  /// \brief Converts the logged fields of the configuration
+  private: std::thread importThread;
 };
 }  // namespace gz::gui::plugins
 
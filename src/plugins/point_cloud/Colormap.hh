@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_GUI_PLUGINS_POINTCLOUD_COLORMAP_HH_
+#define GZ_GUI_PLUGINS_POINTCLOUD_COLORMAP_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <gz/math/Color.hh>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define GZ_GUI_COLORMAP_AVX2
+  #include <immintrin.h>
+#elif defined(__aarch64__)
+  #define GZ_GUI_COLORMAP_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Colors float values with a linear gradient between two colors,
+  /// and filters out NaNs, in a single pass.
+  ///
+  /// Colors are packed as RGBA8, 0xRRGGBBAA, see math::Color::SetFromRGBA.
+  /// Values outside of the range are clamped to the end colors.
+  ///
+  /// The AVX2 kernel is picked at runtime on x86 CPUs that support it, the
+  /// NEON one is always used on 64-bit ARM. Otherwise values are colored
+  /// one by one.
+  class Colormap
+  {
+    /// \brief Constructor
+    /// \param[in] _minValue Value colored with `_minColor`
+    /// \param[in] _maxValue Value colored with `_maxColor`
+    /// \param[in] _minColor Color of the minimum value
+    /// \param[in] _maxColor Color of the maximum value
+    public: Colormap(float _minValue, float _maxValue,
+        const math::Color &_minColor, const math::Color &_maxColor)
+      : minValue(_minValue)
+    {
+      const float range = _maxValue - _minValue;
+      this->scale = range > 0 ? 1.0f / range : 0.0f;
+      const float minChannels[4]{
+          _minColor.R(), _minColor.G(), _minColor.B(), _minColor.A()};
+      const float maxChannels[4]{
+          _maxColor.R(), _maxColor.G(), _maxColor.B(), _maxColor.A()};
+      for (int i = 0; i < 4; ++i)
+      {
+        this->base[i] = minChannels[i];
+        this->delta[i] = maxChannels[i] - minChannels[i];
+      }
+    }
+
+    /// \brief Color values, skipping NaNs
+    /// \param[in] _values Values to color
+    /// \param[in] _count Number of values
+    /// \param[out] _colors Color of each value which isn't NaN. Must have
+    /// room for `_count` colors.
+    /// \param[out] _indices Index in `_values` of each color. Must have room
+    /// for `_count` indices.
+    /// \return Number of colors written
+    public: std::size_t Apply(const float *_values, std::size_t _count,
+        uint32_t *_colors, uint32_t *_indices) const
+    {
+#if defined(GZ_GUI_COLORMAP_AVX2)
+      static const bool avx2 = __builtin_cpu_supports("avx2");
+      if (avx2)
+        return this->ApplyAvx2(_values, _count, _colors, _indices);
+#elif defined(GZ_GUI_COLORMAP_NEON)
+      return this->ApplyNeon(_values, _count, _colors, _indices);
+#endif
+      return this->ApplyScalar(_values, 0, _count, _colors, _indices, 0);
+    }
+
+    /// \brief Color values one by one, see Apply
+    /// \param[in] _values Values to color
+    /// \param[in] _begin Index of the first value
+    /// \param[in] _end Index past the last value
+    /// \param[out] _colors Colors, see Apply
+    /// \param[out] _indices Indices, see Apply
+    /// \param[in] _written Number of colors already written
+    /// \return Number of colors written, including `_written`
+    public: std::size_t ApplyScalar(const float *_values, std::size_t _begin,
+        std::size_t _end, uint32_t *_colors, uint32_t *_indices,
+        std::size_t _written) const
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        const float value = _values[i];
+        if (std::isnan(value))
+          continue;
+
+        const float ratio = (value - this->minValue) * this->scale;
+        uint32_t rgba{0};
+        for (int c = 0; c < 4; ++c)
+        {
+          const float channel = std::min(1.0f, std::max(0.0f,
+              this->base[c] + this->delta[c] * ratio));
+          rgba = (rgba << 8) |
+              static_cast<uint32_t>(channel * 255.0f + 0.5f);
+        }
+        _colors[_written] = rgba;
+        _indices[_written] = static_cast<uint32_t>(i);
+        _written++;
+      }
+      return _written;
+    }
+
+#if defined(GZ_GUI_COLORMAP_AVX2)
+    /// \brief Color 8 values at a time, see Apply
+    /// \param[in] _values Values to color
+    /// \param[in] _count Number of values
+    /// \param[out] _colors Colors, see Apply
+    /// \param[out] _indices Indices, see Apply
+    /// \return Number of colors written
+    private: __attribute__((target("avx2")))
+    std::size_t ApplyAvx2(const float *_values, std::size_t _count,
+        uint32_t *_colors, uint32_t *_indices) const
+    {
+      const __m256 minV = _mm256_set1_ps(this->minValue);
+      const __m256 scaleV = _mm256_set1_ps(this->scale);
+      const __m256 zero = _mm256_setzero_ps();
+      const __m256 one = _mm256_set1_ps(1.0f);
+      const __m256 max8 = _mm256_set1_ps(255.0f);
+      const __m256 half = _mm256_set1_ps(0.5f);
+      __m256 baseV[4];
+      __m256 deltaV[4];
+      for (int c = 0; c < 4; ++c)
+      {
+        baseV[c] = _mm256_set1_ps(this->base[c]);
+        deltaV[c] = _mm256_set1_ps(this->delta[c]);
+      }
+
+      std::size_t written{0};
+      std::size_t i{0};
+      alignas(32) uint32_t packed[8];
+      for (; i + 8 <= _count; i += 8)
+      {
+        const __m256 v = _mm256_loadu_ps(_values + i);
+        int valid = _mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_ORD_Q));
+        if (0 == valid)
+          continue;
+
+        const __m256 ratio = _mm256_mul_ps(_mm256_sub_ps(v, minV), scaleV);
+        __m256i rgba = _mm256_setzero_si256();
+        for (int c = 0; c < 4; ++c)
+        {
+          __m256 channel = _mm256_add_ps(baseV[c],
+              _mm256_mul_ps(deltaV[c], ratio));
+          // Operand order makes NaNs, e.g. from infinite values, clamp to 0
+          channel = _mm256_min_ps(_mm256_max_ps(channel, zero), one);
+          channel = _mm256_add_ps(_mm256_mul_ps(channel, max8), half);
+          rgba = _mm256_or_si256(_mm256_slli_epi32(rgba, 8),
+              _mm256_cvttps_epi32(channel));
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i *>(packed), rgba);
+
+        // Compact the values which aren't NaN
+        while (valid)
+        {
+          const int lane = __builtin_ctz(static_cast<unsigned int>(valid));
+          _colors[written] = packed[lane];
+          _indices[written] = static_cast<uint32_t>(i + lane);
+          written++;
+          valid &= valid - 1;
+        }
+      }
+      return this->ApplyScalar(_values, i, _count, _colors, _indices,
+          written);
+    }
+#elif defined(GZ_GUI_COLORMAP_NEON)
+    /// \brief Color 4 values at a time, see Apply
+    /// \param[in] _values Values to color
+    /// \param[in] _count Number of values
+    /// \param[out] _colors Colors, see Apply
+    /// \param[out] _indices Indices, see Apply
+    /// \return Number of colors written
+    private: std::size_t ApplyNeon(const float *_values, std::size_t _count,
+        uint32_t *_colors, uint32_t *_indices) const
+    {
+      const float32x4_t minV = vdupq_n_f32(this->minValue);
+      const float32x4_t scaleV = vdupq_n_f32(this->scale);
+      const float32x4_t zero = vdupq_n_f32(0.0f);
+      const float32x4_t one = vdupq_n_f32(1.0f);
+      const float32x4_t max8 = vdupq_n_f32(255.0f);
+      const float32x4_t half = vdupq_n_f32(0.5f);
+
+      std::size_t written{0};
+      std::size_t i{0};
+      uint32_t packed[4];
+      uint32_t valid[4];
+      for (; i + 4 <= _count; i += 4)
+      {
+        const float32x4_t v = vld1q_f32(_values + i);
+        vst1q_u32(valid, vceqq_f32(v, v));
+
+        const float32x4_t ratio = vmulq_f32(vsubq_f32(v, minV), scaleV);
+        uint32x4_t rgba = vdupq_n_u32(0);
+        for (int c = 0; c < 4; ++c)
+        {
+          float32x4_t channel = vaddq_f32(vdupq_n_f32(this->base[c]),
+              vmulq_f32(vdupq_n_f32(this->delta[c]), ratio));
+          channel = vminnmq_f32(vmaxnmq_f32(channel, zero), one);
+          channel = vaddq_f32(vmulq_f32(channel, max8), half);
+          rgba = vorrq_u32(vshlq_n_u32(rgba, 8), vcvtq_u32_f32(channel));
+        }
+        vst1q_u32(packed, rgba);
+
+        // Compact the values which aren't NaN
+        for (int lane = 0; lane < 4; ++lane)
+        {
+          if (0 == valid[lane])
+            continue;
+          _colors[written] = packed[lane];
+          _indices[written] = static_cast<uint32_t>(i + lane);
+          written++;
+        }
+      }
+      return this->ApplyScalar(_values, i, _count, _colors, _indices,
+          written);
+    }
+#endif
+
+    /// \brief Value colored with the minimum color
+    private: float minValue;
+
+    /// \brief Inverse of the value range, 0 if the range is empty
+    private: float scale;
+
+    /// \brief Minimum color channels
+    private: float base[4];
+
+    /// \brief Difference between the maximum and minimum color channels
+    private: float delta[4];
+  };
+}  // namespace gz::gui::plugins
+
+#endif
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_GUI_PLUGINS_POINTCLOUD_PACKEDFIELD_HH_
+#define GZ_GUI_PLUGINS_POINTCLOUD_PACKEDFIELD_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define GZ_GUI_PACKEDFIELD_AVX2
+  #include <immintrin.h>
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Reads one field of every point of a packed point cloud, such
+  /// as its intensity, into a contiguous array.
+  ///
+  /// Points are `step` bytes apart, and the field is at the same offset
+  /// within each point. Float32 and int32 fields are gathered 8 points at a
+  /// time by the AVX2 kernel, which is picked at runtime on x86 CPUs that
+  /// support it. Other types, and other CPUs, are read one by one.
+  class PackedField
+  {
+    /// \brief Type of the field's values
+    public: enum class Type
+    {
+      INT8,
+      UINT8,
+      INT16,
+      UINT16,
+      INT32,
+      UINT32,
+      FLOAT32,
+      FLOAT64
+    };
+
+    /// \brief Constructor
+    /// \param[in] _offset Byte offset of the field within each point
+    /// \param[in] _type Type of its values
+    public: PackedField(std::size_t _offset, Type _type)
+      : offset(_offset), type(_type)
+    {
+    }
+
+    /// \brief Size of a value
+    /// \param[in] _type Type of the value
+    /// \return Size in bytes
+    public: static std::size_t Size(Type _type)
+    {
+      switch (_type)
+      {
+        case Type::INT8:
+        case Type::UINT8:
+          return 1;
+        case Type::INT16:
+        case Type::UINT16:
+          return 2;
+        case Type::FLOAT64:
+          return 8;
+        default:
+          return 4;
+      }
+    }
+
+    /// \brief Byte offset of the field within each point
+    /// \return Offset
+    public: std::size_t Offset() const
+    {
+      return this->offset;
+    }
+
+    /// \brief Read the field of each point as a float
+    /// \param[in] _data First point. Each point must be at least
+    /// `Offset() + Size(type)` bytes long.
+    /// \param[in] _count Number of points
+    /// \param[in] _step Bytes from one point to the next
+    /// \param[out] _values Value of each point. Must have room for `_count`
+    /// values.
+    public: void Read(const char *_data, std::size_t _count,
+        std::size_t _step, float *_values) const
+    {
+#if defined(GZ_GUI_PACKEDFIELD_AVX2)
+      static const bool avx2 = __builtin_cpu_supports("avx2");
+      // Lane offsets are 32 bit
+      if (avx2 && (this->type == Type::FLOAT32 || this->type == Type::INT32) &&
+          _step <= 0x7FFFFFFF / 8)
+      {
+        this->ReadAvx2(_data, _count, _step, _values);
+        return;
+      }
+#endif
+      this->ReadScalar(_data, 0, _count, _step, _values);
+    }
+
+    /// \brief Read the field of each point as a packed color, as stored in
+    /// the 4 byte "rgb" and "rgba" fields of PCL point clouds
+    /// \param[in] _data First point, see Read
+    /// \param[in] _count Number of points
+    /// \param[in] _step Bytes from one point to the next
+    /// \param[in] _alpha True if the field holds an alpha channel, packed
+    /// as 0xAARRGGBB. Otherwise the field is 0x00RRGGBB and colors are
+    /// opaque.
+    /// \param[out] _colors Color of each point, packed as RGBA8,
+    /// 0xRRGGBBAA. Must have room for `_count` colors.
+    public: void ReadColors(const char *_data, std::size_t _count,
+        std::size_t _step, bool _alpha, uint32_t *_colors) const
+    {
+      const char *field = _data + this->offset;
+      for (std::size_t i = 0; i < _count; ++i, field += _step)
+      {
+        uint32_t argb;
+        std::memcpy(&argb, field, sizeof(argb));
+        _colors[i] = (argb << 8) | (_alpha ? argb >> 24 : 0xFF);
+      }
+    }
+
+    /// \brief Read values one by one, see Read
+    /// \param[in] _data First point
+    /// \param[in] _begin Index of the first point read
+    /// \param[in] _end Index past the last point read
+    /// \param[in] _step Bytes from one point to the next
+    /// \param[out] _values Values, see Read
+    public: void ReadScalar(const char *_data, std::size_t _begin,
+        std::size_t _end, std::size_t _step, float *_values) const
+    {
+      switch (this->type)
+      {
+        case Type::INT8:
+          return this->ReadAs<int8_t>(_data, _begin, _end, _step, _values);
+        case Type::UINT8:
+          return this->ReadAs<uint8_t>(_data, _begin, _end, _step, _values);
+        case Type::INT16:
+          return this->ReadAs<int16_t>(_data, _begin, _end, _step, _values);
+        case Type::UINT16:
+          return this->ReadAs<uint16_t>(_data, _begin, _end, _step, _values);
+        case Type::INT32:
+          return this->ReadAs<int32_t>(_data, _begin, _end, _step, _values);
+        case Type::UINT32:
+          return this->ReadAs<uint32_t>(_data, _begin, _end, _step, _values);
+        case Type::FLOAT32:
+          return this->ReadAs<float>(_data, _begin, _end, _step, _values);
+        case Type::FLOAT64:
+          return this->ReadAs<double>(_data, _begin, _end, _step, _values);
+      }
+    }
+
+    /// \brief Read values of a given type, see Read
+    /// \param[in] _data First point
+    /// \param[in] _begin Index of the first point read
+    /// \param[in] _end Index past the last point read
+    /// \param[in] _step Bytes from one point to the next
+    /// \param[out] _values Values, see Read
+    private: template <typename T>
+    void ReadAs(const char *_data, std::size_t _begin, std::size_t _end,
+        std::size_t _step, float *_values) const
+    {
+      const char *field = _data + _begin * _step + this->offset;
+      for (std::size_t i = _begin; i < _end; ++i, field += _step)
+      {
+        T value;
+        std::memcpy(&value, field, sizeof(value));
+        _values[i] = static_cast<float>(value);
+      }
+    }
+
+#if defined(GZ_GUI_PACKEDFIELD_AVX2)
+    /// \brief Gather 8 float32 or int32 values at a time, see Read
+    /// \param[in] _data First point
+    /// \param[in] _count Number of points
+    /// \param[in] _step Bytes from one point to the next
+    /// \param[out] _values Values, see Read
+    private: __attribute__((target("avx2")))
+    void ReadAvx2(const char *_data, std::size_t _count, std::size_t _step,
+        float *_values) const
+    {
+      const int step = static_cast<int>(_step);
+      const __m256i lanes = _mm256_setr_epi32(0, step, 2 * step, 3 * step,
+          4 * step, 5 * step, 6 * step, 7 * step);
+      const bool isFloat = this->type == Type::FLOAT32;
+
+      // The base moves along, so lane offsets stay small on large clouds
+      const char *field = _data + this->offset;
+      std::size_t i{0};
+      for (; i + 8 <= _count; i += 8, field += 8 * _step)
+      {
+        __m256 v;
+        if (isFloat)
+        {
+          v = _mm256_i32gather_ps(reinterpret_cast<const float *>(field),
+              lanes, 1);
+        }
+        else
+        {
+          v = _mm256_cvtepi32_ps(_mm256_i32gather_epi32(
+              reinterpret_cast<const int *>(field), lanes, 1));
+        }
+        _mm256_storeu_ps(_values + i, v);
+      }
+      this->ReadScalar(_data, i, _count, _step, _values);
+    }
+#endif
+
+    /// \brief Byte offset of the field within each point
+    private: std::size_t offset;
+
+    /// \brief Type of the values
+    private: Type type;
+  };
+}  // namespace gz::gui::plugins
+
+#endif
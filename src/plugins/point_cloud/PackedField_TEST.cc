@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "PackedField.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Pack points with a value at an offset, after 12 bytes of x, y, z
+/// \param[in] _values Value of each point
+/// \param[in] _step Bytes per point
+/// \param[in] _offset Offset of the value
+/// \return Packed points
+template <typename T>
+std::vector<char> pack(const std::vector<T> &_values, std::size_t _step,
+    std::size_t _offset)
+{
+  std::vector<char> data(_values.size() * _step, 0x55);
+  for (std::size_t i = 0; i < _values.size(); ++i)
+    std::memcpy(data.data() + i * _step + _offset, &_values[i], sizeof(T));
+  return data;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(PackedFieldTest, Size)
+{
+  EXPECT_EQ(1u, PackedField::Size(PackedField::Type::INT8));
+  EXPECT_EQ(1u, PackedField::Size(PackedField::Type::UINT8));
+  EXPECT_EQ(2u, PackedField::Size(PackedField::Type::INT16));
+  EXPECT_EQ(2u, PackedField::Size(PackedField::Type::UINT16));
+  EXPECT_EQ(4u, PackedField::Size(PackedField::Type::INT32));
+  EXPECT_EQ(4u, PackedField::Size(PackedField::Type::UINT32));
+  EXPECT_EQ(4u, PackedField::Size(PackedField::Type::FLOAT32));
+  EXPECT_EQ(8u, PackedField::Size(PackedField::Type::FLOAT64));
+}
+
+/////////////////////////////////////////////////
+TEST(PackedFieldTest, ReadFloat)
+{
+  // Counts around the 8 point blocks, and an odd step
+  for (std::size_t count : {0u, 1u, 7u, 8u, 9u, 100u, 1003u})
+  {
+    std::vector<float> values(count);
+    for (std::size_t i = 0; i < count; ++i)
+      values[i] = static_cast<float>(i) * 0.5f - 3.0f;
+    const auto data = pack(values, 22, 13);
+
+    const PackedField field(13, PackedField::Type::FLOAT32);
+    std::vector<float> read(count, -1.0f);
+    field.Read(data.data(), count, 22, read.data());
+    EXPECT_EQ(values, read) << count;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PackedFieldTest, ReadIntegers)
+{
+  const std::size_t count{50};
+  std::vector<int32_t> ints(count);
+  std::vector<uint16_t> shorts(count);
+  std::vector<int8_t> bytes(count);
+  std::vector<double> doubles(count);
+  std::vector<float> expected(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ints[i] = static_cast<int32_t>(i) * 1000 - 20000;
+    shorts[i] = static_cast<uint16_t>(i * 1000);
+    bytes[i] = static_cast<int8_t>(static_cast<int>(i) - 25);
+    doubles[i] = static_cast<double>(i) * 0.25;
+  }
+
+  std::vector<float> read(count);
+  const PackedField intField(16, PackedField::Type::INT32);
+  intField.Read(pack(ints, 32, 16).data(), count, 32, read.data());
+  for (std::size_t i = 0; i < count; ++i)
+    EXPECT_EQ(static_cast<float>(ints[i]), read[i]);
+
+  const PackedField shortField(12, PackedField::Type::UINT16);
+  shortField.Read(pack(shorts, 16, 12).data(), count, 16, read.data());
+  for (std::size_t i = 0; i < count; ++i)
+    EXPECT_EQ(static_cast<float>(shorts[i]), read[i]);
+
+  const PackedField byteField(15, PackedField::Type::INT8);
+  byteField.Read(pack(bytes, 16, 15).data(), count, 16, read.data());
+  for (std::size_t i = 0; i < count; ++i)
+    EXPECT_EQ(static_cast<float>(bytes[i]), read[i]);
+
+  const PackedField doubleField(16, PackedField::Type::FLOAT64);
+  doubleField.Read(pack(doubles, 24, 16).data(), count, 24, read.data());
+  for (std::size_t i = 0; i < count; ++i)
+    EXPECT_EQ(static_cast<float>(doubles[i]), read[i]);
+}
+
+/////////////////////////////////////////////////
+TEST(PackedFieldTest, ReadColors)
+{
+  const std::vector<uint32_t> packed{0x00FF8000, 0x80102030};
+  const auto data = pack(packed, 32, 16);
+  const PackedField field(16, PackedField::Type::FLOAT32);
+
+  uint32_t colors[2];
+  field.ReadColors(data.data(), 2, 32, false, colors);
+  EXPECT_EQ(0xFF8000FFu, colors[0]);
+  EXPECT_EQ(0x102030FFu, colors[1]);
+
+  field.ReadColors(data.data(), 2, 32, true, colors);
+  EXPECT_EQ(0xFF800000u, colors[0]);
+  EXPECT_EQ(0x10203080u, colors[1]);
+}
@@ -16,47 +16,293 @@
  */
 
 #include "gz/msgs/boolean.pb.h"
+#include "gz/msgs/empty.pb.h"
 #include "gz/msgs/float_v.pb.h"
 #include "gz/msgs/marker.pb.h"
 #include "gz/msgs/pointcloud_packed.pb.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <gz/utils/ImplPtr.hh>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
-#include <gz/common/Profiler.hh>
+#include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
-#include <gz/msgs/PointCloudPackedUtils.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
 #include <gz/transport/Node.hh>
 
 #include <gz/gui/Application.hh>
+#include <gz/gui/AsyncRequests.hh>
 #include <gz/gui/Conversions.hh>
+#include <gz/gui/GpuUploads.hh>
 #include <gz/gui/GuiEvents.hh>
 #include <gz/gui/MainWindow.hh>
-
+#include <gz/gui/MarkerSink.hh>
+#include <gz/gui/MemoryAccounting.hh>
+#include <gz/gui/NodePool.hh>
+#include <gz/gui/ProfileZone.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/SceneServices.hh>
+#include <gz/gui/SubscriptionHub.hh>
+#include <gz/gui/TopicRegistry.hh>
+
+#include "Colormap.hh"
+#include "PackedField.hh"
 #include "PointCloud.hh"
+#include "PointCloudOctree.hh"
 
 namespace gz::gui::plugins
 {
+namespace
+{
+/// \brief Bytes of each point uploaded by markers, its position and color
+constexpr std::size_t kBytesPerPoint{sizeof(float) * 3 + sizeof(float) * 4};
+
+/// \brief Points ready to be rendered
+class RenderData
+{
+  /// \brief Point positions
+  public: std::vector<math::Vector3d> points;
+
+  /// \brief Box around `points`, unset if there are none
+  public: std::optional<math::AxisAlignedBox> bounds;
+
+  /// \brief Color of each point in `points`, packed as RGBA8
+  public: std::vector<uint32_t> colors;
+
+  /// \brief Size of each point
+  public: float pointSize{20};
+
+  /// \brief True if the points come from a new scan, which takes the next
+  /// accumulation slot. Otherwise they replace the latest scan.
+  public: bool newScan{false};
+
+  /// \brief True to clear all scans before adding these points
+  public: bool reset{false};
+};
+
+/// \brief How to reduce the number of points shown
+class Decimation
+{
+  /// \brief Keep one of every `stride` points
+  public: std::size_t stride{1};
+
+  /// \brief Keep one point per voxel of this size, 0 to disable
+  public: double voxelSize{0};
+
+  /// \brief Maximum number of points kept, 0 for no limit
+  public: std::size_t maxPoints{0};
+};
+
+/////////////////////////////////////////////////
+/// \brief Choose which points to keep
+/// \param[in] _points All points
+/// \param[in] _decimation How to reduce the points
+/// \return Indices in `_points` of the points kept, in increasing order
+std::vector<std::size_t> decimate(const std::vector<math::Vector3d> &_points,
+    const Decimation &_decimation)
+{
+  std::vector<std::size_t> kept;
+  const std::size_t stride = std::max<std::size_t>(1, _decimation.stride);
+  kept.reserve(_points.size() / stride + 1);
+
+  // Voxels are identified by their 21 bit coordinates on each axis, so
+  // voxels farther than 2M voxels apart may be merged
+  std::unordered_set<uint64_t> voxels;
+  auto cell = [&_decimation](double _v)
+  {
+    return static_cast<uint64_t>(static_cast<int64_t>(
+        std::floor(_v / _decimation.voxelSize))) & 0x1FFFFF;
+  };
+
+  for (std::size_t i = 0; i < _points.size(); i += stride)
+  {
+    if (_decimation.voxelSize > 0)
+    {
+      const auto &p = _points[i];
+      const uint64_t key =
+          (cell(p.X()) << 42) | (cell(p.Y()) << 21) | cell(p.Z());
+      if (!voxels.insert(key).second)
+        continue;
+    }
+    kept.push_back(i);
+  }
+
+  // Spread the budget evenly over the points left
+  const std::size_t maxPoints = _decimation.maxPoints;
+  if (maxPoints > 0 && kept.size() > maxPoints)
+  {
+    for (std::size_t i = 0; i < maxPoints; ++i)
+      kept[i] = kept[i * kept.size() / maxPoints];
+    kept.resize(maxPoints);
+  }
+
+  return kept;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a field of a point cloud, to color its points
+/// \param[in] _field Field
+/// \param[in] _pointStep Bytes per point
+/// \return The field, or nullopt if it isn't a single number within each
+/// point
+std::optional<PackedField> packedField(
+    const msgs::PointCloudPacked::Field &_field, std::size_t _pointStep)
+{
+  PackedField::Type type;
+  switch (_field.datatype())
+  {
+    case msgs::PointCloudPacked::Field::INT8:
+      type = PackedField::Type::INT8;
+      break;
+    case msgs::PointCloudPacked::Field::UINT8:
+      type = PackedField::Type::UINT8;
+      break;
+    case msgs::PointCloudPacked::Field::INT16:
+      type = PackedField::Type::INT16;
+      break;
+    case msgs::PointCloudPacked::Field::UINT16:
+      type = PackedField::Type::UINT16;
+      break;
+    case msgs::PointCloudPacked::Field::INT32:
+      type = PackedField::Type::INT32;
+      break;
+    case msgs::PointCloudPacked::Field::UINT32:
+      type = PackedField::Type::UINT32;
+      break;
+    case msgs::PointCloudPacked::Field::FLOAT32:
+      type = PackedField::Type::FLOAT32;
+      break;
+    case msgs::PointCloudPacked::Field::FLOAT64:
+      type = PackedField::Type::FLOAT64;
+      break;
+    default:
+      return std::nullopt;
+  }
+  if (_field.count() > 1 ||
+      _field.offset() + PackedField::Size(type) > _pointStep)
+  {
+    return std::nullopt;
+  }
+  return PackedField(_field.offset(), type);
+}
+
+/////////////////////////////////////////////////
+/// \brief Whether a field holds packed colors rather than values
+/// \param[in] _field Field
+/// \return True for 4 byte "rgb" and "rgba" fields
+bool isColorField(const msgs::PointCloudPacked::Field &_field)
+{
+  return (_field.name() == "rgb" || _field.name() == "rgba") &&
+      (_field.datatype() == msgs::PointCloudPacked::Field::FLOAT32 ||
+       _field.datatype() == msgs::PointCloudPacked::Field::UINT32 ||
+       _field.datatype() == msgs::PointCloudPacked::Field::INT32);
+}
+}  // namespace
+
 /// \brief Private data class for PointCloud
 class PointCloud::Implementation
 {
-  /// \brief Makes a request to populate the scene with markers
-  public: void PublishMarkers();
-
-  /// \brief Makes a request to delete all markers related to the point cloud.
+  /// \brief Update the visualization from the latest messages. The points
+  /// are rendered directly once a scene is available, and sent as markers
+  /// until then.
+  public: void UpdateVisual();
+
+  /// \brief Compute the points to render from the latest messages, reading
+  /// positions straight from the packed data.
+  /// \param[out] _data Points to render
+  /// \return False if the point cloud can't be rendered
+  public: bool BuildRenderData(RenderData &_data);
+
+  /// \brief Set the value range from the values of a point cloud field,
+  /// and notify the GUI
+  /// \param[in] _values Values, NaNs are skipped
+  /// \param[in] _count Number of values
+  public: void UpdateRange(const float *_values, std::size_t _count);
+
+  /// \brief Report the fields of the latest point cloud which can color
+  /// its points, if they changed
+  public: void ReportFields();
+
+  /// \brief Populate the scene with markers, through the MarkerSink if
+  /// there's one, or with a request otherwise
+  /// \param[in] _data Points to render, moved out
+  public: void PublishMarkers(RenderData &&_data);
+
+  /// \brief Delete all points, or makes a request to delete all markers
+  /// related to the point cloud.
   public: void ClearMarkers();
 
-  /// \brief Transport node
-  public: gz::transport::Node node {gz::transport::NodeOptions()};
+  /// \brief Render callback, creates the markers and stages new points
+  /// for upload
+  public: void OnRender();
+
+  /// \brief Upload a scan to its slot. Called on the render thread.
+  /// \param[in] _data Points of the scan
+  public: void Upload(const RenderData &_data);
+
+  /// \brief Open the map and read its options
+  /// \param[in] _elem The `<map>` element
+  public: void LoadMap(const tinyxml2::XMLElement *_elem);
+
+  /// \brief Show the map nodes chosen for the user camera, loading a few
+  /// missing ones and unloading the least recently used ones past the
+  /// cache budget. Called on the render thread.
+  public: void RenderMap();
+
+  /// \brief Ask the worker to update the visualization
+  public: void RequestUpdate();
+
+  /// \brief Worker thread loop, updates the visualization when requested
+  public: void RunWorker();
+
+  /// \brief Stop the worker thread and wait for it to finish
+  public: void StopWorker();
+
+  /// \brief Subscription to the point cloud topic, shared with other
+  /// plugins
+  public: HubSubscription pointCloudSubscription;
+
+  /// \brief Subscription to the float vector topic, shared with other
+  /// plugins
+  public: HubSubscription floatVSubscription;
+
+  /// \brief Most messages per second to receive on each topic, 0 for all
+  public: double maxRate{0.0};
+
+  /// \brief True to receive the topics through shared memory from
+  /// publishers on the same host
+  public: bool sharedMemory{true};
+
+  /// \brief True to publish how fast the topics are consumed, so their
+  /// publishers can adapt
+  public: bool feedback{false};
 
   /// \brief Name of topic for PointCloudPacked
   public: std::string pointCloudTopic{""};
@@ -70,20 +316,70 @@ class PointCloud::Implementation
   /// \brief List of topics publishing FloatV.
   public: QStringList floatVTopicList;
 
-  /// \brief Protect variables changed from transport and the user
+  /// \brief Field of the point cloud coloring the points, empty to color
+  /// them with the float vector. Protected by `mutex`.
+  public: std::string colorField;
+
+  /// \brief Fields of the latest point cloud which can color its points.
+  /// Only accessed from the main thread.
+  public: QStringList colorFieldList;
+
+  /// \brief Fields last reported to the GUI. Only used by the worker.
+  public: std::vector<std::string> reportedFields;
+
+  /// \brief Called from the worker with the fields of a new point cloud
+  public: std::function<void(const std::vector<std::string> &)> fieldsCb;
+
+  /// \brief Called from the worker when the value range was set from a
+  /// point cloud field
+  public: std::function<void()> rangeCb;
+
+  /// \brief Protect variables changed by the user and the pending points.
+  /// Never locked from transport callbacks.
   public: std::recursive_mutex mutex;
 
-  /// \brief Point cloud message containing XYZ positions
-  public: gz::msgs::PointCloudPacked pointCloudMsg;
+  /// \brief Protects the latest messages and `droppedFrames`. Only held
+  /// to swap pointers, so transport callbacks never wait on the worker.
+  public: std::mutex msgMutex;
+
+  /// \brief Latest point cloud message containing XYZ positions
+  public: std::shared_ptr<const gz::msgs::PointCloudPacked> latestCloud;
+
+  /// \brief Latest message holding a float vector.
+  public: std::shared_ptr<const gz::msgs::Float_V> latestFloatV;
+
+  /// \brief True if a message arrived since the worker last took them
+  public: bool msgsChanged{false};
+
+  /// \brief True if `latestCloud` hasn't been taken by the worker yet
+  public: bool cloudPending{false};
+
+  /// \brief Number of point clouds replaced before the worker took them
+  public: uint64_t droppedFrames{0};
 
-  /// \brief Message holding a float vector.
-  public: gz::msgs::Float_V floatVMsg;
+  /// \brief Last dropped frame count reported. Only used by the worker.
+  public: uint64_t reportedDropped{0};
+
+  /// \brief Called from the worker with the number of dropped frames
+  public: std::function<void(uint64_t)> droppedFramesCb;
+
+  /// \brief Dropped frames shown on the GUI. Only accessed from the main
+  /// thread.
+  public: int droppedFramesGui{0};
+
+  /// \brief Point cloud the worker builds render data from. Only used by
+  /// the worker.
+  public: std::shared_ptr<const gz::msgs::PointCloudPacked> pointCloudMsg;
+
+  /// \brief Float vector the worker colors points with. Only used by the
+  /// worker.
+  public: std::shared_ptr<const gz::msgs::Float_V> floatVMsg;
 
   /// \brief Minimum value in latest float vector
-  public: float minFloatV{std::numeric_limits<float>::max()};
+  public: std::atomic<float> minFloatV{std::numeric_limits<float>::max()};
 
   /// \brief Maximum value in latest float vector
-  public: float maxFloatV{-std::numeric_limits<float>::max()};
+  public: std::atomic<float> maxFloatV{-std::numeric_limits<float>::max()};
 
   /// \brief Color for minimum value, changeable at runtime
   public: gz::math::Color minColor{1.0f, 0.0f, 0.0f, 1.0f};
@@ -95,7 +391,112 @@ class PointCloud::Implementation
   public: float pointSize{20};
 
   /// \brief True if showing, changeable at runtime
-  public: bool showing{true};
+  public: std::atomic<bool> showing{true};
+
+  /// \brief How to reduce the number of points shown
+  public: Decimation decimation;
+
+  /// \brief Index in the point cloud of each point kept after decimation.
+  /// The kept points are only used by the worker.
+  public: std::vector<uint32_t> keptIndices;
+
+  /// \brief Position of each point in `keptIndices`
+  public: std::vector<math::Vector3d> keptPoints;
+
+  /// \brief True if `keptIndices` is up to date with the latest messages
+  public: bool keptValid{false};
+
+  /// \brief Field the kept points were colored with, empty for the float
+  /// vector. Only used by the worker.
+  public: std::string keptField;
+
+  /// \brief Protects `updateRequested` and `stopping`
+  public: std::mutex workerMutex;
+
+  /// \brief Notifies the worker
+  public: std::condition_variable workerCv;
+
+  /// \brief True if the visualization must be updated
+  public: bool updateRequested{false};
+
+  /// \brief True when the worker must exit
+  public: bool stopping{false};
+
+  /// \brief Builds the points to render off the GUI and transport threads
+  public: std::thread worker;
+
+  /// \brief True once points are rendered directly instead of sent to the
+  /// marker manager
+  public: std::atomic<bool> direct{false};
+
+  /// \brief Points waiting to be uploaded on the next frame
+  public: RenderData pending;
+
+  /// \brief True if `pending` has changed since the last upload
+  public: bool pendingDirty{false};
+
+  /// \brief Scene the points are rendered in. Only accessed from the render
+  /// thread, and by the destructor once rendering stopped.
+  public: rendering::ScenePtr scene{nullptr};
+
+  /// \brief Number of scans shown at once
+  public: std::size_t scanCount{1};
+
+  /// \brief True to fade older scans out
+  public: bool fade{false};
+
+  /// \brief Visual holding the markers
+  public: rendering::VisualPtr visual{nullptr};
+
+  /// \brief Ring of markers, one per scan, created up front and reused
+  /// once all have been filled
+  public: std::vector<rendering::MarkerPtr> slots;
+
+  /// \brief Slot holding the latest scan
+  public: std::size_t latestSlot{0};
+
+  /// \brief Map shown, if any
+  public: PointCloudOctree octree;
+
+  /// \brief Largest spacing between map points shown, in pixels
+  public: double mapMaxError{2.0};
+
+  /// \brief Most map points shown at once
+  public: std::size_t mapPointBudget{5000000};
+
+  /// \brief Most map points kept loaded, shown or not
+  public: std::size_t mapCachePoints{10000000};
+
+  /// \brief Most map nodes loaded each frame
+  public: std::size_t mapNodesPerFrame{16};
+
+  /// \brief Visual holding the map nodes
+  public: rendering::VisualPtr mapVisual{nullptr};
+
+  /// \brief Visual of each loaded map node, by node index
+  public: std::unordered_map<uint32_t, rendering::VisualPtr> mapNodes;
+
+  /// \brief Last use of the loaded map nodes
+  public: OctreeNodeCache mapCache;
+
+  /// \brief Camera pose the map nodes were last chosen for
+  public: math::Pose3d mapCameraPose;
+
+  /// \brief True while nodes chosen for the camera aren't loaded yet
+  public: bool mapLoading{true};
+
+  /// \brief Point size of the loaded map nodes
+  public: float mapPointSize{0};
+
+  /// \brief Graphics memory taken by the loaded map nodes
+  public: MemoryAccount mapMemory{"PointCloud", "map", MemoryType::GPU};
+
+  /// \brief Scans waiting to be uploaded, within the scene's upload budget
+  public: GpuUploadQueue uploads{"PointCloud"};
+
+  /// \brief Keeps the render callback registered. Last member so it's
+  /// destroyed first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
 };
 
 /////////////////////////////////////////////////
@@ -107,7 +508,33 @@ PointCloud::PointCloud()
 /////////////////////////////////////////////////
 PointCloud::~PointCloud()
 {
-  this->dataPtr->ClearMarkers();
+  this->dataPtr->pointCloudSubscription.Reset();
+  this->dataPtr->floatVSubscription.Reset();
+  if (auto *app = App())
+    app->Requests()->CancelOwner(this);
+  this->dataPtr->StopWorker();
+  this->dataPtr->uploads.Clear();
+  this->dataPtr->renderConnection.reset();
+  if (!this->dataPtr->direct)
+  {
+    this->dataPtr->ClearMarkers();
+    return;
+  }
+
+  // Rendering calls must be made from the render thread, so destroy the
+  // visual from a callback which disconnects itself
+  auto scene = this->dataPtr->scene;
+  auto visual = this->dataPtr->visual;
+  auto mapVisual = this->dataPtr->mapVisual;
+  auto connection = std::make_shared<RenderHookConnectionPtr>();
+  *connection = RenderHooks::OnRender([scene, visual, mapVisual, connection]()
+  {
+    scene->DestroyVisual(visual);
+    if (mapVisual)
+      scene->DestroyVisual(mapVisual, true /* recursive */);
+    connection->reset();
+  });
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -119,6 +546,33 @@ void PointCloud::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   // Parameters from XML
   if (_pluginElem)
   {
+    // Before subscribing to the topics
+    if (auto rateElem = _pluginElem->FirstChildElement("max_rate"))
+    {
+      double maxRate{0.0};
+      if (rateElem->QueryDoubleText(&maxRate) != tinyxml2::XML_SUCCESS ||
+          maxRate < 0)
+      {
+        gzerr << "Failed to parse <max_rate> value: "
+               << rateElem->GetText() << std::endl;
+      }
+      else
+      {
+        this->dataPtr->maxRate = maxRate;
+      }
+    }
+
+    if (auto shmElem = _pluginElem->FirstChildElement("shared_memory"))
+      shmElem->QueryBoolText(&this->dataPtr->sharedMemory);
+
+    if (auto feedbackElem = _pluginElem->FirstChildElement("feedback"))
+      feedbackElem->QueryBoolText(&this->dataPtr->feedback);
+
+    // Before the float vector topic, which isn't subscribed to then
+    auto colorFieldElem = _pluginElem->FirstChildElement("color_field");
+    if (nullptr != colorFieldElem && nullptr != colorFieldElem->GetText())
+      this->SetColorField(colorFieldElem->GetText());
+
     auto pointCloudTopicElem =
         _pluginElem->FirstChildElement("point_cloud_topic");
     if (nullptr != pointCloudTopicElem &&
@@ -137,36 +591,474 @@ void PointCloud::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       this->OnFloatVTopic(this->dataPtr->floatVTopicList.at(0));
     }
 
+    auto &decimation = this->dataPtr->decimation;
+    if (auto elem = _pluginElem->FirstChildElement("decimation"))
+    {
+      int value{0};
+      auto strideElem = elem->FirstChildElement("stride");
+      if (nullptr != strideElem)
+      {
+        if (strideElem->QueryIntText(&value) != tinyxml2::XML_SUCCESS ||
+            value < 1)
+        {
+          gzerr << "Failed to parse <stride> value: "
+                 << strideElem->GetText() << std::endl;
+        }
+        else
+        {
+          decimation.stride = static_cast<std::size_t>(value);
+        }
+      }
+
+      auto voxelElem = elem->FirstChildElement("voxel_size");
+      if (nullptr != voxelElem)
+      {
+        double voxelSize{0};
+        if (voxelElem->QueryDoubleText(&voxelSize) != tinyxml2::XML_SUCCESS ||
+            voxelSize < 0)
+        {
+          gzerr << "Failed to parse <voxel_size> value: "
+                 << voxelElem->GetText() << std::endl;
+        }
+        else
+        {
+          decimation.voxelSize = voxelSize;
+        }
+      }
+
+      auto maxElem = elem->FirstChildElement("max_points");
+      if (nullptr != maxElem)
+      {
+        if (maxElem->QueryIntText(&value) != tinyxml2::XML_SUCCESS ||
+            value < 0)
+        {
+          gzerr << "Failed to parse <max_points> value: "
+                 << maxElem->GetText() << std::endl;
+        }
+        else
+        {
+          decimation.maxPoints = static_cast<std::size_t>(value);
+        }
+      }
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("map"))
+      this->dataPtr->LoadMap(elem);
+
+    if (auto elem = _pluginElem->FirstChildElement("accumulation"))
+    {
+      auto scansElem = elem->FirstChildElement("scans");
+      int scans{1};
+      if (nullptr != scansElem)
+      {
+        if (scansElem->QueryIntText(&scans) != tinyxml2::XML_SUCCESS ||
+            scans < 1)
+        {
+          gzerr << "Failed to parse <scans> value: "
+                 << scansElem->GetText() << std::endl;
+        }
+        else
+        {
+          this->dataPtr->scanCount = static_cast<std::size_t>(scans);
+        }
+      }
+
+      auto fadeElem = elem->FirstChildElement("fade");
+      if (nullptr != fadeElem &&
+          fadeElem->QueryBoolText(&this->dataPtr->fade) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Failed to parse <fade> value: "
+               << fadeElem->GetText() << std::endl;
+      }
+    }
   }
 
   gz::gui::App()->findChild<
     gz::gui::MainWindow *>()->installEventFilter(this);
+
+  // Called from the worker thread
+  this->dataPtr->droppedFramesCb = [this](uint64_t _dropped)
+  {
+    QMetaObject::invokeMethod(this, "SetDroppedFrames", Qt::QueuedConnection,
+        Q_ARG(int, static_cast<int>(_dropped)));
+  };
+  this->dataPtr->fieldsCb = [this](const std::vector<std::string> &_fields)
+  {
+    QStringList fields;
+    for (const auto &field : _fields)
+      fields.push_back(QString::fromStdString(field));
+    QMetaObject::invokeMethod(this, "SetColorFieldList",
+        Qt::QueuedConnection, Q_ARG(QStringList, fields));
+  };
+  this->dataPtr->rangeCb = [this]()
+  {
+    QMetaObject::invokeMethod(this, [this]()
+    {
+      emit this->MinFloatVChanged();
+      emit this->MaxFloatVChanged();
+    }, Qt::QueuedConnection);
+  };
+
+  this->dataPtr->worker = std::thread(&Implementation::RunWorker,
+      this->dataPtr.get());
+  this->dataPtr->RequestUpdate();
+
+  this->dataPtr->renderConnection = RenderHooks::OnRender(
+      [this]()
+      {
+        this->dataPtr->OnRender();
+      }, 0, "PointCloud");
 }
 
 //////////////////////////////////////////////////
-void PointCloud::OnPointCloudTopic(const QString &_pointCloudTopic)
+void PointCloud::Implementation::LoadMap(const tinyxml2::XMLElement *_elem)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-  // Unsubscribe from previous choice
-  if (!this->dataPtr->pointCloudTopic.empty() &&
-      !this->dataPtr->node.Unsubscribe(this->dataPtr->pointCloudTopic))
+  auto fileElem = _elem->FirstChildElement("file");
+  if (nullptr == fileElem || nullptr == fileElem->GetText())
+  {
+    gzerr << "<map> needs a <file>" << std::endl;
+    return;
+  }
+
+  if (auto elem = _elem->FirstChildElement("max_error"))
+  {
+    double value{0};
+    if (elem->QueryDoubleText(&value) != tinyxml2::XML_SUCCESS || value <= 0)
+    {
+      gzerr << "Failed to parse <max_error> value: " << elem->GetText()
+             << std::endl;
+    }
+    else
+    {
+      this->mapMaxError = value;
+    }
+  }
+
+  auto count = [](const tinyxml2::XMLElement *_parent, const char *_name,
+      std::size_t &_value)
+  {
+    auto elem = _parent->FirstChildElement(_name);
+    if (nullptr == elem)
+      return;
+    int64_t value{0};
+    if (elem->QueryInt64Text(&value) != tinyxml2::XML_SUCCESS || value < 1)
+    {
+      gzerr << "Failed to parse <" << _name << "> value: "
+             << elem->GetText() << std::endl;
+      return;
+    }
+    _value = static_cast<std::size_t>(value);
+  };
+  count(_elem, "point_budget", this->mapPointBudget);
+  count(_elem, "cache_points", this->mapCachePoints);
+  count(_elem, "nodes_per_frame", this->mapNodesPerFrame);
+  this->mapCachePoints = std::max(this->mapCachePoints, this->mapPointBudget);
+
+  const std::string path = fileElem->GetText();
+  if (this->octree.Open(path))
+  {
+    gzmsg << "Showing [" << this->octree.PointCount() << "] points of map ["
+           << path << "]" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::RequestUpdate()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->updateRequested = true;
+  }
+  this->workerCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::RunWorker()
+{
+  std::unique_lock<std::mutex> lock(this->workerMutex);
+  while (true)
+  {
+    this->workerCv.wait(lock, [this]
+    {
+      return this->updateRequested || this->stopping;
+    });
+    if (this->stopping)
+      return;
+
+    this->updateRequested = false;
+    lock.unlock();
+    this->UpdateVisual();
+    lock.lock();
+  }
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::StopWorker()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->stopping = true;
+  }
+  this->workerCv.notify_one();
+  if (this->worker.joinable())
+    this->worker.join();
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::OnRender()
+{
+  if (nullptr == this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+
+    this->visual = this->scene->CreateVisual();
+
+    // Unlit, so points show their own color
+    rendering::MaterialPtr material = this->scene->CreateMaterial();
+    material->SetDiffuse(math::Color::White);
+    material->SetLightingEnabled(false);
+    for (std::size_t i = 0; i < this->scanCount; ++i)
+    {
+      auto marker = this->scene->CreateMarker();
+      marker->SetType(rendering::MarkerType::MT_POINTS);
+
+      // Each slot gets its own copy, so it can fade independently
+      marker->SetMaterial(material, true /* clone */);
+      this->visual->AddGeometry(marker);
+      this->slots.push_back(marker);
+    }
+    this->scene->DestroyMaterial(material);
+    this->latestSlot = this->scanCount - 1;
+
+    this->scene->RootVisual()->AddChild(this->visual);
+
+    // Switch over from markers
+    this->ClearMarkers();
+    this->direct = true;
+    this->RequestUpdate();
+  }
+
+  this->visual->SetVisible(this->showing);
+  this->RenderMap();
+
+  // Newer points are merged into the pending ones until the previous scan
+  // is uploaded
+  RenderData data;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    if (!this->pendingDirty || this->uploads.Size() > 0)
+      return;
+    std::swap(data, this->pending);
+    this->pendingDirty = false;
+  }
+
+  const std::size_t bytes = data.points.size() * kBytesPerPoint;
+  const auto bounds = data.bounds;
+  this->uploads.Push(bytes, [this, data = std::move(data)]()
+      {
+        this->Upload(data);
+      }, bounds);
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::Upload(const RenderData &_data)
+{
+  GZ_GUI_PROFILE("PointCloud::Upload");
+  if (_data.reset)
+  {
+    for (auto &slot : this->slots)
+      slot->ClearPoints();
+    this->latestSlot = this->scanCount - 1;
+  }
+
+  // Only the slot of the new scan is uploaded, reusing the oldest one
+  if (_data.newScan)
+    this->latestSlot = (this->latestSlot + 1) % this->scanCount;
+
+  auto &marker = this->slots[this->latestSlot];
+  marker->ClearPoints();
+  math::Color color;
+  for (std::size_t i = 0; i < _data.points.size(); ++i)
+  {
+    color.SetFromRGBA(_data.colors[i]);
+    marker->AddPoint(_data.points[i], color);
+  }
+
+  for (std::size_t age = 0; age < this->scanCount; ++age)
+  {
+    auto &slot = this->slots[
+        (this->latestSlot + this->scanCount - age) % this->scanCount];
+    slot->SetSize(_data.pointSize);
+    if (this->fade && _data.newScan)
+    {
+      slot->Material()->SetTransparency(
+          static_cast<double>(age) / this->scanCount);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::RenderMap()
+{
+  if (!this->octree.IsOpen())
+    return;
+
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (nullptr == camera)
+    return;
+
+  if (nullptr == this->mapVisual)
+  {
+    this->mapVisual = this->scene->CreateVisual();
+    this->scene->RootVisual()->AddChild(this->mapVisual);
+  }
+  this->mapVisual->SetVisible(this->showing);
+
+  float pointSize;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    pointSize = this->pointSize;
+  }
+  if (pointSize != this->mapPointSize)
   {
-    gzerr << "Unable to unsubscribe from topic ["
-           << this->dataPtr->pointCloudTopic <<"]" <<std::endl;
+    for (auto &[index, nodeVisual] : this->mapNodes)
+    {
+      auto marker = std::dynamic_pointer_cast<rendering::Marker>(
+          nodeVisual->GeometryByIndex(0));
+      if (marker)
+        marker->SetSize(pointSize);
+    }
+    this->mapPointSize = pointSize;
   }
 
+  // Nodes only change when the camera moves, or while they're loading
+  const math::Pose3d cameraPose = camera->WorldPose();
+  if (!this->mapLoading && cameraPose == this->mapCameraPose)
+    return;
+  this->mapCameraPose = cameraPose;
+
+  GZ_GUI_PROFILE("PointCloud::RenderMap");
+  const double tanH = std::tan(camera->HFOV().Radian() * 0.5);
+  const double tanV = tanH / std::max(1e-6, camera->AspectRatio());
+  PointCloudOctree::View view;
+  view.position = cameraPose.Pos();
+  view.direction = cameraPose.Rot().RotateVector(math::Vector3d::UnitX);
+  view.halfAngle = std::atan(std::sqrt(tanH * tanH + tanV * tanV));
+  view.pixelsPerRadian = camera->ImageHeight() / (2.0 * std::atan(tanV));
+  const auto selected = this->octree.Select(view, this->mapMaxError,
+      this->mapPointBudget);
+  const std::unordered_set<uint32_t> shown(selected.begin(),
+      selected.end());
+
+  // Coarsest first, so holes are filled before details are added, up to the
+  // frame's node count and upload budget. Nodes loaded on later frames are
+  // prefetched, so reading them doesn't wait for the disk.
+  std::size_t loaded{0};
+  this->mapLoading = false;
+  math::Color color;
+  for (const auto index : selected)
+  {
+    if (this->mapCache.Touch(index))
+      continue;
+
+    this->mapLoading = true;
+    if (loaded >= this->mapNodesPerFrame ||
+        (loaded > 0 && GpuUploads::BudgetLeft() == 0))
+    {
+      if (loaded++ < 2 * this->mapNodesPerFrame)
+        this->octree.Prefetch(index);
+      continue;
+    }
+    ++loaded;
+
+    const auto &node = this->octree.NodeAt(index);
+    const OctreePoint *points = this->octree.Points(index);
+    auto marker = this->scene->CreateMarker();
+    marker->SetType(rendering::MarkerType::MT_POINTS);
+    marker->SetSize(this->mapPointSize);
+    rendering::MaterialPtr material = this->scene->CreateMaterial();
+    material->SetDiffuse(math::Color::White);
+    material->SetLightingEnabled(false);
+    marker->SetMaterial(material, true /* clone */);
+    this->scene->DestroyMaterial(material);
+    for (uint32_t i = 0; i < node.pointCount; ++i)
+    {
+      color.SetFromRGBA(points[i].rgba);
+      marker->AddPoint(math::Vector3d(points[i].x, points[i].y,
+          points[i].z), color);
+    }
+
+    auto nodeVisual = this->scene->CreateVisual();
+    nodeVisual->AddGeometry(marker);
+    this->mapVisual->AddChild(nodeVisual);
+    this->mapNodes[index] = nodeVisual;
+    this->mapCache.Insert(index, node.pointCount);
+    this->uploads.Uploaded(node.pointCount * kBytesPerPoint);
+  }
+
+  for (auto &[index, nodeVisual] : this->mapNodes)
+    nodeVisual->SetVisible(shown.count(index) > 0);
+
+  for (const auto index : this->mapCache.Evict(this->mapCachePoints,
+      [&shown](uint32_t _index)
+      {
+        return shown.count(_index) > 0;
+      }))
+  {
+    auto it = this->mapNodes.find(index);
+    this->scene->DestroyVisual(it->second, true /* recursive */);
+    this->mapNodes.erase(it);
+  }
+
+  this->mapMemory.Set(this->mapCache.Points() * kBytesPerPoint);
+
+  if (this->mapLoading)
+    RenderHooks::RequestRender();
+}
+
+//////////////////////////////////////////////////
+void PointCloud::OnPointCloudTopic(const QString &_pointCloudTopic)
+{
+  // Unsubscribe from previous choice
+  this->dataPtr->pointCloudSubscription.Reset();
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+
   // Clear visualization
   this->dataPtr->ClearMarkers();
 
   this->dataPtr->pointCloudTopic = _pointCloudTopic.toStdString();
 
   // Request service
-  this->dataPtr->node.Request(this->dataPtr->pointCloudTopic,
-      &PointCloud::OnPointCloudService, this);
+  App()->Requests()->Request<msgs::Empty, msgs::PointCloudPacked>(
+      this->dataPtr->pointCloudTopic, msgs::Empty(),
+      [this](const RequestResult<msgs::PointCloudPacked> &_res)
+      {
+        // Topics without a service just time out
+        if (_res.status != RequestStatus::TIMED_OUT)
+          this->OnPointCloudService(_res.reply,
+              _res.status == RequestStatus::OK);
+      }, {std::chrono::seconds(5), RequestThread::POOL, this});
 
   // Create new subscription
-  if (!this->dataPtr->node.Subscribe(this->dataPtr->pointCloudTopic,
-                            &PointCloud::OnPointCloud, this))
+  App()->Subscriptions()->SetSharedMemory(this->dataPtr->pointCloudTopic,
+      this->dataPtr->sharedMemory);
+  App()->Subscriptions()->SetFeedback(this->dataPtr->pointCloudTopic,
+      this->dataPtr->feedback);
+  this->dataPtr->pointCloudSubscription = App()->Subscriptions()->Subscribe(
+      this->dataPtr->pointCloudTopic,
+      [this](const std::shared_ptr<const google::protobuf::Message> &_msg)
+      {
+        auto msg =
+            std::dynamic_pointer_cast<const msgs::PointCloudPacked>(_msg);
+        if (msg)
+          this->OnPointCloud(msg);
+      }, this->dataPtr->maxRate);
+  if (!this->dataPtr->pointCloudSubscription.Valid())
   {
     gzerr << "Unable to subscribe to topic ["
            << this->dataPtr->pointCloudTopic << "]\n";
@@ -178,27 +1070,45 @@ void PointCloud::OnPointCloudTopic(const QString &_pointCloudTopic)
 //////////////////////////////////////////////////
 void PointCloud::OnFloatVTopic(const QString &_floatVTopic)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
   // Unsubscribe from previous choice
-  if (!this->dataPtr->floatVTopic.empty() &&
-      !this->dataPtr->node.Unsubscribe(this->dataPtr->floatVTopic))
-  {
-    gzerr << "Unable to unsubscribe from topic ["
-           << this->dataPtr->floatVTopic <<"]" <<std::endl;
-  }
+  this->dataPtr->floatVSubscription.Reset();
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
 
   // Clear visualization
   this->dataPtr->ClearMarkers();
 
   this->dataPtr->floatVTopic = _floatVTopic.toStdString();
 
+  // Points are colored by a field of the cloud, the topic is subscribed to
+  // once the field is cleared
+  if (!this->dataPtr->colorField.empty())
+    return;
+
   // Request service
-  this->dataPtr->node.Request(this->dataPtr->floatVTopic,
-      &PointCloud::OnFloatVService, this);
+  App()->Requests()->Request<msgs::Empty, msgs::Float_V>(
+      this->dataPtr->floatVTopic, msgs::Empty(),
+      [this](const RequestResult<msgs::Float_V> &_res)
+      {
+        // Topics without a service just time out
+        if (_res.status != RequestStatus::TIMED_OUT)
+          this->OnFloatVService(_res.reply, _res.status == RequestStatus::OK);
+      }, {std::chrono::seconds(5), RequestThread::POOL, this});
 
   // Create new subscription
-  if (!this->dataPtr->node.Subscribe(this->dataPtr->floatVTopic,
-                            &PointCloud::OnFloatV, this))
+  App()->Subscriptions()->SetSharedMemory(this->dataPtr->floatVTopic,
+      this->dataPtr->sharedMemory);
+  App()->Subscriptions()->SetFeedback(this->dataPtr->floatVTopic,
+      this->dataPtr->feedback);
+  this->dataPtr->floatVSubscription = App()->Subscriptions()->Subscribe(
+      this->dataPtr->floatVTopic,
+      [this](const std::shared_ptr<const google::protobuf::Message> &_msg)
+      {
+        auto msg = std::dynamic_pointer_cast<const msgs::Float_V>(_msg);
+        if (msg)
+          this->OnFloatV(msg);
+      }, this->dataPtr->maxRate);
+  if (!this->dataPtr->floatVSubscription.Valid())
   {
     gzerr << "Unable to subscribe to topic ["
            << this->dataPtr->floatVTopic << "]\n";
@@ -213,7 +1123,12 @@ void PointCloud::Show(bool _show)
   this->dataPtr->showing = _show;
   if (_show)
   {
-    this->dataPtr->PublishMarkers();
+    this->dataPtr->RequestUpdate();
+  }
+  else if (this->dataPtr->direct)
+  {
+    // Hidden on the next frame
+    RenderHooks::RequestRender();
   }
   else
   {
@@ -232,26 +1147,16 @@ void PointCloud::OnRefresh()
   this->dataPtr->floatVTopicList.clear();
 
   // Get updated list
-  std::vector<std::string> allTopics;
-  this->dataPtr->node.TopicList(allTopics);
-  for (const auto &topic : allTopics)
-  {
-    std::vector<gz::transport::MessagePublisher> publishers;
-    std::vector<gz::transport::MessagePublisher> subscribers;
-    this->dataPtr->node.TopicInfo(topic, publishers, subscribers);
-    for (const auto &pub : publishers)
-    {
-      if (pub.MsgTypeName() == "gz.msgs.PointCloudPacked")
-      {
-        this->dataPtr->pointCloudTopicList.push_back(
-            QString::fromStdString(topic));
-      }
-      else if (pub.MsgTypeName() == "gz.msgs.Float_V")
-      {
-        this->dataPtr->floatVTopicList.push_back(QString::fromStdString(topic));
-      }
-    }
+  auto registry = App()->Topics();
+  registry->Scan();
+  for (const auto &topic : registry->Topics("gz.msgs.PointCloudPacked"))
+  {
+    this->dataPtr->pointCloudTopicList.push_back(
+        QString::fromStdString(topic));
   }
+  for (const auto &topic : registry->Topics("gz.msgs.Float_V"))
+    this->dataPtr->floatVTopicList.push_back(QString::fromStdString(topic));
+
   // Handle floats first, so by the time we get the point cloud it can be
   // colored
   if (!this->dataPtr->floatVTopicList.empty())
@@ -295,38 +1200,122 @@ void PointCloud::SetFloatVTopicList(
   emit this->FloatVTopicListChanged();
 }
 
+/////////////////////////////////////////////////
+QStringList PointCloud::ColorFieldList() const
+{
+  return this->dataPtr->colorFieldList;
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetColorFieldList(const QStringList &_colorFieldList)
+{
+  this->dataPtr->colorFieldList = _colorFieldList;
+  emit this->ColorFieldListChanged();
+}
+
+/////////////////////////////////////////////////
+QString PointCloud::ColorField() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return QString::fromStdString(this->dataPtr->colorField);
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetColorField(const QString &_colorField)
+{
+  const std::string field = _colorField.toStdString();
+  std::string floatVTopic;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    if (field == this->dataPtr->colorField)
+      return;
+    this->dataPtr->colorField = field;
+    floatVTopic = this->dataPtr->floatVTopic;
+  }
+
+  if (!field.empty())
+  {
+    // Values come with the point cloud, drop the float vectors
+    this->dataPtr->floatVSubscription.Reset();
+    std::lock_guard<std::mutex> lock(this->dataPtr->msgMutex);
+    this->dataPtr->latestFloatV.reset();
+    this->dataPtr->msgsChanged = true;
+  }
+  else if (!floatVTopic.empty())
+  {
+    this->OnFloatVTopic(QString::fromStdString(floatVTopic));
+  }
+
+  emit this->ColorFieldChanged();
+  this->dataPtr->RequestUpdate();
+}
+
 //////////////////////////////////////////////////
 void PointCloud::OnPointCloud(
     const gz::msgs::PointCloudPacked &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->pointCloudMsg = _msg;
-  this->dataPtr->PublishMarkers();
+  // Copy outside of the lock, then only swap the pointer
+  this->OnPointCloud(std::make_shared<const gz::msgs::PointCloudPacked>(_msg));
+}
+
+//////////////////////////////////////////////////
+void PointCloud::OnPointCloud(
+    const std::shared_ptr<const gz::msgs::PointCloudPacked> &_msg)
+{
+  auto msg = _msg;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->msgMutex);
+    if (this->dataPtr->cloudPending)
+      this->dataPtr->droppedFrames++;
+    this->dataPtr->latestCloud = std::move(msg);
+    this->dataPtr->cloudPending = true;
+    this->dataPtr->msgsChanged = true;
+  }
+  this->dataPtr->RequestUpdate();
 }
 
 //////////////////////////////////////////////////
 void PointCloud::OnFloatV(const gz::msgs::Float_V &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->floatVMsg = _msg;
+  this->OnFloatV(std::make_shared<const gz::msgs::Float_V>(_msg));
+}
 
-  this->dataPtr->minFloatV = std::numeric_limits<float>::max();
-  this->dataPtr->maxFloatV = -std::numeric_limits<float>::max();
+//////////////////////////////////////////////////
+void PointCloud::OnFloatV(
+    const std::shared_ptr<const gz::msgs::Float_V> &_msg)
+{
+  float minFloatV = std::numeric_limits<float>::max();
+  float maxFloatV = -std::numeric_limits<float>::max();
+  for (auto i = 0; i < _msg->data_size(); ++i)
+  {
+    auto data = _msg->data(i);
+    if (data < minFloatV)
+      minFloatV = data;
+    if (data > maxFloatV)
+      maxFloatV = data;
+  }
 
-  for (auto i = 0; i < _msg.data_size(); ++i)
+  auto msg = _msg;
   {
-    auto data = _msg.data(i);
-    if (data < this->dataPtr->minFloatV)
-      this->SetMinFloatV(data);
-    if (data > this->dataPtr->maxFloatV)
-      this->SetMaxFloatV(data);
+    std::lock_guard<std::mutex> lock(this->dataPtr->msgMutex);
+    this->dataPtr->latestFloatV = std::move(msg);
+    this->dataPtr->minFloatV = minFloatV;
+    this->dataPtr->maxFloatV = maxFloatV;
+    this->dataPtr->msgsChanged = true;
   }
 
+  // Notify the GUI from the main thread
+  QMetaObject::invokeMethod(this, [this]()
+  {
+    emit this->MinFloatVChanged();
+    emit this->MaxFloatVChanged();
+  }, Qt::QueuedConnection);
+
   // TODO(chapulina) Publishing whenever we get a new point cloud and a new
   // floatV is good in case these topics are out of sync. But here they're
   // synchronized, so in practice we're publishing markers twice for each
   // PC+float that we get.
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->RequestUpdate();
 }
 
 //////////////////////////////////////////////////
@@ -354,82 +1343,351 @@ void PointCloud::OnFloatVService(
 }
 
 //////////////////////////////////////////////////
-void PointCloud::Implementation::PublishMarkers()
+void PointCloud::Implementation::UpdateVisual()
 {
-  GZ_PROFILE("PointCloud::PublishMarkers");
+  GZ_GUI_PROFILE("PointCloud::UpdateVisual");
 
   if (!this->showing)
     return;
 
+  // Take the latest messages, older ones which weren't taken are skipped
+  uint64_t droppedFrames;
+  bool newScan{false};
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    if (this->msgsChanged)
+    {
+      newScan = this->cloudPending;
+      this->pointCloudMsg = this->latestCloud;
+      this->floatVMsg = this->latestFloatV;
+      this->msgsChanged = false;
+      this->cloudPending = false;
+      this->keptValid = false;
+    }
+    droppedFrames = this->droppedFrames;
+  }
+
+  if (droppedFrames != this->reportedDropped)
+  {
+    this->reportedDropped = droppedFrames;
+    if (this->droppedFramesCb)
+      this->droppedFramesCb(droppedFrames);
+  }
+
+  // Before checking the float vector, so a field can be picked without one
+  if (newScan)
+    this->ReportFields();
+
+  bool needsFloatV;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    needsFloatV = this->colorField.empty();
+  }
+
   // If point cloud empty, do nothing.
-  if (this->pointCloudMsg.height() == 0 &&
-      this->pointCloudMsg.width() == 0)
+  if (nullptr == this->pointCloudMsg ||
+      (needsFloatV && nullptr == this->floatVMsg) ||
+      (this->pointCloudMsg->height() == 0 &&
+       this->pointCloudMsg->width() == 0))
   {
     return;
   }
 
+  RenderData data;
+  if (!this->BuildRenderData(data))
+    return;
+  data.newScan = newScan;
+
+  // So the scans the camera sees are uploaded first
+  if (this->direct && !data.points.empty())
+  {
+    math::Vector3d min = data.points[0];
+    math::Vector3d max = data.points[0];
+    for (const auto &point : data.points)
+    {
+      min.Min(point);
+      max.Max(point);
+    }
+    data.bounds = math::AxisAlignedBox(min, max);
+  }
+
   std::lock_guard<std::recursive_mutex> lock(this->mutex);
-  gz::msgs::Marker marker;
-  marker.set_ns(this->pointCloudTopic + this->floatVTopic);
-  marker.set_id(1);
-  marker.set_action(gz::msgs::Marker::ADD_MODIFY);
-  marker.set_type(gz::msgs::Marker::POINTS);
-  marker.set_visibility(gz::msgs::Marker::GUI);
+  if (this->direct)
+  {
+    // Don't lose flags of an update which wasn't uploaded yet
+    if (this->pendingDirty)
+    {
+      data.newScan = data.newScan || this->pending.newScan;
+      data.reset = this->pending.reset;
+    }
+    this->pending = std::move(data);
+    this->pendingDirty = true;
+    RenderHooks::RequestRender();
+  }
+  else
+  {
+    this->PublishMarkers(std::move(data));
+  }
+}
 
-  gz::msgs::Set(marker.mutable_scale(),
-    gz::math::Vector3d::One * this->pointSize);
-
-  gz::msgs::PointCloudPackedIterator<float>
-      iterX(this->pointCloudMsg, "x");
-  gz::msgs::PointCloudPackedIterator<float>
-      iterY(this->pointCloudMsg, "y");
-  gz::msgs::PointCloudPackedIterator<float>
-      iterZ(this->pointCloudMsg, "z");
-
-  // Index of point in point cloud, visualized or not
-  int ptIdx{0};
-  auto minC = this->minColor;
-  auto maxC = this->maxColor;
-  auto floatRange = this->maxFloatV - this->minFloatV;
-  auto num_points =
-    this->pointCloudMsg.data().size() / this->pointCloudMsg.point_step();
-  if (static_cast<int>(num_points) != this->floatVMsg.data().size())
+//////////////////////////////////////////////////
+bool PointCloud::Implementation::BuildRenderData(RenderData &_data)
+{
+  math::Color minC;
+  math::Color maxC;
+  std::string fieldName;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    minC.Set(this->minColor.R(), this->minColor.G(), this->minColor.B());
+    maxC.Set(this->maxColor.R(), this->maxColor.G(), this->maxColor.B());
+    _data.pointSize = this->pointSize;
+    fieldName = this->colorField;
+  }
+
+  // The kept points are colored from another source now
+  if (fieldName != this->keptField)
+    this->keptValid = false;
+
+  const std::size_t pointStep = this->pointCloudMsg->point_step();
+
+  // Byte offset of x, y and z within each point, and the field coloring the
+  // points, if any
+  int offsets[3]{-1, -1, -1};
+  const char *names[3]{"x", "y", "z"};
+  std::optional<PackedField> colorField;
+  bool packedColors{false};
+  for (const auto &field : this->pointCloudMsg->field())
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if (field.name() == names[i] &&
+          field.datatype() == msgs::PointCloudPacked::Field::FLOAT32 &&
+          field.offset() + sizeof(float) <= pointStep)
+      {
+        offsets[i] = static_cast<int>(field.offset());
+      }
+    }
+    if (!fieldName.empty() && field.name() == fieldName)
+    {
+      colorField = packedField(field, pointStep);
+      packedColors = isColorField(field);
+    }
+  }
+  if (offsets[0] < 0 || offsets[1] < 0 || offsets[2] < 0)
+  {
+    gzerr << "Point cloud needs float32 x, y and z fields" << std::endl;
+    return false;
+  }
+  if (!fieldName.empty() && !colorField)
+  {
+    gzerr << "Point cloud has no numeric field [" << fieldName
+           << "] to color points with" << std::endl;
+    return false;
+  }
+  const bool alpha = fieldName == "rgba";
+
+  const std::string &cloud = this->pointCloudMsg->data();
+
+  // Only the colors changed, recolor the points kept from the same messages
+  if (this->keptValid)
+  {
+    const std::size_t count = this->keptIndices.size();
+    _data.colors.resize(count);
+    if (packedColors)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        colorField->ReadColors(cloud.data() + this->keptIndices[i] * pointStep,
+            1, pointStep, alpha, &_data.colors[i]);
+      }
+    }
+    else
+    {
+      std::vector<float> values(count);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        if (colorField)
+        {
+          colorField->Read(cloud.data() + this->keptIndices[i] * pointStep,
+              1, pointStep, &values[i]);
+        }
+        else
+        {
+          values[i] = this->floatVMsg->data(this->keptIndices[i]);
+        }
+      }
+
+      const Colormap colormap(this->minFloatV, this->maxFloatV, minC, maxC);
+      std::vector<uint32_t> indices(count);
+      colormap.Apply(values.data(), count, _data.colors.data(),
+          indices.data());
+    }
+    _data.points = this->keptPoints;
+    return true;
+  }
+
+  auto num_points = cloud.size() / pointStep;
+  if (!colorField &&
+      static_cast<int>(num_points) != this->floatVMsg->data().size())
   {
     gzwarn << "Float message and pointcloud are not of the same size,"
       <<" visualization may not be accurate" << std::endl;
   }
-  if (this->pointCloudMsg.data().size() % this->pointCloudMsg.point_step() != 0)
+  if (cloud.size() % pointStep != 0)
   {
     gzwarn << "Mal-formatted pointcloud" << std::endl;
   }
 
-  for (; ptIdx < std::min<int>(this->floatVMsg.data().size(), num_points);
-    ++iterX, ++iterY, ++iterZ, ++ptIdx)
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> colors;
+  std::size_t visible;
+  if (packedColors)
+  {
+    // Colors come straight from the cloud, all points are shown
+    indices.resize(num_points);
+    colors.resize(num_points);
+    std::iota(indices.begin(), indices.end(), 0u);
+    colorField->ReadColors(cloud.data(), num_points, pointStep, alpha,
+        colors.data());
+    visible = num_points;
+  }
+  else
   {
-    // Value from float vector, if available. Otherwise publish all data as
-    // zeroes.
-    float dataVal = this->floatVMsg.data(ptIdx);
+    // Values come from the cloud itself, or from the float vector
+    std::vector<float> fieldValues;
+    const float *values = this->floatVMsg ?
+        this->floatVMsg->data().data() : nullptr;
+    std::size_t count{0};
+    if (colorField)
+    {
+      fieldValues.resize(num_points);
+      colorField->Read(cloud.data(), num_points, pointStep,
+          fieldValues.data());
+      values = fieldValues.data();
+      count = num_points;
+      this->UpdateRange(values, count);
+    }
+    else
+    {
+      count = std::min<std::size_t>(this->floatVMsg->data().size(),
+          num_points);
+    }
 
-    // Don't visualize NaN
-    if (std::isnan(dataVal))
-      continue;
+    // Color the points with a value, leaving out NaNs
+    const Colormap colormap(this->minFloatV, this->maxFloatV, minC, maxC);
+    indices.resize(count);
+    colors.resize(count);
+    visible = colormap.Apply(values, count, colors.data(), indices.data());
+  }
+
+  std::vector<math::Vector3d> points;
+  points.reserve(visible);
+  for (std::size_t i = 0; i < visible; ++i)
+  {
+    const char *point = cloud.data() + indices[i] * pointStep;
+    float xyz[3];
+    for (int j = 0; j < 3; ++j)
+      std::memcpy(&xyz[j], point + offsets[j], sizeof(float));
+    points.emplace_back(xyz[0], xyz[1], xyz[2]);
+  }
+
+  // Reduce the points, and keep the result until a new message arrives
+  const auto kept = decimate(points, this->decimation);
+  this->keptIndices.resize(kept.size());
+  this->keptPoints.resize(kept.size());
+  _data.colors.resize(kept.size());
+  for (std::size_t i = 0; i < kept.size(); ++i)
+  {
+    this->keptIndices[i] = indices[kept[i]];
+    this->keptPoints[i] = points[kept[i]];
+    _data.colors[i] = colors[kept[i]];
+  }
+  this->keptValid = true;
+  this->keptField = fieldName;
 
-    auto ratio = floatRange > 0 ?
-        (dataVal - this->minFloatV) / floatRange : 0.0f;
-    gz:: math::Color color{
-      minC.R() + (maxC.R() - minC.R()) * ratio,
-      minC.G() + (maxC.G() - minC.G()) * ratio,
-      minC.B() + (maxC.B() - minC.B()) * ratio
-    };
+  _data.points = this->keptPoints;
+  return true;
+}
 
+//////////////////////////////////////////////////
+void PointCloud::Implementation::UpdateRange(const float *_values,
+    std::size_t _count)
+{
+  float minValue = std::numeric_limits<float>::max();
+  float maxValue = -std::numeric_limits<float>::max();
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    if (_values[i] < minValue)
+      minValue = _values[i];
+    if (_values[i] > maxValue)
+      maxValue = _values[i];
+  }
+  this->minFloatV = minValue;
+  this->maxFloatV = maxValue;
+  if (this->rangeCb)
+    this->rangeCb();
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::ReportFields()
+{
+  const std::size_t pointStep = this->pointCloudMsg->point_step();
+  std::vector<std::string> fields;
+  for (const auto &field : this->pointCloudMsg->field())
+  {
+    if (field.name() != "x" && field.name() != "y" && field.name() != "z" &&
+        packedField(field, pointStep))
+    {
+      fields.push_back(field.name());
+    }
+  }
+
+  if (fields == this->reportedFields)
+    return;
+  this->reportedFields = fields;
+  if (this->fieldsCb)
+    this->fieldsCb(fields);
+}
+
+//////////////////////////////////////////////////
+void PointCloud::Implementation::PublishMarkers(RenderData &&_data)
+{
+  // Hand the points over within the process, skipping the msg
+  if (auto markers = SceneServices::Get<MarkerSink>(SceneServices::kMarkers))
+  {
+    MarkerPoints points;
+    points.ns = this->pointCloudTopic + this->floatVTopic;
+    points.id = 1;
+    points.type = gz::msgs::Marker::POINTS;
+    points.size = _data.pointSize;
+    points.colors.resize(_data.colors.size());
+    for (std::size_t i = 0; i < _data.colors.size(); ++i)
+      points.colors[i].SetFromRGBA(_data.colors[i]);
+    points.points = std::move(_data.points);
+    if (markers->SetPoints(std::move(points)))
+      return;
+    _data.points = std::move(points.points);
+  }
+
+  gz::msgs::Marker marker;
+  marker.set_ns(this->pointCloudTopic + this->floatVTopic);
+  marker.set_id(1);
+  marker.set_action(gz::msgs::Marker::ADD_MODIFY);
+  marker.set_type(gz::msgs::Marker::POINTS);
+  marker.set_visibility(gz::msgs::Marker::GUI);
+
+  gz::msgs::Set(marker.mutable_scale(),
+    gz::math::Vector3d::One * _data.pointSize);
+
+  math::Color color;
+  for (std::size_t i = 0; i < _data.points.size(); ++i)
+  {
+    color.SetFromRGBA(_data.colors[i]);
     gz::msgs::Set(marker.add_materials()->mutable_diffuse(), color);
-    gz::msgs::Set(marker.add_point(), gz::math::Vector3d(
-      *iterX,
-      *iterY,
-      *iterZ));
+    gz::msgs::Set(marker.add_point(), _data.points[i]);
   }
 
-  this->node.Request("/marker", marker);
+  App()->Nodes()->Node().Request("/marker", marker);
 }
 
 //////////////////////////////////////////////////
@@ -439,6 +1697,16 @@ void PointCloud::Implementation::ClearMarkers()
     return;
 
   std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  if (this->direct)
+  {
+    this->pending = RenderData();
+    this->pending.pointSize = this->pointSize;
+    this->pending.reset = true;
+    this->pendingDirty = true;
+    RenderHooks::RequestRender();
+    return;
+  }
+
   gz::msgs::Marker msg;
   msg.set_ns(this->pointCloudTopic + this->floatVTopic);
   msg.set_id(0);
@@ -448,7 +1716,9 @@ void PointCloud::Implementation::ClearMarkers()
     << this->pointCloudTopic + this->floatVTopic
     << std::endl;
 
-  this->node.Request("/marker", msg);
+  auto markers = SceneServices::Get<MarkerSink>(SceneServices::kMarkers);
+  if ((!markers || !markers->Submit(std::move(msg))) && nullptr != App())
+    App()->Nodes()->Node().Request("/marker", msg);
 }
 
 /////////////////////////////////////////////////
@@ -460,9 +1730,12 @@ QColor PointCloud::MinColor() const
 /////////////////////////////////////////////////
 void PointCloud::SetMinColor(const QColor &_minColor)
 {
-  this->dataPtr->minColor = gz::gui::convert(_minColor);
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->minColor = gz::gui::convert(_minColor);
+  }
   emit this->MinColorChanged();
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->RequestUpdate();
 }
 
 /////////////////////////////////////////////////
@@ -474,9 +1747,12 @@ QColor PointCloud::MaxColor() const
 /////////////////////////////////////////////////
 void PointCloud::SetMaxColor(const QColor &_maxColor)
 {
-  this->dataPtr->maxColor = gz::gui::convert(_maxColor);
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->maxColor = gz::gui::convert(_maxColor);
+  }
   emit this->MaxColorChanged();
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->RequestUpdate();
 }
 
 /////////////////////////////////////////////////
@@ -514,9 +1790,32 @@ float PointCloud::PointSize() const
 /////////////////////////////////////////////////
 void PointCloud::SetPointSize(float _pointSize)
 {
-  this->dataPtr->pointSize = _pointSize;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->pointSize = _pointSize;
+  }
   emit this->PointSizeChanged();
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->RequestUpdate();
+}
+
+/////////////////////////////////////////////////
+int PointCloud::DroppedFrames() const
+{
+  return this->dataPtr->droppedFramesGui;
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetDroppedFrames(int _droppedFrames)
+{
+  // Only point clouds are counted, the handle is only used on this thread
+  if (_droppedFrames > this->dataPtr->droppedFramesGui)
+  {
+    this->dataPtr->pointCloudSubscription.ReportDropped(
+        static_cast<std::size_t>(
+        _droppedFrames - this->dataPtr->droppedFramesGui));
+  }
+  this->dataPtr->droppedFramesGui = _droppedFrames;
+  emit this->DroppedFramesChanged();
 }
 }  // namespace gz::gui::plugins
 
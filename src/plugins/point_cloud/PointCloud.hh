@@ -38,16 +38,75 @@ namespace gz::gui::plugins
   /// their values. The float message must have the same number of elements as
   /// the point cloud and be indexed the same way. NaN values on the FloatV
   /// message aren't displayed.
+  /// Points may also be colored by a field of the point cloud itself,
+  /// which saves subscribing to a second topic and keeping both in sync.
+  ///
+  /// Only the latest messages are processed, point clouds which arrive
+  /// faster than they can be processed are dropped and counted.
   ///
   /// Requirements:
   /// * A plugin that loads a 3D scene, such as `MinimalScene`
-  /// * The `MarkerManager` plugin
+  ///
+  /// Points are read straight from the packed data and rendered by the
+  /// plugin itself. Until a scene is available, they're sent to the
+  /// `MarkerManager` plugin instead, through its MarkerSink if it's loaded
+  /// in the same process, or on `/marker` otherwise.
   ///
   /// Parameters:
   ///
   /// * `<point_cloud_topic>`: Topic to receive
   ///      `gz::msgs::PointCloudPacked` messages.
   /// * `<float_v_topic>`: Topic to receive `gz::msgs::FloatV` messages.
+  /// * `<color_field>`: Optional. Color the points by a field of the point
+  ///   cloud instead, such as "intensity" or "ring", so no float vector is
+  ///   needed. The values are read straight from the packed data, and the
+  ///   range follows each cloud. 4 byte "rgb" and "rgba" fields, packed as
+  ///   in PCL, give the color of each point directly. The float vector
+  ///   topic isn't subscribed to while a field is set. Can be changed from
+  ///   the GUI. Defaults to empty, the float vector.
+  /// * `<decimation>`: Optional. Reduce the number of points shown. The
+  ///   points kept are computed off the GUI thread, and reused until a new
+  ///   message arrives.
+  ///   * `<stride>`: Keep one of every N points. Defaults to 1.
+  ///   * `<voxel_size>`: Keep one point per cubic voxel of this size, in
+  ///     meters. Defaults to 0, disabled.
+  ///   * `<max_points>`: Maximum number of points shown, spread evenly over
+  ///     the cloud. Defaults to 0, no limit.
+  /// * `<accumulation>`: Optional. Show the latest scans together, each one
+  ///   in its own slot of a fixed ring, so adding a scan only uploads that
+  ///   scan. Changing colors only recolors the latest scan. Only available
+  ///   when rendering directly in a scene.
+  ///   * `<scans>`: Number of scans shown. Defaults to 1.
+  ///   * `<fade>`: True to make older scans increasingly transparent.
+  ///     Defaults to false.
+  /// * `<max_rate>`: Optional. Most messages per second to receive on each
+  ///   topic. Messages above this rate are dropped by the transport
+  ///   subscription, before they're delivered and deserialized. Defaults to
+  ///   0, all messages.
+  /// * `<shared_memory>`: Optional. Whether to receive the topics through
+  ///   shared memory when they're published by a SharedMemoryPublisher on
+  ///   the same host, falling back to transport otherwise. Defaults to true.
+  /// * `<feedback>`: Optional. Whether to publish how fast the topics are
+  ///   consumed on their FeedbackTopic(), including the point clouds
+  ///   replaced before they were shown, so cooperating publishers can
+  ///   lower their rate or resolution. Defaults to false. See
+  ///   SubscriptionHub::SetFeedback.
+  /// * `<map>`: Optional. Also show a prebuilt point cloud map, too large
+  ///   to be sent as a message, from an octree file written by the
+  ///   `gz-gui-point-cloud-octree` tool. The file is memory mapped, and
+  ///   only the nodes needed for the user camera's view are read and
+  ///   uploaded, coarse ones first, with finer ones closer to the camera.
+  ///   Nodes which aren't shown anymore stay loaded until the cache is
+  ///   full, and the least recently used ones are unloaded first. Only
+  ///   available when rendering directly in a scene.
+  ///   * `<file>`: Path to the octree file.
+  ///   * `<max_error>`: Nodes are refined until the spacing between their
+  ///     points is at most this many pixels on screen. Defaults to 2.
+  ///   * `<point_budget>`: Most points shown at once. Defaults to 5000000.
+  ///   * `<cache_points>`: Most points kept loaded, at least the point
+  ///     budget. Defaults to 10000000.
+  ///   * `<nodes_per_frame>`: Most nodes loaded each frame, so panning
+  ///     doesn't stall rendering. Defaults to 16.
   class PointCloud : public gz::gui::Plugin
   {
     Q_OBJECT
@@ -68,6 +127,22 @@ namespace gz::gui::plugins
       NOTIFY FloatVTopicListChanged
     )
 
+    /// \brief Fields of the latest point cloud which can color its points
+    Q_PROPERTY(
+      QStringList colorFieldList
+      READ ColorFieldList
+      WRITE SetColorFieldList
+      NOTIFY ColorFieldListChanged
+    )
+
+    /// \brief Field coloring the points, empty for the float vector topic
+    Q_PROPERTY(
+      QString colorField
+      READ ColorField
+      WRITE SetColorField
+      NOTIFY ColorFieldChanged
+    )
+
     /// \brief Color for minimum value
     Q_PROPERTY(
       QColor minColor
@@ -108,6 +183,14 @@ namespace gz::gui::plugins
       NOTIFY PointSizeChanged
     )
 
+    /// \brief Number of point clouds skipped because a newer one arrived
+    /// before they were processed
+    Q_PROPERTY(
+      int droppedFrames
+      READ DroppedFrames
+      NOTIFY DroppedFramesChanged
+    )
+
     /// \brief Constructor
     public: PointCloud();
 
@@ -121,6 +204,12 @@ namespace gz::gui::plugins
     /// \param[in] _msg Point cloud message
     public: void OnPointCloud(const msgs::PointCloudPacked &_msg);
 
+    /// \brief Callback function for point cloud topic, without copying
+    /// the message.
+    /// \param[in] _msg Point cloud message, shared with other subscribers
+    public: void OnPointCloud(
+        const std::shared_ptr<const msgs::PointCloudPacked> &_msg);
+
     /// \brief Callback function for point cloud service
     /// \param[in] _msg Point cloud message
     /// \param[out] _result True on success.
@@ -147,6 +236,11 @@ namespace gz::gui::plugins
     /// \param[in] _msg Float vector message
     public: void OnFloatV(const msgs::Float_V &_msg);
 
+    /// \brief Callback function for float vector topic, without copying
+    /// the message.
+    /// \param[in] _msg Float vector message, shared with other subscribers
+    public: void OnFloatV(const std::shared_ptr<const msgs::Float_V> &_msg);
+
     /// \brief Callback function for point cloud service
     /// \param[in] _msg Float vector message
     /// \param[out] _result True on success.
@@ -168,6 +262,32 @@ namespace gz::gui::plugins
     /// \param[in] _topicName Name of selected topic
     public: Q_INVOKABLE void OnFloatVTopic(const QString &_topicName);
 
+    /// \brief Get the fields which can color the points
+    /// \return Names of the numeric fields of the latest point cloud, other
+    /// than x, y and z
+    public: Q_INVOKABLE QStringList ColorFieldList() const;
+
+    /// \brief Set the fields which can color the points
+    /// \param[in] _colorFieldList Field names
+    public: Q_INVOKABLE void SetColorFieldList(
+        const QStringList &_colorFieldList);
+
+    /// \brief Notify that the field list has changed
+    signals: void ColorFieldListChanged();
+
+    /// \brief Get the field coloring the points
+    /// \return Field name, empty if points are colored by the float vector
+    /// topic
+    public: Q_INVOKABLE QString ColorField() const;
+
+    /// \brief Color the points by a field of the point cloud, such as
+    /// "intensity", or by the float vector topic
+    /// \param[in] _colorField Field name, empty for the float vector topic
+    public: Q_INVOKABLE void SetColorField(const QString &_colorField);
+
+    /// \brief Notify that the field coloring the points has changed
+    signals: void ColorFieldChanged();
+
     /// \brief Get the minimum color
     /// \return Minimum color
     public: Q_INVOKABLE QColor MinColor() const;
@@ -223,6 +343,17 @@ namespace gz::gui::plugins
     /// \brief Notify that point size has changed
     signals: void PointSizeChanged();
 
+    /// \brief Get the number of dropped frames
+    /// \return Point clouds skipped so far
+    public: Q_INVOKABLE int DroppedFrames() const;
+
+    /// \brief Set the number of dropped frames
+    /// \param[in] _droppedFrames Point clouds skipped so far
+    public: Q_INVOKABLE void SetDroppedFrames(int _droppedFrames);
+
+    /// \brief Notify that the number of dropped frames has changed
+    signals: void DroppedFramesChanged();
+
     /// \brief Set whether to show the point cloud.
     /// \param[in] _show Boolean value for displaying the points.
     public: Q_INVOKABLE void Show(bool _show);
@@ -101,6 +101,7 @@ ColumnLayout {
       Layout.columnSpan: 2
       id: floatCombo
       Layout.fillWidth: true
+      enabled: PointCloud.colorField === ""
       model: PointCloud.floatVTopicList
       currentIndex: 0
       onCurrentIndexChanged: {
@@ -113,6 +114,26 @@ ColumnLayout {
       ToolTip.text: qsTr("Gazebo Transport topics publishing FloatV messages, used to color each point on the cloud")
     }
 
+    Label {
+      Layout.columnSpan: 1
+      text: "Color by"
+    }
+
+    ComboBox {
+      Layout.columnSpan: 2
+      id: fieldCombo
+      Layout.fillWidth: true
+      model: ["Float vector"].concat(PointCloud.colorFieldList)
+      currentIndex: PointCloud.colorField === "" ? 0 :
+          Math.max(0, PointCloud.colorFieldList.indexOf(PointCloud.colorField) + 1)
+      onActivated: {
+        PointCloud.SetColorField(index === 0 ? "" : textAt(index));
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Color points by the float vector topic, or by a field of the point cloud, such as its intensity")
+    }
+
     Label {
       Layout.columnSpan: 1
       text: "Point size"
@@ -221,6 +242,19 @@ ColumnLayout {
     }
   }
 
+  Label {
+    Layout.fillWidth: true
+    text: "Dropped frames: " + PointCloud.droppedFrames
+    ToolTip.visible: droppedArea.containsMouse
+    ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+    ToolTip.text: qsTr("Point clouds skipped because a newer one arrived before they were processed")
+    MouseArea {
+      id: droppedArea
+      anchors.fill: parent
+      hoverEnabled: true
+    }
+  }
+
   Item {
     Layout.columnSpan: 6
     width: 10
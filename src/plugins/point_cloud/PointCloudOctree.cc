@@ -0,0 +1,596 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <unordered_set>
+#include <utility>
+
+#include <gz/common/Console.hh>
+
+#include "PointCloudOctree.hh"
+
+namespace gz::gui::plugins
+{
+namespace
+{
+/// \brief Start of an octree file, followed by the nodes and then the
+/// points, at a multiple of 16 bytes
+struct FileHeader
+{
+  /// \brief kMagic
+  char magic[8];
+
+  /// \brief kVersion
+  uint32_t version;
+
+  /// \brief Number of nodes
+  uint32_t nodeCount;
+
+  /// \brief Number of points
+  uint64_t pointCount;
+
+  /// \brief Corner of the root cube with the lowest coordinates
+  float min[3];
+
+  /// \brief Side of the root cube
+  float size;
+
+  /// \brief Spacing of the root's sampling grid
+  float spacing;
+
+  /// \brief Unused, zeroed
+  uint32_t reserved[5];
+};
+
+static_assert(sizeof(FileHeader) == 64, "Octree file header changed");
+static_assert(sizeof(PointCloudOctree::Node) == 40, "Octree node changed");
+static_assert(sizeof(OctreePoint) == 16, "Octree point changed");
+
+/// \brief Identifies octree files
+constexpr char kMagic[8] = {'G', 'Z', 'O', 'C', 'T', 'R', 'E', 'E'};
+
+/// \brief Format version, bumped on incompatible changes
+constexpr uint32_t kVersion{1};
+
+/////////////////////////////////////////////////
+/// \brief Offset of the points in a file
+/// \param[in] _nodeCount Number of nodes
+/// \return Bytes from the start of the file
+std::size_t pointsOffset(std::size_t _nodeCount)
+{
+  const std::size_t end =
+      sizeof(FileHeader) + _nodeCount * sizeof(PointCloudOctree::Node);
+  return (end + 15) / 16 * 16;
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of children of a node
+/// \param[in] _node Node
+/// \return Number of bits set in its child mask
+unsigned int childCount(const PointCloudOctree::Node &_node)
+{
+  unsigned int count{0};
+  for (unsigned int octant = 0; octant < 8; ++octant)
+    count += (_node.childMask >> octant) & 1u;
+  return count;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+PointCloudOctree::~PointCloudOctree()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool PointCloudOctree::Build(std::vector<OctreePoint> &&_points,
+    const BuildOptions &_options, const std::string &_path)
+{
+  if (_points.empty())
+  {
+    gzerr << "No points to build an octree from" << std::endl;
+    return false;
+  }
+
+  // Root cube, around all points
+  float lo[3], hi[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    lo[axis] = std::numeric_limits<float>::max();
+    hi[axis] = std::numeric_limits<float>::lowest();
+  }
+  for (const auto &point : _points)
+  {
+    const float xyz[3] = {point.x, point.y, point.z};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      lo[axis] = std::min(lo[axis], xyz[axis]);
+      hi[axis] = std::max(hi[axis], xyz[axis]);
+    }
+  }
+  float size{0};
+  for (int axis = 0; axis < 3; ++axis)
+    size = std::max(size, hi[axis] - lo[axis]);
+  if (!(size > 0))
+    size = 1;
+
+  // A little larger, so rounding keeps the points inside the cubes
+  size *= 1.0001f;
+  if (!std::isfinite(size))
+  {
+    gzerr << "Points to build an octree from aren't finite" << std::endl;
+    return false;
+  }
+
+  const unsigned int cells = std::max(1u, _options.cells);
+  std::vector<Node> nodes(1);
+  std::copy(lo, lo + 3, nodes[0].min);
+  nodes[0].size = size;
+
+  // Breadth first, so the children of each node are allocated together
+  struct Work
+  {
+    uint32_t node;
+    uint64_t begin;
+    uint64_t end;
+  };
+  std::deque<Work> queue{{0, 0, _points.size()}};
+  std::unordered_set<uint64_t> sampled;
+  while (!queue.empty())
+  {
+    const Work work = queue.front();
+    queue.pop_front();
+
+    // Copied, pushing children moves the nodes
+    Node node = nodes[work.node];
+    const auto begin = _points.begin() + static_cast<std::ptrdiff_t>(
+        work.begin);
+    const auto end = _points.begin() + static_cast<std::ptrdiff_t>(work.end);
+    node.firstPoint = work.begin;
+
+    if (work.end - work.begin <= _options.maxLeafPoints ||
+        node.depth >= _options.maxDepth)
+    {
+      node.pointCount = static_cast<uint32_t>(work.end - work.begin);
+      nodes[work.node] = node;
+      continue;
+    }
+
+    // Keep the first point in each cell of the node's grid, in front of
+    // the others
+    const double cellsPerMeter = cells / static_cast<double>(node.size);
+    auto cell = [&](float _v, int _axis) -> uint64_t
+    {
+      const double index = std::floor((_v - node.min[_axis]) * cellsPerMeter);
+      return static_cast<uint64_t>(
+          std::clamp(index, 0.0, static_cast<double>(cells - 1)));
+    };
+    sampled.clear();
+    const auto kept = std::partition(begin, end,
+        [&](const OctreePoint &_p)
+        {
+          const uint64_t key =
+              (cell(_p.x, 0) * cells + cell(_p.y, 1)) * cells + cell(_p.z, 2);
+          return sampled.insert(key).second;
+        });
+    node.pointCount = static_cast<uint32_t>(kept - begin);
+
+    // Split the others into octants, in octant order
+    const float half = node.size * 0.5f;
+    const float mid[3] = {node.min[0] + half, node.min[1] + half,
+        node.min[2] + half};
+    auto below = [&mid](int _axis)
+    {
+      return [&mid, _axis](const OctreePoint &_p)
+      {
+        const float xyz[3] = {_p.x, _p.y, _p.z};
+        return xyz[_axis] < mid[_axis];
+      };
+    };
+    std::vector<std::vector<OctreePoint>::iterator> bounds{kept, end};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      std::vector<std::vector<OctreePoint>::iterator> split;
+      for (std::size_t i = 0; i + 1 < bounds.size(); ++i)
+      {
+        split.push_back(bounds[i]);
+        split.push_back(std::partition(bounds[i], bounds[i + 1],
+            below(axis)));
+      }
+      split.push_back(end);
+      bounds = std::move(split);
+    }
+
+    node.firstChild = static_cast<uint32_t>(nodes.size());
+    for (unsigned int octant = 0; octant < 8; ++octant)
+    {
+      if (bounds[octant] == bounds[octant + 1])
+        continue;
+      if (nodes.size() >= std::numeric_limits<uint32_t>::max())
+      {
+        gzerr << "Too many octree nodes, increase the leaf size"
+               << std::endl;
+        return false;
+      }
+
+      Node child;
+      child.size = half;
+      child.depth = static_cast<uint8_t>(node.depth + 1);
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        child.min[axis] = (octant >> (2 - axis)) & 1u ?
+            mid[axis] : node.min[axis];
+      }
+      node.childMask = static_cast<uint8_t>(node.childMask | (1u << octant));
+      queue.push_back({static_cast<uint32_t>(nodes.size()),
+          static_cast<uint64_t>(bounds[octant] - _points.begin()),
+          static_cast<uint64_t>(bounds[octant + 1] - _points.begin())});
+      nodes.push_back(child);
+    }
+    nodes[work.node] = node;
+  }
+
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.nodeCount = static_cast<uint32_t>(nodes.size());
+  header.pointCount = _points.size();
+  std::copy(lo, lo + 3, header.min);
+  header.size = size;
+  header.spacing = size / cells;
+
+  std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+  const std::size_t padding =
+      pointsOffset(nodes.size()) - sizeof(FileHeader) -
+      nodes.size() * sizeof(Node);
+  const char zeros[16]{};
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(nodes.data()),
+      static_cast<std::streamsize>(nodes.size() * sizeof(Node)));
+  file.write(zeros, static_cast<std::streamsize>(padding));
+  file.write(reinterpret_cast<const char *>(_points.data()),
+      static_cast<std::streamsize>(_points.size() * sizeof(OctreePoint)));
+  file.close();
+  if (!file)
+  {
+    gzerr << "Failed to write octree file [" << _path << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PointCloudOctree::Open(const std::string &_path)
+{
+  this->Close();
+
+#ifndef _WIN32
+  const int fd = open(_path.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || fstat(fd, &info) != 0)
+  {
+    gzerr << "Failed to open octree file [" << _path << "]: "
+           << std::strerror(errno) << std::endl;
+    if (fd >= 0)
+      close(fd);
+    return false;
+  }
+  this->length = static_cast<std::size_t>(info.st_size);
+  void *addr = this->length > 0 ?
+      mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0) :
+      MAP_FAILED;
+  close(fd);
+  if (addr == MAP_FAILED)
+  {
+    gzerr << "Failed to map octree file [" << _path << "]" << std::endl;
+    this->length = 0;
+    return false;
+  }
+  this->data = static_cast<const char *>(addr);
+#else
+  std::ifstream file(_path, std::ios::binary);
+  this->buffer.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  if (!file.good() && !file.eof())
+  {
+    gzerr << "Failed to open octree file [" << _path << "]" << std::endl;
+    this->buffer.clear();
+    return false;
+  }
+  this->data = this->buffer.data();
+  this->length = this->buffer.size();
+#endif
+
+  FileHeader header{};
+  if (this->length >= sizeof(header))
+    std::memcpy(&header, this->data, sizeof(header));
+  const bool valid = this->length >= sizeof(header) &&
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+      header.version == kVersion && header.nodeCount > 0 &&
+      pointsOffset(header.nodeCount) <= this->length &&
+      header.pointCount <= (this->length - pointsOffset(header.nodeCount)) /
+      sizeof(OctreePoint);
+  if (!valid)
+  {
+    gzerr << "File [" << _path << "] isn't an octree of version ["
+           << kVersion << "]" << std::endl;
+    this->Close();
+    return false;
+  }
+
+  this->nodes = reinterpret_cast<const Node *>(this->data +
+      sizeof(FileHeader));
+  this->nodeCount = header.nodeCount;
+  this->points = reinterpret_cast<const OctreePoint *>(this->data +
+      pointsOffset(header.nodeCount));
+  this->pointCount = header.pointCount;
+  this->spacing = header.spacing;
+
+  // Nodes are trusted from then on
+  for (std::size_t i = 0; i < this->nodeCount; ++i)
+  {
+    const Node &node = this->nodes[i];
+    if (node.firstPoint > this->pointCount ||
+        node.pointCount > this->pointCount - node.firstPoint ||
+        (node.childMask != 0 && (node.firstChild <= i ||
+        node.firstChild + childCount(node) > this->nodeCount)))
+    {
+      gzerr << "Octree file [" << _path << "] has an invalid node [" << i
+             << "]" << std::endl;
+      this->Close();
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void PointCloudOctree::Close()
+{
+#ifndef _WIN32
+  if (nullptr != this->data)
+    munmap(const_cast<char *>(this->data), this->length);
+#endif
+  this->buffer.clear();
+  this->data = nullptr;
+  this->length = 0;
+  this->nodes = nullptr;
+  this->nodeCount = 0;
+  this->points = nullptr;
+  this->pointCount = 0;
+  this->spacing = 0;
+}
+
+/////////////////////////////////////////////////
+bool PointCloudOctree::IsOpen() const
+{
+  return nullptr != this->data;
+}
+
+/////////////////////////////////////////////////
+std::size_t PointCloudOctree::NodeCount() const
+{
+  return this->nodeCount;
+}
+
+/////////////////////////////////////////////////
+uint64_t PointCloudOctree::PointCount() const
+{
+  return this->pointCount;
+}
+
+/////////////////////////////////////////////////
+const PointCloudOctree::Node &PointCloudOctree::NodeAt(uint32_t _node) const
+{
+  return this->nodes[_node];
+}
+
+/////////////////////////////////////////////////
+const OctreePoint *PointCloudOctree::Points(uint32_t _node) const
+{
+  return this->points + this->nodes[_node].firstPoint;
+}
+
+/////////////////////////////////////////////////
+double PointCloudOctree::Spacing(uint32_t _node) const
+{
+  return std::ldexp(this->spacing, -this->nodes[_node].depth);
+}
+
+/////////////////////////////////////////////////
+void PointCloudOctree::Prefetch(uint32_t _node) const
+{
+#ifndef _WIN32
+  const Node &node = this->nodes[_node];
+  if (node.pointCount == 0)
+    return;
+
+  static const std::size_t pageSize =
+      static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  const auto begin = reinterpret_cast<std::uintptr_t>(this->Points(_node));
+  const auto end = begin + node.pointCount * sizeof(OctreePoint);
+  const auto first = begin / pageSize * pageSize;
+  posix_madvise(reinterpret_cast<void *>(first), end - first,
+      POSIX_MADV_WILLNEED);
+#else
+  (void)_node;
+#endif
+}
+
+/////////////////////////////////////////////////
+std::vector<uint32_t> PointCloudOctree::Select(const View &_view,
+    double _maxError, std::size_t _pointBudget) const
+{
+  std::vector<uint32_t> selected;
+  if (!this->IsOpen())
+    return selected;
+
+  // Projected spacing in pixels, negative if the node is out of view
+  auto error = [&](uint32_t _node) -> double
+  {
+    const Node &node = this->nodes[_node];
+    const double half = node.size * 0.5;
+    const math::Vector3d center(node.min[0] + half, node.min[1] + half,
+        node.min[2] + half);
+    const double radius = half * std::sqrt(3.0);
+    const math::Vector3d toNode = center - _view.position;
+    const double distance = toNode.Length();
+    if (distance <= radius)
+      return std::numeric_limits<double>::max();
+
+    if (_view.direction != math::Vector3d::Zero)
+    {
+      const double cosine = std::clamp(
+          _view.direction.Dot(toNode) / distance, -1.0, 1.0);
+      if (std::acos(cosine) - std::asin(radius / distance) >
+          _view.halfAngle)
+      {
+        return -1;
+      }
+    }
+    return this->Spacing(_node) / (distance - radius) *
+        _view.pixelsPerRadian;
+  };
+
+  std::priority_queue<std::pair<double, uint32_t>> queue;
+  const double rootError = error(0);
+  if (rootError >= 0)
+    queue.emplace(rootError, 0);
+
+  std::size_t budget = _pointBudget;
+  while (!queue.empty())
+  {
+    const auto [nodeError, index] = queue.top();
+    queue.pop();
+
+    const Node &node = this->nodes[index];
+    if (node.pointCount > budget)
+      break;
+    budget -= node.pointCount;
+    selected.push_back(index);
+
+    if (nodeError <= _maxError)
+      continue;
+
+    uint32_t child = node.firstChild;
+    for (unsigned int octant = 0; octant < 8; ++octant)
+    {
+      if (!((node.childMask >> octant) & 1u))
+        continue;
+      const double childError = error(child);
+      if (childError >= 0)
+        queue.emplace(childError, child);
+      ++child;
+    }
+  }
+  return selected;
+}
+
+/////////////////////////////////////////////////
+void OctreeNodeCache::Insert(uint32_t _node, std::size_t _points)
+{
+  auto &entry = this->entries[_node];
+  this->points = this->points - entry.points + _points;
+  entry.points = _points;
+  entry.lastUse = ++this->tick;
+}
+
+/////////////////////////////////////////////////
+bool OctreeNodeCache::Touch(uint32_t _node)
+{
+  auto it = this->entries.find(_node);
+  if (it == this->entries.end())
+    return false;
+  it->second.lastUse = ++this->tick;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void OctreeNodeCache::Remove(uint32_t _node)
+{
+  auto it = this->entries.find(_node);
+  if (it == this->entries.end())
+    return;
+  this->points -= it->second.points;
+  this->entries.erase(it);
+}
+
+/////////////////////////////////////////////////
+bool OctreeNodeCache::Contains(uint32_t _node) const
+{
+  return this->entries.find(_node) != this->entries.end();
+}
+
+/////////////////////////////////////////////////
+std::size_t OctreeNodeCache::Points() const
+{
+  return this->points;
+}
+
+/////////////////////////////////////////////////
+std::size_t OctreeNodeCache::Size() const
+{
+  return this->entries.size();
+}
+
+/////////////////////////////////////////////////
+std::vector<uint32_t> OctreeNodeCache::Evict(std::size_t _budget,
+    const std::function<bool(uint32_t)> &_inUse)
+{
+  std::vector<uint32_t> evicted;
+  if (this->points <= _budget)
+    return evicted;
+
+  // Only runs when over budget, so sorting the candidates is cheaper than
+  // keeping an ordered list updated on every use
+  std::vector<std::pair<std::uint64_t, uint32_t>> candidates;
+  candidates.reserve(this->entries.size());
+  for (const auto &[node, entry] : this->entries)
+    candidates.emplace_back(entry.lastUse, node);
+  std::sort(candidates.begin(), candidates.end());
+
+  std::size_t remaining = this->points;
+  for (const auto &candidate : candidates)
+  {
+    if (remaining <= _budget)
+      break;
+    if (_inUse && _inUse(candidate.second))
+      continue;
+    remaining -= this->entries.at(candidate.second).points;
+    evicted.push_back(candidate.second);
+  }
+
+  for (const auto node : evicted)
+    this->Remove(node);
+  return evicted;
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_POINTCLOUDOCTREE_HH_
+#define GZ_GUI_PLUGINS_POINTCLOUDOCTREE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#ifndef _WIN32
+#  define PointCloudOctree_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(PointCloud_EXPORTS))
+#    define PointCloudOctree_EXPORTS_API __declspec(dllexport)
+#  else
+#    define PointCloudOctree_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief A point of an octree file, as stored on disk
+  struct OctreePoint
+  {
+    /// \brief Position, in the map frame
+    float x{0};
+
+    /// \brief Position, in the map frame
+    float y{0};
+
+    /// \brief Position, in the map frame
+    float z{0};
+
+    /// \brief Color, packed as 0xRRGGBBAA
+    uint32_t rgba{0xFFFFFFFF};
+  };
+
+  /// \brief Point cloud map preprocessed into an octree file, which is
+  /// memory mapped so only the nodes shown are read from disk.
+  ///
+  /// Each node holds a subsample of the points in its cube, about one per
+  /// cell of a grid which is twice as fine at each level, and its children
+  /// hold the rest. Nodes add up: drawing a node and its ancestors shows
+  /// its cube at the node's spacing, and drawing all nodes shows every
+  /// point. Children of a node are stored next to each other, after their
+  /// parents, and the points of each node are contiguous.
+  ///
+  /// Files are written by Build, or by the `gz-gui-point-cloud-octree`
+  /// tool, in the byte order of the host. Once opened, the octree is
+  /// immutable, so it may be read from several threads.
+  class PointCloudOctree_EXPORTS_API PointCloudOctree
+  {
+    /// \brief Node of the octree, as stored on disk
+    public: struct Node
+    {
+      /// \brief Index of the node's first point
+      uint64_t firstPoint{0};
+
+      /// \brief Number of points of the node
+      uint32_t pointCount{0};
+
+      /// \brief Index of the node's first child. The others follow it.
+      uint32_t firstChild{0};
+
+      /// \brief Corner of the node's cube with the lowest coordinates
+      float min[3]{0, 0, 0};
+
+      /// \brief Side of the node's cube
+      float size{0};
+
+      /// \brief Octants which have a child, bit 2 for +X, bit 1 for +Y and
+      /// bit 0 for +Z. Children are stored in increasing octant order.
+      uint8_t childMask{0};
+
+      /// \brief Depth, 0 for the root
+      uint8_t depth{0};
+
+      /// \brief Unused, zeroed
+      uint8_t reserved[6]{0, 0, 0, 0, 0, 0};
+    };
+
+    /// \brief How to split points into nodes
+    public: struct BuildOptions
+    {
+      /// \brief Cells along each side of the root's sampling grid. Nodes
+      /// keep about one point per cell.
+      unsigned int cells{128};
+
+      /// \brief Nodes with at most this many points aren't split
+      std::size_t maxLeafPoints{20000};
+
+      /// \brief Depth past which nodes aren't split
+      unsigned int maxDepth{16};
+    };
+
+    /// \brief Camera the nodes are chosen for
+    public: struct View
+    {
+      /// \brief Camera position, in the map frame
+      math::Vector3d position;
+
+      /// \brief Unit view direction, zero to not cull nodes behind or
+      /// beside the camera
+      math::Vector3d direction;
+
+      /// \brief Angle from the view direction to the corners of the view,
+      /// in radians
+      double halfAngle{1.0};
+
+      /// \brief Viewport pixels per radian of view angle
+      double pixelsPerRadian{1000};
+    };
+
+    /// \brief Constructor
+    public: PointCloudOctree() = default;
+
+    /// \brief Destructor, unmapping the file
+    public: ~PointCloudOctree();
+
+    /// \brief Not copyable, it owns a mapping
+    public: PointCloudOctree(const PointCloudOctree &) = delete;
+
+    /// \brief Not copyable, it owns a mapping
+    public: PointCloudOctree &operator=(const PointCloudOctree &) = delete;
+
+    /// \brief Split points into an octree and write it to a file. Points
+    /// are reordered in place.
+    /// \param[in] _points Points, taken over
+    /// \param[in] _options How to split them
+    /// \param[in] _path File written
+    /// \return True on success, errors are printed
+    public: static bool Build(std::vector<OctreePoint> &&_points,
+        const BuildOptions &_options, const std::string &_path);
+
+    /// \brief Map an octree file, replacing the one mapped before
+    /// \param[in] _path File written by Build
+    /// \return True on success, errors are printed
+    public: bool Open(const std::string &_path);
+
+    /// \brief Unmap the file
+    public: void Close();
+
+    /// \brief Whether a file is mapped
+    /// \return True if it is
+    public: bool IsOpen() const;
+
+    /// \brief Number of nodes
+    /// \return Count, 0 if no file is mapped
+    public: std::size_t NodeCount() const;
+
+    /// \brief Number of points of all nodes
+    /// \return Count, 0 if no file is mapped
+    public: uint64_t PointCount() const;
+
+    /// \brief Get a node
+    /// \param[in] _node Node index, 0 for the root, less than NodeCount
+    /// \return The node
+    public: const Node &NodeAt(uint32_t _node) const;
+
+    /// \brief Get the points of a node, read from disk as they're accessed
+    /// \param[in] _node Node index
+    /// \return The node's NodeAt(_node).pointCount points
+    public: const OctreePoint *Points(uint32_t _node) const;
+
+    /// \brief Distance between the points of a node
+    /// \param[in] _node Node index
+    /// \return Spacing of its sampling grid, in meters
+    public: double Spacing(uint32_t _node) const;
+
+    /// \brief Ask the OS to start reading the points of a node, so
+    /// accessing them later doesn't wait for the disk
+    /// \param[in] _node Node index
+    public: void Prefetch(uint32_t _node) const;
+
+    /// \brief Choose the nodes to draw from a view. Nodes are refined,
+    /// largest screen space error first, until their spacing projects to
+    /// at most `_maxError` pixels or the budget is spent. Nodes outside the
+    /// view are skipped.
+    /// \param[in] _view Camera
+    /// \param[in] _maxError Largest spacing shown, in pixels
+    /// \param[in] _pointBudget Most points in the nodes chosen
+    /// \return Nodes, parents before their children and coarsest first
+    public: std::vector<uint32_t> Select(const View &_view, double _maxError,
+        std::size_t _pointBudget) const;
+
+    /// \brief Start of the file
+    private: const char *data{nullptr};
+
+    /// \brief Length of the file
+    private: std::size_t length{0};
+
+    /// \brief Whole file, where it can't be mapped
+    private: std::vector<char> buffer;
+
+    /// \brief Nodes, in the file
+    private: const Node *nodes{nullptr};
+
+    /// \brief Number of nodes
+    private: std::size_t nodeCount{0};
+
+    /// \brief Points, in the file
+    private: const OctreePoint *points{nullptr};
+
+    /// \brief Number of points
+    private: uint64_t pointCount{0};
+
+    /// \brief Spacing of the root
+    private: double spacing{0};
+  };
+
+  /// \brief Sizes and last use of the octree nodes loaded for rendering,
+  /// to pick which ones to unload once they take more points than a
+  /// budget.
+  ///
+  /// The cache only does the bookkeeping. Its owner frees the nodes
+  /// returned by Evict, and loads them again when they're needed.
+  class PointCloudOctree_EXPORTS_API OctreeNodeCache
+  {
+    /// \brief Add a node, or update its size if it's already known. It
+    /// becomes the most recently used.
+    /// \param[in] _node Node index
+    /// \param[in] _points Number of points it holds
+    public: void Insert(uint32_t _node, std::size_t _points);
+
+    /// \brief Mark a node as the most recently used
+    /// \param[in] _node Node index
+    /// \return False if the node isn't in the cache
+    public: bool Touch(uint32_t _node);
+
+    /// \brief Forget a node
+    /// \param[in] _node Node index
+    public: void Remove(uint32_t _node);
+
+    /// \brief Check whether a node is in the cache
+    /// \param[in] _node Node index
+    /// \return True if it is
+    public: bool Contains(uint32_t _node) const;
+
+    /// \brief Points held by all nodes
+    /// \return Count
+    public: std::size_t Points() const;
+
+    /// \brief Number of nodes
+    /// \return Count
+    public: std::size_t Size() const;
+
+    /// \brief Remove the least recently used nodes which aren't in use
+    /// until the cache fits in a budget, or only nodes in use are left
+    /// \param[in] _budget Points the cache should fit in
+    /// \param[in] _inUse Whether a node is still used, such as being shown,
+    /// in which case it's kept
+    /// \return Nodes removed, least recently used first
+    public: std::vector<uint32_t> Evict(std::size_t _budget,
+        const std::function<bool(uint32_t)> &_inUse);
+
+    /// \brief Size and last use of a node
+    private: struct Entry
+    {
+      /// \brief Points it holds
+      std::size_t points{0};
+
+      /// \brief Value of `tick` when it was last used
+      std::uint64_t lastUse{0};
+    };
+
+    /// \brief Nodes, by index
+    private: std::unordered_map<uint32_t, Entry> entries;
+
+    /// \brief Sum of the points of all entries
+    private: std::size_t points{0};
+
+    /// \brief Incremented on each use, to order them
+    private: std::uint64_t tick{0};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_POINTCLOUDOCTREE_HH_
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "PointCloudOctree.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief A dense grid of points
+/// \param[in] _side Points along each side
+/// \return Points spaced 0.1 m apart, colored by index
+std::vector<OctreePoint> grid(int _side)
+{
+  std::vector<OctreePoint> points;
+  for (int i = 0; i < _side; ++i)
+  {
+    for (int j = 0; j < _side; ++j)
+    {
+      for (int k = 0; k < _side; ++k)
+      {
+        OctreePoint point;
+        point.x = i * 0.1f;
+        point.y = j * 0.1f;
+        point.z = k * 0.1f;
+        point.rgba = static_cast<uint32_t>(points.size());
+        points.push_back(point);
+      }
+    }
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+/// \brief Path of a temporary octree file
+/// \param[in] _name File name
+/// \return Path
+std::string tempPath(const std::string &_name)
+{
+  return testing::TempDir() + _name;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(PointCloudOctreeTest, BuildAndOpen)
+{
+  const std::string path = tempPath("octree_build.gzoct");
+  PointCloudOctree::BuildOptions options;
+  options.cells = 4;
+  options.maxLeafPoints = 100;
+  ASSERT_TRUE(PointCloudOctree::Build(grid(20), options, path));
+
+  PointCloudOctree octree;
+  EXPECT_FALSE(octree.IsOpen());
+  ASSERT_TRUE(octree.Open(path));
+  EXPECT_TRUE(octree.IsOpen());
+  EXPECT_EQ(8000u, octree.PointCount());
+  EXPECT_GT(octree.NodeCount(), 9u);
+
+  // Every point is in exactly one node, inside the node's cube
+  std::set<uint32_t> seen;
+  for (uint32_t i = 0; i < octree.NodeCount(); ++i)
+  {
+    const auto &node = octree.NodeAt(i);
+    EXPECT_GT(node.pointCount, 0u);
+    const OctreePoint *points = octree.Points(i);
+    for (uint32_t p = 0; p < node.pointCount; ++p)
+    {
+      EXPECT_TRUE(seen.insert(points[p].rgba).second);
+      EXPECT_GE(points[p].x, node.min[0]);
+      EXPECT_LE(points[p].x, node.min[0] + node.size);
+    }
+
+    // Inner nodes keep at most one point per cell
+    if (node.childMask != 0)
+    {
+      EXPECT_LE(node.pointCount, 4u * 4u * 4u);
+    }
+  }
+  EXPECT_EQ(8000u, seen.size());
+  EXPECT_DOUBLE_EQ(octree.Spacing(0) * 0.5,
+      octree.Spacing(octree.NodeAt(0).firstChild));
+
+  octree.Close();
+  EXPECT_FALSE(octree.IsOpen());
+  EXPECT_EQ(0u, octree.NodeCount());
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudOctreeTest, InvalidFiles)
+{
+  PointCloudOctree octree;
+  EXPECT_FALSE(octree.Open(tempPath("octree_missing.gzoct")));
+
+  const std::string path = tempPath("octree_invalid.gzoct");
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "not an octree, but long enough to hold a header, and then "
+            "some more bytes";
+  }
+  EXPECT_FALSE(octree.Open(path));
+  EXPECT_FALSE(octree.IsOpen());
+  std::remove(path.c_str());
+
+  EXPECT_FALSE(PointCloudOctree::Build({}, {}, path));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudOctreeTest, Select)
+{
+  const std::string path = tempPath("octree_select.gzoct");
+  PointCloudOctree::BuildOptions options;
+  options.cells = 4;
+  options.maxLeafPoints = 100;
+  ASSERT_TRUE(PointCloudOctree::Build(grid(20), options, path));
+  PointCloudOctree octree;
+  ASSERT_TRUE(octree.Open(path));
+
+  // Far away, the root is enough
+  PointCloudOctree::View view;
+  view.position.Set(1000, 1, 1);
+  view.pixelsPerRadian = 1000;
+  auto far = octree.Select(view, 2.0, 1000000);
+  ASSERT_EQ(1u, far.size());
+  EXPECT_EQ(0u, far[0]);
+
+  // Close by, everything is refined, parents first
+  view.position.Set(1, 1, 1);
+  auto near = octree.Select(view, 0.001, 1000000);
+  EXPECT_EQ(octree.NodeCount(), near.size());
+  std::set<uint32_t> selected;
+  for (const auto node : near)
+  {
+    if (node != 0)
+    {
+      bool parentSeen{false};
+      for (const auto parent : selected)
+      {
+        const auto &p = octree.NodeAt(parent);
+        uint32_t children{0};
+        for (int octant = 0; octant < 8; ++octant)
+          children += (p.childMask >> octant) & 1u;
+        parentSeen |= node >= p.firstChild &&
+            node < p.firstChild + children;
+      }
+      EXPECT_TRUE(parentSeen) << node;
+    }
+    selected.insert(node);
+  }
+
+  // The budget stops refinement
+  auto budgeted = octree.Select(view, 0.001, 500);
+  std::size_t points{0};
+  for (const auto node : budgeted)
+    points += octree.NodeAt(node).pointCount;
+  EXPECT_LE(points, 500u);
+  EXPECT_LT(budgeted.size(), near.size());
+
+  // Nodes behind the camera are culled
+  view.position.Set(-5, 1, 1);
+  view.direction.Set(-1, 0, 0);
+  view.halfAngle = 0.5;
+  EXPECT_TRUE(octree.Select(view, 0.001, 1000000).empty());
+
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(OctreeNodeCacheTest, EvictLeastRecentlyUsed)
+{
+  OctreeNodeCache cache;
+  cache.Insert(1, 100);
+  cache.Insert(2, 100);
+  cache.Insert(3, 100);
+  EXPECT_EQ(300u, cache.Points());
+  EXPECT_TRUE(cache.Touch(1));
+  EXPECT_FALSE(cache.Touch(4));
+
+  // Under budget, nothing happens
+  EXPECT_TRUE(cache.Evict(300, nullptr).empty());
+
+  // Node 2 is the least recently used, but it's in use
+  auto evicted = cache.Evict(150, [](uint32_t _node)
+  {
+    return _node == 2;
+  });
+  EXPECT_EQ(std::vector<uint32_t>({3, 1}), evicted);
+  EXPECT_EQ(100u, cache.Points());
+  EXPECT_EQ(1u, cache.Size());
+  EXPECT_TRUE(cache.Contains(2));
+
+  cache.Remove(2);
+  EXPECT_EQ(0u, cache.Points());
+}
@@ -69,7 +69,8 @@ class PointCloudTestFixture : public ::testing::Test
     public: void InitMockData()
     {
       msgs::InitPointCloudPacked(this->pcMsg, "some_frame", true,
-          {{"xyz", msgs::PointCloudPacked::Field::FLOAT32}});
+          {{"xyz", msgs::PointCloudPacked::Field::FLOAT32},
+           {"intensity", msgs::PointCloudPacked::Field::FLOAT32}});
 
       int numberOfPoints{1000};
       unsigned int dataSize{numberOfPoints * this->pcMsg.point_step()};
@@ -81,14 +82,17 @@ class PointCloudTestFixture : public ::testing::Test
       msgs::PointCloudPackedIterator<float> xIter(this->pcMsg, "x");
       msgs::PointCloudPackedIterator<float> yIter(this->pcMsg, "y");
       msgs::PointCloudPackedIterator<float> zIter(this->pcMsg, "z");
+      msgs::PointCloudPackedIterator<float> intensityIter(this->pcMsg,
+          "intensity");
 
       for (float x = 0.0, y = 0.0, z = 0.0;
           xIter != xIter.End();
-          ++xIter, ++yIter, ++zIter)
+          ++xIter, ++yIter, ++zIter, ++intensityIter)
       {
         *xIter = x;
         *yIter = y;
         *zIter = z;
+        *intensityIter = x;
         flatMsg.add_data(x);
 
         x += 1.0;
@@ -142,17 +146,20 @@ class PointCloudTestFixture : public ::testing::Test
           auto dB = maxColor.B() - minColor.B();
           auto dA = maxColor.A() - minColor.A();
 
+          // Colors are quantized to 8 bits per channel
+          const double tol = 0.5 / 255 + 1e-4;
+
           for (int idx = 0; idx < _req.point().size(); idx++)
           {
             // Check color correctness
             EXPECT_NEAR(dR * (_req.point()[idx].x() / 9) + minColor.R(),
-             _req.materials()[idx].diffuse().r(), 1e-3);
+             _req.materials()[idx].diffuse().r(), tol);
             EXPECT_NEAR(dG * (_req.point()[idx].x() / 9) + minColor.G(),
-             _req.materials()[idx].diffuse().g(), 1e-3);
+             _req.materials()[idx].diffuse().g(), tol);
             EXPECT_NEAR(dB * (_req.point()[idx].x() / 9) + minColor.B(),
-             _req.materials()[idx].diffuse().b(), 1e-3);
+             _req.materials()[idx].diffuse().b(), tol);
             EXPECT_NEAR(dA * (_req.point()[idx].x() / 9) + minColor.A(),
-             _req.materials()[idx].diffuse().a(), 1e-3);
+             _req.materials()[idx].diffuse().a(), tol);
 
             std::size_t x = round(_req.point()[idx].x());
             std::size_t y = round(_req.point()[idx].y());
@@ -235,3 +242,55 @@ TEST_F(PointCloudTestFixture,
   // Cleanup
   plugins.clear();
 }
+
+/////////////////////////////////////////////////
+TEST_F(PointCloudTestFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ColorField))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Colored by the intensity field, the float vector isn't subscribed to
+  const char *pluginStr =
+    "<plugin filename=\"PointCloud\" name=\"Point Cloud\">"
+      "<point_cloud_topic>/point_cloud</point_cloud_topic>"
+      "<float_v_topic>/flat</float_v_topic>"
+      "<color_field>intensity</color_field>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+
+  EXPECT_TRUE(app.LoadPlugin("PointCloud",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto window = app.findChild<MainWindow *>();
+  ASSERT_NE(window, nullptr);
+
+  auto plugins = window->findChildren<Plugin *>();
+  EXPECT_EQ(plugins.size(), 1);
+  EXPECT_EQ("intensity",
+      plugins[0]->property("colorField").toString().toStdString());
+
+  window->QuickWindow()->show();
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (!this->receivedMsg && sleep < maxSleep)
+  {
+    this->pointcloudPub.Publish(this->pcMsg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  EXPECT_TRUE(this->receivedMsg);
+
+  // The fields of the cloud are listed for the GUI
+  EXPECT_TRUE(plugins[0]->property("colorFieldList").toStringList().contains(
+      "intensity"));
+
+  plugins.clear();
+}
@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Preprocesses a point cloud map into the octree file shown by the
+// PointCloud plugin's <map> mode. Reads PLY files, ASCII or binary little
+// endian, and text files with one "x y z [r g b]" point per line.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "PointCloudOctree.hh"
+
+using namespace gz::gui::plugins;
+
+namespace
+{
+/// \brief Usage message, after the command
+constexpr const char *kUsage =
+    " [options] <input> <output>\n\n"
+    "Build the octree file of a point cloud map, for the PointCloud plugin's"
+    " <map>.\n"
+    "The input is a .ply file, or a text file with one \"x y z [r g b]\"\n"
+    "point per line, colors from 0 to 255.\n\n"
+    "Options:\n\n"
+    "  --cells arg          Cells along each side of the root's sampling\n"
+    "                       grid. Defaults to 128.\n\n"
+    "  --leaf-points arg    Nodes with at most this many points aren't\n"
+    "                       split. Defaults to 20000.\n\n"
+    "  --max-depth arg      Depth past which nodes aren't split. Defaults\n"
+    "                       to 16.\n\n"
+    "  -h [ --help ]        Print this help message.\n";
+
+/////////////////////////////////////////////////
+/// \brief Pack a color
+/// \param[in] _r Red, 0 to 255
+/// \param[in] _g Green, 0 to 255
+/// \param[in] _b Blue, 0 to 255
+/// \return 0xRRGGBBAA, opaque
+uint32_t packColor(double _r, double _g, double _b)
+{
+  auto channel = [](double _v)
+  {
+    return static_cast<uint32_t>(std::clamp(_v, 0.0, 255.0));
+  };
+  return (channel(_r) << 24) | (channel(_g) << 16) | (channel(_b) << 8) |
+      0xFF;
+}
+
+/// \brief Property of a PLY vertex
+struct PlyProperty
+{
+  /// \brief Name, such as "x"
+  std::string name;
+
+  /// \brief Size in bytes, in binary files
+  std::size_t size{0};
+
+  /// \brief True for float and double
+  bool floating{false};
+
+  /// \brief True for signed integers
+  bool isSigned{false};
+};
+
+/////////////////////////////////////////////////
+/// \brief Size of a PLY type
+/// \param[in] _type Type name
+/// \param[out] _property Property whose size and kind are set
+/// \return False for unknown types
+bool plyType(const std::string &_type, PlyProperty &_property)
+{
+  if (_type == "char" || _type == "int8")
+    _property = {"", 1, false, true};
+  else if (_type == "uchar" || _type == "uint8")
+    _property = {"", 1, false, false};
+  else if (_type == "short" || _type == "int16")
+    _property = {"", 2, false, true};
+  else if (_type == "ushort" || _type == "uint16")
+    _property = {"", 2, false, false};
+  else if (_type == "int" || _type == "int32")
+    _property = {"", 4, false, true};
+  else if (_type == "uint" || _type == "uint32")
+    _property = {"", 4, false, false};
+  else if (_type == "float" || _type == "float32")
+    _property = {"", 4, true, true};
+  else if (_type == "double" || _type == "float64")
+    _property = {"", 8, true, true};
+  else
+    return false;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a binary PLY value
+/// \param[in] _data Value bytes, little endian
+/// \param[in] _property Its type
+/// \return Value
+double plyValue(const char *_data, const PlyProperty &_property)
+{
+  if (_property.floating)
+  {
+    if (_property.size == 4)
+    {
+      float value;
+      std::memcpy(&value, _data, sizeof(value));
+      return value;
+    }
+    double value;
+    std::memcpy(&value, _data, sizeof(value));
+    return value;
+  }
+
+  uint64_t bits{0};
+  std::memcpy(&bits, _data, _property.size);
+  if (_property.isSigned && _property.size < 8 &&
+      (bits >> (_property.size * 8 - 1)) & 1u)
+  {
+    bits |= ~uint64_t{0} << (_property.size * 8);
+  }
+  return _property.isSigned ? static_cast<double>(static_cast<int64_t>(bits)) :
+      static_cast<double>(bits);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the vertices of a PLY file
+/// \param[in] _file File, just opened
+/// \param[out] _points Points read
+/// \return True on success, errors are printed
+bool readPly(std::ifstream &_file, std::vector<OctreePoint> &_points)
+{
+  std::string line;
+  std::string format;
+  uint64_t vertexCount{0};
+  std::vector<PlyProperty> properties;
+  bool inVertex{false};
+  bool seenVertex{false};
+  while (std::getline(_file, line))
+  {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    std::istringstream words(line);
+    std::string keyword;
+    words >> keyword;
+    if (keyword == "format")
+    {
+      words >> format;
+    }
+    else if (keyword == "element")
+    {
+      std::string name;
+      uint64_t count{0};
+      words >> name >> count;
+      inVertex = name == "vertex";
+      if (inVertex)
+      {
+        vertexCount = count;
+        seenVertex = true;
+      }
+      else if (!seenVertex && count > 0)
+      {
+        std::cerr << "Elements before the vertices aren't supported"
+                  << std::endl;
+        return false;
+      }
+    }
+    else if (keyword == "property" && inVertex)
+    {
+      std::string type;
+      PlyProperty property;
+      words >> type;
+      if (type == "list" || !plyType(type, property))
+      {
+        std::cerr << "Unsupported vertex property [" << line << "]"
+                  << std::endl;
+        return false;
+      }
+      words >> property.name;
+      properties.push_back(property);
+    }
+    else if (keyword == "end_header")
+    {
+      break;
+    }
+  }
+
+  if (format != "ascii" && format != "binary_little_endian")
+  {
+    std::cerr << "Unsupported PLY format [" << format << "]" << std::endl;
+    return false;
+  }
+
+  std::size_t fields[6];
+  bool found[6] = {false, false, false, false, false, false};
+  const char *names[6] = {"x", "y", "z", "red", "green", "blue"};
+  std::size_t stride{0};
+  for (std::size_t i = 0; i < properties.size(); ++i)
+  {
+    for (int f = 0; f < 6; ++f)
+    {
+      if (properties[i].name == names[f])
+      {
+        fields[f] = i;
+        found[f] = true;
+      }
+    }
+    stride += properties[i].size;
+  }
+  if (!found[0] || !found[1] || !found[2])
+  {
+    std::cerr << "PLY vertices have no x, y and z" << std::endl;
+    return false;
+  }
+  const bool colored = found[3] && found[4] && found[5];
+
+  _points.reserve(vertexCount);
+  std::vector<double> values(properties.size());
+  std::vector<char> record(stride);
+  for (uint64_t v = 0; v < vertexCount; ++v)
+  {
+    if (format == "ascii")
+    {
+      for (auto &value : values)
+        _file >> value;
+    }
+    else
+    {
+      _file.read(record.data(), static_cast<std::streamsize>(stride));
+      std::size_t offset{0};
+      for (std::size_t i = 0; i < properties.size(); ++i)
+      {
+        values[i] = plyValue(record.data() + offset, properties[i]);
+        offset += properties[i].size;
+      }
+    }
+    if (!_file)
+    {
+      std::cerr << "PLY file ends after [" << v << "] of [" << vertexCount
+                << "] vertices" << std::endl;
+      return false;
+    }
+
+    OctreePoint point;
+    point.x = static_cast<float>(values[fields[0]]);
+    point.y = static_cast<float>(values[fields[1]]);
+    point.z = static_cast<float>(values[fields[2]]);
+    if (colored)
+    {
+      point.rgba = packColor(values[fields[3]], values[fields[4]],
+          values[fields[5]]);
+    }
+    _points.push_back(point);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a text file with one "x y z [r g b]" point per line. Lines
+/// which don't start with 3 numbers are skipped.
+/// \param[in] _file File, just opened
+/// \param[out] _points Points read
+void readXyz(std::ifstream &_file, std::vector<OctreePoint> &_points)
+{
+  std::string line;
+  while (std::getline(_file, line))
+  {
+    std::istringstream values(line);
+    double x, y, z;
+    if (!(values >> x >> y >> z))
+      continue;
+
+    OctreePoint point;
+    point.x = static_cast<float>(x);
+    point.y = static_cast<float>(y);
+    point.z = static_cast<float>(z);
+    double r, g, b;
+    if (values >> r >> g >> b)
+      point.rgba = packColor(r, g, b);
+    _points.push_back(point);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a positive integer option
+/// \param[in] _arg Value
+/// \param[out] _value Parsed value
+/// \return False if it isn't a positive integer
+bool parseCount(const char *_arg, uint64_t &_value)
+{
+  std::istringstream stream(_arg);
+  int64_t value{0};
+  if (!(stream >> value) || !stream.eof() || value < 1)
+    return false;
+  _value = static_cast<uint64_t>(value);
+  return true;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  PointCloudOctree::BuildOptions options;
+  std::vector<std::string> paths;
+  for (int i = 1; i < _argc; ++i)
+  {
+    const std::string arg = _argv[i];
+    if (arg == "-h" || arg == "--help")
+    {
+      std::cout << "Usage: " << _argv[0] << kUsage;
+      return 0;
+    }
+
+    if (arg == "--cells" || arg == "--leaf-points" || arg == "--max-depth")
+    {
+      uint64_t value{0};
+      if (i + 1 >= _argc || !parseCount(_argv[i + 1], value))
+      {
+        std::cerr << "Option [" << arg << "] needs a positive integer"
+                  << std::endl;
+        return 1;
+      }
+      ++i;
+      if (arg == "--cells")
+        options.cells = static_cast<unsigned int>(value);
+      else if (arg == "--leaf-points")
+        options.maxLeafPoints = static_cast<std::size_t>(value);
+      else
+        options.maxDepth = static_cast<unsigned int>(std::min<uint64_t>(
+            value, 255));
+      continue;
+    }
+
+    if (!arg.empty() && arg[0] == '-')
+    {
+      std::cerr << "Unknown option [" << arg << "]" << std::endl
+                << "Usage: " << _argv[0] << kUsage;
+      return 1;
+    }
+    paths.push_back(arg);
+  }
+
+  if (paths.size() != 2)
+  {
+    std::cerr << "Usage: " << _argv[0] << kUsage;
+    return 1;
+  }
+
+  std::ifstream file(paths[0], std::ios::binary);
+  if (!file)
+  {
+    std::cerr << "Failed to open [" << paths[0] << "]" << std::endl;
+    return 1;
+  }
+
+  std::vector<OctreePoint> points;
+  std::string magic(3, '\0');
+  file.read(&magic[0], 3);
+  file.seekg(0);
+  if (magic == "ply")
+  {
+    if (!readPly(file, points))
+      return 1;
+  }
+  else
+  {
+    readXyz(file, points);
+  }
+
+  std::cout << "Read [" << points.size() << "] points from [" << paths[0]
+            << "]" << std::endl;
+
+  gz::common::Console::SetVerbosity(1);
+  if (!PointCloudOctree::Build(std::move(points), options, paths[1]))
+    return 1;
+
+  PointCloudOctree octree;
+  if (!octree.Open(paths[1]))
+    return 1;
+  std::cout << "Wrote [" << octree.NodeCount() << "] nodes to ["
+            << paths[1] << "]" << std::endl;
+  return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/transport/log/QueryOptions.hh>
+
+#include "LogReplay.hh"
+
+namespace gz::gui::plugins
+{
+class LogReplay::Implementation
+{
+  /// \brief Publish the messages on schedule until done or stopped. Runs
+  /// on the replay thread.
+  /// \param[in] _publish Publishes a message
+  /// \param[in] _timeScale How much faster than recorded to replay
+  /// \param[in] _loop True to start over at the end
+  public: void Run(const PublishFn &_publish, double _timeScale, bool _loop);
+
+  /// \brief Messages read, in order
+  public: std::vector<ReplayMessage> messages;
+
+  /// \brief Protects `stop` and `stats`
+  public: mutable std::mutex mutex;
+
+  /// \brief Wakes the replay thread to stop it
+  public: std::condition_variable stopCv;
+
+  /// \brief True to stop the replay thread
+  public: bool stop{false};
+
+  /// \brief True while the replay thread publishes
+  public: std::atomic<bool> running{false};
+
+  /// \brief Stats of the current or last replay
+  public: ReplayStats stats;
+
+  /// \brief Sum of the lateness of the messages published, to average it
+  public: std::chrono::nanoseconds totalLateness{0};
+
+  /// \brief Replay thread
+  public: std::thread thread;
+};
+
+/////////////////////////////////////////////////
+void LogReplay::Implementation::Run(const PublishFn &_publish,
+    double _timeScale, bool _loop)
+{
+  using Clock = std::chrono::steady_clock;
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stop)
+  {
+    ++this->stats.passes;
+    this->stats.target = std::chrono::nanoseconds(0);
+    this->stats.achieved = std::chrono::nanoseconds(0);
+
+    // Deadlines are absolute from the start of the pass, so time spent
+    // publishing doesn't drift the schedule
+    const auto start = Clock::now();
+    for (const auto &msg : this->messages)
+    {
+      const auto offset = std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double, std::nano>(
+          static_cast<double>(msg.time.count()) / _timeScale));
+      const auto due = start + offset;
+      if (this->stopCv.wait_until(lock, due, [this]{return this->stop;}))
+        break;
+
+      lock.unlock();
+      _publish(msg);
+      const auto now = Clock::now();
+      lock.lock();
+
+      const auto lateness = std::max(std::chrono::nanoseconds(0),
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - due));
+      ++this->stats.published;
+      this->totalLateness += lateness;
+      this->stats.meanLateness = this->totalLateness / this->stats.published;
+      this->stats.maxLateness = std::max(this->stats.maxLateness, lateness);
+      this->stats.target = offset;
+      this->stats.achieved =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - start);
+    }
+
+    if (!_loop)
+      break;
+  }
+  this->running = false;
+}
+
+/////////////////////////////////////////////////
+LogReplay::LogReplay()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+LogReplay::~LogReplay()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool LogReplay::Load(const std::string &_path,
+    const std::set<std::string> &_topics)
+{
+  this->Stop();
+  this->dataPtr->messages.clear();
+
+  transport::log::Log log;
+  if (!log.Open(_path))
+  {
+    gzerr << "Failed to open log [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  auto batch = _topics.empty() ?
+      log.QueryMessages() :
+      log.QueryMessages(transport::log::TopicList(_topics));
+  for (const auto &msg : batch)
+  {
+    this->dataPtr->messages.push_back(
+        {msg.TimeReceived(), msg.Topic(), msg.Type(), msg.Data()});
+  }
+  if (this->dataPtr->messages.empty())
+    return true;
+
+  // Messages are returned in the order they were received
+  const auto first = this->dataPtr->messages.front().time;
+  for (auto &msg : this->dataPtr->messages)
+    msg.time -= first;
+  return true;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ReplayMessage> &LogReplay::Messages() const
+{
+  return this->dataPtr->messages;
+}
+
+/////////////////////////////////////////////////
+std::map<std::string, std::string> LogReplay::Topics() const
+{
+  std::map<std::string, std::string> topics;
+  for (const auto &msg : this->dataPtr->messages)
+    topics.emplace(msg.topic, msg.type);
+  return topics;
+}
+
+/////////////////////////////////////////////////
+bool LogReplay::Start(const PublishFn &_publish, double _timeScale,
+    bool _loop)
+{
+  this->Stop();
+  if (this->dataPtr->messages.empty() || !_publish || !(_timeScale > 0.0))
+    return false;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stats = ReplayStats();
+    this->dataPtr->totalLateness = std::chrono::nanoseconds(0);
+  }
+  this->dataPtr->running = true;
+  this->dataPtr->thread = std::thread(&Implementation::Run,
+      this->dataPtr.get(), _publish, _timeScale, _loop);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogReplay::Stop()
+{
+  if (!this->dataPtr->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->stopCv.notify_all();
+  this->dataPtr->thread.join();
+  this->dataPtr->stop = false;
+}
+
+/////////////////////////////////////////////////
+bool LogReplay::Running() const
+{
+  return this->dataPtr->running;
+}
+
+/////////////////////////////////////////////////
+ReplayStats LogReplay::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats;
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_LOGREPLAY_HH_
+#define GZ_GUI_PLUGINS_LOGREPLAY_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#ifndef _WIN32
+#  define LogReplay_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(Publisher_EXPORTS))
+#    define LogReplay_EXPORTS_API __declspec(dllexport)
+#  else
+#    define LogReplay_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Message read from a log
+  struct ReplayMessage
+  {
+    /// \brief Time since the first message read
+    std::chrono::nanoseconds time{0};
+
+    /// \brief Topic
+    std::string topic;
+
+    /// \brief Message type, such as "gz.msgs.Image"
+    std::string type;
+
+    /// \brief Serialized message
+    std::string data;
+  };
+
+  /// \brief How closely a replay keeps the log's timing
+  struct ReplayStats
+  {
+    /// \brief Messages published
+    std::uint64_t published{0};
+
+    /// \brief Times the log was started, more than 1 when looping
+    unsigned int passes{0};
+
+    /// \brief Time the messages published in this pass should have taken,
+    /// the log's time divided by the time scale
+    std::chrono::nanoseconds target{0};
+
+    /// \brief Time they actually took
+    std::chrono::nanoseconds achieved{0};
+
+    /// \brief Average time messages were published after they were due
+    std::chrono::nanoseconds meanLateness{0};
+
+    /// \brief Longest time a message was published after it was due
+    std::chrono::nanoseconds maxLateness{0};
+  };
+
+  /// \brief Replays the messages of a gz-transport log with their original
+  /// timing, from a dedicated thread, to load the GUI and other nodes with
+  /// realistic, bursty traffic.
+  ///
+  /// Messages are read up front, so the log's database doesn't disturb the
+  /// timing, which means the selected topics must fit in memory. Each
+  /// message is due at its time in the log divided by the time scale.
+  /// Messages which are late are published right away and the schedule is
+  /// kept, so bursts stay bursts and the lateness shows how far behind the
+  /// replay fell.
+  class LogReplay_EXPORTS_API LogReplay
+  {
+    /// \brief Function publishing a message, called from the replay thread
+    public: using PublishFn = std::function<void(const ReplayMessage &)>;
+
+    /// \brief Constructor
+    public: LogReplay();
+
+    /// \brief Destructor, stops replaying
+    public: ~LogReplay();
+
+    /// \brief Read the messages of a log, replacing those read before.
+    /// Stops replaying.
+    /// \param[in] _path Path of the log
+    /// \param[in] _topics Topics to read, empty for all of them
+    /// \return False if the log couldn't be opened
+    public: bool Load(const std::string &_path,
+        const std::set<std::string> &_topics = {});
+
+    /// \brief Get the messages read, in order
+    /// \return Messages
+    public: const std::vector<ReplayMessage> &Messages() const;
+
+    /// \brief Get the type of each topic read
+    /// \return Message type by topic
+    public: std::map<std::string, std::string> Topics() const;
+
+    /// \brief Start replaying from the first message, stopping the replay
+    /// in progress first
+    /// \param[in] _publish Called with each message when it's due
+    /// \param[in] _timeScale How much faster than recorded to replay, 2 for
+    /// twice as fast. Must be positive.
+    /// \param[in] _loop True to start over once the last message is
+    /// published
+    /// \return False if there are no messages or the scale isn't positive
+    public: bool Start(const PublishFn &_publish, double _timeScale = 1.0,
+        bool _loop = false);
+
+    /// \brief Stop replaying, waiting for the replay thread
+    public: void Stop();
+
+    /// \brief Whether messages are still being replayed
+    /// \return False once stopped or done
+    public: bool Running() const;
+
+    /// \brief Get the timing of the replay so far
+    /// \return Stats of the current or last replay
+    public: ReplayStats Stats() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}
+
+#endif
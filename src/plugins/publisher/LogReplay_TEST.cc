@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/transport/log/Log.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "LogReplay.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Write a log with a msg every 100 ms on "/fast", and every 200 ms
+/// on "/slow"
+/// \param[in] _path Path of the log
+/// \return True if written
+bool writeLog(const std::string &_path)
+{
+  transport::log::Log log;
+  if (!log.Open(_path, std::ios_base::out))
+    return false;
+
+  const std::chrono::nanoseconds start(std::chrono::seconds(1000));
+  for (int i = 0; i < 10; ++i)
+  {
+    const std::string data = std::to_string(i);
+    const auto time = start + std::chrono::milliseconds(100 * i);
+    log.InsertMessage(time, "/fast", "gz.msgs.StringMsg", data.data(),
+        data.size());
+    if (i % 2 == 0)
+    {
+      log.InsertMessage(time, "/slow", "gz.msgs.Int32", data.data(),
+          data.size());
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST(LogReplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Load))
+{
+  const auto dir = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "test", "log_replay_load");
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+  const auto path = common::joinPaths(dir, "replay.tlog");
+  ASSERT_TRUE(writeLog(path));
+
+  LogReplay replay;
+  EXPECT_FALSE(replay.Load(common::joinPaths(dir, "missing.tlog")));
+  EXPECT_TRUE(replay.Messages().empty());
+  EXPECT_FALSE(replay.Start([](const ReplayMessage &){}));
+
+  ASSERT_TRUE(replay.Load(path));
+  EXPECT_EQ(15u, replay.Messages().size());
+  const auto topics = replay.Topics();
+  ASSERT_EQ(2u, topics.size());
+  EXPECT_EQ("gz.msgs.StringMsg", topics.at("/fast"));
+  EXPECT_EQ("gz.msgs.Int32", topics.at("/slow"));
+
+  // Times start at the first msg
+  EXPECT_EQ(std::chrono::nanoseconds(0), replay.Messages().front().time);
+  EXPECT_EQ(std::chrono::milliseconds(900), replay.Messages().back().time);
+
+  // Only the selected topics
+  ASSERT_TRUE(replay.Load(path, {"/slow"}));
+  ASSERT_EQ(5u, replay.Messages().size());
+  for (std::size_t i = 0; i < replay.Messages().size(); ++i)
+  {
+    EXPECT_EQ("/slow", replay.Messages()[i].topic);
+    EXPECT_EQ(std::to_string(i * 2), replay.Messages()[i].data);
+  }
+
+  common::removeAll(dir);
+}
+
+/////////////////////////////////////////////////
+TEST(LogReplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Replay))
+{
+  const auto dir = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "test", "log_replay_replay");
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+  const auto path = common::joinPaths(dir, "replay.tlog");
+  ASSERT_TRUE(writeLog(path));
+
+  LogReplay replay;
+  ASSERT_TRUE(replay.Load(path, {"/fast"}));
+  EXPECT_FALSE(replay.Start([](const ReplayMessage &){}, 0.0));
+
+  // Twice as fast, so the 900 ms log takes 450 ms
+  std::mutex mutex;
+  std::vector<std::string> published;
+  std::vector<std::chrono::steady_clock::time_point> times;
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(replay.Start([&](const ReplayMessage &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        published.push_back(_msg.data);
+        times.push_back(std::chrono::steady_clock::now());
+      }, 2.0));
+  EXPECT_TRUE(replay.Running());
+  for (int i = 0; i < 50 && replay.Running(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(replay.Running());
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(10u, published.size());
+    for (std::size_t i = 0; i < published.size(); ++i)
+      EXPECT_EQ(std::to_string(i), published[i]);
+    EXPECT_GE(times.back() - start, std::chrono::milliseconds(440));
+    EXPECT_LT(times.back() - start, std::chrono::milliseconds(1000));
+  }
+
+  const auto stats = replay.Stats();
+  EXPECT_EQ(10u, stats.published);
+  EXPECT_EQ(1u, stats.passes);
+  EXPECT_EQ(std::chrono::milliseconds(450), stats.target);
+  EXPECT_GE(stats.achieved, stats.target);
+  EXPECT_LE(stats.meanLateness, stats.maxLateness);
+  EXPECT_LT(stats.maxLateness, std::chrono::milliseconds(200));
+
+  // Looping until stopped
+  ASSERT_TRUE(replay.Start([](const ReplayMessage &){}, 10.0, true));
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_TRUE(replay.Running());
+  replay.Stop();
+  EXPECT_FALSE(replay.Running());
+  EXPECT_GE(replay.Stats().passes, 2u);
+  EXPECT_GT(replay.Stats().published, 10u);
+
+  common::removeAll(dir);
+}
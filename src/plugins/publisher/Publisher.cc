@@ -16,12 +16,23 @@
 */
 
 #include <gz/utils/ImplPtr.hh>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
 #include <gz/common/Console.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
 
+#include "LogReplay.hh"
 #include "Publisher.hh"
 
 namespace gz::gui::plugins
@@ -40,24 +51,213 @@ class Publisher::Implementation
   /// \brief Frequency
   public: double frequency = 1.0;
 
+  /// \brief True to publish from a dedicated thread instead of the GUI
+  /// thread's timer
+  public: bool threaded = false;
+
+  /// \brief Path of the log to replay, empty to publish the message
+  public: QString replayLog;
+
+  /// \brief Topics to replay, separated by spaces, empty for all
+  public: QString replayTopics;
+
+  /// \brief How much faster than recorded to replay
+  public: double timeScale = 1.0;
+
+  /// \brief True to replay the log over and over
+  public: bool loop = false;
+
+  /// \brief Timing of the replay shown on the GUI
+  public: QString replayStats;
+
+  /// \brief Messages per second published during the last second
+  public: double achievedRate = 0.0;
+
   /// \brief Timer to keep publishing
-  public: QTimer *timer;
+  public: QTimer *timer{nullptr};
 
   /// \brief Node for communication
   public: gz::transport::Node node;
 
   /// \brief Publisher
   public: gz::transport::Node::Publisher pub;
+
+  /// \brief Messages published since the last rate update
+  public: std::atomic<std::uint64_t> publishCount{0};
+
+  /// \brief Updates the achieved rate
+  public: QTimer rateTimer;
+
+  /// \brief When the achieved rate was last updated
+  public: std::chrono::steady_clock::time_point rateTime;
+
+  /// \brief Protects `stop` for the publisher thread
+  public: std::mutex mutex;
+
+  /// \brief Wakes the publisher thread to stop it
+  public: std::condition_variable stopCv;
+
+  /// \brief True to stop the publisher thread
+  public: bool stop{false};
+
+  /// \brief Publishes while `threaded` is true
+  public: std::thread publishThread;
+
+  /// \brief Replays the log
+  public: LogReplay replay;
+
+  /// \brief Publishers of the replayed topics, only changed while the
+  /// replay is stopped
+  public: std::map<std::string, gz::transport::Node::Publisher> replayPubs;
+
+  /// \brief Publish serialized data periodically until stopped. Runs on
+  /// the publisher thread.
+  /// \param[in] _data Serialized message
+  /// \param[in] _type Message type
+  /// \param[in] _period Time between messages
+  public: void PublishLoop(const std::string &_data, const std::string &_type,
+      std::chrono::steady_clock::duration _period);
+
+  /// \brief Read the log and start replaying it
+  /// \return False if there's nothing to replay
+  public: bool StartReplay();
+
+  /// \brief Stop publishing, from either the timer or the thread
+  public: void Stop();
 };
 
+/////////////////////////////////////////////////
+void Publisher::Implementation::PublishLoop(const std::string &_data,
+    const std::string &_type, std::chrono::steady_clock::duration _period)
+{
+  using Clock = std::chrono::steady_clock;
+
+  // Deadlines are absolute so that time spent publishing doesn't drift the
+  // rate
+  auto next = Clock::now();
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stop)
+  {
+    lock.unlock();
+    this->pub.PublishRaw(_data, _type);
+    this->publishCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Skip ticks which couldn't be kept up with, the achieved rate shows it
+    next += _period;
+    const auto now = Clock::now();
+    if (next < now)
+      next = now;
+
+    lock.lock();
+    this->stopCv.wait_until(lock, next, [this]{return this->stop;});
+  }
+}
+
+/////////////////////////////////////////////////
+bool Publisher::Implementation::StartReplay()
+{
+  std::set<std::string> topics;
+  for (const auto &topic : this->replayTopics.split(" ", Qt::SkipEmptyParts))
+    topics.insert(topic.toStdString());
+
+  const auto path = this->replayLog.toStdString();
+  if (!this->replay.Load(path, topics))
+    return false;
+  if (this->replay.Messages().empty())
+  {
+    gzerr << "No messages to replay in log[" << path << "].\n";
+    return false;
+  }
+
+  this->replayPubs.clear();
+  for (const auto &[topic, type] : this->replay.Topics())
+  {
+    auto pub = this->node.Advertise(topic, type);
+    if (!pub)
+    {
+      gzerr << "Unable to publish on topic[" << topic << "] "
+        << "with message type[" << type << "].\n";
+      continue;
+    }
+    this->replayPubs.emplace(topic, std::move(pub));
+  }
+
+  return this->replay.Start([this](const ReplayMessage &_msg)
+  {
+    auto pub = this->replayPubs.find(_msg.topic);
+    if (pub == this->replayPubs.end())
+      return;
+    pub->second.PublishRaw(_msg.data, _msg.type);
+    this->publishCount.fetch_add(1, std::memory_order_relaxed);
+  }, this->timeScale, this->loop);
+}
+
+/////////////////////////////////////////////////
+void Publisher::Implementation::Stop()
+{
+  this->replay.Stop();
+
+  if (this->timer != nullptr)
+  {
+    this->timer->stop();
+    QObject::disconnect(this->timer, nullptr, nullptr, nullptr);
+  }
+
+  if (this->publishThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stop = true;
+    }
+    this->stopCv.notify_all();
+    this->publishThread.join();
+    this->stop = false;
+  }
+}
+
 /////////////////////////////////////////////////
 Publisher::Publisher()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
+  this->connect(&this->dataPtr->rateTimer, &QTimer::timeout, this, [this]()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> elapsed =
+        now - this->dataPtr->rateTime;
+    this->dataPtr->rateTime = now;
+    if (elapsed.count() <= 0.0)
+      return;
+
+    this->dataPtr->achievedRate =
+        this->dataPtr->publishCount.exchange(0) / elapsed.count();
+    emit this->AchievedRateChanged();
+
+    if (this->dataPtr->replayPubs.empty())
+      return;
+
+    const auto stats = this->dataPtr->replay.Stats();
+    auto ms = [](std::chrono::nanoseconds _time)
+    {
+      return QString::number(_time.count() * 1e-6, 'f', 1);
+    };
+    this->dataPtr->replayStats = QString(
+        "%1%2 msgs, log time %3 ms in %4 ms, late %5 ms on average, "
+        "%6 ms at worst")
+        .arg(this->dataPtr->replay.Running() ? "" : "Done, ")
+        .arg(stats.published)
+        .arg(ms(stats.target))
+        .arg(ms(stats.achieved))
+        .arg(ms(stats.meanLateness))
+        .arg(ms(stats.maxLateness));
+    emit this->ReplayStatsChanged();
+  });
 }
 
 /////////////////////////////////////////////////
-Publisher::~Publisher() = default;
+Publisher::~Publisher()
+{
+  this->dataPtr->Stop();
+}
 
 /////////////////////////////////////////////////
 void Publisher::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
@@ -82,6 +282,43 @@ void Publisher::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto frequencyElem = _pluginElem->FirstChildElement("frequency"))
       frequencyElem->QueryDoubleText(&this->dataPtr->frequency);
+
+    if (auto threadedElem = _pluginElem->FirstChildElement("threaded"))
+      threadedElem->QueryBoolText(&this->dataPtr->threaded);
+
+    if (auto replayElem = _pluginElem->FirstChildElement("replay"))
+    {
+      auto logElem = replayElem->FirstChildElement("log");
+      if (nullptr != logElem && nullptr != logElem->GetText())
+        this->dataPtr->replayLog = logElem->GetText();
+
+      QStringList topics;
+      for (auto topicElem = replayElem->FirstChildElement("topic");
+          nullptr != topicElem;
+          topicElem = topicElem->NextSiblingElement("topic"))
+      {
+        if (nullptr != topicElem->GetText())
+          topics.append(topicElem->GetText());
+      }
+      this->dataPtr->replayTopics = topics.join(" ");
+
+      if (auto scaleElem = replayElem->FirstChildElement("time_scale"))
+      {
+        double scale{1.0};
+        if (scaleElem->QueryDoubleText(&scale) != tinyxml2::XML_SUCCESS ||
+            !(scale > 0.0))
+        {
+          gzerr << "Invalid <time_scale>, must be positive" << std::endl;
+        }
+        else
+        {
+          this->dataPtr->timeScale = scale;
+        }
+      }
+
+      if (auto loopElem = replayElem->FirstChildElement("loop"))
+        loopElem->QueryBoolText(&this->dataPtr->loop);
+    }
   }
 
   this->dataPtr->timer = new QTimer(this);
@@ -90,16 +327,42 @@ void Publisher::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void Publisher::OnPublish(const bool _checked)
 {
+  // Restart with the latest parameters
+  this->dataPtr->Stop();
+  this->dataPtr->rateTimer.stop();
+  this->dataPtr->publishCount = 0;
+  if (this->dataPtr->achievedRate != 0.0)
+  {
+    this->dataPtr->achievedRate = 0.0;
+    emit this->AchievedRateChanged();
+  }
+
+  if (!this->dataPtr->replayStats.isEmpty())
+  {
+    this->dataPtr->replayStats.clear();
+    emit this->ReplayStatsChanged();
+  }
+
   if (!_checked)
   {
-    if (this->dataPtr->timer != nullptr)
+    this->dataPtr->pub = transport::Node::Publisher();
+    this->dataPtr->replayPubs.clear();
+    return;
+  }
+
+  if (!this->dataPtr->replayLog.isEmpty())
+  {
+    if (!this->dataPtr->StartReplay())
     {
-      this->dataPtr->timer->stop();
-      disconnect(this->dataPtr->timer, nullptr, nullptr, nullptr);
+      this->dataPtr->replayPubs.clear();
+      // TODO(anyone): notify error and uncheck switch
+      return;
     }
-    this->dataPtr->pub = transport::Node::Publisher();
+    this->dataPtr->rateTime = std::chrono::steady_clock::now();
+    this->dataPtr->rateTimer.start(1000);
     return;
   }
+  this->dataPtr->replayPubs.clear();
 
   auto topic = this->dataPtr->topic.toStdString();
   auto msgType = this->dataPtr->msgType.toStdString();
@@ -134,11 +397,33 @@ void Publisher::OnPublish(const bool _checked)
     return;
   }
 
-  this->dataPtr->timer->setInterval(1000/this->dataPtr->frequency);
+  // The message is only parsed and serialized once
+  std::string data;
+  if (!msg->SerializeToString(&data))
+  {
+    gzerr << "Unable to serialize message of type[" << msgType << "].\n";
+    return;
+  }
+
+  this->dataPtr->rateTime = std::chrono::steady_clock::now();
+  this->dataPtr->rateTimer.start(1000);
+
+  if (this->dataPtr->threaded)
+  {
+    this->dataPtr->publishThread = std::thread(
+        &Implementation::PublishLoop, this->dataPtr.get(), data, msgType,
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / this->dataPtr->frequency)));
+    return;
+  }
+
+  this->dataPtr->timer->setTimerType(Qt::PreciseTimer);
+  this->dataPtr->timer->setInterval(
+      std::max(1, static_cast<int>(1000 / this->dataPtr->frequency)));
   connect(this->dataPtr->timer, &QTimer::timeout, this->dataPtr->timer, [=]()
   {
-    auto newMsg = msgs::Factory::New(msgType, msgData);
-    this->dataPtr->pub.Publish(*newMsg);
+    this->dataPtr->pub.PublishRaw(data, msgType);
+    this->dataPtr->publishCount.fetch_add(1, std::memory_order_relaxed);
   });
   this->dataPtr->timer->start();
 }
@@ -194,6 +479,76 @@ void Publisher::SetFrequency(const double _frequency)
   this->dataPtr->frequency = _frequency;
   emit this->FrequencyChanged();
 }
+
+/////////////////////////////////////////////////
+bool Publisher::Threaded() const
+{
+  return this->dataPtr->threaded;
+}
+
+/////////////////////////////////////////////////
+void Publisher::SetThreaded(const bool _threaded)
+{
+  this->dataPtr->threaded = _threaded;
+  emit this->ThreadedChanged();
+}
+
+/////////////////////////////////////////////////
+QString Publisher::ReplayLog() const
+{
+  return this->dataPtr->replayLog;
+}
+
+/////////////////////////////////////////////////
+void Publisher::SetReplayLog(const QString &_path)
+{
+  this->dataPtr->replayLog = _path;
+  emit this->ReplayLogChanged();
+}
+
+/////////////////////////////////////////////////
+QString Publisher::ReplayTopics() const
+{
+  return this->dataPtr->replayTopics;
+}
+
+/////////////////////////////////////////////////
+void Publisher::SetReplayTopics(const QString &_topics)
+{
+  this->dataPtr->replayTopics = _topics;
+  emit this->ReplayTopicsChanged();
+}
+
+/////////////////////////////////////////////////
+double Publisher::TimeScale() const
+{
+  return this->dataPtr->timeScale;
+}
+
+/////////////////////////////////////////////////
+void Publisher::SetTimeScale(const double _timeScale)
+{
+  if (!(_timeScale > 0.0))
+  {
+    gzerr << "Time scale must be positive, got [" << _timeScale << "]"
+          << std::endl;
+    return;
+  }
+  this->dataPtr->timeScale = _timeScale;
+  emit this->TimeScaleChanged();
+}
+
+/////////////////////////////////////////////////
+QString Publisher::ReplayStats() const
+{
+  return this->dataPtr->replayStats;
+}
+
+/////////////////////////////////////////////////
+double Publisher::AchievedRate() const
+{
+  return this->dataPtr->achievedRate;
+}
 }  // namespace gz::gui::plugins
 
 // Register this plugin
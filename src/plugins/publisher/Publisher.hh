@@ -38,7 +38,34 @@ namespace gz::gui::plugins
   /// \brief Widget which publishes a custom Gazebo Transport message.
   ///
   /// ## Configuration
-  /// This plugin doesn't accept any custom configuration.
+  /// * \<message_type\> : Message type, defaults to "gz.msgs.StringMsg".
+  /// * \<message\> : Message contents in text format.
+  /// * \<topic\> : Topic, defaults to "/echo".
+  /// * \<frequency\> : Messages per second, zero to publish once.
+  /// * \<threaded\> : True to publish from a dedicated thread, which keeps
+  ///                  sub-millisecond periods and isn't held up by the GUI
+  ///                  thread. Defaults to false, which publishes from a
+  ///                  timer on the GUI thread, limited to 1 kHz.
+  /// * \<replay\> : Replay a gz-transport log instead of publishing the
+  ///                message, see below. Contains:
+  ///   * \<log\> : Path of the log.
+  ///   * \<topic\> : Topic to replay, may be repeated. Defaults to all the
+  ///                 topics of the log.
+  ///   * \<time_scale\> : How much faster than recorded to replay, 2 for
+  ///                      twice as fast. Defaults to 1.
+  ///   * \<loop\> : True to start over at the end. Defaults to false.
+  ///
+  /// The message is parsed and serialized once when publishing starts.
+  ///
+  /// ## Replay
+  ///
+  /// To load the GUI and other nodes with realistic, bursty traffic, a log
+  /// recorded with `gz log record` or TopicEcho can be republished with
+  /// its original timing, scaled by the time scale. Messages are read
+  /// before replaying starts and are published from a dedicated thread.
+  /// How closely the timing is kept is shown while replaying: the log time
+  /// the published messages should have taken against the time they took,
+  /// and how late they were on average and at worst.
   class Publisher_EXPORTS_API Publisher : public Plugin
   {
     Q_OBJECT
@@ -75,6 +102,52 @@ namespace gz::gui::plugins
       NOTIFY FrequencyChanged
     )
 
+    /// \brief Publish from a dedicated thread
+    Q_PROPERTY(
+      bool threaded
+      READ Threaded
+      WRITE SetThreaded
+      NOTIFY ThreadedChanged
+    )
+
+    /// \brief Path of the log to replay, empty to publish the message
+    Q_PROPERTY(
+      QString replayLog
+      READ ReplayLog
+      WRITE SetReplayLog
+      NOTIFY ReplayLogChanged
+    )
+
+    /// \brief Topics to replay, separated by spaces, empty for all
+    Q_PROPERTY(
+      QString replayTopics
+      READ ReplayTopics
+      WRITE SetReplayTopics
+      NOTIFY ReplayTopicsChanged
+    )
+
+    /// \brief How much faster than recorded to replay
+    Q_PROPERTY(
+      double timeScale
+      READ TimeScale
+      WRITE SetTimeScale
+      NOTIFY TimeScaleChanged
+    )
+
+    /// \brief Timing of the replay, empty when not replaying
+    Q_PROPERTY(
+      QString replayStats
+      READ ReplayStats
+      NOTIFY ReplayStatsChanged
+    )
+
+    /// \brief Messages per second published during the last second
+    Q_PROPERTY(
+      double achievedRate
+      READ AchievedRate
+      NOTIFY AchievedRateChanged
+    )
+
     /// \brief Constructor
     public: Publisher();
 
@@ -138,6 +211,68 @@ namespace gz::gui::plugins
     /// \brief Notify that frequency has changed
     signals: void FrequencyChanged();
 
+    /// \brief Get whether messages are published from a dedicated thread
+    /// \return True if threaded
+    public: Q_INVOKABLE bool Threaded() const;
+
+    /// \brief Set whether to publish from a dedicated thread, used the next
+    /// time publishing starts
+    /// \param[in] _threaded True for a dedicated thread
+    public: Q_INVOKABLE void SetThreaded(const bool _threaded);
+
+    /// \brief Notify that the threaded mode has changed
+    signals: void ThreadedChanged();
+
+    /// \brief Get the path of the log to replay
+    /// \return Path, empty to publish the message instead
+    public: Q_INVOKABLE QString ReplayLog() const;
+
+    /// \brief Set the path of the log to replay, used the next time
+    /// publishing starts
+    /// \param[in] _path Path, empty to publish the message instead
+    public: Q_INVOKABLE void SetReplayLog(const QString &_path);
+
+    /// \brief Notify that the log to replay has changed
+    signals: void ReplayLogChanged();
+
+    /// \brief Get the topics to replay
+    /// \return Topics separated by spaces, empty for all
+    public: Q_INVOKABLE QString ReplayTopics() const;
+
+    /// \brief Set the topics to replay, used the next time publishing
+    /// starts
+    /// \param[in] _topics Topics separated by spaces, empty for all
+    public: Q_INVOKABLE void SetReplayTopics(const QString &_topics);
+
+    /// \brief Notify that the topics to replay have changed
+    signals: void ReplayTopicsChanged();
+
+    /// \brief Get how much faster than recorded to replay
+    /// \return Time scale
+    public: Q_INVOKABLE double TimeScale() const;
+
+    /// \brief Set how much faster than recorded to replay, used the next
+    /// time publishing starts
+    /// \param[in] _timeScale Time scale, 2 for twice as fast
+    public: Q_INVOKABLE void SetTimeScale(const double _timeScale);
+
+    /// \brief Notify that the time scale has changed
+    signals: void TimeScaleChanged();
+
+    /// \brief Get the timing of the replay, updated every second
+    /// \return Summary, empty when not replaying
+    public: Q_INVOKABLE QString ReplayStats() const;
+
+    /// \brief Notify that the timing of the replay has changed
+    signals: void ReplayStatsChanged();
+
+    /// \brief Get the messages per second published during the last second
+    /// \return Achieved rate, in Hz
+    public: Q_INVOKABLE double AchievedRate() const;
+
+    /// \brief Notify that the achieved rate has changed
+    signals: void AchievedRateChanged();
+
     /// \internal
     /// \brief Pointer to private data.
     private: GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
@@ -22,7 +22,7 @@ Rectangle {
   id: publisher
   color: "transparent"
   Layout.minimumWidth: 250
-  Layout.minimumHeight: 375
+  Layout.minimumHeight: 525
   anchors.fill: parent
 
   property int tooltipDelay: 500
@@ -85,6 +85,61 @@ Rectangle {
 //      maximumValue: 10000.0
     }
 
+    CheckBox {
+      id: threadedField
+      text: qsTr("Dedicated thread")
+      checked: Publisher.threaded
+      ToolTip.visible: hovered
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text:
+          qsTr("Publish from a dedicated thread, for rates above 1 kHz")
+    }
+
+    Label {
+      text: "Replay log"
+      ToolTip.visible: replayMa.containsMouse
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Path of a gz-transport log to replay with its " +
+          "original timing instead of publishing the message")
+
+      MouseArea {
+        id: replayMa
+        anchors.fill: parent
+        hoverEnabled: true
+      }
+    }
+
+    TextField {
+      id: replayLogField
+      text: Publisher.replayLog
+      placeholderText: qsTr("None")
+      selectByMouse: true
+    }
+
+    TextField {
+      id: replayTopicsField
+      visible: replayLogField.text !== ""
+      text: Publisher.replayTopics
+      placeholderText: qsTr("All topics")
+      selectByMouse: true
+    }
+
+    TextField {
+      id: timeScaleField
+      visible: replayLogField.text !== ""
+      text: Publisher.timeScale
+      selectByMouse: true
+      validator: DoubleValidator {
+        bottom: 0.001
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Time scale, 2 to replay twice as fast")
+    }
+
     Switch {
       text: qsTr("Publish")
       onToggled: {
@@ -94,6 +149,11 @@ Rectangle {
         Publisher.topic = topicField.text
         Publisher.msgData = msgDataField.text
         Publisher.frequency = frequencyField.value
+        Publisher.threaded = threadedField.checked
+        Publisher.replayLog = replayLogField.text
+        Publisher.replayTopics = replayTopicsField.text
+        if (timeScaleField.acceptableInput)
+          Publisher.timeScale = parseFloat(timeScaleField.text)
 
         Publisher.OnPublish(checked);
       }
@@ -102,5 +162,19 @@ Rectangle {
       ToolTip.timeout: tooltipTimeout
       ToolTip.text: checked ? qsTr("Stop publising") : qsTr("Start publishing")
     }
+
+    Label {
+      visible: Publisher.achievedRate > 0
+      text: "Achieved " + Publisher.achievedRate.toFixed(1) + " Hz"
+      color: "dimgrey"
+    }
+
+    Label {
+      visible: Publisher.replayStats !== ""
+      width: parent.width
+      wrapMode: Text.WordWrap
+      text: Publisher.replayStats
+      color: "dimgrey"
+    }
   }
 }
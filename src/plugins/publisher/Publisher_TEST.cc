@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <atomic>
+
 #include <gz/msgs/stringmsg.pb.h>
 
 #include <gz/transport/Node.hh>
@@ -199,6 +202,36 @@ TEST(PublisherTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Publish))
   EXPECT_FALSE(received);
   plugin->OnPublish(false);
 
+  // Dedicated thread, above the 1 kHz of the GUI timer
+  std::atomic<int> count{0};
+  std::function<void(const msgs::StringMsg &)> countCb =
+      [&](const msgs::StringMsg &_msg)
+  {
+    EXPECT_EQ(_msg.data(), "Hello");
+    ++count;
+  };
+  node.Subscribe("/echo_fast", countCb);
+
+  plugin->SetMsgData("data: \"Hello\"");
+  plugin->SetTopic("/echo_fast");
+  plugin->SetFrequency(2000.0);
+  plugin->SetThreaded(true);
+  EXPECT_TRUE(plugin->Threaded());
+  plugin->OnPublish(true);
+
+  sleep = 0;
+  while (plugin->AchievedRate() <= 0.0 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    sleep++;
+  }
+  EXPECT_GT(plugin->AchievedRate(), 1000.0);
+  EXPECT_GT(count.load(), 1000);
+
+  plugin->OnPublish(false);
+  EXPECT_DOUBLE_EQ(0.0, plugin->AchievedRate());
+
   // Cleanup
   plugins.clear();
 }
@@ -218,6 +251,12 @@ TEST(PublisherTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ParamsFromSDF))
       "<message>number: 1 fruit {name:\"banana\"}</message>"
       "<message_type>gz.msgs.Fruits</message_type>"
       "<frequency>0.1</frequency>"
+      "<replay>"
+        "<log>/tmp/fruit.tlog</log>"
+        "<topic>/fruit</topic>"
+        "<topic>/veggie</topic>"
+        "<time_scale>2.5</time_scale>"
+      "</replay>"
     "</plugin>";
 
   tinyxml2::XMLDocument pluginDoc;
@@ -250,4 +289,10 @@ TEST(PublisherTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ParamsFromSDF))
 
   // Frequency
   EXPECT_DOUBLE_EQ(plugin->Frequency(), 0.1);
+
+  // Replay
+  EXPECT_EQ(plugin->ReplayLog(), "/tmp/fruit.tlog");
+  EXPECT_EQ(plugin->ReplayTopics(), "/fruit /veggie");
+  EXPECT_DOUBLE_EQ(plugin->TimeScale(), 2.5);
+  EXPECT_TRUE(plugin->ReplayStats().isEmpty());
 }
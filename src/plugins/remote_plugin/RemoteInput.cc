@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <utility>
+
+#include "RemoteInput.hh"
+
+namespace gz::gui::plugins
+{
+namespace
+{
+/// \brief Protocol buttons, the same as common::MouseEvent's
+enum InputButton
+{
+  kLeft = 1,
+  kMiddle = 2,
+  kRight = 4
+};
+
+/// \brief Qt::MouseButton values, without depending on Qt
+enum QtButton
+{
+  kQtLeft = 0x01,
+  kQtRight = 0x02,
+  kQtMiddle = 0x04
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a param of a msg
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \return The param, or null if missing
+const msgs::Any *param(const msgs::Param &_msg, const std::string &_key)
+{
+  auto it = _msg.params().find(_key);
+  return it == _msg.params().end() ? nullptr : &it->second;
+}
+
+/////////////////////////////////////////////////
+/// \brief Set an int param of a msg
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \param[in] _value Value
+void setParam(msgs::Param &_msg, const std::string &_key, int _value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_INT32);
+  any.set_int_value(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Set a bool param of a msg
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \param[in] _value Value
+void setParam(msgs::Param &_msg, const std::string &_key, bool _value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_BOOLEAN);
+  any.set_bool_value(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Set a string param of a msg
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \param[in] _value Value
+void setParam(msgs::Param &_msg, const std::string &_key,
+    const std::string &_value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_STRING);
+  any.set_string_value(_value);
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+RemoteInput RemoteInput::FromMsg(const msgs::Param &_msg)
+{
+  RemoteInput input;
+  if (auto *any = param(_msg, "type"))
+    input.type = any->string_value();
+  if (auto *any = param(_msg, "text"))
+    input.text = any->string_value();
+
+  for (auto [key, value] : {
+      std::pair{"x", &input.x}, {"y", &input.y},
+      {"button", &input.button}, {"buttons", &input.buttons},
+      {"scroll", &input.scroll}, {"key", &input.key},
+      {"width", &input.width}, {"height", &input.height}})
+  {
+    if (auto *any = param(_msg, key))
+      *value = any->int_value();
+  }
+
+  for (auto [key, value] : {
+      std::pair{"control", &input.control}, {"shift", &input.shift},
+      {"alt", &input.alt}})
+  {
+    if (auto *any = param(_msg, key))
+      *value = any->bool_value();
+  }
+  return input;
+}
+
+/////////////////////////////////////////////////
+msgs::Param RemoteInput::ToMsg() const
+{
+  msgs::Param msg;
+  setParam(msg, "type", this->type);
+
+  if (this->type == "resize")
+  {
+    setParam(msg, "width", this->width);
+    setParam(msg, "height", this->height);
+    return msg;
+  }
+
+  if (this->type == "key_press" || this->type == "key_release")
+  {
+    setParam(msg, "key", this->key);
+    setParam(msg, "text", this->text);
+  }
+  else
+  {
+    setParam(msg, "x", this->x);
+    setParam(msg, "y", this->y);
+    setParam(msg, "button", this->button);
+    setParam(msg, "buttons", this->buttons);
+    if (this->type == "scroll")
+      setParam(msg, "scroll", this->scroll);
+  }
+  setParam(msg, "control", this->control);
+  setParam(msg, "shift", this->shift);
+  setParam(msg, "alt", this->alt);
+  return msg;
+}
+
+/////////////////////////////////////////////////
+bool RemoteInput::Valid() const
+{
+  return this->type == "press" || this->type == "release" ||
+      this->type == "move" || this->type == "scroll" ||
+      this->type == "key_press" || this->type == "key_release" ||
+      this->type == "resize";
+}
+
+/////////////////////////////////////////////////
+int RemoteInput::QtButtons(int _buttons)
+{
+  int qtButtons{0};
+  if (_buttons & kLeft)
+    qtButtons |= kQtLeft;
+  if (_buttons & kMiddle)
+    qtButtons |= kQtMiddle;
+  if (_buttons & kRight)
+    qtButtons |= kQtRight;
+  return qtButtons;
+}
+
+/////////////////////////////////////////////////
+int RemoteInput::InputButtons(int _qtButtons)
+{
+  int buttons{0};
+  if (_qtButtons & kQtLeft)
+    buttons |= kLeft;
+  if (_qtButtons & kQtMiddle)
+    buttons |= kMiddle;
+  if (_qtButtons & kQtRight)
+    buttons |= kRight;
+  return buttons;
+}
+}  // namespace gz::gui::plugins
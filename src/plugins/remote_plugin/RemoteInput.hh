@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_REMOTEINPUT_HH_
+#define GZ_GUI_PLUGINS_REMOTEINPUT_HH_
+
+#include <string>
+
+#include <gz/msgs/param.pb.h>
+
+#ifndef _WIN32
+#  define RemoteInput_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(RemotePlugin_EXPORTS))
+#    define RemoteInput_EXPORTS_API __declspec(dllexport)
+#  else
+#    define RemoteInput_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief One input event sent to a plugin hosted in another process, as
+  /// the gz::msgs::Param messages MinimalScene's \<input_topic\> handles,
+  /// plus "resize" events with "width" and "height" params.
+  ///
+  /// Buttons are the protocol's: 1 for left, 2 for middle and 4 for right,
+  /// see QtButtons and InputButtons to convert them.
+  class RemoteInput_EXPORTS_API RemoteInput
+  {
+    /// \brief Event type: "press", "release", "move", "scroll",
+    /// "key_press", "key_release" or "resize"
+    public: std::string type;
+
+    /// \brief Mouse position, in pixels of the plugin
+    public: int x{0};
+
+    /// \brief Mouse position, in pixels of the plugin
+    public: int y{0};
+
+    /// \brief Button pressed or released
+    public: int button{0};
+
+    /// \brief Buttons held
+    public: int buttons{0};
+
+    /// \brief Scroll steps, negative away from the user
+    public: int scroll{0};
+
+    /// \brief Qt::Key of key events
+    public: int key{0};
+
+    /// \brief Text of key events
+    public: std::string text;
+
+    /// \brief Whether control is held
+    public: bool control{false};
+
+    /// \brief Whether shift is held
+    public: bool shift{false};
+
+    /// \brief Whether alt is held
+    public: bool alt{false};
+
+    /// \brief New width of resize events, in pixels
+    public: int width{0};
+
+    /// \brief New height of resize events, in pixels
+    public: int height{0};
+
+    /// \brief Read an event from a message. Missing params keep their
+    /// defaults.
+    /// \param[in] _msg Message
+    /// \return Event
+    public: static RemoteInput FromMsg(const msgs::Param &_msg);
+
+    /// \brief Write the event to a message. Only the params its type uses
+    /// are written.
+    /// \return Message
+    public: msgs::Param ToMsg() const;
+
+    /// \brief Whether the event's type is a known one
+    /// \return True if known
+    public: bool Valid() const;
+
+    /// \brief Convert the protocol's buttons to Qt::MouseButtons
+    /// \param[in] _buttons Protocol buttons
+    /// \return Qt buttons
+    public: static int QtButtons(int _buttons);
+
+    /// \brief Convert Qt::MouseButtons to the protocol's buttons. Other Qt
+    /// buttons are dropped.
+    /// \param[in] _qtButtons Qt buttons
+    /// \return Protocol buttons
+    public: static int InputButtons(int _qtButtons);
+  };
+}  // namespace gz::gui::plugins
+
+#endif
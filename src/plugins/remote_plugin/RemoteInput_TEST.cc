@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "RemoteInput.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(RemoteInputTest, Mouse)
+{
+  RemoteInput input;
+  input.type = "scroll";
+  input.x = 12;
+  input.y = 34;
+  input.buttons = 4;
+  input.scroll = -1;
+  input.shift = true;
+  EXPECT_TRUE(input.Valid());
+
+  const auto msg = input.ToMsg();
+  EXPECT_EQ("scroll", msg.params().at("type").string_value());
+  EXPECT_EQ(12, msg.params().at("x").int_value());
+  EXPECT_EQ(-1, msg.params().at("scroll").int_value());
+  EXPECT_EQ(0u, msg.params().count("key"));
+
+  const auto read = RemoteInput::FromMsg(msg);
+  EXPECT_EQ("scroll", read.type);
+  EXPECT_EQ(12, read.x);
+  EXPECT_EQ(34, read.y);
+  EXPECT_EQ(0, read.button);
+  EXPECT_EQ(4, read.buttons);
+  EXPECT_EQ(-1, read.scroll);
+  EXPECT_TRUE(read.shift);
+  EXPECT_FALSE(read.control);
+  EXPECT_FALSE(read.alt);
+}
+
+/////////////////////////////////////////////////
+TEST(RemoteInputTest, KeyAndResize)
+{
+  RemoteInput key;
+  key.type = "key_press";
+  key.key = 0x41;
+  key.text = "a";
+  key.control = true;
+  const auto readKey = RemoteInput::FromMsg(key.ToMsg());
+  EXPECT_EQ("key_press", readKey.type);
+  EXPECT_EQ(0x41, readKey.key);
+  EXPECT_EQ("a", readKey.text);
+  EXPECT_TRUE(readKey.control);
+
+  RemoteInput resize;
+  resize.type = "resize";
+  resize.width = 640;
+  resize.height = 480;
+  const auto msg = resize.ToMsg();
+  EXPECT_EQ(3, msg.params().size());
+  const auto readResize = RemoteInput::FromMsg(msg);
+  EXPECT_TRUE(readResize.Valid());
+  EXPECT_EQ(640, readResize.width);
+  EXPECT_EQ(480, readResize.height);
+
+  // Missing params keep their defaults
+  EXPECT_FALSE(RemoteInput::FromMsg(msgs::Param()).Valid());
+  RemoteInput unknown;
+  unknown.type = "drag";
+  EXPECT_FALSE(unknown.Valid());
+}
+
+/////////////////////////////////////////////////
+TEST(RemoteInputTest, Buttons)
+{
+  // Left, middle and right
+  EXPECT_EQ(0x01, RemoteInput::QtButtons(1));
+  EXPECT_EQ(0x04, RemoteInput::QtButtons(2));
+  EXPECT_EQ(0x02, RemoteInput::QtButtons(4));
+  EXPECT_EQ(0x07, RemoteInput::QtButtons(7));
+  EXPECT_EQ(0, RemoteInput::QtButtons(0));
+
+  for (int buttons = 0; buttons < 8; ++buttons)
+  {
+    EXPECT_EQ(buttons,
+        RemoteInput::InputButtons(RemoteInput::QtButtons(buttons)));
+  }
+
+  // Back and forward buttons aren't sent
+  EXPECT_EQ(1, RemoteInput::InputButtons(0x01 | 0x08 | 0x10));
+}
@@ -0,0 +1,769 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <string>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QProcess>
+#include <QQuickWindow>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+#include <QTimer>
+#include <QWheelEvent>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/param.pb.h>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+
+#include <gz/gui/Application.hh>
+#include <gz/gui/config.hh>
+#include <gz/gui/InstallationDirectories.hh>
+#include <gz/gui/MainWindow.hh>
+#include <gz/gui/NodePool.hh>
+#include <gz/gui/SharedMemory.hh>
+#include <gz/gui/SubscriptionHub.hh>
+
+#include "RemoteInput.hh"
+#include "RemotePlugin.hh"
+
+namespace gz::gui::plugins
+{
+class RemotePlugin::Implementation
+{
+  /// \brief Write the helper's config and start it
+  public: void Start();
+
+  /// \brief Stop the helper, if it's running
+  public: void Stop();
+
+  /// \brief Send an event to the helper
+  /// \param[in] _input Event
+  public: void Send(const RemoteInput &_input);
+
+  /// \brief Convert a position in the item showing the frames to one in
+  /// the hosted plugin
+  /// \param[in] _x Position in the item
+  /// \param[in] _y Position in the item
+  /// \param[out] _input Event to set the position of
+  public: void SetPosition(double _x, double _y, RemoteInput &_input) const;
+
+  /// \brief Callback for frames from the helper
+  /// \param[in] _msg Frame
+  public: void OnFrame(const msgs::Image &_msg);
+
+  /// \brief Find the plugin hosted in this process
+  /// \return Plugin, null if not loaded yet
+  public: Plugin *Hosted() const;
+
+  /// \brief Publish the hosted plugin's card if its window rendered since
+  /// the last frame, in host mode
+  public: void Capture();
+
+  /// \brief Inject an event into the hosted plugin's window, in host mode
+  /// \param[in] _input Event
+  public: void Inject(const RemoteInput &_input);
+
+  /// \brief The plugin
+  public: RemotePlugin *plugin{nullptr};
+
+  /// \brief Topic prefix of the frames and events
+  public: std::string topic;
+
+  /// \brief Most frames per second
+  public: double maxRate{30.0};
+
+  /// \brief Config of the hosted plugin, in the helper's config
+  public: std::string hostedConfig;
+
+  /// \brief Launcher, empty to look for it
+  public: std::string executable;
+
+  /// \brief QT_QPA_PLATFORM of the helper, empty for the environment's
+  public: std::string platform{"offscreen"};
+
+  /// \brief State of the helper
+  public: QString status;
+
+  /// \brief Helper process
+  public: QProcess process;
+
+  /// \brief Whether the helper is being stopped on purpose
+  public: bool stopping{false};
+
+  /// \brief Helper's config, removed with the plugin
+  public: std::unique_ptr<QTemporaryFile> configFile;
+
+  /// \brief Shows the frames, owned by the QML engine
+  public: RemoteFrameProvider *provider{nullptr};
+
+  /// \brief Frames from the helper
+  public: HubSubscription frameSubscription;
+
+  /// \brief Events to the helper
+  public: transport::Node::Publisher inputPub;
+
+  /// \brief Size of the item showing the frames
+  public: int itemWidth{0};
+
+  /// \brief Size of the item showing the frames
+  public: int itemHeight{0};
+
+  /// \brief Size of the last frame, set on the frame thread
+  public: std::atomic<int> frameWidth{0};
+
+  /// \brief Size of the last frame, set on the frame thread
+  public: std::atomic<int> frameHeight{0};
+
+  /// \brief Whether a frame was received since the helper started
+  public: std::atomic<bool> gotFrame{false};
+
+  /// \brief Sends the size again until a frame arrives, since the helper
+  /// doesn't receive events before it's subscribed
+  public: QTimer resizeTimer;
+
+  /// \brief True in host mode
+  public: bool hosting{false};
+
+  /// \brief Publishes the frames, in host mode
+  public: std::unique_ptr<SharedMemoryPublisher> framePub;
+
+  /// \brief Events from the main process, in host mode
+  public: HubSubscription inputSubscription;
+
+  /// \brief Whether the window rendered since the last frame, set on the
+  /// render thread
+  public: std::atomic<bool> dirty{true};
+
+  /// \brief Last frame published, to skip identical ones
+  public: QImage lastFrame;
+
+  /// \brief Checks for new frames at the frame rate, in host mode
+  public: QTimer frameTimer;
+
+  /// \brief Process whose end stops the helper, 0 for none
+  public: qint64 parentPid{0};
+
+  /// \brief Checks whether the parent is still running, in host mode
+  public: QTimer parentTimer;
+};
+
+/////////////////////////////////////////////////
+/// \brief Add a property to a card's config
+/// \param[in] _guiElem `<gz-gui>` element
+/// \param[in] _key Property name
+/// \param[in] _type Property type
+/// \param[in] _value Value
+static void addProperty(tinyxml2::XMLElement *_guiElem, const char *_key,
+    const char *_type, const char *_value)
+{
+  auto *elem = _guiElem->GetDocument()->NewElement("property");
+  elem->SetAttribute("key", _key);
+  elem->SetAttribute("type", _type);
+  elem->SetText(_value);
+  _guiElem->InsertEndChild(elem);
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the launcher
+/// \param[in] _executable Configured launcher, if any
+/// \return Path, empty if not found
+static QString findLauncher(const std::string &_executable)
+{
+  if (!_executable.empty())
+    return QString::fromStdString(_executable);
+
+  const QString name = QString("gz-gui%1").arg(GZ_GUI_MAJOR_VERSION);
+  auto path = QStandardPaths::findExecutable(name);
+  if (path.isEmpty())
+  {
+    path = QStandardPaths::findExecutable(name, {QString::fromStdString(
+        common::joinPaths(getInstallPrefix(), "bin"))});
+  }
+  return path;
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Implementation::Start()
+{
+  // The hosted plugin, followed by the host
+  tinyxml2::XMLDocument doc;
+  doc.Parse(this->hostedConfig.c_str());
+  auto *hostedElem = doc.FirstChildElement("plugin");
+  if (!hostedElem->FirstChildElement("gz-gui"))
+  {
+    auto *guiElem = doc.NewElement("gz-gui");
+    addProperty(guiElem, "showTitleBar", "bool", "false");
+    addProperty(guiElem, "state", "string", "docked");
+    hostedElem->InsertFirstChild(guiElem);
+  }
+
+  auto *hostElem = doc.NewElement("plugin");
+  hostElem->SetAttribute("filename", "RemotePlugin");
+  hostElem->SetAttribute("name", "Remote host");
+  auto *guiElem = doc.NewElement("gz-gui");
+  addProperty(guiElem, "resizable", "bool", "false");
+  addProperty(guiElem, "width", "double", "5");
+  addProperty(guiElem, "height", "double", "5");
+  addProperty(guiElem, "state", "string", "floating");
+  addProperty(guiElem, "showTitleBar", "bool", "false");
+  hostElem->InsertEndChild(guiElem);
+  auto *elem = doc.NewElement("host");
+  elem->SetText(this->topic.c_str());
+  hostElem->InsertEndChild(elem);
+  elem = doc.NewElement("parent_pid");
+  elem->SetText(static_cast<int64_t>(QCoreApplication::applicationPid()));
+  hostElem->InsertEndChild(elem);
+  elem = doc.NewElement("max_rate");
+  elem->SetText(this->maxRate);
+  hostElem->InsertEndChild(elem);
+  doc.InsertEndChild(hostElem);
+
+  tinyxml2::XMLPrinter printer;
+  doc.Print(&printer);
+
+  this->configFile = std::make_unique<QTemporaryFile>(
+      QDir::tempPath() + "/gz-gui-remote-XXXXXX.config");
+  if (!this->configFile->open() ||
+      this->configFile->write(printer.CStr()) < 0 ||
+      !this->configFile->flush())
+  {
+    gzerr << "Failed to write config of remote plugin to ["
+          << this->configFile->fileName().toStdString() << "]" << std::endl;
+    this->status = "failed";
+    emit this->plugin->StatusChanged();
+    return;
+  }
+
+  const auto launcher = findLauncher(this->executable);
+  if (launcher.isEmpty())
+  {
+    gzerr << "Failed to find gz-gui" << GZ_GUI_MAJOR_VERSION
+          << " to run remote plugin, set <executable>" << std::endl;
+    this->status = "failed";
+    emit this->plugin->StatusChanged();
+    return;
+  }
+
+  auto env = QProcessEnvironment::systemEnvironment();
+  if (!this->platform.empty())
+    env.insert("QT_QPA_PLATFORM", QString::fromStdString(this->platform));
+  this->process.setProcessEnvironment(env);
+  this->process.setProcessChannelMode(QProcess::ForwardedChannels);
+
+  this->gotFrame = false;
+  this->stopping = false;
+  this->status = "starting";
+  emit this->plugin->StatusChanged();
+
+  gzmsg << "Starting remote plugin [" << launcher.toStdString()
+        << "] on [" << this->topic << "]" << std::endl;
+  this->process.start(launcher,
+      {"--no-server", "-c", this->configFile->fileName()});
+  this->resizeTimer.start();
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Implementation::Stop()
+{
+  this->resizeTimer.stop();
+  if (this->process.state() == QProcess::NotRunning)
+    return;
+
+  this->stopping = true;
+  this->process.terminate();
+  if (!this->process.waitForFinished(2000))
+  {
+    this->process.kill();
+    this->process.waitForFinished(1000);
+  }
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Implementation::Send(const RemoteInput &_input)
+{
+  if (this->inputPub)
+    this->inputPub.Publish(_input.ToMsg());
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Implementation::SetPosition(double _x, double _y,
+    RemoteInput &_input) const
+{
+  // Frames are stretched over the item while they catch up with its size
+  double scaleX{1.0};
+  double scaleY{1.0};
+  if (this->itemWidth > 0 && this->itemHeight > 0 && this->frameWidth > 0 &&
+      this->frameHeight > 0)
+  {
+    scaleX = static_cast<double>(this->frameWidth) / this->itemWidth;
+    scaleY = static_cast<double>(this->frameHeight) / this->itemHeight;
+  }
+  _input.x = static_cast<int>(_x * scaleX);
+  _input.y = static_cast<int>(_y * scaleY);
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Implementation::OnFrame(const msgs::Image &_msg)
+{
+  if (_msg.pixel_format_type() != msgs::PixelFormatType::RGBA_INT8 ||
+      _msg.width() == 0 || _msg.height() == 0 ||
+      _msg.data().size() < static_cast<std::size_t>(_msg.step()) *
+      _msg.height())
+  {
+    return;
+  }
+
+  QImage image(reinterpret_cast<const uchar *>(_msg.data().data()),
+      _msg.width(), _msg.height(), _msg.step(), QImage::Format_RGBA8888);
+  this->provider->SetImage(image.copy());
+  this->frameWidth = _msg.width();
+  this->frameHeight = _msg.height();
+
+  const bool first = !this->gotFrame.exchange(true);
+  QMetaObject::invokeMethod(this->plugin, [this, first]()
+  {
+    if (first)
+    {
+      this->resizeTimer.stop();
+      this->status = "running";
+      emit this->plugin->StatusChanged();
+    }
+    emit this->plugin->NewFrame();
+  }, Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+Plugin *RemotePlugin::Implementation::Hosted() const
+{
+  auto *window = App()->findChild<MainWindow *>();
+  if (!window)
+    return nullptr;
+
+  for (auto *other : window->findChildren<Plugin *>())
+  {
+    if (other != this->plugin && other->CardItem())
+      return other;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Implementation::Capture()
+{
+  if (!this->dirty.exchange(false))
+    return;
+
+  auto *hosted = this->Hosted();
+  auto *window = App()->findChild<MainWindow *>()->QuickWindow();
+  if (!hosted || !window)
+  {
+    this->dirty = true;
+    return;
+  }
+
+  auto *card = hosted->CardItem();
+  const QRectF rect =
+      card->mapRectToScene(QRectF(0, 0, card->width(), card->height()));
+  const qreal ratio = window->effectiveDevicePixelRatio();
+  const QRect pixels =
+      QRectF(rect.topLeft() * ratio, rect.size() * ratio).toAlignedRect();
+
+  auto frame = window->grabWindow().copy(pixels).convertToFormat(
+      QImage::Format_RGBA8888);
+  if (frame.isNull() || frame == this->lastFrame)
+    return;
+  this->lastFrame = frame;
+
+  msgs::Image msg;
+  msg.set_width(frame.width());
+  msg.set_height(frame.height());
+  msg.set_step(frame.bytesPerLine());
+  msg.set_pixel_format_type(msgs::PixelFormatType::RGBA_INT8);
+  msg.set_data(reinterpret_cast<const char *>(frame.constBits()),
+      frame.sizeInBytes());
+  this->framePub->Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Implementation::Inject(const RemoteInput &_input)
+{
+  auto *hosted = this->Hosted();
+  auto *window = App()->findChild<MainWindow *>()->QuickWindow();
+  if (!hosted || !window)
+    return;
+  auto *card = hosted->CardItem();
+
+  if (_input.type == "resize")
+  {
+    // The window's other items keep their size
+    const int extraWidth = window->width() - static_cast<int>(card->width());
+    const int extraHeight =
+        window->height() - static_cast<int>(card->height());
+    window->resize(_input.width + extraWidth, _input.height + extraHeight);
+    this->dirty = true;
+    return;
+  }
+
+  Qt::KeyboardModifiers modifiers;
+  if (_input.control)
+    modifiers |= Qt::ControlModifier;
+  if (_input.shift)
+    modifiers |= Qt::ShiftModifier;
+  if (_input.alt)
+    modifiers |= Qt::AltModifier;
+
+  if (_input.type == "key_press" || _input.type == "key_release")
+  {
+    QKeyEvent event(_input.type == "key_press" ?
+        QEvent::KeyPress : QEvent::KeyRelease, _input.key, modifiers,
+        QString::fromStdString(_input.text));
+    QCoreApplication::sendEvent(window, &event);
+    return;
+  }
+
+  const QPointF pos = card->mapToScene(QPointF(_input.x, _input.y));
+  const QPointF globalPos = window->mapToGlobal(pos.toPoint());
+  const Qt::MouseButtons buttons(RemoteInput::QtButtons(_input.buttons));
+
+  if (_input.type == "scroll")
+  {
+    // Negative steps are away from the user
+    QWheelEvent event(pos, globalPos, QPoint(),
+        QPoint(0, _input.scroll < 0 ? 120 : -120), buttons, modifiers,
+        Qt::NoScrollPhase, false);
+    QCoreApplication::sendEvent(window, &event);
+    return;
+  }
+
+  QEvent::Type type{QEvent::MouseMove};
+  if (_input.type == "press")
+    type = QEvent::MouseButtonPress;
+  else if (_input.type == "release")
+    type = QEvent::MouseButtonRelease;
+
+  QMouseEvent event(type, pos, pos, globalPos,
+      static_cast<Qt::MouseButton>(RemoteInput::QtButtons(_input.button)),
+      buttons, modifiers);
+  QCoreApplication::sendEvent(window, &event);
+}
+
+/////////////////////////////////////////////////
+RemotePlugin::RemotePlugin()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->plugin = this;
+
+  this->dataPtr->resizeTimer.setInterval(500);
+  this->connect(&this->dataPtr->resizeTimer, &QTimer::timeout, this,
+      [this]()
+      {
+        this->OnResize(this->dataPtr->itemWidth, this->dataPtr->itemHeight);
+      });
+
+  this->connect(&this->dataPtr->process,
+      QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+      [this](int _code, QProcess::ExitStatus _exitStatus)
+      {
+        if (!this->dataPtr->stopping)
+        {
+          gzwarn << "Remote plugin on [" << this->dataPtr->topic << "] "
+                 << (_exitStatus == QProcess::CrashExit ?
+                     "crashed" : "exited with code " + std::to_string(_code))
+                 << std::endl;
+        }
+        this->dataPtr->resizeTimer.stop();
+        this->dataPtr->status = "exited";
+        emit this->StatusChanged();
+      });
+
+  this->connect(&this->dataPtr->process, &QProcess::errorOccurred, this,
+      [this](QProcess::ProcessError _error)
+      {
+        if (_error != QProcess::FailedToStart)
+          return;
+        gzerr << "Failed to start remote plugin: "
+              << this->dataPtr->process.errorString().toStdString()
+              << std::endl;
+        this->dataPtr->resizeTimer.stop();
+        this->dataPtr->status = "failed";
+        emit this->StatusChanged();
+      });
+}
+
+/////////////////////////////////////////////////
+RemotePlugin::~RemotePlugin()
+{
+  this->dataPtr->frameSubscription.Reset();
+  this->dataPtr->inputSubscription.Reset();
+  this->dataPtr->Stop();
+  if (this->dataPtr->provider)
+  {
+    App()->Engine()->removeImageProvider(
+        this->CardItem()->objectName() + "remoteplugin");
+  }
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Remote plugin";
+
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("host"))
+    {
+      if (elem->GetText())
+        this->dataPtr->topic = elem->GetText();
+      this->dataPtr->hosting = true;
+    }
+    if (auto elem = _pluginElem->FirstChildElement("topic"))
+    {
+      if (elem->GetText())
+        this->dataPtr->topic = elem->GetText();
+    }
+    if (auto elem = _pluginElem->FirstChildElement("max_rate"))
+    {
+      elem->QueryDoubleText(&this->dataPtr->maxRate);
+      if (this->dataPtr->maxRate <= 0)
+      {
+        gzerr << "Invalid <max_rate>, using 30" << std::endl;
+        this->dataPtr->maxRate = 30.0;
+      }
+    }
+    if (auto elem = _pluginElem->FirstChildElement("executable"))
+    {
+      if (elem->GetText())
+        this->dataPtr->executable = elem->GetText();
+    }
+    if (auto elem = _pluginElem->FirstChildElement("platform"))
+    {
+      this->dataPtr->platform = elem->GetText() ? elem->GetText() : "";
+    }
+    if (auto elem = _pluginElem->FirstChildElement("parent_pid"))
+    {
+      int64_t pid{0};
+      elem->QueryInt64Text(&pid);
+      this->dataPtr->parentPid = pid;
+    }
+    if (auto elem = _pluginElem->FirstChildElement("plugin"))
+    {
+      tinyxml2::XMLPrinter printer;
+      elem->Accept(&printer);
+      this->dataPtr->hostedConfig = printer.CStr();
+    }
+  }
+
+  if (this->dataPtr->hosting)
+  {
+    if (this->dataPtr->topic.empty())
+    {
+      gzerr << "Empty <host>, not hosting" << std::endl;
+      return;
+    }
+    this->CardItem()->setVisible(false);
+
+    this->dataPtr->framePub = std::make_unique<SharedMemoryPublisher>(
+        this->dataPtr->topic + "/frames", "gz.msgs.Image");
+
+    this->dataPtr->inputSubscription =
+        App()->Subscriptions()->Subscribe<msgs::Param>(
+        this->dataPtr->topic + "/input",
+        std::function<void(const msgs::Param &)>(
+        [this](const msgs::Param &_msg)
+        {
+          auto input = RemoteInput::FromMsg(_msg);
+          if (!input.Valid())
+          {
+            gzwarn << "Ignoring remote input of unknown type ["
+                   << input.type << "]" << std::endl;
+            return;
+          }
+          QMetaObject::invokeMethod(this, [this, input]()
+          {
+            this->dataPtr->Inject(input);
+          }, Qt::QueuedConnection);
+        }));
+
+    // Rendered on the render thread, grabbed on this one
+    auto *window = App()->findChild<MainWindow *>()->QuickWindow();
+    this->connect(window, &QQuickWindow::frameSwapped, this,
+        [this]()
+        {
+          this->dataPtr->dirty = true;
+        }, Qt::DirectConnection);
+    this->dataPtr->frameTimer.setInterval(
+        static_cast<int>(1000.0 / this->dataPtr->maxRate));
+    this->connect(&this->dataPtr->frameTimer, &QTimer::timeout, this,
+        [this]()
+        {
+          this->dataPtr->Capture();
+        });
+    this->dataPtr->frameTimer.start();
+
+#ifndef _WIN32
+    if (this->dataPtr->parentPid > 0)
+    {
+      this->connect(&this->dataPtr->parentTimer, &QTimer::timeout, this,
+          [this]()
+          {
+            if (kill(static_cast<pid_t>(this->dataPtr->parentPid), 0) != 0 &&
+                errno == ESRCH)
+            {
+              gzmsg << "Parent process is gone, quitting" << std::endl;
+              App()->quit();
+            }
+          });
+      this->dataPtr->parentTimer.start(1000);
+    }
+#endif
+    return;
+  }
+
+  if (this->dataPtr->hostedConfig.empty())
+  {
+    gzerr << "Missing <plugin> to run remotely" << std::endl;
+    this->dataPtr->status = "failed";
+    return;
+  }
+
+  if (this->dataPtr->topic.empty())
+  {
+    static std::atomic<int> count{0};
+    this->dataPtr->topic = "/gui/remote_plugin/" +
+        std::to_string(QCoreApplication::applicationPid()) + "_" +
+        std::to_string(count++);
+  }
+
+  this->dataPtr->provider = new RemoteFrameProvider();
+  App()->Engine()->addImageProvider(
+      this->CardItem()->objectName() + "remoteplugin",
+      this->dataPtr->provider);
+
+  App()->Subscriptions()->SetSharedMemory(this->dataPtr->topic + "/frames",
+      true);
+  this->dataPtr->frameSubscription =
+      App()->Subscriptions()->Subscribe<msgs::Image>(
+      this->dataPtr->topic + "/frames",
+      std::function<void(const msgs::Image &)>(
+      [this](const msgs::Image &_msg)
+      {
+        this->dataPtr->OnFrame(_msg);
+      }));
+
+  this->dataPtr->inputPub = App()->Nodes()->Advertise<msgs::Param>(this,
+      this->dataPtr->topic + "/input");
+
+  this->dataPtr->Start();
+}
+
+/////////////////////////////////////////////////
+QString RemotePlugin::Status() const
+{
+  return this->dataPtr->status;
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::Restart()
+{
+  if (this->dataPtr->hosting || this->dataPtr->hostedConfig.empty())
+    return;
+
+  this->dataPtr->Stop();
+  this->dataPtr->Start();
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::OnMouse(const QString &_type, double _x, double _y,
+    int _button, int _buttons, int _modifiers)
+{
+  RemoteInput input;
+  input.type = _type.toStdString();
+  this->dataPtr->SetPosition(_x, _y, input);
+  input.button = RemoteInput::InputButtons(_button);
+  input.buttons = RemoteInput::InputButtons(_buttons);
+  input.control = _modifiers & Qt::ControlModifier;
+  input.shift = _modifiers & Qt::ShiftModifier;
+  input.alt = _modifiers & Qt::AltModifier;
+  this->dataPtr->Send(input);
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::OnWheel(double _x, double _y, int _angleDelta,
+    int _buttons, int _modifiers)
+{
+  if (_angleDelta == 0)
+    return;
+
+  RemoteInput input;
+  input.type = "scroll";
+  this->dataPtr->SetPosition(_x, _y, input);
+  input.buttons = RemoteInput::InputButtons(_buttons);
+  input.scroll = _angleDelta > 0 ? -1 : 1;
+  input.control = _modifiers & Qt::ControlModifier;
+  input.shift = _modifiers & Qt::ShiftModifier;
+  input.alt = _modifiers & Qt::AltModifier;
+  this->dataPtr->Send(input);
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::OnKey(const QString &_type, int _key,
+    const QString &_text, int _modifiers)
+{
+  RemoteInput input;
+  input.type = _type.toStdString();
+  input.key = _key;
+  input.text = _text.toStdString();
+  input.control = _modifiers & Qt::ControlModifier;
+  input.shift = _modifiers & Qt::ShiftModifier;
+  input.alt = _modifiers & Qt::AltModifier;
+  this->dataPtr->Send(input);
+}
+
+/////////////////////////////////////////////////
+void RemotePlugin::OnResize(int _width, int _height)
+{
+  if (_width <= 0 || _height <= 0)
+    return;
+
+  this->dataPtr->itemWidth = _width;
+  this->dataPtr->itemHeight = _height;
+
+  RemoteInput input;
+  input.type = "resize";
+  input.width = _width;
+  input.height = _height;
+  this->dataPtr->Send(input);
+}
+}  // namespace gz::gui::plugins
+
+// Register this plugin
+GZ_ADD_PLUGIN(gz::gui::plugins::RemotePlugin,
+              gz::gui::Plugin)
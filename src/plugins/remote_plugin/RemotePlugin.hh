@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_REMOTEPLUGIN_HH_
+#define GZ_GUI_PLUGINS_REMOTEPLUGIN_HH_
+
+#include <mutex>
+
+#include <QImage>
+#include <QQuickImageProvider>
+
+#include "gz/gui/Plugin.hh"
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz::gui::plugins
+{
+  /// \brief Provides the last frame of a RemotePlugin. Frames are
+  /// requested as "<anything>".
+  class RemoteFrameProvider : public QQuickImageProvider
+  {
+    /// \brief Constructor
+    public: RemoteFrameProvider()
+       : QQuickImageProvider(QQuickImageProvider::Image)
+    {
+    }
+
+    // Documentation inherited
+    public: QImage requestImage(const QString &, QSize *,
+        const QSize &) override
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->image.isNull())
+        {
+          // Must return a copy
+          QImage copy(this->image);
+          return copy;
+        }
+      }
+
+      // Placeholder in case we have no frame yet
+      QImage i(320, 240, QImage::Format_RGB888);
+      i.fill(QColor(128, 128, 128, 100));
+      return i;
+    }
+
+    /// \brief Set the frame
+    /// \param[in] _image New frame
+    public: void SetImage(const QImage &_image)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->image = _image;
+    }
+
+    /// \brief Protects `image`, which is requested from QML's threads
+    private: std::mutex mutex;
+
+    /// \brief Last frame
+    private: QImage image;
+  };
+
+  /// \brief Run another plugin in a helper process, so its GUI and render
+  /// work don't stall the main window, and spread over other cores.
+  ///
+  /// The helper is the `gz-gui` launcher, started with a config holding the
+  /// hosted plugin and a RemotePlugin in host mode. By default it uses Qt's
+  /// offscreen platform, so it opens no window of its own. The host grabs
+  /// the hosted plugin's card each time its window renders, at most
+  /// \<max_rate\> times per second, and publishes it as a
+  /// `gz::msgs::Image` through a SharedMemoryPublisher, which other hosts
+  /// also receive through transport. Mouse, wheel and key events, and size
+  /// changes, are sent back as `gz::msgs::Param`, the way MinimalScene's
+  /// \<input_topic\> receives them, and injected into the helper's window.
+  /// The helper quits once the process which started it is gone.
+  ///
+  /// Parameters:
+  ///
+  /// * `<plugin>`: Config of the plugin to host, as it would be in a
+  ///   config file. A card without a title bar is used if it has no
+  ///   `<gz-gui>`.
+  /// * `<topic>`: Optional. Prefix of the topics the frames and events are
+  ///   sent on, as `<topic>/frames` and `<topic>/input`. Defaults to one
+  ///   unique to this instance.
+  /// * `<max_rate>`: Optional. Most frames per second. Defaults to 30.
+  /// * `<executable>`: Optional. Launcher to start. Defaults to
+  ///   `gz-gui<major version>`, looked for on the path and then where
+  ///   gz-gui was installed.
+  /// * `<platform>`: Optional. `QT_QPA_PLATFORM` of the helper. Defaults
+  ///   to "offscreen". Empty to use the one of the environment, for
+  ///   example with render engines which need a display.
+  ///
+  /// Helpers use these instead:
+  ///
+  /// * `<host>`: Topic prefix to publish the frames of the other plugin in
+  ///   the window on, and receive its events on. The card of the host
+  ///   itself is hidden.
+  /// * `<parent_pid>`: Optional. Quit once this process is gone.
+  class RemotePlugin : public gz::gui::Plugin
+  {
+    Q_OBJECT
+
+    /// \brief State of the helper: "starting", "running", "exited" or
+    /// "failed"
+    Q_PROPERTY(
+      QString status
+      READ Status
+      NOTIFY StatusChanged
+    )
+
+    /// \brief Constructor
+    public: RemotePlugin();
+
+    /// \brief Destructor, stops the helper
+    public: ~RemotePlugin() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    /// \brief Get the state of the helper
+    /// \return Status
+    public: Q_INVOKABLE QString Status() const;
+
+    /// \brief Notify that the status has changed
+    signals: void StatusChanged();
+
+    /// \brief Notify that a new frame can be requested from the provider
+    signals: void NewFrame();
+
+    /// \brief Stop the helper if it's running and start it again
+    public: Q_INVOKABLE void Restart();
+
+    /// \brief Send a mouse event to the helper
+    /// \param[in] _type "press", "release" or "move"
+    /// \param[in] _x Position in the item showing the frames
+    /// \param[in] _y Position in the item showing the frames
+    /// \param[in] _button Qt::MouseButton pressed or released
+    /// \param[in] _buttons Qt::MouseButtons held
+    /// \param[in] _modifiers Qt::KeyboardModifiers held
+    public: Q_INVOKABLE void OnMouse(const QString &_type, double _x,
+        double _y, int _button, int _buttons, int _modifiers);
+
+    /// \brief Send a wheel event to the helper
+    /// \param[in] _x Position in the item showing the frames
+    /// \param[in] _y Position in the item showing the frames
+    /// \param[in] _angleDelta Vertical angle delta of the wheel event
+    /// \param[in] _buttons Qt::MouseButtons held
+    /// \param[in] _modifiers Qt::KeyboardModifiers held
+    public: Q_INVOKABLE void OnWheel(double _x, double _y, int _angleDelta,
+        int _buttons, int _modifiers);
+
+    /// \brief Send a key event to the helper
+    /// \param[in] _type "key_press" or "key_release"
+    /// \param[in] _key Qt::Key
+    /// \param[in] _text Text of the key
+    /// \param[in] _modifiers Qt::KeyboardModifiers held
+    public: Q_INVOKABLE void OnKey(const QString &_type, int _key,
+        const QString &_text, int _modifiers);
+
+    /// \brief Resize the hosted plugin, called when the item showing the
+    /// frames is resized
+    /// \param[in] _width Width in pixels
+    /// \param[in] _height Height in pixels
+    public: Q_INVOKABLE void OnResize(int _width, int _height);
+
+    /// \internal
+    /// \brief Pointer to private data
+    GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+  };
+}  // namespace gz::gui::plugins
+
+#endif
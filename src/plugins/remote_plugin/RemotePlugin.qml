@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: remotePlugin
+  color: "transparent"
+  anchors.fill: parent
+  Layout.minimumWidth: 300
+  Layout.minimumHeight: 300
+
+  /**
+   * Unique name for this plugin instance
+   */
+  property string uniqueName: ""
+
+  onParentChanged: {
+    if (undefined === parent)
+      return;
+
+    uniqueName = parent.card().objectName + "remoteplugin";
+    frame.reload();
+  }
+
+  Connections {
+    target: RemotePlugin
+    function onNewFrame() { frame.reload(); }
+  }
+
+  Image {
+    id: frame
+    anchors.fill: parent
+    fillMode: Image.Stretch
+    // Frames are requested as they arrive, keep showing the last one
+    cache: false
+    function reload() {
+      // Force image request to C++
+      source = "image://" + uniqueName + "/" + Math.random().toString(36).substr(2, 5);
+    }
+
+    onWidthChanged: RemotePlugin.OnResize(width, height)
+    onHeightChanged: RemotePlugin.OnResize(width, height)
+  }
+
+  MouseArea {
+    id: mouseArea
+    anchors.fill: parent
+    hoverEnabled: true
+    acceptedButtons: Qt.LeftButton | Qt.MiddleButton | Qt.RightButton
+    onPressed: {
+      remotePlugin.forceActiveFocus();
+      RemotePlugin.OnMouse("press", mouse.x, mouse.y, mouse.button,
+          mouse.buttons, mouse.modifiers);
+    }
+    onReleased: RemotePlugin.OnMouse("release", mouse.x, mouse.y,
+        mouse.button, mouse.buttons, mouse.modifiers)
+    onPositionChanged: RemotePlugin.OnMouse("move", mouse.x, mouse.y, 0,
+        mouse.buttons, mouse.modifiers)
+    onWheel: RemotePlugin.OnWheel(wheel.x, wheel.y, wheel.angleDelta.y,
+        wheel.buttons, wheel.modifiers)
+  }
+
+  focus: true
+  Keys.onPressed: {
+    RemotePlugin.OnKey("key_press", event.key, event.text, event.modifiers);
+    event.accepted = true;
+  }
+  Keys.onReleased: {
+    RemotePlugin.OnKey("key_release", event.key, event.text, event.modifiers);
+    event.accepted = true;
+  }
+
+  // Shown until the helper sends frames
+  Rectangle {
+    anchors.fill: parent
+    color: "#80808080"
+    visible: RemotePlugin.status !== "running"
+
+    ColumnLayout {
+      anchors.centerIn: parent
+
+      Label {
+        Layout.alignment: Qt.AlignHCenter
+        text: RemotePlugin.status === "starting" ? "Starting..." :
+            RemotePlugin.status === "exited" ? "Plugin process exited" :
+            "Plugin process failed to start"
+      }
+
+      Button {
+        Layout.alignment: Qt.AlignHCenter
+        text: "Restart"
+        visible: RemotePlugin.status === "exited" ||
+            RemotePlugin.status === "failed"
+        onClicked: RemotePlugin.Restart()
+      }
+    }
+  }
+}
@@ -16,27 +16,379 @@
 */
 #include "Screenshot.hh"
 
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/world_stats.pb.h>
+
 #include <gz/utils/ImplPtr.hh>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QImage>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/common/Image.hh>
+#include <gz/common/VideoEncoder.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/rendering/Camera.hh>
+#include <gz/rendering/PixelFormat.hh>
 #include <gz/rendering/RenderEngine.hh>
-#include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
 #include <gz/transport/Node.hh>
 
 #include "gz/gui/Application.hh"
-#include "gz/gui/GuiEvents.hh"
+#include "gz/gui/FrameTaps.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneServices.hh"
 
 namespace gz::gui::plugins
 {
+/// \brief Frame of the camera, waiting to be saved
+class PendingScreenshot
+{
+  /// \brief Frame read back from the camera
+  public: TapFramePtr frame;
+
+  /// \brief Path to save the image to
+  public: std::string path;
+};
+
+/// \brief Number of frames which can wait to be encoded. Frames are
+/// dropped when the encoder falls further behind.
+constexpr std::size_t kRecordRingSize{4};
+
+/// \brief Settings of a video recording
+class RecordOptions
+{
+  /// \brief Video format, such as "mp4"
+  public: std::string format{"mp4"};
+
+  /// \brief Path of the video, empty to not write a file
+  public: std::string path;
+
+  /// \brief Frame rate
+  public: unsigned int fps{25};
+
+  /// \brief Bit rate, in bits per second
+  public: unsigned int bitRate{VIDEO_ENCODER_BITRATE_DEFAULT};
+
+  /// \brief Publisher of the recorded frames, if valid
+  public: transport::Node::Publisher publisher;
+
+  /// \brief True to publish frames as JPEG compressed gz::msgs::Bytes,
+  /// false to publish raw gz::msgs::Image
+  public: bool compress{false};
+
+  /// \brief JPEG quality of compressed frames, from 0 to 100
+  public: int quality{80};
+};
+
+/// \brief Frame waiting to be encoded
+class RecordFrame
+{
+  /// \brief Frame read back from the camera
+  public: TapFramePtr frame;
+
+  /// \brief Number of the frame since the recording started, including
+  /// frames which were dropped
+  public: std::uint64_t index{0};
+};
+
+/// \brief Takes frames of the user camera at a steady rate, which are
+/// encoded into a video and published from a background thread. The render
+/// thread never waits for the encoder: when too many frames are waiting,
+/// the frame is dropped.
+class VideoRecorder
+{
+  /// \brief Destructor, encodes the copied frames and saves the video
+  public: ~VideoRecorder()
+  {
+    this->Stop();
+    if (this->thread.joinable())
+      this->thread.join();
+  }
+
+  /// \brief Start recording, called on the render thread
+  /// \param[in] _camera Camera to record
+  /// \param[in] _options Recording settings
+  /// \return True if the camera's image format can be recorded
+  public: bool Start(const rendering::CameraPtr &_camera,
+      const RecordOptions &_options)
+  {
+    const auto format = _camera->ImageFormat();
+    if (format != rendering::PF_R8G8B8 && format != rendering::PF_R8G8B8A8)
+    {
+      gzerr << "Unable to record camera [" << _camera->Name()
+            << "] with image format [" << rendering::PixelUtil::Name(format)
+            << "]" << std::endl;
+      return false;
+    }
+
+    this->options = _options;
+    this->width = _camera->ImageWidth();
+    this->height = _camera->ImageHeight();
+    this->period = std::chrono::nanoseconds(
+        (1000000000 + _options.fps - 1) / _options.fps);
+
+    this->thread = std::thread(&VideoRecorder::Run, this);
+    return true;
+  }
+
+  /// \brief Check whether a frame is due, without taking it
+  /// \param[in] _time Current wall or sim time
+  /// \return True if AddFrame would keep a frame at this time
+  public: bool Wants(std::chrono::steady_clock::duration _time) const
+  {
+    if (!this->startTime.has_value() || _time < this->lastTime)
+      return true;
+    return static_cast<std::uint64_t>(
+        (_time - *this->startTime) / this->period) >= this->nextIndex;
+  }
+
+  /// \brief Keep a frame of the camera if one is due, called on the
+  /// render thread after the camera has rendered
+  /// \param[in] _time Current wall or sim time
+  /// \param[in] _frame Frame read back from the camera
+  public: void AddFrame(std::chrono::steady_clock::duration _time,
+      const TapFramePtr &_frame)
+  {
+    if (!this->startTime.has_value() || _time < this->lastTime)
+    {
+      // First frame, or time went back, such as after a sim reset
+      this->startTime = _time - this->period *
+          static_cast<std::chrono::steady_clock::rep>(this->nextIndex);
+    }
+    this->lastTime = _time;
+
+    const auto index = static_cast<std::uint64_t>(
+        (_time - *this->startTime) / this->period);
+    if (index < this->nextIndex)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      // Frames skipped because the scene rendered slower than the video
+      this->missed += index - this->nextIndex;
+      this->nextIndex = index + 1;
+      if (this->frames.size() >= kRecordRingSize)
+      {
+        ++this->dropped;
+        return;
+      }
+      this->frames.push_back({_frame, index});
+    }
+    this->condition.notify_one();
+  }
+
+  /// \brief Stop recording. The copied frames are still encoded and the
+  /// video is saved on the background thread, which calls finishedCb once
+  /// done.
+  public: void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stop = true;
+    }
+    this->condition.notify_one();
+  }
+
+  /// \brief Called on the background thread once the video is saved, with
+  /// its path, the number of encoded frames and the number of dropped ones
+  public: std::function<void(const std::string &, std::uint64_t,
+      std::uint64_t)> finishedCb;
+
+  /// \brief Encode and publish the copied frames until stopped
+  private: void Run()
+  {
+    common::VideoEncoder encoder;
+    bool toFile = !this->options.path.empty();
+    if (toFile && !encoder.Start(this->options.format, this->options.path,
+        this->width, this->height, this->options.fps, this->options.bitRate))
+    {
+      gzerr << "Failed to start encoding video [" << this->options.path
+            << "]" << std::endl;
+      toFile = false;
+    }
+
+    std::uint64_t encoded{0};
+    std::uint64_t rejected{0};
+    std::vector<unsigned char> rgb;
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+      this->condition.wait(lock, [this]
+      {
+        return this->stop || !this->frames.empty();
+      });
+      if (this->frames.empty())
+        break;
+
+      const auto frame = this->frames.front();
+      this->frames.pop_front();
+      lock.unlock();
+
+      const auto &image = *frame.frame;
+      const auto w = image.width;
+      const auto h = image.height;
+      const auto *data = image.data.data();
+      if (image.bytesPerPixel == 4u)
+      {
+        // The encoder and the published frames take RGB
+        rgb.resize(static_cast<std::size_t>(w) * h * 3);
+        for (std::size_t i = 0, j = 0; i < rgb.size(); i += 3, j += 4)
+        {
+          rgb[i] = data[j];
+          rgb[i + 1] = data[j + 1];
+          rgb[i + 2] = data[j + 2];
+        }
+        data = rgb.data();
+      }
+
+      if (toFile)
+      {
+        const std::chrono::steady_clock::time_point timestamp(this->period *
+            static_cast<std::chrono::steady_clock::rep>(frame.index));
+        if (encoder.AddFrame(data, w, h, timestamp))
+          ++encoded;
+        else
+          ++rejected;
+      }
+
+      if (this->options.publisher.Valid() && this->options.compress)
+      {
+        const QImage frameImage(data, static_cast<int>(w),
+            static_cast<int>(h), static_cast<qsizetype>(w) * 3,
+            QImage::Format_RGB888);
+        QByteArray bytes;
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::WriteOnly);
+        if (frameImage.save(&buffer, "JPG", this->options.quality))
+        {
+          msgs::Bytes msg;
+          msg.set_data(bytes.constData(), static_cast<std::size_t>(
+              bytes.size()));
+          this->options.publisher.Publish(msg);
+        }
+      }
+      else if (this->options.publisher.Valid())
+      {
+        msgs::Image msg;
+        msg.set_width(w);
+        msg.set_height(h);
+        msg.set_step(w * 3);
+        msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+        msg.set_data(data, static_cast<std::size_t>(w) * h * 3);
+        this->options.publisher.Publish(msg);
+      }
+
+      lock.lock();
+    }
+    const auto dropped = this->dropped + this->missed + rejected;
+    gzmsg << "Recorded [" << encoded << "] frames, dropped [" << this->dropped
+          << "] because the encoder fell behind, [" << this->missed
+          << "] because the scene rendered too slowly and [" << rejected
+          << "] rejected by the encoder" << std::endl;
+    lock.unlock();
+
+    if (toFile)
+      encoder.Stop();
+
+    if (this->finishedCb)
+      this->finishedCb(toFile ? this->options.path : "", encoded, dropped);
+  }
+
+  /// \brief Recording settings
+  private: RecordOptions options;
+
+  /// \brief Width of the video
+  private: unsigned int width{0};
+
+  /// \brief Height of the video
+  private: unsigned int height{0};
+
+  /// \brief Time between two frames
+  private: std::chrono::steady_clock::duration period{};
+
+  /// \brief Time of frame 0, set on the first frame
+  private: std::optional<std::chrono::steady_clock::duration> startTime;
+
+  /// \brief Time of the last frame rendered, to detect time going back
+  private: std::chrono::steady_clock::duration lastTime{};
+
+  /// \brief Number of the next frame to copy
+  private: std::uint64_t nextIndex{0};
+
+  /// \brief Protects the members below
+  private: std::mutex mutex;
+
+  /// \brief Wakes up the background thread
+  private: std::condition_variable condition;
+
+  /// \brief Frames waiting to be encoded, in order
+  private: std::deque<RecordFrame> frames;
+
+  /// \brief Frames dropped because too many were waiting
+  private: std::uint64_t dropped{0};
+
+  /// \brief Frames skipped because no frame was rendered in their period
+  private: std::uint64_t missed{0};
+
+  /// \brief True once the recording is stopped
+  private: bool stop{false};
+
+  /// \brief Encodes and publishes the frames
+  private: std::thread thread;
+};
+
 class Screenshot::Implementation
 {
+  /// \brief Encode and save the pending screenshots until stopped
+  public: void RunSaveWorker();
+
+  /// \brief Time recordings are paced with
+  /// \return Sim or wall time, unset until the sim time is received
+  public: std::optional<std::chrono::steady_clock::duration> Time() const;
+
+  /// \brief Whether the frame about to be tapped is needed for a
+  /// screenshot, the recording or the stream, on the render thread
+  /// \return True to read the frame back
+  public: bool WantsFrame() const;
+
+  /// \brief Called on the worker thread once a screenshot has been saved
+  public: std::function<void(const std::string &)> savedCb;
+
+  /// \brief Protects the pending screenshots and the stopping flag
+  public: std::mutex saveMutex;
+
+  /// \brief Wakes up the worker thread
+  public: std::condition_variable saveCv;
+
+  /// \brief Screenshots copied from the camera and waiting to be saved
+  public: std::deque<PendingScreenshot> pendingSaves;
+
+  /// \brief True when the worker thread must return once it has saved the
+  /// pending screenshots
+  public: bool stopping{false};
+
+  /// \brief Encodes and saves screenshots, off the render thread
+  public: std::thread saveThread;
+
   /// \brief Node for communication
   public: gz::transport::Node node;
 
@@ -54,6 +406,60 @@ class Screenshot::Implementation
 
   /// \brief Saved screenshot filepath
   public: QString savedScreenshotPath = "";
+
+  /// \brief Video recording service name
+  public: std::string recordVideoService;
+
+  /// \brief Default settings of video recordings
+  public: RecordOptions recordOptions;
+
+  /// \brief Whether to write recorded videos to a file
+  public: bool recordToFile{true};
+
+  /// \brief Protects the recording requests
+  public: std::mutex recordMutex;
+
+  /// \brief Settings of a requested recording, waiting for the render
+  /// thread to start it
+  public: std::optional<RecordOptions> recordStart;
+
+  /// \brief Whether stopping the recording has been requested
+  public: bool recordStop{false};
+
+  /// \brief Current recording, only used on the render thread
+  public: std::unique_ptr<VideoRecorder> recorder;
+
+  /// \brief Whether a video is being recorded, only used on the GUI thread
+  public: bool recording{false};
+
+  /// \brief Settings of the stream, its publisher is only valid if
+  /// streaming
+  public: RecordOptions streamOptions;
+
+  /// \brief Streams frames while subscribers are connected, only used on
+  /// the render thread
+  public: std::unique_ptr<VideoRecorder> streamer;
+
+  /// \brief Whether the streamer has subscribers, only used on the render
+  /// thread
+  public: bool streaming{false};
+
+  /// \brief Requests frames at the stream's rate while subscribers are
+  /// connected, so scenes rendering on demand keep streaming
+  public: QTimer *streamTimer{nullptr};
+
+  /// \brief Whether frames are paced with sim time
+  public: bool useSimTime{false};
+
+  /// \brief Latest sim time in nanoseconds, negative until received
+  public: std::atomic<std::int64_t> simTime{-1};
+
+  /// \brief Keeps the render callback registered. Last member so it's
+  /// destroyed first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
+
+  /// \brief Keeps the user camera's frames coming, see renderConnection
+  public: FrameTapConnectionPtr frameTap;
 };
 
 /////////////////////////////////////////////////
@@ -82,14 +488,192 @@ Screenshot::Screenshot()
 }
 
 /////////////////////////////////////////////////
-Screenshot::~Screenshot() = default;
+Screenshot::~Screenshot()
+{
+  // No more screenshots are taken, and the pending ones are still saved
+  this->dataPtr->frameTap.reset();
+  this->dataPtr->renderConnection.reset();
+  this->dataPtr->recorder.reset();
+  this->dataPtr->streamer.reset();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->saveMutex);
+    this->dataPtr->stopping = true;
+  }
+  this->dataPtr->saveCv.notify_one();
+  if (this->dataPtr->saveThread.joinable())
+    this->dataPtr->saveThread.join();
+}
 
 /////////////////////////////////////////////////
-void Screenshot::LoadConfig(const tinyxml2::XMLElement *)
+void Screenshot::Implementation::RunSaveWorker()
+{
+  std::unique_lock<std::mutex> lock(this->saveMutex);
+  while (true)
+  {
+    this->saveCv.wait(lock, [this]
+    {
+      return this->stopping || !this->pendingSaves.empty();
+    });
+    if (this->pendingSaves.empty())
+      return;
+
+    auto pending = std::move(this->pendingSaves.front());
+    this->pendingSaves.pop_front();
+    lock.unlock();
+
+    common::Image image;
+    image.SetFromData(pending.frame->data.data(), pending.frame->width,
+        pending.frame->height,
+        common::Image::ConvertPixelFormat(pending.frame->format));
+    image.SavePNG(pending.path);
+
+    gzdbg << "Saved image to [" << pending.path << "]" << std::endl;
+    this->savedCb(pending.path);
+
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+std::optional<std::chrono::steady_clock::duration>
+    Screenshot::Implementation::Time() const
+{
+  if (!this->useSimTime)
+    return std::chrono::steady_clock::now().time_since_epoch();
+
+  const auto time = this->simTime.load();
+  if (time < 0)
+    return std::nullopt;
+  return std::chrono::nanoseconds(time);
+}
+
+/////////////////////////////////////////////////
+bool Screenshot::Implementation::WantsFrame() const
+{
+  if (this->dirty)
+    return true;
+  if (!this->recorder && !this->streaming)
+    return false;
+
+  const auto time = this->Time();
+  if (!time.has_value())
+    return false;
+  return (this->recorder && this->recorder->Wants(*time)) ||
+         (this->streaming && this->streamer->Wants(*time));
+}
+
+/////////////////////////////////////////////////
+void Screenshot::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Screenshot";
 
+  std::string recordTopic;
+  std::string statsTopic;
+  std::string streamTopic;
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("record_fps"))
+    {
+      elem->QueryUnsignedText(&this->dataPtr->recordOptions.fps);
+      if (this->dataPtr->recordOptions.fps == 0)
+      {
+        gzerr << "Invalid <record_fps>, using 25" << std::endl;
+        this->dataPtr->recordOptions.fps = 25;
+      }
+    }
+    if (auto elem = _pluginElem->FirstChildElement("record_bitrate"))
+      elem->QueryUnsignedText(&this->dataPtr->recordOptions.bitRate);
+    if (auto elem = _pluginElem->FirstChildElement("record_format"))
+    {
+      if (elem->GetText())
+        this->dataPtr->recordOptions.format = elem->GetText();
+    }
+    if (auto elem = _pluginElem->FirstChildElement("record_file"))
+      elem->QueryBoolText(&this->dataPtr->recordToFile);
+    if (auto elem = _pluginElem->FirstChildElement("record_topic"))
+    {
+      if (elem->GetText())
+        recordTopic = elem->GetText();
+    }
+    if (auto elem = _pluginElem->FirstChildElement("stats_topic"))
+    {
+      if (elem->GetText())
+        statsTopic = elem->GetText();
+    }
+    if (auto elem = _pluginElem->FirstChildElement("stream_topic"))
+    {
+      if (elem->GetText())
+        streamTopic = elem->GetText();
+    }
+    if (auto elem = _pluginElem->FirstChildElement("stream_fps"))
+    {
+      elem->QueryUnsignedText(&this->dataPtr->streamOptions.fps);
+      if (this->dataPtr->streamOptions.fps == 0)
+      {
+        gzerr << "Invalid <stream_fps>, using 25" << std::endl;
+        this->dataPtr->streamOptions.fps = 25;
+      }
+    }
+    if (auto elem = _pluginElem->FirstChildElement("stream_quality"))
+    {
+      elem->QueryIntText(&this->dataPtr->streamOptions.quality);
+      this->dataPtr->streamOptions.quality =
+          std::clamp(this->dataPtr->streamOptions.quality, 0, 100);
+    }
+  }
+
+  if (!streamTopic.empty())
+  {
+    this->dataPtr->streamOptions.compress = true;
+    this->dataPtr->streamOptions.publisher =
+        this->dataPtr->node.Advertise<msgs::Bytes>(streamTopic);
+    gzmsg << "Streaming JPEG frames on [" << streamTopic << "]" << std::endl;
+
+    // Only wakes the scene up while someone is watching
+    this->dataPtr->streamTimer = new QTimer(this);
+    this->dataPtr->streamTimer->setInterval(
+        static_cast<int>(1000 / this->dataPtr->streamOptions.fps));
+    connect(this->dataPtr->streamTimer, &QTimer::timeout, this, [this]()
+    {
+      if (this->dataPtr->streamOptions.publisher.HasConnections())
+        RenderHooks::RequestRender();
+    });
+    this->dataPtr->streamTimer->start();
+  }
+
+  if (!recordTopic.empty())
+  {
+    this->dataPtr->recordOptions.publisher =
+        this->dataPtr->node.Advertise<msgs::Image>(recordTopic);
+    gzmsg << "Publishing recorded frames on [" << recordTopic << "]"
+          << std::endl;
+  }
+
+  if (!statsTopic.empty())
+  {
+    std::function<void(const msgs::WorldStatistics &)> statsCb =
+        [this](const msgs::WorldStatistics &_msg)
+        {
+          this->dataPtr->simTime = _msg.sim_time().sec() * 1000000000LL +
+              _msg.sim_time().nsec();
+        };
+    this->dataPtr->useSimTime =
+        this->dataPtr->node.Subscribe(statsTopic, statsCb);
+    if (!this->dataPtr->useSimTime)
+    {
+      gzerr << "Failed to subscribe to [" << statsTopic
+            << "], recordings use wall time" << std::endl;
+    }
+  }
+
+  // Video recording service
+  this->dataPtr->recordVideoService = "/gui/record_video";
+  this->dataPtr->node.Advertise(this->dataPtr->recordVideoService,
+      &Screenshot::RecordVideoService, this);
+  gzmsg << "Record video service on ["
+         << this->dataPtr->recordVideoService << "]" << std::endl;
+
   // Screenshot service
   this->dataPtr->screenshotService = "/gui/screenshot";
   this->dataPtr->node.Advertise(this->dataPtr->screenshotService,
@@ -97,19 +681,165 @@ void Screenshot::LoadConfig(const tinyxml2::XMLElement *)
   gzmsg << "Screenshot service on ["
          << this->dataPtr->screenshotService << "]" << std::endl;
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
+  // Reported on the GUI thread, once the worker thread has saved the image
+  this->dataPtr->savedCb = [this](const std::string &_path)
+  {
+    QMetaObject::invokeMethod(this, [this, _path]()
+    {
+      this->SetSavedScreenshotPath(QString::fromStdString(_path));
+
+      emit App()->findChild<MainWindow *>()->notifyWithDuration(
+        QString::fromStdString("Saved image to: <b>" + _path + "</b>"),
+        4000);
+    }, Qt::QueuedConnection);
+  };
+  this->dataPtr->saveThread = std::thread(&Implementation::RunSaveWorker,
+      this->dataPtr.get());
+
+  this->dataPtr->renderConnection = RenderHooks::OnRender(
+      [this]()
+      {
+        this->UpdateRecording();
+      }, 0, "Screenshot");
+
+  // Screenshots, recordings and the stream share a single readback of the
+  // frames they want, which is skipped when none of them wants one
+  FrameTapOptions tapOptions;
+  tapOptions.wanted = [this]()
+  {
+    return this->dataPtr->WantsFrame();
+  };
+  this->dataPtr->frameTap = FrameTaps::Subscribe(
+      [this](const TapFramePtr &_frame)
+      {
+        if (this->dataPtr->dirty)
+          this->SaveScreenshot(_frame);
+
+        const auto time = this->dataPtr->Time();
+        if (!time.has_value())
+          return;
+        if (this->dataPtr->streaming)
+          this->dataPtr->streamer->AddFrame(*time, _frame);
+        if (this->dataPtr->recorder)
+          this->dataPtr->recorder->AddFrame(*time, _frame);
+      }, tapOptions);
+}
+
+/////////////////////////////////////////////////
+bool Screenshot::RecordVideoService(const msgs::VideoRecord &_msg,
+  msgs::Boolean &_res)
+{
+  if (_msg.start())
+  {
+    auto options = this->dataPtr->recordOptions;
+    if (!_msg.format().empty())
+      options.format = _msg.format();
+    if (!this->dataPtr->recordToFile)
+      options.path.clear();
+    else if (!_msg.save_filename().empty())
+      options.path = _msg.save_filename();
+    else
+    {
+      options.path = common::joinPaths(this->dataPtr->directory,
+          common::systemTimeISO() + "." + options.format);
+    }
+
+    std::lock_guard<std::mutex> lock(this->dataPtr->recordMutex);
+    this->dataPtr->recordStart = options;
+    this->dataPtr->recordStop = false;
+  }
+  else if (_msg.stop())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->recordMutex);
+    this->dataPtr->recordStart.reset();
+    this->dataPtr->recordStop = true;
+  }
+  RenderHooks::RequestRender();
+  _res.set_data(true);
+  return true;
 }
 
 /////////////////////////////////////////////////
-bool Screenshot::eventFilter(QObject *_obj, QEvent *_event)
+void Screenshot::UpdateRecording()
 {
-  if (_event->type() == events::Render::kType && this->dataPtr->dirty)
+  std::optional<RecordOptions> start;
+  bool stop{false};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->recordMutex);
+    std::swap(start, this->dataPtr->recordStart);
+    std::swap(stop, this->dataPtr->recordStop);
+  }
+
+  if ((stop || start) && this->dataPtr->recorder)
+  {
+    this->dataPtr->recorder->Stop();
+    // Joins the encoding thread, which only has a few frames left
+    this->dataPtr->recorder.reset();
+  }
+
+  if (start)
   {
-    this->SaveScreenshot();
+    this->FindUserCamera();
+    if (nullptr == this->dataPtr->userCamera)
+      return;
+
+    auto recorder = std::make_unique<VideoRecorder>();
+    recorder->finishedCb = [this](const std::string &_path,
+        std::uint64_t _frames, std::uint64_t _dropped)
+    {
+      QMetaObject::invokeMethod(this, [this, _path, _frames, _dropped]()
+      {
+        this->dataPtr->recording = false;
+        emit this->RecordingChanged();
+
+        std::string text = "Recorded " + std::to_string(_frames) +
+            " frames, dropped " + std::to_string(_dropped);
+        if (!_path.empty())
+          text = "Saved video to: <b>" + _path + "</b><br>" + text;
+        emit App()->findChild<MainWindow *>()->notifyWithDuration(
+          QString::fromStdString(text), 4000);
+      }, Qt::QueuedConnection);
+    };
+    if (!recorder->Start(this->dataPtr->userCamera, *start))
+      return;
+
+    gzmsg << "Recording video to ["
+          << (start->path.empty() ? "topic only" : start->path) << "]"
+          << std::endl;
+
+    this->dataPtr->recorder = std::move(recorder);
+    QMetaObject::invokeMethod(this, [this]()
+    {
+      this->dataPtr->recording = true;
+      emit this->RecordingChanged();
+    }, Qt::QueuedConnection);
+  }
+
+  const bool streaming =
+      this->dataPtr->streamOptions.publisher.Valid() &&
+      this->dataPtr->streamOptions.publisher.HasConnections();
+  if (streaming && !this->dataPtr->streamer)
+  {
+    this->FindUserCamera();
+    if (nullptr == this->dataPtr->userCamera)
+      return;
+
+    auto streamer = std::make_unique<VideoRecorder>();
+    if (!streamer->Start(this->dataPtr->userCamera,
+        this->dataPtr->streamOptions))
+    {
+      // Don't try again every frame
+      this->dataPtr->streamOptions.publisher = {};
+      return;
+    }
+    this->dataPtr->streamer = std::move(streamer);
   }
 
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  this->dataPtr->streaming = streaming && this->dataPtr->streamer;
+
+  // Keep scenes which render on demand rendering while recording
+  if (this->dataPtr->recorder)
+    RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -119,42 +849,29 @@ bool Screenshot::ScreenshotService(const msgs::StringMsg &_msg,
   if (!_msg.data().empty())
     this->dataPtr->directory = _msg.data();
   this->dataPtr->dirty = true;
+  RenderHooks::RequestRender();
   _res.set_data(true);
   return true;
 }
 
 /////////////////////////////////////////////////
-void Screenshot::SaveScreenshot()
+void Screenshot::SaveScreenshot(const TapFramePtr &_frame)
 {
-  this->FindUserCamera();
-
-  if (nullptr == this->dataPtr->userCamera)
-    return;
-
-  unsigned int width = this->dataPtr->userCamera->ImageWidth();
-  unsigned int height = this->dataPtr->userCamera->ImageHeight();
-
-  auto cameraImage = this->dataPtr->userCamera->CreateImage();
-  this->dataPtr->userCamera->Copy(cameraImage);
-  auto formatStr =
-      rendering::PixelUtil::Name(this->dataPtr->userCamera->ImageFormat());
-  auto format = common::Image::ConvertPixelFormat(formatStr);
+  // Only the copy from the GPU happens on the render thread, encoding and
+  // writing the PNG happen on the worker thread
+  PendingScreenshot pending;
+  pending.frame = _frame;
 
   std::string time = common::systemTimeISO() + ".png";
-  std::string savePath = common::joinPaths(this->dataPtr->directory, time);
-
-  common::Image image;
-  image.SetFromData(cameraImage.Data<unsigned char>(), width, height, format);
-  image.SavePNG(savePath);
-
-  gzdbg << "Saved image to [" << savePath << "]" << std::endl;
+  pending.path = common::joinPaths(this->dataPtr->directory, time);
 
   this->dataPtr->dirty = false;
 
-  this->SetSavedScreenshotPath(QString::fromStdString(savePath));
-
-  emit App()->findChild<MainWindow *>()->notifyWithDuration(
-    QString::fromStdString("Saved image to: <b>" + savePath + "</b>"), 4000);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->saveMutex);
+    this->dataPtr->pendingSaves.push_back(std::move(pending));
+  }
+  this->dataPtr->saveCv.notify_one();
 }
 
 /////////////////////////////////////////////////
@@ -163,20 +880,12 @@ void Screenshot::FindUserCamera()
   if (nullptr != this->dataPtr->userCamera)
     return;
 
-  // Get first scene
-  auto scene = rendering::sceneFromFirstRenderEngine();
-
-  for (unsigned int i = 0; i < scene->NodeCount(); ++i)
+  this->dataPtr->userCamera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (nullptr != this->dataPtr->userCamera)
   {
-    auto cam = std::dynamic_pointer_cast<rendering::Camera>(
-        scene->NodeByIndex(i));
-    if (nullptr != cam)
-    {
-      this->dataPtr->userCamera = cam;
-      gzdbg << "Screenshot plugin taking pictures of camera ["
-             << this->dataPtr->userCamera->Name() << "]" << std::endl;
-      break;
-    }
+    gzdbg << "Screenshot plugin taking pictures of camera ["
+           << this->dataPtr->userCamera->Name() << "]" << std::endl;
   }
 }
 
@@ -184,6 +893,7 @@ void Screenshot::FindUserCamera()
 void Screenshot::OnScreenshot()
 {
   this->dataPtr->dirty = true;
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -206,6 +916,30 @@ QString Screenshot::SavedScreenshotPath() const
   return this->dataPtr->savedScreenshotPath;
 }
 
+/////////////////////////////////////////////////
+void Screenshot::StartRecording()
+{
+  msgs::VideoRecord req;
+  req.set_start(true);
+  msgs::Boolean res;
+  this->RecordVideoService(req, res);
+}
+
+/////////////////////////////////////////////////
+void Screenshot::StopRecording()
+{
+  msgs::VideoRecord req;
+  req.set_stop(true);
+  msgs::Boolean res;
+  this->RecordVideoService(req, res);
+}
+
+/////////////////////////////////////////////////
+bool Screenshot::Recording() const
+{
+  return this->dataPtr->recording;
+}
+
 /////////////////////////////////////////////////
 void Screenshot::SetSavedScreenshotPath(const QString &_filename)
 {
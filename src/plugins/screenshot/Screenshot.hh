@@ -20,10 +20,12 @@
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
+#include <gz/msgs/video_record.pb.h>
 
 #include <memory>
 
 #include "gz/gui/qt.h"
+#include "gz/gui/FrameTaps.hh"
 #include "gz/gui/Plugin.hh"
 
 #include <gz/utils/ImplPtr.hh>
@@ -36,6 +38,44 @@ namespace gz::gui::plugins
   /// /gui/screenshot service:
   ///     Data: Path to save to, leave empty to save to latest path.
   ///     Response: True if screenshot has been queued succesfully.
+  ///
+  /// The plugin can also record videos of the 3D scene. Frames of the user
+  /// camera are taken at a steady rate through FrameTaps, which reads each
+  /// frame back once for screenshots, recordings and the stream together.
+  /// Up to a few frames wait to be encoded on a background thread with
+  /// gz-common's VideoEncoder. When the encoder falls behind, frames are
+  /// dropped instead of stalling the render thread, and dropped frames are
+  /// reported once the recording stops.
+  /// Hardware encoders can be enabled through the environment variables
+  /// read by VideoEncoder, such as GZ_VIDEO_ALLOWED_ENCODERS=NVENC,VAAPI.
+  ///
+  /// /gui/record_video service:
+  ///     Data: `start` or `stop`, with an optional `format`, such as "mp4",
+  ///           and `save_filename`. Leave the file name empty to save into
+  ///           the screenshot directory.
+  ///     Response: True if the request was queued succesfully.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<record_fps\> : Frame rate of recorded videos, defaults to 25.
+  /// * \<record_bitrate\> : Bit rate of recorded videos in bits per second,
+  ///   defaults to VideoEncoder's default.
+  /// * \<record_format\> : Default video format, defaults to "mp4".
+  /// * \<record_file\> : Whether to write recorded videos to a file,
+  ///   defaults to true.
+  /// * \<record_topic\> : If set, recorded frames are also published as
+  ///   gz::msgs::Image on this topic, for remote viewing.
+  /// * \<stats_topic\> : If set, frames are paced using the sim time of
+  ///   the gz::msgs::WorldStatistics published on this topic, such as
+  ///   "/world/shapes/stats". Otherwise wall time is used.
+  /// * \<stream_topic\> : If set, frames are published as JPEG compressed
+  ///   gz::msgs::Bytes on this topic while it has subscribers, such as
+  ///   thin clients showing the scene with the ImageDisplay plugin. Scenes
+  ///   rendering on demand are woken up at the stream's rate meanwhile.
+  ///   Input can be sent back to MinimalScene's \<input_topic\>.
+  /// * \<stream_fps\> : Frame rate of the stream, defaults to 25.
+  /// * \<stream_quality\> : JPEG quality of the stream from 0 to 100,
+  ///   defaults to 80.
   class Screenshot : public Plugin
   {
     Q_OBJECT
@@ -56,6 +96,13 @@ namespace gz::gui::plugins
       NOTIFY SavedScreenshotPathChanged
     )
 
+    /// \brief Whether a video is being recorded
+    Q_PROPERTY(
+      bool recording
+      READ Recording
+      NOTIFY RecordingChanged
+    )
+
     /// \brief Constructor
     public: Screenshot();
 
@@ -68,11 +115,6 @@ namespace gz::gui::plugins
     /// \brief Callback when screenshot is requested from the GUI.
     public slots: void OnScreenshot();
 
-    /// \brief Callback for all installed event filders.
-    /// \param[in] _obj Object that received the event
-    /// \param[in] _event Event
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \brief Callback for saving a screenshot (from the user camera) request
     /// \param[in] _msg Request message of the directory path to save
     /// screenshots
@@ -81,12 +123,25 @@ namespace gz::gui::plugins
     private: bool ScreenshotService(const msgs::StringMsg &_msg,
         msgs::Boolean &_res);
 
+    /// \brief Callback for starting or stopping a video recording
+    /// \param[in] _msg Request message
+    /// \param[in] _res Response data
+    /// \return True if the request is received
+    private: bool RecordVideoService(const msgs::VideoRecord &_msg,
+        msgs::Boolean &_res);
+
+    /// \brief Start, stop and feed video recordings, on the render thread.
+    private: void UpdateRecording();
+
     /// \brief Encapsulates the logic to find the user camera through the
     /// render engine singleton.
     private: void FindUserCamera();
 
-    /// \brief Save a screenshot from the user camera
-    private: void SaveScreenshot();
+    /// \brief Queue a frame of the user camera to be saved as a screenshot
+    /// on a worker thread, called on the render thread. SavedScreenshotPath
+    /// is updated and a notification is shown once it's saved.
+    /// \param[in] _frame Frame read back from the camera
+    private: void SaveScreenshot(const TapFramePtr &_frame);
 
     /// \brief Get the directory path as a string, for example '/home/Pictures'
     /// \return Directory
@@ -116,6 +171,21 @@ namespace gz::gui::plugins
     /// \brief Notify that the screenshot has been saved (opens popup)
     signals: void savedScreenshot();
 
+    /// \brief Start recording a video into the screenshot directory, using
+    /// the configured format.
+    public: Q_INVOKABLE void StartRecording();
+
+    /// \brief Stop recording. The video is saved once the frames which have
+    /// already been copied are encoded.
+    public: Q_INVOKABLE void StopRecording();
+
+    /// \brief Get whether a video is being recorded
+    /// \return True from when a recording starts until its video is saved
+    public: Q_INVOKABLE bool Recording() const;
+
+    /// \brief Notify that recording started or stopped
+    signals: void RecordingChanged();
+
     /// \internal
     /// \brief Pointer to private data.
     private: GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
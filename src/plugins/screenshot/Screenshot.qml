@@ -51,6 +51,21 @@ ToolBar {
       }
     }
 
+    ToolButton {
+      id: record
+      ToolTip.text: Screenshot.recording ? "Stop recording" : "Record a video"
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      text: Screenshot.recording ? "\u25A0" : "\u25CF"
+      font.pixelSize: 24
+      onClicked: {
+        if (Screenshot.recording)
+          Screenshot.StopRecording()
+        else
+          Screenshot.StartRecording()
+      }
+    }
+
     ToolButton {
       id: directory
       ToolTip.text: "Change directory\nCurrent: " + Screenshot.directory
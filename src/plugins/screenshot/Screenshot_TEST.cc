@@ -17,6 +17,7 @@
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
+#include <gz/msgs/video_record.pb.h>
 
 #include <gtest/gtest.h>
 #include <string>
@@ -109,3 +110,42 @@ TEST(ScreenshotTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Screenshot))
   // Cleanup
   plugins.clear();
 }
+
+/////////////////////////////////////////////////
+TEST(ScreenshotTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RecordVideoService))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_TRUE(app.LoadPlugin("Screenshot"));
+
+  auto window = app.findChild<MainWindow *>();
+  ASSERT_NE(window, nullptr);
+
+  auto plugin = window->findChild<plugins::Screenshot *>();
+  ASSERT_NE(plugin, nullptr);
+  EXPECT_FALSE(plugin->Recording());
+
+  // Requests are accepted without a scene, recording only starts once the
+  // user camera renders
+  transport::Node node;
+  msgs::VideoRecord req;
+  req.set_start(true);
+  req.set_format("mp4");
+  msgs::Boolean res;
+  bool result{false};
+  EXPECT_TRUE(node.Request("/gui/record_video", req, 2000, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  req.Clear();
+  req.set_stop(true);
+  EXPECT_TRUE(node.Request("/gui/record_video", req, 2000, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data());
+
+  QCoreApplication::processEvents();
+  EXPECT_FALSE(plugin->Recording());
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "MeshBvh.hh"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace gz::gui::plugins
+{
+namespace
+{
+/// \brief Most triangles in a leaf
+constexpr std::size_t kLeafSize{4};
+
+/////////////////////////////////////////////////
+/// \brief Closest point to a point on a segment
+/// \param[in] _point Point
+/// \param[in] _a Start of the segment
+/// \param[in] _b End of the segment
+/// \return Closest point
+math::Vector3d closestOnSegment(const math::Vector3d &_point,
+    const math::Vector3d &_a, const math::Vector3d &_b)
+{
+  const auto ab = _b - _a;
+  const double length2 = ab.SquaredLength();
+  if (length2 <= 0.0)
+    return _a;
+  const double t = std::clamp((_point - _a).Dot(ab) / length2, 0.0, 1.0);
+  return _a + ab * t;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+MeshBvh::MeshBvh(std::vector<math::Vector3d> _vertices,
+    const std::vector<unsigned int> &_indices)
+  : vertices(std::move(_vertices))
+{
+  this->triangles.reserve(_indices.size() / 3);
+  for (std::size_t i = 0; i + 2 < _indices.size(); i += 3)
+  {
+    if (_indices[i] >= this->vertices.size() ||
+        _indices[i + 1] >= this->vertices.size() ||
+        _indices[i + 2] >= this->vertices.size())
+    {
+      continue;
+    }
+    this->triangles.push_back({_indices[i], _indices[i + 1],
+        _indices[i + 2]});
+  }
+
+  if (this->triangles.empty())
+    return;
+
+  this->nodes.reserve(2 * (this->TriangleCount() / kLeafSize + 1));
+  this->nodes.emplace_back();
+  this->Build(0, 0, this->TriangleCount());
+}
+
+/////////////////////////////////////////////////
+void MeshBvh::Build(std::size_t _node, std::size_t _first,
+    std::size_t _count)
+{
+  math::Vector3d min(std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+  math::Vector3d max(-min);
+  for (std::size_t t = _first; t < _first + _count; ++t)
+  {
+    for (auto index : this->triangles[t])
+    {
+      min.Min(this->vertices[index]);
+      max.Max(this->vertices[index]);
+    }
+  }
+  this->nodes[_node].min = min;
+  this->nodes[_node].max = max;
+
+  if (_count <= kLeafSize)
+  {
+    this->nodes[_node].first = _first;
+    this->nodes[_node].count = _count;
+    return;
+  }
+
+  // Split at the median centroid along the longest axis
+  const auto size = max - min;
+  const int axis = size.X() >= size.Y() && size.X() >= size.Z() ? 0 :
+      size.Y() >= size.Z() ? 1 : 2;
+
+  using Triangle = std::array<unsigned int, 3>;
+  auto centroid = [this, axis](const Triangle &_t)
+  {
+    return this->vertices[_t[0]][axis] + this->vertices[_t[1]][axis] +
+        this->vertices[_t[2]][axis];
+  };
+  const auto begin = this->triangles.begin() + _first;
+  const std::size_t half = _count / 2;
+  std::nth_element(begin, begin + half, begin + _count,
+      [&centroid](const Triangle &_a, const Triangle &_b)
+      {
+        return centroid(_a) < centroid(_b);
+      });
+
+  const std::size_t left = this->nodes.size();
+  this->nodes.emplace_back();
+  this->nodes.emplace_back();
+  this->nodes[_node].first = left;
+  this->nodes[_node].count = 0;
+  this->Build(left, _first, half);
+  this->Build(left + 1, _first + half, _count - half);
+}
+
+/////////////////////////////////////////////////
+std::optional<math::Vector3d> MeshBvh::Snap(const math::Vector3d &_point,
+    double _radius) const
+{
+  if (this->nodes.empty() || _radius <= 0.0)
+    return std::nullopt;
+
+  const double radius2 = _radius * _radius;
+  std::optional<math::Vector3d> vertex;
+  double vertexDist2{radius2};
+  std::optional<math::Vector3d> edge;
+  double edgeDist2{radius2};
+
+  std::vector<std::size_t> stack{0};
+  while (!stack.empty())
+  {
+    const auto &node = this->nodes[stack.back()];
+    stack.pop_back();
+
+    // Skip boxes further than the radius
+    double boxDist2{0.0};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double d = std::max({node.min[axis] - _point[axis], 0.0,
+          _point[axis] - node.max[axis]});
+      boxDist2 += d * d;
+    }
+    if (boxDist2 > radius2)
+      continue;
+
+    if (node.count == 0)
+    {
+      stack.push_back(node.first);
+      stack.push_back(node.first + 1);
+      continue;
+    }
+
+    for (std::size_t t = node.first; t < node.first + node.count; ++t)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        const auto &a = this->vertices[this->triangles[t][i]];
+        const auto &b = this->vertices[this->triangles[t][(i + 1) % 3]];
+
+        const double dist2 = (a - _point).SquaredLength();
+        if (dist2 <= vertexDist2)
+        {
+          vertexDist2 = dist2;
+          vertex = a;
+        }
+
+        const auto closest = closestOnSegment(_point, a, b);
+        const double closestDist2 = (closest - _point).SquaredLength();
+        if (closestDist2 <= edgeDist2)
+        {
+          edgeDist2 = closestDist2;
+          edge = closest;
+        }
+      }
+    }
+  }
+
+  return vertex ? vertex : edge;
+}
+
+/////////////////////////////////////////////////
+std::size_t MeshBvh::TriangleCount() const
+{
+  return this->triangles.size();
+}
+}  // namespace gz::gui::plugins
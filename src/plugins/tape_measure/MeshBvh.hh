@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MESHBVH_HH_
+#define GZ_GUI_PLUGINS_MESHBVH_HH_
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#ifndef _WIN32
+#  define MeshBvh_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TapeMeasure_EXPORTS))
+#    define MeshBvh_EXPORTS_API __declspec(dllexport)
+#  else
+#    define MeshBvh_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Bounding volume hierarchy over the triangles of a mesh, to find
+  /// the vertices and edges near a point without going through all of them.
+  /// It's immutable once built, so it can be built on a worker thread and
+  /// then queried from any thread.
+  class MeshBvh_EXPORTS_API MeshBvh
+  {
+    /// \brief Build the hierarchy
+    /// \param[in] _vertices Vertices of the mesh
+    /// \param[in] _indices Three vertex indices per triangle. Indices out of
+    /// range and incomplete triangles are ignored.
+    public: MeshBvh(std::vector<math::Vector3d> _vertices,
+        const std::vector<unsigned int> &_indices);
+
+    /// \brief Snap a point to the mesh
+    /// \param[in] _point Point, in the mesh's frame
+    /// \param[in] _radius Furthest distance to snap from
+    /// \return The closest vertex within the radius, otherwise the closest
+    /// point on an edge within the radius, otherwise nothing
+    public: std::optional<math::Vector3d> Snap(const math::Vector3d &_point,
+        double _radius) const;
+
+    /// \brief Number of triangles
+    /// \return Triangle count
+    public: std::size_t TriangleCount() const;
+
+    /// \brief Node of the hierarchy
+    private: struct Node
+    {
+      /// \brief Minimum corner of the box around its triangles
+      math::Vector3d min;
+
+      /// \brief Maximum corner of the box around its triangles
+      math::Vector3d max;
+
+      /// \brief Index of its first triangle in `triangles` for leaves, of
+      /// its first child in `nodes` otherwise, followed by the second
+      std::size_t first{0};
+
+      /// \brief Number of triangles, zero if it isn't a leaf
+      std::size_t count{0};
+    };
+
+    /// \brief Build the node for a range of `triangles`
+    /// \param[in] _node Index of the node in `nodes`
+    /// \param[in] _first First triangle
+    /// \param[in] _count Number of triangles
+    private: void Build(std::size_t _node, std::size_t _first,
+        std::size_t _count);
+
+    /// \brief Vertices
+    private: std::vector<math::Vector3d> vertices;
+
+    /// \brief Vertex indices of each triangle, sorted so that the
+    /// triangles of each leaf are contiguous
+    private: std::vector<std::array<unsigned int, 3>> triangles;
+
+    /// \brief Nodes, the root first
+    private: std::vector<Node> nodes;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_MESHBVH_HH_
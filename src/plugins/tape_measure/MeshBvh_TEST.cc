@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "MeshBvh.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Flat grid of square cells on the XY plane, two triangles each
+/// \param[in] _cells Cells along each axis
+/// \param[in] _size Cell size
+/// \param[out] _vertices Vertices
+/// \param[out] _indices Indices
+static void grid(unsigned int _cells, double _size,
+    std::vector<math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  const unsigned int n = _cells + 1;
+  for (unsigned int y = 0; y < n; ++y)
+  {
+    for (unsigned int x = 0; x < n; ++x)
+      _vertices.emplace_back(x * _size, y * _size, 0.0);
+  }
+  for (unsigned int y = 0; y < _cells; ++y)
+  {
+    for (unsigned int x = 0; x < _cells; ++x)
+    {
+      const unsigned int a = y * n + x;
+      _indices.insert(_indices.end(), {a, a + 1, a + n + 1, a, a + n + 1,
+          a + n});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBvhTest, Snap)
+{
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  grid(100, 0.1, vertices, indices);
+
+  MeshBvh bvh(vertices, indices);
+  EXPECT_EQ(20000u, bvh.TriangleCount());
+
+  // Vertices come first
+  auto snapped = bvh.Snap({0.52, 0.31, 0.01}, 0.03);
+  ASSERT_TRUE(snapped.has_value());
+  EXPECT_EQ(math::Vector3d(0.5, 0.3, 0.0), *snapped);
+
+  // Then edges
+  snapped = bvh.Snap({0.55, 0.31, 0.0}, 0.03);
+  ASSERT_TRUE(snapped.has_value());
+  EXPECT_EQ(math::Vector3d(0.55, 0.3, 0.0), *snapped);
+
+  // Nothing within the radius
+  EXPECT_FALSE(bvh.Snap({0.55, 0.35, 0.5}, 0.03).has_value());
+  EXPECT_FALSE(bvh.Snap({20.0, 0.0, 0.0}, 1.0).has_value());
+  EXPECT_FALSE(bvh.Snap({0.5, 0.3, 0.0}, 0.0).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshBvhTest, Invalid)
+{
+  // Out of range indices and incomplete triangles are skipped
+  MeshBvh bvh({{0, 0, 0}, {1, 0, 0}, {0, 1, 0}}, {0, 1, 2, 0, 1, 3, 0, 1});
+  EXPECT_EQ(1u, bvh.TriangleCount());
+  EXPECT_TRUE(bvh.Snap({1.0, 0.1, 0.0}, 0.2).has_value());
+
+  MeshBvh empty({}, {});
+  EXPECT_EQ(0u, empty.TriangleCount());
+  EXPECT_FALSE(empty.Snap({0.0, 0.0, 0.0}, 1.0).has_value());
+}
@@ -15,34 +15,98 @@
  *
 */
 
-#include <gz/msgs/marker.pb.h>
-
 #include <gz/utils/ImplPtr.hh>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
 #include <iostream>
-#include <unordered_set>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
 #include <gz/gui/Application.hh>
+#include <gz/gui/EventBus.hh>
 #include <gz/gui/GuiEvents.hh>
 #include <gz/gui/MainWindow.hh>
-#include <gz/msgs/Utility.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/SceneServices.hh>
 #include <gz/plugin/Register.hh>
-#include <gz/transport/Node.hh>
-#include <gz/transport/Publisher.hh>
-
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Mesh.hh>
+#include <gz/rendering/MeshDescriptor.hh>
+#include <gz/rendering/RayQuery.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+
+#include "MeshBvh.hh"
 #include "TapeMeasure.hh"
 
 namespace gz::gui::plugins
 {
+/// \brief Point or line drawn by the plugin
+struct Shape
+{
+  /// \brief True for a line, false for a point
+  bool line{false};
+
+  /// \brief Position of a point, or start of a line
+  math::Vector3d start;
+
+  /// \brief End of a line
+  math::Vector3d end;
+
+  /// \brief Color
+  math::Color color;
+};
+
+/// \brief Rendering objects drawing a shape
+struct DrawnShape
+{
+  /// \brief Visual holding the geometry
+  rendering::VisualPtr visual;
+
+  /// \brief Line geometry, null for points
+  rendering::MarkerPtr marker;
+
+  /// \brief Material, for the color
+  rendering::MaterialPtr material;
+};
+
+/// \brief Hierarchy being built, or built
+using BvhFuture = std::shared_future<std::shared_ptr<const MeshBvh>>;
+
 class TapeMeasure::Implementation
 {
-  /// \brief Gazebo communication node.
-  public: transport::Node node;
+  /// \brief Snap a point to the vertices or edges of the mesh under it.
+  /// Called in the render thread.
+  /// \param[in] _point Point picked in the scene
+  /// \return Snapped point, or the same point if there's nothing to snap to
+  public: math::Vector3d Snap(const math::Vector3d &_point);
+
+  /// \brief Get the hierarchy of a mesh, starting to build it on a worker
+  /// thread the first time. Called in the render thread.
+  /// \param[in] _descriptor Descriptor the mesh was created with
+  /// \return The hierarchy, or null until it's built
+  public: std::shared_ptr<const MeshBvh> Bvh(
+      const rendering::MeshDescriptor &_descriptor);
+
+  /// \brief Update the visuals to the shapes. Called in the render thread.
+  public: void DrawShapes();
 
   /// \brief True if currently measuring, else false.
-  public: bool measure = false;
+  public: std::atomic<bool> measure{false};
 
   /// \brief The id of the start point marker.
   public: const int kStartPointId = 1;
@@ -77,18 +141,240 @@ class TapeMeasure::Implementation
   public: gz::math::Color
           drawColor{gz::math::Color(0.2f, 0.2f, 0.2f, 1.0f)};
 
-  /// \brief A set of the currently placed markers.  Used to make sure a
-  /// non-existent marker is not deleted.
-  public: std::unordered_set<int> placedMarkers;
+  /// \brief Shapes to draw, by marker id. Set from both the GUI and the
+  /// render threads, drawn on the render thread.
+  public: std::map<int, Shape> shapes;
+
+  /// \brief True if `shapes` changed since they were drawn
+  public: bool shapesDirty{false};
+
+  /// \brief Protects `shapes` and `shapesDirty`
+  public: std::mutex mutex;
+
+  /// \brief Rendering objects of the shapes, by marker id. Only used in the
+  /// render thread.
+  public: std::map<int, DrawnShape> drawnShapes;
+
+  /// \brief Pixels around the cursor to snap to vertices and edges in, zero
+  /// to disable snapping
+  public: double snapRadius{10.0};
+
+  /// \brief Hierarchies of the meshes and sub-meshes snapped to so far,
+  /// kept for the lifetime of the plugin. Only used in the render thread.
+  public: std::map<std::pair<const common::Mesh *, std::string>, BvhFuture>
+      bvhs;
 
   /// \brief The current distance between the two points.  This distance
   /// is updated as the user hovers the end point as well.
   public: double distance = 0.0;
 
-  /// \brief The namespace that the markers for this plugin are placed in.
-  public: std::string ns = "tape_measure";
+  /// \brief Keeps the shapes drawn before each frame. Destroyed before the
+  /// rest, after the event connections.
+  public: RenderHookConnectionPtr renderConnection;
+
+  /// \brief Keep the scene events subscribed. Last, so they're
+  /// unsubscribed before the rest is destroyed.
+  public: std::vector<EventBusConnectionPtr> eventConnections;
 };
 
+/////////////////////////////////////////////////
+/// \brief Build the hierarchy of the triangles of a mesh
+/// \param[in] _mesh Mesh, owned by the mesh manager
+/// \param[in] _subMeshName Only use this sub-mesh, unless empty
+/// \return The hierarchy
+static std::shared_ptr<const MeshBvh> buildBvh(const common::Mesh *_mesh,
+    const std::string &_subMeshName)
+{
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < _mesh->SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh->SubMeshByIndex(i).lock();
+    if (nullptr == subMesh ||
+        subMesh->SubMeshPrimitiveType() != common::SubMesh::TRIANGLES ||
+        (!_subMeshName.empty() && subMesh->Name() != _subMeshName))
+    {
+      continue;
+    }
+
+    const auto offset = static_cast<unsigned int>(vertices.size());
+    for (unsigned int v = 0; v < subMesh->VertexCount(); ++v)
+      vertices.push_back(subMesh->Vertex(v));
+    for (unsigned int k = 0; k < subMesh->IndexCount(); ++k)
+      indices.push_back(offset + static_cast<unsigned int>(subMesh->Index(k)));
+  }
+  return std::make_shared<const MeshBvh>(std::move(vertices), indices);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const MeshBvh> TapeMeasure::Implementation::Bvh(
+    const rendering::MeshDescriptor &_descriptor)
+{
+  const common::Mesh *mesh = _descriptor.mesh;
+  if (nullptr == mesh && !_descriptor.meshName.empty())
+  {
+    mesh = common::MeshManager::Instance()->MeshByName(
+        _descriptor.meshName);
+  }
+
+  // Centered sub-meshes are moved away from the mesh's vertices
+  if (nullptr == mesh || _descriptor.centerSubMesh)
+    return nullptr;
+
+  auto key = std::make_pair(mesh, _descriptor.subMeshName);
+  auto it = this->bvhs.find(key);
+  if (it == this->bvhs.end())
+  {
+    // Dense meshes take a while, so hovering doesn't wait for them. Meshes
+    // are never released by the mesh manager, so the worker can read them.
+    it = this->bvhs.emplace(key, std::async(std::launch::async, &buildBvh,
+        mesh, _descriptor.subMeshName).share()).first;
+  }
+
+  if (it->second.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready)
+  {
+    return nullptr;
+  }
+  return it->second.get();
+}
+
+/////////////////////////////////////////////////
+math::Vector3d TapeMeasure::Implementation::Snap(
+    const math::Vector3d &_point)
+{
+  if (this->snapRadius <= 0.0)
+    return _point;
+
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  auto rayQuery = SceneServices::Get<rendering::RayQuery>(
+      SceneServices::kUserCameraRayQuery);
+  if (nullptr == camera || nullptr == rayQuery ||
+      camera->ImageWidth() == 0 || camera->ImageHeight() == 0)
+  {
+    return _point;
+  }
+
+  // Find the visual under the point, along the ray it was picked with
+  const auto screen = camera->Project(_point);
+  rayQuery->SetFromCamera(camera, math::Vector2d(
+      2.0 * screen.X() / camera->ImageWidth() - 1.0,
+      1.0 - 2.0 * screen.Y() / camera->ImageHeight()));
+  const auto result = rayQuery->ClosestPoint();
+  if (!result)
+    return _point;
+
+  auto visual = camera->Scene()->VisualById(result.objectId);
+  if (nullptr == visual)
+    return _point;
+
+  const auto pose = visual->WorldPose();
+  const auto scale = visual->WorldScale();
+  if (scale.Min() <= 0.0)
+    return _point;
+
+  // Size of the snap radius at the point's distance
+  const double radius = this->snapRadius * 2.0 *
+      camera->WorldPosition().Distance(_point) *
+      std::tan(camera->HFOV().Radian() * 0.5) / camera->ImageWidth();
+
+  const auto local = pose.Rot().RotateVectorReverse(_point - pose.Pos()) /
+      scale;
+  std::optional<math::Vector3d> snapped;
+  double snappedDist{std::numeric_limits<double>::max()};
+  for (unsigned int i = 0; i < visual->GeometryCount(); ++i)
+  {
+    auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(
+        visual->GeometryByIndex(i));
+    if (nullptr == mesh)
+      continue;
+
+    auto bvh = this->Bvh(mesh->Descriptor());
+    if (nullptr == bvh)
+      continue;
+
+    auto point = bvh->Snap(local, radius / scale.Min());
+    if (!point)
+      continue;
+
+    const auto world = pose.Pos() + pose.Rot().RotateVector(*point * scale);
+    const double dist = world.Distance(_point);
+    if (dist < snappedDist)
+    {
+      snappedDist = dist;
+      snapped = world;
+    }
+  }
+  return snapped.value_or(_point);
+}
+
+/////////////////////////////////////////////////
+void TapeMeasure::Implementation::DrawShapes()
+{
+  auto camera = SceneServices::Get<rendering::Camera>(
+      SceneServices::kUserCamera);
+  if (nullptr == camera)
+    return;
+
+  std::map<int, Shape> currentShapes;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->shapesDirty)
+      return;
+    currentShapes = this->shapes;
+    this->shapesDirty = false;
+  }
+
+  for (auto &[id, drawn] : this->drawnShapes)
+  {
+    if (currentShapes.find(id) == currentShapes.end())
+      drawn.visual->SetVisible(false);
+  }
+
+  auto scene = camera->Scene();
+  for (const auto &[id, shape] : currentShapes)
+  {
+    auto &drawn = this->drawnShapes[id];
+    if (nullptr == drawn.visual)
+    {
+      drawn.visual = scene->CreateVisual();
+      drawn.visual->SetVisibilityFlags(
+          GZ_VISIBILITY_GUI & ~GZ_VISIBILITY_SELECTABLE);
+      drawn.material = scene->CreateMaterial();
+      drawn.material->SetCastShadows(false);
+      if (shape.line)
+      {
+        drawn.marker = scene->CreateMarker();
+        drawn.marker->SetType(rendering::MarkerType::MT_LINE_LIST);
+        drawn.visual->AddGeometry(drawn.marker);
+      }
+      else
+      {
+        drawn.visual->AddGeometry(scene->CreateSphere());
+        drawn.visual->SetLocalScale(0.1, 0.1, 0.1);
+      }
+      drawn.visual->SetMaterial(drawn.material, false);
+      scene->RootVisual()->AddChild(drawn.visual);
+    }
+
+    drawn.material->SetAmbient(shape.color);
+    drawn.material->SetDiffuse(shape.color);
+    drawn.material->SetTransparency(1.0 - shape.color.A());
+    if (drawn.marker)
+    {
+      drawn.marker->ClearPoints();
+      drawn.marker->AddPoint(shape.start, shape.color);
+      drawn.marker->AddPoint(shape.end, shape.color);
+    }
+    else
+    {
+      drawn.visual->SetWorldPosition(shape.start);
+    }
+    drawn.visual->SetVisible(true);
+  }
+}
+
 /////////////////////////////////////////////////
 TapeMeasure::TapeMeasure()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -99,13 +385,44 @@ TapeMeasure::TapeMeasure()
 TapeMeasure::~TapeMeasure() = default;
 
 /////////////////////////////////////////////////
-void TapeMeasure::LoadConfig(const tinyxml2::XMLElement *)
+void TapeMeasure::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Tape measure";
 
-  gz::gui::App()->findChild<gz::gui::MainWindow *>
-      ()->installEventFilter(this);
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("snap_radius"))
+      elem->QueryDoubleText(&this->dataPtr->snapRadius);
+  }
+
+  this->dataPtr->renderConnection = RenderHooks::OnPreRender(
+      [this]()
+      {
+        this->dataPtr->DrawShapes();
+      }, 0, "TapeMeasure");
+
+  // Mouse events come from the 3D scene through the event bus, which only
+  // calls this for the events it needs. Key events come from the window.
+  this->dataPtr->eventConnections.push_back(
+      EventBus::Subscribe<events::HoverToScene>(
+      [this](const events::HoverToScene &_event)
+      {
+        this->OnHover(_event.Point());
+      }));
+  this->dataPtr->eventConnections.push_back(
+      EventBus::Subscribe<events::LeftClickToScene>(
+      [this](const events::LeftClickToScene &_event)
+      {
+        this->OnLeftClick(_event.Point());
+      }));
+  this->dataPtr->eventConnections.push_back(
+      EventBus::Subscribe<events::RightClickToScene>(
+      [this](const events::RightClickToScene &)
+      {
+        this->OnRightClick();
+      }));
+
   gz::gui::App()->findChild<gz::gui::MainWindow *>
       ()->QuickWindow()->installEventFilter(this);
 }
@@ -169,131 +486,117 @@ double TapeMeasure::Distance()
 /////////////////////////////////////////////////
 void TapeMeasure::DeleteMarker(int _id)
 {
-  if (this->dataPtr->placedMarkers.find(_id) ==
-      this->dataPtr->placedMarkers.end())
-    return;
-
-  // Delete the previously created marker
-  gz::msgs::Marker markerMsg;
-  markerMsg.set_ns(this->dataPtr->ns);
-  markerMsg.set_id(_id);
-  markerMsg.set_action(gz::msgs::Marker::DELETE_MARKER);
-  this->dataPtr->node.Request("/marker", markerMsg);
-  this->dataPtr->placedMarkers.erase(_id);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->shapes.erase(_id) == 0)
+      return;
+    this->dataPtr->shapesDirty = true;
+  }
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
 void TapeMeasure::DrawPoint(int _id,
     gz::math::Vector3d &_point, gz::math::Color &_color)
 {
-  this->DeleteMarker(_id);
-
-  gz::msgs::Marker markerMsg;
-  markerMsg.set_ns(this->dataPtr->ns);
-  markerMsg.set_id(_id);
-  markerMsg.set_action(gz::msgs::Marker::ADD_MODIFY);
-  markerMsg.set_type(gz::msgs::Marker::SPHERE);
-  gz::msgs::Set(markerMsg.mutable_material()->mutable_ambient(), _color);
-  gz::msgs::Set(markerMsg.mutable_material()->mutable_diffuse(), _color);
-  gz::msgs::Set(markerMsg.mutable_scale(),
-    gz::math::Vector3d(0.1, 0.1, 0.1));
-  gz::msgs::Set(markerMsg.mutable_pose(),
-    gz::math::Pose3d(_point.X(), _point.Y(), _point.Z(), 0, 0, 0));
-
-  this->dataPtr->node.Request("/marker", markerMsg);
-  this->dataPtr->placedMarkers.insert(_id);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->shapes[_id] = Shape{false, _point, _point, _color};
+    this->dataPtr->shapesDirty = true;
+  }
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
 void TapeMeasure::DrawLine(int _id, gz::math::Vector3d &_startPoint,
     gz::math::Vector3d &_endPoint, gz::math::Color &_color)
 {
-  this->DeleteMarker(_id);
-
-  gz::msgs::Marker markerMsg;
-  markerMsg.set_ns(this->dataPtr->ns);
-  markerMsg.set_id(_id);
-  markerMsg.set_action(gz::msgs::Marker::ADD_MODIFY);
-  markerMsg.set_type(gz::msgs::Marker::LINE_LIST);
-  gz::msgs::Set(markerMsg.mutable_material()->mutable_ambient(), _color);
-  gz::msgs::Set(markerMsg.mutable_material()->mutable_diffuse(), _color);
-  gz::msgs::Set(markerMsg.add_point(), _startPoint);
-  gz::msgs::Set(markerMsg.add_point(), _endPoint);
-
-  this->dataPtr->node.Request("/marker", markerMsg);
-  this->dataPtr->placedMarkers.insert(_id);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->shapes[_id] = Shape{true, _startPoint, _endPoint, _color};
+    this->dataPtr->shapesDirty = true;
+  }
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
-bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
+void TapeMeasure::OnHover(const gz::math::Vector3d &_point)
 {
-  if (_event->type() == gz::gui::events::HoverToScene::kType)
+  // This event is called in the RenderThread, so it's safe to make
+  // rendering calls here
+  if (!this->dataPtr->measure)
+    return;
+
+  gz::math::Vector3d point = this->dataPtr->Snap(_point);
+  this->DrawPoint(this->dataPtr->currentId, point,
+    this->dataPtr->hoverColor);
+
+  // If the user is currently choosing the end point, draw the connecting
+  // line and update the new distance.
+  if (this->dataPtr->currentId == this->dataPtr->kEndPointId)
   {
-    auto hoverToSceneEvent =
-        reinterpret_cast<gz::gui::events::HoverToScene *>(_event);
+    this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
+      point, this->dataPtr->hoverColor);
+    this->dataPtr->distance = this->dataPtr->startPoint.Distance(point);
+    emit this->newDistance();
+  }
+}
 
-    // This event is called in the RenderThread, so it's safe to make
-    // rendering calls here
-    if (this->dataPtr->measure && hoverToSceneEvent)
-    {
-      gz::math::Vector3d point = hoverToSceneEvent->Point();
-      this->DrawPoint(this->dataPtr->currentId, point,
-        this->dataPtr->hoverColor);
+/////////////////////////////////////////////////
+void TapeMeasure::OnLeftClick(const gz::math::Vector3d &_point)
+{
+  // This event is called in the RenderThread, so it's safe to make
+  // rendering calls here
+  if (!this->dataPtr->measure)
+    return;
 
-      // If the user is currently choosing the end point, draw the connecting
-      // line and update the new distance.
-      if (this->dataPtr->currentId == this->dataPtr->kEndPointId)
-      {
-        this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
-          point, this->dataPtr->hoverColor);
-        this->dataPtr->distance = this->dataPtr->startPoint.Distance(point);
-        emit this->newDistance();
-      }
-    }
+  gz::math::Vector3d point = this->dataPtr->Snap(_point);
+  this->DrawPoint(this->dataPtr->currentId, point,
+    this->dataPtr->drawColor);
+  // If the user is placing the start point, update its position
+  if (this->dataPtr->currentId == this->dataPtr->kStartPointId)
+  {
+    this->dataPtr->startPoint = point;
   }
-  else if (_event->type() == gz::gui::events::LeftClickToScene::kType)
+  // If the user is placing the end point, update the end position,
+  // end the measurement state, and update the draw line and distance
+  else
   {
-    auto leftClickToSceneEvent =
-        reinterpret_cast<gz::gui::events::LeftClickToScene *>(_event);
+    this->dataPtr->endPoint = point;
+    this->dataPtr->measure = false;
+    this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
+      this->dataPtr->endPoint, this->dataPtr->drawColor);
+    this->dataPtr->distance =
+      this->dataPtr->startPoint.Distance(this->dataPtr->endPoint);
+    emit this->newDistance();
+    QGuiApplication::restoreOverrideCursor();
+
+    // Notify 3D scene that we are done using the right click, so it can
+    // re-enable the settings menu
+    gz::gui::events::DropdownMenuEnabled
+      dropdownMenuEnabledEvent(true);
+
+    gz::gui::App()->sendEvent(
+        gz::gui::App()->findChild<gz::gui::MainWindow *>(),
+        &dropdownMenuEnabledEvent);
+  }
+  this->dataPtr->currentId = this->dataPtr->kEndPointId;
+}
 
-    // This event is called in the RenderThread, so it's safe to make
-    // rendering calls here
-    if (this->dataPtr->measure && leftClickToSceneEvent)
-    {
-      gz::math::Vector3d point = leftClickToSceneEvent->Point();
-      this->DrawPoint(this->dataPtr->currentId, point,
-        this->dataPtr->drawColor);
-      // If the user is placing the start point, update its position
-      if (this->dataPtr->currentId == this->dataPtr->kStartPointId)
-      {
-        this->dataPtr->startPoint = point;
-      }
-      // If the user is placing the end point, update the end position,
-      // end the measurement state, and update the draw line and distance
-      else
-      {
-        this->dataPtr->endPoint = point;
-        this->dataPtr->measure = false;
-        this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
-          this->dataPtr->endPoint, this->dataPtr->drawColor);
-        this->dataPtr->distance =
-          this->dataPtr->startPoint.Distance(this->dataPtr->endPoint);
-        emit this->newDistance();
-        QGuiApplication::restoreOverrideCursor();
-
-        // Notify 3D scene that we are done using the right click, so it can
-        // re-enable the settings menu
-        gz::gui::events::DropdownMenuEnabled
-          dropdownMenuEnabledEvent(true);
-
-        gz::gui::App()->sendEvent(
-            gz::gui::App()->findChild<gz::gui::MainWindow *>(),
-            &dropdownMenuEnabledEvent);
-      }
-      this->dataPtr->currentId = this->dataPtr->kEndPointId;
-    }
+/////////////////////////////////////////////////
+void TapeMeasure::OnRightClick()
+{
+  // Cancel the current action
+  if (this->dataPtr->measure)
+  {
+    this->Reset();
   }
-  else if (_event->type() == QEvent::KeyPress)
+}
+
+/////////////////////////////////////////////////
+bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
+{
+  if (_event->type() == QEvent::KeyPress)
   {
     QKeyEvent *keyEvent = static_cast<QKeyEvent*>(_event);
     if (keyEvent && keyEvent->key() == Qt::Key_M)
@@ -311,14 +614,6 @@ bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
       this->Reset();
     }
   }
-  // Cancel the current action if a right click is detected
-  else if (_event->type() == gz::gui::events::RightClickToScene::kType)
-  {
-    if (this->dataPtr->measure)
-    {
-      this->Reset();
-    }
-  }
 
   return QObject::eventFilter(_obj, _event);
 }
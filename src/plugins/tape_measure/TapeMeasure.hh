@@ -28,6 +28,16 @@
 namespace gz::gui::plugins
 {
   /// \brief Provides buttons for the tape measure tool.
+  ///
+  /// Picked points snap to the nearest vertex of the mesh under the cursor,
+  /// or else the nearest point on one of its edges, within a few pixels.
+  /// The triangles of each mesh are sorted into a bounding volume hierarchy
+  /// on a worker thread the first time it's hovered, and kept for reuse.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<snap_radius\> : Pixels around the cursor to snap in, defaults to
+  ///                      10. Zero disables snapping.
   class TapeMeasure : public gz::gui::Plugin
   {
     Q_OBJECT
@@ -41,8 +51,7 @@ namespace gz::gui::plugins
     // Documentation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
 
-    /// \brief Deletes the marker with the provided id within the
-    /// "tape_measure" namespace.
+    /// \brief Deletes the marker with the provided id.
     /// \param[in] _id The id of the marker
     public: void DeleteMarker(int _id);
 
@@ -90,6 +99,20 @@ namespace gz::gui::plugins
     // Documentation inherited
     protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
 
+    /// \brief Callback in the render thread when the mouse hovers the
+    /// scene.
+    /// \param[in] _point Hovered point in the scene
+    private: void OnHover(const gz::math::Vector3d &_point);
+
+    /// \brief Callback in the render thread when the scene is left
+    /// clicked.
+    /// \param[in] _point Clicked point in the scene
+    private: void OnLeftClick(const gz::math::Vector3d &_point);
+
+    /// \brief Callback in the render thread when the scene is right
+    /// clicked.
+    private: void OnRightClick();
+
     /// \brief Signal fired when a new tape measure distance is set.
     signals: void newDistance();
 
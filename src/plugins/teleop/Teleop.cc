@@ -16,8 +16,14 @@
 */
 
 #include <gz/utils/ImplPtr.hh>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include <gz/msgs/twist.pb.h>
 
@@ -47,6 +53,43 @@ enum class KeyYaw{
   kRight,
   kStop,
 };
+
+/// \brief Twist command, shared with the publisher thread
+struct Command
+{
+  /// \brief Forward velocity
+  double forward{0.0};
+
+  /// \brief Vertical velocity
+  double vertical{0.0};
+
+  /// \brief Yaw velocity
+  double yaw{0.0};
+};
+
+/////////////////////////////////////////////////
+/// \brief Publish a twist command
+/// \param[in] _pub Publisher
+/// \param[in] _command Command to publish
+/// \param[in] _topic Topic, for the error message
+void publish(const gz::transport::Node::Publisher &_pub,
+    const Command &_command, const std::string &_topic)
+{
+  if (!_pub)
+    return;
+
+  gz::msgs::Twist cmdVelMsg;
+
+  cmdVelMsg.mutable_linear()->set_x(_command.forward);
+  cmdVelMsg.mutable_linear()->set_z(_command.vertical);
+  cmdVelMsg.mutable_angular()->set_z(_command.yaw);
+
+  if (!_pub.Publish(cmdVelMsg))
+  {
+    gzerr << "gz::msgs::Twist message couldn't be published at topic: "
+      << _topic << std::endl;
+  }
+}
 }  // namespace
 
 namespace gz::gui::plugins
@@ -100,8 +143,113 @@ class Teleop::Implementation
   /// \brief Indicates if the keyboard is enabled or
   /// disabled.
   public: bool keyEnable = false;
+
+  /// \brief Publish the latest command at a fixed rate until stopped. Runs
+  /// on the publisher thread.
+  /// \param[in] _teleop Plugin to report the jitter to
+  public: void PublishLoop(Teleop *_teleop);
+
+  /// \brief Protects `command`, `stop`, and `cmdVelPub` and `topic` while
+  /// the publisher thread runs
+  public: std::mutex mutex;
+
+  /// \brief Latest command
+  public: Command command;
+
+  /// \brief Commands per second sent by the publisher thread, zero to
+  /// publish each command from the GUI thread as it's given
+  public: double publishRate{0.0};
+
+  /// \brief Seconds the GUI thread may go without a heartbeat before the
+  /// publisher thread sends zero velocities, zero to disable
+  public: double deadmanTimeout{0.0};
+
+  /// \brief Last heartbeat of the GUI thread, in steady clock ticks
+  public: std::atomic<std::chrono::steady_clock::rep> heartbeat{0};
+
+  /// \brief Beats the heartbeat on the GUI thread
+  public: QTimer heartbeatTimer;
+
+  /// \brief Largest delay of a publish past its deadline during the last
+  /// second, in milliseconds
+  public: double publishJitter{0.0};
+
+  /// \brief Wakes the publisher thread to stop it
+  public: std::condition_variable stopCv;
+
+  /// \brief True to stop the publisher thread
+  public: bool stop{false};
+
+  /// \brief Publishes commands at `publishRate`
+  public: std::thread publishThread;
 };
 
+/////////////////////////////////////////////////
+void Teleop::Implementation::PublishLoop(Teleop *_teleop)
+{
+  using Clock = std::chrono::steady_clock;
+  const auto period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / this->publishRate));
+  const auto deadman = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(this->deadmanTimeout));
+
+  // Deadlines are absolute so that time spent publishing doesn't drift the
+  // rate
+  auto next = Clock::now();
+  auto reportTime = next + std::chrono::seconds(1);
+  Clock::duration maxLate{0};
+  bool deadmanTripped{false};
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stopCv.wait_until(lock, next, [this]{return this->stop;}))
+  {
+    const auto now = Clock::now();
+    maxLate = std::max(maxLate, now - next);
+
+    // Only the latest command is sent, however many were given since the
+    // last tick
+    auto command = this->command;
+    auto pub = this->cmdVelPub;
+    auto topic = this->topic;
+    lock.unlock();
+
+    const bool expired = deadman > Clock::duration::zero() &&
+        now - Clock::time_point(Clock::duration(this->heartbeat.load())) >
+        deadman;
+    if (expired != deadmanTripped)
+    {
+      if (expired)
+      {
+        gzwarn << "GUI unresponsive for more than [" << this->deadmanTimeout
+               << "] s, publishing zero velocities on [" << topic << "]"
+               << std::endl;
+      }
+      deadmanTripped = expired;
+    }
+    publish(pub, expired ? Command() : command, topic);
+
+    if (now >= reportTime)
+    {
+      const double jitter =
+          std::chrono::duration<double, std::milli>(maxLate).count();
+      QMetaObject::invokeMethod(_teleop, [_teleop, jitter]()
+          {
+            _teleop->dataPtr->publishJitter = jitter;
+            emit _teleop->PublishJitterChanged();
+          }, Qt::QueuedConnection);
+      maxLate = Clock::duration::zero();
+      reportTime = now + std::chrono::seconds(1);
+    }
+
+    // After a stall, skip the missed ticks instead of bursting through them
+    next += period;
+    if (next < now)
+      next = now + period;
+
+    lock.lock();
+  }
+}
+
 /////////////////////////////////////////////////
 Teleop::Teleop(): dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
@@ -113,7 +261,18 @@ Teleop::Teleop(): dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 }
 
 /////////////////////////////////////////////////
-Teleop::~Teleop() = default;
+Teleop::~Teleop()
+{
+  if (!this->dataPtr->publishThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->stopCv.notify_all();
+  this->dataPtr->publishThread.join();
+}
 
 /////////////////////////////////////////////////
 void Teleop::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
@@ -126,6 +285,41 @@ void Teleop::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     auto topicElem = _pluginElem->FirstChildElement("topic");
     if (nullptr != topicElem && nullptr != topicElem->GetText())
       this->SetTopic(topicElem->GetText());
+
+    if (auto elem = _pluginElem->FirstChildElement("publish_rate"))
+      elem->QueryDoubleText(&this->dataPtr->publishRate);
+
+    if (auto elem = _pluginElem->FirstChildElement("deadman_timeout"))
+      elem->QueryDoubleText(&this->dataPtr->deadmanTimeout);
+  }
+
+  if (this->dataPtr->publishRate < 0.0)
+  {
+    gzwarn << "Invalid <publish_rate> [" << this->dataPtr->publishRate
+           << "], publishing from the GUI thread" << std::endl;
+    this->dataPtr->publishRate = 0.0;
+  }
+
+  if (this->dataPtr->publishRate > 0.0 &&
+      !this->dataPtr->publishThread.joinable())
+  {
+    if (this->dataPtr->deadmanTimeout > 0.0)
+    {
+      auto beat = [this]()
+      {
+        this->dataPtr->heartbeat =
+            std::chrono::steady_clock::now().time_since_epoch().count();
+      };
+      beat();
+      this->connect(&this->dataPtr->heartbeatTimer, &QTimer::timeout,
+          this, beat);
+      this->dataPtr->heartbeatTimer.start(std::max(1,
+          static_cast<int>(this->dataPtr->deadmanTimeout * 250.0)));
+    }
+
+    this->dataPtr->publishThread = std::thread(
+        &Implementation::PublishLoop, this->dataPtr.get(), this);
+    emit this->PublishRateChanged();
   }
 
   App()->findChild<MainWindow *>()->QuickWindow()->installEventFilter(this);
@@ -135,17 +329,18 @@ void Teleop::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 void Teleop::OnTeleopTwist(double _forwardVel, double _verticalVel,
         double _angVel)
 {
-  msgs::Twist cmdVelMsg;
-
-  cmdVelMsg.mutable_linear()->set_x(_forwardVel);
-  cmdVelMsg.mutable_linear()->set_z(_verticalVel);
-  cmdVelMsg.mutable_angular()->set_z(_angVel);
+  const Command command{_forwardVel, _verticalVel, _angVel};
 
-  if (!this->dataPtr->cmdVelPub.Publish(cmdVelMsg))
+  // The publisher thread sends it on its next tick
+  if (this->dataPtr->publishThread.joinable())
   {
-    gzerr << "gz::msgs::Twist message couldn't be published at topic: "
-      << this->dataPtr->topic << std::endl;
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->command = command;
+    return;
   }
+
+  this->dataPtr->command = command;
+  publish(this->dataPtr->cmdVelPub, command, this->dataPtr->topic);
 }
 
 /////////////////////////////////////////////////
@@ -157,15 +352,19 @@ QString Teleop::Topic() const
 /////////////////////////////////////////////////
 void Teleop::SetTopic(const QString &_topic)
 {
-  this->dataPtr->topic = _topic.toStdString();
+  auto topic = _topic.toStdString();
   gzmsg << "A new topic has been entered: '" <<
-      this->dataPtr->topic << " ' " <<std::endl;
+      topic << " ' " <<std::endl;
 
   // Update publisher with new topic.
-  this->dataPtr->cmdVelPub = transport::Node::Publisher();
-  this->dataPtr->cmdVelPub =
-      this->dataPtr->node.Advertise<msgs::Twist>
-      (this->dataPtr->topic);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->topic = topic;
+    this->dataPtr->cmdVelPub = transport::Node::Publisher();
+    this->dataPtr->cmdVelPub =
+        this->dataPtr->node.Advertise<msgs::Twist>
+        (this->dataPtr->topic);
+  }
   if (!this->dataPtr->cmdVelPub)
   {
     emit App()->findChild<MainWindow *>()->notifyWithDuration(
@@ -222,6 +421,18 @@ double Teleop::MaxYawVel() const
   return this->dataPtr->maxYawVel;
 }
 
+/////////////////////////////////////////////////
+double Teleop::PublishRate() const
+{
+  return this->dataPtr->publishRate;
+}
+
+/////////////////////////////////////////////////
+double Teleop::PublishJitter() const
+{
+  return this->dataPtr->publishJitter;
+}
+
 /////////////////////////////////////////////////
 void Teleop::OnKeySwitch(bool _checked)
 {
@@ -43,6 +43,14 @@ namespace gz::gui::plugins
   /// vehicle in the world.
   /// ## Configuration
   /// * `<topic>`: Topic to publish twist messages to.
+  /// * `<publish_rate>`: Commands per second. When set, a dedicated thread
+  ///   publishes the latest command at this rate, so stalls of the GUI
+  ///   thread don't delay commands. Commands given between two ticks are
+  ///   coalesced. Defaults to 0, which publishes each command from the GUI
+  ///   thread as it's given.
+  /// * `<deadman_timeout>`: Seconds the GUI thread may be unresponsive
+  ///   before zero velocities are published instead of the latest command.
+  ///   Only used with `<publish_rate>`. Defaults to 0, disabled.
   class Teleop_EXPORTS_API Teleop : public Plugin
   {
     Q_OBJECT
@@ -79,6 +87,22 @@ namespace gz::gui::plugins
       NOTIFY MaxYawVelChanged
     )
 
+    /// \brief Commands per second of the publisher thread, zero when
+    /// commands are published from the GUI thread
+    Q_PROPERTY(
+      double publishRate
+      READ PublishRate
+      NOTIFY PublishRateChanged
+    )
+
+    /// \brief Largest delay of a publish past its deadline during the last
+    /// second, in milliseconds
+    Q_PROPERTY(
+      double publishJitter
+      READ PublishJitter
+      NOTIFY PublishJitterChanged
+    )
+
     /// \brief Constructor
     public: Teleop();
 
@@ -144,6 +168,20 @@ namespace gz::gui::plugins
     /// \brief Notify that yaw velocity has changed
     signals: void MaxYawVelChanged();
 
+    /// \brief Get the rate of the publisher thread.
+    /// \return Commands per second, zero without a publisher thread.
+    public: Q_INVOKABLE double PublishRate() const;
+
+    /// \brief Notify that the publish rate has changed
+    signals: void PublishRateChanged();
+
+    /// \brief Get the publish jitter of the last second.
+    /// \return Largest delay past a deadline, in milliseconds.
+    public: Q_INVOKABLE double PublishJitter() const;
+
+    /// \brief Notify that the publish jitter has changed
+    signals: void PublishJitterChanged();
+
     /// \brief Callback in Qt thread when the keyboard is enabled or disabled.
     /// \param[in] _checked variable to indicate the state of the switch.
     public slots: void OnKeySwitch(bool _checked);
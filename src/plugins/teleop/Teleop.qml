@@ -94,6 +94,17 @@ ColumnLayout {
     }
   }
 
+  // Publish jitter, only measured by the publisher thread
+  Label {
+    id: jitterLabel
+    visible: Teleop.publishRate > 0
+    text: "Publishing at " + Teleop.publishRate + " Hz, jitter " +
+        Teleop.publishJitter.toFixed(2) + " ms"
+    color: "dimgrey"
+    Layout.fillWidth: true
+    Layout.margins: 10
+  }
+
   // Velocity input
   Label {
     id: velocityLabel
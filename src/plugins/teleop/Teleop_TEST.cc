@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <gz/msgs/stringmsg.pb.h>
 #include <gz/msgs/twist.pb.h>
 
@@ -239,3 +244,89 @@ TEST_F(TeleopTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(KeyboardCommand))
   this->verticalVel = 0.0;
   this->KeyEvent(false, Qt::Key_E);
 }
+
+/////////////////////////////////////////////////
+TEST(TeleopThreadTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(PublishRate))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const std::string topic{"/test/thread/cmd_vel"};
+  std::mutex mutex;
+  std::vector<msgs::Twist> received;
+  transport::Node node;
+  std::function<void(const msgs::Twist &)> cb =
+      [&](const msgs::Twist &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(_msg);
+      };
+  node.Subscribe(topic, cb);
+
+  const std::string pluginStr =
+    "<plugin filename=\"Teleop\">"
+      "<topic>" + topic + "</topic>"
+      "<publish_rate>100</publish_rate>"
+      "<deadman_timeout>0.2</deadman_timeout>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr.c_str()));
+  EXPECT_TRUE(app.LoadPlugin("Teleop",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::Teleop *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_DOUBLE_EQ(100.0, plugin->PublishRate());
+
+  // Commands are coalesced and repeated by the publisher thread
+  plugin->OnTeleopTwist(0.4, 0.0, 0.0);
+  plugin->OnTeleopTwist(0.5, 0.6, 0.7);
+  for (int i = 0; i < 50; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GT(received.size(), 10u);
+    ASSERT_FALSE(received.empty());
+    EXPECT_DOUBLE_EQ(0.5, received.back().linear().x());
+    EXPECT_DOUBLE_EQ(0.6, received.back().linear().z());
+    EXPECT_DOUBLE_EQ(0.7, received.back().angular().z());
+    received.clear();
+  }
+
+  // Commands keep flowing while the GUI thread is blocked, and stop once the
+  // deadman timeout expires
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GT(received.size(), 10u);
+    ASSERT_FALSE(received.empty());
+    EXPECT_DOUBLE_EQ(0.5, received.front().linear().x());
+    EXPECT_DOUBLE_EQ(0.0, received.back().linear().x());
+    EXPECT_DOUBLE_EQ(0.0, received.back().angular().z());
+    received.clear();
+  }
+
+  // The latest command is sent again once the GUI thread recovers
+  for (int i = 0; i < 20; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_FALSE(received.empty());
+    EXPECT_DOUBLE_EQ(0.5, received.back().linear().x());
+  }
+
+  // Jitter is reported every second
+  EXPECT_GE(plugin->PublishJitter(), 0.0);
+}
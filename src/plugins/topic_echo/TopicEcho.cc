@@ -15,24 +15,440 @@
  *
 */
 
+#include <QAbstractListModel>
+#include <QTimer>
+
 #include <gz/utils/ImplPtr.hh>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 #include <gz/plugin/Register.hh>
-#include <gz/transport/Node.hh>
+#include <gz/transport/log/Log.hh>
 
 #include "gz/gui/Application.hh"
+#include "gz/gui/MemoryAccounting.hh"
+#include "gz/gui/PerformanceCounters.hh"
+#include "gz/gui/SubscriptionHub.hh"
 #include "TopicEcho.hh"
 
+namespace
+{
+/// \brief Period of the list updates in ms, so fast topics don't flood the
+/// GUI thread
+constexpr int kRefreshPeriod = 33;
+
+/// \brief Most bytes waiting to be written while recording, msgs arriving
+/// faster than the disk takes them are dropped past it
+constexpr std::size_t kMaxQueuedBytes = 64u << 20;
+
+/// \brief A received msg waiting to be logged
+class LogRecord
+{
+  /// \brief Reception time since the epoch
+  public: std::chrono::nanoseconds time;
+
+  /// \brief Msg type
+  public: std::string type;
+
+  /// \brief Serialized msg
+  public: std::string data;
+};
+
+/// \brief Writes the serialized msgs of a topic to gz-transport logs from a
+/// background thread, starting a new file when one grows past a size
+/// limit. The logs can be played back with `gz log playback`.
+class EchoRecorder
+{
+  /// \brief Destructor, writes the queued msgs and closes the log
+  public: ~EchoRecorder()
+  {
+    this->Stop();
+  }
+
+  /// \brief Start recording
+  /// \param[in] _path Path of the first log file, which mustn't exist
+  /// \param[in] _topic Recorded topic
+  /// \param[in] _maxSize Size in bytes past which a new file is started,
+  /// 0 for no limit
+  /// \param[in] _maxFiles Most files kept, the oldest ones are removed
+  /// first, 0 for no limit
+  /// \return True if the first file was opened
+  public: bool Start(const std::string &_path, const std::string &_topic,
+      std::size_t _maxSize, unsigned int _maxFiles)
+  {
+    this->Stop();
+
+    if (gz::common::exists(_path))
+    {
+      gzerr << "Not overwriting existing log [" << _path << "]" << std::endl;
+      return false;
+    }
+
+    this->path = _path;
+    this->topic = _topic;
+    this->maxSize = _maxSize;
+    this->maxFiles = _maxFiles;
+    this->fileIndex = 0;
+    this->fileSize = 0;
+    this->log = std::make_unique<gz::transport::log::Log>();
+    if (!this->log->Open(_path, std::ios_base::out))
+    {
+      gzerr << "Failed to open log [" << _path << "]" << std::endl;
+      this->log.reset();
+      return false;
+    }
+
+    this->stop = false;
+    this->thread = std::thread(&EchoRecorder::Run, this);
+    return true;
+  }
+
+  /// \brief Stop recording, once the queued msgs are written
+  public: void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stop = true;
+    }
+    this->condition.notify_all();
+    if (this->thread.joinable())
+      this->thread.join();
+    this->log.reset();
+  }
+
+  /// \brief Queue a msg, called from transport threads
+  /// \param[in] _data Serialized msg
+  /// \param[in] _size Size of the serialized msg
+  /// \param[in] _type Msg type
+  public: void Add(const char *_data, std::size_t _size,
+      const std::string &_type)
+  {
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->stop)
+        return;
+      if (this->queuedBytes + _size > kMaxQueuedBytes)
+      {
+        ++this->dropped;
+        return;
+      }
+      this->queuedBytes += _size;
+      this->queue.push_back({now, _type, std::string(_data, _size)});
+    }
+    this->condition.notify_one();
+  }
+
+  /// \brief Get the path of a log file
+  /// \param[in] _index File number, 0 for the first one
+  /// \return Path, with the number before the extension after the first
+  /// file, such as "echo_1.tlog"
+  private: std::string FilePath(unsigned int _index) const
+  {
+    if (_index == 0)
+      return this->path;
+
+    const auto dot = this->path.rfind('.');
+    const auto slash = this->path.find_last_of("/\\");
+    const bool hasExtension = dot != std::string::npos &&
+        (slash == std::string::npos || dot > slash);
+    const auto stem = hasExtension ? this->path.substr(0, dot) : this->path;
+    const auto extension = hasExtension ? this->path.substr(dot) : "";
+    return stem + "_" + std::to_string(_index) + extension;
+  }
+
+  /// \brief Close the current file and start the next one
+  private: void Rotate()
+  {
+    this->log.reset();
+    ++this->fileIndex;
+    this->fileSize = 0;
+
+    if (this->maxFiles > 0 && this->fileIndex >= this->maxFiles)
+      gz::common::removeFile(this->FilePath(this->fileIndex - this->maxFiles));
+
+    const auto filePath = this->FilePath(this->fileIndex);
+    if (gz::common::exists(filePath))
+      gz::common::removeFile(filePath);
+
+    this->log = std::make_unique<gz::transport::log::Log>();
+    if (!this->log->Open(filePath, std::ios_base::out))
+    {
+      gzerr << "Failed to open log [" << filePath << "], recording stopped"
+            << std::endl;
+      this->log.reset();
+    }
+  }
+
+  /// \brief Write the queued msgs until stopped
+  private: void Run()
+  {
+    std::deque<LogRecord> records;
+    while (true)
+    {
+      std::size_t lost{0};
+      bool done{false};
+      {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->condition.wait(lock,
+            [this]{return this->stop || !this->queue.empty();});
+        std::swap(records, this->queue);
+        this->queuedBytes = 0;
+        std::swap(lost, this->dropped);
+        done = this->stop;
+      }
+
+      if (lost > 0)
+      {
+        gzwarn << "Dropped [" << lost << "] msgs of [" << this->topic
+               << "], the log can't keep up" << std::endl;
+      }
+
+      for (const auto &record : records)
+      {
+        if (!this->log)
+          break;
+
+        this->log->InsertMessage(record.time, this->topic, record.type,
+            record.data.data(), record.data.size());
+        this->fileSize += record.data.size();
+        if (this->maxSize > 0 && this->fileSize >= this->maxSize)
+          this->Rotate();
+      }
+      records.clear();
+
+      if (done)
+        return;
+    }
+  }
+
+  /// \brief Path of the first file
+  private: std::string path;
+
+  /// \brief Recorded topic
+  private: std::string topic;
+
+  /// \brief Size past which a new file is started, 0 for no limit
+  private: std::size_t maxSize{0};
+
+  /// \brief Most files kept, 0 for no limit
+  private: unsigned int maxFiles{0};
+
+  /// \brief Number of the current file
+  private: unsigned int fileIndex{0};
+
+  /// \brief Bytes of msgs written to the current file
+  private: std::size_t fileSize{0};
+
+  /// \brief Current log, only used by the writer thread once started
+  private: std::unique_ptr<gz::transport::log::Log> log;
+
+  /// \brief Writer thread
+  private: std::thread thread;
+
+  /// \brief Protects the queue
+  private: std::mutex mutex;
+
+  /// \brief Notifies the writer thread of queued msgs
+  private: std::condition_variable condition;
+
+  /// \brief Msgs waiting to be written
+  private: std::deque<LogRecord> queue;
+
+  /// \brief Size of the queued msgs
+  private: std::size_t queuedBytes{0};
+
+  /// \brief Msgs dropped since the last write
+  private: std::size_t dropped{0};
+
+  /// \brief True once stopping
+  private: bool stop{true};
+};
+}  // namespace
+
 namespace gz::gui::plugins
 {
+/// \brief List of the last received msgs, stored in a fixed capacity ring.
+/// Msgs are only formatted when a visible row asks for its text.
+class TopicEchoModel : public QAbstractListModel
+{
+  /// \brief A received msg and its text, once formatted
+  public: class Entry
+  {
+    /// \brief Received msg, shared with other subscribers
+    public: std::shared_ptr<const google::protobuf::Message> msg;
+
+    /// \brief Text of the msg, empty until it's displayed
+    public: QString text;
+
+    /// \brief Bytes held by the msg and its text
+    public: std::size_t bytes{0};
+  };
+
+  // Documentation inherited
+  public: int rowCount(const QModelIndex &_parent) const override
+  {
+    return _parent.isValid() ? 0 : static_cast<int>(this->count);
+  }
+
+  // Documentation inherited
+  public: QVariant data(const QModelIndex &_index, int _role) const override
+  {
+    if (_role != Qt::DisplayRole || !_index.isValid() ||
+        _index.row() >= static_cast<int>(this->count))
+    {
+      return QVariant();
+    }
+
+    auto &entry = this->Slot(static_cast<std::size_t>(_index.row()));
+    if (entry.text.isEmpty() && entry.msg)
+    {
+      entry.text = QString::fromStdString(entry.msg->DebugString());
+      const std::size_t textBytes =
+          static_cast<std::size_t>(entry.text.size()) * sizeof(QChar);
+      entry.bytes += textBytes;
+      this->memory.Add(textBytes);
+    }
+    return entry.text;
+  }
+
+  /// \brief Set how many msgs are kept, dropping the oldest ones
+  /// \param[in] _capacity Number of msgs
+  public: void SetCapacity(std::size_t _capacity)
+  {
+    if (_capacity == this->ring.size())
+      return;
+
+    // Unroll the ring, keeping the newest msgs
+    const std::size_t kept = std::min(this->count, _capacity);
+    if (kept < this->count)
+    {
+      this->beginRemoveRows(QModelIndex(), 0,
+          static_cast<int>(this->count - kept) - 1);
+    }
+
+    std::vector<Entry> entries(_capacity);
+    std::size_t bytes{0};
+    for (std::size_t i = 0; i < kept; ++i)
+    {
+      entries[i] = std::move(this->Slot(this->count - kept + i));
+      bytes += entries[i].bytes;
+    }
+    this->memory.Set(bytes);
+    this->ring = std::move(entries);
+    this->head = 0;
+
+    if (kept < this->count)
+    {
+      this->count = kept;
+      this->endRemoveRows();
+    }
+  }
+
+  /// \brief Append msgs, dropping the oldest ones once full
+  /// \param[in] _msgs Msgs to append, in arrival order
+  public: void Append(
+      std::vector<std::shared_ptr<const google::protobuf::Message>> &_msgs)
+  {
+    const std::size_t capacity = this->ring.size();
+    if (_msgs.empty() || capacity == 0)
+      return;
+
+    // Only the last msgs fit
+    std::size_t first = 0;
+    if (_msgs.size() > capacity)
+      first = _msgs.size() - capacity;
+    const std::size_t added = _msgs.size() - first;
+
+    const std::size_t dropped = this->count + added > capacity ?
+        this->count + added - capacity : 0;
+    if (dropped > 0)
+    {
+      this->beginRemoveRows(QModelIndex(), 0, static_cast<int>(dropped) - 1);
+      this->head = (this->head + dropped) % capacity;
+      this->count -= dropped;
+      this->endRemoveRows();
+    }
+
+    this->beginInsertRows(QModelIndex(), static_cast<int>(this->count),
+        static_cast<int>(this->count + added) - 1);
+    for (std::size_t i = first; i < _msgs.size(); ++i)
+    {
+      auto &entry = this->Slot(this->count++);
+      this->memory.Remove(entry.bytes);
+      entry.msg = std::move(_msgs[i]);
+      entry.text.clear();
+      entry.bytes = entry.msg ? entry.msg->SpaceUsedLong() : 0u;
+      this->memory.Add(entry.bytes);
+    }
+    this->endInsertRows();
+  }
+
+  /// \brief Remove all msgs
+  public: void Clear()
+  {
+    if (this->count == 0)
+      return;
+
+    this->beginResetModel();
+    for (auto &entry : this->ring)
+      entry = Entry();
+    this->memory.Set(0);
+    this->head = 0;
+    this->count = 0;
+    this->endResetModel();
+  }
+
+  /// \brief Get the entry of a row
+  /// \param[in] _row Row, 0 being the oldest msg
+  /// \return Entry in the ring
+  private: Entry &Slot(std::size_t _row) const
+  {
+    return this->ring[(this->head + _row) % this->ring.size()];
+  }
+
+  /// \brief Fixed capacity storage, mutable so texts can be cached
+  private: mutable std::vector<Entry> ring;
+
+  /// \brief Position of the oldest msg in the ring
+  private: std::size_t head{0};
+
+  /// \brief Number of msgs in the ring
+  private: std::size_t count{0};
+
+  /// \brief Reports the bytes of the msgs and texts held. Msgs are shared
+  /// with other subscribers of the topic, which may count them too.
+  private: mutable MemoryAccount memory{"TopicEcho", "msgs"};
+};
+
 class TopicEcho::Implementation
 {
   /// \brief Topic
   public: QString topic{"/echo"};
 
-  /// \brief A list of text data.
-  public: QStringListModel msgList {nullptr};
+  /// \brief List of the last msgs
+  public: TopicEchoModel msgList;
+
+  /// \brief Msgs received since the last refresh, protected by `mutex`.
+  /// It never holds more than `buffer` msgs.
+  public: std::vector<std::shared_ptr<const google::protobuf::Message>>
+      pending;
+
+  /// \brief Moves the pending msgs to the list, at a capped rate
+  public: QTimer refreshTimer;
+
+  /// \brief Reports the number of pending msgs
+  public: PerformanceCounter queueCounter{"TopicEcho", "pending msgs"};
 
   /// \brief Size of the text buffer. The size is the number of
   /// messages.
@@ -44,44 +460,162 @@ class TopicEcho::Implementation
   /// \brief Mutex to protect message buffer.
   public: std::mutex mutex;
 
-  /// \brief Node for communication
-  public: gz::transport::Node node;
+  /// \brief Subscription to the echoed topic, shared with other plugins
+  public: HubSubscription subscription;
+
+  /// \brief Writes the recorded msgs
+  public: EchoRecorder recorder;
+
+  /// \brief Subscription to the serialized msgs of the recorded topic
+  public: HubSubscription recordSubscription;
+
+  /// \brief Log file being recorded, empty if not recording
+  public: QString recordPath;
+
+  /// \brief Size in bytes past which a new log file is started
+  public: std::size_t recordMaxSize{100u << 20};
+
+  /// \brief Most log files kept while recording
+  public: unsigned int recordMaxFiles{0};
+
+  /// \brief Most messages per second echoed, 0 for all
+  public: double maxRate{0.0};
 };
 
 /////////////////////////////////////////////////
 TopicEcho::TopicEcho()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
+  this->dataPtr->msgList.SetCapacity(this->dataPtr->buffer);
+
   // Connect model
   App()->Engine()->rootContext()->setContextProperty("TopicEchoMsgList",
       &this->dataPtr->msgList);
+
+  this->dataPtr->refreshTimer.setInterval(kRefreshPeriod);
+  this->connect(&this->dataPtr->refreshTimer, &QTimer::timeout,
+      this, &TopicEcho::OnRefresh);
 }
 
 /////////////////////////////////////////////////
-TopicEcho::~TopicEcho() = default;
+TopicEcho::~TopicEcho()
+{
+  this->StopRecording();
+}
 
 /////////////////////////////////////////////////
-void TopicEcho::LoadConfig(const tinyxml2::XMLElement * /*_pluginElem*/)
+void TopicEcho::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Topic echo";
 
-  this->connect(this, SIGNAL(AddMsg(QString)), this, SLOT(OnAddMsg(QString)),
-          Qt::QueuedConnection);
+  if (!_pluginElem)
+    return;
+
+  if (auto sizeElem = _pluginElem->FirstChildElement("record_max_size"))
+  {
+    double megabytes{0.0};
+    if (sizeElem->QueryDoubleText(&megabytes) != tinyxml2::XML_SUCCESS ||
+        megabytes < 0)
+    {
+      gzerr << "Failed to parse <record_max_size>" << std::endl;
+    }
+    else
+    {
+      this->dataPtr->recordMaxSize =
+          static_cast<std::size_t>(megabytes * (1 << 20));
+    }
+  }
+
+  if (auto filesElem = _pluginElem->FirstChildElement("record_max_files"))
+  {
+    if (filesElem->QueryUnsignedText(&this->dataPtr->recordMaxFiles) !=
+        tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Failed to parse <record_max_files>" << std::endl;
+    }
+  }
+
+  if (auto rateElem = _pluginElem->FirstChildElement("max_rate"))
+  {
+    double maxRate{0.0};
+    if (rateElem->QueryDoubleText(&maxRate) != tinyxml2::XML_SUCCESS ||
+        maxRate < 0)
+    {
+      gzerr << "Failed to parse <max_rate>" << std::endl;
+    }
+    else
+    {
+      this->dataPtr->maxRate = maxRate;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool TopicEcho::StartRecording(const QString &_path)
+{
+  this->StopRecording();
+
+  const auto path = _path.toStdString();
+  const auto topic = this->dataPtr->topic.toStdString();
+  if (!this->dataPtr->recorder.Start(path, topic,
+      this->dataPtr->recordMaxSize, this->dataPtr->recordMaxFiles))
+  {
+    return false;
+  }
+
+  // Serialized msgs are logged as they are, without formatting
+  this->dataPtr->recordSubscription = App()->Subscriptions()->SubscribeRaw(
+      topic, [this](const char *_data, std::size_t _size,
+      const std::string &_msgType)
+      {
+        this->dataPtr->recorder.Add(_data, _size, _msgType);
+      });
+  if (!this->dataPtr->recordSubscription.Valid())
+  {
+    gzerr << "Invalid topic [" << topic << "]" << std::endl;
+    this->dataPtr->recorder.Stop();
+    return false;
+  }
+
+  gzmsg << "Recording [" << topic << "] to [" << path << "]" << std::endl;
+  this->dataPtr->recordPath = _path;
+  emit this->RecordingChanged();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::StopRecording()
+{
+  // Unsubscribe first, so nothing is queued while the rest is written
+  this->dataPtr->recordSubscription.Reset();
+  this->dataPtr->recorder.Stop();
+
+  if (this->dataPtr->recordPath.isEmpty())
+    return;
+
+  this->dataPtr->recordPath.clear();
+  emit this->RecordingChanged();
+}
+
+/////////////////////////////////////////////////
+bool TopicEcho::Recording() const
+{
+  return !this->dataPtr->recordPath.isEmpty();
 }
 
 /////////////////////////////////////////////////
 void TopicEcho::Stop()
 {
+  // Unsubscribe, without holding the mutex the callback waits for
+  this->dataPtr->subscription.Reset();
+  this->dataPtr->refreshTimer.stop();
+
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Erase all previous messages
-  this->dataPtr->msgList.removeRows(0,
-      this->dataPtr->msgList.rowCount());
-
-  // Unsubscribe
-  for (auto const &sub : this->dataPtr->node.SubscribedTopics())
-    this->dataPtr->node.Unsubscribe(sub);
+  this->dataPtr->pending.clear();
+  this->dataPtr->msgList.Clear();
 }
 
 /////////////////////////////////////////////////
@@ -92,44 +626,48 @@ void TopicEcho::OnEcho(const bool _checked)
   if (!_checked)
     return;
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
   // Subscribe to new topic
   auto topic = this->dataPtr->topic.toStdString();
-  if (!this->dataPtr->node.Subscribe(topic, &TopicEcho::OnMessage, this))
+  this->dataPtr->subscription = App()->Subscriptions()->Subscribe(topic,
+      [this](const std::shared_ptr<const google::protobuf::Message> &_msg)
+      {
+        this->OnMessage(_msg);
+      }, this->dataPtr->maxRate);
+  if (!this->dataPtr->subscription.Valid())
   {
     gzerr << "Invalid topic [" << topic << "]" << std::endl;
+    return;
   }
+  this->dataPtr->refreshTimer.start();
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::OnMessage(const google::protobuf::Message &_msg)
+void TopicEcho::OnMessage(
+    const std::shared_ptr<const google::protobuf::Message> &_msg)
 {
   if (this->dataPtr->paused)
     return;
 
+  // Formatted later, only if displayed
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  emit this->AddMsg(QString::fromStdString(_msg.DebugString()));
+  auto &pending = this->dataPtr->pending;
+  if (pending.size() >= this->dataPtr->buffer && !pending.empty())
+    pending.erase(pending.begin());
+  if (this->dataPtr->buffer > 0)
+    pending.push_back(_msg);
+  this->dataPtr->queueCounter.SetQueueDepth(pending.size());
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::OnAddMsg(QString _msg)
+void TopicEcho::OnRefresh()
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  // Append msg to list
-  if (this->dataPtr->msgList.insertRow(this->dataPtr->msgList.rowCount()))
+  std::vector<std::shared_ptr<const google::protobuf::Message>> msgs;
   {
-    auto index = this->dataPtr->msgList.index(
-        this->dataPtr->msgList.rowCount() - 1, 0);
-    this->dataPtr->msgList.setData(index, _msg);
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    std::swap(msgs, this->dataPtr->pending);
   }
-
-  // Remove items if the list is too long.
-  auto diff = this->dataPtr->msgList.rowCount() -
-      this->dataPtr->buffer;
-  this->dataPtr->msgList.removeRows(0, diff);
+  this->dataPtr->queueCounter.SetQueueDepth(0);
+  this->dataPtr->msgList.Append(msgs);
 }
 
 /////////////////////////////////////////////////
@@ -148,7 +686,9 @@ void TopicEcho::SetTopic(const QString &_topic)
 /////////////////////////////////////////////////
 void TopicEcho::OnBuffer(const unsigned int _buffer)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->buffer = _buffer;
+  this->dataPtr->msgList.SetCapacity(_buffer);
 }
 
 /////////////////////////////////////////////////
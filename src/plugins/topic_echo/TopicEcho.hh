@@ -46,8 +46,27 @@ namespace gz::gui::plugins
 {
   /// \brief Echo messages coming through a Gazebo Transport topic.
   ///
+  /// The last messages are kept in a fixed size buffer, and only the visible
+  /// ones are formatted. The list is updated about 30 times a second at
+  /// most, so fast topics don't freeze the GUI.
+  ///
+  /// Messages of the topic can also be recorded to gz-transport log files,
+  /// which can be played back with `gz log playback`. Serialized messages
+  /// are written as they are by a background thread.
+  ///
   /// ## Configuration
-  /// This plugin doesn't accept any custom configuration.
+  ///
+  /// \<record_max_size\> : Size of a log file in MB past which recording
+  ///                       continues in a new file, 100 by default, 0 for no
+  ///                       limit. Files after the first one are numbered,
+  ///                       such as "echo_1.tlog".
+  /// \<record_max_files\> : Most log files kept while recording, the oldest
+  ///                        ones are removed first. 0 by default, for no
+  ///                        limit.
+  /// \<max_rate\> : Most messages per second echoed, 0 by default for all
+  ///                of them. Messages above this rate are dropped by the
+  ///                transport subscription, before they're delivered and
+  ///                deserialized. Recordings still get every message.
   class TopicEcho_EXPORTS_API TopicEcho : public Plugin
   {
     Q_OBJECT
@@ -68,6 +87,13 @@ namespace gz::gui::plugins
       NOTIFY PausedChanged
     )
 
+    /// \brief Recording
+    Q_PROPERTY(
+      bool recording
+      READ Recording
+      NOTIFY RecordingChanged
+    )
+
     /// \brief Constructor
     public: TopicEcho();
 
@@ -103,13 +129,26 @@ namespace gz::gui::plugins
     /// \brief Notify that paused has changed
     signals: void PausedChanged();
 
-    /// \brief Signal to add a message to the GUI list.
-    /// \param[in] _msg Text message to add.
-    signals: void AddMsg(QString _msg);
+    /// \brief Start recording the topic to a log file, stopping the current
+    /// recording first
+    /// \param[in] _path Path of the log file, which mustn't exist
+    /// \return True if recording started
+    public: Q_INVOKABLE bool StartRecording(const QString &_path);
+
+    /// \brief Stop recording, once the received messages are written
+    public: Q_INVOKABLE void StopRecording();
+
+    /// \brief Get whether the topic is being recorded
+    /// \return True if recording
+    public: Q_INVOKABLE bool Recording() const;
+
+    /// \brief Notify that recording started or stopped
+    signals: void RecordingChanged();
 
-    /// \brief Receives incoming text messages.
-    /// \param[in] _msg New text message.
-    private: void OnMessage(const google::protobuf::Message &_msg);
+    /// \brief Receives incoming messages, from a transport thread.
+    /// \param[in] _msg New message.
+    private: void OnMessage(
+        const std::shared_ptr<const google::protobuf::Message> &_msg);
 
     /// \brief Clear list and unsubscribe.
     private: void Stop();
@@ -117,9 +156,9 @@ namespace gz::gui::plugins
     /// \brief Callback when echo button is pressed
     public slots: void OnEcho(const bool _checked);
 
-    /// \brief Callback from the ::AddMsg signal.
-    /// \param[in] _msg Message to add to the list.
-    private slots: void OnAddMsg(QString _msg);
+    /// \brief Add the messages received since the last refresh to the
+    /// GUI list.
+    private slots: void OnRefresh();
 
     /// \internal
     /// \brief Pointer to private data.
@@ -73,6 +73,41 @@ Rectangle {
       }
     }
 
+    Row {
+      Column {
+        Label {
+          text: "Log file"
+        }
+
+        TextField {
+          id: recordField
+          objectName: "recordField"
+          placeholderText: "echo.tlog"
+          selectByMouse: true
+        }
+      }
+
+      Switch {
+        objectName: "recordSwitch"
+        text: qsTr("Record")
+        checked: TopicEcho.recording
+        onToggled: {
+          if (checked) {
+            TopicEcho.topic = topicField.text
+            checked = TopicEcho.StartRecording(recordField.text)
+          }
+          else {
+            TopicEcho.StopRecording()
+          }
+        }
+        ToolTip.visible: hovered
+        ToolTip.delay: tooltipDelay
+        ToolTip.timeout: tooltipTimeout
+        ToolTip.text: checked ? qsTr("Stop recording") :
+            qsTr("Record the topic to a log file")
+      }
+    }
+
     CheckBox {
       objectName: "pauseCheck"
       text: qsTr("Pause")
@@ -22,6 +22,7 @@
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/transport/Node.hh>
+#include <gz/transport/log/Log.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
 #include "gz/gui/Application.hh"
@@ -39,6 +40,18 @@ char* g_argv[] =
 using namespace gz;
 using namespace gui;
 
+/////////////////////////////////////////////////
+/// \brief Get the texts of a list model
+/// \param[in] _model Model to read
+/// \return Text of each row
+QStringList texts(const QAbstractItemModel *_model)
+{
+  QStringList list;
+  for (int row = 0; row < _model->rowCount(); ++row)
+    list.append(_model->data(_model->index(row, 0)).toString());
+  return list;
+}
+
 /////////////////////////////////////////////////
 TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Load))
 {
@@ -100,7 +113,8 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   ASSERT_NE(msgList, nullptr);
   objProp = msgList->property("model");
   EXPECT_TRUE(objProp.isValid());
-  auto msgStringList = objProp.value<QStringListModel *>();
+  auto msgStringList = qobject_cast<QAbstractItemModel *>(
+      objProp.value<QObject *>());
   ASSERT_NE(msgStringList, nullptr);
   EXPECT_EQ(msgStringList->rowCount(), 0);
 
@@ -138,7 +152,7 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
 
   // Check message was echoed
   ASSERT_EQ(msgStringList->rowCount(), 1);
-  EXPECT_EQ(msgStringList->stringList().at(0).toStdString(),
+  EXPECT_EQ(texts(msgStringList).at(0).toStdString(),
             "data: \"example string\"\n");
 
   // Publish more than buffer size (messages numbered 0 to 14)
@@ -154,8 +168,8 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   // 13 and 14. There's a chance a lower number comes afterwards, but that's
   // just bad luck.
   sleep = 0;
-  while (msgStringList->stringList().filter("13").count() == 0
-      && msgStringList->stringList().filter("14").count() == 0
+  while (texts(msgStringList).filter("13").count() == 0
+      && texts(msgStringList).filter("14").count() == 0
       && sleep < maxSleep)
   {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -173,7 +187,7 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   unsigned int count = 0;
   for (auto i = 5; i < 15; ++i)
   {
-    if (msgStringList->stringList().filter(QString::number(i)).count() > 0)
+    if (texts(msgStringList).filter(QString::number(i)).count() > 0)
       ++count;
   }
   EXPECT_GE(count, 6u);
@@ -201,9 +215,9 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   ASSERT_EQ(msgStringList->rowCount(), 11);
 
   // The last one is guaranteed to be the new message
-  EXPECT_EQ(msgStringList->stringList().constLast().toStdString(),
+  EXPECT_EQ(texts(msgStringList).constLast().toStdString(),
             "data: \"new message\"\n")
-            << msgStringList->stringList().constLast().toStdString();
+            << texts(msgStringList).constLast().toStdString();
 
   // Pause
   plugin->SetPaused(true);
@@ -223,9 +237,9 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
     ++sleep;
   }
   ASSERT_EQ(msgStringList->rowCount(), 11);
-  EXPECT_EQ(msgStringList->stringList().constLast().toStdString(),
+  EXPECT_EQ(texts(msgStringList).constLast().toStdString(),
             "data: \"new message\"\n")
-            << msgStringList->stringList().constLast().toStdString();
+            << texts(msgStringList).constLast().toStdString();
 
   // Decrease buffer
   bufferField->setProperty("value", 5);
@@ -239,8 +253,11 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   msg.set_data("new message 2");
   pub.Publish(msg);
 
+  // The list is trimmed right away, wait for the new message
+  EXPECT_EQ(msgStringList->rowCount(), 5);
   sleep = 0;
-  while (msgStringList->rowCount() != 5 && sleep < maxSleep)
+  while (texts(msgStringList).filter("new message 2").count() == 0 &&
+      sleep < maxSleep)
   {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     QCoreApplication::processEvents();
@@ -251,9 +268,9 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   ASSERT_EQ(msgStringList->rowCount(), 5);
 
   // The last message is still the new one
-  EXPECT_EQ(msgStringList->stringList().constLast().toStdString(),
+  EXPECT_EQ(texts(msgStringList).constLast().toStdString(),
             "data: \"new message 2\"\n")
-            << msgStringList->stringList().constLast().toStdString();
+            << texts(msgStringList).constLast().toStdString();
 
   // Stop echoing
   plugin->OnEcho(false);
@@ -262,3 +279,92 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   // Cleanup
   plugins.clear();
 }
+
+/////////////////////////////////////////////////
+TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Record))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // A new file is started past 1 kB
+  const char *pluginStr =
+    "<plugin filename=\"TopicEcho\">"
+      "<record_max_size>0.001</record_max_size>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TopicEcho",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+  auto plugins = win->findChildren<plugins::TopicEcho *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  auto recordSwitch =
+      plugin->PluginItem()->findChild<QObject *>("recordSwitch");
+  ASSERT_NE(recordSwitch, nullptr);
+  EXPECT_FALSE(plugin->Recording());
+
+  const auto dir = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "test", "topic_echo_record");
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+  const auto path = common::joinPaths(dir, "echo.tlog");
+
+  plugin->SetTopic("/echo_record");
+  ASSERT_TRUE(plugin->StartRecording(QString::fromStdString(path)));
+  EXPECT_TRUE(plugin->Recording());
+  EXPECT_TRUE(recordSwitch->property("checked").toBool());
+
+  // Existing logs aren't overwritten
+  EXPECT_FALSE(plugin->StartRecording(QString::fromStdString(path)));
+  EXPECT_FALSE(plugin->Recording());
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+  ASSERT_TRUE(plugin->StartRecording(QString::fromStdString(path)));
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/echo_record");
+  msgs::StringMsg msg;
+  msg.set_data(std::string(100, 'a'));
+
+  // Wait for the first msg, then publish enough to fill a few files
+  int sleep = 0;
+  int maxSleep = 30;
+  while (!common::exists(common::joinPaths(dir, "echo_1.tlog")) &&
+      sleep < maxSleep)
+  {
+    for (int i = 0; i < 20; ++i)
+      pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ++sleep;
+  }
+  EXPECT_LT(sleep, maxSleep);
+
+  plugin->StopRecording();
+  EXPECT_FALSE(plugin->Recording());
+
+  // The logs can be played back
+  transport::log::Log log;
+  ASSERT_TRUE(log.Open(path));
+  int count = 0;
+  for (const auto &logMsg : log.QueryMessages())
+  {
+    EXPECT_EQ("/echo_record", logMsg.Topic());
+    EXPECT_EQ("gz.msgs.StringMsg", logMsg.Type());
+    msgs::StringMsg logged;
+    EXPECT_TRUE(logged.ParseFromString(logMsg.Data()));
+    EXPECT_EQ(msg.data(), logged.data());
+    ++count;
+  }
+  EXPECT_GE(count, 10);
+
+  common::removeAll(dir);
+  plugins.clear();
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+
+#include <google/protobuf/descriptor.h>
+
+#include "TopicStats.hh"
+
+namespace
+{
+/// \brief Read a varint
+/// \param[in, out] _it Current position, moved past the varint
+/// \param[in] _end End of the data
+/// \param[out] _value Value read
+/// \return False if the data ends first
+bool ReadVarint(const std::uint8_t *&_it, const std::uint8_t *_end,
+    std::uint64_t &_value)
+{
+  _value = 0;
+  for (int shift = 0; shift < 64 && _it < _end; shift += 7)
+  {
+    const std::uint8_t byte = *_it++;
+    _value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/// \brief Find a length delimited field
+/// \param[in, out] _begin Start of the msg, set to the start of the field
+/// \param[in, out] _end End of the msg, set to the end of the field
+/// \param[in] _number Field number
+/// \return True if found. The last occurrence wins, like when parsing.
+bool FindMessage(const std::uint8_t *&_begin, const std::uint8_t *&_end,
+    std::uint64_t _number)
+{
+  const std::uint8_t *it = _begin;
+  const std::uint8_t *fieldBegin{nullptr};
+  const std::uint8_t *fieldEnd{nullptr};
+  while (it < _end)
+  {
+    std::uint64_t tag{0};
+    if (!ReadVarint(it, _end, tag))
+      return false;
+    std::uint64_t length{0};
+    switch (tag & 7)
+    {
+      case 0:
+        if (!ReadVarint(it, _end, length))
+          return false;
+        continue;
+      case 1:
+        length = 8;
+        break;
+      case 2:
+        if (!ReadVarint(it, _end, length))
+          return false;
+        break;
+      case 5:
+        length = 4;
+        break;
+      default:
+        return false;
+    }
+    if (length > static_cast<std::uint64_t>(_end - it))
+      return false;
+    if ((tag >> 3) == _number && (tag & 7) == 2)
+    {
+      fieldBegin = it;
+      fieldEnd = it + length;
+    }
+    it += length;
+  }
+
+  if (!fieldBegin)
+    return false;
+  _begin = fieldBegin;
+  _end = fieldEnd;
+  return true;
+}
+}  // namespace
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+TopicStats::TopicStats(int _headerField)
+  : headerField(_headerField)
+{
+}
+
+/////////////////////////////////////////////////
+void TopicStats::Record(const char *_data, std::size_t _size,
+    double _receiveTime)
+{
+  this->count.fetch_add(1, std::memory_order_relaxed);
+  this->bytes.fetch_add(_size, std::memory_order_relaxed);
+
+  double stamp{0.0};
+  if (this->headerField > 0 &&
+      Stamp(_data, _size, this->headerField, stamp))
+  {
+    this->latencySum.fetch_add(
+        std::llround((_receiveTime - stamp) * 1e9),
+        std::memory_order_relaxed);
+    this->stamped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/////////////////////////////////////////////////
+TopicStats::Sample TopicStats::Take(double _elapsed)
+{
+  const auto msgs = this->count.exchange(0, std::memory_order_relaxed);
+  const auto size = this->bytes.exchange(0, std::memory_order_relaxed);
+  const auto latency = this->latencySum.exchange(0,
+      std::memory_order_relaxed);
+  const auto withStamp = this->stamped.exchange(0,
+      std::memory_order_relaxed);
+
+  Sample sample;
+  if (_elapsed > 0.0)
+  {
+    sample.rate = static_cast<double>(msgs) / _elapsed;
+    sample.bandwidth = static_cast<double>(size) / _elapsed;
+  }
+  if (msgs > 0)
+    sample.size = static_cast<double>(size) / static_cast<double>(msgs);
+  if (withStamp > 0)
+  {
+    sample.latency = static_cast<double>(latency) * 1e-9 /
+        static_cast<double>(withStamp);
+    sample.hasLatency = true;
+  }
+  return sample;
+}
+
+/////////////////////////////////////////////////
+int TopicStats::HeaderField(const std::string &_msgType)
+{
+  const auto *descriptor = google::protobuf::DescriptorPool::
+      generated_pool()->FindMessageTypeByName(_msgType);
+  if (!descriptor)
+    return 0;
+
+  const auto *field = descriptor->FindFieldByName("header");
+  if (!field || field->is_repeated() || !field->message_type() ||
+      field->message_type()->full_name() != "gz.msgs.Header")
+  {
+    return 0;
+  }
+  return field->number();
+}
+
+/////////////////////////////////////////////////
+bool TopicStats::Stamp(const char *_data, std::size_t _size,
+    int _headerField, double &_stamp)
+{
+  // gz.msgs.Header has the stamp as field 1, gz.msgs.Time has sec as
+  // field 1 and nsec as field 2
+  const auto *begin = reinterpret_cast<const std::uint8_t *>(_data);
+  const auto *end = begin + _size;
+  if (!FindMessage(begin, end, static_cast<std::uint64_t>(_headerField)) ||
+      !FindMessage(begin, end, 1))
+  {
+    return false;
+  }
+
+  std::int64_t sec{0};
+  std::int64_t nsec{0};
+  const std::uint8_t *it = begin;
+  while (it < end)
+  {
+    std::uint64_t tag{0};
+    std::uint64_t value{0};
+    if (!ReadVarint(it, end, tag) || (tag & 7) != 0 ||
+        !ReadVarint(it, end, value))
+    {
+      return false;
+    }
+    if ((tag >> 3) == 1)
+      sec = static_cast<std::int64_t>(value);
+    else if ((tag >> 3) == 2)
+      nsec = static_cast<std::int32_t>(value);
+  }
+  _stamp = static_cast<double>(sec) + static_cast<double>(nsec) * 1e-9;
+  return true;
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TOPICSTATS_HH_
+#define GZ_GUI_PLUGINS_TOPICSTATS_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef _WIN32
+#  define TopicStats_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TopicViewer_EXPORTS))
+#    define TopicStats_EXPORTS_API __declspec(dllexport)
+#  else
+#    define TopicStats_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Traffic of a topic, counted from its serialized msgs.
+  ///
+  /// Recording only adds to atomic counters, so it's cheap enough to run on
+  /// the transport threads for hundreds of topics. The counters are read
+  /// and reset by Take, about once per second.
+  class TopicStats_EXPORTS_API TopicStats
+  {
+    /// \brief Traffic since the previous sample
+    public: struct Sample
+    {
+      /// \brief Msgs per second
+      double rate{0.0};
+
+      /// \brief Bytes per second
+      double bandwidth{0.0};
+
+      /// \brief Mean msg size in bytes
+      double size{0.0};
+
+      /// \brief Mean time from the header stamp to the reception, in
+      /// seconds. Only meaningful if the stamps are wall clock times.
+      double latency{0.0};
+
+      /// \brief True if msgs with a header stamp were received
+      bool hasLatency{false};
+    };
+
+    /// \brief Constructor
+    /// \param[in] _headerField Number of the header field of the msg type,
+    /// 0 if it has none
+    /// \sa HeaderField
+    public: explicit TopicStats(int _headerField = 0);
+
+    /// \brief Count a msg. Safe to call from any thread.
+    /// \param[in] _data Serialized msg
+    /// \param[in] _size Size of the serialized msg
+    /// \param[in] _receiveTime Wall clock time of the reception, in seconds
+    public: void Record(const char *_data, std::size_t _size,
+        double _receiveTime);
+
+    /// \brief Get the traffic since the previous call, and start over
+    /// \param[in] _elapsed Seconds since the previous call
+    /// \return Traffic over that time
+    public: Sample Take(double _elapsed);
+
+    /// \brief Find the number of the gz.msgs.Header field of a msg type
+    /// \param[in] _msgType Full name of a generated msg type
+    /// \return Field number, 0 if there's no header or the type is unknown
+    public: static int HeaderField(const std::string &_msgType);
+
+    /// \brief Read the header stamp of a serialized msg without parsing it
+    /// \param[in] _data Serialized msg
+    /// \param[in] _size Size of the serialized msg
+    /// \param[in] _headerField Number of the header field
+    /// \param[out] _stamp Stamp in seconds
+    /// \return True if the msg has a stamp
+    public: static bool Stamp(const char *_data, std::size_t _size,
+        int _headerField, double &_stamp);
+
+    /// \brief Number of the header field, 0 if none
+    private: const int headerField;
+
+    /// \brief Msgs received
+    private: std::atomic<std::uint64_t> count{0};
+
+    /// \brief Bytes received
+    private: std::atomic<std::uint64_t> bytes{0};
+
+    /// \brief Sum of the latencies, in nanoseconds
+    private: std::atomic<std::int64_t> latencySum{0};
+
+    /// \brief Number of msgs with a stamp
+    private: std::atomic<std::uint64_t> stamped{0};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_TOPICSTATS_HH_
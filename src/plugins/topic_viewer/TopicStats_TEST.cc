@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <gz/msgs/int32.pb.h>
+#include <gz/msgs/time.pb.h>
+
+#include "TopicStats.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, HeaderField)
+{
+  EXPECT_EQ(1, TopicStats::HeaderField("gz.msgs.Int32"));
+  EXPECT_EQ(0, TopicStats::HeaderField("gz.msgs.Header"));
+  EXPECT_EQ(0, TopicStats::HeaderField("gz.msgs.NotAMsg"));
+}
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, Stamp)
+{
+  msgs::Int32 msg;
+  msg.set_data(-7);
+  std::string data;
+  msg.SerializeToString(&data);
+
+  double stamp{0.0};
+  EXPECT_FALSE(TopicStats::Stamp(data.data(), data.size(), 1, stamp));
+
+  msg.mutable_header()->mutable_stamp()->set_sec(5);
+  msg.mutable_header()->mutable_stamp()->set_nsec(250000000);
+  auto *entry = msg.mutable_header()->add_data();
+  entry->set_key("frame_id");
+  entry->add_value("world");
+  msg.SerializeToString(&data);
+
+  EXPECT_TRUE(TopicStats::Stamp(data.data(), data.size(), 1, stamp));
+  EXPECT_DOUBLE_EQ(5.25, stamp);
+
+  // Truncated msgs are rejected
+  EXPECT_FALSE(TopicStats::Stamp(data.data(), 3, 1, stamp));
+}
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, Take)
+{
+  msgs::Int32 msg;
+  msg.mutable_header()->mutable_stamp()->set_sec(100);
+  std::string data;
+  msg.SerializeToString(&data);
+
+  TopicStats stats(TopicStats::HeaderField("gz.msgs.Int32"));
+  for (int i = 0; i < 4; ++i)
+    stats.Record(data.data(), data.size(), 100.02);
+  stats.Record("", 0, 100.0);
+
+  auto sample = stats.Take(2.0);
+  EXPECT_DOUBLE_EQ(2.5, sample.rate);
+  EXPECT_DOUBLE_EQ(4.0 * data.size() / 2.0, sample.bandwidth);
+  EXPECT_DOUBLE_EQ(4.0 * data.size() / 5.0, sample.size);
+  EXPECT_TRUE(sample.hasLatency);
+  EXPECT_NEAR(0.02, sample.latency, 1e-6);
+
+  // Counters start over
+  sample = stats.Take(1.0);
+  EXPECT_DOUBLE_EQ(0.0, sample.rate);
+  EXPECT_DOUBLE_EQ(0.0, sample.size);
+  EXPECT_FALSE(sample.hasLatency);
+
+  // Without a header field, no latency
+  TopicStats unstamped;
+  unstamped.Record(data.data(), data.size(), 100.02);
+  sample = unstamped.Take(1.0);
+  EXPECT_DOUBLE_EQ(1.0, sample.rate);
+  EXPECT_FALSE(sample.hasLatency);
+}
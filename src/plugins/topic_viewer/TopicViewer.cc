@@ -18,21 +18,28 @@
 #include <QModelIndex>
 #include <QStandardItem>
 #include <QString>
+#include <QTimer>
 
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <gz/utils/ImplPtr.hh>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/gui/Application.hh>
+#include <gz/gui/SubscriptionHub.hh>
+#include <gz/gui/TopicRegistry.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/msgs/Factory.hh>
 #include <gz/transport/MessageInfo.hh>
 #include <gz/transport/Node.hh>
 #include <gz/transport/Publisher.hh>
 
+#include "TopicStats.hh"
 #include "TopicViewer.hh"
 
 namespace
@@ -42,12 +49,53 @@ constexpr const char * TYPE_KEY = "type";
 constexpr const char * TOPIC_KEY = "topic";
 constexpr const char * PATH_KEY = "path";
 constexpr const char * PLOT_KEY = "plottable";
+constexpr const char * STATS_KEY = "stats";
 
 constexpr uint8_t NAME_ROLE = 51;
 constexpr uint8_t TYPE_ROLE = 52;
 constexpr uint8_t TOPIC_ROLE = 53;
 constexpr uint8_t PATH_ROLE = 54;
 constexpr uint8_t PLOT_ROLE = 55;
+
+/// \brief True for msg items whose fields haven't been added yet
+constexpr uint8_t FETCH_ROLE = 56;
+
+constexpr uint8_t STATS_ROLE = 57;
+
+/// \brief Format a number of bytes
+/// \param[in] _bytes Bytes
+/// \return Such as "512 B" or "3.4 KB"
+QString FormatBytes(double _bytes)
+{
+  if (_bytes < 1e3)
+    return QString::number(_bytes, 'f', 0) + " B";
+  if (_bytes < 1e6)
+    return QString::number(_bytes / 1e3, 'f', 1) + " KB";
+  return QString::number(_bytes / 1e6, 'f', 1) + " MB";
+}
+
+/// \brief Format the traffic of a topic to show next to it
+/// \param[in] _sample Traffic
+/// \return Such as "10.0 Hz  3.4 KB/s  340 B  2.1 ms"
+QString FormatStats(const gz::gui::plugins::TopicStats::Sample &_sample)
+{
+  if (_sample.rate <= 0.0)
+    return "0 Hz";
+
+  QString text = QString::number(_sample.rate, 'f', 1) + " Hz  " +
+      FormatBytes(_sample.bandwidth) + "/s  " + FormatBytes(_sample.size);
+  if (_sample.hasLatency)
+    text += "  " + QString::number(_sample.latency * 1e3, 'f', 1) + " ms";
+  return text;
+}
+
+/// \brief Wall clock time
+/// \return Seconds since the epoch
+double WallTime()
+{
+  return std::chrono::duration<double>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
 }  // namespace
 
 namespace gz::gui::plugins
@@ -67,23 +115,80 @@ class TopicsModel : public QStandardItemModel
         {TOPIC_ROLE, TOPIC_KEY},
         {PATH_ROLE, PATH_KEY},
         {PLOT_ROLE, PLOT_KEY},
+        {STATS_ROLE, STATS_KEY},
     };
   }
+
+  // Documentation inherited
+  public: bool hasChildren(const QModelIndex &_parent) const override
+  {
+    if (this->canFetchMore(_parent))
+      return true;
+    return QStandardItemModel::hasChildren(_parent);
+  }
+
+  // Documentation inherited
+  public: bool canFetchMore(const QModelIndex &_parent) const override
+  {
+    return _parent.isValid() && _parent.data(FETCH_ROLE).toBool();
+  }
+
+  // Documentation inherited
+  public: void fetchMore(const QModelIndex &_parent) override
+  {
+    auto item = this->itemFromIndex(_parent);
+    if (!item || !item->data(FETCH_ROLE).toBool())
+      return;
+    item->setData(QVariant(false), FETCH_ROLE);
+    if (this->populate)
+      this->populate(item);
+  }
+
+  /// \brief Adds the fields of a msg item, the first time it's expanded
+  public: std::function<void(QStandardItem *)> populate;
 };
 
-class TopicViewer::Implementation
+/// \brief Field of a msg type, shared by all items of that type
+class FieldInfo
 {
-  /// \brief Node for Commincation
-  public: gz::transport::Node node;
+  /// \brief Field name
+  public: std::string name;
+
+  /// \brief Full name of the msg type for msg fields, type name otherwise
+  public: std::string type;
+
+  /// \brief True if the field is a msg with fields of its own
+  public: bool isMsg{false};
+
+  /// \brief True if the field can be plotted
+  public: bool plottable{false};
+};
 
+/// \brief Traffic of a topic whose row is shown
+class TopicWatch
+{
+  /// \brief Number of rows showing the topic
+  public: int views{0};
+
+  /// \brief Counters, shared with the subscription callback. Null while
+  /// the statistics aren't collected.
+  public: std::shared_ptr<TopicStats> stats;
+
+  /// \brief Subscription to the serialized msgs
+  public: HubSubscription subscription;
+};
+
+class TopicViewer::Implementation
+{
   /// \brief Model to create it from the available topics and messages
   public: TopicsModel *model {nullptr};
 
-  /// \brief Timer to update the model and keep track of its changes
-  public: QTimer *timer {nullptr};
+  /// \brief Item of each topic in the model, sorted like the rows
+  public: std::map<std::string, QStandardItem *> currentTopics;
 
-  /// \brief topic: msgType map to keep track of the model current topics
-  public: std::map<std::string, std::string> currentTopics;
+  /// \brief Fields of each msg type, so descriptors are only walked once
+  /// per type
+  public: std::map<std::string, std::vector<FieldInfo>> fieldsCache;
 
   /// \brief Create the fields model
   public: void CreateModel();
@@ -94,13 +199,15 @@ class TopicViewer::Implementation
   public: void AddTopic(const std::string &_topic,
                        const std::string &_msg);
 
-  /// \brief add a field/msg child to that parent item
-  /// \param[in] _parentItem a parent for the added field/msg
-  /// \param[in] _msgName the displayed name of the field/msg
-  /// \param[in] _msgType field/msg type
-  public: void AddField(QStandardItem *_parentItem,
-                     const std::string &_msgName,
-                     const std::string &_msgType);
+  /// \brief add the field/msg children of a msg item. Children of msg
+  /// fields are added when they're expanded.
+  /// \param[in] _msgItem a topic or msg item
+  public: void AddFields(QStandardItem *_msgItem);
+
+  /// \brief get the fields of a msg type, from the cache if possible
+  /// \param[in] _msgType full name of the msg type
+  /// \return fields which aren't repeated
+  public: const std::vector<FieldInfo> &Fields(const std::string &_msgType);
 
   /// \brief factory method for creating an item
   /// \param[in] _name the display name
@@ -142,6 +249,29 @@ class TopicViewer::Implementation
 
   /// \brief supported types for plotting
   public: std::vector<google::protobuf::FieldDescriptor::Type> plotableTypes;
+
+  /// \brief Start or stop collecting the statistics of a topic
+  /// \param[in] _topic Topic name
+  /// \param[in] _watch Its statistics
+  /// \param[in] _active True to collect them
+  public: void Collect(const std::string &_topic, TopicWatch &_watch,
+                       bool _active);
+
+  /// \brief Start or stop collecting the statistics of all watched topics
+  /// \param[in] _active True to collect them
+  public: void CollectAll(bool _active);
+
+  /// \brief True if topic statistics are shown
+  public: bool statistics{false};
+
+  /// \brief Statistics of the topics whose rows are shown
+  public: std::map<std::string, TopicWatch> watched;
+
+  /// \brief Updates the statistics every second
+  public: QTimer statsTimer;
+
+  /// \brief Time of the previous statistics update
+  public: std::chrono::steady_clock::time_point lastUpdate;
 };
 
 TopicViewer::TopicViewer()
@@ -161,19 +291,37 @@ TopicViewer::TopicViewer()
   gui::App()->Engine()->rootContext()->setContextProperty(
                 "TopicsModel", this->dataPtr->model);
 
-  this->dataPtr->timer = new QTimer();
-  connect(this->dataPtr->timer, SIGNAL(timeout()), this, SLOT(UpdateModel()));
-  this->dataPtr->timer->start(1000);
+  // Only update when topics come and go
+  connect(App()->Topics(), &TopicRegistry::TopicsChanged, this,
+      &TopicViewer::UpdateModel);
+
+  this->dataPtr->statsTimer.setInterval(1000);
+  connect(&this->dataPtr->statsTimer, &QTimer::timeout, this,
+      &TopicViewer::UpdateStatistics);
+
+  // Nothing is counted while nothing can be seen
+  connect(this, &Plugin::SuspendedChanged, this, [this]()
+  {
+    this->SetStatistics(this->dataPtr->statistics);
+  });
 }
 
 //////////////////////////////////////////////////
 TopicViewer::~TopicViewer() = default;
 
 //////////////////////////////////////////////////
-void TopicViewer::LoadConfig(const tinyxml2::XMLElement *)
+void TopicViewer::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Topic Viewer";
+
+  if (!_pluginElem)
+    return;
+
+  bool statistics{false};
+  if (auto elem = _pluginElem->FirstChildElement("statistics"))
+    elem->QueryBoolText(&statistics);
+  this->SetStatistics(statistics);
 }
 
 //////////////////////////////////////////////////
@@ -186,20 +334,18 @@ QStandardItemModel *TopicViewer::Model()
 void TopicViewer::Implementation::CreateModel()
 {
   this->model = new TopicsModel();
+  this->model->populate = [this](QStandardItem *_item)
+  {
+    this->AddFields(_item);
+  };
 
-  std::vector<std::string> topics;
-  this->node.TopicList(topics);
-
-  for (unsigned int i = 0; i < topics.size(); ++i)
+  auto registry = App()->Topics();
+  registry->Scan();
+  for (const auto &topic : registry->Topics())
   {
-    std::vector<transport::MessagePublisher> publishers;
-    std::vector<transport::MessagePublisher> subscribers;
-    this->node.TopicInfo(topics[i], publishers, subscribers);
-    if (!publishers.empty())
-    {
-      std::string msgType = publishers[0].MsgTypeName();
-      this->AddTopic(topics[i], msgType);
-    }
+    auto msgTypes = registry->MsgTypes(topic);
+    if (!msgTypes.empty())
+      this->AddTopic(topic, msgTypes[0]);
   }
 }
 
@@ -208,48 +354,81 @@ void TopicViewer::Implementation::AddTopic(const std::string &_topic,
                            const std::string &_msg)
 {
   QStandardItem *topicItem = this->FactoryItem(_topic, _msg);
-  topicItem->setWhatsThis("Topic");
-  QStandardItem *parent = this->model->invisibleRootItem();
-  parent->appendRow(topicItem);
+  topicItem->setData(QVariant(true), FETCH_ROLE);
 
-  this->AddField(topicItem , _msg, _msg);
+  // keep rows sorted by topic
+  QStandardItem *parent = this->model->invisibleRootItem();
+  auto next = this->currentTopics.upper_bound(_topic);
+  if (next == this->currentTopics.end())
+    parent->appendRow(topicItem);
+  else
+    parent->insertRow(next->second->row(), topicItem);
 
   // store the topics to keep track of them
-  this->currentTopics[_topic] = _msg;
+  this->currentTopics[_topic] = topicItem;
 }
 
 //////////////////////////////////////////////////
-void TopicViewer::Implementation::AddField(QStandardItem *_parentItem,
-                           const std::string &_msgName,
-                           const std::string &_msgType)
+void TopicViewer::Implementation::AddFields(QStandardItem *_msgItem)
 {
-  QStandardItem *msgItem;
-
-  // check if it is a topic, to skip the extra level of the topic Msg
-  if (_parentItem->whatsThis() == "Topic")
+  const std::string msgType =
+      _msgItem->data(TYPE_ROLE).toString().toStdString();
+
+  const auto &fields = this->Fields(msgType);
+  QList<QStandardItem *> items;
+  for (const auto &field : fields)
+    items.append(this->FactoryItem(field.name, field.type));
+  _msgItem->appendRows(items);
+
+  // paths and topics are found from the parents, so set them once the
+  // items are in the tree
+  for (int i = 0; i < items.size(); ++i)
   {
-    msgItem = _parentItem;
-    // make it different, so next iteration will make a new msg item
-    msgItem->setWhatsThis("Msg");
-  }
-  else
-  {
-    msgItem = this->FactoryItem(_msgName, _msgType);
-    _parentItem->appendRow(msgItem);
+    if (fields[i].isMsg)
+    {
+      items[i]->setData(QVariant(true), FETCH_ROLE);
+      continue;
+    }
+
+    this->SetItemPath(items[i]);
+    this->SetItemTopic(items[i]);
+
+    // to make the plottable items draggable
+    if (fields[i].plottable)
+      items[i]->setData(QVariant(true), PLOT_ROLE);
   }
+}
+
+//////////////////////////////////////////////////
+const std::vector<FieldInfo> &TopicViewer::Implementation::Fields(
+    const std::string &_msgType)
+{
+  auto cached = this->fieldsCache.find(_msgType);
+  if (cached != this->fieldsCache.end())
+    return cached->second;
 
-  auto msg = msgs::Factory::New(_msgType);
-  if (!msg)
+  auto &fields = this->fieldsCache[_msgType];
+
+  // Compiled msgs are found without creating a msg, others through the
+  // factory
+  auto msgDescriptor = google::protobuf::DescriptorPool::generated_pool()->
+      FindMessageTypeByName(_msgType);
+  std::unique_ptr<google::protobuf::Message> msg;
+  if (!msgDescriptor)
   {
+    msg = msgs::Factory::New(_msgType);
+    if (!msg)
+    {
       gzwarn << "Null Msg: " << _msgType << std::endl;
-      return;
+      return fields;
+    }
+    msgDescriptor = msg->GetDescriptor();
   }
 
-  auto msgDescriptor = msg->GetDescriptor();
   if (!msgDescriptor)
   {
     gzwarn << "Null Descriptor of Msg: " << _msgType << std::endl;
-    return;
+    return fields;
   }
 
   for (int i = 0 ; i < msgDescriptor->field_count(); ++i)
@@ -259,25 +438,22 @@ void TopicViewer::Implementation::AddField(QStandardItem *_parentItem,
     if (msgField->is_repeated())
       continue;
 
+    FieldInfo field;
+    field.name = msgField->name();
     auto messageType = msgField->message_type();
-
     if (messageType)
-      this->AddField(msgItem, msgField->name(), messageType->full_name());
-
+    {
+      field.type = messageType->full_name();
+      field.isMsg = true;
+    }
     else
     {
-      auto msgFieldItem = this->FactoryItem(msgField->name(),
-                                            msgField->type_name());
-      msgItem->appendRow(msgFieldItem);
-
-      this->SetItemPath(msgFieldItem);
-      this->SetItemTopic(msgFieldItem);
-
-      // to make the plottable items draggable
-      if (this->IsPlotable(msgField->type()))
-        msgFieldItem->setData(QVariant(true), PLOT_ROLE);
+      field.type = msgField->type_name();
+      field.plottable = this->IsPlotable(msgField->type());
     }
+    fields.push_back(field);
   }
+  return fields;
 }
 
 //////////////////////////////////////////////////
@@ -299,6 +475,7 @@ QStandardItem *TopicViewer::Implementation::FactoryItem(
   item->setData(QVariant(path), PATH_ROLE);
   item->setData(QVariant(topic), TOPIC_ROLE);
   item->setData(QVariant(false), PLOT_ROLE);
+  item->setData(QVariant(QString()), STATS_ROLE);
 
   return item;
 }
@@ -372,65 +549,157 @@ bool TopicViewer::Implementation::IsPlotable(
 /////////////////////////////////////////////////
 void TopicViewer::UpdateModel()
 {
-  // get the current topics in the network
-  std::vector<std::string> topics;
-  this->dataPtr->node.TopicList(topics);
-
-  // initialize the topics with the old topics & remove every matched topic
-  // when you finish advertised topics the remaining topics will be removed
-  std::map<std::string, std::string> topicsToRemove =
-          this->dataPtr->currentTopics;
-
-  for (unsigned int i = 0; i < topics.size(); ++i)
+  // get the current topics in the network, which the registry keeps up to
+  // date in the background
+  auto registry = App()->Topics();
+  std::map<std::string, std::string> topics;
+  for (const auto &topic : registry->Topics())
   {
-    // get the msg type
-    std::vector<transport::MessagePublisher> publishers;
-    std::vector<transport::MessagePublisher> subscribers;
-    this->dataPtr->node.TopicInfo(topics[i], publishers, subscribers);
+    // ToDo: Go over all the publishers and also consider subscribers.
+    auto msgTypes = registry->MsgTypes(topic);
+    if (!msgTypes.empty())
+      topics[topic] = msgTypes[0];
+  }
 
-    if (publishers.empty())
+  // remove the topics that don't exist in the network anymore, or changed
+  // their msg type
+  auto *root = this->dataPtr->model->invisibleRootItem();
+  for (auto it = this->dataPtr->currentTopics.begin();
+       it != this->dataPtr->currentTopics.end();)
+  {
+    auto topic = topics.find(it->first);
+    if (topic != topics.end() &&
+        it->second->data(TYPE_ROLE).toString().toStdString() ==
+        topic->second)
+    {
+      ++it;
       continue;
+    }
 
-    // ToDo: Go over all the publishers and also consider subscribers.
-    // Review the way we're using "topicsToRemove" as the logic doesn't look
-    // very clear to me.
-
-    std::string msgType = publishers[0].MsgTypeName();
+    root->removeRow(it->second->row());
+    it = this->dataPtr->currentTopics.erase(it);
+  }
 
-    // skip the matched topics
-    if (this->dataPtr->currentTopics.count(topics[i]) &&
-        this->dataPtr->currentTopics[topics[i]] == msgType)
+  // only new topics are added, existing rows are left untouched
+  for (const auto &[topic, msgType] : topics)
+  {
+    if (this->dataPtr->currentTopics.find(topic) ==
+        this->dataPtr->currentTopics.end())
     {
-      topicsToRemove.erase(topics[i]);
-      continue;
+      this->dataPtr->AddTopic(topic, msgType);
     }
+  }
+}
 
-    // new topic
-    this->dataPtr->AddTopic(topics[i], msgType);
+/////////////////////////////////////////////////
+bool TopicViewer::Statistics() const
+{
+  return this->dataPtr->statistics;
+}
+
+/////////////////////////////////////////////////
+void TopicViewer::SetStatistics(bool _statistics)
+{
+  const bool changed = _statistics != this->dataPtr->statistics;
+  this->dataPtr->statistics = _statistics;
+
+  const bool active = _statistics && !this->Suspended();
+  this->dataPtr->CollectAll(active);
+  if (active && !this->dataPtr->statsTimer.isActive())
+  {
+    this->dataPtr->lastUpdate = std::chrono::steady_clock::now();
+    this->dataPtr->statsTimer.start();
+  }
+  else if (!active)
+  {
+    this->dataPtr->statsTimer.stop();
   }
 
-  // remove the topics that don't exist in the network
-  for (const auto &topic : topicsToRemove)
+  if (changed)
+    emit this->StatisticsChanged();
+}
+
+/////////////////////////////////////////////////
+void TopicViewer::WatchTopic(const QString &_topic)
+{
+  const auto topic = _topic.toStdString();
+  auto &watch = this->dataPtr->watched[topic];
+  if (++watch.views == 1)
   {
-    auto *root = this->dataPtr->model->invisibleRootItem();
+    this->dataPtr->Collect(topic, watch,
+        this->dataPtr->statistics && !this->Suspended());
+  }
+}
 
-    // search for the topic in the model
-    for (int i = 0; i < root->rowCount(); ++i)
-    {
-      auto *child = root->child(i);
+/////////////////////////////////////////////////
+void TopicViewer::UnwatchTopic(const QString &_topic)
+{
+  auto it = this->dataPtr->watched.find(_topic.toStdString());
+  if (it == this->dataPtr->watched.end() || --it->second.views > 0)
+    return;
 
-      if (child->data(NAME_ROLE).toString().toStdString() == topic.first &&
-          child->data(TYPE_ROLE).toString().toStdString() == topic.second)
-      {
-        // remove from model
-        root->removeRow(i);
-        // remove from topics as it is a dangling topic
-        this->dataPtr->currentTopics.erase(topic.first);
-        break;
-      }
+  this->dataPtr->Collect(it->first, it->second, false);
+  this->dataPtr->watched.erase(it);
+}
+
+/////////////////////////////////////////////////
+void TopicViewer::UpdateStatistics()
+{
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsed = std::chrono::duration<double>(
+      now - this->dataPtr->lastUpdate).count();
+  this->dataPtr->lastUpdate = now;
+
+  for (auto &[topic, watch] : this->dataPtr->watched)
+  {
+    if (!watch.stats)
+      continue;
+    const auto text = FormatStats(watch.stats->Take(elapsed));
+    auto item = this->dataPtr->currentTopics.find(topic);
+    if (item != this->dataPtr->currentTopics.end() &&
+        item->second->data(STATS_ROLE).toString() != text)
+    {
+      item->second->setData(QVariant(text), STATS_ROLE);
     }
   }
 }
+
+/////////////////////////////////////////////////
+void TopicViewer::Implementation::Collect(const std::string &_topic,
+    TopicWatch &_watch, bool _active)
+{
+  auto item = this->currentTopics.find(_topic);
+  if (!_active)
+  {
+    _watch.subscription.Reset();
+    _watch.stats.reset();
+    if (item != this->currentTopics.end())
+      item->second->setData(QVariant(QString()), STATS_ROLE);
+    return;
+  }
+
+  if (_watch.stats)
+    return;
+
+  std::string msgType;
+  if (item != this->currentTopics.end())
+    msgType = item->second->data(TYPE_ROLE).toString().toStdString();
+
+  auto stats = std::make_shared<TopicStats>(TopicStats::HeaderField(msgType));
+  _watch.subscription = App()->Subscriptions()->SubscribeRaw(_topic,
+      [stats](const char *_data, std::size_t _size, const std::string &)
+      {
+        stats->Record(_data, _size, WallTime());
+      });
+  _watch.stats = stats;
+}
+
+/////////////////////////////////////////////////
+void TopicViewer::Implementation::CollectAll(bool _active)
+{
+  for (auto &[topic, watch] : this->watched)
+    this->Collect(topic, watch, _active);
+}
 }  // namespace gz::gui::plugins
 
 // Register this plugin
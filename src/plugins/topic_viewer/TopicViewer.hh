@@ -39,10 +39,28 @@ namespace gz::gui::plugins
 
   /// \brief a Plugin to view the topics and their msgs & fields
   /// Field's informations can be passed by dragging them via the UI
+  ///
+  /// ## Configuration
+  ///
+  /// * \<statistics\> : If true, the rate, bandwidth, mean msg size and
+  ///                    header stamp to reception latency of each topic
+  ///                    are shown next to it, updated every second. Only
+  ///                    the topics whose rows are shown are subscribed to,
+  ///                    as serialized msgs which are counted but never
+  ///                    parsed, and none while the card is suspended.
+  ///                    Optional, defaults to false.
   class TopicViewer_EXPORTS_API TopicViewer : public Plugin
   {
     Q_OBJECT
 
+    /// \brief Whether topic statistics are shown
+    Q_PROPERTY(
+      bool statistics
+      READ Statistics
+      WRITE SetStatistics
+      NOTIFY StatisticsChanged
+    )
+
     /// \brief Constructor
     public: TopicViewer();
 
@@ -59,6 +77,29 @@ namespace gz::gui::plugins
     /// \brief update the model according to the changes of the topics
     public slots: void UpdateModel();
 
+    /// \brief Get whether topic statistics are shown
+    /// \return True if shown
+    public: Q_INVOKABLE bool Statistics() const;
+
+    /// \brief Show or hide topic statistics
+    /// \param[in] _statistics True to show them
+    public: Q_INVOKABLE void SetStatistics(bool _statistics);
+
+    /// \brief Notify that topic statistics were shown or hidden
+    signals: void StatisticsChanged();
+
+    /// \brief Called by QML when the row of a topic is shown, so its
+    /// statistics are collected. Calls are counted.
+    /// \param[in] _topic Topic name
+    public: Q_INVOKABLE void WatchTopic(const QString &_topic);
+
+    /// \brief Called by QML when the row of a topic isn't shown anymore
+    /// \param[in] _topic Topic name
+    public: Q_INVOKABLE void UnwatchTopic(const QString &_topic);
+
+    /// \brief Update the statistics of the watched topics
+    private slots: void UpdateStatistics();
+
     /// \brief Pointer to private data.
     private: GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
   };
@@ -89,6 +89,29 @@ TreeView {
         Drag.hotSpot.x: 0
         Drag.hotSpot.y: itemHeight
 
+        // topic of the row, watched for its statistics while the row exists
+        readonly property string rowTopic: (model === null ||
+            styleData.depth !== 0) ? "" : model.name
+        property string watchedTopic: ""
+
+        function updateWatch()
+        {
+          if (rowTopic === watchedTopic)
+            return;
+          if (watchedTopic !== "")
+            TopicViewer.UnwatchTopic(watchedTopic);
+          watchedTopic = rowTopic;
+          if (watchedTopic !== "")
+            TopicViewer.WatchTopic(watchedTopic);
+        }
+
+        onRowTopicChanged: updateWatch()
+        Component.onCompleted: updateWatch()
+        Component.onDestruction: {
+          if (watchedTopic !== "")
+            TopicViewer.UnwatchTopic(watchedTopic);
+        }
+
         // used by DropArea that accepts the dragged items
         function itemData ()
         {
@@ -164,11 +187,22 @@ TreeView {
             font.pointSize: 12
             anchors.leftMargin: 5
             anchors.left: icon.right
-            anchors.right: parent.right
+            anchors.right: statsText.left
             elide: Text.ElideMiddle
             y: icon.y
         }
 
+        Text {
+            id: statsText
+            text: (model === null || !TopicViewer.statistics ||
+                   model.stats === undefined) ? "" : model.stats
+            color: field.color
+            font.pointSize: 10
+            anchors.right: parent.right
+            anchors.rightMargin: 5
+            anchors.verticalCenter: field.verticalCenter
+        }
+
         ToolTip {
             id: tool_tip
             delay: 200
@@ -27,6 +27,7 @@
 #include "gz/gui/Application.hh"
 #include "gz/gui/Plugin.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/TopicRegistry.hh"
 #include "TopicViewer.hh"
 
 #define NAME_ROLE 51
@@ -149,11 +150,21 @@ TEST(TopicViewerTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
             foundCollision = true;
 
             EXPECT_EQ(child->data(TYPE_ROLE), "gz.msgs.Collision");
+
+            // fields are only added when expanded
+            EXPECT_EQ(child->rowCount(), 0);
+            EXPECT_TRUE(model->hasChildren(child->index()));
+            ASSERT_TRUE(model->canFetchMore(child->index()));
+            model->fetchMore(child->index());
+            EXPECT_FALSE(model->canFetchMore(child->index()));
             EXPECT_EQ(child->rowCount(), 8);
 
             auto pose = child->child(5);
+            model->fetchMore(pose->index());
             auto position = pose->child(3);
+            model->fetchMore(position->index());
             auto x = position->child(1);
+            ASSERT_NE(nullptr, x);
 
             EXPECT_EQ(x->data(NAME_ROLE), "x");
             EXPECT_EQ(x->data(TYPE_ROLE), "double");
@@ -166,6 +177,7 @@ TEST(TopicViewerTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
             foundInt = true;
 
             EXPECT_EQ(child->data(TYPE_ROLE), "gz.msgs.Int32");
+            model->fetchMore(child->index());
             EXPECT_EQ(child->rowCount(), 2);
 
             auto data = child->child(1);
@@ -194,11 +206,26 @@ TEST(TopicViewerTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
 
     pubEcho.Publish(msgEcho);
     // Remove
-    node.Unsubscribe("/int_topic");
-    // wait for update timeout
-    std::this_thread::sleep_for(std::chrono::milliseconds(700));
+    pubInt = transport::Node::Publisher();
 
+    // wait for the topic registry to notice
+    int sleep = 0;
+    int maxSleep = 30;
     root = plugin->Model()->invisibleRootItem();
+    while ((root->rowCount() != 2 ||
+        root->child(0)->data(NAME_ROLE) != "/collision_topic") &&
+        sleep < maxSleep)
+    {
+      App()->Topics()->Scan();
+      QCoreApplication::processEvents();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      ++sleep;
+    }
 
-    EXPECT_EQ(root->rowCount(), 2);
+    // rows are sorted and the expanded topic was kept
+    ASSERT_EQ(root->rowCount(), 2);
+    EXPECT_EQ(root->child(0)->data(NAME_ROLE), "/collision_topic");
+    EXPECT_EQ(root->child(0)->rowCount(), 8);
+    EXPECT_EQ(root->child(1)->data(NAME_ROLE), "/echo_topic");
+    EXPECT_EQ(root->child(1)->rowCount(), 0);
 }
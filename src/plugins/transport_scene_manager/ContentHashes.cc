@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <functional>
+#include <string>
+
+#include "ContentHashes.hh"
+
+namespace gz::gui::plugins
+{
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Clear the poses which move at runtime from a model, its links
+/// and its nested models
+/// \param[in, out] _msg Model msg
+void clearPoses(msgs::Model &_msg)
+{
+  _msg.clear_header();
+  _msg.clear_pose();
+  for (auto &link : *_msg.mutable_link())
+  {
+    link.clear_header();
+    link.clear_pose();
+  }
+  for (auto &model : *_msg.mutable_model())
+    clearPoses(model);
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+std::size_t ContentHashes::Hash(const msgs::Model &_msg)
+{
+  msgs::Model msg = _msg;
+  clearPoses(msg);
+  return std::hash<std::string>()(msg.SerializeAsString());
+}
+
+/////////////////////////////////////////////////
+std::size_t ContentHashes::Hash(const msgs::Light &_msg)
+{
+  msgs::Light msg = _msg;
+  msg.clear_header();
+  msg.clear_pose();
+  return std::hash<std::string>()(msg.SerializeAsString());
+}
+
+/////////////////////////////////////////////////
+ContentHashes::Change ContentHashes::Update(unsigned int _id,
+    std::size_t _hash)
+{
+  auto [it, inserted] = this->hashes.try_emplace(_id, _hash);
+  if (inserted)
+    return Change::ADDED;
+  if (it->second == _hash)
+    return Change::UNCHANGED;
+  it->second = _hash;
+  return Change::MODIFIED;
+}
+
+/////////////////////////////////////////////////
+void ContentHashes::Erase(unsigned int _id)
+{
+  this->hashes.erase(_id);
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_CONTENTHASHES_HH_
+#define GZ_GUI_PLUGINS_CONTENTHASHES_HH_
+
+#include <cstddef>
+#include <unordered_map>
+
+#include <gz/msgs/light.pb.h>
+#include <gz/msgs/model.pb.h>
+
+#ifndef _WIN32
+#  define ContentHashes_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define ContentHashes_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ContentHashes_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Content hash of each top level model and light received, used
+  /// to skip the ones which didn't change when the scene is published
+  /// again.
+  ///
+  /// Poses are kept up to date through the pose topics, so they aren't
+  /// part of the content: neither the pose of the model or light, nor those
+  /// of links and nested models, which move with the joints. Headers are
+  /// left out too. Poses of visuals and lights within their link are kept.
+  ///
+  /// Not thread safe.
+  class ContentHashes_EXPORTS_API ContentHashes
+  {
+    /// \brief How an entity changed since it was last received
+    public: enum class Change
+    {
+      /// \brief Not received before, or erased since
+      ADDED,
+
+      /// \brief Received before with different content
+      MODIFIED,
+
+      /// \brief Received before with the same content
+      UNCHANGED
+    };
+
+    /// \brief Hash the content of a model
+    /// \param[in] _msg Model msg
+    /// \return Content hash
+    public: static std::size_t Hash(const msgs::Model &_msg);
+
+    /// \brief Hash the content of a light
+    /// \param[in] _msg Light msg
+    /// \return Content hash
+    public: static std::size_t Hash(const msgs::Light &_msg);
+
+    /// \brief Record the content hash of an entity received
+    /// \param[in] _id Entity id
+    /// \param[in] _hash Content hash, see Hash
+    /// \return How the entity changed since it was last received
+    public: Change Update(unsigned int _id, std::size_t _hash);
+
+    /// \brief Forget an entity, so it's added again the next time it's
+    /// received
+    /// \param[in] _id Entity id
+    public: void Erase(unsigned int _id);
+
+    /// \brief Content hash by entity id
+    private: std::unordered_map<unsigned int, std::size_t> hashes;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_CONTENTHASHES_HH_
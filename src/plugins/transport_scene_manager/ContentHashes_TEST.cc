@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/msgs/scene.pb.h>
+#include <gz/msgs/Utility.hh>
+
+#include "ContentHashes.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Articulated model with a nested model, like a robot with an arm
+/// \return Scene with the model and a light
+msgs::Scene articulatedScene()
+{
+  msgs::Scene scene;
+  auto *model = scene.add_model();
+  model->set_id(1);
+  model->set_name("robot");
+  msgs::Set(model->mutable_pose(), math::Pose3d(1, 2, 0, 0, 0, 0));
+
+  auto *link = model->add_link();
+  link->set_id(2);
+  link->set_name("base");
+  auto *visual = link->add_visual();
+  visual->set_id(3);
+  msgs::Set(visual->mutable_pose(), math::Pose3d(0, 0, 0.1, 0, 0, 0));
+  msgs::Set(visual->mutable_geometry()->mutable_box()->mutable_size(),
+      math::Vector3d(1, 1, 0.2));
+
+  auto *arm = model->add_model();
+  arm->set_id(4);
+  arm->set_name("arm");
+  auto *armLink = arm->add_link();
+  armLink->set_id(5);
+  armLink->set_name("forearm");
+  msgs::Set(armLink->mutable_pose(), math::Pose3d(0, 0, 0.5, 0, 0, 0));
+
+  auto *light = scene.add_light();
+  light->set_id(6);
+  light->set_name("sun");
+  msgs::Set(light->mutable_pose(), math::Pose3d(0, 0, 10, 0, 0, 0));
+  return scene;
+}
+
+/// \brief Record the entities of a scene, as the manager does when it
+/// receives one
+/// \param[in] _hashes Hashes of the entities received so far
+/// \param[in] _scene Scene received
+/// \return Number of models and lights which would be loaded
+int queue(ContentHashes &_hashes, const msgs::Scene &_scene)
+{
+  int tasks{0};
+  for (const auto &model : _scene.model())
+  {
+    if (_hashes.Update(model.id(), ContentHashes::Hash(model)) !=
+        ContentHashes::Change::UNCHANGED)
+    {
+      ++tasks;
+    }
+  }
+  for (const auto &light : _scene.light())
+  {
+    if (_hashes.Update(light.id(), ContentHashes::Hash(light)) !=
+        ContentHashes::Change::UNCHANGED)
+    {
+      ++tasks;
+    }
+  }
+  return tasks;
+}
+
+/////////////////////////////////////////////////
+TEST(ContentHashesTest, Update)
+{
+  ContentHashes hashes;
+  EXPECT_EQ(ContentHashes::Change::ADDED, hashes.Update(1, 10));
+  EXPECT_EQ(ContentHashes::Change::UNCHANGED, hashes.Update(1, 10));
+  EXPECT_EQ(ContentHashes::Change::MODIFIED, hashes.Update(1, 11));
+  EXPECT_EQ(ContentHashes::Change::UNCHANGED, hashes.Update(1, 11));
+
+  hashes.Erase(1);
+  EXPECT_EQ(ContentHashes::Change::ADDED, hashes.Update(1, 11));
+}
+
+/////////////////////////////////////////////////
+TEST(ContentHashesTest, SameScene)
+{
+  ContentHashes hashes;
+  auto scene = articulatedScene();
+  EXPECT_EQ(2, queue(hashes, scene));
+  EXPECT_EQ(0, queue(hashes, scene));
+}
+
+/////////////////////////////////////////////////
+TEST(ContentHashesTest, MovedLinks)
+{
+  ContentHashes hashes;
+  auto scene = articulatedScene();
+  EXPECT_EQ(2, queue(hashes, scene));
+
+  // Joints moved the links and the nested model, and the whole robot moved
+  auto *model = scene.mutable_model(0);
+  msgs::Set(model->mutable_pose(), math::Pose3d(5, 2, 0, 0, 0, 1));
+  msgs::Set(model->mutable_link(0)->mutable_pose(),
+      math::Pose3d(0, 0, 0, 0, 0, 0.3));
+  auto *arm = model->mutable_model(0);
+  msgs::Set(arm->mutable_pose(), math::Pose3d(0.2, 0, 0, 0, 0.5, 0));
+  msgs::Set(arm->mutable_link(0)->mutable_pose(),
+      math::Pose3d(0, 0, 0.5, 0.7, 0, 0));
+  model->mutable_header()->mutable_stamp()->set_sec(42);
+  msgs::Set(scene.mutable_light(0)->mutable_pose(),
+      math::Pose3d(0, 0, 20, 0, 0, 0));
+  EXPECT_EQ(0, queue(hashes, scene));
+}
+
+/////////////////////////////////////////////////
+TEST(ContentHashesTest, ModifiedContent)
+{
+  ContentHashes hashes;
+  auto scene = articulatedScene();
+  EXPECT_EQ(2, queue(hashes, scene));
+
+  // Visual poses within their link are content
+  auto *visual = scene.mutable_model(0)->mutable_link(0)->mutable_visual(0);
+  msgs::Set(visual->mutable_pose(), math::Pose3d(0, 0, 0.3, 0, 0, 0));
+  EXPECT_EQ(1, queue(hashes, scene));
+
+  visual->mutable_geometry()->mutable_box()->mutable_size()->set_z(0.4);
+  EXPECT_EQ(1, queue(hashes, scene));
+
+  scene.mutable_model(0)->mutable_model(0)->mutable_link(0)->set_name("arm");
+  EXPECT_EQ(1, queue(hashes, scene));
+
+  scene.mutable_light(0)->set_range(50);
+  EXPECT_EQ(1, queue(hashes, scene));
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <utility>
+
+#include "CullingBvh.hh"
+
+namespace gz::gui::plugins
+{
+namespace
+{
+/// \brief Most items in a leaf
+constexpr std::size_t kLeafSize{4};
+
+/// \brief Where a box is relative to a frustum
+enum class Side
+{
+  /// \brief Entirely outside at least one plane
+  kOutside,
+
+  /// \brief Crossing at least one plane
+  kCrossing,
+
+  /// \brief Entirely inside all planes
+  kInside
+};
+
+/////////////////////////////////////////////////
+/// \brief Find where a box is relative to a frustum
+/// \param[in] _planes Planes of the frustum
+/// \param[in] _min Minimum corner of the box
+/// \param[in] _max Maximum corner of the box
+/// \return Side
+Side side(const std::vector<CullPlane> &_planes, const math::Vector3d &_min,
+    const math::Vector3d &_max)
+{
+  Side result{Side::kInside};
+  for (const auto &plane : _planes)
+  {
+    // Corners furthest along and against the normal
+    math::Vector3d far;
+    math::Vector3d near;
+    for (int i = 0; i < 3; ++i)
+    {
+      const bool positive = plane.normal[i] >= 0.0;
+      far[i] = positive ? _max[i] : _min[i];
+      near[i] = positive ? _min[i] : _max[i];
+    }
+    if (plane.normal.Dot(far) + plane.offset < 0.0)
+      return Side::kOutside;
+    if (plane.normal.Dot(near) + plane.offset < 0.0)
+      result = Side::kCrossing;
+  }
+  return result;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+void CullingBvh::Build(std::vector<Item> _items)
+{
+  this->items = std::move(_items);
+  this->leaves.assign(this->items.size(), 0);
+  this->nodes.clear();
+  this->index.clear();
+  if (this->items.empty())
+    return;
+
+  this->nodes.reserve(2 * this->items.size() / kLeafSize + 1);
+  this->nodes.emplace_back();
+  this->Build(0, 0, this->items.size());
+
+  this->index.reserve(this->items.size());
+  for (std::size_t i = 0; i < this->items.size(); ++i)
+    this->index[this->items[i].id] = i;
+}
+
+/////////////////////////////////////////////////
+void CullingBvh::Build(std::size_t _node, std::size_t _first,
+    std::size_t _count)
+{
+  this->nodes[_node].first = _first;
+  this->nodes[_node].count = _count;
+  if (_count <= kLeafSize)
+  {
+    for (std::size_t i = _first; i < _first + _count; ++i)
+      this->leaves[i] = _node;
+    this->Fit(_node);
+    return;
+  }
+
+  // Split at the median of the centers along the longest axis of their
+  // bounds
+  auto center = [](const Item &_item, int _axis)
+  {
+    return _item.min[_axis] + _item.max[_axis];
+  };
+  math::Vector3d lo = this->items[_first].min + this->items[_first].max;
+  math::Vector3d hi = lo;
+  for (std::size_t i = _first + 1; i < _first + _count; ++i)
+  {
+    const math::Vector3d c = this->items[i].min + this->items[i].max;
+    lo.Min(c);
+    hi.Max(c);
+  }
+  const math::Vector3d extent = hi - lo;
+  int axis = 0;
+  if (extent[1] > extent[axis])
+    axis = 1;
+  if (extent[2] > extent[axis])
+    axis = 2;
+
+  const std::size_t half = _count / 2;
+  auto begin = this->items.begin() + static_cast<std::ptrdiff_t>(_first);
+  std::nth_element(begin, begin + static_cast<std::ptrdiff_t>(half),
+      begin + static_cast<std::ptrdiff_t>(_count),
+      [&](const Item &_a, const Item &_b)
+      {
+        return center(_a, axis) < center(_b, axis);
+      });
+
+  const std::size_t child = this->nodes.size();
+  this->nodes[_node].child = child;
+  this->nodes.emplace_back();
+  this->nodes.emplace_back();
+  this->nodes[child].parent = _node;
+  this->nodes[child + 1].parent = _node;
+  this->Build(child, _first, half);
+  this->Build(child + 1, _first + half, _count - half);
+  this->Fit(_node);
+}
+
+/////////////////////////////////////////////////
+void CullingBvh::Fit(std::size_t _node)
+{
+  auto &node = this->nodes[_node];
+  if (0 != node.child)
+  {
+    const auto &a = this->nodes[node.child];
+    const auto &b = this->nodes[node.child + 1];
+    node.min = a.min;
+    node.min.Min(b.min);
+    node.max = a.max;
+    node.max.Max(b.max);
+    return;
+  }
+
+  node.min = this->items[node.first].min;
+  node.max = this->items[node.first].max;
+  for (std::size_t i = node.first + 1; i < node.first + node.count; ++i)
+  {
+    node.min.Min(this->items[i].min);
+    node.max.Max(this->items[i].max);
+  }
+}
+
+/////////////////////////////////////////////////
+bool CullingBvh::Update(std::size_t _id, const math::Vector3d &_min,
+    const math::Vector3d &_max)
+{
+  auto it = this->index.find(_id);
+  if (it == this->index.end())
+    return false;
+
+  auto &item = this->items[it->second];
+  item.min = _min;
+  item.max = _max;
+
+  std::size_t node = this->leaves[it->second];
+  while (true)
+  {
+    this->Fit(node);
+    if (0 == node)
+      break;
+    node = this->nodes[node].parent;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t CullingBvh::Query(const std::vector<CullPlane> &_planes,
+    std::vector<std::size_t> &_visible) const
+{
+  if (this->nodes.empty())
+    return 0;
+
+  std::size_t tested{0};
+  std::vector<std::size_t> stack{0};
+  while (!stack.empty())
+  {
+    const auto &node = this->nodes[stack.back()];
+    stack.pop_back();
+
+    ++tested;
+    const Side s = side(_planes, node.min, node.max);
+    if (Side::kOutside == s)
+      continue;
+
+    if (Side::kInside == s)
+    {
+      for (std::size_t i = node.first; i < node.first + node.count; ++i)
+        _visible.push_back(this->items[i].id);
+      continue;
+    }
+
+    if (0 != node.child)
+    {
+      stack.push_back(node.child);
+      stack.push_back(node.child + 1);
+      continue;
+    }
+
+    for (std::size_t i = node.first; i < node.first + node.count; ++i)
+    {
+      ++tested;
+      const auto &item = this->items[i];
+      if (Side::kOutside != side(_planes, item.min, item.max))
+        _visible.push_back(item.id);
+    }
+  }
+  return tested;
+}
+
+/////////////////////////////////////////////////
+std::size_t CullingBvh::Size() const
+{
+  return this->items.size();
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_CULLINGBVH_HH_
+#define GZ_GUI_PLUGINS_CULLINGBVH_HH_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#ifndef _WIN32
+#  define CullingBvh_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define CullingBvh_EXPORTS_API __declspec(dllexport)
+#  else
+#    define CullingBvh_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Plane bounding a view frustum. Points for which
+  /// `normal.Dot(point) + offset` is negative are outside.
+  struct CullingBvh_EXPORTS_API CullPlane
+  {
+    /// \brief Normal, pointing into the frustum
+    math::Vector3d normal;
+
+    /// \brief Offset along the normal
+    double offset{0.0};
+  };
+
+  /// \brief Bounding volume hierarchy over the world boxes of visuals, to
+  /// find the ones inside a view frustum without testing all of them.
+  /// Subtrees entirely outside are skipped and subtrees entirely inside are
+  /// taken whole.
+  ///
+  /// Boxes of visuals which move are updated in place by refitting their
+  /// ancestors, which keeps the hierarchy valid but lets it degrade, so it
+  /// should be built again once visuals are added or removed.
+  class CullingBvh_EXPORTS_API CullingBvh
+  {
+    /// \brief Visual and its box
+    public: struct Item
+    {
+      /// \brief Id chosen by the caller, returned by Query
+      std::size_t id{0};
+
+      /// \brief Minimum corner of the box, in the world frame
+      math::Vector3d min;
+
+      /// \brief Maximum corner of the box, in the world frame
+      math::Vector3d max;
+    };
+
+    /// \brief Build the hierarchy, replacing the previous one
+    /// \param[in] _items Items, with unique ids
+    public: void Build(std::vector<Item> _items);
+
+    /// \brief Update the box of an item
+    /// \param[in] _id Item id
+    /// \param[in] _min Minimum corner of the new box
+    /// \param[in] _max Maximum corner of the new box
+    /// \return False if there's no such item
+    public: bool Update(std::size_t _id, const math::Vector3d &_min,
+        const math::Vector3d &_max);
+
+    /// \brief Find the items whose box is at least partly inside all planes
+    /// \param[in] _planes Planes of the frustum
+    /// \param[out] _visible Ids of the items inside, appended in no
+    /// particular order
+    /// \return Number of boxes tested, nodes and items
+    public: std::size_t Query(const std::vector<CullPlane> &_planes,
+        std::vector<std::size_t> &_visible) const;
+
+    /// \brief Number of items
+    /// \return Item count
+    public: std::size_t Size() const;
+
+    /// \brief Node of the hierarchy
+    private: struct Node
+    {
+      /// \brief Minimum corner of the box around its items
+      math::Vector3d min;
+
+      /// \brief Maximum corner of the box around its items
+      math::Vector3d max;
+
+      /// \brief Index of its first item in `items`. The items of a subtree
+      /// are contiguous.
+      std::size_t first{0};
+
+      /// \brief Number of items in the subtree
+      std::size_t count{0};
+
+      /// \brief Index of its first child in `nodes`, followed by the second.
+      /// Zero for leaves, since the root is never a child.
+      std::size_t child{0};
+
+      /// \brief Index of its parent in `nodes`, unused for the root
+      std::size_t parent{0};
+    };
+
+    /// \brief Build the node for a range of `items`
+    /// \param[in] _node Index of the node in `nodes`
+    /// \param[in] _first First item
+    /// \param[in] _count Number of items
+    private: void Build(std::size_t _node, std::size_t _first,
+        std::size_t _count);
+
+    /// \brief Recompute the box of a node from its items or children
+    /// \param[in] _node Index of the node in `nodes`
+    private: void Fit(std::size_t _node);
+
+    /// \brief Items, sorted so that the items of each subtree are
+    /// contiguous
+    private: std::vector<Item> items;
+
+    /// \brief Leaf containing each item of `items`
+    private: std::vector<std::size_t> leaves;
+
+    /// \brief Index in `items` of each item id
+    private: std::unordered_map<std::size_t, std::size_t> index;
+
+    /// \brief Nodes, the root first
+    private: std::vector<Node> nodes;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_CULLINGBVH_HH_
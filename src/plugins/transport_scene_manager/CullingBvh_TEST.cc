@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "CullingBvh.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Unit boxes centered along the X axis at 0, 2, 4...
+/// \param[in] _count Number of boxes
+/// \return Items with ids 0, 1, 2...
+std::vector<CullingBvh::Item> row(std::size_t _count)
+{
+  std::vector<CullingBvh::Item> items;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double x = 2.0 * static_cast<double>(i);
+    items.push_back({i, math::Vector3d(x - 0.5, -0.5, -0.5),
+        math::Vector3d(x + 0.5, 0.5, 0.5)});
+  }
+  return items;
+}
+
+/////////////////////////////////////////////////
+/// \brief Planes keeping x within a range
+/// \param[in] _min Lowest x
+/// \param[in] _max Highest x
+/// \return Planes
+std::vector<CullPlane> slab(double _min, double _max)
+{
+  return {
+    {math::Vector3d(1, 0, 0), -_min},
+    {math::Vector3d(-1, 0, 0), _max}
+  };
+}
+
+/////////////////////////////////////////////////
+std::vector<std::size_t> query(const CullingBvh &_bvh,
+    const std::vector<CullPlane> &_planes)
+{
+  std::vector<std::size_t> visible;
+  _bvh.Query(_planes, visible);
+  std::sort(visible.begin(), visible.end());
+  return visible;
+}
+
+/////////////////////////////////////////////////
+TEST(CullingBvhTest, Empty)
+{
+  CullingBvh bvh;
+  std::vector<std::size_t> visible;
+  EXPECT_EQ(0u, bvh.Query(slab(0, 1), visible));
+  EXPECT_TRUE(visible.empty());
+  EXPECT_FALSE(bvh.Update(0, math::Vector3d(), math::Vector3d()));
+}
+
+/////////////////////////////////////////////////
+TEST(CullingBvhTest, Query)
+{
+  CullingBvh bvh;
+  bvh.Build(row(100));
+  EXPECT_EQ(100u, bvh.Size());
+
+  // Boxes crossing the planes count as visible
+  EXPECT_EQ(std::vector<std::size_t>({5, 6, 7}),
+      query(bvh, slab(10.2, 13.9)));
+
+  // Everything
+  EXPECT_EQ(100u, query(bvh, slab(-10, 1000)).size());
+
+  // Nothing
+  EXPECT_TRUE(query(bvh, slab(500, 600)).empty());
+
+  // Far fewer boxes than items are tested for a small frustum
+  std::vector<std::size_t> visible;
+  EXPECT_LT(bvh.Query(slab(10.2, 13.9), visible), 50u);
+}
+
+/////////////////////////////////////////////////
+TEST(CullingBvhTest, Update)
+{
+  CullingBvh bvh;
+  bvh.Build(row(50));
+
+  // Move the first box into the range of the last ones
+  EXPECT_TRUE(bvh.Update(0, math::Vector3d(95.5, -0.5, -0.5),
+      math::Vector3d(96.5, 0.5, 0.5)));
+  EXPECT_EQ(std::vector<std::size_t>({0, 48}), query(bvh, slab(95.6, 96.4)));
+  EXPECT_TRUE(query(bvh, slab(-0.4, 0.4)).empty());
+
+  EXPECT_FALSE(bvh.Update(50, math::Vector3d(), math::Vector3d()));
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "DeferredPoses.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+bool DeferredPoses::Update(unsigned int _id, const math::Pose3d &_pose)
+{
+  auto it = this->entries.find(_id);
+  if (it == this->entries.end())
+    return false;
+  it->second.pose = _pose;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void DeferredPoses::Add(unsigned int _id, const math::Pose3d &_pose,
+    const math::Vector3d &_center, double _radius)
+{
+  this->entries[_id] = {_pose, _center, _radius};
+}
+
+/////////////////////////////////////////////////
+std::optional<math::Pose3d> DeferredPoses::Take(unsigned int _id)
+{
+  auto it = this->entries.find(_id);
+  if (it == this->entries.end())
+    return std::nullopt;
+  auto pose = it->second.pose;
+  this->entries.erase(it);
+  return pose;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::pair<unsigned int, math::Pose3d>> DeferredPoses::TakeVisible(
+    const std::vector<CullPlane> &_planes, const ParentPose &_parentPose,
+    const Pinned &_pinned)
+{
+  std::vector<std::pair<unsigned int, math::Pose3d>> taken;
+  for (auto it = this->entries.begin(); it != this->entries.end();)
+  {
+    const auto &entry = it->second;
+    const auto parent = _parentPose(it->first);
+    if (!parent)
+    {
+      it = this->entries.erase(it);
+      continue;
+    }
+
+    const auto center = parent->CoordPositionAdd(
+        entry.pose.CoordPositionAdd(entry.center));
+    bool inside{true};
+    for (const auto &plane : _planes)
+    {
+      if (plane.normal.Dot(center) + plane.offset < -entry.radius)
+      {
+        inside = false;
+        break;
+      }
+    }
+    if (!inside && _pinned)
+      inside = _pinned(it->first);
+
+    if (inside)
+    {
+      taken.emplace_back(it->first, entry.pose);
+      it = this->entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  return taken;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::pair<unsigned int, math::Pose3d>> DeferredPoses::TakeAll()
+{
+  std::vector<std::pair<unsigned int, math::Pose3d>> taken;
+  taken.reserve(this->entries.size());
+  for (const auto &[id, entry] : this->entries)
+    taken.emplace_back(id, entry.pose);
+  this->entries.clear();
+  return taken;
+}
+
+/////////////////////////////////////////////////
+std::size_t DeferredPoses::Size() const
+{
+  return this->entries.size();
+}
+}  // namespace gz::gui::plugins
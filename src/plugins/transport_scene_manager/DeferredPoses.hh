@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_DEFERREDPOSES_HH_
+#define GZ_GUI_PLUGINS_DEFERREDPOSES_HH_
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+
+#include "CullingBvh.hh"
+
+#ifndef _WIN32
+#  define DeferredPoses_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define DeferredPoses_EXPORTS_API __declspec(dllexport)
+#  else
+#    define DeferredPoses_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Latest poses of entities outside the view, kept instead of
+  /// applied until the entities may be seen again.
+  ///
+  /// Deferred entities stay where they were in the scene, so their boxes
+  /// can't tell when they come back into view. Instead, each keeps a sphere
+  /// around its geometry, in the frame its poses place, and the sphere is
+  /// moved to the latest pose and tested against the view every frame.
+  ///
+  /// Not thread safe.
+  class DeferredPoses_EXPORTS_API DeferredPoses
+  {
+    /// \brief Signature of the function giving the world pose of the frame
+    /// an entity's poses are in, which is its parent's. Nothing if the
+    /// entity doesn't exist anymore.
+    public: using ParentPose =
+        std::function<std::optional<math::Pose3d>(unsigned int)>;
+
+    /// \brief Signature of the function telling whether an entity's pose
+    /// must be applied even outside the view, such as while the camera
+    /// follows it
+    public: using Pinned = std::function<bool(unsigned int)>;
+
+    /// \brief Replace the pose of an entity already deferred
+    /// \param[in] _id Entity id
+    /// \param[in] _pose Latest pose, in its parent
+    /// \return False if the entity isn't deferred, in which case it must be
+    /// added with its bounds
+    public: bool Update(unsigned int _id, const math::Pose3d &_pose);
+
+    /// \brief Defer the poses of an entity
+    /// \param[in] _id Entity id
+    /// \param[in] _pose Latest pose, in its parent
+    /// \param[in] _center Center of the sphere around the entity's geometry,
+    /// in the frame its poses place
+    /// \param[in] _radius Radius of the sphere
+    public: void Add(unsigned int _id, const math::Pose3d &_pose,
+        const math::Vector3d &_center, double _radius);
+
+    /// \brief Stop deferring an entity, such as once it's deleted or once
+    /// a newer pose is applied
+    /// \param[in] _id Entity id
+    /// \return Latest pose, nothing if the entity wasn't deferred
+    public: std::optional<math::Pose3d> Take(unsigned int _id);
+
+    /// \brief Stop deferring the entities whose sphere, at their latest
+    /// pose, is at least partly inside the view, and the pinned ones
+    /// \param[in] _planes Planes of the view frustum, empty to take all
+    /// \param[in] _parentPose World pose of the entities' parents. Entities
+    /// which don't exist anymore are dropped.
+    /// \param[in] _pinned Entities taken wherever they are, none if null
+    /// \return Ids and latest poses of the entities taken
+    public: std::vector<std::pair<unsigned int, math::Pose3d>> TakeVisible(
+        const std::vector<CullPlane> &_planes, const ParentPose &_parentPose,
+        const Pinned &_pinned = nullptr);
+
+    /// \brief Stop deferring all entities
+    /// \return Ids and latest poses of the entities
+    public: std::vector<std::pair<unsigned int, math::Pose3d>> TakeAll();
+
+    /// \brief Number of entities deferred
+    /// \return Entity count
+    public: std::size_t Size() const;
+
+    /// \brief Deferred entity
+    private: struct Entry
+    {
+      /// \brief Latest pose, in its parent
+      math::Pose3d pose;
+
+      /// \brief Center of the sphere, in the frame the pose places
+      math::Vector3d center;
+
+      /// \brief Radius of the sphere
+      double radius{0.0};
+    };
+
+    /// \brief Deferred entities by id
+    private: std::unordered_map<unsigned int, Entry> entries;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_DEFERREDPOSES_HH_
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <vector>
+
+#include "DeferredPoses.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief View of the half space X > 0
+/// \return Planes
+std::vector<CullPlane> positiveX()
+{
+  return {{math::Vector3d(1, 0, 0), 0.0}};
+}
+
+/////////////////////////////////////////////////
+/// \brief Parents at the world origin
+/// \return World pose of all parents
+std::optional<math::Pose3d> atOrigin(unsigned int)
+{
+  return math::Pose3d::Zero;
+}
+
+/////////////////////////////////////////////////
+TEST(DeferredPosesTest, Latest)
+{
+  DeferredPoses poses;
+  EXPECT_FALSE(poses.Update(1, math::Pose3d(-5, 0, 0, 0, 0, 0)));
+
+  poses.Add(1, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+  EXPECT_TRUE(poses.Update(1, math::Pose3d(-6, 0, 0, 0, 0, 0)));
+  EXPECT_EQ(1u, poses.Size());
+
+  // Only the latest pose is kept
+  auto pose = poses.Take(1);
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_DOUBLE_EQ(-6.0, pose->Pos().X());
+  EXPECT_FALSE(poses.Take(1).has_value());
+  EXPECT_EQ(0u, poses.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(DeferredPosesTest, TakeVisible)
+{
+  DeferredPoses poses;
+  poses.Add(1, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+  poses.Add(2, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+  poses.Add(3, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+  EXPECT_TRUE(poses.TakeVisible(positiveX(), atOrigin).empty());
+
+  // Moving to the edge of the view, within the radius
+  poses.Update(1, math::Pose3d(-0.5, 0, 0, 0, 0, 0));
+  auto taken = poses.TakeVisible(positiveX(), atOrigin);
+  ASSERT_EQ(1u, taken.size());
+  EXPECT_EQ(1u, taken[0].first);
+  EXPECT_DOUBLE_EQ(-0.5, taken[0].second.Pos().X());
+
+  // The geometry is offset from the entity's origin, and turns with it
+  const double halfPi = 1.5707963267948966;
+  poses.Add(4, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d(0, 10, 0),
+      1.0);
+  EXPECT_TRUE(poses.TakeVisible(positiveX(), atOrigin).empty());
+  poses.Update(4, math::Pose3d(-5, 0, 0, 0, 0, -halfPi));
+  taken = poses.TakeVisible(positiveX(), atOrigin);
+  ASSERT_EQ(1u, taken.size());
+  EXPECT_EQ(4u, taken[0].first);
+
+  // Pinned entities are taken wherever they are
+  taken = poses.TakeVisible(positiveX(), atOrigin,
+      [](unsigned int _id) {return 3 == _id;});
+  ASSERT_EQ(1u, taken.size());
+  EXPECT_EQ(3u, taken[0].first);
+  poses.Add(3, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+
+  // Parents move their children, and deleted entities are dropped
+  auto parents = [](unsigned int _id) -> std::optional<math::Pose3d>
+  {
+    if (2 == _id)
+      return math::Pose3d(10, 0, 0, 0, 0, 0);
+    return std::nullopt;
+  };
+  taken = poses.TakeVisible(positiveX(), parents);
+  ASSERT_EQ(1u, taken.size());
+  EXPECT_EQ(2u, taken[0].first);
+  EXPECT_EQ(0u, poses.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(DeferredPosesTest, TakeAll)
+{
+  DeferredPoses poses;
+  poses.Add(1, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+  poses.Add(2, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+
+  // Without planes, everything is in view
+  EXPECT_EQ(2u, poses.TakeVisible({}, atOrigin).size());
+
+  poses.Add(1, math::Pose3d(-5, 0, 0, 0, 0, 0), math::Vector3d::Zero, 1.0);
+  EXPECT_EQ(1u, poses.TakeAll().size());
+  EXPECT_EQ(0u, poses.Size());
+}
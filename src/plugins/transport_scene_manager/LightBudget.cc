@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "LightBudget.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/// \brief Largest ratio of a light's reach to its distance counted, reached
+/// well inside its sphere, so nearby lights don't rank infinitely high
+static constexpr double kMaxReach{1e3};
+
+/////////////////////////////////////////////////
+void LightBudget::SetMaxLights(std::size_t _max)
+{
+  this->maxLights = _max;
+}
+
+/////////////////////////////////////////////////
+void LightBudget::SetMaxShadows(std::size_t _max)
+{
+  this->maxShadows = _max;
+}
+
+/////////////////////////////////////////////////
+void LightBudget::SetHysteresis(double _margin)
+{
+  this->hysteresis = std::max(0.0, _margin);
+}
+
+/////////////////////////////////////////////////
+double LightBudget::Score(const Light &_light, const math::Vector3d &_eye,
+    const std::vector<CullPlane> &_frustum)
+{
+  if (_light.directional)
+    return std::numeric_limits<double>::infinity();
+  if (_light.brightness <= 0.0)
+    return 0.0;
+
+  const double radius = _light.range > 0.0 ? _light.range :
+      std::numeric_limits<double>::infinity();
+  if (radius < std::numeric_limits<double>::infinity())
+  {
+    // Plane normals needn't be unit length
+    for (const auto &plane : _frustum)
+    {
+      if (plane.normal.Dot(_light.position) + plane.offset <
+          -radius * plane.normal.Length())
+      {
+        return 0.0;
+      }
+    }
+  }
+
+  const double distanceSq = std::max(
+      (_light.position - _eye).SquaredLength(), 1e-9);
+  return _light.brightness *
+      std::min(radius * radius / distanceSq, kMaxReach);
+}
+
+/////////////////////////////////////////////////
+std::vector<LightBudget::Change> LightBudget::Update(
+    const std::vector<Light> &_lights, const math::Vector3d &_eye,
+    const std::vector<CullPlane> &_frustum)
+{
+  std::unordered_map<unsigned int, Change> previous;
+  previous.swap(this->states);
+
+  // Rank, favoring lights already chosen
+  std::vector<std::pair<double, const Light *>> ranked;
+  ranked.reserve(_lights.size());
+  for (const auto &light : _lights)
+  {
+    auto it = previous.find(light.id);
+    const bool wasActive = it == previous.end() || it->second.active;
+    const double score = Score(light, _eye, _frustum);
+    if (score > 0.0)
+    {
+      ranked.emplace_back(
+          wasActive ? score * (1.0 + this->hysteresis) : score, &light);
+    }
+    this->states[light.id] = Change{light.id, false, false};
+  }
+
+  auto byRank = [](const std::pair<double, const Light *> &_a,
+      const std::pair<double, const Light *> &_b)
+  {
+    if (_a.first != _b.first)
+      return _a.first > _b.first;
+    return _a.second->id < _b.second->id;
+  };
+  std::sort(ranked.begin(), ranked.end(), byRank);
+  ranked.resize(std::min(ranked.size(), this->maxLights));
+
+  // Shadows are ranked again among the active lights asking for them, with
+  // their own margin
+  std::vector<std::pair<double, const Light *>> shadowed;
+  for (const auto &[score, light] : ranked)
+  {
+    this->states[light->id].active = true;
+    if (!light->castShadows)
+      continue;
+    auto it = previous.find(light->id);
+    const bool hadShadows = it == previous.end() || it->second.shadows;
+    const double base = Score(*light, _eye, _frustum);
+    shadowed.emplace_back(
+        hadShadows ? base * (1.0 + this->hysteresis) : base, light);
+  }
+  std::sort(shadowed.begin(), shadowed.end(), byRank);
+  shadowed.resize(std::min(shadowed.size(), this->maxShadows));
+  for (const auto &[score, light] : shadowed)
+    this->states[light->id].shadows = true;
+
+  std::vector<Change> changes;
+  for (const auto &light : _lights)
+  {
+    const auto &state = this->states[light.id];
+    auto it = previous.find(light.id);
+    const Change before = it != previous.end() ? it->second :
+        Change{light.id, true, light.castShadows};
+    if (before.active != state.active || before.shadows != state.shadows)
+      changes.push_back(state);
+  }
+  return changes;
+}
+
+/////////////////////////////////////////////////
+std::size_t LightBudget::ActiveCount() const
+{
+  return static_cast<std::size_t>(std::count_if(this->states.begin(),
+      this->states.end(), [](const auto &_state)
+      {
+        return _state.second.active;
+      }));
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_LIGHTBUDGET_HH_
+#define GZ_GUI_PLUGINS_LIGHTBUDGET_HH_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "CullingBvh.hh"
+
+#ifndef _WIN32
+#  define LightBudget_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define LightBudget_EXPORTS_API __declspec(dllexport)
+#  else
+#    define LightBudget_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Chooses which of the scene's lights are rendered, so scenes
+  /// with hundreds of lights, such as streetlights, only pay for the few
+  /// lighting the view.
+  ///
+  /// Lights are ranked by how much of the view they may light: their
+  /// brightness times the solid angle of the sphere they reach, as seen
+  /// from the camera. Lights whose sphere is outside the view frustum are
+  /// never chosen, directional lights always come first. The best ones are
+  /// active, and the best active lights asking for shadows cast them.
+  ///
+  /// Lights already chosen are favored by a margin, so lights of similar
+  /// rank don't take turns as the camera moves, and each update only
+  /// changes the few lights which crossed the margin.
+  class LightBudget_EXPORTS_API LightBudget
+  {
+    /// \brief Light to choose from
+    public: struct Light
+    {
+      /// \brief Entity id
+      unsigned int id{0};
+
+      /// \brief Position, in the world frame
+      math::Vector3d position;
+
+      /// \brief Distance it reaches, zero or less if unbounded
+      double range{0.0};
+
+      /// \brief Brightest channel of its diffuse color
+      double brightness{1.0};
+
+      /// \brief True for directional lights, which light everything
+      bool directional{false};
+
+      /// \brief True if it should cast shadows when chosen to
+      bool castShadows{false};
+    };
+
+    /// \brief New state of a light
+    public: struct Change
+    {
+      /// \brief Entity id
+      unsigned int id{0};
+
+      /// \brief True if it's rendered
+      bool active{true};
+
+      /// \brief True if it casts shadows
+      bool shadows{false};
+    };
+
+    /// \brief Set the number of lights rendered at once
+    /// \param[in] _max Maximum number of active lights
+    public: void SetMaxLights(std::size_t _max);
+
+    /// \brief Set the number of lights casting shadows at once
+    /// \param[in] _max Maximum number of shadow casting lights
+    public: void SetMaxShadows(std::size_t _max);
+
+    /// \brief Set how much chosen lights are favored
+    /// \param[in] _margin Fraction of their rank added to the rank of
+    /// chosen lights, defaults to 0.25
+    public: void SetHysteresis(double _margin);
+
+    /// \brief Rank a light
+    /// \param[in] _light Light
+    /// \param[in] _eye Camera position
+    /// \param[in] _frustum View frustum, empty to ignore it
+    /// \return Rank, zero if it can't light the view
+    public: static double Score(const Light &_light,
+        const math::Vector3d &_eye, const std::vector<CullPlane> &_frustum);
+
+    /// \brief Choose the lights for a view. Lights seen for the first time
+    /// are assumed active, casting shadows if they ask to.
+    /// \param[in] _lights All the lights of the scene. Lights missing from
+    /// the previous update are forgotten.
+    /// \param[in] _eye Camera position
+    /// \param[in] _frustum View frustum, empty to ignore it
+    /// \return Lights whose state changed
+    public: std::vector<Change> Update(const std::vector<Light> &_lights,
+        const math::Vector3d &_eye, const std::vector<CullPlane> &_frustum);
+
+    /// \brief Number of active lights, after the last update
+    /// \return Light count
+    public: std::size_t ActiveCount() const;
+
+    /// \brief Maximum number of active lights
+    private: std::size_t maxLights{8};
+
+    /// \brief Maximum number of shadow casting lights
+    private: std::size_t maxShadows{1};
+
+    /// \brief See SetHysteresis
+    private: double hysteresis{0.25};
+
+    /// \brief State of each light, by id
+    private: std::unordered_map<unsigned int, Change> states;
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_LIGHTBUDGET_HH_
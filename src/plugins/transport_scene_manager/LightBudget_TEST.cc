@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "LightBudget.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Streetlights along the X axis at 0, 10, 20...
+/// \param[in] _count Number of lights
+/// \return Lights with ids 1, 2, 3..., all asking for shadows
+std::vector<LightBudget::Light> street(unsigned int _count)
+{
+  std::vector<LightBudget::Light> lights;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    LightBudget::Light light;
+    light.id = i + 1;
+    light.position = math::Vector3d(10.0 * i, 0, 5);
+    light.range = 8.0;
+    light.castShadows = true;
+    lights.push_back(light);
+  }
+  return lights;
+}
+
+/////////////////////////////////////////////////
+/// \brief Apply changes to a map of states
+/// \param[in] _changes Changes
+/// \param[in,out] _states States by id
+void applyChanges(const std::vector<LightBudget::Change> &_changes,
+    std::map<unsigned int, LightBudget::Change> &_states)
+{
+  for (const auto &change : _changes)
+    _states[change.id] = change;
+}
+
+/////////////////////////////////////////////////
+TEST(LightBudgetTest, Score)
+{
+  LightBudget::Light light;
+  light.position = math::Vector3d(10, 0, 0);
+  light.range = 5.0;
+
+  const math::Vector3d eye(0, 0, 0);
+  const double near = LightBudget::Score(light, eye, {});
+  EXPECT_GT(near, 0.0);
+
+  light.position = math::Vector3d(20, 0, 0);
+  EXPECT_LT(LightBudget::Score(light, eye, {}), near);
+
+  light.brightness = 0.0;
+  EXPECT_DOUBLE_EQ(0.0, LightBudget::Score(light, eye, {}));
+
+  // Behind a plane facing +X, unless its sphere reaches across
+  light.brightness = 1.0;
+  const std::vector<CullPlane> front{{math::Vector3d(2, 0, 0), 0.0}};
+  light.position = math::Vector3d(-6, 0, 0);
+  EXPECT_DOUBLE_EQ(0.0, LightBudget::Score(light, eye, front));
+  light.position = math::Vector3d(-4, 0, 0);
+  EXPECT_GT(LightBudget::Score(light, eye, front), 0.0);
+
+  light.directional = true;
+  light.position = math::Vector3d(-100, 0, 0);
+  EXPECT_GT(LightBudget::Score(light, eye, front), near);
+}
+
+/////////////////////////////////////////////////
+TEST(LightBudgetTest, Budget)
+{
+  LightBudget budget;
+  budget.SetMaxLights(3);
+  budget.SetMaxShadows(1);
+
+  auto lights = street(20);
+  LightBudget::Light sun;
+  sun.id = 100;
+  sun.directional = true;
+  sun.castShadows = true;
+  lights.push_back(sun);
+
+  // Lights start active and casting shadows, so all but the sun change
+  std::map<unsigned int, LightBudget::Change> states;
+  auto changes = budget.Update(lights, math::Vector3d(52, 0, 2), {});
+  applyChanges(changes, states);
+  EXPECT_EQ(3u, budget.ActiveCount());
+  EXPECT_EQ(20u, changes.size());
+
+  // The sun, then the two closest lights, only the sun casts shadows
+  EXPECT_EQ(states.end(), states.find(100));
+  EXPECT_TRUE(states[6].active);
+  EXPECT_FALSE(states[6].shadows);
+  EXPECT_FALSE(states[7].shadows);
+  EXPECT_TRUE(states[7].active);
+  EXPECT_FALSE(states[5].active);
+
+  // Nothing changes while the camera stays
+  EXPECT_TRUE(budget.Update(lights, math::Vector3d(52, 0, 2), {}).empty());
+
+  // Moving down the street swaps a single light at a time
+  for (double x = 52; x < 150; x += 1.0)
+  {
+    changes = budget.Update(lights, math::Vector3d(x, 0, 2), {});
+    EXPECT_LE(changes.size(), 2u) << x;
+    EXPECT_EQ(3u, budget.ActiveCount()) << x;
+  }
+
+  // Removed lights are forgotten, and leave room for another light, and
+  // for another shadow
+  lights.pop_back();
+  changes = budget.Update(lights, math::Vector3d(150, 0, 2), {});
+  EXPECT_EQ(3u, budget.ActiveCount());
+  EXPECT_EQ(2u, changes.size());
+}
+
+/////////////////////////////////////////////////
+TEST(LightBudgetTest, Hysteresis)
+{
+  LightBudget budget;
+  budget.SetMaxLights(1);
+  budget.SetMaxShadows(0);
+  auto lights = street(2);
+  for (auto &light : lights)
+    light.castShadows = false;
+
+  // Light 1 wins when the camera is closer to it
+  auto changes = budget.Update(lights, math::Vector3d(4, 0, 5), {});
+  ASSERT_EQ(1u, changes.size());
+  EXPECT_EQ(2u, changes[0].id);
+  EXPECT_FALSE(changes[0].active);
+
+  // Just past the middle, it keeps the light
+  EXPECT_TRUE(budget.Update(lights, math::Vector3d(5.2, 0, 5), {}).empty());
+
+  // Well past, the lights swap
+  changes = budget.Update(lights, math::Vector3d(7, 0, 5), {});
+  EXPECT_EQ(2u, changes.size());
+
+  // Without a margin, they swap right away
+  budget.SetHysteresis(0.0);
+  changes = budget.Update(lights, math::Vector3d(4.9, 0, 5), {});
+  EXPECT_EQ(2u, changes.size());
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "PackedPoses.hh"
+
+namespace
+{
+/// \brief Version of the encoding
+constexpr std::uint8_t kVersion{2};
+
+/// \brief Bytes before the poses
+constexpr std::size_t kHeaderSize{1 + 1 + 8 + 4};
+
+/// \brief Largest magnitude of the 3 smallest components of a unit
+/// quaternion
+const double kMaxSmallest{1.0 / std::sqrt(2.0)};
+
+/// \brief Largest 10 bit value
+constexpr std::uint32_t kMaxQuantized{1023};
+
+/////////////////////////////////////////////////
+void writeU32(std::string &_data, std::uint32_t _value)
+{
+  for (int i = 0; i < 4; ++i)
+    _data.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+}
+
+/////////////////////////////////////////////////
+void writeFloat(std::string &_data, double _value)
+{
+  const float value = static_cast<float>(_value);
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeU32(_data, bits);
+}
+
+/////////////////////////////////////////////////
+std::uint32_t readU32(const std::string &_data, std::size_t &_offset)
+{
+  std::uint32_t value{0};
+  for (int i = 0; i < 4; ++i)
+  {
+    value |= static_cast<std::uint32_t>(
+        static_cast<unsigned char>(_data[_offset++])) << (8 * i);
+  }
+  return value;
+}
+
+/////////////////////////////////////////////////
+double readFloat(const std::string &_data, std::size_t &_offset)
+{
+  const std::uint32_t bits = readU32(_data, _offset);
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/////////////////////////////////////////////////
+std::uint32_t compress(const gz::math::Quaterniond &_rot)
+{
+  std::array<double, 4> q{_rot.W(), _rot.X(), _rot.Y(), _rot.Z()};
+  std::uint32_t largest{0};
+  for (std::uint32_t i = 1; i < 4; ++i)
+  {
+    if (std::abs(q[i]) > std::abs(q[largest]))
+      largest = i;
+  }
+
+  // q and -q are the same rotation, the dropped component is positive
+  const double sign = q[largest] < 0 ? -1.0 : 1.0;
+  std::uint32_t bits = largest << 30;
+  int shift{20};
+  for (std::uint32_t i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+    const double unit = (sign * q[i] / kMaxSmallest + 1.0) * 0.5;
+    const auto quantized = static_cast<std::uint32_t>(std::lround(
+        std::clamp(unit, 0.0, 1.0) * kMaxQuantized));
+    bits |= quantized << shift;
+    shift -= 10;
+  }
+  return bits;
+}
+
+/////////////////////////////////////////////////
+gz::math::Quaterniond decompress(std::uint32_t _bits)
+{
+  const std::uint32_t largest = _bits >> 30;
+  std::array<double, 4> q{0, 0, 0, 0};
+  double sum{0};
+  int shift{20};
+  for (std::uint32_t i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+      continue;
+    const double unit =
+        static_cast<double>((_bits >> shift) & kMaxQuantized) / kMaxQuantized;
+    q[i] = (unit * 2.0 - 1.0) * kMaxSmallest;
+    sum += q[i] * q[i];
+    shift -= 10;
+  }
+  q[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+  return gz::math::Quaterniond(q[0], q[1], q[2], q[3]);
+}
+}  // namespace
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+std::string PackedPoses::Pack(double _stamp,
+    const std::vector<Entry> &_poses, Rotation _rotation)
+{
+  const bool compressed = _rotation == Rotation::COMPRESSED;
+  std::string data;
+  data.reserve(kHeaderSize + _poses.size() * (compressed ? 20 : 32));
+  data.push_back(static_cast<char>(kVersion));
+  data.push_back(static_cast<char>(compressed ? 1 : 0));
+
+  std::uint64_t stampBits;
+  std::memcpy(&stampBits, &_stamp, sizeof(stampBits));
+  writeU32(data, static_cast<std::uint32_t>(stampBits & 0xFFFFFFFF));
+  writeU32(data, static_cast<std::uint32_t>(stampBits >> 32));
+
+  writeU32(data, static_cast<std::uint32_t>(_poses.size()));
+  for (const auto &entry : _poses)
+    writeU32(data, entry.id);
+  for (const auto &entry : _poses)
+  {
+    writeFloat(data, entry.pose.Pos().X());
+    writeFloat(data, entry.pose.Pos().Y());
+    writeFloat(data, entry.pose.Pos().Z());
+  }
+  for (const auto &entry : _poses)
+  {
+    if (compressed)
+    {
+      writeU32(data, compress(entry.pose.Rot()));
+      continue;
+    }
+    writeFloat(data, entry.pose.Rot().W());
+    writeFloat(data, entry.pose.Rot().X());
+    writeFloat(data, entry.pose.Rot().Y());
+    writeFloat(data, entry.pose.Rot().Z());
+  }
+  return data;
+}
+
+/////////////////////////////////////////////////
+bool PackedPoses::Unpack(const std::string &_data, double &_stamp,
+    std::vector<Entry> &_poses)
+{
+  if (_data.size() < kHeaderSize ||
+      static_cast<std::uint8_t>(_data[0]) != kVersion ||
+      static_cast<std::uint8_t>(_data[1]) > 1)
+  {
+    return false;
+  }
+  const bool compressed = _data[1] == 1;
+
+  std::size_t offset{2};
+  std::uint64_t stampBits = readU32(_data, offset);
+  stampBits |= static_cast<std::uint64_t>(readU32(_data, offset)) << 32;
+  const std::size_t count = readU32(_data, offset);
+  const std::size_t poseSize = compressed ? 20 : 32;
+  if ((_data.size() - kHeaderSize) / poseSize < count)
+    return false;
+
+  std::memcpy(&_stamp, &stampBits, sizeof(_stamp));
+  _poses.resize(count);
+  for (auto &entry : _poses)
+    entry.id = readU32(_data, offset);
+  for (auto &entry : _poses)
+  {
+    const double x = readFloat(_data, offset);
+    const double y = readFloat(_data, offset);
+    const double z = readFloat(_data, offset);
+    entry.pose.Pos().Set(x, y, z);
+  }
+  for (auto &entry : _poses)
+  {
+    if (compressed)
+    {
+      entry.pose.Rot() = decompress(readU32(_data, offset));
+      continue;
+    }
+    const double w = readFloat(_data, offset);
+    const double x = readFloat(_data, offset);
+    const double y = readFloat(_data, offset);
+    const double z = readFloat(_data, offset);
+    entry.pose.Rot().Set(w, x, y, z);
+  }
+  return true;
+}
+}  // namespace gz::gui::plugins
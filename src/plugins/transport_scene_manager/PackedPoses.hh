@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_PACKEDPOSES_HH_
+#define GZ_GUI_PLUGINS_PACKEDPOSES_HH_
+
+#include <string>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+
+#ifndef _WIN32
+#  define PackedPoses_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define PackedPoses_EXPORTS_API __declspec(dllexport)
+#  else
+#    define PackedPoses_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Compact encoding of entity poses, a lighter alternative to
+  /// msgs::Pose_V for servers publishing many poses, and used to share
+  /// poses between GUIs showing the same scene.
+  ///
+  /// Little endian, arrays rather than a msg per pose:
+  /// * Version byte, currently 2
+  /// * Rotation byte, 0 for floats and 1 for compressed
+  /// * Stamp as a double, negative if unknown
+  /// * Number of poses as a 32 bit integer
+  /// * Ids as 32 bit integers
+  /// * Positions as 3 floats each
+  /// * Rotations as 4 floats each (w, x, y, z), or compressed in a 32 bit
+  ///   integer each: the index of the largest quaternion component in the
+  ///   2 high bits, then the 3 others quantized to 10 bits, in order.
+  ///
+  /// That's 32 bytes per pose, or 20 with compressed rotations, which are
+  /// accurate to about a tenth of a degree. Positions lose precision beyond
+  /// a few kilometers from the origin.
+  class PackedPoses_EXPORTS_API PackedPoses
+  {
+    /// \brief Encoding of the rotations
+    public: enum class Rotation
+    {
+      /// \brief Quaternion as 4 floats
+      FLOAT,
+
+      /// \brief Largest component dropped and others quantized to 10 bits
+      COMPRESSED
+    };
+
+    /// \brief Entity pose
+    public: struct Entry
+    {
+      /// \brief Entity id
+      unsigned int id{0};
+
+      /// \brief Pose
+      math::Pose3d pose;
+    };
+
+    /// \brief Encode poses
+    /// \param[in] _stamp Time of the poses in seconds, negative if unknown
+    /// \param[in] _poses Poses, in order. Rotations must be normalized to
+    /// be compressed.
+    /// \param[in] _rotation Encoding of the rotations
+    /// \return Encoded poses
+    public: static std::string Pack(double _stamp,
+        const std::vector<Entry> &_poses,
+        Rotation _rotation = Rotation::FLOAT);
+
+    /// \brief Decode poses
+    /// \param[in] _data Poses encoded by Pack
+    /// \param[out] _stamp Time of the poses in seconds, negative if unknown
+    /// \param[out] _poses Poses, in order
+    /// \return False if the data is truncated or of another version, in
+    /// which case the outputs are unchanged
+    public: static bool Unpack(const std::string &_data, double &_stamp,
+        std::vector<Entry> &_poses);
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_PACKEDPOSES_HH_
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "PackedPoses.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(PackedPosesTest, RoundTrip)
+{
+  std::vector<PackedPoses::Entry> poses{
+    {1, math::Pose3d(1.5, -2, 3, 1, 0, 0, 0)},
+    {4000000000u, math::Pose3d(-100, 0.25, 7, 0.5, 0.5, -0.5, 0.5)}};
+
+  const auto data = PackedPoses::Pack(12.345678901, poses);
+  EXPECT_EQ(14u + 2u * 32u, data.size());
+
+  double stamp{0.0};
+  std::vector<PackedPoses::Entry> unpacked;
+  ASSERT_TRUE(PackedPoses::Unpack(data, stamp, unpacked));
+  EXPECT_DOUBLE_EQ(12.345678901, stamp);
+  ASSERT_EQ(2u, unpacked.size());
+  EXPECT_EQ(1u, unpacked[0].id);
+  EXPECT_EQ(4000000000u, unpacked[1].id);
+  EXPECT_DOUBLE_EQ(1.5, unpacked[0].pose.Pos().X());
+  EXPECT_DOUBLE_EQ(-100, unpacked[1].pose.Pos().X());
+  EXPECT_DOUBLE_EQ(0.25, unpacked[1].pose.Pos().Y());
+  EXPECT_DOUBLE_EQ(0.5, unpacked[1].pose.Rot().W());
+  EXPECT_DOUBLE_EQ(-0.5, unpacked[1].pose.Rot().Y());
+
+  // No poses, unknown stamp
+  ASSERT_TRUE(PackedPoses::Unpack(PackedPoses::Pack(-1, {}), stamp,
+      unpacked));
+  EXPECT_DOUBLE_EQ(-1, stamp);
+  EXPECT_TRUE(unpacked.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PackedPosesTest, Invalid)
+{
+  const auto data = PackedPoses::Pack(3,
+      {{1, math::Pose3d()}, {2, math::Pose3d()}});
+
+  double stamp{-1.0};
+  std::vector<PackedPoses::Entry> poses;
+  EXPECT_FALSE(PackedPoses::Unpack("", stamp, poses));
+  EXPECT_FALSE(PackedPoses::Unpack(data.substr(0, data.size() - 1), stamp,
+      poses));
+
+  auto otherVersion = data;
+  otherVersion[0] = 1;
+  EXPECT_FALSE(PackedPoses::Unpack(otherVersion, stamp, poses));
+
+  auto otherRotation = data;
+  otherRotation[1] = 2;
+  EXPECT_FALSE(PackedPoses::Unpack(otherRotation, stamp, poses));
+
+  // Outputs unchanged
+  EXPECT_DOUBLE_EQ(-1, stamp);
+  EXPECT_TRUE(poses.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PackedPosesTest, CompressedRotation)
+{
+  // Each component the largest in turn, some negative
+  const double h = std::sqrt(0.5);
+  std::vector<PackedPoses::Entry> poses{
+    {1, math::Pose3d(1, 2, 3, 1, 0, 0, 0)},
+    {2, math::Pose3d(0, 0, 0, 0.1, -0.9, 0.3, std::sqrt(0.09))},
+    {3, math::Pose3d(0, 0, 0, 0, 0, -h, h)},
+    {4, math::Pose3d(0, 0, 0, 0.5, 0.5, 0.5, -0.5)}};
+
+  const auto data = PackedPoses::Pack(-1, poses,
+      PackedPoses::Rotation::COMPRESSED);
+  EXPECT_EQ(14u + 4u * 20u, data.size());
+
+  double stamp{0.0};
+  std::vector<PackedPoses::Entry> unpacked;
+  ASSERT_TRUE(PackedPoses::Unpack(data, stamp, unpacked));
+  ASSERT_EQ(poses.size(), unpacked.size());
+  EXPECT_DOUBLE_EQ(3, unpacked[0].pose.Pos().Z());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_EQ(poses[i].id, unpacked[i].id);
+
+    // Same rotation, possibly negated
+    const auto &a = poses[i].pose.Rot();
+    const auto &b = unpacked[i].pose.Rot();
+    const double dot = a.W() * b.W() + a.X() * b.X() + a.Y() * b.Y() +
+        a.Z() * b.Z();
+    EXPECT_NEAR(1.0, std::abs(dot), 1e-5) << i;
+  }
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "PoseFilter.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+bool PoseFilter::SetModelPatterns(const std::vector<std::string> &_patterns)
+{
+  bool valid{true};
+  this->patterns.clear();
+  for (const auto &pattern : _patterns)
+  {
+    try
+    {
+      this->patterns.emplace_back(pattern);
+    }
+    catch (const std::regex_error &)
+    {
+      valid = false;
+    }
+  }
+  return valid;
+}
+
+/////////////////////////////////////////////////
+void PoseFilter::SetRadius(double _radius)
+{
+  this->radius = std::max(0.0, _radius);
+}
+
+/////////////////////////////////////////////////
+bool PoseFilter::Enabled() const
+{
+  return !this->patterns.empty() || this->radius > 0.0;
+}
+
+/////////////////////////////////////////////////
+void PoseFilter::SetCamera(const math::Vector3d &_position)
+{
+  this->camera = _position;
+  this->hasCamera = true;
+}
+
+/////////////////////////////////////////////////
+void PoseFilter::AddModel(unsigned int _id, const std::string &_name,
+    const math::Vector3d &_position,
+    const std::vector<unsigned int> &_children)
+{
+  this->RemoveModel(_id);
+
+  Model model;
+  model.excluded = !this->patterns.empty() &&
+      std::none_of(this->patterns.begin(), this->patterns.end(),
+      [&_name](const std::regex &_pattern)
+      {
+        return std::regex_match(_name, _pattern);
+      });
+  model.position = _position;
+  model.children = _children;
+  for (const auto child : _children)
+    this->owners[child] = _id;
+  this->models[_id] = std::move(model);
+}
+
+/////////////////////////////////////////////////
+void PoseFilter::RemoveModel(unsigned int _id)
+{
+  auto it = this->models.find(_id);
+  if (it == this->models.end())
+    return;
+  for (const auto child : it->second.children)
+  {
+    auto owner = this->owners.find(child);
+    if (owner != this->owners.end() && owner->second == _id)
+      this->owners.erase(owner);
+  }
+  this->models.erase(it);
+}
+
+/////////////////////////////////////////////////
+std::vector<bool> PoseFilter::Keep(
+    const std::vector<std::pair<unsigned int, math::Vector3d>> &_poses)
+{
+  // Models first, so their children are judged by where they are now
+  for (const auto &[id, position] : _poses)
+  {
+    auto model = this->models.find(id);
+    if (model != this->models.end())
+      model->second.position = position;
+  }
+
+  const double radiusSquared = this->radius * this->radius;
+  std::vector<bool> keep;
+  keep.reserve(_poses.size());
+  for (const auto &pose : _poses)
+  {
+    auto model = this->models.find(pose.first);
+    if (model == this->models.end())
+    {
+      auto owner = this->owners.find(pose.first);
+      if (owner != this->owners.end())
+        model = this->models.find(owner->second);
+    }
+    if (model == this->models.end())
+    {
+      keep.push_back(true);
+      continue;
+    }
+
+    bool kept = !model->second.excluded;
+    if (kept && this->radius > 0.0 && this->hasCamera)
+    {
+      kept = (model->second.position - this->camera).SquaredLength() <=
+          radiusSquared;
+    }
+    keep.push_back(kept);
+  }
+  return keep;
+}
+}  // namespace gz::gui::plugins
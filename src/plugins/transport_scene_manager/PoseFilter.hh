@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_POSEFILTER_HH_
+#define GZ_GUI_PLUGINS_POSEFILTER_HH_
+
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#ifndef _WIN32
+#  define PoseFilter_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define PoseFilter_EXPORTS_API __declspec(dllexport)
+#  else
+#    define PoseFilter_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Decides which received poses are worth applying, by the name of
+  /// the top level model they belong to and by its distance to the camera.
+  /// Poses of the other models are dropped as soon as they're received, so
+  /// those models stay where they last were.
+  ///
+  /// Not thread safe.
+  class PoseFilter_EXPORTS_API PoseFilter
+  {
+    /// \brief Set the patterns of the top level models whose poses are
+    /// kept
+    /// \param[in] _patterns ECMAScript regular expressions, matching whole
+    /// names. Empty keeps all models.
+    /// \return False if a pattern is invalid, in which case it's skipped
+    public: bool SetModelPatterns(const std::vector<std::string> &_patterns);
+
+    /// \brief Set the distance from the camera past which poses are dropped
+    /// \param[in] _radius Distance in meters, zero keeps all distances
+    public: void SetRadius(double _radius);
+
+    /// \brief Whether there's anything to filter
+    /// \return True if patterns or a radius were set
+    public: bool Enabled() const;
+
+    /// \brief Set the camera position
+    /// \param[in] _position World position. Until set, all distances are
+    /// kept.
+    public: void SetCamera(const math::Vector3d &_position);
+
+    /// \brief Add a top level model, replacing it if it exists
+    /// \param[in] _id Model id
+    /// \param[in] _name Model name
+    /// \param[in] _position World position
+    /// \param[in] _children Ids of its links, visuals, lights and nested
+    /// models
+    public: void AddModel(unsigned int _id, const std::string &_name,
+        const math::Vector3d &_position,
+        const std::vector<unsigned int> &_children);
+
+    /// \brief Remove a top level model and its children
+    /// \param[in] _id Model id, ignored if it isn't a top level model
+    public: void RemoveModel(unsigned int _id);
+
+    /// \brief Decide which poses to keep. Poses of top level models are
+    /// world positions, which update the positions used for the distance.
+    /// Poses of unknown entities are kept.
+    /// \param[in] _poses Entity ids and positions
+    /// \return True for each pose to keep
+    public: std::vector<bool> Keep(
+        const std::vector<std::pair<unsigned int, math::Vector3d>> &_poses);
+
+    /// \brief Top level model
+    private: struct Model
+    {
+      /// \brief True if its name doesn't match any pattern
+      bool excluded{false};
+
+      /// \brief Last known world position
+      math::Vector3d position;
+
+      /// \brief Ids of its children
+      std::vector<unsigned int> children;
+    };
+
+    /// \brief Top level models by id
+    private: std::unordered_map<unsigned int, Model> models;
+
+    /// \brief Top level model of each child entity
+    private: std::unordered_map<unsigned int, unsigned int> owners;
+
+    /// \brief Model name patterns
+    private: std::vector<std::regex> patterns;
+
+    /// \brief Distance from the camera past which poses are dropped
+    private: double radius{0.0};
+
+    /// \brief Camera position
+    private: math::Vector3d camera;
+
+    /// \brief True once the camera position is set
+    private: bool hasCamera{false};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_POSEFILTER_HH_
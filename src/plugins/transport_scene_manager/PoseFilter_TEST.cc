@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "PoseFilter.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(PoseFilterTest, Disabled)
+{
+  PoseFilter filter;
+  EXPECT_FALSE(filter.Enabled());
+
+  filter.AddModel(1, "box", math::Vector3d(100, 0, 0), {2, 3});
+  filter.SetCamera(math::Vector3d(0, 0, 0));
+  EXPECT_EQ(std::vector<bool>({true, true}),
+      filter.Keep({{1, math::Vector3d()}, {2, math::Vector3d()}}));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseFilterTest, Patterns)
+{
+  PoseFilter filter;
+  EXPECT_FALSE(filter.SetModelPatterns({"robot_.*", "[", "arm"}));
+  EXPECT_TRUE(filter.Enabled());
+
+  filter.AddModel(1, "robot_1", math::Vector3d(), {10, 11});
+  filter.AddModel(2, "table", math::Vector3d(), {20});
+  filter.AddModel(3, "arm", math::Vector3d(), {});
+
+  // Children follow their model, unknown entities are kept, and patterns
+  // match whole names
+  EXPECT_EQ(std::vector<bool>({true, true, false, false, true, true}),
+      filter.Keep({{1, math::Vector3d()}, {11, math::Vector3d()},
+                   {2, math::Vector3d()}, {20, math::Vector3d()},
+                   {3, math::Vector3d()}, {99, math::Vector3d()}}));
+
+  filter.AddModel(4, "my_robot_1", math::Vector3d(), {});
+  EXPECT_EQ(std::vector<bool>({false}),
+      filter.Keep({{4, math::Vector3d()}}));
+
+  // Children of removed models become unknown
+  filter.RemoveModel(2);
+  EXPECT_EQ(std::vector<bool>({true}),
+      filter.Keep({{20, math::Vector3d()}}));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseFilterTest, Radius)
+{
+  PoseFilter filter;
+  filter.SetRadius(10);
+  EXPECT_TRUE(filter.Enabled());
+  filter.AddModel(1, "near", math::Vector3d(5, 0, 0), {10});
+  filter.AddModel(2, "far", math::Vector3d(50, 0, 0), {20});
+
+  // Everything is kept until the camera is known
+  EXPECT_EQ(std::vector<bool>({true, true}),
+      filter.Keep({{10, math::Vector3d()}, {20, math::Vector3d()}}));
+
+  filter.SetCamera(math::Vector3d(0, 0, 0));
+  EXPECT_EQ(std::vector<bool>({true, false}),
+      filter.Keep({{10, math::Vector3d()}, {20, math::Vector3d()}}));
+
+  // Models are judged by their new position, before their children
+  EXPECT_EQ(std::vector<bool>({true, true, false, false}),
+      filter.Keep({{20, math::Vector3d()}, {2, math::Vector3d(3, 0, 0)},
+                   {10, math::Vector3d()}, {1, math::Vector3d(0, 30, 0)}}));
+
+  // The camera moving brings models in range
+  filter.SetCamera(math::Vector3d(0, 25, 0));
+  EXPECT_EQ(std::vector<bool>({true, false}),
+      filter.Keep({{10, math::Vector3d()}, {20, math::Vector3d()}}));
+}
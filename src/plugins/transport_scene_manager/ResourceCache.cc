@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <utility>
+
+#include "ResourceCache.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+void ResourceCache::Insert(const std::string &_key, std::size_t _bytes)
+{
+  auto &entry = this->entries[_key];
+  this->bytes = this->bytes - entry.bytes + _bytes;
+  entry.bytes = _bytes;
+  entry.lastUse = ++this->tick;
+}
+
+/////////////////////////////////////////////////
+bool ResourceCache::Touch(const std::string &_key)
+{
+  auto it = this->entries.find(_key);
+  if (it == this->entries.end())
+    return false;
+  it->second.lastUse = ++this->tick;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ResourceCache::Remove(const std::string &_key)
+{
+  auto it = this->entries.find(_key);
+  if (it == this->entries.end())
+    return;
+  this->bytes -= it->second.bytes;
+  this->entries.erase(it);
+}
+
+/////////////////////////////////////////////////
+bool ResourceCache::Contains(const std::string &_key) const
+{
+  return this->entries.find(_key) != this->entries.end();
+}
+
+/////////////////////////////////////////////////
+std::size_t ResourceCache::Bytes() const
+{
+  return this->bytes;
+}
+
+/////////////////////////////////////////////////
+std::size_t ResourceCache::Size() const
+{
+  return this->entries.size();
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> ResourceCache::Evict(std::size_t _budget,
+    const std::function<bool(const std::string &)> &_inUse)
+{
+  std::vector<std::string> evicted;
+  if (this->bytes <= _budget)
+    return evicted;
+
+  // Only runs when over budget, so sorting the candidates is cheaper than
+  // keeping an ordered list updated on every use
+  std::vector<std::pair<std::uint64_t, const std::string *>> candidates;
+  candidates.reserve(this->entries.size());
+  for (const auto &[key, entry] : this->entries)
+    candidates.emplace_back(entry.lastUse, &key);
+  std::sort(candidates.begin(), candidates.end());
+
+  std::size_t remaining = this->bytes;
+  for (const auto &candidate : candidates)
+  {
+    if (remaining <= _budget)
+      break;
+    if (_inUse && _inUse(*candidate.second))
+      continue;
+    remaining -= this->entries.at(*candidate.second).bytes;
+    evicted.push_back(*candidate.second);
+  }
+
+  for (const auto &key : evicted)
+    this->Remove(key);
+  return evicted;
+}
+}  // namespace gz::gui::plugins
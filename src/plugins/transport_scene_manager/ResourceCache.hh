@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_RESOURCECACHE_HH_
+#define GZ_GUI_PLUGINS_RESOURCECACHE_HH_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#  define ResourceCache_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define ResourceCache_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ResourceCache_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Sizes and last use of the resources loaded for the scene, such
+  /// as meshes and their materials, to pick which ones to unload once they
+  /// take more memory than a budget.
+  ///
+  /// The cache only does the bookkeeping. Its owner frees the resources
+  /// returned by Evict, and loads them again when they're needed.
+  class ResourceCache_EXPORTS_API ResourceCache
+  {
+    /// \brief Add a resource, or update its size if it's already known. It
+    /// becomes the most recently used.
+    /// \param[in] _key Resource
+    /// \param[in] _bytes Memory it takes
+    public: void Insert(const std::string &_key, std::size_t _bytes);
+
+    /// \brief Mark a resource as the most recently used
+    /// \param[in] _key Resource
+    /// \return False if the resource isn't in the cache
+    public: bool Touch(const std::string &_key);
+
+    /// \brief Forget a resource
+    /// \param[in] _key Resource
+    public: void Remove(const std::string &_key);
+
+    /// \brief Check whether a resource is in the cache
+    /// \param[in] _key Resource
+    /// \return True if it is
+    public: bool Contains(const std::string &_key) const;
+
+    /// \brief Memory taken by all resources
+    /// \return Bytes
+    public: std::size_t Bytes() const;
+
+    /// \brief Number of resources
+    /// \return Count
+    public: std::size_t Size() const;
+
+    /// \brief Remove the least recently used resources which aren't in use
+    /// until the cache fits in a budget, or only resources in use are left
+    /// \param[in] _budget Bytes the cache should fit in
+    /// \param[in] _inUse Whether a resource is still used, such as by a
+    /// visual, in which case it's kept
+    /// \return Resources removed, least recently used first
+    public: std::vector<std::string> Evict(std::size_t _budget,
+        const std::function<bool(const std::string &)> &_inUse);
+
+    /// \brief Size and last use of a resource
+    private: struct Entry
+    {
+      /// \brief Memory it takes
+      std::size_t bytes{0};
+
+      /// \brief Value of `tick` when it was last used
+      std::uint64_t lastUse{0};
+    };
+
+    /// \brief Resources, by key
+    private: std::unordered_map<std::string, Entry> entries;
+
+    /// \brief Sum of the bytes of all entries
+    private: std::size_t bytes{0};
+
+    /// \brief Incremented on each use, to order them
+    private: std::uint64_t tick{0};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_RESOURCECACHE_HH_
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "ResourceCache.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TEST(ResourceCacheTest, Bytes)
+{
+  ResourceCache cache;
+  EXPECT_EQ(0u, cache.Bytes());
+
+  cache.Insert("a", 100);
+  cache.Insert("b", 50);
+  EXPECT_EQ(150u, cache.Bytes());
+  EXPECT_EQ(2u, cache.Size());
+  EXPECT_TRUE(cache.Contains("a"));
+
+  // Inserting again updates the size
+  cache.Insert("a", 10);
+  EXPECT_EQ(60u, cache.Bytes());
+
+  cache.Remove("a");
+  cache.Remove("unknown");
+  EXPECT_EQ(50u, cache.Bytes());
+  EXPECT_FALSE(cache.Contains("a"));
+  EXPECT_FALSE(cache.Touch("a"));
+}
+
+/////////////////////////////////////////////////
+TEST(ResourceCacheTest, EvictLeastRecentlyUsed)
+{
+  ResourceCache cache;
+  cache.Insert("a", 100);
+  cache.Insert("b", 100);
+  cache.Insert("c", 100);
+  EXPECT_TRUE(cache.Touch("a"));
+
+  auto unused = [](const std::string &) {return false;};
+
+  // Within budget
+  EXPECT_TRUE(cache.Evict(300, unused).empty());
+
+  // "b" is the oldest, then "c"
+  EXPECT_EQ(std::vector<std::string>({"b"}), cache.Evict(250, unused));
+  EXPECT_EQ(200u, cache.Bytes());
+  EXPECT_EQ(std::vector<std::string>({"c", "a"}), cache.Evict(0, unused));
+  EXPECT_EQ(0u, cache.Bytes());
+  EXPECT_EQ(0u, cache.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(ResourceCacheTest, EvictSkipsInUse)
+{
+  ResourceCache cache;
+  cache.Insert("used", 100);
+  cache.Insert("a", 100);
+  cache.Insert("b", 100);
+
+  auto inUse = [](const std::string &_key) {return _key == "used";};
+
+  EXPECT_EQ(std::vector<std::string>({"a", "b"}), cache.Evict(50, inUse));
+  EXPECT_TRUE(cache.Contains("used"));
+  EXPECT_EQ(100u, cache.Bytes());
+
+  // Nothing else can go
+  EXPECT_TRUE(cache.Evict(0, inUse).empty());
+}
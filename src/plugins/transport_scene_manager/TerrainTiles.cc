@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "TerrainTiles.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+TerrainTiles::TerrainTiles(std::vector<float> _heights, unsigned int _width,
+    unsigned int _height, const math::Vector3d &_size,
+    unsigned int _tileSegments)
+  : heights(std::move(_heights)),
+    width(static_cast<int>(std::max(2u, _width))),
+    height(static_cast<int>(std::max(2u, _height)))
+{
+  this->heights.resize(static_cast<std::size_t>(this->width) *
+      static_cast<std::size_t>(this->height), 0.0f);
+  this->spacing.Set(_size.X() / (this->width - 1),
+      _size.Y() / (this->height - 1));
+  this->corner.Set(-_size.X() * 0.5, -_size.Y() * 0.5);
+
+  while (this->tileSegments < static_cast<int>(_tileSegments))
+  {
+    this->tileSegments *= 2;
+    ++this->maxLod;
+  }
+}
+
+/////////////////////////////////////////////////
+int TerrainTiles::TilesX() const
+{
+  return (this->width - 2) / this->tileSegments + 1;
+}
+
+/////////////////////////////////////////////////
+int TerrainTiles::TilesY() const
+{
+  return (this->height - 2) / this->tileSegments + 1;
+}
+
+/////////////////////////////////////////////////
+unsigned int TerrainTiles::MaxLod() const
+{
+  return this->maxLod;
+}
+
+/////////////////////////////////////////////////
+double TerrainTiles::Height(int _i, int _j) const
+{
+  _i = std::clamp(_i, 0, this->width - 1);
+  _j = std::clamp(_j, 0, this->height - 1);
+  return this->heights[static_cast<std::size_t>(_j) *
+      static_cast<std::size_t>(this->width) + static_cast<std::size_t>(_i)];
+}
+
+/////////////////////////////////////////////////
+std::vector<TerrainTiles::Tile> TerrainTiles::Select(
+    const math::Vector3d &_camera, double _radius, double _lodDistance) const
+{
+  const double tileX = this->tileSegments * this->spacing.X();
+  const double tileY = this->tileSegments * this->spacing.Y();
+
+  // Only look at the tiles around the camera, so the cost doesn't grow with
+  // the terrain
+  auto range = [](double _min, double _tile, int _count)
+  {
+    return std::clamp(static_cast<int>(std::floor(_min / _tile)), 0,
+        _count - 1);
+  };
+  const int firstX = range(_camera.X() - _radius - this->corner.X(), tileX,
+      this->TilesX());
+  const int lastX = range(_camera.X() + _radius - this->corner.X(), tileX,
+      this->TilesX());
+  const int firstY = range(_camera.Y() - _radius - this->corner.Y(), tileY,
+      this->TilesY());
+  const int lastY = range(_camera.Y() + _radius - this->corner.Y(), tileY,
+      this->TilesY());
+
+  std::vector<std::pair<double, Tile>> tiles;
+  for (int y = firstY; y <= lastY; ++y)
+  {
+    const double minY = this->corner.Y() + y * tileY;
+    const double maxY = this->corner.Y() + std::min(
+        (y + 1) * this->tileSegments, this->height - 1) * this->spacing.Y();
+    const double dy = std::max({minY - _camera.Y(), 0.0, _camera.Y() - maxY});
+    for (int x = firstX; x <= lastX; ++x)
+    {
+      const double minX = this->corner.X() + x * tileX;
+      const double maxX = this->corner.X() + std::min(
+          (x + 1) * this->tileSegments, this->width - 1) * this->spacing.X();
+      const double dx =
+          std::max({minX - _camera.X(), 0.0, _camera.X() - maxX});
+      const double distance = std::sqrt(dx * dx + dy * dy);
+      if (distance > _radius)
+        continue;
+
+      unsigned int lod{0};
+      if (_lodDistance > 0 && distance >= _lodDistance)
+      {
+        lod = std::min(this->maxLod, 1u + static_cast<unsigned int>(
+            std::floor(std::log2(distance / _lodDistance))));
+      }
+      tiles.push_back({distance, {x, y, lod}});
+    }
+  }
+
+  std::stable_sort(tiles.begin(), tiles.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  std::vector<Tile> result;
+  result.reserve(tiles.size());
+  for (const auto &tile : tiles)
+    result.push_back(tile.second);
+  return result;
+}
+
+/////////////////////////////////////////////////
+TerrainTiles::TileMesh TerrainTiles::Build(const Tile &_tile,
+    double _skirtDepth) const
+{
+  const int step = 1 << std::min(_tile.lod, this->maxLod);
+
+  // Samples used along each axis. The last tile may be shorter, and its
+  // last sample isn't always on the coarser grid, but is always kept so
+  // the tile covers its whole extent.
+  auto samples = [&](int _tile, int _count)
+  {
+    std::vector<int> result;
+    const int first = _tile * this->tileSegments;
+    const int last = std::min(first + this->tileSegments, _count - 1);
+    for (int i = first; i < last; i += step)
+      result.push_back(i);
+    result.push_back(last);
+    return result;
+  };
+  const std::vector<int> columns = samples(_tile.x, this->width);
+  const std::vector<int> rows = samples(_tile.y, this->height);
+  const auto columnCount = static_cast<unsigned int>(columns.size());
+  const auto rowCount = static_cast<unsigned int>(rows.size());
+
+  TileMesh mesh;
+  for (const int j : rows)
+  {
+    for (const int i : columns)
+    {
+      mesh.positions.emplace_back(this->corner.X() + i * this->spacing.X(),
+          this->corner.Y() + j * this->spacing.Y(), this->Height(i, j));
+
+      // Central differences at full resolution, so normals match across
+      // levels and tiles
+      const double dx = (this->Height(i + 1, j) - this->Height(i - 1, j)) /
+          (2.0 * this->spacing.X());
+      const double dy = (this->Height(i, j + 1) - this->Height(i, j - 1)) /
+          (2.0 * this->spacing.Y());
+      mesh.normals.push_back(math::Vector3d(-dx, -dy, 1.0).Normalized());
+
+      // Images start at the top, which is +Y
+      mesh.texCoords.emplace_back(
+          static_cast<double>(i) / (this->width - 1),
+          1.0 - static_cast<double>(j) / (this->height - 1));
+    }
+  }
+
+  for (unsigned int r = 0; r + 1 < rowCount; ++r)
+  {
+    for (unsigned int c = 0; c + 1 < columnCount; ++c)
+    {
+      const unsigned int a = r * columnCount + c;
+      const unsigned int b = a + 1;
+      const unsigned int d = a + columnCount;
+      const unsigned int e = d + 1;
+      mesh.indices.insert(mesh.indices.end(), {a, b, e, a, e, d});
+    }
+  }
+
+  // Edges walked counter-clockwise seen from above, so the skirts face out
+  std::vector<std::vector<unsigned int>> edges(4);
+  for (unsigned int c = 0; c < columnCount; ++c)
+  {
+    edges[0].push_back(c);
+    edges[2].push_back((rowCount - 1) * columnCount + columnCount - 1 - c);
+  }
+  for (unsigned int r = 0; r < rowCount; ++r)
+  {
+    edges[1].push_back(r * columnCount + columnCount - 1);
+    edges[3].push_back((rowCount - 1 - r) * columnCount);
+  }
+
+  for (const auto &edge : edges)
+  {
+    const auto base = static_cast<unsigned int>(mesh.positions.size());
+    for (const auto top : edge)
+    {
+      mesh.positions.push_back(mesh.positions[top] -
+          math::Vector3d(0, 0, _skirtDepth));
+      mesh.normals.push_back(mesh.normals[top]);
+      mesh.texCoords.push_back(mesh.texCoords[top]);
+    }
+    for (unsigned int k = 0; k + 1 < edge.size(); ++k)
+    {
+      const unsigned int top = edge[k];
+      const unsigned int nextTop = edge[k + 1];
+      const unsigned int low = base + k;
+      mesh.indices.insert(mesh.indices.end(),
+          {top, low, low + 1, top, low + 1, nextTop});
+    }
+  }
+  return mesh;
+}
+}  // namespace gz::gui::plugins
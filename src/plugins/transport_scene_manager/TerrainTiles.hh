@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TERRAINTILES_HH_
+#define GZ_GUI_PLUGINS_TERRAINTILES_HH_
+
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#ifndef _WIN32
+#  define TerrainTiles_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define TerrainTiles_EXPORTS_API __declspec(dllexport)
+#  else
+#    define TerrainTiles_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Splits a height field into square tiles which can be built
+  /// independently at several levels of detail, so a large terrain is only
+  /// meshed around the camera, coarser with distance.
+  ///
+  /// Tiles at different levels don't share their edge vertices, so each
+  /// tile has a skirt hanging down from its edges to hide the cracks.
+  ///
+  /// The terrain is centered at the origin of its frame, with Z up. It's
+  /// immutable once constructed, so tiles may be built from several
+  /// threads.
+  class TerrainTiles_EXPORTS_API TerrainTiles
+  {
+    /// \brief Tile at a level of detail
+    public: struct Tile
+    {
+      /// \brief Column, from -X
+      int x{0};
+
+      /// \brief Row, from -Y
+      int y{0};
+
+      /// \brief Level of detail, 0 being every sample and each level
+      /// skipping every other sample of the previous one
+      unsigned int lod{0};
+    };
+
+    /// \brief Triangles of a tile, in the terrain frame
+    public: struct TileMesh
+    {
+      /// \brief Vertex positions
+      std::vector<math::Vector3d> positions;
+
+      /// \brief Vertex normals
+      std::vector<math::Vector3d> normals;
+
+      /// \brief Vertex texture coordinates, spanning the whole terrain from
+      /// 0 to 1
+      std::vector<math::Vector2d> texCoords;
+
+      /// \brief Counter-clockwise triangles, 3 indices each
+      std::vector<unsigned int> indices;
+    };
+
+    /// \brief Constructor
+    /// \param[in] _heights Heights in meters, row by row from -Y, each row
+    /// from -X
+    /// \param[in] _width Samples per row, at least 2
+    /// \param[in] _height Number of rows, at least 2
+    /// \param[in] _size Size of the terrain along X and Y, in meters. Z is
+    /// ignored.
+    /// \param[in] _tileSegments Segments along each side of a tile at full
+    /// detail, rounded up to a power of two
+    public: TerrainTiles(std::vector<float> _heights, unsigned int _width,
+        unsigned int _height, const math::Vector3d &_size,
+        unsigned int _tileSegments);
+
+    /// \brief Number of tiles along X
+    /// \return Tile count
+    public: int TilesX() const;
+
+    /// \brief Number of tiles along Y
+    /// \return Tile count
+    public: int TilesY() const;
+
+    /// \brief Coarsest level of detail, at which a tile is two triangles
+    /// \return Level
+    public: unsigned int MaxLod() const;
+
+    /// \brief Height at a sample, clamped to the terrain
+    /// \param[in] _i Sample along X
+    /// \param[in] _j Sample along Y
+    /// \return Height in meters
+    public: double Height(int _i, int _j) const;
+
+    /// \brief Choose the tiles to show around the camera
+    /// \param[in] _camera Camera position in the terrain frame
+    /// \param[in] _radius Tiles farther than this horizontally, in meters,
+    /// are left out
+    /// \param[in] _lodDistance Distance at which tiles drop to level 1, in
+    /// meters. Each further level starts at twice the previous distance.
+    /// Zero keeps all tiles at full detail.
+    /// \return Tiles, nearest first
+    public: std::vector<Tile> Select(const math::Vector3d &_camera,
+        double _radius, double _lodDistance) const;
+
+    /// \brief Build the triangles of a tile
+    /// \param[in] _tile Tile
+    /// \param[in] _skirtDepth How far down the skirt hangs, in meters
+    /// \return Triangles
+    public: TileMesh Build(const Tile &_tile, double _skirtDepth) const;
+
+    /// \brief Heights, see the constructor
+    private: std::vector<float> heights;
+
+    /// \brief Samples per row
+    private: int width;
+
+    /// \brief Number of rows
+    private: int height;
+
+    /// \brief Distance between samples along X and Y
+    private: math::Vector2d spacing;
+
+    /// \brief Position of the first sample
+    private: math::Vector2d corner;
+
+    /// \brief Segments along each side of a tile at full detail
+    private: int tileSegments{1};
+
+    /// \brief Coarsest level of detail
+    private: unsigned int maxLod{0};
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_TERRAINTILES_HH_
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "TerrainTiles.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Normal of a triangle of a tile
+/// \param[in] _mesh Tile
+/// \param[in] _triangle Index of the triangle
+/// \return Unnormalized normal, following the winding
+math::Vector3d triangleNormal(const TerrainTiles::TileMesh &_mesh,
+    std::size_t _triangle)
+{
+  const auto &a = _mesh.positions[_mesh.indices[_triangle * 3]];
+  const auto &b = _mesh.positions[_mesh.indices[_triangle * 3 + 1]];
+  const auto &c = _mesh.positions[_mesh.indices[_triangle * 3 + 2]];
+  return (b - a).Cross(c - a);
+}
+
+/////////////////////////////////////////////////
+TEST(TerrainTilesTest, Tiles)
+{
+  // 128 segments split in tiles of 64
+  TerrainTiles even(std::vector<float>(129 * 129), 129, 129,
+      math::Vector3d(128, 128, 10), 64);
+  EXPECT_EQ(2, even.TilesX());
+  EXPECT_EQ(2, even.TilesY());
+  EXPECT_EQ(6u, even.MaxLod());
+
+  // Tile size rounded up to a power of two, with a shorter last tile
+  TerrainTiles odd(std::vector<float>(70 * 10), 70, 10,
+      math::Vector3d(69, 9, 10), 50);
+  EXPECT_EQ(2, odd.TilesX());
+  EXPECT_EQ(1, odd.TilesY());
+  EXPECT_EQ(6u, odd.MaxLod());
+}
+
+/////////////////////////////////////////////////
+TEST(TerrainTilesTest, Build)
+{
+  // Flat terrain with one raised sample in the middle of the first tile
+  std::vector<float> heights(9 * 9, 0.0f);
+  heights[2 * 9 + 2] = 1.0f;
+  TerrainTiles terrain(heights, 9, 9, math::Vector3d(8, 8, 1), 4);
+  EXPECT_DOUBLE_EQ(1.0, terrain.Height(2, 2));
+  EXPECT_DOUBLE_EQ(0.0, terrain.Height(-1, 20));
+
+  // Full detail: 5x5 samples, 4x4 cells, and a skirt of 4 quads per edge
+  auto mesh = terrain.Build({0, 0, 0}, 0.5);
+  EXPECT_EQ(25u + 4u * 5u, mesh.positions.size());
+  EXPECT_EQ(mesh.positions.size(), mesh.normals.size());
+  EXPECT_EQ(mesh.positions.size(), mesh.texCoords.size());
+  EXPECT_EQ((16u * 2u + 4u * 4u * 2u) * 3u, mesh.indices.size());
+
+  // Centered on the origin, from -X and -Y
+  EXPECT_DOUBLE_EQ(-4.0, mesh.positions[0].X());
+  EXPECT_DOUBLE_EQ(-4.0, mesh.positions[0].Y());
+  EXPECT_DOUBLE_EQ(0.0, mesh.positions[24].X());
+  EXPECT_DOUBLE_EQ(0.0, mesh.positions[24].Y());
+  EXPECT_DOUBLE_EQ(1.0, mesh.positions[12].Z());
+  EXPECT_DOUBLE_EQ(0.0, mesh.texCoords[0].X());
+  EXPECT_DOUBLE_EQ(1.0, mesh.texCoords[0].Y());
+
+  // Slopes tilt the normals away from the raised sample
+  EXPECT_LT(mesh.normals[11].X(), 0.0);
+  EXPECT_DOUBLE_EQ(1.0, mesh.normals[0].Z());
+
+  // Terrain faces up and skirts face out of the tile
+  EXPECT_GT(triangleNormal(mesh, 0).Z(), 0.0);
+  EXPECT_LT(triangleNormal(mesh, 32).Y(), 0.0);
+  EXPECT_DOUBLE_EQ(-0.5, mesh.positions[25].Z());
+
+  // Coarsest level: a single cell
+  mesh = terrain.Build({1, 1, 2}, 0.5);
+  EXPECT_EQ(4u + 4u * 2u, mesh.positions.size());
+  EXPECT_EQ((2u + 4u * 2u) * 3u, mesh.indices.size());
+  EXPECT_DOUBLE_EQ(4.0, mesh.positions[3].X());
+  EXPECT_DOUBLE_EQ(4.0, mesh.positions[3].Y());
+}
+
+/////////////////////////////////////////////////
+TEST(TerrainTilesTest, ShortLastTile)
+{
+  // The last tile spans 5 segments, and keeps its last sample at coarser
+  // levels
+  TerrainTiles terrain(std::vector<float>(70 * 2), 70, 2,
+      math::Vector3d(69, 1, 1), 64);
+  auto mesh = terrain.Build({1, 0, 2}, 0.0);
+  ASSERT_EQ(6u + 2u * 3u + 2u * 2u, mesh.positions.size());
+  EXPECT_DOUBLE_EQ(64 - 34.5, mesh.positions[0].X());
+  EXPECT_DOUBLE_EQ(68 - 34.5, mesh.positions[1].X());
+  EXPECT_DOUBLE_EQ(69 - 34.5, mesh.positions[2].X());
+}
+
+/////////////////////////////////////////////////
+TEST(TerrainTilesTest, Select)
+{
+  // 10x10 tiles of 8 m
+  TerrainTiles terrain(std::vector<float>(81 * 81), 81, 81,
+      math::Vector3d(80, 80, 1), 8);
+  EXPECT_EQ(10, terrain.TilesX());
+  EXPECT_EQ(3u, terrain.MaxLod());
+
+  // Camera over the corner of tile (0, 0)
+  const math::Vector3d camera(-39, -39, 5);
+  auto tiles = terrain.Select(camera, 12, 0);
+  ASSERT_EQ(4u, tiles.size());
+  EXPECT_EQ(0, tiles[0].x);
+  EXPECT_EQ(0, tiles[0].y);
+  for (const auto &tile : tiles)
+  {
+    EXPECT_LE(tile.x, 1);
+    EXPECT_LE(tile.y, 1);
+    EXPECT_EQ(0u, tile.lod);
+  }
+
+  // Coarser with distance, nearest first
+  tiles = terrain.Select(camera, 1000, 10);
+  ASSERT_EQ(100u, tiles.size());
+  EXPECT_EQ(0u, tiles[0].lod);
+  EXPECT_EQ(9, tiles.back().x);
+  EXPECT_EQ(9, tiles.back().y);
+  EXPECT_EQ(terrain.MaxLod(), tiles.back().lod);
+  for (const auto &tile : tiles)
+  {
+    // Tile 3 starts 23 m away, between 20 and 40 m
+    if (tile.x == 3 && tile.y == 0)
+    {
+      EXPECT_EQ(2u, tile.lod);
+    }
+  }
+
+  // Nothing when the camera is far outside
+  EXPECT_TRUE(terrain.Select(math::Vector3d(500, 0, 0), 100, 10).empty());
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <utility>
+
+#include "TextureLevels.hh"
+
+namespace gz::gui::plugins
+{
+/////////////////////////////////////////////////
+TexturePixels TextureLevels::Halve(const TexturePixels &_level)
+{
+  TexturePixels half;
+  half.channels = _level.channels;
+  if (_level.width == 0 || _level.height == 0 || _level.channels == 0 ||
+      _level.data.size() < static_cast<std::size_t>(_level.width) *
+          _level.height * _level.channels)
+  {
+    return half;
+  }
+
+  half.width = std::max(1u, _level.width / 2);
+  half.height = std::max(1u, _level.height / 2);
+  half.data.resize(static_cast<std::size_t>(half.width) * half.height *
+      half.channels);
+
+  // Odd sizes fold their last row or column into the pixels before it
+  const std::size_t rowBytes =
+      static_cast<std::size_t>(_level.width) * _level.channels;
+  for (unsigned int y = 0; y < half.height; ++y)
+  {
+    const unsigned int y0 = std::min(y * 2, _level.height - 1);
+    const unsigned int y1 = std::min(y * 2 + 1, _level.height - 1);
+    for (unsigned int x = 0; x < half.width; ++x)
+    {
+      const unsigned int x0 = std::min(x * 2, _level.width - 1);
+      const unsigned int x1 = std::min(x * 2 + 1, _level.width - 1);
+      const unsigned char *p00 =
+          &_level.data[y0 * rowBytes + x0 * _level.channels];
+      const unsigned char *p01 =
+          &_level.data[y0 * rowBytes + x1 * _level.channels];
+      const unsigned char *p10 =
+          &_level.data[y1 * rowBytes + x0 * _level.channels];
+      const unsigned char *p11 =
+          &_level.data[y1 * rowBytes + x1 * _level.channels];
+      unsigned char *out = &half.data[
+          (static_cast<std::size_t>(y) * half.width + x) * half.channels];
+      for (unsigned int c = 0; c < half.channels; ++c)
+      {
+        out[c] = static_cast<unsigned char>(
+            (p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+      }
+    }
+  }
+  return half;
+}
+
+/////////////////////////////////////////////////
+TexturePixels TextureLevels::Fit(TexturePixels _level,
+    unsigned int _maxSize)
+{
+  if (_maxSize == 0)
+    return _level;
+
+  while ((_level.width > _maxSize || _level.height > _maxSize) &&
+         !_level.data.empty())
+  {
+    _level = Halve(_level);
+  }
+  return _level;
+}
+
+/////////////////////////////////////////////////
+std::size_t TextureLevels::Bytes(unsigned int _width, unsigned int _height,
+    unsigned int _channels, bool _mipmaps)
+{
+  std::size_t bytes{0};
+  while (_width > 0 && _height > 0)
+  {
+    bytes += static_cast<std::size_t>(_width) * _height * _channels;
+    if (!_mipmaps || (_width == 1 && _height == 1))
+      break;
+    _width = std::max(1u, _width / 2);
+    _height = std::max(1u, _height / 2);
+  }
+  return bytes;
+}
+}  // namespace gz::gui::plugins
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TEXTURELEVELS_HH_
+#define GZ_GUI_PLUGINS_TEXTURELEVELS_HH_
+
+#include <cstddef>
+#include <vector>
+
+#ifndef _WIN32
+#  define TextureLevels_EXPORTS_API __attribute__ ((visibility ("default")))
+#else
+#  if (defined(TransportSceneManager_EXPORTS))
+#    define TextureLevels_EXPORTS_API __declspec(dllexport)
+#  else
+#    define TextureLevels_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace gz::gui::plugins
+{
+  /// \brief Pixels of a decoded texture, 8 bits per channel, rows top to
+  /// bottom without padding
+  struct TexturePixels
+  {
+    /// \brief Width in pixels
+    unsigned int width{0};
+
+    /// \brief Height in pixels
+    unsigned int height{0};
+
+    /// \brief Channels per pixel, such as 4 for RGBA
+    unsigned int channels{4};
+
+    /// \brief width * height * channels bytes
+    std::vector<unsigned char> data;
+  };
+
+  /// \brief Reduces textures decoded by the workers before they're
+  /// uploaded, so oversized textures don't take more GPU memory than they
+  /// can show, and estimates the memory they take once uploaded.
+  class TextureLevels_EXPORTS_API TextureLevels
+  {
+    /// \brief Get the next mip level of a texture: half its size, rounded
+    /// down but at least 1, each pixel the average of the up to 2x2 pixels
+    /// it covers
+    /// \param[in] _level Texture
+    /// \return Half size texture, empty if the texture is
+    /// empty
+    public: static TexturePixels Halve(const TexturePixels &_level);
+
+    /// \brief Halve a texture until neither side is larger than a size
+    /// \param[in] _level Texture
+    /// \param[in] _maxSize Largest width and height, zero for no limit
+    /// \return Texture which fits
+    public: static TexturePixels Fit(TexturePixels _level,
+        unsigned int _maxSize);
+
+    /// \brief Estimate the GPU memory a texture takes
+    /// \param[in] _width Width in pixels
+    /// \param[in] _height Height in pixels
+    /// \param[in] _channels Bytes per pixel
+    /// \param[in] _mipmaps Whether its whole mip chain is uploaded too
+    /// \return Bytes
+    public: static std::size_t Bytes(unsigned int _width,
+        unsigned int _height, unsigned int _channels, bool _mipmaps);
+  };
+}  // namespace gz::gui::plugins
+
+#endif  // GZ_GUI_PLUGINS_TEXTURELEVELS_HH_
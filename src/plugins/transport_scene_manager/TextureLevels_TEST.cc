@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "TextureLevels.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Make a one channel texture
+/// \param[in] _width Width
+/// \param[in] _height Height
+/// \param[in] _data Pixels
+/// \return Texture
+TexturePixels gray(unsigned int _width, unsigned int _height,
+    const std::vector<unsigned char> &_data)
+{
+  TexturePixels pixels;
+  pixels.width = _width;
+  pixels.height = _height;
+  pixels.channels = 1;
+  pixels.data = _data;
+  return pixels;
+}
+
+/////////////////////////////////////////////////
+TEST(TextureLevelsTest, Halve)
+{
+  auto half = TextureLevels::Halve(gray(4, 2,
+      {0, 4, 8, 8,
+       4, 8, 100, 200}));
+  EXPECT_EQ(2u, half.width);
+  EXPECT_EQ(1u, half.height);
+  EXPECT_EQ(std::vector<unsigned char>({4, 79}), half.data);
+
+  // All channels are averaged
+  TexturePixels rgba;
+  rgba.width = 2;
+  rgba.height = 2;
+  rgba.data = {0, 0, 0, 255,   255, 0, 0, 255,
+               0, 255, 0, 255, 0, 0, 255, 255};
+  half = TextureLevels::Halve(rgba);
+  EXPECT_EQ(1u, half.width);
+  EXPECT_EQ(1u, half.height);
+  EXPECT_EQ(std::vector<unsigned char>({64, 64, 64, 255}), half.data);
+
+  // The last column of odd sizes is folded in, and sides stay at least 1
+  half = TextureLevels::Halve(gray(3, 1, {0, 0, 40}));
+  EXPECT_EQ(1u, half.width);
+  EXPECT_EQ(1u, half.height);
+  EXPECT_EQ(std::vector<unsigned char>({0}), half.data);
+
+  // Not enough data
+  EXPECT_TRUE(TextureLevels::Halve(gray(2, 2, {1, 2})).data.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(TextureLevelsTest, Fit)
+{
+  auto pixels = gray(8, 2, std::vector<unsigned char>(16, 10));
+  auto fit = TextureLevels::Fit(pixels, 4);
+  EXPECT_EQ(4u, fit.width);
+  EXPECT_EQ(1u, fit.height);
+  EXPECT_EQ(std::vector<unsigned char>(4, 10), fit.data);
+
+  fit = TextureLevels::Fit(pixels, 1);
+  EXPECT_EQ(1u, fit.width);
+  EXPECT_EQ(1u, fit.height);
+
+  // Already fits, or no limit
+  EXPECT_EQ(8u, TextureLevels::Fit(pixels, 8).width);
+  EXPECT_EQ(8u, TextureLevels::Fit(pixels, 0).width);
+}
+
+/////////////////////////////////////////////////
+TEST(TextureLevelsTest, Bytes)
+{
+  EXPECT_EQ(64u, TextureLevels::Bytes(4, 4, 4, false));
+
+  // 4x4 + 2x2 + 1x1
+  EXPECT_EQ(84u, TextureLevels::Bytes(4, 4, 4, true));
+
+  // 4x1 + 2x1 + 1x1
+  EXPECT_EQ(7u, TextureLevels::Bytes(4, 1, 1, true));
+  EXPECT_EQ(0u, TextureLevels::Bytes(0, 4, 4, true));
+}
@@ -16,31 +16,63 @@
 */
 
 #include <algorithm>
-#include <gz/utils/ImplPtr.hh>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <gz/utils/ImplPtr.hh>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <QQmlProperty>
 
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/empty.pb.h>
 #include <gz/msgs/geometry.pb.h>
 #include <gz/msgs/light.pb.h>
 #include <gz/msgs/link.pb.h>
 #include <gz/msgs/material.pb.h>
 #include <gz/msgs/model.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/scene.pb.h>
 #include <gz/msgs/uint32_v.pb.h>
 #include <gz/msgs/visual.pb.h>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Image.hh>
+#include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/common/Util.hh>
+#include <gz/common/WorkerPool.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Matrix3.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Capsule.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
@@ -49,443 +81,4280 @@
 #include <gz/transport/TopicUtils.hh>
 
 #include "gz/gui/Application.hh"
+#include "gz/gui/AsyncRequests.hh"
 #include "gz/gui/Conversions.hh"
-#include "gz/gui/GuiEvents.hh"
-#include "gz/gui/MainWindow.hh"
+#include "gz/gui/GpuUploads.hh"
+#include "gz/gui/LatencyTrace.hh"
+#include "gz/gui/MemoryAccounting.hh"
+#include "gz/gui/NodePool.hh"
+#include "gz/gui/ProfileZone.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/RetainedMessage.hh"
+#include "gz/gui/SceneHistory.hh"
+#include "gz/gui/SceneIndex.hh"
+#include "gz/gui/SceneLabels.hh"
+#include "gz/gui/SceneSelection.hh"
+#include "gz/gui/SceneServices.hh"
+#include "gz/gui/SubscriptionHub.hh"
 
+#include "ContentHashes.hh"
+#include "CullingBvh.hh"
+#include "DeferredPoses.hh"
+#include "LightBudget.hh"
+#include "PackedPoses.hh"
+#include "PoseFilter.hh"
+#include "ResourceCache.hh"
+#include "TerrainTiles.hh"
+#include "TextureLevels.hh"
 #include "TransportSceneManager.hh"
 
 namespace gz::gui::plugins
 {
-/// \brief Private data class for TransportSceneManager
-class TransportSceneManager::Implementation
+namespace
 {
-  /// \brief Make the scene service request and populate the scene
-  public: void Request();
+/// \brief Last few poses received for an entity, used to interpolate
+/// between them. Fixed size so memory doesn't grow with the pose rate.
+class PoseHistory
+{
+  /// \brief Add a pose. Poses older than the newest one are dropped.
+  /// \param[in] _stamp Time of the pose in seconds
+  /// \param[in] _pose Pose
+  public: void Add(double _stamp, const math::Pose3d &_pose)
+  {
+    if (this->count > 0 && _stamp <= this->stamps[this->Index(0)])
+      return;
+    this->newest = (this->newest + 1) % kSize;
+    this->stamps[this->newest] = _stamp;
+    this->poses[this->newest] = _pose;
+    this->count = std::min(this->count + 1, kSize);
+  }
 
-  /// \brief Update the scene based on pose msgs received
-  public: void OnRender();
+  /// \brief Get the pose at a time, interpolating between the received
+  /// poses or extrapolating from the two newest ones.
+  /// \param[in] _time Time in seconds
+  /// \param[in] _maxExtrapolation Maximum time to extrapolate past the
+  /// newest pose, in seconds
+  /// \return Pose
+  public: math::Pose3d At(double _time, double _maxExtrapolation) const
+  {
+    const std::size_t latest = this->Index(0);
+    if (this->count < 2 || _time <= this->stamps[this->Index(this->count - 1)])
+    {
+      return this->count < 2 || _time >= this->stamps[latest] ?
+          this->poses[latest] : this->poses[this->Index(this->count - 1)];
+    }
 
-  /// \brief Initialize transport, subscribing to the necessary topics.
-  /// To be called after a valid scene has been found.
-  public: void InitializeTransport();
+    // Find the two poses around the time, or the two newest to extrapolate
+    std::size_t after = latest;
+    std::size_t before = this->Index(1);
+    for (std::size_t i = 1; i < this->count; ++i)
+    {
+      before = this->Index(i);
+      if (this->stamps[before] <= _time)
+        break;
+      after = before;
+    }
 
-  /// \brief Callback function for the pose topic
-  /// \param[in] _msg Pose vector msg
-  public: void OnPoseVMsg(const msgs::Pose_V &_msg);
+    double time = std::min(_time, this->stamps[latest] + _maxExtrapolation);
+    const double t = (time - this->stamps[before]) /
+        (this->stamps[after] - this->stamps[before]);
 
-  /// \brief Load the scene from a scene msg
-  /// \param[in] _msg Scene msg
-  public: void LoadScene(const msgs::Scene &_msg);
+    const auto &a = this->poses[before];
+    const auto &b = this->poses[after];
+    return math::Pose3d(a.Pos() + (b.Pos() - a.Pos()) * t,
+        math::Quaterniond::Slerp(t, a.Rot(), b.Rot(), true));
+  }
 
-  /// \brief Callback function for the request topic
-  /// \param[in] _msg Deletion message
-  public: void OnDeletionMsg(const msgs::UInt32_V &_msg);
+  /// \brief Stamp of the newest pose
+  /// \return Time in seconds
+  public: double Newest() const
+  {
+    return this->stamps[this->newest];
+  }
 
-  /// \brief Load the scene from a scene msg
-  /// \param[in] _msg Scene msg
-  public: void OnSceneSrvMsg(const msgs::Scene &_msg, const bool result);
+  /// \brief Index of a pose in the ring
+  /// \param[in] _age 0 for the newest pose, 1 for the one before...
+  /// \return Index in `stamps` and `poses`
+  private: std::size_t Index(std::size_t _age) const
+  {
+    return (this->newest + kSize - _age) % kSize;
+  }
 
-  /// \brief Called when there's an entity is added to the scene
-  /// \param[in] _msg Scene msg
-  public: void OnSceneMsg(const msgs::Scene &_msg);
+  /// \brief Number of poses kept
+  private: static constexpr std::size_t kSize{4};
 
-  /// \brief Load the model from a model msg
-  /// \param[in] _msg Model msg
-  /// \return Model visual created from the msg
-  public: rendering::VisualPtr LoadModel(const msgs::Model &_msg);
+  /// \brief Pose stamps, in seconds
+  private: std::array<double, kSize> stamps{};
 
-  /// \brief Load a link from a link msg
-  /// \param[in] _msg Link msg
-  /// \return Link visual created from the msg
-  public: rendering::VisualPtr LoadLink(const msgs::Link &_msg);
+  /// \brief Poses
+  private: std::array<math::Pose3d, kSize> poses;
 
-  /// \brief Load a visual from a visual msg
-  /// \param[in] _msg Visual msg
-  /// \return Visual visual created from the msg
-  public: rendering::VisualPtr LoadVisual(const msgs::Visual &_msg);
+  /// \brief Index of the newest pose
+  private: std::size_t newest{0};
 
-  /// \brief Load a geometry from a geometry msg
-  /// \param[in] _msg Geometry msg
-  /// \param[out] _scale Geometry scale that will be set based on msg param
-  /// \param[out] _localPose Additional local pose to be applied after the
-  /// visual's pose
-  /// \return Geometry object created from the msg
-  public: rendering::GeometryPtr LoadGeometry(const msgs::Geometry &_msg,
-      math::Vector3d &_scale, math::Pose3d &_localPose);
+  /// \brief Number of valid poses
+  private: std::size_t count{0};
+};
 
-  /// \brief Load a material from a material msg
-  /// \param[in] _msg Material msg
-  /// \return Material object created from the msg
-  public: rendering::MaterialPtr LoadMaterial(const msgs::Material &_msg);
+/// \brief Link collapsed into its parent with \<flatten\>. Its visuals and
+/// lights are children of the link's parent, posed by folding the link's
+/// pose into theirs. Shared by the entities of the link and of its visuals
+/// and lights.
+class FlatLink
+{
+  /// \brief Pose of the link in its parent
+  public: math::Pose3d pose;
 
-  /// \brief Load a light from a light msg
-  /// \param[in] _msg Light msg
-  /// \return Light object created from the msg
-  public: rendering::LightPtr LoadLight(const msgs::Light &_msg);
+  /// \brief Visuals and lights of the link, with their pose in the link
+  public: std::vector<std::pair<rendering::NodePtr::weak_type, math::Pose3d>>
+      children;
+};
 
-  /// \brief Delete an entity
-  /// \param[in] _entity Entity to delete
-  public: void DeleteEntity(const unsigned int _entity);
+/// \brief Rendering objects created for one entity
+class Entity
+{
+  /// \brief Visual for models, links and visuals
+  public: rendering::VisualPtr::weak_type visual;
 
-  //// \brief gz-transport scene service name
-  public: std::string service{"scene"};
+  /// \brief Light for lights
+  public: rendering::LightPtr::weak_type light;
 
-  //// \brief gz-transport pose topic name
-  public: std::string poseTopic{"pose"};
+  /// \brief True if `localPose` must be applied after the pose received
+  /// from transport. Most entities don't have one, so they skip the
+  /// multiplication.
+  public: bool needsLocalPose{false};
 
-  //// \brief gz-transport deletion topic name
-  public: std::string deletionTopic{"delete"};
+  /// \brief Additional local pose to be applied after the pose received
+  /// from transport.
+  /// This is currently used to handle the normal vector in plane visuals. In
+  /// general, this can be used to store any local transforms between the
+  /// parent Visual and geometry.
+  public: math::Pose3d localPose;
 
-  //// \brief gz-transport scene topic name
-  public: std::string sceneTopic{"scene"};
+  /// \brief Received poses, only used when interpolating
+  public: std::unique_ptr<PoseHistory> history;
 
-  //// \brief Pointer to the rendering scene
-  public: rendering::ScenePtr scene{nullptr};
+  /// \brief True while the entity is in the list of interpolated entities
+  public: bool interpolating{false};
 
-  //// \brief Mutex to protect the msgs
-  public: std::mutex msgMutex;
+  /// \brief Culling ids of the visuals with geometry under this entity,
+  /// whose boxes must be updated when it moves. Only filled when culling
+  /// or indexing the scene.
+  public: std::vector<std::size_t> cullIds;
 
-  /// \brief Map of entity id to pose
-  public: std::map<unsigned int, math::Pose3d> poses;
+  /// \brief Id of the top level model this entity belongs to. Only set
+  /// when static batching.
+  public: std::optional<unsigned int> batchModel;
 
-  /// \brief Map of entity id to initial local poses
-  /// This is currently used to handle the normal vector in plane visuals. In
-  /// general, this can be used to store any local transforms between the
-  /// parent Visual and geometry.
-  public: std::map<unsigned int, math::Pose3d> localPoses;
+  /// \brief Link collapsed with \<flatten\>, if the entity is that link,
+  /// or one of its visuals or lights
+  public: std::shared_ptr<FlatLink> flatLink;
+
+  /// \brief Index of the entity in the children of `flatLink`, unset for
+  /// the link itself
+  public: std::optional<std::size_t> flatChild;
+};
+
+/////////////////////////////////////////////////
+/// \brief Set the pose of an entity's visual or light
+/// \param[in] _entity Entity
+/// \param[in] _pose Pose received from transport
+/// \return False if the entity's visual or light doesn't exist anymore
+bool applyPose(Entity &_entity, const math::Pose3d &_pose)
+{
+  // Collapsed links have no node, their children are posed in the link's
+  // parent directly
+  if (_entity.flatLink)
+  {
+    auto &link = *_entity.flatLink;
+    if (!_entity.flatChild)
+    {
+      link.pose = _pose;
+      bool alive{false};
+      for (const auto &[weakNode, pose] : link.children)
+      {
+        if (auto node = weakNode.lock())
+        {
+          node->SetLocalPose(link.pose * pose);
+          alive = true;
+        }
+      }
+      return alive;
+    }
 
-  /// \brief Map of visual id to visual pointers.
-  public: std::map<unsigned int, rendering::VisualPtr::weak_type> visuals;
+    auto &child = link.children[*_entity.flatChild];
+    child.second = _entity.needsLocalPose ? _pose * _entity.localPose : _pose;
+    auto node = child.first.lock();
+    if (nullptr == node)
+      return false;
+    node->SetLocalPose(link.pose * child.second);
+    return true;
+  }
 
-  /// \brief Map of light id to light pointers.
-  public: std::map<unsigned int, rendering::LightPtr::weak_type> lights;
+  if (auto visual = _entity.visual.lock())
+  {
+    // apply additional local poses if needed
+    if (_entity.needsLocalPose)
+      visual->SetLocalPose(_pose * _entity.localPose);
+    else
+      visual->SetLocalPose(_pose);
+    return true;
+  }
+  if (auto light = _entity.light.lock())
+  {
+    light->SetLocalPose(_pose);
+    return true;
+  }
+  return false;
+}
 
-  /// Entities to be deleted
-  public: std::vector<unsigned int> toDeleteEntities;
+/// \brief Entities stored contiguously, with an index from entity id to
+/// slot, so the per-frame pose sweep is a hash lookup and a linear write
+/// per updated entity.
+class EntityTable
+{
+  /// \brief Get an entity, creating it if it doesn't exist yet
+  /// \param[in] _id Entity id
+  /// \return Entity. Invalidated by the next Insert or Erase.
+  public: Entity &Insert(unsigned int _id)
+  {
+    auto [it, inserted] = this->index.try_emplace(_id, this->dense.size());
+    if (inserted)
+    {
+      this->dense.emplace_back();
+      this->ids.push_back(_id);
+    }
+    return this->dense[it->second];
+  }
 
-  /// \brief Keeps the a list of unprocessed scene messages
-  public: std::vector<msgs::Scene> sceneMsgs;
+  /// \brief Find an entity
+  /// \param[in] _id Entity id
+  /// \return Entity or null if not found. Invalidated by the next Insert or
+  /// Erase.
+  public: Entity *Find(unsigned int _id)
+  {
+    auto it = this->index.find(_id);
+    if (it == this->index.end())
+      return nullptr;
+    return &this->dense[it->second];
+  }
 
-  /// \brief Transport node for making service request and subscribing to
-  /// pose topic
-  public: gz::transport::Node node;
+  /// \brief Remove an entity, if present. The last entity is moved into
+  /// the freed slot.
+  /// \param[in] _id Entity id
+  public: void Erase(unsigned int _id)
+  {
+    auto it = this->index.find(_id);
+    if (it == this->index.end())
+      return;
 
-  /// \brief Thread to wait for transport initialization
-  public: std::thread initializeTransport;
+    const std::size_t slot = it->second;
+    const std::size_t last = this->dense.size() - 1;
+    if (slot != last)
+    {
+      this->dense[slot] = std::move(this->dense[last]);
+      this->ids[slot] = this->ids[last];
+      this->index[this->ids[slot]] = slot;
+    }
+    this->dense.pop_back();
+    this->ids.pop_back();
+    this->index.erase(it);
+  }
+
+  /// \brief Entities, in no particular order
+  private: std::vector<Entity> dense;
+
+  /// \brief Id of the entity at the same slot in `dense`
+  private: std::vector<unsigned int> ids;
+
+  /// \brief Entity id to slot in `dense`
+  private: std::unordered_map<unsigned int, std::size_t> index;
+};
+
+/// \brief Model retained from the scene msg it came in
+using ModelHandle = std::shared_ptr<const msgs::Model>;
+
+/// \brief Light retained from the scene msg it came in
+using LightHandle = std::shared_ptr<const msgs::Light>;
+
+/// \brief A top level model or light waiting to be created
+class LoadTask
+{
+  /// \brief Entity id
+  /// \return Id of the model or light
+  public: unsigned int Id() const
+  {
+    return std::visit([](const auto &_msg) {return _msg->id();}, this->msg);
+  }
+
+  /// \brief Model to create
+  /// \return The model, null if it's a light
+  public: const msgs::Model *Model() const
+  {
+    auto model = std::get_if<ModelHandle>(&this->msg);
+    return nullptr == model ? nullptr : model->get();
+  }
+
+  /// \brief Light to create
+  /// \return The light, null if it's a model
+  public: const msgs::Light *Light() const
+  {
+    auto light = std::get_if<LightHandle>(&this->msg);
+    return nullptr == light ? nullptr : light->get();
+  }
+
+  /// \brief Model or light to create, never null
+  public: std::variant<ModelHandle, LightHandle> msg;
+
+  /// \brief True if the entity was already received with different
+  /// content, so the existing one must be replaced
+  public: bool replace{false};
+};
+
+/// \brief Level of detail state of a visual with geometry
+class LodVisual
+{
+  /// \brief Visual with the full geometry
+  public: rendering::VisualPtr::weak_type visual;
+
+  /// \brief Bounding box shown instead of the visual at mid range. Created
+  /// the first time it's needed.
+  public: rendering::VisualPtr::weak_type standIn;
+
+  /// \brief Bounds of the mesh in the visual frame, unscaled. Only meshes
+  /// have a stand-in, other geometries are already cheap.
+  public: std::optional<math::AxisAlignedBox> bounds;
+
+  /// \brief Bounds of the geometry in the visual frame, unscaled, for
+  /// culling. Geometries without them are never culled.
+  public: std::optional<math::AxisAlignedBox> cullBounds;
+
+  /// \brief Current level: 0 is full detail, 1 the stand-in and 2 hidden
+  public: int level{0};
+
+  /// \brief Id in the culling hierarchy, unique for the session
+  public: std::size_t cullId{0};
+
+  /// \brief Id of the visual's entity, its id in the scene index
+  public: unsigned int entityId{0};
+
+  /// \brief True while outside the view frustum
+  public: bool culled{false};
+
+  /// \brief Value of the culling frame counter when it was last found
+  /// inside the view frustum
+  public: std::uint64_t visibleFrame{0};
+};
+
+/// \brief Light whose rendering is decided by the light budget
+class BudgetedLight
+{
+  /// \brief Light
+  public: rendering::LightPtr::weak_type light;
+
+  /// \brief Node the light is attached to while active, and attached back
+  /// to when activated again
+  public: rendering::NodePtr::weak_type parent;
+
+  /// \brief Distance the light reaches, zero if unbounded
+  public: double range{0.0};
+
+  /// \brief Brightest channel of its diffuse color
+  public: double brightness{1.0};
+
+  /// \brief True for directional lights
+  public: bool directional{false};
+
+  /// \brief True if the msg asks for shadows
+  public: bool castShadows{false};
+
+  /// \brief False while detached from the scene graph
+  public: bool active{true};
+};
+
+/// \brief Geometry of a visual which may be merged into a static batch
+class BatchSource
+{
+  /// \brief Visual with the geometry
+  public: rendering::VisualPtr::weak_type visual;
+
+  /// \brief Name of the mesh in common::MeshManager
+  public: std::string meshName;
+
+  /// \brief Submesh used, empty for all
+  public: std::string subMesh;
+
+  /// \brief True if the submesh is centered at the origin
+  public: bool centerSubMesh{false};
+};
+
+/// \brief Cell of the static batching grid
+using BatchCellKey = std::array<int, 3>;
+
+/// \brief Top level model considered for static batching
+class BatchModel
+{
+  /// \brief Model visual
+  public: rendering::VisualPtr::weak_type visual;
+
+  /// \brief Geometries of the model and its children
+  public: std::vector<BatchSource> sources;
+
+  /// \brief True if the model is static, so it's batched right away
+  public: bool isStatic{false};
+
+  /// \brief When the model was loaded or last moved
+  public: std::chrono::steady_clock::time_point lastMoved;
+
+  /// \brief Cell whose batch the model is merged into, if any
+  public: std::optional<BatchCellKey> cell;
+};
+
+/// \brief Geometries of the settled models in a grid cell, merged into one
+/// mesh with a submesh per material
+class BatchCell
+{
+  /// \brief Ids of the models in the batch
+  public: std::vector<unsigned int> models;
+
+  /// \brief Visual with the merged mesh, null if nothing could be merged
+  public: rendering::VisualPtr merged;
+
+  /// \brief Name of the merged mesh in common::MeshManager
+  public: std::string meshName;
+
+  /// \brief Bytes reported to the memory account for the merged mesh
+  public: std::size_t bytes{0};
+
+  /// \brief Visuals detached from their parents while merged, kept alive
+  /// so they can be attached again
+  public: std::vector<std::pair<rendering::VisualPtr,
+      rendering::VisualPtr::weak_type>> detached;
+};
+
+/// \brief Tiles of a terrain built by the workers, waiting to be created by
+/// the render thread
+class TerrainResults
+{
+  /// \brief Protects the members
+  public: std::mutex mutex;
+
+  /// \brief Set once the heights have been read. Null until then, or if
+  /// they couldn't be read.
+  public: std::shared_ptr<const TerrainTiles> tiles;
+
+  /// \brief Tiles built since the render thread last took them
+  public: std::vector<std::pair<TerrainTiles::Tile, TerrainTiles::TileMesh>>
+      built;
+};
+
+/// \brief Tile of a terrain which has been created
+class TerrainTile
+{
+  /// \brief Visual with the tile's mesh
+  public: rendering::VisualPtr visual;
+
+  /// \brief Name of the tile's mesh in common::MeshManager
+  public: std::string meshName;
+
+  /// \brief Level of detail of the tile
+  public: unsigned int lod{0};
+
+  /// \brief Bytes reported to the memory account for the tile
+  public: std::size_t bytes{0};
+};
+
+/// \brief Heightmap whose tiles are created around the user camera
+class Terrain
+{
+  /// \brief Visual the tiles are attached to
+  public: rendering::VisualPtr::weak_type visual;
+
+  /// \brief Position of the terrain's center in the visual frame
+  public: math::Vector3d origin;
+
+  /// \brief How far the tile skirts hang down, in meters
+  public: double skirtDepth{1.0};
+
+  /// \brief Material of all tiles
+  public: rendering::MaterialPtr material;
+
+  /// \brief Copied from `results` once the heights have been read
+  public: std::shared_ptr<const TerrainTiles> tiles;
+
+  /// \brief Shared with the workers
+  public: std::shared_ptr<TerrainResults> results;
+
+  /// \brief Tiles created, by column and row
+  public: std::map<std::pair<int, int>, TerrainTile> loaded;
+
+  /// \brief Tiles being built by the workers, by column and row
+  public: std::set<std::pair<int, int>> building;
+};
+
+/// \brief Visual whose mesh is being parsed by a worker, shown as a box
+/// until the mesh is ready
+class MeshPlaceholder
+{
+  /// \brief Visual the mesh will be attached to
+  public: rendering::VisualPtr::weak_type visual;
+
+  /// \brief Box shown meanwhile, a child of `visual`
+  public: rendering::VisualPtr::weak_type box;
+
+  /// \brief Visual msg, to attach the mesh once ready
+  public: msgs::Visual msg;
+
+  /// \brief Models and links the visual was loaded under, outermost first
+  public: std::vector<unsigned int> ancestors;
+};
+
+/// \brief Texture map of a material
+enum class TextureSlot
+{
+  /// \brief Base color
+  ALBEDO,
+
+  /// \brief Normal map
+  NORMAL,
+
+  /// \brief Roughness map
+  ROUGHNESS,
+
+  /// \brief Metalness map
+  METALNESS,
+
+  /// \brief Emissive map
+  EMISSIVE
+};
+
+/// \brief Material waiting for a texture being decoded by a worker
+class TextureUser
+{
+  /// \brief Material the texture will be set on
+  public: rendering::MaterialPtr::weak_type material;
+
+  /// \brief Map the texture is for
+  public: TextureSlot slot{TextureSlot::ALBEDO};
+};
+
+/// \brief Meshes and materials loaded into a scene, shared by the managers
+/// showing worlds in it, so assets used by several worlds are loaded and
+/// counted once. Only accessed from the render thread, which all managers
+/// of a scene share, except what `queuedMutex` protects.
+class SceneAssets
+{
+  /// \brief Get the assets of a scene, created for the first manager
+  /// showing a world in it
+  /// \param[in] _scene Scene
+  /// \return Assets, kept while a manager holds them
+  public: static std::shared_ptr<SceneAssets> ForScene(
+      const rendering::ScenePtr &_scene)
+  {
+    static std::mutex mutex;
+    static std::map<const rendering::Scene *,
+        std::weak_ptr<SceneAssets>> assets;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = assets.begin(); it != assets.end();)
+    {
+      if (it->second.expired())
+        it = assets.erase(it);
+      else
+        ++it;
+    }
+
+    auto &weak = assets[_scene.get()];
+    auto shared = weak.lock();
+    if (nullptr == shared)
+    {
+      shared = std::make_shared<SceneAssets>();
+      weak = shared;
+    }
+    return shared;
+  }
+
+  /// \brief Descriptors of the meshes loaded so far, keyed by mesh file and
+  /// submesh. Scale is applied to the visual, so it isn't part of the key.
+  public: std::unordered_map<std::string, rendering::MeshDescriptor>
+      meshDescriptors;
+
+  /// \brief Materials shared between visuals, keyed by the material
+  /// parameters, see SharedMaterial
+  public: std::unordered_map<std::string, rendering::MaterialPtr> materials;
+
+  /// \brief Submesh materials shared between visuals of the same mesh, keyed
+  /// by mesh, submesh index, transparency and shadows. Sharing both the mesh
+  /// and the material lets the render engine batch identical visuals into
+  /// instanced draw calls.
+  public: std::unordered_map<std::string, rendering::MaterialPtr>
+      meshMaterials;
+
+  /// \brief Size and last use of each mesh file loaded, so meshes shared by
+  /// several descriptors are only counted once
+  public: ResourceCache meshCache;
+
+  /// \brief Visuals using each mesh file. Expired ones are pruned when
+  /// evicting.
+  public: std::unordered_map<std::string,
+      std::vector<rendering::VisualPtr::weak_type>> meshUsers;
+
+  /// \brief Reports an estimate of the vertex and index buffers of the
+  /// meshes loaded, assuming a position, normal and texture coordinate per
+  /// vertex and 32 bit indices. Without a GPU memory budget, meshes stay
+  /// loaded, so this never decreases.
+  public: MemoryAccount meshMemory{"TransportSceneManager", "meshes",
+      MemoryType::GPU};
+
+  /// \brief Number of static batches created so far, to name their meshes
+  public: std::size_t batchCount{0};
+
+  /// \brief Number of terrain tiles created so far, to name their meshes
+  public: std::size_t terrainTileCount{0};
+
+  /// \brief Protects `queuedMeshes`
+  public: std::mutex queuedMutex;
+
+  /// \brief Functions adding the mesh files each manager is about to load,
+  /// by manager, so they aren't evicted
+  public: std::map<const void *,
+      std::function<void(std::vector<std::string> &)>> queuedMeshes;
 };
 
 /////////////////////////////////////////////////
-TransportSceneManager::TransportSceneManager()
-  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+/// \brief Set a decoded texture on a material
+/// \param[in] _material Material
+/// \param[in] _slot Map the texture is for
+/// \param[in] _name Texture name, its file, so materials using the same
+/// file share it
+/// \param[in] _image Decoded texture
+void setTexture(const rendering::MaterialPtr &_material, TextureSlot _slot,
+    const std::string &_name, const std::shared_ptr<common::Image> &_image)
 {
+  switch (_slot)
+  {
+    case TextureSlot::ALBEDO:
+      _material->SetTexture(_name, _image);
+      break;
+    case TextureSlot::NORMAL:
+      _material->SetNormalMap(_name, _image);
+      break;
+    case TextureSlot::ROUGHNESS:
+      _material->SetRoughnessMap(_name, _image);
+      break;
+    case TextureSlot::METALNESS:
+      _material->SetMetalnessMap(_name, _image);
+      break;
+    case TextureSlot::EMISSIVE:
+      _material->SetEmissiveMap(_name, _image);
+      break;
+  }
 }
 
 /////////////////////////////////////////////////
-TransportSceneManager::~TransportSceneManager()
+/// \brief Collect the texture maps of a material
+/// \param[in] _msg Material msg
+/// \return Texture files and the map each is for
+std::vector<std::pair<std::string, TextureSlot>> textureMaps(
+    const msgs::Material &_msg)
 {
-  if (this->dataPtr->initializeTransport.joinable())
-    this->dataPtr->initializeTransport.join();
+  std::vector<std::pair<std::string, TextureSlot>> maps;
+  if (!_msg.has_pbr())
+    return maps;
+  const auto &pbr = _msg.pbr();
+  const std::pair<const std::string *, TextureSlot> all[] = {
+      {&pbr.albedo_map(), TextureSlot::ALBEDO},
+      {&pbr.normal_map(), TextureSlot::NORMAL},
+      {&pbr.roughness_map(), TextureSlot::ROUGHNESS},
+      {&pbr.metalness_map(), TextureSlot::METALNESS},
+      {&pbr.emissive_map(), TextureSlot::EMISSIVE}};
+  for (const auto &[file, slot] : all)
+  {
+    if (!file->empty())
+      maps.emplace_back(*file, slot);
+  }
+  return maps;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+/// \brief Compute the world box around a box given in a visual's frame
+/// \param[in] _local Box in the visual frame, unscaled
+/// \param[in] _pose World pose of the visual
+/// \param[in] _scale World scale of the visual
+/// \return Minimum and maximum corners of the world box
+std::pair<math::Vector3d, math::Vector3d> worldBox(
+    const math::AxisAlignedBox &_local, const math::Pose3d &_pose,
+    const math::Vector3d &_scale)
 {
-  if (this->title.empty())
-    this->title = "Transport Scene Manager";
+  const math::Vector3d center = _pose.Pos() +
+      _pose.Rot() * (_local.Center() * _scale);
+  const math::Vector3d half = _local.Size() * _scale * 0.5;
+  const math::Matrix3d rot(_pose.Rot());
+  math::Vector3d extent;
+  for (int i = 0; i < 3; ++i)
+  {
+    extent[i] = std::abs(rot(i, 0)) * std::abs(half.X()) +
+        std::abs(rot(i, 1)) * std::abs(half.Y()) +
+        std::abs(rot(i, 2)) * std::abs(half.Z());
+  }
+  return {center - extent, center + extent};
+}
+
+/////////////////////////////////////////////////
+/// \brief Compute the planes of a perspective camera's view frustum
+/// \param[in] _camera Camera, looking along its X axis
+/// \return Planes in the world frame, pointing inwards
+std::vector<CullPlane> frustumPlanes(const rendering::Camera &_camera)
+{
+  const double tanH = std::tan(_camera.HFOV().Radian() * 0.5);
+  const double tanV = tanH / std::max(1e-6, _camera.AspectRatio());
+
+  // In the camera frame, with Y to the left and Z up
+  std::vector<CullPlane> planes{
+    {math::Vector3d(1, 0, 0), -_camera.NearClipPlane()},
+    {math::Vector3d(-1, 0, 0), _camera.FarClipPlane()},
+    {math::Vector3d(tanH, -1, 0), 0.0},
+    {math::Vector3d(tanH, 1, 0), 0.0},
+    {math::Vector3d(tanV, 0, -1), 0.0},
+    {math::Vector3d(tanV, 0, 1), 0.0}
+  };
+
+  const math::Pose3d pose = _camera.WorldPose();
+  for (auto &plane : planes)
+  {
+    plane.normal = pose.Rot() * plane.normal;
+    plane.offset -= plane.normal.Dot(pose.Pos());
+  }
+  return planes;
+}
+
+/////////////////////////////////////////////////
+/// \brief Set a double parameter
+/// \param[in] _msg Msg
+/// \param[in] _key Parameter name
+/// \param[in] _value Value
+void setParam(msgs::Param &_msg, const std::string &_key, double _value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_DOUBLE);
+  any.set_double_value(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Key identifying the content of a mesh geometry, regardless of its
+/// scale
+/// \param[in] _msg Mesh msg
+/// \return Key
+std::string meshKey(const msgs::MeshGeom &_msg)
+{
+  return _msg.filename() + "\n" + _msg.submesh() + "\n" +
+      (_msg.center_submesh() ? "1" : "0");
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the mesh files used by a model and its children
+/// \param[in] _msg Model msg
+/// \param[out] _meshes Mesh file names
+void meshFiles(const msgs::Model &_msg, std::vector<std::string> &_meshes)
+{
+  for (const auto &link : _msg.link())
+  {
+    for (const auto &visual : link.visual())
+    {
+      if (visual.has_geometry() && visual.geometry().has_mesh() &&
+          !visual.geometry().mesh().filename().empty())
+      {
+        _meshes.push_back(visual.geometry().mesh().filename());
+      }
+    }
+  }
+  for (const auto &model : _msg.model())
+    meshFiles(model, _meshes);
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the texture files used by the materials of a model and
+/// its children
+/// \param[in] _msg Model msg
+/// \param[out] _textures Texture file names
+void textureFiles(const msgs::Model &_msg,
+    std::vector<std::string> &_textures)
+{
+  for (const auto &link : _msg.link())
+  {
+    for (const auto &visual : link.visual())
+    {
+      if (!visual.has_material())
+        continue;
+      for (const auto &map : textureMaps(visual.material()))
+        _textures.push_back(map.first);
+    }
+  }
+  for (const auto &model : _msg.model())
+    textureFiles(model, _textures);
+}
+
+/////////////////////////////////////////////////
+/// \brief Collect the ids of the links, visuals, lights and nested models
+/// of a model
+/// \param[in] _msg Model msg
+/// \param[out] _ids Entity ids
+void childIds(const msgs::Model &_msg, std::vector<unsigned int> &_ids)
+{
+  for (const auto &link : _msg.link())
+  {
+    _ids.push_back(link.id());
+    for (const auto &visual : link.visual())
+      _ids.push_back(visual.id());
+    for (const auto &light : link.light())
+      _ids.push_back(light.id());
+  }
+  for (const auto &model : _msg.model())
+  {
+    _ids.push_back(model.id());
+    childIds(model, _ids);
+  }
+}
+}  // namespace
+
+/// \brief Private data class for TransportSceneManager
+class TransportSceneManager::Implementation
+{
+  /// \brief Wait for the scene service and request the scene, then keep
+  /// watching the service and request the scene again whenever the server
+  /// restarts. Returns once `Stop` is called.
+  public: void Request();
+
+  /// \brief Sleep unless stopped
+  /// \param[in] _duration Time to sleep
+  /// \return False if stopped, in which case the caller should return
+  public: bool Sleep(std::chrono::steady_clock::duration _duration);
+
+  /// \brief Interrupt Request and wait for its thread to finish
+  public: void Stop();
+
+  /// \brief Update the scene based on pose msgs received
+  public: void OnRender();
+
+  /// \brief Initialize transport, subscribing to the necessary topics.
+  /// To be called after a valid scene has been found.
+  public: void InitializeTransport();
+
+  /// \brief Callback function for the pose topic
+  /// \param[in] _msg Pose vector msg
+  /// \param[in] _source Subscription of the msg
+  public: void OnPoseVMsg(const msgs::Pose_V &_msg,
+      const HubSubscription &_source);
+
+  /// \brief Callback function for the packed pose topic, and for the pose
+  /// topic when following another GUI's render state
+  /// \param[in] _msg Poses encoded by PackedPoses
+  /// \param[in] _source Subscription of the msg
+  public: void OnPackedPosesMsg(const msgs::Bytes &_msg,
+      const HubSubscription &_source);
+
+  /// \brief Answer another GUI asking for the render state's scene
+  /// \param[out] _rep Latest content of all models and lights
+  /// \return True
+  public: bool OnRenderStateRequest(msgs::Scene &_rep);
+
+  /// \brief Forward deletions to the GUIs following the render state
+  /// \param[in] _ids Deleted entities
+  public: void PublishRenderStateDeletions(
+      const std::vector<unsigned int> &_ids);
+
+  /// \brief Queue the models and lights of a scene msg to be created by
+  /// the render thread, and start parsing their meshes on the workers.
+  /// The models and lights are retained from the msg, not copied.
+  /// \param[in] _msg Scene msg
+  public: void QueueScene(const std::shared_ptr<const msgs::Scene> &_msg);
+
+  /// \brief Queue the scene saved by the last session, if any, so it's
+  /// shown before the server answers
+  public: void LoadSceneCache();
+
+  /// \brief Save a scene received from the service for the next session,
+  /// and delete the entities loaded from the cache which aren't in it
+  /// anymore
+  /// \param[in] _msg Scene msg
+  public: void UpdateSceneCache(const msgs::Scene &_msg);
+
+  /// \brief Create queued models and lights until the time budget for this
+  /// frame is used up.
+  public: void LoadQueued();
+
+  /// \brief Create a model or light and add it to the scene
+  /// \param[in] _task Model or light to create
+  public: void Load(const LoadTask &_task);
+
+  /// \brief Report the load progress if it changed
+  public: void ReportLoadProgress();
+
+  /// \brief Get the user camera, once MinimalScene has created it
+  /// \return Camera, null if there's none yet
+  public: rendering::CameraPtr UserCamera();
+
+  /// \brief Update the world boxes of the visuals which moved, hide the
+  /// visuals outside the user camera's view frustum and show those inside,
+  /// and report how many there are of each
+  public: void UpdateCulling();
+
+  /// \brief Find the nodes the user camera follows or tracks, and their
+  /// ancestors, whose poses are never deferred
+  public: void UpdateCameraTargets();
+
+  /// \brief Whether the poses of an entity can be deferred: all its
+  /// visuals with geometry are outside the view, and it isn't selected or
+  /// followed by the camera. See \<lazy_poses\>.
+  /// \param[in] _id Entity id
+  /// \param[in] _entity Entity
+  /// \param[in] _selection Selected entities, may be null
+  /// \return True if its poses can be deferred
+  public: bool CanDeferPose(unsigned int _id, const Entity &_entity,
+      const SceneSelection *_selection) const;
+
+  /// \brief Keep the latest pose of an entity instead of applying it
+  /// \param[in] _id Entity id
+  /// \param[in] _entity Entity, whose poses can be deferred
+  /// \param[in] _pose Pose received from transport
+  public: void DeferPose(unsigned int _id, const Entity &_entity,
+      const math::Pose3d &_pose);
+
+  /// \brief Apply the deferred poses of the entities which may have come
+  /// into view, or been selected or followed since
+  /// \param[in] _all True to apply all of them
+  public: void ApplyDeferredPoses(bool _all);
+
+  /// \brief Choose the lights rendered for the user camera's view, and
+  /// attach or detach the lights whose state changed
+  public: void UpdateLights();
+
+  /// \brief Record what was received this frame in the scene history
+  /// \param[in] _loadTasks Models and lights received
+  /// \param[in] _deletions Entities deleted
+  public: void RecordHistory(const std::vector<LoadTask> &_loadTasks,
+      const std::vector<unsigned int> &_deletions);
+
+  /// \brief Show the scene as it was at a time of its history. Entities
+  /// added since are taken out of the scene graph, and those deleted
+  /// since are created again.
+  /// \param[in] _time Time of the scene history
+  public: void ShowHistory(double _time);
+
+  /// \brief Undo ShowHistory, and show the latest poses
+  public: void ShowLive();
+
+  /// \brief Remove an entry of `lodVisuals`, along with its stand-in
+  /// \param[in] _index Index of the entry. The last entry is moved there.
+  public: void RemoveLodVisual(std::size_t _index);
+
+  /// \brief Unload the least recently used meshes which aren't used by any
+  /// visual or queued model, until the loaded meshes fit in the GPU memory
+  /// budget
+  public: void EvictMeshes();
+
+  /// \brief Update the level of detail of the next batch of visuals based
+  /// on their distance to the user camera
+  public: void UpdateLod();
+
+  /// \brief Merge the geometries of the models which haven't moved for a
+  /// while into per cell batches
+  public: void UpdateBatching();
+
+  /// \brief Merge the geometries of models into a batch
+  /// \param[in] _key Cell of the batch
+  /// \param[in] _models Ids of the models
+  public: void BuildBatch(const BatchCellKey &_key,
+      const std::vector<unsigned int> &_models);
+
+  /// \brief Destroy a batch, attaching its visuals back to their parents
+  /// \param[in] _key Cell of the batch
+  public: void DissolveBatch(const BatchCellKey &_key);
+
+  /// \brief Take a model out of its batch because it moved
+  /// \param[in] _id Model id
+  public: void OnModelMoved(unsigned int _id);
+
+  /// \brief Start reading a heightmap on the workers. Its tiles are
+  /// created later by UpdateTerrain.
+  /// \param[in] _visual Visual the tiles are attached to
+  /// \param[in] _msg Visual msg with a heightmap geometry
+  public: void LoadTerrain(const rendering::VisualPtr &_visual,
+      const msgs::Visual &_msg);
+
+  /// \brief Create the terrain tiles built by the workers, destroy the
+  /// ones left behind by the user camera, and queue the ones around it
+  public: void UpdateTerrain();
+
+  /// \brief Create the visual of a terrain tile, replacing the same tile
+  /// at another level of detail
+  /// \param[in] _terrain Terrain
+  /// \param[in] _parent Locked `_terrain.visual`
+  /// \param[in] _tile Tile
+  /// \param[in] _mesh Triangles of the tile
+  public: void CreateTerrainTile(Terrain &_terrain,
+      const rendering::VisualPtr &_parent, const TerrainTiles::Tile &_tile,
+      const TerrainTiles::TileMesh &_mesh);
+
+  /// \brief Destroy the visual and mesh of a terrain tile
+  /// \param[in] _tile Tile
+  public: void DestroyTerrainTile(const TerrainTile &_tile);
+
+  /// \brief Show a visual at a level of detail
+  /// \param[in] _lod Visual
+  /// \param[in] _visual Locked `_lod.visual`
+  /// \param[in] _level New level
+  public: void SetLodLevel(LodVisual &_lod,
+      const rendering::VisualPtr &_visual, int _level);
+
+  /// \brief Callback function for the request topic
+  /// \param[in] _msg Deletion message
+  public: void OnDeletionMsg(const msgs::UInt32_V &_msg);
+
+  /// \brief Load the scene from a scene msg
+  /// \param[in] _msg Scene msg
+  public: void OnSceneSrvMsg(const msgs::Scene &_msg, const bool result);
+
+  /// \brief Called when there's an entity is added to the scene
+  /// \param[in] _msg Scene msg
+  public: void OnSceneMsg(const std::shared_ptr<const msgs::Scene> &_msg);
+
+  /// \brief Load the model from a model msg
+  /// \param[in] _msg Model msg
+  /// \return Model visual created from the msg
+  public: rendering::VisualPtr LoadModel(const msgs::Model &_msg);
+
+  /// \brief Load a link from a link msg
+  /// \param[in] _msg Link msg
+  /// \return Link visual created from the msg
+  public: rendering::VisualPtr LoadLink(const msgs::Link &_msg);
+
+  /// \brief Load the visuals and lights of a link into the link's parent,
+  /// without a node for the link, see \<flatten\>
+  /// \param[in] _msg Link msg
+  /// \param[in] _parent Visual of the link's model
+  public: void LoadFlatLink(const msgs::Link &_msg,
+      const rendering::VisualPtr &_parent);
+
+  /// \brief Load a visual from a visual msg
+  /// \param[in] _msg Visual msg
+  /// \return Visual visual created from the msg
+  public: rendering::VisualPtr LoadVisual(const msgs::Visual &_msg);
+
+  /// \brief Attach the geometry and material of a visual msg to its
+  /// visual, and register it for level of detail, culling and batching
+  /// under the current `loadAncestors`
+  /// \param[in] _visual Visual
+  /// \param[in] _msg Visual msg
+  public: void AttachGeometry(const rendering::VisualPtr &_visual,
+      const msgs::Visual &_msg);
+
+  /// \brief Parse a mesh file on the workers, unless it's already loaded
+  /// or being parsed. Called from any thread.
+  /// \param[in] _file Mesh file
+  public: void ParseMesh(const std::string &_file);
+
+  /// \brief Replace the placeholders of the meshes parsed since the last
+  /// frame with their meshes
+  public: void AttachParsedMeshes();
+
+  /// \brief Decode a texture file on the workers, unless it's already
+  /// decoded or being decoded. Called from any thread.
+  /// \param[in] _file Texture file
+  public: void DecodeTexture(const std::string &_file);
+
+  /// \brief Set the textures decoded since the last frame on the materials
+  /// waiting for them
+  public: void AttachDecodedTextures();
+
+  /// \brief Set a texture on a material now if it's decoded, or once it is
+  /// \param[in] _material Material
+  /// \param[in] _slot Map the texture is for
+  /// \param[in] _file Texture file
+  public: void UseTexture(const rendering::MaterialPtr &_material,
+      TextureSlot _slot, const std::string &_file);
+
+  /// \brief Load a geometry from a geometry msg
+  /// \param[in] _msg Geometry msg
+  /// \param[out] _scale Geometry scale that will be set based on msg param
+  /// \param[out] _localPose Additional local pose to be applied after the
+  /// visual's pose
+  /// \return Geometry object created from the msg
+  public: rendering::GeometryPtr LoadGeometry(const msgs::Geometry &_msg,
+      math::Vector3d &_scale, math::Pose3d &_localPose);
+
+  /// \brief Load a material from a material msg
+  /// \param[in] _msg Material msg
+  /// \return Material object created from the msg
+  public: rendering::MaterialPtr LoadMaterial(const msgs::Material &_msg);
+
+  /// \brief Get the material shared by all visuals with the same material
+  /// parameters, creating it the first time.
+  /// \param[in] _msg Material msg, null for the default material
+  /// \param[in] _transparency Visual transparency
+  /// \param[in] _castShadows Whether the visual casts shadows
+  /// \return Shared material
+  public: rendering::MaterialPtr SharedMaterial(const msgs::Material *_msg,
+      double _transparency, bool _castShadows);
+
+  /// \brief Load a light from a light msg
+  /// \param[in] _msg Light msg
+  /// \return Light object created from the msg
+  public: rendering::LightPtr LoadLight(const msgs::Light &_msg);
+
+  /// \brief Delete an entity
+  /// \param[in] _entity Entity to delete
+  /// \param[in] _deferred True to only take it out of the scene graph, and
+  /// destroy it later with DestroyQueued
+  public: void DeleteEntity(const unsigned int _entity,
+      bool _deferred = false);
+
+  /// \brief Destroy the deleted visuals and lights waiting in
+  /// `destroyQueue`, until the time budget for this frame is used up
+  /// \param[in] _all True to destroy all of them regardless of the budget
+  /// \return Number destroyed
+  public: std::size_t DestroyQueued(bool _all);
+
+  //// \brief gz-transport scene service name
+  public: std::string service{"scene"};
+
+  //// \brief gz-transport pose topic name
+  public: std::string poseTopic{"pose"};
+
+  //// \brief gz-transport topic carrying poses encoded by PackedPoses.
+  /// Empty if not used.
+  public: std::string packedPoseTopic;
+
+  //// \brief gz-transport deletion topic name
+  public: std::string deletionTopic{"delete"};
+
+  //// \brief gz-transport scene topic name
+  public: std::string sceneTopic{"scene"};
+
+  //// \brief gz-transport topic carrying only added and modified entities.
+  /// Empty if not used.
+  public: std::string incrementalSceneTopic;
+
+  /// \brief True to receive the scene topics through shared memory from
+  /// publishers on the same host
+  public: bool sharedMemory{true};
+
+  /// \brief True to publish how fast the pose topics are consumed, so
+  /// their publishers can adapt
+  public: bool feedback{false};
+
+  /// \brief True to collapse links into their model, see \<flatten\>
+  public: bool flatten{false};
+
+  /// \brief Subscription to the scene topic, shared with other plugins
+  public: HubSubscription sceneSubscription;
+
+  /// \brief Subscription to the pose topic. Only moved into with
+  /// `msgMutex` locked, since its callbacks use it with it locked.
+  public: HubSubscription poseSubscription;
+
+  /// \brief Subscription to the packed pose topic, like `poseSubscription`
+  public: HubSubscription packedPoseSubscription;
+
+  /// \brief Subscription to the incremental scene topic
+  public: HubSubscription incrementalSceneSubscription;
+
+  /// \brief Subscription to the deletion topic
+  public: HubSubscription deletionSubscription;
+
+  /// \brief Protects `contentHashes`. Serializes scene messages coming from
+  /// different transport threads, never taken by the render thread.
+  public: std::mutex sceneMutex;
+
+  /// \brief Content hash of each top level model and light received, used
+  /// to skip the ones which didn't change when the scene is published again
+  public: ContentHashes contentHashes;
+
+  /// \brief File the scene is cached in between sessions, empty if not
+  /// caching
+  public: std::string sceneCacheFile;
+
+  /// \brief Ids of the models and lights loaded from the scene cache which
+  /// the server hasn't confirmed yet. Protected by `sceneMutex`.
+  public: std::unordered_set<unsigned int> cachedIds;
+
+  //// \brief Pointer to the rendering scene
+  public: rendering::ScenePtr scene{nullptr};
+
+  /// \brief Meshes and materials of the scene, shared with the managers
+  /// showing other worlds in it. Set with `scene`.
+  public: std::shared_ptr<SceneAssets> assets;
+
+  /// \brief Visual top level models and lights are added to, the scene's
+  /// root visual unless the world is shown in a region. Set with `scene`.
+  public: rendering::VisualPtr root;
+
+  /// \brief Pose of the region the world is shown in, within the scene,
+  /// see \<region\>
+  public: std::optional<math::Pose3d> regionPose;
+
+  /// \brief Added to entity ids in the scene index and the selection, so
+  /// the ids of several worlds don't collide
+  public: unsigned int idOffset{0};
+
+  //// \brief Mutex to protect the msgs. It's only held to append to or
+  /// swap out the pending buffers, never while touching the scene, so the
+  /// transport and render threads don't wait on each other.
+  public: std::mutex msgMutex;
+
+  /// \brief Protects `poseFilter`, which is used by the transport threads
+  /// and given the camera position by the render thread
+  public: std::mutex filterMutex;
+
+  /// \brief Drops the poses of models which aren't of interest, see
+  /// \<pose_filter\>
+  public: PoseFilter poseFilter;
+
+  /// \brief True to show the names of top level models, see \<labels\>
+  public: bool labels{false};
+
+  /// \brief Height of the names above the model origins, in meters
+  public: double labelHeight{1.0};
+
+  /// \brief Entity id and pose
+  public: class PoseUpdate
+  {
+    /// \brief Entity id
+    public: unsigned int id;
+
+    /// \brief Pose
+    public: math::Pose3d pose;
+
+    /// \brief Time of the pose in seconds, negative if not interpolating
+    public: double stamp;
+  };
+
+  /// \brief Pose updates in the order they were received
+  public: using PoseBuffer = std::vector<PoseUpdate>;
+
+  /// \brief Filter received poses and hand them to the render thread
+  /// \param[in] _poses Poses, in the order received
+  /// \param[in] _stamp Time of the poses in seconds, negative if not
+  /// interpolating
+  /// \param[in] _arrival When they were received
+  /// \param[in] _tag Latency trace tag of their msg
+  /// \param[in] _source Subscription of their msg, told when it's merged
+  /// with one the render thread hasn't taken yet
+  public: void QueuePoses(PoseBuffer &_poses, double _stamp,
+      std::chrono::steady_clock::time_point _arrival,
+      const LatencyTrace::Tag &_tag, const HubSubscription &_source);
+
+  /// \brief Poses received since the last frame. Filled by the transport
+  /// thread, swapped with `renderPoses` by the render thread.
+  public: PoseBuffer pendingPoses;
+
+  /// \brief Poses being applied by the render thread. Only accessed from
+  /// the render thread.
+  public: PoseBuffer renderPoses;
+
+  /// \brief Latency trace tags of the msgs in `pendingPoses`, when
+  /// tracing
+  public: std::vector<LatencyTrace::Tag> pendingTags;
+
+  /// \brief Latency trace tags of the msgs in `renderPoses`. Only accessed
+  /// from the render thread.
+  public: std::vector<LatencyTrace::Tag> renderTags;
+
+  /// \brief True to interpolate between received poses, see
+  /// \<interpolation\>
+  public: bool interpolate{false};
+
+  /// \brief How far behind the newest pose stamp entities are rendered, in
+  /// seconds
+  public: double interpolationDelay{0.05};
+
+  /// \brief Maximum time to extrapolate past the newest pose, in seconds
+  public: double maxExtrapolation{0.1};
+
+  /// \brief Stamp of the newest pose msg, in seconds. Protected by
+  /// `msgMutex`.
+  public: double pendingStamp{-1.0};
+
+  /// \brief When the newest pose msg arrived. Protected by `msgMutex`.
+  public: std::chrono::steady_clock::time_point pendingArrival;
+
+  /// \brief Ids of the entities being interpolated. Only accessed from the
+  /// render thread.
+  public: std::vector<unsigned int> interpolated;
+
+  /// \brief Visuals, lights and local poses of all loaded entities. Only
+  /// accessed from the render thread.
+  public: EntityTable entities;
+
+  /// \brief Visuals with geometry whose level of detail, culling and
+  /// world boxes are updated. Empty unless level of detail, culling or the
+  /// scene index is enabled.
+  public: std::vector<LodVisual> lodVisuals;
+
+  /// \brief True to hide visuals outside the user camera's view frustum
+  public: bool culling{false};
+
+  /// \brief Hierarchy over the world boxes of `lodVisuals`, by cull id
+  public: CullingBvh cullBvh;
+
+  /// \brief Index over the world boxes of `lodVisuals`, by entity id,
+  /// shared with other plugins, see \<scene_index\>. Null unless enabled.
+  public: std::shared_ptr<SceneIndex> sceneIndex;
+
+  /// \brief True if visuals were added or removed since `cullBvh` was
+  /// built, or the boxes of all of them must be set again
+  public: bool cullDirty{false};
+
+  /// \brief Index in `lodVisuals` of each cull id
+  public: std::unordered_map<std::size_t, std::size_t> cullIndex;
+
+  /// \brief Cull ids of the visuals which moved since the last frame
+  public: std::vector<std::size_t> cullMoved;
+
+  /// \brief Last cull id given out
+  public: std::size_t lastCullId{0};
+
+  /// \brief Incremented each frame culling runs
+  public: std::uint64_t cullFrame{0};
+
+  /// \brief True to defer the poses of entities outside the view, see
+  /// \<lazy_poses\>
+  public: bool lazyPoses{false};
+
+  /// \brief Latest poses of entities outside the view, not applied yet
+  public: DeferredPoses deferredPoses;
+
+  /// \brief Ids of the nodes the user camera follows or tracks, and of
+  /// their ancestors. Updated each frame.
+  public: std::unordered_set<unsigned int> cameraTargetNodes;
+
+  /// \brief True to only render the lights contributing the most to the
+  /// view, see \<light_budget\>
+  public: bool budgetingLights{false};
+
+  /// \brief Chooses the lights rendered
+  public: LightBudget lightBudget;
+
+  /// \brief Lights known to the budget, by entity id. Only used in the
+  /// render thread.
+  public: std::unordered_map<unsigned int, BudgetedLight> budgetedLights;
+
+  /// \brief True if lights were added or removed since they were chosen
+  public: bool lightsDirty{false};
+
+  /// \brief Camera pose when the lights were last chosen
+  public: math::Pose3d lightsCameraPose;
+
+  /// \brief When the lights were last chosen
+  public: std::chrono::steady_clock::time_point lastLightUpdate;
+
+  /// \brief Recent history of the scene, shared with other plugins, see
+  /// \<history\>. Null unless enabled.
+  public: std::shared_ptr<SceneHistory> sceneHistory;
+
+  /// \brief Start of the scene history's clock
+  public: std::chrono::steady_clock::time_point historyEpoch;
+
+  /// \brief Poses recorded this frame, kept to reuse their memory
+  public: std::vector<SceneHistory::Pose> historyPoses;
+
+  /// \brief Time of the scene history shown, unset while live
+  public: std::optional<double> historyShown;
+
+  /// \brief Ids of the loaded models and lights, only kept while
+  /// recording the scene history
+  public: std::unordered_set<unsigned int> topLevelIds;
+
+  /// \brief Models and lights taken out of the scene graph because they
+  /// didn't exist yet at the time shown, by entity id
+  public: std::unordered_map<unsigned int, rendering::NodePtr> historyHidden;
+
+  /// \brief Models and lights created again from the scene history
+  /// because they were deleted since the time shown
+  public: std::unordered_set<unsigned int> historyGhosts;
+
+  /// \brief Ids of the models and links being loaded, outermost first, so
+  /// their visuals can be updated when they move
+  public: std::vector<unsigned int> loadAncestors;
+
+  /// \brief Publishes the culling statistics, if a topic was set
+  public: transport::Node::Publisher cullStatsPub;
+
+  /// \brief Prefix of the render state topics and service, see
+  /// \<render_state\>
+  public: std::string renderStateTopic{"/render_state"};
+
+  /// \brief True if poses come packed from another GUI's render state
+  public: bool renderStateSubscribe{false};
+
+  /// \brief Publishes the render state poses, if publishing
+  public: transport::Node::Publisher renderStatePosePub;
+
+  /// \brief Publishes the models and lights which changed, if publishing
+  public: transport::Node::Publisher renderStateScenePub;
+
+  /// \brief Publishes deletions, if publishing
+  public: transport::Node::Publisher renderStateDeletionPub;
+
+  /// \brief Latest content of each top level model and light, served to
+  /// GUIs which start following the render state. Only kept if
+  /// publishing. Protected by `sceneMutex`.
+  public: std::map<unsigned int, ModelHandle> renderStateModels;
+
+  /// \brief See `renderStateModels`
+  public: std::map<unsigned int, LightHandle> renderStateLights;
+
+  /// \brief When the culling statistics were last published
+  public: std::chrono::steady_clock::time_point lastCullStats;
+
+  /// \brief True to merge the geometries of models which don't move
+  public: bool batching{false};
+
+  /// \brief How long a model must stay still before being batched
+  public: std::chrono::steady_clock::duration batchSettleTime{
+      std::chrono::seconds(5)};
+
+  /// \brief Size of the batching grid cells, in meters
+  public: double batchCellSize{20.0};
+
+  /// \brief Top level models which may be batched, by id
+  public: std::unordered_map<unsigned int, BatchModel> batchModels;
+
+  /// \brief Batches by cell
+  public: std::map<BatchCellKey, BatchCell> batchCells;
+
+  /// \brief When the models were last checked for batching
+  public: std::chrono::steady_clock::time_point lastBatchCheck;
+
+  /// \brief Reports the size of the merged meshes, estimated as for
+  /// `meshMemory`
+  public: MemoryAccount batchMemory{"TransportSceneManager",
+      "static batches", MemoryType::GPU};
+
+  /// \brief Heightmaps being streamed
+  public: std::vector<Terrain> terrains;
+
+  /// \brief Segments along each side of a terrain tile at full detail
+  public: unsigned int terrainTileSegments{64};
+
+  /// \brief Terrain tiles farther than this from the camera aren't
+  /// created, in meters
+  public: double terrainLoadRadius{1000.0};
+
+  /// \brief Distance at which terrain tiles drop to the first coarser
+  /// level, in meters
+  public: double terrainLodDistance{100.0};
+
+  /// \brief Reports the size of the terrain tiles, estimated as for
+  /// `meshMemory`
+  public: MemoryAccount terrainMemory{"TransportSceneManager", "terrain",
+      MemoryType::GPU};
+
+  /// \brief Meshes farther than this from the camera are shown as their
+  /// bounding box. Zero disables.
+  public: double lodBoxDistance{0.0};
+
+  /// \brief Visuals farther than this from the camera are hidden. Zero
+  /// disables.
+  public: double lodHideDistance{0.0};
+
+  /// \brief Number of visuals evaluated each frame
+  public: std::size_t lodBatchSize{1000};
+
+  /// \brief Next visual to evaluate in `lodVisuals`
+  public: std::size_t lodCursor{0};
+
+  /// \brief Camera the distances are measured from
+  public: rendering::CameraPtr::weak_type userCamera;
+
+  /// \brief Most memory the loaded meshes may take before unused ones are
+  /// unloaded, in bytes. Zero keeps all meshes loaded.
+  public: std::size_t gpuMemoryBudget{0};
+
+  /// Entities to be deleted
+  public: std::vector<unsigned int> toDeleteEntities;
+
+  /// \brief Visuals and lights of deleted entities, already out of the
+  /// scene graph, waiting to be destroyed. Destroying a model destroys all
+  /// its descendants, so large deletions are spread over several frames.
+  public: std::deque<rendering::NodePtr> destroyQueue;
+
+  /// \brief Models and lights received since the last frame. Filled by the
+  /// transport thread, moved to `loadTasks` by the render thread.
+  public: std::vector<LoadTask> pendingLoadTasks;
+
+  /// \brief Models and lights waiting to be created, in the order they were
+  /// received. Only accessed from the render thread.
+  public: std::deque<LoadTask> loadTasks;
+
+  /// \brief Time the render thread may spend creating entities each frame.
+  /// Zero loads everything as soon as it's received.
+  public: std::chrono::steady_clock::duration loadBudget{
+      std::chrono::milliseconds(10)};
+
+  /// \brief Tasks queued since the queue was last empty
+  public: std::size_t loadTotal{0};
+
+  /// \brief Tasks completed since the queue was last empty
+  public: std::size_t loadDone{0};
+
+  /// \brief Last progress reported, in percent
+  public: int reportedProgress{100};
+
+  /// \brief Called from the render thread with the fraction of the queued
+  /// entities which have been created
+  public: std::function<void(double)> loadProgressCb;
+
+  /// \brief Load progress shown on the GUI. Only accessed from the main
+  /// thread.
+  public: double loadProgress{1.0};
+
+  /// \brief Protects `parsingMeshes` and `parsedMeshes`
+  public: std::mutex parseMutex;
+
+  /// \brief Mesh files queued on the workers and not parsed yet
+  public: std::unordered_set<std::string> parsingMeshes;
+
+  /// \brief Mesh files parsed since the render thread last looked, and
+  /// whether they could be parsed
+  public: std::vector<std::pair<std::string, bool>> parsedMeshes;
+
+  /// \brief Visuals waiting for each mesh file being parsed. Only accessed
+  /// from the render thread.
+  public: std::unordered_map<std::string, std::vector<MeshPlaceholder>>
+      meshPlaceholders;
+
+  /// \brief Texture files queued on the workers or decoded, protected by
+  /// `parseMutex`
+  public: std::unordered_set<std::string> knownTextures;
+
+  /// \brief Textures decoded since the render thread last looked, null
+  /// if they couldn't be decoded. Protected by `parseMutex`.
+  public: std::vector<std::pair<std::string, std::shared_ptr<common::Image>>>
+      decodedTextures;
+
+  /// \brief Textures decoded, null if they couldn't be, by file. Only
+  /// accessed from the render thread.
+  public: std::unordered_map<std::string, std::shared_ptr<common::Image>>
+      textures;
+
+  /// \brief Materials waiting for each texture file being decoded. Only
+  /// accessed from the render thread.
+  public: std::unordered_map<std::string, std::vector<TextureUser>>
+      textureUsers;
+
+  /// \brief Largest width and height of the textures, larger ones are
+  /// halved by the workers until they fit. Zero for no limit.
+  public: unsigned int maxTextureSize{0};
+
+  /// \brief Reports an estimate of the memory of the decoded textures,
+  /// with their mipmaps
+  public: MemoryAccount textureMemory{"TransportSceneManager", "textures",
+      MemoryType::GPU};
+
+  /// \brief Reports the textures uploaded, and takes them from the scene's
+  /// upload budget
+  public: GpuUploadQueue uploads{"TransportSceneManager"};
+
+  /// \brief Parses meshes and decodes textures ahead of the render thread
+  /// creating them. Declared after the data the work uses, so that it's
+  /// stopped first.
+  public: common::WorkerPool workers;
+
+  /// \brief Plugin the render state topics and scene requests belong to
+  public: const void *owner{nullptr};
+
+  /// \brief Thread to wait for transport initialization and monitor the
+  /// scene service
+  public: std::thread initializeTransport;
+
+  /// \brief Protects `stopping`
+  public: std::mutex stopMutex;
+
+  /// \brief Notified when stopping
+  public: std::condition_variable stopCv;
+
+  /// \brief True once the plugin is being destroyed
+  public: bool stopping{false};
+
+  /// \brief Set when a scene request failed, so it's retried
+  public: std::atomic<bool> requestFailed{false};
+
+  /// \brief Keeps the render callback registered. Last member so it's
+  /// destroyed first, while the rest of the data is still valid.
+  public: RenderHookConnectionPtr renderConnection;
+};
+
+/////////////////////////////////////////////////
+TransportSceneManager::TransportSceneManager()
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->owner = this;
+}
+
+/////////////////////////////////////////////////
+TransportSceneManager::~TransportSceneManager()
+{
+  // Disconnect first so the render thread can't start the transport thread
+  // while it's being stopped
+  this->dataPtr->renderConnection.reset();
+  if (nullptr != this->dataPtr->assets)
+  {
+    // Managers of other worlds evicting meshes look at our queue
+    std::lock_guard<std::mutex> lock(this->dataPtr->assets->queuedMutex);
+    this->dataPtr->assets->queuedMeshes.erase(this->dataPtr.get());
+  }
+  this->dataPtr->Stop();
+  this->dataPtr->sceneSubscription.Reset();
+  this->dataPtr->incrementalSceneSubscription.Reset();
+  this->dataPtr->poseSubscription.Reset();
+  this->dataPtr->packedPoseSubscription.Reset();
+  this->dataPtr->deletionSubscription.Reset();
+  if (auto *app = App())
+  {
+    app->Requests()->CancelOwner(this);
+    app->Nodes()->Release(this);
+  }
+
+  if (auto labels = SceneServices::Get<SceneLabels>(SceneServices::kLabels))
+    labels->RemoveAll(this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Transport Scene Manager";
+
+  // Custom parameters
+  if (_pluginElem)
+  {
+    // Defaults of the topics below
+    auto elem = _pluginElem->FirstChildElement("world");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      const std::string prefix = transport::TopicUtils::AsValidTopic(
+          "/world/" + std::string(elem->GetText()));
+      if (prefix.empty())
+      {
+        gzerr << "Invalid <world>: " << elem->GetText() << std::endl;
+      }
+      else
+      {
+        this->dataPtr->service = prefix + "/scene/info";
+        this->dataPtr->poseTopic = prefix + "/pose/info";
+        this->dataPtr->deletionTopic = prefix + "/scene/deletion";
+        this->dataPtr->sceneTopic = prefix + "/scene/info";
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("service");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->service =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("pose_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->poseTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("packed_pose_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->packedPoseTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+      if (this->dataPtr->packedPoseTopic.empty())
+      {
+        gzerr << "Invalid <packed_pose_topic>: " << elem->GetText()
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("deletion_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->deletionTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->sceneTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("incremental_scene_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->incrementalSceneTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+      if (this->dataPtr->incrementalSceneTopic.empty())
+      {
+        gzerr << "Invalid <incremental_scene_topic>: " << elem->GetText()
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("shared_memory");
+    if (nullptr != elem)
+      elem->QueryBoolText(&this->dataPtr->sharedMemory);
+
+    elem = _pluginElem->FirstChildElement("feedback");
+    if (nullptr != elem)
+      elem->QueryBoolText(&this->dataPtr->feedback);
+
+    elem = _pluginElem->FirstChildElement("flatten");
+    if (nullptr != elem)
+      elem->QueryBoolText(&this->dataPtr->flatten);
+
+    elem = _pluginElem->FirstChildElement("render_state");
+    if (nullptr != elem)
+    {
+      auto child = elem->FirstChildElement("topic");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        const std::string topic =
+            transport::TopicUtils::AsValidTopic(child->GetText());
+        if (topic.empty())
+        {
+          gzerr << "Invalid <topic>: " << child->GetText()
+                << ". Using default." << std::endl;
+        }
+        else
+        {
+          this->dataPtr->renderStateTopic = topic;
+        }
+      }
+
+      std::string mode{"publish"};
+      child = elem->FirstChildElement("mode");
+      if (nullptr != child && nullptr != child->GetText())
+        mode = child->GetText();
+
+      const auto &topic = this->dataPtr->renderStateTopic;
+      if (mode == "publish")
+      {
+        auto *nodes = App()->Nodes();
+        this->dataPtr->renderStatePosePub =
+            nodes->Advertise<msgs::Bytes>(this, topic + "/pose");
+        this->dataPtr->renderStateScenePub =
+            nodes->Advertise<msgs::Scene>(this, topic + "/scene");
+        this->dataPtr->renderStateDeletionPub =
+            nodes->Advertise<msgs::UInt32_V>(this, topic + "/delete");
+        if (!nodes->AdvertiseService(this, topic + "/scene",
+            &Implementation::OnRenderStateRequest, this->dataPtr.get()))
+        {
+          gzerr << "Error advertising service [" << topic << "/scene]"
+                << std::endl;
+        }
+      }
+      else if (mode == "subscribe")
+      {
+        // Everything comes from the publishing GUI instead of the server
+        this->dataPtr->renderStateSubscribe = true;
+        this->dataPtr->service = topic + "/scene";
+        this->dataPtr->sceneTopic = topic + "/scene";
+        this->dataPtr->deletionTopic = topic + "/delete";
+        this->dataPtr->poseTopic = topic + "/pose";
+        this->dataPtr->incrementalSceneTopic.clear();
+        this->dataPtr->packedPoseTopic.clear();
+      }
+      else
+      {
+        gzerr << "Invalid <mode>: " << mode << ". Expected [publish] or "
+              << "[subscribe]." << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("interpolation");
+    if (nullptr != elem)
+    {
+      this->dataPtr->interpolate = true;
+
+      auto readSeconds = [](const tinyxml2::XMLElement *_elem, double &_value)
+      {
+        if (nullptr == _elem || nullptr == _elem->GetText())
+          return;
+        std::stringstream valueStr;
+        valueStr << std::string(_elem->GetText());
+        double value;
+        valueStr >> value;
+        if (valueStr.fail() || value < 0)
+        {
+          gzerr << "Invalid <" << _elem->Name() << ">: " << _elem->GetText()
+                << ". Using default." << std::endl;
+          return;
+        }
+        _value = value;
+      };
+      readSeconds(elem->FirstChildElement("delay"),
+          this->dataPtr->interpolationDelay);
+      readSeconds(elem->FirstChildElement("max_extrapolation"),
+          this->dataPtr->maxExtrapolation);
+    }
+
+    elem = _pluginElem->FirstChildElement("lod");
+    if (nullptr != elem)
+    {
+      auto readValue = [](const tinyxml2::XMLElement *_elem, double &_value)
+      {
+        if (nullptr == _elem || nullptr == _elem->GetText())
+          return;
+        std::stringstream valueStr;
+        valueStr << std::string(_elem->GetText());
+        double value;
+        valueStr >> value;
+        if (valueStr.fail() || value < 0)
+        {
+          gzerr << "Invalid <" << _elem->Name() << ">: " << _elem->GetText()
+                << ". Using default." << std::endl;
+          return;
+        }
+        _value = value;
+      };
+      readValue(elem->FirstChildElement("box_distance"),
+          this->dataPtr->lodBoxDistance);
+      readValue(elem->FirstChildElement("hide_distance"),
+          this->dataPtr->lodHideDistance);
+      double batchSize = static_cast<double>(this->dataPtr->lodBatchSize);
+      readValue(elem->FirstChildElement("batch_size"), batchSize);
+      this->dataPtr->lodBatchSize =
+          std::max<std::size_t>(1, static_cast<std::size_t>(batchSize));
+    }
+
+    elem = _pluginElem->FirstChildElement("culling");
+    if (nullptr != elem)
+    {
+      this->dataPtr->culling = true;
+
+      auto lazyElem = elem->FirstChildElement("lazy_poses");
+      if (nullptr != lazyElem &&
+          lazyElem->QueryBoolText(&this->dataPtr->lazyPoses) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Invalid <lazy_poses>: " << lazyElem->GetText()
+              << ". Using default." << std::endl;
+      }
+
+      auto topicElem = elem->FirstChildElement("stats_topic");
+      if (nullptr != topicElem && nullptr != topicElem->GetText())
+      {
+        const std::string topic =
+            transport::TopicUtils::AsValidTopic(topicElem->GetText());
+        if (topic.empty())
+        {
+          gzerr << "Invalid <stats_topic>: " << topicElem->GetText()
+                << std::endl;
+        }
+        else
+        {
+          this->dataPtr->cullStatsPub =
+              App()->Nodes()->Advertise<msgs::Param>(this, topic);
+        }
+      }
+    }
+
+    // Before the scene index, which regions share
+    elem = _pluginElem->FirstChildElement("region");
+    if (nullptr != elem)
+    {
+      this->dataPtr->regionPose = math::Pose3d::Zero;
+      auto child = elem->FirstChildElement("offset");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        std::stringstream poseStr;
+        poseStr << std::string(child->GetText());
+        poseStr >> *this->dataPtr->regionPose;
+      }
+
+      child = elem->FirstChildElement("id_offset");
+      if (nullptr != child &&
+          child->QueryUnsignedText(&this->dataPtr->idOffset) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Invalid <id_offset> in <region>" << std::endl;
+        this->dataPtr->idOffset = 0;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_index");
+    if (nullptr != elem && this->dataPtr->regionPose)
+    {
+      // Worlds shown in regions add to the index of the first world
+      this->dataPtr->sceneIndex = SceneServices::Get<SceneIndex>(
+          SceneServices::kSceneIndex);
+    }
+    if (nullptr != elem && nullptr == this->dataPtr->sceneIndex)
+    {
+      this->dataPtr->sceneIndex = std::make_shared<SceneIndex>();
+      auto child = elem->FirstChildElement("margin");
+      double margin{0.0};
+      if (nullptr != child)
+      {
+        if (child->QueryDoubleText(&margin) != tinyxml2::XML_SUCCESS ||
+            margin < 0)
+        {
+          gzerr << "Invalid <margin> in <scene_index>" << std::endl;
+        }
+        else
+        {
+          this->dataPtr->sceneIndex->SetMargin(margin);
+        }
+      }
+      SceneServices::Set(SceneServices::kSceneIndex,
+          this->dataPtr->sceneIndex);
+    }
+
+    elem = _pluginElem->FirstChildElement("history");
+    if (nullptr != elem)
+    {
+      this->dataPtr->sceneHistory = std::make_shared<SceneHistory>();
+      this->dataPtr->historyEpoch = std::chrono::steady_clock::now();
+
+      auto readPositive = [](const tinyxml2::XMLElement *_elem)
+          -> std::optional<double>
+      {
+        if (nullptr == _elem)
+          return std::nullopt;
+        double value{0.0};
+        if (_elem->QueryDoubleText(&value) != tinyxml2::XML_SUCCESS ||
+            value <= 0)
+        {
+          gzerr << "Invalid <" << _elem->Name() << "> in <history>"
+                << std::endl;
+          return std::nullopt;
+        }
+        return value;
+      };
+      auto &history = *this->dataPtr->sceneHistory;
+      if (auto value = readPositive(elem->FirstChildElement("duration")))
+        history.SetDuration(*value);
+      if (auto value = readPositive(elem->FirstChildElement("max_memory")))
+        history.SetMaxBytes(static_cast<std::size_t>(*value * 1024 * 1024));
+      if (auto value = readPositive(elem->FirstChildElement("rate")))
+        history.SetRate(*value);
+      if (auto value = readPositive(elem->FirstChildElement("precision")))
+        history.SetPrecision(*value);
+
+      SceneServices::Set(SceneServices::kSceneHistory,
+          this->dataPtr->sceneHistory);
+    }
+
+    elem = _pluginElem->FirstChildElement("light_budget");
+    if (nullptr != elem)
+    {
+      this->dataPtr->budgetingLights = true;
+
+      auto readCount = [](const tinyxml2::XMLElement *_elem)
+          -> std::optional<std::size_t>
+      {
+        if (nullptr == _elem)
+          return std::nullopt;
+        int value{0};
+        if (_elem->QueryIntText(&value) != tinyxml2::XML_SUCCESS ||
+            value < 0)
+        {
+          gzerr << "Invalid <" << _elem->Name() << "> in <light_budget>"
+                << std::endl;
+          return std::nullopt;
+        }
+        return static_cast<std::size_t>(value);
+      };
+      if (auto count = readCount(elem->FirstChildElement("max_lights")))
+        this->dataPtr->lightBudget.SetMaxLights(*count);
+      if (auto count = readCount(elem->FirstChildElement("max_shadows")))
+        this->dataPtr->lightBudget.SetMaxShadows(*count);
+
+      auto child = elem->FirstChildElement("hysteresis");
+      double hysteresis{0.0};
+      if (nullptr != child)
+      {
+        if (child->QueryDoubleText(&hysteresis) != tinyxml2::XML_SUCCESS ||
+            hysteresis < 0)
+        {
+          gzerr << "Invalid <hysteresis> in <light_budget>" << std::endl;
+        }
+        else
+        {
+          this->dataPtr->lightBudget.SetHysteresis(hysteresis);
+        }
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("static_batching");
+    if (nullptr != elem)
+    {
+      this->dataPtr->batching = true;
+
+      auto readValue = [](const tinyxml2::XMLElement *_elem, double &_value)
+      {
+        if (nullptr == _elem || nullptr == _elem->GetText())
+          return;
+        std::stringstream valueStr;
+        valueStr << std::string(_elem->GetText());
+        double value;
+        valueStr >> value;
+        if (valueStr.fail() || value < 0)
+        {
+          gzerr << "Invalid <" << _elem->Name() << ">: " << _elem->GetText()
+                << ". Using default." << std::endl;
+          return;
+        }
+        _value = value;
+      };
+      double settleTime = std::chrono::duration<double>(
+          this->dataPtr->batchSettleTime).count();
+      readValue(elem->FirstChildElement("settle_time"), settleTime);
+      this->dataPtr->batchSettleTime =
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(settleTime));
+      readValue(elem->FirstChildElement("cell_size"),
+          this->dataPtr->batchCellSize);
+      if (this->dataPtr->batchCellSize <= 0)
+      {
+        gzerr << "Invalid <cell_size>: 0. Using default." << std::endl;
+        this->dataPtr->batchCellSize = 20.0;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("pose_filter");
+    if (nullptr != elem)
+    {
+      std::vector<std::string> patterns;
+      for (auto child = elem->FirstChildElement("model"); nullptr != child;
+          child = child->NextSiblingElement("model"))
+      {
+        if (nullptr != child->GetText())
+          patterns.push_back(child->GetText());
+      }
+      if (!this->dataPtr->poseFilter.SetModelPatterns(patterns))
+        gzerr << "Invalid <model> pattern in <pose_filter>" << std::endl;
+
+      auto child = elem->FirstChildElement("radius");
+      if (nullptr != child)
+      {
+        double radius{0.0};
+        if (child->QueryDoubleText(&radius) != tinyxml2::XML_SUCCESS ||
+            radius < 0)
+        {
+          gzerr << "Invalid <radius> in <pose_filter>" << std::endl;
+        }
+        else
+        {
+          this->dataPtr->poseFilter.SetRadius(radius);
+        }
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("labels");
+    if (nullptr != elem)
+    {
+      this->dataPtr->labels = true;
+      auto child = elem->FirstChildElement("height");
+      if (nullptr != child &&
+          child->QueryDoubleText(&this->dataPtr->labelHeight) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Invalid <height> in <labels>" << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_cache");
+    if (nullptr != elem)
+    {
+      std::string home;
+      common::env(GZ_HOMEDIR, home);
+      std::string dir = common::joinPaths(home, ".gz", "gui", "scene_cache");
+      auto child = elem->FirstChildElement("directory");
+      if (nullptr != child && nullptr != child->GetText())
+        dir = child->GetText();
+
+      if (!common::isDirectory(dir) && !common::createDirectories(dir))
+      {
+        gzerr << "Failed to create scene cache [" << dir << "]" << std::endl;
+      }
+      else
+      {
+        // The service name contains the world name, one file per world
+        std::string name = this->dataPtr->service;
+        std::replace(name.begin(), name.end(), '/', '_');
+        this->dataPtr->sceneCacheFile =
+            common::joinPaths(dir, name + ".scene");
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("terrain");
+    if (nullptr != elem)
+    {
+      auto readValue = [](const tinyxml2::XMLElement *_elem, double &_value)
+      {
+        if (nullptr == _elem || nullptr == _elem->GetText())
+          return;
+        std::stringstream valueStr;
+        valueStr << std::string(_elem->GetText());
+        double value;
+        valueStr >> value;
+        if (valueStr.fail() || value <= 0)
+        {
+          gzerr << "Invalid <" << _elem->Name() << ">: " << _elem->GetText()
+                << ". Using default." << std::endl;
+          return;
+        }
+        _value = value;
+      };
+      double tileSize = this->dataPtr->terrainTileSegments;
+      readValue(elem->FirstChildElement("tile_size"), tileSize);
+      this->dataPtr->terrainTileSegments =
+          std::max(1u, static_cast<unsigned int>(tileSize));
+      readValue(elem->FirstChildElement("load_radius"),
+          this->dataPtr->terrainLoadRadius);
+      readValue(elem->FirstChildElement("lod_distance"),
+          this->dataPtr->terrainLodDistance);
+    }
+
+    elem = _pluginElem->FirstChildElement("gpu_memory_budget");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double budget;
+      std::stringstream budgetStr;
+      budgetStr << std::string(elem->GetText());
+      budgetStr >> budget;
+      if (budgetStr.fail() || budget < 0)
+      {
+        gzerr << "Invalid <gpu_memory_budget>: " << elem->GetText()
+              << ". Using default." << std::endl;
+      }
+      else
+      {
+        this->dataPtr->gpuMemoryBudget =
+            static_cast<std::size_t>(budget * 1024.0 * 1024.0);
+
+        // So MemoryStats shows the usage against the budget
+        MemoryAccounting::SetBudget("TransportSceneManager",
+            this->dataPtr->gpuMemoryBudget);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("max_texture_size");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      int size;
+      std::stringstream sizeStr;
+      sizeStr << std::string(elem->GetText());
+      sizeStr >> size;
+      if (sizeStr.fail() || size < 0)
+      {
+        gzerr << "Invalid <max_texture_size>: " << elem->GetText()
+              << ". Using default." << std::endl;
+      }
+      else
+      {
+        this->dataPtr->maxTextureSize = static_cast<unsigned int>(size);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("load_budget");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double budget;
+      std::stringstream budgetStr;
+      budgetStr << std::string(elem->GetText());
+      budgetStr >> budget;
+      if (budgetStr.fail() || budget < 0)
+      {
+        gzerr << "Invalid <load_budget>: " << elem->GetText()
+              << ". Using default." << std::endl;
+      }
+      else
+      {
+        this->dataPtr->loadBudget =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budget));
+      }
+    }
+  }
+
+  // Called from the render thread
+  this->dataPtr->loadProgressCb = [this](double _progress)
+  {
+    QMetaObject::invokeMethod(this, "SetLoadProgress",
+        Qt::QueuedConnection, Q_ARG(double, _progress));
+  };
+
+  QQmlProperty::write(this->PluginItem(), "service",
+      QString::fromStdString(this->dataPtr->service));
+  QQmlProperty::write(this->PluginItem(), "poseTopic",
+      QString::fromStdString(this->dataPtr->poseTopic));
+  QQmlProperty::write(this->PluginItem(), "deletionTopic",
+      QString::fromStdString(this->dataPtr->deletionTopic));
+  QQmlProperty::write(this->PluginItem(), "sceneTopic",
+      QString::fromStdString(this->dataPtr->sceneTopic));
+
+  if (this->dataPtr->service.empty() ||
+      this->dataPtr->poseTopic.empty() ||
+      this->dataPtr->deletionTopic.empty() ||
+      this->dataPtr->sceneTopic.empty())
+  {
+    gzerr << "One or more transport parameters invalid:" << std::endl
+        << "  * <service>: " << this->dataPtr->service << std::endl
+        << "  * <pose_topic>: " << this->dataPtr->poseTopic << std::endl
+        << "  * <deletion_topic>: " << this->dataPtr->deletionTopic << std::endl
+        << "  * <scene_topic>: " << this->dataPtr->sceneTopic << std::endl;
+  }
+  else
+  {
+    // Run before other render callbacks so they see an up to date scene
+    this->dataPtr->renderConnection = RenderHooks::OnRender(
+        [this]()
+        {
+          this->dataPtr->OnRender();
+        }, -10, "TransportSceneManager");
+  }
+}
+
+/////////////////////////////////////////////////
+double TransportSceneManager::LoadProgress() const
+{
+  return this->dataPtr->loadProgress;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::SetLoadProgress(double _progress)
+{
+  this->dataPtr->loadProgress = _progress;
+  emit this->LoadProgressChanged();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::InitializeTransport()
+{
+  // Poses go through the hub too, which tells their publishers how fast
+  // they're consumed if asked to
+  auto hub = App()->Subscriptions();
+  const std::function<void(const msgs::Bytes &)> packedCb =
+      [this](const msgs::Bytes &_msg)
+      {
+        this->OnPackedPosesMsg(_msg, this->packedPoseSubscription);
+      };
+  hub->SetFeedback(this->poseTopic, this->feedback);
+  HubSubscription poseSubscription;
+  if (this->renderStateSubscribe)
+  {
+    poseSubscription = hub->Subscribe<msgs::Bytes>(this->poseTopic,
+        [this](const msgs::Bytes &_msg)
+        {
+          this->OnPackedPosesMsg(_msg, this->poseSubscription);
+        });
+  }
+  else
+  {
+    poseSubscription = hub->Subscribe<msgs::Pose_V>(this->poseTopic,
+        [this](const msgs::Pose_V &_msg)
+        {
+          this->OnPoseVMsg(_msg, this->poseSubscription);
+        });
+  }
+  if (!poseSubscription.Valid())
+  {
+    gzerr << "Error subscribing to pose topic: " << this->poseTopic
+      << std::endl;
+  }
+  else
+  {
+    gzmsg << "Listening to pose messages on [" << this->poseTopic << "]"
+           << std::endl;
+  }
+
+  HubSubscription packedPoseSubscription;
+  if (!this->packedPoseTopic.empty())
+  {
+    hub->SetFeedback(this->packedPoseTopic, this->feedback);
+    packedPoseSubscription = hub->Subscribe<msgs::Bytes>(
+        this->packedPoseTopic, packedCb);
+    if (!packedPoseSubscription.Valid())
+    {
+      gzerr << "Error subscribing to packed pose topic: "
+             << this->packedPoseTopic << std::endl;
+    }
+    else
+    {
+      gzmsg << "Listening to packed pose messages on ["
+             << this->packedPoseTopic << "]" << std::endl;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    this->poseSubscription = std::move(poseSubscription);
+    this->packedPoseSubscription = std::move(packedPoseSubscription);
+  }
+
+  const std::function<void(const msgs::UInt32_V &)> deletionCb =
+      [this](const msgs::UInt32_V &_msg)
+      {
+        this->OnDeletionMsg(_msg);
+      };
+  this->deletionSubscription = hub->Subscribe<msgs::UInt32_V>(
+      this->deletionTopic, deletionCb);
+  if (!this->deletionSubscription.Valid())
+  {
+    gzerr << "Error subscribing to deletion topic: " << this->deletionTopic
+      << std::endl;
+  }
+  else
+  {
+    gzmsg << "Listening to deletion messages on [" << this->deletionTopic
+           << "]" << std::endl;
+  }
+
+  // Large scenes go through the hub, which may get them from shared memory
+  const std::function<void(const std::shared_ptr<const msgs::Scene> &)>
+      sceneCb = [this](const std::shared_ptr<const msgs::Scene> &_msg)
+      {
+        this->OnSceneMsg(_msg);
+      };
+  hub->SetSharedMemory(this->sceneTopic, this->sharedMemory);
+  this->sceneSubscription = hub->SubscribeShared<msgs::Scene>(
+      this->sceneTopic, sceneCb);
+  if (!this->sceneSubscription.Valid())
+  {
+    gzerr << "Error subscribing to scene topic: " << this->sceneTopic
+           << std::endl;
+  }
+  else
+  {
+    gzmsg << "Listening to scene messages on [" << this->sceneTopic << "]"
+           << std::endl;
+  }
+
+  if (!this->incrementalSceneTopic.empty())
+  {
+    hub->SetSharedMemory(this->incrementalSceneTopic, this->sharedMemory);
+    this->incrementalSceneSubscription = hub->SubscribeShared<msgs::Scene>(
+        this->incrementalSceneTopic, sceneCb);
+    if (!this->incrementalSceneSubscription.Valid())
+    {
+      gzerr << "Error subscribing to incremental scene topic: "
+             << this->incrementalSceneTopic << std::endl;
+    }
+    else
+    {
+      gzmsg << "Listening to incremental scene messages on ["
+             << this->incrementalSceneTopic << "]" << std::endl;
+    }
+  }
+
+  gzmsg << "Transport initialized." << std::endl;
+
+  this->LoadSceneCache();
+  this->Request();
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManager::Implementation::Sleep(
+    std::chrono::steady_clock::duration _duration)
+{
+  std::unique_lock<std::mutex> lock(this->stopMutex);
+  return !this->stopCv.wait_for(lock, _duration,
+      [this]() {return this->stopping;});
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->stopMutex);
+    this->stopping = true;
+  }
+  this->stopCv.notify_all();
+
+  if (this->initializeTransport.joinable())
+    this->initializeTransport.join();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::Request()
+{
+  // Retry quickly at first so startup isn't delayed, backing off while the
+  // server is away
+  const std::chrono::steady_clock::duration minRetry{
+      std::chrono::milliseconds(100)};
+  const std::chrono::steady_clock::duration maxRetry{std::chrono::seconds(5)};
+  const std::chrono::steady_clock::duration monitorPeriod{
+      std::chrono::seconds(1)};
+
+  auto retry = minRetry;
+
+  // Process which answered the last request, empty if none
+  std::string serverUuid;
+
+  while (true)
+  {
+    std::vector<transport::ServicePublisher> publishers;
+    App()->Nodes()->Node().ServiceInfo(this->service, publishers);
+
+    if (publishers.empty())
+    {
+      if (!serverUuid.empty())
+      {
+        gzwarn << "Service [" << this->service << "] went away, waiting for "
+               << "it to come back" << std::endl;
+        serverUuid.clear();
+      }
+      else
+      {
+        gzdbg << "Waiting for service [" << this->service << "]\n";
+      }
+
+      if (!this->Sleep(retry))
+        return;
+      retry = std::min(retry * 2, maxRetry);
+      continue;
+    }
+
+    // A new process means the server restarted, or a previous request failed
+    const auto uuid = publishers.front().PUuid();
+    if (uuid != serverUuid || this->requestFailed.exchange(false))
+    {
+      if (!serverUuid.empty())
+      {
+        gzmsg << "Requesting scene again from [" << this->service << "]"
+              << std::endl;
+      }
+
+      // Waits for the reply as long as it takes, failures are retried
+      // through `requestFailed`
+      App()->Requests()->Request<msgs::Empty, msgs::Scene>(this->service,
+          msgs::Empty(), [this](const RequestResult<msgs::Scene> &_res)
+          {
+            this->OnSceneSrvMsg(_res.reply,
+                _res.status == RequestStatus::OK);
+          }, {std::chrono::seconds(0), RequestThread::TRANSPORT, this->owner});
+      serverUuid = uuid;
+      retry = minRetry;
+    }
+
+    if (!this->Sleep(monitorPeriod))
+      return;
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnPoseVMsg(
+    const msgs::Pose_V &_msg, const HubSubscription &_source)
+{
+  GZ_GUI_PROFILE("TransportSceneManager::OnPoseVMsg");
+  const auto arrival = std::chrono::steady_clock::now();
+  double msgStamp{-1.0};
+  if (_msg.has_header() && _msg.header().has_stamp())
+  {
+    msgStamp = _msg.header().stamp().sec() +
+        _msg.header().stamp().nsec() * 1e-9;
+  }
+  const auto tag = App()->Latency()->Begin("poses", msgStamp);
+  const double stamp = this->interpolate ? msgStamp : -1.0;
+
+  // Only copy here, local poses are applied on the render thread
+  PoseBuffer poses;
+  poses.reserve(_msg.pose_size());
+  for (int i = 0; i < _msg.pose_size(); ++i)
+  {
+    poses.push_back({_msg.pose(i).id(), msgs::Convert(_msg.pose(i)), stamp});
+  }
+
+  // Other GUIs get all poses, they filter their own
+  if (this->renderStatePosePub)
+  {
+    std::vector<PackedPoses::Entry> entries;
+    entries.reserve(poses.size());
+    for (const auto &pose : poses)
+      entries.push_back({pose.id, pose.pose});
+    msgs::Bytes packed;
+    packed.set_data(PackedPoses::Pack(msgStamp, entries));
+    this->renderStatePosePub.Publish(packed);
+  }
+
+  this->QueuePoses(poses, stamp, arrival, tag, _source);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnPackedPosesMsg(
+    const msgs::Bytes &_msg, const HubSubscription &_source)
+{
+  GZ_GUI_PROFILE("TransportSceneManager::OnPackedPosesMsg");
+  const auto arrival = std::chrono::steady_clock::now();
+  double msgStamp{-1.0};
+  std::vector<PackedPoses::Entry> entries;
+  if (!PackedPoses::Unpack(_msg.data(), msgStamp, entries))
+  {
+    gzerr << "Ignoring invalid packed poses" << std::endl;
+    return;
+  }
+  const auto tag = App()->Latency()->Begin("packed poses", msgStamp);
+  if (this->renderStatePosePub)
+    this->renderStatePosePub.Publish(_msg);
+  const double stamp = this->interpolate ? msgStamp : -1.0;
+
+  PoseBuffer poses;
+  poses.reserve(entries.size());
+  for (const auto &entry : entries)
+    poses.push_back({entry.id, entry.pose, stamp});
+
+  this->QueuePoses(poses, stamp, arrival, tag, _source);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::QueuePoses(PoseBuffer &_poses,
+    double _stamp, std::chrono::steady_clock::time_point _arrival,
+    const LatencyTrace::Tag &_tag, const HubSubscription &_source)
+{
+  // Drop the poses of models which aren't of interest before they're
+  // queued for the render thread
+  if (this->poseFilter.Enabled())
+  {
+    std::vector<std::pair<unsigned int, math::Vector3d>> positions;
+    positions.reserve(_poses.size());
+    for (const auto &pose : _poses)
+      positions.emplace_back(pose.id, pose.pose.Pos());
+
+    std::vector<bool> keep;
+    {
+      std::lock_guard<std::mutex> lock(this->filterMutex);
+      keep = this->poseFilter.Keep(positions);
+    }
+    std::size_t kept{0};
+    for (std::size_t i = 0; i < _poses.size(); ++i)
+    {
+      if (keep[i])
+        _poses[kept++] = _poses[i];
+    }
+    _poses.resize(kept);
+    if (_poses.empty())
+    {
+      App()->Latency()->Drop(_tag);
+      return;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    if (_stamp >= 0)
+    {
+      this->pendingStamp = _stamp;
+      this->pendingArrival = _arrival;
+    }
+    if (this->pendingPoses.empty())
+    {
+      this->pendingPoses.swap(_poses);
+    }
+    else
+    {
+      // The render thread hasn't caught up, keep all poses in order so the
+      // latest one for each entity wins. The publisher is told the msg
+      // wasn't shown on its own.
+      this->pendingPoses.insert(this->pendingPoses.end(),
+          _poses.begin(), _poses.end());
+      _source.ReportDropped();
+    }
+    if (_tag.Valid())
+      this->pendingTags.push_back(_tag);
+  }
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnDeletionMsg(
+  const msgs::UInt32_V &_msg)
+{
+  {
+    // Entities spawned again with the same id must be loaded again
+    std::lock_guard<std::mutex> sceneLock(this->sceneMutex);
+    for (const auto &entity : _msg.data())
+    {
+      this->contentHashes.Erase(entity);
+      this->renderStateModels.erase(entity);
+      this->renderStateLights.erase(entity);
+    }
+  }
+  if (this->renderStateDeletionPub)
+    this->renderStateDeletionPub.Publish(_msg);
+
+  if (this->poseFilter.Enabled())
+  {
+    std::lock_guard<std::mutex> filterLock(this->filterMutex);
+    for (const auto &entity : _msg.data())
+      this->poseFilter.RemoveModel(entity);
+  }
+
+  std::lock_guard<std::mutex> lock(this->msgMutex);
+  std::copy(_msg.data().begin(), _msg.data().end(),
+            std::back_inserter(this->toDeleteEntities));
+  RenderHooks::RequestRender();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnRender()
+{
+  GZ_GUI_PROFILE("TransportSceneManager::OnRender");
+  if (nullptr == this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+
+    this->assets = SceneAssets::ForScene(this->scene);
+    {
+      std::lock_guard<std::mutex> lock(this->assets->queuedMutex);
+      this->assets->queuedMeshes[this] =
+          [this](std::vector<std::string> &_files)
+          {
+            for (const auto &task : this->loadTasks)
+            {
+              if (auto model = task.Model())
+                meshFiles(*model, _files);
+            }
+          };
+    }
+
+    this->root = this->scene->RootVisual();
+    if (this->regionPose)
+    {
+      auto region = this->scene->CreateVisual();
+      region->SetLocalPose(*this->regionPose);
+      this->root->AddChild(region);
+      this->root = region;
+    }
+
+    this->initializeTransport = std::thread(
+        &Implementation::InitializeTransport, this);
+  }
+
+  // Take everything received so far, and release the lock before touching
+  // the scene
+  std::vector<LoadTask> newLoadTasks;
+  std::vector<unsigned int> newDeletions;
+  double latestStamp;
+  std::chrono::steady_clock::time_point latestArrival;
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    newLoadTasks.swap(this->pendingLoadTasks);
+    newDeletions.swap(this->toDeleteEntities);
+    this->renderPoses.swap(this->pendingPoses);
+    this->renderTags.swap(this->pendingTags);
+    latestStamp = this->pendingStamp;
+    latestArrival = this->pendingArrival;
+  }
+
+  // Recorded even while the history is shown, which doesn't hold up the
+  // live scene
+  std::optional<double> scrubTime;
+  if (nullptr != this->sceneHistory)
+  {
+    this->RecordHistory(newLoadTasks, newDeletions);
+    scrubTime = this->sceneHistory->ScrubTime();
+
+    // Entities created again from the history make way for the live ones
+    for (const auto &task : newLoadTasks)
+    {
+      if (this->historyGhosts.erase(task.Id()) > 0)
+        this->DeleteEntity(task.Id(), true);
+    }
+  }
+
+  this->loadTotal += newLoadTasks.size();
+  std::move(newLoadTasks.begin(), newLoadTasks.end(),
+      std::back_inserter(this->loadTasks));
+  const std::size_t loadDoneBefore = this->loadDone;
+  this->LoadQueued();
+  this->AttachParsedMeshes();
+  this->AttachDecodedTextures();
+
+  if (!newDeletions.empty())
+  {
+    // Only taken out of the scene graph now, so deleting a whole fleet or
+    // resetting the world doesn't stall this frame
+    for (const auto &entity : newDeletions)
+    {
+      if (this->historyGhosts.count(entity) == 0)
+        this->DeleteEntity(entity, true);
+    }
+
+    // Entities deleted before being created are never created
+    const std::unordered_set<unsigned int> deleted(newDeletions.begin(),
+        newDeletions.end());
+    auto removed = std::remove_if(this->loadTasks.begin(),
+        this->loadTasks.end(), [&deleted](const LoadTask &_task)
+        {
+          return deleted.count(_task.Id()) > 0;
+        });
+    this->loadDone += static_cast<std::size_t>(
+        std::distance(removed, this->loadTasks.end()));
+    this->loadTasks.erase(removed, this->loadTasks.end());
+  }
+
+  // Meshes are only unused once the visuals using them are destroyed
+  const std::size_t destroyed = this->DestroyQueued(false);
+  if (destroyed > 0 || this->loadDone != loadDoneBefore)
+    this->EvictMeshes();
+  this->ReportLoadProgress();
+
+  // Live poses are only in the history while it's shown
+  if (scrubTime)
+    this->renderPoses.clear();
+
+  const SceneSelection *selection{nullptr};
+  std::shared_ptr<SceneSelection> selectionPtr;
+  if (this->lazyPoses)
+  {
+    this->UpdateCameraTargets();
+    selectionPtr = SceneServices::Get<SceneSelection>(
+        SceneServices::kSelection);
+    selection = selectionPtr.get();
+  }
+
+  for (const auto &update : this->renderPoses)
+  {
+    auto entity = this->entities.Find(update.id);
+    if (nullptr == entity)
+      continue;
+
+    if (update.stamp >= 0)
+    {
+      // Applied below, once all the new poses are in the history
+      if (nullptr == entity->history)
+        entity->history = std::make_unique<PoseHistory>();
+      entity->history->Add(update.stamp, update.pose);
+      if (!entity->interpolating)
+      {
+        entity->interpolating = true;
+        this->interpolated.push_back(update.id);
+      }
+    }
+    else if (this->CanDeferPose(update.id, *entity, selection))
+    {
+      this->DeferPose(update.id, *entity, update.pose);
+    }
+    else if (!applyPose(*entity, update.pose))
+    {
+      this->entities.Erase(update.id);
+    }
+    else
+    {
+      // Older than the pose just applied
+      if (this->deferredPoses.Size() > 0)
+        this->deferredPoses.Take(update.id);
+      this->cullMoved.insert(this->cullMoved.end(),
+          entity->cullIds.begin(), entity->cullIds.end());
+      if (entity->batchModel)
+        this->OnModelMoved(*entity->batchModel);
+    }
+  }
+
+  // Note we are dropping the poses here but later on we may need to
+  // consider the case where pose msgs arrive before scene/visual msgs
+  this->renderPoses.clear();
+
+  // Shown once the scene's next frame is presented
+  for (const auto &tag : this->renderTags)
+    App()->Latency()->Hold(tag, "scene");
+  this->renderTags.clear();
+
+  if (scrubTime)
+  {
+    // Live changes to the scene must be hidden again
+    if (scrubTime != this->historyShown || !newDeletions.empty() ||
+        this->loadDone != loadDoneBefore)
+    {
+      this->ShowHistory(*scrubTime);
+      this->historyShown = scrubTime;
+    }
+  }
+  else if (this->historyShown)
+  {
+    this->ShowLive();
+    this->historyShown.reset();
+  }
+
+  if (!this->interpolated.empty() && !scrubTime)
+  {
+    // Estimate the server time from the newest stamp and how long ago it
+    // arrived, and render a bit in the past so there are poses on both sides
+    const double now = latestStamp + std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - latestArrival).count();
+    const double renderTime = now - this->interpolationDelay;
+
+    for (std::size_t i = 0; i < this->interpolated.size();)
+    {
+      const unsigned int id = this->interpolated[i];
+      auto entity = this->entities.Find(id);
+
+      // Entities outside the view settle on their newest pose, applied
+      // once they come into view
+      if (nullptr != entity && nullptr != entity->history &&
+          this->CanDeferPose(id, *entity, selection))
+      {
+        this->DeferPose(id, *entity, entity->history->At(
+            entity->history->Newest(), 0.0));
+        entity->interpolating = false;
+        this->interpolated[i] = this->interpolated.back();
+        this->interpolated.pop_back();
+        continue;
+      }
+
+      bool done = nullptr == entity || nullptr == entity->history ||
+          !applyPose(*entity, entity->history->At(renderTime,
+          this->maxExtrapolation));
+      if (!done && this->deferredPoses.Size() > 0)
+        this->deferredPoses.Take(id);
+      if (!done)
+      {
+        this->cullMoved.insert(this->cullMoved.end(),
+            entity->cullIds.begin(), entity->cullIds.end());
+        if (entity->batchModel)
+          this->OnModelMoved(*entity->batchModel);
+      }
+
+      // Stop once past the newest pose, until the entity moves again. The
+      // entity most likely stopped, so settle on the newest pose.
+      if (!done &&
+          renderTime >= entity->history->Newest() + this->maxExtrapolation)
+      {
+        applyPose(*entity, entity->history->At(
+            entity->history->Newest(), 0.0));
+        entity->interpolating = false;
+        done = true;
+      }
+
+      if (done)
+      {
+        this->interpolated[i] = this->interpolated.back();
+        this->interpolated.pop_back();
+      }
+      else
+      {
+        ++i;
+      }
+    }
+
+    // Keep rendering while entities move between poses
+    if (!this->interpolated.empty())
+      RenderHooks::RequestRender();
+  }
+
+  if (!scrubTime)
+    this->ApplyDeferredPoses(!this->lazyPoses);
+
+  if (this->poseFilter.Enabled())
+  {
+    if (auto camera = this->UserCamera())
+    {
+      std::lock_guard<std::mutex> lock(this->filterMutex);
+      // Model poses are in the region
+      auto position = camera->WorldPosition();
+      if (this->regionPose)
+        position = this->regionPose->Inverse().CoordPositionAdd(position);
+      this->poseFilter.SetCamera(position);
+    }
+  }
+
+  this->UpdateBatching();
+  this->UpdateTerrain();
+  this->UpdateLod();
+  this->UpdateCulling();
+  this->UpdateLights();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::EvictMeshes()
+{
+  if (0 == this->gpuMemoryBudget ||
+      this->assets->meshCache.Bytes() <= this->gpuMemoryBudget)
+  {
+    return;
+  }
+
+  // Meshes of queued models are about to be used, and may be being parsed
+  // by a worker, also those of the other worlds sharing the meshes
+  std::vector<std::string> queued;
+  {
+    std::lock_guard<std::mutex> lock(this->assets->queuedMutex);
+    for (const auto &[owner, addQueued] : this->assets->queuedMeshes)
+      addQueued(queued);
+  }
+  std::unordered_set<std::string> queuedSet(queued.begin(), queued.end());
+
+  auto evicted = this->assets->meshCache.Evict(this->gpuMemoryBudget,
+      [&](const std::string &_file)
+      {
+        if (queuedSet.count(_file) > 0)
+          return true;
+        auto it = this->assets->meshUsers.find(_file);
+        if (it == this->assets->meshUsers.end())
+          return false;
+        auto &users = it->second;
+        users.erase(std::remove_if(users.begin(), users.end(),
+            [](const rendering::VisualPtr::weak_type &_visual)
+            {
+              return _visual.expired();
+            }), users.end());
+        return !users.empty();
+      });
+  if (evicted.empty())
+    return;
+
+  // Descriptors and materials are keyed by the mesh key, which starts with
+  // the file name. They're loaded again the next time the mesh is used.
+  auto startsWith = [](const std::string &_key, const std::string &_prefix)
+  {
+    return _key.compare(0, _prefix.size(), _prefix) == 0;
+  };
+  for (const auto &file : evicted)
+  {
+    this->assets->meshUsers.erase(file);
+    const std::string prefix = file + "\n";
+    for (auto it = this->assets->meshDescriptors.begin();
+        it != this->assets->meshDescriptors.end();)
+    {
+      if (startsWith(it->first, prefix))
+        it = this->assets->meshDescriptors.erase(it);
+      else
+        ++it;
+    }
+    for (auto it = this->assets->meshMaterials.begin();
+        it != this->assets->meshMaterials.end();)
+    {
+      if (startsWith(it->first, prefix))
+      {
+        this->scene->DestroyMaterial(it->second);
+        it = this->assets->meshMaterials.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+    common::MeshManager::Instance()->RemoveMesh(file);
+  }
+  this->assets->meshMemory.Set(this->assets->meshCache.Bytes());
+
+  gzdbg << "Unloaded [" << evicted.size() << "] unused meshes, ["
+        << MemoryAccounting::FormatBytes(this->assets->meshCache.Bytes())
+        << "] of meshes still loaded" << std::endl;
+}
+
+/////////////////////////////////////////////////
+rendering::CameraPtr TransportSceneManager::Implementation::UserCamera()
+{
+  auto camera = this->userCamera.lock();
+  if (nullptr == camera)
+  {
+    camera = SceneServices::Get<rendering::Camera>(
+        SceneServices::kUserCamera);
+    this->userCamera = camera;
+  }
+  return camera;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::RemoveLodVisual(
+    std::size_t _index)
+{
+  auto &lod = this->lodVisuals[_index];
+  if (auto standIn = lod.standIn.lock())
+    this->scene->DestroyVisual(standIn);
+  if (0 != lod.cullId)
+  {
+    this->cullIndex.erase(lod.cullId);
+    this->cullDirty = true;
+  }
+  if (_index + 1 != this->lodVisuals.size())
+  {
+    lod = std::move(this->lodVisuals.back());
+    if (0 != lod.cullId)
+      this->cullIndex[lod.cullId] = _index;
+  }
+  this->lodVisuals.pop_back();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateLod()
+{
+  if (this->lodVisuals.empty() ||
+      (this->lodBoxDistance <= 0 && this->lodHideDistance <= 0))
+  {
+    return;
+  }
+
+  auto camera = this->UserCamera();
+  if (nullptr == camera)
+    return;
+  const math::Vector3d cameraPos = camera->WorldPosition();
+
+  // Returns true if the distance is beyond a threshold. Visuals already
+  // beyond it only come back once they're clearly within, so they don't
+  // flicker at the boundary.
+  auto beyond = [](double _distance, double _threshold, bool _wasBeyond)
+  {
+    if (_threshold <= 0)
+      return false;
+    return _distance > (_wasBeyond ? _threshold * 0.9 : _threshold);
+  };
+
+  // Spread the work across frames, so the cost doesn't grow with the world
+  for (std::size_t n = 0;
+       n < this->lodBatchSize && !this->lodVisuals.empty(); ++n)
+  {
+    if (this->lodCursor >= this->lodVisuals.size())
+      this->lodCursor = 0;
+
+    auto &lod = this->lodVisuals[this->lodCursor];
+    auto visual = lod.visual.lock();
+    if (nullptr == visual)
+    {
+      this->RemoveLodVisual(this->lodCursor);
+      continue;
+    }
+
+    const double distance = visual->WorldPosition().Distance(cameraPos);
+    int level{0};
+    // Visuals without a parent are merged into a static batch, which is
+    // always drawn at full detail
+    if (nullptr == visual->Parent())
+      level = 0;
+    else if (beyond(distance, this->lodHideDistance, lod.level >= 2))
+      level = 2;
+    else if (lod.bounds &&
+        beyond(distance, this->lodBoxDistance, lod.level >= 1))
+      level = 1;
+
+    if (level != lod.level)
+      this->SetLodLevel(lod, visual, level);
+    this->lodCursor++;
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateCulling()
+{
+  if (!this->culling && nullptr == this->sceneIndex)
+    return;
+
+  // Rebuilt at most once per frame, however many visuals were added or
+  // removed
+  if (this->cullDirty)
+  {
+    std::vector<CullingBvh::Item> items;
+    items.reserve(this->lodVisuals.size());
+    for (std::size_t i = 0; i < this->lodVisuals.size();)
+    {
+      const auto &lod = this->lodVisuals[i];
+      auto visual = lod.visual.lock();
+      if (nullptr == visual)
+      {
+        this->RemoveLodVisual(i);
+        continue;
+      }
+      ++i;
+      if (0 == lod.cullId)
+        continue;
+      auto [min, max] = worldBox(*lod.cullBounds, visual->WorldPose(),
+          visual->WorldScale());
+      items.push_back({lod.cullId, min, max});
+
+      // Visuals merged into a static batch have no parent, and keep the
+      // box they had
+      if (nullptr != this->sceneIndex && nullptr != visual->Parent())
+        this->sceneIndex->Set(lod.entityId, min, max);
+    }
+    if (this->culling)
+      this->cullBvh.Build(std::move(items));
+    this->cullDirty = false;
+    this->cullMoved.clear();
+  }
+
+  for (const auto id : this->cullMoved)
+  {
+    auto it = this->cullIndex.find(id);
+    if (it == this->cullIndex.end())
+      continue;
+    const auto &lod = this->lodVisuals[it->second];
+    if (auto visual = lod.visual.lock())
+    {
+      auto [min, max] = worldBox(*lod.cullBounds, visual->WorldPose(),
+          visual->WorldScale());
+      if (this->culling)
+        this->cullBvh.Update(id, min, max);
+      if (nullptr != this->sceneIndex)
+        this->sceneIndex->Set(lod.entityId, min, max);
+    }
+  }
+  this->cullMoved.clear();
+
+  if (!this->culling)
+    return;
+
+  auto camera = this->UserCamera();
+  if (nullptr == camera)
+    return;
+
+  ++this->cullFrame;
+  std::size_t tested{0};
+  std::vector<std::size_t> visible;
+  if (camera->ProjectionType() == rendering::CPT_PERSPECTIVE)
+  {
+    tested = this->cullBvh.Query(frustumPlanes(*camera), visible);
+  }
+  else
+  {
+    // Orthographic views aren't culled
+    tested = this->cullBvh.Query({}, visible);
+  }
+  for (const auto id : visible)
+  {
+    auto it = this->cullIndex.find(id);
+    if (it != this->cullIndex.end())
+      this->lodVisuals[it->second].visibleFrame = this->cullFrame;
+  }
+
+  std::size_t culledCount{0};
+  for (std::size_t i = 0; i < this->lodVisuals.size();)
+  {
+    auto &lod = this->lodVisuals[i];
+    auto visual = lod.visual.lock();
+    if (nullptr == visual)
+    {
+      this->RemoveLodVisual(i);
+      continue;
+    }
+    ++i;
+    if (0 == lod.cullId)
+      continue;
+
+    const bool culled = lod.visibleFrame != this->cullFrame;
+    if (culled)
+      ++culledCount;
+    if (culled != lod.culled)
+    {
+      lod.culled = culled;
+      this->SetLodLevel(lod, visual, lod.level);
+    }
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (this->cullStatsPub && now - this->lastCullStats >=
+      std::chrono::milliseconds(250))
+  {
+    this->lastCullStats = now;
+    msgs::Param msg;
+    setParam(msg, "visible", static_cast<double>(visible.size()));
+    setParam(msg, "culled", static_cast<double>(culledCount));
+    setParam(msg, "tested", static_cast<double>(tested));
+    if (this->lazyPoses)
+    {
+      setParam(msg, "deferred",
+          static_cast<double>(this->deferredPoses.Size()));
+    }
+    this->cullStatsPub.Publish(msg);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateCameraTargets()
+{
+  this->cameraTargetNodes.clear();
+  auto camera = this->UserCamera();
+  if (nullptr == camera)
+    return;
+
+  for (auto node : {camera->FollowTarget(), camera->TrackTarget()})
+  {
+    for (; nullptr != node; node = node->Parent())
+      this->cameraTargetNodes.insert(node->Id());
+  }
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManager::Implementation::CanDeferPose(unsigned int _id,
+    const Entity &_entity, const SceneSelection *_selection) const
+{
+  // Collapsed links and batched models are posed through other nodes, and
+  // lights light what's in view
+  if (!this->lazyPoses || !this->culling || _entity.cullIds.empty() ||
+      _entity.flatLink || _entity.batchModel)
+  {
+    return false;
+  }
+
+  for (const auto cullId : _entity.cullIds)
+  {
+    auto it = this->cullIndex.find(cullId);
+    if (it == this->cullIndex.end() || !this->lodVisuals[it->second].culled)
+      return false;
+  }
+
+  // Others look these up wherever they are
+  if (nullptr != _selection &&
+      _selection->Contains(_id + this->idOffset))
+  {
+    return false;
+  }
+  auto visual = _entity.visual.lock();
+  return nullptr != visual && this->cameraTargetNodes.count(visual->Id()) == 0;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::DeferPose(unsigned int _id,
+    const Entity &_entity, const math::Pose3d &_pose)
+{
+  if (this->deferredPoses.Update(_id, _pose))
+    return;
+
+  auto visual = _entity.visual.lock();
+  if (nullptr == visual)
+    return;
+
+  // Sphere around the boxes of its visuals, as they are in the scene
+  const double inf = std::numeric_limits<double>::max();
+  math::Vector3d min(inf, inf, inf);
+  math::Vector3d max(-inf, -inf, -inf);
+  for (const auto cullId : _entity.cullIds)
+  {
+    auto it = this->cullIndex.find(cullId);
+    if (it == this->cullIndex.end())
+      continue;
+    const auto &lod = this->lodVisuals[it->second];
+    auto lodVisual = lod.visual.lock();
+    if (nullptr == lodVisual || !lod.cullBounds)
+      continue;
+    auto [boxMin, boxMax] = worldBox(*lod.cullBounds,
+        lodVisual->WorldPose(), lodVisual->WorldScale());
+    min.Min(boxMin);
+    max.Max(boxMax);
+  }
+  if (min.X() > max.X())
+    return;
+
+  // Its center in the frame the received poses place
+  auto center = visual->WorldPose().Inverse().CoordPositionAdd(
+      (min + max) * 0.5);
+  if (_entity.needsLocalPose)
+    center = _entity.localPose.CoordPositionAdd(center);
+  this->deferredPoses.Add(_id, _pose, center, (max - min).Length() * 0.5);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ApplyDeferredPoses(bool _all)
+{
+  if (0 == this->deferredPoses.Size())
+    return;
+
+  auto camera = this->UserCamera();
+  if (nullptr == camera || !this->culling)
+    _all = true;
+
+  std::vector<CullPlane> planes;
+  if (!_all && camera->ProjectionType() == rendering::CPT_PERSPECTIVE)
+    planes = frustumPlanes(*camera);
+
+  auto selection = SceneServices::Get<SceneSelection>(
+      SceneServices::kSelection);
+
+  auto parentPose = [this](unsigned int _id) -> std::optional<math::Pose3d>
+  {
+    auto entity = this->entities.Find(_id);
+    if (nullptr == entity)
+      return std::nullopt;
+    auto visual = entity->visual.lock();
+    if (nullptr == visual)
+      return std::nullopt;
+    auto parent = visual->Parent();
+    return nullptr == parent ? math::Pose3d::Zero : parent->WorldPose();
+  };
+  // Also those whose stale visuals came into view where they were left
+  auto pinned = [&](unsigned int _id)
+  {
+    if (nullptr != selection &&
+        selection->Contains(_id + this->idOffset))
+    {
+      return true;
+    }
+    auto entity = this->entities.Find(_id);
+    if (nullptr == entity)
+      return false;
+    for (const auto cullId : entity->cullIds)
+    {
+      auto it = this->cullIndex.find(cullId);
+      if (it != this->cullIndex.end() && !this->lodVisuals[it->second].culled)
+        return true;
+    }
+    auto visual = entity->visual.lock();
+    return nullptr != visual && this->cameraTargetNodes.count(visual->Id()) > 0;
+  };
+
+  // Children are tested again once their parents moved
+  while (true)
+  {
+    auto poses = _all ? this->deferredPoses.TakeAll() :
+        this->deferredPoses.TakeVisible(planes, parentPose, pinned);
+    if (poses.empty())
+      break;
+
+    for (const auto &[id, pose] : poses)
+    {
+      auto entity = this->entities.Find(id);
+      if (nullptr == entity || !applyPose(*entity, pose))
+        continue;
+      this->cullMoved.insert(this->cullMoved.end(),
+          entity->cullIds.begin(), entity->cullIds.end());
+      if (entity->batchModel)
+        this->OnModelMoved(*entity->batchModel);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateLights()
+{
+  // Lights hidden by the scene history mustn't be attached back
+  if (!this->budgetingLights || this->historyShown)
+    return;
+
+  auto camera = this->UserCamera();
+  if (nullptr == camera)
+    return;
+
+  // Lights attached to moving models are caught up with a few times per
+  // second, the camera every frame it moves
+  const auto now = std::chrono::steady_clock::now();
+  const math::Pose3d cameraPose = camera->WorldPose();
+  if (!this->lightsDirty && cameraPose == this->lightsCameraPose &&
+      now - this->lastLightUpdate < std::chrono::milliseconds(250))
+  {
+    return;
+  }
+  this->lightsDirty = false;
+  this->lightsCameraPose = cameraPose;
+  this->lastLightUpdate = now;
+
+  std::vector<LightBudget::Light> candidates;
+  candidates.reserve(this->budgetedLights.size());
+  for (auto it = this->budgetedLights.begin();
+      it != this->budgetedLights.end();)
+  {
+    auto &budgeted = it->second;
+    auto light = budgeted.light.lock();
+    rendering::NodePtr parent;
+    if (!budgeted.active)
+      parent = budgeted.parent.lock();
+    else if (nullptr != light)
+      parent = light->Parent();
+    if (nullptr == light || (!budgeted.active && nullptr == parent))
+    {
+      // Detached lights aren't destroyed along with their parent
+      if (nullptr != light)
+        this->scene->DestroyLight(light, true);
+      it = this->budgetedLights.erase(it);
+      continue;
+    }
+
+    // Not attached yet, or being destroyed
+    if (nullptr == parent)
+    {
+      ++it;
+      continue;
+    }
+    budgeted.parent = parent;
+
+    LightBudget::Light candidate;
+    candidate.id = it->first;
+    candidate.position = budgeted.active ? light->WorldPosition() :
+        (parent->WorldPose() * light->LocalPose()).Pos();
+    candidate.range = budgeted.range;
+    candidate.brightness = budgeted.brightness;
+    candidate.directional = budgeted.directional;
+    candidate.castShadows = budgeted.castShadows;
+    candidates.push_back(candidate);
+    ++it;
+  }
+
+  const auto changes = this->lightBudget.Update(candidates,
+      cameraPose.Pos(), camera->ProjectionType() ==
+      rendering::CPT_PERSPECTIVE ? frustumPlanes(*camera) :
+      std::vector<CullPlane>());
+  for (const auto &change : changes)
+  {
+    auto &budgeted = this->budgetedLights[change.id];
+    auto light = budgeted.light.lock();
+    auto parent = budgeted.parent.lock();
+    if (nullptr == light || nullptr == parent)
+      continue;
+
+    // Detached lights are left out of the renderer's light lists
+    // altogether, instead of being lit at zero intensity
+    if (change.active != budgeted.active)
+    {
+      if (change.active)
+        parent->AddChild(light);
+      else
+        parent->RemoveChild(light);
+      budgeted.active = change.active;
+    }
+    light->SetCastShadows(change.shadows);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateBatching()
+{
+  if (!this->batching)
+    return;
+
+  // Settling is measured in seconds, no need to look every frame
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->lastBatchCheck < std::chrono::seconds(1))
+    return;
+  this->lastBatchCheck = now;
+
+  std::map<BatchCellKey, std::vector<unsigned int>> settled;
+  for (auto it = this->batchModels.begin(); it != this->batchModels.end();)
+  {
+    auto &model = it->second;
+    auto visual = model.visual.lock();
+    if (nullptr == visual)
+    {
+      if (model.cell)
+        this->DissolveBatch(*model.cell);
+      it = this->batchModels.erase(it);
+      continue;
+    }
+
+    if (!model.cell && !model.sources.empty() &&
+        (model.isStatic || now - model.lastMoved >= this->batchSettleTime))
+    {
+      const math::Vector3d pos = visual->WorldPosition() /
+          this->batchCellSize;
+      settled[{static_cast<int>(std::floor(pos.X())),
+          static_cast<int>(std::floor(pos.Y())),
+          static_cast<int>(std::floor(pos.Z()))}].push_back(it->first);
+    }
+    ++it;
+  }
+
+  // Merging copies every vertex, so it shares the load budget and the
+  // remaining cells are merged on the next checks
+  for (auto &[key, models] : settled)
+  {
+    auto existing = this->batchCells.find(key);
+    if (existing != this->batchCells.end())
+    {
+      models.insert(models.end(), existing->second.models.begin(),
+          existing->second.models.end());
+      this->DissolveBatch(key);
+    }
+    this->BuildBatch(key, models);
+
+    if (this->loadBudget.count() > 0 &&
+        std::chrono::steady_clock::now() - now >= this->loadBudget)
+    {
+      break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::BuildBatch(
+    const BatchCellKey &_key, const std::vector<unsigned int> &_models)
+{
+  GZ_GUI_PROFILE("TransportSceneManager::BuildBatch");
+
+  // Keeps each merged submesh within a size the render engine handles well
+  constexpr std::size_t kMaxVertices{1u << 20};
+
+  BatchCell cell;
+  cell.models = _models;
+
+  // One submesh per material, or more if a material has many vertices
+  std::vector<std::pair<rendering::MaterialPtr, common::SubMesh>> groups;
+  std::unordered_map<rendering::Material *, std::size_t> groupIndex;
+
+  for (const auto id : _models)
+  {
+    auto model = this->batchModels.find(id);
+    if (model == this->batchModels.end())
+      continue;
+    model->second.cell = _key;
+
+    for (const auto &source : model->second.sources)
+    {
+      auto visual = source.visual.lock();
+      if (nullptr == visual)
+        continue;
+      auto parent = std::dynamic_pointer_cast<rendering::Visual>(
+          visual->Parent());
+      const common::Mesh *mesh =
+          common::MeshManager::Instance()->MeshByName(source.meshName);
+      if (nullptr == parent || nullptr == mesh ||
+          0 == visual->GeometryCount())
+      {
+        continue;
+      }
+
+      std::vector<std::shared_ptr<common::SubMesh>> subMeshes;
+      if (!source.subMesh.empty())
+      {
+        subMeshes.push_back(mesh->SubMeshByName(source.subMesh).lock());
+      }
+      else
+      {
+        for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+          subMeshes.push_back(mesh->SubMeshByIndex(i).lock());
+      }
+
+      // Materials are per submesh for meshes, and per geometry for
+      // primitives
+      auto geom = visual->GeometryByIndex(0);
+      auto geomMesh = std::dynamic_pointer_cast<rendering::Mesh>(geom);
+      std::vector<rendering::MaterialPtr> materials;
+      for (unsigned int i = 0; i < subMeshes.size(); ++i)
+      {
+        if (nullptr != geomMesh && geomMesh->SubMeshCount() == subMeshes.size())
+          materials.push_back(geomMesh->SubMeshByIndex(i)->Material());
+        else if (1 == subMeshes.size())
+          materials.push_back(geom->Material());
+      }
+
+      const math::Vector3d scale = visual->WorldScale();
+      const bool mergeable = materials.size() == subMeshes.size() &&
+          std::all_of(materials.begin(), materials.end(),
+          [](const rendering::MaterialPtr &_material)
+          {
+            return nullptr != _material;
+          }) &&
+          std::all_of(subMeshes.begin(), subMeshes.end(),
+          [](const std::shared_ptr<common::SubMesh> &_subMesh)
+          {
+            return nullptr != _subMesh &&
+                _subMesh->SubMeshPrimitiveType() == common::SubMesh::TRIANGLES;
+          }) &&
+          0 != scale.X() && 0 != scale.Y() && 0 != scale.Z();
+      if (!mergeable)
+        continue;
+
+      const math::Pose3d pose = visual->WorldPose();
+      for (std::size_t s = 0; s < subMeshes.size(); ++s)
+      {
+        const auto &subMesh = *subMeshes[s];
+        auto &index = groupIndex.try_emplace(materials[s].get(),
+            groups.size()).first->second;
+        if (index == groups.size() || groups[index].second.VertexCount() +
+            subMesh.VertexCount() > kMaxVertices)
+        {
+          index = groups.size();
+          groups.emplace_back(materials[s], common::SubMesh());
+          groups.back().second.SetPrimitiveType(common::SubMesh::TRIANGLES);
+        }
+        auto &merged = groups[index].second;
+
+        const math::Vector3d offset = source.centerSubMesh ?
+            -(subMesh.Min() + subMesh.Max()) * 0.5 : math::Vector3d::Zero;
+        const bool hasNormals = subMesh.NormalCount() == subMesh.VertexCount();
+        const bool hasTexCoords =
+            subMesh.TexCoordCount() == subMesh.VertexCount();
+        const unsigned int base =
+            static_cast<unsigned int>(merged.VertexCount());
+        for (unsigned int v = 0; v < subMesh.VertexCount(); ++v)
+        {
+          merged.AddVertex(pose.Pos() +
+              pose.Rot() * ((subMesh.Vertex(v) + offset) * scale));
+
+          // Normals follow the inverse transpose of the scale
+          const math::Vector3d normal = hasNormals ?
+              subMesh.Normal(v) / scale : math::Vector3d::UnitZ / scale;
+          merged.AddNormal(pose.Rot() * normal.Normalized());
+          merged.AddTexCoord(hasTexCoords ? subMesh.TexCoord(v) :
+              math::Vector2d::Zero);
+        }
+        for (unsigned int i = 0; i < subMesh.IndexCount(); ++i)
+          merged.AddIndex(base + static_cast<unsigned int>(subMesh.Index(i)));
+      }
+      cell.detached.emplace_back(visual, parent);
+    }
+  }
+
+  if (!groups.empty())
+  {
+    auto mesh = new common::Mesh();
+    cell.meshName =
+        "__static_batch_" + std::to_string(++this->assets->batchCount);
+    mesh->SetName(cell.meshName);
+    for (const auto &group : groups)
+    {
+      mesh->AddSubMesh(group.second);
+      cell.bytes += group.second.VertexCount() * (8u * sizeof(float)) +
+          group.second.IndexCount() * sizeof(uint32_t);
+    }
+    common::MeshManager::Instance()->AddMesh(mesh);
+
+    rendering::MeshDescriptor descriptor;
+    descriptor.mesh = mesh;
+    descriptor.meshName = cell.meshName;
+    auto geom = this->scene->CreateMesh(descriptor);
+    for (unsigned int i = 0; i < geom->SubMeshCount(); ++i)
+      geom->SubMeshByIndex(i)->SetMaterial(groups[i].first, false);
+
+    cell.merged = this->scene->CreateVisual();
+    cell.merged->AddGeometry(geom);
+    this->scene->RootVisual()->AddChild(cell.merged);
+    for (const auto &[visual, parent] : cell.detached)
+      parent.lock()->RemoveChild(visual);
+    this->batchMemory.Add(cell.bytes);
+  }
+
+  gzdbg << "Merged [" << cell.detached.size() << "] visuals of ["
+        << _models.size() << "] static models into [" << groups.size()
+        << "] submeshes" << std::endl;
+  this->batchCells[_key] = std::move(cell);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::DissolveBatch(
+    const BatchCellKey &_key)
+{
+  auto it = this->batchCells.find(_key);
+  if (it == this->batchCells.end())
+    return;
+
+  auto &cell = it->second;
+  for (const auto &[visual, parent] : cell.detached)
+  {
+    if (auto parentVis = parent.lock())
+      parentVis->AddChild(visual);
+  }
+  if (nullptr != cell.merged)
+  {
+    this->scene->DestroyVisual(cell.merged, true);
+    common::MeshManager::Instance()->RemoveMesh(cell.meshName);
+    this->batchMemory.Remove(cell.bytes);
+  }
+  for (const auto id : cell.models)
+  {
+    auto model = this->batchModels.find(id);
+    if (model != this->batchModels.end())
+      model->second.cell.reset();
+  }
+  this->batchCells.erase(it);
+
+  // The visuals are back with their parents, update their boxes
+  this->cullDirty = this->culling || nullptr != this->sceneIndex;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnModelMoved(unsigned int _id)
+{
+  auto model = this->batchModels.find(_id);
+  if (model == this->batchModels.end())
+    return;
+
+  model->second.lastMoved = std::chrono::steady_clock::now();
+  if (model->second.cell)
+    this->DissolveBatch(*model->second.cell);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::LoadTerrain(
+    const rendering::VisualPtr &_visual, const msgs::Visual &_msg)
+{
+  const auto &heightmap = _msg.geometry().heightmap();
+  const math::Vector3d size = msgs::Convert(heightmap.size());
+
+  Terrain terrain;
+  terrain.visual = _visual;
+  if (heightmap.has_origin())
+    terrain.origin = msgs::Convert(heightmap.origin());
+  terrain.skirtDepth = std::max(0.1, std::abs(size.Z()) * 0.1);
+  terrain.material = this->SharedMaterial(
+      _msg.has_material() ? &_msg.material() : nullptr, _msg.transparency(),
+      _msg.cast_shadows());
+  terrain.results = std::make_shared<TerrainResults>();
+
+  // Images may be several thousand pixels wide, read them off the render
+  // thread
+  this->workers.AddWork(
+      [heightmap, size, results = terrain.results,
+       segments = this->terrainTileSegments]()
+      {
+        std::vector<float> heights;
+        unsigned int width{0};
+        unsigned int height{0};
+        if (heightmap.heights_size() > 0)
+        {
+          width = static_cast<unsigned int>(heightmap.width());
+          height = static_cast<unsigned int>(heightmap.height());
+          if (width < 2 || height < 2 ||
+              static_cast<int>(width * height) != heightmap.heights_size())
+          {
+            gzerr << "Heightmap has [" << heightmap.heights_size()
+                  << "] heights, which doesn't match its size [" << width
+                  << " x " << height << "]" << std::endl;
+            return;
+          }
+          heights.assign(heightmap.heights().begin(),
+              heightmap.heights().end());
+        }
+        else
+        {
+          common::Image image(heightmap.filename());
+          width = image.Width();
+          height = image.Height();
+          if (!image.Valid() || width < 2 || height < 2)
+          {
+            gzerr << "Failed to read heightmap [" << heightmap.filename()
+                  << "]" << std::endl;
+            return;
+          }
+
+          // Images start at the top, which is +Y
+          heights.resize(static_cast<std::size_t>(width) * height);
+          for (unsigned int y = 0; y < height; ++y)
+          {
+            for (unsigned int x = 0; x < width; ++x)
+            {
+              heights[static_cast<std::size_t>(height - 1 - y) * width + x] =
+                  static_cast<float>(image.Pixel(x, y).R() * size.Z());
+            }
+          }
+        }
+
+        auto tiles = std::make_shared<const TerrainTiles>(std::move(heights),
+            width, height, size, segments);
+        {
+          std::lock_guard<std::mutex> lock(results->mutex);
+          results->tiles = std::move(tiles);
+        }
+        RenderHooks::RequestRender();
+      });
+
+  this->terrains.push_back(std::move(terrain));
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UpdateTerrain()
+{
+  // Tiles queued on the workers at once for each terrain, so moving the
+  // camera quickly doesn't pile up work for tiles already left behind
+  constexpr std::size_t kMaxBuilding{4};
 
-  // Custom parameters
-  if (_pluginElem)
+  if (this->terrains.empty())
+    return;
+
+  auto camera = this->UserCamera();
+  for (std::size_t i = 0; i < this->terrains.size();)
   {
-    auto elem = _pluginElem->FirstChildElement("service");
-    if (nullptr != elem && nullptr != elem->GetText())
+    auto &terrain = this->terrains[i];
+    auto visual = terrain.visual.lock();
+    if (nullptr == visual)
     {
-      this->dataPtr->service =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      // The tile visuals were destroyed along with their parent
+      for (const auto &loaded : terrain.loaded)
+      {
+        common::MeshManager::Instance()->RemoveMesh(loaded.second.meshName);
+        this->terrainMemory.Remove(loaded.second.bytes);
+      }
+      if (i + 1 != this->terrains.size())
+        terrain = std::move(this->terrains.back());
+      this->terrains.pop_back();
+      continue;
     }
+    ++i;
 
-    elem = _pluginElem->FirstChildElement("pose_topic");
-    if (nullptr != elem && nullptr != elem->GetText())
+    std::vector<std::pair<TerrainTiles::Tile, TerrainTiles::TileMesh>> built;
     {
-      this->dataPtr->poseTopic =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      std::lock_guard<std::mutex> lock(terrain.results->mutex);
+      if (nullptr == terrain.tiles)
+        terrain.tiles = terrain.results->tiles;
+      built.swap(terrain.results->built);
     }
+    for (const auto &tile : built)
+      terrain.building.erase({tile.first.x, tile.first.y});
+    if (nullptr == terrain.tiles || nullptr == camera)
+      continue;
 
-    elem = _pluginElem->FirstChildElement("deletion_topic");
-    if (nullptr != elem && nullptr != elem->GetText())
+    // Camera in the terrain frame, ignoring scale
+    const math::Pose3d pose = visual->WorldPose() *
+        math::Pose3d(terrain.origin, math::Quaterniond::Identity);
+    const math::Vector3d cameraPos = pose.Rot().RotateVectorReverse(
+        camera->WorldPosition() - pose.Pos());
+    const auto wanted = terrain.tiles->Select(cameraPos,
+        this->terrainLoadRadius, this->terrainLodDistance);
+
+    // Tiles are kept a bit past the radius, so they aren't destroyed and
+    // created again while the camera moves back and forth at the boundary
+    std::set<std::pair<int, int>> kept;
+    for (const auto &tile : terrain.tiles->Select(cameraPos,
+        this->terrainLoadRadius * 1.2, 0.0))
     {
-      this->dataPtr->deletionTopic =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      kept.insert({tile.x, tile.y});
     }
 
-    elem = _pluginElem->FirstChildElement("scene_topic");
-    if (nullptr != elem && nullptr != elem->GetText())
+    for (const auto &[tile, mesh] : built)
     {
-      this->dataPtr->sceneTopic =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      if (kept.count({tile.x, tile.y}) > 0)
+        this->CreateTerrainTile(terrain, visual, tile, mesh);
+    }
+    for (auto it = terrain.loaded.begin(); it != terrain.loaded.end();)
+    {
+      if (kept.count(it->first) > 0)
+      {
+        ++it;
+        continue;
+      }
+      this->DestroyTerrainTile(it->second);
+      it = terrain.loaded.erase(it);
     }
-  }
 
-  QQmlProperty::write(this->PluginItem(), "service",
-      QString::fromStdString(this->dataPtr->service));
-  QQmlProperty::write(this->PluginItem(), "poseTopic",
-      QString::fromStdString(this->dataPtr->poseTopic));
-  QQmlProperty::write(this->PluginItem(), "deletionTopic",
-      QString::fromStdString(this->dataPtr->deletionTopic));
-  QQmlProperty::write(this->PluginItem(), "sceneTopic",
-      QString::fromStdString(this->dataPtr->sceneTopic));
+    // Nearest first. Tiles changing level keep showing the previous level
+    // until the new one is built.
+    for (const auto &tile : wanted)
+    {
+      if (terrain.building.size() >= kMaxBuilding)
+        break;
+      const std::pair<int, int> key{tile.x, tile.y};
+      auto loaded = terrain.loaded.find(key);
+      if ((loaded != terrain.loaded.end() && loaded->second.lod == tile.lod) ||
+          terrain.building.count(key) > 0)
+      {
+        continue;
+      }
 
-  if (this->dataPtr->service.empty() ||
-      this->dataPtr->poseTopic.empty() ||
-      this->dataPtr->deletionTopic.empty() ||
-      this->dataPtr->sceneTopic.empty())
-  {
-    gzerr << "One or more transport parameters invalid:" << std::endl
-        << "  * <service>: " << this->dataPtr->service << std::endl
-        << "  * <pose_topic>: " << this->dataPtr->poseTopic << std::endl
-        << "  * <deletion_topic>: " << this->dataPtr->deletionTopic << std::endl
-        << "  * <scene_topic>: " << this->dataPtr->sceneTopic << std::endl;
+      terrain.building.insert(key);
+      this->workers.AddWork(
+          [tiles = terrain.tiles, results = terrain.results, tile,
+           skirtDepth = terrain.skirtDepth]()
+          {
+            auto mesh = tiles->Build(tile, skirtDepth);
+            {
+              std::lock_guard<std::mutex> lock(results->mutex);
+              results->built.emplace_back(tile, std::move(mesh));
+            }
+            RenderHooks::RequestRender();
+          });
+    }
   }
-  else
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::CreateTerrainTile(
+    Terrain &_terrain, const rendering::VisualPtr &_parent,
+    const TerrainTiles::Tile &_tile, const TerrainTiles::TileMesh &_mesh)
+{
+  common::SubMesh subMesh;
+  subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  for (std::size_t v = 0; v < _mesh.positions.size(); ++v)
   {
-    App()->findChild<MainWindow *>()->installEventFilter(this);
+    subMesh.AddVertex(_mesh.positions[v]);
+    subMesh.AddNormal(_mesh.normals[v]);
+    subMesh.AddTexCoord(_mesh.texCoords[v]);
   }
+  for (const auto index : _mesh.indices)
+    subMesh.AddIndex(index);
+
+  TerrainTile created;
+  created.lod = _tile.lod;
+  created.meshName =
+      "__terrain_tile_" + std::to_string(++this->assets->terrainTileCount);
+  created.bytes = _mesh.positions.size() * (8u * sizeof(float)) +
+      _mesh.indices.size() * sizeof(uint32_t);
+
+  auto mesh = new common::Mesh();
+  mesh->SetName(created.meshName);
+  mesh->AddSubMesh(subMesh);
+  common::MeshManager::Instance()->AddMesh(mesh);
+
+  rendering::MeshDescriptor descriptor;
+  descriptor.mesh = mesh;
+  descriptor.meshName = created.meshName;
+  auto geom = this->scene->CreateMesh(descriptor);
+  geom->SetMaterial(_terrain.material, false);
+
+  created.visual = this->scene->CreateVisual();
+  created.visual->AddGeometry(geom);
+  created.visual->SetLocalPosition(_terrain.origin);
+  _parent->AddChild(created.visual);
+  this->terrainMemory.Add(created.bytes);
+
+  auto &slot = _terrain.loaded[{_tile.x, _tile.y}];
+  if (nullptr != slot.visual)
+    this->DestroyTerrainTile(slot);
+  slot = std::move(created);
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::InitializeTransport()
+void TransportSceneManager::Implementation::DestroyTerrainTile(
+    const TerrainTile &_tile)
 {
-  this->Request();
+  this->scene->DestroyVisual(_tile.visual, true);
+  common::MeshManager::Instance()->RemoveMesh(_tile.meshName);
+  this->terrainMemory.Remove(_tile.bytes);
+}
 
-  if (!this->node.Subscribe(this->poseTopic,
-      &Implementation::OnPoseVMsg, this))
-  {
-    gzerr << "Error subscribing to pose topic: " << this->poseTopic
-      << std::endl;
-  }
-  else
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::SetLodLevel(LodVisual &_lod,
+    const rendering::VisualPtr &_visual, int _level)
+{
+  auto standIn = _lod.standIn.lock();
+  if (1 == _level && nullptr == standIn)
   {
-    gzmsg << "Listening to pose messages on [" << this->poseTopic << "]"
-           << std::endl;
-  }
+    auto parent = std::dynamic_pointer_cast<rendering::Visual>(
+        _visual->Parent());
+    if (nullptr == parent)
+      return;
 
-  if (!this->node.Subscribe(this->deletionTopic,
-      &Implementation::OnDeletionMsg, this))
-  {
-    gzerr << "Error subscribing to deletion topic: " << this->deletionTopic
-      << std::endl;
-  }
-  else
-  {
-    gzmsg << "Listening to deletion messages on [" << this->deletionTopic
-           << "]" << std::endl;
+    standIn = this->scene->CreateVisual();
+    auto box = this->scene->CreateBox();
+    box->SetMaterial(this->SharedMaterial(nullptr, 0.0, false), false);
+    standIn->AddGeometry(box);
+    parent->AddChild(standIn);
+    _lod.standIn = standIn;
   }
 
-  if (!this->node.Subscribe(this->sceneTopic,
-      &Implementation::OnSceneMsg, this))
-  {
-    gzerr << "Error subscribing to scene topic: " << this->sceneTopic
-           << std::endl;
-  }
-  else
+  if (nullptr != standIn)
   {
-    gzmsg << "Listening to scene messages on [" << this->sceneTopic << "]"
-           << std::endl;
+    if (1 == _level)
+    {
+      // Follow the visual, in case it moved relative to its parent
+      const math::Vector3d scale = _visual->LocalScale();
+      standIn->SetLocalScale(_lod.bounds->Size() * scale);
+      standIn->SetLocalPose(_visual->LocalPose() *
+          math::Pose3d(_lod.bounds->Center() * scale, math::Quaterniond()));
+    }
+    standIn->SetVisible(1 == _level && !_lod.culled);
   }
 
-  gzmsg << "Transport initialized." << std::endl;
+  _visual->SetVisible(0 == _level && !_lod.culled);
+  _lod.level = _level;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::OnSceneMsg(
+    const std::shared_ptr<const msgs::Scene> &_msg)
+{
+  this->QueueScene(_msg);
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
-bool TransportSceneManager::eventFilter(QObject *_obj, QEvent *_event)
+void TransportSceneManager::Implementation::OnSceneSrvMsg(
+  const msgs::Scene &_msg, const bool result)
 {
-  if (_event->type() == events::Render::kType)
+  if (!result)
   {
-    this->dataPtr->OnRender();
+    gzerr << "Error making service request to " << this->service
+           << std::endl;
+    this->requestFailed = true;
+    return;
   }
 
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  // Only given for the call, so it's copied, to an arena
+  this->QueueScene(RetainCopy(_msg));
+  if (!this->sceneCacheFile.empty())
+    this->UpdateSceneCache(_msg);
+  RenderHooks::RequestRender();
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::Request()
+void TransportSceneManager::Implementation::LoadSceneCache()
 {
-  // wait for the service to be advertized
-  std::vector<transport::ServicePublisher> publishers;
-  const std::chrono::duration<double> sleepDuration{1.0};
-  const std::size_t tries = 30;
-  for (std::size_t i = 0; i < tries; ++i)
+  if (this->sceneCacheFile.empty() ||
+      !common::isFile(this->sceneCacheFile))
   {
-    this->node.ServiceInfo(this->service, publishers);
-    if (publishers.size() > 0)
-      break;
-    std::this_thread::sleep_for(sleepDuration);
-    gzdbg << "Waiting for service [" << this->service << "]\n";
+    return;
   }
 
-  if (publishers.empty() || !this->node.Request(this->service,
-      &Implementation::OnSceneSrvMsg, this))
+  std::ifstream file(this->sceneCacheFile, std::ios::binary);
+  auto msg = NewArenaMessage<msgs::Scene>();
+  if (!msg->ParseFromIstream(&file))
   {
-    gzerr << "Error making service request to [" << this->service << "]"
+    gzwarn << "Ignoring invalid scene cache [" << this->sceneCacheFile << "]"
            << std::endl;
+    return;
+  }
+
+  this->QueueScene(msg);
+  {
+    std::lock_guard<std::mutex> lock(this->sceneMutex);
+    for (const auto &model : msg->model())
+      this->cachedIds.insert(model.id());
+    for (const auto &light : msg->light())
+      this->cachedIds.insert(light.id());
   }
+  RenderHooks::RequestRender();
+
+  gzmsg << "Loaded [" << msg->model_size() << "] models and ["
+        << msg->light_size() << "] lights from scene cache ["
+        << this->sceneCacheFile << "]" << std::endl;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnPoseVMsg(const msgs::Pose_V &_msg)
+void TransportSceneManager::Implementation::UpdateSceneCache(
+    const msgs::Scene &_msg)
 {
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  for (int i = 0; i < _msg.pose_size(); ++i)
+  // The server's scene replaces the cached one. Models and lights which
+  // changed were replaced by QueueScene, the ones which are gone are
+  // deleted here.
+  std::vector<unsigned int> stale;
   {
-    math::Pose3d pose = msgs::Convert(_msg.pose(i));
-
-    // apply additional local poses if available
-    const auto it = this->localPoses.find(_msg.pose(i).id());
-    if (it != this->localPoses.end())
+    std::lock_guard<std::mutex> lock(this->sceneMutex);
+    for (const auto &model : _msg.model())
+      this->cachedIds.erase(model.id());
+    for (const auto &light : _msg.light())
+      this->cachedIds.erase(light.id());
+    for (const auto id : this->cachedIds)
     {
-      pose = pose * it->second;
+      this->contentHashes.Erase(id);
+      this->renderStateModels.erase(id);
+      this->renderStateLights.erase(id);
+      stale.push_back(id);
     }
-
-    this->poses[_msg.pose(i).id()] = pose;
+    this->cachedIds.clear();
+  }
+  if (!stale.empty())
+  {
+    this->PublishRenderStateDeletions(stale);
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    this->toDeleteEntities.insert(this->toDeleteEntities.end(),
+        stale.begin(), stale.end());
   }
-}
 
-/////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnDeletionMsg(
-  const msgs::UInt32_V &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  std::copy(_msg.data().begin(), _msg.data().end(),
-            std::back_inserter(this->toDeleteEntities));
+  // Written to a temporary file first, so a crash doesn't leave a
+  // truncated cache
+  this->workers.AddWork(
+      [file = this->sceneCacheFile, data = _msg.SerializeAsString()]()
+      {
+        const std::string tmp = file + ".tmp";
+        {
+          std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+          out.write(data.data(), static_cast<std::streamsize>(data.size()));
+          if (!out)
+          {
+            gzwarn << "Failed to write scene cache [" << tmp << "]"
+                   << std::endl;
+            return;
+          }
+        }
+        if (0 != std::rename(tmp.c_str(), file.c_str()))
+        {
+          gzwarn << "Failed to write scene cache [" << file << "]"
+                 << std::endl;
+        }
+      });
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnRender()
+void TransportSceneManager::Implementation::QueueScene(
+    const std::shared_ptr<const msgs::Scene> &_msg)
 {
-  if (nullptr == this->scene)
+  std::lock_guard<std::mutex> sceneLock(this->sceneMutex);
+
+  // Returns false if the entity was already received with the same content
+  auto diff = [this](LoadTask &_task, std::size_t _hash)
   {
-    this->scene = rendering::sceneFromFirstRenderEngine();
-    if (nullptr == this->scene)
-      return;
+    const auto change = this->contentHashes.Update(_task.Id(), _hash);
+    _task.replace = change == ContentHashes::Change::MODIFIED;
+    return change != ContentHashes::Change::UNCHANGED;
+  };
 
-    this->initializeTransport = std::thread(
-        &Implementation::InitializeTransport, this);
+  if (this->poseFilter.Enabled())
+  {
+    std::lock_guard<std::mutex> filterLock(this->filterMutex);
+    for (const auto &model : _msg->model())
+    {
+      std::vector<unsigned int> children;
+      childIds(model, children);
+      this->poseFilter.AddModel(model.id(), model.name(),
+          msgs::Convert(model.pose()).Pos(), children);
+    }
   }
 
-  std::lock_guard<std::mutex> lock(this->msgMutex);
+  std::vector<LoadTask> tasks;
 
-  for (const auto &msg : this->sceneMsgs)
+  for (const auto &model : _msg->model())
   {
-    this->LoadScene(msg);
+    LoadTask task;
+    task.msg = RetainPart(_msg, model);
+    if (!diff(task, ContentHashes::Hash(model)))
+      continue;
+
+    std::vector<std::string> meshes;
+    meshFiles(model, meshes);
+    for (const auto &mesh : meshes)
+      this->ParseMesh(mesh);
+    std::vector<std::string> textureList;
+    textureFiles(model, textureList);
+    for (const auto &texture : textureList)
+      this->DecodeTexture(texture);
+    tasks.push_back(std::move(task));
   }
-  this->sceneMsgs.clear();
 
-  for (const auto &entity : this->toDeleteEntities)
+  for (const auto &light : _msg->light())
   {
-    this->DeleteEntity(entity);
+    LoadTask task;
+    task.msg = RetainPart(_msg, light);
+    if (diff(task, ContentHashes::Hash(light)))
+      tasks.push_back(std::move(task));
   }
-  this->toDeleteEntities.clear();
 
-  for (auto pIt = this->poses.begin(); pIt != this->poses.end();)
+  if (tasks.empty())
+    return;
+
+  // Other GUIs only get what changed
+  if (this->renderStateScenePub)
   {
-    auto vIt = this->visuals.find(pIt->first);
-    if (vIt != this->visuals.end())
+    auto changed = NewArenaMessage<msgs::Scene>();
+    for (const auto &task : tasks)
     {
-      auto visual = vIt->second.lock();
-      if (visual)
+      if (auto model = std::get_if<ModelHandle>(&task.msg))
       {
-        visual->SetLocalPose(pIt->second);
+        this->renderStateModels[(*model)->id()] = *model;
+        *changed->add_model() = **model;
       }
-      else
-      {
-        this->visuals.erase(vIt);
-      }
-      this->poses.erase(pIt++);
-    }
-    else
-    {
-      auto lIt = this->lights.find(pIt->first);
-      if (lIt != this->lights.end())
-      {
-        auto light = lIt->second.lock();
-        if (light)
-        {
-          light->SetLocalPose(pIt->second);
-        }
-        else
-        {
-          this->lights.erase(lIt);
-        }
-        this->poses.erase(pIt++);
-      }
-      else
+      else if (auto light = std::get_if<LightHandle>(&task.msg))
       {
-        ++pIt;
+        this->renderStateLights[(*light)->id()] = *light;
+        *changed->add_light() = **light;
       }
     }
+    this->renderStateScenePub.Publish(*changed);
   }
 
-  // Note we are clearing the pose msgs here but later on we may need to
-  // consider the case where pose msgs arrive before scene/visual msgs
-  this->poses.clear();
+  std::lock_guard<std::mutex> lock(this->msgMutex);
+  std::move(tasks.begin(), tasks.end(),
+      std::back_inserter(this->pendingLoadTasks));
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnSceneMsg(const msgs::Scene &_msg)
+bool TransportSceneManager::Implementation::OnRenderStateRequest(
+    msgs::Scene &_rep)
 {
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  this->sceneMsgs.push_back(_msg);
+  std::lock_guard<std::mutex> lock(this->sceneMutex);
+  for (const auto &[id, model] : this->renderStateModels)
+    *_rep.add_model() = *model;
+  for (const auto &[id, light] : this->renderStateLights)
+    *_rep.add_light() = *light;
+  return true;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::OnSceneSrvMsg(
-  const msgs::Scene &_msg, const bool result)
+void TransportSceneManager::Implementation::PublishRenderStateDeletions(
+    const std::vector<unsigned int> &_ids)
 {
-  if (!result)
-  {
-    gzerr << "Error making service request to " << this->service
-           << std::endl;
+  if (!this->renderStateDeletionPub)
     return;
+
+  msgs::UInt32_V msg;
+  for (const auto id : _ids)
+    msg.add_data(id);
+  this->renderStateDeletionPub.Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::LoadQueued()
+{
+  GZ_GUI_PROFILE("TransportSceneManager::LoadQueued");
+  const auto start = std::chrono::steady_clock::now();
+  while (!this->loadTasks.empty())
+  {
+    // Keep the order entities were received in. Meshes still being parsed
+    // are shown as placeholders until they're ready.
+    this->Load(this->loadTasks.front());
+    this->loadTasks.pop_front();
+    this->loadDone++;
+
+    if (this->loadBudget > std::chrono::steady_clock::duration::zero() &&
+        std::chrono::steady_clock::now() - start >= this->loadBudget)
+    {
+      // Continue next frame
+      if (!this->loadTasks.empty())
+        RenderHooks::RequestRender();
+      break;
+    }
   }
+}
 
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ReportLoadProgress()
+{
+  int progress{100};
+  if (this->loadTasks.empty())
   {
-    std::lock_guard<std::mutex> lock(this->msgMutex);
-    this->sceneMsgs.push_back(_msg);
+    this->loadTotal = 0;
+    this->loadDone = 0;
+  }
+  else
+  {
+    progress = static_cast<int>(100 * this->loadDone / this->loadTotal);
   }
+
+  if (progress == this->reportedProgress)
+    return;
+  this->reportedProgress = progress;
+
+  if (this->loadProgressCb)
+    this->loadProgressCb(progress / 100.0);
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManager::Implementation::LoadScene(const msgs::Scene &_msg)
+void TransportSceneManager::Implementation::Load(const LoadTask &_task)
 {
-  rendering::VisualPtr rootVis = this->scene->RootVisual();
+  rendering::VisualPtr rootVis = this->root;
 
-  // load models
-  for (int i = 0; i < _msg.model_size(); ++i)
+  // Modified entities are created again from scratch
+  if (_task.replace)
+    this->DeleteEntity(_task.Id());
+
+  if (auto model = _task.Model())
   {
     // Only add if it's not already loaded
-    if (this->visuals.find(_msg.model(i).id()) == this->visuals.end())
+    auto entity = this->entities.Find(model->id());
+    if (nullptr != entity && !entity->visual.expired())
+      return;
+
+    // A model spawned again right after being deleted would otherwise not
+    // get its name, which is still taken by the deleted one
+    if (!this->destroyQueue.empty() && !model->name().empty() &&
+        this->scene->HasVisualName(model->name()))
     {
-      rendering::VisualPtr modelVis = this->LoadModel(_msg.model(i));
-      if (modelVis)
-        rootVis->AddChild(modelVis);
-      else
-        gzerr << "Failed to load model: " << _msg.model(i).name() << std::endl;
+      this->DestroyQueued(true);
     }
-  }
 
-  // load lights
-  for (int i = 0; i < _msg.light_size(); ++i)
+    rendering::VisualPtr modelVis = this->LoadModel(*model);
+    if (!modelVis)
+    {
+      gzerr << "Failed to load model: " << model->name() << std::endl;
+      return;
+    }
+    rootVis->AddChild(modelVis);
+  }
+  else if (auto light = _task.Light())
   {
-    if (this->lights.find(_msg.light(i).id()) == this->lights.end())
+    auto entity = this->entities.Find(light->id());
+    if (nullptr != entity && !entity->light.expired())
+      return;
+
+    rendering::LightPtr lightPtr = this->LoadLight(*light);
+    if (!lightPtr)
     {
-      rendering::LightPtr light = this->LoadLight(_msg.light(i));
-      if (light)
-        rootVis->AddChild(light);
-      else
-        gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+      gzerr << "Failed to load light: " << light->name() << std::endl;
+      return;
     }
+    rootVis->AddChild(lightPtr);
   }
+
+  if (nullptr != this->sceneHistory)
+    this->topLevelIds.insert(_task.Id());
 }
 
 /////////////////////////////////////////////////
@@ -504,11 +4373,47 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadModel(
 
   if (_msg.has_pose())
     modelVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = modelVis;
+  auto &entity = this->entities.Insert(_msg.id());
+  entity.visual = modelVis;
+
+  if (this->labels && this->loadAncestors.empty() && !_msg.name().empty())
+  {
+    if (auto labels = SceneServices::Get<SceneLabels>(SceneServices::kLabels))
+    {
+      SceneLabel label;
+      label.text = _msg.name();
+      label.visualId = modelVis->Id();
+      label.position.Set(0, 0, this->labelHeight);
+      labels->Set(this, _msg.id(), std::move(label));
+    }
+  }
+  if (this->batching)
+  {
+    if (this->loadAncestors.empty())
+    {
+      auto &batchModel = this->batchModels[_msg.id()];
+      batchModel = BatchModel();
+      batchModel.visual = modelVis;
+      batchModel.isStatic = _msg.is_static();
+      batchModel.lastMoved = std::chrono::steady_clock::now();
+      entity.batchModel = _msg.id();
+    }
+    else
+    {
+      entity.batchModel = this->loadAncestors.front();
+    }
+  }
+  this->loadAncestors.push_back(_msg.id());
 
   // load links
   for (int i = 0; i < _msg.link_size(); ++i)
   {
+    if (this->flatten)
+    {
+      this->LoadFlatLink(_msg.link(i), modelVis);
+      continue;
+    }
+
     rendering::VisualPtr linkVis = this->LoadLink(_msg.link(i));
     if (linkVis)
       modelVis->AddChild(linkVis);
@@ -527,6 +4432,7 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadModel(
              << std::endl;
   }
 
+  this->loadAncestors.pop_back();
   return modelVis;
 }
 
@@ -537,38 +4443,95 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadLink(
   rendering::VisualPtr linkVis;
   if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
   {
-    linkVis = this->scene->CreateVisual(_msg.name());
+    linkVis = this->scene->CreateVisual(_msg.name());
+  }
+  else
+  {
+    linkVis = this->scene->CreateVisual();
+  }
+
+  if (_msg.has_pose())
+    linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
+  auto &entity = this->entities.Insert(_msg.id());
+  entity.visual = linkVis;
+  if (this->batching && !this->loadAncestors.empty())
+    entity.batchModel = this->loadAncestors.front();
+  this->loadAncestors.push_back(_msg.id());
+
+  // load visuals
+  for (int i = 0; i < _msg.visual_size(); ++i)
+  {
+    rendering::VisualPtr visualVis = this->LoadVisual(_msg.visual(i));
+    if (visualVis)
+      linkVis->AddChild(visualVis);
+    else
+      gzerr << "Failed to load visual: " << _msg.visual(i).name() << std::endl;
+  }
+
+  // load lights
+  for (int i = 0; i < _msg.light_size(); ++i)
+  {
+    rendering::LightPtr light = this->LoadLight(_msg.light(i));
+    if (light)
+      linkVis->AddChild(light);
+    else
+      gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+  }
+
+  this->loadAncestors.pop_back();
+  return linkVis;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::LoadFlatLink(
+    const msgs::Link &_msg, const rendering::VisualPtr &_parent)
+{
+  auto link = std::make_shared<FlatLink>();
+  if (_msg.has_pose())
+    link->pose = msgs::Convert(_msg.pose());
+  {
+    auto &entity = this->entities.Insert(_msg.id());
+    entity.flatLink = link;
+    if (this->batching && !this->loadAncestors.empty())
+      entity.batchModel = this->loadAncestors.front();
   }
-  else
+  this->loadAncestors.push_back(_msg.id());
+
+  // Nodes are created posed in the link, then moved to the link's parent
+  auto adopt = [&](const rendering::NodePtr &_node, unsigned int _id)
   {
-    linkVis = this->scene->CreateVisual();
-  }
+    const math::Pose3d pose = _node->LocalPose();
+    link->children.emplace_back(_node, pose);
+    _node->SetLocalPose(link->pose * pose);
+    _parent->AddChild(_node);
 
-  if (_msg.has_pose())
-    linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = linkVis;
+    auto entity = this->entities.Find(_id);
+    if (nullptr != entity)
+    {
+      entity->flatLink = link;
+      entity->flatChild = link->children.size() - 1;
+    }
+  };
 
-  // load visuals
   for (int i = 0; i < _msg.visual_size(); ++i)
   {
     rendering::VisualPtr visualVis = this->LoadVisual(_msg.visual(i));
     if (visualVis)
-      linkVis->AddChild(visualVis);
+      adopt(visualVis, _msg.visual(i).id());
     else
       gzerr << "Failed to load visual: " << _msg.visual(i).name() << std::endl;
   }
 
-  // load lights
   for (int i = 0; i < _msg.light_size(); ++i)
   {
     rendering::LightPtr light = this->LoadLight(_msg.light(i));
     if (light)
-      linkVis->AddChild(light);
+      adopt(light, _msg.light(i).id());
     else
       gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
   }
 
-  return linkVis;
+  this->loadAncestors.pop_back();
 }
 
 /////////////////////////////////////////////////
@@ -588,82 +4551,224 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadVisual(
     visualVis = this->scene->CreateVisual();
   }
 
-  this->visuals[_msg.id()] = visualVis;
+  auto &entity = this->entities.Insert(_msg.id());
+  entity.visual = visualVis;
+  if (this->batching && !this->loadAncestors.empty())
+    entity.batchModel = this->loadAncestors.front();
+
+  // Heightmaps are streamed in tiles around the camera, instead of being
+  // meshed whole
+  if (_msg.geometry().has_heightmap())
+  {
+    if (_msg.has_pose())
+      visualVis->SetLocalPose(msgs::Convert(_msg.pose()));
+    this->LoadTerrain(visualVis, _msg);
+    return visualVis;
+  }
+
+  // Meshes still being parsed are shown as a box, the size of the mesh
+  // scale, so the render thread doesn't wait for them
+  if (_msg.geometry().has_mesh())
+  {
+    const std::string &file = _msg.geometry().mesh().filename();
+    bool parsing{false};
+    {
+      std::lock_guard<std::mutex> lock(this->parseMutex);
+      parsing = this->parsingMeshes.count(file) > 0;
+    }
+    if (parsing)
+    {
+      if (_msg.has_pose())
+        visualVis->SetLocalPose(msgs::Convert(_msg.pose()));
+
+      auto box = this->scene->CreateVisual();
+      auto boxGeom = this->scene->CreateBox();
+      boxGeom->SetMaterial(this->SharedMaterial(nullptr, 0.5, false), false);
+      box->AddGeometry(boxGeom);
+      box->SetLocalScale(msgs::Convert(_msg.geometry().mesh().scale()));
+      visualVis->AddChild(box);
+
+      this->meshPlaceholders[file].push_back(
+          {visualVis, box, _msg, this->loadAncestors});
+      return visualVis;
+    }
+  }
+
+  this->AttachGeometry(visualVis, _msg);
+  return visualVis;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::AttachGeometry(
+    const rendering::VisualPtr &_visual, const msgs::Visual &_msg)
+{
+  auto entity = this->entities.Find(_msg.id());
 
   math::Vector3d scale = math::Vector3d::One;
   math::Pose3d localPose;
   rendering::GeometryPtr geom =
       this->LoadGeometry(_msg.geometry(), scale, localPose);
 
+  math::Pose3d pose = localPose;
   if (_msg.has_pose())
-    visualVis->SetLocalPose(msgs::Convert(_msg.pose()) * localPose);
-  else
-    visualVis->SetLocalPose(localPose);
+    pose = msgs::Convert(_msg.pose()) * localPose;
+
+  // Visuals of collapsed links are posed in the link's parent
+  if (nullptr != entity && entity->flatLink && entity->flatChild)
+  {
+    entity->flatLink->children[*entity->flatChild].second = pose;
+    pose = entity->flatLink->pose * pose;
+  }
+  _visual->SetLocalPose(pose);
 
   if (geom)
   {
-    // store the local pose
-    this->localPoses[_msg.id()] = localPose;
+    // store the local pose, flagging the few geometries that need one so
+    // that pose updates can skip the rest
+    if (nullptr != entity)
+    {
+      entity->needsLocalPose = localPose != math::Pose3d::Zero;
+      entity->localPose = localPose;
+    }
 
-    visualVis->AddGeometry(geom);
-    visualVis->SetLocalScale(scale);
+    _visual->AddGeometry(geom);
+    _visual->SetLocalScale(scale);
+
+    if (_msg.geometry().has_mesh())
+    {
+      this->assets->meshUsers[_msg.geometry().mesh().filename()].push_back(
+          _visual);
+    }
 
     // set material
     rendering::MaterialPtr material{nullptr};
     if (_msg.has_material())
     {
-      material = this->LoadMaterial(_msg.material());
+      material = this->SharedMaterial(&_msg.material(), _msg.transparency(),
+          _msg.cast_shadows());
     }
     // Don't set a default material for meshes because they
     // may have their own
     // TODO(anyone) support overriding mesh material
     else if (!_msg.geometry().has_mesh())
     {
-      // create default material
-      material = this->scene->Material("gz-grey");
-      if (!material)
-      {
-        material = this->scene->CreateMaterial("gz-grey");
-        material->SetAmbient(0.3, 0.3, 0.3);
-        material->SetDiffuse(0.7, 0.7, 0.7);
-        material->SetSpecular(1.0, 1.0, 1.0);
-        material->SetRoughness(0.2f);
-        material->SetMetalness(1.0f);
-      }
+      material = this->SharedMaterial(nullptr, _msg.transparency(),
+          _msg.cast_shadows());
     }
     else
     {
       // meshes created by mesh loader may have their own materials
       // update/override their properties based on input sdf element values
       auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(geom);
+      std::ostringstream keyPrefix;
+      keyPrefix << meshKey(_msg.geometry().mesh()) << "\n"
+                << std::setprecision(17) << _msg.transparency() << "\n"
+                << _msg.cast_shadows() << "\n";
       for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
       {
         auto submesh = mesh->SubMeshByIndex(i);
         auto submeshMat = submesh->Material();
-        if (submeshMat)
+        if (!submeshMat)
+          continue;
+
+        // The first visual of each mesh creates the shared material, the
+        // others reuse it instead of keeping their own copy
+        auto &shared = this->assets->meshMaterials[keyPrefix.str() +
+            std::to_string(i)];
+        if (nullptr == shared)
         {
+          // Cloned so it doesn't go away with the first visual's mesh
+          shared = submeshMat->Clone();
           double productAlpha = (1.0-_msg.transparency()) *
-              (1.0 - submeshMat->Transparency());
-          submeshMat->SetTransparency(1 - productAlpha);
-          submeshMat->SetCastShadows(_msg.cast_shadows());
+              (1.0 - shared->Transparency());
+          shared->SetTransparency(1 - productAlpha);
+          shared->SetCastShadows(_msg.cast_shadows());
         }
+        submesh->SetMaterial(shared, false);
       }
     }
 
     if (material)
     {
-      // set transparency
-      material->SetTransparency(_msg.transparency());
+      // Not unique, so identical visuals share one material instead of each
+      // getting a clone
+      geom->SetMaterial(material, false);
+    }
+
+    if (this->batching && !this->loadAncestors.empty())
+    {
+      // Primitives are unit meshes of the mesh manager, scaled to size.
+      // Capsules have their own mesh and are left out.
+      const auto &geomMsg = _msg.geometry();
+      BatchSource source;
+      source.visual = _visual;
+      if (geomMsg.has_mesh())
+      {
+        auto descriptor =
+            this->assets->meshDescriptors.find(meshKey(geomMsg.mesh()));
+        if (descriptor != this->assets->meshDescriptors.end())
+        {
+          source.meshName = descriptor->second.meshName;
+          source.subMesh = descriptor->second.subMeshName;
+          source.centerSubMesh = descriptor->second.centerSubMesh;
+        }
+      }
+      else if (geomMsg.has_box())
+        source.meshName = "unit_box";
+      else if (geomMsg.has_cylinder())
+        source.meshName = "unit_cylinder";
+      else if (geomMsg.has_sphere() || geomMsg.has_ellipsoid())
+        source.meshName = "unit_sphere";
+      else if (geomMsg.has_cone())
+        source.meshName = "unit_cone";
+      else if (geomMsg.has_plane())
+        source.meshName = "unit_plane";
+
+      auto batchModel = this->batchModels.find(this->loadAncestors.front());
+      if (!source.meshName.empty() && batchModel != this->batchModels.end())
+        batchModel->second.sources.push_back(std::move(source));
+    }
 
-      // cast shadows
-      material->SetCastShadows(_msg.cast_shadows());
+    if (this->lodBoxDistance > 0 || this->lodHideDistance > 0 ||
+        this->culling || nullptr != this->sceneIndex)
+    {
+      LodVisual lod;
+      lod.visual = _visual;
+      lod.entityId = _msg.id() + this->idOffset;
+      if (_msg.geometry().has_mesh())
+      {
+        auto descriptor =
+            this->assets->meshDescriptors.find(meshKey(_msg.geometry().mesh()));
+        if (descriptor != this->assets->meshDescriptors.end() &&
+            nullptr != descriptor->second.mesh)
+        {
+          lod.bounds = math::AxisAlignedBox(descriptor->second.mesh->Min(),
+              descriptor->second.mesh->Max());
+        }
+        lod.cullBounds = lod.bounds;
+      }
+      // Other geometries are unit shapes scaled to size. Capsules have
+      // their own size and are left out.
+      else if (!_msg.geometry().has_capsule())
+      {
+        lod.cullBounds = math::AxisAlignedBox(
+            math::Vector3d(-0.5, -0.5, -0.5), math::Vector3d(0.5, 0.5, 0.5));
+      }
 
-      geom->SetMaterial(material);
-      // todo(anyone) SetMaterial function clones the input material.
-      // but does not take ownership of it so we need to destroy it here.
-      // This is not ideal. We should let gz-rendering handle the lifetime
-      // of this material
-      this->scene->DestroyMaterial(material);
+      if ((this->culling || nullptr != this->sceneIndex) && lod.cullBounds)
+      {
+        lod.cullId = ++this->lastCullId;
+        for (const auto id : this->loadAncestors)
+        {
+          if (auto ancestor = this->entities.Find(id))
+            ancestor->cullIds.push_back(lod.cullId);
+        }
+        if (auto self = this->entities.Find(_msg.id()))
+          self->cullIds.push_back(lod.cullId);
+        this->cullIndex[lod.cullId] = this->lodVisuals.size();
+        this->cullDirty = true;
+      }
+      this->lodVisuals.push_back(lod);
     }
   }
   else
@@ -671,8 +4776,192 @@ rendering::VisualPtr TransportSceneManager::Implementation::LoadVisual(
     gzerr << "Failed to load geometry for visual: " << _msg.name()
            << std::endl;
   }
+}
 
-  return visualVis;
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ParseMesh(const std::string &_file)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->parseMutex);
+
+    // Each file is parsed once, the mesh manager keeps it afterwards
+    if (this->parsingMeshes.count(_file) > 0 ||
+        common::MeshManager::Instance()->HasMesh(_file))
+    {
+      return;
+    }
+    this->parsingMeshes.insert(_file);
+  }
+
+  // Mesh files are parsed into the mesh manager, so the render thread only
+  // has to create the GPU resources
+  this->workers.AddWork([this, _file]()
+      {
+        const bool parsed =
+            nullptr != common::MeshManager::Instance()->Load(_file);
+        {
+          std::lock_guard<std::mutex> lock(this->parseMutex);
+          this->parsingMeshes.erase(_file);
+          this->parsedMeshes.emplace_back(_file, parsed);
+        }
+        RenderHooks::RequestRender();
+      });
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::AttachParsedMeshes()
+{
+  std::vector<std::pair<std::string, bool>> parsed;
+  {
+    std::lock_guard<std::mutex> lock(this->parseMutex);
+    parsed.swap(this->parsedMeshes);
+  }
+
+  for (const auto &[file, success] : parsed)
+  {
+    auto it = this->meshPlaceholders.find(file);
+    if (it == this->meshPlaceholders.end())
+      continue;
+    auto placeholders = std::move(it->second);
+    this->meshPlaceholders.erase(it);
+
+    for (auto &placeholder : placeholders)
+    {
+      auto visual = placeholder.visual.lock();
+      if (nullptr == visual)
+        continue;
+      if (auto box = placeholder.box.lock())
+        this->scene->DestroyVisual(box, true);
+      if (!success)
+      {
+        gzerr << "Failed to load mesh [" << file << "] for visual: "
+              << placeholder.msg.name() << std::endl;
+        continue;
+      }
+
+      // Keep any pose received since the visual was created
+      const math::Pose3d pose = visual->LocalPose();
+      this->loadAncestors = std::move(placeholder.ancestors);
+      this->AttachGeometry(visual, placeholder.msg);
+      this->loadAncestors.clear();
+      visual->SetLocalPose(pose);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::DecodeTexture(
+    const std::string &_file)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->parseMutex);
+    if (!this->knownTextures.insert(_file).second)
+      return;
+  }
+
+  // Decoding a large image takes longer than a frame, so only the upload
+  // is left to the render thread
+  this->workers.AddWork([this, _file]()
+      {
+        auto image = std::make_shared<common::Image>();
+        if (image->Load(_file) != 0 || !image->Valid())
+        {
+          image.reset();
+        }
+        else if (this->maxTextureSize > 0 &&
+            (image->Width() > this->maxTextureSize ||
+             image->Height() > this->maxTextureSize))
+        {
+          TexturePixels pixels;
+          pixels.width = image->Width();
+          pixels.height = image->Height();
+          pixels.channels = 4;
+          pixels.data = image->RGBAData();
+          pixels = TextureLevels::Fit(std::move(pixels),
+              this->maxTextureSize);
+          image->SetFromData(pixels.data.data(), pixels.width,
+              pixels.height, common::Image::RGBA_INT8);
+        }
+        {
+          std::lock_guard<std::mutex> lock(this->parseMutex);
+          this->decodedTextures.emplace_back(_file, image);
+        }
+        RenderHooks::RequestRender();
+      });
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::AttachDecodedTextures()
+{
+  std::vector<std::pair<std::string, std::shared_ptr<common::Image>>>
+      decoded;
+  {
+    std::lock_guard<std::mutex> lock(this->parseMutex);
+    decoded.swap(this->decodedTextures);
+  }
+
+  // Up to the frame's upload budget, at least one per frame. The others
+  // are put back for the next frames.
+  std::size_t count{0};
+  for (; count < decoded.size(); ++count)
+  {
+    if (count > 0 && GpuUploads::BudgetLeft() == 0)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->parseMutex);
+        this->decodedTextures.insert(this->decodedTextures.begin(),
+            std::make_move_iterator(decoded.begin() + count),
+            std::make_move_iterator(decoded.end()));
+      }
+      RenderHooks::RequestRender();
+      break;
+    }
+
+    const auto &[file, image] = decoded[count];
+    this->textures[file] = image;
+    if (nullptr == image)
+    {
+      gzerr << "Failed to load texture [" << file << "]" << std::endl;
+    }
+    else
+    {
+      const std::size_t bytes = TextureLevels::Bytes(image->Width(),
+          image->Height(), 4, true);
+      this->textureMemory.Add(bytes);
+      this->uploads.Uploaded(bytes);
+    }
+
+    auto it = this->textureUsers.find(file);
+    if (it == this->textureUsers.end())
+      continue;
+    auto users = std::move(it->second);
+    this->textureUsers.erase(it);
+    if (nullptr == image)
+      continue;
+
+    for (const auto &user : users)
+    {
+      if (auto material = user.material.lock())
+        setTexture(material, user.slot, file, image);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::UseTexture(
+    const rendering::MaterialPtr &_material, TextureSlot _slot,
+    const std::string &_file)
+{
+  auto it = this->textures.find(_file);
+  if (it != this->textures.end())
+  {
+    if (nullptr != it->second)
+      setTexture(_material, _slot, _file, it->second);
+    return;
+  }
+
+  this->textureUsers[_file].push_back({_material, _slot});
+  this->DecodeTexture(_file);
 }
 
 /////////////////////////////////////////////////
@@ -754,14 +5043,35 @@ rendering::GeometryPtr TransportSceneManager::Implementation::LoadGeometry(
       gzerr << "Mesh geometry missing filename" << std::endl;
       return geom;
     }
-    rendering::MeshDescriptor descriptor;
+    auto &descriptor = this->assets->meshDescriptors[meshKey(_msg.mesh())];
+    if (nullptr == descriptor.mesh)
+    {
+      // Assume absolute path to mesh file
+      descriptor.meshName = _msg.mesh().filename();
+      descriptor.subMeshName = _msg.mesh().submesh();
+      descriptor.centerSubMesh = _msg.mesh().center_submesh();
 
-    // Assume absolute path to mesh file
-    descriptor.meshName = _msg.mesh().filename();
+      gz::common::MeshManager* meshManager =
+          gz::common::MeshManager::Instance();
+      descriptor.mesh = meshManager->Load(descriptor.meshName);
 
-    gz::common::MeshManager* meshManager =
-        gz::common::MeshManager::Instance();
-    descriptor.mesh = meshManager->Load(descriptor.meshName);
+      if (nullptr != descriptor.mesh &&
+          !this->assets->meshCache.Contains(descriptor.meshName))
+      {
+        std::size_t bytes{0};
+        for (unsigned int i = 0; i < descriptor.mesh->SubMeshCount(); ++i)
+        {
+          auto subMesh = descriptor.mesh->SubMeshByIndex(i).lock();
+          if (nullptr == subMesh)
+            continue;
+          bytes += subMesh->VertexCount() * (8u * sizeof(float)) +
+              subMesh->IndexCount() * sizeof(uint32_t);
+        }
+        this->assets->meshCache.Insert(descriptor.meshName, bytes);
+        this->assets->meshMemory.Set(this->assets->meshCache.Bytes());
+      }
+    }
+    this->assets->meshCache.Touch(descriptor.meshName);
     geom = this->scene->CreateMesh(descriptor);
 
     scale = msgs::Convert(_msg.mesh().scale());
@@ -796,7 +5106,76 @@ rendering::MaterialPtr TransportSceneManager::Implementation::LoadMaterial(
   {
     material->SetEmissive(msgs::Convert(_msg.emissive()));
   }
+  if (_msg.has_pbr())
+  {
+    material->SetRoughness(static_cast<float>(_msg.pbr().roughness()));
+    material->SetMetalness(static_cast<float>(_msg.pbr().metalness()));
+  }
+
+  // Textures are decoded by the workers, the material shows its colors
+  // until they're ready
+  for (const auto &[file, slot] : textureMaps(_msg))
+    this->UseTexture(material, slot, file);
+
+  return material;
+}
+
+/////////////////////////////////////////////////
+rendering::MaterialPtr TransportSceneManager::Implementation::SharedMaterial(
+    const msgs::Material *_msg, double _transparency, bool _castShadows)
+{
+  // Only the parameters used by LoadMaterial are part of the key, so that
+  // materials which differ in unused fields are still shared
+  msgs::Material keyMsg;
+  if (nullptr != _msg)
+  {
+    if (_msg->has_ambient())
+      *keyMsg.mutable_ambient() = _msg->ambient();
+    if (_msg->has_diffuse())
+      *keyMsg.mutable_diffuse() = _msg->diffuse();
+    if (_msg->has_specular())
+      *keyMsg.mutable_specular() = _msg->specular();
+    if (_msg->has_emissive())
+      *keyMsg.mutable_emissive() = _msg->emissive();
+    if (_msg->has_pbr())
+    {
+      auto *pbr = keyMsg.mutable_pbr();
+      pbr->set_roughness(_msg->pbr().roughness());
+      pbr->set_metalness(_msg->pbr().metalness());
+      pbr->set_albedo_map(_msg->pbr().albedo_map());
+      pbr->set_normal_map(_msg->pbr().normal_map());
+      pbr->set_roughness_map(_msg->pbr().roughness_map());
+      pbr->set_metalness_map(_msg->pbr().metalness_map());
+      pbr->set_emissive_map(_msg->pbr().emissive_map());
+    }
+  }
 
+  std::ostringstream key;
+  key << (nullptr == _msg ? "default" : "msg") << "\n"
+      << std::setprecision(17) << _transparency << "\n"
+      << _castShadows << "\n" << keyMsg.SerializeAsString();
+
+  auto &material = this->assets->materials[key.str()];
+  if (nullptr != material)
+    return material;
+
+  if (nullptr != _msg)
+  {
+    material = this->LoadMaterial(*_msg);
+  }
+  else
+  {
+    // default material
+    material = this->scene->CreateMaterial();
+    material->SetAmbient(0.3, 0.3, 0.3);
+    material->SetDiffuse(0.7, 0.7, 0.7);
+    material->SetSpecular(1.0, 1.0, 1.0);
+    material->SetRoughness(0.2f);
+    material->SetMetalness(1.0f);
+  }
+
+  material->SetTransparency(_transparency);
+  material->SetCastShadows(_castShadows);
   return material;
 }
 
@@ -852,32 +5231,296 @@ rendering::LightPtr TransportSceneManager::Implementation::LoadLight(
 
   light->SetCastShadows(_msg.cast_shadows());
 
-  this->lights[_msg.id()] = light;
+  if (this->budgetingLights)
+  {
+    BudgetedLight budgeted;
+    budgeted.light = light;
+    budgeted.range = _msg.range();
+    if (_msg.has_diffuse())
+    {
+      const auto &diffuse = _msg.diffuse();
+      budgeted.brightness = std::max({diffuse.r(), diffuse.g(),
+          diffuse.b()});
+    }
+    budgeted.directional =
+        _msg.type() == msgs::Light_LightType_DIRECTIONAL;
+    budgeted.castShadows = _msg.cast_shadows();
+    this->budgetedLights[_msg.id()] = budgeted;
+    this->lightsDirty = true;
+  }
+
+  this->entities.Insert(_msg.id()).light = light;
   return light;
 }
 
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::RecordHistory(
+    const std::vector<LoadTask> &_loadTasks,
+    const std::vector<unsigned int> &_deletions)
+{
+  const double stamp = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - this->historyEpoch).count();
+
+  // Kept as a scene msg so a model and a light can be told apart
+  for (const auto &task : _loadTasks)
+  {
+    msgs::Scene msg;
+    if (auto model = task.Model())
+      msg.add_model()->CopyFrom(*model);
+    else if (auto light = task.Light())
+      msg.add_light()->CopyFrom(*light);
+    this->sceneHistory->RecordAdded(stamp, task.Id(),
+        msg.SerializeAsString());
+  }
+
+  for (const auto id : _deletions)
+    this->sceneHistory->RecordRemoved(stamp, id);
+
+  // Also when empty, so time passes in the history
+  this->historyPoses.clear();
+  for (const auto &update : this->renderPoses)
+    this->historyPoses.push_back({update.id, update.pose});
+  this->sceneHistory->RecordPoses(stamp, this->historyPoses);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ShowHistory(double _time)
+{
+  std::unordered_map<unsigned int, SceneHistory::Added> alive;
+  for (auto &added : this->sceneHistory->AliveAt(_time))
+    alive.emplace(added.id, std::move(added));
+
+  for (auto it = this->historyGhosts.begin();
+      it != this->historyGhosts.end();)
+  {
+    if (alive.count(*it) > 0)
+    {
+      ++it;
+      continue;
+    }
+    const unsigned int id = *it;
+    it = this->historyGhosts.erase(it);
+    this->DeleteEntity(id, true);
+  }
+
+  // Taken out of the scene graph rather than hidden, so culling and levels
+  // of detail don't show them again
+  auto rootVis = this->root;
+  for (const auto id : this->topLevelIds)
+  {
+    const bool shown = alive.count(id) > 0 ||
+        !this->sceneHistory->Tracked(id);
+    auto hidden = this->historyHidden.find(id);
+    if (shown == (hidden == this->historyHidden.end()))
+      continue;
+
+    if (shown)
+    {
+      rootVis->AddChild(hidden->second);
+      this->historyHidden.erase(hidden);
+      continue;
+    }
+
+    auto entity = this->entities.Find(id);
+    if (nullptr == entity)
+      continue;
+    rendering::NodePtr node = entity->visual.lock();
+    if (nullptr == node)
+      node = entity->light.lock();
+    if (nullptr == node)
+      continue;
+    if (auto parent = node->Parent())
+      parent->RemoveChild(node);
+    this->historyHidden[id] = node;
+  }
+
+  for (const auto &[id, added] : alive)
+  {
+    if (this->topLevelIds.count(id) > 0)
+      continue;
+
+    auto msg = NewArenaMessage<msgs::Scene>();
+    LoadTask task;
+    if (!msg->ParseFromString(added.data))
+      continue;
+    if (msg->model_size() > 0)
+      task.msg = RetainPart(msg, msg->model(0));
+    else if (msg->light_size() > 0)
+      task.msg = RetainPart(msg, msg->light(0));
+    else
+      continue;
+    this->Load(task);
+    this->historyGhosts.insert(id);
+  }
+
+  std::vector<SceneHistory::Pose> poses;
+  this->sceneHistory->PosesAt(_time, poses);
+  for (const auto &pose : poses)
+  {
+    auto entity = this->entities.Find(pose.id);
+    if (nullptr == entity || !applyPose(*entity, pose.pose))
+      continue;
+    this->cullMoved.insert(this->cullMoved.end(),
+        entity->cullIds.begin(), entity->cullIds.end());
+    if (entity->batchModel)
+      this->OnModelMoved(*entity->batchModel);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::Implementation::ShowLive()
+{
+  // Poses received before the history was shown, superseded by those
+  // received since
+  this->ApplyDeferredPoses(true);
+
+  for (const auto id : this->historyGhosts)
+    this->DeleteEntity(id, true);
+  this->historyGhosts.clear();
+
+  auto rootVis = this->root;
+  for (const auto &[id, node] : this->historyHidden)
+    rootVis->AddChild(node);
+  this->historyHidden.clear();
+
+  // Poses received while the history was shown
+  std::vector<SceneHistory::Pose> poses;
+  this->sceneHistory->PosesAt(std::numeric_limits<double>::max(), poses);
+  for (const auto &pose : poses)
+  {
+    auto entity = this->entities.Find(pose.id);
+    if (nullptr == entity || !applyPose(*entity, pose.pose))
+      continue;
+    this->cullMoved.insert(this->cullMoved.end(),
+        entity->cullIds.begin(), entity->cullIds.end());
+    if (entity->batchModel)
+      this->OnModelMoved(*entity->batchModel);
+  }
+  this->lightsDirty = true;
+}
+
 /////////////////////////////////////////////////
 void TransportSceneManager::Implementation::DeleteEntity(
-  const unsigned int _entity)
+  const unsigned int _entity, bool _deferred)
 {
-  if (this->visuals.find(_entity) != this->visuals.end())
+  auto entity = this->entities.Find(_entity);
+  if (nullptr == entity)
+    return;
+
+  this->deferredPoses.Take(_entity);
+
+  if (this->labels)
+  {
+    if (auto labels = SceneServices::Get<SceneLabels>(SceneServices::kLabels))
+      labels->Remove(this, _entity);
+  }
+
+  this->topLevelIds.erase(_entity);
+  this->historyHidden.erase(_entity);
+
+  // A detached light mustn't be attached back while waiting to be
+  // destroyed
+  if (this->budgetedLights.erase(_entity) > 0)
+    this->lightsDirty = true;
+
+  // Right away, the visuals may only be destroyed in a later frame
+  if (nullptr != this->sceneIndex)
+  {
+    for (const auto id : entity->cullIds)
+    {
+      auto it = this->cullIndex.find(id);
+      if (it != this->cullIndex.end())
+        this->sceneIndex->Remove(this->lodVisuals[it->second].entityId);
+    }
+  }
+
+  // Put the model's visuals back in the scene graph first, so they're
+  // destroyed along with it instead of staying in the batch
+  if (entity->batchModel)
+  {
+    auto batchModel = this->batchModels.find(*entity->batchModel);
+    if (batchModel != this->batchModels.end())
+    {
+      if (batchModel->second.cell)
+        this->DissolveBatch(*batchModel->second.cell);
+      if (batchModel->first == _entity)
+        this->batchModels.erase(batchModel);
+    }
+  }
+
+  if (auto visual = entity->visual.lock())
   {
-    auto visual = this->visuals[_entity].lock();
-    if (visual)
+    if (!_deferred)
     {
       this->scene->DestroyVisual(visual, true);
     }
-    this->visuals.erase(_entity);
+    else
+    {
+      if (auto parent = visual->Parent())
+        parent->RemoveChild(visual);
+      this->destroyQueue.push_back(visual);
+    }
   }
-  else if (this->lights.find(_entity) != this->lights.end())
+  else if (auto light = entity->light.lock())
   {
-    auto light = this->lights[_entity].lock();
-    if (light)
+    if (!_deferred)
+    {
+      this->scene->DestroyLight(light, true);
+    }
+    else
+    {
+      if (auto parent = light->Parent())
+        parent->RemoveChild(light);
+      this->destroyQueue.push_back(light);
+    }
+  }
+  // Collapsed links take their visuals and lights with them
+  else if (entity->flatLink && !entity->flatChild)
+  {
+    for (const auto &child : entity->flatLink->children)
     {
+      auto node = child.first.lock();
+      if (nullptr == node)
+        continue;
+      if (auto parent = node->Parent())
+        parent->RemoveChild(node);
+      if (_deferred)
+        this->destroyQueue.push_back(node);
+      else if (auto visual = std::dynamic_pointer_cast<rendering::Visual>(node))
+        this->scene->DestroyVisual(visual, true);
+      else if (auto light = std::dynamic_pointer_cast<rendering::Light>(node))
+        this->scene->DestroyLight(light, true);
+    }
+  }
+  this->entities.Erase(_entity);
+}
+
+/////////////////////////////////////////////////
+std::size_t TransportSceneManager::Implementation::DestroyQueued(bool _all)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t destroyed{0};
+  while (!this->destroyQueue.empty())
+  {
+    auto node = std::move(this->destroyQueue.front());
+    this->destroyQueue.pop_front();
+    if (auto visual = std::dynamic_pointer_cast<rendering::Visual>(node))
+      this->scene->DestroyVisual(visual, true);
+    else if (auto light = std::dynamic_pointer_cast<rendering::Light>(node))
       this->scene->DestroyLight(light, true);
+    ++destroyed;
+
+    if (!_all &&
+        this->loadBudget > std::chrono::steady_clock::duration::zero() &&
+        std::chrono::steady_clock::now() - start >= this->loadBudget)
+    {
+      // Continue next frame
+      if (!this->destroyQueue.empty())
+        RenderHooks::RequestRender();
+      break;
     }
-    this->lights.erase(_entity);
   }
+  return destroyed;
 }
 }  // namespace gz::gui::plugins
 
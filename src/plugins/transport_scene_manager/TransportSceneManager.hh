@@ -31,18 +31,254 @@ namespace gz::gui::plugins
   ///
   /// ## Configuration
   ///
+  /// * \<world\> : Name of the world shown, which sets the defaults of
+  ///               \<service\> to "/world/<name>/scene/info",
+  ///               \<pose_topic\> to "/world/<name>/pose/info",
+  ///               \<deletion_topic\> to "/world/<name>/scene/deletion" and
+  ///               \<scene_topic\> to "/world/<name>/scene/info". Several
+  ///               managers with different worlds, each in its own
+  ///               \<region\>, show several worlds in one scene, rendered
+  ///               by the same render thread. Optional.
   /// * \<service\> : Name of service where this system will request a scene
   ///                 message. Optional, defaults to "/scene".
+  ///                 The scene is requested as soon as the service is
+  ///                 advertised, and again whenever the server restarts.
   /// * \<pose_topic\> : Name of topic to subscribe to receive pose updates.
   ///                    Optional, defaults to "/pose".
+  /// * \<packed_pose_topic\> : Name of an additional topic to receive poses
+  ///                           packed as gz::msgs::Bytes, with an id array
+  ///                           and float arrays, from servers with many
+  ///                           entities. Rotations may be compressed to 32
+  ///                           bits. See PackedPoses.hh for the layout.
+  ///                           Optional, not subscribed by default.
   /// * \<deletion_topic\> : Name of topic to request entity deletions.
   ///                        Optional, defaults to "/delete".
   /// * \<scene_topic\> : Name of topic to receive scene updates. Optional,
   ///                     defaults to "/scene".
+  ///                     Models and lights which were already received
+  ///                     with the same content are skipped, and modified
+  ///                     ones are replaced.
+  /// * \<incremental_scene_topic\> : Name of an additional topic on which the
+  ///                     server publishes only added and modified models
+  ///                     and lights. Optional, not subscribed by default.
+  /// * \<shared_memory\> : Whether to receive the scene topics through
+  ///                     shared memory when they're published by a
+  ///                     SharedMemoryPublisher on the same host, falling
+  ///                     back to transport otherwise. The scene service
+  ///                     and the pose topics always use transport.
+  ///                     Optional, defaults to true.
+  /// * \<feedback\> : Whether to publish how fast the pose topics are
+  ///                consumed on their FeedbackTopic(). Pose msgs merged
+  ///                with others before a frame took them count as
+  ///                dropped, so the consumed rate is about the frame rate.
+  ///                Optional, defaults to false. See
+  ///                SubscriptionHub::SetFeedback.
+  /// * \<flatten\> : Whether to collapse links into their model. Links
+  ///               get no node of their own, their visuals and lights are
+  ///               children of the model with the link's pose folded into
+  ///               theirs, which halves the depth of the scene graph and
+  ///               the transforms updated per frame. Nested models keep
+  ///               their node. Optional, defaults to false.
+  /// * \<render_state\> : Share the scene between GUIs showing the same
+  ///                      world, so only one of them decodes the server's
+  ///                      messages. The publishing GUI forwards the models
+  ///                      and lights which changed, deletions, and
+  ///                      packed poses with float rotations, and
+  ///                      serves its whole scene to GUIs which join later.
+  ///                      Optional, not shared by default.
+  ///   * \<mode\> : "publish" or "subscribe". A subscribing GUI ignores
+  ///                the service and topics above, and gets everything
+  ///                from the publishing one. Defaults to "publish".
+  ///   * \<topic\> : Prefix of the "pose", "scene" and "delete" topics, and
+  ///                 of the "scene" service. Defaults to "/render_state".
+  /// * \<interpolation\> : If present, entities are moved smoothly between
+  ///                       the poses received, using the stamps in the pose
+  ///                       msg headers. Optional, disabled by default.
+  ///   * \<delay\> : How far behind the newest pose entities are rendered,
+  ///                 in seconds. Should be about one pose period. Defaults
+  ///                 to 0.05.
+  ///   * \<max_extrapolation\> : Maximum time to predict past the newest
+  ///                             pose when poses are late, in seconds.
+  ///                             Defaults to 0.1.
+  /// * \<lod\> : Level of detail based on the distance from the user camera.
+  ///             Optional, disabled by default.
+  ///   * \<box_distance\> : Meshes farther than this, in meters, are shown
+  ///                        as their bounding box. Zero disables.
+  ///   * \<hide_distance\> : Visuals farther than this, in meters, are
+  ///                         hidden. Zero disables.
+  ///   * \<batch_size\> : Number of visuals evaluated each frame. All
+  ///                      visuals are evaluated over several frames.
+  ///                      Defaults to 1000.
+  /// * \<culling\> : If present, visuals with geometry outside the user
+  ///                 camera's view frustum are hidden before the scene is
+  ///                 rendered. Their world boxes are kept in a bounding
+  ///                 volume hierarchy, so whole groups of visuals are
+  ///                 accepted or rejected at once, and only the boxes of
+  ///                 visuals which moved are updated each frame.
+  ///   * \<stats_topic\> : Topic to publish the number of visuals inside
+  ///                       ("visible") and outside ("culled") the frustum,
+  ///                       and of boxes tested ("tested"), as
+  ///                       gz::msgs::Param, at most 4 times per second.
+  ///                       Optional, not published by default.
+  ///   * \<lazy_poses\> : True to keep only the latest pose of entities
+  ///                      whose visuals are all outside the frustum, and
+  ///                      apply it once they may come into view, such as
+  ///                      when the camera turns. Selected entities and
+  ///                      those the camera follows or tracks are always
+  ///                      posed. The number of entities waiting is
+  ///                      published as "deferred". Defaults to false.
+  /// * \<scene_index\> : If present, the world boxes of visuals with
+  ///                     geometry are kept in a SceneIndex, shared through
+  ///                     SceneServices as SceneServices::kSceneIndex, so
+  ///                     tools can find the entities near a point or under
+  ///                     the cursor from any thread without scanning the
+  ///                     scene. Entities are indexed by visual id, and
+  ///                     only the boxes of visuals which moved are updated
+  ///                     each frame. Optional, disabled by default.
+  ///   * \<margin\> : How far boxes are enlarged in the index, in meters,
+  ///                  so small moves don't change it. Defaults to 0.1.
+  /// * \<region\> : If present, top level models and lights are added
+  ///                under a visual of their own instead of the scene's root,
+  ///                so a world can be shown next to others in the same
+  ///                scene. Meshes and materials are shared with the managers
+  ///                of the other worlds, and loaded and counted once. A
+  ///                \<scene_index\> already registered by another manager
+  ///                is shared too. Only one manager of a scene should keep
+  ///                \<history\>. Optional, no region by default.
+  ///   * \<offset\> : Pose of the region in the scene, as
+  ///                  "x y z roll pitch yaw". Defaults to the origin.
+  ///   * \<id_offset\> : Added to entity ids in the scene index and the
+  ///                     selection, so the ids of different worlds don't
+  ///                     collide. Defaults to 0.
+  /// * \<light_budget\> : If present, only the lights contributing the most
+  ///                      to the user camera's view are rendered, ranked
+  ///                      by brightness and by how large the sphere they
+  ///                      reach looks from the camera. Lights out of the
+  ///                      view frustum are dropped first, directional
+  ///                      lights are kept first. The choice is updated as
+  ///                      the camera moves, favoring the lights already
+  ///                      chosen so only a few are swapped at a time.
+  ///                      Optional, disabled by default.
+  ///   * \<max_lights\> : Number of lights rendered at once. Defaults to 8.
+  ///   * \<max_shadows\> : Number of the rendered lights which may cast
+  ///                       shadows. Defaults to 1.
+  ///   * \<hysteresis\> : How much the lights already chosen are favored,
+  ///                      as a fraction of their rank. Defaults to 0.25.
+  /// * \<history\> : If present, the last minutes of the scene are recorded
+  ///                 in a SceneHistory, shared through SceneServices as
+  ///                 SceneServices::kSceneHistory, so WorldControl can
+  ///                 scrub the 3D view back in time without a log from the
+  ///                 server. Poses are sampled, quantized and stored as
+  ///                 differences, along with the models and lights added
+  ///                 and deleted. While scrubbing, models and lights added
+  ///                 since are taken out of the scene, deleted ones are
+  ///                 created again, and live poses are only recorded.
+  ///                 Times are those the GUI received things at. Optional,
+  ///                 disabled by default.
+  ///   * \<duration\> : Seconds kept. Defaults to 600.
+  ///   * \<max_memory\> : MiB kept at most, older history is dropped first.
+  ///                      Defaults to 256.
+  ///   * \<rate\> : Pose samples per second. Defaults to 10.
+  ///   * \<precision\> : Position precision, in meters. Defaults to 0.001.
+  /// * \<static_batching\> : If present, the geometries of models which
+  ///                         don't move are merged into one mesh per grid
+  ///                         cell, with a submesh per material, to cut
+  ///                         draw calls. Static models are merged right
+  ///                         away, others once they haven't received a pose
+  ///                         for a while. A pose update takes the model's
+  ///                         cell apart until its models settle again.
+  ///                         Merged geometry is always drawn at full detail
+  ///                         and picking returns the merged visual, so
+  ///                         batched models can't be selected. Capsules
+  ///                         are never merged. Optional, disabled by
+  ///                         default.
+  ///   * \<settle_time\> : Seconds a model must stay still before being
+  ///                       merged. Defaults to 5.
+  ///   * \<cell_size\> : Size of the grid cells, in meters. Defaults to 20.
+  /// * \<pose_filter\> : Drop the poses of the models which aren't of
+  ///                     interest as soon as they're received, so they
+  ///                     cost nothing on the render thread. Filtered
+  ///                     models are still loaded, and stay where they last
+  ///                     were. Optional, all poses are applied by default.
+  ///   * \<model\> : Regular expression matching the whole name of top
+  ///                 level models whose poses are applied. May be repeated.
+  ///                 Poses of the models matching none are dropped.
+  ///   * \<radius\> : Poses of top level models farther than this from the
+  ///                  user camera, in meters, are dropped, along with those
+  ///                  of their links and visuals. Zero disables.
+  /// * \<labels\> : If present, the names of top level models are shown
+  ///                above them, through MinimalScene's batched labels, so
+  ///                thousands of names don't cost a visual each. See
+  ///                MinimalScene's \<labels\> for how crowded names are
+  ///                thinned out. Optional, names aren't shown by default.
+  ///   * \<height\> : Height of the names above the model origins, in
+  ///                  meters. Defaults to 1.
+  /// * \<scene_cache\> : If present, the scene received from the service is
+  ///                     saved to disk, one file per service, and loaded
+  ///                     on the next start so the scene shows before the
+  ///                     server answers. Once it answers, only the models
+  ///                     and lights whose content changed are created
+  ///                     again, and those which are gone are deleted.
+  ///                     Optional, disabled by default.
+  ///   * \<directory\> : Directory for the cache files. Defaults to
+  ///                     "~/.gz/gui/scene_cache".
+  /// * \<terrain\> : Heightmaps are read on worker threads and split into
+  ///                 square tiles, which are built around the user camera,
+  ///                 coarser with distance, and destroyed once left
+  ///                 behind, so large terrains are never meshed whole.
+  ///                 Only their material is used, not their textures and
+  ///                 blends. Optional, these are the defaults:
+  ///   * \<tile_size\> : Samples along each side of a tile, rounded up to a
+  ///                     power of two. Defaults to 64.
+  ///   * \<load_radius\> : Tiles farther than this from the camera, in
+  ///                       meters, aren't created. Defaults to 1000.
+  ///   * \<lod_distance\> : Distance, in meters, at which tiles drop to
+  ///                        half the samples. Each further halving starts
+  ///                        at twice the distance. Defaults to 100.
+  /// * \<load_budget\> : Milliseconds the render thread may spend creating
+  ///                     models and lights each frame. Large scenes are
+  ///                     created over several frames while their meshes are
+  ///                     parsed in the background, each file once. Visuals
+  ///                     whose mesh isn't parsed yet are shown as a
+  ///                     translucent box of the mesh scale until it's
+  ///                     ready. Deleted models and lights vanish at once
+  ///                     but are destroyed within the same budget, so
+  ///                     clearing a large scene doesn't stall a frame.
+  ///                     Zero creates and destroys everything on the first
+  ///                     frame. Optional, defaults to 10.
+  /// * \<gpu_memory_budget\> : Most memory, in MiB, the meshes loaded for
+  ///                           the scene may take. Once exceeded, the least
+  ///                           recently used meshes which no visual uses
+  ///                           anymore are unloaded, along with their
+  ///                           materials, and loaded again if they're
+  ///                           spawned again. The usage is reported to
+  ///                           MemoryAccounting, against this budget, and
+  ///                           shown by the MemoryStats plugin. Optional,
+  ///                           zero keeps all meshes loaded, which is the
+  ///                           default.
+  /// * \<max_texture_size\> : Largest width and height, in pixels, of the
+  ///                          texture maps of the materials. Textures are
+  ///                          decoded in the background, and larger ones
+  ///                          are halved until they fit before they're
+  ///                          uploaded, so they take less GPU memory.
+  ///                          Materials show their colors until their
+  ///                          textures are ready. Optional, zero keeps
+  ///                          textures at full size, which is the default.
+  ///                          Decoded textures are uploaded within
+  ///                          MinimalScene's \<gpu_upload_budget\>, the
+  ///                          others wait for the next frames.
   class TransportSceneManager : public Plugin
   {
     Q_OBJECT
 
+    /// \brief Fraction of the received models and lights which have been
+    /// created, 1 when there's nothing left to load
+    Q_PROPERTY(
+      double loadProgress
+      READ LoadProgress
+      NOTIFY LoadProgressChanged
+    )
+
     /// \brief Constructor
     public: TransportSceneManager();
 
@@ -52,8 +288,16 @@ namespace gz::gui::plugins
   // Documentation inherited
   public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
+    /// \brief Get the load progress.
+    /// \return Fraction of the queued entities which have been created.
+    public: Q_INVOKABLE double LoadProgress() const;
+
+    /// \brief Set the load progress.
+    /// \param[in] _progress Fraction of the queued entities created.
+    public: Q_INVOKABLE void SetLoadProgress(double _progress);
+
+    /// \brief Notify that the load progress has changed
+    signals: void LoadProgressChanged();
 
     /// \internal
     /// \brief Pointer to private data.
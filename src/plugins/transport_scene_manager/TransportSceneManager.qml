@@ -42,6 +42,21 @@ GridLayout {
           "<br><b>Scene topic</b>: /" + sceneTopic
   }
 
+  Label {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    visible: TransportSceneManager.loadProgress < 1
+    text: "Loading scene: " +
+          Math.round(TransportSceneManager.loadProgress * 100) + "%"
+  }
+
+  ProgressBar {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    visible: TransportSceneManager.loadProgress < 1
+    value: TransportSceneManager.loadProgress
+  }
+
 
   Item {
     Layout.columnSpan: 1
@@ -17,8 +17,11 @@
 
 #include "WorldControl.hh"
 
+#include <algorithm>
 #include <string>
 
+#include <QTimer>
+
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/world_control.pb.h>
 #include <gz/msgs/world_stats.pb.h>
@@ -29,9 +32,14 @@
 #include <gz/transport/Node.hh>
 
 #include "gz/gui/Application.hh"
+#include "gz/gui/AsyncRequests.hh"
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/GuiEvents.hh"
+#include "gz/gui/LatestValue.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SceneHistory.hh"
+#include "gz/gui/SceneServices.hh"
 
 namespace gz::gui::plugins
 {
@@ -41,15 +49,15 @@ class WorldControl::Implementation
   /// \param[in] _msg Message to send.
   public: void SendEventMsg(const gz::msgs::WorldControl &_msg);
 
-  /// \brief Message holding latest world statistics
+  /// \brief Latest world statistics processed, only used on the GUI thread
   public: gz::msgs::WorldStatistics msg;
 
+  /// \brief Latest world statistics received
+  public: LatestValue<gz::msgs::WorldStatistics> latestMsg;
+
   /// \brief Service to send world control requests
   public: std::string controlService;
 
-  /// \brief Mutex to protect msg
-  public: std::recursive_mutex mutex;
-
   /// \brief Communication node
   public: gz::transport::Node node;
 
@@ -67,12 +75,31 @@ class WorldControl::Implementation
   /// or service (false). The service option was used by default for
   /// gz-gui7 and earlier, and now uses the event by default in gz-gui8.
   public: bool useEvent{true};
+
+  /// \brief Polls the scene history, which may be shared after this plugin
+  /// is loaded
+  public: QTimer historyTimer;
+
+  /// \brief See HistoryAvailable
+  public: bool historyAvailable{false};
+
+  /// \brief See HistoryLength
+  public: double historyLength{0.0};
+
+  /// \brief See HistoryOffset
+  public: double historyOffset{0.0};
+
+  /// \brief See Scrubbing
+  public: bool scrubbing{false};
 };
 
 /////////////////////////////////////////////////
 WorldControl::WorldControl()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
+  this->connect(&this->dataPtr->historyTimer, &QTimer::timeout,
+      this, &WorldControl::UpdateHistory);
+  this->dataPtr->historyTimer.start(250);
 }
 
 /////////////////////////////////////////////////
@@ -243,7 +270,8 @@ void WorldControl::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void WorldControl::ProcessMsg()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->latestMsg.Take(this->dataPtr->msg))
+    return;
 
   // ignore the message if it's associated with a step
   const auto &header = this->dataPtr->msg.header();
@@ -274,10 +302,9 @@ void WorldControl::ProcessMsg()
 /////////////////////////////////////////////////
 void WorldControl::OnWorldStatsMsg(const msgs::WorldStatistics &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->msg.CopyFrom(_msg);
-  QMetaObject::invokeMethod(this, "ProcessMsg");
+  // Only wake the GUI thread once it's taken the previous message
+  if (this->dataPtr->latestMsg.Set(_msg))
+    QMetaObject::invokeMethod(this, "ProcessMsg", Qt::QueuedConnection);
 }
 
 /////////////////////////////////////////////////
@@ -327,6 +354,97 @@ void WorldControl::OnStep()
   this->dataPtr->SendEventMsg(msg);
 }
 
+/////////////////////////////////////////////////
+bool WorldControl::HistoryAvailable() const
+{
+  return this->dataPtr->historyAvailable;
+}
+
+/////////////////////////////////////////////////
+double WorldControl::HistoryLength() const
+{
+  return this->dataPtr->historyLength;
+}
+
+/////////////////////////////////////////////////
+double WorldControl::HistoryOffset() const
+{
+  return this->dataPtr->historyOffset;
+}
+
+/////////////////////////////////////////////////
+bool WorldControl::Scrubbing() const
+{
+  return this->dataPtr->scrubbing;
+}
+
+/////////////////////////////////////////////////
+void WorldControl::OnScrub(double _offset)
+{
+  auto history = SceneServices::Get<SceneHistory>(
+      SceneServices::kSceneHistory);
+  double start, end;
+  if (nullptr == history || !history->Range(start, end))
+    return;
+
+  history->Scrub(std::clamp(end - _offset, start, end));
+  RenderHooks::RequestRender();
+  this->UpdateHistory();
+}
+
+/////////////////////////////////////////////////
+void WorldControl::OnLive()
+{
+  if (auto history = SceneServices::Get<SceneHistory>(
+      SceneServices::kSceneHistory))
+  {
+    history->Live();
+    RenderHooks::RequestRender();
+  }
+  this->UpdateHistory();
+}
+
+/////////////////////////////////////////////////
+void WorldControl::UpdateHistory()
+{
+  auto history = SceneServices::Get<SceneHistory>(
+      SceneServices::kSceneHistory);
+  double start{0.0};
+  double end{0.0};
+  const bool available = nullptr != history && history->Range(start, end);
+
+  double offset{0.0};
+  bool scrubbing{false};
+  if (available)
+  {
+    if (auto time = history->ScrubTime())
+    {
+      // Keep showing the oldest time left once the one shown is dropped
+      if (*time < start)
+      {
+        history->Scrub(start);
+        RenderHooks::RequestRender();
+        time = start;
+      }
+      offset = end - *time;
+      scrubbing = true;
+    }
+  }
+
+  if (available == this->dataPtr->historyAvailable &&
+      end - start == this->dataPtr->historyLength &&
+      offset == this->dataPtr->historyOffset &&
+      scrubbing == this->dataPtr->scrubbing)
+  {
+    return;
+  }
+  this->dataPtr->historyAvailable = available;
+  this->dataPtr->historyLength = end - start;
+  this->dataPtr->historyOffset = offset;
+  this->dataPtr->scrubbing = scrubbing;
+  emit this->HistoryChanged();
+}
+
 /////////////////////////////////////////////////
 void WorldControl::Implementation::SendEventMsg(const msgs::WorldControl &_msg)
 {
@@ -337,13 +455,10 @@ void WorldControl::Implementation::SendEventMsg(const msgs::WorldControl &_msg)
   }
   else
   {
-    std::function<void(const msgs::Boolean &, const bool)> cb =
-        [](const msgs::Boolean &/*_rep*/, const bool /*_result*/)
-    {
-      // the service CB is empty because updates are handled in
-      // WorldControl::ProcessMsg
-    };
-    this->node.Request(this->controlService, _msg, cb);
+    // No continuation because updates are handled in
+    // WorldControl::ProcessMsg
+    App()->Requests()->Request<msgs::WorldControl, msgs::Boolean>(
+        this->controlService, _msg);
   }
 }
 }  // namespace gz::gui::plugins
@@ -56,10 +56,45 @@ namespace gz::gui::plugins
   ///
   /// If no elements are filled for the plugin, both the play/pause and the
   /// step buttons will be displayed.
+  ///
+  /// When the scene's recent history is recorded, see TransportSceneManager's
+  /// \<history\>, a slider scrubs the 3D view back in time and a button
+  /// goes back to the live scene. Scrubbing is local to this GUI, the
+  /// simulation carries on.
   class WorldControl_EXPORTS_API WorldControl: public gz::gui::Plugin
   {
     Q_OBJECT
 
+    /// \brief True if the scene's history can be scrubbed
+    Q_PROPERTY(
+      bool historyAvailable
+      READ HistoryAvailable
+      NOTIFY HistoryChanged
+    )
+
+    /// \brief Seconds of history recorded
+    Q_PROPERTY(
+      double historyLength
+      READ HistoryLength
+      NOTIFY HistoryChanged
+    )
+
+    /// \brief Seconds before the newest recorded time shown, zero while
+    /// live
+    Q_PROPERTY(
+      double historyOffset
+      READ HistoryOffset
+      NOTIFY HistoryChanged
+    )
+
+    /// \brief True while scrubbing the history instead of showing the live
+    /// scene
+    Q_PROPERTY(
+      bool scrubbing
+      READ Scrubbing
+      NOTIFY HistoryChanged
+    )
+
     /// \brief Constructor
     public: WorldControl();
 
@@ -88,6 +123,35 @@ namespace gz::gui::plugins
     /// \param[in] _steps New number of steps.
     public slots: void OnStepCount(const unsigned int _steps);
 
+    /// \brief Get whether the history can be scrubbed
+    /// \return True if the scene's history is recorded
+    public: Q_INVOKABLE bool HistoryAvailable() const;
+
+    /// \brief Get the length of the history
+    /// \return Seconds recorded
+    public: Q_INVOKABLE double HistoryLength() const;
+
+    /// \brief Get the time shown
+    /// \return Seconds before the newest recorded time, zero while live
+    public: Q_INVOKABLE double HistoryOffset() const;
+
+    /// \brief Get whether the history is being scrubbed
+    /// \return True while the live scene isn't shown
+    public: Q_INVOKABLE bool Scrubbing() const;
+
+    /// \brief Callback in Qt thread when the history slider is moved
+    /// \param[in] _offset Seconds before the newest recorded time to show
+    public slots: void OnScrub(double _offset);
+
+    /// \brief Callback in Qt thread when the live button is clicked
+    public slots: void OnLive();
+
+    /// \brief Check for the history and its length, a few times per second
+    public slots: void UpdateHistory();
+
+    /// \brief Notify that the history or the time shown changed
+    signals: void HistoryChanged();
+
     /// \brief Notify that it's now playing.
     signals: void playing();
 
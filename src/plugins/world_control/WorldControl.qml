@@ -225,6 +225,50 @@ RowLayout {
     onActivated: confirmationDialogOnReset.open()
   }
 
+  /**
+   * Scrub the scene's recent history, back to live
+   */
+  Slider {
+    id: historySlider
+    objectName: "historySlider"
+    visible: WorldControl.historyAvailable
+    from: 0
+    to: Math.max(WorldControl.historyLength, 0.001)
+    value: WorldControl.historyLength - WorldControl.historyOffset
+    Layout.fillWidth: true
+    Layout.minimumWidth: 100
+    Layout.alignment: Qt.AlignVCenter
+    onMoved: {
+      WorldControl.OnScrub(WorldControl.historyLength - value)
+    }
+    ToolTip.visible: hovered
+    ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+    ToolTip.text: qsTr("Show the scene as it was, in this window only")
+  }
+
+  Label {
+    visible: WorldControl.historyAvailable && WorldControl.scrubbing
+    text: "-" + WorldControl.historyOffset.toFixed(1) + " s"
+    Layout.alignment: Qt.AlignVCenter
+  }
+
+  RoundButton {
+    id: liveButton
+    objectName: "liveButton"
+    visible: WorldControl.historyAvailable
+    enabled: WorldControl.scrubbing
+    text: qsTr("Live")
+    implicitHeight: stepButton.height
+    Layout.alignment: Qt.AlignVCenter
+    onClicked: {
+      WorldControl.OnLive()
+    }
+    Material.background: Material.primary
+    ToolTip.visible: hovered
+    ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+    ToolTip.text: qsTr("Show the live scene")
+  }
+
   /**
    *  Confirmation dialog on close button
    */
@@ -17,8 +17,18 @@
 
 #include "WorldStats.hh"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
 #include <string>
 
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/world_stats.pb.h>
 
 #include <gz/common/Console.hh>
@@ -26,19 +36,21 @@
 #include <gz/math/Helpers.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
+#include <gz/transport/SubscribeOptions.hh>
 #include <gz/utils/ImplPtr.hh>
 
 #include "gz/gui/Helpers.hh"
+#include "gz/gui/LatestValue.hh"
 
 namespace gz::gui::plugins
 {
 class WorldStats::Implementation
 {
-  /// \brief Message holding latest world statistics
+  /// \brief Latest world statistics processed, only used on the GUI thread
   public: gz::msgs::WorldStatistics msg;
 
-  /// \brief Mutex to protect msg
-  public: std::recursive_mutex mutex;
+  /// \brief Latest world statistics received
+  public: LatestValue<gz::msgs::WorldStatistics> latestMsg;
 
   /// \brief Communication node
   public: gz::transport::Node node;
@@ -55,19 +67,110 @@ class WorldStats::Implementation
   /// \brief Holds iterations
   public: QString iterations;
 
-  /// \brief Time delayed version if simTime used for computing a low-pass
-  /// filtered RTF
-  public: std::optional<double> simTimeDelayed;
+  /// \brief Displayed updates per second, zero for every message the GUI
+  /// thread gets to
+  public: double updateRate{10.0};
 
-  /// \brief Time delayed version if realTime used for computing a low-pass
-  /// filtered RTF
-  public: std::optional<double> realTimeDelayed;
+  /// \brief Delays updates which come too early for `updateRate`
+  public: QTimer updateTimer;
+
+  /// \brief When the display was last updated
+  public: std::chrono::steady_clock::time_point lastUpdate;
+
+  /// \brief Messages received, counted on the transport thread
+  public: std::atomic<std::uint64_t> received{0};
+
+  /// \brief When the latest message was received, in steady clock ticks
+  public: std::atomic<std::chrono::steady_clock::rep> receivedTime{0};
+
+  /// \brief State at one displayed update
+  public: struct Sample
+  {
+    /// \brief When it was displayed
+    std::chrono::steady_clock::time_point time;
+
+    /// \brief Sim time in seconds
+    double simTime{0.0};
+
+    /// \brief Real time in seconds, zero if the message had none
+    double realTime{0.0};
+
+    /// \brief Messages received up to it
+    std::uint64_t received{0};
+
+    /// \brief Seconds from receiving the message to displaying it
+    double latency{0.0};
+  };
+
+  /// \brief Displayed updates of the last `kWindow`, oldest first from
+  /// `windowStart`. A fixed ring, so updates don't allocate.
+  public: std::array<Sample, 64> window;
+
+  /// \brief Index of the oldest sample in `window`
+  public: std::size_t windowStart{0};
+
+  /// \brief Number of samples in `window`
+  public: std::size_t windowSize{0};
+
+  /// \brief Duration statistics are computed over
+  public: static constexpr std::chrono::seconds kWindow{1};
+
+  /// \brief Transport node for the derived statistics
+  public: transport::Node statsNode;
+
+  /// \brief Publishes the derived statistics
+  public: transport::Node::Publisher statsPub;
+
+  /// \brief Reused for publishing the derived statistics
+  public: msgs::Param statsMsg;
 };
 
+/////////////////////////////////////////////////
+/// \brief Format a time as "DD HH:MM:SS.mmm", like math::timePointToString,
+/// into a buffer instead of allocating a string
+/// \param[in] _sec Seconds
+/// \param[in] _nsec Nanoseconds
+/// \param[out] _buffer Formatted time
+/// \return Length of the formatted time
+template <std::size_t N>
+static int formatTime(std::int64_t _sec, std::int64_t _nsec,
+    char (&_buffer)[N])
+{
+  const std::int64_t ms = _sec * 1000 + _nsec / 1000000;
+  const int len = std::snprintf(_buffer, N,
+      "%02" PRId64 " %02d:%02d:%02d.%03d",
+      ms / 86400000,
+      static_cast<int>(ms / 3600000 % 24),
+      static_cast<int>(ms / 60000 % 60),
+      static_cast<int>(ms / 1000 % 60),
+      static_cast<int>(ms % 1000));
+  return std::min(len, static_cast<int>(N) - 1);
+}
+
+/////////////////////////////////////////////////
+/// \brief Set a double param of the statistics msg
+/// \param[in] _msg Msg
+/// \param[in] _key Param name
+/// \param[in] _value Value
+static void setParam(msgs::Param &_msg, const std::string &_key,
+    double _value)
+{
+  auto &any = (*_msg.mutable_params())[_key];
+  any.set_type(msgs::Any_ValueType_DOUBLE);
+  any.set_double_value(_value);
+}
+
 /////////////////////////////////////////////////
 WorldStats::WorldStats()
   : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
+  this->dataPtr->updateTimer.setSingleShot(true);
+  this->connect(&this->dataPtr->updateTimer, &QTimer::timeout,
+      this, &WorldStats::ProcessMsg);
+
+  // Show the latest stats as soon as the card is shown again
+  this->connect(this, &Plugin::SuspendedChanged, this,
+      &WorldStats::ProcessMsg);
 }
 
 /////////////////////////////////////////////////
@@ -146,8 +249,24 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     return;
   }
 
+  transport::SubscribeOptions opts;
+  if (auto elem = _pluginElem->FirstChildElement("max_rate"))
+  {
+    double maxRate{0.0};
+    if (elem->QueryDoubleText(&maxRate) != tinyxml2::XML_SUCCESS ||
+        maxRate < 0)
+    {
+      gzerr << "Failed to parse <max_rate> value: " << elem->GetText()
+            << std::endl;
+    }
+    else if (maxRate > 0.0)
+    {
+      opts.SetMsgsPerSec(static_cast<uint64_t>(std::ceil(maxRate)));
+    }
+  }
+
   if (!this->dataPtr->node.Subscribe(topic, &WorldStats::OnWorldStatsMsg,
-      this))
+      this, opts))
   {
     gzerr << "Failed to subscribe to [" << topic << "]" << std::endl;
     return;
@@ -155,6 +274,24 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
   gzmsg << "Listening to stats on [" << topic << "]" << std::endl;
 
+  if (auto elem = _pluginElem->FirstChildElement("update_rate"))
+    elem->QueryDoubleText(&this->dataPtr->updateRate);
+
+  std::string statsTopic{"/gui/world_stats"};
+  if (auto elem = _pluginElem->FirstChildElement("stats_topic"))
+    statsTopic = nullptr == elem->GetText() ? "" : elem->GetText();
+
+  if (!statsTopic.empty())
+  {
+    this->dataPtr->statsPub =
+        this->dataPtr->statsNode.Advertise<msgs::Param>(statsTopic);
+    if (!this->dataPtr->statsPub)
+    {
+      gzerr << "Failed to advertise world stats statistics on topic ["
+            << statsTopic << "]" << std::endl;
+    }
+  }
+
   // Sim time
   if (auto simTimeElem = _pluginElem->FirstChildElement("sim_time"))
   {
@@ -201,81 +338,151 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void WorldStats::ProcessMsg()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  // The latest msg waits until the card can be seen
+  if (this->Suspended())
+    return;
 
-  std::chrono::steady_clock::time_point simTimePoint;
-  std::chrono::steady_clock::time_point realTimePoint;
+  const auto now = std::chrono::steady_clock::now();
 
-  if (this->dataPtr->msg.has_sim_time())
+  // Limit the display rate, showing the latest message once it's due
+  if (this->dataPtr->updateRate > 0.0)
   {
-    simTimePoint = math::secNsecToTimePoint(
-        this->dataPtr->msg.sim_time().sec(),
-        this->dataPtr->msg.sim_time().nsec());
-    this->SetSimTime(QString::fromStdString(
-      math::timePointToString(simTimePoint)));
+    const auto period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / this->dataPtr->updateRate));
+    const auto due = this->dataPtr->lastUpdate + period;
+    if (now < due)
+    {
+      if (!this->dataPtr->updateTimer.isActive())
+      {
+        this->dataPtr->updateTimer.start(static_cast<int>(
+            std::chrono::ceil<std::chrono::milliseconds>(due - now).count()));
+      }
+      return;
+    }
   }
 
-  if (this->dataPtr->msg.has_real_time())
+  if (!this->dataPtr->latestMsg.Take(this->dataPtr->msg))
+    return;
+  this->dataPtr->lastUpdate = now;
+
+  const auto &msg = this->dataPtr->msg;
+  char text[32];
+
+  Implementation::Sample sample;
+  sample.time = now;
+  sample.received = this->dataPtr->received.load();
+  sample.latency = std::chrono::duration<double>(now -
+      std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(
+      this->dataPtr->receivedTime.load()))).count();
+
+  if (msg.has_sim_time())
   {
-    realTimePoint = math::secNsecToTimePoint(
-        this->dataPtr->msg.real_time().sec(),
-        this->dataPtr->msg.real_time().nsec());
-    this->SetRealTime(QString::fromStdString(
-      math::timePointToString(realTimePoint)));
+    sample.simTime = msg.sim_time().sec() + msg.sim_time().nsec() * 1e-9;
+    const int len = formatTime(msg.sim_time().sec(), msg.sim_time().nsec(),
+        text);
+    if (this->dataPtr->simTime != QLatin1String(text, len))
+      this->SetSimTime(QString::fromLatin1(text, len));
   }
 
+  if (msg.has_real_time())
   {
-    const double simTimeCount =
-        static_cast<double>(simTimePoint.time_since_epoch().count());
-    const double realTimeCount =
-        static_cast<double>(realTimePoint.time_since_epoch().count());
+    sample.realTime = msg.real_time().sec() + msg.real_time().nsec() * 1e-9;
+    const int len = formatTime(msg.real_time().sec(), msg.real_time().nsec(),
+        text);
+    if (this->dataPtr->realTime != QLatin1String(text, len))
+      this->SetRealTime(QString::fromLatin1(text, len));
+  }
 
-    if (realTimeCount > 0)
+  // Keep the updates of the last window, and at least one before it
+  auto &window = this->dataPtr->window;
+  auto &start = this->dataPtr->windowStart;
+  auto &size = this->dataPtr->windowSize;
+  if (size == window.size())
+  {
+    start = (start + 1) % window.size();
+    --size;
+  }
+  window[(start + size) % window.size()] = sample;
+  ++size;
+  while (size > 1 &&
+      now - window[(start + 1) % window.size()].time >= Implementation::kWindow)
+  {
+    start = (start + 1) % window.size();
+    --size;
+  }
+  const auto &oldest = window[start];
+
+  std::optional<double> rtf;
+  if (sample.realTime > 0)
+  {
+    // RTF over the window, from the oldest update which had a real time.
+    // The real time could be zero if simulation was started paused.
+    for (std::size_t i = 0; i + 1 < size; ++i)
     {
-      constexpr double kAlpha = 0.9;
-      this->dataPtr->simTimeDelayed =
-        kAlpha * this->dataPtr->simTimeDelayed.value_or(simTimeCount) +
-        (1.0 - kAlpha) * simTimeCount;
-
-      this->dataPtr->realTimeDelayed =
-        kAlpha * this->dataPtr->realTimeDelayed.value_or(realTimeCount) +
-        (1.0 - kAlpha) * realTimeCount;
-
-      // Compute the average sim and real times.
-      const double realTimeFiltered =
-          realTimeCount - (*this->dataPtr->realTimeDelayed);
-      const double simTimeFiltered =
-          simTimeCount - (*this->dataPtr->simTimeDelayed);
-
-      // RTF, only compute this if the realTime count is greater than zero. The
-      // realtTime count could be zero if simulation was started paused.
-      if (realTimeFiltered > 0)
+      const auto &from = window[(start + i) % window.size()];
+      if (from.realTime <= 0)
+        continue;
+
+      if (sample.realTime > from.realTime)
       {
-        const double rtf =
-            math::precision(simTimeFiltered / realTimeFiltered, 4) * 100;
-        this->SetRealTimeFactor(QString::number(rtf, 'f', 2) + " %");
+        rtf = math::precision((sample.simTime - from.simTime) /
+            (sample.realTime - from.realTime), 4);
       }
+      break;
     }
-    else
-    {
-      // RTF as a percentage.
-      double rtf = this->dataPtr->msg.real_time_factor() * 100;
-      this->SetRealTimeFactor(QString::number(rtf, 'f', 2) + " %");
-    }
+  }
+  else
+  {
+    rtf = msg.real_time_factor();
   }
 
+  if (rtf)
   {
-    this->SetIterations(QString::number(this->dataPtr->msg.iterations()));
+    // RTF as a percentage.
+    const int len = std::snprintf(text, sizeof(text), "%.2f %%",
+        *rtf * 100);
+    if (this->dataPtr->realTimeFactor != QLatin1String(text, len))
+      this->SetRealTimeFactor(QString::fromLatin1(text, len));
   }
+
+  {
+    const int len = std::snprintf(text, sizeof(text), "%" PRIu64,
+        static_cast<std::uint64_t>(msg.iterations()));
+    if (this->dataPtr->iterations != QLatin1String(text, len))
+      this->SetIterations(QString::fromLatin1(text, len));
+  }
+
+  if (!this->dataPtr->statsPub)
+    return;
+
+  double latency{0.0};
+  for (std::size_t i = 0; i < size; ++i)
+    latency += window[(start + i) % window.size()].latency;
+
+  const double span = std::chrono::duration<double>(now - oldest.time).count();
+
+  auto &statsMsg = this->dataPtr->statsMsg;
+  if (rtf)
+    setParam(statsMsg, "real_time_factor", *rtf);
+  setParam(statsMsg, "message_rate", span > 0.0 ?
+      (sample.received - oldest.received) / span : 0.0);
+  setParam(statsMsg, "display_rate", span > 0.0 ? (size - 1) / span : 0.0);
+  setParam(statsMsg, "display_latency", latency / size);
+  this->dataPtr->statsPub.Publish(statsMsg);
 }
 
 /////////////////////////////////////////////////
 void WorldStats::OnWorldStatsMsg(const msgs::WorldStatistics &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->msg.CopyFrom(_msg);
-  QMetaObject::invokeMethod(this, "ProcessMsg");
+  this->dataPtr->received.fetch_add(1, std::memory_order_relaxed);
+  this->dataPtr->receivedTime.store(
+      std::chrono::steady_clock::now().time_since_epoch().count(),
+      std::memory_order_relaxed);
+
+  // Only wake the GUI thread once it's taken the previous message
+  if (this->dataPtr->latestMsg.Set(_msg))
+    QMetaObject::invokeMethod(this, "ProcessMsg", Qt::QueuedConnection);
 }
 
 /////////////////////////////////////////////////
@@ -55,6 +55,28 @@ namespace gz::gui::plugins
   /// * \<topic\> : Topic to receive world statistics, optional. If not present,
   ///               the plugin will attempt to create a topic with the main
   ///               window's `worldName` property.
+  /// * \<update_rate\> : Display updates per second, defaults to 10. Messages
+  ///                     in between are skipped, the latest is shown once
+  ///                     due. Zero to show every message the GUI thread
+  ///                     gets to.
+  /// * \<max_rate\> : Most messages per second to receive, rounded up to a
+  ///                  whole number, 0 by default for all of them. Unlike
+  ///                  \<update_rate\>, messages above this rate are dropped
+  ///                  by the transport subscription, before they're
+  ///                  delivered and deserialized, and aren't counted in the
+  ///                  "message_rate" statistic.
+  /// * \<stats_topic\> : Topic to publish derived statistics on, as
+  ///                     msgs::Param with "real_time_factor",
+  ///                     "message_rate", "display_rate" and
+  ///                     "display_latency" in seconds, computed over the
+  ///                     last second at each display update. Defaults to
+  ///                     "/gui/world_stats", empty to not publish.
+  ///                     Neither the display nor these statistics are
+  ///                     updated while the card is suspended, see
+  ///                     Plugin::Suspended.
+  ///
+  /// The real time factor is computed over the last second of displayed
+  /// updates.
   ///
   /// If no elements are filled for the plugin, all properties will be
   /// displayed.
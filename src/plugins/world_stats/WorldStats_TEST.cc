@@ -17,7 +17,14 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #include <gz/common/Console.hh>
+#include <gz/msgs/param.pb.h>
 #include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -365,3 +372,96 @@ TEST(WorldStatsTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(WorldNameNoProp))
 
   EXPECT_EQ(plugin->SimTime().toStdString(), "00 01:00:00.123");
 }
+
+/////////////////////////////////////////////////
+TEST(WorldStatsTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(UpdateRate))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  const char *pluginStr =
+    "<plugin filename=\"WorldStats\">"
+    "  <sim_time>true</sim_time>"
+    "  <real_time_factor>true</real_time_factor>"
+    "  <topic>/world_stats_rate_test</topic>"
+    "  <update_rate>10</update_rate>"
+    "  <stats_topic>/world_stats_rate_test/derived</stats_topic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("WorldStats",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto plugin = win->findChild<plugins::WorldStats *>();
+  ASSERT_NE(nullptr, plugin);
+
+  // Derived statistics
+  std::mutex mutex;
+  int statsCount{0};
+  msgs::Param stats;
+  std::function<void(const msgs::Param &)> cb =
+      [&](const msgs::Param &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats = _msg;
+        ++statsCount;
+      };
+  transport::Node node;
+  node.Subscribe("/world_stats_rate_test/derived", cb);
+
+  // Half real time, at 1 kHz
+  auto pub = node.Advertise<msgs::WorldStatistics>("/world_stats_rate_test");
+  std::atomic<bool> done{false};
+  std::thread publisher([&]()
+  {
+    for (int i = 1; i <= 1000; ++i)
+    {
+      msgs::WorldStatistics msg;
+      msg.mutable_sim_time()->set_sec(i / 2000);
+      msg.mutable_sim_time()->set_nsec((i % 2000) * 500000);
+      msg.mutable_real_time()->set_sec(i / 1000);
+      msg.mutable_real_time()->set_nsec((i % 1000) * 1000000);
+      msg.set_iterations(i);
+      pub.Publish(msg);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    done = true;
+  });
+
+  while (!done)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  publisher.join();
+
+  // The last message is still shown once due
+  int sleep = 0;
+  while (plugin->Iterations() != "1000" && sleep < 30)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    QCoreApplication::processEvents();
+    sleep++;
+  }
+  EXPECT_EQ("1000", plugin->Iterations().toStdString());
+  EXPECT_EQ("00 00:00:00.500", plugin->SimTime().toStdString());
+  EXPECT_EQ("50.00 %", plugin->RealTimeFactor().toStdString());
+
+  // Published at most at the update rate
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_GT(statsCount, 0);
+  EXPECT_LT(statsCount, 30);
+  ASSERT_EQ(1u, stats.params().count("real_time_factor"));
+  EXPECT_NEAR(0.5, stats.params().at("real_time_factor").double_value(),
+      1e-3);
+  ASSERT_EQ(1u, stats.params().count("message_rate"));
+  EXPECT_GT(stats.params().at("message_rate").double_value(),
+      stats.params().at("display_rate").double_value());
+  EXPECT_GE(stats.params().at("display_latency").double_value(), 0.0);
+}
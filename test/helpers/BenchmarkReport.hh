@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_BENCHMARKREPORT_HH_
+#define GZ_GUI_BENCHMARKREPORT_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+
+namespace gz
+{
+namespace gui
+{
+namespace testing
+{
+  /// \brief Times small functions and writes the results as JSON, in the
+  /// format of Google Benchmark's --benchmark_format=json, so runs can be
+  /// compared with its tools, such as compare.py.
+  ///
+  /// Results are written to "<suite>.json" in the directory set by the
+  /// GZ_GUI_BENCHMARK_DIR environment variable, or in "test_results" of
+  /// the build directory, where the performance gate in test/regression
+  /// compares them against baselines.
+  class BenchmarkReport
+  {
+    /// \brief Constructor
+    /// \param[in] _suite Name of the file the results are written to
+    public: explicit BenchmarkReport(const std::string &_suite)
+      : suite(_suite)
+    {
+    }
+
+    /// \brief Destructor, writes the results
+    public: ~BenchmarkReport()
+    {
+      this->Write();
+    }
+
+    /// \brief Call a function repeatedly, until it has run for long enough
+    /// to be timed reliably, and record the average time of a call
+    /// \param[in] _name Benchmark name, such as "ConvertImage/RGB_INT8"
+    /// \param[in] _fn Function to time
+    /// \return Average time of a call, in nanoseconds
+    public: double Run(const std::string &_name,
+        const std::function<void()> &_fn)
+    {
+      using std::chrono::steady_clock;
+
+      // Warm up caches and lazy initialization
+      _fn();
+
+      std::uint64_t iterations{0};
+      const auto start = steady_clock::now();
+      auto elapsed = steady_clock::duration::zero();
+      while (iterations < kMinIterations || elapsed < kMinTime)
+      {
+        _fn();
+        ++iterations;
+        elapsed = steady_clock::now() - start;
+      }
+
+      const double ns = std::chrono::duration<double, std::nano>(
+          elapsed).count() / static_cast<double>(iterations);
+      this->results.push_back({_name, iterations, ns, "ns"});
+
+      gzmsg << _name << ": " << ns / 1000.0 << " us (" << iterations
+            << " iterations)" << std::endl;
+      return ns;
+    }
+
+    /// \brief Record a value measured by the caller, such as a frame time
+    /// percentile or the memory used
+    /// \param[in] _name Benchmark name, such as "SceneRender/frame_time_p99"
+    /// \param[in] _value Value, lower is better
+    /// \param[in] _unit "ns", "us", "ms" or "s" for times, which are
+    /// written as the benchmark's time, or "MiB" or "ratio", written as a
+    /// counter
+    public: void Add(const std::string &_name, double _value,
+        const std::string &_unit)
+    {
+      this->results.push_back({_name, 1, _value, _unit});
+      gzmsg << _name << ": " << _value << " " << _unit << std::endl;
+    }
+
+    /// \brief Write the results recorded so far
+    public: void Write() const
+    {
+      std::string dir;
+      if (!common::env("GZ_GUI_BENCHMARK_DIR", dir) || dir.empty())
+        dir = common::joinPaths(PROJECT_BINARY_PATH, "test_results");
+      common::createDirectories(dir);
+
+      const auto path = common::joinPaths(dir, this->suite + ".json");
+      std::ofstream file(path);
+      if (!file)
+      {
+        gzerr << "Failed to write benchmark results to [" << path << "]"
+              << std::endl;
+        return;
+      }
+
+      file << std::setprecision(12)
+           << "{\n"
+           << "  \"context\": {\n"
+           << "    \"executable\": \"" << this->suite << "\"\n"
+           << "  },\n"
+           << "  \"benchmarks\": [";
+      for (std::size_t i = 0; i < this->results.size(); ++i)
+      {
+        const auto &result = this->results[i];
+        const bool time = result.unit != "MiB" && result.unit != "ratio";
+        const double value = time ? result.value : 0.0;
+        file << (i == 0 ? "\n" : ",\n")
+             << "    {\n"
+             << "      \"name\": \"" << result.name << "\",\n"
+             << "      \"run_name\": \"" << result.name << "\",\n"
+             << "      \"run_type\": \"iteration\",\n"
+             << "      \"iterations\": " << result.iterations << ",\n"
+             << "      \"real_time\": " << value << ",\n"
+             << "      \"cpu_time\": " << value << ",\n";
+        if (!time)
+        {
+          file << "      \"" << result.unit << "\": " << result.value
+               << ",\n";
+        }
+        file << "      \"time_unit\": \""
+             << (time ? result.unit : "ns") << "\"\n"
+             << "    }";
+      }
+      file << "\n  ]\n}\n";
+    }
+
+    /// \brief Timing of one benchmark
+    private: struct Result
+    {
+      /// \brief Benchmark name
+      std::string name;
+
+      /// \brief Number of timed calls, 1 for values added by the caller
+      std::uint64_t iterations;
+
+      /// \brief Average time of a call, or value added by the caller
+      double value;
+
+      /// \brief Unit of the value, see Add
+      std::string unit;
+    };
+
+    /// \brief Fewest calls timed per benchmark
+    private: static constexpr std::uint64_t kMinIterations{10};
+
+    /// \brief Shortest time spent in each benchmark
+    private: static constexpr std::chrono::milliseconds kMinTime{200};
+
+    /// \brief Name of the results file
+    private: std::string suite;
+
+    /// \brief Results recorded so far
+    private: std::vector<Result> results;
+  };
+}
+}
+}
+#endif
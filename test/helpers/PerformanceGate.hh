@@ -0,0 +1,457 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_PERFORMANCEGATE_HH_
+#define GZ_GUI_PERFORMANCEGATE_HH_
+
+#include <tinyxml2.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+namespace gz
+{
+namespace gui
+{
+namespace testing
+{
+  /// \brief A measured value, lower is better
+  struct PerformanceMetric
+  {
+    /// \brief Benchmark name
+    std::string name;
+
+    /// \brief Value, in unit
+    double value{0.0};
+
+    /// \brief "ns", "us", "ms" or "s" for times, "MiB" for memory, or
+    /// "ratio" for a time relative to another, which doesn't depend on
+    /// the machine as much
+    std::string unit;
+  };
+
+  /// \brief Outcome of comparing a metric against its baseline
+  struct PerformanceResult
+  {
+    /// \brief Measured metric
+    PerformanceMetric metric;
+
+    /// \brief Baseline value, converted to the metric's unit. Unset if the
+    /// metric has no baseline.
+    std::optional<double> baseline;
+
+    /// \brief Largest value which isn't a regression
+    double limit{0.0};
+
+    /// \brief "pass", "regression", "improvement", "new" if the metric is
+    /// gated but has no baseline, or "skipped" if it isn't gated
+    std::string status;
+  };
+
+  /// \brief Compares the results written by BenchmarkReport against stored
+  /// baselines, with tolerances per metric, and writes a JSON report.
+  ///
+  /// Baselines are XML files:
+  ///
+  ///     <performance_baseline>
+  ///       <gate pattern="SceneRender/.*"/>
+  ///       <tolerance pattern="SceneRender/frame_time.*" percent="15"
+  ///                  min_delta="0.5"/>
+  ///       <metric name="SceneRender/frame_time_p50" value="8.1" unit="ms"/>
+  ///     </performance_baseline>
+  ///
+  /// Only metrics whose whole name matches a gate pattern are compared, or
+  /// all of them if there's no gate. The first tolerance whose pattern
+  /// matches the whole metric name applies. A metric regresses if it
+  /// exceeds its baseline by more than the percentage and by more than
+  /// min_delta, in the metric's unit. It improves if it's below its
+  /// baseline by as much.
+  class PerformanceGate
+  {
+    /// \brief Load a baseline
+    /// \param[in] _path XML file
+    /// \return False if it couldn't be parsed
+    public: bool LoadBaseline(const std::string &_path)
+    {
+      tinyxml2::XMLDocument doc;
+      if (doc.LoadFile(_path.c_str()) != tinyxml2::XML_SUCCESS)
+        return false;
+      auto root = doc.FirstChildElement("performance_baseline");
+      if (nullptr == root)
+        return false;
+
+      this->gates.clear();
+      this->tolerances.clear();
+      this->baselines.clear();
+      for (auto elem = root->FirstChildElement("gate");
+          nullptr != elem; elem = elem->NextSiblingElement("gate"))
+      {
+        const char *pattern = elem->Attribute("pattern");
+        if (nullptr == pattern)
+          continue;
+        try
+        {
+          this->gates.push_back({pattern, std::regex(pattern)});
+        }
+        catch (const std::regex_error &)
+        {
+          gzerr << "Invalid gate pattern [" << pattern << "]" << std::endl;
+        }
+      }
+      for (auto elem = root->FirstChildElement("tolerance");
+          nullptr != elem; elem = elem->NextSiblingElement("tolerance"))
+      {
+        const char *pattern = elem->Attribute("pattern");
+        if (nullptr == pattern)
+          continue;
+        try
+        {
+          this->tolerances.push_back({pattern, std::regex(pattern),
+              elem->DoubleAttribute("percent", kDefaultPercent),
+              elem->DoubleAttribute("min_delta", 0.0)});
+        }
+        catch (const std::regex_error &)
+        {
+          gzerr << "Invalid tolerance pattern [" << pattern << "]"
+                << std::endl;
+        }
+      }
+      for (auto elem = root->FirstChildElement("metric");
+          nullptr != elem; elem = elem->NextSiblingElement("metric"))
+      {
+        const char *name = elem->Attribute("name");
+        const char *unit = elem->Attribute("unit");
+        if (nullptr == name || nullptr == unit)
+          continue;
+        this->baselines.push_back({name, elem->DoubleAttribute("value"),
+            unit});
+      }
+      return true;
+    }
+
+    /// \brief Save the gates and tolerances loaded and the metrics as the
+    /// new baseline
+    /// \param[in] _path XML file
+    /// \param[in] _metrics Metrics
+    /// \return True if saved
+    public: bool SaveBaseline(const std::string &_path,
+        std::vector<PerformanceMetric> _metrics) const
+    {
+      std::sort(_metrics.begin(), _metrics.end(),
+          [](const PerformanceMetric &_a, const PerformanceMetric &_b)
+          {
+            return _a.name < _b.name;
+          });
+
+      tinyxml2::XMLDocument doc;
+      auto root = doc.NewElement("performance_baseline");
+      doc.InsertFirstChild(root);
+      for (const auto &gate : this->gates)
+      {
+        auto elem = doc.NewElement("gate");
+        elem->SetAttribute("pattern", gate.pattern.c_str());
+        root->InsertEndChild(elem);
+      }
+      for (const auto &tolerance : this->tolerances)
+      {
+        auto elem = doc.NewElement("tolerance");
+        elem->SetAttribute("pattern", tolerance.pattern.c_str());
+        elem->SetAttribute("percent", tolerance.percent);
+        elem->SetAttribute("min_delta", tolerance.minDelta);
+        root->InsertEndChild(elem);
+      }
+      for (const auto &metric : _metrics)
+      {
+        if (!this->Gated(metric.name))
+          continue;
+        auto elem = doc.NewElement("metric");
+        elem->SetAttribute("name", metric.name.c_str());
+        elem->SetAttribute("value", metric.value);
+        elem->SetAttribute("unit", metric.unit.c_str());
+        root->InsertEndChild(elem);
+      }
+      return doc.SaveFile(_path.c_str()) == tinyxml2::XML_SUCCESS;
+    }
+
+    /// \brief Compare metrics against the baseline
+    /// \param[in] _metrics Metrics
+    /// \return One result per metric, in the same order
+    public: std::vector<PerformanceResult> Compare(
+        const std::vector<PerformanceMetric> &_metrics) const
+    {
+      std::vector<PerformanceResult> results;
+      for (const auto &metric : _metrics)
+      {
+        PerformanceResult result;
+        result.metric = metric;
+        if (!this->Gated(metric.name))
+        {
+          result.status = "skipped";
+          results.push_back(result);
+          continue;
+        }
+        result.status = "new";
+
+        auto baseline = std::find_if(this->baselines.begin(),
+            this->baselines.end(), [&](const PerformanceMetric &_baseline)
+            {
+              return _baseline.name == metric.name;
+            });
+        // Only times can be converted to each other
+        const bool comparable = baseline != this->baselines.end() &&
+            UnitScale(metric.unit) > 0.0 &&
+            (baseline->unit == metric.unit ||
+            (IsTime(baseline->unit) && IsTime(metric.unit)));
+        const double scale = comparable ?
+            UnitScale(baseline->unit) / UnitScale(metric.unit) : 0.0;
+        if (scale > 0.0)
+        {
+          result.baseline = baseline->value * scale;
+
+          double percent{kDefaultPercent};
+          double minDelta{0.0};
+          for (const auto &tolerance : this->tolerances)
+          {
+            if (std::regex_match(metric.name, tolerance.regex))
+            {
+              percent = tolerance.percent;
+              minDelta = tolerance.minDelta;
+              break;
+            }
+          }
+
+          const double delta = std::max(*result.baseline * percent / 100.0,
+              minDelta);
+          result.limit = *result.baseline + delta;
+          if (metric.value > result.limit)
+            result.status = "regression";
+          else if (metric.value < *result.baseline - delta)
+            result.status = "improvement";
+          else
+            result.status = "pass";
+        }
+        results.push_back(result);
+      }
+      return results;
+    }
+
+    /// \brief Check whether a metric is compared against the baseline
+    /// \param[in] _name Metric name
+    /// \return True if it matches a gate pattern, or if there's none
+    public: bool Gated(const std::string &_name) const
+    {
+      if (this->gates.empty())
+        return true;
+      return std::any_of(this->gates.begin(), this->gates.end(),
+          [&](const Gate &_gate)
+          {
+            return std::regex_match(_name, _gate.regex);
+          });
+    }
+
+    /// \brief Write results as JSON
+    /// \param[in] _path File
+    /// \param[in] _results Results
+    /// \return True if written
+    public: static bool WriteReport(const std::string &_path,
+        const std::vector<PerformanceResult> &_results)
+    {
+      std::ofstream file(_path);
+      if (!file)
+        return false;
+
+      std::size_t regressions{0};
+      for (const auto &result : _results)
+        regressions += result.status == "regression" ? 1 : 0;
+
+      file << std::setprecision(12)
+           << "{\n"
+           << "  \"regressions\": " << regressions << ",\n"
+           << "  \"metrics\": [";
+      for (std::size_t i = 0; i < _results.size(); ++i)
+      {
+        const auto &result = _results[i];
+        file << (i == 0 ? "\n" : ",\n")
+             << "    {\n"
+             << "      \"name\": \"" << result.metric.name << "\",\n"
+             << "      \"unit\": \"" << result.metric.unit << "\",\n"
+             << "      \"value\": " << result.metric.value << ",\n";
+        if (result.baseline)
+        {
+          file << "      \"baseline\": " << *result.baseline << ",\n"
+               << "      \"limit\": " << result.limit << ",\n"
+               << "      \"change_percent\": " << (*result.baseline > 0.0 ?
+                  100.0 * (result.metric.value / *result.baseline - 1.0) :
+                  0.0) << ",\n";
+        }
+        file << "      \"status\": \"" << result.status << "\"\n"
+             << "    }";
+      }
+      file << "\n  ]\n}\n";
+      return static_cast<bool>(file);
+    }
+
+    /// \brief Read the metrics of all reports written by BenchmarkReport
+    /// in a directory
+    /// \param[in] _dir Directory
+    /// \return Metrics, sorted by name
+    public: static std::vector<PerformanceMetric> LoadReports(
+        const std::string &_dir)
+    {
+      std::vector<PerformanceMetric> metrics;
+      std::error_code ec;
+      for (const auto &entry : std::filesystem::directory_iterator(_dir, ec))
+      {
+        if (entry.path().extension() != ".json")
+          continue;
+        auto loaded = LoadReport(entry.path().string());
+        metrics.insert(metrics.end(), loaded.begin(), loaded.end());
+      }
+      std::sort(metrics.begin(), metrics.end(),
+          [](const PerformanceMetric &_a, const PerformanceMetric &_b)
+          {
+            return _a.name < _b.name;
+          });
+      return metrics;
+    }
+
+    /// \brief Read the metrics of a report written by BenchmarkReport. It
+    /// writes one field per line, which is all this reads.
+    /// \param[in] _path File
+    /// \return Metrics, empty if it isn't such a report
+    public: static std::vector<PerformanceMetric> LoadReport(
+        const std::string &_path)
+    {
+      std::vector<PerformanceMetric> metrics;
+      std::ifstream file(_path);
+      std::string line;
+      PerformanceMetric metric;
+      std::string counter;
+      double counterValue{0.0};
+      const std::regex field(R"re(^\s*"(\w+)": "?([^",]*)"?,?\s*$)re");
+      while (std::getline(file, line))
+      {
+        std::smatch match;
+        if (std::regex_match(line, match, field))
+        {
+          const auto key = match[1].str();
+          const auto value = match[2].str();
+          if (key == "name")
+            metric.name = value;
+          else if (key == "real_time")
+            metric.value = std::stod(value);
+          else if (key == "time_unit")
+            metric.unit = value;
+          else if (key == "MiB" || key == "ratio")
+          {
+            counter = key;
+            counterValue = std::stod(value);
+          }
+          continue;
+        }
+
+        // End of a benchmark
+        if (line.find('}') != std::string::npos && !metric.name.empty())
+        {
+          if (!counter.empty())
+          {
+            metric.value = counterValue;
+            metric.unit = counter;
+          }
+          if (UnitScale(metric.unit) > 0.0)
+            metrics.push_back(metric);
+          metric = PerformanceMetric();
+          counter.clear();
+        }
+      }
+      return metrics;
+    }
+
+    /// \brief Check whether a unit is a time
+    /// \param[in] _unit Unit
+    /// \return True for "ns", "us", "ms" and "s"
+    public: static bool IsTime(const std::string &_unit)
+    {
+      return _unit == "ns" || _unit == "us" || _unit == "ms" || _unit == "s";
+    }
+
+    /// \brief Get the size of a unit relative to the base unit of its kind
+    /// \param[in] _unit Unit
+    /// \return Nanoseconds for times, 1 for "MiB" and "ratio", 0 if unknown
+    public: static double UnitScale(const std::string &_unit)
+    {
+      if (_unit == "ns" || _unit == "MiB" || _unit == "ratio")
+        return 1.0;
+      if (_unit == "us")
+        return 1e3;
+      if (_unit == "ms")
+        return 1e6;
+      if (_unit == "s")
+        return 1e9;
+      return 0.0;
+    }
+
+    /// \brief Metrics compared against the baseline
+    private: struct Gate
+    {
+      /// \brief Pattern, as written
+      std::string pattern;
+
+      /// \brief Compiled pattern
+      std::regex regex;
+    };
+
+    /// \brief Tolerance of the metrics whose name matches a pattern
+    private: struct Tolerance
+    {
+      /// \brief Pattern, as written
+      std::string pattern;
+
+      /// \brief Compiled pattern
+      std::regex regex;
+
+      /// \brief Allowed increase, in percent of the baseline
+      double percent;
+
+      /// \brief Increase always allowed, in the metric's unit
+      double minDelta;
+    };
+
+    /// \brief Tolerance of metrics no pattern matches, in percent
+    private: static constexpr double kDefaultPercent{10.0};
+
+    /// \brief Gates, all metrics are compared if empty
+    private: std::vector<Gate> gates;
+
+    /// \brief Tolerances, in order
+    private: std::vector<Tolerance> tolerances;
+
+    /// \brief Baseline metrics
+    private: std::vector<PerformanceMetric> baselines;
+  };
+}
+}
+}
+#endif
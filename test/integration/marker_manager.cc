@@ -16,14 +16,20 @@
 */
 
 #include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include <gz/msgs/world_stats.pb.h>
 #include <gz/msgs/marker.pb.h>
+#include <gz/msgs/marker_v.pb.h>
 #include <gz/msgs/material.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
+#include <gz/math/Vector3.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
@@ -37,7 +43,9 @@
 #include "gz/gui/Application.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/MarkerSink.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/SceneServices.hh"
 
 int g_argc = 1;
 char* g_argv[] =
@@ -50,6 +58,57 @@ using namespace std::chrono_literals;
 using namespace gz;
 using namespace gui;
 
+/// \brief Packed points for MarkerManager's bulk service, in the "bulk"
+/// namespace. Each point has float32 x, y and z at offsets 0, 4 and 8, and
+/// with colors, an uint32 rgba at offset 12.
+/// \param[in] _id Marker id
+/// \param[in] _points Points
+/// \param[in] _colors Colors packed as 0xRRGGBBAA, one per point, or none
+/// \return Msg
+gz::msgs::PointCloudPacked bulkMsg(uint64_t _id,
+    const std::vector<math::Vector3f> &_points,
+    const std::vector<uint32_t> &_colors = {})
+{
+  gz::msgs::PointCloudPacked msg;
+  auto addData = [&msg](const std::string &_key, const std::string &_value)
+  {
+    auto *data = msg.mutable_header()->add_data();
+    data->set_key(_key);
+    data->add_value(_value);
+  };
+  addData("ns", "bulk");
+  addData("id", std::to_string(_id));
+
+  const char *names[4]{"x", "y", "z", "rgba"};
+  const int fieldCount = _colors.empty() ? 3 : 4;
+  for (int i = 0; i < fieldCount; ++i)
+  {
+    auto *field = msg.add_field();
+    field->set_name(names[i]);
+    field->set_offset(static_cast<uint32_t>(i * 4));
+    field->set_datatype(i < 3 ? gz::msgs::PointCloudPacked::Field::FLOAT32 :
+        gz::msgs::PointCloudPacked::Field::UINT32);
+    field->set_count(1);
+  }
+
+  const uint32_t pointStep = static_cast<uint32_t>(fieldCount * 4);
+  msg.set_point_step(pointStep);
+  msg.set_width(static_cast<uint32_t>(_points.size()));
+  msg.set_height(1);
+  msg.set_row_step(pointStep * msg.width());
+
+  std::string data(_points.size() * pointStep, '\0');
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    const float xyz[3]{_points[i].X(), _points[i].Y(), _points[i].Z()};
+    std::memcpy(&data[i * pointStep], xyz, sizeof(xyz));
+    if (!_colors.empty())
+      std::memcpy(&data[i * pointStep + 12], &_colors[i], sizeof(uint32_t));
+  }
+  msg.set_data(data);
+  return msg;
+}
+
 class MarkerManagerTestFixture : public ::testing::Test
 {
 
@@ -197,6 +256,23 @@ TEST_F(MarkerManagerTestFixture,
     FAIL();
   }
 
+  // Count the markers per namespace
+  gz::msgs::Header query;
+  auto *data = query.add_data();
+  data->set_key("summary");
+  data->add_value("true");
+  gz::msgs::Marker_V list;
+  bool result{false};
+  EXPECT_TRUE(node.Request("/marker/list/query", query, 1000, list, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(0, list.marker_size());
+  ASSERT_EQ(2, list.header().data_size());
+  EXPECT_EQ("total", list.header().data(0).key());
+  EXPECT_EQ("1", list.header().data(0).value(0));
+  EXPECT_EQ("count", list.header().data(1).key());
+  EXPECT_EQ("default", list.header().data(1).value(0));
+  EXPECT_EQ("1", list.header().data(1).value(1));
+
   markerMsg.set_action(gz::msgs::Marker::DELETE_ALL);
   executed = node.Request("/marker", markerMsg);
   if (executed)
@@ -215,3 +291,255 @@ TEST_F(MarkerManagerTestFixture,
 
   window->QuickWindow()->close();
 }
+
+/////////////////////////////////////////////////
+TEST_F(MarkerManagerTestFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(InProcessSink))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"MarkerManager\">"
+      "<stats_topic>/example/stats</stats_topic>"
+    "</plugin>";
+
+  const char *pluginMinimalSceneStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>scene</scene>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+
+  tinyxml2::XMLDocument pluginDocMinimalScene;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS,
+    pluginDocMinimalScene.Parse(pluginMinimalSceneStr));
+
+  EXPECT_EQ(nullptr,
+      SceneServices::Get<MarkerSink>(SceneServices::kMarkers));
+
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDocMinimalScene.FirstChildElement("plugin")));
+  EXPECT_TRUE(app.LoadPlugin("MarkerManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Shared as soon as the plugin is loaded
+  auto markers = SceneServices::Get<MarkerSink>(SceneServices::kMarkers);
+  ASSERT_NE(nullptr, markers);
+
+  auto window = app.findChild<MainWindow *>();
+  ASSERT_NE(window, nullptr);
+  window->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+  scene = engine->SceneByName("scene");
+  ASSERT_NE(nullptr, scene);
+
+  std::chrono::steady_clock::duration timePoint =
+    std::chrono::steady_clock::duration::zero();
+
+  // A marker msg, moved instead of serialized
+  gz::msgs::Marker markerMsg;
+  markerMsg.set_ns("default");
+  markerMsg.set_id(1);
+  markerMsg.set_action(gz::msgs::Marker::ADD_MODIFY);
+  markerMsg.set_type(gz::msgs::Marker::SPHERE);
+  EXPECT_TRUE(markers->Submit(std::move(markerMsg)));
+
+  // Points, without a msg at all
+  MarkerPoints points;
+  points.ns = "default";
+  points.id = 2;
+  points.type = gz::msgs::Marker::LINE_STRIP;
+  points.points = {math::Vector3d::Zero, math::Vector3d::UnitX};
+  EXPECT_TRUE(markers->SetPoints(std::move(points)));
+
+  // A growing triangle list, appended to past the first chunk of points
+  MarkerPoints triangles;
+  triangles.ns = "default";
+  triangles.id = 4;
+  triangles.type = gz::msgs::Marker::TRIANGLE_LIST;
+  triangles.points.assign(65532, math::Vector3d::Zero);
+  EXPECT_TRUE(markers->SetPoints(std::move(triangles)));
+
+  MarkerPoints appended;
+  appended.ns = "default";
+  appended.id = 4;
+  appended.offset = 65532;
+  appended.points = {math::Vector3d::Zero, math::Vector3d::UnitX,
+      math::Vector3d::UnitY};
+  EXPECT_TRUE(markers->SetPoints(std::move(appended)));
+
+  // Markers need an id, and only point types can be set from points
+  MarkerPoints invalid;
+  invalid.points = {math::Vector3d::Zero};
+  EXPECT_FALSE(markers->SetPoints(std::move(invalid)));
+  invalid.id = 3;
+  invalid.type = gz::msgs::Marker::BOX;
+  EXPECT_FALSE(markers->SetPoints(std::move(invalid)));
+  EXPECT_EQ(1u, invalid.points.size());
+
+  waitAndSendStatsMsgs(timePoint, 2, 200);
+  EXPECT_EQ(3u, scene->VisualCount());
+
+  auto trianglesVis = scene->VisualByName("__GZ_MARKER_VISUAL_default_4");
+  ASSERT_NE(nullptr, trianglesVis);
+  EXPECT_EQ(2u, trianglesVis->GeometryCount());
+
+  gz::msgs::Marker deleteMsg;
+  deleteMsg.set_ns("default");
+  deleteMsg.set_action(gz::msgs::Marker::DELETE_ALL);
+  std::vector<gz::msgs::Marker> msgs{deleteMsg};
+  EXPECT_TRUE(markers->Submit(std::move(msgs)));
+  waitAndSendStatsMsgs(timePoint, 0, 200);
+  EXPECT_EQ(0u, scene->VisualCount());
+
+  // Cleanup
+  scene.reset();
+  window->QuickWindow()->close();
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerManagerTestFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Bulk))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"MarkerManager\">"
+      "<stats_topic>/example/stats</stats_topic>"
+    "</plugin>";
+
+  const char *pluginMinimalSceneStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>scene</scene>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+
+  tinyxml2::XMLDocument pluginDocMinimalScene;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS,
+    pluginDocMinimalScene.Parse(pluginMinimalSceneStr));
+
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDocMinimalScene.FirstChildElement("plugin")));
+  EXPECT_TRUE(app.LoadPlugin("MarkerManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto window = app.findChild<MainWindow *>();
+  ASSERT_NE(window, nullptr);
+  window->QuickWindow()->show();
+
+  auto engine = gz::gui::testing::getRenderEngine("ogre2");
+  ASSERT_NE(nullptr, engine);
+  scene = engine->SceneByName("scene");
+  ASSERT_NE(nullptr, scene);
+
+  std::chrono::steady_clock::duration timePoint =
+    std::chrono::steady_clock::duration::zero();
+
+  // Wait for the services to be advertised
+  std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+
+  // Points without color
+  EXPECT_TRUE(node.Request("/marker/bulk",
+      bulkMsg(1, {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}})));
+
+  // A colored triangle list filling a whole geometry
+  const std::size_t chunk{65532};
+  std::vector<math::Vector3f> triangles(chunk);
+  for (std::size_t i = 0; i < chunk; ++i)
+    triangles[i].Set(static_cast<float>(i % 3), static_cast<float>(i / 3), 0);
+  auto trianglesMsg = bulkMsg(2, triangles,
+      std::vector<uint32_t>(chunk, 0xFF0000FF));
+  auto *type = trianglesMsg.mutable_header()->add_data();
+  type->set_key("type");
+  type->add_value("triangle_list");
+  EXPECT_TRUE(node.Request("/marker/bulk", trianglesMsg));
+
+  waitAndSendStatsMsgs(timePoint, 2, 200);
+  ASSERT_EQ(2u, scene->VisualCount());
+
+  auto pointsVis = scene->VisualByName("__GZ_MARKER_VISUAL_bulk_1");
+  ASSERT_NE(nullptr, pointsVis);
+  EXPECT_EQ(1u, pointsVis->GeometryCount());
+
+  auto trianglesVis = scene->VisualByName("__GZ_MARKER_VISUAL_bulk_2");
+  ASSERT_NE(nullptr, trianglesVis);
+  EXPECT_EQ(1u, trianglesVis->GeometryCount());
+
+  // Appending a triangle at an offset adds a geometry, keeping the first
+  auto appendMsg = bulkMsg(2, {{0, 0, 1}, {1, 0, 1}, {0, 1, 1}},
+      {0x00FF00FF, 0x00FF00FF, 0x00FF00FF});
+  auto *offset = appendMsg.mutable_header()->add_data();
+  offset->set_key("offset");
+  offset->add_value(std::to_string(chunk));
+  EXPECT_TRUE(node.Request("/marker/bulk", appendMsg));
+
+  for (int sleep = 0; sleep < 200 && trianglesVis->GeometryCount() != 2u;
+      ++sleep)
+  {
+    timePoint += 100ms;
+    sendWorldStatisticsMsg(timePoint);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_EQ(2u, trianglesVis->GeometryCount());
+
+  // Malformed msgs are dropped
+  const std::vector<math::Vector3f> point{{0, 0, 0}};
+
+  auto shortMsg = bulkMsg(10, {{0, 0, 0}, {1, 1, 1}});
+  shortMsg.mutable_data()->resize(shortMsg.data().size() - 1);
+  EXPECT_TRUE(node.Request("/marker/bulk", shortMsg));
+
+  auto badTypeMsg = bulkMsg(11, point);
+  badTypeMsg.mutable_field(0)->set_datatype(
+      gz::msgs::PointCloudPacked::Field::FLOAT64);
+  EXPECT_TRUE(node.Request("/marker/bulk", badTypeMsg));
+
+  auto badOffsetMsg = bulkMsg(12, point, {0xFFFFFFFF});
+  badOffsetMsg.mutable_field(3)->set_offset(14);
+  EXPECT_TRUE(node.Request("/marker/bulk", badOffsetMsg));
+
+  EXPECT_TRUE(node.Request("/marker/bulk", bulkMsg(0, point)));
+
+  auto bigEndianMsg = bulkMsg(13, point);
+  bigEndianMsg.set_is_bigendian(true);
+  EXPECT_TRUE(node.Request("/marker/bulk", bigEndianMsg));
+
+  // Valid msgs after them are still processed
+  EXPECT_TRUE(node.Request("/marker/bulk", bulkMsg(14, point)));
+
+  waitAndSendStatsMsgs(timePoint, 3, 200);
+  EXPECT_EQ(3u, scene->VisualCount());
+  EXPECT_NE(nullptr, scene->VisualByName("__GZ_MARKER_VISUAL_bulk_14"));
+  for (int id : {0, 10, 11, 12, 13})
+  {
+    EXPECT_EQ(nullptr, scene->VisualByName("__GZ_MARKER_VISUAL_bulk_" +
+        std::to_string(id))) << id;
+  }
+
+  gz::msgs::Marker deleteMsg;
+  deleteMsg.set_ns("bulk");
+  deleteMsg.set_action(gz::msgs::Marker::DELETE_ALL);
+  EXPECT_TRUE(node.Request("/marker", deleteMsg));
+  waitAndSendStatsMsgs(timePoint, 0, 200);
+  EXPECT_EQ(0u, scene->VisualCount());
+
+  // Cleanup
+  pointsVis.reset();
+  trianglesVis.reset();
+  scene.reset();
+  window->QuickWindow()->close();
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Rand.hh>
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pose_v.pb.h>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "../helpers/BenchmarkReport.hh"
+#include "../../src/plugins/image_display/ImageConversion.hh"
+#include "gz/gui/Enums.hh"
+#include "gz/gui/PlottingInterface.hh"
+#include "gz/gui/SearchModel.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Count the rows of a nested model, which makes a proxy model
+/// filter all of them
+int countRows(const QAbstractItemModel &_model,
+    const QModelIndex &_index = QModelIndex())
+{
+  int count = _model.rowCount(_index);
+  for (int r = _model.rowCount(_index) - 1; r >= 0; --r)
+    count += countRows(_model, _model.index(r, 0, _index));
+  return count;
+}
+
+/////////////////////////////////////////////////
+// Converts an HD image of each pixel format ImageDisplay shows
+TEST(HotPathsTest, ConvertImage)
+{
+  common::Console::SetVerbosity(4);
+  gz::gui::testing::BenchmarkReport report("hot_paths_convert_image");
+
+  const unsigned int width{1280};
+  const unsigned int height{720};
+  const std::vector<std::pair<msgs::PixelFormatType, unsigned int>> formats{
+      {msgs::PixelFormatType::RGB_INT8, 3},
+      {msgs::PixelFormatType::R_FLOAT32, 4},
+      {msgs::PixelFormatType::L_INT16, 2},
+      {msgs::PixelFormatType::L_INT8, 1},
+      {msgs::PixelFormatType::BAYER_RGGB8, 1}};
+
+  for (const auto &[format, bytes] : formats)
+  {
+    auto msg = std::make_shared<msgs::Image>();
+    msg->set_width(width);
+    msg->set_height(height);
+    msg->set_step(width * bytes);
+    msg->set_pixel_format_type(format);
+    std::string data(static_cast<std::size_t>(width) * height * bytes, '\0');
+    if (format == msgs::PixelFormatType::R_FLOAT32)
+    {
+      auto *values = reinterpret_cast<float *>(data.data());
+      for (std::size_t i = 0; i < static_cast<std::size_t>(width) * height;
+          ++i)
+      {
+        values[i] = static_cast<float>(math::Rand::DblUniform(0.1, 10.0));
+      }
+    }
+    else
+    {
+      for (auto &c : data)
+        c = static_cast<char>(math::Rand::IntUniform(0, 255));
+    }
+    msg->set_data(std::move(data));
+
+    const std::shared_ptr<const msgs::Image> constMsg = msg;
+    report.Run("ConvertImage/" + msgs::PixelFormatType_Name(format), [&]()
+    {
+      const auto image = plugins::ConvertImage(constMsg, std::nullopt,
+          std::nullopt);
+      ASSERT_FALSE(image.isNull());
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+// Extracts plotted fields from a large msg, as TransportPlotting does for
+// each msg received
+TEST(HotPathsTest, TopicCallback)
+{
+  common::Console::SetVerbosity(4);
+  gz::gui::testing::BenchmarkReport report("hot_paths_topic_callback");
+
+  msgs::Pose_V msg;
+  for (int i = 0; i < 1000; ++i)
+  {
+    auto *pose = msg.add_pose();
+    pose->set_name("pose_" + std::to_string(i));
+    pose->set_id(i);
+    pose->mutable_position()->set_x(i * 0.5);
+    pose->mutable_orientation()->set_w(1.0);
+  }
+  std::string data;
+  ASSERT_TRUE(msg.SerializeToString(&data));
+
+  auto timeRef = std::make_shared<double>(0.0);
+  Topic topic("");
+  topic.SetPlottingTimeRef(timeRef);
+  for (int i = 0; i < 1000; i += 100)
+  {
+    topic.Register("pose-" + std::to_string(i) + "-position-x", 1);
+    topic.Register("pose-" + std::to_string(i) + "-orientation-w", 1);
+  }
+
+  report.Run("Topic::Callback/1000_poses/20_fields", [&]()
+  {
+    *timeRef += 0.001;
+    topic.Callback(msg);
+  });
+
+  report.Run("Topic::RawCallback/1000_poses/20_fields", [&]()
+  {
+    *timeRef += 0.001;
+    topic.RawCallback(data.data(), data.size(), msg.GetTypeName());
+  });
+}
+
+/////////////////////////////////////////////////
+// Filters a tree shaped like an entity tree, with models holding links
+// holding visuals
+TEST(HotPathsTest, SearchModel)
+{
+  common::Console::SetVerbosity(4);
+  gz::gui::testing::BenchmarkReport report("hot_paths_search_model");
+
+  QStandardItemModel sourceModel;
+  for (int m = 0; m < 100; ++m)
+  {
+    auto *model = new QStandardItem();
+    model->setData(QString("model_%1").arg(m), DataRole::DISPLAY_NAME);
+    for (int l = 0; l < 10; ++l)
+    {
+      auto *link = new QStandardItem();
+      link->setData(QString("link_%1").arg(l), DataRole::DISPLAY_NAME);
+      for (int v = 0; v < 10; ++v)
+      {
+        auto *visual = new QStandardItem();
+        visual->setData(QString("visual_%1").arg(v), DataRole::DISPLAY_NAME);
+        link->appendRow(visual);
+      }
+      model->appendRow(link);
+    }
+    sourceModel.appendRow(model);
+  }
+
+  SearchModel searchModel;
+  searchModel.setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel.setSourceModel(&sourceModel);
+
+  // Alternate between searches which don't contain each other, so every
+  // search is matched against the whole tree
+  const std::vector<QString> searches{"model_4 link_5", "visual_7"};
+  std::size_t index{0};
+  report.Run("SearchModel/11100_items", [&]()
+  {
+    searchModel.SetSearch(searches[index++ % searches.size()]);
+    EXPECT_GT(countRows(searchModel), 0);
+  });
+}
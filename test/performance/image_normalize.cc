@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Image.hh>
+#include <gz/math/Rand.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "../helpers/BenchmarkReport.hh"
+#include "../../src/plugins/image_display/Normalize.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(ImageNormalizeTest, Benchmark)
+{
+  common::Console::SetVerbosity(4);
+
+  // One full HD depth image, with some invalid pixels
+  const unsigned int width{1920};
+  const unsigned int height{1080};
+  const std::size_t count = width * height;
+  std::vector<float> depth(count);
+  for (auto &value : depth)
+  {
+    value = math::Rand::DblUniform() < 0.05 ?
+        std::numeric_limits<float>::infinity() :
+        static_cast<float>(math::Rand::DblUniform(0.1, 10.0));
+  }
+
+  const int iterations{20};
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+
+  // Through common::Image, like ImageDisplay used to
+  common::Image output;
+  auto start = steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    common::Image::ConvertToRGBImage<float>(depth.data(), width, height,
+        output, 0.0f, std::numeric_limits<float>::lowest(), true);
+  }
+  const auto imageTime = steady_clock::now() - start;
+
+  // Finding the range in each image
+  std::vector<uint8_t> gray(count);
+  start = steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    plugins::Normalizer::Range(depth.data(), count, min, max);
+    plugins::Normalizer(0.0f, max, true).Apply(depth.data(), count,
+        gray.data());
+  }
+  const auto time = steady_clock::now() - start;
+
+  // With a fixed range
+  std::vector<uint8_t> fixedGray(count);
+  start = steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    plugins::Normalizer(0.0f, 10.0f, true).Apply(depth.data(), count,
+        fixedGray.data());
+  }
+  const auto fixedTime = steady_clock::now() - start;
+
+  // The same, one value at a time
+  std::vector<uint8_t> scalarGray(count);
+  start = steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    plugins::Normalizer::RangeScalar(depth.data(), 0, count, min, max);
+    plugins::Normalizer(0.0f, max, true).ApplyScalar(depth.data(), 0, count,
+        scalarGray.data());
+  }
+  const auto scalarTime = steady_clock::now() - start;
+
+  gzmsg << "Normalization of " << width << "x" << height
+        << " depth image, average of " << iterations << " runs:" << std::endl
+        << "  common::Image: "
+        << duration<double, std::milli>(imageTime).count() / iterations
+        << " ms" << std::endl
+        << "  Normalizer: "
+        << duration<double, std::milli>(time).count() / iterations
+        << " ms" << std::endl
+        << "  Normalizer, fixed range: "
+        << duration<double, std::milli>(fixedTime).count() / iterations
+        << " ms" << std::endl
+        << "  Normalizer, scalar: "
+        << duration<double, std::milli>(scalarTime).count() / iterations
+        << " ms" << std::endl;
+
+  gz::gui::testing::BenchmarkReport report("image_normalize");
+  report.Add("ImageNormalize/common_Image",
+      duration<double, std::milli>(imageTime).count() / iterations, "ms");
+  report.Add("ImageNormalize/Normalizer",
+      duration<double, std::milli>(time).count() / iterations, "ms");
+  report.Add("ImageNormalize/Normalizer_fixed_range",
+      duration<double, std::milli>(fixedTime).count() / iterations, "ms");
+
+  // Time of the vector kernels relative to the scalar ones, which depends
+  // much less on the machine than the times, so the performance gate
+  // checks it against the stored baseline
+  const double ratio = duration<double>(time).count() /
+      duration<double>(scalarTime).count();
+  std::string kernel;
+#if defined(GZ_GUI_NORMALIZE_AVX2)
+  if (__builtin_cpu_supports("avx2"))
+    kernel = "avx2";
+#elif defined(GZ_GUI_NORMALIZE_NEON)
+  kernel = "neon";
+#endif
+  if (!kernel.empty())
+    report.Add("ImageNormalize/" + kernel + "_vs_scalar", ratio, "ratio");
+
+  // Same result as common::Image, up to rounding. It doesn't clamp
+  // infinite values, which are shown as black.
+  const auto data = output.Data();
+  ASSERT_EQ(count * 3, data.size());
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (std::isinf(depth[i]))
+    {
+      ASSERT_EQ(0, gray[i]) << i;
+      ASSERT_EQ(0, fixedGray[i]) << i;
+      ASSERT_EQ(0, scalarGray[i]) << i;
+      continue;
+    }
+    ASSERT_LE(std::abs(gray[i] - data[i * 3]), 1) << i;
+    ASSERT_LE(std::abs(fixedGray[i] - data[i * 3]), 1) << i;
+    ASSERT_LE(std::abs(scalarGray[i] - data[i * 3]), 1) << i;
+  }
+}
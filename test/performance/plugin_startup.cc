@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "../helpers/BenchmarkReport.hh"
+#include "gz/gui/Application.hh"
+#include "gz/gui/Helpers.hh"
+#include "gz/gui/qt.h"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./plugin_startup")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Plugins which don't need a 3D scene
+const std::vector<std::string> kPlugins{
+    "KeyPublisher",
+    "Publisher",
+    "ShutdownButton",
+    "Teleop",
+    "TopicEcho",
+    "TopicViewer",
+    "TransportPlotting",
+    "WorldControl",
+    "WorldStats"};
+
+/////////////////////////////////////////////////
+// Compares compiling the plugins' QML from their resources, which use the
+// code compiled ahead of time when the Qt Quick Compiler was available at
+// build time, with compiling the same sources at runtime. Run with
+// QML_DISABLE_DISK_CACHE=1 so builds without the compiler don't benefit from
+// the runtime cache of previous runs.
+TEST(PluginStartupTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Benchmark))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib/");
+
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+
+  // Loading the libraries also registers their resources
+  auto start = steady_clock::now();
+  for (const auto &plugin : kPlugins)
+    EXPECT_TRUE(app.LoadPlugin(plugin)) << plugin;
+  const auto loadTime = steady_clock::now() - start;
+
+  // Each compilation gets a new engine, so nothing is cached in memory
+  const int iterations{5};
+  duration<double, std::milli> resourceTime{0};
+  duration<double, std::milli> sourceTime{0};
+  for (int i = 0; i < iterations; ++i)
+  {
+    for (const auto &plugin : kPlugins)
+    {
+      const auto path = QString::fromStdString(
+          ":/" + plugin + "/" + plugin + ".qml");
+      QFile file(path);
+      ASSERT_TRUE(file.open(QIODevice::ReadOnly)) << plugin;
+      const auto source = file.readAll();
+
+      {
+        QQmlEngine engine;
+        engine.addImportPath(qmlQrcImportPath());
+        start = steady_clock::now();
+        QQmlComponent component(&engine, QUrl("qrc" + path));
+        resourceTime += steady_clock::now() - start;
+        EXPECT_TRUE(component.isReady())
+            << component.errorString().toStdString();
+      }
+
+      // Same directory, so relative imports resolve the same way, but
+      // there's no compiled code for this URL
+      {
+        QQmlEngine engine;
+        engine.addImportPath(qmlQrcImportPath());
+        start = steady_clock::now();
+        QQmlComponent component(&engine);
+        component.setData(source, QUrl(QString::fromStdString(
+            "qrc:/" + plugin + "/source.qml")));
+        sourceTime += steady_clock::now() - start;
+        EXPECT_TRUE(component.isReady())
+            << component.errorString().toStdString();
+      }
+    }
+  }
+
+  gzmsg << "Startup of " << kPlugins.size() << " plugins:" << std::endl
+        << "  Loading through the application: "
+        << duration<double, std::milli>(loadTime).count() << " ms"
+        << std::endl
+        << "  Compiling their QML from the resources: "
+        << resourceTime.count() / iterations << " ms" << std::endl
+        << "  Compiling their QML from source: "
+        << sourceTime.count() / iterations << " ms" << std::endl;
+
+  gz::gui::testing::BenchmarkReport report("plugin_startup");
+  report.Add("PluginStartup/startup_load",
+      duration<double, std::milli>(loadTime).count(), "ms");
+  report.Add("PluginStartup/startup_compile_resources",
+      resourceTime.count() / iterations, "ms");
+  report.Add("PluginStartup/startup_compile_source",
+      sourceTime.count() / iterations, "ms");
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Rand.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "../helpers/BenchmarkReport.hh"
+#include "../../src/plugins/point_cloud/Colormap.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(PointCloudColormapTest, Benchmark)
+{
+  common::Console::SetVerbosity(4);
+
+  // One LIDAR scan, with some invalid returns
+  const std::size_t count{1000000};
+  std::vector<float> values(count);
+  for (auto &value : values)
+  {
+    value = math::Rand::DblUniform() < 0.05 ?
+        std::numeric_limits<float>::quiet_NaN() :
+        static_cast<float>(math::Rand::DblUniform(-10.0, 110.0));
+  }
+
+  const plugins::Colormap colormap(0.0f, 100.0f,
+      math::Color(1.0f, 0.0f, 0.0f), math::Color(0.0f, 1.0f, 0.0f));
+
+  std::vector<uint32_t> colors(count);
+  std::vector<uint32_t> indices(count);
+  std::vector<uint32_t> scalarColors(count);
+  std::vector<uint32_t> scalarIndices(count);
+
+  const int iterations{20};
+  std::size_t written{0};
+  std::size_t scalarWritten{0};
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    scalarWritten = colormap.ApplyScalar(values.data(), 0, count,
+        scalarColors.data(), scalarIndices.data(), 0);
+  }
+  const auto scalarTime = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+  {
+    written = colormap.Apply(values.data(), count, colors.data(),
+        indices.data());
+  }
+  const auto time = std::chrono::steady_clock::now() - start;
+
+  using std::chrono::duration;
+  gzmsg << "Colormap of " << count << " values, average of " << iterations
+        << " runs:" << std::endl
+        << "  scalar: " << duration<double, std::milli>(scalarTime).count() /
+            iterations << " ms" << std::endl
+        << "  dispatched: " << duration<double, std::milli>(time).count() /
+            iterations << " ms" << std::endl;
+
+  gz::gui::testing::BenchmarkReport report("point_cloud_colormap");
+  report.Add("PointCloudColormap/scalar",
+      duration<double, std::milli>(scalarTime).count() / iterations, "ms");
+  report.Add("PointCloudColormap/dispatched",
+      duration<double, std::milli>(time).count() / iterations, "ms");
+
+  // Time of the vector kernels relative to the scalar one, which depends
+  // much less on the machine than the times, so the performance gate
+  // checks it against the stored baseline
+  const double ratio = duration<double>(time).count() /
+      duration<double>(scalarTime).count();
+  std::string kernel;
+#if defined(GZ_GUI_COLORMAP_AVX2)
+  if (__builtin_cpu_supports("avx2"))
+    kernel = "avx2";
+#elif defined(GZ_GUI_COLORMAP_NEON)
+  kernel = "neon";
+#endif
+  if (!kernel.empty())
+    report.Add("PointCloudColormap/" + kernel + "_vs_scalar", ratio, "ratio");
+
+  // All kernels must give the same result, up to rounding
+  ASSERT_EQ(scalarWritten, written);
+  EXPECT_LT(written, count);
+  for (std::size_t i = 0; i < written; ++i)
+  {
+    ASSERT_EQ(scalarIndices[i], indices[i]);
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+      const int channel = (colors[i] >> shift) & 0xFF;
+      const int scalarChannel = (scalarColors[i] >> shift) & 0xFF;
+      EXPECT_LE(std::abs(channel - scalarChannel), 1) << i;
+    }
+  }
+}
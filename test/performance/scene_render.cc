@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Util.hh>
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/scene.pb.h>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "../helpers/BenchmarkReport.hh"
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/qt.h"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./scene_render")),
+};
+
+using namespace gz;
+using namespace gui;
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+/// \brief Get a positive number from an environment variable
+/// \param[in] _name Variable name
+/// \param[in] _default Value if unset or invalid
+/// \return Value
+static double envNumber(const std::string &_name, double _default)
+{
+  std::string str;
+  if (!common::env(_name, str) || str.empty())
+    return _default;
+
+  std::stringstream ss(str);
+  double value;
+  ss >> value;
+  if (ss.fail() || value <= 0.0)
+  {
+    gzerr << "Invalid " << _name << " [" << str << "], using " << _default
+          << std::endl;
+    return _default;
+  }
+  return value;
+}
+
+/// \brief CPU time used by one thread
+class ThreadCpu
+{
+  /// \brief Thread name
+  public: std::string name;
+
+  /// \brief User and system time, in seconds
+  public: double seconds{0.0};
+};
+
+/// \brief Get the CPU time used by each thread of this process so far
+/// \return Times by thread id
+static std::map<std::string, ThreadCpu> threadCpuTimes()
+{
+  std::map<std::string, ThreadCpu> times;
+  const double ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+  for (const auto &entry : std::filesystem::directory_iterator(
+      "/proc/self/task"))
+  {
+    ThreadCpu thread;
+    std::ifstream commFile(entry.path() / "comm");
+    std::getline(commFile, thread.name);
+
+    std::ifstream statFile(entry.path() / "stat");
+    std::string stat;
+    std::getline(statFile, stat);
+
+    // Fields after the name, which may hold spaces, start with the state.
+    // utime and stime are the 14th and 15th fields.
+    const auto nameEnd = stat.rfind(')');
+    if (nameEnd == std::string::npos)
+      continue;
+    std::stringstream fields(stat.substr(nameEnd + 2));
+    std::string field;
+    for (int i = 0; i < 11; ++i)
+      fields >> field;
+    double utime{0.0};
+    double stime{0.0};
+    fields >> utime >> stime;
+    thread.seconds = (utime + stime) / ticks;
+
+    times[entry.path().filename().string()] = thread;
+  }
+  return times;
+}
+
+/// \brief Get a memory figure of this process
+/// \param[in] _key Field of /proc/self/status, such as "VmRSS"
+/// \return Value in MiB
+static double memoryMiB(const std::string &_key)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.rfind(_key + ":", 0) != 0)
+      continue;
+    std::stringstream ss(line.substr(_key.size() + 1));
+    double kib{0.0};
+    ss >> kib;
+    return kib / 1024.0;
+  }
+  return 0.0;
+}
+
+/// \brief Get a percentile of sorted values
+/// \param[in] _sorted Values in ascending order, not empty
+/// \param[in] _percent Percentile, from 0 to 100
+/// \return Value
+static double percentile(const std::vector<double> &_sorted, double _percent)
+{
+  const auto index = static_cast<std::size_t>(std::lround(
+      _percent / 100.0 * static_cast<double>(_sorted.size() - 1)));
+  return _sorted[index];
+}
+
+/////////////////////////////////////////////////
+// Renders a scene served by a synthetic TransportSceneManager source: boxes
+// which all move at a fixed rate. Reports frame time percentiles, the CPU
+// used by each thread and the memory of the process.
+//
+// Run it like the integration tests, with a display or under a virtual one
+// such as xvfb-run. It can be tuned with environment variables:
+//   GZ_GUI_BENCHMARK_ENTITIES: Number of boxes, defaults to 500.
+//   GZ_GUI_BENCHMARK_POSE_RATE: Pose updates per second, defaults to 60.
+//   GZ_GUI_BENCHMARK_DURATION: Seconds measured, defaults to 5.
+TEST(SceneRenderTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Benchmark))
+{
+  common::Console::SetVerbosity(4);
+
+  const auto entityCount = static_cast<unsigned int>(
+      envNumber("GZ_GUI_BENCHMARK_ENTITIES", 500));
+  const double poseRate = envNumber("GZ_GUI_BENCHMARK_POSE_RATE", 60);
+  const double durationSec = envNumber("GZ_GUI_BENCHMARK_DURATION", 5);
+
+  // Each model has a link with a box visual, ids don't overlap
+  std::atomic<bool> sceneRequested{false};
+  std::function<bool(msgs::Scene &)> sceneService =
+    [&](msgs::Scene &_rep) -> bool
+  {
+    const unsigned int side = static_cast<unsigned int>(
+        std::ceil(std::sqrt(entityCount)));
+    for (unsigned int i = 0; i < entityCount; ++i)
+    {
+      auto modelMsg = _rep.add_model();
+      modelMsg->set_id(1 + i);
+      modelMsg->set_name("model_" + std::to_string(i));
+      auto position = modelMsg->mutable_pose()->mutable_position();
+      position->set_x(2.0 * (i % side));
+      position->set_y(2.0 * (i / side));
+
+      auto linkMsg = modelMsg->add_link();
+      linkMsg->set_id(1 + entityCount + i);
+      linkMsg->set_name("link");
+
+      auto visMsg = linkMsg->add_visual();
+      visMsg->set_id(1 + 2 * entityCount + i);
+      visMsg->set_name("visual");
+      auto boxSize = visMsg->mutable_geometry()->mutable_box()
+          ->mutable_size();
+      boxSize->set_x(1.0);
+      boxSize->set_y(1.0);
+      boxSize->set_z(1.0);
+    }
+    sceneRequested = true;
+    return true;
+  };
+
+  transport::Node node;
+  node.Advertise<msgs::Scene>("/benchmark/scene", sceneService);
+  auto posePub = node.Advertise<msgs::Pose_V>("/benchmark/pose");
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>benchmark</scene>"
+      "<camera_pose>-10 -10 20 0 0.8 0.8</camera_pose>"
+    "</plugin>";
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  ASSERT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/benchmark/scene</service>"
+      "<pose_topic>/benchmark/pose</pose_topic>"
+      "<deletion_topic>/benchmark/delete</deletion_topic>"
+      "<scene_topic>/benchmark/scene_info</scene_topic>"
+    "</plugin>";
+  pluginDoc.Parse(pluginStr);
+  ASSERT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Called on the render thread after each frame
+  std::mutex frameMutex;
+  std::vector<steady_clock::time_point> frames;
+  frames.reserve(static_cast<std::size_t>(durationSec * 1000));
+  std::atomic<bool> measuring{false};
+  std::atomic<unsigned int> warmupFrames{0};
+  auto renderConnection = RenderHooks::OnRender([&]()
+  {
+    if (!measuring)
+    {
+      ++warmupFrames;
+      return;
+    }
+    std::lock_guard<std::mutex> lock(frameMutex);
+    frames.push_back(steady_clock::now());
+  });
+
+  win->QuickWindow()->show();
+
+  // Wait for the scene to be loaded and rendered
+  auto start = steady_clock::now();
+  while ((!sceneRequested || warmupFrames < 60) &&
+      steady_clock::now() - start < std::chrono::seconds(30))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  ASSERT_TRUE(sceneRequested);
+  ASSERT_GE(warmupFrames, 60u);
+
+  // All boxes bob up and down
+  std::atomic<bool> publishing{true};
+  std::thread poseThread([&]()
+  {
+    const auto period = duration<double>(1.0 / poseRate);
+    auto next = steady_clock::now();
+    unsigned int tick{0};
+    msgs::Pose_V msg;
+    for (unsigned int i = 0; i < entityCount; ++i)
+      msg.add_pose()->set_id(1 + i);
+    const unsigned int side = static_cast<unsigned int>(
+        std::ceil(std::sqrt(entityCount)));
+    while (publishing)
+    {
+      for (unsigned int i = 0; i < entityCount; ++i)
+      {
+        auto position = msg.mutable_pose(i)->mutable_position();
+        position->set_x(2.0 * (i % side));
+        position->set_y(2.0 * (i / side));
+        position->set_z(std::sin(0.1 * tick + i));
+      }
+      posePub.Publish(msg);
+      ++tick;
+      next += std::chrono::duration_cast<steady_clock::duration>(period);
+      std::this_thread::sleep_until(next);
+    }
+  });
+
+  const auto cpuBefore = threadCpuTimes();
+  measuring = true;
+  start = steady_clock::now();
+  while (steady_clock::now() - start < duration<double>(durationSec))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    QCoreApplication::processEvents();
+  }
+  measuring = false;
+  const duration<double> elapsed = steady_clock::now() - start;
+  const auto cpuAfter = threadCpuTimes();
+
+  publishing = false;
+  poseThread.join();
+  renderConnection.reset();
+
+  std::vector<double> frameTimes;
+  {
+    std::lock_guard<std::mutex> lock(frameMutex);
+    for (std::size_t i = 1; i < frames.size(); ++i)
+    {
+      frameTimes.push_back(duration<double, std::milli>(
+          frames[i] - frames[i - 1]).count());
+    }
+  }
+  ASSERT_FALSE(frameTimes.empty());
+  std::sort(frameTimes.begin(), frameTimes.end());
+
+  std::stringstream report;
+  report << "Rendering " << entityCount << " boxes moving at " << poseRate
+         << " Hz for " << elapsed.count() << " s:" << std::endl
+         << "  Frames: " << frameTimes.size() + 1 << " ("
+         << (frameTimes.size() + 1) / elapsed.count() << " fps)"
+         << std::endl
+         << "  Frame time p50: " << percentile(frameTimes, 50)
+         << " ms, p90: " << percentile(frameTimes, 90)
+         << " ms, p99: " << percentile(frameTimes, 99)
+         << " ms, max: " << frameTimes.back() << " ms" << std::endl
+         << "  Memory RSS: " << memoryMiB("VmRSS") << " MiB, peak: "
+         << memoryMiB("VmHWM") << " MiB" << std::endl
+         << "  CPU by thread:" << std::endl;
+
+  // Busiest threads first, threads which started during the measurement
+  // count from 0
+  std::vector<std::pair<double, std::string>> cpu;
+  for (const auto &[tid, after] : cpuAfter)
+  {
+    double used = after.seconds;
+    auto before = cpuBefore.find(tid);
+    if (before != cpuBefore.end())
+      used -= before->second.seconds;
+    if (used > 0.0)
+      cpu.push_back({used, after.name + " [" + tid + "]"});
+  }
+  std::sort(cpu.rbegin(), cpu.rend());
+  for (const auto &[used, name] : cpu)
+  {
+    report << "    " << name << ": " << 100.0 * used / elapsed.count()
+           << " %" << std::endl;
+  }
+  gzmsg << report.str();
+
+  gz::gui::testing::BenchmarkReport benchmark("scene_render");
+  benchmark.Add("SceneRender/frame_time_p50", percentile(frameTimes, 50),
+      "ms");
+  benchmark.Add("SceneRender/frame_time_p90", percentile(frameTimes, 90),
+      "ms");
+  benchmark.Add("SceneRender/frame_time_p99", percentile(frameTimes, 99),
+      "ms");
+  benchmark.Add("SceneRender/frame_time_max", frameTimes.back(), "ms");
+  benchmark.Add("SceneRender/memory_rss", memoryMiB("VmRSS"), "MiB");
+  benchmark.Add("SceneRender/memory_peak", memoryMiB("VmHWM"), "MiB");
+
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+    EXPECT_TRUE(app.RemovePlugin(p->CardItem()->objectName().toStdString()));
+}
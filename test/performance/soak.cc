@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+#include <gz/msgs/double.pb.h>
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/scene.pb.h>
+#include <gz/msgs/uint32_v.pb.h>
+#include <gz/msgs/world_stats.pb.h>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/MemoryAccounting.hh"
+#include "gz/gui/PlottingInterface.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/qt.h"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./soak")),
+};
+
+using namespace gz;
+using namespace gui;
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+/// \brief Get a positive number from an environment variable
+/// \param[in] _name Variable name
+/// \param[in] _default Value if unset or invalid
+/// \return Value
+static double envNumber(const std::string &_name, double _default)
+{
+  std::string str;
+  if (!common::env(_name, str) || str.empty())
+    return _default;
+
+  std::stringstream ss(str);
+  double value;
+  ss >> value;
+  if (ss.fail() || value <= 0.0)
+  {
+    gzerr << "Invalid " << _name << " [" << str << "], using " << _default
+          << std::endl;
+    return _default;
+  }
+  return value;
+}
+
+/// \brief Get a memory figure of this process
+/// \param[in] _key Field of /proc/self/status, such as "VmRSS"
+/// \return Value in MiB
+static double memoryMiB(const std::string &_key)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.rfind(_key + ":", 0) != 0)
+      continue;
+    std::stringstream ss(line.substr(_key.size() + 1));
+    double kib{0.0};
+    ss >> kib;
+    return kib / 1024.0;
+  }
+  return 0.0;
+}
+
+/// \brief How a memory figure evolved over a soak run
+struct MemoryGrowth
+{
+  /// \brief Difference between the lowest value of the last window and
+  /// of the first window, in the unit of the samples
+  double total{0.0};
+
+  /// \brief True if no window is lower than the previous one and most of
+  /// them are higher, which is how leaks look. Caches which fill up once
+  /// and usage which comes and goes with the churn aren't monotonic.
+  bool monotonic{false};
+};
+
+/// \brief Find out whether samples grow steadily. The samples are split
+/// in windows, the first of which is left out as warm up, and the lowest
+/// value of each window is compared, so spikes from the churn don't count.
+/// \param[in] _samples Samples, in time order
+/// \param[in] _windows Number of windows, at least 3
+/// \param[in] _noise Change between windows which is ignored, in the unit
+/// of the samples
+/// \return Growth, not monotonic if there are fewer samples than windows
+static MemoryGrowth memoryGrowth(const std::vector<double> &_samples,
+    std::size_t _windows, double _noise)
+{
+  MemoryGrowth growth;
+  if (_windows < 3 || _samples.size() < _windows)
+    return growth;
+
+  std::vector<double> lows;
+  for (std::size_t w = 1; w < _windows; ++w)
+  {
+    const auto begin = _samples.begin() + static_cast<std::ptrdiff_t>(
+        w * _samples.size() / _windows);
+    const auto end = _samples.begin() + static_cast<std::ptrdiff_t>(
+        (w + 1) * _samples.size() / _windows);
+    lows.push_back(*std::min_element(begin, end));
+  }
+
+  std::size_t rises{0};
+  growth.monotonic = true;
+  for (std::size_t i = 1; i < lows.size(); ++i)
+  {
+    if (lows[i] < lows[i - 1] - _noise)
+      growth.monotonic = false;
+    else if (lows[i] > lows[i - 1] + _noise)
+      ++rises;
+  }
+  growth.monotonic = growth.monotonic && 2 * rises >= lows.size() - 1;
+  growth.total = lows.back() - lows.front();
+  return growth;
+}
+
+/////////////////////////////////////////////////
+TEST(SoakTest, MemoryGrowth)
+{
+  // Flat with churn spikes
+  std::vector<double> samples;
+  for (int i = 0; i < 800; ++i)
+    samples.push_back(500.0 + (i % 7 == 0 ? 40.0 : 0.0) + (i % 3) * 0.1);
+  auto growth = memoryGrowth(samples, 8, 1.0);
+  EXPECT_FALSE(growth.monotonic);
+  EXPECT_NEAR(0.0, growth.total, 1.0);
+
+  // Leaking 0.1 per sample under the same spikes
+  for (std::size_t i = 0; i < samples.size(); ++i)
+    samples[i] += 0.1 * static_cast<double>(i);
+  growth = memoryGrowth(samples, 8, 1.0);
+  EXPECT_TRUE(growth.monotonic);
+  EXPECT_NEAR(60.0, growth.total, 1.0);
+
+  // A cache filling up once, after the warm up
+  samples.assign(800, 500.0);
+  std::fill(samples.begin() + 300, samples.end(), 600.0);
+  growth = memoryGrowth(samples, 8, 1.0);
+  EXPECT_FALSE(growth.monotonic);
+  EXPECT_DOUBLE_EQ(100.0, growth.total);
+
+  // Too few samples to tell
+  growth = memoryGrowth({1.0, 2.0, 3.0}, 8, 1.0);
+  EXPECT_FALSE(growth.monotonic);
+}
+
+/////////////////////////////////////////////////
+// Runs a scene with churn for hours and fails if the memory of the process
+// grows steadily, to catch leaks which only show after a long time, such
+// as one allocation per frame. Every churn period:
+//   * A batch of boxes is spawned through TransportSceneManager's scene
+//     topic, and the previous batch deleted.
+//   * A marker with a lifetime of half a period is sent to MarkerManager,
+//     and sim time advanced so it expires.
+//   * A plot field is subscribed or unsubscribed, alternately, while
+//     values are published on its topic.
+//
+// The RSS and the GPU memory reported to MemoryAccounting are sampled
+// throughout and written to "soak_memory.csv" in the benchmark directory,
+// see BenchmarkReport.
+//
+// Skipped unless GZ_GUI_SOAK_HOURS is set. Run it like the integration
+// tests, with a display or under a virtual one such as xvfb-run. It can be
+// tuned with environment variables:
+//   GZ_GUI_SOAK_HOURS: Hours to run, may be fractional.
+//   GZ_GUI_SOAK_ENTITIES: Boxes per batch, defaults to 200.
+//   GZ_GUI_SOAK_CHURN_PERIOD: Seconds between churn steps, defaults to 1.
+//   GZ_GUI_SOAK_SAMPLE_PERIOD: Seconds between memory samples, defaults to
+//   10, shortened so there are at least 64 samples.
+//   GZ_GUI_SOAK_MAX_GROWTH: Most steady growth allowed, in MiB, for the
+//   RSS and the GPU memory each. Defaults to 50.
+TEST(SoakTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Soak))
+{
+  const double hours = envNumber("GZ_GUI_SOAK_HOURS", 0.0);
+  if (hours <= 0.0)
+    GTEST_SKIP() << "Set GZ_GUI_SOAK_HOURS to run the soak test";
+
+  common::Console::SetVerbosity(3);
+
+  const auto entityCount = static_cast<unsigned int>(
+      envNumber("GZ_GUI_SOAK_ENTITIES", 200));
+  const double churnPeriod = envNumber("GZ_GUI_SOAK_CHURN_PERIOD", 1.0);
+  const double durationSec = hours * 3600.0;
+  const double samplePeriod = std::min(
+      envNumber("GZ_GUI_SOAK_SAMPLE_PERIOD", 10.0), durationSec / 64.0);
+  const double maxGrowth = envNumber("GZ_GUI_SOAK_MAX_GROWTH", 50.0);
+
+  transport::Node node;
+  auto scenePub = node.Advertise<msgs::Scene>("/soak/scene_info");
+  auto deletionPub = node.Advertise<msgs::UInt32_V>("/soak/delete");
+  auto statsPub = node.Advertise<msgs::WorldStatistics>("/world/soak/stats");
+  auto plotPub = node.Advertise<msgs::Double>("/soak/plot");
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // A large GPU budget, so the meshes are reported to MemoryAccounting
+  // without being unloaded
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre2</engine>"
+      "<scene>soak</scene>"
+      "<camera_pose>-10 -10 20 0 0.8 0.8</camera_pose>"
+    "</plugin>";
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  ASSERT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"TransportSceneManager\">"
+      "<service>/soak/scene</service>"
+      "<pose_topic>/soak/pose</pose_topic>"
+      "<deletion_topic>/soak/delete</deletion_topic>"
+      "<scene_topic>/soak/scene_info</scene_topic>"
+      "<gpu_memory_budget>4096</gpu_memory_budget>"
+    "</plugin>";
+  pluginDoc.Parse(pluginStr);
+  ASSERT_TRUE(app.LoadPlugin("TransportSceneManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  pluginStr =
+    "<plugin filename=\"MarkerManager\">"
+      "<topic_name>/soak/marker</topic_name>"
+      "<stats_topic>/world/soak/stats</stats_topic>"
+      "<warn_on_action_failure>false</warn_on_action_failure>"
+    "</plugin>";
+  pluginDoc.Parse(pluginStr);
+  ASSERT_TRUE(app.LoadPlugin("MarkerManager",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  PlottingInterface plotting;
+
+  // Plot values and sim time flow continuously, the rest is stepped below
+  std::atomic<bool> publishing{true};
+  std::atomic<int64_t> simTimeNs{0};
+  std::thread streamThread([&]()
+  {
+    msgs::Double plotMsg;
+    msgs::WorldStatistics statsMsg;
+    unsigned int tick{0};
+    while (publishing)
+    {
+      plotMsg.set_data(std::sin(0.01 * tick++));
+      plotPub.Publish(plotMsg);
+
+      simTimeNs += 10000000;
+      statsMsg.mutable_sim_time()->set_sec(simTimeNs / 1000000000);
+      statsMsg.mutable_sim_time()->set_nsec(simTimeNs % 1000000000);
+      statsPub.Publish(statsMsg);
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+
+  std::vector<double> rssSamples;
+  std::vector<double> gpuSamples;
+  std::vector<double> sampleTimes;
+
+  unsigned int step{0};
+  const auto start = steady_clock::now();
+  auto nextChurn = start;
+  auto nextSample = start;
+  while (steady_clock::now() - start < duration<double>(durationSec))
+  {
+    const auto now = steady_clock::now();
+    if (now >= nextChurn)
+    {
+      // Ids of the two batches alternate, each model with a link and a box
+      // visual
+      const unsigned int first = 1 + (step % 2) * 3 * entityCount;
+      msgs::Scene sceneMsg;
+      for (unsigned int i = 0; i < entityCount; ++i)
+      {
+        auto modelMsg = sceneMsg.add_model();
+        modelMsg->set_id(first + i);
+        modelMsg->set_name("model_" + std::to_string(first + i));
+        auto position = modelMsg->mutable_pose()->mutable_position();
+        position->set_x(2.0 * (i % 20));
+        position->set_y(2.0 * (i / 20));
+
+        auto linkMsg = modelMsg->add_link();
+        linkMsg->set_id(first + entityCount + i);
+        linkMsg->set_name("link");
+
+        auto visMsg = linkMsg->add_visual();
+        visMsg->set_id(first + 2 * entityCount + i);
+        visMsg->set_name("visual");
+        auto boxSize = visMsg->mutable_geometry()->mutable_box()
+            ->mutable_size();
+        boxSize->set_x(1.0);
+        boxSize->set_y(1.0);
+        boxSize->set_z(1.0);
+      }
+      scenePub.Publish(sceneMsg);
+
+      if (step > 0)
+      {
+        const unsigned int previous = 1 + ((step + 1) % 2) * 3 * entityCount;
+        msgs::UInt32_V deletionMsg;
+        for (unsigned int i = 0; i < entityCount; ++i)
+          deletionMsg.add_data(previous + i);
+        deletionPub.Publish(deletionMsg);
+      }
+
+      msgs::Marker markerMsg;
+      markerMsg.set_ns("soak");
+      markerMsg.set_id(step);
+      markerMsg.set_action(msgs::Marker::ADD_MODIFY);
+      markerMsg.set_type(msgs::Marker::SPHERE);
+      markerMsg.set_visibility(msgs::Marker::GUI);
+      const auto lifetime = static_cast<int64_t>(churnPeriod * 0.5e9);
+      markerMsg.mutable_lifetime()->set_sec(lifetime / 1000000000);
+      markerMsg.mutable_lifetime()->set_nsec(lifetime % 1000000000);
+      node.Request("/soak/marker", markerMsg);
+
+      if (step % 2 == 0)
+        plotting.subscribe(1, "data", "/soak/plot");
+      else
+        plotting.unsubscribe(1, "data", "/soak/plot");
+
+      ++step;
+      nextChurn += std::chrono::duration_cast<steady_clock::duration>(
+          duration<double>(churnPeriod));
+    }
+
+    if (now >= nextSample)
+    {
+      sampleTimes.push_back(duration<double>(now - start).count());
+      rssSamples.push_back(memoryMiB("VmRSS"));
+      gpuSamples.push_back(static_cast<double>(
+          MemoryAccounting::TotalBytes(MemoryType::GPU)) / (1024.0 * 1024.0));
+      nextSample += std::chrono::duration_cast<steady_clock::duration>(
+          duration<double>(samplePeriod));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    QCoreApplication::processEvents();
+  }
+
+  publishing = false;
+  streamThread.join();
+
+  std::string dir;
+  if (!common::env("GZ_GUI_BENCHMARK_DIR", dir) || dir.empty())
+    dir = common::joinPaths(PROJECT_BINARY_PATH, "test_results");
+  common::createDirectories(dir);
+  std::ofstream csv(common::joinPaths(dir, "soak_memory.csv"));
+  csv << "time_s,rss_mib,gpu_mib" << std::endl;
+  for (std::size_t i = 0; i < sampleTimes.size(); ++i)
+  {
+    csv << sampleTimes[i] << "," << rssSamples[i] << "," << gpuSamples[i]
+        << std::endl;
+  }
+
+  const auto rss = memoryGrowth(rssSamples, 8, 1.0);
+  const auto gpu = memoryGrowth(gpuSamples, 8, 1.0);
+  gzmsg << "Soak of " << step << " churn steps over " << hours
+        << " h, " << rssSamples.size() << " samples:" << std::endl
+        << "  RSS growth: " << rss.total << " MiB"
+        << (rss.monotonic ? ", steady" : "") << std::endl
+        << "  GPU growth: " << gpu.total << " MiB"
+        << (gpu.monotonic ? ", steady" : "") << std::endl;
+
+  EXPECT_FALSE(rss.monotonic && rss.total > maxGrowth)
+      << "RSS grew steadily by " << rss.total << " MiB";
+  EXPECT_FALSE(gpu.monotonic && gpu.total > maxGrowth)
+      << "GPU memory grew steadily by " << gpu.total << " MiB";
+
+  auto plugins = win->findChildren<Plugin *>();
+  for (const auto &p : plugins)
+    EXPECT_TRUE(app.RemovePlugin(p->CardItem()->objectName().toStdString()));
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "../helpers/BenchmarkReport.hh"
+#include "../helpers/PerformanceGate.hh"
+
+using namespace gz;
+using gz::gui::testing::BenchmarkReport;
+using gz::gui::testing::PerformanceGate;
+using gz::gui::testing::PerformanceMetric;
+
+/// \brief Directory the performance tests write their results to
+/// \return Path
+static std::string resultsDir()
+{
+  std::string dir;
+  if (!common::env("GZ_GUI_BENCHMARK_DIR", dir) || dir.empty())
+    dir = common::joinPaths(PROJECT_BINARY_PATH, "test_results");
+  return dir;
+}
+
+/// \brief Whether missing results and baselines fail the gate rather than
+/// being reported, which is the case on CI unless
+/// GZ_GUI_PERFORMANCE_GATE_STRICT is set to something other than 1
+/// \return True if strict
+static bool strict()
+{
+  std::string value;
+  if (common::env("GZ_GUI_PERFORMANCE_GATE_STRICT", value))
+    return value == "1";
+  return common::env("CI", value) && !value.empty() && value != "false";
+}
+
+/////////////////////////////////////////////////
+TEST(PerformanceGateTest, Compare)
+{
+  const auto dir = common::joinPaths(PROJECT_BINARY_PATH, "test",
+      "performance_gate");
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+
+  const auto baselinePath = common::joinPaths(dir, "baseline.xml");
+  {
+    std::ofstream file(baselinePath);
+    file << "<performance_baseline>\n"
+         << "  <tolerance pattern=\"Scene/frame.*\" percent=\"10\""
+         << " min_delta=\"0.5\"/>\n"
+         << "  <tolerance pattern=\".*\" percent=\"20\"/>\n"
+         << "  <metric name=\"Scene/frame_p50\" value=\"10\" unit=\"ms\"/>\n"
+         << "  <metric name=\"Scene/frame_p99\" value=\"2\" unit=\"ms\"/>\n"
+         << "  <metric name=\"Scene/memory\" value=\"100\" unit=\"MiB\"/>\n"
+         << "  <metric name=\"Image/convert\" value=\"100\" unit=\"us\"/>\n"
+         << "  <metric name=\"Image/simd\" value=\"0.2\" unit=\"ratio\"/>\n"
+         << "</performance_baseline>\n";
+  }
+
+  PerformanceGate gate;
+  EXPECT_FALSE(gate.LoadBaseline(baselinePath + ".missing"));
+  ASSERT_TRUE(gate.LoadBaseline(baselinePath));
+
+  const std::vector<PerformanceMetric> metrics{
+      // 10% over, within tolerance
+      {"Scene/frame_p50", 11.0, "ms"},
+      // 25% over, but within the minimum delta
+      {"Scene/frame_p99", 2.5, "ms"},
+      // The default tolerance of the last pattern applies
+      {"Scene/memory", 125.0, "MiB"},
+      // Units are converted
+      {"Image/convert", 50000.0, "ns"},
+      {"Plot/callback", 1.0, "us"},
+      // Ratios aren't times
+      {"Image/simd", 0.5, "ratio"},
+      {"Image/simd", 0.5, "ms"}};
+  const auto results = gate.Compare(metrics);
+  ASSERT_EQ(metrics.size(), results.size());
+  EXPECT_EQ("pass", results[0].status);
+  EXPECT_DOUBLE_EQ(11.0, results[0].limit);
+  EXPECT_EQ("pass", results[1].status);
+  EXPECT_DOUBLE_EQ(2.5, results[1].limit);
+  EXPECT_EQ("regression", results[2].status);
+  EXPECT_EQ("improvement", results[3].status);
+  ASSERT_TRUE(results[3].baseline);
+  EXPECT_DOUBLE_EQ(100000.0, *results[3].baseline);
+  EXPECT_EQ("new", results[4].status);
+  EXPECT_FALSE(results[4].baseline);
+  EXPECT_EQ("regression", results[5].status);
+  EXPECT_EQ("new", results[6].status);
+
+  // Reports written by BenchmarkReport are read back
+  common::setenv("GZ_GUI_BENCHMARK_DIR", dir);
+  {
+    BenchmarkReport report("gate_test");
+    report.Add("Scene/frame_p50", 9.5, "ms");
+    report.Add("Scene/memory", 90.0, "MiB");
+    report.Add("Image/simd", 0.25, "ratio");
+    report.Run("Noop", []() {});
+  }
+  common::unsetenv("GZ_GUI_BENCHMARK_DIR");
+  auto loaded = PerformanceGate::LoadReports(dir);
+  ASSERT_EQ(4u, loaded.size());
+  EXPECT_EQ("Image/simd", loaded[0].name);
+  EXPECT_DOUBLE_EQ(0.25, loaded[0].value);
+  EXPECT_EQ("ratio", loaded[0].unit);
+  EXPECT_EQ("Noop", loaded[1].name);
+  EXPECT_EQ("ns", loaded[1].unit);
+  EXPECT_EQ("Scene/frame_p50", loaded[2].name);
+  EXPECT_DOUBLE_EQ(9.5, loaded[2].value);
+  EXPECT_EQ("ms", loaded[2].unit);
+  EXPECT_EQ("Scene/memory", loaded[3].name);
+  EXPECT_DOUBLE_EQ(90.0, loaded[3].value);
+  EXPECT_EQ("MiB", loaded[3].unit);
+
+  // Saving keeps the tolerances
+  ASSERT_TRUE(gate.SaveBaseline(baselinePath, loaded));
+  PerformanceGate saved;
+  ASSERT_TRUE(saved.LoadBaseline(baselinePath));
+  const auto savedResults = saved.Compare(
+      {{"Scene/frame_p50", 10.0, "ms"}, {"Noop", 1.0, "ns"}});
+  EXPECT_EQ("pass", savedResults[0].status);
+  EXPECT_DOUBLE_EQ(10.45, savedResults[0].limit);
+  EXPECT_NE("new", savedResults[1].status);
+
+  const auto reportPath = common::joinPaths(dir, "report.json");
+  ASSERT_TRUE(PerformanceGate::WriteReport(reportPath, results));
+  std::ifstream file(reportPath);
+  const std::string report((std::istreambuf_iterator<char>(file)),
+      std::istreambuf_iterator<char>());
+  EXPECT_NE(std::string::npos, report.find("\"regressions\": 2"));
+
+  // The gate's own report isn't read as results
+  EXPECT_EQ(4u, PerformanceGate::LoadReports(dir).size());
+}
+
+/////////////////////////////////////////////////
+TEST(PerformanceGateTest, Gates)
+{
+  const auto dir = common::joinPaths(PROJECT_BINARY_PATH, "test",
+      "performance_gate_gates");
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+
+  const auto baselinePath = common::joinPaths(dir, "baseline.xml");
+  {
+    std::ofstream file(baselinePath);
+    file << "<performance_baseline>\n"
+         << "  <gate pattern=\".*_vs_scalar\"/>\n"
+         << "  <metric name=\"A/avx2_vs_scalar\" value=\"0.2\""
+         << " unit=\"ratio\"/>\n"
+         << "  <metric name=\"A/time\" value=\"1\" unit=\"ms\"/>\n"
+         << "</performance_baseline>\n";
+  }
+
+  PerformanceGate gate;
+  ASSERT_TRUE(gate.LoadBaseline(baselinePath));
+  EXPECT_TRUE(gate.Gated("A/avx2_vs_scalar"));
+  EXPECT_FALSE(gate.Gated("A/time"));
+
+  const std::vector<PerformanceMetric> metrics{
+      {"A/avx2_vs_scalar", 0.9, "ratio"},
+      // Not gated, even with a baseline
+      {"A/time", 100.0, "ms"},
+      // Gated without a baseline
+      {"B/neon_vs_scalar", 0.3, "ratio"}};
+  const auto results = gate.Compare(metrics);
+  ASSERT_EQ(metrics.size(), results.size());
+  EXPECT_EQ("regression", results[0].status);
+  EXPECT_EQ("skipped", results[1].status);
+  EXPECT_EQ("new", results[2].status);
+
+  // Only gated metrics are saved, with the gates
+  ASSERT_TRUE(gate.SaveBaseline(baselinePath, metrics));
+  PerformanceGate saved;
+  ASSERT_TRUE(saved.LoadBaseline(baselinePath));
+  EXPECT_FALSE(saved.Gated("A/time"));
+  const auto savedResults = saved.Compare(metrics);
+  EXPECT_EQ("pass", savedResults[0].status);
+  EXPECT_EQ("skipped", savedResults[1].status);
+  EXPECT_EQ("pass", savedResults[2].status);
+}
+
+/////////////////////////////////////////////////
+// Compares the results of the performance tests, which must run first, such
+// as with `ctest -L "PERFORMANCE|REGRESSION"`, against the baseline stored
+// in this directory, and fails on significant regressions. The comparison
+// is written to "performance_gate_report.json" next to the results.
+//
+// The stored baseline gates the speedups of the vector kernels, which
+// don't depend much on the machine. Times are only meaningful on the
+// machine they were recorded on, so set GZ_GUI_PERFORMANCE_BASELINE to a
+// baseline of the CI machine to gate them too, or run once with
+// GZ_GUI_UPDATE_PERFORMANCE_BASELINE=1 to replace the stored values with
+// the current results, keeping the gates and tolerances.
+//
+// On CI, missing results and gated metrics without a baseline fail, so the
+// gate can't pass without checking anything.
+TEST(PerformanceGateTest, Baseline)
+{
+  common::Console::SetVerbosity(4);
+
+  const auto dir = resultsDir();
+  const auto metrics = PerformanceGate::LoadReports(dir);
+  if (metrics.empty())
+  {
+    if (strict())
+    {
+      FAIL() << "No benchmark results in [" << dir
+             << "], the performance tests must run first";
+    }
+    GTEST_SKIP() << "No benchmark results in [" << dir
+                 << "], run the performance tests first";
+  }
+
+  std::string baselinePath;
+  if (!common::env("GZ_GUI_PERFORMANCE_BASELINE", baselinePath) ||
+      baselinePath.empty())
+  {
+    baselinePath = common::joinPaths(PROJECT_SOURCE_PATH, "test",
+        "regression", "performance_baseline.xml");
+  }
+
+  PerformanceGate gate;
+  ASSERT_TRUE(gate.LoadBaseline(baselinePath)) << baselinePath;
+
+  std::string update;
+  if (common::env("GZ_GUI_UPDATE_PERFORMANCE_BASELINE", update) &&
+      update == "1")
+  {
+    ASSERT_TRUE(gate.SaveBaseline(baselinePath, metrics)) << baselinePath;
+    gzmsg << "Saved " << metrics.size() << " metrics to baseline ["
+          << baselinePath << "]" << std::endl;
+    return;
+  }
+
+  const auto results = gate.Compare(metrics);
+  const auto reportPath = common::joinPaths(dir,
+      "performance_gate_report.json");
+  EXPECT_TRUE(PerformanceGate::WriteReport(reportPath, results))
+      << reportPath;
+
+  std::size_t unknown{0};
+  std::size_t compared{0};
+  for (const auto &result : results)
+  {
+    if (result.status == "skipped")
+      continue;
+    if (result.status == "new")
+    {
+      ++unknown;
+      EXPECT_FALSE(strict()) << result.metric.name
+          << " has no baseline in [" << baselinePath << "]";
+      continue;
+    }
+    ++compared;
+
+    gzmsg << result.metric.name << ": " << result.metric.value << " "
+          << result.metric.unit << " (baseline " << *result.baseline
+          << ", " << result.status << ")" << std::endl;
+    EXPECT_NE("regression", result.status)
+        << result.metric.name << " regressed to " << result.metric.value
+        << " " << result.metric.unit << ", the limit is " << result.limit
+        << " (baseline " << *result.baseline << ")";
+  }
+  if (unknown > 0)
+  {
+    gzwarn << unknown << " metrics have no baseline in [" << baselinePath
+           << "]" << std::endl;
+  }
+  if (strict())
+  {
+    EXPECT_GT(compared, 0u) << "None of the " << metrics.size()
+        << " metrics is gated by [" << baselinePath << "]";
+  }
+}